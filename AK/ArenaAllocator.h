@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#if defined(KERNEL)
+#    error "ArenaAllocator.h is not available in the kernel"
+#endif
+
+#include <AK/BumpAllocator.h>
+#include <AK/Forward.h>
+#include <AK/Noncopyable.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+// Memory for many short-lived allocations, such as the nodes and lists a parser creates, that is all released at
+// once when the arena is destroyed. Freeing single allocations is not possible. An arena is not thread-safe.
+class Arena {
+    AK_MAKE_NONCOPYABLE(Arena);
+    AK_MAKE_NONMOVABLE(Arena);
+
+public:
+    static constexpr size_t chunk_size = 64 * KiB;
+    static constexpr size_t max_alignment = 16;
+
+    Arena() = default;
+
+    ~Arena()
+    {
+        while (m_large_allocations) {
+            auto* next = m_large_allocations->next;
+            kfree_sized(m_large_allocations, m_large_allocations->size);
+            m_large_allocations = next;
+        }
+    }
+
+    void* allocate(size_t size, size_t alignment = max_alignment)
+    {
+        VERIFY(alignment <= max_alignment);
+        m_bytes_allocated += size;
+
+        // Allocations that would waste a large part of a chunk get their own memory.
+        if (size > chunk_size / 4) {
+            VERIFY(!Checked<size_t>::addition_would_overflow(size, sizeof(LargeAllocation)));
+            auto allocation_size = size + sizeof(LargeAllocation);
+            auto* allocation = static_cast<LargeAllocation*>(kmalloc(allocation_size));
+            if (!allocation)
+                return nullptr;
+            allocation->next = m_large_allocations;
+            allocation->size = allocation_size;
+            m_large_allocations = allocation;
+            return allocation + 1;
+        }
+
+        return m_chunks.allocate(size, alignment);
+    }
+
+    template<typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        static_assert(IsTriviallyDestructible<T>, "The arena does not run destructors");
+        auto* ptr = allocate(sizeof(T), alignof(T));
+        if (!ptr)
+            return nullptr;
+        return new (ptr) T(forward<Args>(args)...);
+    }
+
+    size_t bytes_allocated() const { return m_bytes_allocated; }
+
+private:
+    struct alignas(max_alignment) LargeAllocation {
+        LargeAllocation* next;
+        size_t size;
+    };
+
+    BumpAllocator<false, chunk_size> m_chunks;
+    LargeAllocation* m_large_allocations { nullptr };
+    size_t m_bytes_allocated { 0 };
+};
+
+namespace Detail {
+
+inline Arena*& current_arena()
+{
+    static thread_local Arena* s_current_arena = nullptr;
+    return s_current_arena;
+}
+
+}
+
+// Makes the containers using ArenaAllocator on this thread allocate from the given arena until it goes out of scope.
+// Scopes can be nested; the previous arena is used again when the inner scope ends.
+class ArenaScope {
+    AK_MAKE_NONCOPYABLE(ArenaScope);
+    AK_MAKE_NONMOVABLE(ArenaScope);
+
+public:
+    explicit ArenaScope(Arena& arena)
+        : m_previous_arena(exchange(Detail::current_arena(), &arena))
+    {
+    }
+
+    ~ArenaScope()
+    {
+        Detail::current_arena() = m_previous_arena;
+    }
+
+    static Arena* current() { return Detail::current_arena(); }
+
+private:
+    Arena* m_previous_arena { nullptr };
+};
+
+// An allocator for AK containers that takes memory from the arena of the innermost ArenaScope on the current thread.
+// Freed memory is only returned when the arena is destroyed, so such containers must not outlive their arena, and may
+// only grow while one is in scope. Copy them into a regular container to keep their contents around.
+struct ArenaAllocator {
+    static size_t good_size(size_t size) { return size; }
+
+    static void* allocate(size_t size)
+    {
+        auto* arena = ArenaScope::current();
+        VERIFY(arena);
+        return arena->allocate(size);
+    }
+
+    static void* allocate_zeroed(size_t size)
+    {
+        auto* ptr = allocate(size);
+        if (ptr)
+            __builtin_memset(ptr, 0, size);
+        return ptr;
+    }
+
+    static void deallocate(void*, size_t) { }
+};
+
+template<typename T, size_t inline_capacity = 0>
+using ArenaVector = Vector<T, inline_capacity, ArenaAllocator>;
+
+template<typename T, typename TraitsForT = Traits<T>>
+using ArenaHashTable = HashTable<T, TraitsForT, false, ArenaAllocator>;
+
+template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>>
+using ArenaHashMap = HashMap<K, V, KeyTraits, ValueTraits, false, HashTable, ArenaAllocator>;
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::Arena;
+using AK::ArenaAllocator;
+using AK::ArenaHashMap;
+using AK::ArenaHashTable;
+using AK::ArenaScope;
+using AK::ArenaVector;
+#endif
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Format.h>
 #include <AK/FormatParser.h>
@@ -42,65 +43,98 @@ static constexpr size_t use_next_index = NumericLimits<size_t>::max();
 
 // The worst case is that we have the largest 64-bit value formatted as binary number, this would take
 // 65 bytes (85 bytes with separators). Choosing a larger power of two won't hurt and is a bit of mitigation against out-of-bounds accesses.
+// The digits are written to the end of the buffer, and the index of the first one is returned.
 static constexpr size_t convert_unsigned_to_string(u64 value, Array<u8, 128>& buffer, u8 base, bool upper_case, bool use_separator)
 {
     VERIFY(base >= 2 && base <= 16);
 
     constexpr char const* lowercase_lookup = "0123456789abcdef";
     constexpr char const* uppercase_lookup = "0123456789ABCDEF";
+    auto const* lookup = upper_case ? uppercase_lookup : lowercase_lookup;
+
+    // "00" to "99", so decimal numbers can be converted two digits at a time.
+    constexpr auto two_digit_lookup = [] {
+        Array<u8, 200> table {};
+        for (size_t i = 0; i < 100; ++i) {
+            table[2 * i] = '0' + i / 10;
+            table[2 * i + 1] = '0' + i % 10;
+        }
+        return table;
+    }();
+
+    size_t start = buffer.size();
 
     if (value == 0) {
-        buffer[0] = '0';
-        return 1;
+        buffer[--start] = '0';
+        return start;
     }
 
-    size_t used = 0;
-    size_t digit_count = 0;
-    while (value > 0) {
-        if (upper_case)
-            buffer[used++] = uppercase_lookup[value % base];
-        else
-            buffer[used++] = lowercase_lookup[value % base];
+    if (use_separator) {
+        size_t digit_count = 0;
+        while (value > 0) {
+            buffer[--start] = lookup[value % base];
+            value /= base;
 
-        digit_count++;
-        value /= base;
+            if (value > 0 && ++digit_count % 3 == 0)
+                buffer[--start] = ',';
+        }
+        return start;
+    }
 
-        if (use_separator && value > 0 && digit_count % 3 == 0)
-            buffer[used++] = ',';
+    if (base == 10) {
+        while (value >= 100) {
+            auto const index = (value % 100) * 2;
+            value /= 100;
+            buffer[--start] = two_digit_lookup[index + 1];
+            buffer[--start] = two_digit_lookup[index];
+        }
+        if (value >= 10) {
+            buffer[--start] = two_digit_lookup[value * 2 + 1];
+            buffer[--start] = two_digit_lookup[value * 2];
+        } else {
+            buffer[--start] = '0' + value;
+        }
+        return start;
     }
 
-    for (size_t i = 0; i < used / 2; ++i)
-        swap(buffer[i], buffer[used - i - 1]);
+    if ((base & (base - 1)) == 0) {
+        auto const bits_per_digit = count_trailing_zeroes(base);
+        for (; value > 0; value >>= bits_per_digit)
+            buffer[--start] = lookup[value & (base - 1)];
+        return start;
+    }
 
-    return used;
+    for (; value > 0; value /= base)
+        buffer[--start] = lookup[value % base];
+    return start;
 }
 
 ErrorOr<void> vformat_impl(TypeErasedFormatParams& params, FormatBuilder& builder, FormatParser& parser)
 {
-    auto const literal = parser.consume_literal();
-    TRY(builder.put_literal(literal));
-
-    FormatParser::FormatSpecifier specifier;
-    if (!parser.consume_specifier(specifier)) {
-        VERIFY(parser.is_eof());
-        return {};
-    }
+    for (;;) {
+        auto const literal = parser.consume_literal();
+        TRY(builder.put_literal(literal));
+
+        FormatParser::FormatSpecifier specifier;
+        if (!parser.consume_specifier(specifier)) {
+            VERIFY(parser.is_eof());
+            return {};
+        }
 
-    if (specifier.index == use_next_index)
-        specifier.index = params.take_next_index();
+        if (specifier.index == use_next_index)
+            specifier.index = params.take_next_index();
 
-    auto& parameter = params.parameters().at(specifier.index);
+        auto& parameter = params.parameters().at(specifier.index);
 
-    FormatParser argparser { specifier.flags };
-    TRY(parameter.visit([&]<typename T>(T const& value) {
-        if constexpr (IsSame<T, TypeErasedParameter::CustomType>) {
-            return value.formatter(params, builder, argparser, value.value);
-        } else {
-            return __format_value<T>(params, builder, argparser, &value);
-        }
-    }));
-    TRY(vformat_impl(params, builder, parser));
-    return {};
+        FormatParser argparser { specifier.flags };
+        TRY(parameter.visit([&]<typename T>(T const& value) {
+            if constexpr (IsSame<T, TypeErasedParameter::CustomType>) {
+                return value.formatter(params, builder, argparser, value.value);
+            } else {
+                return __format_value<T>(params, builder, argparser, &value);
+            }
+        }));
+    }
 }
 
 } // namespace AK::{anonymous}
@@ -114,16 +148,17 @@ StringView FormatParser::consume_literal()
     auto const begin = tell();
 
     while (!is_eof()) {
-        if (consume_specific("{{"sv))
-            continue;
-
-        if (consume_specific("}}"sv))
+        auto const ch = peek();
+        if (ch != '{' && ch != '}') {
+            ignore();
             continue;
+        }
 
-        if (next_is(is_any_of("{}"sv)))
+        if (peek(1) != ch)
             return m_input.substring_view(begin, tell() - begin);
 
-        consume();
+        // An escaped "{{" or "}}".
+        ignore(2);
     }
 
     return m_input.substring_view(begin);
@@ -197,17 +232,20 @@ bool FormatParser::consume_replacement_field(size_t& index)
 
 ErrorOr<void> FormatBuilder::put_padding(char fill, size_t amount)
 {
-    for (size_t i = 0; i < amount; ++i)
-        TRY(m_builder.try_append(fill));
-    return {};
+    return m_builder.try_append_repeated(fill, amount);
 }
 ErrorOr<void> FormatBuilder::put_literal(StringView value)
 {
+    // Append everything up to and including the first brace of each escaped "{{" or "}}" at once.
+    size_t run_start = 0;
     for (size_t i = 0; i < value.length(); ++i) {
-        TRY(m_builder.try_append(value[i]));
-        if (value[i] == '{' || value[i] == '}')
-            ++i;
+        if (value[i] == '{' || value[i] == '}') {
+            TRY(m_builder.try_append(value.substring_view(run_start, i + 1 - run_start)));
+            run_start = ++i + 1;
+        }
     }
+    if (run_start < value.length())
+        TRY(m_builder.try_append(value.substring_view(run_start)));
     return {};
 }
 
@@ -259,7 +297,8 @@ ErrorOr<void> FormatBuilder::put_u64(
 
     Array<u8, 128> buffer;
 
-    auto const used_by_digits = convert_unsigned_to_string(value, buffer, base, upper_case, use_separator);
+    auto const digits = StringView { buffer.span().slice(convert_unsigned_to_string(value, buffer, base, upper_case, use_separator)) };
+    auto const used_by_digits = digits.length();
 
     size_t used_by_prefix = 0;
     if (align == Align::Right && zero_pad) {
@@ -310,9 +349,7 @@ ErrorOr<void> FormatBuilder::put_u64(
     };
 
     auto const put_digits = [&]() -> ErrorOr<void> {
-        for (size_t i = 0; i < used_by_digits; ++i)
-            TRY(m_builder.try_append(buffer[i]));
-        return {};
+        return m_builder.try_append(digits);
     };
 
     if (align == Align::Left) {
@@ -582,17 +619,9 @@ ErrorOr<void> FormatBuilder::put_f32_or_f64(
 
     auto const [sign, mantissa, exponent] = convert_floating_point_to_decimal_exponential_form(value);
 
-    auto convert_to_decimal_digits_array = [](auto x, auto& digits) -> size_t {
-        size_t length = 0;
-        for (; x; x /= 10)
-            digits[length++] = x % 10 | '0';
-        for (size_t i = 0; 2 * i + 1 < length; ++i)
-            swap(digits[i], digits[length - i - 1]);
-        return length;
-    };
-
-    Array<u8, 20> mantissa_digits;
-    auto mantissa_length = convert_to_decimal_digits_array(mantissa, mantissa_digits);
+    Array<u8, 128> mantissa_digits;
+    auto const mantissa_text = StringView { mantissa_digits.span().slice(convert_unsigned_to_string(mantissa, mantissa_digits, 10, false, false)) };
+    auto const mantissa_length = mantissa_text.length();
 
     if (sign)
         TRY(builder.try_append('-'));
@@ -602,7 +631,6 @@ ErrorOr<void> FormatBuilder::put_f32_or_f64(
         TRY(builder.try_append(' '));
 
     auto const n = exponent + static_cast<i32>(mantissa_length);
-    auto const mantissa_text = StringView { mantissa_digits.span().slice(0, mantissa_length) };
     size_t integral_part_end = 0;
     // NOTE: Range from ECMA262, seems like an okay default.
     if (n >= -5 && n <= 21) {
@@ -623,9 +651,8 @@ ErrorOr<void> FormatBuilder::put_f32_or_f64(
         }
     } else {
         auto const exponent_sign = n < 0 ? '-' : '+';
-        Array<u8, 5> exponent_digits;
-        auto const exponent_length = convert_to_decimal_digits_array(abs(n - 1), exponent_digits);
-        auto const exponent_text = StringView { exponent_digits.span().slice(0, exponent_length) };
+        Array<u8, 128> exponent_digits;
+        auto const exponent_text = StringView { exponent_digits.span().slice(convert_unsigned_to_string(abs(n - 1), exponent_digits, 10, false, false)) };
         integral_part_end = 1;
 
         if (mantissa_length == 1) {
@@ -117,7 +117,7 @@ private:
 // A set datastructure based on a hash table with closed hashing.
 // HashTable can optionally provide ordered iteration when IsOrdered = true.
 // For a (more commonly required) map datastructure with key-value entries, see HashMap.
-template<typename T, typename TraitsForT, bool IsOrdered>
+template<typename T, typename TraitsForT, bool IsOrdered, typename Allocator>
 class HashTable {
     static constexpr size_t grow_capacity_at_least = 8;
     static constexpr size_t grow_at_load_factor_percent = 80;
@@ -167,7 +167,7 @@ public:
             }
         }
 
-        kfree_sized(m_buckets, size_in_bytes(m_capacity));
+        Allocator::deallocate(m_buckets, size_in_bytes(m_capacity));
     }
 
     HashTable(HashTable const& other)
@@ -524,14 +524,14 @@ private:
     ErrorOr<void> try_rehash(size_t new_capacity)
     {
         new_capacity = max(new_capacity, m_capacity + grow_capacity_at_least);
-        new_capacity = kmalloc_good_size(size_in_bytes(new_capacity)) / sizeof(BucketType);
+        new_capacity = Allocator::good_size(size_in_bytes(new_capacity)) / sizeof(BucketType);
         VERIFY(new_capacity >= size());
 
         auto* old_buckets = m_buckets;
         auto old_buckets_size = size_in_bytes(m_capacity);
         Iterator old_iter = begin();
 
-        auto* new_buckets = kcalloc(1, size_in_bytes(new_capacity));
+        auto* new_buckets = Allocator::allocate_zeroed(size_in_bytes(new_capacity));
         if (!new_buckets)
             return Error::from_errno(ENOMEM);
 
@@ -550,7 +550,7 @@ private:
             it->~T();
         }
 
-        kfree_sized(old_buckets, old_buckets_size);
+        Allocator::deallocate(old_buckets, old_buckets_size);
         return {};
     }
     void rehash(size_t new_capacity)
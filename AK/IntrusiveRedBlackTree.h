@@ -139,17 +139,18 @@ public:
         if (!node)
             return false;
 
-        BaseTree::remove(node);
-
-        node->right_child = nullptr;
-        node->left_child = nullptr;
-        node->m_in_tree = false;
-        if constexpr (!TreeNode::IsRaw)
-            node->m_self.reference = nullptr;
-
+        remove_node(*node);
         return true;
     }
 
+    // Removes exactly this value, even if other values were inserted with the same key.
+    void remove(V& value)
+    {
+        auto& node = value.*member;
+        VERIFY(node.m_in_tree);
+        remove_node(node);
+    }
+
     void clear()
     {
         clear_nodes(static_cast<TreeNode*>(this->m_root));
@@ -159,6 +160,17 @@ public:
     }
 
 private:
+    void remove_node(TreeNode& node)
+    {
+        BaseTree::remove(&node);
+
+        node.right_child = nullptr;
+        node.left_child = nullptr;
+        node.m_in_tree = false;
+        if constexpr (!TreeNode::IsRaw)
+            node.m_self.reference = nullptr;
+    }
+
     static void clear_nodes(TreeNode* node)
     {
         if (!node)
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/JsonReader.h>
+#include <AK/StringBuilder.h>
+
+namespace AK {
+
+static constexpr bool is_space(int ch)
+{
+    return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
+}
+
+ErrorOr<ByteString> JsonReader::Token::to_byte_string() const
+{
+    VERIFY(is_string());
+    if (!has_escapes)
+        return ByteString { text };
+
+    StringBuilder builder;
+    TRY(unescape_string(text, builder));
+    return builder.to_byte_string();
+}
+
+ErrorOr<void> JsonReader::unescape_string(StringView text, StringBuilder& builder)
+{
+    struct UnescapingLexer : GenericLexer {
+        using GenericLexer::GenericLexer;
+        using GenericLexer::decode_single_or_paired_surrogate;
+    };
+
+    UnescapingLexer lexer { text };
+    while (!lexer.is_eof()) {
+        TRY(builder.try_append(lexer.consume_until('\\')));
+        if (lexer.is_eof())
+            break;
+
+        lexer.ignore(); // '\'
+        switch (auto ch = lexer.consume()) {
+        case '"':
+        case '\\':
+        case '/':
+            TRY(builder.try_append(ch));
+            break;
+        case 'b':
+            TRY(builder.try_append('\b'));
+            break;
+        case 'f':
+            TRY(builder.try_append('\f'));
+            break;
+        case 'n':
+            TRY(builder.try_append('\n'));
+            break;
+        case 'r':
+            TRY(builder.try_append('\r'));
+            break;
+        case 't':
+            TRY(builder.try_append('\t'));
+            break;
+        case 'u': {
+            auto code_point = lexer.decode_single_or_paired_surrogate();
+            if (code_point.is_error())
+                return Error::from_string_literal("JsonReader: Error while parsing Unicode escape");
+            TRY(builder.try_append_code_point(code_point.value()));
+            break;
+        }
+        default:
+            return Error::from_string_literal("JsonReader: Invalid escaped character");
+        }
+    }
+    return {};
+}
+
+ErrorOr<JsonReader::Token> JsonReader::next()
+{
+    for (;;) {
+        ignore_while(is_space);
+
+        switch (m_state) {
+        case State::Done:
+            if (!is_eof())
+                return Error::from_string_literal("JsonReader: Didn't consume all input");
+            return Token {};
+
+        case State::ExpectValue:
+            return read_value();
+
+        case State::ExpectValueOrEndArray:
+            if (peek() == ']')
+                return end_container(Container::Array);
+            return read_value();
+
+        case State::ExpectKeyOrEndObject:
+            if (peek() == '}')
+                return end_container(Container::Object);
+            [[fallthrough]];
+        case State::ExpectKey: {
+            auto key = TRY(read_string(TokenType::Key));
+            ignore_while(is_space);
+            if (!consume_specific(':'))
+                return Error::from_string_literal("JsonReader: Expected ':'");
+            m_state = State::ExpectValue;
+            return key;
+        }
+
+        case State::ExpectCommaOrEnd: {
+            auto container = m_containers.last();
+            if (consume_specific(',')) {
+                m_state = container == Container::Object ? State::ExpectKey : State::ExpectValue;
+                continue;
+            }
+            return end_container(container);
+        }
+        }
+        VERIFY_NOT_REACHED();
+    }
+}
+
+ErrorOr<void> JsonReader::skip_value()
+{
+    size_t depth = 0;
+    do {
+        auto token = TRY(next());
+        switch (token.type) {
+        case TokenType::BeginObject:
+        case TokenType::BeginArray:
+            ++depth;
+            break;
+        case TokenType::EndObject:
+        case TokenType::EndArray:
+            if (depth == 0)
+                return Error::from_string_literal("JsonReader: Expected a value");
+            --depth;
+            break;
+        case TokenType::EndOfInput:
+            return Error::from_string_literal("JsonReader: Expected a value");
+        default:
+            break;
+        }
+    } while (depth > 0);
+    return {};
+}
+
+ErrorOr<JsonReader::Token> JsonReader::read_value()
+{
+    switch (peek()) {
+    case '{':
+        ignore();
+        TRY(m_containers.try_append(Container::Object));
+        m_state = State::ExpectKeyOrEndObject;
+        return Token { .type = TokenType::BeginObject };
+    case '[':
+        ignore();
+        TRY(m_containers.try_append(Container::Array));
+        m_state = State::ExpectValueOrEndArray;
+        return Token { .type = TokenType::BeginArray };
+    case '"': {
+        auto token = TRY(read_string(TokenType::String));
+        value_finished();
+        return token;
+    }
+    case 't':
+        return read_literal("true"sv, TokenType::True);
+    case 'f':
+        return read_literal("false"sv, TokenType::False);
+    case 'n':
+        return read_literal("null"sv, TokenType::Null);
+    default:
+        if (peek() == '-' || is_ascii_digit(peek()))
+            return read_number();
+        return Error::from_string_literal("JsonReader: Unexpected character");
+    }
+}
+
+ErrorOr<JsonReader::Token> JsonReader::end_container(Container container)
+{
+    if (!consume_specific(container == Container::Object ? '}' : ']'))
+        return Error::from_string_literal("JsonReader: Expected ',' or the end of the object or array");
+    m_containers.take_last();
+    value_finished();
+    return Token { .type = container == Container::Object ? TokenType::EndObject : TokenType::EndArray };
+}
+
+void JsonReader::value_finished()
+{
+    m_state = m_containers.is_empty() ? State::Done : State::ExpectCommaOrEnd;
+}
+
+ErrorOr<JsonReader::Token> JsonReader::read_string(TokenType type)
+{
+    if (!consume_specific('"'))
+        return Error::from_string_literal("JsonReader: Expected '\"'");
+
+    auto start = tell();
+    bool has_escapes = false;
+    for (;;) {
+        if (is_eof())
+            return Error::from_string_literal("JsonReader: EOF while parsing String");
+        auto ch = consume();
+        if (ch == '"')
+            break;
+        if (is_ascii_c0_control(ch))
+            return Error::from_string_literal("JsonReader: ASCII control sequence encountered");
+        if (ch == '\\') {
+            if (is_eof())
+                return Error::from_string_literal("JsonReader: EOF while parsing String");
+            // The escape sequence itself is validated when the string is unescaped.
+            ignore();
+            has_escapes = true;
+        }
+    }
+
+    return Token { .type = type, .text = m_input.substring_view(start, tell() - start - 1), .has_escapes = has_escapes };
+}
+
+// number = [ minus ] int [ frac ] [ exp ]
+ErrorOr<JsonReader::Token> JsonReader::read_number()
+{
+    auto start = tell();
+    consume_specific('-');
+
+    if (consume_specific('0')) {
+        if (is_ascii_digit(peek()))
+            return Error::from_string_literal("JsonReader: Cannot have leading zeros");
+    } else if (is_ascii_digit(peek())) {
+        ignore_while(is_ascii_digit);
+    } else {
+        return Error::from_string_literal("JsonReader: Unexpected '-' without further digits");
+    }
+
+    if (consume_specific('.')) {
+        if (!is_ascii_digit(peek()))
+            return Error::from_string_literal("JsonReader: Must have digits after decimal point");
+        ignore_while(is_ascii_digit);
+    }
+
+    if (consume_specific('e') || consume_specific('E')) {
+        if (!consume_specific('+'))
+            consume_specific('-');
+        if (!is_ascii_digit(peek()))
+            return Error::from_string_literal("JsonReader: Must have digits after exponent");
+        ignore_while(is_ascii_digit);
+    }
+
+    value_finished();
+    return Token { .type = TokenType::Number, .text = m_input.substring_view(start, tell() - start) };
+}
+
+ErrorOr<JsonReader::Token> JsonReader::read_literal(StringView literal, TokenType type)
+{
+    if (!consume_specific(literal))
+        return Error::from_string_literal("JsonReader: Unexpected character");
+    value_finished();
+    return Token { .type = type };
+}
+
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/GenericLexer.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace AK {
+
+// A pull parser for JSON, for reading a few values out of a document without building a JsonValue tree.
+// Tokens refer to the input, so nothing is allocated unless a string with escape sequences is unescaped.
+//
+//     JsonReader reader { R"({"pid": 1, "name": "init"})"sv };
+//     TRY(reader.next()); // BeginObject
+//     while (true) {
+//         auto token = TRY(reader.next());
+//         if (token.type == JsonReader::TokenType::EndObject)
+//             break;
+//         if (token.text == "pid"sv)
+//             pid = TRY(reader.next()).to_number<u32>();
+//         else
+//             TRY(reader.skip_value());
+//     }
+class JsonReader : private GenericLexer {
+public:
+    enum class TokenType {
+        BeginObject,
+        EndObject,
+        BeginArray,
+        EndArray,
+        Key,
+        String,
+        Number,
+        True,
+        False,
+        Null,
+        EndOfInput,
+    };
+
+    struct Token {
+        TokenType type { TokenType::EndOfInput };
+
+        // For keys and strings, the characters between the quotes, still escaped if has_escapes is set.
+        // For numbers, the number as it appears in the input.
+        StringView text;
+        bool has_escapes { false };
+
+        bool is_string() const { return type == TokenType::Key || type == TokenType::String; }
+
+        template<Arithmetic T>
+        Optional<T> to_number() const
+        {
+            if (type != TokenType::Number)
+                return {};
+            return text.to_number<T>(TrimWhitespace::No);
+        }
+
+        Optional<bool> to_bool() const
+        {
+            if (type == TokenType::True)
+                return true;
+            if (type == TokenType::False)
+                return false;
+            return {};
+        }
+
+        // Returns the unescaped contents of a key or string.
+        ErrorOr<ByteString> to_byte_string() const;
+    };
+
+    explicit JsonReader(StringView input)
+        : GenericLexer(input)
+    {
+    }
+
+    // Returns the next token, or an error if the input is not valid JSON up to it.
+    // After the top-level value has ended, returns EndOfInput tokens.
+    ErrorOr<Token> next();
+
+    // Skips the next value, including everything nested in it.
+    ErrorOr<void> skip_value();
+
+    // The number of objects and arrays the reader is currently in.
+    size_t depth() const { return m_containers.size(); }
+
+    static ErrorOr<void> unescape_string(StringView, StringBuilder&);
+
+private:
+    enum class State {
+        ExpectValue,
+        ExpectValueOrEndArray,
+        ExpectKey,
+        ExpectKeyOrEndObject,
+        ExpectCommaOrEnd,
+        Done,
+    };
+
+    enum class Container : u8 {
+        Object,
+        Array,
+    };
+
+    ErrorOr<Token> read_value();
+    ErrorOr<Token> read_string(TokenType);
+    ErrorOr<Token> read_number();
+    ErrorOr<Token> read_literal(StringView, TokenType);
+    ErrorOr<Token> end_container(Container);
+    void value_finished();
+
+    State m_state { State::ExpectValue };
+    Vector<Container, 32> m_containers;
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::JsonReader;
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Platform.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A bounded lock-free queue for any number of producers and consumers, after Dmitry Vyukov's design.
+//
+// Every slot carries a sequence number that tells whose turn it is: producers wait for it to match the position
+// they claimed, consumers for it to be one past that. Claiming a position is a single compare-exchange, so
+// producers and consumers only contend with each other when they go for the same slot.
+template<typename T, size_t Capacity>
+class MPMCQueue {
+    AK_MAKE_NONCOPYABLE(MPMCQueue);
+    AK_MAKE_NONMOVABLE(MPMCQueue);
+
+    static_assert(Capacity >= 2 && is_power_of_two(Capacity), "MPMCQueue capacity must be a power of two");
+
+public:
+    MPMCQueue()
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+            m_slots[i].sequence.store(i, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    ~MPMCQueue()
+    {
+        while (try_dequeue().has_value())
+            ;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    // Returns false if the queue is full.
+    template<typename U = T>
+    [[nodiscard]] bool try_enqueue(U&& value)
+    {
+        auto position = m_enqueue_position.load(AK::MemoryOrder::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[position & (Capacity - 1)];
+            auto sequence = slot->sequence.load(AK::MemoryOrder::memory_order_acquire);
+            auto difference = static_cast<ssize_t>(sequence - position);
+            if (difference == 0) {
+                // On failure, position is updated to the current one.
+                if (m_enqueue_position.compare_exchange_strong(position, position + 1, AK::MemoryOrder::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                // The slot still holds the value from one lap ago.
+                return false;
+            } else {
+                position = m_enqueue_position.load(AK::MemoryOrder::memory_order_relaxed);
+            }
+        }
+
+        new (slot->storage) T(forward<U>(value));
+        slot->sequence.store(position + 1, AK::MemoryOrder::memory_order_release);
+        return true;
+    }
+
+    // Returns an empty Optional if the queue is empty.
+    [[nodiscard]] Optional<T> try_dequeue()
+    {
+        auto position = m_dequeue_position.load(AK::MemoryOrder::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &m_slots[position & (Capacity - 1)];
+            auto sequence = slot->sequence.load(AK::MemoryOrder::memory_order_acquire);
+            auto difference = static_cast<ssize_t>(sequence - (position + 1));
+            if (difference == 0) {
+                if (m_dequeue_position.compare_exchange_strong(position, position + 1, AK::MemoryOrder::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                return {};
+            } else {
+                position = m_dequeue_position.load(AK::MemoryOrder::memory_order_relaxed);
+            }
+        }
+
+        auto& element = *reinterpret_cast<T*>(slot->storage);
+        Optional<T> value = move(element);
+        element.~T();
+        // Hand the slot to the producer of the next lap.
+        slot->sequence.store(position + Capacity, AK::MemoryOrder::memory_order_release);
+        return value;
+    }
+
+private:
+    struct Slot {
+        Atomic<size_t> sequence { 0 };
+        alignas(T) u8 storage[sizeof(T)];
+    };
+
+    // Producers and consumers each get a cache line of their own, so they don't slow each other down.
+    AK_CACHE_ALIGNED Atomic<size_t> m_enqueue_position { 0 };
+    AK_CACHE_ALIGNED Atomic<size_t> m_dequeue_position { 0 };
+    AK_CACHE_ALIGNED Slot m_slots[Capacity];
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::MPMCQueue;
+#endif
@@ -40,6 +40,44 @@ constexpr void const* bitap_bitwise(void const* haystack, size_t haystack_length
 
     return nullptr;
 }
+
+inline u8 const* find_byte(u8 const* haystack, size_t haystack_length, u8 byte)
+{
+#ifdef KERNEL
+    for (size_t i = 0; i < haystack_length; ++i) {
+        if (haystack[i] == byte)
+            return haystack + i;
+    }
+    return nullptr;
+#else
+    return static_cast<u8 const*>(__builtin_memchr(haystack, byte, haystack_length));
+#endif
+}
+
+// Looks for candidates with memchr(), which checks many bytes at a time, and then compares the rest of the needle.
+// Needles with a common first byte can make this quadratic, so it falls back to bitap after too many false candidates.
+inline void const* find_first_byte_then_compare(void const* haystack, size_t haystack_length, void const* needle, size_t needle_length)
+{
+    constexpr size_t max_false_candidates = 64;
+
+    auto const* haystack_bytes = static_cast<u8 const*>(haystack);
+    auto const* needle_bytes = static_cast<u8 const*>(needle);
+    size_t last_possible_offset = haystack_length - needle_length;
+    size_t false_candidates = 0;
+
+    for (size_t offset = 0; offset <= last_possible_offset;) {
+        auto const* candidate = find_byte(haystack_bytes + offset, last_possible_offset - offset + 1, needle_bytes[0]);
+        if (!candidate)
+            return nullptr;
+        if (__builtin_memcmp(candidate + 1, needle_bytes + 1, needle_length - 1) == 0)
+            return candidate;
+
+        offset = candidate - haystack_bytes + 1;
+        if (++false_candidates > max_false_candidates)
+            return bitap_bitwise(haystack_bytes + offset, haystack_length - offset, needle, needle_length);
+    }
+    return nullptr;
+}
 }
 
 template<typename HaystackIterT>
@@ -116,7 +154,7 @@ inline Optional<size_t> memmem_optional(void const* haystack, size_t haystack_le
     }
 
     if (needle_length < 32) {
-        auto const* ptr = Detail::bitap_bitwise(haystack, haystack_length, needle, needle_length);
+        auto const* ptr = Detail::find_first_byte_then_compare(haystack, haystack_length, needle, needle_length);
         if (ptr)
             return static_cast<size_t>((FlatPtr)ptr - (FlatPtr)haystack);
         return {};
@@ -102,30 +102,22 @@ ALWAYS_INLINE int print_hex(PutChFunc putch, CharType*& bufptr, T number, bool u
 template<typename PutChFunc, typename CharType>
 ALWAYS_INLINE int print_decimal(PutChFunc putch, CharType*& bufptr, u64 number, bool sign, bool always_sign, bool left_pad, bool zero_pad, u32 field_width, bool has_precision, u32 precision)
 {
-    u64 divisor = 10000000000000000000LLU;
-    char ch;
-    char padding = 1;
-    char buf[21];
-    char* p = buf;
+    char buf[20];
+    char* const end = buf + sizeof(buf);
+    char* p = end;
 
+    // Generate the digits from the least significant one, so only as many divisions as there are digits are needed.
     if (!(has_precision && precision == 0 && number == 0)) {
-        for (;;) {
-            ch = '0' + (number / divisor);
-            number %= divisor;
-            if (ch != '0')
-                padding = 0;
-            if (!padding || divisor == 1) {
-                *(p++) = ch;
-                if (precision > 0)
-                    precision--;
-            }
-            if (divisor == 1)
-                break;
-            divisor /= 10;
-        }
+        do {
+            *(--p) = '0' + number % 10;
+            number /= 10;
+        } while (number > 0);
     }
 
-    size_t numlen = p - buf;
+    size_t numlen = end - p;
+
+    // The precision is the minimum number of digits, so only the remainder is padded with zeros.
+    precision = precision > numlen ? precision - numlen : 0;
 
     if (!field_width || field_width < (numlen + has_precision * precision + (sign || always_sign)))
         field_width = numlen + has_precision * precision + (sign || always_sign);
@@ -151,7 +143,7 @@ ALWAYS_INLINE int print_decimal(PutChFunc putch, CharType*& bufptr, u64 number,
     }
 
     for (unsigned i = 0; i < numlen; ++i) {
-        putch(bufptr, buf[i]);
+        putch(bufptr, p[i]);
     }
 
     if (left_pad) {
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Platform.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace AK {
+
+// A bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+//
+// Each side only ever writes its own index. It also keeps a copy of the other side's index, and only reloads that
+// when the copy says the queue is full (or empty), so most operations don't touch the other side's cache line.
+template<typename T, size_t Capacity>
+class SPSCQueue {
+    AK_MAKE_NONCOPYABLE(SPSCQueue);
+    AK_MAKE_NONMOVABLE(SPSCQueue);
+
+    static_assert(Capacity >= 2 && is_power_of_two(Capacity), "SPSCQueue capacity must be a power of two");
+
+public:
+    SPSCQueue() = default;
+
+    ~SPSCQueue()
+    {
+        while (try_dequeue().has_value())
+            ;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+    // Only callable from the producer. Returns false if the queue is full.
+    template<typename U = T>
+    [[nodiscard]] bool try_enqueue(U&& value)
+    {
+        auto tail = m_tail.load(AK::MemoryOrder::memory_order_relaxed);
+        if (tail - m_cached_head == Capacity) {
+            m_cached_head = m_head.load(AK::MemoryOrder::memory_order_acquire);
+            if (tail - m_cached_head == Capacity)
+                return false;
+        }
+
+        new (slot(tail)) T(forward<U>(value));
+        m_tail.store(tail + 1, AK::MemoryOrder::memory_order_release);
+        return true;
+    }
+
+    // Only callable from the consumer. Returns an empty Optional if the queue is empty.
+    [[nodiscard]] Optional<T> try_dequeue()
+    {
+        auto head = m_head.load(AK::MemoryOrder::memory_order_relaxed);
+        if (head == m_cached_tail) {
+            m_cached_tail = m_tail.load(AK::MemoryOrder::memory_order_acquire);
+            if (head == m_cached_tail)
+                return {};
+        }
+
+        auto& element = *slot(head);
+        Optional<T> value = move(element);
+        element.~T();
+        m_head.store(head + 1, AK::MemoryOrder::memory_order_release);
+        return value;
+    }
+
+private:
+    T* slot(size_t index) { return reinterpret_cast<T*>(m_storage) + (index & (Capacity - 1)); }
+
+    // Written by the consumer.
+    AK_CACHE_ALIGNED Atomic<size_t> m_head { 0 };
+    size_t m_cached_tail { 0 };
+
+    // Written by the producer.
+    AK_CACHE_ALIGNED Atomic<size_t> m_tail { 0 };
+    size_t m_cached_head { 0 };
+
+    AK_CACHE_ALIGNED alignas(T) u8 m_storage[sizeof(T) * Capacity];
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::SPSCQueue;
+#endif
@@ -68,6 +68,16 @@ public:
         co_return nread;
     }
 
+    // Like enqueue(), for functions that don't have to wait, such as reading from a non-blocking file.
+    template<typename Func>
+    ErrorOr<size_t> enqueue_synchronously(size_t preferred_capacity_for_writing, Func&& func)
+    {
+        allocate_enough_space_for(preferred_capacity_for_writing);
+        size_t nread = TRY(func(Bytes { m_data + m_peek_head, m_capacity - m_peek_head }));
+        m_peek_head += nread;
+        return nread;
+    }
+
     void append(ReadonlyBytes bytes)
     {
         if (m_peek_head + bytes.size() > m_capacity)
@@ -96,6 +106,9 @@ private:
 
     void allocate_enough_space_for(size_t length)
     {
+        if (m_capacity - m_peek_head >= length)
+            return;
+
         if (m_read_head != 0) {
             if (m_capacity - (m_peek_head - m_read_head) >= length) {
                 memmove(m_data, m_data + m_read_head, m_peek_head - m_read_head);
@@ -0,0 +1,507 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/Vector.h>
+#include <AK/kmalloc.h>
+
+namespace AK {
+
+namespace Detail {
+
+// The control bytes of a SwissHashTable are looked at in groups of 16, so one lookup usually only touches a single
+// cache line of control bytes and then the one slot that actually holds the value.
+struct SwissGroup {
+    static constexpr size_t size = 16;
+    static constexpr u8 empty = 0x80;
+    static constexpr u8 deleted = 0xfe;
+    // Full control bytes hold the lowest 7 bits of the hash, so their highest bit is always clear.
+
+    // The bytes of a group that matched, as the highest bit of each matching byte.
+    struct Matches {
+        u64 low { 0 };
+        u64 high { 0 };
+
+        explicit operator bool() const { return (low | high) != 0; }
+        size_t lowest() const { return low ? count_trailing_zeroes(low) / 8 : 8 + count_trailing_zeroes(high) / 8; }
+        void clear_lowest()
+        {
+            if (low)
+                low &= low - 1;
+            else
+                high &= high - 1;
+        }
+    };
+
+    explicit SwissGroup(u8 const* control_bytes)
+        : m_bytes(SIMD::load_unaligned<SIMD::u8x16>(control_bytes))
+    {
+    }
+
+    Matches match(u8 control_byte) const { return highest_bits(m_bytes == SIMD::expand_to<SIMD::u8x16>(control_byte)); }
+    Matches match_empty() const { return match(empty); }
+    Matches match_empty_or_deleted() const { return highest_bits(m_bytes); }
+
+private:
+    template<typename VectorType>
+    static Matches highest_bits(VectorType vector)
+    {
+        constexpr u64 highest_bit_of_each_byte = 0x8080808080808080ull;
+        auto words = bit_cast<SIMD::u64x2>(vector);
+        return { words[0] & highest_bit_of_each_byte, words[1] & highest_bit_of_each_byte };
+    }
+
+    SIMD::u8x16 m_bytes;
+};
+
+}
+
+template<typename HashTableType, typename T>
+class SwissHashTableIterator {
+    friend HashTableType;
+
+public:
+    bool operator==(SwissHashTableIterator const& other) const { return m_slot == other.m_slot; }
+    bool operator!=(SwissHashTableIterator const& other) const { return m_slot != other.m_slot; }
+    T& operator*() { return *m_slot; }
+    T* operator->() { return m_slot; }
+    void operator++()
+    {
+        ++m_control_byte;
+        ++m_slot;
+        skip_to_full();
+    }
+
+private:
+    SwissHashTableIterator(u8 const* control_byte, u8 const* end_control_byte, T* slot)
+        : m_control_byte(control_byte)
+        , m_end_control_byte(end_control_byte)
+        , m_slot(slot)
+    {
+        skip_to_full();
+    }
+
+    void skip_to_full()
+    {
+        while (m_control_byte != m_end_control_byte && (*m_control_byte & Detail::SwissGroup::empty)) {
+            ++m_control_byte;
+            ++m_slot;
+        }
+        if (m_control_byte == m_end_control_byte)
+            m_slot = nullptr;
+    }
+
+    u8 const* m_control_byte { nullptr };
+    u8 const* m_end_control_byte { nullptr };
+    T* m_slot { nullptr };
+};
+
+// A set datastructure based on a hash table with open addressing, laid out like Abseil's "Swiss tables".
+// Next to the slots, the table keeps one control byte per slot with 7 bits of the hash of its value, and looks for
+// values by comparing a group of 16 control bytes at once. Compared to HashTable, a lookup reads fewer cache lines for
+// large tables, and values don't have to be moved around when other values are inserted or removed.
+// It has the same interface as an unordered HashTable, and can be used for HashMaps via SwissHashMap.
+template<typename T, typename TraitsForT = Traits<T>, bool IsOrdered = false, typename Allocator = KmallocAllocator>
+class SwissHashTable {
+    static_assert(!IsOrdered, "SwissHashTable does not support ordered iteration");
+
+    using Group = Detail::SwissGroup;
+
+    static constexpr size_t minimum_capacity = Group::size;
+    // The table grows once 7/8 of the slots are in use.
+    static constexpr size_t max_size_for_capacity(size_t capacity) { return capacity - capacity / 8; }
+
+public:
+    SwissHashTable() = default;
+    explicit SwissHashTable(size_t capacity) { MUST(try_ensure_capacity(capacity)); }
+
+    ~SwissHashTable()
+    {
+        if (!m_control_bytes)
+            return;
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (auto& value : *this)
+                value.~T();
+        }
+        Allocator::deallocate(m_control_bytes, size_in_bytes(m_capacity));
+    }
+
+    SwissHashTable(SwissHashTable const& other)
+    {
+        MUST(try_ensure_capacity(other.size()));
+        for (auto& value : other)
+            set(value);
+    }
+
+    SwissHashTable& operator=(SwissHashTable const& other)
+    {
+        SwissHashTable temporary(other);
+        swap(*this, temporary);
+        return *this;
+    }
+
+    SwissHashTable(SwissHashTable&& other) noexcept
+        : m_control_bytes(exchange(other.m_control_bytes, nullptr))
+        , m_slots(exchange(other.m_slots, nullptr))
+        , m_size(exchange(other.m_size, 0))
+        , m_capacity(exchange(other.m_capacity, 0))
+        , m_growth_left(exchange(other.m_growth_left, 0))
+    {
+    }
+
+    SwissHashTable& operator=(SwissHashTable&& other) noexcept
+    {
+        SwissHashTable temporary { move(other) };
+        swap(*this, temporary);
+        return *this;
+    }
+
+    friend void swap(SwissHashTable& a, SwissHashTable& b) noexcept
+    {
+        swap(a.m_control_bytes, b.m_control_bytes);
+        swap(a.m_slots, b.m_slots);
+        swap(a.m_size, b.m_size);
+        swap(a.m_capacity, b.m_capacity);
+        swap(a.m_growth_left, b.m_growth_left);
+    }
+
+    [[nodiscard]] bool is_empty() const { return m_size == 0; }
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+
+    ErrorOr<void> try_ensure_capacity(size_t capacity)
+    {
+        if (capacity <= max_size_for_capacity(m_capacity))
+            return {};
+        size_t new_capacity = max(minimum_capacity, m_capacity);
+        while (max_size_for_capacity(new_capacity) < capacity)
+            new_capacity *= 2;
+        return try_rehash(new_capacity);
+    }
+    void ensure_capacity(size_t capacity)
+    {
+        MUST(try_ensure_capacity(capacity));
+    }
+
+    [[nodiscard]] bool contains(T const& value) const
+    {
+        return find(value) != end();
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] bool contains(K const& value) const
+    {
+        return find(value) != end();
+    }
+
+    using Iterator = SwissHashTableIterator<SwissHashTable, T>;
+    using ConstIterator = SwissHashTableIterator<SwissHashTable const, T const>;
+
+    [[nodiscard]] Iterator begin() { return Iterator(m_control_bytes, m_control_bytes + m_capacity, m_slots); }
+    [[nodiscard]] Iterator end() { return Iterator(nullptr, nullptr, nullptr); }
+    [[nodiscard]] ConstIterator begin() const { return ConstIterator(m_control_bytes, m_control_bytes + m_capacity, m_slots); }
+    [[nodiscard]] ConstIterator end() const { return ConstIterator(nullptr, nullptr, nullptr); }
+
+    void clear()
+    {
+        *this = SwissHashTable();
+    }
+
+    void clear_with_capacity()
+    {
+        if (m_capacity == 0)
+            return;
+        if constexpr (!IsTriviallyDestructible<T>) {
+            for (auto& value : *this)
+                value.~T();
+        }
+        __builtin_memset(m_control_bytes, Group::empty, m_capacity);
+        m_size = 0;
+        m_growth_left = max_size_for_capacity(m_capacity);
+    }
+
+    template<typename U = T>
+    ErrorOr<HashSetResult> try_set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        auto hash = TraitsForT::hash(value);
+        if (auto* slot = lookup_with_hash(hash, [&](auto& entry) { return TraitsForT::equals(entry, static_cast<T const&>(value)); })) {
+            if (existing_entry_behavior == HashSetExistingEntryBehavior::Replace) {
+                *slot = forward<U>(value);
+                return HashSetResult::ReplacedExistingEntry;
+            }
+            return HashSetResult::KeptExistingEntry;
+        }
+
+        if (m_growth_left == 0)
+            TRY(try_rehash_for_insertion());
+        insert_new_value(hash, forward<U>(value));
+        return HashSetResult::InsertedNewEntry;
+    }
+    template<typename U = T>
+    HashSetResult set(U&& value, HashSetExistingEntryBehavior existing_entry_behavior = HashSetExistingEntryBehavior::Replace)
+    {
+        return MUST(try_set(forward<U>(value), existing_entry_behavior));
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] Iterator find(unsigned hash, TUnaryPredicate predicate)
+    {
+        return iterator_for(lookup_with_hash(hash, move(predicate)));
+    }
+
+    [[nodiscard]] Iterator find(T const& value)
+    {
+        return find(TraitsForT::hash(value), [&](auto& entry) { return TraitsForT::equals(entry, value); });
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] ConstIterator find(unsigned hash, TUnaryPredicate predicate) const
+    {
+        return const_cast<SwissHashTable*>(this)->const_iterator_for(lookup_with_hash(hash, move(predicate)));
+    }
+
+    [[nodiscard]] ConstIterator find(T const& value) const
+    {
+        return find(TraitsForT::hash(value), [&](auto& entry) { return TraitsForT::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] Iterator find(K const& value)
+    {
+        return find(Traits<K>::hash(value), [&](auto& entry) { return Traits<T>::equals(entry, value); });
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) [[nodiscard]] ConstIterator find(K const& value) const
+    {
+        return find(Traits<K>::hash(value), [&](auto& entry) { return Traits<T>::equals(entry, value); });
+    }
+
+    bool remove(T const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    template<Concepts::HashCompatible<T> K>
+    requires(IsSame<TraitsForT, Traits<T>>) bool remove(K const& value)
+    {
+        auto it = find(value);
+        if (it != end()) {
+            remove(it);
+            return true;
+        }
+        return false;
+    }
+
+    // This invalidates the iterator
+    void remove(Iterator& iterator)
+    {
+        VERIFY(iterator.m_slot);
+        delete_slot(iterator.m_slot - m_slots);
+        iterator.m_slot = nullptr;
+    }
+
+    template<typename TUnaryPredicate>
+    bool remove_all_matching(TUnaryPredicate const& predicate)
+    {
+        bool has_removed_anything = false;
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if ((m_control_bytes[i] & Group::empty) || !predicate(m_slots[i]))
+                continue;
+            delete_slot(i);
+            has_removed_anything = true;
+        }
+        return has_removed_anything;
+    }
+
+    [[nodiscard]] Vector<T> values() const
+    {
+        Vector<T> list;
+        list.ensure_capacity(size());
+        for (auto& value : *this)
+            list.unchecked_append(value);
+        return list;
+    }
+
+private:
+    // The hashes of Traits are only 32 bits, and often not very well distributed, so they are mixed into 64 bits first.
+    // The lowest 7 bits go into the control byte, the rest chooses the group to start probing at.
+    static constexpr u64 mix_hash(unsigned hash)
+    {
+        u64 mixed = static_cast<u64>(hash) * 0x9e3779b97f4a7c15ull;
+        return mixed ^ (mixed >> 29);
+    }
+    static constexpr u8 control_byte_for_hash(u64 mixed_hash) { return mixed_hash & 0x7f; }
+
+    // Groups are probed in triangular order, which visits every group once when the number of groups is a power of two.
+    struct ProbeSequence {
+        size_t group_index;
+        size_t group_mask;
+        size_t step { 0 };
+
+        size_t offset() const { return group_index * Group::size; }
+        void next()
+        {
+            ++step;
+            group_index = (group_index + step) & group_mask;
+        }
+    };
+    ProbeSequence probe_sequence_for(u64 mixed_hash) const
+    {
+        size_t group_mask = m_capacity / Group::size - 1;
+        return { static_cast<size_t>(mixed_hash >> 7) & group_mask, group_mask };
+    }
+
+    static constexpr size_t slots_offset(size_t capacity) { return align_up_to(capacity, alignof(T)); }
+    static constexpr size_t size_in_bytes(size_t capacity) { return slots_offset(capacity) + sizeof(T) * capacity; }
+
+    Iterator iterator_for(T* slot)
+    {
+        if (!slot)
+            return end();
+        size_t index = slot - m_slots;
+        return Iterator(m_control_bytes + index, m_control_bytes + m_capacity, slot);
+    }
+    ConstIterator const_iterator_for(T* slot)
+    {
+        if (!slot)
+            return ConstIterator(nullptr, nullptr, nullptr);
+        size_t index = slot - m_slots;
+        return ConstIterator(m_control_bytes + index, m_control_bytes + m_capacity, slot);
+    }
+
+    template<typename TUnaryPredicate>
+    [[nodiscard]] T* lookup_with_hash(unsigned hash, TUnaryPredicate predicate) const
+    {
+        if (is_empty())
+            return nullptr;
+
+        auto mixed_hash = mix_hash(hash);
+        auto control_byte = control_byte_for_hash(mixed_hash);
+        for (auto probe = probe_sequence_for(mixed_hash);; probe.next()) {
+            Group group { m_control_bytes + probe.offset() };
+            for (auto matches = group.match(control_byte); matches; matches.clear_lowest()) {
+                auto* slot = &m_slots[probe.offset() + matches.lowest()];
+                if (predicate(*slot))
+                    return slot;
+            }
+            // A value is only ever placed after a group that was full at the time, so we can stop at the first empty slot.
+            if (group.match_empty())
+                return nullptr;
+        }
+    }
+
+    size_t find_first_non_full(u64 mixed_hash) const
+    {
+        for (auto probe = probe_sequence_for(mixed_hash);; probe.next()) {
+            Group group { m_control_bytes + probe.offset() };
+            if (auto matches = group.match_empty_or_deleted())
+                return probe.offset() + matches.lowest();
+        }
+    }
+
+    template<typename U>
+    void insert_new_value(unsigned hash, U&& value)
+    {
+        auto mixed_hash = mix_hash(hash);
+        auto index = find_first_non_full(mixed_hash);
+        // Reusing a deleted slot doesn't make any probe sequence longer.
+        if (m_control_bytes[index] == Group::empty)
+            --m_growth_left;
+        new (&m_slots[index]) T(forward<U>(value));
+        m_control_bytes[index] = control_byte_for_hash(mixed_hash);
+        ++m_size;
+    }
+
+    void delete_slot(size_t index)
+    {
+        VERIFY(index < m_capacity);
+        VERIFY(!(m_control_bytes[index] & Group::empty));
+
+        m_slots[index].~T();
+        --m_size;
+
+        // If the group still had an empty slot, no lookup ever continued past it, so this slot can become empty again.
+        // Otherwise, lookups for values in later groups have to keep probing past it.
+        size_t group_offset = index - index % Group::size;
+        if (Group { m_control_bytes + group_offset }.match_empty()) {
+            m_control_bytes[index] = Group::empty;
+            ++m_growth_left;
+        } else {
+            m_control_bytes[index] = Group::deleted;
+        }
+    }
+
+    ErrorOr<void> try_rehash_for_insertion()
+    {
+        // If many slots are only taken up by deleted values, it's enough to clean them up.
+        if (m_capacity != 0 && m_size < max_size_for_capacity(m_capacity) / 2)
+            return try_rehash(m_capacity);
+        return try_rehash(max(minimum_capacity, m_capacity * 2));
+    }
+
+    ErrorOr<void> try_rehash(size_t new_capacity)
+    {
+        VERIFY(is_power_of_two(new_capacity) && new_capacity >= minimum_capacity);
+        VERIFY(max_size_for_capacity(new_capacity) >= m_size);
+
+        auto* new_control_bytes = static_cast<u8*>(Allocator::allocate(size_in_bytes(new_capacity)));
+        if (!new_control_bytes)
+            return Error::from_errno(ENOMEM);
+        __builtin_memset(new_control_bytes, Group::empty, new_capacity);
+
+        auto* old_control_bytes = m_control_bytes;
+        auto* old_slots = m_slots;
+        auto old_capacity = m_capacity;
+
+        m_control_bytes = new_control_bytes;
+        m_slots = reinterpret_cast<T*>(new_control_bytes + slots_offset(new_capacity));
+        m_capacity = new_capacity;
+        m_growth_left = max_size_for_capacity(new_capacity);
+        m_size = 0;
+
+        if (!old_control_bytes)
+            return {};
+
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_control_bytes[i] & Group::empty)
+                continue;
+            insert_new_value(TraitsForT::hash(old_slots[i]), move(old_slots[i]));
+            old_slots[i].~T();
+        }
+
+        Allocator::deallocate(old_control_bytes, size_in_bytes(old_capacity));
+        return {};
+    }
+
+    u8* m_control_bytes { nullptr };
+    T* m_slots { nullptr };
+    size_t m_size { 0 };
+    size_t m_capacity { 0 };
+    // How many more values can be inserted into empty slots before the table has to grow.
+    size_t m_growth_left { 0 };
+};
+
+template<typename K, typename V, typename KeyTraits = Traits<K>, typename ValueTraits = Traits<V>>
+using SwissHashMap = HashMap<K, V, KeyTraits, ValueTraits, false, SwissHashTable>;
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::SwissHashMap;
+using AK::SwissHashTable;
+#endif
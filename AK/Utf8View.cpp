@@ -70,11 +70,35 @@ Utf8View Utf8View::unicode_substring_view(size_t code_point_offset, size_t code_
     VERIFY_NOT_REACHED();
 }
 
+size_t Utf8View::length_of_ascii_run(size_t byte_offset) const
+{
+    auto const* characters = m_string.characters_without_null_termination();
+    size_t offset = byte_offset;
+    for (; offset + ascii_chunk_size <= m_string.length(); offset += ascii_chunk_size) {
+        u64 words[ascii_chunk_size / sizeof(u64)];
+        __builtin_memcpy(words, characters + offset, sizeof(words));
+        if (((words[0] | words[1]) & 0x8080808080808080ull) != 0)
+            break;
+    }
+    return offset - byte_offset;
+}
+
 size_t Utf8View::calculate_length() const
 {
     size_t length = 0;
+    size_t next_ascii_run_check = 0;
 
     for (size_t i = 0; i < m_string.length(); ++length) {
+        if (i >= next_ascii_run_check && static_cast<u8>(m_string[i]) < 0x80) {
+            // Every ASCII character is one code point.
+            if (auto ascii_length = length_of_ascii_run(i); ascii_length > 0) {
+                i += ascii_length;
+                length += ascii_length - 1;
+                continue;
+            }
+            next_ascii_run_check = i + ascii_chunk_size;
+        }
+
         auto [byte_length, code_point, is_valid] = decode_leading_byte(static_cast<u8>(m_string[i]));
 
         // Similar to Utf8CodePointIterator::operator++, if the byte is invalid, try the next byte.
@@ -101,6 +101,11 @@ public:
     size_t byte_offset_of(Utf8CodePointIterator const&) const;
     size_t byte_offset_of(size_t code_point_offset) const;
 
+    // Runs of ASCII characters are common and don't need to be decoded one by one, so they are skipped in whole chunks.
+    static constexpr size_t ascii_chunk_size = 16;
+    // Returns how many bytes starting at the given offset are ASCII, rounded down to a multiple of ascii_chunk_size.
+    size_t length_of_ascii_run(size_t byte_offset) const;
+
     Utf8View substring_view(size_t byte_offset, size_t byte_length) const { return Utf8View { m_string.substring_view(byte_offset, byte_length) }; }
     Utf8View substring_view(size_t byte_offset) const { return substring_view(byte_offset, byte_length() - byte_offset); }
     Utf8View unicode_substring_view(size_t code_point_offset, size_t code_point_length) const;
@@ -136,8 +141,19 @@ public:
     constexpr bool validate(size_t& valid_bytes, AllowSurrogates surrogates = AllowSurrogates::Yes) const
     {
         valid_bytes = 0;
+        size_t next_ascii_run_check = 0;
 
         for (auto it = m_string.begin(); it != m_string.end(); ++it) {
+            if (!is_constant_evaluated() && it.index() >= next_ascii_run_check && static_cast<u8>(*it) < 0x80) {
+                auto ascii_length = length_of_ascii_run(it.index());
+                if (ascii_length > 0) {
+                    it = it + (ascii_length - 1);
+                    valid_bytes += ascii_length;
+                    continue;
+                }
+                next_ascii_run_check = it.index() + ascii_chunk_size;
+            }
+
             auto [byte_length, code_point, is_valid] = decode_leading_byte(static_cast<u8>(*it));
             if (!is_valid)
                 return false;
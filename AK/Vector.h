@@ -41,7 +41,7 @@ struct CanBePlacedInsideVectorHelper<StorageType, false> {
 };
 }
 
-template<typename T, size_t inline_capacity>
+template<typename T, size_t inline_capacity, typename Allocator>
 requires(!IsRvalueReference<T>) class Vector {
 private:
     static constexpr bool contains_reference = IsLvalueReference<T>;
@@ -97,8 +97,8 @@ public:
         m_size = other.size();
     }
 
-    template<size_t other_inline_capacity>
-    Vector(Vector<T, other_inline_capacity> const& other)
+    template<size_t other_inline_capacity, typename OtherAllocator>
+    Vector(Vector<T, other_inline_capacity, OtherAllocator> const& other)
     {
         ensure_capacity(other.size());
         TypedTransfer<StorageType>::copy(data(), other.data(), other.size());
@@ -376,8 +376,8 @@ public:
         return *this;
     }
 
-    template<size_t other_inline_capacity>
-    Vector& operator=(Vector<T, other_inline_capacity> const& other)
+    template<size_t other_inline_capacity, typename OtherAllocator>
+    Vector& operator=(Vector<T, other_inline_capacity, OtherAllocator> const& other)
     {
         clear();
         ensure_capacity(other.size());
@@ -390,7 +390,7 @@ public:
     {
         clear_with_capacity();
         if (m_outline_buffer) {
-            kfree_sized(m_outline_buffer, m_capacity * sizeof(StorageType));
+            Allocator::deallocate(m_outline_buffer, m_capacity * sizeof(StorageType));
             m_outline_buffer = nullptr;
         }
         reset_capacity();
@@ -674,8 +674,9 @@ public:
     {
         if (m_capacity >= needed_capacity)
             return {};
-        size_t new_capacity = kmalloc_good_size(needed_capacity * sizeof(StorageType)) / sizeof(StorageType);
-        auto* new_buffer = static_cast<StorageType*>(kmalloc_array(new_capacity, sizeof(StorageType)));
+        size_t new_capacity = Allocator::good_size(needed_capacity * sizeof(StorageType)) / sizeof(StorageType);
+        VERIFY(!Checked<size_t>::multiplication_would_overflow(new_capacity, sizeof(StorageType)));
+        auto* new_buffer = static_cast<StorageType*>(Allocator::allocate(new_capacity * sizeof(StorageType)));
         if (new_buffer == nullptr)
             return Error::from_errno(ENOMEM);
 
@@ -688,7 +689,7 @@ public:
             }
         }
         if (m_outline_buffer)
-            kfree_sized(m_outline_buffer, m_capacity * sizeof(StorageType));
+            Allocator::deallocate(m_outline_buffer, m_capacity * sizeof(StorageType));
         m_outline_buffer = new_buffer;
         m_capacity = new_capacity;
         return {};
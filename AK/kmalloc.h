@@ -53,3 +53,19 @@ inline void* kmalloc_array(AK::Checked<size_t> a, AK::Checked<size_t> b, AK::Che
     VERIFY(!size.has_overflow());
     return kmalloc(size.value());
 }
+
+namespace AK {
+
+// The allocator AK containers use unless they are given another one, see ArenaAllocator.h.
+struct KmallocAllocator {
+    static size_t good_size(size_t size) { return kmalloc_good_size(size); }
+    static void* allocate(size_t size) { return kmalloc(size); }
+    static void* allocate_zeroed(size_t size) { return kcalloc(1, size); }
+    static void deallocate(void* ptr, size_t size) { kfree_sized(ptr, size); }
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::KmallocAllocator;
+#endif
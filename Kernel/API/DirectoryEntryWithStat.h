@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+#ifdef KERNEL
+#    include <Kernel/API/POSIX/sys/stat.h>
+#else
+#    include <sys/stat.h>
+#endif
+
+// The records that get_dir_entries_with_stat() fills its buffer with, one right after the other.
+struct [[gnu::packed]] DirectoryEntryWithStat {
+    u64 inode { 0 };
+    u8 file_type { 0 };
+    // The errno that lstat() would have failed with for this entry, in which case stat is zeroed out.
+    i32 stat_error { 0 };
+    struct stat stat {};
+    u32 name_length { 0 };
+    // This is a VLA which is written during the get_dir_entries_with_stat() call. It's not null-terminated.
+    char name[];
+
+    size_t total_size() const { return sizeof(DirectoryEntryWithStat) + name_length; }
+};
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// An I/O ring is a mapping shared between a process and the kernel. The process queues operations
+// in the submission ring and hands them to the kernel with io_ring_enter(), which carries them out
+// asynchronously and posts their results to the completion ring, in whatever order they finish.
+//
+// The mapping starts with an IORingHeader, followed by the submission and completion rings at the
+// offsets given in the header. Both rings are indexed with free-running counters that wrap around,
+// the slot for a counter value is (value & (entries - 1)).
+
+enum class IORingOperation : u8 {
+    Nop,
+    Read,
+    Write,
+    Fsync,
+    // Completes once the file is ready for any of the given poll() events.
+    Poll,
+};
+
+struct IORingSubmission {
+    IORingOperation operation;
+    u8 reserved;
+    // For Poll, the events to wait for (only POLLIN and POLLOUT are supported).
+    u16 poll_events;
+    i32 fd;
+    // For Read and Write, the offset in the file, or -1 to use (and advance) the file offset.
+    i64 offset;
+    u64 buffer;
+    u64 length;
+    // Handed back untouched in the completion of this operation.
+    u64 user_data;
+};
+
+struct IORingCompletion {
+    u64 user_data;
+    // What the equivalent syscall would have returned, or a negated errno.
+    i64 result;
+};
+
+struct IORingHeader {
+    // Userspace advances the submission tail after filling in submissions, the kernel advances the head as it takes them.
+    u32 submission_head;
+    u32 submission_tail;
+    // The kernel advances the completion tail as operations finish, userspace advances the head as it reaps them.
+    u32 completion_head;
+    u32 completion_tail;
+    u32 submission_entries;
+    u32 completion_entries;
+    u32 submissions_offset;
+    u32 completions_offset;
+};
+
+// There are twice as many completion slots as submission slots, so a full submission ring can be
+// handed to the kernel while the results of an earlier one are still waiting to be reaped.
+static constexpr u32 io_ring_max_entries = 4096;
+
+static constexpr u32 io_ring_completion_entries(u32 entries)
+{
+    return entries * 2;
+}
+
+static constexpr size_t io_ring_submissions_offset()
+{
+    return (sizeof(IORingHeader) + 63) & ~static_cast<size_t>(63);
+}
+
+static constexpr size_t io_ring_completions_offset(u32 entries)
+{
+    return io_ring_submissions_offset() + entries * sizeof(IORingSubmission);
+}
+
+// The size of the mapping for a ring with the given number of submission entries.
+static constexpr size_t io_ring_size(u32 entries)
+{
+    return io_ring_completions_offset(entries) + io_ring_completion_entries(entries) * sizeof(IORingCompletion);
+}
@@ -22,6 +22,8 @@ extern "C" {
 #define F_SETLK 7
 #define F_SETLKW 8
 #define F_DUPFD_CLOEXEC 9
+#define F_GETPIPE_SZ 10
+#define F_SETPIPE_SZ 11
 
 #define FD_CLOEXEC 1
 
@@ -41,6 +43,12 @@ extern "C" {
 #define O_CLOEXEC (1 << 11)
 #define O_DIRECT (1 << 12)
 #define O_SYNC (1 << 13)
+// Together with O_DIRECT, block device transfers are waited for by polling the device for a short while before sleeping.
+#define O_HIPRI (1 << 14)
+
+#define SPLICE_F_MOVE (1 << 0)
+#define SPLICE_F_NONBLOCK (1 << 1)
+#define SPLICE_F_MORE (1 << 2)
 
 #define F_RDLCK ((short)0)
 #define F_WRLCK ((short)1)
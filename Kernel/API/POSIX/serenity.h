@@ -33,9 +33,16 @@ enum {
     PERF_EVENT_SYSCALL = 16384,
     PERF_EVENT_SIGNPOST = 32768,
     PERF_EVENT_FILESYSTEM = 65536,
+    PERF_EVENT_SCHEDULING_LATENCY = 131072,
+    PERF_EVENT_CPU_CYCLES = 262144,
+    PERF_EVENT_INSTRUCTIONS_RETIRED = 524288,
+    PERF_EVENT_CACHE_MISS = 1048576,
+    PERF_EVENT_BRANCH_MISS = 2097152,
+    PERF_EVENT_TRACEPOINT = 4194304,
 };
 
 #define PERF_EVENT_MASK_ALL (~0ull)
+#define PERF_EVENT_MASK_HARDWARE_SAMPLES (PERF_EVENT_CPU_CYCLES | PERF_EVENT_INSTRUCTIONS_RETIRED | PERF_EVENT_CACHE_MISS | PERF_EVENT_BRANCH_MISS)
 
 #define THREAD_PRIORITY_MIN 1
 #define THREAD_PRIORITY_LOW 10
@@ -43,6 +50,19 @@ enum {
 #define THREAD_PRIORITY_HIGH 50
 #define THREAD_PRIORITY_MAX 99
 
+#define SYSCALL_BATCH_MAX_ENTRIES 64
+
+// One syscall of a syscall_batch() call.
+struct syscall_batch_entry {
+    uint32_t function;
+    // The index of an earlier entry whose result is passed as the first argument instead of args[0], or -1.
+    // If that entry failed, this one isn't run and fails with ECANCELED.
+    int32_t arg1_from;
+    uintptr_t args[4];
+    // Written by the kernel: the return value of the syscall, or the negated errno it failed with.
+    intptr_t result;
+};
+
 #ifdef __cplusplus
 }
 #endif
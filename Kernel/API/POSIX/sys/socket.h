@@ -147,6 +147,7 @@ enum {
     SO_OOBINLINE,
     SO_SNDLOWAT,
     SO_RCVLOWAT,
+    SO_REUSEPORT,
 };
 #define SO_RCVTIMEO SO_RCVTIMEO
 #define SO_SNDTIMEO SO_SNDTIMEO
@@ -167,6 +168,7 @@ enum {
 #define SO_OOBINLINE SO_OOBINLINE
 #define SO_SNDLOWAT SO_SNDLOWAT
 #define SO_RCVLOWAT SO_RCVLOWAT
+#define SO_REUSEPORT SO_REUSEPORT
 
 enum {
     SCM_TIMESTAMP,
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// A perfcore file starts with a PerfcoreHeader, followed by a stream of records that each start with a
+// PerfcoreRecordHeader. A string record always comes before the first event that refers to it, and events
+// are sorted by their timestamp, so a reader can process the file front to back in a single pass.
+// Every record is padded to a multiple of 8 bytes, and all fields are in the byte order of the machine that
+// recorded the profile. See perfcore(5).
+
+#define PERFCORE_MAGIC "PERFCORE"
+#define PERFCORE_VERSION 1
+#define PERFCORE_RECORD_ALIGNMENT 8
+
+struct [[gnu::packed]] PerfcoreHeader {
+    char magic[8];
+    u32 version;
+    u32 reserved;
+};
+
+enum class PerfcoreRecordType : u16 {
+    String = 1,
+    Event = 2,
+    DroppedEvents = 3,
+};
+
+struct [[gnu::packed]] PerfcoreRecordHeader {
+    PerfcoreRecordType type;
+    u16 reserved;
+    // The size of the whole record, including this header and the padding at the end.
+    u32 size;
+};
+
+struct [[gnu::packed]] PerfcoreStringRecord {
+    PerfcoreRecordHeader header;
+    // The index that signposts and filesystem events use to refer to this string.
+    u32 index;
+    u32 length;
+    // Followed by the characters of the string, without a null terminator.
+};
+
+struct [[gnu::packed]] PerfcoreEventRecord {
+    PerfcoreRecordHeader header;
+    // One of the PERF_EVENT_* types.
+    u32 type;
+    i32 pid;
+    i32 tid;
+    // The number of samples that couldn't be taken since the previous sample of this thread.
+    u32 lost_samples;
+    // In nanoseconds since boot. Events are ordered by their timestamp, events that were recorded on the
+    // same processor are also in the order they were recorded in.
+    u64 timestamp_ns;
+    // The number of return addresses that follow this struct, as u64s, innermost frame first.
+    u16 stack_size;
+    // The size of the type-specific data that follows the stack.
+    u16 data_size;
+    u32 reserved;
+};
+
+// Written after all events, for every processor that had to drop events because the profile buffer was full.
+struct [[gnu::packed]] PerfcoreDroppedEventsRecord {
+    PerfcoreRecordHeader header;
+    u32 processor;
+    u32 reserved;
+    u64 count;
+};
+
+// PERF_EVENT_MALLOC, PERF_EVENT_FREE, PERF_EVENT_MMAP, PERF_EVENT_MUNMAP, PERF_EVENT_KMALLOC, PERF_EVENT_KFREE.
+// For PERF_EVENT_MMAP, this is followed by the name of the region, which takes up the rest of the data.
+struct [[gnu::packed]] PerfcoreMemoryEventData {
+    u64 ptr;
+    u64 size;
+};
+
+// PERF_EVENT_PROCESS_CREATE. This is followed by the path of the executable, which takes up the rest of the data.
+// PERF_EVENT_PROCESS_EXEC events only carry the path of the executable.
+struct [[gnu::packed]] PerfcoreProcessCreateEventData {
+    i32 parent_pid;
+};
+
+// PERF_EVENT_THREAD_CREATE
+struct [[gnu::packed]] PerfcoreThreadCreateEventData {
+    i32 parent_tid;
+};
+
+// PERF_EVENT_CONTEXT_SWITCH
+struct [[gnu::packed]] PerfcoreContextSwitchEventData {
+    i32 next_pid;
+    i32 next_tid;
+};
+
+// PERF_EVENT_SCHEDULING_LATENCY
+struct [[gnu::packed]] PerfcoreSchedulingLatencyEventData {
+    u64 latency_ns;
+    u32 cpu;
+};
+
+// PERF_EVENT_CPU_CYCLES, PERF_EVENT_INSTRUCTIONS_RETIRED, PERF_EVENT_CACHE_MISS, PERF_EVENT_BRANCH_MISS.
+struct [[gnu::packed]] PerfcoreHardwareSampleEventData {
+    // The number of hardware events this sample stands for.
+    u64 period;
+    u32 cpu;
+};
+
+// PERF_EVENT_SIGNPOST
+struct [[gnu::packed]] PerfcoreSignpostEventData {
+    u64 string_index;
+    u64 arg;
+};
+
+// PERF_EVENT_TRACEPOINT. This is followed by the name of the tracepoint, which takes up the rest of the data.
+struct [[gnu::packed]] PerfcoreTracepointEventData {
+    u64 arg1;
+    u64 arg2;
+};
+
+enum class PerfcoreFilesystemEventType : u8 {
+    Open,
+    Close,
+    Preadv,
+    Read,
+    Pread,
+};
+
+// PERF_EVENT_FILESYSTEM. Fields that don't apply to the type of the event are zero.
+struct [[gnu::packed]] PerfcoreFilesystemEventData {
+    PerfcoreFilesystemEventType type;
+    u64 duration_ns;
+    // The directory file descriptor for open events.
+    i32 fd;
+    u32 filename_index;
+    i32 options;
+    u64 mode;
+    i64 offset;
+    u64 buffer_ptr;
+    u64 size;
+};
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// How userspace can find out which processor it's running on without a syscall.
+enum class ProcessorIDSource : u32 {
+    // Only through the getcpu syscall.
+    None,
+    // The kernel puts the processor ID into IA32_TSC_AUX, which RDPID reads.
+    RDPID,
+    // The same, but through RDTSCP, which also reads the time stamp counter.
+    RDTSCP,
+};
+
+struct ProcessPageData {
+    i32 pid;
+    i32 ppid;
+    u32 uid;
+    u32 euid;
+    u32 gid;
+    u32 egid;
+    ProcessorIDSource processor_id_source;
+};
+
+// A page that the kernel keeps up to date for every process that maps it with map_process_page, so LibC can
+// answer getuid() and friends without a syscall. The mapping is moved over to the child's own page on fork().
+// Like with the TimePage, readers retry while update1 and update2 differ.
+struct ProcessPage {
+    u32 volatile update1;
+    ProcessPageData data;
+    u32 volatile update2;
+};
+
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+
+// The binary format of /sys/kernel/process_statistics, which has the same data as the JSON in /sys/kernel/processes.
+// It starts with a ProcessStatisticsHeader, followed by a ProcessStatisticsRecord for every process until the end of
+// the file. Each of those is followed by the executable path and the pledge promises of the process (without null
+// terminators), padded to a multiple of 8 bytes, and then by a ThreadStatisticsRecord for every thread of the process.
+// Fixed-size strings are null-terminated.
+
+#define PROCESS_STATISTICS_MAGIC "PROCSTAT"
+#define PROCESS_STATISTICS_VERSION 1
+#define PROCESS_STATISTICS_RECORD_ALIGNMENT 8
+
+struct [[gnu::packed]] ProcessStatisticsHeader {
+    char magic[8];
+    u32 version;
+    u32 reserved;
+    u64 total_time;
+    u64 total_time_kernel;
+};
+
+enum class ProcessStatisticsVeilState : u8 {
+    None,
+    Dropped,
+    Locked,
+};
+
+struct [[gnu::packed]] ProcessStatisticsRecord {
+    // The size of the whole record, including the strings and thread records that follow it.
+    u32 size;
+    i32 pid;
+    // The process group of the controlling terminal.
+    i32 pgid;
+    i32 pgp;
+    i32 sid;
+    u32 uid;
+    u32 gid;
+    i32 ppid;
+    u8 kernel;
+    u8 dumpable;
+    ProcessStatisticsVeilState veil;
+    u8 reserved;
+    u32 thread_count;
+    u16 executable_length;
+    u16 pledge_length;
+    u32 reserved2;
+    i64 creation_time_ns;
+    u64 amount_virtual;
+    u64 amount_resident;
+    u64 amount_shared;
+    u64 amount_dirty_private;
+    u64 amount_clean_inode;
+    u64 amount_purgeable_volatile;
+    u64 amount_purgeable_nonvolatile;
+    char name[32];
+    char tty[32];
+};
+
+struct [[gnu::packed]] ThreadStatisticsRecord {
+    i32 tid;
+    u32 cpu;
+    u32 priority;
+    u32 times_scheduled;
+    u32 migration_count;
+    u32 syscall_count;
+    u32 inode_faults;
+    u32 zero_faults;
+    u32 cow_faults;
+    u32 reserved;
+    u64 time_user;
+    u64 time_kernel;
+    u64 scheduling_latency_count;
+    u64 scheduling_latency_total_ns;
+    u64 scheduling_latency_max_ns;
+    u64 file_read_bytes;
+    u64 file_write_bytes;
+    u64 unix_socket_read_bytes;
+    u64 unix_socket_write_bytes;
+    u64 ipv4_socket_read_bytes;
+    u64 ipv4_socket_write_bytes;
+    char state[16];
+    char name[64];
+};
+
+static_assert(sizeof(ProcessStatisticsHeader) % PROCESS_STATISTICS_RECORD_ALIGNMENT == 0);
+static_assert(sizeof(ProcessStatisticsRecord) % PROCESS_STATISTICS_RECORD_ALIGNMENT == 0);
+static_assert(sizeof(ThreadStatisticsRecord) % PROCESS_STATISTICS_RECORD_ALIGNMENT == 0);
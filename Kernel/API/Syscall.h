@@ -14,9 +14,11 @@
 #ifdef KERNEL
 #    include <AK/Error.h>
 #    include <Kernel/Arch/RegisterState.h>
+#    include <Kernel/Forward.h>
 #endif
 
 extern "C" {
+struct epoll_event;
 struct pollfd;
 struct timeval;
 struct timespec;
@@ -61,6 +63,7 @@ enum class NeedsBigProcessLock {
     S(clock_settime, NeedsBigProcessLock::No)              \
     S(close, NeedsBigProcessLock::No)                      \
     S(connect, NeedsBigProcessLock::No)                    \
+    S(copy_file_range, NeedsBigProcessLock::Yes)           \
     S(copy_mount, NeedsBigProcessLock::No)                 \
     S(create_inode_watcher, NeedsBigProcessLock::No)       \
     S(create_thread, NeedsBigProcessLock::No)              \
@@ -69,6 +72,9 @@ enum class NeedsBigProcessLock {
     S(disown, NeedsBigProcessLock::No)                     \
     S(dump_backtrace, NeedsBigProcessLock::No)             \
     S(dup2, NeedsBigProcessLock::No)                       \
+    S(epoll_create, NeedsBigProcessLock::No)               \
+    S(epoll_ctl, NeedsBigProcessLock::No)                  \
+    S(epoll_wait, NeedsBigProcessLock::No)                 \
     S(execve, NeedsBigProcessLock::Yes)                    \
     S(exit, NeedsBigProcessLock::Yes)                      \
     S(exit_thread, NeedsBigProcessLock::Yes)               \
@@ -84,11 +90,13 @@ enum class NeedsBigProcessLock {
     S(fsmount, NeedsBigProcessLock::No)                    \
     S(fsync, NeedsBigProcessLock::No)                      \
     S(ftruncate, NeedsBigProcessLock::No)                  \
-    S(futex, NeedsBigProcessLock::Yes)                     \
+    S(futex, NeedsBigProcessLock::No)                      \
     S(futimens, NeedsBigProcessLock::No)                   \
     S(get_dir_entries, NeedsBigProcessLock::No)            \
+    S(get_dir_entries_with_stat, NeedsBigProcessLock::No)  \
     S(get_root_session_id, NeedsBigProcessLock::No)        \
     S(get_stack_bounds, NeedsBigProcessLock::No)           \
+    S(getcpu, NeedsBigProcessLock::No)                     \
     S(getcwd, NeedsBigProcessLock::No)                     \
     S(getegid, NeedsBigProcessLock::No)                    \
     S(geteuid, NeedsBigProcessLock::No)                    \
@@ -112,6 +120,8 @@ enum class NeedsBigProcessLock {
     S(getuid, NeedsBigProcessLock::No)                     \
     S(inode_watcher_add_watch, NeedsBigProcessLock::No)    \
     S(inode_watcher_remove_watch, NeedsBigProcessLock::No) \
+    S(io_ring_create, NeedsBigProcessLock::No)             \
+    S(io_ring_enter, NeedsBigProcessLock::No)              \
     S(ioctl, NeedsBigProcessLock::No)                      \
     S(join_thread, NeedsBigProcessLock::No)                \
     S(kill, NeedsBigProcessLock::No)                       \
@@ -121,6 +131,7 @@ enum class NeedsBigProcessLock {
     S(listen, NeedsBigProcessLock::No)                     \
     S(lseek, NeedsBigProcessLock::No)                      \
     S(madvise, NeedsBigProcessLock::No)                    \
+    S(map_process_page, NeedsBigProcessLock::No)           \
     S(map_time_page, NeedsBigProcessLock::No)              \
     S(mkdir, NeedsBigProcessLock::No)                      \
     S(mknod, NeedsBigProcessLock::No)                      \
@@ -182,10 +193,12 @@ enum class NeedsBigProcessLock {
     S(sigtimedwait, NeedsBigProcessLock::No)               \
     S(socket, NeedsBigProcessLock::No)                     \
     S(socketpair, NeedsBigProcessLock::No)                 \
+    S(splice, NeedsBigProcessLock::Yes)                    \
     S(stat, NeedsBigProcessLock::No)                       \
     S(statvfs, NeedsBigProcessLock::No)                    \
     S(symlink, NeedsBigProcessLock::No)                    \
     S(sync, NeedsBigProcessLock::No)                       \
+    S(syscall_batch, NeedsBigProcessLock::No)              \
     S(sysconf, NeedsBigProcessLock::No)                    \
     S(times, NeedsBigProcessLock::No)                      \
     S(umask, NeedsBigProcessLock::No)                      \
@@ -216,6 +229,14 @@ enum Function {
         __Count
 };
 
+#ifdef KERNEL
+// How often each syscall was made on the given processor.
+u64 call_count(u32 processor, Function);
+
+// Runs a single syscall of a syscall_batch() call on behalf of the current thread.
+ErrorOr<FlatPtr> handle_batched(Process&, FlatPtr function, FlatPtr arg1, FlatPtr arg2, FlatPtr arg3, FlatPtr arg4);
+#endif
+
 #ifdef AK_OS_SERENITY
 struct StringArgument {
     char const* characters;
@@ -265,6 +286,14 @@ struct SC_poll_params {
     u32 const* sigmask;
 };
 
+struct SC_epoll_wait_params {
+    int epoll_fd;
+    struct epoll_event* events;
+    int max_events;
+    const struct timespec* timeout;
+    u32 const* sigmask;
+};
+
 struct SC_clock_nanosleep_params {
     int clock_id;
     int flags;
@@ -487,6 +516,27 @@ struct SC_utimensat_params {
     int flag;
 };
 
+enum class PosixSpawnFileActionType : u32 {
+    Open,
+    Close,
+    Dup2,
+    Chdir,
+    Fchdir,
+};
+
+// The serialized file actions of posix_spawn are an array of these, which are applied to the child in order.
+struct SC_posix_spawn_file_action {
+    PosixSpawnFileActionType type;
+    int fd;
+    // The file descriptor that fd is duplicated to for Dup2.
+    int new_fd;
+    // The options and mode for Open.
+    int options;
+    u16 mode;
+    // The path for Open and Chdir.
+    StringArgument path;
+};
+
 struct SC_posix_spawn_params {
     StringArgument path;
     StringListArgument arguments;
@@ -509,6 +559,24 @@ struct SC_waitid_params {
     int options;
 };
 
+struct SC_copy_file_range_params {
+    int fd_in;
+    off_t* offset_in;
+    int fd_out;
+    off_t* offset_out;
+    size_t length;
+    unsigned flags;
+};
+
+struct SC_splice_params {
+    int fd_in;
+    off_t* offset_in;
+    int fd_out;
+    off_t* offset_out;
+    size_t length;
+    unsigned flags;
+};
+
 struct SC_stat_params {
     StringArgument path;
     struct stat* statbuf;
@@ -559,6 +627,8 @@ struct SC_scheduler_parameters_params {
     pid_t pid_or_tid;
     SchedulerParametersMode mode;
     struct sched_param parameters;
+    // One of the SCHED_* policies, or -1 to leave the policy unchanged when setting parameters.
+    int policy;
 };
 
 struct SC_faccessat_params {
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <Kernel/API/POSIX/serenity.h>
+#include <Kernel/Arch/PerformanceCounters.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/Tasks/PerformanceManager.h>
+
+namespace Kernel {
+
+static constexpr Array<u64, PerformanceCounters::hardware_event_count> s_perf_event_types = {
+    PERF_EVENT_CPU_CYCLES,
+    PERF_EVENT_INSTRUCTIONS_RETIRED,
+    PERF_EVENT_CACHE_MISS,
+    PERF_EVENT_BRANCH_MISS,
+};
+
+// Chosen so that a busy processor records a sample about as often as the profile timer fires.
+// FIXME: Let the profiler pick the sampling periods.
+static constexpr Array<u64, PerformanceCounters::hardware_event_count> s_sampling_periods = {
+    2'000'000,
+    2'000'000,
+    10'000,
+    10'000,
+};
+
+static u64 s_supported_event_mask;
+static Array<Atomic<u32>, PerformanceCounters::hardware_event_count> s_sampling_enable_counts;
+static Atomic<u32> s_configuration_generation;
+
+struct PerformanceCountersData {
+    static ProcessorSpecificDataID processor_specific_data_id() { return ProcessorSpecificDataID::PerformanceCounters; }
+
+    bool is_available { false };
+    u32 configuration_generation { 0 };
+    u32 running_counters { 0 };
+};
+
+void PerformanceCounters::initialize()
+{
+    ProcessorSpecific<PerformanceCountersData>::initialize();
+    auto& data = ProcessorSpecific<PerformanceCountersData>::get();
+    data.is_available = arch_initialize_performance_counters();
+
+    if (!Processor::is_bootstrap_processor() || !data.is_available)
+        return;
+    for (size_t i = 0; i < hardware_event_count; ++i) {
+        if (arch_performance_counter_is_supported(static_cast<HardwareEvent>(i)))
+            s_supported_event_mask |= s_perf_event_types[i];
+    }
+    dmesgln("PerformanceCounters: Hardware event sampling available (event mask {:#x})", s_supported_event_mask);
+}
+
+u64 PerformanceCounters::enable_sampling(u64 event_mask)
+{
+    u64 enabled_events = 0;
+    for (size_t i = 0; i < hardware_event_count; ++i) {
+        if ((event_mask & s_supported_event_mask & s_perf_event_types[i]) == 0)
+            continue;
+        s_sampling_enable_counts[i].fetch_add(1);
+        enabled_events |= s_perf_event_types[i];
+    }
+    if (enabled_events != 0)
+        s_configuration_generation.fetch_add(1, AK::MemoryOrder::memory_order_release);
+    return enabled_events;
+}
+
+void PerformanceCounters::disable_sampling(u64 event_mask)
+{
+    bool did_disable = false;
+    for (size_t i = 0; i < hardware_event_count; ++i) {
+        if ((event_mask & s_supported_event_mask & s_perf_event_types[i]) == 0)
+            continue;
+        auto previous_count = s_sampling_enable_counts[i].fetch_sub(1);
+        VERIFY(previous_count > 0);
+        did_disable = true;
+    }
+    if (did_disable)
+        s_configuration_generation.fetch_add(1, AK::MemoryOrder::memory_order_release);
+}
+
+void PerformanceCounters::update_current_processor()
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    auto& data = ProcessorSpecific<PerformanceCountersData>::get();
+    if (!data.is_available)
+        return;
+
+    auto generation = s_configuration_generation.load(AK::MemoryOrder::memory_order_acquire);
+    if (generation == data.configuration_generation)
+        return;
+    data.configuration_generation = generation;
+
+    for (size_t i = 0; i < hardware_event_count; ++i) {
+        auto event = static_cast<HardwareEvent>(i);
+        bool should_run = s_sampling_enable_counts[i].load() > 0;
+        bool is_running = (data.running_counters & (1u << i)) != 0;
+        if (should_run && !is_running) {
+            arch_start_performance_counter(event, s_sampling_periods[i]);
+            data.running_counters |= 1u << i;
+        } else if (!should_run && is_running) {
+            arch_stop_performance_counter(event);
+            data.running_counters &= ~(1u << i);
+        }
+    }
+}
+
+void PerformanceCounters::handle_overflow_interrupt()
+{
+    auto& data = ProcessorSpecific<PerformanceCountersData>::get();
+    auto overflowed_counters = arch_take_overflowed_performance_counters() & data.running_counters;
+    if (overflowed_counters == 0)
+        return;
+
+    auto* current_thread = Thread::current();
+    // FIXME: Like the profile timer, we don't collect samples while idle.
+    bool should_sample = current_thread && current_thread != Processor::idle_thread() && current_thread->current_trap();
+
+    for (size_t i = 0; i < hardware_event_count; ++i) {
+        if ((overflowed_counters & (1u << i)) == 0)
+            continue;
+        arch_reload_performance_counter(static_cast<HardwareEvent>(i), s_sampling_periods[i]);
+        if (should_sample)
+            PerformanceManager::add_hardware_sample_event(*current_thread, *current_thread->current_trap()->regs, s_perf_event_types[i], s_sampling_periods[i]);
+    }
+}
+
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/StdLibExtras.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+enum class HardwareEvent : u8 {
+    CPUCycles,
+    InstructionsRetired,
+    CacheMisses,
+    BranchMisses,
+    __Count,
+};
+
+// Programmable counters on each processor that interrupt it after a number of hardware events,
+// so profiles can be sampled on cache misses or branch mispredictions instead of only on a timer.
+class PerformanceCounters {
+public:
+    static constexpr size_t hardware_event_count = to_underlying(HardwareEvent::__Count);
+
+    // Must be called once on every processor.
+    static void initialize();
+
+    // Takes a reference on sampling every hardware event in the PERF_EVENT_* mask that this machine can count,
+    // and returns the mask of events it took a reference on.
+    static u64 enable_sampling(u64 event_mask);
+    static void disable_sampling(u64 event_mask);
+
+    // Applies the changes made by enable_sampling() and disable_sampling() to the current processor.
+    static void update_current_processor();
+
+    static void handle_overflow_interrupt();
+};
+
+// These are implemented per architecture. Counter i always counts HardwareEvent i.
+bool arch_initialize_performance_counters();
+bool arch_performance_counter_is_supported(HardwareEvent);
+void arch_start_performance_counter(HardwareEvent, u64 period);
+void arch_stop_performance_counter(HardwareEvent);
+void arch_reload_performance_counter(HardwareEvent, u64 period);
+// Returns a mask with bit i set if counter i overflowed, and acknowledges the overflows.
+u32 arch_take_overflowed_performance_counters();
+
+}
@@ -77,6 +77,8 @@ public:
 
     [[noreturn]] static void halt();
     void wait_for_interrupt() const;
+    // Atomically enables interrupts and waits for one, so an interrupt arriving in between can't be missed.
+    void enable_interrupts_and_wait_for_interrupt() const;
     ALWAYS_INLINE static void pause();
     ALWAYS_INLINE static void wait_check();
 
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <Kernel/Arch/PerformanceCounters.h>
+#include <Kernel/Arch/aarch64/Registers.h>
+#include <Kernel/Firmware/DeviceTree/DeviceTree.h>
+#include <Kernel/Firmware/DeviceTree/Driver.h>
+#include <Kernel/Firmware/DeviceTree/Management.h>
+#include <Kernel/Interrupts/IRQHandler.h>
+
+// https://developer.arm.com/documentation/ddi0487/latest/, D13 "The Performance Monitors Extension"
+namespace Kernel {
+
+#define DEFINE_PMU_REGISTER_ACCESSORS(name)                                 \
+    [[maybe_unused]] static u64 read_##name()                               \
+    {                                                                       \
+        u64 value;                                                          \
+        asm volatile("mrs %[value], " #name : [value] "=r"(value));         \
+        return value;                                                       \
+    }                                                                       \
+    [[maybe_unused]] static void write_##name(u64 value)                    \
+    {                                                                       \
+        asm volatile("msr " #name ", %[value]\n"                            \
+                     "isb" ::[value] "r"(value));                           \
+    }
+
+DEFINE_PMU_REGISTER_ACCESSORS(pmcr_el0)
+DEFINE_PMU_REGISTER_ACCESSORS(pmceid0_el0)
+DEFINE_PMU_REGISTER_ACCESSORS(pmcntenset_el0)
+DEFINE_PMU_REGISTER_ACCESSORS(pmcntenclr_el0)
+DEFINE_PMU_REGISTER_ACCESSORS(pmintenset_el1)
+DEFINE_PMU_REGISTER_ACCESSORS(pmintenclr_el1)
+DEFINE_PMU_REGISTER_ACCESSORS(pmovsclr_el0)
+DEFINE_PMU_REGISTER_ACCESSORS(pmselr_el0)
+DEFINE_PMU_REGISTER_ACCESSORS(pmxevtyper_el0)
+DEFINE_PMU_REGISTER_ACCESSORS(pmxevcntr_el0)
+
+#undef DEFINE_PMU_REGISTER_ACCESSORS
+
+#define PMCR_E (1 << 0)
+#define PMCR_P (1 << 1)
+#define PMCR_N_SHIFT 11
+#define PMCR_N_MASK 0x1f
+
+// The common architectural and microarchitectural event numbers.
+static constexpr Array<u16, PerformanceCounters::hardware_event_count> s_event_numbers = {
+    0x11, // CPU_CYCLES
+    0x08, // INST_RETIRED
+    0x03, // L1D_CACHE_REFILL
+    0x10, // BR_MIS_PRED
+};
+
+static u32 s_counter_count;
+static u64 s_implemented_common_events;
+
+bool arch_initialize_performance_counters()
+{
+    auto pmu_version = Aarch64::ID_AA64DFR0_EL1::read().PMUVer;
+    // 0b0000 means there's no PMU, 0b1111 means there's only an IMPLEMENTATION DEFINED one.
+    if (pmu_version == 0b0000 || pmu_version == 0b1111)
+        return false;
+
+    s_counter_count = (read_pmcr_el0() >> PMCR_N_SHIFT) & PMCR_N_MASK;
+    s_implemented_common_events = read_pmceid0_el0();
+
+    write_pmcntenclr_el0(0xffffffff);
+    write_pmintenclr_el1(0xffffffff);
+    write_pmovsclr_el0(0xffffffff);
+    write_pmcr_el0(read_pmcr_el0() | PMCR_E | PMCR_P);
+    return s_counter_count > 0;
+}
+
+bool arch_performance_counter_is_supported(HardwareEvent event)
+{
+    auto index = to_underlying(event);
+    if (index >= s_counter_count)
+        return false;
+    // PMCEID0_EL0 bit n is set if common event n is implemented.
+    return (s_implemented_common_events & (1ull << s_event_numbers[index])) != 0;
+}
+
+static void select_counter(size_t index)
+{
+    write_pmselr_el0(index);
+}
+
+void arch_start_performance_counter(HardwareEvent event, u64 period)
+{
+    auto index = to_underlying(event);
+    select_counter(index);
+    // Leaving the filter bits clear counts at both EL0 and EL1.
+    write_pmxevtyper_el0(s_event_numbers[index]);
+    arch_reload_performance_counter(event, period);
+    write_pmovsclr_el0(1u << index);
+    write_pmintenset_el1(1u << index);
+    write_pmcntenset_el0(1u << index);
+}
+
+void arch_stop_performance_counter(HardwareEvent event)
+{
+    auto index = to_underlying(event);
+    write_pmcntenclr_el0(1u << index);
+    write_pmintenclr_el1(1u << index);
+    write_pmovsclr_el0(1u << index);
+}
+
+void arch_reload_performance_counter(HardwareEvent event, u64 period)
+{
+    // The event counters are 32 bits wide unless FEAT_PMUv3p5 is implemented and enabled, which we don't do.
+    period = min(period, static_cast<u64>(NumericLimits<u32>::max()));
+    select_counter(to_underlying(event));
+    write_pmxevcntr_el0(static_cast<u32>(-period));
+}
+
+u32 arch_take_overflowed_performance_counters()
+{
+    u32 counter_mask = (1u << min(s_counter_count, PerformanceCounters::hardware_event_count)) - 1;
+    u32 overflowed_counters = read_pmovsclr_el0() & counter_mask;
+    write_pmovsclr_el0(overflowed_counters);
+    return overflowed_counters;
+}
+
+class PMUv3InterruptHandler final : public IRQHandler {
+public:
+    static ErrorOr<void> initialize(u8 interrupt_number)
+    {
+        auto* handler = new (nothrow) PMUv3InterruptHandler(interrupt_number);
+        if (!handler)
+            return ENOMEM;
+        handler->enable_irq();
+        return {};
+    }
+
+    virtual bool handle_irq() override
+    {
+        PerformanceCounters::handle_overflow_interrupt();
+        return true;
+    }
+
+    virtual StringView purpose() const override { return "Performance Counter Overflow Handler"sv; }
+
+private:
+    explicit PMUv3InterruptHandler(u8 interrupt_number)
+        : IRQHandler(interrupt_number)
+    {
+    }
+};
+
+static constinit Array const compatibles_array = {
+    "arm,armv8-pmuv3"sv,
+    "arm,cortex-a53-pmu"sv,
+    "arm,cortex-a57-pmu"sv,
+    "arm,cortex-a72-pmu"sv,
+    "arm,cortex-a76-pmu"sv,
+};
+
+DEVICETREE_DRIVER(PMUv3Driver, compatibles_array);
+
+// https://www.kernel.org/doc/Documentation/devicetree/bindings/arm/pmu.yaml
+ErrorOr<void> PMUv3Driver::probe(DeviceTree::Device const& device, StringView) const
+{
+    auto const interrupts = TRY(device.node().interrupts(DeviceTree::get()));
+    if (interrupts.is_empty())
+        return ENOTSUP;
+
+    auto const& interrupt = interrupts[0];
+
+    // FIXME: Don't depend on a specific interrupt descriptor format and implement proper devicetree interrupt mapping/translation.
+    //        Some SoCs also route the overflow interrupt of every core to its own SPI, which we don't support yet.
+    if (!interrupt.domain_root->is_compatible_with("arm,gic-400"sv) && !interrupt.domain_root->is_compatible_with("arm,cortex-a15-gic"sv))
+        return ENOTSUP;
+    if (interrupt.interrupt_identifier.size() != 3 * sizeof(BigEndian<u32>))
+        return ENOTSUP;
+
+    // The interrupt type is in the first cell. It should be 1 for PPIs.
+    if (reinterpret_cast<BigEndian<u32> const*>(interrupt.interrupt_identifier.data())[0] != 1)
+        return ENOTSUP;
+
+    // The interrupt number is in the second cell.
+    // GIC interrupts 16-31 are for PPIs, so add 16 to get the GIC interrupt ID.
+    auto interrupt_number = (reinterpret_cast<BigEndian<u32> const*>(interrupt.interrupt_identifier.data())[1]) + 16;
+
+    return PMUv3InterruptHandler::initialize(interrupt_number);
+}
+
+}
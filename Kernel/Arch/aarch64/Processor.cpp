@@ -476,6 +476,15 @@ void ProcessorBase<T>::wait_for_interrupt() const
     asm("wfi");
 }
 
+template<typename T>
+void ProcessorBase<T>::enable_interrupts_and_wait_for_interrupt() const
+{
+    // NOTE: wfi also wakes up for pending interrupts that are currently masked,
+    //       which we then take as soon as interrupts are enabled again.
+    asm("wfi");
+    enable_interrupts();
+}
+
 template<typename T>
 Processor& ProcessorBase<T>::by_id(u32 id)
 {
@@ -9,6 +9,7 @@
 #include <AK/Types.h>
 #include <Kernel/Arch/CPU.h>
 #include <Kernel/Arch/InterruptManagement.h>
+#include <Kernel/Arch/PerformanceCounters.h>
 #include <Kernel/Arch/Processor.h>
 #include <Kernel/Boot/BootInfo.h>
 #include <Kernel/Boot/CommandLine.h>
@@ -57,6 +58,7 @@
 #include <Kernel/Security/Random.h>
 #include <Kernel/Tasks/FinalizerTask.h>
 #include <Kernel/Tasks/HostnameContext.h>
+#include <Kernel/Tasks/PageReclaimTask.h>
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/Scheduler.h>
 #include <Kernel/Tasks/SyncTask.h>
@@ -182,6 +184,7 @@ extern "C" [[noreturn]] UNMAP_AFTER_INIT NO_SANITIZE_COVERAGE void init(BootInfo
 
     CommandLine::initialize();
     Memory::MemoryManager::initialize(0);
+    PerformanceCounters::initialize();
 
 #if ARCH(AARCH64) || ARCH(RISCV64)
     DeviceTree::map_flattened_devicetree();
@@ -279,6 +282,7 @@ extern "C" [[noreturn]] UNMAP_AFTER_INIT void init_ap(FlatPtr cpu, Processor* pr
 
     processor_info->initialize(cpu);
     Memory::MemoryManager::initialize(cpu);
+    PerformanceCounters::initialize();
 
     Scheduler::set_idle_thread(APIC::the().get_idle_thread(cpu));
 
@@ -308,8 +312,6 @@ void init_stage2(void*)
     // The colonel process gets away without having to do this because it never exits.
     Process::register_new(Process::current());
 
-    WorkQueue::initialize();
-
 #if ARCH(X86_64)
     if (kernel_command_line().is_smp_enabled() && APIC::initialized() && APIC::the().enabled_processor_count() > 1) {
         // We can't start the APs until we have a scheduler up and running.
@@ -320,6 +322,9 @@ void init_stage2(void*)
     }
 #endif
 
+    // NOTE: This has to happen after all processors are up, as the IO work queue has one thread per processor.
+    WorkQueue::initialize();
+
 #if ARCH(AARCH64) || ARCH(RISCV64)
     MUST(DeviceTree::Management::the().probe_drivers(DeviceTree::Driver::ProbeStage::Regular));
 #endif
@@ -349,6 +354,7 @@ void init_stage2(void*)
 
     SyncTask::spawn();
     FinalizerTask::spawn();
+    PageReclaimTask::spawn();
 
     auto boot_profiling = kernel_command_line().is_boot_profiling_enabled();
 
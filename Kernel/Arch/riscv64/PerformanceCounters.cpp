@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Arch/PerformanceCounters.h>
+
+namespace Kernel {
+
+// FIXME: Program the hpmcounters through the SBI PMU extension, and take overflow interrupts with Sscofpmf.
+bool arch_initialize_performance_counters()
+{
+    return false;
+}
+
+bool arch_performance_counter_is_supported(HardwareEvent)
+{
+    return false;
+}
+
+void arch_start_performance_counter(HardwareEvent, u64)
+{
+    VERIFY_NOT_REACHED();
+}
+
+void arch_stop_performance_counter(HardwareEvent)
+{
+    VERIFY_NOT_REACHED();
+}
+
+void arch_reload_performance_counter(HardwareEvent, u64)
+{
+    VERIFY_NOT_REACHED();
+}
+
+u32 arch_take_overflowed_performance_counters()
+{
+    return 0;
+}
+
+}
@@ -52,8 +52,9 @@ void activate_kernel_page_directory(PageDirectory const& pgd)
 
 void activate_page_directory(PageDirectory const& pgd, Thread* current_thread)
 {
+    InterruptDisabler disabler;
     current_thread->regs().cr3 = pgd.cr3();
-    write_cr3(pgd.cr3());
+    Processor::activate_cr3(pgd.cr3());
 }
 
 UNMAP_AFTER_INIT NonnullLockRefPtr<PageDirectory> PageDirectory::must_create_kernel_page_directory()
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <Kernel/Arch/PerformanceCounters.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/Arch/x86_64/CPUID.h>
+#include <Kernel/Arch/x86_64/MSR.h>
+#include <Kernel/Arch/x86_64/ProcessorInfo.h>
+
+#define IA32_PMC0 0xc1
+#define IA32_PERFEVTSEL0 0x186
+#define IA32_PERF_GLOBAL_STATUS 0x38e
+#define IA32_PERF_GLOBAL_CTRL 0x38f
+#define IA32_PERF_GLOBAL_OVF_CTRL 0x390
+
+#define AMD_PERF_CTL0 0xc0010200
+#define AMD_PERF_CTR0 0xc0010201
+#define AMD_PERF_COUNTER_COUNT 6
+#define AMD_PERF_COUNTER_WIDTH 48
+
+#define PERFEVTSEL_USR (1 << 16)
+#define PERFEVTSEL_OS (1 << 17)
+#define PERFEVTSEL_INT (1 << 20)
+#define PERFEVTSEL_EN (1 << 22)
+
+namespace Kernel {
+
+struct EventSelector {
+    u8 event;
+    u8 unit_mask;
+};
+
+// Intel SDM Vol. 3B, 21.2.1.2 "Pre-defined Architectural Performance Events"
+static constexpr Array<EventSelector, PerformanceCounters::hardware_event_count> s_intel_events = { {
+    { 0x3c, 0x00 }, // UnHalted Core Cycles
+    { 0xc0, 0x00 }, // Instructions Retired
+    { 0x2e, 0x41 }, // LLC Misses
+    { 0xc5, 0x00 }, // Branch Misses Retired
+} };
+
+// The bit in CPUID.0AH:EBX that is set if the architectural event is not available.
+static constexpr Array<u8, PerformanceCounters::hardware_event_count> s_intel_event_unavailable_bits = { 0, 1, 4, 6 };
+
+// AMD Processor Programming Reference, "Core Performance Monitor Counters"
+static constexpr Array<EventSelector, PerformanceCounters::hardware_event_count> s_amd_events = { {
+    { 0x76, 0x00 }, // Cycles not in Halt
+    { 0xc0, 0x00 }, // Retired Instructions
+    { 0x7e, 0x07 }, // L2 Cache Misses
+    { 0xc3, 0x00 }, // Retired Branch Instructions Mispredicted
+} };
+
+enum class PMUType {
+    None,
+    IntelArchitectural,
+    AMD,
+};
+
+static PMUType s_pmu_type { PMUType::None };
+static u32 s_counter_count;
+static u32 s_intel_unavailable_events;
+
+static u32 counter_select_msr(size_t index)
+{
+    if (s_pmu_type == PMUType::AMD)
+        return AMD_PERF_CTL0 + 2 * index;
+    return IA32_PERFEVTSEL0 + index;
+}
+
+static u32 counter_msr(size_t index)
+{
+    if (s_pmu_type == PMUType::AMD)
+        return AMD_PERF_CTR0 + 2 * index;
+    return IA32_PMC0 + index;
+}
+
+static u64 initial_counter_value(u64 period)
+{
+    // Intel only writes the low 32 bits of the counter and sign-extends them, AMD's counters are 48 bits wide.
+    period = min(period, static_cast<u64>(NumericLimits<i32>::max()));
+    return -period & ((1ull << AMD_PERF_COUNTER_WIDTH) - 1);
+}
+
+static void detect_pmu()
+{
+    auto& processor = Processor::current();
+    auto vendor_id = processor.info().vendor_id_string();
+
+    if (vendor_id == ProcessorInfo::s_intel_vendor_id && CPUID(0).eax() >= 0xa) {
+        CPUID architectural_performance_monitoring(0xa);
+        u32 version = architectural_performance_monitoring.eax() & 0xff;
+        // Version 1 has no global overflow status, which the interrupt handler relies on.
+        if (version < 2)
+            return;
+        s_counter_count = (architectural_performance_monitoring.eax() >> 8) & 0xff;
+        u32 event_bit_count = (architectural_performance_monitoring.eax() >> 24) & 0xff;
+        for (size_t i = 0; i < PerformanceCounters::hardware_event_count; ++i) {
+            auto bit = s_intel_event_unavailable_bits[i];
+            if (bit >= event_bit_count || (architectural_performance_monitoring.ebx() & (1u << bit)) != 0)
+                s_intel_unavailable_events |= 1u << i;
+        }
+        s_pmu_type = PMUType::IntelArchitectural;
+        return;
+    }
+
+    // The legacy counters can't be detected, so only use the extended ones that have a CPUID bit.
+    if (vendor_id == ProcessorInfo::s_amd_vendor_id && processor.has_feature(CPUFeature::PERFCTR_CORE)) {
+        s_counter_count = AMD_PERF_COUNTER_COUNT;
+        s_pmu_type = PMUType::AMD;
+    }
+}
+
+bool arch_initialize_performance_counters()
+{
+    if (Processor::is_bootstrap_processor())
+        detect_pmu();
+    if (s_pmu_type == PMUType::None)
+        return false;
+
+    for (size_t i = 0; i < min(s_counter_count, PerformanceCounters::hardware_event_count); ++i) {
+        MSR(counter_select_msr(i)).set(0);
+        MSR(counter_msr(i)).set(0);
+    }
+    if (s_pmu_type == PMUType::IntelArchitectural) {
+        MSR(IA32_PERF_GLOBAL_CTRL).set(0);
+        MSR(IA32_PERF_GLOBAL_OVF_CTRL).set(MSR(IA32_PERF_GLOBAL_STATUS).get());
+    }
+    return true;
+}
+
+bool arch_performance_counter_is_supported(HardwareEvent event)
+{
+    auto index = to_underlying(event);
+    if (s_pmu_type == PMUType::None || index >= s_counter_count)
+        return false;
+    if (s_pmu_type == PMUType::IntelArchitectural)
+        return (s_intel_unavailable_events & (1u << index)) == 0;
+    return true;
+}
+
+void arch_start_performance_counter(HardwareEvent event, u64 period)
+{
+    auto index = to_underlying(event);
+    auto selector = s_pmu_type == PMUType::AMD ? s_amd_events[index] : s_intel_events[index];
+
+    MSR select_msr(counter_select_msr(index));
+    select_msr.set(0);
+    MSR(counter_msr(index)).set(initial_counter_value(period));
+    select_msr.set(selector.event | (selector.unit_mask << 8) | PERFEVTSEL_USR | PERFEVTSEL_OS | PERFEVTSEL_INT | PERFEVTSEL_EN);
+
+    if (s_pmu_type == PMUType::IntelArchitectural) {
+        MSR global_control(IA32_PERF_GLOBAL_CTRL);
+        global_control.set(global_control.get() | (1ull << index));
+    }
+}
+
+void arch_stop_performance_counter(HardwareEvent event)
+{
+    auto index = to_underlying(event);
+    if (s_pmu_type == PMUType::IntelArchitectural) {
+        MSR global_control(IA32_PERF_GLOBAL_CTRL);
+        global_control.set(global_control.get() & ~(1ull << index));
+        MSR(IA32_PERF_GLOBAL_OVF_CTRL).set(1ull << index);
+    }
+    MSR(counter_select_msr(index)).set(0);
+    MSR(counter_msr(index)).set(0);
+}
+
+void arch_reload_performance_counter(HardwareEvent event, u64 period)
+{
+    MSR(counter_msr(to_underlying(event))).set(initial_counter_value(period));
+}
+
+u32 arch_take_overflowed_performance_counters()
+{
+    u32 counter_count = min(s_counter_count, PerformanceCounters::hardware_event_count);
+    u32 overflowed_counters = 0;
+
+    switch (s_pmu_type) {
+    case PMUType::None:
+        break;
+    case PMUType::IntelArchitectural: {
+        overflowed_counters = MSR(IA32_PERF_GLOBAL_STATUS).get() & ((1u << counter_count) - 1);
+        MSR(IA32_PERF_GLOBAL_OVF_CTRL).set(overflowed_counters);
+        break;
+    }
+    case PMUType::AMD:
+        // There's no overflow status register, but a counter that started out negative has overflowed
+        // once its top bit is clear.
+        for (size_t i = 0; i < counter_count; ++i) {
+            if ((MSR(counter_msr(i)).get() & (1ull << (AMD_PERF_COUNTER_WIDTH - 1))) == 0)
+                overflowed_counters |= 1u << i;
+        }
+        break;
+    }
+    return overflowed_counters;
+}
+
+}
@@ -566,6 +566,12 @@ UNMAP_AFTER_INIT void Processor::cpu_setup()
         write_cr4(read_cr4() | 0x800);
     }
 
+    if (has_feature(CPUFeature::RDTSCP) || has_feature(CPUFeature::RDPID)) {
+        // Let userspace find out which processor it runs on with RDPID or RDTSCP, see ProcessPage.h.
+        MSR tsc_aux(MSR_TSC_AUX);
+        tsc_aux.set(id());
+    }
+
     if (has_feature(CPUFeature::XSAVE)) {
         // Turn on CR4.OSXSAVE
         write_cr4(read_cr4() | 0x40000);
@@ -633,6 +639,7 @@ UNMAP_AFTER_INIT void ProcessorBase<T>::early_initialize(u32 cpu)
     m_in_scheduler = true;
 
     self->m_message_queue = nullptr;
+    self->m_active_cr3 = 0;
     m_idle_thread = nullptr;
     m_current_thread = nullptr;
     self->m_info = nullptr;
@@ -845,6 +852,14 @@ void ProcessorBase<T>::exit_trap(TrapFrame& trap)
 template<typename T>
 void ProcessorBase<T>::flush_tlb_local(VirtualAddress vaddr, size_t page_count)
 {
+    // Past a certain size, reloading CR3 is cheaper than invalidating every page on its own.
+    // We don't use global pages, so this flushes kernel mappings just as well.
+    static constexpr size_t max_pages_to_invalidate_individually = 64;
+    if (page_count > max_pages_to_invalidate_individually) {
+        flush_entire_tlb_local();
+        return;
+    }
+
     auto ptr = vaddr.as_ptr();
     while (page_count > 0) {
         asm volatile("invlpg %0"
@@ -865,7 +880,7 @@ void ProcessorBase<T>::flush_entire_tlb_local()
 template<typename T>
 void ProcessorBase<T>::flush_tlb(Memory::PageDirectory const* page_directory, VirtualAddress vaddr, size_t page_count)
 {
-    if (s_smp_enabled && (!Memory::is_user_address(vaddr) || Process::current().thread_count() > 1))
+    if (s_smp_enabled)
         Processor::smp_broadcast_flush_tlb(page_directory, vaddr, page_count);
     else
         flush_tlb_local(vaddr, page_count);
@@ -1115,6 +1130,26 @@ void Processor::smp_broadcast_message(ProcessorMessage& msg)
         APIC::the().broadcast_ipi();
 }
 
+void Processor::smp_multicast_message(u32 cpu_mask, ProcessorMessage& msg)
+{
+    auto& current_processor = Processor::current();
+    VERIFY(!(cpu_mask & (1u << current_processor.id())));
+
+    dbgln_if(SMP_DEBUG, "SMP[{}]: Multicast message {} to cpu mask: {:b} processor: {}", current_processor.id(), VirtualAddress(&msg), cpu_mask, VirtualAddress(&current_processor));
+
+    msg.refs.store(popcount(cpu_mask), AK::MemoryOrder::memory_order_release);
+    VERIFY(msg.refs > 0);
+    for_each(
+        [&](Processor& proc) {
+            auto cpu = proc.id();
+            if (!(cpu_mask & (1u << cpu)))
+                return;
+            // Like with broadcasts, we only need to send an IPI if the target doesn't have messages queued already.
+            if (proc.smp_enqueue_message(msg))
+                APIC::the().send_ipi(cpu);
+        });
+}
+
 void Processor::smp_broadcast_wait_sync(ProcessorMessage& msg)
 {
     auto& cur_proc = Processor::current();
@@ -1175,19 +1210,52 @@ void Processor::smp_unicast(u32 cpu, Function<void()> callback, bool async)
 
 void Processor::smp_broadcast_flush_tlb(Memory::PageDirectory const* page_directory, VirtualAddress vaddr, size_t page_count)
 {
+    auto& current_processor = Processor::current();
+
+    u32 target_cpu_mask = 0;
+    if (Memory::is_user_address(vaddr)) {
+        // Only processors that have this page directory loaded can have TLB entries for it, since switching
+        // page directories flushes all user mappings. Our page table updates have to be visible before we
+        // check, as a processor that loads it after this point then won't see any stale translations.
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_seq_cst);
+        auto cr3 = page_directory->cr3();
+        for_each([&](Processor& proc) {
+            if (&proc != &current_processor && proc.m_active_cr3.load(AK::MemoryOrder::memory_order_acquire) == cr3)
+                target_cpu_mask |= 1u << proc.id();
+        });
+    } else {
+        for_each([&](Processor& proc) {
+            if (&proc != &current_processor)
+                target_cpu_mask |= 1u << proc.id();
+        });
+    }
+
+    if (target_cpu_mask == 0) {
+        flush_tlb_local(vaddr, page_count);
+        return;
+    }
+
     auto& msg = smp_get_from_pool();
     msg.async = false;
     msg.type = ProcessorMessage::FlushTlb;
     msg.flush_tlb.page_directory = page_directory;
     msg.flush_tlb.ptr = vaddr.as_ptr();
     msg.flush_tlb.page_count = page_count;
-    smp_broadcast_message(msg);
+    smp_multicast_message(target_cpu_mask, msg);
     // While the other processors handle this request, we'll flush ours
     flush_tlb_local(vaddr, page_count);
     // Now wait until everybody is done as well
     smp_broadcast_wait_sync(msg);
 }
 
+void Processor::activate_cr3(FlatPtr cr3)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    // NOTE: This has to be published before we actually switch, see smp_broadcast_flush_tlb().
+    Processor::current().m_active_cr3.store(cr3, AK::MemoryOrder::memory_order_seq_cst);
+    write_cr3(cr3);
+}
+
 void Processor::smp_broadcast_halt()
 {
     // We don't want to use a message, because this could have been triggered
@@ -1279,7 +1347,7 @@ extern "C" void enter_thread_context(Thread* from_thread, Thread* to_thread)
     Processor::set_fs_base(to_thread->arch_specific_data().fs_base);
 
     if (from_regs.cr3 != to_regs.cr3)
-        write_cr3(to_regs.cr3);
+        Processor::activate_cr3(to_regs.cr3);
 
     to_thread->set_cpu(processor.id());
 
@@ -1620,6 +1688,14 @@ void ProcessorBase<T>::wait_for_interrupt() const
     asm("hlt");
 }
 
+template<typename T>
+void ProcessorBase<T>::enable_interrupts_and_wait_for_interrupt() const
+{
+    // NOTE: sti only takes effect after the next instruction, so no interrupt can sneak in before the hlt.
+    asm("sti\n"
+        "hlt");
+}
+
 }
 
 #include <Kernel/Arch/ProcessorFunctions.include>
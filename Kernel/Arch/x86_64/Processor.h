@@ -38,6 +38,7 @@ struct ProcessorMessageEntry;
 #define MSR_SFMASK 0xc0000084
 #define MSR_FS_BASE 0xc0000100
 #define MSR_GS_BASE 0xc0000101
+#define MSR_TSC_AUX 0xc0000103
 #define MSR_IA32_EFER 0xc0000080
 #define MSR_IA32_PAT 0x277
 
@@ -79,6 +80,10 @@ private:
 
     Atomic<ProcessorMessageEntry*> m_message_queue;
 
+    // The page directory this processor has loaded, so shootdowns for user addresses only have to
+    // interrupt the processors that can actually have TLB entries for the affected address space.
+    Atomic<FlatPtr> m_active_cr3;
+
     void gdt_init();
     void write_raw_gdt_entry(u16 selector, u32 low, u32 high);
     void write_gdt_entry(u16 selector, Descriptor& descriptor);
@@ -90,6 +95,7 @@ private:
     bool smp_enqueue_message(ProcessorMessage&);
     static void smp_unicast_message(u32 cpu, ProcessorMessage& msg, bool async);
     static void smp_broadcast_message(ProcessorMessage& msg);
+    static void smp_multicast_message(u32 cpu_mask, ProcessorMessage& msg);
     static void smp_broadcast_wait_sync(ProcessorMessage& msg);
     static void smp_broadcast_halt();
 
@@ -155,6 +161,8 @@ public:
     static void smp_unicast(u32 cpu, Function<void()>, bool async);
     static void smp_broadcast_flush_tlb(Memory::PageDirectory const*, VirtualAddress, size_t);
 
+    static void activate_cr3(FlatPtr cr3);
+
     static void set_fs_base(FlatPtr);
 };
 
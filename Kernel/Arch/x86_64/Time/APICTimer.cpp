@@ -136,6 +136,17 @@ void APICTimer::enable_local_timer()
     APIC::the().setup_local_timer(m_timer_period, m_timer_mode, true);
 }
 
+void APICTimer::enable_local_one_shot_timer(Duration timeout)
+{
+    // m_timer_period is the number of bus clock ticks per timer tick.
+    u64 bus_ticks_per_second = (u64)m_timer_period * m_frequency;
+    u64 timeout_ns = max(timeout.to_nanoseconds(), 0);
+    u64 bus_ticks = (bus_ticks_per_second / 1000) * timeout_ns / 1'000'000;
+    // Never program a zero count, as that would stop the timer instead of firing it right away.
+    bus_ticks = clamp(bus_ticks, (u64)APIC::the().get_timer_divisor(), (u64)NumericLimits<u32>::max());
+    APIC::the().setup_local_timer((u32)bus_ticks, APIC::TimerMode::OneShot, true);
+}
+
 void APICTimer::disable_local_timer()
 {
     APIC::the().setup_local_timer(0, APIC::TimerMode::OneShot, false);
@@ -180,6 +180,16 @@ UNMAP_AFTER_INIT bool CommandLine::is_legacy_time_enabled() const
     return lookup("time"sv).value_or("modern"sv) == "legacy"sv;
 }
 
+UNMAP_AFTER_INIT bool CommandLine::is_nohz_enabled() const
+{
+    auto value = lookup("nohz"sv).value_or("off"sv);
+    if (value == "on"sv)
+        return true;
+    if (value == "off"sv)
+        return false;
+    PANIC("Unknown nohz setting: {}", value);
+}
+
 bool CommandLine::is_pc_speaker_enabled() const
 {
     auto value = lookup("pcspeaker"sv).value_or("off"sv);
@@ -57,8 +57,13 @@ ErrorOr<void> Device::accept_device_features(u64 device_features, u64 accepted_f
         // accepted_features |= VIRTIO_F_INDIRECT_DESC;
     }
 
-    if (is_feature_set(device_features, VIRTIO_F_IN_ORDER)) {
-        accepted_features |= VIRTIO_F_IN_ORDER;
+    // NOTE: We don't accept VIRTIO_F_IN_ORDER, as it allows the device to only report the last of a batch of
+    //       used buffers, which our queues don't know how to deal with now that more than one buffer can be in flight.
+
+    // Event indexes let both sides suppress notifications until the other one has actually caught up,
+    // which saves us a lot of VM exits (and interrupts) when many buffers are in flight.
+    if (is_feature_set(device_features, VIRTIO_F_RING_EVENT_IDX)) {
+        accepted_features |= VIRTIO_F_RING_EVENT_IDX;
     }
 
     dbgln_if(VIRTIO_DEBUG, "{}: Device features: {}", m_class_name, device_features);
@@ -82,6 +87,8 @@ ErrorOr<void> Device::setup_queue(u16 queue_index)
 {
     auto queue = TRY(m_transport_entity->setup_queue({}, queue_index));
     dbgln_if(VIRTIO_DEBUG, "{}: Queue[{}] configured with size: {}", m_class_name, queue_index, queue->size());
+    if (is_feature_accepted(VIRTIO_F_RING_EVENT_IDX))
+        queue->enable_event_index();
 
     TRY(m_queues.try_append(move(queue)));
     return {};
@@ -144,26 +151,41 @@ bool Device::handle_irq(Badge<TransportInterruptHandler>)
     }
     if (isr_type & QUEUE_INTERRUPT) {
         dbgln_if(VIRTIO_DEBUG, "{}: VirtIO Queue interrupt!", class_name());
+        // NOTE: With several queues, more than one of them may have been updated by the time we get here.
+        bool handled_any_queue = false;
         for (size_t i = 0; i < m_queues.size(); i++) {
             if (get_queue(i).new_data_available()) {
                 handle_queue_update(i);
-                return true;
+                handled_any_queue = true;
             }
         }
-        dbgln_if(VIRTIO_DEBUG, "{}: Got queue interrupt but all queues are up to date!", class_name());
+        if (!handled_any_queue)
+            dbgln_if(VIRTIO_DEBUG, "{}: Got queue interrupt but all queues are up to date!", class_name());
     }
     return true;
 }
 
-void Device::supply_chain_and_notify(u16 queue_index, QueueChain& chain)
+void Device::supply_chain(u16 queue_index, QueueChain& chain)
 {
     auto& queue = get_queue(queue_index);
     VERIFY(&chain.queue() == &queue);
     VERIFY(queue.lock().is_locked());
     chain.submit_to_queue();
-    auto descriptor = TransportEntity::NotifyQueueDescriptor { queue_index, get_queue(queue_index).notify_offset() };
+}
+
+void Device::notify_queue_if_needed(u16 queue_index)
+{
+    auto& queue = get_queue(queue_index);
+    VERIFY(queue.lock().is_locked());
+    auto descriptor = TransportEntity::NotifyQueueDescriptor { queue_index, queue.notify_offset() };
     if (queue.should_notify())
         m_transport_entity->notify_queue({}, descriptor);
 }
 
+void Device::supply_chain_and_notify(u16 queue_index, QueueChain& chain)
+{
+    supply_chain(queue_index, chain);
+    notify_queue_if_needed(queue_index);
+}
+
 }
@@ -70,6 +70,11 @@ protected:
     }
 
     void supply_chain_and_notify(u16 queue_index, QueueChain& chain);
+    // For handing a batch of chains to the device, with (at most) a single notification at the end.
+    void supply_chain(u16 queue_index, QueueChain& chain);
+    void notify_queue_if_needed(u16 queue_index);
+
+    u16 queue_count() const { return m_queue_count; }
 
     virtual ErrorOr<void> handle_device_config_change() = 0;
     virtual void handle_queue_update(u16 queue_index) = 0;
@@ -11,12 +11,26 @@
 
 namespace Kernel::VirtIO {
 
+size_t Queue::size_of_descriptors(u16 queue_size)
+{
+    return sizeof(QueueDescriptor) * queue_size;
+}
+
+size_t Queue::size_of_driver(u16 queue_size)
+{
+    // The ring is followed by used_event, and the device ring after it has to be 4-byte aligned.
+    return align_up_to(sizeof(QueueDriver) + (queue_size + 1) * sizeof(u16), 4);
+}
+
+size_t Queue::size_of_device(u16 queue_size)
+{
+    // The ring is followed by avail_event.
+    return sizeof(QueueDevice) + queue_size * sizeof(QueueDeviceItem) + sizeof(u16);
+}
+
 ErrorOr<NonnullOwnPtr<Queue>> Queue::try_create(u16 queue_size, u16 notify_offset)
 {
-    size_t size_of_descriptors = sizeof(QueueDescriptor) * queue_size;
-    size_t size_of_driver = sizeof(QueueDriver) + queue_size * sizeof(u16);
-    size_t size_of_device = sizeof(QueueDevice) + queue_size * sizeof(QueueDeviceItem);
-    auto queue_region_size = TRY(Memory::page_round_up(size_of_descriptors + size_of_driver + size_of_device));
+    auto queue_region_size = TRY(Memory::page_round_up(size_of_descriptors(queue_size) + size_of_driver(queue_size) + size_of_device(queue_size)));
     OwnPtr<Memory::Region> queue_region;
     if (queue_region_size <= PAGE_SIZE)
         queue_region = TRY(MM.allocate_kernel_region(queue_region_size, "VirtIO Queue"sv, Memory::Region::Access::ReadWrite));
@@ -31,14 +45,12 @@ Queue::Queue(NonnullOwnPtr<Memory::Region> queue_region, u16 queue_size, u16 not
     , m_free_buffers(queue_size)
     , m_queue_region(move(queue_region))
 {
-    size_t size_of_descriptors = sizeof(QueueDescriptor) * queue_size;
-    size_t size_of_driver = sizeof(QueueDriver) + queue_size * sizeof(u16);
-    // TODO: ensure alignment!!!
+    // NOTE: The region is page aligned, so the descriptor table (which needs 16-byte alignment) is as well.
     u8* ptr = m_queue_region->vaddr().as_ptr();
     memset(ptr, 0, m_queue_region->size());
     m_descriptors = reinterpret_cast<QueueDescriptor*>(ptr);
-    m_driver = reinterpret_cast<QueueDriver*>(ptr + size_of_descriptors);
-    m_device = reinterpret_cast<QueueDevice*>(ptr + size_of_descriptors + size_of_driver);
+    m_driver = reinterpret_cast<QueueDriver*>(ptr + size_of_descriptors(queue_size));
+    m_device = reinterpret_cast<QueueDevice*>(ptr + size_of_descriptors(queue_size) + size_of_driver(queue_size));
 
     for (auto i = 0; i + 1 < queue_size; i++)
         m_descriptors[i].next = i + 1; // link all the descriptors in a line
@@ -51,13 +63,31 @@ Queue::~Queue() = default;
 void Queue::enable_interrupts()
 {
     SpinlockLocker lock(m_lock);
-    m_driver->flags = 0;
+    m_interrupts_enabled = true;
+    if (m_uses_event_index)
+        AK::atomic_store(used_event(), m_used_tail, AK::MemoryOrder::memory_order_relaxed);
+    else
+        m_driver->flags = 0;
 }
 
 void Queue::disable_interrupts()
 {
     SpinlockLocker lock(m_lock);
-    m_driver->flags = 1;
+    m_interrupts_enabled = false;
+    // NOTE: With event indexes, this is only a hint: the device interrupts us once it wraps around to this index.
+    if (m_uses_event_index)
+        AK::atomic_store(used_event(), static_cast<u16>(m_used_tail - 1), AK::MemoryOrder::memory_order_relaxed);
+    else
+        m_driver->flags = VIRTQ_AVAIL_F_NO_INTERRUPT;
+}
+
+void Queue::enable_event_index()
+{
+    SpinlockLocker lock(m_lock);
+    m_uses_event_index = true;
+    // The flags have to be left alone once event indexes are in use.
+    m_driver->flags = 0;
+    AK::atomic_store(used_event(), static_cast<u16>(m_interrupts_enabled ? m_used_tail : m_used_tail - 1), AK::MemoryOrder::memory_order_relaxed);
 }
 
 bool Queue::new_data_available() const
@@ -91,6 +121,10 @@ QueueChain Queue::pop_used_buffer_chain(size_t& used)
 
     // We are now done with this buffer chain
     m_used_tail++;
+    // Ask for an interrupt as soon as the next buffer has been used, rather than for every single one
+    // the device used while we were busy handling this one.
+    if (m_uses_event_index && m_interrupts_enabled)
+        AK::atomic_store(used_event(), m_used_tail, AK::MemoryOrder::memory_order_relaxed);
 
     return QueueChain(*this, descriptor_index, last_index, length_of_chain);
 }
@@ -131,10 +165,24 @@ Optional<u16> Queue::take_free_slot()
     return {};
 }
 
-bool Queue::should_notify() const
+bool Queue::should_notify()
 {
     VERIFY(m_lock.is_locked());
-    auto device_flags = m_device->flags;
+    // The device has to see the new available index before we look at what it wants.
+    full_memory_fence();
+
+    auto old_index = m_driver_index_at_last_notification;
+    auto new_index = m_driver_index_shadow;
+    m_driver_index_at_last_notification = new_index;
+    if (old_index == new_index)
+        return false;
+
+    if (m_uses_event_index) {
+        // This is vring_need_event() from the spec: notify if avail_event lies in (old_index, new_index].
+        auto event_index = avail_event();
+        return static_cast<u16>(new_index - event_index - 1) < static_cast<u16>(new_index - old_index);
+    }
+    auto device_flags = AK::atomic_load(&m_device->flags, AK::MemoryOrder::memory_order_relaxed);
     return !(device_flags & VIRTQ_USED_F_NO_NOTIFY);
 }
 
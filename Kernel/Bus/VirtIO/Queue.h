@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <Kernel/Locking/Spinlock.h>
 #include <Kernel/Memory/MemoryManager.h>
 
@@ -36,19 +37,25 @@ public:
     void enable_interrupts();
     void disable_interrupts();
 
+    // With VIRTIO_F_RING_EVENT_IDX we tell the device which used ring index to interrupt us at, and
+    // the device tells us which available ring index to notify it at, instead of using the flags.
+    void enable_event_index();
+
     PhysicalAddress descriptor_area() const { return to_physical(m_descriptors); }
     PhysicalAddress driver_area() const { return to_physical(m_driver); }
     PhysicalAddress device_area() const { return to_physical(m_device); }
 
     bool new_data_available() const;
     bool has_free_slots() const;
+    u16 free_slot_count() const { return m_free_buffers; }
     Optional<u16> take_free_slot();
     QueueChain pop_used_buffer_chain(size_t& used);
     void discard_used_buffers();
 
     Spinlock<LockRank::None>& lock() { return m_lock; }
 
-    bool should_notify() const;
+    // Returns whether the device wants to hear about the buffers that were made available since the last call.
+    bool should_notify();
 
     u16 size() const { return m_queue_size; }
 
@@ -57,6 +64,18 @@ private:
 
     void reclaim_buffer_chain(u16 chain_start_index, u16 chain_end_index, size_t length_of_chain);
 
+    static size_t size_of_descriptors(u16 queue_size);
+    static size_t size_of_driver(u16 queue_size);
+    static size_t size_of_device(u16 queue_size);
+
+    // These live at the end of the driver and device rings, and are only used with VIRTIO_F_RING_EVENT_IDX.
+    u16* used_event() { return reinterpret_cast<u16*>(reinterpret_cast<u8*>(m_driver) + sizeof(QueueDriver) + m_queue_size * sizeof(u16)); }
+    u16 avail_event() const
+    {
+        auto const* avail_event = reinterpret_cast<u16 const*>(reinterpret_cast<u8 const*>(m_device) + sizeof(QueueDevice) + m_queue_size * sizeof(QueueDeviceItem));
+        return AK::atomic_load(avail_event, AK::MemoryOrder::memory_order_relaxed);
+    }
+
     PhysicalAddress to_physical(void const* ptr) const
     {
         auto offset = FlatPtr(ptr) - m_queue_region->vaddr().get();
@@ -92,6 +111,9 @@ private:
     u16 m_free_head { 0 };
     u16 m_used_tail { 0 };
     u16 m_driver_index_shadow { 0 };
+    u16 m_driver_index_at_last_notification { 0 };
+    bool m_uses_event_index { false };
+    bool m_interrupts_enabled { true };
 
     QueueDescriptor* m_descriptors { nullptr };
     QueueDriver* m_driver { nullptr };
@@ -153,6 +175,7 @@ public:
     [[nodiscard]] Queue& queue() const { return m_queue; }
     [[nodiscard]] bool is_empty() const { return m_chain_length == 0; }
     [[nodiscard]] size_t length() const { return m_chain_length; }
+    [[nodiscard]] u16 start_index() const { return m_start_of_chain_index.value(); }
     bool add_buffer_to_chain(PhysicalAddress buffer_start, size_t buffer_length, BufferType buffer_type);
     void submit_to_queue();
     void release_buffer_slots_to_queue();
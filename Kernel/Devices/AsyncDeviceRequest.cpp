@@ -41,11 +41,14 @@ AsyncDeviceRequest::~AsyncDeviceRequest()
 
 void AsyncDeviceRequest::request_finished()
 {
+    will_finish(get_request_result());
+
     if (m_parent_request)
         m_parent_request->sub_request_finished(*this);
 
     // Trigger processing the next request
-    m_device.process_next_queued_request({}, *this);
+    if (!m_was_merged)
+        m_device.process_next_queued_request({}, *this);
 
     // Wake anyone who may be waiting
     m_queue.wake_all();
@@ -67,6 +70,14 @@ auto AsyncDeviceRequest::get_request_result() const -> RequestResult
     return m_result;
 }
 
+void AsyncDeviceRequest::mark_as_merged()
+{
+    SpinlockLocker lock(m_lock);
+    VERIFY(m_result == Pending);
+    m_result = Started;
+    m_was_merged = true;
+}
+
 void AsyncDeviceRequest::add_sub_request(NonnullLockRefPtr<AsyncDeviceRequest> sub_request)
 {
     // Sub-requests cannot be for the same device
@@ -61,6 +61,7 @@ public:
     void add_sub_request(NonnullLockRefPtr<AsyncDeviceRequest>);
 
     [[nodiscard]] RequestWaitResult wait(Duration* = nullptr);
+    bool is_completed() const { return is_completed_result(get_request_result()); }
 
     void do_start(SpinlockLocker<Spinlock<LockRank::None>>&& requests_lock)
     {
@@ -134,6 +135,13 @@ protected:
 
     RequestResult get_request_result() const;
 
+    // Called once the request has its result, before anyone that is waiting for it hears about it.
+    virtual void will_finish(RequestResult) { }
+
+    // A request that was merged into another one is never started on its own, it is finished along
+    // with the request it was merged into and doesn't take up a place in the device's queue anymore.
+    void mark_as_merged();
+
 private:
     void sub_request_finished(AsyncDeviceRequest&);
     void request_finished();
@@ -154,7 +162,14 @@ private:
 
     AsyncDeviceRequest* m_parent_request { nullptr };
     RequestResult m_result { Pending };
+    bool m_was_merged { false };
     IntrusiveListNode<AsyncDeviceRequest, LockRefPtr<AsyncDeviceRequest>> m_list_node;
+    IntrusiveListNode<AsyncDeviceRequest, LockRefPtr<AsyncDeviceRequest>> m_device_list_node;
+
+public:
+    using DeviceRequestList = IntrusiveList<&AsyncDeviceRequest::m_device_list_node>;
+
+private:
 
     using AsyncDeviceSubRequestList = IntrusiveList<&AsyncDeviceRequest::m_list_node>;
 
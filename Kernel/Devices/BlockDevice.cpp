@@ -6,10 +6,40 @@
 
 #include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/DeviceIdentifiers/BlockDevicesDirectory.h>
+#include <Kernel/Memory/MemoryManager.h>
+#include <Kernel/Tasks/Tracepoints.h>
+#include <Kernel/Time/TimeManagement.h>
 
 namespace Kernel {
 
-AsyncBlockDeviceRequest::AsyncBlockDeviceRequest(Device& block_device, RequestType request_type, u64 block_index, u32 block_count, UserOrKernelBuffer const& buffer, size_t buffer_size)
+// Requests for rotating media that have waited this long are started next, no matter where they are on the disk.
+static constexpr Duration read_request_expiry = Duration::from_milliseconds(500);
+static constexpr Duration write_request_expiry = Duration::from_seconds(5);
+
+auto AsyncBlockDeviceRequest::find_dma_segments(UserOrKernelBuffer const& buffer, size_t size) -> DMASegments
+{
+    // NOTE: Pages of user memory can be replaced (e.g. when they're copied on write) while the device is still
+    //       working on them, so user buffers always go through the DMA buffers of the drivers.
+    if (!buffer.is_kernel_buffer())
+        return {};
+
+    DMASegments segments;
+    auto vaddr = VirtualAddress(buffer.user_or_kernel_ptr());
+    while (size > 0) {
+        auto page = MM.physical_page_for_kernel_vaddr(vaddr);
+        if (!page)
+            return {};
+        auto offset_in_page = vaddr.get() - vaddr.page_base().get();
+        auto length = min(size, PAGE_SIZE - offset_in_page);
+        if (segments.try_append({ page.release_nonnull(), offset_in_page, length }).is_error())
+            return {};
+        vaddr = vaddr.offset(length);
+        size -= length;
+    }
+    return segments;
+}
+
+AsyncBlockDeviceRequest::AsyncBlockDeviceRequest(Device& block_device, RequestType request_type, u64 block_index, u32 block_count, UserOrKernelBuffer const& buffer, size_t buffer_size, DMASegments dma_segments)
     : AsyncDeviceRequest(block_device)
     , m_block_device(static_cast<BlockDevice&>(block_device))
     , m_request_type(request_type)
@@ -17,14 +47,71 @@ AsyncBlockDeviceRequest::AsyncBlockDeviceRequest(Device& block_device, RequestTy
     , m_block_count(block_count)
     , m_buffer(buffer)
     , m_buffer_size(buffer_size)
+    , m_submission_time(TimeManagement::the().monotonic_time())
+    , m_dma_segments(move(dma_segments))
 {
 }
 
+bool AsyncBlockDeviceRequest::can_be_merged_with(AsyncBlockDeviceRequest const& other, size_t max_block_count) const
+{
+    if (other.m_request_type != m_request_type || !other.m_merged_requests.is_empty())
+        return false;
+    // NOTE: The data is copied around in whatever context the request is started or completed in,
+    //       so we can only do this for kernel buffers.
+    if (!m_buffer.is_kernel_buffer() || !other.m_buffer.is_kernel_buffer())
+        return false;
+    if (m_buffer_size != m_block_count * block_size() || other.m_buffer_size != other.m_block_count * block_size())
+        return false;
+    if (m_block_count + other.m_block_count > max_block_count)
+        return false;
+    return other.m_block_index == m_block_index + m_block_count || other.m_block_index + other.m_block_count == m_block_index;
+}
+
+ErrorOr<void> AsyncBlockDeviceRequest::try_merge(AsyncBlockDeviceRequest& other, size_t max_block_count)
+{
+    VERIFY(can_be_merged_with(other, max_block_count));
+    if (m_merged_requests.is_empty()) {
+        m_merge_buffer = TRY(ByteBuffer::create_uninitialized(max_block_count * block_size()));
+        TRY(m_merged_requests.try_append({ nullptr, m_block_index, m_block_count, m_buffer }));
+    }
+    TRY(m_merged_requests.try_append({ other, other.m_block_index, other.m_block_count, other.m_buffer }));
+    other.mark_as_merged();
+
+    m_block_index = min(m_block_index, other.m_block_index);
+    m_block_count += other.m_block_count;
+    m_buffer = UserOrKernelBuffer::for_kernel_buffer(m_merge_buffer.data());
+    m_buffer_size = m_block_count * block_size();
+    m_dma_segments.clear();
+    return {};
+}
+
 void AsyncBlockDeviceRequest::start()
 {
+    TRACEPOINT(block_request_start, m_block_index, m_block_count);
+    if (m_merged_requests.size() > 1 && m_request_type == Write) {
+        for (auto& merged_request : m_merged_requests) {
+            auto* destination = m_merge_buffer.offset_pointer((merged_request.block_index - m_block_index) * block_size());
+            MUST(merged_request.buffer.read(destination, 0, merged_request.block_count * block_size()));
+        }
+    }
     m_block_device.start_request(*this);
 }
 
+void AsyncBlockDeviceRequest::will_finish(RequestResult result)
+{
+    TRACEPOINT(block_request_finish, m_block_index, result);
+    if (m_merged_requests.size() <= 1)
+        return;
+    for (auto& merged_request : m_merged_requests) {
+        if (result == Success && m_request_type == Read) {
+            auto const* source = m_merge_buffer.offset_pointer((merged_request.block_index - m_block_index) * block_size());
+            MUST(merged_request.buffer.write(source, 0, merged_request.block_count * block_size()));
+        }
+        if (merged_request.request)
+            merged_request.request->complete(result);
+    }
+}
+
 BlockDevice::BlockDevice(MajorAllocation::BlockDeviceFamily block_device_family, MinorNumber minor, size_t block_size)
     : Device(MajorAllocation::block_device_family_to_major_number(block_device_family), minor)
     , m_block_size(block_size)
@@ -71,6 +158,61 @@ void BlockDevice::before_will_be_destroyed_remove_from_device_identifier_directo
     });
 }
 
+NonnullLockRefPtr<AsyncDeviceRequest> BlockDevice::take_next_queued_request(AsyncDeviceRequest::DeviceRequestList& queued_requests)
+{
+    // NOTE: Only AsyncBlockDeviceRequests are ever made for block devices.
+    auto as_block_device_request = [](AsyncDeviceRequest& request) -> AsyncBlockDeviceRequest& {
+        return static_cast<AsyncBlockDeviceRequest&>(request);
+    };
+
+    // The queue is in the order the requests were made in, which is what we want for anything that doesn't have to seek.
+    auto* next_request = &as_block_device_request(*queued_requests.first());
+    if (is_rotational()) {
+        auto expiry = next_request->request_type() == AsyncBlockDeviceRequest::Read ? read_request_expiry : write_request_expiry;
+        if (TimeManagement::the().monotonic_time() < next_request->submission_time() + expiry) {
+            // Sweep across the disk in one direction, and start over from the lowest block once we're past the last request.
+            AsyncBlockDeviceRequest* next_request_in_sweep = nullptr;
+            AsyncBlockDeviceRequest* lowest_request = nullptr;
+            for (auto& queued_request : queued_requests) {
+                auto& request = as_block_device_request(queued_request);
+                if (!lowest_request || request.block_index() < lowest_request->block_index())
+                    lowest_request = &request;
+                if (request.block_index() >= m_next_block_index && (!next_request_in_sweep || request.block_index() < next_request_in_sweep->block_index()))
+                    next_request_in_sweep = &request;
+            }
+            next_request = next_request_in_sweep ? next_request_in_sweep : lowest_request;
+        }
+    }
+
+    NonnullLockRefPtr<AsyncDeviceRequest> request = *next_request;
+    queued_requests.remove(*next_request);
+    merge_adjacent_queued_requests(*next_request, queued_requests);
+    m_next_block_index = next_request->block_index() + next_request->block_count();
+    return request;
+}
+
+void BlockDevice::merge_adjacent_queued_requests(AsyncBlockDeviceRequest& request, AsyncDeviceRequest::DeviceRequestList& queued_requests)
+{
+    auto max_block_count = max_blocks_per_request();
+    while (true) {
+        AsyncBlockDeviceRequest* adjacent_request = nullptr;
+        for (auto& queued_request : queued_requests) {
+            auto& other_request = static_cast<AsyncBlockDeviceRequest&>(queued_request);
+            if (request.can_be_merged_with(other_request, max_block_count)) {
+                adjacent_request = &other_request;
+                break;
+            }
+        }
+        if (!adjacent_request)
+            return;
+        // NOTE: Not merging is always fine, the requests will just be started on their own.
+        if (request.try_merge(*adjacent_request, max_block_count).is_error())
+            return;
+        queued_requests.remove(*adjacent_request);
+        did_merge_queued_request();
+    }
+}
+
 bool BlockDevice::read_block(u64 index, UserOrKernelBuffer& buffer)
 {
     auto read_request_or_error = try_make_request<AsyncBlockDeviceRequest>(AsyncBlockDeviceRequest::Read, index, 1, buffer, m_block_size);
@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/IntegralMath.h>
+#include <AK/Time.h>
 #include <Kernel/API/MajorNumberAllocation.h>
 #include <Kernel/Devices/Device.h>
 #include <Kernel/Library/LockWeakable.h>
+#include <Kernel/Memory/PhysicalRAMPage.h>
 
 namespace Kernel {
 
@@ -28,12 +31,22 @@ public:
 
     virtual void start_request(AsyncBlockDeviceRequest&) = 0;
 
+    // Rotating media are a lot faster when they don't have to seek back and forth, so queued requests
+    // for them are started in order of their block index instead of the order they were made in.
+    virtual bool is_rotational() const { return false; }
+
 protected:
     BlockDevice(MajorAllocation::BlockDeviceFamily, MinorNumber minor, size_t block_size = PAGE_SIZE);
 
+    // Queued requests for adjacent blocks are merged into one as long as it doesn't get bigger than this.
+    virtual size_t max_blocks_per_request() const { return max(PAGE_SIZE >> m_block_size_log, static_cast<size_t>(1)); }
+
 protected:
     virtual bool is_block_device() const final { return true; }
 
+    // ^Device
+    virtual NonnullLockRefPtr<AsyncDeviceRequest> take_next_queued_request(AsyncDeviceRequest::DeviceRequestList&) override;
+
     virtual void after_inserting_add_symlink_to_device_identifier_directory() override final;
     virtual void before_will_be_destroyed_remove_symlink_from_device_identifier_directory() override final;
 
@@ -42,8 +55,13 @@ private:
     virtual void after_inserting_add_to_device_identifier_directory() override final;
     virtual void before_will_be_destroyed_remove_from_device_identifier_directory() override final;
 
+    void merge_adjacent_queued_requests(AsyncBlockDeviceRequest&, AsyncDeviceRequest::DeviceRequestList&);
+
     size_t m_block_size { 0 };
     u8 m_block_size_log { 0 };
+
+    // Where the last request we started ended, i.e. roughly where the heads of a rotating disk are.
+    u64 m_next_block_index { 0 };
 };
 
 class AsyncBlockDeviceRequest final : public AsyncDeviceRequest {
@@ -52,8 +70,23 @@ public:
         Read,
         Write
     };
+
+    // A piece of the buffer in physical memory. Drivers can let the device transfer data from and to
+    // these directly, instead of copying it through a DMA buffer of their own.
+    struct DMASegment {
+        NonnullRefPtr<Memory::PhysicalRAMPage> page;
+        size_t offset_in_page { 0 };
+        size_t length { 0 };
+
+        PhysicalAddress paddr() const { return page->paddr().offset(offset_in_page); }
+    };
+    using DMASegments = Vector<DMASegment, 2>;
+
+    // Returns nothing if (a part of) the buffer isn't somewhere we could hand to a device.
+    static DMASegments find_dma_segments(UserOrKernelBuffer const&, size_t);
+
     AsyncBlockDeviceRequest(Device& block_device, RequestType request_type,
-        u64 block_index, u32 block_count, UserOrKernelBuffer const& buffer, size_t buffer_size);
+        u64 block_index, u32 block_count, UserOrKernelBuffer const& buffer, size_t buffer_size, DMASegments dma_segments = {});
 
     RequestType request_type() const { return m_request_type; }
     u64 block_index() const { return m_block_index; }
@@ -62,6 +95,12 @@ public:
     UserOrKernelBuffer& buffer() { return m_buffer; }
     UserOrKernelBuffer const& buffer() const { return m_buffer; }
     size_t buffer_size() const { return m_buffer_size; }
+    MonotonicTime submission_time() const { return m_submission_time; }
+    // Empty unless the whole buffer is in memory that the device can access directly.
+    ReadonlySpan<DMASegment> dma_segments() const { return m_dma_segments; }
+
+    bool can_be_merged_with(AsyncBlockDeviceRequest const&, size_t max_block_count) const;
+    ErrorOr<void> try_merge(AsyncBlockDeviceRequest&, size_t max_block_count);
 
     virtual void start() override;
     virtual StringView name() const override
@@ -77,12 +116,30 @@ public:
     }
 
 private:
+    // ^AsyncDeviceRequest
+    virtual void will_finish(RequestResult) override;
+
     BlockDevice& m_block_device;
     RequestType const m_request_type;
-    u64 const m_block_index;
-    u32 const m_block_count;
+    u64 m_block_index;
+    u32 m_block_count;
     UserOrKernelBuffer m_buffer;
-    size_t const m_buffer_size;
+    size_t m_buffer_size;
+    MonotonicTime const m_submission_time;
+    // NOTE: These also keep the pages alive for as long as the device might be using them.
+    DMASegments m_dma_segments;
+
+    // Once other requests have been merged into this one, the device works on a bounce buffer that covers
+    // all of them, and the data is copied between it and the buffers of the individual requests.
+    // The first entry describes this request itself.
+    struct MergedRequest {
+        LockRefPtr<AsyncBlockDeviceRequest> request;
+        u64 block_index { 0 };
+        u32 block_count { 0 };
+        UserOrKernelBuffer buffer;
+    };
+    Vector<MergedRequest, 8> m_merged_requests;
+    ByteBuffer m_merge_buffer;
 };
 
 }
@@ -117,20 +117,45 @@ ErrorOr<NonnullRefPtr<OpenFileDescription>> Device::open(int options)
     return File::open(options);
 }
 
-void Device::process_next_queued_request(Badge<AsyncDeviceRequest>, AsyncDeviceRequest const& completed_request)
+void Device::process_next_queued_request(Badge<AsyncDeviceRequest>, AsyncDeviceRequest& completed_request)
 {
     SpinlockLocker lock(m_requests_lock);
-    VERIFY(!m_requests.is_empty());
-    VERIFY(m_requests.first().ptr() == &completed_request);
-    m_requests.remove(m_requests.begin());
-    if (!m_requests.is_empty()) {
-        auto* next_request = m_requests.first().ptr();
-        next_request->do_start(move(lock));
-    }
+    VERIFY(m_started_requests_count > 0);
+    VERIFY(m_started_requests.contains(completed_request));
+    m_started_requests.remove(completed_request);
+    --m_started_requests_count;
+
+    start_next_queued_request(move(lock));
 
     evaluate_block_conditions();
 }
 
+void Device::start_next_queued_request(SpinlockLocker<Spinlock<LockRank::None>>&& lock)
+{
+    VERIFY(m_requests_lock.is_locked());
+    if (m_queued_requests.is_empty() || m_started_requests_count >= max_outstanding_requests())
+        return;
+
+    auto request = take_next_queued_request(m_queued_requests);
+    m_started_requests.append(*request);
+    ++m_started_requests_count;
+    ++m_total_started_requests;
+    m_peak_started_requests_count = max(m_peak_started_requests_count, m_started_requests_count);
+    request->do_start(move(lock));
+}
+
+Device::RequestQueueStatistics Device::request_queue_statistics() const
+{
+    SpinlockLocker lock(m_requests_lock);
+    return {
+        .queued_requests = m_queued_requests.size_slow(),
+        .in_flight_requests = m_started_requests_count,
+        .peak_in_flight_requests = m_peak_started_requests_count,
+        .started_requests = m_total_started_requests,
+        .merged_requests = m_total_merged_requests,
+    };
+}
+
 void Device::after_inserting_device(Badge<Device>, Device& device)
 {
     if (device.is_block_device()) {
@@ -15,7 +15,6 @@
 //   - BlockDevice (random access)
 //   - CharacterDevice (sequential)
 #include <AK/CircularQueue.h>
-#include <AK/DoublyLinkedList.h>
 #include <AK/Error.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
@@ -52,20 +51,31 @@ public:
     virtual void will_be_destroyed() override;
     virtual ErrorOr<void> after_inserting();
     virtual bool is_openable_by_jailed_processes() const { return false; }
-    void process_next_queued_request(Badge<AsyncDeviceRequest>, AsyncDeviceRequest const&);
+    void process_next_queued_request(Badge<AsyncDeviceRequest>, AsyncDeviceRequest&);
+
+    // Devices that can work on several requests at once (and complete them in any order) may let
+    // more than one of them be started.
+    virtual size_t max_outstanding_requests() const { return 1; }
 
     template<typename AsyncRequestType, typename... Args>
     ErrorOr<NonnullLockRefPtr<AsyncRequestType>> try_make_request(Args&&... args)
     {
         auto request = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) AsyncRequestType(*this, forward<Args>(args)...)));
         SpinlockLocker lock(m_requests_lock);
-        bool was_empty = m_requests.is_empty();
-        TRY(m_requests.try_append(request));
-        if (was_empty)
-            request->do_start(move(lock));
+        m_queued_requests.append(*request);
+        start_next_queued_request(move(lock));
         return request;
     }
 
+    struct RequestQueueStatistics {
+        size_t queued_requests { 0 };
+        size_t in_flight_requests { 0 };
+        size_t peak_in_flight_requests { 0 };
+        u64 started_requests { 0 };
+        u64 merged_requests { 0 };
+    };
+    RequestQueueStatistics request_queue_statistics() const;
+
     static SpinlockProtected<CircularQueue<DeviceEvent, 100>, LockRank::None>& event_queue();
     static BaseDevices* base_devices();
     static void after_inserting_device(Badge<Device>, Device&);
@@ -85,6 +95,13 @@ public:
 protected:
     Device(MajorNumber major, MinorNumber minor);
 
+    // Takes the request that should be started next out of the queue. This is called with the requests lock held.
+    // By default, requests are started in the order they were made.
+    virtual NonnullLockRefPtr<AsyncDeviceRequest> take_next_queued_request(AsyncDeviceRequest::DeviceRequestList& queued_requests) { return *queued_requests.take_first(); }
+
+    // Called with the requests lock held by whoever merged a queued request into the one that's about to be started.
+    void did_merge_queued_request() { ++m_total_merged_requests; }
+
     void after_inserting_add_to_device_management();
     void before_will_be_destroyed_remove_from_device_management();
 
@@ -118,8 +135,15 @@ private:
 
     State m_state { State::Normal };
 
-    Spinlock<LockRank::None> m_requests_lock {};
-    DoublyLinkedList<LockRefPtr<AsyncDeviceRequest>> m_requests;
+    void start_next_queued_request(SpinlockLocker<Spinlock<LockRank::None>>&&);
+
+    mutable Spinlock<LockRank::None> m_requests_lock {};
+    AsyncDeviceRequest::DeviceRequestList m_queued_requests;
+    AsyncDeviceRequest::DeviceRequestList m_started_requests;
+    size_t m_started_requests_count { 0 };
+    size_t m_peak_started_requests_count { 0 };
+    u64 m_total_started_requests { 0 };
+    u64 m_total_merged_requests { 0 };
 
 protected:
     // FIXME: This pointer will be eventually removed after all nodes in /sys/dev/block/ and
@@ -35,6 +35,15 @@ ErrorOr<void> FUSEDevice::initialize_instance(OpenFileDescription const& descrip
     });
 }
 
+FUSEDevice::FUSERequest* FUSEDevice::FUSEInstance::find_request(u64 unique)
+{
+    for (auto& request : requests) {
+        if (request.unique == unique)
+            return &request;
+    }
+    return nullptr;
+}
+
 bool FUSEDevice::can_read(OpenFileDescription const& description, u64) const
 {
     return m_instances.with([&](auto& instances) {
@@ -48,8 +57,8 @@ bool FUSEDevice::can_read(OpenFileDescription const& description, u64) const
             return false;
         }
 
-        auto const& requests_for_instance = (*instance_iterator).value;
-        for (auto const& request : requests_for_instance.in_reverse()) {
+        auto const& requests_for_instance = (*instance_iterator).value.requests;
+        for (auto const& request : requests_for_instance) {
             if (request.buffer_ready)
                 return true;
         }
@@ -69,16 +78,15 @@ ErrorOr<size_t> FUSEDevice::read(OpenFileDescription& description, u64, UserOrKe
         if (removed)
             return Error::from_errno(ENODEV);
 
-        if (size < 0x21000)
+        if (size < max_message_size)
             return Error::from_errno(EIO);
 
         auto instance_iterator = instances.active_instances.find(&description);
         if (instance_iterator == instances.active_instances.end())
             return Error::from_errno(ENODEV);
 
-        auto& requests_for_instance = (*instance_iterator).value;
-
-        for (auto& request : requests_for_instance.in_reverse()) {
+        // Hand out requests in the order they were made, so none of them has to wait for all the ones that came after it.
+        for (auto& request : (*instance_iterator).value.requests) {
             if (!request.buffer_ready)
                 continue;
 
@@ -93,67 +101,84 @@ ErrorOr<size_t> FUSEDevice::read(OpenFileDescription& description, u64, UserOrKe
 
 ErrorOr<size_t> FUSEDevice::write(OpenFileDescription& description, u64, UserOrKernelBuffer const& buffer, size_t size)
 {
-    return m_instances.with([&](auto& instances) -> ErrorOr<size_t> {
+    bool response_was_completed = false;
+    auto result = m_instances.with([&](auto& instances) -> ErrorOr<size_t> {
         auto instance_iterator = instances.active_instances.find(&description);
 
         if (instance_iterator == instances.active_instances.end())
             return Error::from_errno(ENODEV);
 
-        auto& requests_for_instance = (*instance_iterator).value;
-        auto& instance = requests_for_instance.last();
+        auto& instance = (*instance_iterator).value;
 
-        if (instance.expecting_header) {
-            memset(instance.response->data(), 0, instance.response->size());
+        if (instance.unique_awaiting_body.has_value()) {
+            auto unique = instance.unique_awaiting_body.release_value();
+            auto* request = instance.find_request(unique);
+            // The request might have timed out in the meantime, in which case we just swallow the body.
+            if (!request)
+                return size;
 
-            fuse_out_header header;
-            TRY(buffer.read(&header, 0, sizeof(fuse_out_header)));
+            auto& response = *request->response;
+            u64 length = response.size() - sizeof(fuse_out_header);
+            dbgln_if(FUSE_DEBUG, "request: response length: {}", length);
+            if (size < length)
+                return Error::from_errno(EINVAL);
+            TRY(buffer.read(response.data() + sizeof(fuse_out_header), 0, length));
+            request->response_ready = true;
+            response_was_completed = true;
+            return size;
+        }
 
-            dbgln_if(FUSE_DEBUG, "header: length: {}, error: {}, unique: {}", header.len, header.error, header.unique);
-            memcpy(instance.response->data(), &header, sizeof(fuse_out_header));
+        if (size < sizeof(fuse_out_header))
+            return Error::from_errno(EINVAL);
 
-            if (header.len > sizeof(fuse_out_header)) {
-                instance.expecting_header = false;
-            } else {
-                instance.response_ready = true;
-                instance_queue.notify_all();
-            }
-        } else {
-            fuse_out_header* existing_header = bit_cast<fuse_out_header*>(instance.response->data());
+        fuse_out_header header;
+        TRY(buffer.read(&header, 0, sizeof(fuse_out_header)));
+        dbgln_if(FUSE_DEBUG, "header: length: {}, error: {}, unique: {}", header.len, header.error, header.unique);
 
-            instance.expecting_header = true;
-            if (existing_header->len > instance.response->size())
-                return Error::from_errno(EINVAL);
+        if (header.len < sizeof(fuse_out_header) || header.len > max_message_size)
+            return Error::from_errno(EINVAL);
 
-            instance.response_ready = true;
-            instance_queue.notify_all();
-            u64 length = existing_header->len - sizeof(fuse_out_header);
-            dbgln_if(FUSE_DEBUG, "request: response length: {}", length);
-            TRY(buffer.read(instance.response->data() + sizeof(fuse_out_header), 0, length));
+        auto* request = instance.find_request(header.unique);
+        if (!request || request->buffer_ready || request->response_ready)
+            return Error::from_errno(ENOENT);
+
+        request->response = TRY(KBuffer::try_create_with_size("FUSE: Response buffer"sv, header.len));
+        memcpy(request->response->data(), &header, sizeof(fuse_out_header));
+
+        if (header.len == sizeof(fuse_out_header)) {
+            request->response_ready = true;
+            response_was_completed = true;
+        } else if (size >= header.len) {
+            TRY(buffer.read(request->response->data() + sizeof(fuse_out_header), sizeof(fuse_out_header), header.len - sizeof(fuse_out_header)));
+            request->response_ready = true;
+            response_was_completed = true;
+        } else {
+            instance.unique_awaiting_body = header.unique;
         }
 
         return size;
     });
+
+    if (response_was_completed)
+        instance_queue.notify_all();
+    return result;
 }
 
 ErrorOr<void> FUSEDevice::queue_request(OpenFileDescription const& description, Bytes bytes, InstanceTracker& instances)
 {
-    VERIFY(bytes.size() >= sizeof(fuse_in_header) && bytes.size() <= 0x21000);
+    VERIFY(bytes.size() >= sizeof(fuse_in_header) && bytes.size() <= max_message_size);
 
     auto instance_iterator = instances.active_instances.find(&description);
     VERIFY(instance_iterator != instances.active_instances.end());
-    auto& requests_for_instance = (*instance_iterator).value;
+    auto& requests_for_instance = (*instance_iterator).value.requests;
 
+    // NOTE: The response buffer is only allocated once we know how large the response is.
     TRY(requests_for_instance.try_append({
-        &description,
-        TRY(KBuffer::try_create_with_size("FUSE: Pending request buffer"sv, 0x21000)),
-        TRY(KBuffer::try_create_with_size("FUSE: Response buffer"sv, 0x21000)),
+        bit_cast<fuse_in_header*>(bytes.data())->unique,
+        TRY(KBuffer::try_create_with_bytes("FUSE: Pending request buffer"sv, bytes)),
+        nullptr,
     }));
-
-    auto& instance = requests_for_instance.last();
-
-    memset(instance.pending_request->data(), 0, instance.pending_request->size());
-    memcpy(instance.pending_request->data(), bytes.data(), bytes.size());
-    instance.buffer_ready = true;
+    requests_for_instance.last().buffer_ready = true;
 
     return {};
 }
@@ -172,10 +197,10 @@ ErrorOr<NonnullOwnPtr<KBuffer>> FUSEDevice::send_request_and_wait_for_a_reply(Op
     auto receive_reply = [&](auto& instances) -> bool {
         auto instance_iterator = instances.active_instances.find(&description);
         VERIFY(instance_iterator != instances.active_instances.end());
-        auto& requests_for_instance = (*instance_iterator).value;
+        auto& requests_for_instance = (*instance_iterator).value.requests;
 
         for (size_t i = 0; i < requests_for_instance.size(); ++i) {
-            if (bit_cast<fuse_in_header*>(requests_for_instance[i].pending_request->data())->unique != unique)
+            if (requests_for_instance[i].unique != unique)
                 continue;
             if (requests_for_instance[i].timed_out) {
                 requests_for_instance.remove(i);
@@ -184,7 +209,7 @@ ErrorOr<NonnullOwnPtr<KBuffer>> FUSEDevice::send_request_and_wait_for_a_reply(Op
             }
             if (!requests_for_instance[i].response_ready)
                 continue;
-            reply_or_error = KBuffer::try_create_with_bytes("FUSEDevice: Response"sv, requests_for_instance[i].response->bytes());
+            reply_or_error = move(requests_for_instance[i].response);
             requests_for_instance.remove(i);
             return true;
         }
@@ -196,14 +221,8 @@ ErrorOr<NonnullOwnPtr<KBuffer>> FUSEDevice::send_request_and_wait_for_a_reply(Op
         m_instances.with([&](auto& instances) {
             auto instance_iterator = instances.active_instances.find(&description);
             VERIFY(instance_iterator != instances.active_instances.end());
-            auto& requests_for_instance = (*instance_iterator).value;
-
-            for (auto& request : requests_for_instance) {
-                if (bit_cast<fuse_in_header*>(request.pending_request->data())->unique != unique)
-                    continue;
-                request.timed_out = true;
-                break;
-            }
+            if (auto* request = (*instance_iterator).value.find_request(unique))
+                request->timed_out = true;
         });
         instance_queue.notify_all();
     };
@@ -21,6 +21,9 @@ public:
     static NonnullRefPtr<FUSEDevice> must_create();
     virtual ~FUSEDevice() override;
 
+    // Daemons have to read requests with buffers of at least this size, and no reply may be larger.
+    static constexpr size_t max_message_size = 0x21000;
+
     ErrorOr<void> initialize_instance(OpenFileDescription const&);
     ErrorOr<NonnullOwnPtr<KBuffer>> send_request_and_wait_for_a_reply(OpenFileDescription const&, Bytes);
     void shutdown_for_description(OpenFileDescription const&);
@@ -38,18 +41,26 @@ private:
     virtual bool can_write(OpenFileDescription const&, u64) const override;
     virtual StringView class_name() const override { return "FUSEDevice"sv; }
 
-    struct FUSEInstance {
-        OpenFileDescription const* fd = nullptr;
+    struct FUSERequest {
+        u64 unique { 0 };
         NonnullOwnPtr<KBuffer> pending_request;
-        NonnullOwnPtr<KBuffer> response;
+        OwnPtr<KBuffer> response;
         bool buffer_ready = false;
         bool timed_out = false;
         bool response_ready = false;
-        bool expecting_header = true;
+    };
+
+    // Any number of requests can be outstanding on an instance at once, the daemon can answer them in any order.
+    struct FUSEInstance {
+        Vector<FUSERequest> requests;
+        // Set while the body of a reply is expected in the next write (e.g. from a writev() of header and body).
+        Optional<u64> unique_awaiting_body;
+
+        FUSERequest* find_request(u64 unique);
     };
 
     struct InstanceTracker {
-        HashMap<OpenFileDescription const*, Vector<FUSEInstance>> active_instances;
+        HashMap<OpenFileDescription const*, FUSEInstance> active_instances;
         Vector<OpenFileDescription const*> closing_instances;
     };
 
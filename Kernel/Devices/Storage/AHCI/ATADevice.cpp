@@ -32,4 +32,16 @@ void ATADevice::start_request(AsyncBlockDeviceRequest& request)
     m_controller->start_request(m_ata_address, request);
 }
 
+size_t ATADevice::max_outstanding_requests() const
+{
+    VERIFY(m_controller);
+    return m_controller->max_outstanding_requests(m_ata_address);
+}
+
+bool ATADevice::is_rotational() const
+{
+    VERIFY(m_controller);
+    return m_controller->is_rotational(m_ata_address);
+}
+
 }
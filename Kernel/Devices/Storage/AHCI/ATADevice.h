@@ -17,8 +17,12 @@ class ATADevice : public StorageDevice {
 public:
     virtual ~ATADevice() override;
 
+    // ^Device
+    virtual size_t max_outstanding_requests() const override;
+
     // ^BlockDevice
     virtual void start_request(AsyncBlockDeviceRequest&) override;
+    virtual bool is_rotational() const override;
 
     u16 ata_capabilites() const { return m_capabilities; }
     ATA::Address const& ata_address() const { return m_ata_address; }
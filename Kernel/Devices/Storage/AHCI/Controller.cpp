@@ -91,6 +91,20 @@ void AHCIController::start_request(ATA::Address address, AsyncBlockDeviceRequest
     port->start_request(request);
 }
 
+size_t AHCIController::max_outstanding_requests(ATA::Address address) const
+{
+    auto port = m_ports[address.port];
+    VERIFY(port);
+    return port->max_outstanding_requests();
+}
+
+bool AHCIController::is_rotational(ATA::Address address) const
+{
+    auto port = m_ports[address.port];
+    VERIFY(port);
+    return port->is_rotational();
+}
+
 void AHCIController::complete_current_request(AsyncDeviceRequest::RequestResult)
 {
     VERIFY_NOT_REACHED();
@@ -180,11 +194,11 @@ UNMAP_AFTER_INIT ErrorOr<void> AHCIController::initialize_hba(PCI::DeviceIdentif
     return {};
 }
 
-void AHCIController::handle_interrupt_for_port(Badge<AHCIInterruptHandler>, u32 port_index) const
+void AHCIController::handle_interrupt_for_port(Badge<AHCIInterruptHandler>, u32 port_index, WorkQueue::Batch& batch) const
 {
     auto port = m_ports[port_index];
     VERIFY(port);
-    port->handle_interrupt();
+    port->handle_interrupt(batch);
 }
 
 void AHCIController::disable_global_interrupts() const
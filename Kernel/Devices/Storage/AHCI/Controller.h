@@ -14,6 +14,7 @@
 #include <Kernel/Library/LockRefPtr.h>
 #include <Kernel/Memory/TypedMapping.h>
 #include <Kernel/Sections.h>
+#include <Kernel/Tasks/WorkQueue.h>
 
 namespace Kernel {
 
@@ -35,8 +36,10 @@ public:
     virtual void complete_current_request(AsyncDeviceRequest::RequestResult) override;
 
     void start_request(ATA::Address, AsyncBlockDeviceRequest&);
+    size_t max_outstanding_requests(ATA::Address) const;
+    bool is_rotational(ATA::Address) const;
 
-    void handle_interrupt_for_port(Badge<AHCIInterruptHandler>, u32 port_index) const;
+    void handle_interrupt_for_port(Badge<AHCIInterruptHandler>, u32 port_index, WorkQueue::Batch&) const;
 
 private:
     ErrorOr<void> reset();
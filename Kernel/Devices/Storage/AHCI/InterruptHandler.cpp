@@ -5,6 +5,7 @@
  */
 
 #include <Kernel/Devices/Storage/AHCI/InterruptHandler.h>
+#include <Kernel/Tasks/WorkQueue.h>
 
 namespace Kernel {
 
@@ -43,12 +44,15 @@ bool AHCIInterruptHandler::handle_irq()
     dbgln_if(AHCI_DEBUG, "AHCI Port Handler: IRQ received");
     if (m_pending_ports_interrupts.is_zeroed())
         return false;
+    // Deferred work from all ports is queued together, so we only wake up the work queue once.
+    WorkQueue::Batch batch;
     for (auto port_index : m_pending_ports_interrupts.to_vector()) {
         dbgln_if(AHCI_DEBUG, "AHCI Port Handler: Handling IRQ for port {}", port_index);
-        m_parent_controller->handle_interrupt_for_port({}, port_index);
+        m_parent_controller->handle_interrupt_for_port({}, port_index, batch);
         // We do this to clear the pending interrupt after we handled it.
         m_pending_ports_interrupts.set_at(port_index);
     }
+    g_io_work->queue(batch);
     return true;
 }
 
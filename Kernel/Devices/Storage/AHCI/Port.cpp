@@ -8,6 +8,7 @@
 // please look at Documentation/Kernel/AHCILocking.md
 
 #include <AK/Atomic.h>
+#include <AK/NumericLimits.h>
 #include <Kernel/Arch/Delay.h>
 #include <Kernel/Arch/MemoryFences.h>
 #include <Kernel/Devices/Storage/AHCI/ATADiskDevice.h>
@@ -38,11 +39,14 @@ ErrorOr<void> AHCIPort::allocate_resources_and_initialize_ports()
 
     m_fis_receive_page = TRY(MM.allocate_physical_page());
 
-    for (size_t index = 0; index < 1; index++) {
+    // Note: Every command slot we can use needs its own command table and DMA buffers,
+    // so that multiple requests can be issued to the device at the same time.
+    size_t command_slots_count = min<size_t>(m_hba_capabilities.max_command_list_entries_count, AHCI::Limits::MaxCommands);
+    for (size_t index = 0; index < command_slots_count * dma_buffers_per_command_slot; index++) {
         auto dma_page = TRY(MM.allocate_physical_page());
         m_dma_buffers.append(move(dma_page));
     }
-    for (size_t index = 0; index < 1; index++) {
+    for (size_t index = 0; index < command_slots_count; index++) {
         auto command_table_page = TRY(MM.allocate_physical_page());
         m_command_table_pages.append(move(command_table_page));
     }
@@ -73,7 +77,7 @@ void AHCIPort::clear_sata_error_register() const
     m_port_registers.serr = m_port_registers.serr;
 }
 
-void AHCIPort::handle_interrupt()
+void AHCIPort::handle_interrupt(WorkQueue::Batch& batch)
 {
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Interrupt handled, PxIS {}", representative_port_index(), m_interrupt_status.raw_value());
     if (m_interrupt_status.raw_value() == 0) {
@@ -84,23 +88,17 @@ void AHCIPort::handle_interrupt()
         if ((m_port_registers.ssts & 0xf) != 3 && m_connected_device) {
             m_connected_device->prepare_for_unplug();
             StorageManagement::the().remove_device(*m_connected_device);
-            auto work_item_creation_result = g_io_work->try_queue([this]() {
+            auto work_item_creation_result = batch.try_append([this]() {
                 m_connected_device.clear();
             });
-            if (work_item_creation_result.is_error()) {
-                auto current_request = m_current_request;
-                m_current_request.clear();
-                current_request->complete(AsyncDeviceRequest::OutOfMemory);
-            }
+            if (work_item_creation_result.is_error())
+                complete_requests_in_command_slots(NumericLimits<u32>::max(), AsyncDeviceRequest::Failure);
         } else {
-            auto work_item_creation_result = g_io_work->try_queue([this]() {
+            auto work_item_creation_result = batch.try_append([this]() {
                 reset();
             });
-            if (work_item_creation_result.is_error()) {
-                auto current_request = m_current_request;
-                m_current_request.clear();
-                current_request->complete(AsyncDeviceRequest::OutOfMemory);
-            }
+            if (work_item_creation_result.is_error())
+                complete_requests_in_command_slots(NumericLimits<u32>::max(), AsyncDeviceRequest::Failure);
         }
         return;
     }
@@ -110,63 +108,47 @@ void AHCIPort::handle_interrupt()
     if (m_interrupt_status.is_set(AHCI::PortInterruptFlag::INF)) {
         // We need to defer the reset, because we can receive interrupts when
         // resetting the device.
-        auto work_item_creation_result = g_io_work->try_queue([this]() {
+        auto work_item_creation_result = batch.try_append([this]() {
             reset();
         });
-        if (work_item_creation_result.is_error()) {
-            auto current_request = m_current_request;
-            m_current_request.clear();
-            current_request->complete(AsyncDeviceRequest::OutOfMemory);
-        }
+        if (work_item_creation_result.is_error())
+            complete_requests_in_command_slots(NumericLimits<u32>::max(), AsyncDeviceRequest::Failure);
         return;
     }
     if (m_interrupt_status.is_set(AHCI::PortInterruptFlag::IF) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::TFE) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::HBD) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::HBF)) {
-        auto work_item_creation_result = g_io_work->try_queue([this]() {
+        auto work_item_creation_result = batch.try_append([this]() {
             recover_from_fatal_error();
         });
-        if (work_item_creation_result.is_error()) {
-            auto current_request = m_current_request;
-            m_current_request.clear();
-            current_request->complete(AsyncDeviceRequest::OutOfMemory);
-        }
+        if (work_item_creation_result.is_error())
+            complete_requests_in_command_slots(NumericLimits<u32>::max(), AsyncDeviceRequest::Failure);
         return;
     }
-    if (m_interrupt_status.is_set(AHCI::PortInterruptFlag::DHR) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::PS)) {
-        m_wait_for_completion = false;
+    // Note: Regular commands complete with a Device to Host Register FIS, while queued commands
+    // are completed (possibly several at once, and in any order) with a Set Device Bits FIS.
+    if (m_interrupt_status.is_set(AHCI::PortInterruptFlag::DHR) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::PS) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::SDB)) {
+        u32 completed_command_slots = 0;
+        {
+            SpinlockLocker lock(m_hard_lock);
+            u32 active_command_slots = m_native_command_queuing_enabled ? m_port_registers.sact : m_port_registers.ci;
+            completed_command_slots = m_issued_command_slots & ~active_command_slots;
+            m_issued_command_slots &= ~completed_command_slots;
+        }
 
         // Now schedule reading/writing the buffer as soon as we leave the irq handler.
         // This is important so that we can safely access the buffers, which could
         // trigger page faults
-        if (!m_current_request) {
+        if (completed_command_slots == 0) {
             dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request handled, probably identify request", representative_port_index());
         } else {
-            auto work_item_creation_result = g_io_work->try_queue([this]() {
-                dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request handled", representative_port_index());
+            auto work_item_creation_result = batch.try_append([this, completed_command_slots]() {
                 MutexLocker locker(m_lock);
-                VERIFY(m_current_request);
-                VERIFY(m_current_scatter_list);
-                if (!m_connected_device) {
-                    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request success", representative_port_index());
-                    complete_current_request(AsyncDeviceRequest::Failure);
-                    return;
-                }
-                if (m_current_request->request_type() == AsyncBlockDeviceRequest::Read) {
-                    if (auto result = m_current_request->write_to_buffer(m_current_request->buffer(), m_current_scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * m_current_request->block_count()); result.is_error()) {
-                        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, memory fault occurred when reading in data.", representative_port_index());
-                        m_current_scatter_list = nullptr;
-                        complete_current_request(AsyncDeviceRequest::MemoryFault);
-                        return;
-                    }
+                for (u8 command_slot = 0; command_slot < m_command_slots.size(); command_slot++) {
+                    if (completed_command_slots & (1u << command_slot))
+                        finish_request_in_command_slot(command_slot);
                 }
-                m_current_scatter_list = nullptr;
-                dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request success", representative_port_index());
-                complete_current_request(AsyncDeviceRequest::Success);
             });
-            if (work_item_creation_result.is_error()) {
-                auto current_request = m_current_request;
-                m_current_request.clear();
-                current_request->complete(AsyncDeviceRequest::OutOfMemory);
-            }
+            if (work_item_creation_result.is_error())
+                complete_requests_in_command_slots(completed_command_slots, AsyncDeviceRequest::Failure);
         }
     }
 
@@ -253,6 +235,9 @@ bool AHCIPort::initialize()
     size_t physical_sector_size = 512;
     u64 max_addressable_sector = 0;
 
+    m_native_command_queuing_enabled = false;
+    m_queue_depth = 1;
+
     if (identify_device()) {
         auto identify_block = Memory::map_typed<ATAIdentifyBlock>(m_identify_buffer_page->paddr()).release_value_but_fixme_should_propagate_errors();
         // Check if word 106 is valid before using it!
@@ -274,6 +259,16 @@ bool AHCIPort::initialize()
         if (is_atapi_attached()) {
             m_port_registers.cmd = m_port_registers.cmd | (1 << 24);
         }
+        // Check if both the HBA and the device support Native Command Queuing (word 76, bit 8).
+        // The device tells us in word 75 how many commands it can take at once.
+        if (!is_atapi_attached() && m_hba_capabilities.native_command_queuing_supported && (identify_block->serial_ata_capabilities & (1 << 8))) {
+            m_native_command_queuing_enabled = true;
+            m_queue_depth = min<size_t>((identify_block->queue_depth & 0x1f) + 1, m_command_table_pages.size());
+            dbgln_if(AHCI_DEBUG, "AHCI Port {}: Using Native Command Queuing, queue depth {}", representative_port_index(), m_queue_depth);
+        }
+
+        // Word 217 is 1 for devices that don't rotate (i.e. SSDs), or the rotation rate in RPM.
+        m_rotational = identify_block->nominal_media_rotation_rate != 1;
 
         dmesgln("AHCI Port {}: Device found, Capacity={}, Bytes per logical sector={}, Bytes per physical sector={}", representative_port_index(), max_addressable_sector * logical_sector_size, logical_sector_size, physical_sector_size);
 
@@ -406,28 +401,59 @@ size_t AHCIPort::calculate_descriptors_count(size_t block_count) const
 {
     VERIFY(m_connected_device);
     size_t needed_dma_regions_count = Memory::page_round_up((block_count * m_connected_device->block_size())).value() / PAGE_SIZE;
-    VERIFY(needed_dma_regions_count <= m_dma_buffers.size());
+    VERIFY(needed_dma_regions_count <= dma_buffers_per_command_slot);
     return needed_dma_regions_count;
 }
 
-Optional<AsyncDeviceRequest::RequestResult> AHCIPort::prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request)
+bool AHCIPort::can_transfer_directly(AsyncBlockDeviceRequest const& request) const
+{
+    auto dma_segments = request.dma_segments();
+    if (dma_segments.is_empty())
+        return false;
+    for (auto const& segment : dma_segments) {
+        // Note: Physical region descriptors need a word aligned address and an even byte count.
+        if ((segment.paddr().get() & 1) || (segment.length & 1))
+            return false;
+        if (!m_hba_capabilities.addressing_64_bit_supported && segment.paddr().get() + segment.length > 0x100000000ull)
+            return false;
+    }
+    return true;
+}
+
+Optional<AsyncDeviceRequest::RequestResult> AHCIPort::prepare_and_set_scatter_list(u8 command_slot, AsyncBlockDeviceRequest& request)
 {
     VERIFY(m_lock.is_locked());
     VERIFY(request.block_count() > 0);
 
+    // Note: There's nothing to prepare if the HBA can get at the buffer of the request itself.
+    if (can_transfer_directly(request))
+        return {};
+
     Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> allocated_dma_regions;
     for (size_t index = 0; index < calculate_descriptors_count(request.block_count()); index++) {
-        allocated_dma_regions.append(m_dma_buffers.at(index));
+        allocated_dma_regions.append(m_dma_buffers.at(command_slot * dma_buffers_per_command_slot + index));
     }
 
-    m_current_scatter_list = Memory::ScatterGatherList::try_create(request, allocated_dma_regions.span(), m_connected_device->block_size(), "AHCI Scattered DMA"sv).release_value_but_fixme_should_propagate_errors();
-    if (!m_current_scatter_list)
+    auto scatter_list = Memory::ScatterGatherList::try_create(request, allocated_dma_regions.span(), m_connected_device->block_size(), "AHCI Scattered DMA"sv).release_value_but_fixme_should_propagate_errors();
+    if (!scatter_list)
         return AsyncDeviceRequest::Failure;
     if (request.request_type() == AsyncBlockDeviceRequest::Write) {
-        if (auto result = request.read_from_buffer(request.buffer(), m_current_scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * request.block_count()); result.is_error()) {
+        if (auto result = request.read_from_buffer(request.buffer(), scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * request.block_count()); result.is_error()) {
             return AsyncDeviceRequest::MemoryFault;
         }
     }
+    SpinlockLocker lock(m_hard_lock);
+    m_command_slots[command_slot].scatter_list = move(scatter_list);
+    return {};
+}
+
+Optional<u8> AHCIPort::try_to_find_unused_command_slot() const
+{
+    VERIFY(m_hard_lock.is_locked());
+    for (u8 command_slot = 0; command_slot < m_command_table_pages.size(); command_slot++) {
+        if (!m_command_slots[command_slot].request)
+            return command_slot;
+    }
     return {};
 }
 
@@ -435,34 +461,90 @@ void AHCIPort::start_request(AsyncBlockDeviceRequest& request)
 {
     MutexLocker locker(m_lock);
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request start", representative_port_index());
-    VERIFY(!m_current_request);
-    VERIFY(!m_current_scatter_list);
 
-    m_current_request = request;
+    u8 command_slot = 0;
+    {
+        SpinlockLocker lock(m_hard_lock);
+        // Note: The Device never starts more requests than our queue depth, so there's always a free slot.
+        auto unused_command_slot = try_to_find_unused_command_slot();
+        VERIFY(unused_command_slot.has_value());
+        command_slot = unused_command_slot.value();
+        VERIFY(!m_command_slots[command_slot].scatter_list);
+        m_command_slots[command_slot].request = request;
+    }
 
-    auto result = prepare_and_set_scatter_list(request);
+    auto result = prepare_and_set_scatter_list(command_slot, request);
     if (result.has_value()) {
         dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure.", representative_port_index());
         locker.unlock();
-        complete_current_request(result.value());
+        complete_request_in_command_slot(command_slot, result.value());
         return;
     }
 
-    auto success = access_device(request.request_type(), request.block_index(), request.block_count());
+    auto success = access_device(command_slot, request.request_type(), request.block_index(), request.block_count());
     if (!success) {
         dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure.", representative_port_index());
         locker.unlock();
-        complete_current_request(AsyncDeviceRequest::Failure);
+        complete_request_in_command_slot(command_slot, AsyncDeviceRequest::Failure);
         return;
     }
 }
 
-void AHCIPort::complete_current_request(AsyncDeviceRequest::RequestResult result)
+void AHCIPort::finish_request_in_command_slot(u8 command_slot)
 {
-    VERIFY(m_current_request);
-    auto current_request = m_current_request;
-    m_current_request.clear();
-    current_request->complete(result);
+    VERIFY(m_lock.is_locked());
+    LockRefPtr<AsyncBlockDeviceRequest> request;
+    LockRefPtr<Memory::ScatterGatherList> scatter_list;
+    {
+        SpinlockLocker lock(m_hard_lock);
+        request = m_command_slots[command_slot].request;
+        scatter_list = m_command_slots[command_slot].scatter_list;
+    }
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request in command slot {} handled", representative_port_index(), command_slot);
+    VERIFY(request);
+    if (!m_connected_device) {
+        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, device is gone.", representative_port_index());
+        complete_request_in_command_slot(command_slot, AsyncDeviceRequest::Failure);
+        return;
+    }
+    if (scatter_list && request->request_type() == AsyncBlockDeviceRequest::Read) {
+        if (auto result = request->write_to_buffer(request->buffer(), scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * request->block_count()); result.is_error()) {
+            dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, memory fault occurred when reading in data.", representative_port_index());
+            complete_request_in_command_slot(command_slot, AsyncDeviceRequest::MemoryFault);
+            return;
+        }
+    }
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request success", representative_port_index());
+    complete_request_in_command_slot(command_slot, AsyncDeviceRequest::Success);
+}
+
+void AHCIPort::complete_request_in_command_slot(u8 command_slot, AsyncDeviceRequest::RequestResult result)
+{
+    LockRefPtr<AsyncBlockDeviceRequest> request;
+    {
+        // Note: The slot has to be free again before completing the request, because that starts the next one.
+        SpinlockLocker lock(m_hard_lock);
+        request = move(m_command_slots[command_slot].request);
+        m_command_slots[command_slot].scatter_list = nullptr;
+    }
+    VERIFY(request);
+    request->complete(result);
+}
+
+void AHCIPort::complete_requests_in_command_slots(u32 command_slots, AsyncDeviceRequest::RequestResult result)
+{
+    for (u8 command_slot = 0; command_slot < m_command_slots.size(); command_slot++) {
+        if (!(command_slots & (1u << command_slot)))
+            continue;
+        LockRefPtr<AsyncBlockDeviceRequest> request;
+        {
+            SpinlockLocker lock(m_hard_lock);
+            request = move(m_command_slots[command_slot].request);
+            m_command_slots[command_slot].scatter_list = nullptr;
+        }
+        if (request)
+            request->complete(result);
+    }
 }
 
 bool AHCIPort::spin_until_ready() const
@@ -481,35 +563,37 @@ bool AHCIPort::spin_until_ready() const
     return true;
 }
 
-bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64 lba, u8 block_count)
+bool AHCIPort::access_device(u8 command_slot, AsyncBlockDeviceRequest::RequestType direction, u64 lba, u8 block_count)
 {
     VERIFY(m_connected_device);
     VERIFY(is_operable());
     VERIFY(m_lock.is_locked());
-    VERIFY(m_current_scatter_list);
     SpinlockLocker lock(m_hard_lock);
-
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {}", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count);
-    if (!spin_until_ready())
+    auto& scatter_list = m_command_slots[command_slot].scatter_list;
+    auto& request = m_command_slots[command_slot].request;
+    VERIFY(request);
+    VERIFY(scatter_list || can_transfer_directly(*request));
+
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {}, command slot {}", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count, command_slot);
+    // Note: Queued commands are accepted by the device while it's still busy with other ones.
+    if (!m_native_command_queuing_enabled && !spin_until_ready())
         return false;
 
-    auto unused_command_header = try_to_find_unused_command_header();
-    VERIFY(unused_command_header.has_value());
     auto* command_list_entries = (volatile AHCI::CommandHeader*)m_command_list_region->vaddr().as_ptr();
-    command_list_entries[unused_command_header.value()].ctba = m_command_table_pages[unused_command_header.value()]->paddr().get();
-    command_list_entries[unused_command_header.value()].ctbau = 0;
-    command_list_entries[unused_command_header.value()].prdbc = 0;
-    command_list_entries[unused_command_header.value()].prdtl = m_current_scatter_list->scatters_count();
+    command_list_entries[command_slot].ctba = m_command_table_pages[command_slot]->paddr().get();
+    command_list_entries[command_slot].ctbau = 0;
+    command_list_entries[command_slot].prdbc = 0;
+    command_list_entries[command_slot].prdtl = scatter_list ? scatter_list->scatters_count() : request->dma_segments().size();
 
     // Note: we must set the correct Dword count in this register. Real hardware
     // AHCI controllers do care about this field! QEMU doesn't care if we don't
     // set the correct CFL field in this register, real hardware will set an
     // handshake error bit in PxSERR register if CFL is incorrect.
-    command_list_entries[unused_command_header.value()].attributes = (size_t)FIS::DwordCount::RegisterHostToDevice | AHCI::CommandHeaderAttributes::P | (is_atapi_attached() ? AHCI::CommandHeaderAttributes::A : 0) | (direction == AsyncBlockDeviceRequest::RequestType::Write ? AHCI::CommandHeaderAttributes::W : 0);
+    command_list_entries[command_slot].attributes = (size_t)FIS::DwordCount::RegisterHostToDevice | AHCI::CommandHeaderAttributes::P | (is_atapi_attached() ? AHCI::CommandHeaderAttributes::A : 0) | (direction == AsyncBlockDeviceRequest::RequestType::Write ? AHCI::CommandHeaderAttributes::W : 0);
 
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: CLE: ctba={:#08x}, ctbau={:#08x}, prdbc={:#08x}, prdtl={:#04x}, attributes={:#04x}", representative_port_index(), (u32)command_list_entries[unused_command_header.value()].ctba, (u32)command_list_entries[unused_command_header.value()].ctbau, (u32)command_list_entries[unused_command_header.value()].prdbc, (u16)command_list_entries[unused_command_header.value()].prdtl, (u16)command_list_entries[unused_command_header.value()].attributes);
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: CLE: ctba={:#08x}, ctbau={:#08x}, prdbc={:#08x}, prdtl={:#04x}, attributes={:#04x}", representative_port_index(), (u32)command_list_entries[command_slot].ctba, (u32)command_list_entries[command_slot].ctbau, (u32)command_list_entries[command_slot].prdbc, (u16)command_list_entries[command_slot].prdtl, (u16)command_list_entries[command_slot].attributes);
 
-    auto command_table_region = MM.allocate_kernel_region_with_physical_pages({ &m_command_table_pages[unused_command_header.value()], 1 }, "AHCI Command Table"sv, Memory::Region::Access::ReadWrite, Memory::MemoryType::IO).release_value();
+    auto command_table_region = MM.allocate_kernel_region_with_physical_pages({ &m_command_table_pages[command_slot], 1 }, "AHCI Command Table"sv, Memory::Region::Access::ReadWrite, Memory::MemoryType::IO).release_value();
     auto& command_table = *(volatile AHCI::CommandTable*)command_table_region->vaddr().as_ptr();
 
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Allocated command table at {}", representative_port_index(), command_table_region->vaddr());
@@ -518,20 +602,33 @@ bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64
 
     size_t scatter_entry_index = 0;
     size_t data_transfer_count = (block_count * m_connected_device->block_size());
-    for (auto scatter_page : m_current_scatter_list->vmobject().physical_pages()) {
-        VERIFY(data_transfer_count != 0);
-        VERIFY(scatter_page);
-        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Add a transfer scatter entry @ {}", representative_port_index(), scatter_page->paddr());
-        command_table.descriptors[scatter_entry_index].base_high = 0;
-        command_table.descriptors[scatter_entry_index].base_low = scatter_page->paddr().get();
-        if (data_transfer_count <= PAGE_SIZE) {
-            command_table.descriptors[scatter_entry_index].byte_count = data_transfer_count - 1;
-            data_transfer_count = 0;
-        } else {
-            command_table.descriptors[scatter_entry_index].byte_count = PAGE_SIZE - 1;
-            data_transfer_count -= PAGE_SIZE;
+    if (scatter_list) {
+        for (auto scatter_page : scatter_list->vmobject().physical_pages()) {
+            VERIFY(data_transfer_count != 0);
+            VERIFY(scatter_page);
+            dbgln_if(AHCI_DEBUG, "AHCI Port {}: Add a transfer scatter entry @ {}", representative_port_index(), scatter_page->paddr());
+            command_table.descriptors[scatter_entry_index].base_high = 0;
+            command_table.descriptors[scatter_entry_index].base_low = scatter_page->paddr().get();
+            if (data_transfer_count <= PAGE_SIZE) {
+                command_table.descriptors[scatter_entry_index].byte_count = data_transfer_count - 1;
+                data_transfer_count = 0;
+            } else {
+                command_table.descriptors[scatter_entry_index].byte_count = PAGE_SIZE - 1;
+                data_transfer_count -= PAGE_SIZE;
+            }
+            scatter_entry_index++;
+        }
+    } else {
+        for (auto const& segment : request->dma_segments()) {
+            VERIFY(data_transfer_count >= segment.length);
+            dbgln_if(AHCI_DEBUG, "AHCI Port {}: Add a direct transfer entry @ {}, length {}", representative_port_index(), segment.paddr(), segment.length);
+            command_table.descriptors[scatter_entry_index].base_high = static_cast<u32>(segment.paddr().get() >> 32);
+            command_table.descriptors[scatter_entry_index].base_low = static_cast<u32>(segment.paddr().get());
+            command_table.descriptors[scatter_entry_index].byte_count = segment.length - 1;
+            data_transfer_count -= segment.length;
+            scatter_entry_index++;
         }
-        scatter_entry_index++;
+        VERIFY(data_transfer_count == 0);
     }
     command_table.descriptors[scatter_entry_index].byte_count = (PAGE_SIZE - 1) | (1 << 31);
 
@@ -542,6 +639,11 @@ bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64
     if (is_atapi_attached()) {
         fis.command = ATA_CMD_PACKET;
         TODO();
+    } else if (m_native_command_queuing_enabled) {
+        if (direction == AsyncBlockDeviceRequest::RequestType::Write)
+            fis.command = ATA_CMD_WRITE_FPDMA_QUEUED;
+        else
+            fis.command = ATA_CMD_READ_FPDMA_QUEUED;
     } else {
         if (direction == AsyncBlockDeviceRequest::RequestType::Write)
             fis.command = ATA_CMD_WRITE_DMA_EXT;
@@ -560,17 +662,25 @@ bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64
     fis.lba_low[0] = lba & 0xff;
     fis.lba_low[1] = (lba >> 8) & 0xff;
     fis.lba_low[2] = (lba >> 16) & 0xff;
-    fis.count = (block_count);
+    if (m_native_command_queuing_enabled) {
+        // Note: Queued commands take the sector count in the features field,
+        // and the tag of the command (which is just its command slot) in the count field.
+        fis.features_low = block_count;
+        fis.features_high = 0;
+        fis.count = command_slot << 3;
+    } else {
+        fis.count = (block_count);
 
-    // The below loop waits until the port is no longer busy before issuing a new command
-    if (!spin_until_ready())
-        return false;
+        // The below loop waits until the port is no longer busy before issuing a new command
+        if (!spin_until_ready())
+            return false;
+    }
 
     full_memory_fence();
-    mark_command_header_ready_to_process(unused_command_header.value());
+    mark_command_header_ready_to_process(command_slot);
     full_memory_fence();
 
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {} @ {}, ended", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count, m_dma_buffers[0]->paddr());
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {} @ {}, ended", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count, m_dma_buffers[command_slot * dma_buffers_per_command_slot]->paddr());
     return true;
 }
 
@@ -696,10 +806,13 @@ void AHCIPort::mark_command_header_ready_to_process(u8 command_header_index) con
     VERIFY(m_lock.is_locked());
     VERIFY(m_hard_lock.is_locked());
     VERIFY(is_operable());
-    VERIFY(!m_wait_for_completion);
-    m_wait_for_completion = true;
+    VERIFY(!(m_issued_command_slots & (1u << command_header_index)));
+    m_issued_command_slots |= 1u << command_header_index;
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Marking command header at index {} as ready to process.", representative_port_index(), command_header_index);
-    m_port_registers.ci = 1 << command_header_index;
+    // Note: Queued commands have to be marked as active before they're issued.
+    if (m_native_command_queuing_enabled)
+        m_port_registers.sact = 1u << command_header_index;
+    m_port_registers.ci = 1u << command_header_index;
 }
 
 void AHCIPort::stop_command_list_processing() const
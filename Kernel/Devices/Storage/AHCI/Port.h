@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <Kernel/Devices/Device.h>
@@ -23,6 +24,7 @@
 #include <Kernel/Memory/ScatterGatherList.h>
 #include <Kernel/Sections.h>
 #include <Kernel/Security/Random.h>
+#include <Kernel/Tasks/WorkQueue.h>
 
 namespace Kernel {
 
@@ -44,9 +46,14 @@ public:
 
     RefPtr<StorageDevice> connected_device() const { return m_connected_device; }
 
+    // With Native Command Queuing the device can work on (and complete) several requests at once,
+    // each of them in its own command slot.
+    size_t max_outstanding_requests() const { return m_queue_depth; }
+    bool is_rotational() const { return m_rotational; }
+
     bool reset();
     bool initialize_without_reset();
-    void handle_interrupt();
+    void handle_interrupt(WorkQueue::Batch&);
 
 private:
     ErrorOr<void> allocate_resources_and_initialize_ports();
@@ -69,10 +76,13 @@ private:
     ALWAYS_INLINE void power_on() const;
 
     void start_request(AsyncBlockDeviceRequest&);
-    void complete_current_request(AsyncDeviceRequest::RequestResult);
-    bool access_device(AsyncBlockDeviceRequest::RequestType, u64 lba, u8 block_count);
+    void finish_request_in_command_slot(u8 command_slot);
+    void complete_request_in_command_slot(u8 command_slot, AsyncDeviceRequest::RequestResult);
+    void complete_requests_in_command_slots(u32 command_slots, AsyncDeviceRequest::RequestResult);
+    bool access_device(u8 command_slot, AsyncBlockDeviceRequest::RequestType, u64 lba, u8 block_count);
     size_t calculate_descriptors_count(size_t block_count) const;
-    [[nodiscard]] Optional<AsyncDeviceRequest::RequestResult> prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request);
+    bool can_transfer_directly(AsyncBlockDeviceRequest const&) const;
+    [[nodiscard]] Optional<AsyncDeviceRequest::RequestResult> prepare_and_set_scatter_list(u8 command_slot, AsyncBlockDeviceRequest& request);
 
     ALWAYS_INLINE bool is_interrupts_enabled() const;
 
@@ -93,6 +103,7 @@ private:
     void set_interface_state(AHCI::DeviceDetectionInitialization);
 
     Optional<u8> try_to_find_unused_command_header();
+    Optional<u8> try_to_find_unused_command_slot() const;
 
     ALWAYS_INLINE bool is_interface_disabled() const { return (m_port_registers.ssts & 0xf) == 4; }
 
@@ -101,11 +112,25 @@ private:
     // Data members
 
     EntropySource m_entropy_source;
-    LockRefPtr<AsyncBlockDeviceRequest> m_current_request;
     Spinlock<LockRank::None> m_hard_lock {};
     Mutex m_lock { "AHCIPort"sv };
 
-    mutable bool m_wait_for_completion { false };
+    // Note: Every command slot owns one command table page and dma_buffers_per_command_slot DMA buffers.
+    static constexpr size_t dma_buffers_per_command_slot = 1;
+
+    struct CommandSlot {
+        LockRefPtr<AsyncBlockDeviceRequest> request;
+        // Note: This is null if the HBA transfers the data directly from and to the DMA segments of the request.
+        LockRefPtr<Memory::ScatterGatherList> scatter_list;
+    };
+    // Note: The command slots are protected by the hard lock, because we look at them in the IRQ handler.
+    Array<CommandSlot, AHCI::Limits::MaxCommands> m_command_slots;
+    // The command slots we handed to the HBA which we haven't seen completing yet.
+    mutable u32 m_issued_command_slots { 0 };
+
+    bool m_native_command_queuing_enabled { false };
+    size_t m_queue_depth { 1 };
+    bool m_rotational { true };
 
     Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> m_dma_buffers;
     Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> m_command_table_pages;
@@ -130,7 +155,6 @@ private:
     AHCI::PortInterruptStatusBitField m_interrupt_status;
     AHCI::PortInterruptEnableBitField m_interrupt_enable;
 
-    LockRefPtr<Memory::ScatterGatherList> m_current_scatter_list;
     bool m_disabled_by_firmware { false };
 };
 }
@@ -67,10 +67,12 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::initialize(bool is_queue_polled)
     dbgln_if(NVME_DEBUG, "NVMe: IO queue depth is: {}", IO_QUEUE_SIZE);
 
     TRY(identify_and_init_controller());
-    // Create an IO queue per core
+    // Create an IO queue per core, as far as the controller lets us
+    nr_of_queues = request_io_queue_pairs(nr_of_queues);
+    dbgln_if(NVME_DEBUG, "NVMe: Using {} IO queues for {} processors", nr_of_queues, Processor::count());
     for (u32 cpuid = 0; cpuid < nr_of_queues; ++cpuid) {
         // qid is zero is used for admin queue
-        TRY(create_io_queue(cpuid + 1, queue_type));
+        TRY(create_io_queue(cpuid + 1, queue_type, cpuid));
     }
     TRY(identify_and_init_namespaces());
     return {};
@@ -370,7 +372,27 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_admin_queue(QueueType queu
     return {};
 }
 
-UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_io_queue(u8 qid, QueueType queue_type)
+UNMAP_AFTER_INIT u32 NVMeController::request_io_queue_pairs(u32 count)
+{
+    NVMeSubmission sub {};
+    u32 allocated_queues = 0;
+    sub.op = OP_ADMIN_SET_FEATURES;
+    sub.generic.cdw10 = AK::convert_between_host_and_little_endian(static_cast<u32>(FEATURE_NUMBER_OF_QUEUES));
+    // The number of submission and completion queues are 0 based
+    sub.generic.cdw11 = AK::convert_between_host_and_little_endian((count - 1) | ((count - 1) << 16));
+    auto status = submit_admin_command(sub, true, &allocated_queues);
+    if (status) {
+        dmesgln_pci(*this, "Failed to set the number of IO queues, using only one");
+        return 1;
+    }
+
+    // The controller may give us fewer (or more) queues than we asked for.
+    u32 submission_queues = (allocated_queues & 0xffff) + 1;
+    u32 completion_queues = (allocated_queues >> 16) + 1;
+    return min(count, min(submission_queues, completion_queues));
+}
+
+UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_io_queue(u8 qid, QueueType queue_type, u32 processor_id)
 {
     OwnPtr<Memory::Region> cq_dma_region;
     Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> cq_dma_pages;
@@ -441,7 +463,8 @@ UNMAP_AFTER_INIT ErrorOr<void> NVMeController::create_io_queue(u8 qid, QueueType
         .dbbuf_eventidx = move(eventidx_doorbell_regs),
     };
 
-    auto irq = TRY(allocate_irq(qid));
+    // Completions are steered to the processor that submits to this queue, if the interrupt type allows it.
+    auto irq = TRY(allocate_irq(qid, static_cast<u8>(processor_id)));
 
     m_queues.append(TRY(NVMeQueue::try_create(*this, qid, irq, IO_QUEUE_SIZE, move(cq_dma_region), move(sq_dma_region), move(doorbell), queue_type)));
     dbgln_if(NVME_DEBUG, "NVMe: Created IO Queue with QID{}", m_queues.size());
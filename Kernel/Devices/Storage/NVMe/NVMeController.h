@@ -38,11 +38,11 @@ public:
     ErrorOr<void> reset_controller();
     ErrorOr<void> start_controller();
 
-    u16 submit_admin_command(NVMeSubmission& sub, bool sync = false)
+    u16 submit_admin_command(NVMeSubmission& sub, bool sync = false, u32* command_specific = nullptr)
     {
         // First queue is always the admin queue
         if (sync) {
-            return m_admin_queue->submit_sync_sqe(sub);
+            return m_admin_queue->submit_sync_sqe(sub, command_specific);
         }
         m_admin_queue->submit_sqe(sub);
         return 0;
@@ -64,7 +64,8 @@ private:
     ErrorOr<void> identify_and_init_controller();
     NSFeatures get_ns_features(IdentifyNamespace& identify_data_struct);
     ErrorOr<void> create_admin_queue(QueueType queue_type);
-    ErrorOr<void> create_io_queue(u8 qid, QueueType queue_type);
+    u32 request_io_queue_pairs(u32 count);
+    ErrorOr<void> create_io_queue(u8 qid, QueueType queue_type, u32 processor_id);
     void calculate_doorbell_stride()
     {
         m_dbl_stride = (m_controller_regs->cap >> CAP_DBL_SHIFT) & CAP_DBL_MASK;
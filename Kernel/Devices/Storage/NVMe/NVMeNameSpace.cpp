@@ -25,9 +25,17 @@ UNMAP_AFTER_INIT NVMeNameSpace::NVMeNameSpace(LUNAddress logical_unit_number_add
 {
 }
 
+bool NVMeNameSpace::poll_for_completions()
+{
+    // Note: This is the queue start_request() picks, unless the waiting thread moved to another processor in the meantime.
+    auto index = Processor::current_id() % m_queues.size();
+    return m_queues.at(index)->poll_cq() > 0;
+}
+
 void NVMeNameSpace::start_request(AsyncBlockDeviceRequest& request)
 {
-    auto index = Processor::current_id();
+    // Note: The controller might have given us fewer queues than there are processors.
+    auto index = Processor::current_id() % m_queues.size();
     auto& queue = m_queues.at(index);
     // TODO: For now we support only IO transfers of size PAGE_SIZE (Going along with the current constraint in the block layer)
     // Eventually remove this constraint by using the PRP2 field in the submission struct and remove block layer constraint for NVMe driver.
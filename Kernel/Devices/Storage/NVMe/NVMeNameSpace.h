@@ -28,6 +28,14 @@ public:
     CommandSet command_set() const override { return CommandSet::NVMe; }
     void start_request(AsyncBlockDeviceRequest& request) override;
 
+    // ^Device
+    // Note: All in-flight requests could end up on the queue of the same processor.
+    virtual size_t max_outstanding_requests() const override { return IO_QUEUE_SIZE - 1; }
+
+protected:
+    // ^StorageDevice
+    virtual bool poll_for_completions() override;
+
 private:
     NVMeNameSpace(LUNAddress, u32 hardware_relative_controller_id, Vector<NonnullLockRefPtr<NVMeQueue>> queues, size_t storage_size, size_t lba_size, u16 nsid);
 
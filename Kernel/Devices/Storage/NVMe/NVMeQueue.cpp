@@ -15,24 +15,23 @@
 namespace Kernel {
 ErrorOr<NonnullLockRefPtr<NVMeQueue>> NVMeQueue::try_create(NVMeController& device, u16 qid, Optional<u8> irq, u32 q_depth, OwnPtr<Memory::Region> cq_dma_region, OwnPtr<Memory::Region> sq_dma_region, Doorbell db_regs, QueueType queue_type)
 {
-    // Note: Allocate DMA region for RW operation. For now the requests don't exceed more than 4096 bytes (Storage device takes care of it)
-    RefPtr<Memory::PhysicalRAMPage> rw_dma_page;
+    VERIFY(q_depth <= IO_QUEUE_SIZE);
+    // Note: Allocate DMA region for RW operation, with one page for every command that can be in flight.
+    // For now the requests don't exceed more than 4096 bytes (Storage device takes care of it)
+    Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> rw_dma_pages;
     // FIXME: Synchronize DMA buffer accesses correctly and set the MemoryType to NonCacheable.
-    auto rw_dma_region = TRY(MM.allocate_dma_buffer_page("NVMe Queue Read/Write DMA"sv, Memory::Region::Access::ReadWrite, rw_dma_page, Memory::MemoryType::IO));
-
-    if (rw_dma_page.is_null())
-        return ENOMEM;
+    auto rw_dma_region = TRY(MM.allocate_dma_buffer_pages(q_depth * PAGE_SIZE, "NVMe Queue Read/Write DMA"sv, Memory::Region::Access::ReadWrite, rw_dma_pages, Memory::MemoryType::IO));
 
     if (queue_type == QueueType::Polled) {
-        auto queue = NVMePollQueue::try_create(move(rw_dma_region), rw_dma_page.release_nonnull(), qid, q_depth, move(cq_dma_region), move(sq_dma_region), move(db_regs));
+        auto queue = NVMePollQueue::try_create(move(rw_dma_region), move(rw_dma_pages), qid, q_depth, move(cq_dma_region), move(sq_dma_region), move(db_regs));
         return queue;
     }
 
-    auto queue = NVMeInterruptQueue::try_create(device, move(rw_dma_region), rw_dma_page.release_nonnull(), qid, irq.release_value(), q_depth, move(cq_dma_region), move(sq_dma_region), move(db_regs));
+    auto queue = NVMeInterruptQueue::try_create(device, move(rw_dma_region), move(rw_dma_pages), qid, irq.release_value(), q_depth, move(cq_dma_region), move(sq_dma_region), move(db_regs));
     return queue;
 }
 
-UNMAP_AFTER_INIT NVMeQueue::NVMeQueue(NonnullOwnPtr<Memory::Region> rw_dma_region, Memory::PhysicalRAMPage const& rw_dma_page, u16 qid, u32 q_depth, OwnPtr<Memory::Region> cq_dma_region, OwnPtr<Memory::Region> sq_dma_region, Doorbell db_regs)
+UNMAP_AFTER_INIT NVMeQueue::NVMeQueue(NonnullOwnPtr<Memory::Region> rw_dma_region, Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> rw_dma_pages, u16 qid, u32 q_depth, OwnPtr<Memory::Region> cq_dma_region, OwnPtr<Memory::Region> sq_dma_region, Doorbell db_regs)
     : m_rw_dma_region(move(rw_dma_region))
     , m_qid(qid)
     , m_admin_queue(qid == 0)
@@ -40,12 +39,9 @@ UNMAP_AFTER_INIT NVMeQueue::NVMeQueue(NonnullOwnPtr<Memory::Region> rw_dma_regio
     , m_cq_dma_region(move(cq_dma_region))
     , m_sq_dma_region(move(sq_dma_region))
     , m_db_regs(move(db_regs))
-    , m_rw_dma_page(rw_dma_page)
-
+    , m_rw_dma_pages(move(rw_dma_pages))
 {
-    m_requests.with([q_depth](auto& requests) {
-        requests.try_ensure_capacity(q_depth).release_value_but_fixme_should_propagate_errors();
-    });
+    VERIFY(m_rw_dma_pages.size() == m_qdepth);
     m_sqe_array = { reinterpret_cast<NVMeSubmission*>(m_sq_dma_region->vaddr().as_ptr()), m_qdepth };
     m_cqe_array = { reinterpret_cast<NVMeCompletion*>(m_cq_dma_region->vaddr().as_ptr()), m_qdepth };
 }
@@ -67,32 +63,65 @@ void NVMeQueue::update_cqe_head()
     }
 }
 
-u32 NVMeQueue::process_cq()
+template<typename Callback>
+u32 NVMeQueue::reap_completions(Callback callback)
 {
+    VERIFY(m_cq_lock.is_locked());
     u32 nr_of_processed_cqes = 0;
-    m_requests.with([this, &nr_of_processed_cqes](auto& requests) {
-        while (cqe_available()) {
-            u16 status;
-            u16 cmdid;
-            ++nr_of_processed_cqes;
-            status = CQ_STATUS_FIELD(m_cqe_array[m_cq_head].status);
-            cmdid = m_cqe_array[m_cq_head].command_id;
-            dbgln_if(NVME_DEBUG, "NVMe: Completion with status {:x} and command identifier {}. CQ_HEAD: {}", status, cmdid, m_cq_head);
-
-            if (!requests.contains(cmdid)) {
-                dmesgln("Bogus cmd id: {}", cmdid);
-                VERIFY_NOT_REACHED();
-            }
-            complete_current_request_impl(cmdid, status, requests);
-            update_cqe_head();
+    while (cqe_available()) {
+        u16 status;
+        u16 cmdid;
+        u32 command_specific;
+        ++nr_of_processed_cqes;
+        status = CQ_STATUS_FIELD(m_cqe_array[m_cq_head].status);
+        cmdid = m_cqe_array[m_cq_head].command_id;
+        command_specific = m_cqe_array[m_cq_head].cmd_spec;
+        dbgln_if(NVME_DEBUG, "NVMe: Completion with status {:x} and command identifier {}. CQ_HEAD: {}", status, cmdid, m_cq_head);
+
+        bool is_known_command = m_requests.with([cmdid, this](auto& requests) {
+            return cmdid < m_qdepth && requests[cmdid].in_use;
+        });
+        if (!is_known_command) {
+            dmesgln("Bogus cmd id: {}", cmdid);
+            VERIFY_NOT_REACHED();
         }
-    });
+        callback(cmdid, status, command_specific);
+        update_cqe_head();
+    }
     if (nr_of_processed_cqes) {
         update_cq_doorbell();
     }
     return nr_of_processed_cqes;
 }
 
+u32 NVMeQueue::process_cq()
+{
+    return reap_completions([this](u16 cmdid, u16 status, u32 command_specific) {
+        complete_current_request(cmdid, status, command_specific);
+    });
+}
+
+u32 NVMeQueue::poll_cq()
+{
+    struct ReapedCompletion {
+        u16 cmdid;
+        u16 status;
+        u32 command_specific;
+    };
+    // Note: There can't be more completions than commands in flight, and we only complete them once the lock is
+    //       dropped, as completing a read may have to copy the data to userspace.
+    Vector<ReapedCompletion, IO_QUEUE_SIZE> completions;
+    {
+        SpinlockLocker lock(m_cq_lock);
+        reap_completions([&](u16 cmdid, u16 status, u32 command_specific) {
+            completions.unchecked_append({ cmdid, status, command_specific });
+        });
+    }
+    for (auto& completion : completions)
+        NVMeQueue::complete_current_request(completion.cmdid, completion.status, completion.command_specific);
+    return completions.size();
+}
+
 void NVMeQueue::submit_sqe(NVMeSubmission& sub)
 {
     SpinlockLocker lock(m_sq_lock);
@@ -110,18 +139,46 @@ void NVMeQueue::submit_sqe(NVMeSubmission& sub)
     update_sq_doorbell();
 }
 
-void NVMeQueue::complete_current_request_impl(u16 cmdid, u16 status, HashMap<u16, NVMeIO>& requests)
+u16 NVMeQueue::reserve_cid(RefPtr<AsyncBlockDeviceRequest> request, Function<void(u16 status, u32 command_specific)> end_io_handler)
+{
+    return m_requests.with([&](auto& requests) -> u16 {
+        for (u16 cid = 0; cid < m_qdepth; cid++) {
+            auto& io = requests[cid];
+            if (io.in_use)
+                continue;
+            io.request = move(request);
+            io.end_io_handler = move(end_io_handler);
+            io.in_use = true;
+            return cid;
+        }
+        // Note: The block layer never has more requests in flight than a queue can take.
+        VERIFY_NOT_REACHED();
+    });
+}
+
+NVMeIO NVMeQueue::take_io(u16 cmdid)
 {
-    auto& request_pdu = requests.get(cmdid).release_value();
-    auto current_request = request_pdu.request;
+    return m_requests.with([cmdid](auto& requests) {
+        auto& io = requests[cmdid];
+        VERIFY(io.in_use);
+        NVMeIO taken_io { move(io.request), move(io.end_io_handler), true };
+        io.in_use = false;
+        return taken_io;
+    });
+}
+
+void NVMeQueue::complete_current_request(u16 cmdid, u16 status, u32 command_specific)
+{
+    // Note: We must not hold the requests lock while completing, because that may submit the next request.
+    auto io = take_io(cmdid);
+    auto current_request = io.request;
     AsyncDeviceRequest::RequestResult req_result = AsyncDeviceRequest::Success;
 
-    ScopeGuard guard = [&req_result, status, &request_pdu] {
-        if (request_pdu.request)
-            request_pdu.request->complete(req_result);
-        if (request_pdu.end_io_handler)
-            request_pdu.end_io_handler(status);
-        request_pdu.clear();
+    ScopeGuard guard = [&req_result, status, command_specific, &io] {
+        if (io.request)
+            io.request->complete(req_result);
+        if (io.end_io_handler)
+            io.end_io_handler(status, command_specific);
     };
 
     // There can be submission without any request associated with it such as with
@@ -134,30 +191,22 @@ void NVMeQueue::complete_current_request_impl(u16 cmdid, u16 status, HashMap<u16
         return;
     }
 
-    if (current_request->request_type() == AsyncBlockDeviceRequest::RequestType::Read) {
-        if (auto result = current_request->write_to_buffer(current_request->buffer(), m_rw_dma_region->vaddr().as_ptr(), current_request->buffer_size()); result.is_error()) {
+    if (current_request->request_type() == AsyncBlockDeviceRequest::RequestType::Read && !can_transfer_directly(*current_request)) {
+        if (auto result = current_request->write_to_buffer(current_request->buffer(), rw_dma_buffer(cmdid), current_request->buffer_size()); result.is_error()) {
             req_result = AsyncBlockDeviceRequest::MemoryFault;
             return;
         }
     }
 }
 
-void NVMeQueue::complete_current_request(u16 cmdid, u16 status)
+u16 NVMeQueue::submit_sync_sqe(NVMeSubmission& sub, u32* command_specific)
 {
-    m_requests.with([this, cmdid, status](auto& requests) {
-        complete_current_request_impl(cmdid, status, requests);
-    });
-}
-
-u16 NVMeQueue::submit_sync_sqe(NVMeSubmission& sub)
-{
-    // For now let's use sq tail as a unique command id.
     u16 cmd_status;
-    u16 cid = get_request_cid();
-    sub.cmdid = cid;
-
-    m_requests.with([this, &sub, &cmd_status](auto& requests) {
-        requests.set(sub.cmdid, { nullptr, [this, &cmd_status](u16 status) mutable { cmd_status = status; m_sync_wait_queue.wake_all(); } });
+    sub.cmdid = reserve_cid(nullptr, [this, &cmd_status, command_specific](u16 status, u32 result) mutable {
+        cmd_status = status;
+        if (command_specific)
+            *command_specific = result;
+        m_sync_wait_queue.wake_all();
     });
     submit_sqe(sub);
 
@@ -167,20 +216,42 @@ u16 NVMeQueue::submit_sync_sqe(NVMeSubmission& sub)
     return cmd_status;
 }
 
-void NVMeQueue::read(AsyncBlockDeviceRequest& request, u16 nsid, u64 index, u32 count)
+bool NVMeQueue::can_transfer_directly(AsyncBlockDeviceRequest const& request)
+{
+    // We only ever use the two PRP entries in the submission itself, not PRP lists.
+    auto dma_segments = request.dma_segments();
+    if (dma_segments.is_empty() || dma_segments.size() > 2)
+        return false;
+    // Note: PRP entries have to be dword aligned, and only the first one may point into the middle of a page.
+    if (dma_segments[0].paddr().get() & 0x3)
+        return false;
+    if (dma_segments.size() == 2 && dma_segments[1].offset_in_page != 0)
+        return false;
+    return true;
+}
+
+void NVMeQueue::prepare_rw_submission(NVMeSubmission& sub, AsyncBlockDeviceRequest const& request, u16 cmdid, u16 nsid, u64 index, u32 count)
 {
-    NVMeSubmission sub {};
-    sub.op = OP_NVME_READ;
     sub.rw.nsid = nsid;
     sub.rw.slba = AK::convert_between_host_and_little_endian(index);
     // No. of lbas is 0 based
     sub.rw.length = AK::convert_between_host_and_little_endian((count - 1) & 0xFFFF);
-    sub.rw.data_ptr.prp1 = reinterpret_cast<u64>(AK::convert_between_host_and_little_endian(m_rw_dma_page->paddr().as_ptr()));
-    sub.cmdid = get_request_cid();
+    if (can_transfer_directly(request)) {
+        auto dma_segments = request.dma_segments();
+        sub.rw.data_ptr.prp1 = reinterpret_cast<u64>(AK::convert_between_host_and_little_endian(dma_segments[0].paddr().as_ptr()));
+        if (dma_segments.size() > 1)
+            sub.rw.data_ptr.prp2 = reinterpret_cast<u64>(AK::convert_between_host_and_little_endian(dma_segments[1].paddr().as_ptr()));
+    } else {
+        sub.rw.data_ptr.prp1 = reinterpret_cast<u64>(AK::convert_between_host_and_little_endian(m_rw_dma_pages[cmdid]->paddr().as_ptr()));
+    }
+    sub.cmdid = cmdid;
+}
 
-    m_requests.with([&sub, &request](auto& requests) {
-        requests.set(sub.cmdid, { request, nullptr });
-    });
+void NVMeQueue::read(AsyncBlockDeviceRequest& request, u16 nsid, u64 index, u32 count)
+{
+    NVMeSubmission sub {};
+    sub.op = OP_NVME_READ;
+    prepare_rw_submission(sub, request, reserve_cid(request, nullptr), nsid, index, count);
 
     full_memory_fence();
     submit_sqe(sub);
@@ -189,22 +260,15 @@ void NVMeQueue::read(AsyncBlockDeviceRequest& request, u16 nsid, u64 index, u32
 void NVMeQueue::write(AsyncBlockDeviceRequest& request, u16 nsid, u64 index, u32 count)
 {
     NVMeSubmission sub {};
-
     sub.op = OP_NVME_WRITE;
-    sub.rw.nsid = nsid;
-    sub.rw.slba = AK::convert_between_host_and_little_endian(index);
-    // No. of lbas is 0 based
-    sub.rw.length = AK::convert_between_host_and_little_endian((count - 1) & 0xFFFF);
-    sub.rw.data_ptr.prp1 = reinterpret_cast<u64>(AK::convert_between_host_and_little_endian(m_rw_dma_page->paddr().as_ptr()));
-    sub.cmdid = get_request_cid();
-
-    m_requests.with([&sub, &request](auto& requests) {
-        requests.set(sub.cmdid, { request, nullptr });
-    });
+    prepare_rw_submission(sub, request, reserve_cid(request, nullptr), nsid, index, count);
 
-    if (auto result = request.read_from_buffer(request.buffer(), m_rw_dma_region->vaddr().as_ptr(), request.buffer_size()); result.is_error()) {
-        complete_current_request(sub.cmdid, AsyncDeviceRequest::MemoryFault);
-        return;
+    if (!can_transfer_directly(request)) {
+        if (auto result = request.read_from_buffer(request.buffer(), rw_dma_buffer(sub.cmdid), request.buffer_size()); result.is_error()) {
+            auto io = take_io(sub.cmdid);
+            io.request->complete(AsyncDeviceRequest::MemoryFault);
+            return;
+        }
     }
 
     full_memory_fence();
@@ -6,8 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/AtomicRefCounted.h>
-#include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <AK/Types.h>
 #include <Kernel/Arch/MemoryFences.h>
@@ -42,13 +42,9 @@ enum class QueueType {
 class AsyncBlockDeviceRequest;
 
 struct NVMeIO {
-    void clear()
-    {
-        request = nullptr;
-        end_io_handler = nullptr;
-    }
     RefPtr<AsyncBlockDeviceRequest> request;
-    Function<void(u16 status)> end_io_handler;
+    Function<void(u16 status, u32 command_specific)> end_io_handler;
+    bool in_use { false };
 };
 
 class NVMeController;
@@ -56,13 +52,18 @@ class NVMeQueue : public AtomicRefCounted<NVMeQueue> {
 public:
     static ErrorOr<NonnullLockRefPtr<NVMeQueue>> try_create(NVMeController& device, u16 qid, Optional<u8> irq, u32 q_depth, OwnPtr<Memory::Region> cq_dma_region, OwnPtr<Memory::Region> sq_dma_region, Doorbell db_regs, QueueType queue_type);
     bool is_admin_queue() { return m_admin_queue; }
-    u16 submit_sync_sqe(NVMeSubmission&);
+    u16 submit_sync_sqe(NVMeSubmission&, u32* command_specific = nullptr);
     void read(AsyncBlockDeviceRequest& request, u16 nsid, u64 index, u32 count);
     void write(AsyncBlockDeviceRequest& request, u16 nsid, u64 index, u32 count);
     virtual void submit_sqe(NVMeSubmission&);
     virtual ~NVMeQueue();
 
+    // Reaps the completion queue from a thread that is waiting for one of its requests, and completes
+    // the requests right away instead of leaving that to the I/O work queue. Returns the number of completions.
+    u32 poll_cq();
+
 protected:
+    // Note: The caller has to hold m_cq_lock.
     u32 process_cq();
 
     // Updates the shadow buffer and returns if mmio is needed
@@ -85,27 +86,24 @@ protected:
             m_db_regs.mmio_reg->sq_tail = m_sq_tail;
     }
 
-    NVMeQueue(NonnullOwnPtr<Memory::Region> rw_dma_region, Memory::PhysicalRAMPage const& rw_dma_page, u16 qid, u32 q_depth, OwnPtr<Memory::Region> cq_dma_region, OwnPtr<Memory::Region> sq_dma_region, Doorbell db_regs);
+    NVMeQueue(NonnullOwnPtr<Memory::Region> rw_dma_region, Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> rw_dma_pages, u16 qid, u32 q_depth, OwnPtr<Memory::Region> cq_dma_region, OwnPtr<Memory::Region> sq_dma_region, Doorbell db_regs);
 
-    [[nodiscard]] u32 get_request_cid()
-    {
-        u32 expected_tag = m_tag.load(AK::memory_order_acquire);
-
-        for (;;) {
-            u32 cid = expected_tag + 1;
-            if (cid == m_qdepth)
-                cid = 0;
-            if (m_tag.compare_exchange_strong(expected_tag, cid, AK::memory_order_acquire))
-                return cid;
-        }
-    }
+    // Command identifiers index into a fixed array of in-flight commands, and every one of them
+    // has its own page in the read/write DMA region.
+    [[nodiscard]] u16 reserve_cid(RefPtr<AsyncBlockDeviceRequest>, Function<void(u16 status, u32 command_specific)> end_io_handler);
+    NVMeIO take_io(u16 cmdid);
 
-    virtual void complete_current_request(u16 cmdid, u16 status);
+    virtual void complete_current_request(u16 cmdid, u16 status, u32 command_specific);
 
 private:
-    void complete_current_request_impl(u16 cmdid, u16 status, HashMap<u16, NVMeIO>& requests);
+    // A request can skip the DMA buffer of its command identifier if the device can get at its own buffer.
+    static bool can_transfer_directly(AsyncBlockDeviceRequest const&);
+    void prepare_rw_submission(NVMeSubmission&, AsyncBlockDeviceRequest const&, u16 cmdid, u16 nsid, u64 index, u32 count);
+    u8* rw_dma_buffer(u16 cmdid) { return m_rw_dma_region->vaddr().offset(cmdid * PAGE_SIZE).as_ptr(); }
     bool cqe_available();
     void update_cqe_head();
+    template<typename Callback>
+    u32 reap_completions(Callback);
     void update_cq_doorbell()
     {
         full_memory_fence();
@@ -115,8 +113,10 @@ private:
     }
 
 protected:
-    SpinlockProtected<HashMap<u16, NVMeIO>, LockRank::None> m_requests;
+    SpinlockProtected<Array<NVMeIO, IO_QUEUE_SIZE>, LockRank::None> m_requests {};
     NonnullOwnPtr<Memory::Region> m_rw_dma_region;
+    // Both the interrupt handler and threads polling for their requests reap the completion queue.
+    Spinlock<LockRank::Interrupts> m_cq_lock {};
 
 private:
     u16 m_qid {};
@@ -125,7 +125,6 @@ private:
     u16 m_cq_head {};
     bool m_admin_queue { false };
     u32 m_qdepth {};
-    Atomic<u32> m_tag { 0 }; // used for the cid in a submission queue entry
     Spinlock<LockRank::Interrupts> m_sq_lock {};
     OwnPtr<Memory::Region> m_cq_dma_region;
     Span<NVMeSubmission> m_sqe_array;
@@ -133,6 +132,6 @@ private:
     Span<NVMeCompletion> m_cqe_array;
     DeprecatedWaitQueue m_sync_wait_queue;
     Doorbell m_db_regs;
-    NonnullRefPtr<Memory::PhysicalRAMPage const> const m_rw_dma_page;
+    Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> const m_rw_dma_pages;
 };
 }
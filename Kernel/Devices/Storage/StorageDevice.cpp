@@ -7,6 +7,7 @@
 #include <AK/StringView.h>
 #include <Kernel/API/Ioctl.h>
 #include <Kernel/API/MajorNumberAllocation.h>
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Devices/Device.h>
 #include <Kernel/Devices/Storage/StorageDevice.h>
@@ -16,6 +17,7 @@
 #include <Kernel/FileSystem/SysFS/Subsystems/DeviceIdentifiers/SymbolicLinkDeviceComponent.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Devices/Storage/DeviceDirectory.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Devices/Storage/Directory.h>
+#include <Kernel/Time/TimeManagement.h>
 
 namespace Kernel {
 
@@ -75,8 +77,87 @@ StringView StorageDevice::command_set_to_string_view() const
     VERIFY_NOT_REACHED();
 }
 
-ErrorOr<size_t> StorageDevice::read(OpenFileDescription&, u64 offset, UserOrKernelBuffer& outbuf, size_t len)
+// Drivers only work on (at most) a page at a time, because some of them use a single page for their DMA buffer.
+// We make all the requests for a transfer up front (well, this many at a time) and only then wait for them,
+// so the device can reorder and merge them, or work on several of them at once.
+static constexpr size_t max_plugged_requests = 64;
+
+// Fast devices finish a small transfer in a few microseconds. Spinning for that long is cheaper than
+// taking the interrupt and waking the waiting thread up again, but anything slower isn't worth the processor time.
+static constexpr Duration completion_poll_budget = Duration::from_microseconds(50);
+
+AsyncDeviceRequest::RequestWaitResult StorageDevice::wait_for_request(AsyncBlockDeviceRequest& request, bool poll_for_completion)
+{
+    if (poll_for_completion) {
+        auto deadline = TimeManagement::the().monotonic_time(TimePrecision::Precise) + completion_poll_budget;
+        while (!request.is_completed() && TimeManagement::the().monotonic_time(TimePrecision::Precise) < deadline) {
+            if (!poll_for_completions())
+                Processor::pause();
+        }
+    }
+    return request.wait();
+}
+
+ErrorOr<size_t> StorageDevice::transfer_whole_blocks(AsyncBlockDeviceRequest::RequestType request_type, u64 index, size_t block_count, UserOrKernelBuffer const& buffer, bool poll_for_completion)
 {
+    size_t transferred_blocks = 0;
+    while (transferred_blocks < block_count) {
+        Vector<NonnullLockRefPtr<AsyncBlockDeviceRequest>, max_plugged_requests> requests;
+        Optional<Error> submission_error;
+        size_t submitted_blocks = transferred_blocks;
+        while (requests.size() < max_plugged_requests && submitted_blocks < block_count) {
+            auto request_block_count = min(block_count - submitted_blocks, m_blocks_per_page);
+            auto request_buffer = buffer.offset(submitted_blocks * block_size());
+            auto request_size = request_block_count * block_size();
+            auto dma_segments = AsyncBlockDeviceRequest::find_dma_segments(request_buffer, request_size);
+            auto request_or_error = try_make_request<AsyncBlockDeviceRequest>(request_type, index + submitted_blocks, request_block_count, request_buffer, request_size, move(dma_segments));
+            if (request_or_error.is_error()) {
+                submission_error = request_or_error.release_error();
+                break;
+            }
+            requests.unchecked_append(request_or_error.release_value());
+            submitted_blocks += request_block_count;
+        }
+
+        // NOTE: We have to wait for all of the requests, even after one of them failed, as they might still be using the buffer.
+        //       Only the blocks before the first failure count as transferred though.
+        Optional<Error> error;
+        for (auto& request : requests) {
+            auto result = wait_for_request(*request, poll_for_completion);
+            if (result.wait_result().was_interrupted())
+                return EINTR;
+            if (error.has_value())
+                continue;
+            switch (result.request_result()) {
+            case AsyncDeviceRequest::Failure:
+            case AsyncDeviceRequest::Cancelled:
+                error = Error::from_errno(EIO);
+                continue;
+            case AsyncDeviceRequest::MemoryFault:
+                error = Error::from_errno(EFAULT);
+                continue;
+            default:
+                break;
+            }
+            // NOTE: Other requests might have been merged into this one, so we can't ask it how many blocks it covers.
+            transferred_blocks += min(block_count - transferred_blocks, m_blocks_per_page);
+        }
+        if (!error.has_value() && submission_error.has_value())
+            error = submission_error.release_value();
+
+        if (error.has_value()) {
+            if (transferred_blocks > 0)
+                break;
+            return error.release_value();
+        }
+    }
+    return transferred_blocks;
+}
+
+ErrorOr<size_t> StorageDevice::read(OpenFileDescription& description, u64 offset, UserOrKernelBuffer& outbuf, size_t len)
+{
+    if (description.is_direct())
+        TRY(check_direct_io_alignment(block_size(), offset, outbuf, len));
     // NOTE: The last available offset is actually just after the last addressable block.
     if (offset >= (max_mathematical_addressable_block() * block_size()))
         return 0;
@@ -86,32 +167,15 @@ ErrorOr<size_t> StorageDevice::read(OpenFileDescription&, u64 offset, UserOrKern
     size_t whole_blocks = nread >> block_size_log();
     size_t remaining = nread - (whole_blocks << block_size_log());
 
-    // PATAChannel will chuck a wobbly if we try to read more than PAGE_SIZE
-    // at a time, because it uses a single page for its DMA buffer.
-    if (whole_blocks >= m_blocks_per_page) {
-        whole_blocks = m_blocks_per_page;
-        remaining = 0;
-    }
-
     if (nread < block_size())
         offset_within_block = offset - (index << block_size_log());
 
     dbgln_if(STORAGE_DEVICE_DEBUG, "StorageDevice::read() index={}, whole_blocks={}, remaining={}", index, whole_blocks, remaining);
 
     if (whole_blocks > 0) {
-        auto read_request = TRY(try_make_request<AsyncBlockDeviceRequest>(AsyncBlockDeviceRequest::Read, index, whole_blocks, outbuf, whole_blocks * block_size()));
-        auto result = read_request->wait();
-        if (result.wait_result().was_interrupted())
-            return EINTR;
-        switch (result.request_result()) {
-        case AsyncDeviceRequest::Failure:
-        case AsyncDeviceRequest::Cancelled:
-            return EIO;
-        case AsyncDeviceRequest::MemoryFault:
-            return EFAULT;
-        default:
-            break;
-        }
+        auto blocks_read = TRY(transfer_whole_blocks(AsyncBlockDeviceRequest::Read, index, whole_blocks, outbuf, description.is_direct() && description.is_high_priority()));
+        if (blocks_read < whole_blocks)
+            return blocks_read * block_size();
     }
 
     off_t pos = whole_blocks * block_size();
@@ -140,8 +204,10 @@ ErrorOr<size_t> StorageDevice::read(OpenFileDescription&, u64 offset, UserOrKern
     return pos + remaining;
 }
 
-ErrorOr<size_t> StorageDevice::write(OpenFileDescription&, u64 offset, UserOrKernelBuffer const& inbuf, size_t len)
+ErrorOr<size_t> StorageDevice::write(OpenFileDescription& description, u64 offset, UserOrKernelBuffer const& inbuf, size_t len)
 {
+    if (description.is_direct())
+        TRY(check_direct_io_alignment(block_size(), offset, inbuf, len));
     // NOTE: The last available offset is actually just after the last addressable block.
     if (offset >= (max_mathematical_addressable_block() * block_size()))
         return Error::from_errno(ENOSPC);
@@ -151,13 +217,6 @@ ErrorOr<size_t> StorageDevice::write(OpenFileDescription&, u64 offset, UserOrKer
     size_t whole_blocks = nwrite >> block_size_log();
     size_t remaining = nwrite - (whole_blocks << block_size_log());
 
-    // PATAChannel will chuck a wobbly if we try to write more than PAGE_SIZE
-    // at a time, because it uses a single page for its DMA buffer.
-    if (whole_blocks >= m_blocks_per_page) {
-        whole_blocks = m_blocks_per_page;
-        remaining = 0;
-    }
-
     if (nwrite < block_size())
         offset_within_block = offset - (index << block_size_log());
 
@@ -170,19 +229,9 @@ ErrorOr<size_t> StorageDevice::write(OpenFileDescription&, u64 offset, UserOrKer
     dbgln_if(STORAGE_DEVICE_DEBUG, "StorageDevice::write() index={}, whole_blocks={}, remaining={}", index, whole_blocks, remaining);
 
     if (whole_blocks > 0) {
-        auto write_request = TRY(try_make_request<AsyncBlockDeviceRequest>(AsyncBlockDeviceRequest::Write, index, whole_blocks, inbuf, whole_blocks * block_size()));
-        auto result = write_request->wait();
-        if (result.wait_result().was_interrupted())
-            return EINTR;
-        switch (result.request_result()) {
-        case AsyncDeviceRequest::Failure:
-        case AsyncDeviceRequest::Cancelled:
-            return EIO;
-        case AsyncDeviceRequest::MemoryFault:
-            return EFAULT;
-        default:
-            break;
-        }
+        auto blocks_written = TRY(transfer_whole_blocks(AsyncBlockDeviceRequest::Write, index, whole_blocks, inbuf, description.is_direct() && description.is_high_priority()));
+        if (blocks_written < whole_blocks)
+            return blocks_written * block_size();
     }
 
     off_t pos = whole_blocks * block_size();
@@ -88,10 +88,17 @@ protected:
     // ^DiskDevice
     virtual StringView class_name() const override;
 
+    // Reaps the completions the device has posted for requests of the current processor, without waiting for an interrupt.
+    // Returns whether there were any.
+    virtual bool poll_for_completions() { return false; }
+
 private:
     virtual ErrorOr<void> after_inserting() override;
     virtual void will_be_destroyed() override;
 
+    ErrorOr<size_t> transfer_whole_blocks(AsyncBlockDeviceRequest::RequestType, u64 index, size_t block_count, UserOrKernelBuffer const&, bool poll_for_completion);
+    AsyncDeviceRequest::RequestWaitResult wait_for_request(AsyncBlockDeviceRequest&, bool poll_for_completion);
+
     mutable IntrusiveListNode<StorageDevice, LockRefPtr<StorageDevice>> m_list_node;
     // NOTE: This probably need a better locking once we support hotplug and
     // refresh of the partition table.
@@ -25,6 +25,7 @@ static constexpr u64 VIRTIO_BLK_F_SCSI = 1ull << 7;          // Device supports
 static constexpr u64 VIRTIO_BLK_F_FLUSH = 1ull << 9;         // Cache flush command support.
 static constexpr u64 VIRTIO_BLK_F_TOPOLOGY = 1ull << 10;     // Device exports information on optimal I/O alignment.
 static constexpr u64 VIRTIO_BLK_F_CONFIG_WCE = 1ull << 11;   // Device can toggle its cache between writeback and writethrough modes.
+static constexpr u64 VIRTIO_BLK_F_MQ = 1ull << 12;           // Device supports multiqueue.
 static constexpr u64 VIRTIO_BLK_F_DISCARD = 1ull << 13;      // Device can support discard command, maximum discard sectors size in max_discard_sectors and maximum discard segment number in max_discard_seg.
 static constexpr u64 VIRTIO_BLK_F_WRITE_ZEROES = 1ull << 14; // Device can support write zeroes command, maximum write zeroes sectors size in max_write_zeroes_sectors and maximum write zeroes segment number in max_write_zeroes_seg.
 
@@ -62,7 +63,8 @@ struct [[gnu::packed]] VirtIOBlkConfig {
         LittleEndian<u32> opt_io_size;
     } topology;
     u8 writeback;
-    u8 unused0[3];
+    u8 unused0;
+    LittleEndian<u16> num_queues;
     LittleEndian<u32> max_discard_sectors;
     LittleEndian<u32> max_discard_seg;
     LittleEndian<u32> discard_sector_alignment;
@@ -91,9 +93,12 @@ struct [[gnu::packed]] VirtIOBlkReq {
 
 using namespace VirtIO;
 
-static constexpr u16 REQUESTQ = 0;
+static constexpr u16 MAX_REQUEST_QUEUES = 8;
 static constexpr u64 SECTOR_SIZE = 512;
 static constexpr u64 INFLIGHT_BUFFER_SIZE = PAGE_SIZE * 16; // 128 blocks
+// Request headers (and the trailers that come with them) are laid out in m_header_buf with this stride.
+static constexpr size_t REQUEST_HEADER_STRIDE = 32;
+static_assert(sizeof(VirtIOBlkReq) <= REQUEST_HEADER_STRIDE);
 static constexpr u64 MAX_ADDRESSABLE_BLOCK = 1ull << 32;    // FIXME: Supply effective device size.
 
 UNMAP_AFTER_INIT VirtIOBlockDevice::VirtIOBlockDevice(
@@ -110,19 +115,54 @@ UNMAP_AFTER_INIT ErrorOr<void> VirtIOBlockDevice::initialize_virtio_resources()
     dbgln_if(VIRTIO_DEBUG, "VirtIOBlockDevice::initialize_virtio_resources");
     TRY(VirtIO::Device::initialize_virtio_resources());
 
+    static_assert(max_in_flight_requests * REQUEST_HEADER_STRIDE <= PAGE_SIZE);
     m_header_buf = TRY(MM.allocate_contiguous_kernel_region(
         PAGE_SIZE, "VirtIOBlockDevice header_buf"sv, Memory::Region::Access::Read | Memory::Region::Access::Write));
-    m_data_buf = TRY(MM.allocate_contiguous_kernel_region(
-        INFLIGHT_BUFFER_SIZE, "VirtIOBlockDevice data_buf"sv, Memory::Region::Access::Read | Memory::Region::Access::Write));
+    for (auto& data_buf : m_data_bufs) {
+        data_buf = TRY(MM.allocate_contiguous_kernel_region(
+            INFLIGHT_BUFFER_SIZE, "VirtIOBlockDevice data_buf"sv, Memory::Region::Access::Read | Memory::Region::Access::Write));
+    }
+    m_device_config = TRY(transport_entity().get_config(VirtIO::ConfigurationType::Device));
 
-    TRY(negotiate_features([&](u64) {
-        return 0; // We rely on the basic feature set.
+    TRY(negotiate_features([&](u64 supported_features) {
+        u64 negotiated = 0;
+        if (is_feature_set(supported_features, VIRTIO_BLK_F_MQ))
+            negotiated |= VIRTIO_BLK_F_MQ;
+        return negotiated;
     }));
-    TRY(setup_queues(1)); // REQUESTQ
+
+    // With more than one request queue, processors can start requests without contending on a single queue lock.
+    if (is_feature_accepted(VIRTIO_BLK_F_MQ)) {
+        u16 num_queues = transport_entity().config_read16(*m_device_config, offsetof(VirtIOBlkConfig, num_queues));
+        m_request_queue_count = clamp<u16>(num_queues, 1, min<size_t>(Processor::count(), MAX_REQUEST_QUEUES));
+    }
+    dbgln_if(VIRTIO_DEBUG, "VirtIOBlockDevice: Using {} request queues", m_request_queue_count);
+    TRY(setup_queues(m_request_queue_count));
     finish_init();
     return {};
 }
 
+VirtIOBlkReq* VirtIOBlockDevice::request_header(size_t slot) const
+{
+    return reinterpret_cast<VirtIOBlkReq*>(m_header_buf->vaddr().offset(slot * REQUEST_HEADER_STRIDE).as_ptr());
+}
+
+PhysicalAddress VirtIOBlockDevice::request_header_address(size_t slot) const
+{
+    return m_header_buf->physical_page(0)->paddr().offset(slot * REQUEST_HEADER_STRIDE);
+}
+
+Optional<size_t> VirtIOBlockDevice::slot_for_request_header(PhysicalAddress address) const
+{
+    auto base = m_header_buf->physical_page(0)->paddr();
+    if (address < base)
+        return {};
+    auto offset = address.get() - base.get();
+    if (offset % REQUEST_HEADER_STRIDE != 0 || offset / REQUEST_HEADER_STRIDE >= max_in_flight_requests)
+        return {};
+    return offset / REQUEST_HEADER_STRIDE;
+}
+
 ErrorOr<void> VirtIOBlockDevice::handle_device_config_change()
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIOBlockDevice::handle_device_config_change");
@@ -133,41 +173,58 @@ void VirtIOBlockDevice::start_request(AsyncBlockDeviceRequest& request)
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIOBlockDevice::start_request type={}", (int)request.request_type());
 
-    m_current_request.with([&](auto& current_request) {
-        VERIFY(current_request.is_null());
-        current_request = request;
+    auto preferred_queue = Processor::current_id() % m_request_queue_count;
+    auto slot = m_requests_in_slots.with([&](auto& requests_in_slots) -> Optional<size_t> {
+        Optional<size_t> free_slot;
+        for (size_t i = 0; i < max_in_flight_requests; ++i) {
+            if (requests_in_slots[i])
+                continue;
+            if (!free_slot.has_value() || queue_for_slot(i) == preferred_queue)
+                free_slot = i;
+            if (queue_for_slot(i) == preferred_queue)
+                break;
+        }
+        if (free_slot.has_value())
+            requests_in_slots[free_slot.value()] = request;
+        return free_slot;
     });
+    // NOTE: We are never handed more requests than max_outstanding_requests(), so there is always a free slot.
+    VERIFY(slot.has_value());
 
-    if (maybe_start_request(request).is_error()) {
-        m_current_request.with([&](auto& current_request) {
-            VERIFY(current_request == request);
-            current_request.clear();
+    if (maybe_start_request(slot.value(), request).is_error()) {
+        m_requests_in_slots.with([&](auto& requests_in_slots) {
+            VERIFY(requests_in_slots[slot.value()] == &request);
+            requests_in_slots[slot.value()].clear();
         });
         request.complete(AsyncDeviceRequest::Failure);
     }
 }
 
-ErrorOr<void> VirtIOBlockDevice::maybe_start_request(AsyncBlockDeviceRequest& request)
+ErrorOr<void> VirtIOBlockDevice::maybe_start_request(size_t slot, AsyncBlockDeviceRequest& request)
 {
-    auto& queue = get_queue(REQUESTQ);
+    auto queue_index = queue_for_slot(slot);
+    auto& queue = get_queue(queue_index);
     SpinlockLocker queue_lock(queue.lock());
     VirtIO::QueueChain chain(queue);
+    auto& data_buf = *m_data_bufs[slot];
 
     u64 data_size = block_size() * request.block_count();
     if (request.buffer_size() < data_size) {
         dmesgln("VirtIOBlockDevice: not enough space in the request buffer.");
         return Error::from_errno(EINVAL);
     }
-    if (m_data_buf->size() < data_size + sizeof(VirtIOBlkReqTrailer)) {
-        // TODO: Supply the provider buffer instead to avoid copies.
+    // If we know where the buffer of the request is in physical memory, the device can use it directly.
+    auto dma_segments = request.dma_segments();
+    bool transfer_directly = !dma_segments.is_empty();
+    if (!transfer_directly && data_buf.size() < data_size) {
         dmesgln("VirtIOBlockDevice: not enough space in the internal buffer.");
         return Error::from_errno(ENOMEM);
     }
 
-    // m_header_buf contains VirtIOBlkReqHeader and VirtIOBlkReqTrailer contingously
+    // The slot's part of m_header_buf contains VirtIOBlkReqHeader and VirtIOBlkReqTrailer contingously
     // When adding to chain we insert the parts of m_header_buf (as device-readable)
     // and the data buffer in between (as device-writable if needed).
-    VirtIOBlkReq* device_req = (VirtIOBlkReq*)m_header_buf->vaddr().as_ptr();
+    VirtIOBlkReq* device_req = request_header(slot);
 
     device_req->header.reserved = 0;
     device_req->header.sector = request.block_index();
@@ -179,15 +236,27 @@ ErrorOr<void> VirtIOBlockDevice::maybe_start_request(AsyncBlockDeviceRequest& re
     } else if (request.request_type() == AsyncBlockDeviceRequest::Write) {
         device_req->header.type = VIRTIO_BLK_T_OUT;
         buffer_type = BufferType::DeviceReadable;
-        TRY(request.read_from_buffer(request.buffer(), m_data_buf->vaddr().as_ptr(), data_size));
+        if (!transfer_directly)
+            TRY(request.read_from_buffer(request.buffer(), data_buf.vaddr().as_ptr(), data_size));
     } else {
         return Error::from_errno(EINVAL);
     }
 
-    chain.add_buffer_to_chain(m_header_buf->physical_page(0)->paddr(), sizeof(VirtIOBlkReqHeader), BufferType::DeviceReadable);
-    chain.add_buffer_to_chain(m_data_buf->physical_page(0)->paddr(), data_size, buffer_type);
-    chain.add_buffer_to_chain(m_header_buf->physical_page(0)->paddr().offset(sizeof(VirtIOBlkReqHeader)), sizeof(VirtIOBlkReqTrailer), BufferType::DeviceWritable);
-    supply_chain_and_notify(REQUESTQ, chain);
+    // All of the slots share the descriptors of their queue, so running out of them is possible (if unlikely).
+    bool added_all_buffers = chain.add_buffer_to_chain(request_header_address(slot), sizeof(VirtIOBlkReqHeader), BufferType::DeviceReadable);
+    if (transfer_directly) {
+        for (auto const& segment : dma_segments)
+            added_all_buffers = added_all_buffers && chain.add_buffer_to_chain(segment.paddr(), segment.length, buffer_type);
+    } else {
+        added_all_buffers = added_all_buffers && chain.add_buffer_to_chain(data_buf.physical_page(0)->paddr(), data_size, buffer_type);
+    }
+    added_all_buffers = added_all_buffers && chain.add_buffer_to_chain(request_header_address(slot).offset(sizeof(VirtIOBlkReqHeader)), sizeof(VirtIOBlkReqTrailer), BufferType::DeviceWritable);
+    if (!added_all_buffers) {
+        dmesgln("VirtIOBlockDevice: not enough free descriptors in queue {}.", queue_index);
+        chain.release_buffer_slots_to_queue();
+        return Error::from_errno(EBUSY);
+    }
+    supply_chain_and_notify(queue_index, chain);
     return {};
 }
 
@@ -195,56 +264,73 @@ void VirtIOBlockDevice::handle_queue_update(u16 queue_index)
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIOBlockDevice::handle_queue_update {}", queue_index);
 
-    if (queue_index == REQUESTQ) {
-        auto& queue = get_queue(REQUESTQ);
+    if (queue_index >= m_request_queue_count) {
+        dmesgln("VirtIOBlockDevice::handle_queue_update unexpected update for queue {}", queue_index);
+        return;
+    }
+
+    Array<size_t, max_in_flight_requests> completed_slots;
+    size_t completed_slot_count = 0;
+    {
+        auto& queue = get_queue(queue_index);
         SpinlockLocker queue_lock(queue.lock());
 
         size_t used;
-        VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
-        // Exactly one request is completed.
-        VERIFY(popped_chain.length() == 3);
-        VERIFY(!queue.new_data_available());
+        for (auto popped_chain = queue.pop_used_buffer_chain(used); !popped_chain.is_empty(); popped_chain = queue.pop_used_buffer_chain(used)) {
+            // Every request comes with its header, trailer and at least one data buffer.
+            VERIFY(popped_chain.length() >= 3);
+            // The header comes first, and tells us which slot the request is in.
+            Optional<size_t> slot;
+            bool is_first_buffer = true;
+            popped_chain.for_each([&](PhysicalAddress address, size_t) {
+                if (is_first_buffer)
+                    slot = slot_for_request_header(address);
+                is_first_buffer = false;
+            });
+            VERIFY(slot.has_value());
+            VERIFY(completed_slot_count < max_in_flight_requests);
+            completed_slots[completed_slot_count++] = slot.value();
+            popped_chain.release_buffer_slots_to_queue();
+        }
+    }
 
-        auto work_res = g_io_work->try_queue([this]() {
-            respond();
+    for (size_t i = 0; i < completed_slot_count; ++i) {
+        auto work_res = g_io_work->try_queue([this, slot = completed_slots[i]]() {
+            respond(slot);
         });
         if (work_res.is_error()) {
             dmesgln("VirtIOBlockDevice::handle_queue_update error starting response: {}", work_res.error());
         }
-        popped_chain.release_buffer_slots_to_queue();
-    } else {
-        dmesgln("VirtIOBlockDevice::handle_queue_update unexpected update for queue {}", queue_index);
     }
 }
 
-void VirtIOBlockDevice::respond()
+void VirtIOBlockDevice::respond(size_t slot)
 {
-    RefPtr<AsyncBlockDeviceRequest> request;
-
-    m_current_request.with([&](auto& current_request) {
-        VERIFY(current_request);
-        request = current_request;
+    auto request = m_requests_in_slots.with([&](auto& requests_in_slots) {
+        VERIFY(requests_in_slots[slot]);
+        return requests_in_slots[slot];
     });
 
     u64 data_size = block_size() * request->block_count();
-    VirtIOBlkReq* device_req = (VirtIOBlkReq*)(m_header_buf->vaddr().as_ptr());
+    VirtIOBlkReq* device_req = request_header(slot);
+    auto status = device_req->trailer.status;
 
     // The order is important:
     // * first we finish reading up the data buf;
-    // * then we unblock new requests by clearing m_current_request (thus new requests will be free to use the data buf)
-    // * then unblock the caller (who may immediately come with another request and need m_current_request cleared).
+    // * then we free up the slot (thus new requests will be free to use the data buf)
+    // * then unblock the caller (who may immediately come with another request and need a free slot).
 
-    if (device_req->trailer.status == VIRTIO_BLK_S_OK && request->request_type() == AsyncBlockDeviceRequest::Read) {
-        if (auto res = request->write_to_buffer(request->buffer(), m_data_buf->vaddr().as_ptr(), data_size); res.is_error()) {
+    if (status == VIRTIO_BLK_S_OK && request->request_type() == AsyncBlockDeviceRequest::Read && request->dma_segments().is_empty()) {
+        if (auto res = request->write_to_buffer(request->buffer(), m_data_bufs[slot]->vaddr().as_ptr(), data_size); res.is_error()) {
             dmesgln("VirtIOBlockDevice::respond failed to read buffer: {}", res.error());
         }
     }
 
-    m_current_request.with([&](auto& current_request) {
-        current_request.clear();
+    m_requests_in_slots.with([&](auto& requests_in_slots) {
+        requests_in_slots[slot].clear();
     });
 
-    request->complete(device_req->trailer.status == VIRTIO_BLK_S_OK
+    request->complete(status == VIRTIO_BLK_S_OK
             ? AsyncDeviceRequest::Success
             : AsyncDeviceRequest::Failure);
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Function.h>
 #include <AK/Result.h>
 #include <AK/Types.h>
@@ -15,6 +16,10 @@
 
 namespace Kernel {
 
+namespace VirtIO {
+struct VirtIOBlkReq;
+}
+
 class VirtIOBlockDevice : public StorageDevice
     , VirtIO::Device {
 public:
@@ -24,6 +29,9 @@ public:
     // ^BlockDevice
     virtual void start_request(AsyncBlockDeviceRequest&) override;
 
+    // ^Device
+    virtual size_t max_outstanding_requests() const override { return max_in_flight_requests; }
+
 protected:
     // ^VirtIO::Device
     virtual ErrorOr<void> initialize_virtio_resources() override;
@@ -36,14 +44,26 @@ private:
         StorageDevice::LUNAddress lun,
         u32 hardware_relative_controller_id);
 
-    ErrorOr<void> maybe_start_request(AsyncBlockDeviceRequest&);
-    void respond();
+    // Every request in flight occupies a slot, with its own request header and bounce buffer. Slots are
+    // spread over the request queues, and requests prefer slots on the queue of the processor starting them.
+    static constexpr size_t max_in_flight_requests = 8;
+
+    u16 queue_for_slot(size_t slot) const { return slot % m_request_queue_count; }
+    VirtIO::VirtIOBlkReq* request_header(size_t slot) const;
+    PhysicalAddress request_header_address(size_t slot) const;
+    Optional<size_t> slot_for_request_header(PhysicalAddress) const;
+
+    ErrorOr<void> maybe_start_request(size_t slot, AsyncBlockDeviceRequest&);
+    void respond(size_t slot);
 
 private:
+    VirtIO::Configuration const* m_device_config { nullptr };
+    u16 m_request_queue_count { 1 };
+
     OwnPtr<Memory::Region> m_header_buf;
-    OwnPtr<Memory::Region> m_data_buf;
+    Array<OwnPtr<Memory::Region>, max_in_flight_requests> m_data_bufs;
 
-    SpinlockProtected<RefPtr<AsyncBlockDeviceRequest>, LockRank::None> m_current_request {};
+    SpinlockProtected<Array<RefPtr<AsyncBlockDeviceRequest>, max_in_flight_requests>, LockRank::None> m_requests_in_slots {};
 };
 
 }
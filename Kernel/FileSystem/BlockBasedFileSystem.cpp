@@ -4,54 +4,113 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
+#include <AK/FixedArray.h>
 #include <AK/IntrusiveList.h>
+#include <AK/QuickSort.h>
+#include <AK/Singleton.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Tasks/Process.h>
 
 namespace Kernel {
 
+struct CacheChunk;
+
 struct CacheEntry {
     IntrusiveListNode<CacheEntry> list_node;
     BlockBasedFileSystem::BlockIndex block_index { 0 };
     u8* data { nullptr };
+    CacheChunk* chunk { nullptr };
     bool has_data { false };
 };
 
+// The cache grows and shrinks in chunks, which each own the memory for a fixed number of blocks.
+struct CacheChunk {
+    NonnullOwnPtr<KBuffer> block_data;
+    FixedArray<CacheEntry> entries;
+};
+
 class DiskCache {
 public:
-    static constexpr size_t EntryCount = 10000;
-    explicit DiskCache(BlockBasedFileSystem& fs, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer)
-        : m_cached_block_data(move(cached_block_data))
-        , m_entries(move(entries_buffer))
+    static constexpr size_t ChunkSize = 256 * KiB;
+
+    static ErrorOr<NonnullOwnPtr<DiskCache>> try_create(BlockBasedFileSystem& fs)
     {
-        for (size_t i = 0; i < EntryCount; ++i) {
-            entries()[i].data = m_cached_block_data->data() + i * fs.logical_block_size();
-            m_clean_list.append(entries()[i]);
-        }
+        // Let each cache grow to an eighth of physical memory, as long as there's no memory pressure.
+        auto physical_memory_size = MM.get_system_memory_info().physical_pages * PAGE_SIZE;
+        auto max_chunk_count = max(physical_memory_size / 8 / ChunkSize, static_cast<u64>(1));
+
+        auto cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(fs.logical_block_size(), max_chunk_count)));
+        // We always keep at least one chunk around, so we can make progress no matter what.
+        TRY(cache->grow());
+        return cache;
     }
 
     ~DiskCache() = default;
 
     bool is_dirty() const { return !m_dirty_list.is_empty(); }
     bool entry_is_dirty(CacheEntry const& entry) const { return m_dirty_list.contains(entry); }
+    size_t dirty_block_count() const { return m_dirty_block_count; }
 
     void mark_all_clean()
     {
         while (auto* entry = m_dirty_list.first())
             m_clean_list.prepend(*entry);
+        m_dirty_block_count = 0;
     }
 
     void mark_dirty(CacheEntry& entry)
     {
+        if (!entry_is_dirty(entry))
+            ++m_dirty_block_count;
         m_dirty_list.prepend(entry);
     }
 
     void mark_clean(CacheEntry& entry)
     {
+        if (entry_is_dirty(entry))
+            --m_dirty_block_count;
         m_clean_list.prepend(entry);
     }
 
+    // Writes back the given dirty entries in the order of their blocks, so the disk sees mostly sequential writes,
+    // and coalesces blocks that are adjacent on disk into a single write. Returns the first error that occurred.
+    template<typename Callback>
+    ErrorOr<void> write_back(Vector<CacheEntry*>& entries, Callback write_blocks)
+    {
+        quick_sort(entries, [](auto* a, auto* b) { return a->block_index < b->block_index; });
+
+        size_t max_run_length = max(ChunkSize / m_block_size, static_cast<size_t>(1));
+        auto bounce_buffer_or_error = KBuffer::try_create_with_size("BlockBasedFS: Writeback"sv, max_run_length * m_block_size, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow);
+        if (bounce_buffer_or_error.is_error())
+            max_run_length = 1;
+
+        ErrorOr<void> result {};
+        for (size_t i = 0; i < entries.size();) {
+            auto first_block_index = entries[i]->block_index;
+            size_t run_length = 1;
+            while (i + run_length < entries.size() && run_length < max_run_length && entries[i + run_length]->block_index.value() == first_block_index.value() + run_length)
+                ++run_length;
+
+            u8* data = entries[i]->data;
+            if (run_length > 1) {
+                data = bounce_buffer_or_error.value()->data();
+                for (size_t j = 0; j < run_length; ++j)
+                    memcpy(data + j * m_block_size, entries[i + j]->data, m_block_size);
+            }
+
+            if (auto write_result = write_blocks(first_block_index, run_length, data); write_result.is_error() && !result.is_error())
+                result = write_result.release_error();
+
+            for (size_t j = 0; j < run_length; ++j)
+                mark_clean(*entries[i + j]);
+            i += run_length;
+        }
+        return result;
+    }
+
     CacheEntry* get(BlockBasedFileSystem::BlockIndex block_index) const
     {
         auto it = m_hash.find(block_index);
@@ -66,11 +125,16 @@ public:
         return &entry;
     }
 
-    ErrorOr<CacheEntry*> ensure(BlockBasedFileSystem::BlockIndex block_index, BlockBasedFileSystem& fs) const
+    ErrorOr<CacheEntry*> ensure(BlockBasedFileSystem::BlockIndex block_index, BlockBasedFileSystem& fs)
     {
         if (auto* entry = get(block_index))
             return entry;
 
+        // Rather than evicting a block, we add more room for blocks while there's memory to spare.
+        // NOTE: Unused entries are at the end of the clean list, so we only grow once they are all used up.
+        if (should_grow())
+            (void)grow();
+
         if (m_clean_list.is_empty()) {
             // Not a single clean entry! Flush writes and try again.
             // NOTE: We want to make sure we only call FileBackedFileSystem flush here,
@@ -83,7 +147,7 @@ public:
         auto& new_entry = *m_clean_list.last();
         m_clean_list.prepend(new_entry);
 
-        m_hash.remove(new_entry.block_index);
+        forget(new_entry);
         TRY(m_hash.try_set(block_index, &new_entry));
 
         new_entry.block_index = block_index;
@@ -92,8 +156,28 @@ public:
         return &new_entry;
     }
 
-    CacheEntry const* entries() const { return (CacheEntry const*)m_entries->data(); }
-    CacheEntry* entries() { return (CacheEntry*)m_entries->data(); }
+    // Gives memory back to the system by dropping the chunks holding the least recently used blocks,
+    // as long as they don't hold any dirty blocks. Returns the number of pages that were freed.
+    size_t shrink(size_t max_page_count)
+    {
+        size_t freed_page_count = 0;
+        while (freed_page_count < max_page_count && m_chunks.size() > 1) {
+            auto* least_recently_used_entry = m_clean_list.last();
+            if (!least_recently_used_entry)
+                break;
+            auto& chunk = *least_recently_used_entry->chunk;
+            if (any_of(chunk.entries, [&](auto& entry) { return entry_is_dirty(entry); }))
+                break;
+
+            for (auto& entry : chunk.entries) {
+                forget(entry);
+                m_clean_list.remove(entry);
+            }
+            freed_page_count += chunk.block_data->size() / PAGE_SIZE;
+            m_chunks.remove_first_matching([&](auto& it) { return it.ptr() == &chunk; });
+        }
+        return freed_page_count;
+    }
 
     template<typename Callback>
     void for_each_dirty_entry(Callback callback)
@@ -103,39 +187,170 @@ public:
     }
 
 private:
-    NonnullOwnPtr<KBuffer> m_cached_block_data;
+    DiskCache(size_t block_size, size_t max_chunk_count)
+        : m_block_size(block_size)
+        , m_max_chunk_count(max_chunk_count)
+    {
+    }
+
+    bool should_grow() const
+    {
+        if (m_chunks.size() >= m_max_chunk_count)
+            return false;
+        if (!m_clean_list.is_empty() && !m_clean_list.last()->has_data)
+            return false;
+        return MM.memory_pressure_level() == Memory::MemoryManager::MemoryPressureLevel::Normal;
+    }
+
+    ErrorOr<void> grow()
+    {
+        auto entry_count = max(ChunkSize / m_block_size, static_cast<size_t>(1));
+        auto block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, entry_count * m_block_size, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+        auto entries = TRY(FixedArray<CacheEntry>::create(entry_count));
+        auto chunk = TRY(adopt_nonnull_own_or_enomem(new (nothrow) CacheChunk { move(block_data), move(entries) }));
+        TRY(m_chunks.try_ensure_capacity(m_chunks.size() + 1));
+
+        for (size_t i = 0; i < entry_count; ++i) {
+            auto& entry = chunk->entries[i];
+            entry.data = chunk->block_data->data() + i * m_block_size;
+            entry.chunk = chunk.ptr();
+            m_clean_list.append(entry);
+        }
+        m_chunks.unchecked_append(move(chunk));
+        return {};
+    }
+
+    void forget(CacheEntry& entry)
+    {
+        // NOTE: Entries that have never been used still have their initial block index, which might
+        //       belong to another entry, so we have to check that the mapping is actually ours.
+        auto it = m_hash.find(entry.block_index);
+        if (it != m_hash.end() && it->value == &entry)
+            m_hash.remove(it);
+    }
+
+    size_t m_block_size { 0 };
+    size_t m_max_chunk_count { 0 };
+    size_t m_dirty_block_count { 0 };
 
-    // NOTE: m_entries must be declared before m_dirty_list and m_clean_list because their entries are allocated from it.
-    // We need to ensure that the destructors of m_dirty_list and m_clean_list are called before m_entries is destroyed.
-    NonnullOwnPtr<KBuffer> m_entries;
+    // NOTE: m_chunks must be declared before m_dirty_list and m_clean_list because their entries are allocated from it.
+    // We need to ensure that the destructors of m_dirty_list and m_clean_list are called before m_chunks is destroyed.
+    Vector<NonnullOwnPtr<CacheChunk>> m_chunks;
     mutable IntrusiveList<&CacheEntry::list_node> m_dirty_list;
     mutable IntrusiveList<&CacheEntry::list_node> m_clean_list;
     mutable HashMap<BlockBasedFileSystem::BlockIndex, CacheEntry*> m_hash;
 };
 
+static Singleton<SpinlockProtected<BlockBasedFileSystem::List, LockRank::None>> s_all_block_based_file_systems;
+
+// Shared between a filesystem and its writeback thread, which outlives it.
+struct BlockBasedFileSystem::WritebackState : public AtomicRefCounted<WritebackState> {
+    explicit WritebackState(BlockBasedFileSystem& fs)
+        : file_system(&fs)
+    {
+    }
+
+    SpinlockProtected<BlockBasedFileSystem*, LockRank::None> file_system;
+};
+
 BlockBasedFileSystem::BlockBasedFileSystem(OpenFileDescription& file_description)
     : FileBackedFileSystem(file_description)
 {
     VERIFY(file_description.file().is_seekable());
 }
 
-BlockBasedFileSystem::~BlockBasedFileSystem() = default;
+BlockBasedFileSystem::~BlockBasedFileSystem()
+{
+    // Let the writeback thread know that there's nothing left to write back.
+    if (m_writeback_state) {
+        m_writeback_state->file_system.with([](auto& file_system) {
+            file_system = nullptr;
+        });
+    }
+    s_all_block_based_file_systems->with([&](auto& list) {
+        if (m_block_based_file_system_node.is_in_list())
+            list.remove(*this);
+    });
+}
 
 ErrorOr<void> BlockBasedFileSystem::initialize_while_locked()
 {
     VERIFY(m_lock.is_locked());
     VERIFY(!is_initialized_while_locked());
     VERIFY(logical_block_size() != 0);
-    auto cached_block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, DiskCache::EntryCount * logical_block_size(), Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
-    auto entries_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, DiskCache::EntryCount * sizeof(CacheEntry), Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
-    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(*this, move(cached_block_data), move(entries_data))));
+    auto disk_cache = TRY(DiskCache::try_create(*this));
 
     m_cache.with_exclusive([&](auto& cache) {
         cache = move(disk_cache);
     });
+    s_all_block_based_file_systems->with([&](auto& list) {
+        list.append(*this);
+    });
+    return start_writeback_thread();
+}
+
+ErrorOr<void> BlockBasedFileSystem::start_writeback_thread()
+{
+    auto state = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) WritebackState(*this)));
+    auto name = TRY(KString::formatted("{} Writeback", class_name()));
+    m_writeback_state = state;
+    (void)TRY(Process::create_kernel_process(name->view(), [state = move(state)]() mutable {
+        writeback_thread_main(move(state));
+        Process::current().sys$exit(0);
+        VERIFY_NOT_REACHED();
+    }));
     return {};
 }
 
+void BlockBasedFileSystem::writeback_thread_main(NonnullRefPtr<WritebackState> state)
+{
+    while (!Process::current().is_dying()) {
+        (void)Thread::current()->sleep(writeback_interval);
+
+        auto file_system = state->file_system.with([](auto* file_system) -> RefPtr<BlockBasedFileSystem> {
+            // NOTE: The filesystem might already be in the middle of being destroyed.
+            if (!file_system || !file_system->try_ref())
+                return nullptr;
+            return adopt_ref(*file_system);
+        });
+        if (!file_system)
+            return;
+
+        bool is_dirty = file_system->m_cache.with_exclusive([](auto& cache) { return cache->is_dirty(); });
+        if (!is_dirty)
+            continue;
+        if (auto result = file_system->flush_writes(); result.is_error())
+            dbgln("{}: Failed to write back dirty blocks: {}", file_system->class_name(), result.error());
+    }
+}
+
+size_t BlockBasedFileSystem::reclaim_cache_memory(size_t max_page_count)
+{
+    // NOTE: We can't take a filesystem's cache lock while holding a spinlock, so collect them first.
+    Vector<NonnullRefPtr<BlockBasedFileSystem>> file_systems;
+    s_all_block_based_file_systems->with([&](auto& list) {
+        if (file_systems.try_ensure_capacity(list.size_slow()).is_error())
+            return;
+        for (auto& fs : list) {
+            // Skip filesystems that are already on their way out.
+            if (fs.try_ref())
+                file_systems.unchecked_append(adopt_ref(fs));
+        }
+    });
+
+    size_t freed_page_count = 0;
+    for (auto& fs : file_systems) {
+        if (freed_page_count >= max_page_count)
+            break;
+        freed_page_count += fs->m_cache.with_exclusive([&](auto& cache) -> size_t {
+            if (!cache)
+                return 0;
+            return cache->shrink(max_page_count - freed_page_count);
+        });
+    }
+    return freed_page_count;
+}
+
 ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBuffer const& data, size_t count, u64 offset, bool allow_cache)
 {
     VERIFY(m_device_block_size);
@@ -149,7 +364,8 @@ ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBu
 
     TRY(data.read(buffered_data.bytes()));
 
-    return m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
+    bool should_write_back = false;
+    TRY(m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
         if (!allow_cache) {
             flush_specific_block_if_needed(index);
             u64 base_offset = index.value() * logical_block_size() + offset;
@@ -167,8 +383,14 @@ ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBu
 
         cache->mark_dirty(*entry);
         entry->has_data = true;
+        should_write_back = cache->dirty_block_count() * logical_block_size() >= max_dirty_bytes;
         return {};
-    });
+    }));
+
+    // Writers that dirty blocks faster than the writeback thread can write them back have to wait for the disk.
+    if (should_write_back)
+        flush_writes_impl();
+    return {};
 }
 
 ErrorOr<void> BlockBasedFileSystem::raw_read(BlockIndex index, UserOrKernelBuffer& buffer)
@@ -262,6 +484,51 @@ ErrorOr<void> BlockBasedFileSystem::read_blocks(BlockIndex index, unsigned count
     return {};
 }
 
+ErrorOr<void> BlockBasedFileSystem::read_ahead_blocks(BlockIndex index, size_t count) const
+{
+    VERIFY(m_device_block_size);
+    dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::read_ahead_blocks {}, count={}", index, count);
+
+    static constexpr size_t max_read_size = 256 * KiB;
+    auto block_size = logical_block_size();
+    auto max_blocks_per_read = max(max_read_size / block_size, static_cast<size_t>(1));
+    auto read_buffer = TRY(KBuffer::try_create_with_size("BlockBasedFS: Read-ahead"sv, min(count, max_blocks_per_read) * block_size, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+
+    return m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
+        auto is_cached = [&](u64 block) {
+            auto* entry = cache->get(BlockIndex { block });
+            return entry && entry->has_data;
+        };
+
+        size_t i = 0;
+        while (i < count) {
+            if (is_cached(index.value() + i)) {
+                ++i;
+                continue;
+            }
+            size_t run_length = 1;
+            while (i + run_length < count && run_length < max_blocks_per_read && !is_cached(index.value() + i + run_length))
+                ++run_length;
+
+            auto read_buffer_data = UserOrKernelBuffer::for_kernel_buffer(read_buffer->data());
+            auto nread = TRY(file_description().read(read_buffer_data, (index.value() + i) * block_size, run_length * block_size));
+            if (nread != run_length * block_size)
+                return EIO;
+
+            for (size_t j = 0; j < run_length; ++j) {
+                auto* entry = TRY(cache->ensure(BlockIndex { index.value() + i + j }, const_cast<BlockBasedFileSystem&>(*this)));
+                // NOTE: Never overwrite a block we already have, it might be dirty.
+                if (entry->has_data)
+                    continue;
+                memcpy(entry->data, read_buffer->data() + j * block_size, block_size);
+                entry->has_data = true;
+            }
+            i += run_length;
+        }
+        return {};
+    });
+}
+
 void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
 {
     m_cache.with_exclusive([&](auto& cache) {
@@ -280,21 +547,55 @@ void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
 
 void BlockBasedFileSystem::flush_writes_impl()
 {
-    size_t count = 0;
     m_cache.with_exclusive([&](auto& cache) {
         if (!cache->is_dirty())
             return;
-        cache->for_each_dirty_entry([&](CacheEntry& entry) {
-            auto base_offset = entry.block_index.value() * logical_block_size();
-            auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
-            [[maybe_unused]] auto rc = file_description().write(base_offset, entry_data_buffer, logical_block_size());
-            ++count;
-        });
-        cache->mark_all_clean();
+
+        auto count = cache->dirty_block_count();
+        Vector<CacheEntry*> entries;
+        if (entries.try_ensure_capacity(count).is_error()) {
+            // Without a sorted list of blocks, just write them back in whatever order they are in.
+            cache->for_each_dirty_entry([&](CacheEntry& entry) {
+                auto base_offset = entry.block_index.value() * logical_block_size();
+                auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
+                [[maybe_unused]] auto rc = file_description().write(base_offset, entry_data_buffer, logical_block_size());
+            });
+            cache->mark_all_clean();
+        } else {
+            cache->for_each_dirty_entry([&](CacheEntry& entry) {
+                entries.unchecked_append(&entry);
+            });
+            [[maybe_unused]] auto result = cache->write_back(entries, [&](BlockIndex index, size_t block_count, u8* data) -> ErrorOr<void> {
+                auto buffer = UserOrKernelBuffer::for_kernel_buffer(data);
+                TRY(file_description().write(index.value() * logical_block_size(), buffer, block_count * logical_block_size()));
+                return {};
+            });
+        }
         dbgln("{}: Flushed {} blocks to disk", class_name(), count);
     });
 }
 
+ErrorOr<void> BlockBasedFileSystem::flush_blocks(ReadonlySpan<BlockIndex> blocks)
+{
+    return m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
+        if (!cache->is_dirty())
+            return {};
+
+        Vector<CacheEntry*> entries;
+        for (auto block : blocks) {
+            if (auto* entry = cache->get(block); entry && cache->entry_is_dirty(*entry))
+                TRY(entries.try_append(entry));
+        }
+        return cache->write_back(entries, [&](BlockIndex index, size_t block_count, u8* data) -> ErrorOr<void> {
+            auto buffer = UserOrKernelBuffer::for_kernel_buffer(data);
+            auto nwritten = TRY(file_description().write(index.value() * logical_block_size(), buffer, block_count * logical_block_size()));
+            if (nwritten != block_count * logical_block_size())
+                return EIO;
+            return {};
+        });
+    });
+}
+
 ErrorOr<void> BlockBasedFileSystem::flush_writes()
 {
     flush_writes_impl();
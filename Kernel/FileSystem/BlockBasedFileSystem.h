@@ -22,6 +22,12 @@ public:
     virtual ErrorOr<void> flush_writes() override;
     void flush_writes_impl();
 
+    // Writes back the given blocks if they are dirty, without writing back the rest of the cache.
+    ErrorOr<void> flush_blocks(ReadonlySpan<BlockIndex>);
+
+    // Shrinks the block caches of all block-based filesystems by up to max_page_count pages.
+    static size_t reclaim_cache_memory(size_t max_page_count);
+
 protected:
     explicit BlockBasedFileSystem(OpenFileDescription&);
 
@@ -30,6 +36,9 @@ protected:
     ErrorOr<void> read_block(BlockIndex, UserOrKernelBuffer*, size_t count, u64 offset = 0, bool allow_cache = true) const;
     ErrorOr<void> read_blocks(BlockIndex, unsigned count, UserOrKernelBuffer&, bool allow_cache = true) const;
 
+    // Brings the given blocks into the cache, reading those that aren't cached yet with as few requests as possible.
+    ErrorOr<void> read_ahead_blocks(BlockIndex, size_t count) const;
+
     ErrorOr<void> raw_read(BlockIndex, UserOrKernelBuffer&);
     ErrorOr<void> raw_write(BlockIndex, UserOrKernelBuffer const&);
 
@@ -42,9 +51,23 @@ protected:
     u64 m_device_block_size { 512 };
 
 private:
+    // Writers have to write back the cache themselves once this much of it is dirty.
+    static constexpr size_t max_dirty_bytes = 16 * MiB;
+    static constexpr Duration writeback_interval = Duration::from_seconds(1);
+
+    struct WritebackState;
+    ErrorOr<void> start_writeback_thread();
+    static void writeback_thread_main(NonnullRefPtr<WritebackState>);
+
     void flush_specific_block_if_needed(BlockIndex index);
 
     mutable MutexProtected<OwnPtr<DiskCache>> m_cache;
+    RefPtr<WritebackState> m_writeback_state;
+
+    IntrusiveListNode<BlockBasedFileSystem> m_block_based_file_system_node;
+
+public:
+    using List = IntrusiveList<&BlockBasedFileSystem::m_block_based_file_system_node>;
 };
 
 }
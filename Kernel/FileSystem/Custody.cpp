@@ -14,6 +14,8 @@
 
 namespace Kernel {
 
+DEFINE_KMEM_CACHE(Custody)
+
 ErrorOr<NonnullRefPtr<Custody>> Custody::try_create(RefPtr<Custody> parent, StringView name, Inode& inode, int mount_flags)
 {
     auto name_kstring = TRY(KString::try_create(name));
@@ -10,6 +10,7 @@
 #include <AK/IntrusiveList.h>
 #include <AK/RefPtr.h>
 #include <Kernel/Forward.h>
+#include <Kernel/Heap/KmemCache.h>
 #include <Kernel/Library/KString.h>
 #include <Kernel/Library/ListedRefCounted.h>
 #include <Kernel/Locking/SpinlockProtected.h>
@@ -17,6 +18,8 @@
 namespace Kernel {
 
 class Custody final : public AtomicRefCounted<Custody> {
+    KMEM_CACHE_ALLOCATED(Custody);
+
 public:
     static ErrorOr<NonnullRefPtr<Custody>> try_create(RefPtr<Custody> parent, StringView name, Inode&, int mount_flags);
 
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashFunctions.h>
+#include <AK/Singleton.h>
+#include <Kernel/FileSystem/DentryCache.h>
+#include <Kernel/FileSystem/FileSystem.h>
+#include <Kernel/FileSystem/Inode.h>
+
+namespace Kernel {
+
+static Singleton<DentryCache> s_the;
+
+DentryCache& DentryCache::the()
+{
+    return *s_the;
+}
+
+unsigned DentryCache::hash_for(InodeIdentifier parent, StringView name)
+{
+    return pair_int_hash(pair_int_hash(parent.fsid().value(), u64_hash(parent.index().value())), name.hash());
+}
+
+RefPtr<DentryCache::Entry> DentryCache::remove_entry(State& state, Entry& entry)
+{
+    NonnullRefPtr<Entry> protector = entry;
+    state.entries.remove(&entry);
+    state.lru_list.remove(entry);
+    return protector;
+}
+
+Optional<DentryCache::CachedLookup> DentryCache::lookup(Inode const& parent, StringView name)
+{
+    auto parent_identifier = parent.identifier();
+    return m_state.with_exclusive([&](auto& state) -> Optional<CachedLookup> {
+        auto it = state.entries.find(hash_for(parent_identifier, name), [&](auto* entry) {
+            return entry->parent == parent_identifier && entry->name->view() == name;
+        });
+        if (it == state.entries.end())
+            return {};
+        auto& entry = **it;
+        if (state.lru_list.first() != &entry) {
+            NonnullRefPtr<Entry> protector = entry;
+            state.lru_list.prepend(entry);
+        }
+        return CachedLookup { entry.inode };
+    });
+}
+
+u64 DentryCache::generation() const
+{
+    return m_state.with_shared([](auto const& state) { return state.generation; });
+}
+
+void DentryCache::add(Inode const& parent, StringView name, RefPtr<Inode> inode, u64 generation)
+{
+    auto parent_identifier = parent.identifier();
+    auto hash = hash_for(parent_identifier, name);
+
+    // NOTE: Failing to remember something is harmless, so we don't bother reporting allocation failures.
+    auto name_or_error = KString::try_create(name);
+    if (name_or_error.is_error())
+        return;
+    auto entry = adopt_ref_if_nonnull(new (nothrow) Entry(parent_identifier, name_or_error.release_value(), move(inode), hash));
+    if (!entry)
+        return;
+
+    // NOTE: Evicted entries may hold the last reference to an inode, so we let them go after dropping the lock.
+    RefPtr<Entry> evicted_entry;
+    m_state.with_exclusive([&](auto& state) {
+        if (state.generation != generation)
+            return;
+        if (state.entries.find(hash, [&](auto* other) { return EntryTraits::equals(other, entry.ptr()); }) != state.entries.end())
+            return;
+        if (state.entries.try_set(entry.ptr()).is_error())
+            return;
+        state.lru_list.prepend(*entry);
+
+        if (state.entries.size() > max_entry_count)
+            evicted_entry = remove_entry(state, *state.lru_list.last());
+    });
+}
+
+void DentryCache::invalidate(Inode const& parent, StringView name)
+{
+    auto parent_identifier = parent.identifier();
+    RefPtr<Entry> removed_entry;
+    m_state.with_exclusive([&](auto& state) {
+        // Lookups that are in flight right now might have seen the old state of the directory.
+        ++state.generation;
+        auto it = state.entries.find(hash_for(parent_identifier, name), [&](auto* entry) {
+            return entry->parent == parent_identifier && entry->name->view() == name;
+        });
+        if (it != state.entries.end())
+            removed_entry = remove_entry(state, **it);
+    });
+}
+
+void DentryCache::invalidate_file_system(FileSystem const& fs)
+{
+    IntrusiveList<&Entry::list_node> removed_entries;
+    m_state.with_exclusive([&](auto& state) {
+        ++state.generation;
+        state.entries.remove_all_matching([&](auto* entry) {
+            if (entry->parent.fsid() != fs.fsid())
+                return false;
+            NonnullRefPtr<Entry> protector = *entry;
+            removed_entries.append(*entry);
+            return true;
+        });
+    });
+}
+
+}
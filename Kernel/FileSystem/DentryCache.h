@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashTable.h>
+#include <AK/IntrusiveList.h>
+#include <AK/Optional.h>
+#include <AK/RefCounted.h>
+#include <Kernel/FileSystem/InodeIdentifier.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Library/KString.h>
+#include <Kernel/Locking/MutexProtected.h>
+
+namespace Kernel {
+
+// Remembers the results of looking up names in directories, including names that don't exist,
+// so that resolving the same paths over and over doesn't have to ask the filesystem every time.
+// The VirtualFileSystem is responsible for invalidating entries whenever it changes a directory.
+class DentryCache {
+public:
+    static DentryCache& the();
+
+    DentryCache() = default;
+
+    struct CachedLookup {
+        // Null if the name is known not to exist.
+        RefPtr<Inode> inode;
+    };
+
+    // Returns an empty Optional if we don't know anything about the name.
+    Optional<CachedLookup> lookup(Inode const& parent, StringView name);
+
+    // The generation has to be taken before asking the filesystem, so that we never add a result
+    // that got invalidated while we were busy looking it up.
+    u64 generation() const;
+    void add(Inode const& parent, StringView name, RefPtr<Inode> inode, u64 generation);
+
+    void invalidate(Inode const& parent, StringView name);
+    void invalidate_file_system(FileSystem const&);
+
+private:
+    static constexpr size_t max_entry_count = 4096;
+
+    struct Entry : public RefCounted<Entry> {
+        Entry(InodeIdentifier parent, NonnullOwnPtr<KString> name, RefPtr<Inode> inode, unsigned hash)
+            : parent(parent)
+            , name(move(name))
+            , inode(move(inode))
+            , hash(hash)
+        {
+        }
+
+        InodeIdentifier parent;
+        NonnullOwnPtr<KString> name;
+        RefPtr<Inode> inode;
+        unsigned hash { 0 };
+        IntrusiveListNode<Entry, NonnullRefPtr<Entry>> list_node;
+    };
+
+    struct EntryTraits : public DefaultTraits<Entry*> {
+        static unsigned hash(Entry const* entry) { return entry->hash; }
+        static bool equals(Entry const* a, Entry const* b) { return a->parent == b->parent && a->name->view() == b->name->view(); }
+    };
+
+    struct State {
+        HashTable<Entry*, EntryTraits> entries;
+        // Least recently used entries are at the back.
+        IntrusiveList<&Entry::list_node> lru_list;
+        u64 generation { 0 };
+    };
+
+    static unsigned hash_for(InodeIdentifier parent, StringView name);
+    static RefPtr<Entry> remove_entry(State&, Entry&);
+
+    MutexProtected<State> m_state;
+};
+
+}
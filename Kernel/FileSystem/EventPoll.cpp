@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/EventPoll.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+// Entries are handed out in batches, since the ready list lock can't be held while looking at their files.
+static constexpr size_t collect_batch_size = 32;
+
+static constexpr u32 supported_events = EPOLLIN | EPOLLPRI | EPOLLOUT | EPOLLERR | EPOLLHUP | EPOLLWRBAND | EPOLLRDHUP | EPOLLONESHOT | EPOLLET;
+
+ErrorOr<NonnullRefPtr<EventPoll>> EventPoll::try_create()
+{
+    return adopt_nonnull_ref_or_enomem(new (nothrow) EventPoll);
+}
+
+EventPoll::~EventPoll()
+{
+    m_state.with([](auto& state) {
+        VERIFY(state.entries.is_empty());
+        VERIFY(state.ready_list.is_empty());
+    });
+}
+
+EventPoll::Entry::Entry(EventPoll& event_poll, int fd, OpenFileDescription& description, epoll_event const& event)
+    : FileReadinessListener(description)
+    , event_poll(event_poll)
+    , file(description.file())
+    , fd(fd)
+    , events(event.events)
+    , data(event.data.u64)
+{
+}
+
+u32 EventPoll::Entry::ready_events_locked(OpenFileDescription const& description) const
+{
+    u32 ready_events = 0;
+    if (description.can_read())
+        ready_events |= EPOLLIN;
+    if (description.can_write())
+        ready_events |= EPOLLOUT;
+    return ready_events;
+}
+
+void EventPoll::Entry::readiness_may_have_changed()
+{
+    auto const* description = listened_description();
+    VERIFY(description);
+    auto ready_events = ready_events_locked(*description);
+
+    bool did_queue = event_poll.m_state.with([&](auto& state) {
+        if (is_removed || is_disarmed || (ready_events & events) == 0)
+            return false;
+        if (!ready_list_node.is_in_list())
+            state.ready_list.append(*this);
+        return true;
+    });
+    if (did_queue)
+        event_poll.did_queue_entries();
+}
+
+void EventPoll::Entry::description_will_be_destroyed()
+{
+    event_poll.detach_entry(*this);
+}
+
+ErrorOr<void> EventPoll::validate_events(OpenFileDescription& description, epoll_event const& event)
+{
+    if (event.events & ~supported_events)
+        return EINVAL;
+    // FIXME: Nested event polls would need loop detection, and a way to pass readiness up the chain.
+    if (description.file().is_event_poll())
+        return EINVAL;
+    return {};
+}
+
+ErrorOr<NonnullRefPtr<EventPoll::Entry>> EventPoll::find_entry(int fd, OpenFileDescription& description)
+{
+    auto entry = m_state.with([&](auto& state) -> RefPtr<Entry> {
+        auto it = state.entries.find(fd);
+        if (it == state.entries.end())
+            return nullptr;
+        return it->value;
+    });
+    if (!entry)
+        return ENOENT;
+
+    // The file descriptor might have been closed and reused since the entry was added.
+    bool is_same_description = entry->file->blocker_set().with_listened_description(*entry, [&](auto* listened) {
+        return listened == &description;
+    });
+    if (!is_same_description)
+        return ENOENT;
+    return entry.release_nonnull();
+}
+
+ErrorOr<void> EventPoll::add(int fd, OpenFileDescription& description, epoll_event const& event)
+{
+    TRY(validate_events(description, event));
+
+    MutexLocker locker(m_control_lock);
+
+    auto existing_entry_or_error = find_entry(fd, description);
+    if (!existing_entry_or_error.is_error())
+        return EEXIST;
+
+    // An entry for a description that's no longer behind this file descriptor is replaced.
+    auto stale_entry = m_state.with([&](auto& state) -> RefPtr<Entry> {
+        return state.entries.get(fd).value_or(nullptr);
+    });
+    if (stale_entry) {
+        stale_entry->file->blocker_set().remove_listener(*stale_entry);
+        detach_entry(*stale_entry);
+    }
+
+    auto entry = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) Entry(*this, fd, description, event)));
+    TRY(m_state.with([&](auto& state) -> ErrorOr<void> {
+        TRY(state.entries.try_set(fd, entry));
+        return {};
+    }));
+
+    description.blocker_set().add_listener(*entry);
+    queue_entry_if_ready(*entry);
+    return {};
+}
+
+ErrorOr<void> EventPoll::modify(int fd, OpenFileDescription& description, epoll_event const& event)
+{
+    TRY(validate_events(description, event));
+
+    MutexLocker locker(m_control_lock);
+
+    auto entry = TRY(find_entry(fd, description));
+    m_state.with([&](auto& state) {
+        entry->events = event.events;
+        entry->data = event.data.u64;
+        entry->is_disarmed = false;
+        if (entry->ready_list_node.is_in_list())
+            state.ready_list.remove(*entry);
+    });
+    queue_entry_if_ready(*entry);
+    return {};
+}
+
+ErrorOr<void> EventPoll::remove(int fd, OpenFileDescription& description)
+{
+    MutexLocker locker(m_control_lock);
+
+    auto entry = TRY(find_entry(fd, description));
+    entry->file->blocker_set().remove_listener(*entry);
+    detach_entry(*entry);
+    return {};
+}
+
+void EventPoll::detach_entry(Entry& entry)
+{
+    m_state.with([&](auto& state) {
+        entry.is_removed = true;
+        if (entry.ready_list_node.is_in_list())
+            state.ready_list.remove(entry);
+        auto it = state.entries.find(entry.fd);
+        if (it != state.entries.end() && it->value.ptr() == &entry)
+            state.entries.remove(it);
+    });
+}
+
+void EventPoll::queue_entry_if_ready(Entry& entry)
+{
+    entry.file->blocker_set().with_listened_description(entry, [&](auto* description) {
+        if (description)
+            entry.readiness_may_have_changed();
+    });
+}
+
+void EventPoll::did_queue_entries()
+{
+    evaluate_block_conditions();
+}
+
+ErrorOr<size_t> EventPoll::collect_ready_events(Process& process, Span<epoll_event> events)
+{
+    // Level-triggered entries that are still ready only go back on the ready list at the end, so they
+    // aren't reported twice by the same call.
+    Vector<NonnullRefPtr<Entry>> still_ready_entries;
+    TRY(still_ready_entries.try_ensure_capacity(events.size()));
+
+    size_t count = 0;
+    while (count < events.size()) {
+        Vector<NonnullRefPtr<Entry>, collect_batch_size> batch;
+        m_state.with([&](auto& state) {
+            while (batch.size() < min(collect_batch_size, events.size() - count) && !state.ready_list.is_empty())
+                batch.unchecked_append(*state.ready_list.take_first());
+        });
+        if (batch.is_empty())
+            break;
+
+        for (auto& entry : batch) {
+            auto current_description_or_error = process.open_file_description(entry->fd);
+            auto const* current_description = current_description_or_error.is_error() ? nullptr : current_description_or_error.value().ptr();
+
+            auto ready_events = entry->file->blocker_set().with_listened_description(*entry, [&](auto* description) -> u32 {
+                if (!description || description != current_description)
+                    return 0;
+                return entry->ready_events_locked(*description);
+            });
+
+            m_state.with([&](auto&) {
+                if (entry->is_removed || entry->is_disarmed)
+                    return;
+                auto reported_events = ready_events & (entry->events | EPOLLERR | EPOLLHUP);
+                if (reported_events == 0)
+                    return;
+
+                auto& event = events[count++];
+                event.events = reported_events;
+                event.data.u64 = entry->data;
+
+                if (entry->events & EPOLLONESHOT)
+                    entry->is_disarmed = true;
+                else if (!(entry->events & EPOLLET))
+                    still_ready_entries.unchecked_append(entry);
+            });
+        }
+    }
+
+    if (!still_ready_entries.is_empty()) {
+        m_state.with([&](auto& state) {
+            for (auto& entry : still_ready_entries) {
+                if (!entry->is_removed && !entry->is_disarmed && !entry->ready_list_node.is_in_list())
+                    state.ready_list.append(*entry);
+            }
+        });
+    }
+    return count;
+}
+
+bool EventPoll::can_read(OpenFileDescription const&, u64) const
+{
+    return m_state.with([](auto& state) {
+        return !state.ready_list.is_empty();
+    });
+}
+
+ErrorOr<void> EventPoll::close()
+{
+    MutexLocker locker(m_control_lock);
+
+    Vector<NonnullRefPtr<Entry>> entries;
+    TRY(m_state.with([&](auto& state) -> ErrorOr<void> {
+        TRY(entries.try_ensure_capacity(state.entries.size()));
+        for (auto& it : state.entries)
+            entries.unchecked_append(it.value);
+        return {};
+    }));
+
+    for (auto& entry : entries) {
+        entry->file->blocker_set().remove_listener(*entry);
+        detach_entry(*entry);
+    }
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<KString>> EventPoll::pseudo_path(OpenFileDescription const&) const
+{
+    return KString::try_create(":event-poll:"sv);
+}
+
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <Kernel/API/POSIX/sys/epoll.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/Locking/SpinlockProtected.h>
+
+namespace Kernel {
+
+// A persistent interest list for epoll_wait(). Instead of the files being looked at on every call, they
+// tell the EventPoll whenever their readiness may have changed, and it keeps a list of the ones that did.
+//
+// Entries are keyed by file descriptor. They go away by themselves once the open file description they
+// were added with is destroyed, and are ignored while their file descriptor refers to something else.
+class EventPoll final : public File {
+public:
+    static ErrorOr<NonnullRefPtr<EventPoll>> try_create();
+    virtual ~EventPoll() override;
+
+    ErrorOr<void> add(int fd, OpenFileDescription&, epoll_event const&);
+    ErrorOr<void> modify(int fd, OpenFileDescription&, epoll_event const&);
+    ErrorOr<void> remove(int fd, OpenFileDescription&);
+
+    // Fills in events for the files that are ready right now, without blocking.
+    ErrorOr<size_t> collect_ready_events(Process&, Span<epoll_event>);
+
+    // Readable whenever a file may have become ready, so this can be used with poll() and blocking reads.
+    virtual bool can_read(OpenFileDescription const&, u64) const override;
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+
+    virtual ErrorOr<void> close() override;
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "EventPoll"sv; }
+    virtual bool is_event_poll() const override { return true; }
+
+private:
+    EventPoll() = default;
+
+    class Entry final
+        : public AtomicRefCounted<Entry>
+        , public FileReadinessListener {
+    public:
+        Entry(EventPoll&, int fd, OpenFileDescription&, epoll_event const&);
+
+        virtual void readiness_may_have_changed() override;
+        virtual void description_will_be_destroyed() override;
+
+        // Called with the lock of the file's blocker set held.
+        u32 ready_events_locked(OpenFileDescription const&) const;
+
+        // Entries are removed from their files before the EventPoll goes away.
+        EventPoll& event_poll;
+        NonnullRefPtr<File> const file;
+        int const fd;
+
+        // These are protected by the state lock of the EventPoll.
+        u32 events { 0 };
+        u64 data { 0 };
+        bool is_removed { false };
+        // A one-shot entry that has been reported and wasn't rearmed yet.
+        bool is_disarmed { false };
+        IntrusiveListNode<Entry, NonnullRefPtr<Entry>> ready_list_node;
+    };
+
+    struct State {
+        HashMap<int, NonnullRefPtr<Entry>> entries;
+        // Entries whose readiness changed since they were last looked at. Level-triggered entries that
+        // are still ready go back to the end after being reported.
+        IntrusiveList<&Entry::ready_list_node> ready_list;
+    };
+
+    static ErrorOr<void> validate_events(OpenFileDescription&, epoll_event const&);
+    ErrorOr<NonnullRefPtr<Entry>> find_entry(int fd, OpenFileDescription&);
+    void detach_entry(Entry&);
+    void queue_entry_if_ready(Entry&);
+    void did_queue_entries();
+
+    // Serializes changes to the interest list, so an entry is never added to or removed from its file twice.
+    Mutex m_control_lock { "EventPoll"sv };
+    SpinlockProtected<State, LockRank::None> m_state {};
+};
+
+}
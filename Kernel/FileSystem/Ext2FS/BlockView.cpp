@@ -40,13 +40,7 @@ ErrorOr<BlockBasedFileSystem::BlockIndex> Ext2FSBlockView::get_block(BlockBasedF
     MutexLocker block_list_locker(m_block_list_lock);
     TRY(ensure_block(block));
 
-    auto it = m_block_list.find(block);
-    if (it == m_block_list.end())
-        return BlockBasedFileSystem::BlockIndex { 0 };
-
-    auto on_disk_block = (*it).value;
-    VERIFY(on_disk_block != 0);
-    return on_disk_block;
+    return m_block_list.find(block);
 }
 
 ErrorOr<BlockBasedFileSystem::BlockIndex> Ext2FSBlockView::get_or_allocate_block(BlockBasedFileSystem::BlockIndex block, bool zero_newly_allocated_block, bool allow_cache)
@@ -54,15 +48,22 @@ ErrorOr<BlockBasedFileSystem::BlockIndex> Ext2FSBlockView::get_or_allocate_block
     MutexLocker block_list_locker(m_block_list_lock);
     TRY(ensure_block(block));
 
-    auto it = m_block_list.find(block);
-    if (it != m_block_list.end()) {
-        auto on_disk_block = (*it).value;
-        VERIFY(on_disk_block != 0);
+    if (auto on_disk_block = m_block_list.find(block); on_disk_block != 0)
         return on_disk_block;
+
+    // FIXME: Support allocating blocks in extent trees.
+    if (m_inode.uses_extents())
+        return EROFS;
+
+    // Try to put the block right after the one preceding it, so sequentially written files stay contiguous.
+    BlockBasedFileSystem::BlockIndex goal = 0;
+    if (block > m_first_block) {
+        if (auto previous_block = m_block_list.find(block.value() - 1); previous_block != 0)
+            goal = previous_block.value() + 1;
     }
 
-    auto on_disk_block = TRY(m_inode.allocate_block(block, zero_newly_allocated_block, allow_cache));
-    TRY(m_block_list.try_set(block, on_disk_block));
+    auto on_disk_block = TRY(m_inode.allocate_block(block, goal, zero_newly_allocated_block, allow_cache));
+    TRY(m_block_list.set(block, on_disk_block));
 
     return on_disk_block;
 }
@@ -71,12 +72,17 @@ ErrorOr<void> Ext2FSBlockView::write_block_pointer(BlockBasedFileSystem::BlockIn
 {
     MutexLocker block_list_locker(m_block_list_lock);
 
+    if (m_inode.uses_extents()) {
+        // Rewriting a block pointer we already have is fine, but we can't change the extent tree yet.
+        TRY(ensure_block(logical_block_index));
+        if (m_block_list.find(logical_block_index) == on_disk_index)
+            return {};
+        return EROFS;
+    }
+
     TRY(m_inode.write_block_pointer(logical_block_index, on_disk_index));
 
-    if (on_disk_index == 0)
-        m_block_list.remove(logical_block_index);
-    else
-        TRY(m_block_list.try_set(logical_block_index, on_disk_index));
+    TRY(m_block_list.set(logical_block_index, on_disk_index));
 
     return {};
 }
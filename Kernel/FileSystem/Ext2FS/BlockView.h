@@ -30,7 +30,7 @@ private:
     BlockBasedFileSystem::BlockIndex m_last_block = 0;
     SetOnce m_block_list_initialized;
 
-    Mutex m_block_list_lock { "BlockList"sv };
+    Mutex m_block_list_lock { "BlockList"sv, LockRank::FileSystem };
 };
 
 }
@@ -414,6 +414,37 @@ struct ext2_inode_large {
 
 #define i_size_high i_dir_acl
 
+/*
+ * ext4 extent tree, stored in i_block of inodes that have EXT4_EXTENTS_FL set.
+ *
+ * Note: all of the multibyte integer fields are little endian.
+ */
+#define EXT4_EXT_MAGIC 0xf30a
+#define EXT4_EXT_INIT_MAX_LEN (1 << 15) /* Longer extents are uninitialized */
+#define EXT4_EXT_MAX_DEPTH 5
+
+struct ext4_extent_header {
+    __u16 eh_magic;      /* Magic number */
+    __u16 eh_entries;    /* Number of valid entries */
+    __u16 eh_max;        /* Capacity of the node in entries */
+    __u16 eh_depth;      /* Depth of the tree below this node, 0 for leaves */
+    __u32 eh_generation; /* Generation of the tree */
+};
+
+struct ext4_extent {
+    __u32 ee_block;    /* First logical block covered by the extent */
+    __u16 ee_len;      /* Number of blocks covered by the extent */
+    __u16 ee_start_hi; /* High 16 bits of the first physical block */
+    __u32 ee_start_lo; /* Low 32 bits of the first physical block */
+};
+
+struct ext4_extent_idx {
+    __u32 ei_block;   /* First logical block covered by the subtree */
+    __u32 ei_leaf_lo; /* Low 32 bits of the block holding the next level */
+    __u16 ei_leaf_hi; /* High 16 bits of the block holding the next level */
+    __u16 ei_unused;
+};
+
 #define EXT4_EPOCH_BITS 2
 #define EXT4_EPOCH_MASK ((1 << EXT4_EPOCH_BITS) - 1)
 #define EXT4_NSEC_MASK (~0UL << EXT4_EPOCH_BITS)
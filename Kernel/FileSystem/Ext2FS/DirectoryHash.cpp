@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <Kernel/FileSystem/Ext2FS/Definitions.h>
+#include <Kernel/FileSystem/Ext2FS/DirectoryHash.h>
+
+namespace Kernel {
+
+// NOTE: These have to match what Linux and e2fsprogs compute bit for bit, including their quirks.
+//       The "signed" variants treat the bytes of the name as signed chars, like x86 compilers do.
+
+static constexpr u32 rotate_left(u32 value, unsigned shift)
+{
+    return (value << shift) | (value >> (32 - shift));
+}
+
+static u32 legacy_hash(ReadonlyBytes name, bool is_signed)
+{
+    u32 hash0 = 0x12a3fe2d;
+    u32 hash1 = 0x37abe8f9;
+    for (auto byte : name) {
+        i32 value = is_signed ? static_cast<i32>(bit_cast<i8>(byte)) : static_cast<i32>(byte);
+        u32 hash = hash1 + (hash0 ^ (static_cast<u32>(value) * 7152373u));
+        if (hash & 0x80000000)
+            hash -= 0x7fffffff;
+        hash1 = hash0;
+        hash0 = hash;
+    }
+    return hash0 << 1;
+}
+
+// Packs (up to) the first 4 * word_count bytes of the name into words, padding them with the length of the name.
+static void name_to_hash_buffer(ReadonlyBytes name, u32* buffer, size_t word_count, bool is_signed)
+{
+    u32 padding = static_cast<u32>(name.size()) | (static_cast<u32>(name.size()) << 8);
+    padding |= padding << 16;
+
+    u32 value = padding;
+    auto length = min(name.size(), word_count * 4);
+    for (size_t i = 0; i < length; ++i) {
+        i32 byte = is_signed ? static_cast<i32>(bit_cast<i8>(name[i])) : static_cast<i32>(name[i]);
+        value = static_cast<u32>(byte) + (value << 8);
+        if (i % 4 == 3) {
+            *buffer++ = value;
+            value = padding;
+            --word_count;
+        }
+    }
+    if (word_count > 0) {
+        *buffer++ = value;
+        --word_count;
+    }
+    while (word_count-- > 0)
+        *buffer++ = padding;
+}
+
+static void half_md4_transform(u32 (&buffer)[4], u32 const (&in)[8])
+{
+    auto f = [](u32 x, u32 y, u32 z) { return z ^ (x & (y ^ z)); };
+    auto g = [](u32 x, u32 y, u32 z) { return (x & y) + ((x ^ y) & z); };
+    auto h = [](u32 x, u32 y, u32 z) { return x ^ y ^ z; };
+    auto round = [](auto function, u32& a, u32 b, u32 c, u32 d, u32 x, unsigned shift) {
+        a = rotate_left(a + function(b, c, d) + x, shift);
+    };
+
+    constexpr u32 k1 = 0;
+    constexpr u32 k2 = 013240474631;
+    constexpr u32 k3 = 015666365641;
+
+    u32 a = buffer[0];
+    u32 b = buffer[1];
+    u32 c = buffer[2];
+    u32 d = buffer[3];
+
+    round(f, a, b, c, d, in[0] + k1, 3);
+    round(f, d, a, b, c, in[1] + k1, 7);
+    round(f, c, d, a, b, in[2] + k1, 11);
+    round(f, b, c, d, a, in[3] + k1, 19);
+    round(f, a, b, c, d, in[4] + k1, 3);
+    round(f, d, a, b, c, in[5] + k1, 7);
+    round(f, c, d, a, b, in[6] + k1, 11);
+    round(f, b, c, d, a, in[7] + k1, 19);
+
+    round(g, a, b, c, d, in[1] + k2, 3);
+    round(g, d, a, b, c, in[3] + k2, 5);
+    round(g, c, d, a, b, in[5] + k2, 9);
+    round(g, b, c, d, a, in[7] + k2, 13);
+    round(g, a, b, c, d, in[0] + k2, 3);
+    round(g, d, a, b, c, in[2] + k2, 5);
+    round(g, c, d, a, b, in[4] + k2, 9);
+    round(g, b, c, d, a, in[6] + k2, 13);
+
+    round(h, a, b, c, d, in[3] + k3, 3);
+    round(h, d, a, b, c, in[7] + k3, 9);
+    round(h, c, d, a, b, in[2] + k3, 11);
+    round(h, b, c, d, a, in[6] + k3, 15);
+    round(h, a, b, c, d, in[1] + k3, 3);
+    round(h, d, a, b, c, in[5] + k3, 9);
+    round(h, c, d, a, b, in[0] + k3, 11);
+    round(h, b, c, d, a, in[4] + k3, 15);
+
+    buffer[0] += a;
+    buffer[1] += b;
+    buffer[2] += c;
+    buffer[3] += d;
+}
+
+static void tea_transform(u32 (&buffer)[4], u32 const (&in)[4])
+{
+    constexpr u32 delta = 0x9e3779b9;
+    u32 sum = 0;
+    u32 b0 = buffer[0];
+    u32 b1 = buffer[1];
+    for (int i = 0; i < 16; ++i) {
+        sum += delta;
+        b0 += ((b1 << 4) + in[0]) ^ (b1 + sum) ^ ((b1 >> 5) + in[1]);
+        b1 += ((b0 << 4) + in[2]) ^ (b0 + sum) ^ ((b0 >> 5) + in[3]);
+    }
+    buffer[0] += b0;
+    buffer[1] += b1;
+}
+
+Optional<u32> ext2_directory_hash(ReadonlyBytes name, u8 hash_version, u32 const (&seed)[4])
+{
+    u32 buffer[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+    if (seed[0] || seed[1] || seed[2] || seed[3]) {
+        for (size_t i = 0; i < 4; ++i)
+            buffer[i] = seed[i];
+    }
+
+    u32 hash = 0;
+    switch (hash_version) {
+    case EXT2_HASH_LEGACY:
+    case EXT2_HASH_LEGACY_UNSIGNED:
+        hash = legacy_hash(name, hash_version == EXT2_HASH_LEGACY);
+        break;
+    case EXT2_HASH_HALF_MD4:
+    case EXT2_HASH_HALF_MD4_UNSIGNED: {
+        u32 in[8];
+        for (auto remaining = name; !remaining.is_empty(); remaining = remaining.slice(min<size_t>(32, remaining.size()))) {
+            name_to_hash_buffer(remaining, in, 8, hash_version == EXT2_HASH_HALF_MD4);
+            half_md4_transform(buffer, in);
+        }
+        hash = buffer[1];
+        break;
+    }
+    case EXT2_HASH_TEA:
+    case EXT2_HASH_TEA_UNSIGNED: {
+        u32 in[4];
+        for (auto remaining = name; !remaining.is_empty(); remaining = remaining.slice(min<size_t>(16, remaining.size()))) {
+            name_to_hash_buffer(remaining, in, 4, hash_version == EXT2_HASH_TEA);
+            tea_transform(buffer, in);
+        }
+        hash = buffer[0];
+        break;
+    }
+    default:
+        return {};
+    }
+
+    hash &= ~1u;
+    // The largest hash is reserved to mean "end of directory" to readdir() on Linux.
+    constexpr u32 end_of_directory_hash = 0x7fffffff;
+    if (hash == end_of_directory_hash << 1)
+        hash = (end_of_directory_hash - 1) << 1;
+    return hash;
+}
+
+}
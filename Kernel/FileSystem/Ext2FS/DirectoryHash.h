@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// Hashed directory indexes (the "htree" of ext3 and ext4) keep the leaf blocks of a directory
+// sorted by this hash of the names in them. The lowest bit is always clear, because the index
+// uses it to mark hash collisions that continue into the next leaf block.
+// Returns an empty Optional for hash versions we don't know about.
+Optional<u32> ext2_directory_hash(ReadonlyBytes name, u8 hash_version, u32 const (&seed)[4]);
+
+}
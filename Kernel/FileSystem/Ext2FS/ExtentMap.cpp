@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/Ext2FS/ExtentMap.h>
+
+namespace Kernel {
+
+size_t Ext2FSExtentMap::index_of_first_extent_ending_after(u64 logical_block) const
+{
+    size_t low = 0;
+    size_t high = m_extents.size();
+    while (low < high) {
+        auto middle = low + (high - low) / 2;
+        if (m_extents[middle].logical_end() <= logical_block)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+Ext2FSExtentMap::BlockIndex Ext2FSExtentMap::find(BlockIndex logical_block) const
+{
+    auto index = index_of_first_extent_ending_after(logical_block.value());
+    if (index == m_extents.size())
+        return 0;
+    auto const& extent = m_extents[index];
+    if (extent.logical_start > logical_block.value())
+        return 0;
+    return extent.physical_start + (logical_block.value() - extent.logical_start);
+}
+
+void Ext2FSExtentMap::merge_with_neighbors(size_t index)
+{
+    if (index + 1 < m_extents.size()) {
+        auto& extent = m_extents[index];
+        auto const& next = m_extents[index + 1];
+        if (extent.logical_end() == next.logical_start && extent.physical_end() == next.physical_start) {
+            extent.length += next.length;
+            m_extents.remove(index + 1);
+        }
+    }
+    if (index > 0) {
+        auto& previous = m_extents[index - 1];
+        auto const& extent = m_extents[index];
+        if (previous.logical_end() == extent.logical_start && previous.physical_end() == extent.physical_start) {
+            previous.length += extent.length;
+            m_extents.remove(index);
+        }
+    }
+}
+
+ErrorOr<void> Ext2FSExtentMap::set(BlockIndex logical_block_index, BlockIndex physical_block_index)
+{
+    auto logical_block = logical_block_index.value();
+    auto physical_block = physical_block_index.value();
+
+    // NOTE: Splitting an extent turns it into up to three, so make sure that can't fail halfway through.
+    TRY(m_extents.try_ensure_capacity(m_extents.size() + 2));
+
+    auto index = index_of_first_extent_ending_after(logical_block);
+    if (index < m_extents.size() && m_extents[index].logical_start <= logical_block) {
+        auto extent = m_extents[index];
+        auto offset_in_extent = logical_block - extent.logical_start;
+        if (physical_block != 0 && extent.physical_start + offset_in_extent == physical_block)
+            return {};
+
+        // Cut the block out of the extent, keeping whatever is left on either side.
+        Extent before { extent.logical_start, extent.physical_start, offset_in_extent };
+        Extent after { logical_block + 1, extent.physical_start + offset_in_extent + 1, extent.length - offset_in_extent - 1 };
+        m_extents.remove(index);
+        if (after.length > 0)
+            m_extents.insert(index, after);
+        if (before.length > 0)
+            m_extents.insert(index++, before);
+    }
+
+    if (physical_block == 0)
+        return {};
+
+    m_extents.insert(index, { logical_block, physical_block, 1 });
+    merge_with_neighbors(index);
+    return {};
+}
+
+ErrorOr<void> Ext2FSExtentMap::append(u64 logical_start, u64 physical_start, u64 length)
+{
+    if (length == 0)
+        return {};
+    if (!m_extents.is_empty()) {
+        auto& last = m_extents.last();
+        VERIFY(logical_start >= last.logical_end());
+        if (last.logical_end() == logical_start && last.physical_end() == physical_start) {
+            last.length += length;
+            return {};
+        }
+    }
+    return m_extents.try_append({ logical_start, physical_start, length });
+}
+
+}
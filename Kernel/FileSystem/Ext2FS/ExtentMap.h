@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Vector.h>
+#include <Kernel/FileSystem/BlockBasedFileSystem.h>
+
+namespace Kernel {
+
+// Maps the logical blocks of an inode to their blocks on disk, as runs of blocks that are contiguous on disk.
+// Files are usually laid out in a few long runs, so this stays small no matter how large they are.
+class Ext2FSExtentMap {
+public:
+    using BlockIndex = BlockBasedFileSystem::BlockIndex;
+
+    struct Extent {
+        u64 logical_start { 0 };
+        u64 physical_start { 0 };
+        u64 length { 0 };
+
+        u64 logical_end() const { return logical_start + length; }
+        u64 physical_end() const { return physical_start + length; }
+    };
+
+    // Returns 0 for logical blocks that aren't mapped, i.e. holes.
+    BlockIndex find(BlockIndex logical_block) const;
+
+    // Maps (or with a physical block of 0, unmaps) a single logical block.
+    ErrorOr<void> set(BlockIndex logical_block, BlockIndex physical_block);
+    void remove(BlockIndex logical_block) { MUST(set(logical_block, 0)); }
+
+    // Appends a run of blocks, which has to start after every run that has been added so far.
+    ErrorOr<void> append(u64 logical_start, u64 physical_start, u64 length);
+
+    Vector<Extent> const& extents() const { return m_extents; }
+
+private:
+    size_t index_of_first_extent_ending_after(u64 logical_block) const;
+    void merge_with_neighbors(size_t index);
+
+    Vector<Extent> m_extents;
+};
+
+}
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/IntegralMath.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/Ext2FS/FileSystem.h>
@@ -89,7 +90,11 @@ ErrorOr<void> Ext2FS::rename(Inode& old_parent_inode, StringView old_basename, I
         //        Revert the changes made above if we can't write_directory.
         //        Ideally, decrement should be the last operation, but we currently
         //        can't "un-write" a directory entry list.
-        TRY(static_cast<Ext2FSInode&>(*new_inode).write_directory(entries));
+        auto& new_directory = static_cast<Ext2FSInode&>(*new_inode);
+        if (new_directory.has_directory_index())
+            TRY(new_directory.set_dot_dot_in_directory_index(new_parent_inode.index()));
+        else
+            TRY(new_directory.write_directory(entries));
     }
 
     return {};
@@ -394,6 +399,69 @@ auto Ext2FS::allocate_blocks(GroupIndex preferred_group_index, size_t count) ->
     return blocks;
 }
 
+auto Ext2FS::allocate_contiguous_blocks(GroupIndex preferred_group_index, BlockIndex goal, size_t max_count) -> ErrorOr<BlockRun>
+{
+    dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_contiguous_blocks(preferred group: {}, goal: {}, max count: {})", preferred_group_index, goal, max_count);
+    VERIFY(max_count > 0);
+
+    MutexLocker locker(m_lock);
+
+    if (!super_block().s_free_blocks_count)
+        return Error::from_errno(ENOSPC);
+
+    auto allocate_run = [&](BlockIndex first_block, size_t count) -> ErrorOr<BlockRun> {
+        dbgln_if(EXT2_DEBUG, "Ext2FS: allocating contiguous blocks {}-{}", first_block, first_block.value() + count - 1);
+        for (size_t i = 0; i < count; ++i)
+            TRY(set_block_allocation_state(first_block.value() + i, true));
+        return BlockRun { first_block, count };
+    };
+
+    int blocks_in_group = min(blocks_per_group(), super_block().s_blocks_count);
+
+    // Continuing right where the caller's last run of blocks ended keeps files contiguous.
+    if (goal != 0 && goal.value() < super_block().s_blocks_count) {
+        auto group_index = group_index_from_block_index(goal);
+        auto const& bgd = group_descriptor(group_index);
+        if (bgd.bg_free_blocks_count) {
+            auto block_bitmap = TRY(get_bitmap_block(bgd.bg_block_bitmap))->bitmap(blocks_in_group);
+            size_t first_bit = goal.value() - first_block_of_group(group_index).value();
+            size_t run_length = 0;
+            while (run_length < max_count && first_bit + run_length < block_bitmap.size() && !block_bitmap.get(first_bit + run_length))
+                ++run_length;
+            if (run_length != 0)
+                return allocate_run(goal, run_length);
+        }
+    }
+
+    // Otherwise, take the longest free run of the first group that has any free blocks, starting with the preferred one.
+    if (preferred_group_index == 0 || preferred_group_index > m_block_group_count)
+        preferred_group_index = 1;
+    for (u64 i = 0; i < m_block_group_count; ++i) {
+        GroupIndex group_index = (preferred_group_index.value() - 1 + i) % m_block_group_count + 1;
+        auto const& bgd = group_descriptor(group_index);
+        if (!bgd.bg_free_blocks_count)
+            continue;
+
+        auto block_bitmap = TRY(get_bitmap_block(bgd.bg_block_bitmap))->bitmap(blocks_in_group);
+        size_t free_region_size = 0;
+        auto first_unset_bit_index = block_bitmap.find_longest_range_of_unset_bits(max_count, free_region_size);
+        if (!first_unset_bit_index.has_value())
+            continue;
+        return allocate_run(first_block_of_group(group_index).value() + first_unset_bit_index.value(), free_region_size);
+    }
+
+    dmesgln("Ext2FS: allocate_contiguous_blocks found no free blocks, despite the super block claiming there are some");
+    return EIO;
+}
+
+ErrorOr<void> Ext2FS::free_block_run(BlockRun run)
+{
+    MutexLocker locker(m_lock);
+    for (size_t i = 0; i < run.count; ++i)
+        TRY(set_block_allocation_state(run.first_block.value() + i, false));
+    return {};
+}
+
 ErrorOr<InodeIndex> Ext2FS::allocate_inode(GroupIndex preferred_group)
 {
     dbgln_if(EXT2_DEBUG, "Ext2FS: allocate_inode(preferred_group: {})", preferred_group);
@@ -754,6 +822,14 @@ void Ext2FS::flush_block_group_descriptor_table()
     }
 }
 
+bool Ext2FS::has_dirty_allocation_state() const
+{
+    MutexLocker locker(m_lock);
+    if (m_super_block_dirty || m_block_group_descriptors_dirty)
+        return true;
+    return any_of(m_cached_bitmaps, [](auto& cached_bitmap) { return cached_bitmap->dirty; });
+}
+
 ErrorOr<void> Ext2FS::flush_writes()
 {
     {
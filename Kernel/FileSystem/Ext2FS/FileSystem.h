@@ -10,6 +10,7 @@
 #include <AK/HashMap.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
 #include <Kernel/FileSystem/Ext2FS/Definitions.h>
+#include <Kernel/FileSystem/Ext2FS/ExtentMap.h>
 #include <Kernel/FileSystem/FileSystemSpecificOption.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/Library/KBuffer.h>
@@ -27,6 +28,7 @@ public:
     enum class FeaturesOptional : u32 {
         None = 0,
         ExtendedAttributes = EXT2_FEATURE_COMPAT_EXT_ATTR,
+        DirectoryIndex = EXT2_FEATURE_COMPAT_DIR_INDEX,
     };
     AK_ENUM_BITWISE_FRIEND_OPERATORS(FeaturesOptional);
 
@@ -48,6 +50,7 @@ public:
     virtual unsigned free_inode_count() const override;
 
     virtual bool supports_watchers() const override { return true; }
+    virtual bool supports_dentry_caching() const override { return true; }
     virtual bool supports_backing_loop_devices() const override { return true; }
 
     virtual ErrorOr<void> rename(Inode& old_parent_inode, StringView old_basename, Inode& new_parent_inode, StringView new_basename) override;
@@ -62,7 +65,7 @@ public:
     virtual StringView class_name() const override { return "Ext2FS"sv; }
     virtual Inode& root_inode() override;
 
-    using BlockList = HashMap<BlockBasedFileSystem::BlockIndex, BlockBasedFileSystem::BlockIndex>;
+    using BlockList = Ext2FSExtentMap;
 
 private:
     AK_TYPEDEF_DISTINCT_ORDERED_ID(unsigned, GroupIndex);
@@ -89,6 +92,7 @@ private:
     bool find_block_containing_inode(InodeIndex, BlockIndex& block_index, unsigned& offset) const;
 
     ErrorOr<void> flush_super_block();
+    bool has_dirty_allocation_state() const;
 
     virtual ErrorOr<void> initialize_while_locked() override;
     virtual bool is_initialized_while_locked() override;
@@ -103,6 +107,14 @@ private:
     BlockIndex first_block_of_block_group_descriptors() const;
     ErrorOr<InodeIndex> allocate_inode(GroupIndex preferred_group = 0);
     ErrorOr<Vector<BlockIndex>> allocate_blocks(GroupIndex preferred_group_index, size_t count);
+
+    struct BlockRun {
+        BlockIndex first_block { 0 };
+        size_t count { 0 };
+    };
+    // Allocates between 1 and max_count blocks that are contiguous on disk, starting at goal if it is free.
+    ErrorOr<BlockRun> allocate_contiguous_blocks(GroupIndex preferred_group_index, BlockIndex goal, size_t max_count);
+    ErrorOr<void> free_block_run(BlockRun);
     GroupIndex group_index_from_inode(InodeIndex) const;
     GroupIndex group_index_from_block_index(BlockIndex) const;
     BlockIndex first_block_of_group(GroupIndex) const;
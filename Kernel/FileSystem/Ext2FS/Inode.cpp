@@ -8,16 +8,22 @@
 #include <AK/IntegralMath.h>
 #include <AK/IterationDecision.h>
 #include <AK/MemoryStream.h>
+#include <AK/NumericLimits.h>
+#include <AK/QuickSort.h>
 #include <Kernel/API/POSIX/errno.h>
 #include <Kernel/Debug.h>
+#include <Kernel/FileSystem/Ext2FS/DirectoryHash.h>
 #include <Kernel/FileSystem/Ext2FS/FileSystem.h>
 #include <Kernel/FileSystem/Ext2FS/Inode.h>
 #include <Kernel/FileSystem/InodeMetadata.h>
+#include <Kernel/Library/KBuffer.h>
+#include <Kernel/Tasks/WorkQueue.h>
 #include <Kernel/UnixTypes.h>
 
 namespace Kernel {
 
 static constexpr size_t max_inline_symlink_length = 60;
+static constexpr size_t copy_range_chunk_size = 64 * KiB;
 
 u8 Ext2FSInode::to_ext2_file_type(mode_t mode)
 {
@@ -256,6 +262,11 @@ ErrorOr<Ext2FS::BlockList> Ext2FSInode::compute_block_list(BlockBasedFileSystem:
     if (Kernel::is_symlink(m_raw_inode.i_mode) && m_raw_inode.i_blocks == 0)
         return list;
 
+    if (uses_extents()) {
+        TRY(collect_extents(ReadonlyBytes { m_raw_inode.i_block, sizeof(m_raw_inode.i_block) }, first_block, last_block, EXT4_EXT_MAX_DEPTH, list));
+        return list;
+    }
+
     unsigned const block_size = fs().logical_block_size();
     unsigned const entries_per_block = EXT2_ADDR_PER_BLOCK(&fs().super_block());
 
@@ -265,7 +276,8 @@ ErrorOr<Ext2FS::BlockList> Ext2FSInode::compute_block_list(BlockBasedFileSystem:
         if (logical_index > last_block)
             return IterationDecision::Break;
 
-        TRY(list.try_set(logical_index, on_disk_index));
+        // NOTE: Block pointers are visited in increasing logical order.
+        TRY(list.append(static_cast<u64>(logical_index), on_disk_index, 1));
         return IterationDecision::Continue;
     };
 
@@ -319,25 +331,70 @@ ErrorOr<Ext2FS::BlockList> Ext2FSInode::compute_block_list(BlockBasedFileSystem:
     return list;
 }
 
-ErrorOr<void> Ext2FSInode::free_all_blocks()
+ErrorOr<void> Ext2FSInode::collect_extents(ReadonlyBytes node, BlockBasedFileSystem::BlockIndex first_block, BlockBasedFileSystem::BlockIndex last_block, unsigned max_depth, Ext2FS::BlockList& list) const
 {
-    MutexLocker locker(m_inode_lock);
+    if (node.size() < sizeof(ext4_extent_header))
+        return EIO;
+    auto const& header = *bit_cast<ext4_extent_header const*>(node.data());
+    // NOTE: All entry types have the same size.
+    static_assert(sizeof(ext4_extent) == sizeof(ext4_extent_idx));
+    if (header.eh_magic != EXT4_EXT_MAGIC || header.eh_depth > max_depth || sizeof(ext4_extent_header) + header.eh_entries * sizeof(ext4_extent) > node.size()) {
+        dmesgln("Ext2FSInode[{}]::collect_extents(): Invalid extent tree node", identifier());
+        return EIO;
+    }
 
-    dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::free_all_blocks(): i_size={}, i_blocks={}", identifier(), m_raw_inode.i_size, m_raw_inode.i_blocks);
+    if (header.eh_depth == 0) {
+        auto const* extents = bit_cast<ext4_extent const*>(node.offset_pointer(sizeof(ext4_extent_header)));
+        for (size_t i = 0; i < header.eh_entries; ++i) {
+            auto const& extent = extents[i];
+            // Uninitialized extents have been allocated, but read back as zeroes, just like holes.
+            if (extent.ee_len > EXT4_EXT_INIT_MAX_LEN)
+                continue;
+            u64 logical_start = extent.ee_block;
+            u64 logical_end = logical_start + extent.ee_len;
+            if (logical_end <= first_block.value() || logical_start > last_block.value())
+                continue;
+            u64 physical_start = (static_cast<u64>(extent.ee_start_hi) << 32) | extent.ee_start_lo;
+            auto clipped_start = max(logical_start, first_block.value());
+            auto clipped_end = min(logical_end, last_block.value() + 1);
+            TRY(list.append(clipped_start, physical_start + (clipped_start - logical_start), clipped_end - clipped_start));
+        }
+        return {};
+    }
 
+    unsigned const block_size = fs().logical_block_size();
+    auto const* indices = bit_cast<ext4_extent_idx const*>(node.offset_pointer(sizeof(ext4_extent_header)));
+    ByteBuffer child_storage;
+    for (size_t i = 0; i < header.eh_entries; ++i) {
+        // Each subtree covers the logical blocks up to where the next one starts.
+        u64 subtree_start = indices[i].ei_block;
+        u64 subtree_end = i + 1 < header.eh_entries ? indices[i + 1].ei_block : NumericLimits<u64>::max();
+        if (subtree_end <= first_block.value() || subtree_start > last_block.value())
+            continue;
+
+        BlockBasedFileSystem::BlockIndex child_block = (static_cast<u64>(indices[i].ei_leaf_hi) << 32) | indices[i].ei_leaf_lo;
+        TRY(child_storage.try_resize(block_size));
+        auto buffer = UserOrKernelBuffer::for_kernel_buffer(child_storage.data());
+        TRY(fs().read_block(child_block, &buffer, block_size, 0));
+        TRY(collect_extents(child_storage.bytes(), first_block, last_block, header.eh_depth - 1, list));
+    }
+    return {};
+}
+
+ErrorOr<void> Ext2FSInode::for_each_allocated_block(Function<ErrorOr<void>(BlockBasedFileSystem::BlockIndex)> callback) const
+{
     if (Kernel::is_symlink(m_raw_inode.i_mode) && m_raw_inode.i_blocks == 0)
         return {};
 
+    // FIXME: Support walking the blocks of extent trees.
+    if (uses_extents())
+        return ENOTSUP;
+
     unsigned const block_size = fs().logical_block_size();
     unsigned const entries_per_block = EXT2_ADDR_PER_BLOCK(&fs().super_block());
 
-    auto deallocate_block = [&](auto on_disk_block_index) -> ErrorOr<void> {
-        TRY(fs().set_block_allocation_state(on_disk_block_index, false));
-        m_raw_inode.i_blocks -= fs().i_blocks_increment();
-        return {};
-    };
-
-    auto process_block_array = [&](auto current_logical_index, unsigned level, auto array_block_index, ByteBuffer& array_storage, auto&& callback) -> ErrorOr<void> {
+    // NOTE: The blocks pointed to by an indirect block are visited before the indirect block itself.
+    auto process_block_array = [&](auto current_logical_index, unsigned level, auto array_block_index, ByteBuffer& array_storage, auto&& array_callback) -> ErrorOr<void> {
         TRY(array_storage.try_resize(block_size));
 
         auto* array = bit_cast<u32*>(array_storage.data());
@@ -346,29 +403,29 @@ ErrorOr<void> Ext2FSInode::free_all_blocks()
 
         for (unsigned i = 0; i < block_size / sizeof(u32); ++i) {
             if (array[i] != 0)
-                TRY(callback(current_logical_index + i * AK::pow(entries_per_block, level - 1), array[i]));
+                TRY(array_callback(current_logical_index + i * AK::pow(entries_per_block, level - 1), array[i]));
         }
 
-        return deallocate_block(array_block_index);
+        return callback(array_block_index);
     };
 
     for (size_t i = 0; i < EXT2_NDIR_BLOCKS; ++i) {
         if (m_raw_inode.i_block[i] != 0)
-            TRY(deallocate_block(m_raw_inode.i_block[i]));
+            TRY(callback(m_raw_inode.i_block[i]));
     }
 
     ByteBuffer block_storage[3] = {};
 
     if (m_raw_inode.i_block[EXT2_IND_BLOCK]) {
         TRY(process_block_array(EXT2_NDIR_BLOCKS, 1, m_raw_inode.i_block[EXT2_IND_BLOCK], block_storage[0], [&]([[maybe_unused]] auto logical_block_index, auto on_disk_index) -> ErrorOr<void> {
-            return deallocate_block(on_disk_index);
+            return callback(on_disk_index);
         }));
     }
 
     if (m_raw_inode.i_block[EXT2_DIND_BLOCK]) {
         TRY(process_block_array(singly_indirect_block_capacity(), 2, m_raw_inode.i_block[EXT2_DIND_BLOCK], block_storage[1], [&](auto logical_block_index, auto on_disk_index) -> ErrorOr<void> {
             return process_block_array(logical_block_index, 1, on_disk_index, block_storage[0], [&]([[maybe_unused]] auto logical_block_index2, auto on_disk_index2) -> ErrorOr<void> {
-                return deallocate_block(on_disk_index2);
+                return callback(on_disk_index2);
             });
         }));
     }
@@ -377,7 +434,7 @@ ErrorOr<void> Ext2FSInode::free_all_blocks()
         TRY(process_block_array(doubly_indirect_block_capacity(), 3, m_raw_inode.i_block[EXT2_TIND_BLOCK], block_storage[2], [&](auto logical_block_index, auto on_disk_index) -> ErrorOr<void> {
             return process_block_array(logical_block_index, 2, on_disk_index, block_storage[1], [&](auto logical_block_index2, auto on_disk_index2) -> ErrorOr<void> {
                 return process_block_array(logical_block_index2, 1, on_disk_index2, block_storage[0], [&]([[maybe_unused]] auto logical_block_index3, auto on_disk_index3) -> ErrorOr<void> {
-                    return deallocate_block(on_disk_index3);
+                    return callback(on_disk_index3);
                 });
             });
         }));
@@ -386,6 +443,46 @@ ErrorOr<void> Ext2FSInode::free_all_blocks()
     return {};
 }
 
+ErrorOr<void> Ext2FSInode::free_all_blocks()
+{
+    MutexLocker locker(m_inode_lock);
+
+    dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::free_all_blocks(): i_size={}, i_blocks={}", identifier(), m_raw_inode.i_size, m_raw_inode.i_blocks);
+
+    // FIXME: Support freeing the blocks of extent trees.
+    if (uses_extents())
+        return EROFS;
+
+    return for_each_allocated_block([&](auto on_disk_block_index) -> ErrorOr<void> {
+        TRY(fs().set_block_allocation_state(on_disk_block_index, false));
+        m_raw_inode.i_blocks -= fs().i_blocks_increment();
+        return {};
+    });
+}
+
+ErrorOr<void> Ext2FSInode::flush_writes()
+{
+    // Allocating blocks dirties the bitmaps, group descriptors and super block, which we can only write
+    // back all at once. In that case (and for extent trees we can't walk yet), write back everything.
+    if (uses_extents() || fs().has_dirty_allocation_state())
+        return fs().flush_writes();
+
+    Vector<BlockBasedFileSystem::BlockIndex> blocks;
+    {
+        MutexLocker locker(m_inode_lock);
+        TRY(for_each_allocated_block([&](auto on_disk_block_index) {
+            return blocks.try_append(on_disk_block_index);
+        }));
+    }
+
+    BlockBasedFileSystem::BlockIndex block_containing_inode;
+    unsigned offset;
+    if (fs().find_block_containing_inode(index(), block_containing_inode, offset))
+        TRY(blocks.try_append(block_containing_inode));
+
+    return fs().flush_blocks(blocks);
+}
+
 Ext2FSInode::Ext2FSInode(Ext2FS& fs, InodeIndex index)
     : Inode(fs, index)
     , m_block_view(*this)
@@ -394,10 +491,11 @@ Ext2FSInode::Ext2FSInode(Ext2FS& fs, InodeIndex index)
 
 Ext2FSInode::~Ext2FSInode()
 {
-    if (m_raw_inode.i_links_count == 0) {
-        // Alas, we have nowhere to propagate any errors that occur here.
+    // Alas, we have nowhere to propagate any errors that occur here.
+    (void)discard_preallocated_blocks();
+
+    if (m_raw_inode.i_links_count == 0)
         (void)fs().free_inode(*this);
-    }
 }
 
 u64 Ext2FSInode::size() const
@@ -534,6 +632,49 @@ ErrorOr<size_t> Ext2FSInode::read_bytes_locked(off_t offset, size_t count, UserO
     return nread;
 }
 
+void Ext2FSInode::read_ahead(u64 offset, size_t size)
+{
+    // NOTE: If we can't queue the work, the reader will simply fetch the blocks itself once it gets there.
+    (void)g_read_ahead_work->try_queue([inode = NonnullRefPtr { *this }, offset, size] {
+        MutexLocker locker(inode->m_inode_lock, Mutex::Mode::Shared);
+        if (auto result = inode->read_ahead_locked(offset, size); result.is_error())
+            dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::read_ahead(): Failed to read ahead {} bytes at offset {}: {}", inode->identifier(), size, offset, result.error());
+    });
+}
+
+ErrorOr<void> Ext2FSInode::read_ahead_locked(u64 offset, size_t size) const
+{
+    VERIFY(m_inode_lock.is_locked());
+    if (offset >= this->size() || is_symlink())
+        return {};
+    size = min(static_cast<u64>(size), this->size() - offset);
+    if (size == 0)
+        return {};
+
+    auto block_size = fs().logical_block_size();
+    u64 first_block_logical_index = offset / block_size;
+    u64 last_block_logical_index = (offset + size - 1) / block_size;
+
+    // Blocks that follow each other on disk are read in one go, so the device gets few large requests.
+    BlockBasedFileSystem::BlockIndex run_start = 0;
+    size_t run_length = 0;
+    for (auto logical_index = first_block_logical_index; logical_index <= last_block_logical_index; ++logical_index) {
+        auto block_index = TRY(m_block_view.get_block(logical_index));
+        if (run_length > 0 && block_index.value() != 0 && block_index.value() == run_start.value() + run_length) {
+            ++run_length;
+            continue;
+        }
+        if (run_length > 0)
+            TRY(fs().read_ahead_blocks(run_start, run_length));
+        // Holes don't need to be read at all.
+        run_start = block_index;
+        run_length = block_index.value() == 0 ? 0 : 1;
+    }
+    if (run_length > 0)
+        TRY(fs().read_ahead_blocks(run_start, run_length));
+    return {};
+}
+
 ErrorOr<void> Ext2FSInode::resize(u64 new_size)
 {
     VERIFY(m_inode_lock.is_locked());
@@ -543,7 +684,13 @@ ErrorOr<void> Ext2FSInode::resize(u64 new_size)
     if (!((u32)fs().get_features_readonly() & (u32)Ext2FS::FeaturesReadOnly::FileSize64bits) && (new_size >= static_cast<u32>(-1)))
         return ENOSPC;
 
+    // FIXME: Support shrinking extent trees.
+    if (new_size < size() && uses_extents())
+        return EROFS;
+
     if (new_size < size()) {
+        TRY(discard_preallocated_blocks());
+
         auto block_size = fs().logical_block_size();
         BlockBasedFileSystem::BlockIndex first_block_logical_index = ceil_div(new_size, block_size);
         BlockBasedFileSystem::BlockIndex last_block_logical_index = size() / block_size;
@@ -669,6 +816,9 @@ ErrorOr<void> Ext2FSInode::write_directory(Vector<Ext2FSDirectoryEntry>& entries
     MutexLocker locker(m_inode_lock);
     auto block_size = fs().logical_block_size();
 
+    // The entries get written out linearly, so an index would point at the wrong blocks afterwards.
+    m_raw_inode.i_flags &= ~EXT2_INDEX_FL;
+
     // Calculate directory size and record length of entries so that
     // the following constraints are met:
     // - All used blocks must be entirely filled.
@@ -723,14 +873,21 @@ ErrorOr<void> Ext2FSInode::write_directory(Vector<Ext2FSDirectoryEntry>& entries
     return {};
 }
 
-ErrorOr<BlockBasedFileSystem::BlockIndex> Ext2FSInode::allocate_block(BlockBasedFileSystem::BlockIndex block_index, bool zero_newly_allocated_block, bool allow_cache)
+ErrorOr<BlockBasedFileSystem::BlockIndex> Ext2FSInode::allocate_block(BlockBasedFileSystem::BlockIndex block_index, BlockBasedFileSystem::BlockIndex goal, bool zero_newly_allocated_block, bool allow_cache)
 {
-    // FIXME: Preallocate some extra blocks here.
-    auto blocks = TRY(fs().allocate_blocks(fs().group_index_from_inode(index()), 1));
-    m_raw_inode.i_blocks += fs().i_blocks_increment();
+    VERIFY(m_inode_lock.is_locked());
 
-    VERIFY(blocks.size() == 1);
-    auto block = blocks.first();
+    // The preallocated blocks are only useful if they continue where the previous block of the file ended.
+    if (m_preallocated_blocks.count != 0 && goal != 0 && m_preallocated_blocks.first_block != goal)
+        TRY(discard_preallocated_blocks());
+
+    if (m_preallocated_blocks.count == 0)
+        m_preallocated_blocks = TRY(fs().allocate_contiguous_blocks(fs().group_index_from_inode(index()), goal, preallocated_block_count));
+
+    auto block = m_preallocated_blocks.first_block;
+    m_preallocated_blocks.first_block = block.value() + 1;
+    --m_preallocated_blocks.count;
+    m_raw_inode.i_blocks += fs().i_blocks_increment();
 
     if (zero_newly_allocated_block) {
         u8 zero_buffer[PAGE_SIZE] {};
@@ -743,6 +900,85 @@ ErrorOr<BlockBasedFileSystem::BlockIndex> Ext2FSInode::allocate_block(BlockBased
     return block;
 }
 
+ErrorOr<void> Ext2FSInode::discard_preallocated_blocks()
+{
+    if (m_preallocated_blocks.count == 0)
+        return {};
+    dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::discard_preallocated_blocks(): Freeing {} blocks starting at {}", identifier(), m_preallocated_blocks.count, m_preallocated_blocks.first_block);
+    auto blocks = exchange(m_preallocated_blocks, Ext2FS::BlockRun {});
+    return fs().free_block_run(blocks);
+}
+
+ErrorOr<size_t> Ext2FSInode::copy_range_from_locked(Inode& source_inode, off_t source_offset, off_t offset, size_t length)
+{
+    VERIFY(m_inode_lock.is_locked());
+    auto& source = static_cast<Ext2FSInode&>(source_inode);
+    if (!Kernel::is_regular_file(source.m_raw_inode.i_mode) || !Kernel::is_regular_file(m_raw_inode.i_mode))
+        return EINVAL;
+    if (static_cast<u64>(source_offset) >= source.size())
+        return 0;
+    length = min<u64>(length, source.size() - source_offset);
+
+    // Copying a hole onto another hole can be done by not copying anything. That requires the blocks of
+    // both files to line up, and leaves sparse files sparse instead of filling them up with zeroes.
+    auto const block_size = fs().logical_block_size();
+    bool const can_skip_holes = (source_offset % block_size) == (offset % block_size);
+    auto is_hole_in_both = [&](BlockBasedFileSystem::BlockIndex source_block, BlockBasedFileSystem::BlockIndex destination_block) -> ErrorOr<bool> {
+        return TRY(source.m_block_view.get_block(source_block)) == 0 && TRY(m_block_view.get_block(destination_block)) == 0;
+    };
+
+    auto buffer = TRY(KBuffer::try_create_with_size("Ext2FSInode: Copy"sv, min<size_t>(length, copy_range_chunk_size)));
+    auto kernel_buffer = buffer->as_kernel_buffer();
+
+    size_t ncopied = 0;
+    while (ncopied < length) {
+        auto const current_source_offset = source_offset + ncopied;
+        auto const current_offset = offset + ncopied;
+        auto chunk_size = min(length - ncopied, buffer->size());
+
+        if (can_skip_holes) {
+            BlockBasedFileSystem::BlockIndex source_block = current_source_offset / block_size;
+            BlockBasedFileSystem::BlockIndex destination_block = current_offset / block_size;
+            auto const bytes_left_in_block = block_size - (current_offset % block_size);
+            if (current_offset % block_size == 0 && TRY(is_hole_in_both(source_block, destination_block))) {
+                ncopied += min<size_t>(bytes_left_in_block, length - ncopied);
+                continue;
+            }
+            // Stop this chunk at the next hole we can skip over.
+            size_t run = bytes_left_in_block;
+            while (run < chunk_size) {
+                source_block = source_block.value() + 1;
+                destination_block = destination_block.value() + 1;
+                if (TRY(is_hole_in_both(source_block, destination_block)))
+                    break;
+                run += block_size;
+            }
+            chunk_size = min(chunk_size, run);
+        }
+
+        auto nread = TRY(source.read_bytes_locked(current_source_offset, chunk_size, kernel_buffer, nullptr));
+        if (nread == 0)
+            break;
+        auto nwritten = TRY(write_bytes_locked(current_offset, nread, kernel_buffer, nullptr));
+        ncopied += nwritten;
+        if (nwritten < nread)
+            break;
+    }
+
+    // Holes at the end still have to count towards the size of the file.
+    if (ncopied > 0 && static_cast<u64>(offset + ncopied) > size())
+        TRY(truncate_locked(offset + ncopied));
+    return ncopied;
+}
+
+void Ext2FSInode::detach(OpenFileDescription&)
+{
+    MutexLocker locker(m_inode_lock);
+    // Don't hold on to blocks that the file may never grow into.
+    if (auto result = discard_preallocated_blocks(); result.is_error())
+        dbgln("Ext2FSInode[{}]::detach(): Failed to free preallocated blocks: {}", identifier(), result.error());
+}
+
 ErrorOr<NonnullRefPtr<Inode>> Ext2FSInode::create_child(StringView name, mode_t mode, dev_t dev, UserID uid, GroupID gid)
 {
     if (Kernel::is_directory(mode))
@@ -761,6 +997,16 @@ ErrorOr<void> Ext2FSInode::add_child(Inode& child, StringView name, mode_t mode)
     dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::add_child(): Adding inode {} with name '{}' and mode {:o} to directory {}", identifier(), child.index(), name, mode, index());
     bool has_file_type_attribute = has_flag(fs().get_features_optional(), Ext2FS::FeaturesOptional::ExtendedAttributes);
 
+    if (auto index_path = TRY(probe_directory_index(name)); index_path.has_value()) {
+        auto lookup_path = *index_path;
+        if (TRY(find_in_directory_index(lookup_path, name)).has_value())
+            return EEXIST;
+        TRY(child.increment_link_count());
+        TRY(add_to_directory_index(*index_path, name, child.index(), has_file_type_attribute ? to_ext2_file_type(mode) : (u8)EXT2_FT_UNKNOWN));
+        did_add_child(child.identifier(), name);
+        return {};
+    }
+
     Vector<Ext2FSDirectoryEntry> entries;
     TRY(traverse_as_directory([&](auto& entry) -> ErrorOr<void> {
         if (name == entry.name)
@@ -789,12 +1035,20 @@ ErrorOr<void> Ext2FSInode::remove_child_impl(StringView name, RemoveDotEntries r
     MutexLocker locker(m_inode_lock);
     VERIFY(is_directory());
 
-    TRY(populate_lookup_cache());
-
-    auto it = m_lookup_cache.find(name);
-    if (it == m_lookup_cache.end())
-        return ENOENT;
-    auto child_inode_index = (*it).value;
+    InodeIndex child_inode_index;
+    Optional<DirectoryIndexMatch> index_match;
+    if (auto index_path = TRY(probe_directory_index(name)); index_path.has_value()) {
+        index_match = TRY(find_in_directory_index(*index_path, name));
+        if (!index_match.has_value())
+            return ENOENT;
+        child_inode_index = index_match->inode_index;
+    } else {
+        TRY(populate_lookup_cache());
+        auto it = m_lookup_cache.find(name);
+        if (it == m_lookup_cache.end())
+            return ENOENT;
+        child_inode_index = it->value;
+    }
 
     InodeIdentifier child_id { fsid(), child_inode_index };
     auto child_inode = TRY(fs().get_inode(child_id));
@@ -803,20 +1057,24 @@ ErrorOr<void> Ext2FSInode::remove_child_impl(StringView name, RemoveDotEntries r
         TRY(static_cast<Ext2FSInode&>(*child_inode).remove_child_impl(".."sv, RemoveDotEntries::No));
     }
 
-    bool has_file_type_attribute = has_flag(fs().get_features_optional(), Ext2FS::FeaturesOptional::ExtendedAttributes);
+    if (index_match.has_value()) {
+        TRY(remove_from_directory_index(*index_match));
+    } else {
+        bool has_file_type_attribute = has_flag(fs().get_features_optional(), Ext2FS::FeaturesOptional::ExtendedAttributes);
 
-    Vector<Ext2FSDirectoryEntry> entries;
-    TRY(traverse_as_directory([&](auto& entry) -> ErrorOr<void> {
-        if (name != entry.name) {
-            auto entry_name = TRY(KString::try_create(entry.name));
-            TRY(entries.try_append({ move(entry_name), entry.inode.index(), has_file_type_attribute ? entry.file_type : (u8)EXT2_FT_UNKNOWN }));
-        }
-        return {};
-    }));
+        Vector<Ext2FSDirectoryEntry> entries;
+        TRY(traverse_as_directory([&](auto& entry) -> ErrorOr<void> {
+            if (name != entry.name) {
+                auto entry_name = TRY(KString::try_create(entry.name));
+                TRY(entries.try_append({ move(entry_name), entry.inode.index(), has_file_type_attribute ? entry.file_type : (u8)EXT2_FT_UNKNOWN }));
+            }
+            return {};
+        }));
 
-    TRY(write_directory(entries));
+        TRY(write_directory(entries));
 
-    m_lookup_cache.remove(it);
+        m_lookup_cache.remove(name);
+    }
 
     TRY(child_inode->decrement_link_count());
 
@@ -849,6 +1107,383 @@ ErrorOr<void> Ext2FSInode::populate_lookup_cache()
     return {};
 }
 
+// The first two records of an indexed directory are "." and "..", and the root of the index comes right after them.
+static constexpr size_t directory_index_dot_dot_offset = EXT2_DIR_REC_LEN(1);
+static constexpr size_t directory_index_root_info_offset = directory_index_dot_dot_offset + EXT2_DIR_REC_LEN(2);
+// Inner nodes start with an unused record that spans the whole block.
+static constexpr size_t directory_index_node_entries_offset = 8;
+// The upper bits of block numbers in the index are reserved.
+static constexpr u32 directory_index_block_mask = 0x0fffffff;
+// Without the "largedir" feature, an index can't be more than two levels deep below its root.
+static constexpr size_t max_directory_index_levels = 3;
+
+template<typename Callback>
+static ErrorOr<void> for_each_record_in_directory_block(Bytes block, Callback callback)
+{
+    Optional<size_t> previous_offset;
+    for (size_t offset = 0; offset < block.size();) {
+        auto& record = *reinterpret_cast<ext2_dir_entry_2*>(block.data() + offset);
+        if (offset + 8 > block.size() || record.rec_len < 8 || record.rec_len % EXT2_DIR_PAD != 0 || offset + record.rec_len > block.size() || record.name_len + 8u > record.rec_len) {
+            dbgln("Ext2FS: Corrupted directory record at offset {}", offset);
+            return EIO;
+        }
+        if (callback(record, offset, previous_offset) == IterationDecision::Break)
+            return {};
+        previous_offset = offset;
+        offset += record.rec_len;
+    }
+    return {};
+}
+
+// The first entry of an index node has no hash, its place is taken by the count and limit of the node.
+static ext2_dx_countlimit& directory_index_count_limit(Bytes block, size_t entries_offset)
+{
+    return *reinterpret_cast<ext2_dx_countlimit*>(block.data() + entries_offset);
+}
+
+static ErrorOr<Span<ext2_dx_entry>> directory_index_entries(Bytes block, size_t entries_offset)
+{
+    if (entries_offset + sizeof(ext2_dx_entry) > block.size())
+        return EIO;
+    auto const& count_limit = directory_index_count_limit(block, entries_offset);
+    if (count_limit.count == 0 || count_limit.count > count_limit.limit || entries_offset + count_limit.limit * sizeof(ext2_dx_entry) > block.size()) {
+        dbgln("Ext2FS: Corrupted directory index node (count: {}, limit: {})", count_limit.count, count_limit.limit);
+        return EIO;
+    }
+    return Span<ext2_dx_entry> { reinterpret_cast<ext2_dx_entry*>(block.data() + entries_offset), count_limit.count };
+}
+
+// Puts a new record into the first gap that is large enough for it. Returns false if there is none.
+static ErrorOr<bool> insert_into_directory_block(Bytes block, StringView name, InodeIndex inode_index, u8 file_type)
+{
+    size_t needed_length = EXT2_DIR_REC_LEN(name.length());
+    bool inserted = false;
+    TRY(for_each_record_in_directory_block(block, [&](auto& record, size_t offset, auto) {
+        size_t used_length = record.inode != 0 ? EXT2_DIR_REC_LEN(record.name_len) : 0;
+        if (record.rec_len - used_length < needed_length)
+            return IterationDecision::Continue;
+
+        auto new_record_length = record.rec_len - used_length;
+        if (used_length != 0)
+            record.rec_len = used_length;
+        auto& new_record = *reinterpret_cast<ext2_dir_entry_2*>(block.data() + offset + used_length);
+        new_record.inode = inode_index.value();
+        new_record.rec_len = new_record_length;
+        new_record.name_len = name.length();
+        new_record.file_type = file_type;
+        memcpy(new_record.name, name.characters_without_null_termination(), name.length());
+        inserted = true;
+        return IterationDecision::Break;
+    }));
+    return inserted;
+}
+
+// Lays out the given records of the source block one after the other, with the last one taking up the rest of the block.
+static void pack_directory_block(Bytes destination, ReadonlyBytes source, ReadonlySpan<size_t> record_offsets)
+{
+    VERIFY(!record_offsets.is_empty());
+    destination.fill(0);
+    size_t offset = 0;
+    ext2_dir_entry_2* last_record = nullptr;
+    for (auto source_offset : record_offsets) {
+        auto const& source_record = *reinterpret_cast<ext2_dir_entry_2 const*>(source.data() + source_offset);
+        memcpy(destination.data() + offset, &source_record, 8 + source_record.name_len);
+        last_record = reinterpret_cast<ext2_dir_entry_2*>(destination.data() + offset);
+        last_record->rec_len = EXT2_DIR_REC_LEN(source_record.name_len);
+        offset += last_record->rec_len;
+    }
+    last_record->rec_len += destination.size() - offset;
+}
+
+bool Ext2FSInode::has_directory_index() const
+{
+    return is_directory() && (m_raw_inode.i_flags & EXT2_INDEX_FL) && has_flag(fs().get_features_optional(), Ext2FS::FeaturesOptional::DirectoryIndex);
+}
+
+ErrorOr<void> Ext2FSInode::read_directory_block(BlockBasedFileSystem::BlockIndex block, Bytes buffer) const
+{
+    VERIFY(m_inode_lock.is_locked());
+    auto block_size = fs().logical_block_size();
+    VERIFY(buffer.size() == block_size);
+    if ((block.value() + 1) * block_size > size()) {
+        dbgln("Ext2FSInode[{}]::read_directory_block(): Block {} is past the end of the directory", identifier(), block);
+        return EIO;
+    }
+    auto user_or_kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer.data());
+    auto nread = TRY(read_bytes_locked(block.value() * block_size, block_size, user_or_kernel_buffer, nullptr));
+    if (nread != block_size)
+        return EIO;
+    return {};
+}
+
+ErrorOr<void> Ext2FSInode::write_directory_block(BlockBasedFileSystem::BlockIndex block, Bytes buffer)
+{
+    VERIFY(m_inode_lock.is_exclusively_locked_by_current_thread());
+    auto block_size = fs().logical_block_size();
+    VERIFY(buffer.size() == block_size);
+    auto user_or_kernel_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer.data());
+    auto nwritten = TRY(prepare_and_write_bytes_locked(block.value() * block_size, block_size, user_or_kernel_buffer, nullptr));
+    set_metadata_dirty(true);
+    if (nwritten != block_size)
+        return EIO;
+    return {};
+}
+
+ErrorOr<Optional<Ext2FSInode::DirectoryIndexPath>> Ext2FSInode::probe_directory_index(StringView name) const
+{
+    VERIFY(m_inode_lock.is_locked());
+    // "." and ".." are in the root block, in front of the index.
+    if (!has_directory_index() || name == "."sv || name == ".."sv)
+        return OptionalNone {};
+
+    u8 buffer[max_block_size];
+    Bytes block { buffer, fs().logical_block_size() };
+    TRY(read_directory_block(0, block));
+
+    auto const& root_info = *reinterpret_cast<ext2_dx_root_info const*>(buffer + directory_index_root_info_offset);
+    if (root_info.reserved_zero != 0 || root_info.indirect_levels >= max_directory_index_levels || (root_info.unused_flags & EXT2_HASH_FLAG_INCOMPAT)) {
+        dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::probe_directory_index(): Ignoring index with {} indirect levels and flags {:#x}", identifier(), root_info.indirect_levels, root_info.unused_flags);
+        return OptionalNone {};
+    }
+
+    DirectoryIndexPath path;
+    path.hash_version = root_info.hash_version;
+    if (path.hash_version <= EXT2_HASH_TEA && (fs().super_block().s_flags & EXT2_FLAGS_UNSIGNED_HASH))
+        path.hash_version += EXT2_HASH_LEGACY_UNSIGNED;
+    auto hash = ext2_directory_hash(name.bytes(), path.hash_version, fs().super_block().s_hash_seed);
+    if (!hash.has_value()) {
+        dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::probe_directory_index(): Ignoring index with unknown hash version {}", identifier(), path.hash_version);
+        return OptionalNone {};
+    }
+    path.hash = hash.value();
+
+    size_t indirect_levels = root_info.indirect_levels;
+    BlockBasedFileSystem::BlockIndex block_index = 0;
+    size_t entries_offset = directory_index_root_info_offset + root_info.info_length;
+    for (size_t level = 0;; ++level) {
+        auto entries = TRY(directory_index_entries(block, entries_offset));
+
+        // Find the last entry whose hash isn't larger than ours. The first entry covers everything below the second one.
+        size_t low = 1;
+        size_t high = entries.size();
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            if (entries[middle].hash > path.hash)
+                high = middle;
+            else
+                low = middle + 1;
+        }
+        auto position = low - 1;
+
+        auto const& count_limit = directory_index_count_limit(block, entries_offset);
+        TRY(path.levels.try_append({ block_index, entries_offset, count_limit.count, count_limit.limit, position }));
+
+        BlockBasedFileSystem::BlockIndex child = entries[position].block & directory_index_block_mask;
+        if (level == indirect_levels) {
+            path.leaf_block = child;
+            return path;
+        }
+        TRY(read_directory_block(child, block));
+        block_index = child;
+        entries_offset = directory_index_node_entries_offset;
+    }
+}
+
+ErrorOr<bool> Ext2FSInode::advance_directory_index(DirectoryIndexPath& path) const
+{
+    VERIFY(m_inode_lock.is_locked());
+    u8 buffer[max_block_size];
+    Bytes block { buffer, fs().logical_block_size() };
+
+    // Go up to the closest level that has more entries after the one we took.
+    auto level = path.levels.size();
+    while (level > 0 && path.levels[level - 1].position + 1 >= path.levels[level - 1].count)
+        --level;
+    if (level == 0)
+        return false;
+
+    auto& current = path.levels[level - 1];
+    TRY(read_directory_block(current.block, block));
+    auto entries = TRY(directory_index_entries(block, current.entries_offset));
+    if (current.position + 1 >= entries.size())
+        return false;
+    // Names with our hash only continue in the next leaf if it starts with that hash, with the collision bit set.
+    if ((entries[current.position + 1].hash & ~1u) != path.hash)
+        return false;
+    ++current.position;
+
+    BlockBasedFileSystem::BlockIndex child = entries[current.position].block & directory_index_block_mask;
+    for (; level < path.levels.size(); ++level) {
+        TRY(read_directory_block(child, block));
+        auto child_entries = TRY(directory_index_entries(block, directory_index_node_entries_offset));
+        auto const& count_limit = directory_index_count_limit(block, directory_index_node_entries_offset);
+        path.levels[level] = { child, directory_index_node_entries_offset, count_limit.count, count_limit.limit, 0 };
+        child = child_entries[0].block & directory_index_block_mask;
+    }
+    path.leaf_block = child;
+    return true;
+}
+
+ErrorOr<Optional<Ext2FSInode::DirectoryIndexMatch>> Ext2FSInode::find_in_directory_index(DirectoryIndexPath& path, StringView name) const
+{
+    VERIFY(m_inode_lock.is_locked());
+    u8 buffer[max_block_size];
+    Bytes block { buffer, fs().logical_block_size() };
+
+    do {
+        TRY(read_directory_block(path.leaf_block, block));
+        Optional<DirectoryIndexMatch> match;
+        TRY(for_each_record_in_directory_block(block, [&](auto& record, size_t offset, Optional<size_t> previous_offset) {
+            if (record.inode == 0 || StringView { record.name, record.name_len } != name)
+                return IterationDecision::Continue;
+            match = DirectoryIndexMatch { path.leaf_block, offset, previous_offset, record.inode };
+            return IterationDecision::Break;
+        }));
+        if (match.has_value())
+            return match;
+    } while (TRY(advance_directory_index(path)));
+
+    return OptionalNone {};
+}
+
+ErrorOr<InodeIndex> Ext2FSInode::dot_dot_from_directory_index() const
+{
+    VERIFY(m_inode_lock.is_locked());
+    u8 buffer[max_block_size];
+    TRY(read_directory_block(0, { buffer, fs().logical_block_size() }));
+    auto const& record = *reinterpret_cast<ext2_dir_entry_2 const*>(buffer + directory_index_dot_dot_offset);
+    if (StringView { record.name, record.name_len } != ".."sv)
+        return EIO;
+    return InodeIndex { record.inode };
+}
+
+ErrorOr<void> Ext2FSInode::set_dot_dot_in_directory_index(InodeIndex parent_index)
+{
+    MutexLocker locker(m_inode_lock);
+    VERIFY(has_directory_index());
+    u8 buffer[max_block_size];
+    Bytes block { buffer, fs().logical_block_size() };
+    TRY(read_directory_block(0, block));
+    auto& record = *reinterpret_cast<ext2_dir_entry_2*>(buffer + directory_index_dot_dot_offset);
+    if (StringView { record.name, record.name_len } != ".."sv)
+        return EIO;
+    record.inode = parent_index.value();
+    return write_directory_block(0, block);
+}
+
+ErrorOr<void> Ext2FSInode::add_to_directory_index(DirectoryIndexPath const& path, StringView name, InodeIndex inode_index, u8 file_type)
+{
+    VERIFY(m_inode_lock.is_exclusively_locked_by_current_thread());
+    auto block_size = fs().logical_block_size();
+    auto leaf = TRY(ByteBuffer::create_uninitialized(block_size));
+    TRY(read_directory_block(path.leaf_block, leaf.bytes()));
+    if (TRY(insert_into_directory_block(leaf.bytes(), name, inode_index, file_type)))
+        return write_directory_block(path.leaf_block, leaf.bytes());
+
+    auto const& parent = path.levels.last();
+    if (parent.count >= parent.limit) {
+        // FIXME: Split full index nodes too, instead of giving up on the index.
+        dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::add_to_directory_index(): Index node in block {} is full, dropping the index", identifier(), parent.block);
+        return add_to_linear_directory(name, inode_index, file_type);
+    }
+
+    // The leaf is full, so we move the upper half of its hashes into a new leaf at the end of the directory.
+    struct HashedRecord {
+        u32 hash { 0 };
+        size_t offset { 0 };
+    };
+    Vector<HashedRecord> records;
+    TRY(records.try_ensure_capacity(block_size / EXT2_DIR_REC_LEN(1)));
+    TRY(for_each_record_in_directory_block(leaf.bytes(), [&](auto& record, size_t offset, auto) {
+        if (record.inode != 0) {
+            auto hash = ext2_directory_hash({ reinterpret_cast<u8 const*>(record.name), record.name_len }, path.hash_version, fs().super_block().s_hash_seed);
+            records.unchecked_append({ hash.value(), offset });
+        }
+        return IterationDecision::Continue;
+    }));
+    if (records.size() < 2)
+        return add_to_linear_directory(name, inode_index, file_type);
+    quick_sort(records, [](auto const& a, auto const& b) { return a.hash < b.hash; });
+
+    auto split = records.size() / 2;
+    auto split_hash = records[split].hash;
+    // If names with the same hash end up in both leaves, lookups have to know that they should continue into the new one.
+    u32 collision_bit = records[split - 1].hash == split_hash ? 1 : 0;
+
+    Vector<size_t> offsets;
+    TRY(offsets.try_ensure_capacity(records.size()));
+    for (auto const& record : records)
+        offsets.unchecked_append(record.offset);
+
+    auto lower_leaf = TRY(ByteBuffer::create_uninitialized(block_size));
+    auto upper_leaf = TRY(ByteBuffer::create_uninitialized(block_size));
+    pack_directory_block(lower_leaf.bytes(), leaf.bytes(), offsets.span().trim(split));
+    pack_directory_block(upper_leaf.bytes(), leaf.bytes(), offsets.span().slice(split));
+    auto& target_leaf = path.hash >= split_hash ? upper_leaf : lower_leaf;
+    if (!TRY(insert_into_directory_block(target_leaf.bytes(), name, inode_index, file_type)))
+        return add_to_linear_directory(name, inode_index, file_type);
+
+    auto parent_node = TRY(ByteBuffer::create_uninitialized(block_size));
+    TRY(read_directory_block(parent.block, parent_node.bytes()));
+    auto parent_entries = TRY(directory_index_entries(parent_node.bytes(), parent.entries_offset));
+    auto& count_limit = directory_index_count_limit(parent_node.bytes(), parent.entries_offset);
+    if (count_limit.count != parent.count || parent.position >= parent.count)
+        return EIO;
+
+    BlockBasedFileSystem::BlockIndex new_leaf_block = ceil_div(size(), static_cast<u64>(block_size));
+    auto* new_entry = parent_entries.data() + parent.position + 1;
+    memmove(new_entry + 1, new_entry, (parent.count - parent.position - 1) * sizeof(ext2_dx_entry));
+    new_entry->hash = split_hash | collision_bit;
+    new_entry->block = new_leaf_block.value();
+    ++count_limit.count;
+
+    dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]::add_to_directory_index(): Split leaf {} at hash {:#x} into new leaf {}", identifier(), path.leaf_block, split_hash, new_leaf_block);
+    TRY(write_directory_block(new_leaf_block, upper_leaf.bytes()));
+    TRY(write_directory_block(path.leaf_block, lower_leaf.bytes()));
+    return write_directory_block(parent.block, parent_node.bytes());
+}
+
+ErrorOr<void> Ext2FSInode::remove_from_directory_index(DirectoryIndexMatch const& match)
+{
+    VERIFY(m_inode_lock.is_exclusively_locked_by_current_thread());
+    u8 buffer[max_block_size];
+    Bytes block { buffer, fs().logical_block_size() };
+    TRY(read_directory_block(match.leaf_block, block));
+
+    auto& record = *reinterpret_cast<ext2_dir_entry_2*>(buffer + match.offset);
+    VERIFY(record.inode == match.inode_index.value());
+    if (match.previous_offset.has_value()) {
+        auto& previous_record = *reinterpret_cast<ext2_dir_entry_2*>(buffer + match.previous_offset.value());
+        previous_record.rec_len += record.rec_len;
+    } else {
+        record.inode = 0;
+    }
+    return write_directory_block(match.leaf_block, block);
+}
+
+ErrorOr<void> Ext2FSInode::add_to_linear_directory(StringView name, InodeIndex inode_index, u8 file_type)
+{
+    VERIFY(m_inode_lock.is_exclusively_locked_by_current_thread());
+    bool has_file_type_attribute = has_flag(fs().get_features_optional(), Ext2FS::FeaturesOptional::ExtendedAttributes);
+
+    Vector<Ext2FSDirectoryEntry> entries;
+    TRY(traverse_as_directory([&](auto& entry) -> ErrorOr<void> {
+        auto entry_name = TRY(KString::try_create(entry.name));
+        TRY(entries.try_append({ move(entry_name), entry.inode.index(), has_file_type_attribute ? entry.file_type : (u8)EXT2_FT_UNKNOWN }));
+        return {};
+    }));
+
+    auto entry_name = TRY(KString::try_create(name));
+    TRY(entries.try_empend(move(entry_name), inode_index, file_type));
+
+    TRY(write_directory(entries));
+    TRY(populate_lookup_cache());
+
+    auto cache_entry_name = TRY(KString::try_create(name));
+    TRY(m_lookup_cache.try_set(move(cache_entry_name), inode_index));
+    return {};
+}
+
 ErrorOr<NonnullRefPtr<Inode>> Ext2FSInode::lookup(StringView name)
 {
     VERIFY(is_directory());
@@ -857,13 +1492,26 @@ ErrorOr<NonnullRefPtr<Inode>> Ext2FSInode::lookup(StringView name)
     InodeIndex inode_index;
     {
         MutexLocker locker(m_inode_lock);
-        TRY(populate_lookup_cache());
-        auto it = m_lookup_cache.find(name);
-        if (it == m_lookup_cache.end()) {
-            dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]:lookup(): '{}' not found", identifier(), name);
-            return ENOENT;
+        if (auto index_path = TRY(probe_directory_index(name)); index_path.has_value()) {
+            auto match = TRY(find_in_directory_index(*index_path, name));
+            if (!match.has_value()) {
+                dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]:lookup(): '{}' not found in index", identifier(), name);
+                return ENOENT;
+            }
+            inode_index = match->inode_index;
+        } else if (has_directory_index() && name == "."sv) {
+            inode_index = index();
+        } else if (has_directory_index() && name == ".."sv) {
+            inode_index = TRY(dot_dot_from_directory_index());
+        } else {
+            TRY(populate_lookup_cache());
+            auto it = m_lookup_cache.find(name);
+            if (it == m_lookup_cache.end()) {
+                dbgln_if(EXT2_DEBUG, "Ext2FSInode[{}]:lookup(): '{}' not found", identifier(), name);
+                return ENOENT;
+            }
+            inode_index = it->value;
         }
-        inode_index = it->value;
     }
 
     return fs().get_inode({ fsid(), inode_index });
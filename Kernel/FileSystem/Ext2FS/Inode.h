@@ -26,14 +26,18 @@ public:
     u64 size() const;
     bool is_symlink() const { return Kernel::is_symlink(m_raw_inode.i_mode); }
     bool is_directory() const { return Kernel::is_directory(m_raw_inode.i_mode); }
+    bool uses_extents() const { return m_raw_inode.i_flags & EXT4_EXTENTS_FL; }
 
 private:
     // ^Inode
     virtual ErrorOr<size_t> read_bytes_locked(off_t, size_t, UserOrKernelBuffer& buffer, OpenFileDescription*) const override;
+    virtual void read_ahead(u64 offset, size_t size) override;
+    virtual void detach(OpenFileDescription&) override;
     virtual InodeMetadata metadata() const override;
     virtual ErrorOr<void> traverse_as_directory(Function<ErrorOr<void>(FileSystem::DirectoryEntryView const&)>) const override;
     virtual ErrorOr<NonnullRefPtr<Inode>> lookup(StringView name) override;
     virtual ErrorOr<void> flush_metadata() override;
+    virtual ErrorOr<void> flush_writes() override;
     virtual ErrorOr<size_t> write_bytes_locked(off_t, size_t, UserOrKernelBuffer const& data, OpenFileDescription*) override;
     virtual ErrorOr<NonnullRefPtr<Inode>> create_child(StringView name, mode_t, dev_t, UserID, GroupID) override;
     virtual ErrorOr<void> add_child(Inode& child, StringView name, mode_t) override;
@@ -44,6 +48,7 @@ private:
     virtual ErrorOr<void> chmod(mode_t) override;
     virtual ErrorOr<void> chown(UserID, GroupID) override;
     virtual ErrorOr<void> truncate_locked(u64) override;
+    virtual ErrorOr<size_t> copy_range_from_locked(Inode&, off_t source_offset, off_t offset, size_t length) override;
     virtual ErrorOr<int> get_block_address(int) override;
 
     static u8 to_ext2_file_type(mode_t mode);
@@ -52,7 +57,8 @@ private:
     static u32 decode_nanoseconds_from_extra(u32 extra) { return (extra & EXT4_NSEC_MASK) >> EXT4_EPOCH_BITS; }
     static u32 encode_time_to_extra(time_t seconds, u32 nanoseconds) { return (((static_cast<time_t>(seconds) - static_cast<i32>(seconds)) >> 32) & EXT4_EPOCH_MASK) | (nanoseconds << EXT4_EPOCH_BITS); }
 
-    ErrorOr<BlockBasedFileSystem::BlockIndex> allocate_block(BlockBasedFileSystem::BlockIndex, bool zero_newly_allocated_block, bool allow_cache);
+    ErrorOr<BlockBasedFileSystem::BlockIndex> allocate_block(BlockBasedFileSystem::BlockIndex, BlockBasedFileSystem::BlockIndex goal, bool zero_newly_allocated_block, bool allow_cache);
+    ErrorOr<void> discard_preallocated_blocks();
     ErrorOr<u32> allocate_and_zero_block();
 
     enum class RemoveDotEntries {
@@ -63,14 +69,54 @@ private:
     ErrorOr<void> remove_child_impl(StringView name, RemoveDotEntries);
     ErrorOr<void> write_directory(Vector<Ext2FSDirectoryEntry>&);
     ErrorOr<void> populate_lookup_cache();
+
+    // Large directories made by ext3 and ext4 can have a hashed index ("htree") in front of their entries.
+    // Its root lives in the first block of the directory, which (like the inner nodes) looks like
+    // an unused directory entry to anyone who doesn't know about the index.
+    struct DirectoryIndexPath {
+        struct Level {
+            BlockBasedFileSystem::BlockIndex block;
+            size_t entries_offset { 0 };
+            u16 count { 0 };
+            u16 limit { 0 };
+            size_t position { 0 };
+        };
+        Vector<Level, 3> levels;
+        u8 hash_version { 0 };
+        u32 hash { 0 };
+        BlockBasedFileSystem::BlockIndex leaf_block;
+    };
+
+    struct DirectoryIndexMatch {
+        BlockBasedFileSystem::BlockIndex leaf_block;
+        size_t offset { 0 };
+        Optional<size_t> previous_offset;
+        InodeIndex inode_index;
+    };
+
+    bool has_directory_index() const;
+    ErrorOr<void> read_directory_block(BlockBasedFileSystem::BlockIndex, Bytes) const;
+    ErrorOr<void> write_directory_block(BlockBasedFileSystem::BlockIndex, Bytes);
+    // Returns an empty Optional if the directory doesn't have an index we can use for this name.
+    ErrorOr<Optional<DirectoryIndexPath>> probe_directory_index(StringView name) const;
+    ErrorOr<bool> advance_directory_index(DirectoryIndexPath&) const;
+    ErrorOr<Optional<DirectoryIndexMatch>> find_in_directory_index(DirectoryIndexPath&, StringView name) const;
+    ErrorOr<InodeIndex> dot_dot_from_directory_index() const;
+    ErrorOr<void> set_dot_dot_in_directory_index(InodeIndex);
+    ErrorOr<void> add_to_directory_index(DirectoryIndexPath const&, StringView name, InodeIndex, u8 file_type);
+    ErrorOr<void> remove_from_directory_index(DirectoryIndexMatch const&);
+    ErrorOr<void> add_to_linear_directory(StringView name, InodeIndex, u8 file_type);
     ErrorOr<void> resize(u64);
+    ErrorOr<void> read_ahead_locked(u64 offset, size_t size) const;
     ErrorOr<void> write_singly_indirect_block_pointer(BlockBasedFileSystem::BlockIndex logical_block_index, BlockBasedFileSystem::BlockIndex on_disk_index);
     ErrorOr<void> write_doubly_indirect_block_pointer(BlockBasedFileSystem::BlockIndex logical_block_index, BlockBasedFileSystem::BlockIndex on_disk_index);
     ErrorOr<void> write_triply_indirect_block_pointer(BlockBasedFileSystem::BlockIndex logical_block_index, BlockBasedFileSystem::BlockIndex on_disk_index);
     ErrorOr<void> write_block_pointer(BlockBasedFileSystem::BlockIndex logical_block_index, BlockBasedFileSystem::BlockIndex on_disk_index);
 
     ErrorOr<Ext2FS::BlockList> compute_block_list(BlockBasedFileSystem::BlockIndex, BlockBasedFileSystem::BlockIndex) const;
+    ErrorOr<void> collect_extents(ReadonlyBytes node, BlockBasedFileSystem::BlockIndex first_block, BlockBasedFileSystem::BlockIndex last_block, unsigned max_depth, Ext2FS::BlockList&) const;
 
+    ErrorOr<void> for_each_allocated_block(Function<ErrorOr<void>(BlockBasedFileSystem::BlockIndex)>) const;
     ErrorOr<void> free_all_blocks();
 
     u64 singly_indirect_block_capacity() const
@@ -95,7 +141,13 @@ private:
     Ext2FS const& fs() const;
     Ext2FSInode(Ext2FS&, InodeIndex);
 
+    // Writes that extend a file allocate this many blocks at once, and keep the ones they don't need yet around,
+    // so that the next writes can continue the same run of blocks on disk.
+    static constexpr size_t preallocated_block_count = 32;
+
     mutable Ext2FSBlockView m_block_view;
+    // Allocated in the block bitmap, but not part of the inode yet. Protected by m_inode_lock.
+    Ext2FS::BlockRun m_preallocated_blocks;
     HashMap<NonnullOwnPtr<KString>, InodeIndex> m_lookup_cache;
     ext2_inode_large m_raw_inode {};
 };
@@ -22,6 +22,16 @@ ErrorOr<NonnullRefPtr<FIFO>> FIFO::try_create(UserID uid)
     return adopt_nonnull_ref_or_enomem(new (nothrow) FIFO(uid, move(buffer)));
 }
 
+ErrorOr<size_t> FIFO::set_buffer_capacity(size_t capacity)
+{
+    if (capacity > DoubleBuffer::max_capacity)
+        return EPERM;
+    // Like on other systems, asking for less than a page gets a page.
+    TRY(m_buffer->try_resize(max(capacity, PAGE_SIZE)));
+    evaluate_block_conditions();
+    return m_buffer->capacity();
+}
+
 ErrorOr<NonnullRefPtr<OpenFileDescription>> FIFO::open_direction(FIFO::Direction direction)
 {
     auto description = TRY(OpenFileDescription::try_create(*this));
@@ -32,6 +32,9 @@ public:
     ErrorOr<NonnullRefPtr<OpenFileDescription>> open_direction(Direction);
     ErrorOr<NonnullRefPtr<OpenFileDescription>> open_direction_blocking(Direction);
 
+    size_t buffer_capacity() const { return m_buffer->capacity(); }
+    ErrorOr<size_t> set_buffer_capacity(size_t);
+
 private:
     // ^File
     virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override;
@@ -68,6 +68,12 @@ struct fuse_attr {
 #define FATTR_CTIME (1 << 10)
 #define FATTR_KILL_SUIDGID (1 << 11)
 
+// Bitmasks for fuse_init_in.flags and fuse_init_out.flags
+#define FUSE_ASYNC_READ (1 << 0)
+#define FUSE_BIG_WRITES (1 << 5)
+#define FUSE_WRITEBACK_CACHE (1 << 16)
+#define FUSE_MAX_PAGES (1 << 22)
+
 enum class FUSEOpcode {
     FUSE_LOOKUP = 1,
     FUSE_FORGET = 2, // no reply
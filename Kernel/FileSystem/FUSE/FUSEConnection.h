@@ -7,9 +7,11 @@
 #pragma once
 
 #include <AK/Atomic.h>
+#include <Kernel/Devices/FUSEDevice.h>
 #include <Kernel/FileSystem/FUSE/Definitions.h>
 #include <Kernel/FileSystem/OpenFileDescription.h>
 #include <Kernel/Library/KBuffer.h>
+#include <Kernel/Locking/Mutex.h>
 #include <Kernel/Tasks/Process.h>
 
 namespace Kernel {
@@ -58,10 +60,7 @@ public:
     {
         auto* device = bit_cast<FUSEDevice*>(m_description->device());
 
-        // FIXME: Send the init request from the filesystem itself right after it has been
-        // mounted. (Without blocking the mount syscall.)
-        if (!m_initialized)
-            TRY(handle_init());
+        TRY(ensure_initialized());
 
         u64 unique = m_unique++;
         auto request = TRY(create_request(opcode, nodeid, unique, request_body));
@@ -92,6 +91,23 @@ public:
         return response.release_nonnull();
     }
 
+    ErrorOr<void> ensure_initialized()
+    {
+        // FIXME: Send the init request from the filesystem itself right after it has been
+        // mounted. (Without blocking the mount syscall.)
+        if (m_initialized)
+            return {};
+        MutexLocker locker(m_init_lock);
+        if (!m_initialized)
+            TRY(handle_init());
+        return {};
+    }
+
+    // The largest amount of data a single FUSE_WRITE may carry. Only valid once the connection is initialized.
+    size_t max_write() const { return m_max_write; }
+    // Whether the kernel caches writes and owns the file sizes and modification times (FUSE_WRITEBACK_CACHE).
+    bool has_writeback_cache() const { return m_flags & FUSE_WRITEBACK_CACHE; }
+
     ~FUSEConnection()
     {
         auto* device = bit_cast<FUSEDevice*>(m_description->device());
@@ -132,8 +148,8 @@ private:
         fuse_init_in init_request;
         init_request.major = FUSE_KERNEL_VERSION;
         init_request.minor = FUSE_KERNEL_MINOR_VERSION;
-        init_request.max_readahead = 512;
-        init_request.flags = 0;
+        init_request.max_readahead = max_readahead;
+        init_request.flags = FUSE_ASYNC_READ | FUSE_BIG_WRITES | FUSE_WRITEBACK_CACHE | FUSE_MAX_PAGES;
 
         auto* device = bit_cast<FUSEDevice*>(m_description->device());
 
@@ -143,22 +159,37 @@ private:
         if (validate_response(*response, 0).is_error())
             return Error::from_errno(EIO);
 
+        if (response->size() < sizeof(fuse_out_header) + sizeof(fuse_init_out))
+            return Error::from_errno(EIO);
+
         fuse_init_out* init = bit_cast<fuse_init_out*>(response->data() + sizeof(fuse_out_header));
 
         m_major = init->major;
         m_minor = init->minor;
+        m_flags = init->flags & init_request.flags;
+        // Daemons that don't do big writes only take a page at a time.
+        if (!(m_flags & FUSE_BIG_WRITES))
+            m_max_write = PAGE_SIZE;
+        else
+            m_max_write = clamp<size_t>(init->max_write, PAGE_SIZE, max_write_payload_size);
 
         m_initialized = true;
 
         return {};
     }
 
+    static constexpr u32 max_readahead = 128 * KiB;
+    static constexpr size_t max_write_payload_size = FUSEDevice::max_message_size - sizeof(fuse_in_header) - sizeof(fuse_write_in);
+
     NonnullRefPtr<OpenFileDescription> m_description;
-    bool m_initialized { false };
+    Mutex m_init_lock { "FUSEConnection"sv };
+    Atomic<bool> m_initialized { false };
     Atomic<u64> m_unique { 0 };
 
     u32 m_major { 0 };
     u32 m_minor { 0 };
+    u32 m_flags { 0 };
+    size_t m_max_write { PAGE_SIZE };
 };
 
 }
@@ -81,6 +81,13 @@ ErrorOr<void> FUSE::rename(Inode& old_parent_inode, StringView old_basename, Ino
 
     auto response = TRY(m_connection->send_request_and_wait_for_a_reply(FUSEOpcode::FUSE_RENAME, old_parent_inode.identifier().index().value(), payload->bytes()));
 
+    auto& old_parent = static_cast<FUSEInode&>(old_parent_inode);
+    auto& new_parent = static_cast<FUSEInode&>(new_parent_inode);
+    old_parent.invalidate_entry(old_basename);
+    old_parent.invalidate_attributes();
+    new_parent.invalidate_entry(new_basename);
+    new_parent.invalidate_attributes();
+
     fuse_out_header* header = bit_cast<fuse_out_header*>(response->data());
     if (header->error)
         return Error::from_errno(-header->error);
@@ -88,6 +95,58 @@ ErrorOr<void> FUSE::rename(Inode& old_parent_inode, StringView old_basename, Ino
     return {};
 }
 
+ErrorOr<NonnullRefPtr<FUSEInode>> FUSE::get_inode(InodeIndex index)
+{
+    if (index == m_root_inode->index())
+        return *m_root_inode;
+
+    MutexLocker locker(m_inode_cache_lock);
+    if (auto it = m_inode_cache.find(index); it != m_inode_cache.end())
+        return it->value;
+
+    auto inode = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) FUSEInode(*this, index)));
+    TRY(m_inode_cache.try_set(index, inode));
+    return inode;
+}
+
+ErrorOr<NonnullRefPtr<FUSEInode>> FUSE::get_inode(fuse_entry_out const& entry)
+{
+    auto inode = TRY(get_inode(entry.nodeid));
+    inode->cache_attributes(entry.attr, entry.attr_valid, entry.attr_valid_nsec);
+    return inode;
+}
+
+ErrorOr<void> FUSE::flush_writes()
+{
+    Vector<NonnullRefPtr<FUSEInode>> inodes;
+    {
+        MutexLocker locker(m_inode_cache_lock);
+        TRY(inodes.try_ensure_capacity(m_inode_cache.size() + 1));
+        for (auto& it : m_inode_cache)
+            inodes.unchecked_append(it.value);
+    }
+    inodes.unchecked_append(*m_root_inode);
+
+    Optional<Error> error;
+    for (auto& inode : inodes) {
+        if (auto result = inode->flush_writes(); result.is_error() && !error.has_value())
+            error = result.release_error();
+    }
+    inodes.clear();
+
+    // Forget about inodes that only the cache keeps alive.
+    {
+        MutexLocker locker(m_inode_cache_lock);
+        m_inode_cache.remove_all_matching([](InodeIndex, NonnullRefPtr<FUSEInode> const& inode) {
+            return inode->ref_count() == 1 && !inode->has_watchers() && !inode->has_pending_writes();
+        });
+    }
+
+    if (error.has_value())
+        return error.release_value();
+    return {};
+}
+
 u8 FUSE::internal_file_type_to_directory_entry_type(DirectoryEntryView const& entry) const
 {
     return ram_backed_file_type_to_directory_entry_type(entry);
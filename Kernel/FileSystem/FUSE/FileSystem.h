@@ -32,14 +32,24 @@ public:
     virtual Inode& root_inode() override;
 
     virtual ErrorOr<void> rename(Inode& old_parent_inode, StringView old_basename, Inode& new_parent_inode, StringView new_basename) override;
+    virtual ErrorOr<void> flush_writes() override;
 
 private:
+    ErrorOr<NonnullRefPtr<FUSEInode>> get_inode(InodeIndex);
+    // Returns the inode for an entry the daemon told us about, and caches the attributes that came with it.
+    ErrorOr<NonnullRefPtr<FUSEInode>> get_inode(fuse_entry_out const&);
+
     virtual u8 internal_file_type_to_directory_entry_type(DirectoryEntryView const& entry) const override;
 
     FUSE(NonnullRefPtr<FUSEConnection> connection, u64 rootmode, u64 gid, u64 uid);
 
     RefPtr<FUSEInode> m_root_inode;
     NonnullRefPtr<FUSEConnection> m_connection;
+
+    // Inodes stay around (and so do their cached attributes, directory entries and writes), as long as
+    // anyone uses them or they have writes that haven't been sent to the daemon yet.
+    Mutex m_inode_cache_lock { "FUSEInodeCache"sv };
+    HashMap<InodeIndex, NonnullRefPtr<FUSEInode>> m_inode_cache;
     u64 m_rootmode { 0 };
     u64 m_gid { 0 };
     u64 m_uid { 0 };
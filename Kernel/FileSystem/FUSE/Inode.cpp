@@ -7,6 +7,7 @@
 #include <Kernel/FileSystem/FUSE/Definitions.h>
 #include <Kernel/FileSystem/FUSE/Inode.h>
 #include <Kernel/FileSystem/RAMBackedFileType.h>
+#include <Kernel/Time/TimeManagement.h>
 
 namespace Kernel {
 
@@ -22,19 +23,34 @@ FUSEInode::FUSEInode(FUSE& fs)
 
 FUSEInode::~FUSEInode() = default;
 
+// Daemons that want something cached forever hand us absurdly long timeouts, this keeps the deadlines sane.
+static constexpr u64 max_cache_timeout_in_seconds = 24 * 60 * 60;
+
+static MonotonicTime cache_deadline(u64 valid_seconds, u32 valid_nanoseconds)
+{
+    auto timeout = Duration::from_seconds(min(valid_seconds, max_cache_timeout_in_seconds)) + Duration::from_nanoseconds(valid_nanoseconds);
+    return TimeManagement::the().monotonic_time() + timeout;
+}
+
 ErrorOr<size_t> FUSEInode::read_bytes_locked(off_t offset, size_t size, UserOrKernelBuffer& buffer, OpenFileDescription*) const
 {
     VERIFY(m_inode_lock.is_locked());
     VERIFY(!is_directory());
 
-    constexpr size_t max_read_size = 0x21000 - sizeof(fuse_in_header) - sizeof(fuse_read_in);
+    {
+        // The daemon can only hand out what it has seen.
+        MutexLocker locker(m_pending_writes_lock);
+        TRY(flush_pending_writes_locked());
+    }
+
+    constexpr size_t max_read_size = FUSEDevice::max_message_size - sizeof(fuse_in_header) - sizeof(fuse_read_in);
     u64 id = TRY(try_open(false, O_RDONLY));
     u64 nodeid = identifier().index().value();
 
     size_t nread = 0;
     size_t target_size = size;
     while (target_size) {
-        size_t chunk_size = min(size, max_read_size);
+        size_t chunk_size = min(target_size, max_read_size);
         fuse_read_in payload {};
         payload.fh = id;
         payload.offset = offset + nread;
@@ -62,13 +78,11 @@ ErrorOr<size_t> FUSEInode::read_bytes_locked(off_t offset, size_t size, UserOrKe
     return nread;
 }
 
-ErrorOr<size_t> FUSEInode::write_bytes_locked(off_t offset, size_t size, UserOrKernelBuffer const& buffer, OpenFileDescription*)
+ErrorOr<size_t> FUSEInode::write_through_locked(off_t offset, size_t size, UserOrKernelBuffer const& buffer) const
 {
     VERIFY(m_inode_lock.is_locked());
-    VERIFY(!is_directory());
-    VERIFY(offset >= 0);
 
-    constexpr size_t max_write_size = 0x21000 - sizeof(fuse_in_header) - sizeof(fuse_write_in);
+    size_t max_write_size = fs().m_connection->max_write();
     u64 id = TRY(try_open(false, O_WRONLY));
     u64 nodeid = identifier().index().value();
 
@@ -91,6 +105,8 @@ ErrorOr<size_t> FUSEInode::write_bytes_locked(off_t offset, size_t size, UserOrK
             return Error::from_errno(-header->error);
 
         fuse_write_out* write_response = bit_cast<fuse_write_out*>(response->data() + sizeof(fuse_out_header));
+        if (write_response->size == 0 || write_response->size > chunk_size)
+            return Error::from_errno(EIO);
 
         nwritten += write_response->size;
         size -= write_response->size;
@@ -99,46 +115,161 @@ ErrorOr<size_t> FUSEInode::write_bytes_locked(off_t offset, size_t size, UserOrK
     TRY(try_flush(id));
     TRY(try_release(id, false));
 
+    // The size and modification time have most likely changed.
+    invalidate_attributes();
     return nwritten;
 }
 
-InodeMetadata FUSEInode::metadata() const
+ErrorOr<size_t> FUSEInode::write_bytes_locked(off_t offset, size_t size, UserOrKernelBuffer const& buffer, OpenFileDescription*)
 {
-    InodeMetadata metadata;
-    metadata.inode = identifier();
-    u64 id = identifier().index().value();
+    VERIFY(m_inode_lock.is_locked());
+    VERIFY(!is_directory());
+    VERIFY(offset >= 0);
 
-    fuse_getattr_in payload {};
+    TRY(fs().m_connection->ensure_initialized());
+    if (!fs().m_connection->has_writeback_cache())
+        return write_through_locked(offset, size, buffer);
 
-    auto response_or_error = fs().m_connection->send_request_and_wait_for_a_reply(FUSEOpcode::FUSE_GETATTR, id, { &payload, sizeof(payload) });
+    MutexLocker locker(m_pending_writes_lock);
+    size_t max_write_size = fs().m_connection->max_write();
+    if (!m_pending_write_data.is_empty()) {
+        bool continues_pending_writes = static_cast<u64>(offset) == m_pending_write_offset + m_pending_write_data.size();
+        if (!continues_pending_writes || m_pending_write_data.size() + size > max_write_size)
+            TRY(flush_pending_writes_locked());
+    }
 
-    if (response_or_error.is_error())
-        return {};
+    // Writes that fill a FUSE_WRITE on their own don't gain anything from waiting.
+    if (size >= max_write_size)
+        return write_through_locked(offset, size, buffer);
+
+    auto known_size = metadata().size;
+    if (m_pending_write_data.is_empty())
+        m_pending_write_offset = offset;
+    auto pending_size = m_pending_write_data.size();
+    TRY(m_pending_write_data.try_resize(pending_size + size));
+    if (auto result = buffer.read(m_pending_write_data.data() + pending_size, 0, size); result.is_error()) {
+        m_pending_write_data.resize(pending_size);
+        return result.release_error();
+    }
 
-    auto response = response_or_error.release_value();
-    fuse_out_header* header = bit_cast<fuse_out_header*>(response->data());
-    if (header->error || response->size() < sizeof(fuse_out_header) + sizeof(fuse_attr_out))
+    m_cached_attributes.with([&](auto& cache) {
+        cache.size_with_pending_writes = max(static_cast<u64>(known_size), offset + size);
+        cache.mtime_of_pending_writes = kgettimeofday();
+    });
+    return size;
+}
+
+ErrorOr<void> FUSEInode::flush_pending_writes_locked() const
+{
+    VERIFY(m_pending_writes_lock.is_locked());
+    if (m_pending_write_data.is_empty())
         return {};
 
-    fuse_attr_out* getattr_response = bit_cast<fuse_attr_out*>(response->data() + sizeof(fuse_out_header));
+    // NOTE: Whatever happens, these writes are done with. A failure is reported to whoever is flushing them.
+    auto data = move(m_pending_write_data);
+    auto buffer = UserOrKernelBuffer::for_kernel_buffer(data.data());
+    auto result = write_through_locked(m_pending_write_offset, data.size(), buffer);
+    m_cached_attributes.with([](auto& cache) {
+        cache.size_with_pending_writes.clear();
+    });
+    if (result.is_error()) {
+        dmesgln("FUSE: Failed to write back {} bytes at offset {} of inode {}: {}", data.size(), m_pending_write_offset, identifier(), result.error());
+        return result.release_error();
+    }
+    return {};
+}
+
+bool FUSEInode::has_pending_writes() const
+{
+    MutexLocker locker(m_pending_writes_lock);
+    return !m_pending_write_data.is_empty();
+}
 
-    metadata.mode = getattr_response->attr.mode;
-    metadata.size = getattr_response->attr.size;
-    metadata.block_size = getattr_response->attr.blksize;
-    metadata.block_count = getattr_response->attr.blocks;
+ErrorOr<void> FUSEInode::flush_writes()
+{
+    MutexLocker locker(m_inode_lock);
+    MutexLocker pending_writes_locker(m_pending_writes_lock);
+    return flush_pending_writes_locked();
+}
 
-    metadata.uid = getattr_response->attr.uid;
-    metadata.gid = getattr_response->attr.gid;
-    metadata.link_count = getattr_response->attr.nlink;
-    metadata.atime = UnixDateTime::from_seconds_since_epoch(getattr_response->attr.atime);
-    metadata.ctime = UnixDateTime::from_seconds_since_epoch(getattr_response->attr.ctime);
-    metadata.mtime = UnixDateTime::from_seconds_since_epoch(getattr_response->attr.mtime);
-    metadata.major_device = major_from_encoded_device(getattr_response->attr.rdev);
-    metadata.minor_device = minor_from_encoded_device(getattr_response->attr.rdev);
+void FUSEInode::detach(OpenFileDescription&)
+{
+    // Whoever opens the file next might do so through the daemon directly.
+    (void)flush_writes();
+}
 
+static InodeMetadata metadata_from_attributes(InodeIdentifier identifier, fuse_attr const& attr)
+{
+    InodeMetadata metadata;
+    metadata.inode = identifier;
+    metadata.mode = attr.mode;
+    metadata.size = attr.size;
+    metadata.block_size = attr.blksize;
+    metadata.block_count = attr.blocks;
+
+    metadata.uid = attr.uid;
+    metadata.gid = attr.gid;
+    metadata.link_count = attr.nlink;
+    metadata.atime = UnixDateTime::from_seconds_since_epoch(attr.atime);
+    metadata.ctime = UnixDateTime::from_seconds_since_epoch(attr.ctime);
+    metadata.mtime = UnixDateTime::from_seconds_since_epoch(attr.mtime);
+    metadata.major_device = major_from_encoded_device(attr.rdev);
+    metadata.minor_device = minor_from_encoded_device(attr.rdev);
     return metadata;
 }
 
+void FUSEInode::cache_attributes(fuse_attr const& attr, u64 valid_seconds, u32 valid_nanoseconds) const
+{
+    auto metadata = metadata_from_attributes(identifier(), attr);
+    auto valid_until = cache_deadline(valid_seconds, valid_nanoseconds);
+    m_cached_attributes.with([&](auto& cache) {
+        cache.metadata = metadata;
+        cache.valid_until = valid_until;
+    });
+}
+
+void FUSEInode::invalidate_attributes() const
+{
+    m_cached_attributes.with([](auto& cache) { cache.valid_until.clear(); });
+}
+
+InodeMetadata FUSEInode::metadata() const
+{
+    auto now = TimeManagement::the().monotonic_time();
+    auto is_cached = m_cached_attributes.with([&](auto& cache) {
+        return cache.valid_until.has_value() && now < cache.valid_until.value();
+    });
+
+    if (!is_cached) {
+        fuse_getattr_in payload {};
+        auto response_or_error = fs().m_connection->send_request_and_wait_for_a_reply(FUSEOpcode::FUSE_GETATTR, identifier().index().value(), { &payload, sizeof(payload) });
+        if (response_or_error.is_error())
+            return {};
+
+        auto response = response_or_error.release_value();
+        fuse_out_header* header = bit_cast<fuse_out_header*>(response->data());
+        if (header->error || response->size() < sizeof(fuse_out_header) + sizeof(fuse_attr_out))
+            return {};
+
+        fuse_attr_out* getattr_response = bit_cast<fuse_attr_out*>(response->data() + sizeof(fuse_out_header));
+        // NOTE: Even with a timeout of zero, this is fresh enough to hand out right now.
+        auto metadata = metadata_from_attributes(identifier(), getattr_response->attr);
+        m_cached_attributes.with([&](auto& cache) {
+            cache.metadata = metadata;
+            cache.valid_until = cache_deadline(getattr_response->attr_valid, getattr_response->attr_valid_nsec);
+        });
+    }
+
+    return m_cached_attributes.with([](auto& cache) {
+        auto metadata = cache.metadata;
+        if (cache.size_with_pending_writes.has_value()) {
+            metadata.size = max(static_cast<u64>(metadata.size), cache.size_with_pending_writes.value());
+            metadata.mtime = cache.mtime_of_pending_writes;
+        }
+        return metadata;
+    });
+}
+
 ErrorOr<u64> FUSEInode::try_open(bool directory, u32 flags) const
 {
     u64 id = identifier().index().value();
@@ -226,8 +357,37 @@ ErrorOr<void> FUSEInode::traverse_as_directory(Function<ErrorOr<void>(FileSystem
     return {};
 }
 
+ErrorOr<void> FUSEInode::cache_entry(StringView name, fuse_entry_out const& entry)
+{
+    auto cache_entry_name = TRY(KString::try_create(name));
+    auto valid_until = cache_deadline(entry.entry_valid, entry.entry_valid_nsec);
+    return m_entry_cache.with([&](auto& cache) -> ErrorOr<void> {
+        TRY(cache.try_set(move(cache_entry_name), { entry.nodeid, valid_until }));
+        return {};
+    });
+}
+
+void FUSEInode::invalidate_entry(StringView name)
+{
+    m_entry_cache.with([&](auto& cache) { cache.remove(name); });
+}
+
 ErrorOr<NonnullRefPtr<Inode>> FUSEInode::lookup(StringView name)
 {
+    auto now = TimeManagement::the().monotonic_time();
+    auto cached_nodeid = m_entry_cache.with([&](auto& cache) -> Optional<InodeIndex> {
+        auto it = cache.find(name);
+        if (it == cache.end())
+            return {};
+        if (now >= it->value.valid_until) {
+            cache.remove(it);
+            return {};
+        }
+        return it->value.nodeid;
+    });
+    if (cached_nodeid.has_value())
+        return TRY(fs().get_inode(cached_nodeid.value()));
+
     auto name_buffer = TRY(KBuffer::try_create_with_size("FUSE: Lookup name string"sv, name.length() + 1));
     memset(name_buffer->data(), 0, name_buffer->size());
     memcpy(name_buffer->data(), name.characters_without_null_termination(), name.length());
@@ -241,8 +401,9 @@ ErrorOr<NonnullRefPtr<Inode>> FUSEInode::lookup(StringView name)
         return Error::from_errno(-header->error);
 
     fuse_entry_out* entry = bit_cast<fuse_entry_out*>(response->data() + sizeof(fuse_out_header));
-
-    return TRY(adopt_nonnull_ref_or_enomem(new (nothrow) FUSEInode(fs(), entry->nodeid)));
+    auto inode = TRY(fs().get_inode(*entry));
+    TRY(cache_entry(name, *entry));
+    return inode;
 }
 
 ErrorOr<void> FUSEInode::flush_metadata()
@@ -300,8 +461,11 @@ ErrorOr<NonnullRefPtr<Inode>> FUSEInode::create_child(StringView name, mode_t mo
     }
 
     fuse_entry_out* entry = bit_cast<fuse_entry_out*>(response->data() + sizeof(fuse_out_header));
-
-    return TRY(adopt_nonnull_ref_or_enomem(new (nothrow) FUSEInode(fs(), entry->nodeid)));
+    auto inode = TRY(fs().get_inode(*entry));
+    TRY(cache_entry(name, *entry));
+    // Our own attributes (sizes, link counts and modification times) have changed along with the new entry.
+    invalidate_attributes();
+    return inode;
 }
 
 ErrorOr<void> FUSEInode::remove_child(StringView name)
@@ -320,6 +484,10 @@ ErrorOr<void> FUSEInode::remove_child(StringView name)
     else
         response = TRY(fs().m_connection->send_request_and_wait_for_a_reply(FUSEOpcode::FUSE_UNLINK, identifier().index().value(), name_buffer->bytes()));
 
+    invalidate_entry(name);
+    invalidate_attributes();
+    static_cast<FUSEInode&>(*inode).invalidate_attributes();
+
     fuse_out_header* header = bit_cast<fuse_out_header*>(response->data());
     if (header->error)
         return Error::from_errno(-header->error);
@@ -327,6 +495,26 @@ ErrorOr<void> FUSEInode::remove_child(StringView name)
     return {};
 }
 
+ErrorOr<void> FUSEInode::try_setattr(fuse_setattr_in& setattr)
+{
+    auto response = TRY(fs().m_connection->send_request_and_wait_for_a_reply(FUSEOpcode::FUSE_SETATTR, identifier().index().value(), { &setattr, sizeof(setattr) }));
+
+    fuse_out_header* header = bit_cast<fuse_out_header*>(response->data());
+    if (header->error) {
+        invalidate_attributes();
+        return Error::from_errno(-header->error);
+    }
+
+    // NOTE: The daemon answers with the attributes it ended up with, so there is no need to ask for them again.
+    if (response->size() >= sizeof(fuse_out_header) + sizeof(fuse_attr_out)) {
+        fuse_attr_out* attr_response = bit_cast<fuse_attr_out*>(response->data() + sizeof(fuse_out_header));
+        cache_attributes(attr_response->attr, attr_response->attr_valid, attr_response->attr_valid_nsec);
+    } else {
+        invalidate_attributes();
+    }
+    return {};
+}
+
 ErrorOr<void> FUSEInode::chmod(mode_t mode)
 {
     MutexLocker locker(m_inode_lock);
@@ -337,12 +525,10 @@ ErrorOr<void> FUSEInode::chmod(mode_t mode)
     setattr.valid = FATTR_MODE;
     setattr.mode = mode;
 
-    auto response = TRY(fs().m_connection->send_request_and_wait_for_a_reply(FUSEOpcode::FUSE_SETATTR, identifier().index().value(), { &setattr, sizeof(setattr) }));
-
-    fuse_out_header* header = bit_cast<fuse_out_header*>(response->data());
-    if (header->error)
-        return Error::from_errno(-header->error);
-
+    if (auto result = try_setattr(setattr); result.is_error()) {
+        (void)try_release(id, is_directory());
+        return result.release_error();
+    }
     return try_release(id, is_directory());
 }
 
@@ -357,12 +543,10 @@ ErrorOr<void> FUSEInode::chown(UserID uid, GroupID gid)
     setattr.uid = static_cast<u32>(uid.value());
     setattr.gid = static_cast<u32>(gid.value());
 
-    auto response = TRY(fs().m_connection->send_request_and_wait_for_a_reply(FUSEOpcode::FUSE_SETATTR, identifier().index().value(), { &setattr, sizeof(setattr) }));
-
-    fuse_out_header* header = bit_cast<fuse_out_header*>(response->data());
-    if (header->error)
-        return Error::from_errno(-header->error);
-
+    if (auto result = try_setattr(setattr); result.is_error()) {
+        (void)try_release(id, is_directory());
+        return result.release_error();
+    }
     return try_release(id, is_directory());
 }
 
@@ -370,6 +554,12 @@ ErrorOr<void> FUSEInode::truncate_locked(u64 new_size)
 {
     VERIFY(m_inode_lock.is_locked());
     VERIFY(!is_directory());
+
+    {
+        MutexLocker locker(m_pending_writes_lock);
+        TRY(flush_pending_writes_locked());
+    }
+
     u64 id = TRY(try_open(is_directory(), 0));
 
     fuse_setattr_in setattr {};
@@ -377,12 +567,10 @@ ErrorOr<void> FUSEInode::truncate_locked(u64 new_size)
     setattr.valid = FATTR_SIZE;
     setattr.size = new_size;
 
-    auto response = TRY(fs().m_connection->send_request_and_wait_for_a_reply(FUSEOpcode::FUSE_SETATTR, identifier().index().value(), { &setattr, sizeof(setattr) }));
-
-    fuse_out_header* header = bit_cast<fuse_out_header*>(response->data());
-    if (header->error)
-        return Error::from_errno(-header->error);
-
+    if (auto result = try_setattr(setattr); result.is_error()) {
+        (void)try_release(id, is_directory());
+        return result.release_error();
+    }
     return try_release(id, is_directory());
 }
 
@@ -390,6 +578,12 @@ ErrorOr<void> FUSEInode::update_timestamps(Optional<UnixDateTime> atime, Optiona
 {
     MutexLocker locker(m_inode_lock);
 
+    {
+        // Writing these back later would bump the modification time again.
+        MutexLocker pending_writes_locker(m_pending_writes_lock);
+        TRY(flush_pending_writes_locked());
+    }
+
     u64 id = TRY(try_open(is_directory(), 0));
     fuse_setattr_in setattr {};
     setattr.fh = id;
@@ -407,12 +601,10 @@ ErrorOr<void> FUSEInode::update_timestamps(Optional<UnixDateTime> atime, Optiona
         setattr.mtime = mtime.value().to_timespec().tv_sec;
     }
 
-    auto response = TRY(fs().m_connection->send_request_and_wait_for_a_reply(FUSEOpcode::FUSE_SETATTR, identifier().index().value(), { &setattr, sizeof(setattr) }));
-
-    fuse_out_header* header = bit_cast<fuse_out_header*>(response->data());
-    if (header->error)
-        return Error::from_errno(-header->error);
-
+    if (auto result = try_setattr(setattr); result.is_error()) {
+        (void)try_release(id, is_directory());
+        return result.release_error();
+    }
     return try_release(id, is_directory());
 }
 
@@ -6,9 +6,13 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <Kernel/FileSystem/FUSE/FileSystem.h>
 #include <Kernel/FileSystem/Inode.h>
+#include <Kernel/Library/KString.h>
 
 namespace Kernel {
 
@@ -28,9 +32,11 @@ private:
     // ^Inode
     virtual ErrorOr<size_t> read_bytes_locked(off_t, size_t, UserOrKernelBuffer& buffer, OpenFileDescription*) const override;
     virtual InodeMetadata metadata() const override;
+    virtual void detach(OpenFileDescription&) override;
     virtual ErrorOr<void> traverse_as_directory(Function<ErrorOr<void>(FileSystem::DirectoryEntryView const&)>) const override;
     virtual ErrorOr<NonnullRefPtr<Inode>> lookup(StringView name) override;
     virtual ErrorOr<void> flush_metadata() override;
+    virtual ErrorOr<void> flush_writes() override;
     virtual ErrorOr<size_t> write_bytes_locked(off_t, size_t, UserOrKernelBuffer const& buffer, OpenFileDescription*) override;
     virtual ErrorOr<NonnullRefPtr<Inode>> create_child(StringView name, mode_t, dev_t, UserID, GroupID) override;
     virtual ErrorOr<void> add_child(Inode&, StringView name, mode_t) override;
@@ -43,8 +49,40 @@ private:
     ErrorOr<u64> try_open(bool directory, u32 flags) const;
     ErrorOr<void> try_flush(u64 id) const;
     ErrorOr<void> try_release(u64 id, bool directory) const;
+    ErrorOr<void> try_setattr(fuse_setattr_in&);
+
+    // The daemon tells us how long attributes and directory entries stay valid whenever it sends them.
+    void cache_attributes(fuse_attr const&, u64 valid_seconds, u32 valid_nanoseconds) const;
+    void invalidate_attributes() const;
+    ErrorOr<void> cache_entry(StringView name, fuse_entry_out const&);
+    void invalidate_entry(StringView name);
+
+    ErrorOr<size_t> write_through_locked(off_t, size_t, UserOrKernelBuffer const& buffer) const;
+    ErrorOr<void> flush_pending_writes_locked() const;
+    bool has_pending_writes() const;
 
     InodeMetadata m_metadata;
+
+    struct CachedAttributes {
+        InodeMetadata metadata;
+        Optional<MonotonicTime> valid_until;
+        // With the writeback cache, we know better than the daemon until our writes have made it there.
+        Optional<u64> size_with_pending_writes;
+        UnixDateTime mtime_of_pending_writes;
+    };
+    mutable SpinlockProtected<CachedAttributes, LockRank::None> m_cached_attributes {};
+
+    struct CachedEntry {
+        InodeIndex nodeid;
+        MonotonicTime valid_until;
+    };
+    SpinlockProtected<HashMap<NonnullOwnPtr<KString>, CachedEntry>, LockRank::None> m_entry_cache {};
+
+    // Writes that haven't been sent to the daemon yet (only with the writeback cache). They are always
+    // contiguous, and sent as soon as they fill a FUSE_WRITE, or a write doesn't continue where they end.
+    mutable Mutex m_pending_writes_lock { "FUSEInodePendingWrites"sv };
+    mutable u64 m_pending_write_offset { 0 };
+    mutable ByteBuffer m_pending_write_data;
 };
 
 }
@@ -50,4 +50,14 @@ void File::detach(OpenFileDescription&)
 {
     m_attach_count--;
 }
+
+ErrorOr<void> File::check_direct_io_alignment(u64 alignment, u64 offset, UserOrKernelBuffer const& buffer, size_t count)
+{
+    if (alignment == 0)
+        return {};
+    if ((offset % alignment) || (count % alignment) || (reinterpret_cast<FlatPtr>(buffer.user_or_kernel_ptr()) % alignment))
+        return EINVAL;
+    return {};
+}
+
 }
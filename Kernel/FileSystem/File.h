@@ -8,6 +8,7 @@
 
 #include <AK/AtomicRefCounted.h>
 #include <AK/Error.h>
+#include <AK/IntrusiveList.h>
 #include <AK/StringView.h>
 #include <AK/Types.h>
 #include <Kernel/Forward.h>
@@ -21,10 +22,80 @@ namespace Kernel {
 
 class File;
 
+// Hears about every change in the readiness of an open file description, without a thread having to block on it.
+// Both callbacks are made with the lock of the file's blocker set held, so they must not block or take that lock again.
+class FileReadinessListener {
+    friend class FileBlockerSet;
+
+public:
+    virtual ~FileReadinessListener() = default;
+
+    virtual void readiness_may_have_changed() = 0;
+    // The listener has already been removed when this is called.
+    virtual void description_will_be_destroyed() = 0;
+
+protected:
+    explicit FileReadinessListener(OpenFileDescription& description)
+        : m_description(&description)
+    {
+    }
+
+    // Only safe to look at with the lock of the file's blocker set held, it becomes null once the description is gone.
+    OpenFileDescription* listened_description() const { return m_description; }
+
+private:
+    OpenFileDescription* m_description { nullptr };
+    IntrusiveListNode<FileReadinessListener> m_list_node;
+
+public:
+    using List = IntrusiveList<&FileReadinessListener::m_list_node>;
+};
+
 class FileBlockerSet final : public Thread::BlockerSet {
 public:
     FileBlockerSet() { }
 
+    ~FileBlockerSet()
+    {
+        VERIFY(m_listeners.is_empty());
+    }
+
+    void add_listener(FileReadinessListener& listener)
+    {
+        SpinlockLocker lock(m_lock);
+        VERIFY(listener.m_description);
+        m_listeners.append(listener);
+    }
+
+    // Once this returns, the listener won't be called anymore.
+    void remove_listener(FileReadinessListener& listener)
+    {
+        SpinlockLocker lock(m_lock);
+        if (listener.m_list_node.is_in_list())
+            m_listeners.remove(listener);
+    }
+
+    template<typename Callback>
+    decltype(auto) with_listened_description(FileReadinessListener const& listener, Callback callback)
+    {
+        SpinlockLocker lock(m_lock);
+        return callback(listener.m_description);
+    }
+
+    void description_will_be_destroyed(OpenFileDescription& description)
+    {
+        SpinlockLocker lock(m_lock);
+        for (auto it = m_listeners.begin(); it != m_listeners.end();) {
+            auto& listener = *it;
+            ++it;
+            if (listener.m_description != &description)
+                continue;
+            m_listeners.remove(listener);
+            listener.m_description = nullptr;
+            listener.description_will_be_destroyed();
+        }
+    }
+
     virtual bool should_add_blocker(Thread::Blocker& b, void* data) override
     {
         VERIFY(b.blocker_type() == Thread::Blocker::Type::File);
@@ -40,7 +111,12 @@ public:
             auto& blocker = static_cast<Thread::FileBlocker&>(b);
             return blocker.unblock_if_conditions_are_met(false, data);
         });
+        for (auto& listener : m_listeners)
+            listener.readiness_may_have_changed();
     }
+
+private:
+    FileReadinessListener::List m_listeners;
 };
 
 // File is the base class for anything that can be referenced by a OpenFileDescription.
@@ -119,6 +195,8 @@ public:
     virtual bool is_character_device() const { return false; }
     virtual bool is_socket() const { return false; }
     virtual bool is_inode_watcher() const { return false; }
+    virtual bool is_io_ring() const { return false; }
+    virtual bool is_event_poll() const { return false; }
     virtual bool is_mount_file() const { return false; }
     virtual bool is_loop_device() const { return false; }
 
@@ -131,6 +209,10 @@ public:
 protected:
     File();
 
+    // Reads and writes through an O_DIRECT description skip all caches, so the offset, the size and the
+    // buffer have to line up with the blocks underneath them. An alignment of 0 doesn't check anything.
+    static ErrorOr<void> check_direct_io_alignment(u64 alignment, u64 offset, UserOrKernelBuffer const&, size_t count);
+
     void evaluate_block_conditions()
     {
         if (Processor::current_in_irq() != 0) {
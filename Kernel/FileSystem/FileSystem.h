@@ -31,6 +31,9 @@ public:
     virtual StringView class_name() const = 0;
     virtual Inode& root_inode() = 0;
     virtual bool supports_watchers() const { return false; }
+    // Filesystems whose directories only ever change through the VirtualFileSystem can have
+    // their lookups cached in the DentryCache.
+    virtual bool supports_dentry_caching() const { return false; }
 
     virtual ErrorOr<void> rename(Inode& old_parent_inode, StringView old_basename, Inode& new_parent_inode, StringView new_basename) = 0;
 
@@ -76,7 +79,7 @@ protected:
 
     virtual ErrorOr<void> prepare_to_clear_last_mount([[maybe_unused]] Inode& mount_guest_inode) { return {}; }
 
-    mutable Mutex m_lock { "FS"sv };
+    mutable Mutex m_lock { "FS"sv, LockRank::FileSystem };
 
 private:
     FileSystemID m_fsid;
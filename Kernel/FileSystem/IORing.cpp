@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/API/POSIX/poll.h>
+#include <Kernel/FileSystem/IORing.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Memory/MemoryManager.h>
+#include <Kernel/Memory/ScopedAddressSpaceSwitcher.h>
+#include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/WorkQueue.h>
+
+namespace Kernel {
+
+// An operation that has to wait for its file to become ready only keeps a worker busy for this long,
+// after that it goes to the back of the queue to make room for the operations behind it.
+static constexpr Duration readiness_wait_slice = Duration::from_milliseconds(10);
+
+ErrorOr<NonnullRefPtr<IORing>> IORing::try_create(u32 entries)
+{
+    if (entries == 0 || entries > io_ring_max_entries || !is_power_of_two(entries))
+        return EINVAL;
+
+    auto size = TRY(Memory::page_round_up(io_ring_size(entries)));
+    auto vmobject = TRY(Memory::AnonymousVMObject::try_create_with_size(size, AllocationStrategy::AllocateNow));
+    auto region = TRY(MM.allocate_kernel_region_with_vmobject(*vmobject, size, "IORing"sv, Memory::Region::Access::ReadWrite));
+    auto ring = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) IORing(entries, move(vmobject), move(region))));
+
+    auto& header = ring->header();
+    header.submission_entries = entries;
+    header.completion_entries = io_ring_completion_entries(entries);
+    header.submissions_offset = io_ring_submissions_offset();
+    header.completions_offset = io_ring_completions_offset(entries);
+    return ring;
+}
+
+IORing::IORing(u32 entries, NonnullLockRefPtr<Memory::AnonymousVMObject> vmobject, NonnullOwnPtr<Memory::Region> region)
+    : m_entries(entries)
+    , m_vmobject(move(vmobject))
+    , m_region(move(region))
+{
+}
+
+IORing::~IORing() = default;
+
+IORingHeader& IORing::header() const
+{
+    return *reinterpret_cast<IORingHeader*>(m_region->vaddr().as_ptr());
+}
+
+IORingSubmission& IORing::submission_at(u32 index) const
+{
+    auto* submissions = reinterpret_cast<IORingSubmission*>(m_region->vaddr().offset(io_ring_submissions_offset()).as_ptr());
+    return submissions[index & (m_entries - 1)];
+}
+
+IORingCompletion& IORing::completion_at(u32 index) const
+{
+    auto* completions = reinterpret_cast<IORingCompletion*>(m_region->vaddr().offset(io_ring_completions_offset(m_entries)).as_ptr());
+    return completions[index & (io_ring_completion_entries(m_entries) - 1)];
+}
+
+ErrorOr<size_t> IORing::submit(Process& process, u32 count)
+{
+    MutexLocker locker(m_submission_lock);
+
+    // NOTE: Everything userspace can write to is read exactly once, so it can't change under our feet.
+    auto tail = AK::atomic_load(&header().submission_tail, AK::memory_order_acquire);
+    auto available = min(count, min(tail - m_submission_head, m_entries));
+
+    size_t submitted = 0;
+    for (; submitted < available; ++submitted) {
+        bool has_room = m_completion_state.with([&](auto& state) {
+            auto unreaped = state.tail - AK::atomic_load(&header().completion_head, AK::memory_order_relaxed);
+            if (unreaped > io_ring_completion_entries(m_entries) || unreaped + state.in_flight >= io_ring_completion_entries(m_entries))
+                return false;
+            ++state.in_flight;
+            return true;
+        });
+        if (!has_room)
+            break;
+
+        IORingSubmission submission;
+        memcpy(&submission, &submission_at(m_submission_head++), sizeof(submission));
+
+        auto operation_or_error = prepare_operation(process, submission);
+        if (operation_or_error.is_error()) {
+            complete(submission.user_data, -static_cast<i64>(operation_or_error.error().code()));
+            continue;
+        }
+        queue_operation(operation_or_error.release_value());
+    }
+    AK::atomic_store(&header().submission_head, m_submission_head, AK::memory_order_release);
+
+    if (submitted == 0 && available > 0)
+        return EBUSY;
+    return submitted;
+}
+
+ErrorOr<void> IORing::wait_for_completions(u32 count)
+{
+    if (count == 0)
+        return {};
+    return m_completion_wait_queue.wait_until(m_completion_state, [&](auto& state) {
+        auto unreaped = state.tail - AK::atomic_load(&header().completion_head, AK::memory_order_relaxed);
+        // There's no point in waiting if nothing that could complete is in flight.
+        return unreaped >= count || state.in_flight == 0;
+    });
+}
+
+ErrorOr<NonnullOwnPtr<IORing::Operation>> IORing::prepare_operation(Process& process, IORingSubmission const& submission)
+{
+    if (submission.reserved != 0)
+        return EINVAL;
+
+    RefPtr<OpenFileDescription> description;
+    switch (submission.operation) {
+    case IORingOperation::Nop:
+        break;
+    case IORingOperation::Read:
+    case IORingOperation::Write:
+        description = TRY(process.open_file_description(submission.fd));
+        if (submission.operation == IORingOperation::Read && !description->is_readable())
+            return EBADF;
+        if (submission.operation == IORingOperation::Write && !description->is_writable())
+            return EBADF;
+        if (description->is_directory())
+            return EISDIR;
+        if (submission.length > NumericLimits<ssize_t>::max() || submission.offset < -1)
+            return EINVAL;
+        if (submission.offset >= 0 && !description->file().is_seekable())
+            return EINVAL;
+        (void)TRY(UserOrKernelBuffer::for_user_buffer(reinterpret_cast<u8*>(submission.buffer), submission.length));
+        break;
+    case IORingOperation::Fsync:
+        description = TRY(process.open_file_description(submission.fd));
+        break;
+    case IORingOperation::Poll:
+        if (submission.poll_events == 0 || (submission.poll_events & ~(POLLIN | POLLOUT)))
+            return EINVAL;
+        description = TRY(process.open_file_description(submission.fd));
+        break;
+    default:
+        return EINVAL;
+    }
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) Operation { *this, process, move(description), submission });
+}
+
+void IORing::queue_operation(NonnullOwnPtr<Operation> operation)
+{
+    auto user_data = operation->submission.user_data;
+    auto* leaked_operation = operation.leak_ptr();
+    auto result = g_io_ring_work->try_queue([leaked_operation] {
+        run_operation(adopt_own_if_nonnull(leaked_operation).release_nonnull());
+    });
+    if (result.is_error()) {
+        delete leaked_operation;
+        complete(user_data, -ENOMEM);
+    }
+}
+
+bool IORing::is_ready(Operation const& operation)
+{
+    auto const& submission = operation.submission;
+    switch (submission.operation) {
+    case IORingOperation::Read:
+        return !operation.description->is_blocking() || operation.description->can_read();
+    case IORingOperation::Write:
+        return !operation.description->is_blocking() || operation.description->can_write();
+    case IORingOperation::Poll:
+        return ((submission.poll_events & POLLIN) && operation.description->can_read())
+            || ((submission.poll_events & POLLOUT) && operation.description->can_write());
+    default:
+        return true;
+    }
+}
+
+void IORing::run_operation(NonnullOwnPtr<Operation> operation)
+{
+    NonnullRefPtr<IORing> ring = operation->ring;
+    auto user_data = operation->submission.user_data;
+
+    if (!is_ready(*operation)) {
+        if (ring->m_closed) {
+            ring->complete(user_data, -ECANCELED);
+            return;
+        }
+
+        auto& description = *operation->description;
+        bool wants_read = operation->submission.operation == IORingOperation::Read
+            || (operation->submission.operation == IORingOperation::Poll && (operation->submission.poll_events & POLLIN));
+        Thread::BlockTimeout timeout(false, &readiness_wait_slice);
+        auto unblock_flags = Thread::FileBlocker::BlockFlags::None;
+        if (wants_read)
+            (void)Thread::current()->block<Thread::ReadBlocker>(timeout, description, unblock_flags);
+        else
+            (void)Thread::current()->block<Thread::WriteBlocker>(timeout, description, unblock_flags);
+
+        if (!is_ready(*operation)) {
+            ring->queue_operation(move(operation));
+            return;
+        }
+    }
+
+    auto result = perform(*operation);
+    ring->complete(user_data, result.is_error() ? -static_cast<i64>(result.error().code()) : static_cast<i64>(result.value()));
+}
+
+ErrorOr<size_t> IORing::perform(Operation& operation)
+{
+    auto const& submission = operation.submission;
+    if (submission.operation == IORingOperation::Nop)
+        return 0;
+
+    auto& description = *operation.description;
+    switch (submission.operation) {
+    case IORingOperation::Read:
+    case IORingOperation::Write: {
+        // We're running on a worker thread, so the buffer has to be reached through the address space of the submitter.
+        ScopedAddressSpaceSwitcher switcher(*operation.process);
+        auto buffer = TRY(UserOrKernelBuffer::for_user_buffer(reinterpret_cast<u8*>(submission.buffer), submission.length));
+        if (submission.operation == IORingOperation::Read)
+            return submission.offset >= 0 ? description.read(buffer, submission.offset, submission.length) : description.read(buffer, submission.length);
+        if (submission.offset < 0 && description.should_append() && description.file().is_seekable())
+            TRY(description.seek(0, SEEK_END));
+        return submission.offset >= 0 ? description.write(submission.offset, buffer, submission.length) : description.write(buffer, submission.length);
+    }
+    case IORingOperation::Fsync:
+        TRY(description.sync());
+        return 0;
+    case IORingOperation::Poll: {
+        size_t revents = 0;
+        if ((submission.poll_events & POLLIN) && description.can_read())
+            revents |= POLLIN;
+        if ((submission.poll_events & POLLOUT) && description.can_write())
+            revents |= POLLOUT;
+        return revents;
+    }
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void IORing::complete(u64 user_data, i64 result)
+{
+    m_completion_state.with([&](auto& state) {
+        VERIFY(state.in_flight > 0);
+        auto& completion = completion_at(state.tail);
+        completion.user_data = user_data;
+        completion.result = result;
+        ++state.tail;
+        --state.in_flight;
+        AK::atomic_store(&header().completion_tail, state.tail, AK::memory_order_release);
+    });
+    m_completion_wait_queue.notify_all();
+    evaluate_block_conditions();
+}
+
+bool IORing::can_read(OpenFileDescription const&, u64) const
+{
+    return m_completion_state.with([&](auto& state) {
+        return state.tail != AK::atomic_load(&header().completion_head, AK::memory_order_relaxed);
+    });
+}
+
+ErrorOr<File::VMObjectAndMemoryType> IORing::vmobject_and_memory_type_for_mmap(Process&, Memory::VirtualRange const& range, u64& offset, bool shared)
+{
+    // A private copy of the ring would never see what the kernel posts to it.
+    if (!shared || offset != 0 || range.size() > m_vmobject->size())
+        return EINVAL;
+
+    return VMObjectAndMemoryType {
+        .vmobject = m_vmobject,
+        .memory_type = Memory::MemoryType::Normal,
+    };
+}
+
+ErrorOr<void> IORing::close()
+{
+    // Operations that are still waiting for their file give up the next time they look.
+    m_closed = true;
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<KString>> IORing::pseudo_path(OpenFileDescription const&) const
+{
+    return KString::try_create(":io-ring:"sv);
+}
+
+}
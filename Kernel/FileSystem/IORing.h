@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/NonnullOwnPtr.h>
+#include <Kernel/API/IORing.h>
+#include <Kernel/FileSystem/File.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/Locking/SpinlockProtected.h>
+#include <Kernel/Memory/AnonymousVMObject.h>
+#include <Kernel/Tasks/WaitQueue.h>
+
+namespace Kernel {
+
+// The kernel side of an I/O ring (see Kernel/API/IORing.h). The ring memory is mapped into the
+// kernel as well, so operations can post their completions from whichever thread carries them out.
+class IORing final : public File {
+public:
+    static ErrorOr<NonnullRefPtr<IORing>> try_create(u32 entries);
+    virtual ~IORing() override;
+
+    // Takes up to `count` operations from the submission ring and starts them. Operations that can't be
+    // started (e.g. because of a bad file descriptor) complete right away with an error.
+    // Stops early when the completion ring could overflow, and returns the number of operations taken.
+    ErrorOr<size_t> submit(Process&, u32 count);
+
+    // Blocks until at least `count` completions are waiting to be reaped.
+    ErrorOr<void> wait_for_completions(u32 count);
+
+    virtual bool can_read(OpenFileDescription const&, u64) const override;
+    virtual bool can_write(OpenFileDescription const&, u64) const override { return false; }
+    virtual ErrorOr<size_t> read(OpenFileDescription&, u64, UserOrKernelBuffer&, size_t) override { return EINVAL; }
+    virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override { return EINVAL; }
+    virtual ErrorOr<VMObjectAndMemoryType> vmobject_and_memory_type_for_mmap(Process&, Memory::VirtualRange const&, u64& offset, bool shared) override;
+    virtual ErrorOr<void> close() override;
+
+    virtual ErrorOr<NonnullOwnPtr<KString>> pseudo_path(OpenFileDescription const&) const override;
+    virtual StringView class_name() const override { return "IORing"sv; }
+    virtual bool is_io_ring() const override { return true; }
+
+private:
+    IORing(u32 entries, NonnullLockRefPtr<Memory::AnonymousVMObject>, NonnullOwnPtr<Memory::Region>);
+
+    struct Operation {
+        NonnullRefPtr<IORing> ring;
+        NonnullRefPtr<Process> process;
+        RefPtr<OpenFileDescription> description;
+        IORingSubmission submission;
+    };
+
+    IORingHeader& header() const;
+    IORingSubmission& submission_at(u32 index) const;
+    IORingCompletion& completion_at(u32 index) const;
+
+    ErrorOr<NonnullOwnPtr<Operation>> prepare_operation(Process&, IORingSubmission const&);
+    void queue_operation(NonnullOwnPtr<Operation>);
+    static void run_operation(NonnullOwnPtr<Operation>);
+    static bool is_ready(Operation const&);
+    static ErrorOr<size_t> perform(Operation&);
+    void complete(u64 user_data, i64 result);
+
+    u32 const m_entries;
+    NonnullLockRefPtr<Memory::AnonymousVMObject> m_vmobject;
+    NonnullOwnPtr<Memory::Region> m_region;
+
+    // Serializes submitters, m_submission_head is only touched while holding it.
+    Mutex m_submission_lock { "IORing"sv };
+    u32 m_submission_head { 0 };
+
+    struct CompletionState {
+        u32 tail { 0 };
+        // Operations that have been taken from the submission ring but haven't completed yet,
+        // each of them has been promised a slot in the completion ring.
+        u32 in_flight { 0 };
+    };
+    SpinlockProtected<CompletionState, LockRank::None> m_completion_state {};
+    WaitQueue m_completion_wait_queue;
+
+    Atomic<bool> m_closed { false };
+};
+
+}
@@ -34,6 +34,7 @@ public:
 
     virtual ~ISO9660FS() override;
     virtual StringView class_name() const override { return "ISO9660FS"sv; }
+    virtual bool supports_dentry_caching() const override { return true; }
     virtual Inode& root_inode() override;
 
     virtual ErrorOr<void> rename(Inode& old_parent_inode, StringView old_basename, Inode& new_parent_inode, StringView new_basename) override;
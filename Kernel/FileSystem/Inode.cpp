@@ -47,7 +47,7 @@ void Inode::sync_all()
 void Inode::sync()
 {
     (void)flush_metadata();
-    auto result = fs().flush_writes();
+    auto result = flush_writes();
     if (result.is_error()) {
         // TODO: Figure out how to propagate error to a higher function.
     }
@@ -92,9 +92,38 @@ void Inode::will_be_destroyed()
 ErrorOr<void> Inode::truncate(u64 size)
 {
     MutexLocker locker(m_inode_lock);
+    invalidate_executable_load_plan();
     return truncate_locked(size);
 }
 
+ErrorOr<size_t> Inode::copy_range_from(Inode& source, off_t source_offset, off_t offset, size_t length)
+{
+    if (&source.fs() != &fs())
+        return EXDEV;
+    VERIFY(source_offset >= 0 && offset >= 0);
+
+    if (&source == this) {
+        if (source_offset < static_cast<off_t>(offset + length) && offset < static_cast<off_t>(source_offset + length))
+            return EINVAL;
+        MutexLocker locker(m_inode_lock);
+        TRY(prepare_to_write_data());
+        return copy_range_from_locked(source, source_offset, offset, length);
+    }
+
+    // NOTE: The locks are always taken in the same order, so that two copies going in opposite directions can't deadlock.
+    MutexLocker first_locker;
+    MutexLocker second_locker;
+    if (index() < source.index()) {
+        first_locker.attach_and_lock(m_inode_lock);
+        second_locker.attach_and_lock(source.m_inode_lock, Mutex::Mode::Shared);
+    } else {
+        first_locker.attach_and_lock(source.m_inode_lock, Mutex::Mode::Shared);
+        second_locker.attach_and_lock(m_inode_lock);
+    }
+    TRY(prepare_to_write_data());
+    return copy_range_from_locked(source, source_offset, offset, length);
+}
+
 ErrorOr<size_t> Inode::write_bytes(off_t offset, size_t length, UserOrKernelBuffer const& target_buffer, OpenFileDescription* open_description)
 {
     MutexLocker locker(m_inode_lock);
@@ -268,6 +297,7 @@ ErrorOr<void> Inode::prepare_to_write_data()
     VERIFY(m_inode_lock.is_locked());
     if (fs().is_readonly())
         return EROFS;
+    invalidate_executable_load_plan();
     auto metadata = this->metadata();
     if (metadata.is_setuid() || metadata.is_setgid()) {
         dbgln("Inode::prepare_to_write_data(): Stripping SUID/SGID bits from {}", identifier());
@@ -282,6 +312,27 @@ LockRefPtr<Memory::SharedInodeVMObject> Inode::shared_vmobject() const
     return m_shared_vmobject.strong_ref();
 }
 
+Inode::CachedExecutableLoadPlan Inode::executable_load_plan() const
+{
+    return m_executable_load_plan.with([](auto const& cached) { return cached; });
+}
+
+void Inode::set_executable_load_plan(NonnullRefPtr<ExecutableLoadPlan> plan, u64 contents_version)
+{
+    m_executable_load_plan.with([&](auto& cached) {
+        if (cached.contents_version == contents_version)
+            cached.plan = move(plan);
+    });
+}
+
+void Inode::invalidate_executable_load_plan()
+{
+    m_executable_load_plan.with([](auto& cached) {
+        cached.plan = nullptr;
+        ++cached.contents_version;
+    });
+}
+
 template<typename T>
 static inline bool range_overlap(T start1, T len1, T start2, T len2)
 {
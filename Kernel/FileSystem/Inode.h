@@ -21,6 +21,7 @@
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Locking/Mutex.h>
 #include <Kernel/Memory/SharedInodeVMObject.h>
+#include <Kernel/Tasks/ExecutableLoadPlan.h>
 
 namespace Kernel {
 
@@ -55,8 +56,14 @@ public:
 
     ErrorOr<size_t> write_bytes(off_t, size_t, UserOrKernelBuffer const& data, OpenFileDescription*);
     ErrorOr<size_t> read_bytes(off_t, size_t, UserOrKernelBuffer& buffer, OpenFileDescription*) const;
+    // Starts reading the given range into the filesystem's caches in the background, if the filesystem supports it.
+    virtual void read_ahead(u64, size_t) { }
+
     ErrorOr<size_t> read_until_filled_or_end(off_t, size_t, UserOrKernelBuffer buffer, OpenFileDescription*) const;
     ErrorOr<void> truncate(u64);
+    // Copies a range of another inode on the same filesystem into this one, which lets the filesystem share
+    // or skip storage instead of moving every byte through a buffer. Fails with ENOTSUP if it can't do better.
+    ErrorOr<size_t> copy_range_from(Inode& source, off_t source_offset, off_t offset, size_t length);
 
     virtual ErrorOr<void> attach(OpenFileDescription&) { return {}; }
     virtual void detach(OpenFileDescription&) { }
@@ -84,12 +91,24 @@ public:
     virtual ErrorOr<void> decrement_link_count();
 
     virtual ErrorOr<void> flush_metadata() = 0;
+    // Writes back the contents of this inode. Filesystems that can't do that for a single inode write back everything.
+    virtual ErrorOr<void> flush_writes() { return fs().flush_writes(); }
 
     void will_be_destroyed();
 
     ErrorOr<void> set_shared_vmobject(Memory::SharedInodeVMObject&);
     LockRefPtr<Memory::SharedInodeVMObject> shared_vmobject() const;
 
+    // The version changes whenever the contents of the inode may have changed, which drops the cached plan.
+    struct CachedExecutableLoadPlan {
+        RefPtr<ExecutableLoadPlan> plan;
+        u64 contents_version { 0 };
+    };
+    CachedExecutableLoadPlan executable_load_plan() const;
+    // Does nothing if the contents of the inode changed since the given version was returned by executable_load_plan().
+    void set_executable_load_plan(NonnullRefPtr<ExecutableLoadPlan>, u64 contents_version);
+    void invalidate_executable_load_plan();
+
     static void sync_all();
     void sync();
 
@@ -116,13 +135,15 @@ protected:
     void did_modify_contents();
     void did_delete_self();
 
-    mutable Mutex m_inode_lock { "Inode"sv };
+    mutable Mutex m_inode_lock { "Inode"sv, LockRank::FileSystem };
 
     ErrorOr<size_t> prepare_and_write_bytes_locked(off_t, size_t, UserOrKernelBuffer const& data, OpenFileDescription*);
 
     virtual ErrorOr<size_t> write_bytes_locked(off_t, size_t, UserOrKernelBuffer const& data, OpenFileDescription*) = 0;
     virtual ErrorOr<size_t> read_bytes_locked(off_t, size_t, UserOrKernelBuffer& buffer, OpenFileDescription*) const = 0;
     virtual ErrorOr<void> truncate_locked(u64) { return {}; }
+    // Both inodes are locked, this one exclusively. The source may be this inode, but never with overlapping ranges.
+    virtual ErrorOr<size_t> copy_range_from_locked(Inode&, off_t, off_t, size_t) { return ENOTSUP; }
 
 private:
     struct Flock {
@@ -139,6 +160,7 @@ private:
     FileSystem& m_file_system;
     InodeIndex m_index { 0 };
     LockWeakPtr<Memory::SharedInodeVMObject> m_shared_vmobject;
+    SpinlockProtected<CachedExecutableLoadPlan, LockRank::None> m_executable_load_plan {};
     LockWeakPtr<LocalSocket> m_bound_socket;
     SpinlockProtected<HashTable<InodeWatcher*>, LockRank::None> m_watchers {};
     bool m_metadata_dirty { false };
@@ -29,11 +29,18 @@ ErrorOr<size_t> InodeFile::read(OpenFileDescription& description, u64 offset, Us
 {
     if (Checked<off_t>::addition_would_overflow(offset, count))
         return EOVERFLOW;
+    if (description.is_direct())
+        TRY(check_direct_io_alignment(m_inode->fs().logical_block_size(), offset, buffer, count));
 
     auto nread = TRY(m_inode->read_bytes(offset, count, buffer, &description));
     if (nread > 0) {
         Thread::current()->did_file_read(nread);
         evaluate_block_conditions();
+
+        if (!description.is_direct()) {
+            if (auto read_ahead_range = description.track_read_for_read_ahead(offset, nread); read_ahead_range.has_value())
+                m_inode->read_ahead(read_ahead_range->offset, read_ahead_range->size);
+        }
     }
     return nread;
 }
@@ -42,6 +49,8 @@ ErrorOr<size_t> InodeFile::write(OpenFileDescription& description, u64 offset, U
 {
     if (Checked<off_t>::addition_would_overflow(offset, count))
         return EOVERFLOW;
+    if (description.is_direct())
+        TRY(check_direct_io_alignment(m_inode->fs().logical_block_size(), offset, data, count));
 
     size_t nwritten = TRY(m_inode->write_bytes(offset, count, data, &description));
     if (nwritten > 0) {
@@ -6,6 +6,7 @@
  */
 
 #include <AK/MemoryStream.h>
+#include <Kernel/API/DirectoryEntryWithStat.h>
 #include <Kernel/API/POSIX/errno.h>
 #include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/Devices/TTY/MasterPTY.h>
@@ -20,10 +21,13 @@
 #include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Net/Socket.h>
 #include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/Tracepoints.h>
 #include <Kernel/UnixTypes.h>
 
 namespace Kernel {
 
+DEFINE_KMEM_CACHE(OpenFileDescription)
+
 ErrorOr<NonnullRefPtr<OpenFileDescription>> OpenFileDescription::try_create(Custody& custody)
 {
     auto inode_file = TRY(InodeFile::create(custody.inode()));
@@ -53,6 +57,7 @@ OpenFileDescription::OpenFileDescription(File& file)
 
 OpenFileDescription::~OpenFileDescription()
 {
+    blocker_set().description_will_be_destroyed(*this);
     m_file->detach(*this);
     // FIXME: Should this error path be observed somehow?
     (void)m_file->close();
@@ -148,6 +153,7 @@ ErrorOr<off_t> OpenFileDescription::seek(off_t offset, int whence)
 
 ErrorOr<size_t> OpenFileDescription::read(UserOrKernelBuffer& buffer, u64 offset, size_t count)
 {
+    TRACEPOINT(vfs_read, offset, count);
     if (Checked<u64>::addition_would_overflow(offset, count))
         return EOVERFLOW;
     return m_file->read(*this, offset, buffer, count);
@@ -155,6 +161,7 @@ ErrorOr<size_t> OpenFileDescription::read(UserOrKernelBuffer& buffer, u64 offset
 
 ErrorOr<size_t> OpenFileDescription::write(u64 offset, UserOrKernelBuffer const& data, size_t data_size)
 {
+    TRACEPOINT(vfs_write, offset, data_size);
     if (Checked<u64>::addition_would_overflow(offset, data_size))
         return EOVERFLOW;
     return m_file->write(*this, offset, data, data_size);
@@ -167,6 +174,7 @@ ErrorOr<size_t> OpenFileDescription::read(UserOrKernelBuffer& buffer, size_t cou
             return EOVERFLOW;
         return state.current_offset;
     }));
+    TRACEPOINT(vfs_read, offset, count);
     auto nread = TRY(m_file->read(*this, offset, buffer, count));
     if (m_file->is_seekable())
         m_state.with([&](auto& state) { state.current_offset = offset + nread; });
@@ -181,6 +189,7 @@ ErrorOr<size_t> OpenFileDescription::write(UserOrKernelBuffer const& data, size_
             return EOVERFLOW;
         return state.current_offset;
     }));
+    TRACEPOINT(vfs_write, offset, size);
     auto nwritten = TRY(m_file->write(*this, offset, data, size));
 
     if (m_file->is_seekable())
@@ -256,6 +265,60 @@ ErrorOr<size_t> OpenFileDescription::get_dir_entries(UserOrKernelBuffer& output_
     return size - remaining;
 }
 
+ErrorOr<size_t> OpenFileDescription::get_dir_entries_with_stat(VFSRootContext const& vfs_root_context, Credentials const& credentials, UserOrKernelBuffer& output_buffer, size_t size)
+{
+    if (!is_directory())
+        return ENOTDIR;
+    auto custody = this->custody();
+    if (!custody)
+        return ENOTDIR;
+
+    size_t remaining = size;
+    u8 stack_buffer[PAGE_SIZE];
+    Bytes temp_buffer(stack_buffer, sizeof(stack_buffer));
+    size_t buffered_size = 0;
+
+    auto flush_to_output_buffer = [&]() -> ErrorOr<void> {
+        if (buffered_size == 0)
+            return {};
+        if (remaining < buffered_size)
+            return Error::from_errno(EINVAL);
+        TRY(output_buffer.write(temp_buffer.trim(buffered_size)));
+        output_buffer = output_buffer.offset(buffered_size);
+        remaining -= buffered_size;
+        buffered_size = 0;
+        return {};
+    };
+
+    ErrorOr<void> result = VirtualFileSystem::traverse_directory_with_metadata(vfs_root_context, credentials, *custody, [&](StringView name, InodeIdentifier inode, u8 file_type, ErrorOr<InodeMetadata> const& metadata) -> ErrorOr<void> {
+        DirectoryEntryWithStat entry;
+        entry.inode = inode.index().value();
+        entry.file_type = file_type;
+        entry.name_length = name.length();
+        if (metadata.is_error()) {
+            entry.stat_error = metadata.error().code();
+        } else if (auto stat = metadata.value().stat(); stat.is_error()) {
+            entry.stat_error = stat.error().code();
+        } else {
+            entry.stat = stat.release_value();
+        }
+
+        if (entry.total_size() > temp_buffer.size() - buffered_size)
+            TRY(flush_to_output_buffer());
+        memcpy(temp_buffer.offset_pointer(buffered_size), &entry, sizeof(entry));
+        memcpy(temp_buffer.offset_pointer(buffered_size + sizeof(entry)), name.characters_without_null_termination(), name.length());
+        buffered_size += entry.total_size();
+        return {};
+    });
+
+    if (result.is_error())
+        return result.release_error();
+
+    TRY(flush_to_output_buffer());
+
+    return size - remaining;
+}
+
 bool OpenFileDescription::is_device() const
 {
     return m_file->is_device();
@@ -431,6 +494,7 @@ void OpenFileDescription::set_file_flags(u32 flags)
         state.is_blocking = !(flags & O_NONBLOCK);
         state.should_append = flags & O_APPEND;
         state.direct = flags & O_DIRECT;
+        state.high_priority = flags & O_HIPRI;
         state.file_flags = flags;
     });
 }
@@ -498,6 +562,42 @@ bool OpenFileDescription::is_direct() const
     return m_state.with([](auto& state) { return state.direct; });
 }
 
+bool OpenFileDescription::is_high_priority() const
+{
+    return m_state.with([](auto& state) { return state.high_priority; });
+}
+
+Optional<OpenFileDescription::ReadAheadRange> OpenFileDescription::track_read_for_read_ahead(u64 offset, size_t nread)
+{
+    static constexpr size_t initial_read_ahead_window = 32 * KiB;
+    static constexpr size_t max_read_ahead_window = 1 * MiB;
+
+    return m_state.with([&](auto& state) -> Optional<ReadAheadRange> {
+        auto end = offset + nread;
+        bool is_sequential = offset == state.read_ahead_expected_offset;
+        state.read_ahead_expected_offset = end;
+
+        if (!is_sequential) {
+            state.read_ahead_window = 0;
+            state.read_ahead_end = end;
+            return {};
+        }
+
+        // Only read ahead again once the reader has caught up with half of the window,
+        // so the device sees a few large requests instead of lots of small ones.
+        if (state.read_ahead_window != 0 && end + state.read_ahead_window / 2 < state.read_ahead_end)
+            return {};
+
+        state.read_ahead_window = state.read_ahead_window == 0 ? initial_read_ahead_window : min(state.read_ahead_window * 2, max_read_ahead_window);
+        auto read_ahead_start = max(end, state.read_ahead_end);
+        auto read_ahead_end = end + state.read_ahead_window;
+        if (read_ahead_end <= read_ahead_start)
+            return {};
+        state.read_ahead_end = read_ahead_end;
+        return ReadAheadRange { read_ahead_start, static_cast<size_t>(read_ahead_end - read_ahead_start) };
+    });
+}
+
 bool OpenFileDescription::is_directory() const
 {
     return m_state.with([](auto& state) { return state.is_directory; });
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/AtomicRefCounted.h>
+#include <AK/Optional.h>
 #include <AK/Badge.h>
 #include <AK/RefPtr.h>
 #include <Kernel/FileSystem/Custody.h>
@@ -14,6 +15,7 @@
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/FileSystem/InodeMetadata.h>
 #include <Kernel/Forward.h>
+#include <Kernel/Heap/KmemCache.h>
 #include <Kernel/Library/KBuffer.h>
 #include <Kernel/Memory/VirtualAddress.h>
 
@@ -25,6 +27,8 @@ public:
 };
 
 class OpenFileDescription final : public AtomicRefCounted<OpenFileDescription> {
+    KMEM_CACHE_ALLOCATED(OpenFileDescription);
+
 public:
     static ErrorOr<NonnullRefPtr<OpenFileDescription>> try_create(Custody&);
     static ErrorOr<NonnullRefPtr<OpenFileDescription>> try_create(File&);
@@ -57,11 +61,21 @@ public:
     bool can_write() const;
 
     ErrorOr<size_t> get_dir_entries(UserOrKernelBuffer& buffer, size_t);
+    ErrorOr<size_t> get_dir_entries_with_stat(VFSRootContext const&, Credentials const&, UserOrKernelBuffer& buffer, size_t);
 
     ErrorOr<NonnullOwnPtr<KString>> original_absolute_path() const;
     ErrorOr<NonnullOwnPtr<KString>> pseudo_path() const;
 
     bool is_direct() const;
+    bool is_high_priority() const;
+
+    struct ReadAheadRange {
+        u64 offset { 0 };
+        size_t size { 0 };
+    };
+    // Keeps track of whether this description is being read sequentially, and if so, returns the range
+    // that should be read ahead of the reader next, if any.
+    Optional<ReadAheadRange> track_read_for_read_ahead(u64 offset, size_t nread);
 
     bool is_directory() const;
 
@@ -156,7 +170,13 @@ private:
         bool is_directory : 1 { false };
         bool should_append : 1 { false };
         bool direct : 1 { false };
+        bool high_priority : 1 { false };
         FIFO::Direction fifo_direction : 2 { FIFO::Direction::Neither };
+
+        // Where the next read would have to start to be sequential, and how far we have read ahead already.
+        u64 read_ahead_expected_offset { 0 };
+        u64 read_ahead_end { 0 };
+        size_t read_ahead_window { 0 };
     };
 
     SpinlockProtected<State, LockRank::None> m_state {};
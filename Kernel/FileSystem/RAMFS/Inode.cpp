@@ -8,6 +8,7 @@
 #include <Kernel/FileSystem/RAMBackedFileType.h>
 #include <Kernel/FileSystem/RAMFS/FileSystem.h>
 #include <Kernel/FileSystem/RAMFS/Inode.h>
+#include <Kernel/Library/KBuffer.h>
 #include <Kernel/Tasks/Process.h>
 
 namespace Kernel {
@@ -77,6 +78,12 @@ ErrorOr<NonnullOwnPtr<RAMFSInode::DataBlock>> RAMFSInode::DataBlock::create()
     return TRY(adopt_nonnull_own_or_enomem(new (nothrow) DataBlock(move(data_block_buffer_vmobject))));
 }
 
+ErrorOr<NonnullOwnPtr<RAMFSInode::DataBlock>> RAMFSInode::DataBlock::try_clone()
+{
+    auto vmobject_clone = TRY(m_content_buffer_vmobject->try_clone());
+    return TRY(adopt_nonnull_own_or_enomem(new (nothrow) DataBlock(static_ptr_cast<Memory::AnonymousVMObject>(vmobject_clone))));
+}
+
 ErrorOr<void> RAMFSInode::ensure_allocated_blocks(size_t offset, size_t io_size)
 {
     VERIFY(m_inode_lock.is_locked());
@@ -151,6 +158,85 @@ ErrorOr<size_t> RAMFSInode::write_bytes_locked(off_t offset, size_t size, UserOr
     return nwritten;
 }
 
+ErrorOr<size_t> RAMFSInode::copy_range_from_locked(Inode& source_inode, off_t source_offset, off_t offset, size_t length)
+{
+    VERIFY(m_inode_lock.is_locked());
+    auto& source = static_cast<RAMFSInode&>(source_inode);
+    if (!source.m_metadata.is_regular_file() || !m_metadata.is_regular_file())
+        return EINVAL;
+    if (source_offset >= source.m_metadata.size)
+        return 0;
+    length = min<u64>(length, source.m_metadata.size - source_offset);
+
+    auto source_mapping_region = TRY(MM.allocate_kernel_region(DataBlock::block_size, "RAMFSInode Mapping Region"sv, Memory::Region::Access::Read, AllocationStrategy::Reserve));
+    OwnPtr<KBuffer> zeroes;
+
+    size_t ncopied = 0;
+    bool shared_blocks = false;
+    while (ncopied < length) {
+        size_t current_source_offset = source_offset + ncopied;
+        size_t current_offset = offset + ncopied;
+        auto source_block_index = current_source_offset / DataBlock::block_size;
+        auto offset_in_source_block = current_source_offset % DataBlock::block_size;
+        auto chunk_size = min(length - ncopied, DataBlock::block_size - offset_in_source_block);
+        auto* source_block = source_block_index < source.m_blocks.size() ? source.m_blocks[source_block_index].ptr() : nullptr;
+
+        // Whole blocks can simply share their pages (copy-on-write) with the destination. So can the last block of the source,
+        // since everything past its end is zeroes, if the destination doesn't have anything after it either.
+        bool is_whole_block = chunk_size == DataBlock::block_size
+            || (current_source_offset + chunk_size == static_cast<size_t>(source.m_metadata.size) && current_offset + chunk_size >= static_cast<size_t>(m_metadata.size));
+        if (offset_in_source_block == 0 && current_offset % DataBlock::block_size == 0 && is_whole_block) {
+            auto destination_block_index = current_offset / DataBlock::block_size;
+            OwnPtr<DataBlock> new_block;
+            bool can_share = true;
+            if (source_block) {
+                // NOTE: If we can't commit the memory the clone might need later on, we copy the data instead.
+                auto clone_or_error = source_block->try_clone();
+                if (clone_or_error.is_error())
+                    can_share = false;
+                else
+                    new_block = clone_or_error.release_value();
+            }
+            if (can_share) {
+                if (m_blocks.size() <= destination_block_index)
+                    TRY(m_blocks.try_resize(destination_block_index + 1));
+                // A hole in the source becomes a hole in the destination.
+                m_blocks[destination_block_index] = move(new_block);
+                shared_blocks = true;
+                ncopied += chunk_size;
+                continue;
+            }
+        }
+
+        UserOrKernelBuffer data = UserOrKernelBuffer::for_kernel_buffer(nullptr);
+        if (source_block) {
+            NonnullLockRefPtr<Memory::AnonymousVMObject> block_vmobject = source_block->vmobject();
+            source_mapping_region->set_vmobject(block_vmobject);
+            source_mapping_region->remap();
+            data = UserOrKernelBuffer::for_kernel_buffer(source_mapping_region->vaddr().offset(offset_in_source_block).as_ptr());
+        } else {
+            if (!zeroes) {
+                zeroes = TRY(KBuffer::try_create_with_size("RAMFSInode: Zeroes"sv, DataBlock::block_size));
+                memset(zeroes->data(), 0, zeroes->size());
+            }
+            data = zeroes->as_kernel_buffer();
+        }
+        auto nwritten = TRY(write_bytes_locked(current_offset, chunk_size, data, nullptr));
+        ncopied += nwritten;
+        if (nwritten < chunk_size)
+            break;
+    }
+
+    if (shared_blocks) {
+        if (static_cast<off_t>(offset + ncopied) > m_metadata.size) {
+            m_metadata.size = offset + ncopied;
+            set_metadata_dirty(true);
+        }
+        did_modify_contents();
+    }
+    return ncopied;
+}
+
 ErrorOr<size_t> RAMFSInode::do_io_on_content_space(Memory::Region& mapping_region, size_t offset, size_t io_size, UserOrKernelBuffer& buffer, bool write)
 {
     VERIFY(m_inode_lock.is_locked());
@@ -34,6 +34,7 @@ public:
     virtual ErrorOr<void> chmod(mode_t) override;
     virtual ErrorOr<void> chown(UserID, GroupID) override;
     virtual ErrorOr<void> truncate_locked(u64) override;
+    virtual ErrorOr<size_t> copy_range_from_locked(Inode&, off_t source_offset, off_t offset, size_t length) override;
     virtual ErrorOr<void> update_timestamps(Optional<UnixDateTime> atime, Optional<UnixDateTime> ctime, Optional<UnixDateTime> mtime) override;
 
 private:
@@ -70,6 +71,8 @@ private:
         using List = Vector<OwnPtr<DataBlock>>;
 
         static ErrorOr<NonnullOwnPtr<DataBlock>> create();
+        // The clone shares its pages with this block until one of them gets written to.
+        ErrorOr<NonnullOwnPtr<DataBlock>> try_clone();
 
         constexpr static size_t block_size = 128 * KiB;
 
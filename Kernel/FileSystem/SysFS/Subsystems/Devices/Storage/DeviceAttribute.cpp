@@ -19,6 +19,20 @@ StringView StorageDeviceAttributeSysFSComponent::name() const
         return "sector_size"sv;
     case Type::CommandSet:
         return "command_set"sv;
+    case Type::Rotational:
+        return "rotational"sv;
+    case Type::QueueDepth:
+        return "queue_depth"sv;
+    case Type::QueuedRequests:
+        return "queued_requests"sv;
+    case Type::InFlightRequests:
+        return "in_flight_requests"sv;
+    case Type::PeakInFlightRequests:
+        return "peak_in_flight_requests"sv;
+    case Type::StartedRequests:
+        return "started_requests"sv;
+    case Type::MergedRequests:
+        return "merged_requests"sv;
     default:
         VERIFY_NOT_REACHED();
     }
@@ -61,6 +75,27 @@ ErrorOr<NonnullOwnPtr<KBuffer>> StorageDeviceAttributeSysFSComponent::try_to_gen
     case Type::CommandSet:
         value = TRY(KString::formatted("{}", m_device->command_set_to_string_view()));
         break;
+    case Type::Rotational:
+        value = TRY(KString::formatted("{}", m_device->is_rotational() ? 1 : 0));
+        break;
+    case Type::QueueDepth:
+        value = TRY(KString::formatted("{}", m_device->max_outstanding_requests()));
+        break;
+    case Type::QueuedRequests:
+        value = TRY(KString::formatted("{}", m_device->request_queue_statistics().queued_requests));
+        break;
+    case Type::InFlightRequests:
+        value = TRY(KString::formatted("{}", m_device->request_queue_statistics().in_flight_requests));
+        break;
+    case Type::PeakInFlightRequests:
+        value = TRY(KString::formatted("{}", m_device->request_queue_statistics().peak_in_flight_requests));
+        break;
+    case Type::StartedRequests:
+        value = TRY(KString::formatted("{}", m_device->request_queue_statistics().started_requests));
+        break;
+    case Type::MergedRequests:
+        value = TRY(KString::formatted("{}", m_device->request_queue_statistics().merged_requests));
+        break;
     default:
         VERIFY_NOT_REACHED();
     }
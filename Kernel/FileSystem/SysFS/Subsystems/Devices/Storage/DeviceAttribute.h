@@ -18,6 +18,13 @@ public:
         EndLBA,
         SectorSize,
         CommandSet,
+        Rotational,
+        QueueDepth,
+        QueuedRequests,
+        InFlightRequests,
+        PeakInFlightRequests,
+        StartedRequests,
+        MergedRequests,
     };
 
 public:
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Configuration/Tracepoints.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSTracepoint::SysFSTracepoint(SysFSDirectory const& parent_directory, Tracepoint tracepoint)
+    : SysFSSystemBooleanVariable(parent_directory)
+    , m_tracepoint(tracepoint)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSTracepoint> SysFSTracepoint::must_create(SysFSDirectory const& parent_directory, Tracepoint tracepoint)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSTracepoint(parent_directory, tracepoint)).release_nonnull();
+}
+
+bool SysFSTracepoint::value() const
+{
+    return is_tracepoint_enabled(m_tracepoint);
+}
+
+ErrorOr<void> SysFSTracepoint::set_value(bool new_value)
+{
+    set_tracepoint_enabled(m_tracepoint, new_value);
+    return {};
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSTracepointsDirectory> SysFSTracepointsDirectory::must_create(SysFSDirectory const& parent_directory)
+{
+    auto tracepoints_directory = adopt_ref_if_nonnull(new (nothrow) SysFSTracepointsDirectory(parent_directory)).release_nonnull();
+    MUST(tracepoints_directory->m_child_components.with([&](auto& list) -> ErrorOr<void> {
+        for (size_t i = 0; i < tracepoint_count; ++i)
+            list.append(SysFSTracepoint::must_create(*tracepoints_directory, static_cast<Tracepoint>(i)));
+        return {};
+    }));
+    return tracepoints_directory;
+}
+
+UNMAP_AFTER_INIT SysFSTracepointsDirectory::SysFSTracepointsDirectory(SysFSDirectory const& parent_directory)
+    : SysFSDirectory(parent_directory)
+{
+}
+
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/RefPtr.h>
+#include <AK/Types.h>
+#include <Kernel/FileSystem/SysFS/Component.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Configuration/BooleanVariable.h>
+#include <Kernel/Tasks/Tracepoints.h>
+
+namespace Kernel {
+
+class SysFSTracepoint final : public SysFSSystemBooleanVariable {
+public:
+    virtual StringView name() const override { return tracepoint_name(m_tracepoint); }
+    static NonnullRefPtr<SysFSTracepoint> must_create(SysFSDirectory const&, Tracepoint);
+
+private:
+    virtual bool value() const override;
+    virtual ErrorOr<void> set_value(bool new_value) override;
+
+    SysFSTracepoint(SysFSDirectory const&, Tracepoint);
+
+    Tracepoint const m_tracepoint;
+};
+
+class SysFSTracepointsDirectory final : public SysFSDirectory {
+public:
+    static NonnullRefPtr<SysFSTracepointsDirectory> must_create(SysFSDirectory const&);
+    virtual StringView name() const override { return "tracepoints"sv; }
+
+private:
+    explicit SysFSTracepointsDirectory(SysFSDirectory const&);
+};
+
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObjectSerializer.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/KmemCaches.h>
+#include <Kernel/Heap/KmemCache.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSKmemCaches::SysFSKmemCaches(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSKmemCaches> SysFSKmemCaches::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSKmemCaches(parent_directory)).release_nonnull();
+}
+
+ErrorOr<void> SysFSKmemCaches::try_generate(KBufferBuilder& builder)
+{
+    auto array = TRY(JsonArraySerializer<>::try_create(builder));
+    ErrorOr<void> result;
+    KmemCache::for_each([&](KmemCache const& cache) {
+        if (result.is_error())
+            return;
+        result = ([&]() -> ErrorOr<void> {
+            auto statistics = cache.statistics();
+            auto obj = TRY(array.add_object());
+            TRY(obj.add("name"sv, cache.name()));
+            TRY(obj.add("object_size"sv, cache.object_size()));
+            TRY(obj.add("block_size"sv, cache.block_size()));
+            TRY(obj.add("objects_per_block"sv, cache.objects_per_block()));
+            TRY(obj.add("block_count"sv, statistics.block_count));
+            TRY(obj.add("allocated_objects"sv, statistics.allocated_objects));
+            TRY(obj.add("allocation_count"sv, statistics.allocation_count));
+            TRY(obj.add("free_count"sv, statistics.free_count));
+            TRY(obj.finish());
+            return {};
+        })();
+    });
+    TRY(result);
+    TRY(array.finish());
+    return {};
+}
+
+}
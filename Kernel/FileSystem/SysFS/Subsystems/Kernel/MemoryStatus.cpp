@@ -35,8 +35,15 @@ ErrorOr<void> SysFSMemoryStatus::try_generate(KBufferBuilder& builder)
     TRY(json.add("physical_available"sv, system_memory.physical_pages - system_memory.physical_pages_used));
     TRY(json.add("physical_committed"sv, system_memory.physical_pages_committed));
     TRY(json.add("physical_uncommitted"sv, system_memory.physical_pages_uncommitted));
+    TRY(json.add("physical_reclaimed"sv, MM.reclaimed_page_count()));
+    TRY(json.add("memory_pressure"sv, Memory::MemoryManager::memory_pressure_level_name(MM.memory_pressure_level())));
     TRY(json.add("kmalloc_call_count"sv, stats.kmalloc_call_count));
     TRY(json.add("kfree_call_count"sv, stats.kfree_call_count));
+    TRY(json.add("kmalloc_magazine_cached"sv, stats.magazine_cached_bytes));
+    TRY(json.add("kmalloc_magazine_allocation_count"sv, stats.magazine_allocation_count));
+    TRY(json.add("kmalloc_magazine_free_count"sv, stats.magazine_free_count));
+    TRY(json.add("kmalloc_magazine_refill_count"sv, stats.magazine_refill_count));
+    TRY(json.add("kmalloc_magazine_drain_count"sv, stats.magazine_drain_count));
     TRY(json.finish());
     return {};
 }
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObjectSerializer.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/MutexContention.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSMutexContention::SysFSMutexContention(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSMutexContention> SysFSMutexContention::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSMutexContention(parent_directory)).release_nonnull();
+}
+
+static StringView lock_rank_to_string(LockRank rank)
+{
+    switch (rank) {
+    case LockRank::None:
+        return "none"sv;
+    case LockRank::MemoryManager:
+        return "memory_manager"sv;
+    case LockRank::Interrupts:
+        return "interrupts"sv;
+    case LockRank::FileSystem:
+        return "file_system"sv;
+    case LockRank::Thread:
+        return "thread"sv;
+    case LockRank::Process:
+        return "process"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ErrorOr<void> SysFSMutexContention::try_generate(KBufferBuilder& builder)
+{
+    auto array = TRY(JsonArraySerializer<>::try_create(builder));
+    for (size_t bucket = 0; bucket < Mutex::contention_statistics_bucket_count; ++bucket) {
+        auto rank = Mutex::lock_rank_for_contention_statistics_bucket(bucket);
+        auto& statistics = Mutex::contention_statistics_for(rank);
+        auto obj = TRY(array.add_object());
+        TRY(obj.add("rank"sv, lock_rank_to_string(rank)));
+        TRY(obj.add("contended"sv, statistics.contended.load()));
+        TRY(obj.add("acquired_by_spinning"sv, statistics.acquired_by_spinning.load()));
+        TRY(obj.add("blocked"sv, statistics.blocked.load()));
+        TRY(obj.finish());
+    }
+    TRY(array.finish());
+    return {};
+}
+
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/API/ProcessStatistics.h>
+#include <Kernel/Devices/TTY/TTY.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/ProcessStatistics.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/Scheduler.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSProcessStatistics::SysFSProcessStatistics(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSProcessStatistics> SysFSProcessStatistics::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSProcessStatistics(parent_directory)).release_nonnull();
+}
+
+template<size_t N>
+static void copy_to_fixed_string(char (&destination)[N], StringView string)
+{
+    auto length = min(string.length(), N - 1);
+    __builtin_memcpy(destination, string.characters_without_null_termination(), length);
+    destination[length] = '\0';
+}
+
+static ErrorOr<void> append_padding(KBufferBuilder& builder, size_t size)
+{
+    static constexpr Array<u8, PROCESS_STATISTICS_RECORD_ALIGNMENT> zeroes {};
+    auto padding = align_up_to(size, PROCESS_STATISTICS_RECORD_ALIGNMENT) - size;
+    return builder.append_bytes(zeroes.span().trim(padding));
+}
+
+static ErrorOr<void> build_process(KBufferBuilder& builder, Process const& process)
+{
+    ProcessStatisticsRecord record {};
+
+    StringBuilder pledge_builder;
+    if (process.is_user_process()) {
+#define __ENUMERATE_PLEDGE_PROMISE(promise)    \
+    if (process.has_promised(Pledge::promise)) \
+        TRY(pledge_builder.try_append(#promise " "sv));
+        ENUMERATE_PLEDGE_PROMISES
+#undef __ENUMERATE_PLEDGE_PROMISE
+
+        switch (process.veil_state()) {
+        case VeilState::None:
+            record.veil = ProcessStatisticsVeilState::None;
+            break;
+        case VeilState::Dropped:
+            record.veil = ProcessStatisticsVeilState::Dropped;
+            break;
+        case VeilState::Locked:
+        case VeilState::LockedInherited:
+            // Note: We don't reveal if the locked state is either by our choice
+            // or someone else applied it.
+            record.veil = ProcessStatisticsVeilState::Locked;
+            break;
+        }
+    }
+
+    record.pid = process.pid().value();
+    if (auto tty = process.tty()) {
+        record.pgid = tty->pgid().value();
+        auto tty_pseudo_name = TRY(tty->pseudo_name());
+        copy_to_fixed_string(record.tty, tty_pseudo_name->view());
+    }
+    record.pgp = process.pgid().value();
+    record.sid = process.sid().value();
+    auto credentials = process.credentials();
+    record.uid = credentials->uid().value();
+    record.gid = credentials->gid().value();
+    record.ppid = process.ppid().value();
+    record.kernel = process.is_kernel_process();
+    record.dumpable = process.is_dumpable();
+    record.creation_time_ns = process.creation_time().nanoseconds_since_epoch();
+    process.name().with([&](auto& process_name) { copy_to_fixed_string(record.name, process_name.representable_view()); });
+
+    OwnPtr<KString> executable_path;
+    if (process.executable())
+        executable_path = TRY(process.executable()->try_serialize_absolute_path());
+    auto executable = executable_path ? executable_path->view() : ""sv;
+    auto pledge = pledge_builder.string_view();
+    record.executable_length = min(executable.length(), NumericLimits<u16>::max());
+    record.pledge_length = min(pledge.length(), NumericLimits<u16>::max());
+
+    TRY(process.address_space().with([&](auto& space) -> ErrorOr<void> {
+        record.amount_virtual = space->amount_virtual();
+        record.amount_resident = space->amount_resident();
+        record.amount_dirty_private = space->amount_dirty_private();
+        record.amount_clean_inode = TRY(space->amount_clean_inode());
+        record.amount_shared = space->amount_shared();
+        record.amount_purgeable_volatile = space->amount_purgeable_volatile();
+        record.amount_purgeable_nonvolatile = space->amount_purgeable_nonvolatile();
+        return {};
+    }));
+
+    // The counters are only ever written by their own thread (or the scheduler on its behalf), so they can be read
+    // without the thread lock. Only the state, which looks at the blocker, needs it.
+    Vector<ThreadStatisticsRecord> threads;
+    TRY(process.try_for_each_thread([&](Thread const& thread) -> ErrorOr<void> {
+        ThreadStatisticsRecord thread_record {};
+        thread_record.tid = thread.tid().value();
+        thread_record.cpu = thread.cpu();
+        thread_record.priority = thread.priority();
+        thread_record.times_scheduled = thread.times_scheduled();
+        thread_record.migration_count = thread.migration_count();
+        thread_record.syscall_count = thread.syscall_count();
+        thread_record.inode_faults = thread.inode_faults();
+        thread_record.zero_faults = thread.zero_faults();
+        thread_record.cow_faults = thread.cow_faults();
+        thread_record.time_user = thread.time_in_user();
+        thread_record.time_kernel = thread.time_in_kernel();
+        thread_record.scheduling_latency_count = thread.scheduling_latency_count();
+        thread_record.scheduling_latency_total_ns = thread.scheduling_latency_total_ns();
+        thread_record.scheduling_latency_max_ns = thread.scheduling_latency_max_ns();
+        thread_record.file_read_bytes = thread.file_read_bytes();
+        thread_record.file_write_bytes = thread.file_write_bytes();
+        thread_record.unix_socket_read_bytes = thread.unix_socket_read_bytes();
+        thread_record.unix_socket_write_bytes = thread.unix_socket_write_bytes();
+        thread_record.ipv4_socket_read_bytes = thread.ipv4_socket_read_bytes();
+        thread_record.ipv4_socket_write_bytes = thread.ipv4_socket_write_bytes();
+        thread.name().with([&](auto& thread_name) { copy_to_fixed_string(thread_record.name, thread_name.representable_view()); });
+        {
+            SpinlockLocker locker(thread.get_lock());
+            copy_to_fixed_string(thread_record.state, thread.state_string());
+        }
+        TRY(threads.try_append(thread_record));
+        return {};
+    }));
+
+    auto strings_size = static_cast<size_t>(record.executable_length) + record.pledge_length;
+    record.thread_count = threads.size();
+    record.size = sizeof(record) + align_up_to(strings_size, PROCESS_STATISTICS_RECORD_ALIGNMENT) + threads.size() * sizeof(ThreadStatisticsRecord);
+
+    TRY(builder.append_bytes({ reinterpret_cast<u8 const*>(&record), sizeof(record) }));
+    TRY(builder.append_bytes(executable.bytes().trim(record.executable_length)));
+    TRY(builder.append_bytes(pledge.bytes().trim(record.pledge_length)));
+    TRY(append_padding(builder, strings_size));
+    return builder.append_bytes({ reinterpret_cast<u8 const*>(threads.data()), threads.size() * sizeof(ThreadStatisticsRecord) });
+}
+
+ErrorOr<void> SysFSProcessStatistics::try_generate(KBufferBuilder& builder)
+{
+    ProcessStatisticsHeader header {};
+    __builtin_memcpy(header.magic, PROCESS_STATISTICS_MAGIC, sizeof(header.magic));
+    header.version = PROCESS_STATISTICS_VERSION;
+    auto total_time_scheduled = Scheduler::get_total_time_scheduled();
+    header.total_time = total_time_scheduled.total;
+    header.total_time_kernel = total_time_scheduled.total_kernel;
+    TRY(builder.append_bytes({ reinterpret_cast<u8 const*>(&header), sizeof(header) }));
+
+    if (!Process::current().is_jailed())
+        TRY(build_process(builder, *Scheduler::colonel()));
+    return Process::for_each_in_same_process_list([&](Process& process) -> ErrorOr<void> {
+        return build_process(builder, process);
+    });
+}
+
+}
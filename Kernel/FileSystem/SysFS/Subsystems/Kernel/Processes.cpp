@@ -127,6 +127,10 @@ ErrorOr<void> SysFSOverallProcesses::try_generate(KBufferBuilder& builder)
             TRY(thread_object.add("time_kernel"sv, thread.time_in_kernel()));
             TRY(thread_object.add("state"sv, thread.state_string()));
             TRY(thread_object.add("cpu"sv, thread.cpu()));
+            TRY(thread_object.add("migration_count"sv, thread.migration_count()));
+            TRY(thread_object.add("scheduling_latency_count"sv, thread.scheduling_latency_count()));
+            TRY(thread_object.add("scheduling_latency_total_ns"sv, thread.scheduling_latency_total_ns()));
+            TRY(thread_object.add("scheduling_latency_max_ns"sv, thread.scheduling_latency_max_ns()));
             TRY(thread_object.add("priority"sv, thread.priority()));
             TRY(thread_object.add("syscall_count"sv, thread.syscall_count()));
             TRY(thread_object.add("inode_faults"sv, thread.inode_faults()));
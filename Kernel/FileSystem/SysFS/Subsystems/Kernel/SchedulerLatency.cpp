@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObjectSerializer.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/SchedulerLatency.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/Scheduler.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSSchedulerLatency::SysFSSchedulerLatency(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSSchedulerLatency> SysFSSchedulerLatency::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSSchedulerLatency(parent_directory)).release_nonnull();
+}
+
+ErrorOr<void> SysFSSchedulerLatency::try_generate(KBufferBuilder& builder)
+{
+    auto array = TRY(JsonArraySerializer<>::try_create(builder));
+    for (u32 cpu = 0; cpu < Processor::count(); ++cpu) {
+        auto& histogram = Scheduler::scheduling_latency_histogram(cpu);
+        auto obj = TRY(array.add_object());
+        TRY(obj.add("processor"sv, cpu));
+        TRY(obj.add("total_ns"sv, histogram.total_ns.load()));
+        TRY(obj.add("max_ns"sv, histogram.max_ns.load()));
+        auto buckets = TRY(obj.add_array("buckets"sv));
+        for (size_t bucket = 0; bucket < SchedulingLatencyHistogram::bucket_count; ++bucket) {
+            auto bucket_object = TRY(buckets.add_object());
+            // An upper bound of 0 marks the last bucket, which has none.
+            TRY(bucket_object.add("upper_bound_us"sv, SchedulingLatencyHistogram::bucket_upper_bound_us(bucket)));
+            TRY(bucket_object.add("count"sv, histogram.buckets[bucket].load()));
+            TRY(bucket_object.finish());
+        }
+        TRY(buckets.finish());
+        TRY(obj.finish());
+    }
+    TRY(array.finish());
+    return {};
+}
+
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObjectSerializer.h>
+#include <Kernel/API/Syscall.h>
+#include <Kernel/API/SyscallString.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/SyscallStatistics.h>
+#include <Kernel/Sections.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSSyscallStatistics::SysFSSyscallStatistics(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSSyscallStatistics> SysFSSyscallStatistics::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSSyscallStatistics(parent_directory)).release_nonnull();
+}
+
+ErrorOr<void> SysFSSyscallStatistics::try_generate(KBufferBuilder& builder)
+{
+    auto array = TRY(JsonArraySerializer<>::try_create(builder));
+    for (size_t i = 0; i < Syscall::Function::__Count; ++i) {
+        auto function = static_cast<Syscall::Function>(i);
+        auto obj = TRY(array.add_object());
+        TRY(obj.add("name"sv, Syscall::to_string(function)));
+        u64 total_call_count = 0;
+        auto per_cpu_call_counts = TRY(obj.add_array("per_cpu_call_counts"sv));
+        for (u32 cpu = 0; cpu < Processor::count(); ++cpu) {
+            auto call_count = Syscall::call_count(cpu, function);
+            total_call_count += call_count;
+            TRY(per_cpu_call_counts.add(call_count));
+        }
+        TRY(per_cpu_call_counts.finish());
+        TRY(obj.add("call_count"sv, total_call_count));
+        TRY(obj.finish());
+    }
+    TRY(array.finish());
+    return {};
+}
+
+}
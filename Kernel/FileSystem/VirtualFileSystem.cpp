@@ -8,6 +8,7 @@
 #include <AK/AnyOf.h>
 #include <AK/GenericLexer.h>
 #include <AK/RefPtr.h>
+#include <AK/ScopeGuard.h>
 #include <AK/Singleton.h>
 #include <AK/StringBuilder.h>
 #include <Kernel/API/DeviceFileTypes.h>
@@ -17,6 +18,7 @@
 #include <Kernel/Devices/Device.h>
 #include <Kernel/Devices/Loop/LoopDevice.h>
 #include <Kernel/FileSystem/Custody.h>
+#include <Kernel/FileSystem/DentryCache.h>
 #include <Kernel/FileSystem/FileBackedFileSystem.h>
 #include <Kernel/FileSystem/FileSystem.h>
 #include <Kernel/FileSystem/OpenFileDescription.h>
@@ -25,6 +27,7 @@
 #include <Kernel/Library/KLexicalPath.h>
 #include <Kernel/Sections.h>
 #include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/Tracepoints.h>
 
 #include <Kernel/FileSystem/DevLoopFS/FileSystem.h>
 #include <Kernel/FileSystem/DevPtsFS/FileSystem.h>
@@ -60,6 +63,27 @@ struct VirtualFileSystemDetails {
 
 static Singleton<VirtualFileSystemDetails> s_details;
 
+static ErrorOr<NonnullRefPtr<Inode>> lookup_child(Inode& parent_inode, StringView name)
+{
+    if (!parent_inode.fs().supports_dentry_caching())
+        return parent_inode.lookup(name);
+
+    auto& dentry_cache = DentryCache::the();
+    if (auto cached_lookup = dentry_cache.lookup(parent_inode, name); cached_lookup.has_value()) {
+        if (!cached_lookup->inode)
+            return ENOENT;
+        return cached_lookup->inode.release_nonnull();
+    }
+
+    auto generation = dentry_cache.generation();
+    auto child_or_error = parent_inode.lookup(name);
+    if (!child_or_error.is_error())
+        dentry_cache.add(parent_inode, name, child_or_error.value(), generation);
+    else if (child_or_error.error().code() == ENOENT)
+        dentry_cache.add(parent_inode, name, nullptr, generation);
+    return child_or_error;
+}
+
 SpinlockProtected<FileSystem::List, LockRank::FileSystem>& FileSystem::all_file_systems_list()
 {
     return s_details->file_systems_list;
@@ -294,6 +318,8 @@ ErrorOr<void> VirtualFileSystem::unmount(VFSRootContext& context, Custody& mount
 ErrorOr<void> VirtualFileSystem::remove_mount(Mount& mount, FileBackedFileSystem::List& file_backed_fs_list)
 {
     NonnullRefPtr<FileSystem> fs = mount.guest_fs();
+    // NOTE: Cached lookups keep inodes alive, which would make the filesystem look busy.
+    DentryCache::the().invalidate_file_system(*fs);
     TRY(fs->prepare_to_unmount(mount.guest()));
     fs->mounted_count().with([&](auto& mounted_count) {
         VERIFY(mounted_count > 0);
@@ -381,6 +407,8 @@ ErrorOr<NonnullRefPtr<OpenFileDescription>> VirtualFileSystem::open(VFSRootConte
 
 ErrorOr<NonnullRefPtr<OpenFileDescription>> VirtualFileSystem::open(Process const& process, VFSRootContext const& vfs_root_context, Credentials const& credentials, StringView path, int options, mode_t mode, CustodyBase const& base, Optional<UidAndGid> owner)
 {
+    TRACEPOINT(vfs_open, options, mode);
+
     if ((options & O_CREAT) && (options & O_DIRECTORY))
         return EINVAL;
 
@@ -494,6 +522,7 @@ ErrorOr<void> VirtualFileSystem::mknod(VFSRootContext const& vfs_root_context, C
 
     auto basename = KLexicalPath::basename(path);
     dbgln_if(VFS_DEBUG, "VirtualFileSystem::mknod: '{}' mode={} dev={} in {}", basename, mode, dev, parent_inode.identifier());
+    ScopeGuard invalidate_cached_lookup = [&] { DentryCache::the().invalidate(parent_inode, basename); };
     (void)TRY(parent_inode.create_child(basename, mode, dev, credentials.euid(), credentials.egid()));
     return {};
 }
@@ -527,6 +556,7 @@ ErrorOr<NonnullRefPtr<OpenFileDescription>> VirtualFileSystem::create(Process co
     auto uid = owner.has_value() ? owner.value().uid : credentials.euid();
     auto gid = owner.has_value() ? owner.value().gid : credentials.egid();
 
+    ScopeGuard invalidate_cached_lookup = [&] { DentryCache::the().invalidate(parent_inode, basename); };
     auto inode = TRY(parent_inode.create_child(basename, mode, 0, uid, gid));
     auto custody = TRY(Custody::try_create(&parent_custody, basename, inode, parent_custody.mount_flags()));
 
@@ -569,6 +599,7 @@ ErrorOr<void> VirtualFileSystem::mkdir(VFSRootContext const& vfs_root_context, C
 
     auto basename = KLexicalPath::basename(path);
     dbgln_if(VFS_DEBUG, "VirtualFileSystem::mkdir: '{}' in {}", basename, parent_inode.identifier());
+    ScopeGuard invalidate_cached_lookup = [&] { DentryCache::the().invalidate(parent_inode, basename); };
     (void)TRY(parent_inode.create_child(basename, S_IFDIR | mode, 0, credentials.euid(), credentials.egid()));
     return {};
 }
@@ -609,6 +640,59 @@ ErrorOr<NonnullRefPtr<Custody>> VirtualFileSystem::open_directory(VFSRootContext
     return custody;
 }
 
+ErrorOr<void> VirtualFileSystem::traverse_directory_with_metadata(VFSRootContext const& vfs_root_context, Credentials const& credentials, Custody& directory, Function<ErrorOr<void>(StringView name, InodeIdentifier, u8 file_type, ErrorOr<InodeMetadata> const&)> callback)
+{
+    auto& inode = directory.inode();
+    auto directory_metadata = inode.metadata();
+    if (!directory_metadata.is_valid())
+        return EIO;
+    if (!directory_metadata.is_directory())
+        return ENOTDIR;
+    // Resolving the path of an entry requires permission to search the directory.
+    bool may_search = directory_metadata.may_execute(credentials);
+
+    // NOTE: We can't look anything up while traversing, as some filesystems hold their locks for the whole traversal.
+    struct Entry {
+        NonnullOwnPtr<KString> name;
+        InodeIdentifier inode;
+        u8 file_type { 0 };
+    };
+    Vector<Entry> entries;
+    TRY(inode.traverse_as_directory([&](auto& entry) -> ErrorOr<void> {
+        auto name = TRY(KString::try_create(entry.name));
+        TRY(entries.try_append({ move(name), entry.inode, inode.fs().internal_file_type_to_directory_entry_type(entry) }));
+        return {};
+    }));
+
+    auto metadata_for_entry = [&](StringView name) -> ErrorOr<InodeMetadata> {
+        if (!may_search)
+            return EACCES;
+        if (name == "."sv) {
+            TRY(validate_path_against_process_veil(directory, O_NOFOLLOW_NOERROR));
+            return inode.metadata();
+        }
+        if (name == ".."sv) {
+            // Just like resolve_path(), we never go beyond the root.
+            auto& parent = directory.parent() ? *directory.parent() : directory;
+            TRY(validate_path_against_process_veil(parent, O_NOFOLLOW_NOERROR));
+            return parent.inode().metadata();
+        }
+
+        auto child_inode = TRY(lookup_child(inode, name));
+        auto child_custody = TRY(Custody::try_create(&directory, name, *child_inode, directory.mount_flags()));
+        if (auto mount_state = vfs_root_context.current_mount_state_for_host_custody(child_custody); !mount_state.is_error()) {
+            child_inode = mount_state.value().details.guest;
+            child_custody = TRY(Custody::try_create(&directory, name, *child_inode, mount_state.value().flags));
+        }
+        TRY(validate_path_against_process_veil(child_custody, O_NOFOLLOW_NOERROR));
+        return child_inode->metadata();
+    };
+
+    for (auto& entry : entries)
+        TRY(callback(entry.name->view(), entry.inode, entry.file_type, metadata_for_entry(entry.name->view())));
+    return {};
+}
+
 ErrorOr<void> VirtualFileSystem::chmod(Credentials const& credentials, Custody& custody, mode_t mode)
 {
     auto& inode = custody.inode();
@@ -714,6 +798,10 @@ ErrorOr<void> VirtualFileSystem::rename(VFSRootContext const& vfs_root_context,
             return EISDIR;
     }
 
+    ScopeGuard invalidate_cached_lookups = [&] {
+        DentryCache::the().invalidate(old_parent_inode, old_basename);
+        DentryCache::the().invalidate(new_parent_inode, new_basename);
+    };
     TRY(new_parent_inode.fs().rename(old_parent_inode, old_basename, new_parent_inode, new_basename));
 
     return {};
@@ -809,7 +897,9 @@ ErrorOr<void> VirtualFileSystem::link(VFSRootContext const& vfs_root_context, Cr
     if (!hard_link_allowed(credentials, old_inode))
         return EPERM;
 
-    return parent_inode.add_child(old_inode, KLexicalPath::basename(new_path), old_inode.mode());
+    auto basename = KLexicalPath::basename(new_path);
+    ScopeGuard invalidate_cached_lookup = [&] { DentryCache::the().invalidate(parent_inode, basename); };
+    return parent_inode.add_child(old_inode, basename, old_inode.mode());
 }
 
 ErrorOr<void> VirtualFileSystem::unlink(VFSRootContext const& vfs_root_context, Credentials const& credentials, StringView path, CustodyBase const& base)
@@ -838,7 +928,9 @@ ErrorOr<void> VirtualFileSystem::unlink(VFSRootContext const& vfs_root_context,
     if (parent_custody->is_readonly())
         return EROFS;
 
-    return parent_inode.remove_child(KLexicalPath::basename(path));
+    auto basename = KLexicalPath::basename(path);
+    ScopeGuard invalidate_cached_lookup = [&] { DentryCache::the().invalidate(parent_inode, basename); };
+    return parent_inode.remove_child(basename);
 }
 
 ErrorOr<void> VirtualFileSystem::symlink(VFSRootContext const& vfs_root_context, Credentials const& credentials, StringView target, StringView linkpath, CustodyBase const& base)
@@ -874,6 +966,7 @@ ErrorOr<void> VirtualFileSystem::symlink(VFSRootContext const& vfs_root_context,
     auto basename = KLexicalPath::basename(linkpath);
     dbgln_if(VFS_DEBUG, "VirtualFileSystem::symlink: '{}' (-> '{}') in {}", basename, target, parent_inode.identifier());
 
+    ScopeGuard invalidate_cached_lookup = [&] { DentryCache::the().invalidate(parent_inode, basename); };
     auto inode = TRY(parent_inode.create_child(basename, S_IFLNK | 0644, 0, credentials.euid(), credentials.egid()));
 
     auto target_buffer = UserOrKernelBuffer::for_kernel_buffer(const_cast<u8*>((u8 const*)target.characters_without_null_termination()));
@@ -938,7 +1031,8 @@ ErrorOr<void> VirtualFileSystem::rmdir(VFSRootContext const& vfs_root_context, C
     if (custody->is_readonly())
         return EROFS;
 
-    return parent_inode.remove_child(KLexicalPath::basename(path));
+    ScopeGuard invalidate_cached_lookup = [&] { DentryCache::the().invalidate(parent_inode, last_component); };
+    return parent_inode.remove_child(last_component);
 }
 
 UnveilNode const& find_matching_unveiled_path(Process const& process, StringView path)
@@ -1112,7 +1206,7 @@ ErrorOr<NonnullRefPtr<Custody>> VirtualFileSystem::resolve_path_without_veil(VFS
         }
 
         // Okay, let's look up this part.
-        auto child_or_error = parent.inode().lookup(part);
+        auto child_or_error = lookup_child(parent.inode(), part);
         if (child_or_error.is_error()) {
             if (out_parent) {
                 // ENOENT with a non-null parent custody signals to caller that
@@ -89,6 +89,10 @@ ErrorOr<void> rename(VFSRootContext const&, Credentials const&, CustodyBase cons
 ErrorOr<void> mknod(VFSRootContext const&, Credentials const&, StringView path, mode_t, dev_t, CustodyBase const& base);
 ErrorOr<NonnullRefPtr<Custody>> open_directory(VFSRootContext const&, Credentials const&, StringView path, CustodyBase const& base);
 
+// Calls the callback for each entry of the directory, along with the metadata that lstat() would return for
+// its path (or the error it would fail with), without having to resolve the path of every single entry.
+ErrorOr<void> traverse_directory_with_metadata(VFSRootContext const&, Credentials const&, Custody& directory, Function<ErrorOr<void>(StringView name, InodeIdentifier, u8 file_type, ErrorOr<InodeMetadata> const&)>);
+
 ErrorOr<NonnullRefPtr<Custody>> resolve_path(VFSRootContext const&, Credentials const&, StringView path, CustodyBase const& base, RefPtr<Custody>* out_parent = nullptr, int options = 0, int symlink_recursion_level = 0);
 ErrorOr<NonnullRefPtr<Custody>> resolve_path(Process const&, VFSRootContext const&, Credentials const&, StringView path, CustodyBase const& base, RefPtr<Custody>* out_parent = nullptr, int options = 0, int symlink_recursion_level = 0);
 ErrorOr<NonnullRefPtr<Custody>> resolve_path_without_veil(VFSRootContext const&, Credentials const&, StringView path, NonnullRefPtr<Custody> base, RefPtr<Custody>* out_parent = nullptr, int options = 0, int symlink_recursion_level = 0);
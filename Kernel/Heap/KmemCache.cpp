@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/Debug.h>
+#include <Kernel/Heap/KmemCache.h>
+#include <Kernel/Library/StdLib.h>
+
+namespace Kernel {
+
+static constexpr size_t max_kmem_cache_count = 64;
+
+// Caches only ever get added, so readers can walk the first s_kmem_cache_count entries without taking the lock.
+static Array<KmemCache*, max_kmem_cache_count> s_kmem_caches;
+static Atomic<size_t> s_kmem_cache_count { 0 };
+static Spinlock<LockRank::None> s_kmem_caches_lock {};
+
+void KmemCache::BlockList::prepend(Block& block)
+{
+    VERIFY(!block.previous && !block.next);
+    block.next = first;
+    if (first)
+        first->previous = &block;
+    first = &block;
+}
+
+void KmemCache::BlockList::remove(Block& block)
+{
+    if (block.previous)
+        block.previous->next = block.next;
+    else
+        first = block.next;
+    if (block.next)
+        block.next->previous = block.previous;
+    block.previous = nullptr;
+    block.next = nullptr;
+}
+
+size_t KmemCache::data_offset() const
+{
+    return round_up_to_power_of_two(sizeof(Block), m_alignment);
+}
+
+bool KmemCache::is_cached_size(size_t size) const
+{
+    return round_up_to_power_of_two(max(size, sizeof(void*)), m_alignment) == m_object_size;
+}
+
+size_t KmemCache::objects_per_block() const
+{
+    return (m_block_size - data_offset()) / m_object_size;
+}
+
+void KmemCache::register_if_needed()
+{
+    SpinlockLocker lock(s_kmem_caches_lock);
+    if (m_registered)
+        return;
+    m_registered = true;
+
+    auto index = s_kmem_cache_count.load(AK::MemoryOrder::memory_order_relaxed);
+    if (index == max_kmem_cache_count) {
+        dbgln("KmemCache: Not tracking cache '{}', there are too many caches", m_name);
+        return;
+    }
+    s_kmem_caches[index] = this;
+    s_kmem_cache_count.store(index + 1, AK::MemoryOrder::memory_order_release);
+}
+
+KmemCache::Block* KmemCache::try_create_block()
+{
+    auto* storage = kmalloc_aligned(m_block_size, m_block_size);
+    if (!storage)
+        return nullptr;
+    auto* block = new (storage) Block;
+
+    size_t color;
+    {
+        SpinlockLocker lock(m_lock);
+        // The space left over at the end of the block determines how far we can shift its objects.
+        auto unused_space = m_block_size - data_offset() - objects_per_block() * m_object_size;
+        color = m_next_color <= unused_space ? m_next_color : 0;
+        m_next_color = color + max(color_step, m_alignment);
+    }
+
+    auto* data = static_cast<u8*>(storage) + data_offset() + color;
+    for (size_t i = objects_per_block(); i > 0; --i) {
+        auto* entry = reinterpret_cast<FreelistEntry*>(data + (i - 1) * m_object_size);
+        entry->next = block->freelist;
+        block->freelist = entry;
+    }
+
+    register_if_needed();
+    return block;
+}
+
+void* KmemCache::allocate(size_t size)
+{
+    if (!is_cached_size(size))
+        return kmalloc_aligned(size, m_alignment);
+
+    if constexpr (KMALLOC_VERIFY_NO_SPINLOCK_HELD) {
+        Processor::verify_no_spinlocks_held();
+    }
+
+    SpinlockLocker lock(m_lock);
+    Block* block = m_partial_blocks.first;
+    if (!block) {
+        block = exchange(m_empty_block, nullptr);
+        if (!block) {
+            // NOTE: We can't call into kmalloc while holding our own lock.
+            lock.unlock();
+            auto* new_block = try_create_block();
+            if (!new_block)
+                return nullptr;
+            lock.lock();
+            ++m_block_count;
+            // Someone else might have freed up a slot in the meantime, but the new block will get used eventually either way.
+            block = new_block;
+        }
+        m_partial_blocks.prepend(*block);
+    }
+
+    auto* entry = block->freelist;
+    VERIFY(entry);
+    block->freelist = entry->next;
+    ++block->allocated_objects;
+    if (!block->freelist) {
+        m_partial_blocks.remove(*block);
+        m_full_blocks.prepend(*block);
+    }
+
+    ++m_allocated_objects;
+    ++m_allocation_count;
+    lock.unlock();
+
+    memset(entry, KMALLOC_SCRUB_BYTE, m_object_size);
+    return entry;
+}
+
+void KmemCache::deallocate(void* ptr, size_t size)
+{
+    if (!ptr)
+        return;
+
+    if (!is_cached_size(size)) {
+        kfree_sized(ptr, size);
+        return;
+    }
+
+    memset(ptr, KFREE_SCRUB_BYTE, m_object_size);
+
+    auto* block = reinterpret_cast<Block*>(reinterpret_cast<FlatPtr>(ptr) & ~(m_block_size - 1));
+    Block* block_to_free = nullptr;
+    {
+        SpinlockLocker lock(m_lock);
+        VERIFY(block->allocated_objects > 0);
+
+        bool block_was_full = !block->freelist;
+        auto* entry = static_cast<FreelistEntry*>(ptr);
+        entry->next = block->freelist;
+        block->freelist = entry;
+        --block->allocated_objects;
+
+        if (block_was_full) {
+            m_full_blocks.remove(*block);
+            m_partial_blocks.prepend(*block);
+        }
+
+        if (block->allocated_objects == 0) {
+            m_partial_blocks.remove(*block);
+            block_to_free = exchange(m_empty_block, block);
+            if (block_to_free)
+                --m_block_count;
+        }
+
+        --m_allocated_objects;
+        ++m_free_count;
+    }
+
+    // NOTE: Like allocating a block, freeing one has to happen outside of our lock.
+    if (block_to_free)
+        kfree_sized(block_to_free, m_block_size);
+}
+
+KmemCache::Statistics KmemCache::statistics() const
+{
+    SpinlockLocker lock(m_lock);
+    return {
+        .block_count = m_block_count,
+        .allocated_objects = m_allocated_objects,
+        .allocation_count = m_allocation_count,
+        .free_count = m_free_count,
+    };
+}
+
+void KmemCache::for_each(Function<void(KmemCache const&)> callback)
+{
+    auto count = s_kmem_cache_count.load(AK::MemoryOrder::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i)
+        callback(*s_kmem_caches[i]);
+}
+
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/StdLibExtras.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+#include <Kernel/Heap/kmalloc.h>
+#include <Kernel/Locking/Spinlock.h>
+
+namespace Kernel {
+
+// A cache of objects of a single type, carved out of blocks that are dedicated to it.
+// Compared to the generic kmalloc slabheaps, objects don't get rounded up to the next size class,
+// and consecutive blocks start their objects at different offsets ("colors"), so that objects
+// at the same index of different blocks don't all compete for the same cache lines.
+//
+// NOTE: Caches are constant-initialized and never destroyed, so they can be used before the global
+//       constructors have run. That's also why this doesn't use IntrusiveList for its blocks.
+class KmemCache {
+    AK_MAKE_NONCOPYABLE(KmemCache);
+    AK_MAKE_NONMOVABLE(KmemCache);
+
+public:
+    constexpr KmemCache(StringView name, size_t object_size, size_t alignment)
+        : m_name(name)
+        , m_object_size(round_up_to_power_of_two(max(object_size, sizeof(void*)), max(alignment, alignof(void*))))
+        , m_alignment(max(alignment, alignof(void*)))
+        , m_block_size(block_size_for_object_size(m_object_size))
+    {
+    }
+
+    // Allocations of any other size than the one the cache was created for are passed on to kmalloc,
+    // which happens when a subclass of the cached type gets allocated.
+    [[nodiscard]] void* allocate(size_t size);
+    void deallocate(void* ptr, size_t size);
+
+    StringView name() const { return m_name; }
+    size_t object_size() const { return m_object_size; }
+    size_t block_size() const { return m_block_size; }
+    size_t objects_per_block() const;
+
+    struct Statistics {
+        size_t block_count { 0 };
+        size_t allocated_objects { 0 };
+        u64 allocation_count { 0 };
+        u64 free_count { 0 };
+    };
+    Statistics statistics() const;
+
+    static void for_each(Function<void(KmemCache const&)>);
+
+private:
+    struct FreelistEntry {
+        FreelistEntry* next;
+    };
+
+    struct Block {
+        Block* previous { nullptr };
+        Block* next { nullptr };
+        FreelistEntry* freelist { nullptr };
+        size_t allocated_objects { 0 };
+    };
+
+    struct BlockList {
+        Block* first { nullptr };
+
+        bool is_empty() const { return first == nullptr; }
+        void prepend(Block&);
+        void remove(Block&);
+    };
+
+    static constexpr size_t minimum_block_size = 16 * KiB;
+    static constexpr size_t minimum_objects_per_block = 8;
+    static constexpr size_t color_step = 64;
+
+    static constexpr size_t block_size_for_object_size(size_t object_size)
+    {
+        size_t block_size = minimum_block_size;
+        while ((block_size - sizeof(Block)) / object_size < minimum_objects_per_block)
+            block_size *= 2;
+        return block_size;
+    }
+
+    bool is_cached_size(size_t) const;
+    size_t data_offset() const;
+    Block* try_create_block();
+    void register_if_needed();
+
+    StringView m_name;
+    size_t m_object_size { 0 };
+    size_t m_alignment { 0 };
+    size_t m_block_size { 0 };
+
+    mutable Spinlock<LockRank::None> m_lock {};
+    BlockList m_partial_blocks;
+    BlockList m_full_blocks;
+    // We keep a single empty block around, so allocating and freeing one object
+    // in a loop doesn't keep allocating and freeing blocks as well.
+    Block* m_empty_block { nullptr };
+    size_t m_next_color { 0 };
+
+    size_t m_block_count { 0 };
+    size_t m_allocated_objects { 0 };
+    u64 m_allocation_count { 0 };
+    u64 m_free_count { 0 };
+
+    bool m_registered { false };
+};
+
+}
+
+// Routes a class's (non-placement) operator new and delete through its own KmemCache.
+// The cache itself needs to be defined with DEFINE_KMEM_CACHE in a single translation unit.
+#define KMEM_CACHE_ALLOCATED(type)                                                \
+public:                                                                           \
+    static Kernel::KmemCache& kmem_cache();                                       \
+    [[nodiscard]] void* operator new(size_t size)                                 \
+    {                                                                             \
+        void* ptr = kmem_cache().allocate(size);                                  \
+        VERIFY(ptr);                                                              \
+        return ptr;                                                               \
+    }                                                                             \
+    [[nodiscard]] void* operator new(size_t size, std::nothrow_t const&) noexcept \
+    {                                                                             \
+        return kmem_cache().allocate(size);                                       \
+    }                                                                             \
+    void operator delete(void* ptr, size_t size) noexcept                         \
+    {                                                                             \
+        kmem_cache().deallocate(ptr, size);                                       \
+    }                                                                             \
+                                                                                  \
+private:
+
+#define DEFINE_KMEM_CACHE(type)                                                                          \
+    static constinit Kernel::KmemCache s_##type##_kmem_cache { #type##sv, sizeof(type), alignof(type) }; \
+    Kernel::KmemCache& type::kmem_cache()                                                                \
+    {                                                                                                    \
+        return s_##type##_kmem_cache;                                                                    \
+    }
+
@@ -5,11 +5,13 @@
  */
 
 #include <AK/Assertions.h>
+#include <AK/Atomic.h>
 #include <AK/Types.h>
 #include <Kernel/Arch/PageDirectory.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Heap/Heap.h>
 #include <Kernel/Heap/kmalloc.h>
+#include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/KSyms.h>
 #include <Kernel/Library/Panic.h>
 #include <Kernel/Library/StdLib.h>
@@ -235,18 +237,40 @@ private:
 
 struct KmallocGlobalData {
     static constexpr size_t minimum_subheap_size = 1 * MiB;
+    static constexpr size_t slabheap_count = 6;
+    // FIXME: This range can be much bigger on 64-bit, but we need to figure something out for 32-bit.
+    static constexpr size_t expansion_range_size = 64 * MiB;
+    static constexpr size_t max_expansion_subheap_count = expansion_range_size / minimum_subheap_size;
+    static_assert(max_expansion_subheap_count < 256);
 
     KmallocGlobalData(u8* initial_heap, size_t initial_heap_size)
     {
         add_subheap(initial_heap, initial_heap_size);
     }
 
-    void add_subheap(u8* storage, size_t storage_size)
+    KmallocSubheap& add_subheap(u8* storage, size_t storage_size)
     {
         dbgln_if(KMALLOC_DEBUG, "Adding kmalloc subheap @ {} with size {}", storage, storage_size);
         static_assert(sizeof(KmallocSubheap) <= PAGE_SIZE);
         auto* subheap = new (storage) KmallocSubheap(storage + PAGE_SIZE, storage_size - PAGE_SIZE);
         subheaps.append(*subheap);
+        return *subheap;
+    }
+
+    KmallocSubheap* subheap_containing(void* ptr)
+    {
+        auto vaddr = VirtualAddress { ptr };
+        if (vaddr.as_ptr() >= initial_kmalloc_memory && vaddr.as_ptr() < (initial_kmalloc_memory + INITIAL_KMALLOC_MEMORY_SIZE))
+            return subheaps.first();
+
+        if (!expansion_data.has_value() || !expansion_data->virtual_range.contains(vaddr))
+            return nullptr;
+
+        auto page_index = (vaddr.get() - expansion_data->virtual_range.base().get()) / PAGE_SIZE;
+        auto subheap_index = expansion_subheap_index_for_page[page_index];
+        if (subheap_index == 0)
+            return nullptr;
+        return expansion_subheaps[subheap_index - 1];
     }
 
     void* allocate(size_t size, size_t alignment, CallerWillInitializeMemory caller_will_initialize_memory)
@@ -298,11 +322,9 @@ struct KmallocGlobalData {
                 return slabheap.deallocate(ptr);
         }
 
-        for (auto& subheap : subheaps) {
-            if (subheap.allocator.contains(ptr)) {
-                subheap.allocator.deallocate(ptr);
-                return;
-            }
+        if (auto* subheap = subheap_containing(ptr); subheap && subheap->allocator.contains(ptr)) {
+            subheap->allocator.deallocate(ptr);
+            return;
         }
 
         PANIC("Bogus pointer passed to kfree_sized({:p}, {})", ptr, size);
@@ -380,14 +402,18 @@ struct KmallocGlobalData {
             pte->set_present(true);
         }
 
-        add_subheap(new_subheap_base.as_ptr(), new_subheap_size);
+        // Every expansion subheap is at least minimum_subheap_size large, so we can't run out of indices.
+        VERIFY(expansion_subheap_count < max_expansion_subheap_count);
+        expansion_subheaps[expansion_subheap_count++] = &add_subheap(new_subheap_base.as_ptr(), new_subheap_size);
+        auto first_page = (new_subheap_base.get() - expansion_data->virtual_range.base().get()) / PAGE_SIZE;
+        for (size_t page = 0; page < new_subheap_size / PAGE_SIZE; ++page)
+            expansion_subheap_index_for_page[first_page + page] = expansion_subheap_count;
         return true;
     }
 
     void enable_expansion()
     {
-        // FIXME: This range can be much bigger on 64-bit, but we need to figure something out for 32-bit.
-        auto reserved_region = MUST(MM.allocate_unbacked_region_anywhere(64 * MiB, 1 * MiB));
+        auto reserved_region = MUST(MM.allocate_unbacked_region_anywhere(expansion_range_size, 1 * MiB));
 
         expansion_data = KmallocGlobalData::ExpansionData {
             .virtual_range = reserved_region->range(),
@@ -423,7 +449,13 @@ struct KmallocGlobalData {
 
     KmallocSubheap::List subheaps;
 
-    KmallocSlabheap slabheaps[6] = { 16, 32, 64, 128, 256, 512 };
+    // Maps every page of the expansion range to the (1-based) index of the subheap covering it, or 0 if there is none,
+    // so that freeing doesn't have to ask every subheap whether it contains the pointer.
+    KmallocSubheap* expansion_subheaps[max_expansion_subheap_count] {};
+    u8 expansion_subheap_index_for_page[expansion_range_size / PAGE_SIZE] {};
+    size_t expansion_subheap_count { 0 };
+
+    KmallocSlabheap slabheaps[slabheap_count] = { 16, 32, 64, 128, 256, 512 };
 
     bool expansion_in_progress { false };
 };
@@ -436,6 +468,120 @@ static size_t g_kfree_call_count;
 static size_t g_nested_kfree_calls;
 bool g_dump_kmalloc_stacks;
 
+// Every processor keeps a magazine of free slabs for each slabheap, so most small allocations
+// and frees never have to take the global kmalloc lock. Empty magazines are refilled from the
+// shared slabheaps (and full ones drained back into them) in batches while holding the lock.
+struct KmallocMagazine {
+    static constexpr size_t capacity = 32;
+    static constexpr size_t batch_size = capacity / 2;
+
+    void* slabs[capacity];
+    // Only ever modified by the owning processor, other processors merely read it for statistics.
+    Atomic<size_t, AK::MemoryOrder::memory_order_relaxed> count { 0 };
+};
+
+struct KmallocProcessorCache {
+    KmallocMagazine magazines[KmallocGlobalData::slabheap_count];
+
+    Atomic<size_t, AK::MemoryOrder::memory_order_relaxed> allocation_count { 0 };
+    Atomic<size_t, AK::MemoryOrder::memory_order_relaxed> free_count { 0 };
+    Atomic<size_t, AK::MemoryOrder::memory_order_relaxed> refill_count { 0 };
+    Atomic<size_t, AK::MemoryOrder::memory_order_relaxed> drain_count { 0 };
+};
+
+static KmallocProcessorCache s_processor_caches[MAX_CPU_COUNT];
+
+// NOTE: The counters are only written by the processor owning them, so there's no need for an atomic read-modify-write.
+static ALWAYS_INLINE void increment_processor_cache_counter(Atomic<size_t, AK::MemoryOrder::memory_order_relaxed>& counter, size_t amount = 1)
+{
+    counter.store(counter.load() + amount);
+}
+
+static Optional<size_t> slabheap_index_for(size_t size, size_t alignment)
+{
+    for (size_t i = 0; i < KmallocGlobalData::slabheap_count; ++i) {
+        auto slab_size = g_kmalloc_global->slabheaps[i].slab_size();
+        if (size <= slab_size && alignment <= slab_size)
+            return i;
+    }
+    return {};
+}
+
+static void* try_allocate_from_processor_cache([[maybe_unused]] size_t size, [[maybe_unused]] size_t alignment, [[maybe_unused]] CallerWillInitializeMemory caller_will_initialize_memory)
+{
+#ifdef HAS_ADDRESS_SANITIZER
+    // Slabs sitting in a magazine would have to be tracked as both allocated and free, so let the slabheaps handle everything.
+    return nullptr;
+#else
+    auto index = slabheap_index_for(size, alignment);
+    if (!index.has_value())
+        return nullptr;
+
+    InterruptDisabler disabler;
+    auto& cache = s_processor_caches[Processor::current_id()];
+    auto& magazine = cache.magazines[index.value()];
+    auto& slabheap = g_kmalloc_global->slabheaps[index.value()];
+
+    if (magazine.count.load() == 0) {
+        SpinlockLocker lock(s_lock);
+        size_t count = 0;
+        while (count < KmallocMagazine::batch_size) {
+            auto* slab = slabheap.allocate(slabheap.slab_size(), CallerWillInitializeMemory::Yes);
+            if (!slab)
+                break;
+            magazine.slabs[count++] = slab;
+        }
+        // Let the regular allocation path deal with purging or expanding the heap.
+        if (count == 0)
+            return nullptr;
+        magazine.count.store(count);
+        increment_processor_cache_counter(cache.refill_count);
+    }
+
+    auto count = magazine.count.load() - 1;
+    auto* ptr = magazine.slabs[count];
+    magazine.count.store(count);
+    increment_processor_cache_counter(cache.allocation_count);
+
+    if (caller_will_initialize_memory == CallerWillInitializeMemory::No)
+        memset(ptr, KMALLOC_SCRUB_BYTE, slabheap.slab_size());
+    return ptr;
+#endif
+}
+
+static bool try_deallocate_to_processor_cache([[maybe_unused]] void* ptr, [[maybe_unused]] size_t size)
+{
+#ifdef HAS_ADDRESS_SANITIZER
+    return false;
+#else
+    // NOTE: Like KmallocGlobalData::deallocate(), we pick the slabheap by size alone.
+    auto index = slabheap_index_for(size, 1);
+    if (!index.has_value())
+        return false;
+
+    VERIFY(g_kmalloc_global->is_valid_kmalloc_address(VirtualAddress { ptr }));
+    auto& slabheap = g_kmalloc_global->slabheaps[index.value()];
+    memset(ptr, KFREE_SCRUB_BYTE, slabheap.slab_size());
+
+    InterruptDisabler disabler;
+    auto& cache = s_processor_caches[Processor::current_id()];
+    auto& magazine = cache.magazines[index.value()];
+
+    auto count = magazine.count.load();
+    if (count == KmallocMagazine::capacity) {
+        SpinlockLocker lock(s_lock);
+        for (size_t i = 0; i < KmallocMagazine::batch_size; ++i)
+            slabheap.deallocate(magazine.slabs[--count]);
+        increment_processor_cache_counter(cache.drain_count);
+    }
+
+    magazine.slabs[count++] = ptr;
+    magazine.count.store(count);
+    increment_processor_cache_counter(cache.free_count);
+    return true;
+#endif
+}
+
 void kmalloc_enable_expand()
 {
     g_kmalloc_global->enable_expansion();
@@ -460,18 +606,23 @@ static void* kmalloc_impl(size_t size, size_t alignment, CallerWillInitializeMem
     // Alignment must be a power of two.
     VERIFY(is_power_of_two(alignment));
 
-    Optional<SpinlockLocker<Spinlock<Kernel::LockRank::None>>> maybe_lock = {};
+    void* ptr = nullptr;
     if (caller_has_acquired_lock == CallerHasAcquiredLock::No)
-        maybe_lock = SpinlockLocker(s_lock);
+        ptr = try_allocate_from_processor_cache(size, alignment, caller_will_initialize_memory);
 
-    ++g_kmalloc_call_count;
+    Optional<SpinlockLocker<Spinlock<Kernel::LockRank::None>>> maybe_lock = {};
+    if (!ptr && caller_has_acquired_lock == CallerHasAcquiredLock::No)
+        maybe_lock = SpinlockLocker(s_lock);
 
     if (g_dump_kmalloc_stacks && Kernel::g_kernel_symbols_available.was_set()) {
         dbgln("kmalloc({})", size);
         Kernel::dump_backtrace();
     }
 
-    void* ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+    if (!ptr) {
+        ++g_kmalloc_call_count;
+        ptr = g_kmalloc_global->allocate(size, alignment, caller_will_initialize_memory);
+    }
 
     Thread* current_thread = Thread::current();
     if (!current_thread)
@@ -534,6 +685,17 @@ void kfree_sized(void* ptr, size_t size)
         Processor::verify_no_spinlocks_held();
     }
 
+    if (ptr && try_deallocate_to_processor_cache(ptr, size)) {
+        Thread* current_thread = Thread::current();
+        if (!current_thread)
+            current_thread = Processor::idle_thread();
+        if (current_thread) {
+            VERIFY(current_thread->is_allocation_enabled());
+            PerformanceManager::add_kfree_perf_event(*current_thread, 0, (FlatPtr)ptr);
+        }
+        return;
+    }
+
     SpinlockLocker lock(s_lock);
     kfree_sized_impl(ptr, size);
 }
@@ -624,4 +786,25 @@ void get_kmalloc_stats(kmalloc_stats& stats)
     stats.bytes_free = g_kmalloc_global->free_bytes();
     stats.kmalloc_call_count = g_kmalloc_call_count;
     stats.kfree_call_count = g_kfree_call_count;
+    stats.magazine_cached_bytes = 0;
+    stats.magazine_allocation_count = 0;
+    stats.magazine_free_count = 0;
+    stats.magazine_refill_count = 0;
+    stats.magazine_drain_count = 0;
+
+    for (u32 cpu = 0; cpu < Processor::count(); ++cpu) {
+        auto const& cache = s_processor_caches[cpu];
+        for (size_t i = 0; i < KmallocGlobalData::slabheap_count; ++i)
+            stats.magazine_cached_bytes += cache.magazines[i].count.load() * g_kmalloc_global->slabheaps[i].slab_size();
+        stats.magazine_allocation_count += cache.allocation_count.load();
+        stats.magazine_free_count += cache.free_count.load();
+        stats.magazine_refill_count += cache.refill_count.load();
+        stats.magazine_drain_count += cache.drain_count.load();
+    }
+
+    // The slabheaps consider slabs sitting in a magazine allocated, but they're free as far as anyone else is concerned.
+    stats.bytes_allocated -= min(stats.bytes_allocated, stats.magazine_cached_bytes);
+    stats.bytes_free += stats.magazine_cached_bytes;
+    stats.kmalloc_call_count += stats.magazine_allocation_count;
+    stats.kfree_call_count += stats.magazine_free_count;
 }
@@ -52,6 +52,11 @@ struct kmalloc_stats {
     size_t bytes_free;
     size_t kmalloc_call_count;
     size_t kfree_call_count;
+    size_t magazine_cached_bytes;
+    size_t magazine_allocation_count;
+    size_t magazine_free_count;
+    size_t magazine_refill_count;
+    size_t magazine_drain_count;
 };
 void get_kmalloc_stats(kmalloc_stats&);
 
@@ -20,12 +20,13 @@ inline void DoubleBuffer::compute_lockfree_metadata()
 ErrorOr<NonnullOwnPtr<DoubleBuffer>> DoubleBuffer::try_create(StringView name, size_t capacity)
 {
     auto storage = TRY(KBuffer::try_create_with_size(name, capacity * 2, Memory::Region::Access::ReadWrite));
-    return adopt_nonnull_own_or_enomem(new (nothrow) DoubleBuffer(capacity, move(storage)));
+    return adopt_nonnull_own_or_enomem(new (nothrow) DoubleBuffer(name, capacity, move(storage)));
 }
 
-DoubleBuffer::DoubleBuffer(size_t capacity, NonnullOwnPtr<KBuffer> storage)
+DoubleBuffer::DoubleBuffer(StringView name, size_t capacity, NonnullOwnPtr<KBuffer> storage)
     : m_write_buffer(&m_buffer1)
     , m_read_buffer(&m_buffer2)
+    , m_name(name)
     , m_storage(move(storage))
     , m_capacity(capacity)
 {
@@ -45,6 +46,43 @@ void DoubleBuffer::flip()
     compute_lockfree_metadata();
 }
 
+ErrorOr<void> DoubleBuffer::try_resize(size_t capacity)
+{
+    if (capacity == 0 || capacity > max_capacity)
+        return EINVAL;
+    capacity = TRY(Memory::page_round_up(capacity));
+
+    MutexLocker locker(m_lock);
+    if (capacity == m_capacity)
+        return {};
+
+    size_t unread_in_read_buffer = m_read_buffer->size - min(m_read_buffer_index, m_read_buffer->size);
+    size_t unread_size = unread_in_read_buffer + m_write_buffer->size;
+    if (unread_size > capacity)
+        return EBUSY;
+
+    auto storage = TRY(KBuffer::try_create_with_size(m_name, capacity * 2, Memory::Region::Access::ReadWrite));
+
+    // Move everything that hasn't been read yet to the start of the new read buffer, in order.
+    u8* unread_data = storage->data();
+    memcpy(unread_data, m_read_buffer->data + m_read_buffer_index, unread_in_read_buffer);
+    memcpy(unread_data + unread_in_read_buffer, m_write_buffer->data, m_write_buffer->size);
+
+    m_read_buffer = &m_buffer1;
+    m_write_buffer = &m_buffer2;
+    m_buffer1.data = storage->data();
+    m_buffer1.size = unread_size;
+    m_buffer2.data = storage->data() + capacity;
+    m_buffer2.size = 0;
+    m_read_buffer_index = 0;
+    m_storage = move(storage);
+    m_capacity = capacity;
+    compute_lockfree_metadata();
+    if (m_unblock_callback && m_space_for_writing > 0)
+        m_unblock_callback();
+    return {};
+}
+
 ErrorOr<size_t> DoubleBuffer::write(UserOrKernelBuffer const& data, size_t size)
 {
     if (!size)
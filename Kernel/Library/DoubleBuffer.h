@@ -16,7 +16,16 @@ namespace Kernel {
 
 class DoubleBuffer {
 public:
-    static ErrorOr<NonnullOwnPtr<DoubleBuffer>> try_create(StringView name, size_t capacity = 65536);
+    static constexpr size_t default_capacity = 64 * KiB;
+    static constexpr size_t max_capacity = 4 * MiB;
+
+    static ErrorOr<NonnullOwnPtr<DoubleBuffer>> try_create(StringView name, size_t capacity = default_capacity);
+
+    // Replaces the storage with one that has room for the given capacity, rounded up to a whole page.
+    // Fails with EBUSY if there is more unread data than would fit.
+    ErrorOr<void> try_resize(size_t capacity);
+    size_t capacity() const { return m_capacity; }
+
     ErrorOr<size_t> write(UserOrKernelBuffer const&, size_t);
     ErrorOr<size_t> write(u8 const* data, size_t size)
     {
@@ -50,7 +59,7 @@ public:
     }
 
 private:
-    explicit DoubleBuffer(size_t capacity, NonnullOwnPtr<KBuffer> storage);
+    DoubleBuffer(StringView name, size_t capacity, NonnullOwnPtr<KBuffer> storage);
     void flip();
     void compute_lockfree_metadata();
 
@@ -66,6 +75,7 @@ private:
     InnerBuffer m_buffer1;
     InnerBuffer m_buffer2;
 
+    StringView m_name;
     NonnullOwnPtr<KBuffer> m_storage;
     Function<void()> m_unblock_callback;
     size_t m_capacity { 0 };
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/SetOnce.h>
 #include <Kernel/Debug.h>
 #include <Kernel/KSyms.h>
@@ -17,6 +18,36 @@ extern SetOnce g_not_in_early_boot;
 
 namespace Kernel {
 
+// When the exclusive holder of a contended mutex is running on another processor, it is likely to
+// release the mutex sooner than it would take us to block and switch away. We re-check the holder
+// this many times, pausing in between, before giving up and blocking.
+static constexpr size_t mutex_spin_check_limit = 64;
+static constexpr size_t mutex_spin_pauses_per_check = 16;
+
+static Array<Mutex::ContentionStatistics, Mutex::contention_statistics_bucket_count> s_contention_statistics;
+
+static size_t contention_statistics_bucket_for(LockRank rank)
+{
+    if (rank == LockRank::None)
+        return 0;
+    auto bucket = count_trailing_zeroes(to_underlying(rank)) + 1;
+    VERIFY(static_cast<size_t>(bucket) < Mutex::contention_statistics_bucket_count);
+    return bucket;
+}
+
+Mutex::ContentionStatistics& Mutex::contention_statistics_for(LockRank rank)
+{
+    return s_contention_statistics[contention_statistics_bucket_for(rank)];
+}
+
+LockRank Mutex::lock_rank_for_contention_statistics_bucket(size_t bucket)
+{
+    VERIFY(bucket < contention_statistics_bucket_count);
+    if (bucket == 0)
+        return LockRank::None;
+    return static_cast<LockRank>(1 << (bucket - 1));
+}
+
 void Mutex::lock(Mode mode, [[maybe_unused]] LockLocation const& location)
 {
     // NOTE: This may be called from an interrupt handler (not an IRQ handler)
@@ -31,6 +62,15 @@ void Mutex::lock(Mode mode, [[maybe_unused]] LockLocation const& location)
     auto* current_thread = Thread::current();
 
     SpinlockLocker lock(m_lock);
+    bool is_contended = (m_mode == Mode::Exclusive && m_holder != bit_cast<uintptr_t>(current_thread))
+        || (m_mode == Mode::Shared && mode == Mode::Exclusive);
+    if (is_contended) {
+        auto& statistics = contention_statistics_for(m_rank);
+        statistics.contended++;
+        if (spin_while_holder_is_running(*current_thread, lock))
+            statistics.acquired_by_spinning++;
+    }
+
     bool did_block = false;
     Mode current_mode = m_mode;
     switch (current_mode) {
@@ -208,6 +248,36 @@ void Mutex::unlock()
     }
 }
 
+bool Mutex::spin_while_holder_is_running(Thread& current_thread, SpinlockLocker<Spinlock<LockRank::None>>& lock)
+{
+    // FIXME: remove this after annihilating Process::m_big_lock
+    if (m_behavior == MutexBehavior::BigLock)
+        return false;
+    if (Processor::count() == 1)
+        return false;
+
+    for (size_t check = 0; check < mutex_spin_check_limit; ++check) {
+        if (m_mode == Mode::Unlocked)
+            return true;
+        // We don't know who the shared holders are, so there is nothing to spin on.
+        if (m_mode != Mode::Exclusive)
+            return false;
+
+        // NOTE: The holder can't go away while it still holds this mutex, and it can't release
+        //       it while we're holding m_lock, so it's safe to look at it here.
+        auto* holder = bit_cast<Thread*>(m_holder);
+        VERIFY(holder != &current_thread);
+        if (!holder->is_active() || holder->cpu() == Processor::current_id())
+            return false;
+
+        lock.unlock();
+        for (size_t i = 0; i < mutex_spin_pauses_per_check; ++i)
+            Processor::pause();
+        lock.lock();
+    }
+    return m_mode == Mode::Unlocked;
+}
+
 void Mutex::block(Thread& current_thread, Mode mode, SpinlockLocker<Spinlock<LockRank::None>>& lock, u32 requested_locks)
 {
     if constexpr (LOCK_IN_CRITICAL_DEBUG) {
@@ -215,6 +285,7 @@ void Mutex::block(Thread& current_thread, Mode mode, SpinlockLocker<Spinlock<Loc
         if (g_not_in_early_boot.was_set())
             VERIFY_INTERRUPTS_ENABLED();
     }
+    contention_statistics_for(m_rank).blocked++;
     m_blocked_thread_lists.with([&](auto& lists) {
         auto append_to_list = [&]<typename L>(L& list) {
             VERIFY(!list.contains(current_thread));
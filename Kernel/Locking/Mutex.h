@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Assertions.h>
 #include <AK/Atomic.h>
 #include <AK/HashMap.h>
@@ -39,6 +40,14 @@ public:
         , m_behavior(behavior)
     {
     }
+    // NOTE: The rank is only used to bucket the contention statistics below,
+    //       it is not (yet) validated against the other locks held by the thread.
+    Mutex(StringView name, LockRank rank)
+        : m_name(name)
+        , m_behavior(MutexBehavior::Regular)
+        , m_rank(rank)
+    {
+    }
     ~Mutex() = default;
 
     void lock(Mode mode = Mode::Exclusive, LockLocation const& location = LockLocation::current());
@@ -62,6 +71,21 @@ public:
     }
 
     [[nodiscard]] StringView name() const { return m_name; }
+    [[nodiscard]] LockRank rank() const { return m_rank; }
+
+    struct ContentionStatistics {
+        // Acquisitions that found the mutex held in an incompatible mode.
+        Atomic<u64, AK::MemoryOrder::memory_order_relaxed> contended { 0 };
+        // Contended acquisitions that succeeded by spinning on a running holder.
+        Atomic<u64, AK::MemoryOrder::memory_order_relaxed> acquired_by_spinning { 0 };
+        // Contended acquisitions that had to block the current thread.
+        Atomic<u64, AK::MemoryOrder::memory_order_relaxed> blocked { 0 };
+    };
+
+    // One bucket for LockRank::None, followed by one for each of the rank bits.
+    static constexpr size_t contention_statistics_bucket_count = 6;
+    static ContentionStatistics& contention_statistics_for(LockRank);
+    static LockRank lock_rank_for_contention_statistics_bucket(size_t);
 
     static StringView mode_to_string(Mode mode)
     {
@@ -86,6 +110,7 @@ private:
     // FIXME: Allow any lock rank.
     void block(Thread&, Mode, SpinlockLocker<Spinlock<LockRank::None>>&, u32);
     void unblock_waiters(Mode);
+    bool spin_while_holder_is_running(Thread&, SpinlockLocker<Spinlock<LockRank::None>>&);
 
     StringView m_name;
     Mode m_mode { Mode::Unlocked };
@@ -93,6 +118,8 @@ private:
     // FIXME: remove this after annihilating Process::m_big_lock
     MutexBehavior m_behavior;
 
+    LockRank m_rank { LockRank::None };
+
     // When locked exclusively, only the thread already holding the lock can
     // lock it again. When locked in shared mode, any thread can do that.
     u32 m_times_locked { 0 };
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <Kernel/API/MemoryLayout.h>
 #include <Kernel/Arch/CPU.h>
 #include <Kernel/Locking/Spinlock.h>
@@ -76,7 +77,13 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
         // Remove the old region from our regions tree, since were going to add another region
         // with the exact same start address.
         auto region = take_region(*old_region);
-        region->unmap();
+        auto old_range = region->range();
+        region->unmap(ShouldFlushTLB::No);
+
+        // The split regions map the same pages as before, so one flush for the whole old region is enough.
+        ScopeGuard flush_tlb_guard = [&] {
+            MemoryManager::flush_tlb(&page_directory(), old_range.base(), old_range.size() / PAGE_SIZE);
+        };
 
         auto new_regions = TRY(try_split_region_around_range(*region, range_to_unmap));
 
@@ -84,7 +91,7 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
         for (auto* new_region : new_regions) {
             // TODO: Ideally we should do this in a way that can be rolled back on failure, as failing here
             // leaves the caller in an undefined state.
-            TRY(new_region->map(page_directory()));
+            TRY(new_region->map(page_directory(), ShouldFlushTLB::No));
         }
 
         PerformanceManager::add_unmap_perf_event(Process::current(), range_to_unmap);
@@ -108,18 +115,28 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
 
     Vector<Region*, 2> new_regions;
 
+    // Instead of flushing the TLB for every region on its own (which means another round of IPIs each time),
+    // we flush everything we've touched in one go. The regions we remove entirely have to stay alive until then,
+    // since destroying them might free pages that other processors can still reach through their TLBs.
+    Vector<NonnullOwnPtr<Region>> regions_to_deallocate;
+    TRY(regions_to_deallocate.try_ensure_capacity(regions.size()));
+    VirtualRange flush_range { regions.first()->vaddr(), regions.last()->range().end().get() - regions.first()->vaddr().get() };
+    ScopeGuard flush_tlb_guard = [&] {
+        MemoryManager::flush_tlb(&page_directory(), flush_range.base(), flush_range.size() / PAGE_SIZE);
+    };
+
     for (auto* old_region : regions) {
+        // Remove the old region from our regions tree, since were going to add another region
+        // with the exact same start address (or none at all if it's a full match).
+        auto region = take_region(*old_region);
+        region->unmap(ShouldFlushTLB::No);
+
         // If it's a full match we can remove the entire old region.
-        if (old_region->range().intersect(range_to_unmap).size() == old_region->size()) {
-            deallocate_region(*old_region);
+        if (region->range().intersect(range_to_unmap).size() == region->size()) {
+            regions_to_deallocate.unchecked_append(move(region));
             continue;
         }
 
-        // Remove the old region from our regions tree, since were going to add another region
-        // with the exact same start address.
-        auto region = take_region(*old_region);
-        region->unmap();
-
         // Otherwise, split the regions and collect them for future mapping.
         auto split_regions = TRY(try_split_region_around_range(*region, range_to_unmap));
         TRY(new_regions.try_extend(split_regions));
@@ -129,7 +146,7 @@ ErrorOr<void> AddressSpace::unmap_mmap_range(VirtualAddress addr, size_t size)
     for (auto* new_region : new_regions) {
         // TODO: Ideally we should do this in a way that can be rolled back on failure, as failing here
         // leaves the caller in an undefined state.
-        TRY(new_region->map(page_directory()));
+        TRY(new_region->map(page_directory(), ShouldFlushTLB::No));
     }
 
     PerformanceManager::add_unmap_perf_event(Process::current(), range_to_unmap);
@@ -148,6 +165,8 @@ ErrorOr<Region*> AddressSpace::try_allocate_split_region(Region const& source_re
     new_region->set_syscall_region(source_region.is_syscall_region());
     new_region->set_mmap(source_region.is_mmap(), source_region.mmapped_from_readable(), source_region.mmapped_from_writable());
     new_region->set_stack(source_region.is_stack());
+    new_region->set_wants_huge_pages(source_region.wants_huge_pages());
+    new_region->set_access_pattern(source_region.access_pattern());
     TRY(m_region_tree.place_specifically(*new_region, range));
     return new_region.leak_ptr();
 }
@@ -255,6 +274,21 @@ Region* AddressSpace::find_region_containing(VirtualRange const& range)
     return m_region_tree.find_region_containing(range);
 }
 
+ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> AddressSpace::pin_pages_for_reading(VirtualRange const& range)
+{
+    auto* region = find_region_containing(range);
+    if (!region || !region->is_user())
+        return EFAULT;
+
+    Vector<NonnullRefPtr<PhysicalRAMPage>> pages;
+    auto first_page = region->page_index_from_address(range.base());
+    auto last_page = region->page_index_from_address(range.end().offset(-1));
+    TRY(pages.try_ensure_capacity(last_page - first_page + 1));
+    for (auto index = first_page; index <= last_page; ++index)
+        pages.unchecked_append(TRY(region->pin_page_for_reading(index)));
+    return pages;
+}
+
 ErrorOr<Vector<Region*, 4>> AddressSpace::find_regions_intersecting(VirtualRange const& range)
 {
     Vector<Region*, 4> regions = {};
@@ -47,6 +47,9 @@ public:
     Region* find_region_from_range(VirtualRange const&);
     Region* find_region_containing(VirtualRange const&);
 
+    // Pins the pages of a range within a single region, as Region::pin_page_for_reading() does.
+    ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> pin_pages_for_reading(VirtualRange const&);
+
     ErrorOr<Vector<Region*, 4>> find_regions_intersecting(VirtualRange const&);
 
     bool enforces_syscall_regions() const { return m_enforces_syscall_regions.was_set(); }
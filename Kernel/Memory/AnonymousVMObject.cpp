@@ -267,6 +267,11 @@ NonnullRefPtr<PhysicalRAMPage> AnonymousVMObject::allocate_committed_page(Badge<
     return m_unused_committed_pages->take_one();
 }
 
+Vector<NonnullRefPtr<PhysicalRAMPage>> AnonymousVMObject::try_allocate_committed_huge_page(Badge<Region>)
+{
+    return m_unused_committed_pages->try_take_contiguous(HUGE_PAGE_SIZE / PAGE_SIZE, HUGE_PAGE_SIZE);
+}
+
 void AnonymousVMObject::reset_cow_map()
 {
     for (size_t i = 0; i < page_count(); ++i) {
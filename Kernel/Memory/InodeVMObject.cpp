@@ -4,22 +4,27 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/FileSystem/Inode.h>
+#include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/Memory/InodeVMObject.h>
+#include <Kernel/Memory/MemoryManager.h>
 
 namespace Kernel::Memory {
 
-InodeVMObject::InodeVMObject(Inode& inode, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages)
+InodeVMObject::InodeVMObject(Inode& inode, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages, Bitmap inactive_pages)
     : VMObject(move(new_physical_pages))
     , m_inode(inode)
     , m_dirty_pages(move(dirty_pages))
+    , m_inactive_pages(move(inactive_pages))
 {
 }
 
-InodeVMObject::InodeVMObject(InodeVMObject const& other, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages)
+InodeVMObject::InodeVMObject(InodeVMObject const& other, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages, Bitmap inactive_pages)
     : VMObject(move(new_physical_pages))
     , m_inode(other.m_inode)
     , m_dirty_pages(move(dirty_pages))
+    , m_inactive_pages(move(inactive_pages))
 {
     for (size_t i = 0; i < page_count(); ++i)
         m_dirty_pages.set(i, other.m_dirty_pages.get(i));
@@ -58,6 +63,44 @@ void InodeVMObject::set_page_dirty(size_t page_index, bool is_dirty)
 {
     VERIFY(m_lock.is_locked());
     m_dirty_pages.set(page_index, is_dirty);
+    if (is_dirty)
+        m_inactive_pages.set(page_index, false);
+}
+
+bool InodeVMObject::is_page_inactive(size_t page_index) const
+{
+    VERIFY(m_lock.is_locked());
+    return m_inactive_pages.get(page_index);
+}
+
+void InodeVMObject::mark_page_active(size_t page_index)
+{
+    VERIFY(m_lock.is_locked());
+    m_inactive_pages.set(page_index, false);
+}
+
+size_t InodeVMObject::reclaim_inactive_clean_pages(size_t max_page_count)
+{
+    SpinlockLocker locker(m_lock);
+
+    size_t reclaimed_page_count = 0;
+    bool did_deactivate_pages = false;
+    for (size_t i = 0; i < page_count() && reclaimed_page_count < max_page_count; ++i) {
+        if (m_dirty_pages.get(i) || !m_physical_pages[i])
+            continue;
+        if (m_inactive_pages.get(i)) {
+            m_physical_pages[i] = nullptr;
+            m_inactive_pages.set(i, false);
+            ++reclaimed_page_count;
+        } else {
+            m_inactive_pages.set(i, true);
+            did_deactivate_pages = true;
+        }
+    }
+    // Evicted and newly inactive pages both have to be unmapped from all regions.
+    if (reclaimed_page_count || did_deactivate_pages)
+        remap_regions_locked();
+    return reclaimed_page_count;
 }
 
 int InodeVMObject::release_all_clean_pages()
@@ -73,6 +116,7 @@ int InodeVMObject::try_release_clean_pages(int page_amount)
     for (size_t i = 0; i < page_count() && count < page_amount; ++i) {
         if (!m_dirty_pages.get(i) && m_physical_pages[i]) {
             m_physical_pages[i] = nullptr;
+            m_inactive_pages.set(i, false);
             ++count;
         }
     }
@@ -91,4 +135,109 @@ u32 InodeVMObject::writable_mappings() const
     return count;
 }
 
+ErrorOr<size_t> InodeVMObject::read_in_pages(size_t first_page_index, size_t max_page_count, bool flush_instruction_cache)
+{
+    VERIFY(first_page_index < page_count());
+
+    size_t count = 0;
+    {
+        SpinlockLocker locker(m_lock);
+        max_page_count = min(max_page_count, page_count() - first_page_index);
+        while (count < max_page_count && physical_pages()[first_page_index + count].is_null())
+            ++count;
+    }
+    if (count == 0)
+        return 0;
+
+    Vector<NonnullRefPtr<PhysicalRAMPage>> new_physical_pages;
+    TRY(new_physical_pages.try_ensure_capacity(count));
+    for (size_t i = 0; i < count; ++i) {
+        auto page_or_error = MM.allocate_physical_page(MemoryManager::ShouldZeroFill::No);
+        if (page_or_error.is_error()) {
+            // Reading fewer pages ahead is better than failing the whole request.
+            if (i == 0)
+                return page_or_error.release_error();
+            break;
+        }
+        new_physical_pages.unchecked_append(page_or_error.release_value());
+    }
+
+    auto offset = static_cast<off_t>(first_page_index) * PAGE_SIZE;
+    size_t nread = 0;
+    if (new_physical_pages.size() == 1) {
+        u8 page_buffer[PAGE_SIZE];
+        auto buffer = UserOrKernelBuffer::for_kernel_buffer(page_buffer);
+        nread = TRY(m_inode->read_bytes(offset, PAGE_SIZE, buffer, nullptr));
+
+        // If we read less than a page, zero out the rest to avoid leaking uninitialized data.
+        if (nread < PAGE_SIZE)
+            memset(page_buffer + nread, 0, PAGE_SIZE - nread);
+
+        InterruptDisabler disabler;
+        u8* dest_ptr = MM.quickmap_page(*new_physical_pages.first());
+        memcpy(dest_ptr, page_buffer, PAGE_SIZE);
+        if (flush_instruction_cache) {
+            // Some architectures require an explicit synchronization operation after writing to memory that will be executed.
+            // This is required even if no instructions were previously fetched from that (physical) memory location,
+            // because some systems have an I-cache that is not coherent with the D-cache,
+            // resulting in the I-cache being filled with old values if the contents of the D-cache aren't written back yet.
+            Processor::flush_instruction_cache(VirtualAddress { dest_ptr }, PAGE_SIZE);
+        }
+        MM.unquickmap_page();
+    } else {
+        // Map all of the new pages next to each other, so the inode can read straight into them with a single request.
+        auto size = new_physical_pages.size() * PAGE_SIZE;
+        auto region = TRY(MM.allocate_kernel_region_with_physical_pages(new_physical_pages, "InodeVMObject read-in"sv, Region::Access::ReadWrite));
+        auto buffer = UserOrKernelBuffer::for_kernel_buffer(region->vaddr().as_ptr());
+        nread = TRY(m_inode->read_bytes(offset, size, buffer, nullptr));
+
+        if (nread < size)
+            memset(region->vaddr().offset(nread).as_ptr(), 0, size - nread);
+        if (flush_instruction_cache)
+            Processor::flush_instruction_cache(region->vaddr(), size);
+    }
+
+    size_t pages_read = ceil_div(nread, static_cast<size_t>(PAGE_SIZE));
+    SpinlockLocker locker(m_lock);
+    for (size_t i = 0; i < pages_read; ++i) {
+        auto& physical_page_slot = physical_pages()[first_page_index + i];
+        // Someone else can assign a new page while we were reading, in which case we keep theirs.
+        if (!physical_page_slot.is_null())
+            continue;
+        physical_page_slot = new_physical_pages[i];
+        // Something went wrong if a newly loaded page is already marked dirty
+        VERIFY(!is_page_dirty(first_page_index + i));
+    }
+    return pages_read;
+}
+
+ErrorOr<void> InodeVMObject::read_ahead(size_t first_page_index, size_t count)
+{
+    static constexpr size_t pages_per_read = 64;
+
+    auto end_page_index = min(first_page_index + count, page_count());
+    for (auto page_index = first_page_index; page_index < end_page_index;) {
+        bool is_cached;
+        {
+            SpinlockLocker locker(m_lock);
+            is_cached = !physical_pages()[page_index].is_null();
+        }
+        if (is_cached) {
+            ++page_index;
+            continue;
+        }
+
+        auto pages_read = TRY(read_in_pages(page_index, min(pages_per_read, end_page_index - page_index), false));
+        if (pages_read == 0) {
+            // We've reached the end of the inode (or lost a race, which we can just retry).
+            SpinlockLocker locker(m_lock);
+            if (physical_pages()[page_index].is_null())
+                break;
+            continue;
+        }
+        page_index += pages_read;
+    }
+    return {};
+}
+
 }
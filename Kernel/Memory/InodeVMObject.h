@@ -28,11 +28,26 @@ public:
     int release_all_clean_pages();
     int try_release_clean_pages(int page_amount);
 
+    // Page reclaim gives clean pages a second chance: The first pass only marks them as inactive and unmaps them.
+    // Touching an inactive page again causes a (cheap) fault that marks it active, and only pages that are still
+    // inactive on the next pass get evicted.
+    bool is_page_inactive(size_t page_index) const;
+    void mark_page_active(size_t page_index);
+    size_t reclaim_inactive_clean_pages(size_t max_page_count);
+
     u32 writable_mappings() const;
 
+    // Reads the run of not yet cached pages starting at first_page_index (up to page_count of them) with a single
+    // request to the inode, and returns how many pages ended up being read. This is 0 if the first page is beyond
+    // the end of the inode, or if it has already been read by someone else.
+    ErrorOr<size_t> read_in_pages(size_t first_page_index, size_t page_count, bool flush_instruction_cache);
+
+    // Brings all pages in the given range into memory, without mapping them anywhere.
+    ErrorOr<void> read_ahead(size_t first_page_index, size_t page_count);
+
 protected:
-    explicit InodeVMObject(Inode&, FixedArray<RefPtr<PhysicalRAMPage>>&&, Bitmap dirty_pages);
-    explicit InodeVMObject(InodeVMObject const&, FixedArray<RefPtr<PhysicalRAMPage>>&&, Bitmap dirty_pages);
+    explicit InodeVMObject(Inode&, FixedArray<RefPtr<PhysicalRAMPage>>&&, Bitmap dirty_pages, Bitmap inactive_pages);
+    explicit InodeVMObject(InodeVMObject const&, FixedArray<RefPtr<PhysicalRAMPage>>&&, Bitmap dirty_pages, Bitmap inactive_pages);
 
     InodeVMObject& operator=(InodeVMObject const&) = delete;
     InodeVMObject& operator=(InodeVMObject&&) = delete;
@@ -42,6 +57,7 @@ protected:
 
     NonnullRefPtr<Inode> const m_inode;
     Bitmap m_dirty_pages;
+    Bitmap m_inactive_pages;
 };
 
 }
@@ -15,6 +15,7 @@
 #include <Kernel/Arch/RegisterState.h>
 #include <Kernel/Boot/BootInfo.h>
 #include <Kernel/Boot/Multiboot.h>
+#include <Kernel/Debug.h>
 #include <Kernel/FileSystem/Inode.h>
 #include <Kernel/Firmware/DeviceTree/DeviceTree.h>
 #include <Kernel/Heap/kmalloc.h>
@@ -964,10 +965,15 @@ PageTableEntry* MemoryManager::pte(PageDirectory& page_directory, VirtualAddress
     u32 page_table_index = (vaddr.get() >> 12) & 0x1ff;
 
     auto* pd = quickmap_pd(const_cast<PageDirectory&>(page_directory), page_directory_table_index);
-    PageDirectoryEntry const& pde = pd[page_directory_index];
+    PageDirectoryEntry& pde = pd[page_directory_index];
     if (!pde.is_present())
         return nullptr;
 
+#if ARCH(X86_64)
+    if (pde.is_huge() && !split_huge_pde(page_directory, pde, page_directory_table_index, page_directory_index, vaddr))
+        return nullptr;
+#endif
+
     return &quickmap_pt(PhysicalAddress((FlatPtr)pde.page_table_base()))[page_table_index];
 }
 
@@ -981,8 +987,15 @@ PageTableEntry* MemoryManager::ensure_pte(PageDirectory& page_directory, Virtual
 
     auto* pd = quickmap_pd(page_directory, page_directory_table_index);
     auto& pde = pd[page_directory_index];
-    if (pde.is_present())
+    if (pde.is_present()) {
+#if ARCH(X86_64)
+        if (pde.is_huge() && !split_huge_pde(page_directory, pde, page_directory_table_index, page_directory_index, vaddr)) {
+            dbgln("MM: Unable to allocate page table to split huge page at {}", vaddr);
+            return nullptr;
+        }
+#endif
         return &quickmap_pt(PhysicalAddress(pde.page_table_base()))[page_table_index];
+    }
 
     bool did_purge = false;
     auto page_table_or_error = allocate_physical_page(ShouldZeroFill::Yes, &did_purge);
@@ -1022,6 +1035,14 @@ void MemoryManager::release_pte(PageDirectory& page_directory, VirtualAddress va
 
     auto* pd = quickmap_pd(page_directory, page_directory_table_index);
     PageDirectoryEntry& pde = pd[page_directory_index];
+#if ARCH(X86_64)
+    if (pde.is_present() && pde.is_huge()) {
+        // Huge pages are only ever mapped for blocks that lie entirely within a single region, and regions are always unmapped as a whole.
+        // So instead of splitting the huge page just to clear its page table again, we can drop the whole mapping right away.
+        pde.clear();
+        return;
+    }
+#endif
     if (pde.is_present()) {
         auto* page_table = quickmap_pt(PhysicalAddress((FlatPtr)pde.page_table_base()));
         auto& pte = page_table[page_table_index];
@@ -1045,6 +1066,76 @@ void MemoryManager::release_pte(PageDirectory& page_directory, VirtualAddress va
     }
 }
 
+#if ARCH(X86_64)
+bool MemoryManager::split_huge_pde(PageDirectory& page_directory, PageDirectoryEntry& pde, u32 page_directory_table_index, u32 page_directory_index, VirtualAddress vaddr)
+{
+    VERIFY(pde.is_present() && pde.is_huge());
+
+    bool did_purge = false;
+    auto page_table_or_error = allocate_physical_page(ShouldZeroFill::No, &did_purge);
+    if (page_table_or_error.is_error())
+        return false;
+    auto page_table = page_table_or_error.release_value();
+
+    auto* pd = quickmap_pd(page_directory, page_directory_table_index);
+    if (did_purge) {
+        // See the comment in ensure_pte() as for why the pd has to be re-mapped.
+        VERIFY(&pde == &pd[page_directory_index]);
+        VERIFY(pde.is_present() && pde.is_huge()); // Should have not changed
+    }
+
+    // Recreate the huge mapping one small page at a time, with the same permissions.
+    auto huge_page_base = pde.page_table_base();
+    VERIFY(huge_page_base % HUGE_PAGE_SIZE == 0);
+    auto* ptes = quickmap_pt(page_table->paddr());
+    for (size_t i = 0; i < HUGE_PAGE_SIZE / PAGE_SIZE; ++i) {
+        auto& pte = ptes[i];
+        pte.clear();
+        // NOTE: We only ever create huge mappings for normal memory, see Region::try_map_huge_page().
+        pte.set_memory_type(MemoryType::Normal);
+        pte.set_physical_page_base(huge_page_base + i * PAGE_SIZE);
+        pte.set_present(true);
+        pte.set_writable(pde.is_writable());
+        pte.set_user_allowed(pde.is_user_allowed());
+        pte.set_execute_disabled(pde.is_execute_disabled());
+        pte.set_global(pde.is_global());
+    }
+
+    pde.clear();
+    pde.set_page_table_base(page_table->paddr().get());
+    pde.set_user_allowed(true);
+    pde.set_present(true);
+    pde.set_writable(true);
+    pde.set_global(&page_directory == m_kernel_page_directory.ptr());
+
+    // NOTE: This leaked ref is matched by the unref in MemoryManager::release_pte()
+    (void)page_table.leak_ref();
+
+    // The translations stay the same, but the processor must not keep using the huge TLB entry alongside the new small ones.
+    flush_tlb(&page_directory, VirtualAddress { vaddr.get() & ~(HUGE_PAGE_SIZE - 1) }, HUGE_PAGE_SIZE / PAGE_SIZE);
+    return true;
+}
+
+PageDirectoryEntry* MemoryManager::ensure_huge_pde(PageDirectory& page_directory, VirtualAddress vaddr)
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    VERIFY(page_directory.get_lock().is_locked_by_current_processor());
+    VERIFY(vaddr.get() % HUGE_PAGE_SIZE == 0);
+    u32 page_directory_table_index = (vaddr.get() >> 30) & 0x1ff;
+    u32 page_directory_index = (vaddr.get() >> 21) & 0x1ff;
+
+    auto* pd = quickmap_pd(page_directory, page_directory_table_index);
+    auto& pde = pd[page_directory_index];
+    if (pde.is_present() && !pde.is_huge()) {
+        // The caller owns the entire range covered by this page table, so whatever the
+        // table currently maps is about to be replaced by the huge page.
+        get_physical_page_entry(PhysicalAddress { pde.page_table_base() }).allocated.physical_page.unref();
+    }
+    pde.clear();
+    return &pde;
+}
+#endif
+
 UNMAP_AFTER_INIT void MemoryManager::initialize(u32 cpu)
 {
     ProcessorSpecific<MemoryManagerData>::initialize();
@@ -1062,6 +1153,29 @@ Region* MemoryManager::find_user_region_from_vaddr(AddressSpace& space, VirtualA
     return space.find_region_containing({ vaddr, 1 });
 }
 
+RefPtr<PhysicalRAMPage> MemoryManager::physical_page_for_kernel_vaddr(VirtualAddress vaddr)
+{
+    size_t page_index_in_vmobject = 0;
+    auto vmobject = m_global_data.with([&](auto& global_data) -> LockRefPtr<VMObject> {
+        auto* region = global_data.region_tree.find_region_containing(vaddr);
+        if (!region || !region->vmobject().is_anonymous())
+            return nullptr;
+        page_index_in_vmobject = region->translate_to_vmobject_page(region->page_index_from_address(vaddr));
+        return region->vmobject();
+    });
+    if (!vmobject)
+        return nullptr;
+
+    // NOTE: We can't take the VMObject lock while holding the global one, since page faults take them the other way around.
+    SpinlockLocker vmobject_locker(vmobject->m_lock);
+    if (page_index_in_vmobject >= vmobject->page_count())
+        return nullptr;
+    RefPtr<PhysicalRAMPage> page = vmobject->physical_pages()[page_index_in_vmobject];
+    if (!page || page->is_shared_zero_page() || page->is_lazy_committed_page())
+        return nullptr;
+    return page;
+}
+
 void MemoryManager::validate_syscall_preconditions(Process& process, RegisterState const& regs)
 {
     bool should_crash = false;
@@ -1349,7 +1463,14 @@ void MemoryManager::deallocate_physical_page(PhysicalAddress paddr)
     });
 }
 
-RefPtr<PhysicalRAMPage> MemoryManager::find_free_physical_page(bool committed, GlobalData& global_data)
+static RefPtr<PhysicalRAMPage> take_prezeroed_page(auto& global_data)
+{
+    if (global_data.prezeroed_page_count == 0)
+        return nullptr;
+    return move(global_data.prezeroed_pages[--global_data.prezeroed_page_count]);
+}
+
+RefPtr<PhysicalRAMPage> MemoryManager::find_free_physical_page(bool committed, GlobalData& global_data, bool* is_zeroed)
 {
     RefPtr<PhysicalRAMPage> page;
     if (committed) {
@@ -1364,27 +1485,71 @@ RefPtr<PhysicalRAMPage> MemoryManager::find_free_physical_page(bool committed, G
         }
         global_data.system_memory_info.physical_pages_uncommitted--;
     }
-    for (auto& region : global_data.physical_regions) {
-        page = region->take_free_page();
-        if (!page.is_null()) {
-            ++global_data.system_memory_info.physical_pages_used;
-            break;
+
+    // Callers that are going to zero the page anyway get one that has already been zeroed, if there is one.
+    if (is_zeroed) {
+        page = take_prezeroed_page(global_data);
+        *is_zeroed = !page.is_null();
+    }
+
+    if (page.is_null()) {
+        for (auto& region : global_data.physical_regions) {
+            page = region->take_free_page();
+            if (!page.is_null())
+                break;
         }
     }
 
-    if (page.is_null())
+    // The pre-zeroed pages still count as free, so we have to fall back to them once the regions run dry.
+    if (page.is_null()) {
+        page = take_prezeroed_page(global_data);
+        if (is_zeroed)
+            *is_zeroed = !page.is_null();
+    }
+
+    if (page.is_null()) {
         dbgln("MM: couldn't find free physical page. Continuing...");
+        return nullptr;
+    }
 
+    ++global_data.system_memory_info.physical_pages_used;
     return page;
 }
 
+Vector<NonnullRefPtr<PhysicalRAMPage>> MemoryManager::allocate_committed_contiguous_physical_pages(Badge<CommittedPhysicalPageSet>, size_t page_count, size_t alignment)
+{
+    auto physical_pages = m_global_data.with([&](auto& global_data) -> Vector<NonnullRefPtr<PhysicalRAMPage>> {
+        // Draw from the committed pages pool, the caller has made sure we have enough of these.
+        VERIFY(global_data.system_memory_info.physical_pages_committed >= page_count);
+
+        for (auto& physical_region : global_data.physical_regions) {
+            auto physical_pages = physical_region->take_contiguous_free_pages(page_count, alignment);
+            if (!physical_pages.is_empty()) {
+                global_data.system_memory_info.physical_pages_committed -= page_count;
+                global_data.system_memory_info.physical_pages_used += page_count;
+                return physical_pages;
+            }
+        }
+        return {};
+    });
+
+    for (auto& page : physical_pages) {
+        InterruptDisabler disabler;
+        auto* ptr = quickmap_page(page);
+        memset(ptr, 0, PAGE_SIZE);
+        unquickmap_page();
+    }
+    return physical_pages;
+}
+
 NonnullRefPtr<PhysicalRAMPage> MemoryManager::allocate_committed_physical_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill should_zero_fill)
 {
+    bool is_zeroed = false;
     auto page = m_global_data.with([&](auto& global_data) {
-        return find_free_physical_page(true, global_data);
+        return find_free_physical_page(true, global_data, should_zero_fill == ShouldZeroFill::Yes ? &is_zeroed : nullptr);
     });
     VERIFY(page);
-    if (should_zero_fill == ShouldZeroFill::Yes) {
+    if (should_zero_fill == ShouldZeroFill::Yes && !is_zeroed) {
         InterruptDisabler disabler;
         // FIXME: To prevent aliasing memory with different memory types, this page should be mapped using the same memory type it will use later for the actual mapping.
         //        (See the comment above the memset in allocate_contiguous_physical_pages.)
@@ -1397,8 +1562,12 @@ NonnullRefPtr<PhysicalRAMPage> MemoryManager::allocate_committed_physical_page(B
 
 ErrorOr<NonnullRefPtr<PhysicalRAMPage>> MemoryManager::allocate_physical_page(ShouldZeroFill should_zero_fill, bool* did_purge, MemoryType memory_type_for_zero_fill)
 {
+    // Pre-zeroed pages have been zeroed through a normal memory mapping, so they are only suitable for normal memory.
+    bool is_zeroed = false;
+    bool* is_zeroed_pointer = should_zero_fill == ShouldZeroFill::Yes && memory_type_for_zero_fill == MemoryType::Normal ? &is_zeroed : nullptr;
+
     return m_global_data.with([&](auto& global_data) -> ErrorOr<NonnullRefPtr<PhysicalRAMPage>> {
-        auto page = find_free_physical_page(false, global_data);
+        auto page = find_free_physical_page(false, global_data, is_zeroed_pointer);
         bool purged_pages = false;
 
         if (!page) {
@@ -1440,7 +1609,7 @@ ErrorOr<NonnullRefPtr<PhysicalRAMPage>> MemoryManager::allocate_physical_page(Sh
             return ENOMEM;
         }
 
-        if (should_zero_fill == ShouldZeroFill::Yes) {
+        if (should_zero_fill == ShouldZeroFill::Yes && !is_zeroed) {
             auto* ptr = quickmap_page(*page, memory_type_for_zero_fill);
             memset(ptr, 0, PAGE_SIZE);
             unquickmap_page();
@@ -1578,6 +1747,15 @@ void MemoryManager::unquickmap_page()
     mm_data.m_quickmap_in_use.unlock(mm_data.m_quickmap_previous_interrupts_state);
 }
 
+void MemoryManager::copy_from_physical_page(PhysicalRAMPage& page, size_t offset, Bytes destination)
+{
+    VERIFY(offset + destination.size() <= PAGE_SIZE);
+    InterruptDisabler disabler;
+    auto* source = quickmap_page(page);
+    memcpy(destination.data(), source + offset, destination.size());
+    unquickmap_page();
+}
+
 bool MemoryManager::validate_user_stack(AddressSpace& space, VirtualAddress vaddr) const
 {
     if (!is_user_address(vaddr))
@@ -1648,6 +1826,15 @@ NonnullRefPtr<PhysicalRAMPage> CommittedPhysicalPageSet::take_one()
     return MM.allocate_committed_physical_page({}, MemoryManager::ShouldZeroFill::Yes);
 }
 
+Vector<NonnullRefPtr<PhysicalRAMPage>> CommittedPhysicalPageSet::try_take_contiguous(size_t count, size_t alignment)
+{
+    VERIFY(m_page_count >= count);
+    auto physical_pages = MM.allocate_committed_contiguous_physical_pages({}, count, alignment);
+    if (!physical_pages.is_empty())
+        m_page_count -= count;
+    return physical_pages;
+}
+
 void CommittedPhysicalPageSet::uncommit_one()
 {
     VERIFY(m_page_count > 0);
@@ -1679,6 +1866,141 @@ ErrorOr<NonnullOwnPtr<Region>> MemoryManager::allocate_unbacked_region_anywhere(
     return region;
 }
 
+MemoryManager::MemoryPressureLevel MemoryManager::memory_pressure_level()
+{
+    auto info = get_system_memory_info();
+    if (info.physical_pages_uncommitted < info.physical_pages / 64)
+        return MemoryPressureLevel::Critical;
+    if (info.physical_pages_uncommitted < info.physical_pages / 16)
+        return MemoryPressureLevel::Low;
+    return MemoryPressureLevel::Normal;
+}
+
+StringView MemoryManager::memory_pressure_level_name(MemoryPressureLevel level)
+{
+    switch (level) {
+    case MemoryPressureLevel::Normal:
+        return "normal"sv;
+    case MemoryPressureLevel::Low:
+        return "low"sv;
+    case MemoryPressureLevel::Critical:
+        return "critical"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+size_t MemoryManager::page_reclaim_target()
+{
+    auto info = get_system_memory_info();
+    auto normal_watermark = info.physical_pages / 16;
+    if (info.physical_pages_uncommitted >= normal_watermark)
+        return 0;
+    return normal_watermark - info.physical_pages_uncommitted;
+}
+
+size_t MemoryManager::reclaim_pages(size_t max_page_count)
+{
+    size_t reclaimed_page_count = 0;
+
+    // NOTE: Reclaiming pages remaps regions, which we can't do while iterating over all VMObjects, so collect them first.
+    auto collect_vmobjects = [](auto& vmobjects, auto filter) {
+        for_each_vmobject([&](auto& vmobject) {
+            auto* matching_vmobject = filter(vmobject);
+            if (!matching_vmobject)
+                return IterationDecision::Continue;
+            if (vmobjects.try_append(*matching_vmobject).is_error())
+                return IterationDecision::Break;
+            return IterationDecision::Continue;
+        });
+    };
+
+    if (memory_pressure_level() == MemoryPressureLevel::Critical) {
+        Vector<NonnullLockRefPtr<AnonymousVMObject>> anonymous_vmobjects;
+        collect_vmobjects(anonymous_vmobjects, [](VMObject& vmobject) -> AnonymousVMObject* {
+            if (!vmobject.is_anonymous())
+                return nullptr;
+            auto& anonymous_vmobject = static_cast<AnonymousVMObject&>(vmobject);
+            if (!anonymous_vmobject.is_purgeable() || !anonymous_vmobject.is_volatile())
+                return nullptr;
+            return &anonymous_vmobject;
+        });
+        for (auto& vmobject : anonymous_vmobjects)
+            reclaimed_page_count += vmobject->purge();
+    }
+
+    Vector<NonnullLockRefPtr<InodeVMObject>> inode_vmobjects;
+    collect_vmobjects(inode_vmobjects, [](VMObject& vmobject) -> InodeVMObject* {
+        if (!vmobject.is_inode())
+            return nullptr;
+        return &static_cast<InodeVMObject&>(vmobject);
+    });
+    for (auto& vmobject : inode_vmobjects) {
+        if (reclaimed_page_count >= max_page_count)
+            break;
+        reclaimed_page_count += vmobject->reclaim_inactive_clean_pages(max_page_count - reclaimed_page_count);
+    }
+
+    if (reclaimed_page_count)
+        dbgln_if(PAGE_RECLAIM_DEBUG, "MM: Page reclaimer freed {} pages", reclaimed_page_count);
+    m_reclaimed_page_count.fetch_add(reclaimed_page_count, AK::MemoryOrder::memory_order_relaxed);
+    return reclaimed_page_count;
+}
+
+static void zero_page_bypassing_caches(u8* page)
+{
+#if ARCH(X86_64)
+    // Non-temporal stores don't pull the page into the cache, so zeroing pages ahead of time
+    // doesn't evict anything that's actually in use.
+    auto* qwords = reinterpret_cast<u64*>(page);
+    for (size_t i = 0; i < PAGE_SIZE / sizeof(u64); i += 4) {
+        asm volatile(
+            "movnti %1, 0(%0)\n"
+            "movnti %1, 8(%0)\n"
+            "movnti %1, 16(%0)\n"
+            "movnti %1, 24(%0)\n" ::"r"(&qwords[i]),
+            "r"(0ull)
+            : "memory");
+    }
+    asm volatile("sfence" ::: "memory");
+#else
+    memset(page, 0, PAGE_SIZE);
+#endif
+}
+
+bool MemoryManager::prezero_one_free_page()
+{
+    // Don't hold on to free pages when we're short on them, they might be needed for contiguous allocations.
+    if (memory_pressure_level() != MemoryPressureLevel::Normal)
+        return false;
+
+    auto page = m_global_data.with([&](auto& global_data) -> RefPtr<PhysicalRAMPage> {
+        if (global_data.prezeroed_page_count + global_data.prezeroed_pages_in_flight >= prezeroed_page_pool_capacity)
+            return nullptr;
+        for (auto& region : global_data.physical_regions) {
+            if (auto page = region->take_free_page()) {
+                ++global_data.prezeroed_pages_in_flight;
+                return page;
+            }
+        }
+        return nullptr;
+    });
+    if (!page)
+        return false;
+
+    {
+        InterruptDisabler disabler;
+        auto* ptr = quickmap_page(*page);
+        zero_page_bypassing_caches(ptr);
+        unquickmap_page();
+    }
+
+    m_global_data.with([&](auto& global_data) {
+        --global_data.prezeroed_pages_in_flight;
+        global_data.prezeroed_pages[global_data.prezeroed_page_count++] = page.release_nonnull();
+    });
+    return true;
+}
+
 MemoryManager::SystemMemoryInfo MemoryManager::get_system_memory_info()
 {
     return m_global_data.with([&](auto& global_data) {
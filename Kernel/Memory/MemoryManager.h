@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/Concepts.h>
 #include <AK/HashTable.h>
@@ -27,6 +28,9 @@ namespace Kernel::Memory {
 class PageDirectoryEntry;
 class PageTableEntry;
 
+// The size of a page that's mapped by a single page directory entry instead of a page table.
+constexpr size_t HUGE_PAGE_SIZE = 512 * PAGE_SIZE;
+
 ErrorOr<FlatPtr> page_round_up(FlatPtr x);
 
 constexpr FlatPtr page_round_down(FlatPtr x)
@@ -116,6 +120,8 @@ public:
     size_t page_count() const { return m_page_count; }
 
     [[nodiscard]] NonnullRefPtr<PhysicalRAMPage> take_one();
+    // Returns an empty vector if there is no suitably aligned run of free physical pages, in which case nothing is taken.
+    [[nodiscard]] Vector<NonnullRefPtr<PhysicalRAMPage>> try_take_contiguous(size_t count, size_t alignment);
     void uncommit_one();
 
     void operator=(CommittedPhysicalPageSet&&) = delete;
@@ -125,8 +131,10 @@ private:
 };
 
 class MemoryManager {
+    friend class AddressSpace;
     friend class PageDirectory;
     friend class AnonymousVMObject;
+    friend class InodeVMObject;
     friend class Region;
     friend class RegionTree;
     friend class VMObject;
@@ -166,10 +174,14 @@ public:
     void uncommit_physical_pages(Badge<CommittedPhysicalPageSet>, size_t page_count);
 
     NonnullRefPtr<PhysicalRAMPage> allocate_committed_physical_page(Badge<CommittedPhysicalPageSet>, ShouldZeroFill = ShouldZeroFill::Yes);
+    Vector<NonnullRefPtr<PhysicalRAMPage>> allocate_committed_contiguous_physical_pages(Badge<CommittedPhysicalPageSet>, size_t page_count, size_t alignment);
     ErrorOr<NonnullRefPtr<PhysicalRAMPage>> allocate_physical_page(ShouldZeroFill = ShouldZeroFill::Yes, bool* did_purge = nullptr, MemoryType memory_type_for_zero_fill = MemoryType::Normal);
     ErrorOr<Vector<NonnullRefPtr<PhysicalRAMPage>>> allocate_contiguous_physical_pages(size_t size, MemoryType memory_type_for_zero_fill);
     void deallocate_physical_page(PhysicalAddress);
 
+    // Copies out of a page that doesn't have to be mapped anywhere.
+    void copy_from_physical_page(PhysicalRAMPage&, size_t offset, Bytes destination);
+
     ErrorOr<NonnullOwnPtr<Region>> allocate_contiguous_kernel_region(size_t, StringView name, Region::Access access, MemoryType = MemoryType::Normal);
     ErrorOr<NonnullOwnPtr<Region>> allocate_dma_buffer_page(StringView name, Region::Access access, RefPtr<PhysicalRAMPage>& dma_buffer_page, MemoryType = MemoryType::NonCacheable);
     ErrorOr<NonnullOwnPtr<Region>> allocate_dma_buffer_page(StringView name, Region::Access access, MemoryType = MemoryType::NonCacheable);
@@ -191,6 +203,27 @@ public:
 
     SystemMemoryInfo get_system_memory_info();
 
+    // How close we are to running out of physical pages that aren't committed to anything yet.
+    enum class MemoryPressureLevel : u8 {
+        Normal,
+        Low,
+        Critical,
+    };
+    MemoryPressureLevel memory_pressure_level();
+    static StringView memory_pressure_level_name(MemoryPressureLevel);
+
+    // The number of pages that would need to be freed to get back to MemoryPressureLevel::Normal.
+    size_t page_reclaim_target();
+
+    // Runs one pass of the page reclaimer, which evicts up to max_page_count cold clean file-backed pages.
+    // Under critical pressure, volatile purgeable memory gets purged as well.
+    size_t reclaim_pages(size_t max_page_count);
+    u64 reclaimed_page_count() const { return m_reclaimed_page_count.load(AK::MemoryOrder::memory_order_relaxed); }
+
+    // Called by idle processors to zero a free page ahead of time, so that allocations asking for a
+    // zero-filled page don't have to. Returns false when there is nothing left to do.
+    bool prezero_one_free_page();
+
     template<IteratorFunction<VMObject&> Callback>
     static void for_each_vmobject(Callback callback)
     {
@@ -213,6 +246,9 @@ public:
     }
 
     static Region* find_user_region_from_vaddr(AddressSpace&, VirtualAddress);
+
+    // Returns the page of RAM that backs this address in an anonymous kernel region, if there is one already.
+    RefPtr<PhysicalRAMPage> physical_page_for_kernel_vaddr(VirtualAddress);
     static void validate_syscall_preconditions(Process&, RegisterState const&);
 
     void dump_kernel_regions();
@@ -235,6 +271,8 @@ private:
     MemoryManager();
     ~MemoryManager();
 
+    static constexpr size_t prezeroed_page_pool_capacity = 512;
+
     struct GlobalData {
         GlobalData();
 
@@ -248,6 +286,12 @@ private:
         Vector<UsedMemoryRange> used_memory_ranges;
         Vector<PhysicalMemoryRange> physical_memory_ranges;
         Vector<ContiguousReservedMemoryRange> reserved_memory_ranges;
+
+        // Free pages that have already been zeroed by an idle processor. They have been taken out of the
+        // physical regions, but still count as free (i.e. committed or uncommitted) pages.
+        Array<RefPtr<PhysicalRAMPage>, prezeroed_page_pool_capacity> prezeroed_pages;
+        size_t prezeroed_page_count { 0 };
+        size_t prezeroed_pages_in_flight { 0 };
     };
 
     void initialize_physical_pages(GlobalData& global_data);
@@ -267,7 +311,7 @@ private:
     static void flush_tlb_local(VirtualAddress, size_t page_count = 1);
     static void flush_tlb(PageDirectory const*, VirtualAddress, size_t page_count = 1);
 
-    RefPtr<PhysicalRAMPage> find_free_physical_page(bool, GlobalData&);
+    RefPtr<PhysicalRAMPage> find_free_physical_page(bool, GlobalData&, bool* is_zeroed = nullptr);
 
     ALWAYS_INLINE u8* quickmap_page(PhysicalRAMPage& page, MemoryType memory_type = Memory::MemoryType::Normal)
     {
@@ -286,6 +330,10 @@ private:
         No
     };
     void release_pte(PageDirectory&, VirtualAddress, IsLastPTERelease);
+#if ARCH(X86_64)
+    bool split_huge_pde(PageDirectory&, PageDirectoryEntry&, u32 page_directory_table_index, u32 page_directory_index, VirtualAddress);
+    PageDirectoryEntry* ensure_huge_pde(PageDirectory&, VirtualAddress);
+#endif
 
     // NOTE: These are outside of GlobalData as they are only assigned on startup,
     //       and then never change. Atomic ref-counting covers that case without
@@ -300,6 +348,8 @@ private:
     size_t m_physical_page_entries_count { 0 };
 
     SpinlockProtected<GlobalData, LockRank::None> m_global_data;
+
+    Atomic<u64> m_reclaimed_page_count { 0 };
 };
 
 inline bool PhysicalRAMPage::is_shared_zero_page() const
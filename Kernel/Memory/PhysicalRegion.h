@@ -35,7 +35,8 @@ public:
     OwnPtr<PhysicalRegion> try_take_pages_from_beginning(size_t);
 
     RefPtr<PhysicalRAMPage> take_free_page();
-    Vector<NonnullRefPtr<PhysicalRAMPage>> take_contiguous_free_pages(size_t count);
+    // NOTE: The alignment can't be larger than the buddy block that backs the allocation, which is `count` rounded up to the next power of two.
+    Vector<NonnullRefPtr<PhysicalRAMPage>> take_contiguous_free_pages(size_t count, size_t alignment = PAGE_SIZE);
     void return_page(PhysicalAddress);
 
 private:
@@ -24,23 +24,25 @@ ErrorOr<NonnullLockRefPtr<PrivateInodeVMObject>> PrivateInodeVMObject::try_creat
     VERIFY(size > 0);
     auto new_physical_pages = TRY(VMObject::try_create_physical_pages(size));
     auto dirty_pages = TRY(Bitmap::create(new_physical_pages.size(), false));
-    return adopt_nonnull_lock_ref_or_enomem(new (nothrow) PrivateInodeVMObject(inode, move(new_physical_pages), move(dirty_pages)));
+    auto inactive_pages = TRY(Bitmap::create(new_physical_pages.size(), false));
+    return adopt_nonnull_lock_ref_or_enomem(new (nothrow) PrivateInodeVMObject(inode, move(new_physical_pages), move(dirty_pages), move(inactive_pages)));
 }
 
 ErrorOr<NonnullLockRefPtr<VMObject>> PrivateInodeVMObject::try_clone()
 {
     auto new_physical_pages = TRY(this->try_clone_physical_pages());
     auto dirty_pages = TRY(Bitmap::create(new_physical_pages.size(), false));
-    return adopt_nonnull_lock_ref_or_enomem<VMObject>(new (nothrow) PrivateInodeVMObject(*this, move(new_physical_pages), move(dirty_pages)));
+    auto inactive_pages = TRY(Bitmap::create(new_physical_pages.size(), false));
+    return adopt_nonnull_lock_ref_or_enomem<VMObject>(new (nothrow) PrivateInodeVMObject(*this, move(new_physical_pages), move(dirty_pages), move(inactive_pages)));
 }
 
-PrivateInodeVMObject::PrivateInodeVMObject(Inode& inode, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages)
-    : InodeVMObject(inode, move(new_physical_pages), move(dirty_pages))
+PrivateInodeVMObject::PrivateInodeVMObject(Inode& inode, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages, Bitmap inactive_pages)
+    : InodeVMObject(inode, move(new_physical_pages), move(dirty_pages), move(inactive_pages))
 {
 }
 
-PrivateInodeVMObject::PrivateInodeVMObject(PrivateInodeVMObject const& other, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages)
-    : InodeVMObject(other, move(new_physical_pages), move(dirty_pages))
+PrivateInodeVMObject::PrivateInodeVMObject(PrivateInodeVMObject const& other, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages, Bitmap inactive_pages)
+    : InodeVMObject(other, move(new_physical_pages), move(dirty_pages), move(inactive_pages))
 {
 }
 
@@ -22,6 +22,8 @@
 
 namespace Kernel::Memory {
 
+DEFINE_KMEM_CACHE(Region)
+
 Region::Region()
     : m_range(VirtualRange({}, 0))
 {
@@ -118,6 +120,7 @@ ErrorOr<NonnullOwnPtr<Region>> Region::try_clone()
         region->set_mmap(m_mmap, m_mmapped_from_readable, m_mmapped_from_writable);
         region->set_shared(m_shared);
         region->set_syscall_region(is_syscall_region());
+        region->set_access_pattern(m_access_pattern);
         return region;
     }
 
@@ -143,6 +146,8 @@ ErrorOr<NonnullOwnPtr<Region>> Region::try_clone()
     }
     clone_region->set_syscall_region(is_syscall_region());
     clone_region->set_mmap(m_mmap, m_mmapped_from_readable, m_mmapped_from_writable);
+    clone_region->set_wants_huge_pages(m_wants_huge_pages);
+    clone_region->set_access_pattern(m_access_pattern);
     return clone_region;
 }
 
@@ -221,9 +226,23 @@ bool Region::should_dirty_on_write(size_t page_index, ShouldLockVMObject should_
     return is_not_dirty(page_index);
 }
 
+bool Region::is_page_inactive(size_t page_index, ShouldLockVMObject should_lock_vmobject) const
+{
+    if (!vmobject().is_inode())
+        return false;
+
+    auto& inode_vmobject = static_cast<InodeVMObject const&>(vmobject());
+    if (should_lock_vmobject == ShouldLockVMObject::Yes) {
+        SpinlockLocker locker(vmobject().m_lock);
+        return inode_vmobject.is_page_inactive(first_page_index() + page_index);
+    }
+    return inode_vmobject.is_page_inactive(first_page_index() + page_index);
+}
+
 bool Region::map_individual_page_impl(size_t page_index, RefPtr<PhysicalRAMPage> page, ShouldLockVMObject should_lock_vmobject)
 {
-    if (!page)
+    // Inactive pages stay unmapped, so we notice when they get used again (see InodeVMObject::reclaim_inactive_clean_pages()).
+    if (!page || is_page_inactive(page_index, should_lock_vmobject))
         return map_individual_page_impl(page_index, {}, false, false, should_lock_vmobject);
     return map_individual_page_impl(page_index, page->paddr(), is_readable(), is_writable() && !page->is_shared_zero_page() && !page->is_lazy_committed_page(), should_lock_vmobject);
 }
@@ -367,6 +386,18 @@ ErrorOr<void> Region::map(PageDirectory& page_directory, PhysicalAddress paddr,
     return ENOMEM;
 }
 
+bool Region::can_be_mapped_lazily() const
+{
+    return vmobject().is_anonymous() || vmobject().is_inode();
+}
+
+void Region::map_lazily(PageDirectory& page_directory)
+{
+    VERIFY(can_be_mapped_lazily());
+    SpinlockLocker page_lock(page_directory.get_lock());
+    set_page_directory(page_directory);
+}
+
 void Region::remap_impl(ShouldLockVMObject should_lock_vmobject)
 {
     VERIFY(m_page_directory);
@@ -430,6 +461,12 @@ PageFaultResponse Region::handle_fault(PageFault const& fault)
                 return PageFaultResponse::OutOfMemory;
             return PageFaultResponse::Continue;
         }
+        if (page_slot) {
+            // The page is there, but its page table entry was never populated because the region was mapped lazily.
+            if (!remap_vmobject_page(translate_to_vmobject_page(page_index_in_region), *page_slot, ShouldLockVMObject::No))
+                return PageFaultResponse::OutOfMemory;
+            return PageFaultResponse::Continue;
+        }
         dbgln("BUG! Unexpected NP fault at {}", fault.vaddr());
         dbgln("     - Physical page slot pointer: {:p}", page_slot.ptr());
         if (page_slot) {
@@ -512,6 +549,13 @@ PageFaultResponse Region::handle_fault(PageFault const& fault)
         return PageFaultResponse::Continue;
     }
 
+    if (page_slot) {
+        // The page is there, but its page table entry was never populated because the region was mapped lazily.
+        if (!remap_vmobject_page(translate_to_vmobject_page(page_index_in_region), *page_slot, ShouldLockVMObject::No))
+            return PageFaultResponse::OutOfMemory;
+        return PageFaultResponse::Continue;
+    }
+
     dbgln("Unexpected page fault in Region({})[{}] at {}", this, page_index_in_region, fault.vaddr());
     return PageFaultResponse::ShouldCrash;
 #endif
@@ -528,6 +572,9 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region, Physica
     if (current_thread != nullptr)
         current_thread->did_zero_fault();
 
+    if (page_in_slot_at_time_of_fault.is_lazy_committed_page() && try_map_huge_page(page_index_in_region))
+        return PageFaultResponse::Continue;
+
     RefPtr<PhysicalRAMPage> new_physical_page;
 
     if (page_in_slot_at_time_of_fault.is_lazy_committed_page()) {
@@ -570,6 +617,57 @@ PageFaultResponse Region::handle_zero_fault(size_t page_index_in_region, Physica
     return PageFaultResponse::Continue;
 }
 
+bool Region::try_map_huge_page(size_t page_index_in_region)
+{
+#if ARCH(X86_64)
+    // FIXME: Support huge pages on other architectures as well.
+    if (!m_wants_huge_pages || m_shared || !is_user() || m_memory_type != MemoryType::Normal || !is_writable())
+        return false;
+
+    // Only map huge pages for blocks that lie entirely within this region, so no other region can end up sharing the page directory entry.
+    auto block_base = VirtualAddress { vaddr_from_page_index(page_index_in_region).get() & ~(HUGE_PAGE_SIZE - 1) };
+    if (block_base < vaddr() || block_base.offset(HUGE_PAGE_SIZE) > range().end())
+        return false;
+
+    auto& anonymous_vmobject = static_cast<AnonymousVMObject&>(vmobject());
+    auto first_page_index_in_region = page_index_from_address(block_base);
+    constexpr size_t pages_per_huge_page = HUGE_PAGE_SIZE / PAGE_SIZE;
+
+    SpinlockLocker vmobject_locker(anonymous_vmobject.m_lock);
+    for (size_t i = 0; i < pages_per_huge_page; ++i) {
+        // Any page that has already been faulted in has to stay where it is, so we can't use a huge page for this block.
+        auto& page_slot = physical_page_slot(first_page_index_in_region + i);
+        if (!page_slot || !page_slot->is_lazy_committed_page())
+            return false;
+    }
+
+    // If physical memory is too fragmented for a suitably aligned block, we fall back to small pages.
+    auto physical_pages = anonymous_vmobject.try_allocate_committed_huge_page({});
+    if (physical_pages.is_empty())
+        return false;
+    dbgln_if(PAGE_FAULT_DEBUG, "      >> ALLOCATED COMMITTED HUGE {}", physical_pages.first()->paddr());
+
+    for (size_t i = 0; i < pages_per_huge_page; ++i)
+        physical_page_slot(first_page_index_in_region + i) = physical_pages[i];
+
+    SpinlockLocker page_lock(m_page_directory->get_lock());
+    auto* pde = MM.ensure_huge_pde(*m_page_directory, block_base);
+    pde->set_page_table_base(physical_pages.first()->paddr().get());
+    pde->set_huge(true);
+    pde->set_memory_type(m_memory_type);
+    pde->set_present(true);
+    pde->set_writable(true);
+    if (Processor::current().has_nx())
+        pde->set_execute_disabled(!is_executable());
+    pde->set_user_allowed(true);
+    MemoryManager::flush_tlb(m_page_directory, block_base, pages_per_huge_page);
+    return true;
+#else
+    (void)page_index_in_region;
+    return false;
+#endif
+}
+
 PageFaultResponse Region::handle_cow_fault(size_t page_index_in_region)
 {
     auto current_thread = Thread::current();
@@ -603,10 +701,12 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region, bool m
 
         if (!physical_page_slot.is_null()) {
             dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else before reading, remapping.");
+            inode_vmobject.mark_page_active(page_index_in_vmobject);
             if (mark_page_dirty)
                 inode_vmobject.set_page_dirty(page_index_in_vmobject, true);
             if (!remap_vmobject_page(page_index_in_vmobject, *physical_page_slot, ShouldLockVMObject::No))
                 return PageFaultResponse::OutOfMemory;
+            fault_around(page_index_in_region);
             return PageFaultResponse::Continue;
         }
     }
@@ -617,67 +717,74 @@ PageFaultResponse Region::handle_inode_fault(size_t page_index_in_region, bool m
     if (current_thread)
         current_thread->did_inode_fault();
 
-    u8 page_buffer[PAGE_SIZE];
-    auto& inode = inode_vmobject.inode();
-
-    auto buffer = UserOrKernelBuffer::for_kernel_buffer(page_buffer);
-    auto result = inode.read_bytes(page_index_in_vmobject * PAGE_SIZE, PAGE_SIZE, buffer, nullptr);
-
+    // Read the pages following the faulting one along with it, so accessing them doesn't cause another trap each.
+    auto read_ahead_page_count = min(fault_around_page_count(), page_count() - page_index_in_region);
+    auto result = inode_vmobject.read_in_pages(page_index_in_vmobject, read_ahead_page_count, is_executable());
     if (result.is_error()) {
+        if (result.error().code() == ENOMEM) {
+            dmesgln("MM: handle_inode_fault was unable to allocate a physical page");
+            return PageFaultResponse::OutOfMemory;
+        }
         dmesgln("handle_inode_fault: Error ({}) while reading from inode", result.error());
         return PageFaultResponse::ShouldCrash;
     }
 
-    auto nread = result.value();
-    // Note: If we received 0, it means we are at the end of file or after it,
+    SpinlockLocker locker(inode_vmobject.m_lock);
+
+    // Note: If we didn't read anything and nobody else did either, it means we are at the end of file or after it,
     // which means we should return bus error.
-    if (nread == 0)
+    if (physical_page_slot.is_null())
         return PageFaultResponse::BusError;
+    if (result.value() == 0)
+        dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else, remapping.");
+    inode_vmobject.mark_page_active(page_index_in_vmobject);
 
-    // If we read less than a page, zero out the rest to avoid leaking uninitialized data.
-    if (nread < PAGE_SIZE)
-        memset(page_buffer + nread, 0, PAGE_SIZE - nread);
-
-    // Allocate a new physical page, and copy the read inode contents into it.
-    auto new_physical_page_or_error = MM.allocate_physical_page(MemoryManager::ShouldZeroFill::No);
-    if (new_physical_page_or_error.is_error()) {
-        dmesgln("MM: handle_inode_fault was unable to allocate a physical page");
+    if (mark_page_dirty)
+        inode_vmobject.set_page_dirty(page_index_in_vmobject, true);
+    if (!remap_vmobject_page(page_index_in_vmobject, *physical_page_slot, ShouldLockVMObject::No))
         return PageFaultResponse::OutOfMemory;
-    }
-    auto new_physical_page = new_physical_page_or_error.release_value();
-    {
-        InterruptDisabler disabler;
-        u8* dest_ptr = MM.quickmap_page(*new_physical_page);
-        memcpy(dest_ptr, page_buffer, PAGE_SIZE);
-
-        if (is_executable()) {
-            // Some architectures require an explicit synchronization operation after writing to memory that will be executed.
-            // This is required even if no instructions were previously fetched from that (physical) memory location,
-            // because some systems have an I-cache that is not coherent with the D-cache,
-            // resulting in the I-cache being filled with old values if the contents of the D-cache aren't written back yet.
-            Processor::flush_instruction_cache(VirtualAddress { dest_ptr }, PAGE_SIZE);
-        }
+    fault_around(page_index_in_region);
+    return PageFaultResponse::Continue;
+}
 
-        MM.unquickmap_page();
+size_t Region::fault_around_page_count() const
+{
+    switch (m_access_pattern) {
+    case AccessPattern::Normal:
+        return 16;
+    case AccessPattern::Sequential:
+        return 64;
+    case AccessPattern::Random:
+        return 1;
     }
+    VERIFY_NOT_REACHED();
+}
 
-    {
-        SpinlockLocker locker(inode_vmobject.m_lock);
+void Region::fault_around(size_t page_index_in_region)
+{
+    VERIFY(vmobject().m_lock.is_locked());
 
-        // Someone else can assign a new page before we get here, so check if physical_page_slot is still null.
-        if (physical_page_slot.is_null()) {
-            physical_page_slot = new_physical_page;
-            // Something went wrong if a newly loaded page is already marked dirty
-            VERIFY(!inode_vmobject.is_page_dirty(page_index_in_vmobject));
-        } else {
-            dbgln_if(PAGE_FAULT_DEBUG, "handle_inode_fault: Page faulted in by someone else, remapping.");
-        }
+    auto window_size = fault_around_page_count();
+    if (window_size <= 1)
+        return;
 
-        if (mark_page_dirty)
-            inode_vmobject.set_page_dirty(page_index_in_vmobject, true);
-        if (!remap_vmobject_page(page_index_in_vmobject, *physical_page_slot, ShouldLockVMObject::No))
-            return PageFaultResponse::OutOfMemory;
-        return PageFaultResponse::Continue;
+    // Map the pages around the faulting one that are already in memory, but aren't mapped into this region yet.
+    auto first_page_index = page_index_in_region - (page_index_in_region % window_size);
+    auto end_page_index = min(page_index_in_region + window_size, page_count());
+
+    SpinlockLocker page_lock(m_page_directory->get_lock());
+    for (auto page_index = first_page_index; page_index < end_page_index; ++page_index) {
+        if (page_index == page_index_in_region)
+            continue;
+        auto page = physical_page_locked(page_index);
+        if (!page)
+            continue;
+        // NOTE: Only newly present entries get written here, so there's nothing to flush from the TLB.
+        auto* pte = MM.pte(*m_page_directory, vaddr_from_page_index(page_index));
+        if (pte && pte->is_present())
+            continue;
+        if (!map_individual_page_impl(page_index, page, ShouldLockVMObject::No))
+            break;
     }
 }
 
@@ -688,6 +795,10 @@ PageFaultResponse Region::handle_dirty_on_write_fault(size_t page_index_in_regio
     auto page_index_in_vmobject = translate_to_vmobject_page(page_index_in_region);
     auto& physical_page_slot = inode_vmobject.physical_pages()[page_index_in_vmobject];
 
+    // The file is written to through a shared mapping, so its headers might be about to change.
+    if (inode_vmobject.is_shared_inode())
+        inode_vmobject.inode().invalidate_executable_load_plan();
+
     {
         SpinlockLocker locker(inode_vmobject.m_lock);
 
@@ -719,6 +830,32 @@ RefPtr<PhysicalRAMPage> Region::physical_page(size_t index) const
     return physical_page_locked(index);
 }
 
+ErrorOr<NonnullRefPtr<PhysicalRAMPage>> Region::pin_page_for_reading(size_t index)
+{
+    if (!vmobject().is_anonymous() || m_shared || !is_readable())
+        return ENOTSUP;
+    auto& anonymous_vmobject = static_cast<AnonymousVMObject&>(vmobject());
+    // Writing to volatile memory doesn't copy the page, and purging it would replace the page altogether.
+    if (anonymous_vmobject.is_purgeable())
+        return ENOTSUP;
+
+    auto vmobject_page_index = translate_to_vmobject_page(index);
+    RefPtr<PhysicalRAMPage> page;
+    {
+        SpinlockLocker vmobject_locker(vmobject().m_lock);
+        page = physical_page_locked(index);
+        if (!page)
+            return EFAULT;
+        // The shared zero page and the lazily committed page are never written to anyway.
+        if (!page->is_shared_zero_page() && !page->is_lazy_committed_page())
+            TRY(anonymous_vmobject.set_should_cow(vmobject_page_index, true));
+    }
+
+    // Writes have to fault from now on, so remap the page read-only wherever it's mapped.
+    (void)vmobject().remap_regions_one_page(vmobject_page_index, *page);
+    return page.release_nonnull();
+}
+
 RefPtr<PhysicalRAMPage>& Region::physical_page_slot(size_t index)
 {
     VERIFY(vmobject().m_lock.is_locked());
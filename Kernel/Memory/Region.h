@@ -12,6 +12,7 @@
 #include <AK/IntrusiveRedBlackTree.h>
 #include <AK/SetOnce.h>
 #include <Kernel/Forward.h>
+#include <Kernel/Heap/KmemCache.h>
 #include <Kernel/Library/KString.h>
 #include <Kernel/Library/LockWeakable.h>
 #include <Kernel/Locking/LockRank.h>
@@ -34,6 +35,8 @@ enum class ShouldFlushTLB {
 
 class Region final
     : public LockWeakable<Region> {
+    KMEM_CACHE_ALLOCATED(Region);
+
     friend class AddressSpace;
     friend class MemoryManager;
     friend class RegionTree;
@@ -85,6 +88,20 @@ public:
     [[nodiscard]] bool is_stack() const { return m_stack; }
     void set_stack(bool stack) { m_stack = stack; }
 
+    // How the memory in this region is expected to be accessed, as told to us by madvise().
+    // This determines how many neighbouring pages are brought in along with a faulting one.
+    enum class AccessPattern : u8 {
+        Normal,
+        Sequential,
+        Random,
+    };
+    [[nodiscard]] AccessPattern access_pattern() const { return m_access_pattern; }
+    void set_access_pattern(AccessPattern access_pattern) { m_access_pattern = access_pattern; }
+
+    // A hint that anonymous memory in this region should be backed by huge pages where possible.
+    [[nodiscard]] bool wants_huge_pages() const { return m_wants_huge_pages; }
+    void set_wants_huge_pages(bool wants_huge_pages) { m_wants_huge_pages = wants_huge_pages; }
+
     [[nodiscard]] bool is_immutable() const { return m_immutable.was_set(); }
     void set_immutable() { m_immutable.set(); }
 
@@ -162,6 +179,10 @@ public:
     RefPtr<PhysicalRAMPage> physical_page(size_t index) const;
     RefPtr<PhysicalRAMPage>& physical_page_slot(size_t index);
 
+    // Takes a reference to the page, which keeps its current contents even if the region is written to
+    // afterwards, since writes go to a copy of the page from now on. Only works for private anonymous memory.
+    ErrorOr<NonnullRefPtr<PhysicalRAMPage>> pin_page_for_reading(size_t index);
+
     [[nodiscard]] size_t offset_in_vmobject() const
     {
         return m_offset_in_vmobject;
@@ -204,6 +225,10 @@ public:
     void set_page_directory(PageDirectory&);
     ErrorOr<void> map(PageDirectory&, ShouldFlushTLB = ShouldFlushTLB::Yes);
     ErrorOr<void> map(PageDirectory&, PhysicalAddress, ShouldFlushTLB = ShouldFlushTLB::Yes);
+    // Attaches the region to the page directory without populating any page table entries. They are filled in by
+    // the page fault handler on the first access to each page instead, which only works for anonymous and inode memory.
+    [[nodiscard]] bool can_be_mapped_lazily() const;
+    void map_lazily(PageDirectory&);
     void unmap(ShouldFlushTLB = ShouldFlushTLB::Yes);
     void unmap_with_locks_held(ShouldFlushTLB, SpinlockLocker<RecursiveSpinlock<LockRank::None>>& pd_locker);
 
@@ -254,6 +279,7 @@ private:
     [[nodiscard]] PageFaultResponse handle_zero_fault(size_t page_index, PhysicalRAMPage& page_in_slot_at_time_of_fault);
     [[nodiscard]] PageFaultResponse handle_dirty_on_write_fault(size_t page_index);
 
+    [[nodiscard]] bool is_page_inactive(size_t page_index, ShouldLockVMObject) const;
     [[nodiscard]] bool map_individual_page_impl(size_t page_index, ShouldLockVMObject);
     [[nodiscard]] bool map_individual_page_impl(size_t page_index, RefPtr<PhysicalRAMPage>, ShouldLockVMObject);
     [[nodiscard]] bool map_individual_page_impl(size_t page_index, PhysicalAddress);
@@ -261,6 +287,11 @@ private:
 
     void remap_impl(ShouldLockVMObject should_lock_vmobject);
 
+    [[nodiscard]] bool try_map_huge_page(size_t page_index_in_region);
+
+    [[nodiscard]] size_t fault_around_page_count() const;
+    void fault_around(size_t page_index_in_region);
+
     LockRefPtr<PageDirectory> m_page_directory;
     VirtualRange m_range;
     size_t m_offset_in_vmobject { 0 };
@@ -268,12 +299,14 @@ private:
     OwnPtr<KString> m_name;
     Atomic<u32> m_in_progress_page_faults;
     u8 m_access { Region::None };
+    AccessPattern m_access_pattern { AccessPattern::Normal };
     bool m_shared : 1 { false };
     bool m_stack : 1 { false };
     bool m_mmap : 1 { false };
     bool m_syscall_region : 1 { false };
     bool m_mmapped_from_readable : 1 { false };
     bool m_mmapped_from_writable : 1 { false };
+    bool m_wants_huge_pages : 1 { false };
 
     MemoryType m_memory_type;
 
@@ -27,7 +27,8 @@ ErrorOr<NonnullLockRefPtr<SharedInodeVMObject>> SharedInodeVMObject::try_create_
         return shared_vmobject.release_nonnull();
     auto new_physical_pages = TRY(VMObject::try_create_physical_pages(size));
     auto dirty_pages = TRY(Bitmap::create(new_physical_pages.size(), false));
-    auto vmobject = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) SharedInodeVMObject(inode, move(new_physical_pages), move(dirty_pages))));
+    auto inactive_pages = TRY(Bitmap::create(new_physical_pages.size(), false));
+    auto vmobject = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) SharedInodeVMObject(inode, move(new_physical_pages), move(dirty_pages), move(inactive_pages))));
     TRY(vmobject->inode().set_shared_vmobject(*vmobject));
     return vmobject;
 }
@@ -36,16 +37,17 @@ ErrorOr<NonnullLockRefPtr<VMObject>> SharedInodeVMObject::try_clone()
 {
     auto new_physical_pages = TRY(this->try_clone_physical_pages());
     auto dirty_pages = TRY(Bitmap::create(new_physical_pages.size(), false));
-    return adopt_nonnull_lock_ref_or_enomem<VMObject>(new (nothrow) SharedInodeVMObject(*this, move(new_physical_pages), move(dirty_pages)));
+    auto inactive_pages = TRY(Bitmap::create(new_physical_pages.size(), false));
+    return adopt_nonnull_lock_ref_or_enomem<VMObject>(new (nothrow) SharedInodeVMObject(*this, move(new_physical_pages), move(dirty_pages), move(inactive_pages)));
 }
 
-SharedInodeVMObject::SharedInodeVMObject(Inode& inode, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages)
-    : InodeVMObject(inode, move(new_physical_pages), move(dirty_pages))
+SharedInodeVMObject::SharedInodeVMObject(Inode& inode, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages, Bitmap inactive_pages)
+    : InodeVMObject(inode, move(new_physical_pages), move(dirty_pages), move(inactive_pages))
 {
 }
 
-SharedInodeVMObject::SharedInodeVMObject(SharedInodeVMObject const& other, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages)
-    : InodeVMObject(other, move(new_physical_pages), move(dirty_pages))
+SharedInodeVMObject::SharedInodeVMObject(SharedInodeVMObject const& other, FixedArray<RefPtr<PhysicalRAMPage>>&& new_physical_pages, Bitmap dirty_pages, Bitmap inactive_pages)
+    : InodeVMObject(other, move(new_physical_pages), move(dirty_pages), move(inactive_pages))
 {
 }
 
@@ -45,6 +45,15 @@ public:
         return ~m_checksum & 0xffff;
     }
 
+    // The folded sum without the final complement, for checksums that are completed elsewhere (e.g. by the network adapter).
+    u16 partial_sum() const
+    {
+        u32 checksum = m_checksum;
+        while (checksum >> 16)
+            checksum = (checksum & 0xffff) + (checksum >> 16);
+        return checksum;
+    }
+
 private:
     u32 m_checksum { 0 };
     bool m_uneven_payload { false };
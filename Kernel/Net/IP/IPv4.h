@@ -102,4 +102,21 @@ private:
 
 static_assert(AssertSize<IPv4Packet, 20>());
 
+// TCP and UDP checksums also cover a pseudo header made of the addresses, the protocol and the segment length.
+inline InternetChecksum ipv4_pseudo_header_checksum(IPv4Address const& source, IPv4Address const& destination, TransportProtocol protocol, u16 length)
+{
+    struct [[gnu::packed]] {
+        IPv4Address source;
+        IPv4Address destination;
+        u8 zero;
+        u8 protocol;
+        NetworkOrdered<u16> length;
+    } pseudo_header { source, destination, 0, to_underlying(protocol), length };
+    static_assert(sizeof(pseudo_header) == 12);
+
+    InternetChecksum checksum;
+    checksum.add({ &pseudo_header, sizeof(pseudo_header) });
+    return checksum;
+}
+
 }
@@ -14,6 +14,7 @@
 #include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Net/IP/IPv4.h>
 #include <Kernel/Net/IP/SocketTuple.h>
+#include <Kernel/Net/Routing.h>
 #include <Kernel/Net/Socket.h>
 
 namespace Kernel {
@@ -37,7 +38,7 @@ public:
     virtual bool can_write(OpenFileDescription const&, u64) const override;
     virtual ErrorOr<size_t> sendto(OpenFileDescription&, UserOrKernelBuffer const&, size_t, int, Userspace<sockaddr const*>, socklen_t) override;
     virtual ErrorOr<size_t> recvfrom(OpenFileDescription&, UserOrKernelBuffer&, size_t, int flags, Userspace<sockaddr*>, Userspace<socklen_t*>, UnixDateTime&, bool blocking) override;
-    virtual ErrorOr<void> setsockopt(int level, int option, Userspace<void const*>, socklen_t) override;
+    virtual ErrorOr<void> setsockopt(OpenFileDescription&, int level, int option, Userspace<void const*>, socklen_t) override;
     virtual ErrorOr<void> getsockopt(OpenFileDescription&, int level, int option, Userspace<void*>, Userspace<socklen_t*>) override;
 
     virtual ErrorOr<void> ioctl(OpenFileDescription&, unsigned request, Userspace<void*> arg) override;
@@ -77,6 +78,15 @@ protected:
     void set_bound() { m_bound.set(); }
     ErrorOr<void> ensure_bound();
 
+    // Whether this socket may join the other, already bound one on the same address and port.
+    bool can_share_port_with(IPv4Socket const& other) const
+    {
+        return reuses_port() && other.reuses_port() && origin_uid() == other.origin_uid();
+    }
+
+    // Routes to the peer through the bound interface, if any, reusing the previous decision while it holds.
+    RoutingDecision route_to_peer(AllowBroadcast = AllowBroadcast::No, AllowUsingGateway = AllowUsingGateway::Yes);
+
     virtual ErrorOr<void> protocol_bind() { return {}; }
     virtual ErrorOr<void> protocol_listen() { return {}; }
     virtual ErrorOr<size_t> protocol_receive(ReadonlyBytes /* raw_ipv4_packet */, UserOrKernelBuffer&, size_t, int) { return ENOTIMPL; }
@@ -105,6 +115,7 @@ private:
 
     IPv4Address m_local_address;
     IPv4Address m_peer_address;
+    CachedRoutingDecision m_cached_routing_decision;
 
     Vector<IPv4Address> m_multicast_memberships;
     bool m_multicast_loop { true };
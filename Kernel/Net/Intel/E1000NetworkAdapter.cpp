@@ -39,6 +39,7 @@ namespace Kernel {
 #define REG_RADV 0x282C             // RX Int. Absolute Delay Timer
 #define REG_RSRPD 0x2C00            // RX Small Packet Detect Interrupt
 #define REG_TIPG 0x0410             // Transmit Inter Packet Gap
+#define REG_RXCSUM 0x5000           // RX Checksum Control
 #define ECTRL_SLU 0x40              // set link up
 #define RCTL_EN (1 << 1)            // Receiver Enable
 #define RCTL_SBP (1 << 2)           // Store Bad Packets
@@ -81,6 +82,18 @@ namespace Kernel {
 #define CMD_VLE (1 << 6)  // VLAN Packet Enable
 #define CMD_IDE (1 << 7)  // Interrupt Delay Enable
 
+// RXCSUM Register
+
+#define RXCSUM_IPOFL (1 << 8) // IP Checksum Off-load Enable
+#define RXCSUM_TUOFL (1 << 9) // TCP/UDP Checksum Off-load Enable
+
+// Receive Status and Errors
+
+#define RSTA_DD (1 << 0)    // Descriptor Done
+#define RSTA_IXSM (1 << 2)  // Ignore Checksum Indication
+#define RSTA_TCPCS (1 << 5) // TCP/UDP Checksum Calculated
+#define RERR_TCPE (1 << 5)  // TCP/UDP Checksum Error
+
 // TCTL Register
 
 #define TCTL_EN (1 << 1)      // Transmit Enable
@@ -219,14 +232,64 @@ UNMAP_AFTER_INIT void E1000NetworkAdapter::setup_link()
     out32(REG_CTRL, flags | ECTRL_SLU);
 }
 
+// The receive interrupts are masked while the network task polls the ring.
+static constexpr u32 receive_interrupts = INTERRUPT_RXT0 | INTERRUPT_RXO;
+
+// The interrupt rate register counts in 256 ns units.
+static constexpr u32 interrupt_interval_for_rate(u32 interrupts_per_second)
+{
+    return 1'000'000'000 / (interrupts_per_second * 256);
+}
+
 UNMAP_AFTER_INIT void E1000NetworkAdapter::setup_interrupts()
 {
-    out32(REG_INTERRUPT_RATE, 6000); // Interrupt rate of 1.536 milliseconds
-    out32(REG_INTERRUPT_MASK_SET, INTERRUPT_LSC | INTERRUPT_RXT0 | INTERRUPT_RXO);
+    m_interrupt_latency = InterruptLatency::Low;
+    out32(REG_INTERRUPT_RATE, interrupt_interval_for_latency(m_interrupt_latency));
+    // Transmit completions have to wake up senders even while the receive interrupts are masked.
+    out32(REG_INTERRUPT_MASK_SET, INTERRUPT_LSC | INTERRUPT_TXDW | receive_interrupts);
     in32(REG_INTERRUPT_CAUSE_READ);
     enable_irq();
 }
 
+u32 E1000NetworkAdapter::interrupt_interval_for_latency(InterruptLatency latency)
+{
+    switch (latency) {
+    case InterruptLatency::Lowest:
+        return interrupt_interval_for_rate(70000);
+    case InterruptLatency::Low:
+        return interrupt_interval_for_rate(20000);
+    case InterruptLatency::Bulk:
+        return interrupt_interval_for_rate(4000);
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void E1000NetworkAdapter::update_interrupt_rate()
+{
+    // Like the adaptive interrupt throttling of Intel's drivers: A few small frames per interrupt are
+    // interactive traffic that wants low latency, while many or large frames are bulk transfers that
+    // can wait for the next interrupt to pick up more of them at once.
+    auto frames = m_frames_since_interrupt;
+    auto bytes = m_bytes_since_interrupt;
+    m_frames_since_interrupt = 0;
+    m_bytes_since_interrupt = 0;
+    if (frames == 0)
+        return;
+
+    InterruptLatency latency;
+    if (frames > 35 || bytes / frames > 1200)
+        latency = InterruptLatency::Bulk;
+    else if (frames > 10 || bytes > 10000)
+        latency = InterruptLatency::Low;
+    else
+        latency = InterruptLatency::Lowest;
+
+    if (latency == m_interrupt_latency)
+        return;
+    m_interrupt_latency = latency;
+    out32(REG_INTERRUPT_RATE, interrupt_interval_for_latency(latency));
+}
+
 UNMAP_AFTER_INIT E1000NetworkAdapter::E1000NetworkAdapter(StringView interface_name,
     PCI::DeviceIdentifier const& device_identifier, u8 irq,
     NonnullOwnPtr<IOWindow> registers_io_window, NonnullOwnPtr<Memory::Region> rx_buffer_region,
@@ -241,6 +304,8 @@ UNMAP_AFTER_INIT E1000NetworkAdapter::E1000NetworkAdapter(StringView interface_n
     , m_rx_buffer_region(move(rx_buffer_region))
     , m_tx_buffer_region(move(tx_buffer_region))
 {
+    // The legacy descriptors can insert a checksum, but segmentation would need context descriptors and bigger buffers.
+    set_offloads(Offload::TransmitChecksum | Offload::ReceiveChecksum);
 }
 
 UNMAP_AFTER_INIT E1000NetworkAdapter::~E1000NetworkAdapter() = default;
@@ -267,8 +332,10 @@ bool E1000NetworkAdapter::handle_irq()
     if (status & INTERRUPT_RXO) {
         dbgln_if(E1000_DEBUG, "E1000: RX buffer overrun");
     }
-    if (status & INTERRUPT_RXT0) {
-        receive();
+    if (status & receive_interrupts) {
+        // The ring is left to the network task until it's empty.
+        out32(REG_INTERRUPT_MASK_CLEAR, receive_interrupts);
+        schedule_poll();
     }
 
     m_wait_queue.wake_all();
@@ -341,6 +408,7 @@ UNMAP_AFTER_INIT void E1000NetworkAdapter::initialize_rx_descriptors()
     out32(REG_RXDESCHEAD, 0);
     out32(REG_RXDESCTAIL, number_of_rx_descriptors - 1);
 
+    out32(REG_RXCSUM, in32(REG_RXCSUM) | RXCSUM_IPOFL | RXCSUM_TUOFL);
     out32(REG_RCTRL, RCTL_EN | RCTL_SBP | RCTL_UPE | RCTL_MPE | RCTL_LBM_NONE | RTCL_RDMTS_HALF | RCTL_BAM | RCTL_SECRC | RCTL_BSIZE_8192);
 }
 
@@ -402,6 +470,17 @@ u32 E1000NetworkAdapter::in32(u16 address)
 }
 
 void E1000NetworkAdapter::send_raw(ReadonlyBytes payload)
+{
+    send_with_checksum_offload(payload, {});
+}
+
+void E1000NetworkAdapter::send_raw_with_offload(PacketWithTimestamp const& packet)
+{
+    VERIFY(packet.transmit_offload.segment_size == 0 && packet.fragments.is_empty());
+    send_with_checksum_offload(packet.buffer->bytes(), packet.transmit_offload);
+}
+
+void E1000NetworkAdapter::send_with_checksum_offload(ReadonlyBytes payload, PacketWithTimestamp::TransmitOffload const& offload)
 {
     disable_irq();
     size_t tx_current = in32(REG_TXDESCTAIL) % number_of_tx_descriptors;
@@ -413,6 +492,15 @@ void E1000NetworkAdapter::send_raw(ReadonlyBytes payload)
     descriptor.length = payload.size();
     descriptor.status = 0;
     descriptor.cmd = CMD_EOP | CMD_IFCS | CMD_RS;
+    if (offload.needs_checksum) {
+        // The checksum is summed up from CSS to the end of the packet, and inserted at CSO.
+        descriptor.css = offload.checksum_start;
+        descriptor.cso = offload.checksum_start + offload.checksum_offset;
+        descriptor.cmd = descriptor.cmd | CMD_IC;
+    } else {
+        descriptor.css = 0;
+        descriptor.cso = 0;
+    }
     dbgln_if(E1000_DEBUG, "E1000: Using tx descriptor {} (head is at {})", tx_current, in32(REG_TXDESCHEAD));
     tx_current = (tx_current + 1) % number_of_tx_descriptors;
     Processor::disable_interrupts();
@@ -428,22 +516,40 @@ void E1000NetworkAdapter::send_raw(ReadonlyBytes payload)
     dbgln_if(E1000_DEBUG, "E1000: Sent packet, status is now {:#02x}!", (u8)descriptor.status);
 }
 
-void E1000NetworkAdapter::receive()
+size_t E1000NetworkAdapter::poll(size_t budget)
 {
+    auto received = receive(budget);
+    if (received < budget) {
+        update_interrupt_rate();
+        out32(REG_INTERRUPT_MASK_SET, receive_interrupts);
+    }
+    return received;
+}
+
+size_t E1000NetworkAdapter::receive(size_t budget)
+{
+    size_t received = 0;
     u32 rx_current;
-    for (;;) {
+    while (received < budget) {
         rx_current = in32(REG_RXDESCTAIL) % number_of_rx_descriptors;
         rx_current = (rx_current + 1) % number_of_rx_descriptors;
-        if (!(m_rx_descriptors[rx_current].status & 1))
+        u8 status = m_rx_descriptors[rx_current].status;
+        if (!(status & RSTA_DD))
             break;
         auto* buffer = m_rx_buffers[rx_current];
         u16 length = m_rx_descriptors[rx_current].length;
         VERIFY(length <= 8192);
         dbgln_if(E1000_DEBUG, "E1000: Received 1 packet @ {:p} ({} bytes)", buffer, length);
-        did_receive({ buffer, length });
+        // Packets with a bad checksum are left for the network stack to drop.
+        bool checksum_verified = !(status & RSTA_IXSM) && (status & RSTA_TCPCS) && !(m_rx_descriptors[rx_current].errors & RERR_TCPE);
+        did_receive({ buffer, length }, checksum_verified);
         m_rx_descriptors[rx_current].status = 0;
         out32(REG_RXDESCTAIL, rx_current);
+        ++received;
+        ++m_frames_since_interrupt;
+        m_bytes_since_interrupt += length;
     }
+    return received;
 }
 
 i32 E1000NetworkAdapter::link_speed()
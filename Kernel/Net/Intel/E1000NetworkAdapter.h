@@ -28,9 +28,11 @@ public:
     virtual ~E1000NetworkAdapter() override;
 
     virtual void send_raw(ReadonlyBytes) override;
+    virtual void send_raw_with_offload(PacketWithTimestamp const&) override;
     virtual bool link_up() override { return m_link_up; }
     virtual i32 link_speed() override;
     virtual bool link_full_duplex() override;
+    virtual size_t poll(size_t budget) override;
 
     virtual StringView purpose() const override { return class_name(); }
     virtual StringView device_name() const override { return "E1000"sv; }
@@ -87,7 +89,16 @@ protected:
     u16 in16(u16 address);
     u32 in32(u16 address);
 
-    void receive();
+    size_t receive(size_t budget);
+    void send_with_checksum_offload(ReadonlyBytes, PacketWithTimestamp::TransmitOffload const&);
+
+    enum class InterruptLatency {
+        Lowest,
+        Low,
+        Bulk,
+    };
+    static u32 interrupt_interval_for_latency(InterruptLatency);
+    void update_interrupt_rate();
 
     static constexpr size_t number_of_rx_descriptors = 256;
     static constexpr size_t number_of_tx_descriptors = 256;
@@ -103,6 +114,10 @@ protected:
     Array<void*, number_of_tx_descriptors> m_tx_buffers;
     SetOnce m_has_eeprom;
     bool m_link_up { false };
+    InterruptLatency m_interrupt_latency { InterruptLatency::Low };
+    // What the ring has received since the receive interrupts were last unmasked.
+    size_t m_frames_since_interrupt { 0 };
+    size_t m_bytes_since_interrupt { 0 };
     EntropySource m_entropy_source;
 
     DeprecatedWaitQueue m_wait_queue;
@@ -392,6 +392,16 @@ ErrorOr<NonnullOwnPtr<KString>> LocalSocket::pseudo_path(OpenFileDescription con
     return KString::try_create(builder.string_view());
 }
 
+DoubleBuffer& LocalSocket::buffer_for_size_option(OpenFileDescription& description, int option)
+{
+    VERIFY(option == SO_SNDBUF || option == SO_RCVBUF);
+    auto* buffer = option == SO_SNDBUF ? send_buffer_for(description) : receive_buffer_for(description);
+    if (buffer)
+        return *buffer;
+    // A socket that isn't connected yet can only become the connecting side.
+    return option == SO_SNDBUF ? *m_for_server : *m_for_client;
+}
+
 ErrorOr<void> LocalSocket::getsockopt(OpenFileDescription& description, int level, int option, Userspace<void*> value, Userspace<socklen_t*> value_size)
 {
     if (level != SOL_SOCKET)
@@ -403,19 +413,12 @@ ErrorOr<void> LocalSocket::getsockopt(OpenFileDescription& description, int leve
     TRY(copy_from_user(&size, value_size.unsafe_userspace_ptr()));
 
     switch (option) {
-    case SO_SNDBUF: {
-        if (size != sizeof(int))
-            return EINVAL;
-        int snd_buffer_size = static_cast<int>(m_for_server->space_for_writing() + m_for_server->immediately_readable());
-        TRY(copy_to_user(static_ptr_cast<int*>(value), &snd_buffer_size));
-        TRY(copy_to_user(value_size, &size));
-        return {};
-    }
+    case SO_SNDBUF:
     case SO_RCVBUF: {
         if (size != sizeof(int))
             return EINVAL;
-        int rcv_buffer_size = static_cast<int>(m_for_client->space_for_writing() + m_for_client->immediately_readable());
-        TRY(copy_to_user(static_ptr_cast<int*>(value), &rcv_buffer_size));
+        int buffer_size = static_cast<int>(buffer_for_size_option(description, option).capacity());
+        TRY(copy_to_user(static_ptr_cast<int*>(value), &buffer_size));
         TRY(copy_to_user(value_size, &size));
         return {};
     }
@@ -445,6 +448,25 @@ ErrorOr<void> LocalSocket::getsockopt(OpenFileDescription& description, int leve
     }
 }
 
+ErrorOr<void> LocalSocket::setsockopt(OpenFileDescription& description, int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
+{
+    if (level != SOL_SOCKET || (option != SO_SNDBUF && option != SO_RCVBUF))
+        return Socket::setsockopt(description, level, option, user_value, user_value_size);
+
+    if (user_value_size != sizeof(int))
+        return EINVAL;
+    auto buffer_size = TRY(copy_typed_from_user(static_ptr_cast<int const*>(user_value)));
+    if (buffer_size < 0)
+        return EINVAL;
+
+    MutexLocker locker(mutex());
+    // Like on other systems, sizes outside of what we support are silently clamped.
+    auto capacity = clamp(static_cast<size_t>(buffer_size), PAGE_SIZE, DoubleBuffer::max_capacity);
+    TRY(buffer_for_size_option(description, option).try_resize(capacity));
+    evaluate_block_conditions();
+    return {};
+}
+
 ErrorOr<void> LocalSocket::ioctl(OpenFileDescription& description, unsigned request, Userspace<void*> arg)
 {
     switch (request) {
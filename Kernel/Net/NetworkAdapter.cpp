@@ -7,13 +7,19 @@
 #include <Kernel/Heap/kmalloc.h>
 #include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/Library/StdLib.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Net/EtherType.h>
 #include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/Net/NetworkingManagement.h>
+#include <Kernel/Net/Routing.h>
+#include <Kernel/Net/TCP.h>
 #include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/Tracepoints.h>
 
 namespace Kernel {
 
+DEFINE_KMEM_CACHE(PacketWithTimestamp)
+
 NetworkAdapter::NetworkAdapter(StringView interface_name)
 {
     m_name.store_characters(interface_name);
@@ -23,11 +29,106 @@ NetworkAdapter::~NetworkAdapter() = default;
 
 void NetworkAdapter::send_packet(ReadonlyBytes packet)
 {
+    TRACEPOINT(net_transmit, packet.size(), 0);
     m_packets_out++;
     m_bytes_out += packet.size();
     send_raw(packet);
 }
 
+static void complete_checksum_in_software(Bytes frame, PacketWithTimestamp::TransmitOffload& offload)
+{
+    // The checksum field already holds the sum of the pseudo header, so summing up the rest gives the final checksum.
+    InternetChecksum checksum;
+    checksum.add(frame.slice(offload.checksum_start));
+    NetworkOrdered<u16> result = checksum.finish();
+    memcpy(frame.offset_pointer(offload.checksum_start + offload.checksum_offset), &result, sizeof(result));
+    offload.needs_checksum = false;
+}
+
+void NetworkAdapter::send_packet(PacketWithTimestamp& packet)
+{
+    auto& offload = packet.transmit_offload;
+    bool needs_segmentation_in_software = offload.segment_size != 0 && !has_offload(Offload::TCPSegmentation);
+    bool needs_checksum_in_software = offload.needs_checksum && !has_offload(Offload::TransmitChecksum);
+    if (!packet.fragments.is_empty() && (!has_offload(Offload::ScatterGather) || needs_segmentation_in_software || needs_checksum_in_software))
+        return send_linearized(packet);
+
+    if (needs_segmentation_in_software)
+        return send_segmented_in_software(packet);
+
+    if (needs_checksum_in_software)
+        complete_checksum_in_software(packet.buffer->bytes(), offload);
+
+    if (!offload.needs_checksum && offload.segment_size == 0 && packet.fragments.is_empty())
+        return send_packet(packet.bytes());
+
+    TRACEPOINT(net_transmit, packet.size(), 0);
+    m_packets_out++;
+    m_bytes_out += packet.size();
+    send_raw_with_offload(packet);
+}
+
+void NetworkAdapter::send_linearized(PacketWithTimestamp& packet)
+{
+    auto linear_packet = acquire_packet_buffer(packet.size());
+    if (!linear_packet) {
+        m_packets_dropped++;
+        return;
+    }
+
+    memcpy(linear_packet->buffer->data(), packet.buffer->data(), packet.buffer->size());
+    auto* destination = linear_packet->buffer->data() + packet.buffer->size();
+    for (auto const& fragment : packet.fragments) {
+        MM.copy_from_physical_page(*fragment.page, fragment.offset, { destination, fragment.length });
+        destination += fragment.length;
+    }
+
+    // The copy is changed while doing the offloads in software, so the original still works for a retransmission.
+    linear_packet->transmit_offload = packet.transmit_offload;
+    send_packet(*linear_packet);
+    release_packet_buffer(*linear_packet);
+}
+
+void NetworkAdapter::send_segmented_in_software(PacketWithTimestamp& packet)
+{
+    auto const& offload = packet.transmit_offload;
+    auto frame = packet.bytes();
+    auto const& tcp_packet = *bit_cast<TCPPacket const*>(frame.offset_pointer(offload.checksum_start));
+    size_t header_size = offload.checksum_start + tcp_packet.header_size();
+    size_t payload_size = frame.size() - header_size;
+
+    for (size_t offset = 0; offset < payload_size; offset += offload.segment_size) {
+        size_t segment_payload_size = min<size_t>(offload.segment_size, payload_size - offset);
+        auto segment = acquire_packet_buffer(header_size + segment_payload_size);
+        if (!segment) {
+            // Whatever is missing gets retransmitted.
+            m_packets_dropped++;
+            return;
+        }
+        memcpy(segment->buffer->data(), frame.data(), header_size);
+        memcpy(segment->buffer->data() + header_size, frame.offset_pointer(header_size + offset), segment_payload_size);
+
+        auto& ipv4 = *bit_cast<IPv4Packet*>(segment->buffer->data() + layer3_payload_offset());
+        ipv4.set_length(header_size - layer3_payload_offset() + segment_payload_size);
+        ipv4.set_checksum(0);
+        ipv4.set_checksum(ipv4.compute_checksum());
+
+        auto& segment_tcp_packet = *bit_cast<TCPPacket*>(segment->buffer->data() + offload.checksum_start);
+        segment_tcp_packet.set_sequence_number(tcp_packet.sequence_number() + offset);
+        if (offset + segment_payload_size < payload_size)
+            segment_tcp_packet.set_flags(tcp_packet.flags() & ~(TCPFlags::FIN | TCPFlags::PSH));
+
+        u16 tcp_segment_size = header_size - offload.checksum_start + segment_payload_size;
+        auto checksum = ipv4_pseudo_header_checksum(ipv4.source(), ipv4.destination(), TransportProtocol::TCP, tcp_segment_size);
+        segment_tcp_packet.set_checksum(0);
+        checksum.add({ &segment_tcp_packet, tcp_segment_size });
+        segment_tcp_packet.set_checksum(checksum.finish());
+
+        send_packet(segment->bytes());
+        release_packet_buffer(*segment);
+    }
+}
+
 void NetworkAdapter::send(MACAddress const& destination, ARPPacket const& packet)
 {
     size_t size_in_bytes = sizeof(EthernetFrameHeader) + sizeof(ARPPacket);
@@ -47,10 +148,11 @@ void NetworkAdapter::send(MACAddress const& destination, ARPPacket const& packet
 void NetworkAdapter::fill_in_ipv4_header(PacketWithTimestamp& packet, IPv4Address const& source_ipv4, MACAddress const& destination_mac, IPv4Address const& destination_ipv4, TransportProtocol protocol, size_t payload_size, u8 type_of_service, u8 ttl)
 {
     size_t ipv4_packet_size = sizeof(IPv4Packet) + payload_size;
-    VERIFY(ipv4_packet_size <= mtu());
+    // Super-segments are only cut down to the MTU by the adapter.
+    VERIFY(ipv4_packet_size <= mtu() || (packet.transmit_offload.segment_size != 0 && ipv4_packet_size <= maximum_super_segment_size));
 
     size_t ethernet_frame_size = ipv4_payload_offset() + payload_size;
-    VERIFY(packet.buffer->size() == ethernet_frame_size);
+    VERIFY(packet.size() == ethernet_frame_size);
     memset(packet.buffer->data(), 0, ipv4_payload_offset());
 
     auto& eth = *bit_cast<EthernetFrameHeader*>(packet.buffer->data());
@@ -103,9 +205,10 @@ void NetworkAdapter::fill_in_ipv6_header(PacketWithTimestamp& packet, IPv6Addres
     ipv6.set_hop_limit(hop_limit);
 }
 
-void NetworkAdapter::did_receive(ReadonlyBytes payload)
+void NetworkAdapter::did_receive(ReadonlyBytes payload, bool checksum_verified)
 {
     InterruptDisabler disabler;
+    TRACEPOINT(net_receive, payload.size(), 0);
     m_packets_in++;
     m_bytes_in += payload.size();
 
@@ -121,6 +224,7 @@ void NetworkAdapter::did_receive(ReadonlyBytes payload)
     }
 
     memcpy(packet->buffer->data(), payload.data(), payload.size());
+    packet->checksum_verified = checksum_verified;
 
     m_packet_queue.append(*packet);
     m_packet_queue_size++;
@@ -129,20 +233,21 @@ void NetworkAdapter::did_receive(ReadonlyBytes payload)
         on_receive();
 }
 
-size_t NetworkAdapter::dequeue_packet(u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp)
+void NetworkAdapter::schedule_poll()
+{
+    m_poll_scheduled = true;
+    if (on_poll_scheduled)
+        on_poll_scheduled();
+}
+
+RefPtr<PacketWithTimestamp> NetworkAdapter::dequeue_packet()
 {
     InterruptDisabler disabler;
     if (m_packet_queue.is_empty())
-        return 0;
-    auto packet_with_timestamp = m_packet_queue.take_first();
+        return nullptr;
+    auto packet = m_packet_queue.take_first();
     m_packet_queue_size--;
-    packet_timestamp = packet_with_timestamp->timestamp;
-    auto& packet_buffer = packet_with_timestamp->buffer;
-    size_t packet_size = packet_buffer->size();
-    VERIFY(packet_size <= buffer_size);
-    memcpy(buffer, packet_buffer->data(), packet_size);
-    release_packet_buffer(*packet_with_timestamp);
-    return packet_size;
+    return packet;
 }
 
 RefPtr<PacketWithTimestamp> NetworkAdapter::acquire_packet_buffer(size_t size)
@@ -163,6 +268,8 @@ RefPtr<PacketWithTimestamp> NetworkAdapter::acquire_packet_buffer(size_t size)
     if (packet) {
         packet->timestamp = kgettimeofday();
         packet->buffer->set_size(size);
+        packet->transmit_offload = {};
+        packet->checksum_verified = false;
         return packet;
     }
 
@@ -178,19 +285,36 @@ RefPtr<PacketWithTimestamp> NetworkAdapter::acquire_packet_buffer(size_t size)
 
 void NetworkAdapter::release_packet_buffer(PacketWithTimestamp& packet)
 {
+    // Let go of the pages right away, rather than whenever the packet is used again.
+    packet.fragments.clear();
     m_unused_packets.with([&packet](auto& unused_packets) {
         unused_packets.append(packet);
     });
 }
 
+ErrorOr<void> NetworkAdapter::preallocate_packet_buffers()
+{
+    // Every buffer is physically backed from the start, and one page for the usual Ethernet MTU.
+    auto buffer_size = TRY(Memory::page_round_up(layer3_payload_offset() + mtu()));
+    auto count = max<size_t>(preallocated_packet_buffer_bytes / buffer_size, 1);
+    for (size_t i = 0; i < count; ++i) {
+        auto buffer = TRY(KBuffer::try_create_with_size("NetworkAdapter: Packet buffer"sv, buffer_size, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+        auto packet = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) PacketWithTimestamp { move(buffer), kgettimeofday() }));
+        release_packet_buffer(*packet);
+    }
+    return {};
+}
+
 void NetworkAdapter::set_ipv4_address(IPv4Address const& address)
 {
     m_ipv4_address = address;
+    invalidate_routing_decisions();
 }
 
 void NetworkAdapter::set_ipv4_netmask(IPv4Address const& netmask)
 {
     m_ipv4_netmask = netmask;
+    invalidate_routing_decisions();
 }
 
 void NetworkAdapter::set_ipv6_address(IPv6Address const& address)
@@ -8,16 +8,20 @@
 
 #include <AK/AtomicRefCounted.h>
 #include <AK/ByteBuffer.h>
+#include <AK/EnumBits.h>
 #include <AK/Function.h>
 #include <AK/IPv6Address.h>
 #include <AK/IntrusiveList.h>
 #include <AK/MACAddress.h>
+#include <AK/NumericLimits.h>
 #include <AK/Types.h>
 #include <Kernel/Bus/PCI/Definitions.h>
+#include <Kernel/Heap/KmemCache.h>
 #include <Kernel/Library/KBuffer.h>
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Library/LockWeakable.h>
 #include <Kernel/Library/UserOrKernelBuffer.h>
+#include <Kernel/Memory/PhysicalRAMPage.h>
 #include <Kernel/Net/EthernetFrameHeader.h>
 #include <Kernel/Net/ICMP.h>
 #include <Kernel/Net/IP/ARP.h>
@@ -31,17 +35,52 @@ class NetworkAdapter;
 
 using NetworkByteBuffer = AK::Detail::ByteBuffer<1500>;
 
+// A piece of a packet that lives in a page of its own, e.g. user data that is sent without being copied.
+struct PacketFragment {
+    NonnullRefPtr<Memory::PhysicalRAMPage> page;
+    u16 offset { 0 };
+    u16 length { 0 };
+};
+
 struct PacketWithTimestamp final : public AtomicRefCounted<PacketWithTimestamp> {
+    KMEM_CACHE_ALLOCATED(PacketWithTimestamp);
+
+public:
     PacketWithTimestamp(NonnullOwnPtr<KBuffer> buffer, UnixDateTime timestamp)
         : buffer(move(buffer))
         , timestamp(timestamp)
     {
     }
 
+    // Only the part in the buffer, without the fragments.
     ReadonlyBytes bytes() { return buffer->bytes(); }
 
+    size_t size() const
+    {
+        size_t size = buffer->size();
+        for (auto const& fragment : fragments)
+            size += fragment.length;
+        return size;
+    }
+
+    // What the sender leaves to the adapter, see NetworkAdapter::send_packet().
+    struct TransmitOffload {
+        // The TCP or UDP checksum field at checksum_start + checksum_offset holds the sum of the pseudo header,
+        // and the adapter has to add everything from checksum_start onwards.
+        bool needs_checksum { false };
+        u16 checksum_start { 0 };
+        u16 checksum_offset { 0 };
+        // If nonzero, the packet is a TCP super-segment whose payload has to be sent in segments of this size.
+        u16 segment_size { 0 };
+    };
+
     NonnullOwnPtr<KBuffer> buffer;
+    // The rest of the packet after the buffer, see NetworkAdapter::Offload::ScatterGather.
+    Vector<PacketFragment> fragments;
     UnixDateTime timestamp;
+    TransmitOffload transmit_offload;
+    // Set for received packets whose TCP or UDP checksum the adapter has already verified.
+    bool checksum_verified { false };
     IntrusiveListNode<PacketWithTimestamp, RefPtr<PacketWithTimestamp>> packet_node;
 };
 
@@ -57,6 +96,21 @@ public:
 
     static constexpr i32 LINKSPEED_INVALID = -1;
 
+    // Work the adapter can take off the network stack. All of it is only for IPv4.
+    enum class Offload : u8 {
+        None = 0,
+        TransmitChecksum = 1 << 0,
+        // Implies TransmitChecksum.
+        TCPSegmentation = 1 << 1,
+        ReceiveChecksum = 1 << 2,
+        // The adapter can transmit packets with fragments straight from their pages.
+        ScatterGather = 1 << 3,
+    };
+    AK_ENUM_BITWISE_FRIEND_OPERATORS(Offload);
+
+    // The largest TCP super-segment we hand to adapters, which is what fits into an IPv4 packet.
+    static constexpr size_t maximum_super_segment_size = NumericLimits<u16>::max();
+
     virtual ~NetworkAdapter();
 
     virtual StringView class_name() const = 0;
@@ -82,6 +136,9 @@ public:
     }
     virtual bool link_full_duplex() { return false; }
 
+    Offload offloads() const { return m_offloads; }
+    bool has_offload(Offload offload) const { return has_flag(m_offloads, offload); }
+
     void set_ipv4_address(IPv4Address const&);
     void set_ipv4_netmask(IPv4Address const&);
 
@@ -92,7 +149,8 @@ public:
     void fill_in_ipv4_header(PacketWithTimestamp&, IPv4Address const&, MACAddress const&, IPv4Address const&, TransportProtocol, size_t, u8 type_of_service, u8 ttl);
     void fill_in_ipv6_header(PacketWithTimestamp&, IPv6Address const&, MACAddress const&, IPv6Address const&, TransportProtocol, size_t, u8 hop_limit);
 
-    size_t dequeue_packet(u8* buffer, size_t buffer_size, UnixDateTime& packet_timestamp);
+    // The packet has to be given back with release_packet_buffer() once it has been handled.
+    RefPtr<PacketWithTimestamp> dequeue_packet();
 
     bool has_queued_packets() const { return !m_packet_queue.is_empty(); }
 
@@ -107,6 +165,8 @@ public:
 
     RefPtr<PacketWithTimestamp> acquire_packet_buffer(size_t);
     void release_packet_buffer(PacketWithTimestamp&);
+    // Fills the pool up front, so the packets of the adapter don't have to be allocated while the network is busy.
+    ErrorOr<void> preallocate_packet_buffers();
 
     constexpr size_t layer3_payload_offset() const { return sizeof(EthernetFrameHeader); }
     constexpr size_t ipv4_payload_offset() const { return layer3_payload_offset() + sizeof(IPv4Packet); }
@@ -114,16 +174,33 @@ public:
 
     Function<void()> on_receive;
 
+    // Adapters that support polling stop raising receive interrupts while frames keep coming in. Their interrupt
+    // handler masks the receive interrupts and calls schedule_poll(), after which the network task calls poll() with
+    // a budget of frames. Once poll() receives fewer frames than that, the ring is empty and the adapter unmasks its
+    // receive interrupts again.
+    virtual size_t poll(size_t) { return 0; }
+    void schedule_poll();
+    bool take_scheduled_poll() { return m_poll_scheduled.exchange(false); }
+    Function<void()> on_poll_scheduled;
+
     void send_packet(ReadonlyBytes);
+    // Does whatever the packet leaves to the adapter in software if the adapter can't.
+    void send_packet(PacketWithTimestamp&);
 
 protected:
     NetworkAdapter(StringView);
     void set_mac_address(MACAddress const& mac_address) { m_mac_address = mac_address; }
-    void did_receive(ReadonlyBytes);
+    void set_offloads(Offload offloads) { m_offloads = offloads; }
+    void did_receive(ReadonlyBytes, bool checksum_verified = false);
     virtual void send_raw(ReadonlyBytes) = 0;
+    // Only used for the offloads the adapter advertises.
+    virtual void send_raw_with_offload(PacketWithTimestamp const&) { VERIFY_NOT_REACHED(); }
     void autoconfigure_link_local_ipv6();
 
 private:
+    void send_segmented_in_software(PacketWithTimestamp&);
+    void send_linearized(PacketWithTimestamp&);
+
     MACAddress m_mac_address;
     // FIXME: Allow for more than one IPv4/IPv6 address each.
     IPv4Address m_ipv4_address;
@@ -133,6 +210,7 @@ private:
 
     // FIXME: Make this configurable
     static constexpr size_t max_packet_buffers = 1024;
+    static constexpr size_t preallocated_packet_buffer_bytes = 1 * MiB;
 
     using PacketList = IntrusiveList<&PacketWithTimestamp::packet_node>;
 
@@ -146,6 +224,8 @@ private:
     u32 m_bytes_out { 0 };
     u32 m_mtu { 1500 };
     u32 m_packets_dropped { 0 };
+    Atomic<bool> m_poll_scheduled { false };
+    Offload m_offloads { Offload::None };
 };
 
 }
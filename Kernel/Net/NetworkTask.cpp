@@ -6,9 +6,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/CircularQueue.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Locking/Mutex.h>
 #include <Kernel/Locking/MutexProtected.h>
+#include <Kernel/Locking/SpinlockProtected.h>
 #include <Kernel/Net/EtherType.h>
 #include <Kernel/Net/EthernetFrameHeader.h>
 #include <Kernel/Net/ICMP.h>
@@ -26,41 +29,221 @@
 #include <Kernel/Net/TCPSocket.h>
 #include <Kernel/Net/UDP.h>
 #include <Kernel/Net/UDPSocket.h>
+#include <Kernel/Tasks/DeprecatedWaitQueue.h>
 #include <Kernel/Tasks/Process.h>
 
 namespace Kernel {
 
 static void handle_arp(EthernetFrameHeader const&, size_t frame_size, RefPtr<NetworkAdapter> adapter);
-static void handle_ipv4(EthernetFrameHeader const&, size_t frame_size, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter);
+static void handle_ipv4(EthernetFrameHeader const&, size_t frame_size, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter, bool checksum_verified);
 static void handle_icmp(EthernetFrameHeader const&, IPv4Packet const&, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter);
 static void handle_ipv6(EthernetFrameHeader const&, size_t frame_size, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter);
 static void handle_icmpv6(EthernetFrameHeader const&, IPv6PacketHeader const&, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter);
-static void handle_udp(IPv4Packet const&, UnixDateTime const& packet_timestamp);
-static void handle_tcp(IPv4Packet const&, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter);
+static void handle_udp(IPv4Packet const&, UnixDateTime const& packet_timestamp, bool checksum_verified);
+static void handle_tcp(IPv4Packet const&, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter, bool checksum_verified);
 static void send_delayed_tcp_ack(TCPSocket& socket);
 static void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, RefPtr<NetworkAdapter> adapter);
-static void flush_delayed_tcp_acks();
 static void retransmit_tcp_packets();
 
-static Thread* network_task = nullptr;
-static HashTable<NonnullRefPtr<TCPSocket>>* delayed_ack_sockets;
+// Incoming frames are spread over several workers by flow, so that a busy connection doesn't hold up
+// all the others. All frames of a TCP or UDP flow go to the same worker and are handled in order.
+static constexpr size_t max_network_workers = 8;
+static constexpr size_t max_queued_frames_per_worker = 256;
+
+// How many frames an adapter in polling mode may take off its receive ring per turn.
+static constexpr size_t adapter_poll_budget = 64;
+
+struct QueuedFrame {
+    RefPtr<NetworkAdapter> adapter;
+    RefPtr<PacketWithTimestamp> packet;
+};
+
+struct NetworkWorker {
+    Thread* thread { nullptr };
+    SpinlockProtected<CircularQueue<QueuedFrame, max_queued_frames_per_worker>, LockRank::None> frames {};
+    DeprecatedWaitQueue wait_queue;
+    // Only ever touched by the worker itself, every socket lives on the worker its flow is hashed to.
+    HashTable<NonnullRefPtr<TCPSocket>> delayed_ack_sockets;
+};
+
+// The first worker is the thread that takes frames from the adapters. It also gets everything that
+// isn't part of a flow (ARP, ICMP, IPv6, fragments), and takes care of retransmissions.
+static Array<NetworkWorker*, max_network_workers> s_workers;
+static Atomic<size_t> s_worker_count { 0 };
+
+static void flush_delayed_tcp_acks(NetworkWorker&);
 
 [[noreturn]] static void NetworkTask_main(void*);
+[[noreturn]] static void network_worker_main(NetworkWorker&);
 
 void NetworkTask::spawn()
 {
-    auto [_, first_thread] = MUST(Process::create_kernel_process("Network Task"sv, NetworkTask_main, nullptr));
-    network_task = first_thread;
+    (void)MUST(Process::create_kernel_process("Network Task"sv, NetworkTask_main, nullptr));
+}
+
+static NetworkWorker* current_worker()
+{
+    auto* current_thread = Thread::current();
+    for (size_t i = 0; i < s_worker_count; ++i) {
+        if (s_workers[i]->thread == current_thread)
+            return s_workers[i];
+    }
+    return nullptr;
 }
 
 bool NetworkTask::is_current()
 {
-    return Thread::current() == network_task;
+    return current_worker() != nullptr;
+}
+
+static NetworkWorker& worker_for_frame(ReadonlyBytes frame)
+{
+    auto& first_worker = *s_workers[0];
+    if (s_worker_count == 1)
+        return first_worker;
+
+    if (frame.size() < sizeof(EthernetFrameHeader) + sizeof(IPv4Packet))
+        return first_worker;
+    auto& eth = *reinterpret_cast<EthernetFrameHeader const*>(frame.data());
+    if (eth.ether_type() != EtherType::IPv4)
+        return first_worker;
+    auto& ipv4_packet = *static_cast<IPv4Packet const*>(eth.payload());
+    if (ipv4_packet.is_a_fragment() || ipv4_packet.length() < sizeof(IPv4Packet) || ipv4_packet.length() > frame.size() - sizeof(EthernetFrameHeader))
+        return first_worker;
+
+    u16 source_port = 0;
+    u16 destination_port = 0;
+    switch ((TransportProtocol)ipv4_packet.protocol()) {
+    case TransportProtocol::TCP: {
+        if (ipv4_packet.payload_size() < sizeof(TCPPacket))
+            return first_worker;
+        auto& tcp_packet = *static_cast<TCPPacket const*>(ipv4_packet.payload());
+        source_port = tcp_packet.source_port();
+        destination_port = tcp_packet.destination_port();
+        break;
+    }
+    case TransportProtocol::UDP: {
+        if (ipv4_packet.payload_size() < sizeof(UDPPacket))
+            return first_worker;
+        auto& udp_packet = *static_cast<UDPPacket const*>(ipv4_packet.payload());
+        source_port = udp_packet.source_port();
+        destination_port = udp_packet.destination_port();
+        break;
+    }
+    default:
+        return first_worker;
+    }
+
+    IPv4SocketTuple tuple(ipv4_packet.destination(), destination_port, ipv4_packet.source(), source_port);
+    return *s_workers[Traits<IPv4SocketTuple>::hash(tuple) % s_worker_count];
+}
+
+static void handle_frame(RefPtr<NetworkAdapter> adapter, PacketWithTimestamp& packet)
+{
+    auto frame = packet.bytes();
+    if (frame.size() < sizeof(EthernetFrameHeader)) {
+        dbgln("NetworkTask: Packet is too small to be an Ethernet packet! ({})", frame.size());
+        return;
+    }
+    auto& eth = *reinterpret_cast<EthernetFrameHeader const*>(frame.data());
+    dbgln_if(ETHERNET_DEBUG, "NetworkTask: From {} to {}, ether_type={:#04x}, packet_size={}", eth.source().to_string(), eth.destination().to_string(), eth.ether_type(), frame.size());
+
+    switch (eth.ether_type()) {
+    case EtherType::ARP:
+        handle_arp(eth, frame.size(), adapter);
+        break;
+    case EtherType::IPv4:
+        handle_ipv4(eth, frame.size(), packet.timestamp, adapter, packet.checksum_verified);
+        break;
+    case EtherType::IPv6:
+        handle_ipv6(eth, frame.size(), packet.timestamp, adapter);
+        break;
+    default:
+        dbgln_if(ETHERNET_DEBUG, "NetworkTask: Unknown ethernet type {:#04x}", eth.ether_type());
+    }
+}
+
+static void dispatch_frame(NonnullRefPtr<NetworkAdapter> adapter, NonnullRefPtr<PacketWithTimestamp> packet)
+{
+    auto& worker = worker_for_frame(packet->bytes());
+    if (&worker == s_workers[0]) {
+        handle_frame(adapter, *packet);
+        adapter->release_packet_buffer(*packet);
+        return;
+    }
+
+    bool queued = worker.frames.with([&](auto& frames) {
+        if (frames.size() == frames.capacity())
+            return false;
+        frames.enqueue(QueuedFrame { adapter, packet });
+        return true;
+    });
+    if (!queued) {
+        dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dropping packet from {}, worker queue is full", adapter->name());
+        adapter->release_packet_buffer(*packet);
+        return;
+    }
+    worker.wait_queue.wake_all();
+}
+
+void network_worker_main(NetworkWorker& worker)
+{
+    while (!Process::current().is_dying()) {
+        flush_delayed_tcp_acks(worker);
+        auto frame = worker.frames.with([](auto& frames) -> Optional<QueuedFrame> {
+            if (frames.is_empty())
+                return {};
+            return frames.dequeue();
+        });
+        if (!frame.has_value()) {
+            auto timeout_time = Duration::from_milliseconds(500);
+            auto timeout = Thread::BlockTimeout { false, &timeout_time };
+            [[maybe_unused]] auto result = worker.wait_queue.wait_on(timeout, "NetworkWorker"sv);
+            continue;
+        }
+        handle_frame(frame->adapter, *frame->packet);
+        frame->adapter->release_packet_buffer(*frame->packet);
+    }
+    Thread::current()->exit();
+    VERIFY_NOT_REACHED();
+}
+
+// Gives the adapters in polling mode a turn, once the frames from their previous turn have been taken off their
+// queue. Returns whether any of them has to be polled again.
+static bool poll_adapters()
+{
+    bool has_adapters_to_poll = false;
+    NetworkingManagement::the().for_each([&](auto& adapter) {
+        if (!adapter.take_scheduled_poll())
+            return;
+        if (adapter.has_queued_packets() || adapter.poll(adapter_poll_budget) == adapter_poll_budget) {
+            adapter.schedule_poll();
+            has_adapters_to_poll = true;
+        }
+    });
+    return has_adapters_to_poll;
 }
 
 void NetworkTask_main(void*)
 {
-    delayed_ack_sockets = new HashTable<NonnullRefPtr<TCPSocket>>;
+    auto worker_count = min<size_t>(Processor::count(), max_network_workers);
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto* worker = new NetworkWorker;
+        if (i == 0) {
+            worker->thread = Thread::current();
+        } else {
+            auto thread_or_error = Process::current().create_kernel_thread("Network Worker"sv, [worker] { network_worker_main(*worker); });
+            if (thread_or_error.is_error()) {
+                dmesgln("NetworkTask: Couldn't create worker thread: {}", thread_or_error.error());
+                delete worker;
+                break;
+            }
+            worker->thread = thread_or_error.value().ptr();
+        }
+        s_workers[i] = worker;
+        ++s_worker_count;
+    }
+    dmesgln("NetworkTask: Handling incoming packets with {} workers", s_worker_count.load());
 
     DeprecatedWaitQueue packet_wait_queue;
     int pending_packets = 0;
@@ -76,62 +259,39 @@ void NetworkTask_main(void*)
             pending_packets++;
             packet_wait_queue.wake_all();
         };
+        adapter.on_poll_scheduled = [&]() {
+            packet_wait_queue.wake_all();
+        };
     });
 
-    size_t buffer_size = 64 * KiB;
-    auto region_or_error = MM.allocate_kernel_region(buffer_size, "Kernel Packet Buffer"sv, Memory::Region::Access::ReadWrite);
-    if (region_or_error.is_error())
-        TODO();
-    auto buffer_region = region_or_error.release_value();
-
-    struct {
-        u8* buffer;
-        UnixDateTime packet_timestamp;
-        RefPtr<NetworkAdapter> adapter;
-    } meta;
-
-    meta.buffer = (u8*)buffer_region->vaddr().get();
-
     while (!Process::current().is_dying()) {
-        flush_delayed_tcp_acks();
+        flush_delayed_tcp_acks(*s_workers[0]);
         retransmit_tcp_packets();
-        size_t packet_size = 0;
+        bool has_adapters_to_poll = poll_adapters();
         if (!pending_packets) {
+            if (has_adapters_to_poll)
+                continue;
             auto timeout_time = Duration::from_milliseconds(500);
             auto timeout = Thread::BlockTimeout { false, &timeout_time };
             [[maybe_unused]] auto result = packet_wait_queue.wait_on(timeout, "NetworkTask"sv);
             continue;
-        } else {
-            NetworkingManagement::the().for_each([&](auto& adapter) {
-                if (packet_size || !adapter.has_queued_packets()) {
-                    return;
-                }
-                packet_size = adapter.dequeue_packet(meta.buffer, buffer_size, meta.packet_timestamp);
-                pending_packets--;
-                dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", adapter.name(), packet_size);
-                meta.adapter = adapter;
-            });
         }
-        if (packet_size < sizeof(EthernetFrameHeader)) {
-            dbgln("NetworkTask: Packet is too small to be an Ethernet packet! ({})", packet_size);
+
+        RefPtr<NetworkAdapter> adapter;
+        RefPtr<PacketWithTimestamp> packet;
+        NetworkingManagement::the().for_each([&](auto& candidate) {
+            if (packet || !candidate.has_queued_packets())
+                return;
+            packet = candidate.dequeue_packet();
+            if (!packet)
+                return;
+            pending_packets--;
+            dbgln_if(NETWORK_TASK_DEBUG, "NetworkTask: Dequeued packet from {} ({} bytes)", candidate.name(), packet->buffer->size());
+            adapter = candidate;
+        });
+        if (!packet)
             continue;
-        }
-        auto& eth = *(EthernetFrameHeader const*)meta.buffer;
-        dbgln_if(ETHERNET_DEBUG, "NetworkTask: From {} to {}, ether_type={:#04x}, packet_size={}", eth.source().to_string(), eth.destination().to_string(), eth.ether_type(), packet_size);
-
-        switch (eth.ether_type()) {
-        case EtherType::ARP:
-            handle_arp(eth, packet_size, meta.adapter);
-            break;
-        case EtherType::IPv4:
-            handle_ipv4(eth, packet_size, meta.packet_timestamp, meta.adapter);
-            break;
-        case EtherType::IPv6:
-            handle_ipv6(eth, packet_size, meta.packet_timestamp, meta.adapter);
-            break;
-        default:
-            dbgln_if(ETHERNET_DEBUG, "NetworkTask: Unknown ethernet type {:#04x}", eth.ether_type());
-        }
+        dispatch_frame(adapter.release_nonnull(), packet.release_nonnull());
     }
     Process::current().sys$exit(0);
     VERIFY_NOT_REACHED();
@@ -180,7 +340,7 @@ void handle_arp(EthernetFrameHeader const& eth, size_t frame_size, RefPtr<Networ
     }
 }
 
-void handle_ipv4(EthernetFrameHeader const& eth, size_t frame_size, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter)
+void handle_ipv4(EthernetFrameHeader const& eth, size_t frame_size, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter, bool checksum_verified)
 {
     constexpr size_t minimum_ipv4_frame_size = sizeof(EthernetFrameHeader) + sizeof(IPv4Packet);
     if (frame_size < minimum_ipv4_frame_size) {
@@ -217,9 +377,9 @@ void handle_ipv4(EthernetFrameHeader const& eth, size_t frame_size, UnixDateTime
     case TransportProtocol::ICMP:
         return handle_icmp(eth, packet, packet_timestamp, adapter);
     case TransportProtocol::UDP:
-        return handle_udp(packet, packet_timestamp);
+        return handle_udp(packet, packet_timestamp, checksum_verified);
     case TransportProtocol::TCP:
-        return handle_tcp(packet, packet_timestamp, adapter);
+        return handle_tcp(packet, packet_timestamp, adapter, checksum_verified);
     default:
         dbgln_if(IPV4_DEBUG, "handle_ipv4: Unhandled protocol {:#02x}", packet.protocol());
         break;
@@ -440,7 +600,15 @@ void handle_icmp(EthernetFrameHeader const& eth, IPv4Packet const& ipv4_packet,
     }
 }
 
-void handle_udp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timestamp)
+// Only needed for packets the adapter hasn't verified already (see NetworkAdapter::Offload::ReceiveChecksum).
+static bool has_valid_checksum(IPv4Packet const& ipv4_packet)
+{
+    auto checksum = ipv4_pseudo_header_checksum(ipv4_packet.source(), ipv4_packet.destination(), static_cast<TransportProtocol>(ipv4_packet.protocol()), ipv4_packet.payload_size());
+    checksum.add({ ipv4_packet.payload(), ipv4_packet.payload_size() });
+    return checksum.finish() == 0;
+}
+
+void handle_udp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timestamp, bool checksum_verified)
 {
     if (ipv4_packet.payload_size() < sizeof(UDPPacket)) {
         dbgln("handle_udp: Packet too small ({}, need {})", ipv4_packet.payload_size(), sizeof(UDPPacket));
@@ -448,24 +616,42 @@ void handle_udp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
     }
 
     auto& udp_packet = *static_cast<UDPPacket const*>(ipv4_packet.payload());
+    // A zero checksum means the sender didn't compute one.
+    if (!checksum_verified && udp_packet.checksum() != 0 && !has_valid_checksum(ipv4_packet)) {
+        dbgln_if(UDP_DEBUG, "handle_udp: Dropping packet with bad checksum");
+        return;
+    }
     dbgln_if(UDP_DEBUG, "handle_udp: source={}:{}, destination={}:{}, length={}",
         ipv4_packet.source(), udp_packet.source_port(),
         ipv4_packet.destination(), udp_packet.destination_port(),
         udp_packet.length());
 
-    auto socket = UDPSocket::from_port(udp_packet.destination_port());
-    if (!socket) {
-        dbgln_if(UDP_DEBUG, "handle_udp: No local UDP socket for {}:{}", ipv4_packet.destination(), udp_packet.destination_port());
+    auto& destination = ipv4_packet.destination();
+    ReadonlyBytes raw_ipv4_packet { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() };
+
+    if (NetworkingManagement::the().from_ipv4_address(destination)) {
+        IPv4SocketTuple tuple(destination, udp_packet.destination_port(), ipv4_packet.source(), udp_packet.source_port());
+        auto socket = UDPSocket::from_tuple(tuple);
+        if (!socket) {
+            dbgln_if(UDP_DEBUG, "handle_udp: No local UDP socket for {}:{}", destination, udp_packet.destination_port());
+            return;
+        }
+        VERIFY(socket->type() == SOCK_DGRAM);
+        VERIFY(socket->local_port() == udp_packet.destination_port());
+        socket->did_receive(ipv4_packet.source(), udp_packet.source_port(), raw_ipv4_packet, packet_timestamp);
         return;
     }
 
-    VERIFY(socket->type() == SOCK_DGRAM);
-    VERIFY(socket->local_port() == udp_packet.destination_port());
-
-    auto& destination = ipv4_packet.destination();
-
-    if (destination == IPv4Address(255, 255, 255, 255) || NetworkingManagement::the().from_ipv4_address(destination) || socket->multicast_memberships().contains_slow(destination))
-        socket->did_receive(ipv4_packet.source(), udp_packet.source_port(), { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() }, packet_timestamp);
+    // Broadcast and multicast datagrams go to every socket on the port that wants them.
+    auto sockets_or_error = UDPSocket::sockets_bound_to_port(udp_packet.destination_port());
+    if (sockets_or_error.is_error()) {
+        dbgln_if(UDP_DEBUG, "handle_udp: Dropping datagram for {}:{}: {}", destination, udp_packet.destination_port(), sockets_or_error.error());
+        return;
+    }
+    for (auto& socket : sockets_or_error.value()) {
+        if (destination == IPv4Address(255, 255, 255, 255) || socket->multicast_memberships().contains_slow(destination))
+            socket->did_receive(ipv4_packet.source(), udp_packet.source_port(), raw_ipv4_packet, packet_timestamp);
+    }
 }
 
 void send_delayed_tcp_ack(TCPSocket& socket)
@@ -476,13 +662,16 @@ void send_delayed_tcp_ack(TCPSocket& socket)
         return;
     }
 
-    delayed_ack_sockets->set(move(socket));
+    auto* worker = current_worker();
+    VERIFY(worker);
+    worker->delayed_ack_sockets.set(move(socket));
 }
 
-void flush_delayed_tcp_acks()
+void flush_delayed_tcp_acks(NetworkWorker& worker)
 {
+    auto& delayed_ack_sockets = worker.delayed_ack_sockets;
     Vector<NonnullRefPtr<TCPSocket>, 32> remaining_sockets;
-    for (auto& socket : *delayed_ack_sockets) {
+    for (auto& socket : delayed_ack_sockets) {
         MutexLocker locker(socket->mutex());
         if (socket->should_delay_next_ack()) {
             MUST(remaining_sockets.try_append(*socket));
@@ -491,12 +680,12 @@ void flush_delayed_tcp_acks()
         [[maybe_unused]] auto result = socket->send_ack();
     }
 
-    if (remaining_sockets.size() != delayed_ack_sockets->size()) {
-        delayed_ack_sockets->clear();
+    if (remaining_sockets.size() != delayed_ack_sockets.size()) {
+        delayed_ack_sockets.clear();
         if (remaining_sockets.size() > 0)
             dbgln("flush_delayed_tcp_acks: {} sockets remaining", remaining_sockets.size());
         for (auto&& socket : remaining_sockets)
-            delayed_ack_sockets->set(move(socket));
+            delayed_ack_sockets.set(move(socket));
     }
 }
 
@@ -534,7 +723,7 @@ void send_tcp_rst(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, Re
     routing_decision.adapter->release_packet_buffer(*packet);
 }
 
-void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter)
+void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timestamp, RefPtr<NetworkAdapter> adapter, bool checksum_verified)
 {
     if (ipv4_packet.payload_size() < sizeof(TCPPacket)) {
         dbgln("handle_tcp: IPv4 payload is too small to be a TCP packet ({}, need {})", ipv4_packet.payload_size(), sizeof(TCPPacket));
@@ -556,6 +745,11 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
 
     size_t payload_size = ipv4_packet.payload_size() - tcp_packet.header_size();
 
+    if (!checksum_verified && !has_valid_checksum(ipv4_packet)) {
+        dbgln_if(TCP_DEBUG, "handle_tcp: Dropping packet with bad checksum");
+        return;
+    }
+
     dbgln_if(TCP_DEBUG, "handle_tcp: source={}:{}, destination={}:{}, seq_no={}, ack_no={}, flags={:#04x} ({}{}{}{}), window_size={}, payload_size={}",
         ipv4_packet.source().to_string(),
         tcp_packet.source_port(),
@@ -593,8 +787,13 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
 
     socket->receive_tcp_packet(tcp_packet, ipv4_packet.payload_size());
     Optional<u8> send_window_scale;
+    bool sack_permitted = false;
     if (tcp_packet.has_syn()) {
-        tcp_packet.for_each_option([&send_window_scale](auto const& option) {
+        tcp_packet.for_each_option([&send_window_scale, &sack_permitted](auto const& option) {
+            if (option.kind() == TCPOptionKind::SACKPermitted && option.length() == sizeof(TCPOptionSACKPermitted)) {
+                sack_permitted = true;
+                return;
+            }
             if (option.kind() != TCPOptionKind::WindowScale)
                 return;
             if (option.length() != sizeof(TCPOptionWindowScale))
@@ -637,6 +836,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
             dbgln_if(TCP_DEBUG, "handle_tcp: created new client socket with tuple {}", client->tuple().to_string());
             client->set_sequence_number(1000);
             client->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
+            client->set_sack_permitted(sack_permitted);
             [[maybe_unused]] auto rc2 = client->send_tcp_packet(TCPFlags::SYN | TCPFlags::ACK);
             client->set_state(TCPSocket::State::SynReceived);
             if (send_window_scale.has_value())
@@ -652,6 +852,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
         switch (tcp_packet.flags()) {
         case TCPFlags::SYN:
             socket->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
+            socket->set_sack_permitted(sack_permitted);
             (void)socket->send_tcp_packet(TCPFlags::SYN | TCPFlags::ACK);
             socket->set_state(TCPSocket::State::SynReceived);
             if (send_window_scale.has_value())
@@ -659,6 +860,7 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
             return;
         case TCPFlags::ACK | TCPFlags::SYN:
             socket->set_ack_number(tcp_packet.sequence_number() + payload_size + 1);
+            socket->set_sack_permitted(sack_permitted);
             (void)socket->send_ack(true);
             socket->set_state(TCPSocket::State::Established);
             socket->set_setup_state(Socket::SetupState::Completed);
@@ -816,6 +1018,12 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
         }
 
         if (tcp_packet.sequence_number() != socket->ack_number()) {
+            // RFC 5681 section 4.2: Segments after a hole are acknowledged right away, so the peer notices it soon.
+            if (!tcp_packet.has_fin() && socket->queue_out_of_order_segment(ipv4_packet, tcp_packet, payload_size, packet_timestamp)) {
+                dbgln_if(TCP_DEBUG, "Queued out of order packet: seq {} vs. ack {}", tcp_packet.sequence_number(), socket->ack_number());
+                [[maybe_unused]] auto result = socket->send_ack(true);
+                return;
+            }
             dbgln_if(TCP_DEBUG, "Discarding out of order packet: seq {} vs. ack {}", tcp_packet.sequence_number(), socket->ack_number());
             if (socket->duplicate_acks() < TCPSocket::maximum_duplicate_acks) {
                 dbgln_if(TCP_DEBUG, "Sending ACK with same ack number to trigger fast retransmission");
@@ -843,7 +1051,12 @@ void handle_tcp(IPv4Packet const& ipv4_packet, UnixDateTime const& packet_timest
                 socket->set_ack_number(tcp_packet.sequence_number() + payload_size);
                 dbgln_if(TCP_DEBUG, "Got packet with ack_no={}, seq_no={}, payload_size={}, acking it with new ack_no={}, seq_no={}",
                     tcp_packet.ack_number(), tcp_packet.sequence_number(), payload_size, socket->ack_number(), socket->sequence_number());
-                send_delayed_tcp_ack(*socket);
+                // Filling a hole is acknowledged right away as well (RFC 5681 section 4.2).
+                if (socket->receive_queued_segments()) {
+                    [[maybe_unused]] auto result = socket->send_ack();
+                } else {
+                    send_delayed_tcp_ack(*socket);
+                }
             }
         }
     }
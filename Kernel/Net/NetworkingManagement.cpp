@@ -129,6 +129,7 @@ UNMAP_AFTER_INIT ErrorOr<NonnullRefPtr<NetworkAdapter>> NetworkingManagement::de
         if (initializer_probe_found_driver_match) {
             auto adapter = TRY(initializer.create(device_identifier));
             TRY(adapter->initialize({}));
+            TRY(adapter->preallocate_packet_buffers());
             return adapter;
         }
     }
@@ -152,6 +153,7 @@ bool NetworkingManagement::initialize()
         }));
     }
     auto loopback = MUST(LoopbackAdapter::try_create());
+    MUST(loopback->preallocate_packet_buffers());
     m_adapters.with([&](auto& adapters) { adapters.append(*loopback); });
     m_loopback_adapter = *loopback;
     return true;
@@ -433,6 +433,7 @@ void RTL8168NetworkAdapter::startup()
         enabled_interrupts |= INT_RX_FIFO_OVERFLOW;
         enabled_interrupts &= ~INT_RX_OVERFLOW;
     }
+    m_enabled_interrupts = enabled_interrupts;
     out16(REG_IMR, enabled_interrupts);
     pci_commit();
 
@@ -1286,6 +1287,9 @@ UNMAP_AFTER_INIT void RTL8168NetworkAdapter::initialize_tx_descriptors()
 
 UNMAP_AFTER_INIT RTL8168NetworkAdapter::~RTL8168NetworkAdapter() = default;
 
+// The receive interrupts are masked while the network task polls the ring.
+static constexpr u16 receive_interrupts = INT_RXOK | INT_RXERR | INT_RX_OVERFLOW | INT_RX_FIFO_OVERFLOW;
+
 bool RTL8168NetworkAdapter::handle_irq()
 {
     bool was_handled = false;
@@ -1303,7 +1307,6 @@ bool RTL8168NetworkAdapter::handle_irq()
         was_handled = true;
         if (status & INT_RXOK) {
             dbgln_if(RTL8168_DEBUG, "RTL8168: RX ready");
-            receive();
         }
         if (status & INT_RXERR) {
             dbgln_if(RTL8168_DEBUG, "RTL8168: RX error - invalid packet");
@@ -1317,7 +1320,6 @@ bool RTL8168NetworkAdapter::handle_irq()
         }
         if (status & INT_RX_OVERFLOW) {
             dmesgln_pci(*this, "RX descriptor unavailable (packet lost)");
-            receive();
         }
         if (status & INT_LINK_CHANGE) {
             m_link_up = (in8(REG_PHYSTATUS) & PHY_LINK_STATUS) != 0;
@@ -1326,15 +1328,27 @@ bool RTL8168NetworkAdapter::handle_irq()
         }
         if (status & INT_RX_FIFO_OVERFLOW) {
             dmesgln_pci(*this, "RX FIFO overflow");
-            receive();
         }
         if (status & INT_SYS_ERR) {
             dmesgln_pci(*this, "Fatal system error");
         }
+        if (status & receive_interrupts) {
+            // The ring is left to the network task until it's empty.
+            out16(REG_IMR, m_enabled_interrupts & ~receive_interrupts);
+            schedule_poll();
+        }
     }
     return was_handled;
 }
 
+size_t RTL8168NetworkAdapter::poll(size_t budget)
+{
+    auto received = receive(budget);
+    if (received < budget)
+        out16(REG_IMR, m_enabled_interrupts);
+    return received;
+}
+
 void RTL8168NetworkAdapter::reset()
 {
     out8(REG_COMMAND, COMMAND_RESET);
@@ -1386,16 +1400,15 @@ void RTL8168NetworkAdapter::send_raw(ReadonlyBytes payload)
     out8(REG_TXSTART, TXSTART_START); // FIXME: this shouldn't be done so often, we should look into doing this using the watchdog timer
 }
 
-void RTL8168NetworkAdapter::receive()
+size_t RTL8168NetworkAdapter::receive(size_t budget)
 {
-    for (u16 i = 0; i < number_of_rx_descriptors; ++i) {
-        auto descriptor_index = (m_rx_free_index + i) % number_of_rx_descriptors;
+    size_t received = 0;
+    while (received < budget) {
+        auto descriptor_index = m_rx_free_index;
         auto& descriptor = m_rx_descriptors[descriptor_index];
 
-        if ((descriptor.flags & RXDescriptor::Ownership) != 0) {
-            m_rx_free_index = descriptor_index;
+        if ((descriptor.flags & RXDescriptor::Ownership) != 0)
             break;
-        }
 
         u16 flags = descriptor.flags;
         u16 length = descriptor.buffer_size & 0x3FFF;
@@ -1417,7 +1430,11 @@ void RTL8168NetworkAdapter::receive()
         if (descriptor_index == number_of_rx_descriptors - 1)
             flags |= RXDescriptor::EndOfRing;
         descriptor.flags = flags; // let the NIC know it can use this descriptor again
+
+        m_rx_free_index = (descriptor_index + 1) % number_of_rx_descriptors;
+        ++received;
     }
+    return received;
 }
 
 void RTL8168NetworkAdapter::out8(u16 address, u8 data)
@@ -32,6 +32,7 @@ public:
     virtual bool link_up() override { return m_link_up; }
     virtual bool link_full_duplex() override;
     virtual i32 link_speed() override;
+    virtual size_t poll(size_t budget) override;
 
     virtual StringView purpose() const override { return class_name(); }
     virtual StringView device_name() const override { return class_name(); }
@@ -159,7 +160,7 @@ private:
     void initialize_rx_descriptors();
     void initialize_tx_descriptors();
 
-    void receive();
+    size_t receive(size_t budget);
 
     void out8(u16 address, u8 data);
     void out16(u16 address, u16 data);
@@ -218,6 +219,7 @@ private:
     Vector<NonnullOwnPtr<Memory::Region>> m_tx_buffers_regions;
     u16 m_tx_free_index { 0 };
     bool m_link_up { false };
+    u16 m_enabled_interrupts { 0 };
     EntropySource m_entropy_source;
     DeprecatedWaitQueue m_wait_queue;
 };
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashFunctions.h>
 #include <AK/HashMap.h>
 #include <AK/Singleton.h>
 #include <Kernel/Debug.h>
@@ -17,7 +18,90 @@
 namespace Kernel {
 
 static Singleton<SpinlockProtected<HashMap<IPv4Address, MACAddress>, LockRank::None>> s_arp_table;
-static Singleton<SpinlockProtected<Route::RouteList, LockRank::None>> s_routing_table;
+static Singleton<SpinlockProtected<RoutingTable, LockRank::None>> s_routing_table;
+static Atomic<u32> s_routing_generation { 1 };
+
+// Recently used ARP entries, which route_to() can look up without taking the ARP table lock. Each slot is
+// a seqlock: Writers hold the ARP table lock and make the sequence odd while they change the slot, and
+// readers retry if the sequence was odd or changed while they were reading.
+class NeighbourCache {
+public:
+    Optional<MACAddress> get(IPv4Address const& address) const
+    {
+        auto const& slot = slot_for(address);
+        for (;;) {
+            auto sequence = slot.sequence.load(AK::MemoryOrder::memory_order_acquire);
+            if (sequence & 1) {
+                Processor::wait_check();
+                continue;
+            }
+            auto slot_address = slot.address.load(AK::MemoryOrder::memory_order_relaxed);
+            auto slot_mac_address = slot.mac_address.load(AK::MemoryOrder::memory_order_relaxed);
+            AK::atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+            if (slot.sequence.load(AK::MemoryOrder::memory_order_relaxed) != sequence)
+                continue;
+            if (slot_address == 0 || slot_address != address.to_u32())
+                return {};
+            return unpack(slot_mac_address);
+        }
+    }
+
+    // Has to be called with the ARP table lock held.
+    void set(IPv4Address const& address, MACAddress const& mac_address)
+    {
+        write(slot_for(address), address.to_u32(), pack(mac_address));
+    }
+
+    // Has to be called with the ARP table lock held.
+    void remove(IPv4Address const& address)
+    {
+        auto& slot = slot_for(address);
+        if (slot.address.load(AK::MemoryOrder::memory_order_relaxed) == address.to_u32())
+            write(slot, 0, 0);
+    }
+
+private:
+    static constexpr size_t slot_count = 64;
+
+    struct Slot {
+        Atomic<u32> sequence { 0 };
+        Atomic<u32> address { 0 };
+        Atomic<u64> mac_address { 0 };
+    };
+
+    static void write(Slot& slot, u32 address, u64 mac_address)
+    {
+        auto sequence = slot.sequence.load(AK::MemoryOrder::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, AK::MemoryOrder::memory_order_relaxed);
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_release);
+        slot.address.store(address, AK::MemoryOrder::memory_order_relaxed);
+        slot.mac_address.store(mac_address, AK::MemoryOrder::memory_order_relaxed);
+        slot.sequence.store(sequence + 2, AK::MemoryOrder::memory_order_release);
+    }
+
+    static u64 pack(MACAddress const& mac_address)
+    {
+        u64 packed = 0;
+        for (size_t i = 0; i < 6; ++i)
+            packed |= static_cast<u64>(mac_address[i]) << (8 * i);
+        return packed;
+    }
+
+    static MACAddress unpack(u64 packed)
+    {
+        MACAddress mac_address;
+        for (size_t i = 0; i < 6; ++i)
+            mac_address[i] = (packed >> (8 * i)) & 0xff;
+        return mac_address;
+    }
+
+    Slot& slot_for(IPv4Address const& address) { return m_slots[int_hash(address.to_u32()) % slot_count]; }
+    Slot const& slot_for(IPv4Address const& address) const { return m_slots[int_hash(address.to_u32()) % slot_count]; }
+
+    Array<Slot, slot_count> m_slots;
+};
+
+static Singleton<NeighbourCache> s_neighbour_cache;
 
 class ARPTableBlocker final : public Thread::Blocker {
 public:
@@ -113,12 +197,21 @@ SpinlockProtected<HashMap<IPv4Address, MACAddress>, LockRank::None>& arp_table()
 
 void update_arp_table(IPv4Address const& ip_addr, MACAddress const& addr, UpdateTable update)
 {
-    arp_table().with([&](auto& table) {
-        if (update == UpdateTable::Set)
+    bool did_change = arp_table().with([&](auto& table) {
+        if (update == UpdateTable::Set) {
+            auto previous_mac_address = table.get(ip_addr);
+            if (previous_mac_address.has_value() && previous_mac_address.value() == addr)
+                return false;
             table.set(ip_addr, addr);
-        if (update == UpdateTable::Delete)
-            table.remove(ip_addr);
+            s_neighbour_cache->set(ip_addr, addr);
+            return true;
+        }
+        s_neighbour_cache->remove(ip_addr);
+        return table.remove(ip_addr);
     });
+    // Every ARP packet we see updates the table, but only actual changes make the cached routes stale.
+    if (did_change)
+        invalidate_routing_decisions();
     s_arp_table_blocker_set->unblock_blockers_waiting_for_ipv4_address(ip_addr, addr);
 
     if constexpr (ARP_DEBUG) {
@@ -130,11 +223,55 @@ void update_arp_table(IPv4Address const& ip_addr, MACAddress const& addr, Update
     }
 }
 
-SpinlockProtected<Route::RouteList, LockRank::None>& routing_table()
+SpinlockProtected<RoutingTable, LockRank::None>& routing_table()
 {
     return *s_routing_table;
 }
 
+u32 routing_generation()
+{
+    return s_routing_generation.load(AK::MemoryOrder::memory_order_acquire);
+}
+
+void invalidate_routing_decisions()
+{
+    s_routing_generation.fetch_add(1, AK::MemoryOrder::memory_order_release);
+}
+
+ErrorOr<void> RouteTrie::insert(Route& route)
+{
+    auto destination = to_host_order(route.destination);
+    auto* node = &m_root;
+    for (size_t depth = 0; depth < prefix_length(route.netmask); ++depth) {
+        auto& child = node->children[bit_at(destination, depth)];
+        if (!child)
+            child = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Node));
+        node = child.ptr();
+    }
+    TRY(node->routes.try_append(route));
+    return {};
+}
+
+void RouteTrie::remove(Route const& route)
+{
+    remove_from(m_root, route, to_host_order(route.destination), 0, prefix_length(route.netmask));
+}
+
+void RouteTrie::remove_from(Node& node, Route const& route, u32 host_order_destination, size_t depth, size_t prefix_length)
+{
+    if (depth == prefix_length) {
+        node.routes.remove_first_matching([&](auto& candidate) { return candidate.ptr() == &route; });
+        return;
+    }
+    auto& child = node.children[bit_at(host_order_destination, depth)];
+    if (!child)
+        return;
+    remove_from(*child, route, host_order_destination, depth + 1, prefix_length);
+    // Nodes that lead nowhere anymore are pruned on the way back up.
+    if (child->is_empty())
+        child = nullptr;
+}
+
 ErrorOr<void> update_routing_table(IPv4Address const& destination, IPv4Address const& gateway, IPv4Address const& netmask, u16 flags, RefPtr<NetworkAdapter> adapter, UpdateTable update)
 {
     dbgln_if(ROUTING_DEBUG, "update_routing_table {} {} {} {} {} {}", destination, gateway, netmask, flags, adapter, update == UpdateTable::Set ? "Set" : "Delete");
@@ -145,18 +282,20 @@ ErrorOr<void> update_routing_table(IPv4Address const& destination, IPv4Address c
 
     TRY(routing_table().with([&](auto& table) -> ErrorOr<void> {
         if (update == UpdateTable::Set) {
-            for (auto const& route : table) {
+            for (auto const& route : table.routes) {
                 if (route == *route_entry)
                     return EEXIST;
             }
-            table.append(*route_entry);
+            TRY(table.trie.insert(*route_entry));
+            table.routes.append(*route_entry);
         }
         if (update == UpdateTable::Delete) {
-            for (auto& route : table) {
+            for (auto& route : table.routes) {
                 dbgln_if(ROUTING_DEBUG, "candidate: {} {} {} {} {}", route.destination, route.gateway, route.netmask, route.flags, route.adapter);
                 if (route.matches(*route_entry)) {
                     // FIXME: Remove all entries, not only the first one.
-                    table.remove(route);
+                    table.trie.remove(route);
+                    table.routes.remove(route);
                     return {};
                 }
             }
@@ -165,6 +304,7 @@ ErrorOr<void> update_routing_table(IPv4Address const& destination, IPv4Address c
         return {};
     }));
 
+    invalidate_routing_decisions();
     return {};
 }
 
@@ -222,38 +362,11 @@ RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, R
             local_adapter = adapter;
     });
 
-    u32 longest_prefix_match = 0;
-    routing_table().for_each([&target_addr, &matches, &longest_prefix_match, &chosen_route](auto& route) {
-        auto route_addr = route.destination.to_u32();
-        auto route_mask = route.netmask.to_u32();
-
-        if (route_addr == 0 && matches(*route.adapter)) {
-            dbgln_if(ROUTING_DEBUG, "Resorting to default route found for adapter: {}", route.adapter->name());
-            chosen_route = route;
-        }
-
-        // We have a direct match and we can exit the routing table earlier.
-        if (target_addr == route_addr) {
-            dbgln_if(ROUTING_DEBUG, "Target address has a direct match in the routing table");
-            chosen_route = route;
-            return;
-        }
-
-        if ((target_addr & route_mask) == (route_addr & route_mask) && (route_addr != 0)) {
-            auto prefix = (target_addr & (route_addr & route_mask));
-
-            if (chosen_route && prefix == longest_prefix_match) {
-                chosen_route = (route.netmask.to_u32() > chosen_route->netmask.to_u32()) ? route : chosen_route;
-                dbgln_if(ROUTING_DEBUG, "Found a matching prefix match. Using longer netmask: {}", chosen_route->netmask);
-            }
-
-            if (prefix > longest_prefix_match) {
-                dbgln_if(ROUTING_DEBUG, "Found a longer prefix match - route: {}, netmask: {}", route.destination.to_string(), route.netmask);
-                longest_prefix_match = prefix;
-                chosen_route = route;
-            }
-        }
+    chosen_route = routing_table().with([&](auto const& table) {
+        return table.trie.longest_prefix_match(target, [&](Route const& route) { return matches(*route.adapter); });
     });
+    if (chosen_route)
+        dbgln_if(ROUTING_DEBUG, "Found a longest prefix match - route: {}, netmask: {}", chosen_route->destination, chosen_route->netmask);
 
     if (local_adapter && target == local_adapter->ipv4_address())
         return { local_adapter, local_adapter->mac_address() };
@@ -304,9 +417,16 @@ RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, R
         return { adapter, multicast_ethernet_address(target) };
 
     {
-        auto addr = arp_table().with([&](auto const& table) -> auto {
-            return table.get(next_hop_ip);
-        });
+        auto addr = s_neighbour_cache->get(next_hop_ip);
+        if (!addr.has_value()) {
+            addr = arp_table().with([&](auto const& table) -> Optional<MACAddress> {
+                auto addr = table.get(next_hop_ip);
+                if (!addr.has_value())
+                    return {};
+                s_neighbour_cache->set(next_hop_ip, addr.value());
+                return addr.value();
+            });
+        }
         if (addr.has_value()) {
             dbgln_if(ARP_DEBUG, "Routing: Using cached ARP entry for {} ({})", next_hop_ip, addr.value().to_string());
             return { adapter, addr.value() };
@@ -345,4 +465,30 @@ RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, R
     return { nullptr, {} };
 }
 
+RoutingDecision CachedRoutingDecision::route_to(IPv4Address const& target, IPv4Address const& source, RefPtr<NetworkAdapter> const through, AllowBroadcast allow_broadcast, AllowUsingGateway allow_using_gateway)
+{
+    // The generation is read first, so a change that races with the lookup below leaves the entry stale.
+    auto generation = routing_generation();
+    auto cached_decision = m_entry.with([&](auto const& entry) -> Optional<RoutingDecision> {
+        if (!entry.has_value() || entry->generation != generation)
+            return {};
+        if (entry->target != target || entry->source != source || entry->through != through)
+            return {};
+        if (entry->allow_broadcast != allow_broadcast || entry->allow_using_gateway != allow_using_gateway)
+            return {};
+        return entry->decision;
+    });
+    if (cached_decision.has_value() && cached_decision->adapter->link_up())
+        return cached_decision.release_value();
+
+    auto decision = Kernel::route_to(target, source, through, allow_broadcast, allow_using_gateway);
+    m_entry.with([&](auto& entry) {
+        if (decision.is_zero())
+            entry.clear();
+        else
+            entry = Entry { target, source, through, allow_broadcast, allow_using_gateway, generation, decision };
+    });
+    return decision;
+}
+
 }
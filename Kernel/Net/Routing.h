@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/IPv4Address.h>
 #include <AK/IPv6Address.h>
 #include <AK/RefPtr.h>
 #include <Kernel/Locking/MutexProtected.h>
+#include <Kernel/Locking/SpinlockProtected.h>
 #include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/Tasks/Thread.h>
 
@@ -45,6 +48,54 @@ struct Route final : public AtomicRefCounted<Route> {
     using RouteList = IntrusiveList<&Route::route_list_node>;
 };
 
+// Routes indexed by their destination prefix, one bit of the address per level.
+class RouteTrie {
+public:
+    ErrorOr<void> insert(Route&);
+    void remove(Route const&);
+
+    // The route with the longest prefix that contains the address, out of the ones the filter accepts.
+    template<typename Filter>
+    RefPtr<Route> longest_prefix_match(IPv4Address const& address, Filter filter) const
+    {
+        auto host_order_address = to_host_order(address);
+        RefPtr<Route> match;
+        auto const* node = &m_root;
+        for (size_t depth = 0; node; ++depth) {
+            for (auto& route : node->routes) {
+                if (filter(*route)) {
+                    match = route;
+                    break;
+                }
+            }
+            if (depth == 32)
+                break;
+            node = node->children[bit_at(host_order_address, depth)].ptr();
+        }
+        return match;
+    }
+
+private:
+    struct Node {
+        Array<OwnPtr<Node>, 2> children;
+        Vector<NonnullRefPtr<Route>, 1> routes;
+
+        bool is_empty() const { return routes.is_empty() && !children[0] && !children[1]; }
+    };
+
+    static u32 to_host_order(IPv4Address const& address) { return (address[0] << 24) | (address[1] << 16) | (address[2] << 8) | address[3]; }
+    static size_t bit_at(u32 host_order_address, size_t depth) { return (host_order_address >> (31 - depth)) & 1; }
+    static size_t prefix_length(IPv4Address const& netmask) { return count_leading_zeroes_safe(~to_host_order(netmask)); }
+    static void remove_from(Node&, Route const&, u32 host_order_destination, size_t depth, size_t prefix_length);
+
+    Node m_root;
+};
+
+struct RoutingTable {
+    Route::RouteList routes;
+    RouteTrie trie;
+};
+
 struct RoutingDecision {
     RefPtr<NetworkAdapter> adapter;
     MACAddress next_hop;
@@ -72,7 +123,31 @@ enum class AllowBroadcast {
 
 RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, RefPtr<NetworkAdapter> const through = nullptr, AllowBroadcast = AllowBroadcast::No, AllowUsingGateway = AllowUsingGateway::Yes);
 
+// Changes whenever a routing decision made before might not hold anymore: When a route, ARP entry,
+// or adapter address changes.
+u32 routing_generation();
+void invalidate_routing_decisions();
+
+// A routing decision that is remembered until the routing generation changes, so that sending to the same
+// peer again doesn't have to look at the routing and ARP tables.
+class CachedRoutingDecision {
+public:
+    RoutingDecision route_to(IPv4Address const& target, IPv4Address const& source, RefPtr<NetworkAdapter> const through = nullptr, AllowBroadcast = AllowBroadcast::No, AllowUsingGateway = AllowUsingGateway::Yes);
+
+private:
+    struct Entry {
+        IPv4Address target;
+        IPv4Address source;
+        RefPtr<NetworkAdapter> through;
+        AllowBroadcast allow_broadcast { AllowBroadcast::No };
+        AllowUsingGateway allow_using_gateway { AllowUsingGateway::Yes };
+        u32 generation { 0 };
+        RoutingDecision decision;
+    };
+    SpinlockProtected<Optional<Entry>, LockRank::None> m_entry {};
+};
+
 SpinlockProtected<HashMap<IPv4Address, MACAddress>, LockRank::None>& arp_table();
-SpinlockProtected<Route::RouteList, LockRank::None>& routing_table();
+SpinlockProtected<RoutingTable, LockRank::None>& routing_table();
 
 }
@@ -74,7 +74,7 @@ ErrorOr<void> Socket::queue_connection_from(NonnullRefPtr<Socket> peer)
     return {};
 }
 
-ErrorOr<void> Socket::setsockopt(int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
+ErrorOr<void> Socket::setsockopt(OpenFileDescription&, int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
 {
     MutexLocker locker(mutex());
 
@@ -127,9 +127,18 @@ ErrorOr<void> Socket::setsockopt(int level, int option, Userspace<void const*> u
         m_routing_disabled = TRY(copy_typed_from_user(static_ptr_cast<int const*>(user_value))) != 0;
         return {};
     }
-    case SO_REUSEADDR:
-        dbgln("FIXME: SO_REUSEADDR requested, but not implemented.");
+    case SO_REUSEADDR: {
+        if (user_value_size != sizeof(int))
+            return EINVAL;
+        m_reuse_address = TRY(copy_typed_from_user(static_ptr_cast<int const*>(user_value))) != 0;
         return {};
+    }
+    case SO_REUSEPORT: {
+        if (user_value_size != sizeof(int))
+            return EINVAL;
+        m_reuse_port = TRY(copy_typed_from_user(static_ptr_cast<int const*>(user_value))) != 0;
+        return {};
+    }
     case SO_BROADCAST: {
         if (user_value_size != sizeof(int))
             return EINVAL;
@@ -242,13 +251,21 @@ ErrorOr<void> Socket::getsockopt(OpenFileDescription&, int level, int option, Us
         return copy_to_user(value_size, &size);
     }
     case SO_REUSEADDR: {
-        int reuse_address = 0;
+        int reuse_address = m_reuse_address ? 1 : 0;
         if (size < sizeof(reuse_address))
             return EINVAL;
         TRY(copy_to_user(static_ptr_cast<int*>(value), &reuse_address));
         size = sizeof(reuse_address);
         return copy_to_user(value_size, &size);
     }
+    case SO_REUSEPORT: {
+        int reuse_port = m_reuse_port ? 1 : 0;
+        if (size < sizeof(reuse_port))
+            return EINVAL;
+        TRY(copy_to_user(static_ptr_cast<int*>(value), &reuse_port));
+        size = sizeof(reuse_port);
+        return copy_to_user(value_size, &size);
+    }
     case SO_BROADCAST: {
         int broadcast_allowed = m_broadcast_allowed ? 1 : 0;
         if (size < sizeof(broadcast_allowed))
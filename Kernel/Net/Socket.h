@@ -81,7 +81,7 @@ public:
     virtual ErrorOr<size_t> sendto(OpenFileDescription&, UserOrKernelBuffer const&, size_t, int flags, Userspace<sockaddr const*>, socklen_t) = 0;
     virtual ErrorOr<size_t> recvfrom(OpenFileDescription&, UserOrKernelBuffer&, size_t, int flags, Userspace<sockaddr*>, Userspace<socklen_t*>, UnixDateTime&, bool blocking) = 0;
 
-    virtual ErrorOr<void> setsockopt(int level, int option, Userspace<void const*>, socklen_t);
+    virtual ErrorOr<void> setsockopt(OpenFileDescription&, int level, int option, Userspace<void const*>, socklen_t);
     virtual ErrorOr<void> getsockopt(OpenFileDescription&, int level, int option, Userspace<void*>, Userspace<socklen_t*>);
 
     ProcessID origin_pid() const { return m_origin.pid; }
@@ -108,6 +108,9 @@ public:
 
     bool wants_timestamp() const { return m_timestamp; }
 
+    bool reuses_address() const { return m_reuse_address; }
+    bool reuses_port() const { return m_reuse_port; }
+
 protected:
     Socket(int domain, int type, int protocol);
 
@@ -157,6 +160,8 @@ protected:
     ucred m_acceptor { 0, 0, 0 };
     bool m_routing_disabled { false };
     bool m_broadcast_allowed { false };
+    bool m_reuse_address { false };
+    bool m_reuse_port { false };
 
 private:
     virtual bool is_socket() const final { return true; }
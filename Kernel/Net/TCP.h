@@ -76,7 +76,42 @@ private:
     NetworkOrdered<u8> m_value;
 };
 
+class [[gnu::packed]] TCPOptionSACKPermitted : public TCPOption {
+public:
+    TCPOptionSACKPermitted()
+        : TCPOption(TCPOptionKind::SACKPermitted, sizeof(TCPOptionSACKPermitted))
+    {
+    }
+};
+
+struct [[gnu::packed]] TCPSACKBlock {
+    // The first sequence number of a block of received data, and the one just after it.
+    NetworkOrdered<u32> left_edge;
+    NetworkOrdered<u32> right_edge;
+};
+
+class [[gnu::packed]] TCPOptionSACK : public TCPOption {
+public:
+    // Without timestamps, that's as many as fit into the 40 bytes of TCP options.
+    static constexpr size_t maximum_block_count = 4;
+
+    explicit TCPOptionSACK(size_t block_count)
+        : TCPOption(TCPOptionKind::SACK, sizeof(TCPOptionSACK) + block_count * sizeof(TCPSACKBlock))
+    {
+        VERIFY(block_count <= maximum_block_count);
+    }
+
+    size_t block_count() const { return (length() - sizeof(TCPOptionSACK)) / sizeof(TCPSACKBlock); }
+    TCPSACKBlock const& block(size_t index) const { return m_blocks[index]; }
+    TCPSACKBlock& block(size_t index) { return m_blocks[index]; }
+
+private:
+    TCPSACKBlock m_blocks[0];
+};
+
 static_assert(AssertSize<TCPOptionMSS, 4>());
+static_assert(AssertSize<TCPOptionSACKPermitted, 2>());
+static_assert(AssertSize<TCPSACKBlock, 8>());
 
 class [[gnu::packed]] TCPPacket {
 public:
@@ -113,6 +148,8 @@ public:
 
     u16 checksum() const { return m_checksum; }
     void set_checksum(u16 checksum) { m_checksum = checksum; }
+    // For network adapters that fill in the checksum.
+    static constexpr size_t checksum_offset = 16;
 
     u16 urgent() const { return m_urgent; }
     void set_urgent(u16 urgent) { m_urgent = urgent; }
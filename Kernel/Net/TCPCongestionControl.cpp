@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Net/TCPCongestionControl.h>
+
+namespace Kernel {
+
+ErrorOr<NonnullOwnPtr<TCPCongestionControl>> TCPCongestionControl::try_create(StringView algorithm, u32 maximum_segment_size)
+{
+    if (algorithm == "cubic"sv)
+        return adopt_nonnull_own_or_enomem(new (nothrow) TCPCubicCongestionControl(maximum_segment_size));
+    if (algorithm == "newreno"sv)
+        return adopt_nonnull_own_or_enomem(new (nothrow) TCPNewRenoCongestionControl(maximum_segment_size));
+    return ENOENT;
+}
+
+TCPCongestionControl::TCPCongestionControl(u32 maximum_segment_size)
+    : m_maximum_segment_size(maximum_segment_size)
+{
+    // RFC 6928: Start out with about 10 segments.
+    m_congestion_window = min(10 * maximum_segment_size, max(2 * maximum_segment_size, 14600u));
+}
+
+void TCPCongestionControl::set_maximum_segment_size(u32 maximum_segment_size)
+{
+    VERIFY(maximum_segment_size > 0);
+    m_maximum_segment_size = maximum_segment_size;
+    set_congestion_window(m_congestion_window);
+}
+
+void TCPCongestionControl::set_congestion_window(u64 window)
+{
+    m_congestion_window = clamp<u64>(window, m_maximum_segment_size, NumericLimits<u32>::max() / 2);
+}
+
+void TCPCongestionControl::on_ack(u32 acknowledged_bytes, MonotonicTime now, Optional<Duration> smoothed_round_trip_time)
+{
+    if (is_in_slow_start()) {
+        // RFC 5681 section 3.1: We count bytes, but at most one segment per ACK.
+        set_congestion_window(static_cast<u64>(m_congestion_window) + min(acknowledged_bytes, m_maximum_segment_size));
+        return;
+    }
+    grow_in_congestion_avoidance(acknowledged_bytes, now, smoothed_round_trip_time);
+}
+
+void TCPCongestionControl::on_enter_fast_recovery(u32 bytes_in_flight, MonotonicTime now)
+{
+    m_slow_start_threshold = reduced_window(bytes_in_flight, now);
+    // The three duplicate ACKs mean three segments have left the network.
+    set_congestion_window(static_cast<u64>(m_slow_start_threshold) + 3 * m_maximum_segment_size);
+}
+
+void TCPCongestionControl::on_duplicate_ack_in_fast_recovery()
+{
+    set_congestion_window(static_cast<u64>(m_congestion_window) + m_maximum_segment_size);
+}
+
+void TCPCongestionControl::on_partial_ack(u32 acknowledged_bytes)
+{
+    u64 window = m_congestion_window - min(acknowledged_bytes, m_congestion_window);
+    if (acknowledged_bytes >= m_maximum_segment_size)
+        window += m_maximum_segment_size;
+    set_congestion_window(window);
+}
+
+void TCPCongestionControl::on_exit_fast_recovery(u32 bytes_in_flight)
+{
+    // RFC 6582 section 3.2, step 3: Deflate the window, but don't allow a burst of more than one segment.
+    set_congestion_window(min<u64>(m_slow_start_threshold, static_cast<u64>(max(bytes_in_flight, m_maximum_segment_size)) + m_maximum_segment_size));
+}
+
+void TCPCongestionControl::on_retransmit_timeout(u32 bytes_in_flight, MonotonicTime now)
+{
+    // RFC 5681 section 3.1: The loss window is one segment.
+    m_slow_start_threshold = reduced_window(bytes_in_flight, now);
+    set_congestion_window(m_maximum_segment_size);
+}
+
+u32 TCPNewRenoCongestionControl::reduced_window(u32 bytes_in_flight, MonotonicTime)
+{
+    m_bytes_acknowledged = 0;
+    return max(bytes_in_flight / 2, minimum_window());
+}
+
+void TCPNewRenoCongestionControl::grow_in_congestion_avoidance(u32 acknowledged_bytes, MonotonicTime, Optional<Duration>)
+{
+    // RFC 5681 section 3.1: One segment for every window's worth of acknowledged data.
+    m_bytes_acknowledged += acknowledged_bytes;
+    if (m_bytes_acknowledged < m_congestion_window)
+        return;
+    m_bytes_acknowledged -= m_congestion_window;
+    set_congestion_window(static_cast<u64>(m_congestion_window) + m_maximum_segment_size);
+}
+
+// The constants of RFC 9438 section 4, as fractions: C = 0.4 and beta = 0.7.
+static constexpr u64 cubic_c_numerator = 4;
+static constexpr u64 cubic_c_denominator = 10;
+static constexpr u64 cubic_beta_numerator = 7;
+static constexpr u64 cubic_beta_denominator = 10;
+
+// Beyond this, the cubic function would overflow (and the window would be absurdly large anyway).
+static constexpr i64 cubic_maximum_time_offset_in_ms = 100'000;
+
+static u64 integer_cube_root(u64 value)
+{
+    u64 low = 0;
+    u64 high = 2642246; // The cube root of 2^64, rounded up.
+    while (low + 1 < high) {
+        auto middle = (low + high) / 2;
+        if (middle * middle * middle <= value)
+            low = middle;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+u32 TCPCubicCongestionControl::reduced_window(u32, MonotonicTime)
+{
+    // RFC 9438 section 4.7: If the window stopped growing before reaching the last maximum, other flows
+    // probably joined, so give up some more room to them.
+    m_previous_window_before_reduction = m_window_before_reduction;
+    if (m_congestion_window < m_previous_window_before_reduction)
+        m_window_before_reduction = static_cast<u64>(m_congestion_window) * (cubic_beta_denominator + cubic_beta_numerator) / (2 * cubic_beta_denominator);
+    else
+        m_window_before_reduction = m_congestion_window;
+
+    m_epoch_start.clear();
+    m_pending_growth = 0;
+    return max<u64>(static_cast<u64>(m_congestion_window) * cubic_beta_numerator / cubic_beta_denominator, minimum_window());
+}
+
+u64 TCPCubicCongestionControl::cubic_window(i64 milliseconds_since_epoch) const
+{
+    // W_cubic(t) = C * (t - K)^3 + W_max, with the window in segments and the time in seconds.
+    auto offset = clamp(milliseconds_since_epoch - m_epoch_time_to_origin_in_ms, -cubic_maximum_time_offset_in_ms, cubic_maximum_time_offset_in_ms);
+    auto cubed_offset = offset * offset * offset / 1000;
+    auto difference = cubed_offset * static_cast<i64>(cubic_c_numerator * m_maximum_segment_size) / static_cast<i64>(cubic_c_denominator * 1'000'000);
+    return max<i64>(static_cast<i64>(m_epoch_origin_window) + difference, 0);
+}
+
+void TCPCubicCongestionControl::grow_in_congestion_avoidance(u32 acknowledged_bytes, MonotonicTime now, Optional<Duration> smoothed_round_trip_time)
+{
+    if (!m_epoch_start.has_value()) {
+        m_epoch_start = now;
+        m_window_at_epoch_start = m_congestion_window;
+        if (m_congestion_window < m_window_before_reduction) {
+            // K = cbrt((W_max - cwnd) / C), in milliseconds.
+            auto segments_to_regain = static_cast<u64>(m_window_before_reduction - m_congestion_window) * (cubic_c_denominator * 1'000'000'000 / cubic_c_numerator) / m_maximum_segment_size;
+            m_epoch_time_to_origin_in_ms = integer_cube_root(segments_to_regain);
+            m_epoch_origin_window = m_window_before_reduction;
+        } else {
+            m_epoch_time_to_origin_in_ms = 0;
+            m_epoch_origin_window = m_congestion_window;
+        }
+    }
+
+    auto milliseconds_since_epoch = (now - m_epoch_start.value()).to_milliseconds();
+    auto round_trip_time_in_ms = smoothed_round_trip_time.has_value() ? max<i64>(smoothed_round_trip_time->to_milliseconds(), 1) : 0;
+
+    // Aim for where the cubic function will be one round trip from now.
+    auto target = cubic_window(milliseconds_since_epoch + round_trip_time_in_ms);
+
+    // RFC 9438 section 4.3: Grow at least as fast as NewReno would have since the start of the epoch,
+    // alpha = 3 * (1 - beta) / (1 + beta) segments per round trip.
+    if (round_trip_time_in_ms > 0) {
+        auto reno_growth = static_cast<u64>(milliseconds_since_epoch) * m_maximum_segment_size * 3 * (cubic_beta_denominator - cubic_beta_numerator)
+            / (static_cast<u64>(round_trip_time_in_ms) * (cubic_beta_denominator + cubic_beta_numerator));
+        target = max(target, m_window_at_epoch_start + reno_growth);
+    }
+
+    // Never more than 1.5 times the current window per round trip.
+    target = min(target, static_cast<u64>(m_congestion_window) * 3 / 2);
+    if (target <= m_congestion_window)
+        return;
+
+    // Spread the growth over the ACKs of a whole window.
+    m_pending_growth += (target - m_congestion_window) * acknowledged_bytes;
+    auto growth = m_pending_growth / m_congestion_window;
+    m_pending_growth %= m_congestion_window;
+    set_congestion_window(static_cast<u64>(m_congestion_window) + growth);
+}
+
+}
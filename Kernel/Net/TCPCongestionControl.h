@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// Decides how much unacknowledged data a TCP connection may have in flight (RFC 5681).
+// Slow start and fast recovery are the same for every algorithm, the algorithms differ
+// in how the window grows during congestion avoidance and how far it's cut after a loss.
+class TCPCongestionControl {
+public:
+    static constexpr StringView default_algorithm = "cubic"sv;
+    static ErrorOr<NonnullOwnPtr<TCPCongestionControl>> try_create(StringView algorithm, u32 maximum_segment_size);
+
+    virtual ~TCPCongestionControl() = default;
+
+    virtual StringView name() const = 0;
+
+    u32 congestion_window() const { return m_congestion_window; }
+    u32 slow_start_threshold() const { return m_slow_start_threshold; }
+    u32 maximum_segment_size() const { return m_maximum_segment_size; }
+    bool is_in_slow_start() const { return m_congestion_window < m_slow_start_threshold; }
+
+    void set_maximum_segment_size(u32);
+
+    // New data was acknowledged outside of fast recovery.
+    void on_ack(u32 acknowledged_bytes, MonotonicTime now, Optional<Duration> smoothed_round_trip_time);
+
+    // The third duplicate ACK in a row came in, and the first unacknowledged segment is sent again.
+    void on_enter_fast_recovery(u32 bytes_in_flight, MonotonicTime now);
+    // Every further duplicate ACK means another segment has left the network.
+    void on_duplicate_ack_in_fast_recovery();
+    // An ACK covered some, but not all, of the data that was in flight when fast recovery began (RFC 6582).
+    void on_partial_ack(u32 acknowledged_bytes);
+    void on_exit_fast_recovery(u32 bytes_in_flight);
+
+    void on_retransmit_timeout(u32 bytes_in_flight, MonotonicTime now);
+
+protected:
+    explicit TCPCongestionControl(u32 maximum_segment_size);
+
+    u32 minimum_window() const { return 2 * m_maximum_segment_size; }
+    void set_congestion_window(u64);
+
+    // Returns the new slow start threshold after a loss.
+    virtual u32 reduced_window(u32 bytes_in_flight, MonotonicTime now) = 0;
+    virtual void grow_in_congestion_avoidance(u32 acknowledged_bytes, MonotonicTime now, Optional<Duration> smoothed_round_trip_time) = 0;
+
+    u32 m_maximum_segment_size { 0 };
+    u32 m_congestion_window { 0 };
+    u32 m_slow_start_threshold { NumericLimits<u32>::max() };
+};
+
+// RFC 5681 and RFC 6582: One segment more per round trip, and half the data in flight after a loss.
+class TCPNewRenoCongestionControl final : public TCPCongestionControl {
+public:
+    explicit TCPNewRenoCongestionControl(u32 maximum_segment_size)
+        : TCPCongestionControl(maximum_segment_size)
+    {
+    }
+
+    virtual StringView name() const override { return "newreno"sv; }
+
+private:
+    virtual u32 reduced_window(u32 bytes_in_flight, MonotonicTime now) override;
+    virtual void grow_in_congestion_avoidance(u32 acknowledged_bytes, MonotonicTime now, Optional<Duration> smoothed_round_trip_time) override;
+
+    u32 m_bytes_acknowledged { 0 };
+};
+
+// RFC 9438: The window follows a cubic function of the time since the last loss, centred on the
+// window at which that loss happened, so it's regained quickly on long fat links.
+class TCPCubicCongestionControl final : public TCPCongestionControl {
+public:
+    explicit TCPCubicCongestionControl(u32 maximum_segment_size)
+        : TCPCongestionControl(maximum_segment_size)
+    {
+    }
+
+    virtual StringView name() const override { return "cubic"sv; }
+
+private:
+    virtual u32 reduced_window(u32 bytes_in_flight, MonotonicTime now) override;
+    virtual void grow_in_congestion_avoidance(u32 acknowledged_bytes, MonotonicTime now, Optional<Duration> smoothed_round_trip_time) override;
+
+    u64 cubic_window(i64 milliseconds_since_epoch) const;
+
+    // The window just before the last loss, and the one before that.
+    u32 m_window_before_reduction { 0 };
+    u32 m_previous_window_before_reduction { 0 };
+
+    // The current congestion avoidance epoch begins with the first ACK after a loss.
+    Optional<MonotonicTime> m_epoch_start;
+    u32 m_epoch_origin_window { 0 };
+    i64 m_epoch_time_to_origin_in_ms { 0 };
+    u32 m_window_at_epoch_start { 0 };
+
+    // Growth of less than a byte per ACK is carried over to the next one.
+    u64 m_pending_growth { 0 };
+};
+
+}
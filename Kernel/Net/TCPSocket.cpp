@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/HashFunctions.h>
 #include <AK/Singleton.h>
 #include <AK/Time.h>
 #include <Kernel/Debug.h>
@@ -24,36 +26,57 @@
 
 namespace Kernel {
 
+static constexpr size_t connection_table_shard_count = 64;
+
+static Singleton<MutexProtected<TCPSocket::SocketTable>> s_listening_sockets;
+static Singleton<Array<MutexProtected<TCPSocket::SocketTable>, connection_table_shard_count>> s_connection_table_shards;
+
+template<typename Callback>
+static ErrorOr<void> try_for_each_socket_table(Callback callback)
+{
+    TRY(callback(*s_listening_sockets));
+    for (auto& shard : *s_connection_table_shards)
+        TRY(callback(shard));
+    return {};
+}
+
 void TCPSocket::for_each(Function<void(TCPSocket const&)> callback)
 {
-    sockets_by_tuple().for_each_shared([&](auto const& it) {
-        callback(*it.value);
-    });
+    MUST(try_for_each([&](auto const& socket) -> ErrorOr<void> {
+        callback(socket);
+        return {};
+    }));
 }
 
 ErrorOr<void> TCPSocket::try_for_each(Function<ErrorOr<void>(TCPSocket const&)> callback)
 {
-    return sockets_by_tuple().with_shared([&](auto const& sockets) -> ErrorOr<void> {
-        for (auto& it : sockets)
-            TRY(callback(*it.value));
-        return {};
+    return try_for_each_socket_table([&](auto const& table) {
+        return table.with_shared([&](auto const& sockets) -> ErrorOr<void> {
+            for (auto& it : sockets) {
+                if (!it.value->m_reuse_port_group) {
+                    TRY(callback(*it.value));
+                    continue;
+                }
+                for (auto* member : it.value->m_reuse_port_group->members)
+                    TRY(callback(*member));
+            }
+            return {};
+        });
     });
 }
 
 bool TCPSocket::unref() const
 {
-    bool did_hit_zero = sockets_by_tuple().with_exclusive([&](auto& table) {
-        if (deref_base())
-            return false;
-        table.remove(tuple());
-        const_cast<TCPSocket&>(*this).revoke_weak_ptrs();
-        return true;
-    });
-    if (did_hit_zero) {
-        const_cast<TCPSocket&>(*this).will_be_destroyed();
-        delete this;
-    }
-    return did_hit_zero;
+    // Lookups only take a reference with try_ref(), so a socket that's still registered can't be brought
+    // back once the count hits zero, and it doesn't have to be held under a table lock here.
+    if (deref_base())
+        return false;
+    auto& socket = const_cast<TCPSocket&>(*this);
+    socket.unregister_socket_tuple();
+    socket.revoke_weak_ptrs();
+    socket.will_be_destroyed();
+    delete this;
+    return true;
 }
 
 void TCPSocket::set_state(State new_state)
@@ -116,37 +139,139 @@ MutexProtected<HashMap<IPv4SocketTuple, RefPtr<TCPSocket>>>& TCPSocket::closing_
     return *s_socket_closing;
 }
 
-static Singleton<MutexProtected<HashMap<IPv4SocketTuple, TCPSocket*>>> s_socket_tuples;
+MutexProtected<TCPSocket::SocketTable>& TCPSocket::listening_sockets()
+{
+    return *s_listening_sockets;
+}
+
+MutexProtected<TCPSocket::SocketTable>& TCPSocket::connection_table_shard(IPv4SocketTuple const& tuple)
+{
+    // The tuple hash is mixed once more, since the tables inside a shard bucket by the same hash.
+    auto shard_index = int_hash(Traits<IPv4SocketTuple>::hash(tuple)) % connection_table_shard_count;
+    return (*s_connection_table_shards)[shard_index];
+}
 
-MutexProtected<HashMap<IPv4SocketTuple, TCPSocket*>>& TCPSocket::sockets_by_tuple()
+MutexProtected<TCPSocket::SocketTable>& TCPSocket::socket_table_for(IPv4SocketTuple const& tuple)
 {
-    return *s_socket_tuples;
+    if (tuple.peer_address().is_zero() && tuple.peer_port() == 0)
+        return listening_sockets();
+    return connection_table_shard(tuple);
+}
+
+// Sockets stay in the tables until unref() has taken them out, which is after their count has hit zero.
+static RefPtr<TCPSocket> try_take_reference(TCPSocket& socket)
+{
+    if (!socket.try_ref())
+        return {};
+    return adopt_ref(socket);
+}
+
+RefPtr<TCPSocket> TCPSocket::ReusePortGroup::select_listener(IPv4SocketTuple const& tuple) const
+{
+    VERIFY(!members.is_empty());
+    auto first_index = Traits<IPv4SocketTuple>::hash(tuple) % members.size();
+    // Members that were only bound, or already closed, can't take the connection.
+    for (size_t i = 0; i < members.size(); ++i) {
+        auto& member = *members[(first_index + i) % members.size()];
+        if (member.state() != State::Listen)
+            continue;
+        if (auto socket = try_take_reference(member))
+            return socket;
+    }
+    return try_take_reference(*members[first_index]);
 }
 
 RefPtr<TCPSocket> TCPSocket::from_tuple(IPv4SocketTuple const& tuple)
 {
-    return sockets_by_tuple().with_shared([&](auto const& table) -> RefPtr<TCPSocket> {
+    auto connected_socket = connection_table_shard(tuple).with_shared([&](auto const& table) -> RefPtr<TCPSocket> {
         auto exact_match = table.get(tuple);
-        if (exact_match.has_value())
-            return { *exact_match.value() };
+        if (!exact_match.has_value())
+            return {};
+        return try_take_reference(*exact_match.value());
+    });
+    if (connected_socket)
+        return connected_socket;
+
+    return listening_sockets().with_shared([&](auto const& table) -> RefPtr<TCPSocket> {
+        auto select_socket = [&](TCPSocket& socket) -> RefPtr<TCPSocket> {
+            if (socket.m_reuse_port_group)
+                return socket.m_reuse_port_group->select_listener(tuple);
+            return try_take_reference(socket);
+        };
 
         auto address_tuple = IPv4SocketTuple(tuple.local_address(), tuple.local_port(), IPv4Address(), 0);
         auto address_match = table.get(address_tuple);
         if (address_match.has_value())
-            return { *address_match.value() };
+            return select_socket(*address_match.value());
 
         auto wildcard_tuple = IPv4SocketTuple(IPv4Address(), tuple.local_port(), IPv4Address(), 0);
         auto wildcard_match = table.get(wildcard_tuple);
         if (wildcard_match.has_value())
-            return { *wildcard_match.value() };
+            return select_socket(*wildcard_match.value());
+
+        return {};
+    });
+}
+
+void TCPSocket::unregister_socket_tuple()
+{
+    if (!m_registered_socket_tuple.has_value())
+        return;
+
+    socket_table_for(*m_registered_socket_tuple).with_exclusive([&](auto& table) {
+        auto it = table.find(*m_registered_socket_tuple);
+        bool is_in_table = it != table.end() && it->value == this;
+        if (m_reuse_port_group) {
+            auto& members = m_reuse_port_group->members;
+            members.remove_first_matching([this](auto* member) { return member == this; });
+            // Another member of the group takes over the entry.
+            if (is_in_table && !members.is_empty())
+                it->value = members.first();
+            else if (is_in_table)
+                table.remove(it);
+            m_reuse_port_group = nullptr;
+        } else if (is_in_table) {
+            table.remove(it);
+        }
+    });
+    m_registered_socket_tuple = {};
+}
+
+ErrorOr<void> TCPSocket::check_for_overlapping_binds(SocketTable const& table)
+{
+    // A socket bound to the wildcard address covers the same port on every specific address, and the other way around.
+    auto overlaps_with_socket_on = [&](IPv4Address const& address) {
+        auto other = table.get(IPv4SocketTuple(address, local_port(), IPv4Address(), 0));
+        if (!other.has_value())
+            return false;
+        auto& other_socket = *other.value();
+        if (can_share_port_with(other_socket))
+            return false;
+        // With SO_REUSEADDR on both, only a listening socket keeps others off the addresses it covers.
+        if (reuses_address() && other_socket.reuses_address() && other_socket.state() != State::Listen)
+            return false;
+        return true;
+    };
 
+    if (has_specific_local_address()) {
+        if (overlaps_with_socket_on(IPv4Address()))
+            return set_so_error(EADDRINUSE);
         return {};
+    }
+
+    bool has_overlap = false;
+    NetworkingManagement::the().for_each([&](auto& adapter) {
+        if (!has_overlap && !adapter.ipv4_address().is_zero())
+            has_overlap = overlaps_with_socket_on(adapter.ipv4_address());
     });
+    if (has_overlap)
+        return set_so_error(EADDRINUSE);
+    return {};
 }
 ErrorOr<NonnullRefPtr<TCPSocket>> TCPSocket::try_create_client(IPv4Address const& new_local_address, u16 new_local_port, IPv4Address const& new_peer_address, u16 new_peer_port)
 {
     auto tuple = IPv4SocketTuple(new_local_address, new_local_port, new_peer_address, new_peer_port);
-    return sockets_by_tuple().with_exclusive([&](auto& table) -> ErrorOr<NonnullRefPtr<TCPSocket>> {
+    return connection_table_shard(tuple).with_exclusive([&](auto& table) -> ErrorOr<NonnullRefPtr<TCPSocket>> {
         if (table.contains(tuple))
             return EEXIST;
 
@@ -185,10 +310,11 @@ void TCPSocket::release_for_accept(NonnullRefPtr<TCPSocket> socket)
     [[maybe_unused]] auto rc = queue_connection_from(move(socket));
 }
 
-TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer)
+TCPSocket::TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer, NonnullOwnPtr<TCPCongestionControl> congestion_control)
     : IPv4Socket(SOCK_STREAM, protocol, move(receive_buffer), move(scratch_buffer))
     , m_last_ack_sent_time(TimeManagement::the().monotonic_time())
-    , m_last_retransmit_time(TimeManagement::the().monotonic_time())
+    , m_retransmit_timer_start(TimeManagement::the().monotonic_time())
+    , m_congestion_control(move(congestion_control))
     , m_timer(timer)
 {
 }
@@ -205,7 +331,9 @@ ErrorOr<NonnullRefPtr<TCPSocket>> TCPSocket::try_create(int protocol, NonnullOwn
     // Note: Scratch buffer is only used for SOCK_STREAM sockets.
     auto scratch_buffer = TRY(KBuffer::try_create_with_size("TCPSocket: Scratch buffer"sv, 65536));
     auto timer = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) Timer));
-    return adopt_nonnull_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer), timer));
+    // FIXME: We don't know the MSS until we have a route, so start with the one for Ethernet.
+    auto congestion_control = TRY(TCPCongestionControl::try_create(TCPCongestionControl::default_algorithm, 1460));
+    return adopt_nonnull_ref_or_enomem(new (nothrow) TCPSocket(protocol, move(receive_buffer), move(scratch_buffer), timer, move(congestion_control)));
 }
 
 ErrorOr<size_t> TCPSocket::protocol_size(ReadonlyBytes raw_ipv4_packet)
@@ -226,16 +354,69 @@ ErrorOr<size_t> TCPSocket::protocol_receive(ReadonlyBytes raw_ipv4_packet, UserO
     return payload_size;
 }
 
+// The SACK option is preceded by two NOPs, to keep the blocks aligned.
+static size_t sack_option_size(size_t block_count)
+{
+    return block_count == 0 ? 0 : 2 + sizeof(TCPOptionSACK) + block_count * sizeof(TCPSACKBlock);
+}
+
+static constexpr size_t maximum_tcp_header_size = 15 * sizeof(u32);
+
+// Below this, taking the pages away from the sender costs more than copying them.
+static constexpr size_t zero_copy_minimum_size = 8 * PAGE_SIZE;
+
+static ErrorOr<Vector<PacketFragment>> pin_user_data(UserOrKernelBuffer const& data, size_t length)
+{
+    auto base = VirtualAddress { data.user_or_kernel_ptr() };
+    auto range = TRY(Memory::VirtualRange::expand_to_page_boundaries(base.get(), length));
+    auto pages = TRY(Process::current().address_space().with([&](auto& space) {
+        return space->pin_pages_for_reading(range);
+    }));
+
+    Vector<PacketFragment> fragments;
+    TRY(fragments.try_ensure_capacity(pages.size()));
+    size_t offset_in_page = base.get() % PAGE_SIZE;
+    for (auto& page : pages) {
+        auto fragment_length = min(PAGE_SIZE - offset_in_page, length);
+        fragments.unchecked_append({ move(page), static_cast<u16>(offset_in_page), static_cast<u16>(fragment_length) });
+        length -= fragment_length;
+        offset_in_page = 0;
+    }
+    return fragments;
+}
+
 ErrorOr<size_t> TCPSocket::protocol_send(UserOrKernelBuffer const& data, size_t data_length)
 {
-    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
-    RoutingDecision routing_decision = route_to(peer_address(), local_address(), adapter);
+    RoutingDecision routing_decision = route_to_peer();
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
     size_t mss = routing_decision.adapter->mtu() - sizeof(IPv4Packet) - sizeof(TCPPacket);
+    if (mss != m_congestion_control->maximum_segment_size())
+        m_congestion_control->set_maximum_segment_size(mss);
+
+    // Room for SACK blocks has to be left in every segment.
+    size_t segment_size = mss - align_up_to(sack_option_size(m_sack_permitted ? sack_blocks().size() : 0), 4);
+    size_t maximum_payload_size = segment_size;
+    if (routing_decision.adapter->has_offload(NetworkAdapter::Offload::TCPSegmentation)) {
+        // The adapter cuts super-segments into segments for us, so we can hand it as much as the window allows at once.
+        auto bytes_in_flight = m_unacked_packets.with_shared([](auto& unacked_packets) { return unacked_packets.size; });
+        size_t window_space = send_window() > bytes_in_flight ? send_window() - bytes_in_flight : 0;
+        size_t super_segment_space = NetworkAdapter::maximum_super_segment_size - sizeof(IPv4Packet) - maximum_tcp_header_size;
+        maximum_payload_size = max(segment_size, min(window_space, super_segment_space) / segment_size * segment_size);
+    }
 
-    data_length = min(data_length, mss);
-    TRY(send_tcp_packet(TCPFlags::PSH | TCPFlags::ACK, &data, data_length, &routing_decision));
+    data_length = min(data_length, maximum_payload_size);
+    auto segmentation_size = data_length > segment_size ? segment_size : 0;
+
+    if (data_length >= zero_copy_minimum_size && !data.is_kernel_buffer() && routing_decision.adapter->has_offload(NetworkAdapter::Offload::ScatterGather | NetworkAdapter::Offload::TransmitChecksum)) {
+        // Large sends go out straight from the pages of the sender, which are copied on write instead.
+        if (auto fragments = pin_user_data(data, data_length); !fragments.is_error()) {
+            TRY(send_tcp_packet(TCPFlags::PSH | TCPFlags::ACK, nullptr, data_length, &routing_decision, segmentation_size, fragments.release_value()));
+            return data_length;
+        }
+    }
+
+    TRY(send_tcp_packet(TCPFlags::PSH | TCPFlags::ACK, &data, data_length, &routing_decision, segmentation_size));
     return data_length;
 }
 
@@ -246,10 +427,9 @@ ErrorOr<void> TCPSocket::send_ack(bool allow_duplicate)
     return send_tcp_packet(TCPFlags::ACK);
 }
 
-ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* payload, size_t payload_size, RoutingDecision* user_routing_decision)
+ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* payload, size_t payload_size, RoutingDecision* user_routing_decision, size_t segment_size, Vector<PacketFragment> payload_fragments)
 {
-    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
-    RoutingDecision routing_decision = user_routing_decision ? *user_routing_decision : route_to(peer_address(), local_address(), adapter);
+    RoutingDecision routing_decision = user_routing_decision ? *user_routing_decision : route_to_peer();
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
 
@@ -257,12 +437,22 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
     bool const has_mss_option = flags & TCPFlags::SYN;
     bool const has_window_scale_option = flags & TCPFlags::SYN;
-    size_t const options_size = (has_mss_option ? sizeof(TCPOptionMSS) : 0) + (has_window_scale_option ? sizeof(TCPOptionWindowScale) : 0);
+    // We always offer selective acknowledgements, but may only accept them if the peer offered them too.
+    bool const has_sack_permitted_option = (flags & TCPFlags::SYN) && (!(flags & TCPFlags::ACK) || m_sack_permitted);
+    Vector<TCPSACKBlock, TCPOptionSACK::maximum_block_count> sack_blocks;
+    if ((flags & TCPFlags::ACK) && !(flags & TCPFlags::SYN) && m_sack_permitted)
+        sack_blocks = this->sack_blocks();
+    size_t const options_size = (has_mss_option ? sizeof(TCPOptionMSS) : 0) + (has_window_scale_option ? sizeof(TCPOptionWindowScale) : 0)
+        + (has_sack_permitted_option ? sizeof(TCPOptionSACKPermitted) : 0) + sack_option_size(sack_blocks.size());
     size_t const tcp_header_size = sizeof(TCPPacket) + align_up_to(options_size, 4);
     size_t const buffer_size = ipv4_payload_offset + tcp_header_size + payload_size;
-    auto packet = routing_decision.adapter->acquire_packet_buffer(buffer_size);
+    // With fragments, the payload isn't copied into the buffer.
+    VERIFY(payload_fragments.is_empty() || !payload);
+    auto packet = routing_decision.adapter->acquire_packet_buffer(payload_fragments.is_empty() ? buffer_size : buffer_size - payload_size);
     if (!packet)
         return set_so_error(ENOMEM);
+    packet->fragments = move(payload_fragments);
+    packet->transmit_offload.segment_size = segment_size;
     routing_decision.adapter->fill_in_ipv4_header(*packet, local_address(),
         routing_decision.next_hop, peer_address(), TransportProtocol::TCP,
         buffer_size - ipv4_payload_offset, type_of_service(), ttl());
@@ -310,21 +500,48 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
         memcpy(next_option, &window_scale_option, sizeof(window_scale_option));
         next_option += sizeof(window_scale_option);
     }
+    if (has_sack_permitted_option) {
+        TCPOptionSACKPermitted sack_permitted_option;
+        memcpy(next_option, &sack_permitted_option, sizeof(sack_permitted_option));
+        next_option += sizeof(sack_permitted_option);
+    }
+    if (!sack_blocks.is_empty()) {
+        *next_option++ = to_underlying(TCPOptionKind::Nop);
+        *next_option++ = to_underlying(TCPOptionKind::Nop);
+        auto& sack_option = *new (next_option) TCPOptionSACK(sack_blocks.size());
+        for (size_t i = 0; i < sack_blocks.size(); ++i)
+            sack_option.block(i) = sack_blocks[i];
+        next_option += sack_option.length();
+    }
     if ((options_size % 4) != 0)
         *next_option = to_underlying(TCPOptionKind::End);
 
-    tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
+    if (routing_decision.adapter->has_offload(NetworkAdapter::Offload::TransmitChecksum)) {
+        auto pseudo_header_checksum = ipv4_pseudo_header_checksum(local_address(), peer_address(), TransportProtocol::TCP, tcp_header_size + payload_size);
+        tcp_packet.set_checksum(pseudo_header_checksum.partial_sum());
+        packet->transmit_offload.needs_checksum = true;
+        packet->transmit_offload.checksum_start = ipv4_payload_offset;
+        packet->transmit_offload.checksum_offset = TCPPacket::checksum_offset;
+    } else {
+        VERIFY(segment_size == 0 && packet->fragments.is_empty());
+        tcp_packet.set_checksum(compute_tcp_checksum(local_address(), peer_address(), tcp_packet, payload_size));
+    }
 
     bool expect_ack { tcp_packet.has_syn() || payload_size > 0 };
     if (expect_ack) {
         bool append_failed { false };
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
-            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter });
+            auto now = TimeManagement::the().monotonic_time();
+            bool was_empty = unacked_packets.packets.is_empty();
+            auto result = unacked_packets.packets.try_append({ m_sequence_number, packet, ipv4_payload_offset, *routing_decision.adapter, payload_size, now });
             if (result.is_error()) {
                 dbgln("TCPSocket: Dropped outbound packet because try_append() failed");
                 append_failed = true;
                 return;
             }
+            // RFC 6298 section 5.1: The timer runs for the oldest unacknowledged packet.
+            if (was_empty)
+                m_retransmit_timer_start = now;
             unacked_packets.size += payload_size;
             enqueue_for_retransmit();
         });
@@ -334,58 +551,308 @@ ErrorOr<void> TCPSocket::send_tcp_packet(u16 flags, UserOrKernelBuffer const* pa
 
     m_packets_out++;
     m_bytes_out += buffer_size;
-    routing_decision.adapter->send_packet(packet->bytes());
+    routing_decision.adapter->send_packet(*packet);
     if (!expect_ack)
         routing_decision.adapter->release_packet_buffer(*packet);
 
     return {};
 }
 
+// Sequence numbers wrap around, so they are compared by their distance (RFC 793 section 3.3).
+static bool sequence_number_is_before_or_at(u32 a, u32 b)
+{
+    return static_cast<i32>(a - b) <= 0;
+}
+
 void TCPSocket::receive_tcp_packet(TCPPacket const& packet, u16 size)
 {
     if (packet.has_ack()) {
         u32 ack_number = packet.ack_number();
+        auto now = TimeManagement::the().monotonic_time();
 
         dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet: {}", ack_number);
 
-        int removed = 0;
+        // The window in a SYN is never scaled (RFC 7323 section 2.2).
+        u32 send_window_size = packet.has_syn() ? packet.window_size() : static_cast<u32>(packet.window_size()) << m_send_window_scale;
+        bool window_changed = send_window_size != m_send_window_size;
+        m_send_window_size = send_window_size;
+
+        bool should_retransmit = false;
         m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+            bool sacked_something = false;
+            if (m_sack_permitted) {
+                auto sacked_packets_before = unacked_packets.sacked_count;
+                process_sack_option(packet, unacked_packets);
+                sacked_something = unacked_packets.sacked_count != sacked_packets_before;
+            }
+
+            int removed = 0;
+            u32 acknowledged_bytes = 0;
+            Optional<Duration> round_trip_time_sample;
             while (!unacked_packets.packets.is_empty()) {
                 auto& packet = unacked_packets.packets.first();
 
                 dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: iterate: {}", packet.ack_number);
 
-                if (packet.ack_number <= ack_number) {
-                    auto old_adapter = packet.adapter.strong_ref();
-                    if (old_adapter)
-                        old_adapter->release_packet_buffer(*packet.buffer);
-                    TCPPacket& tcp_packet = *(TCPPacket*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                    if (m_send_window_size != tcp_packet.window_size()) {
-                        m_send_window_size = tcp_packet.window_size() << m_send_window_scale;
-                    }
-                    auto payload_size = packet.buffer->buffer->data() + packet.buffer->buffer->size() - (u8*)tcp_packet.payload();
-                    unacked_packets.size -= payload_size;
-                    evaluate_block_conditions();
-                    unacked_packets.packets.take_first();
-                    removed++;
-                } else {
+                if (!sequence_number_is_before_or_at(packet.ack_number, ack_number))
                     break;
+
+                auto old_adapter = packet.adapter.strong_ref();
+                if (old_adapter)
+                    old_adapter->release_packet_buffer(*packet.buffer);
+                // RFC 6298 section 3: Packets that were sent more than once can't tell us the round trip time (Karn's algorithm).
+                if (packet.tx_counter == 0)
+                    round_trip_time_sample = now - packet.first_sent_time;
+                acknowledged_bytes += packet.payload_size;
+                unacked_packets.size -= packet.payload_size;
+                if (packet.sacked)
+                    --unacked_packets.sacked_count;
+                unacked_packets.packets.take_first();
+                removed++;
+            }
+
+            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
+
+            if (removed == 0) {
+                // RFC 5681 section 2: Only a bare ACK that doesn't move anything forward counts as a duplicate.
+                bool is_duplicate = !unacked_packets.packets.is_empty() && ack_number == m_last_acknowledged_number
+                    && size == packet.header_size() && !packet.has_syn() && !packet.has_fin() && !window_changed;
+                if (!is_duplicate)
+                    return;
+
+                ++m_duplicate_acks_received;
+                if (m_fast_recovery_point.has_value()) {
+                    m_congestion_control->on_duplicate_ack_in_fast_recovery();
+                    // New SACK information can uncover further holes.
+                    if (sacked_something)
+                        mark_lost_packets_in_fast_recovery(unacked_packets);
+                } else if (m_duplicate_acks_received == 3) {
+                    dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) fast retransmit of {}", this, m_last_acknowledged_number);
+                    ++m_fast_retransmits;
+                    m_fast_recovery_point = m_sequence_number;
+                    m_congestion_control->on_enter_fast_recovery(unacked_packets.size, now);
+                    for (auto& packet : unacked_packets.packets)
+                        packet.retransmitted_in_fast_recovery = false;
+                    mark_lost_packets_in_fast_recovery(unacked_packets);
+                }
+                should_retransmit = m_fast_recovery_point.has_value();
+                return;
+            }
+
+            evaluate_block_conditions();
+            m_last_acknowledged_number = ack_number;
+            m_duplicate_acks_received = 0;
+            m_retransmit_attempts = 0;
+            m_retransmit_timer_start = now;
+            if (round_trip_time_sample.has_value())
+                update_round_trip_time(*round_trip_time_sample);
+
+            if (m_fast_recovery_point.has_value()) {
+                if (sequence_number_is_before_or_at(*m_fast_recovery_point, ack_number)) {
+                    m_fast_recovery_point.clear();
+                    m_congestion_control->on_exit_fast_recovery(unacked_packets.size);
+                } else {
+                    // RFC 6582 section 3.2, step 5: The next hole gets retransmitted right away.
+                    m_congestion_control->on_partial_ack(acknowledged_bytes);
+                    mark_lost_packets_in_fast_recovery(unacked_packets);
                 }
+            } else {
+                m_congestion_control->on_ack(acknowledged_bytes, now, m_smoothed_round_trip_time);
             }
 
             if (unacked_packets.packets.is_empty()) {
-                m_retransmit_attempts = 0;
                 dequeue_for_retransmit();
+                return;
+            }
+            // What's still marked after a timeout can go out now that the window has opened up a bit.
+            for (auto& packet : unacked_packets.packets) {
+                if (packet.needs_retransmit) {
+                    should_retransmit = true;
+                    break;
+                }
             }
-
-            dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket: receive_tcp_packet acknowledged {} packets", removed);
         });
+
+        if (window_changed)
+            evaluate_block_conditions();
+        if (should_retransmit)
+            retransmit_marked_packets();
     }
 
     m_packets_in++;
     m_bytes_in += packet.header_size() + size;
 }
 
+void TCPSocket::process_sack_option(TCPPacket const& packet, UnackedPackets& unacked_packets)
+{
+    packet.for_each_option([&](auto const& option) {
+        if (option.kind() != TCPOptionKind::SACK || option.length() < sizeof(TCPOptionSACK))
+            return;
+        auto const& sack_option = static_cast<TCPOptionSACK const&>(option);
+        for (size_t i = 0; i < sack_option.block_count(); ++i) {
+            u32 left_edge = sack_option.block(i).left_edge;
+            u32 right_edge = sack_option.block(i).right_edge;
+            for (auto& outgoing_packet : unacked_packets.packets) {
+                if (outgoing_packet.sacked || outgoing_packet.payload_size == 0)
+                    continue;
+                if (sequence_number_is_before_or_at(left_edge, outgoing_packet.sequence_number()) && sequence_number_is_before_or_at(outgoing_packet.ack_number, right_edge)) {
+                    outgoing_packet.sacked = true;
+                    outgoing_packet.needs_retransmit = false;
+                    ++unacked_packets.sacked_count;
+                }
+            }
+        }
+    });
+}
+
+void TCPSocket::mark_lost_packets_in_fast_recovery(UnackedPackets& unacked_packets)
+{
+    if (unacked_packets.packets.is_empty())
+        return;
+
+    // Without SACK information, all we know is that the first packet is missing. Otherwise, every
+    // packet that wasn't SACKed, but has SACKed packets after it, is presumed lost (RFC 6675).
+    if (unacked_packets.sacked_count == 0) {
+        auto& first_packet = unacked_packets.packets.first();
+        if (!first_packet.retransmitted_in_fast_recovery) {
+            first_packet.needs_retransmit = true;
+            first_packet.retransmitted_in_fast_recovery = true;
+        }
+        return;
+    }
+
+    size_t sacked_packets_left = unacked_packets.sacked_count;
+    for (auto& packet : unacked_packets.packets) {
+        if (sacked_packets_left == 0)
+            break;
+        if (packet.sacked) {
+            --sacked_packets_left;
+            continue;
+        }
+        if (!packet.retransmitted_in_fast_recovery) {
+            packet.needs_retransmit = true;
+            packet.retransmitted_in_fast_recovery = true;
+        }
+    }
+}
+
+Vector<TCPSACKBlock, TCPOptionSACK::maximum_block_count> TCPSocket::sack_blocks() const
+{
+    Vector<TCPSACKBlock, TCPOptionSACK::maximum_block_count> blocks;
+    auto add_block = [&](u32 left_edge, u32 right_edge) {
+        TCPSACKBlock block { left_edge, right_edge };
+        bool is_most_recent = sequence_number_is_before_or_at(left_edge, m_last_out_of_order_sequence_number)
+            && !sequence_number_is_before_or_at(right_edge, m_last_out_of_order_sequence_number);
+        if (is_most_recent) {
+            if (blocks.size() == TCPOptionSACK::maximum_block_count)
+                blocks.take_last();
+            // There's always room, the inline capacity is enough for all blocks.
+            MUST(blocks.try_insert(0, block));
+        } else if (blocks.size() < TCPOptionSACK::maximum_block_count) {
+            MUST(blocks.try_append(block));
+        }
+    };
+
+    Optional<u32> left_edge;
+    u32 right_edge = 0;
+    for (auto const& segment : m_out_of_order_segments) {
+        if (left_edge.has_value() && segment.sequence_number == right_edge) {
+            right_edge += segment.payload_size;
+            continue;
+        }
+        if (left_edge.has_value())
+            add_block(*left_edge, right_edge);
+        left_edge = segment.sequence_number;
+        right_edge = segment.sequence_number + segment.payload_size;
+    }
+    if (left_edge.has_value())
+        add_block(*left_edge, right_edge);
+    return blocks;
+}
+
+bool TCPSocket::queue_out_of_order_segment(IPv4Packet const& ipv4_packet, TCPPacket const& tcp_packet, u32 payload_size, UnixDateTime const& packet_timestamp)
+{
+    u32 sequence_number = tcp_packet.sequence_number();
+    if (payload_size == 0 || sequence_number_is_before_or_at(sequence_number, m_ack_number))
+        return false;
+    // Only keep what fits in the window we advertised.
+    if (sequence_number + payload_size - m_ack_number > available_space_in_receive_buffer())
+        return false;
+
+    size_t index = 0;
+    for (; index < m_out_of_order_segments.size(); ++index) {
+        auto const& segment = m_out_of_order_segments[index];
+        if (segment.sequence_number == sequence_number) {
+            // We already have this one, but the peer still gets told about it.
+            m_last_out_of_order_sequence_number = sequence_number;
+            return true;
+        }
+        if (!sequence_number_is_before_or_at(segment.sequence_number, sequence_number))
+            break;
+    }
+
+    // Segments that overlap others would only complicate reassembly, so we let the peer send them again.
+    if (index > 0) {
+        auto const& previous = m_out_of_order_segments[index - 1];
+        if (!sequence_number_is_before_or_at(previous.sequence_number + previous.payload_size, sequence_number))
+            return false;
+    }
+    if (index < m_out_of_order_segments.size() && !sequence_number_is_before_or_at(sequence_number + payload_size, m_out_of_order_segments[index].sequence_number))
+        return false;
+
+    if (m_out_of_order_segments.size() >= maximum_out_of_order_segments)
+        return false;
+
+    auto packet_or_error = KBuffer::try_create_with_bytes("TCPSocket: Out of order segment"sv, { &ipv4_packet, sizeof(IPv4Packet) + ipv4_packet.payload_size() });
+    if (packet_or_error.is_error())
+        return false;
+    if (m_out_of_order_segments.try_insert(index, { sequence_number, payload_size, packet_or_error.release_value(), packet_timestamp }).is_error())
+        return false;
+
+    m_last_out_of_order_sequence_number = sequence_number;
+    ++m_out_of_order_packets;
+    return true;
+}
+
+bool TCPSocket::receive_queued_segments()
+{
+    bool received_any = false;
+    while (!m_out_of_order_segments.is_empty()) {
+        auto& segment = m_out_of_order_segments.first();
+        if (segment.sequence_number != m_ack_number) {
+            if (!sequence_number_is_before_or_at(segment.sequence_number, m_ack_number))
+                break;
+            // The peer sent something that covers this segment, so it's no longer needed.
+            m_out_of_order_segments.take_first();
+            continue;
+        }
+        if (!did_receive(peer_address(), peer_port(), segment.packet->bytes(), segment.timestamp))
+            break;
+        m_ack_number += segment.payload_size;
+        m_out_of_order_segments.take_first();
+        received_any = true;
+    }
+    return received_any;
+}
+
+void TCPSocket::update_round_trip_time(Duration sample)
+{
+    // RFC 6298 section 2
+    auto sample_ns = sample.to_nanoseconds();
+    if (!m_smoothed_round_trip_time.has_value()) {
+        m_smoothed_round_trip_time = sample;
+        m_round_trip_time_variation = Duration::from_nanoseconds(sample_ns / 2);
+    } else {
+        auto smoothed_ns = m_smoothed_round_trip_time->to_nanoseconds();
+        auto difference_ns = smoothed_ns > sample_ns ? smoothed_ns - sample_ns : sample_ns - smoothed_ns;
+        m_round_trip_time_variation = Duration::from_nanoseconds((3 * m_round_trip_time_variation.to_nanoseconds() + difference_ns) / 4);
+        m_smoothed_round_trip_time = Duration::from_nanoseconds((7 * smoothed_ns + sample_ns) / 8);
+    }
+
+    auto timeout = *m_smoothed_round_trip_time + Duration::from_nanoseconds(4 * m_round_trip_time_variation.to_nanoseconds());
+    m_retransmission_timeout = clamp(timeout, minimum_retransmission_timeout, maximum_retransmission_timeout);
+}
+
 bool TCPSocket::should_delay_next_ack() const
 {
     // FIXME: We don't know the MSS here so make a reasonable guess.
@@ -451,14 +918,23 @@ NetworkOrdered<u16> TCPSocket::compute_tcp_checksum(IPv4Address const& source, I
     return ~(checksum & 0xffff);
 }
 
-ErrorOr<void> TCPSocket::setsockopt(int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
+ErrorOr<void> TCPSocket::setsockopt(OpenFileDescription& description, int level, int option, Userspace<void const*> user_value, socklen_t user_value_size)
 {
     if (level != IPPROTO_TCP)
-        return IPv4Socket::setsockopt(level, option, user_value, user_value_size);
+        return IPv4Socket::setsockopt(description, level, option, user_value, user_value_size);
 
     MutexLocker locker(mutex());
 
     switch (option) {
+    case TCP_CONGESTION: {
+        char name[TCP_CA_NAME_MAX] {};
+        if (user_value_size == 0)
+            return EINVAL;
+        TRY(copy_from_user(name, static_ptr_cast<char const*>(user_value), min<size_t>(user_value_size, sizeof(name) - 1)));
+        auto algorithm = StringView { name, strnlen(name, sizeof(name)) };
+        m_congestion_control = TRY(TCPCongestionControl::try_create(algorithm, m_congestion_control->maximum_segment_size()));
+        return {};
+    }
     default:
         dbgln("setsockopt({}) at IPPROTO_TCP not implemented.", option);
         return ENOPROTOOPT;
@@ -476,6 +952,15 @@ ErrorOr<void> TCPSocket::getsockopt(OpenFileDescription& description, int level,
     TRY(copy_from_user(&size, value_size.unsafe_userspace_ptr()));
 
     switch (option) {
+    case TCP_CONGESTION: {
+        char name[TCP_CA_NAME_MAX] {};
+        auto algorithm = m_congestion_control->name();
+        VERIFY(algorithm.length() < sizeof(name));
+        memcpy(name, algorithm.characters_without_null_termination(), algorithm.length());
+        size = min<socklen_t>(size, sizeof(name));
+        TRY(copy_to_user(static_ptr_cast<char*>(value), name, size));
+        return copy_to_user(value_size, &size);
+    }
     default:
         dbgln("getsockopt({}) at IPPROTO_TCP not implemented.", option);
         return ENOPROTOOPT;
@@ -502,40 +987,56 @@ ErrorOr<void> TCPSocket::protocol_bind()
         constexpr u16 ephemeral_port_range_size = last_ephemeral_port - first_ephemeral_port;
         u16 first_scan_port = first_ephemeral_port + get_good_random<u16>() % ephemeral_port_range_size;
 
-        return sockets_by_tuple().with_exclusive([&](auto& table) -> ErrorOr<void> {
-            u16 port = first_scan_port;
-            while (true) {
-                IPv4SocketTuple proposed_tuple(local_address(), port, peer_address(), peer_port());
-
-                auto it = table.find(proposed_tuple);
-                if (it == table.end()) {
-                    set_local_port(port);
-                    m_registered_socket_tuple = proposed_tuple;
-                    table.set(proposed_tuple, this);
-                    dbgln_if(TCP_SOCKET_DEBUG, "...allocated port {}, tuple {}", port, proposed_tuple.to_string());
-                    return {};
-                }
-                ++port;
-                if (port > last_ephemeral_port)
-                    port = first_ephemeral_port;
-                if (port == first_scan_port)
-                    break;
+        u16 port = first_scan_port;
+        while (true) {
+            IPv4SocketTuple proposed_tuple(local_address(), port, peer_address(), peer_port());
+
+            // Each proposed tuple can live in a different table, so they're tried one at a time.
+            auto did_register = TRY(socket_table_for(proposed_tuple).with_exclusive([&](auto& table) -> ErrorOr<bool> {
+                if (table.contains(proposed_tuple))
+                    return false;
+                TRY(table.try_set(proposed_tuple, this));
+                set_local_port(port);
+                m_registered_socket_tuple = proposed_tuple;
+                return true;
+            }));
+            if (did_register) {
+                dbgln_if(TCP_SOCKET_DEBUG, "...allocated port {}, tuple {}", port, proposed_tuple.to_string());
+                return {};
             }
-            return set_so_error(EADDRINUSE);
-        });
+            ++port;
+            if (port > last_ephemeral_port)
+                port = first_ephemeral_port;
+            if (port == first_scan_port)
+                break;
+        }
+        return set_so_error(EADDRINUSE);
     } else {
-        // Verify that the user-supplied port is not already used by someone else.
-        bool ok = sockets_by_tuple().with_exclusive([&](auto& table) -> bool {
-            if (table.contains(tuple()))
-                return false;
+        // Verify that the user-supplied port is not already used by someone else, unless we may share it.
+        return listening_sockets().with_exclusive([&](auto& table) -> ErrorOr<void> {
+            TRY(check_for_overlapping_binds(table));
+
             auto socket_tuple = tuple();
+            auto existing = table.get(socket_tuple);
+            if (!existing.has_value()) {
+                TRY(table.try_set(socket_tuple, this));
+                m_registered_socket_tuple = socket_tuple;
+                return {};
+            }
+
+            auto& other_socket = *existing.value();
+            if (!can_share_port_with(other_socket))
+                return set_so_error(EADDRINUSE);
+            if (!other_socket.m_reuse_port_group) {
+                auto group = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) ReusePortGroup));
+                TRY(group->members.try_append(&other_socket));
+                other_socket.m_reuse_port_group = move(group);
+            }
+            TRY(other_socket.m_reuse_port_group->members.try_append(this));
+            m_reuse_port_group = other_socket.m_reuse_port_group;
             m_registered_socket_tuple = socket_tuple;
-            table.set(socket_tuple, this);
-            return true;
+            return {};
         });
-        if (!ok)
-            return set_so_error(EADDRINUSE);
-        return {};
     }
 }
 
@@ -560,18 +1061,17 @@ ErrorOr<void> TCPSocket::protocol_connect(OpenFileDescription& description)
     TRY(ensure_bound());
     if (m_registered_socket_tuple.has_value() && m_registered_socket_tuple != tuple()) {
         // If the socket was manually bound (using bind(2)) instead of implicitly using connect,
-        // it will already be registered in the TCPSocket sockets_by_tuple table, under the previous
-        // socket tuple. We replace the entry in the table to ensure it is also properly removed on
+        // it will already be registered in the TCPSocket listening_sockets table, under the previous
+        // socket tuple. We move it to the connection table to ensure it is also properly removed on
         // socket deletion, to prevent a dangling reference.
-        TRY(sockets_by_tuple().with_exclusive([this](auto& table) -> ErrorOr<void> {
-            auto removed = table.remove(*m_registered_socket_tuple);
-            VERIFY(removed);
+        unregister_socket_tuple();
+        TRY(connection_table_shard(tuple()).with_exclusive([this](auto& table) -> ErrorOr<void> {
             if (table.contains(tuple()))
                 return set_so_error(EADDRINUSE);
-            table.set(tuple(), this);
+            TRY(table.try_set(tuple(), this));
+            m_registered_socket_tuple = tuple();
             return {};
         }));
-        m_registered_socket_tuple = tuple();
     }
 
     m_sequence_number = get_good_random<u32>();
@@ -673,19 +1173,12 @@ void TCPSocket::dequeue_for_retransmit()
 void TCPSocket::retransmit_packets()
 {
     auto now = TimeManagement::the().monotonic_time();
-
-    // RFC6298 says we should have at least one second between retransmits. According to
-    // RFC1122 we must do exponential backoff - even for SYN packets.
-    i64 retransmit_interval = 1;
-    for (decltype(m_retransmit_attempts) i = 0; i < m_retransmit_attempts; i++)
-        retransmit_interval *= 2;
-
-    if (m_last_retransmit_time > now - Duration::from_seconds(retransmit_interval))
+    if (now < m_retransmit_timer_start + m_retransmission_timeout)
         return;
 
     dbgln_if(TCP_SOCKET_DEBUG, "TCPSocket({}) handling retransmit", this);
 
-    m_last_retransmit_time = now;
+    m_retransmit_timer_start = now;
     ++m_retransmit_attempts;
 
     if (m_retransmit_attempts > maximum_retransmits) {
@@ -695,47 +1188,84 @@ void TCPSocket::retransmit_packets()
         return;
     }
 
-    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
-    auto routing_decision = route_to(peer_address(), local_address(), adapter);
+    // RFC 6298 section 5.5: Back off exponentially, even for SYN packets (RFC 1122).
+    m_retransmission_timeout = min(m_retransmission_timeout + m_retransmission_timeout, maximum_retransmission_timeout);
+
+    // Everything in flight is presumed lost, and goes out again as the (now much smaller) congestion window allows.
+    ++m_retransmit_timeouts;
+    m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+        m_congestion_control->on_retransmit_timeout(unacked_packets.size, now);
+        // RFC 2018 section 8: The peer is allowed to discard what it has SACKed, so we can't rely on it anymore.
+        for (auto& packet : unacked_packets.packets) {
+            packet.needs_retransmit = true;
+            packet.sacked = false;
+        }
+        unacked_packets.sacked_count = 0;
+    });
+    m_fast_recovery_point.clear();
+    m_duplicate_acks_received = 0;
+
+    retransmit_marked_packets();
+}
+
+void TCPSocket::retransmit_marked_packets()
+{
+    auto routing_decision = route_to_peer();
     if (routing_decision.is_zero())
         return;
 
     m_unacked_packets.with_exclusive([&](auto& unacked_packets) {
+        // The first packet always goes out, the ones after it only if they (and everything before them) fit in the window.
+        size_t bytes_before_packet = 0;
         for (auto& packet : unacked_packets.packets) {
-            packet.tx_counter++;
-
-            if constexpr (TCP_SOCKET_DEBUG) {
-                auto& tcp_packet = *(TCPPacket const*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
-                dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
-                    local_address(), local_port(),
-                    peer_address(), peer_port(),
-                    (tcp_packet.has_syn() ? "SYN " : ""),
-                    (tcp_packet.has_ack() ? "ACK " : ""),
-                    (tcp_packet.has_fin() ? "FIN " : ""),
-                    (tcp_packet.has_rst() ? "RST " : ""),
-                    tcp_packet.sequence_number(),
-                    tcp_packet.ack_number(),
-                    packet.tx_counter);
+            // What the peer has SACKed isn't in flight anymore.
+            if (packet.sacked)
+                continue;
+            if (packet.needs_retransmit) {
+                if (bytes_before_packet > 0 && bytes_before_packet + packet.payload_size > m_congestion_control->congestion_window())
+                    break;
+                packet.needs_retransmit = false;
+                send_outgoing_packet(packet, routing_decision);
             }
+            bytes_before_packet += packet.payload_size;
+        }
+    });
+}
 
-            size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
-            if (ipv4_payload_offset != packet.ipv4_payload_offset) {
-                // FIXME: Add support for this. This can happen if after a route change
-                // we ended up on another adapter which doesn't have the same layer 2 type
-                // like the previous adapter.
-                VERIFY_NOT_REACHED();
-            }
+void TCPSocket::send_outgoing_packet(OutgoingPacket& packet, RoutingDecision const& routing_decision)
+{
+    packet.tx_counter++;
+    m_retransmitted_packets++;
+
+    if constexpr (TCP_SOCKET_DEBUG) {
+        auto& tcp_packet = *(TCPPacket const*)(packet.buffer->buffer->data() + packet.ipv4_payload_offset);
+        dbgln("Sending TCP packet from {}:{} to {}:{} with ({}{}{}{}) seq_no={}, ack_no={}, tx_counter={}",
+            local_address(), local_port(),
+            peer_address(), peer_port(),
+            (tcp_packet.has_syn() ? "SYN " : ""),
+            (tcp_packet.has_ack() ? "ACK " : ""),
+            (tcp_packet.has_fin() ? "FIN " : ""),
+            (tcp_packet.has_rst() ? "RST " : ""),
+            tcp_packet.sequence_number(),
+            tcp_packet.ack_number(),
+            packet.tx_counter);
+    }
 
-            auto packet_buffer = packet.buffer->bytes();
+    size_t ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
+    if (ipv4_payload_offset != packet.ipv4_payload_offset) {
+        // FIXME: Add support for this. This can happen if after a route change
+        // we ended up on another adapter which doesn't have the same layer 2 type
+        // like the previous adapter.
+        VERIFY_NOT_REACHED();
+    }
 
-            routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
-                local_address(), routing_decision.next_hop, peer_address(),
-                TransportProtocol::TCP, packet_buffer.size() - ipv4_payload_offset, type_of_service(), ttl());
-            routing_decision.adapter->send_packet(packet_buffer);
-            m_packets_out++;
-            m_bytes_out += packet_buffer.size();
-        }
-    });
+    routing_decision.adapter->fill_in_ipv4_header(*packet.buffer,
+        local_address(), routing_decision.next_hop, peer_address(),
+        TransportProtocol::TCP, packet.buffer->size() - ipv4_payload_offset, type_of_service(), ttl());
+    // If the adapter changed, this also does whatever the new one can't offload.
+    routing_decision.adapter->send_packet(*packet.buffer);
+    m_packets_out++;
+    m_bytes_out += packet.buffer->size();
 }
 
 bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size) const
@@ -746,11 +1276,9 @@ bool TCPSocket::can_write(OpenFileDescription const& file_description, u64 size)
     if (m_state == State::SynSent || m_state == State::SynReceived)
         return false;
 
-    if (!file_description.is_blocking())
-        return true;
-
     return m_unacked_packets.with_shared([&](auto& unacked_packets) {
-        return unacked_packets.size + size <= m_send_window_size;
+        // With nothing in flight, we always send, so that a closed window gets probed.
+        return unacked_packets.size == 0 || unacked_packets.size < send_window();
     });
 }
 }
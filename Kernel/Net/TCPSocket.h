@@ -12,9 +12,12 @@
 #include <AK/IntegralMath.h>
 #include <AK/SinglyLinkedList.h>
 #include <AK/Time.h>
+#include <AK/Vector.h>
 #include <Kernel/Library/LockWeakPtr.h>
 #include <Kernel/Locking/MutexProtected.h>
 #include <Kernel/Net/IP/Socket.h>
+#include <Kernel/Net/TCP.h>
+#include <Kernel/Net/TCPCongestionControl.h>
 #include <Kernel/Time/TimerQueue.h>
 
 namespace Kernel {
@@ -136,6 +139,10 @@ public:
     u32 bytes_in() const { return m_bytes_in; }
     u32 packets_out() const { return m_packets_out; }
     u32 bytes_out() const { return m_bytes_out; }
+    u32 out_of_order_packets() const { return m_out_of_order_packets; }
+    u32 retransmitted_packets() const { return m_retransmitted_packets; }
+    u32 fast_retransmits() const { return m_fast_retransmits; }
+    u32 retransmit_timeouts() const { return m_retransmit_timeouts; }
 
     void set_send_window_scale(size_t scale)
     {
@@ -143,18 +150,35 @@ public:
         m_send_window_scale = scale;
     }
 
+    // Whether both sides have agreed to use selective acknowledgements (RFC 2018).
+    bool is_sack_permitted() const { return m_sack_permitted; }
+    void set_sack_permitted(bool permitted) { m_sack_permitted = permitted; }
+
+    // Holds on to a segment that arrived ahead of the next one we expect, until the hole before it is filled.
+    // Returns false if the segment isn't ahead, or there's no room for it.
+    bool queue_out_of_order_segment(IPv4Packet const&, TCPPacket const&, u32 payload_size, UnixDateTime const& packet_timestamp);
+    // Receives the queued segments that the last in-order segment made contiguous, returns whether there were any.
+    bool receive_queued_segments();
+
     // FIXME: Make this configurable?
     static constexpr u32 maximum_duplicate_acks = 5;
     void set_duplicate_acks(u32 acks) { m_duplicate_acks = acks; }
     u32 duplicate_acks() const { return m_duplicate_acks; }
 
     ErrorOr<void> send_ack(bool allow_duplicate = false);
-    ErrorOr<void> send_tcp_packet(u16 flags, UserOrKernelBuffer const* = nullptr, size_t = 0, RoutingDecision* = nullptr);
+    // With a segment size, the payload is a super-segment for an adapter with Offload::TCPSegmentation.
+    // With fragments, the payload is sent from their pages instead of being copied.
+    ErrorOr<void> send_tcp_packet(u16 flags, UserOrKernelBuffer const* = nullptr, size_t = 0, RoutingDecision* = nullptr, size_t segment_size = 0, Vector<PacketFragment> payload_fragments = {});
     void receive_tcp_packet(TCPPacket const&, u16 size);
 
     bool should_delay_next_ack() const;
 
-    static MutexProtected<HashMap<IPv4SocketTuple, TCPSocket*>>& sockets_by_tuple();
+    using SocketTable = HashMap<IPv4SocketTuple, TCPSocket*>;
+    // Sockets that are bound to a local address and port but aren't connected, which is where listening sockets live.
+    static MutexProtected<SocketTable>& listening_sockets();
+    // Connected sockets are spread across shards by the hash of their tuple, so segments for different
+    // connections don't all have to wait on the same lock.
+    static MutexProtected<SocketTable>& connection_table_shard(IPv4SocketTuple const&);
     static RefPtr<TCPSocket> from_tuple(IPv4SocketTuple const& tuple);
 
     static MutexProtected<HashMap<IPv4SocketTuple, RefPtr<TCPSocket>>>& closing_sockets();
@@ -173,14 +197,14 @@ public:
 
     static NetworkOrdered<u16> compute_tcp_checksum(IPv4Address const& source, IPv4Address const& destination, TCPPacket const&, u16 payload_size);
 
-    virtual ErrorOr<void> setsockopt(int level, int option, Userspace<void const*>, socklen_t) override;
+    virtual ErrorOr<void> setsockopt(OpenFileDescription&, int level, int option, Userspace<void const*>, socklen_t) override;
     virtual ErrorOr<void> getsockopt(OpenFileDescription&, int level, int option, Userspace<void*>, Userspace<socklen_t*>) override;
 
 protected:
     void set_direction(Direction direction) { m_direction = direction; }
 
 private:
-    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer);
+    explicit TCPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer, NonnullOwnPtr<KBuffer> scratch_buffer, NonnullRefPtr<Timer> timer, NonnullOwnPtr<TCPCongestionControl>);
     virtual StringView class_name() const override { return "TCPSocket"sv; }
 
     virtual void shut_down_for_writing() override;
@@ -195,9 +219,25 @@ private:
 
     void do_state_closed();
 
+    static MutexProtected<SocketTable>& socket_table_for(IPv4SocketTuple const&);
+    ErrorOr<void> check_for_overlapping_binds(SocketTable const&);
+    void unregister_socket_tuple();
+
     void enqueue_for_retransmit();
     void dequeue_for_retransmit();
 
+    struct OutgoingPacket;
+    struct UnackedPackets;
+    void update_round_trip_time(Duration sample);
+    void process_sack_option(TCPPacket const&, UnackedPackets&);
+    void mark_lost_packets_in_fast_recovery(UnackedPackets&);
+    Vector<TCPSACKBlock, TCPOptionSACK::maximum_block_count> sack_blocks() const;
+    void send_outgoing_packet(OutgoingPacket&, RoutingDecision const&);
+    void retransmit_marked_packets();
+
+    // How much we may have in flight: The peer's receive window, limited by the congestion window.
+    u32 send_window() const { return min(m_send_window_size, m_congestion_control->congestion_window()); }
+
     static constexpr size_t receive_window_scale()
     {
         auto buffer_size_bit_length = AK::log2(receive_buffer_size) + 1;
@@ -218,18 +258,46 @@ private:
     u32 m_bytes_in { 0 };
     u32 m_packets_out { 0 };
     u32 m_bytes_out { 0 };
+    u32 m_out_of_order_packets { 0 };
+    u32 m_retransmitted_packets { 0 };
+    u32 m_fast_retransmits { 0 };
+    u32 m_retransmit_timeouts { 0 };
+
+    struct OutOfOrderSegment {
+        u32 sequence_number { 0 };
+        u32 payload_size { 0 };
+        NonnullOwnPtr<KBuffer> packet;
+        UnixDateTime timestamp;
+    };
+
+    // Sorted by sequence number, and never overlapping.
+    static constexpr size_t maximum_out_of_order_segments = 128;
+    Vector<OutOfOrderSegment> m_out_of_order_segments;
+    // RFC 2018 section 4: The first SACK block has to report the most recently received segment.
+    u32 m_last_out_of_order_sequence_number { 0 };
+    bool m_sack_permitted { false };
 
     struct OutgoingPacket {
         u32 ack_number { 0 };
         RefPtr<PacketWithTimestamp> buffer;
         size_t ipv4_payload_offset;
         LockWeakPtr<NetworkAdapter> adapter;
+        size_t payload_size { 0 };
+        MonotonicTime first_sent_time;
         int tx_counter { 0 };
+        // Set when the packet is presumed lost, it's sent again as soon as the congestion window allows.
+        bool needs_retransmit { false };
+        bool retransmitted_in_fast_recovery { false };
+        // The peer told us it has received this packet, but can't acknowledge it yet because of a hole before it.
+        bool sacked { false };
+
+        u32 sequence_number() const { return ack_number - payload_size; }
     };
 
     struct UnackedPackets {
         SinglyLinkedList<OutgoingPacket> packets;
         size_t size { 0 };
+        size_t sacked_count { 0 };
     };
 
     MutexProtected<UnackedPackets> m_unacked_packets;
@@ -243,9 +311,24 @@ private:
 
     // FIXME: Make this configurable (sysctl)
     static constexpr u32 maximum_retransmits = 5;
-    MonotonicTime m_last_retransmit_time;
+    // Retransmissions time out after m_retransmission_timeout without any new data being acknowledged.
+    MonotonicTime m_retransmit_timer_start;
     u32 m_retransmit_attempts { 0 };
 
+    // RFC 6298
+    static constexpr Duration initial_retransmission_timeout = Duration::from_seconds(1);
+    static constexpr Duration minimum_retransmission_timeout = Duration::from_seconds(1);
+    static constexpr Duration maximum_retransmission_timeout = Duration::from_seconds(60);
+    Optional<Duration> m_smoothed_round_trip_time;
+    Duration m_round_trip_time_variation;
+    Duration m_retransmission_timeout { initial_retransmission_timeout };
+
+    NonnullOwnPtr<TCPCongestionControl> m_congestion_control;
+    u32 m_last_acknowledged_number { 0 };
+    u32 m_duplicate_acks_received { 0 };
+    // While in fast recovery, the sequence number that was next to be sent when it began.
+    Optional<u32> m_fast_recovery_point;
+
     // Default to maximum window size. receive_tcp_packet() will update from the
     // peer's advertised window size.
     u32 m_send_window_size { 64 * KiB };
@@ -256,6 +339,16 @@ private:
 
     Optional<IPv4SocketTuple> m_registered_socket_tuple;
 
+    // Sockets that were bound to the same address and port with SO_REUSEPORT. Only one of them is in the
+    // listening_sockets() table, and new connections are spread across the listening ones by the hash of
+    // their tuple. Protected by the listening_sockets() lock.
+    struct ReusePortGroup : public RefCounted<ReusePortGroup> {
+        RefPtr<TCPSocket> select_listener(IPv4SocketTuple const&) const;
+
+        Vector<TCPSocket*, 4> members;
+    };
+    RefPtr<ReusePortGroup> m_reuse_port_group;
+
     NonnullRefPtr<Timer> m_timer;
 
 public:
@@ -15,6 +15,9 @@ public:
     UDPPacket() = default;
     ~UDPPacket() = default;
 
+    // For network adapters that fill in the checksum.
+    static constexpr size_t checksum_offset = 6;
+
     u16 source_port() const { return m_source_port; }
     void set_source_port(u16 port) { m_source_port = port; }
 
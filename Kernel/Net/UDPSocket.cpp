@@ -19,15 +19,26 @@ namespace Kernel {
 void UDPSocket::for_each(Function<void(UDPSocket const&)> callback)
 {
     sockets_by_port().for_each_shared([&](auto const& socket) {
-        callback(*socket.value);
+        if (!socket.value->m_port_group) {
+            callback(*socket.value);
+            return;
+        }
+        for (auto* member : socket.value->m_port_group->members)
+            callback(*member);
     });
 }
 
 ErrorOr<void> UDPSocket::try_for_each(Function<ErrorOr<void>(UDPSocket const&)> callback)
 {
     return sockets_by_port().with_shared([&](auto const& sockets) -> ErrorOr<void> {
-        for (auto& socket : sockets)
-            TRY(callback(*socket.value));
+        for (auto& socket : sockets) {
+            if (!socket.value->m_port_group) {
+                TRY(callback(*socket.value));
+                continue;
+            }
+            for (auto* member : socket.value->m_port_group->members)
+                TRY(callback(*member));
+        }
         return {};
     });
 }
@@ -39,13 +50,35 @@ MutexProtected<HashMap<u16, UDPSocket*>>& UDPSocket::sockets_by_port()
     return *s_map;
 }
 
-RefPtr<UDPSocket> UDPSocket::from_port(u16 port)
+RefPtr<UDPSocket> UDPSocket::from_tuple(IPv4SocketTuple const& tuple)
 {
     return sockets_by_port().with_shared([&](auto const& table) -> RefPtr<UDPSocket> {
-        auto it = table.find(port);
+        auto it = table.find(tuple.local_port());
         if (it == table.end())
             return {};
-        return (*it).value;
+        auto& socket = *it->value;
+        if (!socket.m_port_group)
+            return socket;
+        auto& members = socket.m_port_group->members;
+        return *members[Traits<IPv4SocketTuple>::hash(tuple) % members.size()];
+    });
+}
+
+ErrorOr<Vector<NonnullRefPtr<UDPSocket>, 4>> UDPSocket::sockets_bound_to_port(u16 port)
+{
+    return sockets_by_port().with_shared([&](auto const& table) -> ErrorOr<Vector<NonnullRefPtr<UDPSocket>, 4>> {
+        Vector<NonnullRefPtr<UDPSocket>, 4> sockets;
+        auto it = table.find(port);
+        if (it == table.end())
+            return sockets;
+        auto& socket = *it->value;
+        if (!socket.m_port_group) {
+            TRY(sockets.try_append(socket));
+            return sockets;
+        }
+        for (auto* member : socket.m_port_group->members)
+            TRY(sockets.try_append(*member));
+        return sockets;
     });
 }
 
@@ -57,7 +90,19 @@ UDPSocket::UDPSocket(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer)
 UDPSocket::~UDPSocket()
 {
     sockets_by_port().with_exclusive([&](auto& table) {
-        table.remove(local_port());
+        auto it = table.find(local_port());
+        bool is_in_table = it != table.end() && it->value == this;
+        if (m_port_group) {
+            auto& members = m_port_group->members;
+            members.remove_first_matching([this](auto* member) { return member == this; });
+            // Another member of the group takes over the entry.
+            if (is_in_table && !members.is_empty())
+                it->value = members.first();
+            else if (is_in_table)
+                table.remove(it);
+        } else if (is_in_table) {
+            table.remove(it);
+        }
     });
 }
 
@@ -85,9 +130,8 @@ ErrorOr<size_t> UDPSocket::protocol_receive(ReadonlyBytes raw_ipv4_packet, UserO
 
 ErrorOr<size_t> UDPSocket::protocol_send(UserOrKernelBuffer const& data, size_t data_length)
 {
-    auto adapter = bound_interface().with([](auto& bound_device) -> RefPtr<NetworkAdapter> { return bound_device; });
     auto allow_broadcast = m_broadcast_allowed ? AllowBroadcast::Yes : AllowBroadcast::No;
-    auto routing_decision = route_to(peer_address(), local_address(), adapter, allow_broadcast);
+    auto routing_decision = route_to_peer(allow_broadcast);
     if (routing_decision.is_zero())
         return set_so_error(EHOSTUNREACH);
     auto ipv4_payload_offset = routing_decision.adapter->ipv4_payload_offset();
@@ -104,7 +148,15 @@ ErrorOr<size_t> UDPSocket::protocol_send(UserOrKernelBuffer const& data, size_t
     SOCKET_TRY(data.read(udp_packet.payload(), data_length));
     routing_decision.adapter->fill_in_ipv4_header(*packet, local_address(), routing_decision.next_hop,
         peer_address(), TransportProtocol::UDP, udp_buffer_size, type_of_service(), ttl());
-    routing_decision.adapter->send_packet(packet->bytes());
+    // The checksum is optional for UDP over IPv4, so we only have one if the adapter computes it for us.
+    if (routing_decision.adapter->has_offload(NetworkAdapter::Offload::TransmitChecksum)) {
+        auto pseudo_header_checksum = ipv4_pseudo_header_checksum(local_address(), peer_address(), TransportProtocol::UDP, udp_buffer_size);
+        udp_packet.set_checksum(pseudo_header_checksum.partial_sum());
+        packet->transmit_offload.needs_checksum = true;
+        packet->transmit_offload.checksum_start = ipv4_payload_offset;
+        packet->transmit_offload.checksum_offset = UDPPacket::checksum_offset;
+    }
+    routing_decision.adapter->send_packet(*packet);
     return data_length;
 }
 
@@ -143,11 +195,24 @@ ErrorOr<void> UDPSocket::protocol_bind()
             return set_so_error(EADDRINUSE);
         });
     } else {
-        // Verify that the user-supplied port is not already used by someone else.
+        // Verify that the user-supplied port is not already used by someone else, unless we may share it.
         return sockets_by_port().with_exclusive([&](auto& table) -> ErrorOr<void> {
-            if (table.contains(local_port()))
+            auto existing = table.get(local_port());
+            if (!existing.has_value()) {
+                TRY(table.try_set(local_port(), this));
+                return {};
+            }
+
+            auto& other_socket = *existing.value();
+            if (!can_share_udp_port_with(other_socket))
                 return set_so_error(EADDRINUSE);
-            table.set(local_port(), this);
+            if (!other_socket.m_port_group) {
+                auto group = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) PortGroup));
+                TRY(group->members.try_append(&other_socket));
+                other_socket.m_port_group = move(group);
+            }
+            TRY(other_socket.m_port_group->members.try_append(this));
+            m_port_group = other_socket.m_port_group;
             return {};
         });
     }
@@ -17,7 +17,10 @@ public:
     static ErrorOr<NonnullRefPtr<UDPSocket>> try_create(int protocol, NonnullOwnPtr<DoubleBuffer> receive_buffer);
     virtual ~UDPSocket() override;
 
-    static RefPtr<UDPSocket> from_port(u16);
+    // The socket that receives unicast datagrams of this flow.
+    static RefPtr<UDPSocket> from_tuple(IPv4SocketTuple const&);
+    // Every socket bound to the port, for datagrams that all of them receive.
+    static ErrorOr<Vector<NonnullRefPtr<UDPSocket>, 4>> sockets_bound_to_port(u16);
     static void for_each(Function<void(UDPSocket const&)>);
     static ErrorOr<void> try_for_each(Function<ErrorOr<void>(UDPSocket const&)>);
 
@@ -26,11 +29,25 @@ private:
     virtual StringView class_name() const override { return "UDPSocket"sv; }
     static MutexProtected<HashMap<u16, UDPSocket*>>& sockets_by_port();
 
+    // Whether this socket may join the other, already bound one on the same port.
+    bool can_share_udp_port_with(UDPSocket const& other) const
+    {
+        return can_share_port_with(other) || (reuses_address() && other.reuses_address());
+    }
+
     virtual ErrorOr<size_t> protocol_receive(ReadonlyBytes raw_ipv4_packet, UserOrKernelBuffer& buffer, size_t buffer_size, int flags) override;
     virtual ErrorOr<size_t> protocol_send(UserOrKernelBuffer const&, size_t) override;
     virtual ErrorOr<size_t> protocol_size(ReadonlyBytes raw_ipv4_packet) override;
     virtual ErrorOr<void> protocol_connect(OpenFileDescription&) override;
     virtual ErrorOr<void> protocol_bind() override;
+
+    // Sockets that were bound to the same port with SO_REUSEPORT or SO_REUSEADDR. Only one of them is in the
+    // sockets_by_port() table, and unicast datagrams are spread across them by the hash of their flow.
+    // Protected by the sockets_by_port() lock.
+    struct PortGroup : public RefCounted<PortGroup> {
+        Vector<UDPSocket*, 4> members;
+    };
+    RefPtr<PortGroup> m_port_group;
 };
 
 }
@@ -4,9 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <Kernel/Arch/Delay.h>
 #include <Kernel/Bus/PCI/IDs.h>
 #include <Kernel/Bus/VirtIO/Transport/PCIe/TransportLink.h>
 #include <Kernel/Net/NetworkingManagement.h>
+#include <Kernel/Net/TCP.h>
 #include <Kernel/Net/VirtIO/VirtIONetworkAdapter.h>
 
 namespace Kernel {
@@ -48,8 +50,8 @@ static constexpr u16 VIRTIO_NET_S_LINK_UP = 1;
 static constexpr u16 VIRTIO_NET_S_ANNOUNCE = 2;
 
 static constexpr u8 VIRTIO_NET_HDR_F_NEEDS_CSUM = 1;
-static constexpr u8 VIRTIO_NET_HDR_F_DATA_VALID = 1;
-static constexpr u8 VIRTIO_NET_HDR_F_RSC_INFO = 1;
+static constexpr u8 VIRTIO_NET_HDR_F_DATA_VALID = 2;
+static constexpr u8 VIRTIO_NET_HDR_F_RSC_INFO = 4;
 static constexpr u8 VIRTIO_NET_HDR_GSO_NONE = 0;
 static constexpr u8 VIRTIO_NET_HDR_GSO_TCPV4 = 1;
 static constexpr u8 VIRTIO_NET_HDR_GSO_UDP = 3;
@@ -69,6 +71,16 @@ struct [[gnu::packed]] VirtIONetConfig {
     LittleEndian<u32> supported_hash_types;
 };
 
+static constexpr u8 VIRTIO_NET_OK = 0;
+static constexpr u8 VIRTIO_NET_CTRL_MQ = 4;
+static constexpr u8 VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET = 0;
+
+struct [[gnu::packed]] VirtIONetCtrlMQ {
+    u8 class_;
+    u8 command;
+    LittleEndian<u16> virtqueue_pairs;
+};
+
 struct [[gnu::packed]] VirtIONetHdr {
     u8 flags;
     u8 gso_type;
@@ -84,8 +96,7 @@ struct [[gnu::packed]] VirtIONetHdr {
 
 using namespace VirtIO;
 
-static constexpr u16 RECEIVEQ = 0;
-static constexpr u16 TRANSMITQ = 1;
+static constexpr u16 MAX_QUEUE_PAIRS = 8;
 
 static constexpr size_t MAX_RX_FRAME_SIZE = 1514; // Non-jumbo Ethernet frame limit.
 static constexpr size_t RX_BUFFER_SIZE = sizeof(VirtIONetHdr) * MAX_RX_FRAME_SIZE;
@@ -116,7 +127,6 @@ UNMAP_AFTER_INIT VirtIONetworkAdapter::VirtIONetworkAdapter(StringView interface
 UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::initialize(Badge<NetworkingManagement>)
 {
     m_rx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Rx buffer"sv, RX_BUFFER_SIZE * MAX_INFLIGHT_PACKETS));
-    m_tx_buffers = TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Tx buffer"sv, RX_BUFFER_SIZE * MAX_INFLIGHT_PACKETS));
 
     return initialize_virtio_resources();
 }
@@ -127,8 +137,18 @@ UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::initialize_virtio_resources
     TRY(Device::initialize_virtio_resources());
     m_device_config = TRY(transport_entity().get_config(VirtIO::ConfigurationType::Device));
 
+    u16 max_queue_pairs = 1;
     TRY(negotiate_features([&](u64 supported_features) {
         u64 negotiated = 0;
+        // Every processor gets its own pair of queues (as far as they go), so transmitting doesn't contend on a single
+        // queue lock. We have to set up every queue up to the control queue, so devices with lots of them are left alone.
+        if (is_feature_set(supported_features, VIRTIO_NET_F_CTRL_VQ | VIRTIO_NET_F_MQ) && Processor::count() > 1) {
+            max_queue_pairs = transport_entity().config_read16(*m_device_config, offsetof(VirtIONetConfig, max_virtqueue_pairs));
+            if (max_queue_pairs > 1 && max_queue_pairs <= MAX_QUEUE_PAIRS)
+                negotiated |= VIRTIO_NET_F_CTRL_VQ | VIRTIO_NET_F_MQ;
+            else
+                max_queue_pairs = 1;
+        }
         if (is_feature_set(supported_features, VIRTIO_NET_F_STATUS))
             negotiated |= VIRTIO_NET_F_STATUS;
         if (is_feature_set(supported_features, VIRTIO_NET_F_MAC))
@@ -137,27 +157,110 @@ UNMAP_AFTER_INIT ErrorOr<void> VirtIONetworkAdapter::initialize_virtio_resources
             negotiated |= VIRTIO_NET_F_SPEED_DUPLEX;
         if (is_feature_set(supported_features, VIRTIO_NET_F_MTU))
             negotiated |= VIRTIO_NET_F_MTU;
+        if (is_feature_set(supported_features, VIRTIO_NET_F_CSUM)) {
+            negotiated |= VIRTIO_NET_F_CSUM;
+            if (is_feature_set(supported_features, VIRTIO_NET_F_HOST_TSO4))
+                negotiated |= VIRTIO_NET_F_HOST_TSO4;
+        }
+        if (is_feature_set(supported_features, VIRTIO_NET_F_GUEST_CSUM))
+            negotiated |= VIRTIO_NET_F_GUEST_CSUM;
         return negotiated;
     }));
 
+    auto offloads = Offload::None;
+    if (is_feature_accepted(VIRTIO_NET_F_CSUM))
+        offloads |= Offload::TransmitChecksum;
+    if (is_feature_accepted(VIRTIO_NET_F_HOST_TSO4))
+        offloads |= Offload::TCPSegmentation;
+    if (is_feature_accepted(VIRTIO_NET_F_GUEST_CSUM))
+        offloads |= Offload::ReceiveChecksum;
+    set_offloads(offloads | Offload::ScatterGather);
+
     TRY(handle_device_config_change());
-    TRY(setup_queues(2)); // receive & transmit
+    if (is_feature_accepted(VIRTIO_NET_F_MQ)) {
+        m_queue_pair_count = min<u16>(max_queue_pairs, Processor::count());
+        m_control_queue = max_queue_pairs * 2;
+        TRY(setup_queues(max_queue_pairs * 2 + 1));
+    } else {
+        TRY(setup_queues(2)); // receive & transmit
+    }
+
+    auto tx_buffer_size = TRY(Memory::page_round_up(RX_BUFFER_SIZE * MAX_INFLIGHT_PACKETS / m_queue_pair_count));
+    for (u16 pair = 0; pair < m_queue_pair_count; ++pair) {
+        TRY(m_tx_buffers.try_append(TRY(Memory::RingBuffer::try_create("VirtIONetworkAdapter Tx buffer"sv, tx_buffer_size))));
+        Vector<Vector<NonnullRefPtr<Memory::PhysicalRAMPage>>> fragment_pages;
+        TRY(fragment_pages.try_resize(get_queue(transmit_queue(pair)).size()));
+        TRY(m_tx_fragment_pages.try_append(move(fragment_pages)));
+    }
 
     finish_init();
 
-    {
-        // Supply receive buffers.
-        auto& rx_queue = get_queue(RECEIVEQ);
+    if (m_control_queue.has_value()) {
+        // We wait for control commands to complete right after submitting them.
+        get_queue(m_control_queue.value()).disable_interrupts();
+        TRY(set_active_queue_pairs(m_queue_pair_count));
+    }
+    dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: Using {} queue pairs", m_queue_pair_count);
+
+    // Supply receive buffers, spread evenly over the receive queues.
+    auto buffers_per_queue = m_rx_buffers->available_bytes() / RX_BUFFER_SIZE / m_queue_pair_count;
+    for (u16 pair = 0; pair < m_queue_pair_count; ++pair) {
+        auto& rx_queue = get_queue(receive_queue(pair));
         SpinlockLocker queue_lock(rx_queue.lock());
         VirtIO::QueueChain chain(rx_queue);
-        while (m_rx_buffers->available_bytes() > RX_BUFFER_SIZE) {
+        for (size_t i = 0; i < buffers_per_queue && m_rx_buffers->available_bytes() > RX_BUFFER_SIZE; ++i) {
             // We know that the RingBuffer will not wraparound in this loop. But it's still awkward.
             auto buffer_start = MUST(m_rx_buffers->reserve_space(RX_BUFFER_SIZE));
-            VERIFY(chain.add_buffer_to_chain(buffer_start, RX_BUFFER_SIZE, VirtIO::BufferType::DeviceWritable));
-            supply_chain_and_notify(RECEIVEQ, chain);
+            if (!chain.add_buffer_to_chain(buffer_start, RX_BUFFER_SIZE, VirtIO::BufferType::DeviceWritable)) {
+                m_rx_buffers->reclaim_space(buffer_start, RX_BUFFER_SIZE);
+                break;
+            }
+            supply_chain(receive_queue(pair), chain);
         }
+        notify_queue_if_needed(receive_queue(pair));
+    }
+
+    return {};
+}
+
+ErrorOr<void> VirtIONetworkAdapter::set_active_queue_pairs(u16 count)
+{
+    VERIFY(m_control_queue.has_value());
+    auto command_region = TRY(MM.allocate_contiguous_kernel_region(PAGE_SIZE, "VirtIONetworkAdapter control"sv, Memory::Region::Access::ReadWrite));
+    auto* command = reinterpret_cast<VirtIONetCtrlMQ*>(command_region->vaddr().as_ptr());
+    command->class_ = VIRTIO_NET_CTRL_MQ;
+    command->command = VIRTIO_NET_CTRL_MQ_VQ_PAIRS_SET;
+    command->virtqueue_pairs = count;
+    auto* ack = command_region->vaddr().offset(sizeof(VirtIONetCtrlMQ)).as_ptr();
+    *ack = ~VIRTIO_NET_OK;
+
+    auto& queue = get_queue(m_control_queue.value());
+    {
+        SpinlockLocker queue_lock(queue.lock());
+        VirtIO::QueueChain chain(queue);
+        auto command_address = command_region->physical_page(0)->paddr();
+        VERIFY(chain.add_buffer_to_chain(command_address, sizeof(VirtIONetCtrlMQ), VirtIO::BufferType::DeviceReadable));
+        VERIFY(chain.add_buffer_to_chain(command_address.offset(sizeof(VirtIONetCtrlMQ)), sizeof(u8), VirtIO::BufferType::DeviceWritable));
+        supply_chain_and_notify(m_control_queue.value(), chain);
+    }
+
+    // Devices handle control commands right away, so there's no point in waiting for an interrupt.
+    for (size_t attempt = 0; !queue.new_data_available(); ++attempt) {
+        if (attempt == 1000) {
+            dmesgln("VirtIONetworkAdapter: Timed out waiting for control command");
+            return Error::from_errno(ETIMEDOUT);
+        }
+        microseconds_delay(100);
+    }
+    {
+        SpinlockLocker queue_lock(queue.lock());
+        queue.discard_used_buffers();
     }
 
+    if (AK::atomic_load(ack) != VIRTIO_NET_OK) {
+        dmesgln("VirtIONetworkAdapter: Device refused to use {} queue pairs", count);
+        return Error::from_errno(EIO);
+    }
     return {};
 }
 
@@ -197,9 +300,19 @@ void VirtIONetworkAdapter::handle_queue_update(u16 queue_index)
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: handle_queue_update {}", queue_index);
 
-    if (queue_index == RECEIVEQ) {
+    // NOTE: Control commands are waited for by set_active_queue_pairs().
+    if (queue_index == m_control_queue)
+        return;
+
+    auto pair = queue_index / 2;
+    if (pair >= m_queue_pair_count) {
+        dmesgln("VirtIONetworkAdapter: unexpected update for queue {}", queue_index);
+        return;
+    }
+
+    if (queue_index == receive_queue(pair)) {
         // FIXME: Disable interrupts while receiving as recommended by the spec.
-        auto& queue = get_queue(RECEIVEQ);
+        auto& queue = get_queue(queue_index);
         SpinlockLocker queue_lock(queue.lock());
         size_t used;
         VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
@@ -209,28 +322,34 @@ void VirtIONetworkAdapter::handle_queue_update(u16 queue_index)
             popped_chain.for_each([&](PhysicalAddress addr, size_t length) {
                 size_t offset = addr.as_ptr() - m_rx_buffers->start_of_region().as_ptr();
                 auto* message = reinterpret_cast<VirtIONetHdr*>(m_rx_buffers->vaddr().offset(offset).as_ptr());
-                did_receive({ message->frame, length - sizeof(VirtIONetHdr) });
+                // Packets that still need their checksum come from the host itself, so they are as good as verified.
+                bool checksum_verified = is_feature_accepted(VIRTIO_NET_F_GUEST_CSUM) && (message->flags & (VIRTIO_NET_HDR_F_DATA_VALID | VIRTIO_NET_HDR_F_NEEDS_CSUM));
+                did_receive({ message->frame, length - sizeof(VirtIONetHdr) }, checksum_verified);
             });
 
-            supply_chain_and_notify(RECEIVEQ, popped_chain);
+            supply_chain(queue_index, popped_chain);
             popped_chain = queue.pop_used_buffer_chain(used);
         }
-    } else if (queue_index == TRANSMITQ) {
-        auto& queue = get_queue(TRANSMITQ);
+        // The device only has to hear about the buffers we gave back once, no matter how many there were.
+        notify_queue_if_needed(queue_index);
+    } else {
+        auto& queue = get_queue(queue_index);
+        auto& tx_buffers = *m_tx_buffers[pair];
         SpinlockLocker queue_lock(queue.lock());
-        SpinlockLocker ringbuffer_lock(m_tx_buffers->lock());
+        SpinlockLocker ringbuffer_lock(tx_buffers.lock());
 
         size_t used;
         VirtIO::QueueChain popped_chain = queue.pop_used_buffer_chain(used);
         do {
-            popped_chain.for_each([this](PhysicalAddress address, size_t length) {
-                m_tx_buffers->reclaim_space(address, length);
+            if (!popped_chain.is_empty())
+                m_tx_fragment_pages[pair][popped_chain.start_index()].clear();
+            popped_chain.for_each([&](PhysicalAddress address, size_t length) {
+                if (tx_buffers.contains(address))
+                    tx_buffers.reclaim_space(address, length);
             });
             popped_chain.release_buffer_slots_to_queue();
             popped_chain = queue.pop_used_buffer_chain(used);
         } while (!popped_chain.is_empty());
-    } else {
-        dmesgln("VirtIONetworkAdapter: unexpected update for queue {}", queue_index);
     }
 }
 
@@ -254,26 +373,67 @@ static bool copy_data_to_chain(VirtIO::QueueChain& chain, Memory::RingBuffer& ri
 }
 
 void VirtIONetworkAdapter::send_raw(ReadonlyBytes payload)
+{
+    send_with_header({}, payload);
+}
+
+void VirtIONetworkAdapter::send_raw_with_offload(PacketWithTimestamp const& packet)
+{
+    auto const& offload = packet.transmit_offload;
+    auto payload = packet.buffer->bytes();
+    VirtIONetHdr hdr {};
+    if (offload.needs_checksum) {
+        hdr.flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+        hdr.csum_start = offload.checksum_start;
+        hdr.csum_offset = offload.checksum_offset;
+    }
+    if (offload.segment_size != 0) {
+        VERIFY(offload.needs_checksum);
+        auto const& tcp_packet = *reinterpret_cast<TCPPacket const*>(payload.offset_pointer(offload.checksum_start));
+        hdr.gso_type = VIRTIO_NET_HDR_GSO_TCPV4;
+        hdr.gso_size = offload.segment_size;
+        hdr.hdr_len = offload.checksum_start + tcp_packet.header_size();
+    }
+    send_with_header(hdr, payload, packet.fragments);
+}
+
+void VirtIONetworkAdapter::send_with_header(VirtIONetHdr const& hdr, ReadonlyBytes payload, ReadonlySpan<PacketFragment> fragments)
 {
     dbgln_if(VIRTIO_DEBUG, "VirtIONetworkAdapter: send_raw length={}", payload.size());
 
-    auto& queue = get_queue(TRANSMITQ);
+    // Transmitting on the queue of the current processor keeps processors from contending on the queue locks.
+    auto pair = static_cast<u16>(Processor::current_id() % m_queue_pair_count);
+    auto& queue = get_queue(transmit_queue(pair));
+    auto& tx_buffers = *m_tx_buffers[pair];
     SpinlockLocker queue_lock(queue.lock());
     VirtIO::QueueChain chain(queue);
 
-    SpinlockLocker ringbuffer_lock(m_tx_buffers->lock());
-    if (m_tx_buffers->available_bytes() < sizeof(VirtIONetHdr) + payload.size()) {
+    SpinlockLocker ringbuffer_lock(tx_buffers.lock());
+    if (tx_buffers.available_bytes() < sizeof(VirtIONetHdr) + payload.size()) {
         // We can drop packets that don't fit to apply back pressure on eager senders.
         dmesgln("VirtIONetworkAdapter: not enough space in the buffer. Dropping packet");
         return;
     }
 
+    Vector<NonnullRefPtr<Memory::PhysicalRAMPage>> fragment_pages;
+    if (!fragments.is_empty()) {
+        // The header and the buffer take up to two descriptors each, as they may wrap around the end of the RingBuffer.
+        if (queue.free_slot_count() < 4 + fragments.size() || fragment_pages.try_ensure_capacity(fragments.size()).is_error()) {
+            dmesgln("VirtIONetworkAdapter: not enough descriptors for a scatter-gather packet. Dropping packet");
+            return;
+        }
+        for (auto const& fragment : fragments)
+            fragment_pages.unchecked_append(fragment.page);
+    }
+
     // FIXME: Handle errors from pushing to the chain and rewind the RingBuffer.
-    VirtIONetHdr hdr {};
-    VERIFY(copy_data_to_chain(chain, *m_tx_buffers, reinterpret_cast<u8*>(&hdr), sizeof(hdr)));
-    VERIFY(copy_data_to_chain(chain, *m_tx_buffers, payload.data(), payload.size()));
+    VERIFY(copy_data_to_chain(chain, tx_buffers, reinterpret_cast<u8 const*>(&hdr), sizeof(hdr)));
+    VERIFY(copy_data_to_chain(chain, tx_buffers, payload.data(), payload.size()));
+    for (auto const& fragment : fragments)
+        VERIFY(chain.add_buffer_to_chain(fragment.page->paddr().offset(fragment.offset), fragment.length, VirtIO::BufferType::DeviceReadable));
+    m_tx_fragment_pages[pair][chain.start_index()] = move(fragment_pages);
 
-    supply_chain_and_notify(TRANSMITQ, chain);
+    supply_chain_and_notify(transmit_queue(pair), chain);
 }
 
 }
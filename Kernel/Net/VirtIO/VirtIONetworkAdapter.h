@@ -6,12 +6,17 @@
 
 #pragma once
 
+#include <AK/Vector.h>
 #include <Kernel/Bus/VirtIO/Device.h>
 #include <Kernel/Memory/RingBuffer.h>
 #include <Kernel/Net/NetworkAdapter.h>
 
 namespace Kernel {
 
+namespace VirtIO {
+struct VirtIONetHdr;
+}
+
 class VirtIONetworkAdapter
     : public VirtIO::Device
     , public NetworkAdapter {
@@ -42,6 +47,14 @@ private:
 
     // NetworkAdapter
     virtual void send_raw(ReadonlyBytes) override;
+    virtual void send_raw_with_offload(PacketWithTimestamp const&) override;
+    void send_with_header(VirtIO::VirtIONetHdr const&, ReadonlyBytes, ReadonlySpan<PacketFragment> = {});
+
+    // With VIRTIO_NET_F_MQ, there is a receive and a transmit queue for every queue pair, and a control queue after all of them.
+    static u16 receive_queue(u16 pair) { return pair * 2; }
+    static u16 transmit_queue(u16 pair) { return pair * 2 + 1; }
+
+    ErrorOr<void> set_active_queue_pairs(u16 count);
 
 private:
     VirtIO::Configuration const* m_device_config { nullptr };
@@ -52,8 +65,15 @@ private:
     i32 m_link_speed { LINKSPEED_INVALID };
     bool m_link_duplex { false };
 
+    u16 m_queue_pair_count { 1 };
+    Optional<u16> m_control_queue;
+
     OwnPtr<Memory::RingBuffer> m_rx_buffers;
-    OwnPtr<Memory::RingBuffer> m_tx_buffers;
+    // Buffers used by the device are reclaimed in the order they were handed out, so every transmit queue needs its own.
+    Vector<NonnullOwnPtr<Memory::RingBuffer>> m_tx_buffers;
+    // The device reads packet fragments straight from their pages, so we hold on to those until it's done.
+    // They are kept by the first descriptor of the chain, for every transmit queue.
+    Vector<Vector<Vector<NonnullRefPtr<Memory::PhysicalRAMPage>>>> m_tx_fragment_pages;
 };
 
 }
@@ -37,6 +37,15 @@ static HandlerMetadata const s_syscall_table[] = {
 };
 #undef __ENUMERATE_SYSCALL
 
+// Every processor only ever increments its own counters, so they don't bounce between caches.
+static Array<Array<Atomic<u64, AK::MemoryOrder::memory_order_relaxed>, Function::__Count>, MAX_CPU_COUNT> s_call_counts;
+
+u64 call_count(u32 processor, Function function)
+{
+    VERIFY(processor < MAX_CPU_COUNT);
+    return s_call_counts[processor][function].load();
+}
+
 ErrorOr<FlatPtr> handle(RegisterState& regs, FlatPtr function, FlatPtr arg1, FlatPtr arg2, FlatPtr arg3, FlatPtr arg4)
 {
     VERIFY_INTERRUPTS_ENABLED();
@@ -54,6 +63,8 @@ ErrorOr<FlatPtr> handle(RegisterState& regs, FlatPtr function, FlatPtr arg1, Fla
         return ENOSYS;
     }
 
+    s_call_counts[Processor::current_id()][function]++;
+
     auto const syscall_metadata = s_syscall_table[function];
     if (syscall_metadata.handler == nullptr) {
         dbgln("Null syscall {} requested, you probably need to rebuild this program!", function);
@@ -98,6 +109,40 @@ ErrorOr<FlatPtr> handle(RegisterState& regs, FlatPtr function, FlatPtr arg1, Fla
     return result;
 }
 
+ErrorOr<FlatPtr> handle_batched(Process& process, FlatPtr function, FlatPtr arg1, FlatPtr arg2, FlatPtr arg3, FlatPtr arg4)
+{
+    VERIFY_INTERRUPTS_ENABLED();
+
+    if (function >= Function::__Count)
+        return ENOSYS;
+
+    switch (function) {
+    // These never return to the caller, replace its address space or want the RegisterState& of the syscall.
+    case SC_exit:
+    case SC_exit_thread:
+    case SC_execve:
+    case SC_fork:
+    case SC_sigreturn:
+    case SC_syscall_batch:
+        return EINVAL;
+    default:
+        break;
+    }
+
+    Thread::current()->did_syscall();
+    s_call_counts[Processor::current_id()][function]++;
+
+    auto const syscall_metadata = s_syscall_table[function];
+    if (syscall_metadata.handler == nullptr)
+        return ENOSYS;
+
+    MutexLocker mutex_locker;
+    if (syscall_metadata.needs_lock == NeedsBigProcessLock::Yes)
+        mutex_locker.attach_and_lock(process.big_lock());
+
+    return (process.*(syscall_metadata.handler))(arg1, arg2, arg3, arg4);
+}
+
 }
 
 extern "C" NEVER_INLINE void syscall_handler(TrapFrame* trap);
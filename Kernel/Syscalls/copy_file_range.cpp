@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Checked.h>
+#include <AK/NumericLimits.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/Inode.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+ErrorOr<FlatPtr> Process::sys$copy_file_range(Userspace<Syscall::SC_copy_file_range_params const*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.flags != 0)
+        return EINVAL;
+
+    dbgln_if(IO_DEBUG, "sys$copy_file_range({}, {}, {}, {}, {})", params.fd_in, params.offset_in, params.fd_out, params.offset_out, params.length);
+
+    auto in_description = TRY(open_file_description(params.fd_in));
+    auto out_description = TRY(open_file_description(params.fd_out));
+    if (!in_description->is_readable() || !out_description->is_writable() || out_description->should_append())
+        return EBADF;
+    auto* in_inode = in_description->inode();
+    auto* out_inode = out_description->inode();
+    if (!in_inode || !out_inode || !in_inode->metadata().is_regular_file() || !out_inode->metadata().is_regular_file())
+        return EINVAL;
+
+    off_t in_offset = in_description->offset();
+    if (params.offset_in)
+        TRY(copy_from_user(&in_offset, params.offset_in));
+    off_t out_offset = out_description->offset();
+    if (params.offset_out)
+        TRY(copy_from_user(&out_offset, params.offset_out));
+    if (in_offset < 0 || out_offset < 0)
+        return EINVAL;
+
+    auto length = min(params.length, static_cast<size_t>(NumericLimits<ssize_t>::max()));
+    if (Checked<off_t>::addition_would_overflow(in_offset, static_cast<off_t>(length)) || Checked<off_t>::addition_would_overflow(out_offset, static_cast<off_t>(length)))
+        return EOVERFLOW;
+
+    // Let the filesystem do the copy if it knows how, and fall back to moving the data through the kernel otherwise.
+    size_t ncopied = 0;
+    auto ncopied_or_error = out_inode->copy_range_from(*in_inode, in_offset, out_offset, length);
+    if (!ncopied_or_error.is_error()) {
+        ncopied = ncopied_or_error.release_value();
+        if (ncopied > 0)
+            TRY(out_inode->update_timestamps({}, {}, kgettimeofday()));
+    } else if (ncopied_or_error.error().code() == ENOTSUP || ncopied_or_error.error().code() == EXDEV) {
+        Optional<off_t> in_splice_offset = in_offset;
+        Optional<off_t> out_splice_offset = out_offset;
+        ncopied = TRY(do_splice(*in_description, in_splice_offset, *out_description, out_splice_offset, length, false));
+    } else {
+        return ncopied_or_error.release_error();
+    }
+
+    in_offset += ncopied;
+    out_offset += ncopied;
+    if (params.offset_in)
+        TRY(copy_to_user(params.offset_in, &in_offset));
+    else
+        TRY(in_description->seek(in_offset, SEEK_SET));
+    if (params.offset_out)
+        TRY(copy_to_user(params.offset_out, &out_offset));
+    else
+        TRY(out_description->seek(out_offset, SEEK_SET));
+    return ncopied;
+}
+
+}
@@ -5,7 +5,6 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/FixedArray.h>
 #include <AK/ScopeGuard.h>
 #include <AK/TemporaryChange.h>
 #include <Kernel/Arch/CPU.h>
@@ -18,14 +17,13 @@
 #include <Kernel/Memory/Region.h>
 #include <Kernel/Memory/SharedInodeVMObject.h>
 #include <Kernel/Security/Random.h>
+#include <Kernel/Tasks/ExecutableLoadPlan.h>
 #include <Kernel/Tasks/PerformanceManager.h>
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/Scheduler.h>
 #include <Kernel/Tasks/ScopedProcessList.h>
 #include <Kernel/Time/TimeManagement.h>
 #include <LibELF/AuxiliaryVector.h>
-#include <LibELF/Image.h>
-#include <LibELF/Validation.h>
 
 namespace Kernel {
 
@@ -174,41 +172,17 @@ struct RequiredLoadRange {
     FlatPtr end { 0 };
 };
 
-static ErrorOr<RequiredLoadRange> get_required_load_range(OpenFileDescription& program_description)
+static ErrorOr<RequiredLoadRange> get_required_load_range(ExecutableLoadPlan const& plan)
 {
-    auto& inode = *(program_description.inode());
-    auto vmobject = TRY(Memory::SharedInodeVMObject::try_create_with_inode(inode));
-
-    size_t executable_size = inode.size();
-    size_t rounded_executable_size = TRY(Memory::page_round_up(executable_size));
-    auto region = TRY(MM.allocate_kernel_region_with_vmobject(*vmobject, rounded_executable_size, "ELF memory range calculation"sv, Memory::Region::Access::Read));
-    auto elf_image = ELF::Image(region->vaddr().as_ptr(), executable_size);
-    if (!elf_image.is_valid()) {
-        return EINVAL;
-    }
-
-    RequiredLoadRange range {};
-    elf_image.for_each_program_header([&range](auto const& pheader) {
-        if (pheader.type() != PT_LOAD)
-            return;
-
-        auto region_start = (FlatPtr)pheader.vaddr().as_ptr();
-        auto region_end = region_start + pheader.size_in_memory();
-        if (range.start == 0 || region_start < range.start)
-            range.start = region_start;
-        if (range.end == 0 || region_end > range.end)
-            range.end = region_end;
-    });
-
     // If there's nothing to load, there's nothing to execute
-    if (range.start == range.end)
+    if (plan.load_range_start() == plan.load_range_end())
         return EINVAL;
 
-    VERIFY(range.end > range.start);
-    return range;
+    VERIFY(plan.load_range_end() > plan.load_range_start());
+    return RequiredLoadRange { plan.load_range_start(), plan.load_range_end() };
 }
 
-static ErrorOr<FlatPtr> get_load_offset(Elf_Ehdr const& main_program_header, OpenFileDescription& main_program_description, OpenFileDescription* interpreter_description)
+static ErrorOr<FlatPtr> get_load_offset(ExecutableLoadPlan const& main_program_plan, ExecutableLoadPlan const* interpreter_plan)
 {
     constexpr FlatPtr load_range_start = 0x08000000;
     constexpr FlatPtr load_range_size = 65536 * PAGE_SIZE; // 2**16 * PAGE_SIZE = 256MB
@@ -218,19 +192,19 @@ static ErrorOr<FlatPtr> get_load_offset(Elf_Ehdr const& main_program_header, Ope
         return Memory::page_round_down(start + get_good_random<FlatPtr>() % size);
     });
 
-    if (main_program_header.e_type == ET_DYN) {
+    if (main_program_plan.header().e_type == ET_DYN) {
         return random_load_offset_in_range(load_range_start, load_range_size);
     }
 
-    if (main_program_header.e_type != ET_EXEC)
+    if (main_program_plan.header().e_type != ET_EXEC)
         return EINVAL;
 
-    auto main_program_load_range = TRY(get_required_load_range(main_program_description));
+    auto main_program_load_range = TRY(get_required_load_range(main_program_plan));
 
     RequiredLoadRange selected_range {};
 
-    if (interpreter_description) {
-        auto interpreter_load_range = TRY(get_required_load_range(*interpreter_description));
+    if (interpreter_plan) {
+        auto interpreter_load_range = TRY(get_required_load_range(*interpreter_plan));
 
         auto interpreter_size_in_memory = interpreter_load_range.end - interpreter_load_range.start;
         auto interpreter_load_range_end = load_range_start + load_range_size - interpreter_size_in_memory;
@@ -262,7 +236,7 @@ enum class ShouldAllowSyscalls {
     Yes,
 };
 
-static ErrorOr<LoadResult> load_elf_object(Memory::AddressSpace& new_space, OpenFileDescription& object_description,
+static ErrorOr<LoadResult> load_elf_object(Memory::AddressSpace& new_space, OpenFileDescription& object_description, ExecutableLoadPlan const& plan,
     FlatPtr load_offset, ShouldAllowSyscalls should_allow_syscalls, Optional<size_t> minimum_stack_size = {})
 {
     auto& inode = *(object_description.inode());
@@ -273,15 +247,6 @@ static ErrorOr<LoadResult> load_elf_object(Memory::AddressSpace& new_space, Open
         return ETXTBSY;
     }
 
-    size_t executable_size = inode.size();
-    size_t rounded_executable_size = TRY(Memory::page_round_up(executable_size));
-
-    auto executable_region = TRY(MM.allocate_kernel_region_with_vmobject(*vmobject, rounded_executable_size, "ELF loading"sv, Memory::Region::Access::Read));
-    auto elf_image = ELF::Image(executable_region->vaddr().as_ptr(), executable_size);
-
-    if (!elf_image.is_valid())
-        return ENOEXEC;
-
     FlatPtr load_base_address = 0;
     size_t stack_size = Thread::default_userspace_stack_size;
 
@@ -293,24 +258,19 @@ static ErrorOr<LoadResult> load_elf_object(Memory::AddressSpace& new_space, Open
 
     Memory::MemoryManager::enter_address_space(new_space);
 
-    auto load_writable_section = [&](auto& program_header) -> ErrorOr<void> {
+    auto load_writable_section = [&](ExecutableLoadPlan::Segment const& segment) -> ErrorOr<void> {
         // Writable section: create a copy in memory.
-        VERIFY(program_header.alignment() % PAGE_SIZE == 0);
-
-        if (!elf_image.is_within_image(program_header.raw_data(), program_header.size_in_image())) {
-            dbgln("Shenanigans! Writable ELF PT_LOAD header sneaks outside of executable.");
-            return ENOEXEC;
-        }
+        VERIFY(segment.alignment % PAGE_SIZE == 0);
 
         int prot = 0;
-        if (program_header.is_readable())
+        if (segment.readable)
             prot |= PROT_READ;
-        if (program_header.is_writable())
+        if (segment.writable)
             prot |= PROT_WRITE;
-        auto region_name = TRY(KString::formatted("{} (data-{}{})", elf_name, program_header.is_readable() ? "r" : "", program_header.is_writable() ? "w" : ""));
+        auto region_name = TRY(KString::formatted("{} (data-{}{})", elf_name, segment.readable ? "r" : "", segment.writable ? "w" : ""));
 
-        auto range_base = VirtualAddress { Memory::page_round_down(program_header.vaddr().offset(load_offset).get()) };
-        size_t rounded_range_end = TRY(Memory::page_round_up(program_header.vaddr().offset(load_offset).offset(program_header.size_in_memory()).get()));
+        auto range_base = VirtualAddress { Memory::page_round_down(segment.vaddr + load_offset) };
+        size_t rounded_range_end = TRY(Memory::page_round_up(segment.vaddr + load_offset + segment.size_in_memory));
         auto range_end = VirtualAddress { rounded_range_end };
 
         auto region = TRY(new_space.allocate_region(Memory::RandomizeVirtualAddress::Yes, range_base, range_end.get() - range_base.get(), PAGE_SIZE, region_name->view(), prot, AllocationStrategy::Reserve));
@@ -322,62 +282,50 @@ static ErrorOr<LoadResult> load_elf_object(Memory::AddressSpace& new_space, Open
         // FIXME: There's an opportunity to munmap, or at least mprotect, the padding space between
         //     the .text and .data PT_LOAD sections of the executable.
         //     Accessing it would definitely be a bug.
-        auto page_offset = program_header.vaddr();
-        page_offset.mask(~PAGE_MASK);
-        TRY(copy_to_user((u8*)region->vaddr().as_ptr() + page_offset.get(), program_header.raw_data(), program_header.size_in_image()));
+        auto page_offset = segment.vaddr & ~PAGE_MASK;
+        auto buffer = TRY(UserOrKernelBuffer::for_user_buffer(region->vaddr().offset(page_offset).as_ptr(), segment.size_in_image));
+        auto nread = TRY(object_description.read(buffer, segment.offset, segment.size_in_image));
+        // The plan made sure the data is within the file, so it must have been truncated since.
+        if (nread < segment.size_in_image)
+            return ENOEXEC;
         return {};
     };
 
-    auto load_section = [&](auto& program_header) -> ErrorOr<void> {
-        if (program_header.size_in_memory() == 0)
+    auto load_section = [&](ExecutableLoadPlan::Segment const& segment) -> ErrorOr<void> {
+        if (segment.size_in_memory == 0)
             return {};
 
-        if (program_header.is_writable())
-            return load_writable_section(program_header);
+        if (segment.writable)
+            return load_writable_section(segment);
 
         // Non-writable section: map the executable itself in memory.
-        VERIFY(program_header.alignment() % PAGE_SIZE == 0);
+        VERIFY(segment.alignment % PAGE_SIZE == 0);
         int prot = 0;
-        if (program_header.is_readable())
+        if (segment.readable)
             prot |= PROT_READ;
-        if (program_header.is_writable())
-            prot |= PROT_WRITE;
-        if (program_header.is_executable())
+        if (segment.executable)
             prot |= PROT_EXEC;
 
-        auto range_base = VirtualAddress { Memory::page_round_down(program_header.vaddr().offset(load_offset).get()) };
-        size_t rounded_range_end = TRY(Memory::page_round_up(program_header.vaddr().offset(load_offset).offset(program_header.size_in_memory()).get()));
+        auto range_base = VirtualAddress { Memory::page_round_down(segment.vaddr + load_offset) };
+        size_t rounded_range_end = TRY(Memory::page_round_up(segment.vaddr + load_offset + segment.size_in_memory));
         auto range_end = VirtualAddress { rounded_range_end };
-        auto region = TRY(new_space.allocate_region_with_vmobject(Memory::RandomizeVirtualAddress::Yes, range_base, range_end.get() - range_base.get(), program_header.alignment(), *vmobject, program_header.offset(), elf_name->view(), prot, true));
-        if (program_header.is_executable())
+        auto region = TRY(new_space.allocate_region_with_vmobject(Memory::RandomizeVirtualAddress::Yes, range_base, range_end.get() - range_base.get(), segment.alignment, *vmobject, segment.offset, elf_name->view(), prot, true));
+        if (segment.executable)
             region->set_initially_loaded_executable_segment();
 
         if (should_allow_syscalls == ShouldAllowSyscalls::Yes)
             region->set_syscall_region(true);
-        if (program_header.offset() == 0)
+        if (segment.offset == 0)
             load_base_address = (FlatPtr)region->vaddr().as_ptr();
         return {};
     };
 
-    auto load_elf_program_header = [&](auto& program_header) -> ErrorOr<void> {
-        if (program_header.type() == PT_LOAD)
-            return load_section(program_header);
-
-        // NOTE: We ignore other program header types.
-        return {};
-    };
-
-    TRY([&] {
-        ErrorOr<void> result;
-        elf_image.for_each_program_header([&](ELF::Image::ProgramHeader const& program_header) {
-            result = load_elf_program_header(program_header);
-            return result.is_error() ? IterationDecision::Break : IterationDecision::Continue;
-        });
-        return result;
-    }());
+    for (auto const& segment : plan.segments())
+        TRY(load_section(segment));
 
-    if (!elf_image.entry().offset(load_offset).get()) {
-        dbgln("do_exec: Failure loading program, entry pointer is invalid! {})", elf_image.entry().offset(load_offset));
+    auto entry = static_cast<FlatPtr>(plan.header().e_entry) + load_offset;
+    if (!entry) {
+        dbgln("do_exec: Failure loading program, entry pointer is invalid! {})", VirtualAddress { entry });
         return ENOEXEC;
     }
 
@@ -386,22 +334,26 @@ static ErrorOr<LoadResult> load_elf_object(Memory::AddressSpace& new_space, Open
 
     return LoadResult {
         load_base_address,
-        elf_image.entry().offset(load_offset).get(),
-        executable_size,
+        entry,
+        plan.file_size(),
         TRY(stack_region->try_make_weak_ptr())
     };
 }
 
 ErrorOr<LoadResult>
-Process::load(Memory::AddressSpace& new_space, NonnullRefPtr<OpenFileDescription> main_program_description,
-    RefPtr<OpenFileDescription> interpreter_description, Elf_Ehdr const& main_program_header, Optional<size_t> minimum_stack_size)
+Process::load(Memory::AddressSpace& new_space, NonnullRefPtr<OpenFileDescription> main_program_description, ExecutableLoadPlan const& main_program_plan,
+    RefPtr<OpenFileDescription> interpreter_description, ExecutableLoadPlan const* interpreter_plan)
 {
-    auto load_offset = TRY(get_load_offset(main_program_header, main_program_description, interpreter_description));
+    auto load_offset = TRY(get_load_offset(main_program_plan, interpreter_plan));
+
+    Optional<size_t> minimum_stack_size = main_program_plan.requested_stack_size();
+    if (interpreter_plan && interpreter_plan->requested_stack_size().has_value() && (!minimum_stack_size.has_value() || *minimum_stack_size < *interpreter_plan->requested_stack_size()))
+        minimum_stack_size = interpreter_plan->requested_stack_size();
 
     if (interpreter_description.is_null())
-        return TRY(load_elf_object(new_space, main_program_description, load_offset, ShouldAllowSyscalls::No, minimum_stack_size));
+        return TRY(load_elf_object(new_space, main_program_description, main_program_plan, load_offset, ShouldAllowSyscalls::No, minimum_stack_size));
 
-    return TRY(load_elf_object(new_space, *interpreter_description, load_offset, ShouldAllowSyscalls::Yes, minimum_stack_size));
+    return TRY(load_elf_object(new_space, *interpreter_description, *interpreter_plan, load_offset, ShouldAllowSyscalls::Yes, minimum_stack_size));
 }
 
 void Process::clear_signal_handlers_for_exec()
@@ -424,7 +376,7 @@ void Process::clear_signal_handlers_for_exec()
 }
 
 ErrorOr<void> Process::do_exec(NonnullRefPtr<OpenFileDescription> main_program_description, Vector<NonnullOwnPtr<KString>> arguments, Vector<NonnullOwnPtr<KString>> environment,
-    RefPtr<OpenFileDescription> interpreter_description, Thread*& new_main_thread, InterruptsState& previous_interrupts_state, Elf_Ehdr const& main_program_header, Optional<size_t> minimum_stack_size)
+    RefPtr<OpenFileDescription> interpreter_description, Thread*& new_main_thread, InterruptsState& previous_interrupts_state, ExecutableLoadPlan const& main_program_plan, ExecutableLoadPlan const* interpreter_plan)
 {
     VERIFY(is_user_process());
     VERIFY(!Processor::in_critical());
@@ -460,7 +412,7 @@ ErrorOr<void> Process::do_exec(NonnullRefPtr<OpenFileDescription> main_program_d
         });
     });
 
-    auto load_result = TRY(load(new_space, main_program_description, interpreter_description, main_program_header, minimum_stack_size));
+    auto load_result = TRY(load(new_space, main_program_description, main_program_plan, interpreter_description, interpreter_plan));
 
     // NOTE: We don't need the interpreter executable description after this point.
     //       We destroy it here to prevent it from getting destroyed when we return from this function.
@@ -755,75 +707,16 @@ static ErrorOr<Vector<NonnullOwnPtr<KString>>> find_shebang_interpreter_for_exec
     return ENOEXEC;
 }
 
-static ErrorOr<FixedArray<u8>> read_elf_buffer_including_program_headers(OpenFileDescription& elf_file, Elf_Ehdr const& main_executable_header)
-{
-    auto program_header_offset = static_cast<size_t>(main_executable_header.e_phoff);
-    auto program_header_entry_size = static_cast<size_t>(main_executable_header.e_phentsize);
-    auto program_header_entries_count = static_cast<size_t>(main_executable_header.e_phnum);
-
-    if (Checked<size_t>::multiplication_would_overflow(program_header_entry_size, program_header_entries_count))
-        return EOVERFLOW;
-
-    if (Checked<size_t>::addition_would_overflow(program_header_offset, (program_header_entry_size * program_header_entries_count)))
-        return EOVERFLOW;
-
-    auto last_needed_byte_offset_on_program_header_list = program_header_offset + (program_header_entry_size * program_header_entries_count);
-    if (last_needed_byte_offset_on_program_header_list < sizeof(Elf_Ehdr))
-        return EINVAL;
-
-    auto elf_buffer = TRY(FixedArray<u8>::create(last_needed_byte_offset_on_program_header_list));
-    auto elf_read_buffer = UserOrKernelBuffer::for_kernel_buffer(elf_buffer.data());
-    {
-        auto nread = TRY(elf_file.read(elf_read_buffer, 0, elf_buffer.span().size()));
-        if (nread < elf_buffer.span().size())
-            return EIO;
-    }
-    return elf_buffer;
-}
-
-ErrorOr<RefPtr<OpenFileDescription>> Process::find_elf_interpreter_for_executable(OpenFileDescription& elf_file, StringView path, Elf_Ehdr const& main_executable_header, size_t file_size, Optional<size_t>& minimum_stack_size)
+ErrorOr<RefPtr<OpenFileDescription>> Process::find_elf_interpreter_for_executable(ExecutableLoadPlan const& main_program_plan, StringView path, RefPtr<ExecutableLoadPlan>& interpreter_plan)
 {
-    // We can't exec an ET_REL, as that's just an object file from the compiler,
-    // and we can't exec an ET_CORE as it's just a coredump.
-    // The only allowed ELF files on execve are executables or shared object files
-    // which are dynamically linked programs (or static-pie programs like the dynamic loader).
-    if (main_executable_header.e_type != ET_EXEC && main_executable_header.e_type != ET_DYN)
-        return ENOEXEC;
-
-    auto main_program_with_program_headers_buffer = TRY(read_elf_buffer_including_program_headers(elf_file, main_executable_header));
-
-    Optional<size_t> main_executable_requested_stack_size {};
-    Optional<Elf_Phdr> maybe_interpreter_path_program_header {};
-    if (!ELF::validate_program_headers(main_executable_header, file_size, main_program_with_program_headers_buffer.span(), maybe_interpreter_path_program_header, &main_executable_requested_stack_size)) {
-        dbgln("exec({}): File has invalid ELF Program headers", path);
-        return ENOEXEC;
-    }
-
-    if (main_executable_requested_stack_size.has_value() && (!minimum_stack_size.has_value() || *minimum_stack_size < *main_executable_requested_stack_size))
-        minimum_stack_size = main_executable_requested_stack_size;
-
     // The ELF file might not have any INTERP header, which in such
     // case we can't do anything and therefore we should just continue
     // without loading any interpreter.
-    if (!maybe_interpreter_path_program_header.has_value())
-        return nullptr;
-
-    auto interpreter_path_program_header = maybe_interpreter_path_program_header.release_value();
-
-    auto buffer = TRY(KBuffer::try_create_with_size("ELF interpreter program path"sv, static_cast<size_t>(interpreter_path_program_header.p_filesz) - 1));
-    auto buffer_as_kernel_buffer = buffer->as_kernel_buffer();
-    {
-        auto nread = TRY(elf_file.read(buffer_as_kernel_buffer, static_cast<size_t>(interpreter_path_program_header.p_offset), buffer->size()));
-        if (nread < buffer->size())
-            return EIO;
-    }
-
-    auto interpreter_path = StringView(buffer->bytes());
-    if (interpreter_path.is_empty()) {
-        dbgln("exec({}): WARNING: File has an INTERP program header, but the interpreter path is empty", path);
+    auto const* interpreter_path_string = main_program_plan.interpreter_path();
+    if (!interpreter_path_string)
         return nullptr;
-    }
 
+    auto interpreter_path = interpreter_path_string->view();
     dbgln_if(EXEC_DEBUG, "exec({}): Using program interpreter {}", path, interpreter_path);
     auto interpreter_description = TRY(VirtualFileSystem::open(vfs_root_context(), credentials(), interpreter_path, O_EXEC, 0, current_directory()));
     auto interp_metadata = interpreter_description->metadata();
@@ -838,38 +731,20 @@ ErrorOr<RefPtr<OpenFileDescription>> Process::find_elf_interpreter_for_executabl
     if (interp_metadata.size < static_cast<int>(sizeof(Elf_Ehdr)))
         return ENOEXEC;
 
-    static_assert(sizeof(Elf_Ehdr) < PAGE_SIZE);
-    auto elf_interpreter_buffer = Array<u8, sizeof(Elf_Ehdr)>::from_repeated_value(0);
-    auto elf_interpreter_read_buffer = UserOrKernelBuffer::for_kernel_buffer(elf_interpreter_buffer.data());
-    auto nread = TRY(interpreter_description->read(elf_interpreter_read_buffer, elf_interpreter_buffer.span().size()));
-    if (nread < sizeof(Elf_Ehdr))
-        return ENOEXEC;
-
-    auto const* interpreter_executable_header = bit_cast<Elf_Ehdr const*>(elf_interpreter_buffer.data());
-    if (!ELF::validate_elf_header(*interpreter_executable_header, interp_metadata.size)) {
-        dbgln("exec({}): Interpreter ({}) has invalid ELF header", path, interpreter_path);
-        return ENOEXEC;
-    }
-
-    auto elf_interpreter_with_program_headers_buffer = TRY(read_elf_buffer_including_program_headers(*interpreter_description, *interpreter_executable_header));
-
-    Optional<size_t> interpreter_requested_stack_size {};
-    Optional<Elf_Phdr> maybe_interpreter_interpreter_path_program_header {};
-    if (!ELF::validate_program_headers(*interpreter_executable_header, interp_metadata.size, elf_interpreter_with_program_headers_buffer.span(), maybe_interpreter_interpreter_path_program_header, &interpreter_requested_stack_size)) {
-        dbgln("exec({}): Interpreter ({}) has invalid ELF Program headers", path, interpreter_path);
-        return ENOEXEC;
+    auto plan_or_error = ExecutableLoadPlan::get_or_create(*interpreter_description);
+    if (plan_or_error.is_error()) {
+        dbgln("exec({}): Interpreter ({}) is not a valid ELF object", path, interpreter_path);
+        return plan_or_error.release_error();
     }
+    interpreter_plan = plan_or_error.release_value();
 
     // NOTE: This ELF file should not have any INTERP header, because it's already the
     // interpreter of the previously loaded ELF file!
-    if (maybe_interpreter_interpreter_path_program_header.has_value()) {
+    if (interpreter_plan->interpreter_path()) {
         dbgln("exec({}): Interpreter ({}) has its own interpreter! No thank you!", path, interpreter_path);
         return ELOOP;
     }
 
-    if (interpreter_requested_stack_size.has_value() && (!minimum_stack_size.has_value() || *minimum_stack_size < *interpreter_requested_stack_size))
-        minimum_stack_size = interpreter_requested_stack_size;
-
     return interpreter_description;
 }
 
@@ -899,41 +774,45 @@ ErrorOr<void> Process::exec(NonnullOwnPtr<KString> path, Vector<NonnullOwnPtr<KS
 
     VERIFY(description->inode());
 
-    // Read just the size of ELF header of the program into memory so we can start parsing it.
-    // The size of a ELF header should suffice to find the shebang sign (known as #! sign) if the file has it
-    // in the start.
-    auto preliminary_buffer = Array<u8, sizeof(Elf_Ehdr)>::from_repeated_value(0);
-    auto preliminary_read_buffer = UserOrKernelBuffer::for_kernel_buffer(preliminary_buffer.data());
-    auto nread = TRY(description->read(preliminary_read_buffer, 0, preliminary_buffer.span().size()));
-
-    // 1) #! interpreted file
-    if (is_executable_starting_with_shebang(preliminary_buffer)) {
-        // FIXME: PAGE_SIZE seems like enough for specifying an interpreter for now.
-        // We might need to re-evaluate this but to avoid further allocations, this is how it is for now.
-        auto shebang_line_buffer = Array<u8, PAGE_SIZE>::from_repeated_value(0);
-        auto shebang_line_read_buffer = UserOrKernelBuffer::for_kernel_buffer(shebang_line_buffer.data());
-        TRY(description->read(shebang_line_read_buffer, 0, shebang_line_buffer.span().size()));
-        auto shebang_words = TRY(find_shebang_interpreter_for_executable(shebang_line_buffer));
-        auto shebang_path = TRY(shebang_words.first()->try_clone());
-        arguments[0] = move(path);
-        TRY(arguments.try_prepend(move(shebang_words)));
-        return exec(move(shebang_path), move(arguments), move(environment), new_main_thread, previous_interrupts_state, ++recursion_depth);
+    // A cached load plan means that we already know that this is an ELF object, so we don't have to look at it again.
+    if (!description->inode()->executable_load_plan().plan) {
+        // Read just the size of ELF header of the program into memory so we can start parsing it.
+        // The size of a ELF header should suffice to find the shebang sign (known as #! sign) if the file has it
+        // in the start.
+        auto preliminary_buffer = Array<u8, sizeof(Elf_Ehdr)>::from_repeated_value(0);
+        auto preliminary_read_buffer = UserOrKernelBuffer::for_kernel_buffer(preliminary_buffer.data());
+        auto nread = TRY(description->read(preliminary_read_buffer, 0, preliminary_buffer.span().size()));
+
+        // 1) #! interpreted file
+        if (is_executable_starting_with_shebang(preliminary_buffer)) {
+            // FIXME: PAGE_SIZE seems like enough for specifying an interpreter for now.
+            // We might need to re-evaluate this but to avoid further allocations, this is how it is for now.
+            auto shebang_line_buffer = Array<u8, PAGE_SIZE>::from_repeated_value(0);
+            auto shebang_line_read_buffer = UserOrKernelBuffer::for_kernel_buffer(shebang_line_buffer.data());
+            TRY(description->read(shebang_line_read_buffer, 0, shebang_line_buffer.span().size()));
+            auto shebang_words = TRY(find_shebang_interpreter_for_executable(shebang_line_buffer));
+            auto shebang_path = TRY(shebang_words.first()->try_clone());
+            arguments[0] = move(path);
+            TRY(arguments.try_prepend(move(shebang_words)));
+            return exec(move(shebang_path), move(arguments), move(environment), new_main_thread, previous_interrupts_state, ++recursion_depth);
+        }
+
+        if (nread < sizeof(Elf_Ehdr))
+            return ENOEXEC;
     }
 
     // #2) ELF32 for i386
 
-    if (nread < sizeof(Elf_Ehdr))
-        return ENOEXEC;
-    auto const* main_program_header = bit_cast<Elf_Ehdr const*>(preliminary_buffer.data());
-
-    if (!ELF::validate_elf_header(*main_program_header, metadata.size)) {
-        dbgln("exec({}): File has invalid ELF header", path);
-        return ENOEXEC;
+    auto main_program_plan_or_error = ExecutableLoadPlan::get_or_create(*description);
+    if (main_program_plan_or_error.is_error()) {
+        dbgln("exec({}): File is not a valid ELF object", path);
+        return main_program_plan_or_error.release_error();
     }
+    auto main_program_plan = main_program_plan_or_error.release_value();
 
-    Optional<size_t> minimum_stack_size {};
-    auto interpreter_description = TRY(find_elf_interpreter_for_executable(*description, path->view(), *main_program_header, metadata.size, minimum_stack_size));
-    TRY(do_exec(move(description), move(arguments), move(environment), move(interpreter_description), new_main_thread, previous_interrupts_state, *main_program_header, minimum_stack_size));
+    RefPtr<ExecutableLoadPlan> interpreter_plan;
+    auto interpreter_description = TRY(find_elf_interpreter_for_executable(*main_program_plan, path->view(), interpreter_plan));
+    TRY(do_exec(move(description), move(arguments), move(environment), move(interpreter_description), new_main_thread, previous_interrupts_state, *main_program_plan, interpreter_plan.ptr()));
 
     VERIFY_INTERRUPTS_DISABLED();
     VERIFY(Processor::in_critical() == 1);
@@ -42,6 +42,14 @@ ErrorOr<FlatPtr> Process::sys$fcntl(int fd, int cmd, uintptr_t arg)
         break;
     case F_ISTTY:
         return description->is_tty();
+    case F_GETPIPE_SZ:
+        if (!description->is_fifo())
+            return EBADF;
+        return description->fifo()->buffer_capacity();
+    case F_SETPIPE_SZ:
+        if (!description->is_fifo())
+            return EBADF;
+        return TRY(description->fifo()->set_buffer_capacity(arg));
     case F_GETLK:
         TRY(description->get_flock(Userspace<flock*>(arg)));
         return 0;
@@ -128,14 +128,28 @@ ErrorOr<FlatPtr> Process::sys$fork(RegisterState& regs)
 
     Processor::store_fpu_state(child_first_thread->fpu_state());
 
+    // The child gets its own process page, mapped where the parent has its one.
+    auto parent_process_page_vmobject = process_page_vmobject_if_allocated();
+    LockRefPtr<Memory::VMObject> child_process_page_vmobject;
+    if (parent_process_page_vmobject)
+        child_process_page_vmobject = TRY(child->process_page_vmobject());
+
     TRY(address_space().with([&](auto& parent_space) {
         return child->address_space().with([&](auto& child_space) -> ErrorOr<void> {
             if (parent_space->enforces_syscall_regions())
                 child_space->set_enforces_syscall_regions();
             for (auto& region : parent_space->region_tree().regions()) {
+                if (parent_process_page_vmobject && &region.vmobject() == parent_process_page_vmobject.ptr()) {
+                    TRY(child_space->allocate_region_with_vmobject(region.range(), *child_process_page_vmobject, 0, region.name(), PROT_READ, true));
+                    continue;
+                }
                 dbgln_if(FORK_DEBUG, "fork: cloning Region '{}' @ {}", region.name(), region.vaddr());
                 auto region_clone = TRY(region.try_clone());
-                TRY(region_clone->map(child_space->page_directory(), Memory::ShouldFlushTLB::No));
+                // Most children exec or exit soon after fork, so don't copy page table entries they will never use.
+                if (region_clone->can_be_mapped_lazily())
+                    region_clone->map_lazily(child_space->page_directory());
+                else
+                    TRY(region_clone->map(child_space->page_directory(), Memory::ShouldFlushTLB::No));
                 TRY(child_space->region_tree().place_specifically(*region_clone, region.range()));
                 (void)region_clone.leak_ptr();
             }
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/Singleton.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Memory/InodeVMObject.h>
@@ -13,23 +14,34 @@
 
 namespace Kernel {
 
-static Singleton<RecursiveSpinlockProtected<HashMap<GlobalFutexKey, NonnullLockRefPtr<FutexQueue>>, LockRank::None>> s_global_futex_queues;
+// The futex queues are spread over a fixed number of buckets, each with its own lock,
+// so that threads waking or waiting on unrelated futexes don't contend with each other.
+static constexpr size_t futex_queue_bucket_count = 64;
+using FutexQueueBucket = RecursiveSpinlockProtected<HashMap<GlobalFutexKey, NonnullLockRefPtr<FutexQueue>>, LockRank::None>;
+static Singleton<Array<FutexQueueBucket, futex_queue_bucket_count>> s_global_futex_queues;
+
+static FutexQueueBucket& futex_queue_bucket_for(GlobalFutexKey const& futex_key)
+{
+    return s_global_futex_queues->at(Traits<GlobalFutexKey>::hash(futex_key) % futex_queue_bucket_count);
+}
 
 void Process::clear_futex_queues_on_exec()
 {
-    s_global_futex_queues->with([this](auto& queues) {
-        auto const* address_space = this->address_space().with([](auto& space) { return space.ptr(); });
-        queues.remove_all_matching([address_space](auto& futex_key, auto& futex_queue) {
-            if ((futex_key.raw.offset & futex_key_private_flag) == 0)
-                return false;
-            if (futex_key.private_.address_space != address_space)
-                return false;
-            bool did_wake_all;
-            futex_queue->wake_all(did_wake_all);
-            VERIFY(did_wake_all); // No one should be left behind...
-            return true;
+    auto const* address_space = this->address_space().with([](auto& space) { return space.ptr(); });
+    for (auto& bucket : *s_global_futex_queues) {
+        bucket.with([address_space](auto& queues) {
+            queues.remove_all_matching([address_space](auto& futex_key, auto& futex_queue) {
+                if ((futex_key.raw.offset & futex_key_private_flag) == 0)
+                    return false;
+                if (futex_key.private_.address_space != address_space)
+                    return false;
+                bool did_wake_all;
+                futex_queue->wake_all(did_wake_all);
+                VERIFY(did_wake_all); // No one should be left behind...
+                return true;
+            });
         });
-    });
+    }
 }
 
 ErrorOr<GlobalFutexKey> Process::get_futex_key(FlatPtr user_address, bool shared)
@@ -90,7 +102,7 @@ ErrorOr<GlobalFutexKey> Process::get_futex_key(FlatPtr user_address, bool shared
 
 ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> user_params)
 {
-    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
     auto params = TRY(copy_typed_from_user(user_params));
 
     Thread::BlockTimeout timeout;
@@ -106,12 +118,12 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
     switch (cmd) {
     case FUTEX_WAIT:
     case FUTEX_WAIT_BITSET:
-    case FUTEX_REQUEUE:
-    case FUTEX_CMP_REQUEUE: {
+    case FUTEX_LOCK_PI: {
         if (params.timeout) {
             auto timeout_time = TRY(copy_time_from_user(params.timeout));
             bool is_absolute = cmd != FUTEX_WAIT;
-            clockid_t clock_id = use_realtime_clock ? CLOCK_REALTIME_COARSE : CLOCK_MONOTONIC_COARSE;
+            // FUTEX_LOCK_PI timeouts are always measured against the realtime clock.
+            clockid_t clock_id = (use_realtime_clock || cmd == FUTEX_LOCK_PI) ? CLOCK_REALTIME_COARSE : CLOCK_MONOTONIC_COARSE;
             timeout = Thread::BlockTimeout(is_absolute, &timeout_time, nullptr, clock_id);
         }
         if (cmd == FUTEX_WAIT_BITSET && params.val3 == FUTEX_BITSET_MATCH_ANY)
@@ -124,16 +136,16 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
     }
     }
 
-    auto find_futex_queue = [&](GlobalFutexKey futex_key, bool create_if_not_found, bool* did_create = nullptr) -> ErrorOr<LockRefPtr<FutexQueue>> {
+    auto find_futex_queue = [&](GlobalFutexKey futex_key, bool create_if_not_found, bool* did_create = nullptr, FutexQueue::CreatedForWait created_for_wait = FutexQueue::CreatedForWait::Yes) -> ErrorOr<LockRefPtr<FutexQueue>> {
         VERIFY(!create_if_not_found || did_create != nullptr);
-        return s_global_futex_queues->with([&](auto& queues) -> ErrorOr<LockRefPtr<FutexQueue>> {
+        return futex_queue_bucket_for(futex_key).with([&](auto& queues) -> ErrorOr<LockRefPtr<FutexQueue>> {
             auto it = queues.find(futex_key);
             if (it != queues.end())
                 return it->value;
             if (!create_if_not_found)
                 return nullptr;
             *did_create = true;
-            auto futex_queue = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) FutexQueue));
+            auto futex_queue = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) FutexQueue(created_for_wait)));
             auto result = TRY(queues.try_set(futex_key, futex_queue));
             VERIFY(result == AK::HashSetResult::InsertedNewEntry);
             return futex_queue;
@@ -141,7 +153,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
     };
 
     auto remove_futex_queue = [&](GlobalFutexKey futex_key) {
-        return s_global_futex_queues->with([&](auto& queues) {
+        return futex_queue_bucket_for(futex_key).with([&](auto& queues) {
             auto it = queues.find(futex_key);
             if (it == queues.end())
                 return;
@@ -169,7 +181,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
     auto user_address = FlatPtr(params.userspace_address);
     auto user_address2 = FlatPtr(params.userspace_address2);
 
-    auto do_wait = [&](u32 bitset) -> ErrorOr<FlatPtr> {
+    auto do_wait = [&](u32 expected_value, u32 bitset, Thread* priority_inheriting_owner = nullptr) -> ErrorOr<FlatPtr> {
         bool did_create;
         LockRefPtr<FutexQueue> futex_queue;
         auto futex_key = TRY(get_futex_key(user_address, shared));
@@ -177,8 +189,8 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
             auto user_value = user_atomic_load_relaxed(params.userspace_address);
             if (!user_value.has_value())
                 return EFAULT;
-            if (user_value.value() != params.val) {
-                dbgln_if(FUTEX_DEBUG, "futex wait: EAGAIN. user value: {:p} @ {:p} != val: {}", user_value.value(), params.userspace_address, params.val);
+            if (user_value.value() != expected_value) {
+                dbgln_if(FUTEX_DEBUG, "futex wait: EAGAIN. user value: {:p} @ {:p} != val: {}", user_value.value(), params.userspace_address, expected_value);
                 return EAGAIN;
             }
             atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
@@ -193,8 +205,14 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
         // We must not hold the lock before blocking. But we have a reference
         // to the FutexQueue so that we can keep it alive.
 
+        if (priority_inheriting_owner)
+            futex_queue->add_priority_inheriting_waiter(*Thread::current(), *priority_inheriting_owner);
+
         Thread::BlockResult block_result = futex_queue->wait_on(timeout, bitset);
 
+        if (priority_inheriting_owner)
+            futex_queue->remove_priority_inheriting_waiter(*Thread::current());
+
         if (futex_queue->is_empty_and_no_imminent_waits()) {
             // If there are no more waiters, we want to get rid of the futex!
             remove_futex_queue(futex_key);
@@ -202,6 +220,89 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
         if (block_result == Thread::BlockResult::InterruptedByTimeout) {
             return ETIMEDOUT;
         }
+        if (priority_inheriting_owner && block_result.was_interrupted())
+            return EINTR;
+        return 0;
+    };
+
+    auto do_lock_pi = [&](bool try_only) -> ErrorOr<FlatPtr> {
+        auto* current_thread = Thread::current();
+        auto tid = static_cast<u32>(current_thread->tid().value());
+        auto futex_key = TRY(get_futex_key(user_address, shared));
+        for (;;) {
+            auto user_value = user_atomic_load_relaxed(params.userspace_address);
+            if (!user_value.has_value())
+                return EFAULT;
+            u32 value = user_value.value();
+            u32 owner_tid = value & FUTEX_TID_MASK;
+
+            if (owner_tid == 0) {
+                // We don't know whether anyone else is still waiting, so always leave FUTEX_WAITERS set
+                // when taking the futex here. At worst, this costs the new owner a FUTEX_UNLOCK_PI call.
+                auto did_exchange = user_atomic_compare_exchange_relaxed(params.userspace_address, value, tid | FUTEX_WAITERS);
+                if (!did_exchange.has_value())
+                    return EFAULT;
+                if (!did_exchange.value())
+                    continue;
+                atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+                // The threads still waiting now lend their priority to us.
+                if (auto futex_queue = TRY(find_futex_queue(futex_key, false)))
+                    futex_queue->set_priority_inheriting_owner(current_thread);
+                return 0;
+            }
+            if (owner_tid == tid)
+                return EDEADLK;
+            if (try_only)
+                return EAGAIN;
+
+            if (!(value & FUTEX_WAITERS)) {
+                // Make sure the owner comes to the kernel to wake us up when it unlocks the futex.
+                auto did_exchange = user_atomic_compare_exchange_relaxed(params.userspace_address, value, value | FUTEX_WAITERS);
+                if (!did_exchange.has_value())
+                    return EFAULT;
+                if (!did_exchange.value())
+                    continue;
+                value |= FUTEX_WAITERS;
+            }
+
+            auto owner = shared ? Thread::from_tid_ignoring_process_lists(owner_tid) : Thread::from_tid_in_same_process_list(owner_tid);
+            if (!owner)
+                return ESRCH;
+
+            // If the futex changed hands in the meantime, this returns EAGAIN and we try again.
+            auto result = do_wait(value, FUTEX_BITSET_MATCH_ANY, owner.ptr());
+            if (result.is_error() && result.error().code() != EAGAIN)
+                return result.release_error();
+        }
+    };
+
+    auto do_unlock_pi = [&]() -> ErrorOr<FlatPtr> {
+        auto* current_thread = Thread::current();
+        auto tid = static_cast<u32>(current_thread->tid().value());
+        auto futex_key = TRY(get_futex_key(user_address, shared));
+        auto futex_queue = TRY(find_futex_queue(futex_key, false));
+        for (;;) {
+            auto user_value = user_atomic_load_relaxed(params.userspace_address);
+            if (!user_value.has_value())
+                return EFAULT;
+            u32 value = user_value.value();
+            if ((value & FUTEX_TID_MASK) != tid)
+                return EPERM;
+
+            // Keep FUTEX_WAITERS set while there are still waiters, so that whoever takes the futex
+            // next from userspace will come back to the kernel to wake them up.
+            bool has_waiters = futex_queue && !futex_queue->is_empty_and_no_imminent_waits();
+            atomic_thread_fence(AK::MemoryOrder::memory_order_release);
+            auto did_exchange = user_atomic_compare_exchange_relaxed(params.userspace_address, value, has_waiters ? FUTEX_WAITERS : 0);
+            if (!did_exchange.has_value())
+                return EFAULT;
+            if (did_exchange.value())
+                break;
+        }
+
+        if (futex_queue)
+            futex_queue->set_priority_inheriting_owner(nullptr);
+        TRY(do_wake(user_address, 1, {}));
         return 0;
     };
 
@@ -227,7 +328,9 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
                 // NOTE: futex_queue's lock is being held while this callback is called
                 // The reason we're doing this in a callback is that we don't want to always
                 // create a target queue, only if we actually have anything to move to it!
-                target_futex_queue = TRY(find_futex_queue(futex_key2, true));
+                // A target queue created here has no imminent waits, as the blockers are moved over directly.
+                bool did_create_target = false;
+                target_futex_queue = TRY(find_futex_queue(futex_key2, true, &did_create_target, FutexQueue::CreatedForWait::No));
                 return target_futex_queue.ptr();
             },
             params.val2, is_empty, is_target_empty));
@@ -240,7 +343,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
 
     switch (cmd) {
     case FUTEX_WAIT:
-        return do_wait(0);
+        return do_wait(params.val, 0);
 
     case FUTEX_WAKE:
         return TRY(do_wake(user_address, params.val, {}));
@@ -251,7 +354,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
         auto op = _FUTEX_OP(params.val3);
         if (op & FUTEX_OP_ARG_SHIFT) {
             op_arg = 1 << op_arg;
-            op &= FUTEX_OP_ARG_SHIFT;
+            op &= ~FUTEX_OP_ARG_SHIFT;
         }
         atomic_thread_fence(AK::MemoryOrder::memory_order_release);
         switch (op) {
@@ -307,6 +410,15 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
         return result;
     }
 
+    case FUTEX_LOCK_PI:
+        return do_lock_pi(false);
+
+    case FUTEX_TRYLOCK_PI:
+        return do_lock_pi(true);
+
+    case FUTEX_UNLOCK_PI:
+        return do_unlock_pi();
+
     case FUTEX_REQUEUE:
         return do_requeue({});
 
@@ -317,7 +429,7 @@ ErrorOr<FlatPtr> Process::sys$futex(Userspace<Syscall::SC_futex_params const*> u
         VERIFY(params.val3 != FUTEX_BITSET_MATCH_ANY); // we should have turned it into FUTEX_WAIT
         if (params.val3 == 0)
             return EINVAL;
-        return do_wait(params.val3);
+        return do_wait(params.val, params.val3);
 
     case FUTEX_WAKE_BITSET:
         VERIFY(params.val3 != FUTEX_BITSET_MATCH_ANY); // we should have turned it into FUTEX_WAKE
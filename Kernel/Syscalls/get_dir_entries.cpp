@@ -21,4 +21,16 @@ ErrorOr<FlatPtr> Process::sys$get_dir_entries(int fd, Userspace<void*> user_buff
     return count;
 }
 
+ErrorOr<FlatPtr> Process::sys$get_dir_entries_with_stat(int fd, Userspace<void*> user_buffer, size_t user_size)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::rpath));
+    if (user_size > NumericLimits<ssize_t>::max())
+        return EINVAL;
+    auto description = TRY(open_file_description(fd));
+    auto buffer = TRY(UserOrKernelBuffer::for_user_buffer(user_buffer, static_cast<size_t>(user_size)));
+    auto count = TRY(description->get_dir_entries_with_stat(vfs_root_context(), credentials(), buffer, user_size));
+    return count;
+}
+
 }
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/IORing.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+ErrorOr<FlatPtr> Process::sys$io_ring_create(u32 entries, int options)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (options & ~O_CLOEXEC)
+        return EINVAL;
+
+    auto ring = TRY(IORing::try_create(entries));
+    auto description = TRY(OpenFileDescription::try_create(move(ring)));
+    description->set_readable(true);
+
+    u32 fd_flags = 0;
+    if (options & O_CLOEXEC)
+        fd_flags |= FD_CLOEXEC;
+
+    return m_fds.with_exclusive([&](auto& fds) -> ErrorOr<FlatPtr> {
+        auto new_fd = TRY(fds.allocate());
+        fds[new_fd.fd].set(description, fd_flags);
+        return new_fd.fd;
+    });
+}
+
+ErrorOr<FlatPtr> Process::sys$io_ring_enter(int fd, u32 to_submit, u32 min_complete)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto description = TRY(open_file_description(fd));
+    if (!description->file().is_io_ring())
+        return EBADF;
+    auto& ring = static_cast<IORing&>(description->file());
+
+    size_t submitted = 0;
+    if (to_submit > 0)
+        submitted = TRY(ring.submit(*this, to_submit));
+
+    // Being interrupted while waiting doesn't undo the submissions, so those still have to be reported.
+    if (auto result = ring.wait_for_completions(min_complete); result.is_error() && submitted == 0)
+        return result.release_error();
+    return submitted;
+}
+
+}
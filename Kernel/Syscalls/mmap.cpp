@@ -120,6 +120,7 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
     bool map_noreserve = flags & MAP_NORESERVE;
     bool map_randomized = flags & MAP_RANDOMIZED;
     bool map_fixed_noreplace = flags & MAP_FIXED_NOREPLACE;
+    bool map_huge = flags & MAP_HUGE;
 
     if (map_shared && map_private)
         return EINVAL;
@@ -141,6 +142,10 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
         requested_range = { {}, rounded_size };
     }
 
+    // Huge pages only get used for blocks that are aligned to the huge page size, so try to give the kernel as many of them as possible.
+    if (map_huge && map_anonymous && rounded_size >= Memory::HUGE_PAGE_SIZE && alignment < Memory::HUGE_PAGE_SIZE)
+        alignment = Memory::HUGE_PAGE_SIZE;
+
     Memory::Region* region = nullptr;
 
     RefPtr<OpenFileDescription> description;
@@ -209,6 +214,8 @@ ErrorOr<FlatPtr> Process::sys$mmap(Userspace<Syscall::SC_mmap_params const*> use
             region->set_shared(true);
         if (map_stack)
             region->set_stack(true);
+        if (map_huge && map_anonymous && !map_shared)
+            region->set_wants_huge_pages(true);
         if (name)
             region->set_name(move(name));
 
@@ -369,7 +376,11 @@ ErrorOr<FlatPtr> Process::sys$madvise(Userspace<void*> address, size_t size, int
     if (!is_user_range(range_to_madvise))
         return EFAULT;
 
-    return address_space().with([&](auto& space) -> ErrorOr<FlatPtr> {
+    LockRefPtr<Memory::InodeVMObject> vmobject_to_read_ahead;
+    size_t first_page_index_to_read_ahead = 0;
+    size_t page_count_to_read_ahead = 0;
+
+    auto result = TRY(address_space().with([&](auto& space) -> ErrorOr<FlatPtr> {
         auto* region = space->find_region_from_range(range_to_madvise);
         if (!region)
             return EINVAL;
@@ -387,8 +398,31 @@ ErrorOr<FlatPtr> Process::sys$madvise(Userspace<void*> address, size_t size, int
             TRY(vmobject.set_volatile(advice == MADV_SET_VOLATILE, was_purged));
             return was_purged ? 1 : 0;
         }
+        if (advice == MADV_NORMAL || advice == MADV_SEQUENTIAL || advice == MADV_RANDOM) {
+            if (advice == MADV_SEQUENTIAL)
+                region->set_access_pattern(Memory::Region::AccessPattern::Sequential);
+            else if (advice == MADV_RANDOM)
+                region->set_access_pattern(Memory::Region::AccessPattern::Random);
+            else
+                region->set_access_pattern(Memory::Region::AccessPattern::Normal);
+            return 0;
+        }
+        if (advice == MADV_WILLNEED) {
+            if (!region->vmobject().is_inode())
+                return 0;
+            // NOTE: Reading from the inode can block, so we have to do it outside of the address space lock.
+            //       Holding a reference to the VMObject keeps it alive even if the region gets unmapped meanwhile.
+            vmobject_to_read_ahead = static_cast<Memory::InodeVMObject&>(region->vmobject());
+            first_page_index_to_read_ahead = region->first_page_index();
+            page_count_to_read_ahead = region->page_count();
+            return 0;
+        }
         return EINVAL;
-    });
+    }));
+
+    if (vmobject_to_read_ahead)
+        TRY(vmobject_to_read_ahead->read_ahead(first_page_index_to_read_ahead, page_count_to_read_ahead));
+    return result;
 }
 
 ErrorOr<FlatPtr> Process::sys$set_mmap_name(Userspace<Syscall::SC_set_mmap_name_params const*> user_params)
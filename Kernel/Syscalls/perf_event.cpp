@@ -12,6 +12,10 @@ namespace Kernel {
 ErrorOr<FlatPtr> Process::sys$perf_event(int type, FlatPtr arg1, FlatPtr arg2)
 {
     VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    // Hardware samples are only recorded by the kernel, when a performance counter overflows,
+    // and tracepoint events only by the tracepoints in the kernel.
+    if (type & (PERF_EVENT_MASK_HARDWARE_SAMPLES | PERF_EVENT_TRACEPOINT))
+        return EINVAL;
     auto* events_buffer = current_perf_events_buffer();
     if (!events_buffer)
         return 0;
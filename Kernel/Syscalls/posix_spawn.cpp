@@ -10,6 +10,7 @@
 #include <Kernel/Devices/Generic/NullDevice.h>
 #include <Kernel/Devices/TTY/TTY.h>
 #include <Kernel/FileSystem/Custody.h>
+#include <Kernel/FileSystem/VirtualFileSystem.h>
 #include <Kernel/Memory/Region.h>
 #include <Kernel/Tasks/PerformanceManager.h>
 #include <Kernel/Tasks/Process.h>
@@ -18,6 +19,80 @@
 
 namespace Kernel {
 
+// Applies a file action to the child the same way as the corresponding syscall would, if the child made it before calling execve().
+ErrorOr<void> Process::apply_posix_spawn_file_action(Process& child, Syscall::SC_posix_spawn_file_action const& action)
+{
+    switch (action.type) {
+    case Syscall::PosixSpawnFileActionType::Open: {
+        if (action.options & (O_NOFOLLOW_NOERROR | O_UNLINK_INTERNAL))
+            return EINVAL;
+        if (action.fd < 0 || static_cast<size_t>(action.fd) >= OpenFileDescriptions::max_open())
+            return EBADF;
+
+        if (action.options & O_WRONLY)
+            TRY(require_promise(Pledge::wpath));
+        else if (action.options & O_RDONLY)
+            TRY(require_promise(Pledge::rpath));
+        if (action.options & O_CREAT)
+            TRY(require_promise(Pledge::cpath));
+
+        auto path = TRY(get_syscall_path_argument(action.path));
+        auto description = TRY(VirtualFileSystem::open(vfs_root_context(), credentials(), path->view(), action.options, (action.mode & 0777) & ~child.umask(), child.current_directory()));
+        if (description->inode() && description->inode()->bound_socket())
+            return ENXIO;
+
+        child.m_fds.with_exclusive([&](auto& fds) {
+            if (!fds.m_fds_metadatas[action.fd].is_allocated())
+                fds.m_fds_metadatas[action.fd].allocate();
+            fds[action.fd].set(move(description), (action.options & O_CLOEXEC) ? FD_CLOEXEC : 0);
+        });
+        return {};
+    }
+    case Syscall::PosixSpawnFileActionType::Close: {
+        auto description = TRY(child.open_file_description(action.fd));
+        auto result = description->close();
+        child.m_fds.with_exclusive([&](auto& fds) { fds[action.fd] = {}; });
+        return result;
+    }
+    case Syscall::PosixSpawnFileActionType::Dup2:
+        return child.m_fds.with_exclusive([&](auto& fds) -> ErrorOr<void> {
+            auto description = TRY(fds.open_file_description(action.fd));
+            if (action.fd == action.new_fd) {
+                // "If fildes and newfildes are equal, then the FD_CLOEXEC flag for newfildes shall be cleared."
+                fds[action.new_fd].set_flags(fds[action.new_fd].flags() & ~FD_CLOEXEC);
+                return {};
+            }
+            if (action.new_fd < 0 || static_cast<size_t>(action.new_fd) >= OpenFileDescriptions::max_open())
+                return EBADF;
+            if (!fds.m_fds_metadatas[action.new_fd].is_allocated())
+                fds.m_fds_metadatas[action.new_fd].allocate();
+            fds[action.new_fd].set(move(description));
+            return {};
+        });
+    case Syscall::PosixSpawnFileActionType::Chdir: {
+        TRY(require_promise(Pledge::rpath));
+        auto path = TRY(get_syscall_path_argument(action.path));
+        RefPtr<Custody> new_directory = TRY(VirtualFileSystem::open_directory(vfs_root_context(), credentials(), path->view(), child.current_directory()));
+        child.m_current_directory.with([&](auto& current_directory) {
+            swap(current_directory, new_directory);
+        });
+        return {};
+    }
+    case Syscall::PosixSpawnFileActionType::Fchdir: {
+        auto description = TRY(child.open_file_description(action.fd));
+        if (!description->is_directory())
+            return ENOTDIR;
+        if (!description->metadata().may_execute(credentials()))
+            return EACCES;
+        child.m_current_directory.with([&](auto& current_directory) {
+            current_directory = description->custody();
+        });
+        return {};
+    }
+    }
+    return EINVAL;
+}
+
 // https://pubs.opengroup.org/onlinepubs/9799919799/functions/posix_spawn.html
 ErrorOr<FlatPtr> Process::sys$posix_spawn(Userspace<Syscall::SC_posix_spawn_params const*> user_params)
 {
@@ -32,11 +107,22 @@ ErrorOr<FlatPtr> Process::sys$posix_spawn(Userspace<Syscall::SC_posix_spawn_para
     if (params.arguments.length == 0)
         return EINVAL;
 
-    if (params.attr_data.ptr() != 0 || params.attr_data_size != 0 || params.serialized_file_actions_data.ptr() != 0 || params.serialized_file_actions_data_size != 0) {
-        // FIXME: Implement spawn attributes and spawn file actions handling.
+    if (params.attr_data.ptr() != 0 || params.attr_data_size != 0) {
+        // FIXME: Implement spawn attributes handling.
         return ENOTSUP;
     }
 
+    Vector<Syscall::SC_posix_spawn_file_action> file_actions;
+    if (params.serialized_file_actions_data_size != 0) {
+        if (params.serialized_file_actions_data_size % sizeof(Syscall::SC_posix_spawn_file_action) != 0)
+            return EINVAL;
+        auto file_action_count = params.serialized_file_actions_data_size / sizeof(Syscall::SC_posix_spawn_file_action);
+        if (file_action_count > OpenFileDescriptions::max_open())
+            return EINVAL;
+        TRY(file_actions.try_resize(file_action_count));
+        TRY(copy_from_user(file_actions.data(), static_ptr_cast<Syscall::SC_posix_spawn_file_action const*>(params.serialized_file_actions_data), params.serialized_file_actions_data_size));
+    }
+
     auto path = TRY(get_syscall_path_argument(params.path));
 
     auto copy_user_strings = [](auto const& list, auto& output) -> ErrorOr<void> {
@@ -95,6 +181,10 @@ ErrorOr<FlatPtr> Process::sys$posix_spawn(Userspace<Syscall::SC_posix_spawn_para
         });
     });
 
+    // The file actions run after the child got its umask, as they have to behave as if the child called open() itself.
+    for (auto const& file_action : file_actions)
+        TRY(apply_posix_spawn_file_action(*child, file_action));
+
     dbgln_if(FORK_DEBUG, "posix_spawn: child={}", child);
 
     // A child created via posix_spawn inherits a copy of its parent's signal mask
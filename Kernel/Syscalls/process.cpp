@@ -16,6 +16,19 @@ ErrorOr<FlatPtr> Process::sys$getpid()
     return pid().value();
 }
 
+ErrorOr<FlatPtr> Process::sys$map_process_page()
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    auto vmobject = TRY(process_page_vmobject());
+
+    return address_space().with([&](auto& space) -> ErrorOr<FlatPtr> {
+        auto* region = TRY(space->allocate_region_with_vmobject(Memory::RandomizeVirtualAddress::Yes, {}, PAGE_SIZE, PAGE_SIZE, move(vmobject), 0, "Process page"sv, PROT_READ, true));
+        return region->vaddr().get();
+    });
+}
+
 ErrorOr<FlatPtr> Process::sys$getppid()
 {
     VERIFY_NO_PROCESS_BIG_LOCK(this);
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <Kernel/Arch/PerformanceCounters.h>
 #include <Kernel/Tasks/Coredump.h>
 #include <Kernel/Tasks/PerformanceManager.h>
 #include <Kernel/Tasks/Process.h>
@@ -15,6 +16,7 @@ namespace Kernel {
 bool g_profiling_all_threads;
 PerformanceEventBuffer* g_global_perf_events;
 u64 g_profiling_event_mask;
+static u64 s_profiling_all_threads_hardware_events;
 
 ErrorOr<FlatPtr> Process::sys$profiling_enable(pid_t pid, u64 event_mask)
 {
@@ -49,6 +51,8 @@ ErrorOr<FlatPtr> Process::profiling_enable(pid_t pid, u64 event_mask)
         if (!TimeManagement::the().enable_profile_timer())
             return ENOTSUP;
         g_profiling_all_threads = true;
+        PerformanceCounters::disable_sampling(s_profiling_all_threads_hardware_events);
+        s_profiling_all_threads_hardware_events = PerformanceCounters::enable_sampling(event_mask);
         PerformanceManager::add_process_created_event(*Scheduler::colonel());
         TRY(Process::for_each_in_same_process_list([](auto& process) -> ErrorOr<void> {
             PerformanceManager::add_process_created_event(process);
@@ -79,6 +83,8 @@ ErrorOr<FlatPtr> Process::profiling_enable(pid_t pid, u64 event_mask)
         process->set_profiling(false);
         return ENOTSUP;
     }
+    PerformanceCounters::disable_sampling(process->profiling_hardware_events());
+    process->set_profiling_hardware_events(PerformanceCounters::enable_sampling(event_mask));
     return 0;
 }
 
@@ -95,6 +101,7 @@ ErrorOr<FlatPtr> Process::sys$profiling_disable(pid_t pid)
         if (!TimeManagement::the().disable_profile_timer())
             return ENOTSUP;
         g_profiling_all_threads = false;
+        PerformanceCounters::disable_sampling(exchange(s_profiling_all_threads_hardware_events, 0));
         return 0;
     }
 
@@ -112,6 +119,8 @@ ErrorOr<FlatPtr> Process::sys$profiling_disable(pid_t pid)
     if (!TimeManagement::the().disable_profile_timer())
         return ENOTSUP;
     process->set_profiling(false);
+    PerformanceCounters::disable_sampling(process->profiling_hardware_events());
+    process->set_profiling_hardware_events(0);
     return 0;
 }
 
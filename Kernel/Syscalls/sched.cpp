@@ -19,6 +19,13 @@ ErrorOr<FlatPtr> Process::sys$yield()
     return 0;
 }
 
+ErrorOr<FlatPtr> Process::sys$getcpu()
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+    return Processor::current_id();
+}
+
 ErrorOr<NonnullRefPtr<Thread>> Process::get_thread_from_pid_or_tid(pid_t pid_or_tid, Syscall::SchedulerParametersMode mode)
 {
     VERIFY(g_scheduler_lock.is_locked_by_current_processor());
@@ -58,6 +65,31 @@ ErrorOr<NonnullRefPtr<Thread>> Process::get_thread_from_pid_or_tid(pid_t pid_or_
     return NonnullRefPtr<Thread> { *peer };
 }
 
+static ErrorOr<Thread::SchedulingClass> scheduling_class_for_policy(int policy)
+{
+    switch (policy) {
+    case SCHED_FIFO:
+    case SCHED_RR:
+    case SCHED_OTHER:
+        return Thread::SchedulingClass::Priority;
+    case SCHED_BATCH:
+        return Thread::SchedulingClass::Fair;
+    default:
+        return EINVAL;
+    }
+}
+
+static int policy_for_scheduling_class(Thread::SchedulingClass scheduling_class)
+{
+    switch (scheduling_class) {
+    case Thread::SchedulingClass::Priority:
+        return SCHED_OTHER;
+    case Thread::SchedulingClass::Fair:
+        return SCHED_BATCH;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 ErrorOr<FlatPtr> Process::sys$scheduler_set_parameters(Userspace<Syscall::SC_scheduler_parameters_params const*> user_param)
 {
     VERIFY_NO_PROCESS_BIG_LOCK(this);
@@ -67,6 +99,10 @@ ErrorOr<FlatPtr> Process::sys$scheduler_set_parameters(Userspace<Syscall::SC_sch
     if (parameters.parameters.sched_priority < THREAD_PRIORITY_MIN || parameters.parameters.sched_priority > THREAD_PRIORITY_MAX)
         return EINVAL;
 
+    Optional<Thread::SchedulingClass> scheduling_class;
+    if (parameters.policy != -1)
+        scheduling_class = TRY(scheduling_class_for_policy(parameters.policy));
+
     SpinlockLocker lock(g_scheduler_lock);
     auto peer = TRY(get_thread_from_pid_or_tid(parameters.pid_or_tid, parameters.mode));
 
@@ -76,11 +112,15 @@ ErrorOr<FlatPtr> Process::sys$scheduler_set_parameters(Userspace<Syscall::SC_sch
         return EPERM;
 
     peer->set_priority((u32)parameters.parameters.sched_priority);
+    if (scheduling_class.has_value())
+        peer->set_scheduling_class(scheduling_class.value());
     // POSIX says that process scheduling parameters have precedence over thread scheduling parameters.
     // We don't track them separately, so overwrite the thread scheduling settings manually for now.
     if (parameters.mode == Syscall::SchedulerParametersMode::Process) {
         peer->process().for_each_thread([&](auto& thread) {
             thread.set_priority((u32)parameters.parameters.sched_priority);
+            if (scheduling_class.has_value())
+                thread.set_scheduling_class(scheduling_class.value());
         });
     }
 
@@ -96,6 +136,7 @@ ErrorOr<FlatPtr> Process::sys$scheduler_get_parameters(Userspace<Syscall::SC_sch
     TRY(copy_from_user(&parameters, user_param));
 
     int priority;
+    Thread::SchedulingClass scheduling_class;
     {
         SpinlockLocker lock(g_scheduler_lock);
         auto peer = TRY(get_thread_from_pid_or_tid(parameters.pid_or_tid, parameters.mode));
@@ -106,9 +147,11 @@ ErrorOr<FlatPtr> Process::sys$scheduler_get_parameters(Userspace<Syscall::SC_sch
             return EPERM;
 
         priority = (int)peer->priority();
+        scheduling_class = peer->scheduling_class();
     }
 
     parameters.parameters.sched_priority = priority;
+    parameters.policy = policy_for_scheduling_class(scheduling_class);
 
     TRY(copy_to_user(user_param, &parameters));
     return 0;
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <Kernel/Debug.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Library/KBuffer.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+// Data is moved through a kernel buffer of (at most) this size, so it never has to visit userspace.
+static constexpr size_t splice_chunk_size = 64 * KiB;
+
+static ErrorOr<void> block_until_readable(OpenFileDescription& description, bool nonblocking)
+{
+    if (description.can_read())
+        return {};
+    if (nonblocking || !description.is_blocking())
+        return EAGAIN;
+    auto unblock_flags = Thread::FileBlocker::BlockFlags::None;
+    if (Thread::current()->block<Thread::ReadBlocker>({}, description, unblock_flags).was_interrupted())
+        return EINTR;
+    if (!has_flag(unblock_flags, Thread::FileBlocker::BlockFlags::Read))
+        return EAGAIN;
+    return {};
+}
+
+ErrorOr<size_t> Process::do_splice(OpenFileDescription& in, Optional<off_t>& in_offset, OpenFileDescription& out, Optional<off_t>& out_offset, size_t length, bool nonblocking)
+{
+    if (!in.is_readable() || !out.is_writable())
+        return EBADF;
+    if (in.is_directory() || out.is_directory())
+        return EISDIR;
+    if ((in_offset.has_value() && !in.file().is_seekable()) || (out_offset.has_value() && !out.file().is_seekable()))
+        return ESPIPE;
+    // We read ahead of what the output has accepted, so anything it doesn't take has to be put back.
+    // That isn't possible for pipes and sockets, so those have to wait for the output instead.
+    if (!in.file().is_seekable() && (nonblocking || !out.is_blocking()))
+        return EINVAL;
+    if (length == 0)
+        return 0;
+
+    auto buffer = TRY(KBuffer::try_create_with_size("splice"sv, min(length, splice_chunk_size)));
+    auto kernel_buffer = buffer->as_kernel_buffer();
+
+    size_t total_nwritten = 0;
+    while (total_nwritten < length) {
+        // Only the first chunk is allowed to wait for data, after that we hand back what we have.
+        if (total_nwritten > 0 && !in.can_read())
+            break;
+        if (nonblocking && !out.can_write()) {
+            if (total_nwritten > 0)
+                break;
+            return EAGAIN;
+        }
+        if (total_nwritten == 0)
+            TRY(block_until_readable(in, nonblocking));
+
+        auto nread_or_error = in_offset.has_value()
+            ? in.read(kernel_buffer, in_offset.value(), min(length - total_nwritten, buffer->size()))
+            : in.read(kernel_buffer, min(length - total_nwritten, buffer->size()));
+        if (nread_or_error.is_error()) {
+            if (total_nwritten > 0)
+                break;
+            return nread_or_error.release_error();
+        }
+        auto nread = nread_or_error.release_value();
+        if (nread == 0)
+            break;
+
+        auto nwritten_or_error = do_write(out, kernel_buffer, nread, out_offset);
+        size_t nwritten = nwritten_or_error.is_error() ? 0 : nwritten_or_error.value();
+        if (nwritten < nread && !in_offset.has_value() && in.file().is_seekable())
+            TRY(in.seek(-static_cast<off_t>(nread - nwritten), SEEK_CUR));
+        if (nwritten_or_error.is_error()) {
+            if (total_nwritten > 0)
+                break;
+            return nwritten_or_error.release_error();
+        }
+
+        total_nwritten += nwritten;
+        if (in_offset.has_value())
+            in_offset.value() += nwritten;
+        if (out_offset.has_value())
+            out_offset.value() += nwritten;
+        if (nwritten < nread)
+            break;
+    }
+    return total_nwritten;
+}
+
+ErrorOr<FlatPtr> Process::sys$splice(Userspace<Syscall::SC_splice_params const*> user_params)
+{
+    VERIFY_PROCESS_BIG_LOCK_ACQUIRED(this);
+    TRY(require_promise(Pledge::stdio));
+    auto params = TRY(copy_typed_from_user(user_params));
+
+    if (params.flags & ~(SPLICE_F_MOVE | SPLICE_F_NONBLOCK | SPLICE_F_MORE))
+        return EINVAL;
+    if (params.length > NumericLimits<ssize_t>::max())
+        return EINVAL;
+
+    dbgln_if(IO_DEBUG, "sys$splice({}, {}, {}, {}, {}, {:#x})", params.fd_in, params.offset_in, params.fd_out, params.offset_out, params.length, params.flags);
+
+    auto in_description = TRY(open_file_description(params.fd_in));
+    auto out_description = TRY(open_file_description(params.fd_out));
+
+    Optional<off_t> in_offset;
+    if (params.offset_in) {
+        off_t offset;
+        TRY(copy_from_user(&offset, params.offset_in));
+        if (offset < 0)
+            return EINVAL;
+        in_offset = offset;
+    }
+    Optional<off_t> out_offset;
+    if (params.offset_out) {
+        off_t offset;
+        TRY(copy_from_user(&offset, params.offset_out));
+        if (offset < 0)
+            return EINVAL;
+        out_offset = offset;
+    }
+
+    auto nwritten = TRY(do_splice(*in_description, in_offset, *out_description, out_offset, params.length, params.flags & SPLICE_F_NONBLOCK));
+
+    if (params.offset_in)
+        TRY(copy_to_user(params.offset_in, &in_offset.value()));
+    if (params.offset_out)
+        TRY(copy_to_user(params.offset_out, &out_offset.value()));
+    return nwritten;
+}
+
+}
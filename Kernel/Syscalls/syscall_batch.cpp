@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/API/Syscall.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+ErrorOr<FlatPtr> Process::sys$syscall_batch(Userspace<syscall_batch_entry*> user_entries, size_t count)
+{
+    VERIFY_NO_PROCESS_BIG_LOCK(this);
+    TRY(require_promise(Pledge::stdio));
+
+    if (count == 0 || count > SYSCALL_BATCH_MAX_ENTRIES)
+        return EINVAL;
+
+    Vector<syscall_batch_entry> entries;
+    TRY(entries.try_resize(count));
+    TRY(copy_n_from_user(entries.data(), static_ptr_cast<syscall_batch_entry const*>(user_entries), count));
+
+    auto* current_thread = Thread::current();
+    size_t i = 0;
+    for (; i < count; ++i) {
+        // Give pending signals a chance to be delivered, like they would be between separate syscalls.
+        if (i > 0 && (current_thread->should_die() || current_thread->has_unmasked_pending_signals()))
+            break;
+
+        auto& entry = entries[i];
+        FlatPtr arg1 = entry.args[0];
+        if (entry.arg1_from >= 0) {
+            if (static_cast<size_t>(entry.arg1_from) >= i) {
+                entry.result = -EINVAL;
+                continue;
+            }
+            auto source_result = entries[entry.arg1_from].result;
+            if (source_result < 0) {
+                entry.result = -ECANCELED;
+                continue;
+            }
+            arg1 = static_cast<FlatPtr>(source_result);
+        }
+
+        auto result = Syscall::handle_batched(*this, entry.function, arg1, entry.args[1], entry.args[2], entry.args[3]);
+        if (result.is_error()) {
+            // syscall_handler() has to crash the process, so this can't be reported as the result of an entry.
+            if (result.error().code() == EPROMISEVIOLATION)
+                return result.release_error();
+            entry.result = -result.error().code();
+        } else {
+            entry.result = static_cast<intptr_t>(result.value());
+        }
+    }
+
+    auto processed_count = i;
+    for (; i < count; ++i)
+        entries[i].result = -EINTR;
+
+    TRY(copy_n_to_user(user_entries, entries.data(), count));
+    return processed_count;
+}
+
+}
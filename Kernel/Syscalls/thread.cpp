@@ -96,6 +96,7 @@ ErrorOr<FlatPtr> Process::sys$create_thread(void* (*entry)(void*), Userspace<Sys
 
     SpinlockLocker lock(g_scheduler_lock);
     thread->set_priority(requested_thread_priority);
+    thread->set_scheduling_class(Thread::current()->scheduling_class());
     thread->set_state(Thread::State::Runnable);
     return thread->tid().value();
 }
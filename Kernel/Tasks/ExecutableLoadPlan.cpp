@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/FixedArray.h>
+#include <Kernel/FileSystem/Inode.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Library/KBuffer.h>
+#include <Kernel/Tasks/ExecutableLoadPlan.h>
+#include <LibELF/Validation.h>
+
+namespace Kernel {
+
+static ErrorOr<FixedArray<u8>> read_elf_buffer_including_program_headers(OpenFileDescription& elf_file, Elf_Ehdr const& header)
+{
+    auto program_header_offset = static_cast<size_t>(header.e_phoff);
+    auto program_header_entry_size = static_cast<size_t>(header.e_phentsize);
+    auto program_header_entries_count = static_cast<size_t>(header.e_phnum);
+
+    if (Checked<size_t>::multiplication_would_overflow(program_header_entry_size, program_header_entries_count))
+        return EOVERFLOW;
+
+    if (Checked<size_t>::addition_would_overflow(program_header_offset, (program_header_entry_size * program_header_entries_count)))
+        return EOVERFLOW;
+
+    auto last_needed_byte_offset_on_program_header_list = program_header_offset + (program_header_entry_size * program_header_entries_count);
+    if (last_needed_byte_offset_on_program_header_list < sizeof(Elf_Ehdr))
+        return EINVAL;
+
+    auto elf_buffer = TRY(FixedArray<u8>::create(last_needed_byte_offset_on_program_header_list));
+    auto elf_read_buffer = UserOrKernelBuffer::for_kernel_buffer(elf_buffer.data());
+    {
+        auto nread = TRY(elf_file.read(elf_read_buffer, 0, elf_buffer.span().size()));
+        if (nread < elf_buffer.span().size())
+            return EIO;
+    }
+    return elf_buffer;
+}
+
+ErrorOr<NonnullRefPtr<ExecutableLoadPlan>> ExecutableLoadPlan::get_or_create(OpenFileDescription& description)
+{
+    auto& inode = *description.inode();
+
+    // Remember the version before reading the headers, so we don't cache a plan for contents that changed in the meantime.
+    auto cached = inode.executable_load_plan();
+    if (cached.plan)
+        return cached.plan.release_nonnull();
+
+    auto plan = TRY(try_create(description));
+    inode.set_executable_load_plan(plan, cached.contents_version);
+    return plan;
+}
+
+ErrorOr<NonnullRefPtr<ExecutableLoadPlan>> ExecutableLoadPlan::try_create(OpenFileDescription& description)
+{
+    size_t file_size = description.inode()->size();
+
+    Elf_Ehdr header {};
+    auto header_buffer = UserOrKernelBuffer::for_kernel_buffer(reinterpret_cast<u8*>(&header));
+    if (TRY(description.read(header_buffer, 0, sizeof(header))) < sizeof(header))
+        return ENOEXEC;
+
+    if (!ELF::validate_elf_header(header, file_size))
+        return ENOEXEC;
+
+    // We can't exec an ET_REL, as that's just an object file from the compiler,
+    // and we can't exec an ET_CORE as it's just a coredump.
+    // The only allowed ELF files on execve are executables or shared object files
+    // which are dynamically linked programs (or static-pie programs like the dynamic loader).
+    if (header.e_type != ET_EXEC && header.e_type != ET_DYN)
+        return ENOEXEC;
+
+    auto buffer = TRY(read_elf_buffer_including_program_headers(description, header));
+
+    auto plan = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) ExecutableLoadPlan(header, file_size)));
+
+    Optional<Elf_Phdr> interpreter_path_program_header;
+    if (!ELF::validate_program_headers(header, file_size, buffer.span(), interpreter_path_program_header, &plan->m_requested_stack_size))
+        return ENOEXEC;
+
+    if (interpreter_path_program_header.has_value() && interpreter_path_program_header->p_filesz > 1) {
+        auto interpreter_path_buffer = TRY(KBuffer::try_create_with_size("ELF interpreter program path"sv, static_cast<size_t>(interpreter_path_program_header->p_filesz) - 1));
+        auto interpreter_path_kernel_buffer = interpreter_path_buffer->as_kernel_buffer();
+        auto nread = TRY(description.read(interpreter_path_kernel_buffer, static_cast<size_t>(interpreter_path_program_header->p_offset), interpreter_path_buffer->size()));
+        if (nread < interpreter_path_buffer->size())
+            return EIO;
+        plan->m_interpreter_path = TRY(KString::try_create(StringView(interpreter_path_buffer->bytes())));
+    }
+
+    // validate_program_headers() made sure that all program headers are within the buffer.
+    for (size_t i = 0; i < header.e_phnum; ++i) {
+        Elf_Phdr program_header;
+        __builtin_memcpy(&program_header, buffer.data() + header.e_phoff + i * header.e_phentsize, sizeof(program_header));
+        if (program_header.p_type != PT_LOAD)
+            continue;
+
+        TRY(plan->m_segments.try_append({
+            .vaddr = static_cast<FlatPtr>(program_header.p_vaddr),
+            .size_in_memory = static_cast<size_t>(program_header.p_memsz),
+            .size_in_image = static_cast<size_t>(program_header.p_filesz),
+            .offset = static_cast<size_t>(program_header.p_offset),
+            .alignment = static_cast<size_t>(program_header.p_align),
+            .readable = (program_header.p_flags & PF_R) != 0,
+            .writable = (program_header.p_flags & PF_W) != 0,
+            .executable = (program_header.p_flags & PF_X) != 0,
+        }));
+
+        auto segment_start = static_cast<FlatPtr>(program_header.p_vaddr);
+        auto segment_end = segment_start + program_header.p_memsz;
+        if (plan->m_load_range_start == 0 || segment_start < plan->m_load_range_start)
+            plan->m_load_range_start = segment_start;
+        if (plan->m_load_range_end == 0 || segment_end > plan->m_load_range_end)
+            plan->m_load_range_end = segment_end;
+    }
+
+    return plan;
+}
+
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <Kernel/Forward.h>
+#include <Kernel/Library/KString.h>
+#include <LibELF/ELFABI.h>
+
+namespace Kernel {
+
+// Everything execve() needs to know about an ELF object to load it, taken from its validated headers.
+// Plans are cached on the inode until its contents change, so executing the same program again doesn't
+// have to read and validate its headers again.
+class ExecutableLoadPlan : public AtomicRefCounted<ExecutableLoadPlan> {
+    AK_MAKE_NONCOPYABLE(ExecutableLoadPlan);
+    AK_MAKE_NONMOVABLE(ExecutableLoadPlan);
+
+public:
+    // A PT_LOAD program header.
+    struct Segment {
+        FlatPtr vaddr { 0 };
+        size_t size_in_memory { 0 };
+        size_t size_in_image { 0 };
+        size_t offset { 0 };
+        size_t alignment { 0 };
+        bool readable { false };
+        bool writable { false };
+        bool executable { false };
+    };
+
+    // Returns the cached plan of the object, or reads and validates its headers and caches the result.
+    // Fails with ENOEXEC if the object is not a valid ELF executable or shared object.
+    static ErrorOr<NonnullRefPtr<ExecutableLoadPlan>> get_or_create(OpenFileDescription&);
+
+    Elf_Ehdr const& header() const { return m_header; }
+    size_t file_size() const { return m_file_size; }
+    Vector<Segment> const& segments() const { return m_segments; }
+
+    // The lowest and highest address any of the segments occupies.
+    FlatPtr load_range_start() const { return m_load_range_start; }
+    FlatPtr load_range_end() const { return m_load_range_end; }
+
+    // The path in the PT_INTERP program header, if there is one.
+    KString const* interpreter_path() const { return m_interpreter_path.ptr(); }
+    Optional<size_t> requested_stack_size() const { return m_requested_stack_size; }
+
+private:
+    ExecutableLoadPlan(Elf_Ehdr const& header, size_t file_size)
+        : m_header(header)
+        , m_file_size(file_size)
+    {
+    }
+
+    static ErrorOr<NonnullRefPtr<ExecutableLoadPlan>> try_create(OpenFileDescription&);
+
+    Elf_Ehdr m_header;
+    size_t m_file_size { 0 };
+    Vector<Segment> m_segments;
+    FlatPtr m_load_range_start { 0 };
+    FlatPtr m_load_range_end { 0 };
+    OwnPtr<KString> m_interpreter_path;
+    Optional<size_t> m_requested_stack_size;
+};
+
+}
@@ -6,11 +6,17 @@
 
 #include <Kernel/Debug.h>
 #include <Kernel/Tasks/FutexQueue.h>
+#include <Kernel/Tasks/Scheduler.h>
 #include <Kernel/Tasks/Thread.h>
 
 namespace Kernel {
 
-FutexQueue::FutexQueue() = default;
+// If we're creating this object because we're going to be waiting on it, start out with that imminent wait.
+FutexQueue::FutexQueue(CreatedForWait created_for_wait)
+    : m_imminent_waits(created_for_wait == CreatedForWait::Yes ? 1 : 0)
+{
+}
+
 FutexQueue::~FutexQueue() = default;
 
 bool FutexQueue::should_add_blocker(Thread::Blocker& b, void*)
@@ -157,4 +163,52 @@ bool FutexQueue::try_remove()
     return true;
 }
 
+void FutexQueue::add_priority_inheriting_waiter(Thread& waiter, Thread& owner)
+{
+    SpinlockLocker lock(m_priority_inheritance_lock);
+    VERIFY(!waiter.m_priority_inheriting_waiters_list_node.is_in_list());
+    m_priority_inheriting_waiters.append(waiter);
+    set_priority_inheriting_owner_locked(&owner);
+}
+
+void FutexQueue::remove_priority_inheriting_waiter(Thread& waiter)
+{
+    SpinlockLocker lock(m_priority_inheritance_lock);
+    if (!waiter.m_priority_inheriting_waiters_list_node.is_in_list())
+        return;
+    m_priority_inheriting_waiters.remove(waiter);
+    update_inherited_priority_locked();
+}
+
+void FutexQueue::set_priority_inheriting_owner(Thread* owner)
+{
+    SpinlockLocker lock(m_priority_inheritance_lock);
+    set_priority_inheriting_owner_locked(owner);
+}
+
+void FutexQueue::set_priority_inheriting_owner_locked(Thread* owner)
+{
+    VERIFY(m_priority_inheritance_lock.is_locked());
+    if (m_priority_inheriting_owner.ptr() != owner) {
+        // FIXME: A thread owning more than one contended priority-inheriting futex
+        //        only keeps the priority inherited through the one that changed last.
+        if (m_priority_inheriting_owner)
+            Scheduler::set_inherited_priority(*m_priority_inheriting_owner, 0);
+        m_priority_inheriting_owner = owner;
+    }
+    update_inherited_priority_locked();
+}
+
+void FutexQueue::update_inherited_priority_locked()
+{
+    VERIFY(m_priority_inheritance_lock.is_locked());
+    if (!m_priority_inheriting_owner)
+        return;
+    u32 inherited_priority = 0;
+    for (auto& waiter : m_priority_inheriting_waiters)
+        inherited_priority = max(inherited_priority, waiter.effective_priority());
+    dbgln_if(FUTEXQUEUE_DEBUG, "FutexQueue @ {}: {} inherits priority {}", this, *m_priority_inheriting_owner, inherited_priority);
+    Scheduler::set_inherited_priority(*m_priority_inheriting_owner, inherited_priority);
+}
+
 }
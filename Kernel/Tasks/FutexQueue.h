@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/AtomicRefCounted.h>
+#include <AK/IntrusiveList.h>
 #include <Kernel/Locking/Spinlock.h>
 #include <Kernel/Tasks/Thread.h>
 
@@ -16,7 +17,12 @@ class FutexQueue final
     : public AtomicRefCounted<FutexQueue>
     , public Thread::BlockerSet {
 public:
-    FutexQueue();
+    enum class CreatedForWait {
+        No,
+        Yes,
+    };
+
+    explicit FutexQueue(CreatedForWait);
     virtual ~FutexQueue();
 
     ErrorOr<u32> wake_n_requeue(u32, Function<ErrorOr<FutexQueue*>()> const&, u32, bool&, bool&);
@@ -39,12 +45,24 @@ public:
     }
     bool is_empty_and_no_imminent_waits_locked();
 
+    // Threads waiting on a priority-inheriting futex lend their priority to its owner while they wait.
+    void add_priority_inheriting_waiter(Thread& waiter, Thread& owner);
+    void remove_priority_inheriting_waiter(Thread& waiter);
+    void set_priority_inheriting_owner(Thread*);
+
 protected:
     virtual bool should_add_blocker(Thread::Blocker& b, void*) override;
 
 private:
-    size_t m_imminent_waits { 1 }; // We only create this object if we're going to be waiting, so start out with 1
+    size_t m_imminent_waits { 0 };
     bool m_was_removed { false };
+
+    void set_priority_inheriting_owner_locked(Thread*);
+    void update_inherited_priority_locked();
+
+    RefPtr<Thread> m_priority_inheriting_owner;
+    IntrusiveList<&Thread::m_priority_inheriting_waiters_list_node> m_priority_inheriting_waiters;
+    Spinlock<LockRank::None> m_priority_inheritance_lock {};
 };
 
 }
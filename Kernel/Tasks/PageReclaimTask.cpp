@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/BlockBasedFileSystem.h>
+#include <Kernel/Memory/MemoryManager.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/PageReclaimTask.h>
+#include <Kernel/Tasks/Process.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT void PageReclaimTask::spawn()
+{
+    MUST(Process::create_kernel_process("Page Reclaim Task"sv, [] {
+        dbgln("PageReclaimTask is running");
+        while (!Process::current().is_dying()) {
+            auto pressure_level = MM.memory_pressure_level();
+            if (pressure_level != Memory::MemoryManager::MemoryPressureLevel::Normal) {
+                // Blocks in the filesystem caches are often cached again in a VMObject, so they go first.
+                auto target = MM.page_reclaim_target();
+                auto reclaimed_page_count = BlockBasedFileSystem::reclaim_cache_memory(target);
+                if (reclaimed_page_count < target)
+                    (void)MM.reclaim_pages(target - reclaimed_page_count);
+            }
+            // NOTE: Allocations happen in contexts that can't wake us up, so we poll for pressure instead, just more often while there is some.
+            auto interval = pressure_level == Memory::MemoryManager::MemoryPressureLevel::Normal ? Duration::from_seconds(1) : Duration::from_milliseconds(250);
+            (void)Thread::current()->sleep(interval);
+        }
+        Process::current().sys$exit(0);
+        VERIFY_NOT_REACHED();
+    }));
+}
+
+}
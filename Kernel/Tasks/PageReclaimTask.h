@@ -0,0 +1,14 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+namespace Kernel {
+class PageReclaimTask {
+public:
+    static void spawn();
+};
+}
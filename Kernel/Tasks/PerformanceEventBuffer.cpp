@@ -5,13 +5,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/JsonArraySerializer.h>
-#include <AK/JsonObjectSerializer.h>
+#include <AK/ByteBuffer.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StackUnwinder.h>
 #include <Kernel/Arch/RegisterState.h>
 #include <Kernel/Arch/SafeMem.h>
 #include <Kernel/FileSystem/Custody.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
+#include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/Library/KBufferBuilder.h>
 #include <Kernel/Tasks/PerformanceEventBuffer.h>
 #include <Kernel/Tasks/Process.h>
@@ -19,8 +20,13 @@
 
 namespace Kernel {
 
-PerformanceEventBuffer::PerformanceEventBuffer(NonnullOwnPtr<KBuffer> buffer)
+static constexpr size_t max_event_data_size = sizeof(PerfcoreMemoryEventData) + PerformanceEventBuffer::max_event_string_length;
+static constexpr size_t max_event_record_size = align_up_to(sizeof(PerfcoreEventRecord) + PerformanceEventBuffer::max_stack_frame_count * sizeof(u64) + max_event_data_size, PERFCORE_RECORD_ALIGNMENT);
+
+PerformanceEventBuffer::PerformanceEventBuffer(NonnullOwnPtr<KBuffer> buffer, FixedArray<ProcessorState> processors)
     : m_buffer(move(buffer))
+    , m_chunk_count(m_buffer->size() / chunk_size)
+    , m_processors(move(processors))
 {
 }
 
@@ -30,9 +36,9 @@ NEVER_INLINE ErrorOr<void> PerformanceEventBuffer::append(int type, FlatPtr arg1
     return append_with_ip_and_bp(current_thread->pid(), current_thread->tid(), 0, base_pointer, type, 0, arg1, arg2, arg3, filesystem_event);
 }
 
-static Vector<FlatPtr, PerformanceEvent::max_stack_frame_count> raw_backtrace(FlatPtr frame_pointer, FlatPtr pc)
+static Vector<FlatPtr, PerformanceEventBuffer::max_stack_frame_count> raw_backtrace(FlatPtr frame_pointer, FlatPtr pc)
 {
-    Vector<FlatPtr, PerformanceEvent::max_stack_frame_count> backtrace;
+    Vector<FlatPtr, PerformanceEventBuffer::max_stack_frame_count> backtrace;
     if (pc != 0)
         backtrace.unchecked_append(pc);
 
@@ -66,7 +72,7 @@ static Vector<FlatPtr, PerformanceEvent::max_stack_frame_count> raw_backtrace(Fl
         },
         [&backtrace](AK::StackFrame stack_frame) -> ErrorOr<IterationDecision> {
             backtrace.unchecked_append(stack_frame.return_address);
-            if (backtrace.size() >= PerformanceEvent::max_stack_frame_count)
+            if (backtrace.size() >= PerformanceEventBuffer::max_stack_frame_count)
                 return IterationDecision::Break;
 
             return IterationDecision::Continue;
@@ -81,15 +87,53 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
     return append_with_ip_and_bp(pid, tid, regs.ip(), regs.bp(), type, lost_samples, arg1, arg2, arg3, filesystem_event);
 }
 
+static PerfcoreFilesystemEventData to_perfcore_data(FilesystemEvent const& event)
+{
+    PerfcoreFilesystemEventData data {};
+    data.type = event.type;
+    data.duration_ns = event.durationNs;
+    switch (event.type) {
+    case FilesystemEventType::Open:
+        data.fd = event.data.open.dirfd;
+        data.filename_index = event.data.open.filename_index;
+        data.options = event.data.open.options;
+        data.mode = event.data.open.mode;
+        break;
+    case FilesystemEventType::Close:
+        data.fd = event.data.close.fd;
+        data.filename_index = event.data.close.filename_index;
+        break;
+    case FilesystemEventType::Preadv:
+        data.fd = event.data.preadv.fd;
+        data.filename_index = event.data.preadv.filename_index;
+        data.offset = event.data.preadv.offset;
+        break;
+    case FilesystemEventType::Read:
+        data.fd = event.data.read.fd;
+        data.filename_index = event.data.read.filename_index;
+        break;
+    case FilesystemEventType::Pread:
+        data.fd = event.data.pread.fd;
+        data.filename_index = event.data.pread.filename_index;
+        data.buffer_ptr = event.data.pread.buffer_ptr;
+        data.size = event.data.pread.size;
+        data.offset = event.data.pread.offset;
+        break;
+    }
+    return data;
+}
+
 ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, ThreadID tid,
     FlatPtr ip, FlatPtr bp, int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, StringView arg3, FilesystemEvent filesystem_event)
 {
-    if (count() >= capacity())
-        return ENOBUFS;
-
     if ((g_profiling_event_mask & type) == 0)
         return EINVAL;
 
+    if (m_claimed_chunk_count.load(AK::MemoryOrder::memory_order_relaxed) >= m_chunk_count) {
+        note_dropped_event();
+        return ENOBUFS;
+    }
+
     auto* current_thread = Thread::current();
     u32 enter_count = 0;
     if (current_thread)
@@ -101,285 +145,348 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
     if (enter_count > 0)
         return EINVAL;
 
-    PerformanceEvent event;
-    event.type = type;
-    event.lost_samples = lost_samples;
+    u8 data[max_event_data_size];
+    size_t data_size = 0;
+    auto append_data = [&](auto const& value) {
+        memcpy(data + data_size, &value, sizeof(value));
+        data_size += sizeof(value);
+    };
+    auto append_string = [&](StringView string) {
+        auto length = min(string.length(), max_event_string_length);
+        memcpy(data + data_size, string.characters_without_null_termination(), length);
+        data_size += length;
+    };
 
     switch (type) {
     case PERF_EVENT_SAMPLE:
         break;
     case PERF_EVENT_MALLOC:
-        event.data.malloc.size = arg1;
-        event.data.malloc.ptr = arg2;
+    case PERF_EVENT_KMALLOC:
+        append_data(PerfcoreMemoryEventData { .ptr = arg2, .size = arg1 });
         break;
     case PERF_EVENT_FREE:
-        event.data.free.ptr = arg1;
+        append_data(PerfcoreMemoryEventData { .ptr = arg1, .size = 0 });
+        break;
+    case PERF_EVENT_KFREE:
+        append_data(PerfcoreMemoryEventData { .ptr = arg2, .size = arg1 });
         break;
     case PERF_EVENT_MMAP:
-        event.data.mmap.ptr = arg1;
-        event.data.mmap.size = arg2;
-        memset(event.data.mmap.name, 0, sizeof(event.data.mmap.name));
-        if (!arg3.is_empty())
-            memcpy(event.data.mmap.name, arg3.characters_without_null_termination(), min(arg3.length(), sizeof(event.data.mmap.name) - 1));
+        append_data(PerfcoreMemoryEventData { .ptr = arg1, .size = arg2 });
+        append_string(arg3);
         break;
     case PERF_EVENT_MUNMAP:
-        event.data.munmap.ptr = arg1;
-        event.data.munmap.size = arg2;
+        append_data(PerfcoreMemoryEventData { .ptr = arg1, .size = arg2 });
         break;
     case PERF_EVENT_PROCESS_CREATE:
-        event.data.process_create.parent_pid = arg1;
-        memset(event.data.process_create.executable, 0, sizeof(event.data.process_create.executable));
-        if (!arg3.is_empty()) {
-            memcpy(event.data.process_create.executable, arg3.characters_without_null_termination(),
-                min(arg3.length(), sizeof(event.data.process_create.executable) - 1));
-        }
+        append_data(PerfcoreProcessCreateEventData { .parent_pid = static_cast<i32>(arg1) });
+        append_string(arg3);
         break;
     case PERF_EVENT_PROCESS_EXEC:
-        memset(event.data.process_exec.executable, 0, sizeof(event.data.process_exec.executable));
-        if (!arg3.is_empty()) {
-            memcpy(event.data.process_exec.executable, arg3.characters_without_null_termination(),
-                min(arg3.length(), sizeof(event.data.process_exec.executable) - 1));
-        }
+        append_string(arg3);
         break;
     case PERF_EVENT_PROCESS_EXIT:
         break;
     case PERF_EVENT_THREAD_CREATE:
-        event.data.thread_create.parent_tid = arg1;
+        append_data(PerfcoreThreadCreateEventData { .parent_tid = static_cast<i32>(arg1) });
         break;
     case PERF_EVENT_THREAD_EXIT:
         break;
     case PERF_EVENT_CONTEXT_SWITCH:
-        event.data.context_switch.next_pid = arg1;
-        event.data.context_switch.next_tid = arg2;
+        append_data(PerfcoreContextSwitchEventData { .next_pid = static_cast<i32>(arg1), .next_tid = static_cast<i32>(arg2) });
         break;
-    case PERF_EVENT_KMALLOC:
-        event.data.kmalloc.size = arg1;
-        event.data.kmalloc.ptr = arg2;
+    case PERF_EVENT_SCHEDULING_LATENCY:
+        append_data(PerfcoreSchedulingLatencyEventData { .latency_ns = arg1, .cpu = static_cast<u32>(arg2) });
         break;
-    case PERF_EVENT_KFREE:
-        event.data.kfree.size = arg1;
-        event.data.kfree.ptr = arg2;
+    case PERF_EVENT_CPU_CYCLES:
+    case PERF_EVENT_INSTRUCTIONS_RETIRED:
+    case PERF_EVENT_CACHE_MISS:
+    case PERF_EVENT_BRANCH_MISS:
+        append_data(PerfcoreHardwareSampleEventData { .period = arg1, .cpu = static_cast<u32>(arg2) });
         break;
     case PERF_EVENT_PAGE_FAULT:
         break;
     case PERF_EVENT_SYSCALL:
         break;
     case PERF_EVENT_SIGNPOST:
-        event.data.signpost.arg1 = arg1;
-        event.data.signpost.arg2 = arg2;
+        append_data(PerfcoreSignpostEventData { .string_index = arg1, .arg = arg2 });
         break;
     case PERF_EVENT_FILESYSTEM:
-        event.data.filesystem = filesystem_event;
+        append_data(to_perfcore_data(filesystem_event));
+        break;
+    case PERF_EVENT_TRACEPOINT:
+        append_data(PerfcoreTracepointEventData { .arg1 = arg1, .arg2 = arg2 });
+        append_string(arg3);
         break;
     default:
         return EINVAL;
     }
 
     auto backtrace = raw_backtrace(bp, ip);
-    event.stack_size = min(sizeof(event.stack) / sizeof(FlatPtr), static_cast<size_t>(backtrace.size()));
-    memcpy(event.stack, backtrace.data(), event.stack_size * sizeof(FlatPtr));
+    auto record_size = align_up_to(sizeof(PerfcoreEventRecord) + backtrace.size() * sizeof(u64) + data_size, PERFCORE_RECORD_ALIGNMENT);
+
+    alignas(u64) u8 record_buffer[max_event_record_size];
+    auto& record = *reinterpret_cast<PerfcoreEventRecord*>(record_buffer);
+    record = {
+        .header = { .type = PerfcoreRecordType::Event, .reserved = 0, .size = static_cast<u32>(record_size) },
+        .type = static_cast<u32>(type),
+        .pid = pid.value(),
+        .tid = tid.value(),
+        .lost_samples = lost_samples,
+        .timestamp_ns = 0,
+        .stack_size = static_cast<u16>(backtrace.size()),
+        .data_size = static_cast<u16>(data_size),
+        .reserved = 0,
+    };
+    auto* stack = reinterpret_cast<u64*>(record_buffer + sizeof(PerfcoreEventRecord));
+    for (size_t i = 0; i < backtrace.size(); ++i)
+        stack[i] = backtrace[i];
+    auto* record_data = reinterpret_cast<u8*>(stack + backtrace.size());
+    memcpy(record_data, data, data_size);
+    memset(record_data + data_size, 0, record_buffer + record_size - (record_data + data_size));
+
+    return commit_record({ record_buffer, record_size });
+}
 
-    event.pid = pid.value();
-    event.tid = tid.value();
-    event.timestamp = TimeManagement::the().uptime_ms();
-    at(m_count++) = event;
+ErrorOr<void> PerformanceEventBuffer::commit_record(Bytes record)
+{
+    VERIFY(record.size() <= chunk_capacity);
+
+    // This keeps us on the same processor, and keeps anything else on it from appending to its chunk.
+    InterruptDisabler disabler;
+    auto processor_id = Processor::current_id();
+    auto& processor = m_processors[processor_id];
+    auto chunk_index = processor.current_chunk;
+    if (chunk_index == no_chunk || chunk_header(chunk_index).used + record.size() > chunk_capacity) {
+        if (m_claimed_chunk_count.load(AK::MemoryOrder::memory_order_relaxed) >= m_chunk_count) {
+            note_dropped_event();
+            return ENOBUFS;
+        }
+        chunk_index = m_claimed_chunk_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        if (chunk_index >= m_chunk_count) {
+            note_dropped_event();
+            return ENOBUFS;
+        }
+        auto& header = chunk_header(chunk_index);
+        header.processor = processor_id;
+        AK::atomic_store(&header.used, 0u, AK::MemoryOrder::memory_order_release);
+        processor.current_chunk = chunk_index;
+    }
+
+    // Taking the timestamp here rather than when the event was put together keeps the events of each chunk in timestamp order,
+    // even if another event was recorded in between by an interrupt.
+    reinterpret_cast<PerfcoreEventRecord*>(record.data())->timestamp_ns = TimeManagement::the().monotonic_time(TimePrecision::Precise).nanoseconds();
+
+    auto& header = chunk_header(chunk_index);
+    memcpy(chunk_data(chunk_index) + header.used, record.data(), record.size());
+    AK::atomic_store(&header.used, static_cast<u32>(header.used + record.size()), AK::MemoryOrder::memory_order_release);
     return {};
 }
 
-PerformanceEvent& PerformanceEventBuffer::at(size_t index)
+void PerformanceEventBuffer::note_dropped_event()
 {
-    VERIFY(index < capacity());
-    auto* events = reinterpret_cast<PerformanceEvent*>(m_buffer->data());
-    return events[index];
+    m_processors[Processor::current_id()].dropped_events.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
 }
 
-template<typename Serializer>
-ErrorOr<void> PerformanceEventBuffer::to_json_impl(Serializer& object) const
+u64 PerformanceEventBuffer::dropped_event_count() const
 {
-    {
-        auto strings_object = TRY(object.add_array("strings"sv));
-        Vector<KString*> strings_sorted_by_index;
+    u64 count = 0;
+    for (auto const& processor : m_processors)
+        count += processor.dropped_events.load(AK::MemoryOrder::memory_order_relaxed);
+    return count;
+}
 
-        TRY(m_strings.with([&](auto& strings) -> ErrorOr<void> {
-            TRY(strings_sorted_by_index.try_resize(strings.size()));
+void PerformanceEventBuffer::clear()
+{
+    InterruptDisabler disabler;
+    for (auto& processor : m_processors) {
+        processor.current_chunk = no_chunk;
+        processor.dropped_events.store(0, AK::MemoryOrder::memory_order_relaxed);
+    }
+    m_claimed_chunk_count.store(0);
+}
 
-            for (auto& entry : strings) {
-                strings_sorted_by_index[entry.value] = const_cast<Kernel::KString*>(entry.key.ptr());
-            }
+namespace {
 
-            for (size_t i = 0; i < strings.size(); i++) {
-                TRY(strings_object.add(strings_sorted_by_index[i]->view()));
-            }
+// Batches up the many small pieces of a profile, so they don't each go through a write() of their own.
+class PerfcoreStream {
+public:
+    PerfcoreStream(ByteBuffer& buffer, Function<ErrorOr<void>(ReadonlyBytes)> const& write)
+        : m_buffer(buffer)
+        , m_write(write)
+    {
+    }
 
-            return {};
-        }));
+    ErrorOr<void> append(ReadonlyBytes bytes)
+    {
+        if (m_used + bytes.size() > m_buffer.size())
+            TRY(flush());
+        if (bytes.size() > m_buffer.size())
+            return m_write(bytes);
+        memcpy(m_buffer.data() + m_used, bytes.data(), bytes.size());
+        m_used += bytes.size();
+        return {};
+    }
 
-        TRY(strings_object.finish());
+    ErrorOr<void> flush()
+    {
+        if (m_used == 0)
+            return {};
+        TRY(m_write(m_buffer.span().trim(m_used)));
+        m_used = 0;
+        return {};
     }
 
+private:
+    ByteBuffer& m_buffer;
+    Function<ErrorOr<void>(ReadonlyBytes)> const& m_write;
+    size_t m_used { 0 };
+};
+
+}
+
+ErrorOr<void> PerformanceEventBuffer::write_perfcore(Function<ErrorOr<void>(ReadonlyBytes)> const& write) const
+{
+    auto buffer = TRY(ByteBuffer::create_uninitialized(16 * KiB));
+    PerfcoreStream stream(buffer, write);
+
+    PerfcoreHeader file_header {};
+    memcpy(file_header.magic, PERFCORE_MAGIC, sizeof(file_header.magic));
+    file_header.version = PERFCORE_VERSION;
+    TRY(stream.append({ &file_header, sizeof(file_header) }));
+
+    TRY(m_strings.with([&](auto& strings) -> ErrorOr<void> {
+        for (auto& entry : strings) {
+            auto string = entry.key->view();
+            auto record_size = align_up_to(sizeof(PerfcoreStringRecord) + string.length(), PERFCORE_RECORD_ALIGNMENT);
+            PerfcoreStringRecord record {
+                .header = { .type = PerfcoreRecordType::String, .reserved = 0, .size = static_cast<u32>(record_size) },
+                .index = static_cast<u32>(entry.value),
+                .length = static_cast<u32>(string.length()),
+            };
+            TRY(stream.append({ &record, sizeof(record) }));
+            TRY(stream.append(string.bytes()));
+            static constexpr Array<u8, PERFCORE_RECORD_ALIGNMENT> padding {};
+            TRY(stream.append(padding.span().trim(record_size - sizeof(record) - string.length())));
+        }
+        return {};
+    }));
+
     auto current_process_credentials = Process::current().credentials();
     bool show_kernel_addresses = current_process_credentials->is_superuser();
-    auto array = TRY(object.add_array("events"sv));
     bool seen_first_sample = false;
-    for (size_t i = 0; i < m_count; ++i) {
-        auto const& event = at(i);
-
-        if (!show_kernel_addresses) {
-            if (event.type == PERF_EVENT_KMALLOC || event.type == PERF_EVENT_KFREE)
-                continue;
-        }
 
-        auto event_object = TRY(array.add_object());
-        switch (event.type) {
-        case PERF_EVENT_SAMPLE:
-            TRY(event_object.add("type"sv, "sample"));
-            break;
-        case PERF_EVENT_MALLOC:
-            TRY(event_object.add("type"sv, "malloc"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.malloc.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.malloc.size)));
-            break;
-        case PERF_EVENT_FREE:
-            TRY(event_object.add("type"sv, "free"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.free.ptr)));
-            break;
-        case PERF_EVENT_MMAP:
-            TRY(event_object.add("type"sv, "mmap"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.mmap.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.mmap.size)));
-            TRY(event_object.add("name"sv, event.data.mmap.name));
-            break;
-        case PERF_EVENT_MUNMAP:
-            TRY(event_object.add("type"sv, "munmap"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.munmap.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.munmap.size)));
-            break;
-        case PERF_EVENT_PROCESS_CREATE:
-            TRY(event_object.add("type"sv, "process_create"));
-            TRY(event_object.add("parent_pid"sv, static_cast<u64>(event.data.process_create.parent_pid)));
-            TRY(event_object.add("executable"sv, event.data.process_create.executable));
-            break;
-        case PERF_EVENT_PROCESS_EXEC:
-            TRY(event_object.add("type"sv, "process_exec"));
-            TRY(event_object.add("executable"sv, event.data.process_exec.executable));
-            break;
-        case PERF_EVENT_PROCESS_EXIT:
-            TRY(event_object.add("type"sv, "process_exit"));
-            break;
-        case PERF_EVENT_THREAD_CREATE:
-            TRY(event_object.add("type"sv, "thread_create"));
-            TRY(event_object.add("parent_tid"sv, static_cast<u64>(event.data.thread_create.parent_tid)));
-            break;
-        case PERF_EVENT_THREAD_EXIT:
-            TRY(event_object.add("type"sv, "thread_exit"));
-            break;
-        case PERF_EVENT_CONTEXT_SWITCH:
-            TRY(event_object.add("type"sv, "context_switch"));
-            TRY(event_object.add("next_pid"sv, static_cast<u64>(event.data.context_switch.next_pid)));
-            TRY(event_object.add("next_tid"sv, static_cast<u64>(event.data.context_switch.next_tid)));
-            break;
-        case PERF_EVENT_KMALLOC:
-            TRY(event_object.add("type"sv, "kmalloc"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.kmalloc.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.kmalloc.size)));
-            break;
-        case PERF_EVENT_KFREE:
-            TRY(event_object.add("type"sv, "kfree"));
-            TRY(event_object.add("ptr"sv, static_cast<u64>(event.data.kfree.ptr)));
-            TRY(event_object.add("size"sv, static_cast<u64>(event.data.kfree.size)));
-            break;
-        case PERF_EVENT_PAGE_FAULT:
-            TRY(event_object.add("type"sv, "page_fault"));
-            break;
-        case PERF_EVENT_SYSCALL:
-            TRY(event_object.add("type"sv, "syscall"));
-            break;
-        case PERF_EVENT_SIGNPOST:
-            TRY(event_object.add("type"sv, "signpost"sv));
-            TRY(event_object.add("arg1"sv, event.data.signpost.arg1));
-            TRY(event_object.add("arg2"sv, event.data.signpost.arg2));
-            break;
-        case PERF_EVENT_FILESYSTEM:
-            TRY(event_object.add("type"sv, "filesystem"sv));
-            TRY(event_object.add("durationNs"sv, event.data.filesystem.durationNs));
-            switch (event.data.filesystem.type) {
-            case FilesystemEventType::Open: {
-                auto const& open = event.data.filesystem.data.open;
-                TRY(event_object.add("fs_event_type"sv, "open"sv));
-                TRY(event_object.add("dirfd"sv, open.dirfd));
-                TRY(event_object.add("filename_index"sv, open.filename_index));
-                TRY(event_object.add("options"sv, open.options));
-                TRY(event_object.add("mode"sv, open.mode));
-                break;
-            }
-            case FilesystemEventType::Close: {
-                auto const& close = event.data.filesystem.data.close;
-                TRY(event_object.add("fs_event_type"sv, "close"sv));
-                TRY(event_object.add("fd"sv, close.fd));
-                TRY(event_object.add("filename_index"sv, close.filename_index));
-                break;
-            }
-            case FilesystemEventType::Preadv: {
-                auto const& preadv = event.data.filesystem.data.preadv;
-                TRY(event_object.add("fs_event_type"sv, "preadv"sv));
-                TRY(event_object.add("fd"sv, preadv.fd));
-                TRY(event_object.add("filename_index"sv, preadv.filename_index));
-                TRY(event_object.add("offset"sv, preadv.offset));
-                break;
-            }
-            case FilesystemEventType::Read: {
-                auto const& read = event.data.filesystem.data.read;
-                TRY(event_object.add("fs_event_type"sv, "read"sv));
-                TRY(event_object.add("fd"sv, read.fd));
-                TRY(event_object.add("filename_index"sv, read.filename_index));
-                break;
-            }
-            case FilesystemEventType::Pread: {
-                auto const& pread = event.data.filesystem.data.pread;
-                TRY(event_object.add("fs_event_type"sv, "pread"sv));
-                TRY(event_object.add("fd"sv, pread.fd));
-                TRY(event_object.add("filename_index"sv, pread.filename_index));
-                TRY(event_object.add("buffer_ptr"sv, pread.buffer_ptr));
-                TRY(event_object.add("size"sv, pread.size));
-                TRY(event_object.add("offset"sv, pread.offset));
+    // Events that are appended while we're writing the profile out are left for the next time.
+    auto end_timestamp = TimeManagement::the().monotonic_time(TimePrecision::Precise).nanoseconds();
+    auto claimed_chunk_count = min(static_cast<size_t>(m_claimed_chunk_count.load(AK::MemoryOrder::memory_order_acquire)), m_chunk_count);
+
+    // The chunks of each processor are in the order it claimed them in, and every chunk is in timestamp order,
+    // so merging one cursor per processor gives us all events in timestamp order.
+    struct Cursor {
+        size_t chunk_index;
+        size_t offset;
+    };
+    auto first_chunk_of_processor_at_or_after = [&](u32 processor, size_t index) {
+        for (; index < claimed_chunk_count; ++index) {
+            if (chunk_header(index).processor == processor)
                 break;
+        }
+        return index;
+    };
+    auto next_record = [&](Cursor& cursor) -> PerfcoreEventRecord const* {
+        while (cursor.chunk_index < claimed_chunk_count) {
+            auto& header = chunk_header(cursor.chunk_index);
+            if (cursor.offset < AK::atomic_load(&header.used, AK::MemoryOrder::memory_order_acquire)) {
+                auto const* record = reinterpret_cast<PerfcoreEventRecord const*>(chunk_data(cursor.chunk_index) + cursor.offset);
+                if (static_cast<i64>(record->timestamp_ns) > end_timestamp)
+                    return nullptr;
+                return record;
             }
+            cursor = { first_chunk_of_processor_at_or_after(header.processor, cursor.chunk_index + 1), 0 };
+        }
+        return nullptr;
+    };
+
+    Vector<Cursor> cursors;
+    TRY(cursors.try_ensure_capacity(m_processors.size()));
+    for (u32 processor = 0; processor < m_processors.size(); ++processor)
+        cursors.unchecked_append({ first_chunk_of_processor_at_or_after(processor, 0), 0 });
+
+    alignas(u64) u8 record_buffer[max_event_record_size];
+    for (;;) {
+        Cursor* next_cursor = nullptr;
+        PerfcoreEventRecord const* next = nullptr;
+        for (auto& cursor : cursors) {
+            auto const* record = next_record(cursor);
+            if (record && (!next || record->timestamp_ns < next->timestamp_ns)) {
+                next_cursor = &cursor;
+                next = record;
             }
+        }
+        if (!next)
             break;
+        next_cursor->offset += next->header.size;
+
+        if (!show_kernel_addresses) {
+            if (next->type == PERF_EVENT_KMALLOC || next->type == PERF_EVENT_KFREE)
+                continue;
         }
-        TRY(event_object.add("pid"sv, event.pid));
-        TRY(event_object.add("tid"sv, event.tid));
-        TRY(event_object.add("timestamp"sv, event.timestamp));
-        TRY(event_object.add("lost_samples"sv, seen_first_sample ? event.lost_samples : 0));
-        if (event.type == PERF_EVENT_SAMPLE)
+
+        memcpy(record_buffer, next, next->header.size);
+        auto& record = *reinterpret_cast<PerfcoreEventRecord*>(record_buffer);
+        if (!seen_first_sample)
+            record.lost_samples = 0;
+        if (record.type == PERF_EVENT_SAMPLE)
             seen_first_sample = true;
-        auto stack_array = TRY(event_object.add_array("stack"sv));
-        for (size_t j = 0; j < event.stack_size; ++j) {
-            auto address = event.stack[j];
-            if (!show_kernel_addresses && !Memory::is_user_address(VirtualAddress { address }))
-                address = 0xdeadc0de;
-            TRY(stack_array.add(address));
+        if (!show_kernel_addresses) {
+            auto* stack = reinterpret_cast<u64*>(record_buffer + sizeof(PerfcoreEventRecord));
+            for (size_t i = 0; i < record.stack_size; ++i) {
+                if (!Memory::is_user_address(VirtualAddress { stack[i] }))
+                    stack[i] = 0xdeadc0de;
+            }
         }
-        TRY(stack_array.finish());
-        TRY(event_object.finish());
+        TRY(stream.append({ record_buffer, record.header.size }));
     }
-    TRY(array.finish());
-    TRY(object.finish());
-    return {};
+
+    for (u32 processor = 0; processor < m_processors.size(); ++processor) {
+        auto dropped_events = m_processors[processor].dropped_events.load(AK::MemoryOrder::memory_order_relaxed);
+        if (dropped_events == 0)
+            continue;
+        PerfcoreDroppedEventsRecord record {
+            .header = { .type = PerfcoreRecordType::DroppedEvents, .reserved = 0, .size = sizeof(PerfcoreDroppedEventsRecord) },
+            .processor = processor,
+            .reserved = 0,
+            .count = dropped_events,
+        };
+        TRY(stream.append({ &record, sizeof(record) }));
+    }
+
+    return stream.flush();
+}
+
+ErrorOr<void> PerformanceEventBuffer::write_perfcore(KBufferBuilder& builder) const
+{
+    return write_perfcore([&](ReadonlyBytes bytes) {
+        return builder.append_bytes(bytes);
+    });
 }
 
-ErrorOr<void> PerformanceEventBuffer::to_json(KBufferBuilder& builder) const
+ErrorOr<void> PerformanceEventBuffer::write_perfcore(OpenFileDescription& description) const
 {
-    auto object = TRY(JsonObjectSerializer<>::try_create(builder));
-    return to_json_impl(object);
+    return write_perfcore([&](ReadonlyBytes bytes) -> ErrorOr<void> {
+        TRY(description.write(UserOrKernelBuffer::for_kernel_buffer(const_cast<u8*>(bytes.data())), bytes.size()));
+        return {};
+    });
 }
 
 OwnPtr<PerformanceEventBuffer> PerformanceEventBuffer::try_create_with_size(size_t buffer_size)
 {
-    auto buffer_or_error = KBuffer::try_create_with_size("Performance events"sv, buffer_size, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow);
+    auto buffer_or_error = KBuffer::try_create_with_size("Performance events"sv, align_up_to(buffer_size, chunk_size), Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow);
     if (buffer_or_error.is_error())
         return {};
-    return adopt_own_if_nonnull(new (nothrow) PerformanceEventBuffer(buffer_or_error.release_value()));
+    auto processors_or_error = FixedArray<ProcessorState>::create(Processor::count());
+    if (processors_or_error.is_error())
+        return {};
+    return adopt_own_if_nonnull(new (nothrow) PerformanceEventBuffer(buffer_or_error.release_value(), processors_or_error.release_value()));
 }
 
 ErrorOr<void> PerformanceEventBuffer::add_process(Process const& process, ProcessEventType event_type)
@@ -7,83 +7,20 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Error.h>
+#include <AK/FixedArray.h>
+#include <AK/Function.h>
+#include <Kernel/API/Perfcore.h>
 #include <Kernel/Library/KBuffer.h>
 
 namespace Kernel {
 
 class KBufferBuilder;
+class OpenFileDescription;
 struct RegisterState;
 
-struct [[gnu::packed]] MallocPerformanceEvent {
-    size_t size;
-    FlatPtr ptr;
-};
-
-struct [[gnu::packed]] FreePerformanceEvent {
-    size_t size;
-    FlatPtr ptr;
-};
-
-struct [[gnu::packed]] MmapPerformanceEvent {
-    size_t size;
-    FlatPtr ptr;
-    char name[64];
-};
-
-struct [[gnu::packed]] MunmapPerformanceEvent {
-    size_t size;
-    FlatPtr ptr;
-};
-
-struct [[gnu::packed]] ProcessCreatePerformanceEvent {
-    pid_t parent_pid;
-    char executable[64];
-};
-
-struct [[gnu::packed]] ProcessExecPerformanceEvent {
-    char executable[64];
-};
-
-struct [[gnu::packed]] ThreadCreatePerformanceEvent {
-    pid_t parent_tid;
-};
-
-struct [[gnu::packed]] ContextSwitchPerformanceEvent {
-    pid_t next_pid;
-    u32 next_tid;
-};
-
-struct [[gnu::packed]] KMallocPerformanceEvent {
-    size_t size;
-    FlatPtr ptr;
-};
-
-struct [[gnu::packed]] KFreePerformanceEvent {
-    size_t size;
-    FlatPtr ptr;
-};
-
-struct [[gnu::packed]] SignpostPerformanceEvent {
-    FlatPtr arg1;
-    FlatPtr arg2;
-};
-
-struct [[gnu::packed]] ReadPerformanceEvent {
-    int fd;
-    size_t size;
-    size_t filename_index;
-    size_t start_timestamp;
-    bool success;
-};
-
-enum class FilesystemEventType : u8 {
-    Open,
-    Close,
-    Preadv,
-    Read,
-    Pread
-};
+using FilesystemEventType = PerfcoreFilesystemEventType;
 
 struct [[gnu::packed]] OpenEventData {
     int dirfd;
@@ -138,38 +75,21 @@ struct [[gnu::packed]] FilesystemEvent {
     } data;
 };
 
-struct [[gnu::packed]] PerformanceEvent {
-    u32 type { 0 };
-    u8 stack_size { 0 };
-    u32 pid { 0 };
-    u32 tid { 0 };
-    u64 timestamp;
-    u32 lost_samples;
-    union {
-        MallocPerformanceEvent malloc;
-        FreePerformanceEvent free;
-        MmapPerformanceEvent mmap;
-        MunmapPerformanceEvent munmap;
-        ProcessCreatePerformanceEvent process_create;
-        ProcessExecPerformanceEvent process_exec;
-        ThreadCreatePerformanceEvent thread_create;
-        ContextSwitchPerformanceEvent context_switch;
-        KMallocPerformanceEvent kmalloc;
-        KFreePerformanceEvent kfree;
-        SignpostPerformanceEvent signpost;
-        FilesystemEvent filesystem;
-    } data;
-    static constexpr size_t max_stack_frame_count = 64;
-    FlatPtr stack[max_stack_frame_count];
-};
-
 enum class ProcessEventType {
     Create,
     Exec
 };
 
+// Events are stored as perfcore records (see Kernel/API/Perfcore.h). The buffer is carved into chunks that
+// processors claim one at a time, so each processor appends to a chunk of its own without taking a lock or
+// touching memory that other processors write to, and the chunks are merged back into a single stream
+// ordered by timestamp when the profile is written out.
 class PerformanceEventBuffer {
 public:
+    static constexpr size_t max_stack_frame_count = 64;
+    // Longer mmap names and executable paths are truncated.
+    static constexpr size_t max_event_string_length = 255;
+
     static OwnPtr<PerformanceEventBuffer> try_create_with_size(size_t buffer_size);
 
     ErrorOr<void> append(int type, FlatPtr arg1, FlatPtr arg2, StringView arg3, Thread* current_thread = Thread::current(), FilesystemEvent filesystem_event = {});
@@ -178,34 +98,49 @@ public:
     ErrorOr<void> append_with_ip_and_bp(ProcessID pid, ThreadID tid, RegisterState const& regs,
         int type, u32 lost_samples, FlatPtr arg1, FlatPtr arg2, StringView arg3, FilesystemEvent filesystem_event = {});
 
-    void clear()
-    {
-        m_count = 0;
-    }
+    void clear();
 
-    size_t capacity() const { return m_buffer->size() / sizeof(PerformanceEvent); }
-    size_t count() const { return m_count; }
-    PerformanceEvent const& at(size_t index) const
-    {
-        return const_cast<PerformanceEventBuffer&>(*this).at(index);
-    }
+    u64 dropped_event_count() const;
 
-    ErrorOr<void> to_json(KBufferBuilder&) const;
+    // Hands the profile to the callback in perfcore format, a piece at a time.
+    ErrorOr<void> write_perfcore(Function<ErrorOr<void>(ReadonlyBytes)> const&) const;
+    ErrorOr<void> write_perfcore(KBufferBuilder&) const;
+    ErrorOr<void> write_perfcore(OpenFileDescription&) const;
 
     ErrorOr<void> add_process(Process const&, ProcessEventType event_type);
 
     ErrorOr<FlatPtr> register_string(NonnullOwnPtr<KString>);
 
 private:
-    explicit PerformanceEventBuffer(NonnullOwnPtr<KBuffer>);
+    static constexpr size_t chunk_size = 64 * KiB;
+    static constexpr u32 no_chunk = NumericLimits<u32>::max();
+
+    struct ChunkHeader {
+        u32 processor;
+        // Only written by the processor that claimed the chunk, and read atomically by write_perfcore().
+        u32 used;
+    };
+    static constexpr size_t chunk_capacity = chunk_size - sizeof(ChunkHeader);
+
+    struct ProcessorState {
+        u32 current_chunk { no_chunk };
+        // Events that were dropped on this processor because all chunks were used up.
+        Atomic<u64> dropped_events { 0 };
+    };
+
+    PerformanceEventBuffer(NonnullOwnPtr<KBuffer>, FixedArray<ProcessorState>);
 
-    template<typename Serializer>
-    ErrorOr<void> to_json_impl(Serializer&) const;
+    ErrorOr<void> commit_record(Bytes record);
+    void note_dropped_event();
 
-    PerformanceEvent& at(size_t index);
+    ChunkHeader& chunk_header(size_t index) const { return *reinterpret_cast<ChunkHeader*>(m_buffer->data() + index * chunk_size); }
+    u8* chunk_data(size_t index) const { return m_buffer->data() + index * chunk_size + sizeof(ChunkHeader); }
 
-    size_t m_count { 0 };
     NonnullOwnPtr<KBuffer> m_buffer;
+    size_t m_chunk_count { 0 };
+    Atomic<u32> m_claimed_chunk_count { 0 };
+    // Indexed by processor ID.
+    FixedArray<ProcessorState> m_processors;
 
     RecursiveSpinlockProtected<HashMap<NonnullOwnPtr<KString>, size_t>, LockRank::None> m_strings;
 };
@@ -69,6 +69,16 @@ public:
         }
     }
 
+    static void add_hardware_sample_event(Thread& current_thread, RegisterState const& regs, int type, u64 period)
+    {
+        if (current_thread.is_profiling_suppressed())
+            return;
+        if (auto* event_buffer = current_thread.process().current_perf_events_buffer()) {
+            [[maybe_unused]] auto rc = event_buffer->append_with_ip_and_bp(
+                current_thread.pid(), current_thread.tid(), regs, type, 0, period, Processor::current_id(), {});
+        }
+    }
+
     static void add_mmap_perf_event(Process& current_process, Memory::Region const& region)
     {
         if (auto* event_buffer = current_process.current_perf_events_buffer()) {
@@ -92,6 +102,15 @@ public:
         }
     }
 
+    static void add_scheduling_latency_perf_event(Thread& thread, u64 latency_ns)
+    {
+        if (thread.is_profiling_suppressed())
+            return;
+        if (auto* event_buffer = thread.process().current_perf_events_buffer()) {
+            [[maybe_unused]] auto res = event_buffer->append(PERF_EVENT_SCHEDULING_LATENCY, latency_ns, thread.cpu(), {}, &thread);
+        }
+    }
+
     static void add_kmalloc_perf_event(Thread& current_thread, size_t size, FlatPtr ptr)
     {
         if (current_thread.is_profiling_suppressed())
@@ -110,6 +129,15 @@ public:
         }
     }
 
+    static void add_tracepoint_event(Thread& current_thread, StringView name, FlatPtr arg1, FlatPtr arg2)
+    {
+        if (current_thread.is_profiling_suppressed())
+            return;
+        if (auto* event_buffer = current_thread.process().current_perf_events_buffer()) {
+            [[maybe_unused]] auto res = event_buffer->append(PERF_EVENT_TRACEPOINT, arg1, arg2, name, &current_thread);
+        }
+    }
+
     static void add_page_fault_event(Thread& thread, RegisterState const& regs)
     {
         if (thread.is_profiling_suppressed())
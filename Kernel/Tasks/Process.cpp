@@ -11,8 +11,10 @@
 #include <AK/Types.h>
 #include <Kernel/API/POSIX/errno.h>
 #include <Kernel/API/POSIX/sys/limits.h>
+#include <Kernel/API/ProcessPage.h>
 #include <Kernel/API/Syscall.h>
 #include <Kernel/Arch/PageDirectory.h>
+#include <Kernel/Arch/PerformanceCounters.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Devices/BaseDevices.h>
 #include <Kernel/Devices/Device.h>
@@ -23,7 +25,6 @@
 #include <Kernel/FileSystem/VirtualFileSystem.h>
 #include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/KSyms.h>
-#include <Kernel/Library/KBufferBuilder.h>
 #include <Kernel/Library/KLexicalPath.h>
 #include <Kernel/Library/Panic.h>
 #include <Kernel/Library/StdLib.h>
@@ -293,6 +294,59 @@ void Process::unprotect_data()
     });
 }
 
+ErrorOr<NonnullLockRefPtr<Memory::VMObject>> Process::process_page_vmobject()
+{
+    if (auto vmobject = process_page_vmobject_if_allocated())
+        return vmobject.release_nonnull();
+
+    auto region = TRY(MM.allocate_kernel_region(PAGE_SIZE, "Process page"sv, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+    SpinlockLocker locker(m_protected_data_lock);
+    // Another thread might have been faster, in which case we throw our region away.
+    if (!m_process_page_region) {
+        m_process_page_region = move(region);
+        update_process_page();
+    }
+    return m_process_page_region->vmobject();
+}
+
+LockRefPtr<Memory::VMObject> Process::process_page_vmobject_if_allocated()
+{
+    SpinlockLocker locker(m_protected_data_lock);
+    if (!m_process_page_region)
+        return nullptr;
+    return m_process_page_region->vmobject();
+}
+
+void Process::update_process_page()
+{
+    VERIFY(m_protected_data_lock.is_locked_by_current_processor());
+    if (!m_process_page_region)
+        return;
+
+    auto& page = *reinterpret_cast<ProcessPage*>(m_process_page_region->vaddr().as_ptr());
+    auto const& protected_data = m_protected_values_do_not_access_directly;
+
+    ProcessorIDSource processor_id_source = ProcessorIDSource::None;
+#if ARCH(X86_64)
+    if (Processor::current().has_feature(CPUFeature::RDPID))
+        processor_id_source = ProcessorIDSource::RDPID;
+    else if (Processor::current().has_feature(CPUFeature::RDTSCP))
+        processor_id_source = ProcessorIDSource::RDTSCP;
+#endif
+
+    u32 update_iteration = AK::atomic_fetch_add(&page.update2, 1u, AK::MemoryOrder::memory_order_acquire);
+    page.data.pid = protected_data.pid.value();
+    page.data.ppid = protected_data.ppid.value();
+    if (protected_data.credentials) {
+        page.data.uid = protected_data.credentials->uid().value();
+        page.data.euid = protected_data.credentials->euid().value();
+        page.data.gid = protected_data.credentials->gid().value();
+        page.data.egid = protected_data.credentials->egid().value();
+    }
+    page.data.processor_id_source = processor_id_source;
+    AK::atomic_store(&page.update1, update_iteration + 1u, AK::MemoryOrder::memory_order_release);
+}
+
 ErrorOr<Process::ProcessAndFirstThread> Process::create_with_forked_name(UserID uid, GroupID gid, ProcessID ppid, bool is_kernel_process, NonnullRefPtr<VFSRootContext> vfs_root_context, NonnullRefPtr<HostnameContext> hostname_context, RefPtr<Custody> current_directory, RefPtr<Custody> executable, RefPtr<TTY> tty, Process* fork_parent)
 {
     Process::Name name {};
@@ -833,18 +887,11 @@ ErrorOr<void> Process::dump_perfcore()
         return EEXIST;
     }
 
-    auto builder = TRY(KBufferBuilder::try_create());
-    TRY(m_perf_event_buffer->to_json(builder));
-
-    auto json = builder.build();
-    if (!json) {
-        dbgln("Failed to generate perfcore for pid {}: Could not allocate buffer.", pid().value());
-        return ENOMEM;
-    }
-    auto json_buffer = UserOrKernelBuffer::for_kernel_buffer(json->data());
-    TRY(description->write(json_buffer, json->size()));
+    TRY(m_perf_event_buffer->write_perfcore(*description));
 
     dbgln("Wrote perfcore for pid {} to {}", pid().value(), perfcore_filename);
+    if (auto dropped_event_count = m_perf_event_buffer->dropped_event_count(); dropped_event_count > 0)
+        dbgln("The profile buffer of pid {} was full, {} events were dropped", pid().value(), dropped_event_count);
     return {};
 }
 
@@ -882,6 +929,7 @@ void Process::finalize()
             TimeManagement::the().disable_profile_timer();
         }
     }
+    PerformanceCounters::disable_sampling(exchange(m_profiling_hardware_events, 0));
 
     m_threads_for_coredump.clear();
 
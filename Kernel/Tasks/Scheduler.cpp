@@ -4,7 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/BuiltinWrappers.h>
+#include <AK/IntrusiveRedBlackTree.h>
+#include <AK/Optional.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Singleton.h>
 #include <AK/Time.h>
@@ -12,10 +15,12 @@
 #include <Kernel/Debug.h>
 #include <Kernel/Interrupts/InterruptDisabler.h>
 #include <Kernel/Library/Panic.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Sections.h>
 #include <Kernel/Tasks/PerformanceManager.h>
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/Scheduler.h>
+#include <Kernel/Tasks/Tracepoints.h>
 #include <Kernel/Tasks/WaitQueue.h>
 #include <Kernel/Time/TimeManagement.h>
 #include <Kernel/kstdio.h>
@@ -45,14 +50,51 @@ struct ThreadReadyQueues {
     u32 mask {};
     static constexpr size_t count = sizeof(mask) * 8;
     Array<ThreadReadyQueue, count> queues;
+
+    // Threads in the fair scheduling class are ordered by their virtual runtime. As a whole,
+    // they take turns with the threads in the priority bucket of THREAD_PRIORITY_NORMAL.
+    IntrusiveRedBlackTree<&Thread::m_fair_queue_node> fair_queue;
+    u64 min_virtual_runtime { 0 };
+    bool prefer_fair_queue { false };
+};
+
+enum class RemoveFromQueue {
+    No,
+    Yes,
+};
+
+struct ProcessorReadyQueues {
+    Thread* find_runnable_thread(u32 affinity_mask, RemoveFromQueue, Optional<MonotonicTime> skip_cache_hot_threads_at = {});
+    bool remove(Thread&);
+    void append(Thread&, u32 processor_id);
+
+    RecursiveSpinlockProtected<ThreadReadyQueues, LockRank::None> ready_queues {};
+    // NOTE: This is only updated while holding the ready queue lock, but is read
+    //       without it when an idle processor is looking for a peer to steal from.
+    Atomic<u32, AK::MemoryOrder::memory_order_relaxed> thread_count { 0 };
 };
 
-static Singleton<RecursiveSpinlockProtected<ThreadReadyQueues, LockRank::None>> g_ready_queues;
+static Singleton<Array<ProcessorReadyQueues, MAX_CPU_COUNT>> g_ready_queues;
 
 static RecursiveSpinlockProtected<TotalTimeScheduled, LockRank::None> g_total_time_scheduled {};
 
+// Each processor only ever updates its own histogram, so the counters don't need to be shared.
+static Array<SchedulingLatencyHistogram, MAX_CPU_COUNT> s_scheduling_latency_histograms;
+
 static void dump_thread_list(bool = false);
 
+// A thread that was descheduled less than this long ago most likely still has
+// a warm cache on the processor it last ran on, so we avoid migrating it.
+static constexpr Duration cache_hot_threshold = Duration::from_milliseconds(8);
+
+static bool is_cache_hot(Thread const& thread, MonotonicTime now)
+{
+    auto last_descheduled_time = thread.last_descheduled_time();
+    if (!last_descheduled_time.has_value())
+        return false;
+    return now - last_descheduled_time.value() < cache_hot_threshold;
+}
+
 static inline u32 thread_priority_to_priority_index(u32 thread_priority)
 {
     // Converts the priority in the range of THREAD_PRIORITY_MIN...THREAD_PRIORITY_MAX
@@ -65,74 +107,249 @@ static inline u32 thread_priority_to_priority_index(u32 thread_priority)
     return priority_bucket;
 }
 
-Thread& Scheduler::pull_next_runnable_thread()
+static inline u32 fair_queue_priority_index()
+{
+    return thread_priority_to_priority_index(THREAD_PRIORITY_NORMAL);
+}
+
+static void remove_from_ready_queues(ThreadReadyQueues& ready_queues, Thread& thread)
+{
+    auto priority = thread.m_runnable_priority;
+    VERIFY(priority >= 0);
+    VERIFY(ready_queues.mask & (1u << priority));
+
+    auto& ready_queue = ready_queues.queues[priority];
+    if (thread.m_fair_queue_node.is_in_tree())
+        ready_queues.fair_queue.remove(thread);
+    else
+        ready_queue.thread_list.remove(thread);
+    thread.m_runnable_priority = -1;
+    thread.m_ready_queue_processor = -1;
+
+    bool bucket_is_empty = ready_queue.thread_list.is_empty();
+    if ((u32)priority == fair_queue_priority_index())
+        bucket_is_empty = bucket_is_empty && ready_queues.fair_queue.is_empty();
+    if (bucket_is_empty)
+        ready_queues.mask &= ~(1u << priority);
+}
+
+Thread* ProcessorReadyQueues::find_runnable_thread(u32 affinity_mask, RemoveFromQueue remove_from_queue, Optional<MonotonicTime> skip_cache_hot_threads_at)
 {
-    auto affinity_mask = 1u << Processor::current_id();
+    // Avoid taking a peer's lock if there is nothing for us to find there anyway.
+    if (thread_count == 0)
+        return nullptr;
+
+    return ready_queues.with([&](auto& ready_queues) -> Thread* {
+        auto is_eligible = [&](Thread& thread) {
+            if (thread.is_active())
+                return false;
+            if (!(thread.affinity() & affinity_mask))
+                return false;
+            if (skip_cache_hot_threads_at.has_value() && is_cache_hot(thread, skip_cache_hot_threads_at.value()))
+                return false;
+            return true;
+        };
+
+        auto find_in_list = [&](ThreadReadyQueue& ready_queue, u32 priority) -> Thread* {
+            for (auto& thread : ready_queue.thread_list) {
+                VERIFY(thread.m_runnable_priority == (int)priority);
+                if (is_eligible(thread))
+                    return &thread;
+            }
+            return nullptr;
+        };
+
+        auto find_in_fair_queue = [&]() -> Thread* {
+            // The fair queue is ordered by virtual runtime, so the first eligible thread
+            // is the one that has received the least processor time relative to its weight.
+            for (auto& thread : ready_queues.fair_queue) {
+                if (is_eligible(thread))
+                    return &thread;
+            }
+            return nullptr;
+        };
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread& {
         auto priority_mask = ready_queues.mask;
         while (priority_mask != 0) {
             auto priority = bit_scan_forward(priority_mask);
             VERIFY(priority > 0);
             auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                thread.m_runnable_priority = -1;
-                ready_queue.thread_list.remove(thread);
-                if (ready_queue.thread_list.is_empty())
-                    ready_queues.mask &= ~(1u << priority);
-                // Mark it as active because we are using this thread. This is similar
-                // to comparing it with Processor::current_thread, but when there are
-                // multiple processors there's no easy way to check whether the thread
-                // is actually still needed. This prevents accidental finalization when
-                // a thread is no longer in Running state, but running on another core.
-
-                // We need to mark it active here so that this thread won't be
-                // scheduled on another core if it were to be queued before actually
-                // switching to it.
-                // FIXME: Figure out a better way maybe?
-                thread.set_active(true);
+
+            Thread* thread = nullptr;
+            if (priority == fair_queue_priority_index()) {
+                if (ready_queues.prefer_fair_queue) {
+                    thread = find_in_fair_queue();
+                    if (!thread)
+                        thread = find_in_list(ready_queue, priority);
+                } else {
+                    thread = find_in_list(ready_queue, priority);
+                    if (!thread)
+                        thread = find_in_fair_queue();
+                }
+            } else {
+                thread = find_in_list(ready_queue, priority);
+            }
+
+            if (thread) {
+                if (remove_from_queue == RemoveFromQueue::No)
+                    return thread;
+                if (priority == fair_queue_priority_index()) {
+                    bool is_fair = thread->m_fair_queue_node.is_in_tree();
+                    // Let the other half of this bucket go next.
+                    ready_queues.prefer_fair_queue = !is_fair;
+                    if (is_fair)
+                        ready_queues.min_virtual_runtime = max(ready_queues.min_virtual_runtime, thread->m_virtual_runtime);
+                }
+                remove_from_ready_queues(ready_queues, *thread);
+                thread_count--;
                 return thread;
             }
             priority_mask &= ~(1u << priority);
         }
+        return nullptr;
+    });
+}
+
+bool ProcessorReadyQueues::remove(Thread& thread)
+{
+    return ready_queues.with([&](auto& ready_queues) {
+        if (thread.m_runnable_priority < 0) {
+            VERIFY(!thread.m_ready_queue_node.is_in_list());
+            VERIFY(!thread.m_fair_queue_node.is_in_tree());
+            return false;
+        }
 
-        auto* idle_thread = Processor::idle_thread();
-        idle_thread->set_active(true);
-        return *idle_thread;
+        remove_from_ready_queues(ready_queues, thread);
+        thread_count--;
+        return true;
     });
 }
 
-Thread* Scheduler::peek_next_runnable_thread()
+void ProcessorReadyQueues::append(Thread& thread, u32 processor_id)
 {
-    auto affinity_mask = 1u << Processor::current_id();
+    ready_queues.with([&](auto& ready_queues) {
+        VERIFY(thread.m_runnable_priority < 0);
+        VERIFY(thread.m_ready_queue_processor < 0);
+        VERIFY(!thread.m_ready_queue_node.is_in_list());
+        VERIFY(!thread.m_fair_queue_node.is_in_tree());
+
+        u32 priority;
+        // NOTE: While a fair thread inherits a priority, it has to be able to preempt the threads
+        //       waiting for it, so it is queued by its effective priority like any other thread.
+        if (thread.scheduling_class() == Thread::SchedulingClass::Fair && !thread.has_inherited_priority()) {
+            priority = fair_queue_priority_index();
+            // Don't let a thread that slept for a long time (or came from another processor)
+            // claim all the processor time it didn't use in the meantime.
+            thread.m_virtual_runtime = max(thread.m_virtual_runtime, ready_queues.min_virtual_runtime);
+            ready_queues.fair_queue.insert(thread.m_virtual_runtime, thread);
+        } else {
+            priority = thread_priority_to_priority_index(thread.effective_priority());
+            ready_queues.queues[priority].thread_list.append(thread);
+        }
+        thread.m_runnable_priority = (int)priority;
+        thread.m_ready_queue_processor = (int)processor_id;
+        thread_count++;
+        ready_queues.mask |= (1u << priority);
+    });
+}
 
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread* {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                return &thread;
-            }
-            priority_mask &= ~(1u << priority);
+static Thread* steal_runnable_thread(u32 processor_id)
+{
+    auto affinity_mask = 1u << processor_id;
+    auto processor_count = Processor::count();
+
+    // Try the busiest peer first, since that is where a stolen thread frees up the most time.
+    Optional<u32> busiest_processor_id;
+    u32 busiest_thread_count = 0;
+    for (u32 peer_id = 0; peer_id < processor_count; peer_id++) {
+        if (peer_id == processor_id)
+            continue;
+        u32 thread_count = (*g_ready_queues)[peer_id].thread_count;
+        if (thread_count > busiest_thread_count) {
+            busiest_processor_id = peer_id;
+            busiest_thread_count = thread_count;
         }
+    }
+    if (!busiest_processor_id.has_value())
+        return nullptr;
 
-        // Unlike in pull_next_runnable_thread() we don't want to fall back to
-        // the idle thread. We just want to see if we have any other thread ready
-        // to be scheduled.
+    auto try_steal = [&](Optional<MonotonicTime> skip_cache_hot_threads_at) -> Thread* {
+        if (auto* thread = (*g_ready_queues)[*busiest_processor_id].find_runnable_thread(affinity_mask, RemoveFromQueue::Yes, skip_cache_hot_threads_at))
+            return thread;
+
+        // Everything queued on the busiest peer may be pinned to it, so fall back to the others.
+        for (u32 peer_id = 0; peer_id < processor_count; peer_id++) {
+            if (peer_id == processor_id || peer_id == *busiest_processor_id)
+                continue;
+            if (auto* thread = (*g_ready_queues)[peer_id].find_runnable_thread(affinity_mask, RemoveFromQueue::Yes, skip_cache_hot_threads_at))
+                return thread;
+        }
         return nullptr;
-    });
+    };
+
+    // Leave threads with a warm cache where they are if we can, and only take one
+    // of them if nothing else is available, since running it here still beats idling.
+    if (auto* thread = try_steal(TimeManagement::the().monotonic_time(TimePrecision::Coarse)))
+        return thread;
+    return try_steal({});
+}
+
+static u32 processor_for_runnable_thread(Thread const& thread)
+{
+    auto processor_count = max(Processor::count(), 1u);
+    auto allowed_mask = thread.affinity();
+    if (processor_count < 32)
+        allowed_mask &= (1u << processor_count) - 1;
+    VERIFY(allowed_mask != 0);
+
+    // If the thread ran recently, put it back on the processor it last ran on so
+    // that it can pick up where it left off with a warm cache.
+    auto last_processor_id = thread.cpu();
+    if ((allowed_mask & (1u << last_processor_id)) && is_cache_hot(thread, TimeManagement::the().monotonic_time(TimePrecision::Coarse)))
+        return last_processor_id;
+
+    // Otherwise prefer the current processor, which is usually the one that just
+    // woke the thread up. Idle peers will steal the thread if this processor is busy.
+    auto current_id = Processor::current_id();
+    if (allowed_mask & (1u << current_id))
+        return current_id;
+
+    return bit_scan_forward(allowed_mask) - 1;
+}
+
+Thread& Scheduler::pull_next_runnable_thread()
+{
+    auto processor_id = Processor::current_id();
+
+    auto* thread = (*g_ready_queues)[processor_id].find_runnable_thread(1u << processor_id, RemoveFromQueue::Yes);
+    if (!thread)
+        thread = steal_runnable_thread(processor_id);
+
+    if (!thread)
+        thread = Processor::idle_thread();
+
+    // Mark it as active because we are using this thread. This is similar
+    // to comparing it with Processor::current_thread, but when there are
+    // multiple processors there's no easy way to check whether the thread
+    // is actually still needed. This prevents accidental finalization when
+    // a thread is no longer in Running state, but running on another core.
+
+    // We need to mark it active here so that this thread won't be
+    // scheduled on another core if it were to be queued before actually
+    // switching to it.
+    // FIXME: Figure out a better way maybe?
+    thread->set_active(true);
+    return *thread;
+}
+
+Thread* Scheduler::peek_next_runnable_thread()
+{
+    // Unlike in pull_next_runnable_thread() we don't want to fall back to
+    // the idle thread. We just want to see if we have any other thread ready
+    // to be scheduled on this processor. Threads queued on busy peers will be
+    // picked up by idle processors stealing from them.
+    auto processor_id = Processor::current_id();
+    return (*g_ready_queues)[processor_id].find_runnable_thread(1u << processor_id, RemoveFromQueue::No);
 }
 
 bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
@@ -140,24 +357,17 @@ bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
     if (thread.is_idle_thread())
         return true;
 
-    return g_ready_queues->with([&](auto& ready_queues) {
-        auto priority = thread.m_runnable_priority;
-        if (priority < 0) {
-            VERIFY(!thread.m_ready_queue_node.is_in_list());
-            return false;
-        }
+    if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
+        return false;
 
-        if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
-            return false;
+    auto processor_id = thread.m_ready_queue_processor;
+    if (processor_id < 0) {
+        VERIFY(thread.m_runnable_priority < 0);
+        VERIFY(!thread.m_ready_queue_node.is_in_list());
+        return false;
+    }
 
-        VERIFY(ready_queues.mask & (1u << priority));
-        auto& ready_queue = ready_queues.queues[priority];
-        thread.m_runnable_priority = -1;
-        ready_queue.thread_list.remove(thread);
-        if (ready_queue.thread_list.is_empty())
-            ready_queues.mask &= ~(1u << priority);
-        return true;
-    });
+    return (*g_ready_queues)[processor_id].remove(thread);
 }
 
 void Scheduler::enqueue_runnable_thread(Thread& thread)
@@ -165,18 +375,21 @@ void Scheduler::enqueue_runnable_thread(Thread& thread)
     VERIFY(g_scheduler_lock.is_locked_by_current_processor());
     if (thread.is_idle_thread())
         return;
-    auto priority = thread_priority_to_priority_index(thread.priority());
+    auto processor_id = processor_for_runnable_thread(thread);
+    (*g_ready_queues)[processor_id].append(thread, processor_id);
+}
 
-    g_ready_queues->with([&](auto& ready_queues) {
-        VERIFY(thread.m_runnable_priority < 0);
-        thread.m_runnable_priority = (int)priority;
-        VERIFY(!thread.m_ready_queue_node.is_in_list());
-        auto& ready_queue = ready_queues.queues[priority];
-        bool was_empty = ready_queue.thread_list.is_empty();
-        ready_queue.thread_list.append(thread);
-        if (was_empty)
-            ready_queues.mask |= (1u << priority);
-    });
+void Scheduler::set_inherited_priority(Thread& thread, u32 priority)
+{
+    SpinlockLocker lock(g_scheduler_lock);
+    if (thread.m_inherited_priority == priority)
+        return;
+
+    // A queued thread has to be moved to the ready queue matching its new effective priority.
+    bool was_queued = dequeue_runnable_thread(thread);
+    thread.m_inherited_priority = priority;
+    if (was_queued)
+        enqueue_runnable_thread(thread);
 }
 
 UNMAP_AFTER_INIT void Scheduler::start()
@@ -270,6 +483,23 @@ ShouldYield Scheduler::context_switch(Thread* thread)
     if (from_thread == thread)
         return ShouldYield::No;
 
+    // Remember when the previous thread stopped running, so we can tell whether
+    // its cache might still be warm when it becomes runnable again.
+    if (!from_thread->is_idle_thread())
+        from_thread->m_last_descheduled_time = TimeManagement::the().monotonic_time(TimePrecision::Coarse);
+
+    // Charge the previous thread for the time it just ran before it gets queued again, weighted
+    // by its priority so that higher priority threads accumulate virtual runtime more slowly.
+    auto scheduler_time = TimeManagement::scheduler_current_time();
+    if (from_thread->scheduling_class() == Thread::SchedulingClass::Fair && scheduler_time > from_thread->m_last_time_switched_in) {
+        auto time_ran = scheduler_time - from_thread->m_last_time_switched_in;
+        from_thread->m_virtual_runtime += time_ran * THREAD_PRIORITY_NORMAL / from_thread->priority();
+    }
+    thread->m_last_time_switched_in = scheduler_time;
+
+    auto& proc = Processor::current();
+    record_scheduling_latency(*thread, proc.id());
+
     // If the last process hasn't blocked (still marked as running),
     // mark it as runnable for the next round, unless it's supposed
     // to be stopped, in which case just mark it as such.
@@ -288,7 +518,9 @@ ShouldYield Scheduler::context_switch(Thread* thread)
         thread->tid().value(), thread->priority(), thread->regs().ip());
 #endif
 
-    auto& proc = Processor::current();
+    if (thread->m_last_descheduled_time.has_value() && thread->cpu() != proc.id())
+        thread->m_migration_count++;
+
     if (!thread->is_initialized()) {
         proc.init_context(*thread, false);
         thread->set_initialized(true);
@@ -296,6 +528,7 @@ ShouldYield Scheduler::context_switch(Thread* thread)
     thread->set_state(Thread::State::Running);
 
     PerformanceManager::add_context_switch_perf_event(*from_thread, *thread);
+    TRACEPOINT(scheduler_switch, thread->tid().value(), thread->priority());
 
     proc.switch_context(from_thread, thread);
 
@@ -304,6 +537,11 @@ ShouldYield Scheduler::context_switch(Thread* thread)
     enter_current(*from_thread);
     VERIFY(thread == Thread::current());
 
+    // Now that we're back on the stack of the thread that was waiting, the event's backtrace
+    // shows where it had been waiting to run.
+    if (auto latency_ns = exchange(thread->m_pending_scheduling_latency_ns, 0); latency_ns != 0)
+        PerformanceManager::add_scheduling_latency_perf_event(*thread, latency_ns);
+
     {
         SpinlockLocker lock(thread->get_lock());
         return thread->dispatch_one_pending_signal() == DispatchSignalResult::Yield ? ShouldYield::Yes : ShouldYield::No;
@@ -409,6 +647,55 @@ UNMAP_AFTER_INIT Thread* Scheduler::create_ap_idle_thread(u32 cpu)
     return idle_thread;
 }
 
+size_t SchedulingLatencyHistogram::bucket_for_latency(u64 latency_ns)
+{
+    auto latency_us = latency_ns / 1000;
+    if (latency_us == 0)
+        return 0;
+    auto bucket = static_cast<size_t>(64 - count_leading_zeroes(latency_us));
+    return min(bucket, bucket_count - 1);
+}
+
+u64 SchedulingLatencyHistogram::bucket_upper_bound_us(size_t bucket)
+{
+    VERIFY(bucket < bucket_count);
+    if (bucket == bucket_count - 1)
+        return 0;
+    return 1ull << bucket;
+}
+
+SchedulingLatencyHistogram const& Scheduler::scheduling_latency_histogram(u32 cpu)
+{
+    VERIFY(cpu < MAX_CPU_COUNT);
+    return s_scheduling_latency_histograms[cpu];
+}
+
+void Scheduler::record_scheduling_latency(Thread& thread, u32 cpu)
+{
+    VERIFY(g_scheduler_lock.is_locked_by_current_processor());
+
+    // Threads that were never made runnable (like a processor's idle thread) have nothing to report.
+    auto runnable_since = exchange(thread.m_runnable_since, {});
+    if (!runnable_since.has_value() || thread.is_idle_thread())
+        return;
+
+    auto now = TimeManagement::the().monotonic_time(TimePrecision::Precise);
+    if (now <= runnable_since.value())
+        return;
+    auto latency_ns = static_cast<u64>((now - runnable_since.value()).to_nanoseconds());
+
+    thread.m_scheduling_latency_count++;
+    thread.m_scheduling_latency_total_ns += latency_ns;
+    thread.m_scheduling_latency_max_ns = max(thread.m_scheduling_latency_max_ns, latency_ns);
+    thread.m_pending_scheduling_latency_ns = latency_ns;
+
+    auto& histogram = s_scheduling_latency_histograms[cpu];
+    histogram.buckets[SchedulingLatencyHistogram::bucket_for_latency(latency_ns)]++;
+    histogram.total_ns += latency_ns;
+    if (latency_ns > histogram.max_ns.load())
+        histogram.max_ns = latency_ns;
+}
+
 void Scheduler::add_time_scheduled(u64 time_to_add, bool is_kernel)
 {
     g_total_time_scheduled.with([&](auto& total_time_scheduled) {
@@ -493,8 +780,30 @@ void Scheduler::idle_loop(void*)
     VERIFY(Processor::are_interrupts_enabled());
 
     for (;;) {
+        // Use the idle time to zero free pages, so that page faults don't have to do it themselves.
+        for (;;) {
+            InterruptDisabler disabler;
+            if (peek_next_runnable_thread() || !MM.prezero_one_free_page())
+                break;
+        }
+
         proc.idle_begin();
-        proc.wait_for_interrupt();
+
+        // If tickless idle is enabled, stop the periodic tick while there is nothing to do.
+        // This has to happen with interrupts disabled, so that a wakeup arriving between
+        // checking the ready queue and halting can't be lost.
+        Processor::disable_interrupts();
+        if (peek_next_runnable_thread()) {
+            Processor::enable_interrupts();
+        } else if (TimeManagement::the().stop_tick_for_idle()) {
+            proc.enable_interrupts_and_wait_for_interrupt();
+            InterruptDisabler disabler;
+            TimeManagement::the().restart_tick_after_idle();
+        } else {
+            Processor::enable_interrupts();
+            proc.wait_for_interrupt();
+        }
+
         proc.idle_end();
         VERIFY_INTERRUPTS_ENABLED();
         yield();
@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Assertions.h>
+#include <AK/Atomic.h>
 #include <AK/Function.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Types.h>
@@ -30,6 +32,21 @@ struct TotalTimeScheduled {
     u64 total_kernel { 0 };
 };
 
+// Time spent by threads between becoming runnable and actually getting to run.
+struct SchedulingLatencyHistogram {
+    // Bucket 0 counts delays below 1us, bucket n counts delays in [2^(n-1), 2^n) us,
+    // and the last bucket collects everything above that.
+    static constexpr size_t bucket_count = 24;
+
+    Array<Atomic<u64, AK::MemoryOrder::memory_order_relaxed>, bucket_count> buckets {};
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> total_ns { 0 };
+    Atomic<u64, AK::MemoryOrder::memory_order_relaxed> max_ns { 0 };
+
+    static size_t bucket_for_latency(u64 latency_ns);
+    // Exclusive upper bound of a bucket in microseconds, or 0 for the last, unbounded bucket.
+    static u64 bucket_upper_bound_us(size_t bucket);
+};
+
 enum class [[nodiscard]] ShouldYield {
     Yes,
     No,
@@ -57,10 +74,15 @@ public:
     static Thread* peek_next_runnable_thread();
     static bool dequeue_runnable_thread(Thread&, bool = false);
     static void enqueue_runnable_thread(Thread&);
+    static void set_inherited_priority(Thread&, u32);
     static void dump_scheduler_state(bool = false);
     static bool is_initialized();
     static TotalTimeScheduled get_total_time_scheduled();
     static void add_time_scheduled(u64, bool);
+    static SchedulingLatencyHistogram const& scheduling_latency_histogram(u32 cpu);
+
+private:
+    static void record_scheduling_latency(Thread&, u32 cpu);
 };
 
 }
@@ -4,7 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <Kernel/FileSystem/FileSystem.h>
+#include <Kernel/FileSystem/Inode.h>
 #include <Kernel/Sections.h>
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/SyncTask.h>
@@ -17,7 +17,9 @@ UNMAP_AFTER_INIT void SyncTask::spawn()
     MUST(Process::create_kernel_process("VFS Sync Task"sv, [] {
         dbgln("VFS SyncTask is running");
         while (!Process::current().is_dying()) {
-            FileSystem::sync();
+            // NOTE: Block-based filesystems write back their caches on their own writeback threads,
+            //       we only make sure the dirty inode metadata makes it into those caches.
+            Inode::sync_all();
             (void)Thread::current()->sleep(Duration::from_seconds(1));
         }
         Process::current().sys$exit(0);
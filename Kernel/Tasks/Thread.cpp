@@ -28,11 +28,14 @@
 #include <Kernel/Tasks/ScopedProcessList.h>
 #include <Kernel/Tasks/Thread.h>
 #include <Kernel/Tasks/ThreadTracer.h>
+#include <Kernel/Tasks/Tracepoints.h>
 #include <Kernel/Time/TimerQueue.h>
 #include <Kernel/kstdio.h>
 
 namespace Kernel {
 
+DEFINE_KMEM_CACHE(Thread)
+
 static Singleton<RecursiveSpinlockProtected<Thread::GlobalList, LockRank::None>> s_thread_list;
 
 RecursiveSpinlockProtected<Thread::GlobalList, LockRank::None>& Thread::all_instances()
@@ -1182,6 +1185,7 @@ ErrorOr<NonnullRefPtr<Thread>> Thread::clone(NonnullRefPtr<Process> process)
     m_signal_action_masks.span().copy_to(clone->m_signal_action_masks);
     clone->m_signal_mask = m_signal_mask;
     clone->m_arch_specific_data = m_arch_specific_data;
+    clone->m_scheduling_class = m_scheduling_class;
     return clone;
 }
 
@@ -1217,6 +1221,8 @@ void Thread::set_state(State new_state, u8 stop_signal)
     }
 
     if (m_state == Thread::State::Runnable) {
+        m_runnable_since = TimeManagement::the().monotonic_time(TimePrecision::Precise);
+        TRACEPOINT(scheduler_wakeup, tid().value(), 0);
         Scheduler::enqueue_runnable_thread(*this);
         Processor::smp_wake_n_idle_processors(1);
     } else if (m_state == Thread::State::Stopped) {
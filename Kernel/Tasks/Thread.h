@@ -11,6 +11,7 @@
 #include <AK/Error.h>
 #include <AK/FixedStringBuffer.h>
 #include <AK/IntrusiveList.h>
+#include <AK/IntrusiveRedBlackTree.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <AK/Platform.h>
@@ -25,6 +26,7 @@
 #include <Kernel/Arch/ThreadRegisters.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Forward.h>
+#include <Kernel/Heap/KmemCache.h>
 #include <Kernel/Library/KString.h>
 #include <Kernel/Library/ListedRefCounted.h>
 #include <Kernel/Library/LockWeakPtr.h>
@@ -59,11 +61,14 @@ class Thread
     , public LockWeakable<Thread> {
     AK_MAKE_NONCOPYABLE(Thread);
     AK_MAKE_NONMOVABLE(Thread);
+    KMEM_CACHE_ALLOCATED(Thread);
 
+    friend class FutexQueue;
     friend class Mutex;
     friend class Process;
     friend class Scheduler;
     friend struct ThreadReadyQueue;
+    friend struct ProcessorReadyQueues;
 
 public:
     static Thread* current()
@@ -83,6 +88,20 @@ public:
 
     void set_priority(u32 p) { m_priority = p; }
     u32 priority() const { return m_priority; }
+    // The priority this thread is scheduled with, which may be boosted by threads
+    // waiting for a priority-inheriting futex owned by this thread.
+    u32 effective_priority() const { return max(m_priority, m_inherited_priority); }
+    bool has_inherited_priority() const { return m_inherited_priority > m_priority; }
+
+    enum class SchedulingClass : u8 {
+        // Always run the runnable threads of the highest priority bucket, round robin.
+        Priority,
+        // Share the processor proportionally to the priority, based on the virtual runtime.
+        Fair,
+    };
+    // NOTE: A thread that is already queued switches its class the next time it is queued.
+    void set_scheduling_class(SchedulingClass scheduling_class) { m_scheduling_class = scheduling_class; }
+    SchedulingClass scheduling_class() const { return m_scheduling_class; }
 
     void detach()
     {
@@ -765,6 +784,11 @@ public:
 
     void did_schedule() { ++m_times_scheduled; }
     u32 times_scheduled() const { return m_times_scheduled; }
+    u32 migration_count() const { return m_migration_count; }
+    Optional<MonotonicTime> last_descheduled_time() const { return m_last_descheduled_time; }
+    u64 scheduling_latency_count() const { return m_scheduling_latency_count; }
+    u64 scheduling_latency_total_ns() const { return m_scheduling_latency_total_ns; }
+    u64 scheduling_latency_max_ns() const { return m_scheduling_latency_max_ns; }
 
     void resume_from_stopped();
 
@@ -1096,6 +1120,11 @@ private:
 
     IntrusiveListNode<Thread> m_process_thread_list_node;
     int m_runnable_priority { -1 };
+    int m_ready_queue_processor { -1 };
+    SchedulingClass m_scheduling_class { SchedulingClass::Priority };
+    IntrusiveRedBlackTreeNode<u64, Thread, RawPtr<Thread>> m_fair_queue_node;
+    u64 m_virtual_runtime { 0 };
+    u64 m_last_time_switched_in { 0 };
 
     friend class DeprecatedWaitQueue;
 
@@ -1175,6 +1204,13 @@ private:
     Atomic<u64> m_total_time_scheduled_kernel { 0 };
     u32 m_ticks_left { 0 };
     u32 m_times_scheduled { 0 };
+    u32 m_migration_count { 0 };
+    Optional<MonotonicTime> m_last_descheduled_time;
+    Optional<MonotonicTime> m_runnable_since;
+    u64 m_pending_scheduling_latency_ns { 0 };
+    u64 m_scheduling_latency_count { 0 };
+    u64 m_scheduling_latency_total_ns { 0 };
+    u64 m_scheduling_latency_max_ns { 0 };
     u32 m_ticks_in_user { 0 };
     u32 m_ticks_in_kernel { 0 };
     u32 m_pending_signals { 0 };
@@ -1191,6 +1227,7 @@ private:
     Kernel::Mutex* m_blocking_mutex { nullptr };
     u32 m_lock_requested_count { 0 };
     IntrusiveListNode<Thread> m_blocked_threads_list_node;
+    IntrusiveListNode<Thread> m_priority_inheriting_waiters_list_node;
     LockRank m_lock_rank_mask {};
     bool m_allocation_enabled { true };
     ArchSpecificThreadData m_arch_specific_data;
@@ -1228,6 +1265,7 @@ private:
     State m_state { Thread::State::Invalid };
     RecursiveSpinlockProtected<Name, LockRank::None> m_name;
     u32 m_priority { THREAD_PRIORITY_NORMAL };
+    u32 m_inherited_priority { 0 };
 
     bool m_dump_backtrace_on_finalization { false };
     bool m_should_die { false };
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Tasks/PerformanceManager.h>
+#include <Kernel/Tasks/Tracepoints.h>
+
+namespace Kernel {
+
+Array<bool, tracepoint_count> g_enabled_tracepoints {};
+
+void set_tracepoint_enabled(Tracepoint tracepoint, bool enabled)
+{
+    AK::atomic_store(&g_enabled_tracepoints[to_underlying(tracepoint)], enabled, AK::MemoryOrder::memory_order_relaxed);
+}
+
+StringView tracepoint_name(Tracepoint tracepoint)
+{
+    switch (tracepoint) {
+#define __ENUMERATE_TRACEPOINT(name) \
+    case Tracepoint::name:           \
+        return #name##sv;
+        ENUMERATE_TRACEPOINTS(__ENUMERATE_TRACEPOINT)
+#undef __ENUMERATE_TRACEPOINT
+    case Tracepoint::__Count:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void record_tracepoint(Tracepoint tracepoint, FlatPtr arg1, FlatPtr arg2)
+{
+    auto* current_thread = Thread::current();
+    if (!current_thread)
+        return;
+    PerformanceManager::add_tracepoint_event(*current_thread, tracepoint_name(tracepoint), arg1, arg2);
+}
+
+}
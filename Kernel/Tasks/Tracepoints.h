@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/StdLibExtras.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// Tracepoints are named spots in the kernel that record a PERF_EVENT_TRACEPOINT event with two arguments into the
+// current profile, once they're enabled through /sys/kernel/conf/tracepoints/. They're all disabled by default,
+// and a disabled tracepoint only costs a load and a branch that isn't taken.
+//
+// scheduler_switch: The current processor switches to another thread. (TID of that thread, its priority)
+// scheduler_wakeup: A thread becomes runnable. (TID of the thread, 0)
+// vfs_open: A path is opened. (open() options, mode)
+// vfs_read, vfs_write: A read or write on an open file description starts. (offset, size)
+// block_request_start: A request to a block device is handed to the driver. (first block, block count)
+// block_request_finish: A request to a block device finishes. (first block, AsyncDeviceRequest::RequestResult)
+// net_receive, net_transmit: A network adapter receives or sends a packet. (size, 0)
+#define ENUMERATE_TRACEPOINTS(T) \
+    T(scheduler_switch)          \
+    T(scheduler_wakeup)          \
+    T(vfs_open)                  \
+    T(vfs_read)                  \
+    T(vfs_write)                 \
+    T(block_request_start)       \
+    T(block_request_finish)      \
+    T(net_receive)               \
+    T(net_transmit)
+
+enum class Tracepoint : u8 {
+#define __ENUMERATE_TRACEPOINT(name) name,
+    ENUMERATE_TRACEPOINTS(__ENUMERATE_TRACEPOINT)
+#undef __ENUMERATE_TRACEPOINT
+    __Count,
+};
+
+static constexpr size_t tracepoint_count = to_underlying(Tracepoint::__Count);
+
+extern Array<bool, tracepoint_count> g_enabled_tracepoints;
+
+ALWAYS_INLINE bool is_tracepoint_enabled(Tracepoint tracepoint)
+{
+    return AK::atomic_load(&g_enabled_tracepoints[to_underlying(tracepoint)], AK::MemoryOrder::memory_order_relaxed);
+}
+
+void set_tracepoint_enabled(Tracepoint, bool);
+StringView tracepoint_name(Tracepoint);
+
+void record_tracepoint(Tracepoint, FlatPtr arg1, FlatPtr arg2);
+
+#define TRACEPOINT(name, arg1, arg2)                                                         \
+    do {                                                                                     \
+        if (::Kernel::is_tracepoint_enabled(::Kernel::Tracepoint::name)) [[unlikely]]        \
+            ::Kernel::record_tracepoint(::Kernel::Tracepoint::name, (arg1), (arg2));         \
+    } while (0)
+
+}
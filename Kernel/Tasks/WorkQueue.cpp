@@ -6,6 +6,7 @@
  */
 
 #include <Kernel/Arch/Processor.h>
+#include <Kernel/Library/KString.h>
 #include <Kernel/Sections.h>
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/WorkQueue.h>
@@ -14,44 +15,93 @@ namespace Kernel {
 
 WorkQueue* g_io_work;
 WorkQueue* g_ata_work;
+WorkQueue* g_read_ahead_work;
+WorkQueue* g_io_ring_work;
 
 UNMAP_AFTER_INIT void WorkQueue::initialize()
 {
-    g_io_work = new WorkQueue("IO WorkQueue Task"sv);
-    g_ata_work = new WorkQueue("ATA WorkQueue Task"sv);
+    g_io_work = new WorkQueue("IO WorkQueue Task"sv, PerProcessor::Yes);
+    g_ata_work = new WorkQueue("ATA WorkQueue Task"sv, PerProcessor::No);
+    // NOTE: Reading ahead blocks on I/O requests that are completed on g_io_work, so it needs its own queue.
+    g_read_ahead_work = new WorkQueue("Read-ahead WorkQueue Task"sv, PerProcessor::No);
+    // NOTE: I/O ring operations block on I/O as well, and there should be plenty of them in flight at once.
+    g_io_ring_work = new WorkQueue("IORing WorkQueue Task"sv, 8);
 }
 
-UNMAP_AFTER_INIT WorkQueue::WorkQueue(StringView name)
+UNMAP_AFTER_INIT WorkQueue::WorkQueue(StringView name, PerProcessor per_processor)
 {
-    auto [_, thread] = Process::create_kernel_process(name, [this] {
-        while (!Process::current().is_dying()) {
-            WorkItem* item;
-            bool have_more;
-            m_items.with([&](auto& items) {
-                item = items.take_first();
-                have_more = !items.is_empty();
-            });
-            if (item) {
-                item->function();
-                delete item;
-
-                if (have_more)
-                    continue;
+    create_lanes(name, per_processor == PerProcessor::Yes ? min(static_cast<size_t>(Processor::count()), max_lane_count) : 1, per_processor);
+}
+
+UNMAP_AFTER_INIT WorkQueue::WorkQueue(StringView name, size_t lane_count)
+    : m_spread_over_lanes(true)
+{
+    create_lanes(name, min(lane_count, max_lane_count), PerProcessor::No);
+}
+
+UNMAP_AFTER_INIT void WorkQueue::create_lanes(StringView name, size_t lane_count, PerProcessor per_processor)
+{
+    m_lane_count = lane_count;
+
+    for (size_t lane_index = 0; lane_index < m_lane_count; ++lane_index) {
+        m_lanes[lane_index] = adopt_own_if_nonnull(new (nothrow) Lane);
+        VERIFY(m_lanes[lane_index]);
+        auto& lane = *m_lanes[lane_index];
+
+        OwnPtr<KString> lane_name;
+        u32 affinity = THREAD_AFFINITY_DEFAULT;
+        if (per_processor == PerProcessor::Yes || m_spread_over_lanes)
+            lane_name = MUST(KString::formatted("{} #{}", name, lane_index));
+        if (per_processor == PerProcessor::Yes)
+            affinity = 1u << lane_index;
+
+        auto run_work_items = [&lane] {
+            while (!Process::current().is_dying()) {
+                // Take everything that has been queued so far in one go, so producers
+                // queueing while we are running work items don't contend with us.
+                WorkItemList items_to_run;
+                lane.items.with([&](auto& items) {
+                    while (auto* item = items.take_first())
+                        items_to_run.append(*item);
+                });
+                while (auto* item = items_to_run.take_first()) {
+                    item->function();
+                    delete item;
+                }
+                MUST(lane.wait_queue.wait_until(lane.items, [](auto& items) -> bool { return !items.is_empty(); }));
             }
-            MUST(m_wait_queue.wait_until(m_items, [](auto& items) -> bool { return !items.is_empty(); }));
-        }
-        Process::current().sys$exit(0);
-        VERIFY_NOT_REACHED();
-    }).release_value_but_fixme_should_propagate_errors();
-    m_thread = move(thread);
+            Process::current().sys$exit(0);
+            VERIFY_NOT_REACHED();
+        };
+        auto [_, thread] = Process::create_kernel_process(lane_name ? lane_name->view() : name, move(run_work_items), affinity).release_value_but_fixme_should_propagate_errors();
+        lane.thread = move(thread);
+    }
+}
+
+WorkQueue::Lane& WorkQueue::lane_for_current_processor()
+{
+    return *m_lanes[Processor::current_id() % m_lane_count];
 }
 
 void WorkQueue::do_queue(WorkItem& item)
 {
-    m_items.with([&](auto& items) {
+    auto& lane = m_spread_over_lanes ? *m_lanes[m_next_lane.fetch_add(1, AK::memory_order_relaxed) % m_lane_count] : lane_for_current_processor();
+    lane.items.with([&](auto& items) {
         items.append(item);
     });
-    m_wait_queue.notify_one();
+    lane.wait_queue.notify_one();
+}
+
+void WorkQueue::queue(Batch& batch)
+{
+    if (batch.is_empty())
+        return;
+    auto& lane = lane_for_current_processor();
+    lane.items.with([&](auto& items) {
+        while (auto* item = batch.m_items.take_first())
+            items.append(*item);
+    });
+    lane.wait_queue.notify_one();
 }
 
 }
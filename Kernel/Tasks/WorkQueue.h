@@ -7,8 +7,12 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <AK/Error.h>
 #include <AK/IntrusiveList.h>
+#include <AK/OwnPtr.h>
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/Forward.h>
 #include <Kernel/Locking/SpinlockProtected.h>
 #include <Kernel/Tasks/WaitQueue.h>
@@ -17,14 +21,52 @@ namespace Kernel {
 
 extern WorkQueue* g_io_work;
 extern WorkQueue* g_ata_work;
+extern WorkQueue* g_read_ahead_work;
+extern WorkQueue* g_io_ring_work;
 
 class WorkQueue {
     AK_MAKE_NONCOPYABLE(WorkQueue);
     AK_MAKE_NONMOVABLE(WorkQueue);
 
+    struct WorkItem {
+    public:
+        IntrusiveListNode<WorkItem> m_node;
+        Function<void()> function;
+    };
+    using WorkItemList = IntrusiveList<&WorkItem::m_node>;
+
 public:
     static void initialize();
 
+    // Collects work items so they can be handed to a WorkQueue with a single lock
+    // acquisition and a single wakeup, e.g. when completing multiple requests from
+    // one interrupt.
+    class Batch {
+        AK_MAKE_NONCOPYABLE(Batch);
+        AK_MAKE_NONMOVABLE(Batch);
+
+    public:
+        Batch() = default;
+        ~Batch() { VERIFY(m_items.is_empty()); }
+
+        template<typename Function>
+        ErrorOr<void> try_append(Function function)
+        {
+            auto item = new (nothrow) WorkItem; // TODO: use a pool
+            if (!item)
+                return Error::from_errno(ENOMEM);
+            item->function = Function(function);
+            m_items.append(*item);
+            return {};
+        }
+
+        [[nodiscard]] bool is_empty() const { return m_items.is_empty(); }
+
+    private:
+        friend class WorkQueue;
+        WorkItemList m_items;
+    };
+
     ErrorOr<void> try_queue(void (*function)(void*), void* data = nullptr, void (*free_data)(void*) = nullptr)
     {
         auto item = new (nothrow) WorkItem; // TODO: use a pool
@@ -50,20 +92,39 @@ public:
         return {};
     }
 
+    void queue(Batch&);
+
 private:
-    explicit WorkQueue(StringView);
+    enum class PerProcessor {
+        No,
+        Yes,
+    };
+    WorkQueue(StringView, PerProcessor);
+    // Spreads work items over the lanes in turn, so work items that block for a while don't hold up
+    // the ones that were queued right after them.
+    WorkQueue(StringView, size_t lane_count);
 
-    struct WorkItem {
-    public:
-        IntrusiveListNode<WorkItem> m_node;
-        Function<void()> function;
+    void create_lanes(StringView name, size_t lane_count, PerProcessor);
+
+    // Each lane is serviced by its own thread. Per-processor work queues have one lane
+    // for every processor (with the thread pinned to it), and work is queued to the lane
+    // of the processor that is queueing it.
+    struct Lane {
+        RefPtr<Thread> thread;
+        WaitQueue wait_queue;
+        SpinlockProtected<WorkItemList, LockRank::None> items {};
     };
 
+    // Thread affinity masks are 32 bits wide.
+    static constexpr size_t max_lane_count = min(MAX_CPU_COUNT, static_cast<size_t>(32));
+
+    Lane& lane_for_current_processor();
     void do_queue(WorkItem&);
 
-    RefPtr<Thread> m_thread;
-    WaitQueue m_wait_queue;
-    SpinlockProtected<IntrusiveList<&WorkItem::m_node>, LockRank::None> m_items {};
+    Array<OwnPtr<Lane>, max_lane_count> m_lanes;
+    size_t m_lane_count { 0 };
+    bool m_spread_over_lanes { false };
+    Atomic<size_t> m_next_lane { 0 };
 };
 
 }
@@ -28,6 +28,7 @@
 #endif
 
 #include <Kernel/Arch/CurrentTime.h>
+#include <Kernel/Arch/PerformanceCounters.h>
 #include <Kernel/Boot/CommandLine.h>
 #include <Kernel/Firmware/ACPI/Parser.h>
 #include <Kernel/Interrupts/InterruptDisabler.h>
@@ -218,6 +219,7 @@ UNMAP_AFTER_INIT void TimeManagement::initialize([[maybe_unused]] u32 cpu)
                 s_the->set_system_timer(*apic_timer);
             }
         }
+        s_the->m_tickless_idle_enabled = kernel_command_line().is_nohz_enabled();
     } else {
         VERIFY(s_the.is_initialized());
         if (auto* apic_timer = APIC::the().get_timer()) {
@@ -608,9 +610,48 @@ void TimeManagement::system_timer_tick()
         // Don't expire timers while handling IRQs
         TimerQueue::the().fire();
     }
+    PerformanceCounters::update_current_processor();
     Scheduler::timer_tick();
 }
 
+// Even without any pending timers we want to wake up every now and then, so that
+// the time keeper never misses a wraparound of its counter.
+static constexpr Duration max_tickless_idle_duration = Duration::from_seconds(1);
+
+bool TimeManagement::stop_tick_for_idle()
+{
+    VERIFY_INTERRUPTS_DISABLED();
+    if (!m_tickless_idle_enabled)
+        return false;
+#if ARCH(X86_64)
+    // The periodic tick is only per-processor when the local APIC timer drives it.
+    if (!APIC::initialized())
+        return false;
+    auto* apic_timer = APIC::the().get_timer();
+    if (!apic_timer || !is_system_timer(*apic_timer))
+        return false;
+
+    auto timeout = max_tickless_idle_duration;
+    if (auto time_until_next_timer_due = TimerQueue::the().time_until_next_timer_due(); time_until_next_timer_due.has_value())
+        timeout = min(timeout, time_until_next_timer_due.value());
+    apic_timer->enable_local_one_shot_timer(timeout);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void TimeManagement::restart_tick_after_idle()
+{
+#if ARCH(X86_64)
+    auto* apic_timer = APIC::the().get_timer();
+    VERIFY(apic_timer);
+    apic_timer->enable_local_timer();
+#else
+    VERIFY_NOT_REACHED();
+#endif
+}
+
 bool TimeManagement::enable_profile_timer()
 {
     if (!m_profile_timer)
@@ -67,6 +67,11 @@ public:
     bool enable_profile_timer();
     bool disable_profile_timer();
 
+    // Tickless idle: Replace the periodic tick of the current processor with a one-shot
+    // timer for the earliest pending timer expiry while it has nothing to run.
+    bool stop_tick_for_idle();
+    void restart_tick_after_idle();
+
     u64 uptime_ms() const;
     static UnixDateTime now();
 
@@ -113,6 +118,7 @@ private:
     u32 m_time_ticks_per_second { 0 }; // may be different from interrupts/second (e.g. hpet)
     SetOnce m_can_query_precise_time;
     bool m_updating_time { false }; // may only be accessed from the BSP!
+    bool m_tickless_idle_enabled { false };
 
     LockRefPtr<HardwareTimerBase> m_system_timer;
     LockRefPtr<HardwareTimerBase> m_time_keeper_timer;
@@ -219,6 +219,25 @@ void TimerQueue::fire()
         fire_timers(m_timer_queue_realtime);
 }
 
+Optional<Duration> TimerQueue::time_until_next_timer_due()
+{
+    SpinlockLocker lock(g_timerqueue_lock);
+
+    Optional<Duration> time_until_next_timer_due;
+    auto check_queue = [&](Queue& queue, clockid_t clock_id) {
+        if (queue.list.is_empty())
+            return;
+        auto time_until_due = queue.next_timer_due - TimeManagement::the().current_time(clock_id);
+        if (time_until_due.is_negative())
+            time_until_due = Duration::zero();
+        if (!time_until_next_timer_due.has_value() || time_until_due < time_until_next_timer_due.value())
+            time_until_next_timer_due = time_until_due;
+    };
+    check_queue(m_timer_queue_monotonic, CLOCK_MONOTONIC_COARSE);
+    check_queue(m_timer_queue_realtime, CLOCK_REALTIME_COARSE);
+    return time_until_next_timer_due;
+}
+
 void TimerQueue::update_next_timer_due(Queue& queue)
 {
     VERIFY(g_timerqueue_lock.is_locked());
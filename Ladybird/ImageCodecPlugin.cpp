@@ -16,7 +16,20 @@ namespace Ladybird {
 
 ImageCodecPlugin::~ImageCodecPlugin() = default;
 
-NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+static ImageDecoderClient::FrameDecoding to_image_decoder_client_frame_decoding(Web::Platform::FrameDecoding frame_decoding)
+{
+    switch (frame_decoding) {
+    case Web::Platform::FrameDecoding::AllFrames:
+        return ImageDecoderClient::FrameDecoding::AllFrames;
+    case Web::Platform::FrameDecoding::FirstFrameOnly:
+        return ImageDecoderClient::FrameDecoding::FirstFrameOnly;
+    case Web::Platform::FrameDecoding::OnDemand:
+        return ImageDecoderClient::FrameDecoding::OnDemand;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+ImageDecoderClient::Client& ImageCodecPlugin::client()
 {
     if (!m_client) {
         auto candidate_image_decoder_paths = get_paths_for_helper_process("ImageDecoder"sv).release_value_but_fixme_should_propagate_errors();
@@ -25,31 +38,112 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
             m_client = nullptr;
         };
     }
+    return *m_client;
+}
+
+// FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
+static Web::Platform::DecodedImage to_web_decoded_image(ImageDecoderClient::DecodedImage& result)
+{
+    Web::Platform::DecodedImage decoded_image;
+    decoded_image.image_id = result.image_id;
+    decoded_image.is_animated = result.is_animated;
+    decoded_image.loop_count = result.loop_count;
+    decoded_image.frame_count = result.frame_count;
+    for (auto& frame : result.frames) {
+        decoded_image.frames.empend(move(frame.bitmap), frame.duration);
+    }
+    return decoded_image;
+}
 
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Web::Platform::FrameDecoding frame_decoding, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+{
     auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
     if (on_resolved)
         promise->on_resolution = move(on_resolved);
     if (on_rejected)
         promise->on_rejection = move(on_rejected);
 
-    auto image_decoder_promise = m_client->decode_image(
+    auto image_decoder_promise = client().decode_image(
         bytes,
         [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
-            // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
-            Web::Platform::DecodedImage decoded_image;
-            decoded_image.is_animated = result.is_animated;
-            decoded_image.loop_count = result.loop_count;
-            for (auto& frame : result.frames) {
-                decoded_image.frames.empend(move(frame.bitmap), frame.duration);
-            }
-            promise->resolve(move(decoded_image));
+            promise->resolve(to_web_decoded_image(result));
             return {};
         },
         [promise](auto& error) {
             promise->reject(Error::copy(error));
-        });
+        },
+        {}, {}, to_image_decoder_client_frame_decoding(frame_decoding));
 
     return promise;
 }
 
+void ImageCodecPlugin::request_animation_frames(i64 image_id, u32 start_frame_index, u32 frame_count, AnimationFramesCallback on_decoded)
+{
+    if (!m_client)
+        return;
+
+    m_client->request_animation_frames(image_id, start_frame_index, frame_count, [on_decoded = move(on_decoded)](u32 start_frame_index, Vector<Optional<ImageDecoderClient::Frame>>& result) {
+        Vector<Web::Platform::Frame> frames;
+        frames.ensure_capacity(result.size());
+        for (auto& frame : result) {
+            if (frame.has_value())
+                frames.unchecked_append({ move(frame->bitmap), frame->duration });
+            else
+                frames.unchecked_append({});
+        }
+        on_decoded(start_frame_index, frames);
+    });
+}
+
+void ImageCodecPlugin::release_animated_image(i64 image_id)
+{
+    if (m_client)
+        m_client->release_animated_image(image_id);
+}
+
+Optional<i64> ImageCodecPlugin::begin_incremental_decode(PartialImageCallback on_partial_image)
+{
+    return client().begin_incremental_decode(move(on_partial_image));
+}
+
+void ImageCodecPlugin::append_incremental_data(i64 incremental_decode_id, ReadonlyBytes bytes)
+{
+    if (m_client)
+        m_client->append_incremental_data(incremental_decode_id, bytes);
+}
+
+NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::finish_incremental_decode(i64 incremental_decode_id, Web::Platform::FrameDecoding frame_decoding, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+{
+    auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
+    if (on_resolved)
+        promise->on_resolution = move(on_resolved);
+    if (on_rejected)
+        promise->on_rejection = move(on_rejected);
+
+    // The decoder went away since the decode began, and its data with it.
+    if (!m_client) {
+        promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
+        return promise;
+    }
+
+    auto image_decoder_promise = m_client->finish_incremental_decode(
+        incremental_decode_id,
+        [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
+            promise->resolve(to_web_decoded_image(result));
+            return {};
+        },
+        [promise](auto& error) {
+            promise->reject(Error::copy(error));
+        },
+        to_image_decoder_client_frame_decoding(frame_decoding));
+
+    return promise;
+}
+
+void ImageCodecPlugin::cancel_incremental_decode(i64 incremental_decode_id)
+{
+    if (m_client)
+        m_client->cancel_incremental_decode(incremental_decode_id);
+}
+
 }
@@ -17,9 +17,18 @@ public:
     ImageCodecPlugin() = default;
     virtual ~ImageCodecPlugin() override;
 
-    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Web::Platform::FrameDecoding, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
+    virtual void request_animation_frames(i64 image_id, u32 start_frame_index, u32 frame_count, AnimationFramesCallback) override;
+    virtual void release_animated_image(i64 image_id) override;
+
+    virtual Optional<i64> begin_incremental_decode(PartialImageCallback) override;
+    virtual void append_incremental_data(i64 incremental_decode_id, ReadonlyBytes) override;
+    virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> finish_incremental_decode(i64 incremental_decode_id, Web::Platform::FrameDecoding, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
+    virtual void cancel_incremental_decode(i64 incremental_decode_id) override;
 
 private:
+    ImageDecoderClient::Client& client();
+
     RefPtr<ImageDecoderClient::Client> m_client;
 };
 
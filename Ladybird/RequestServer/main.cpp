@@ -10,12 +10,14 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 #include <LibTLS/Certificate.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/GeminiProtocol.h>
 #include <RequestServer/HttpProtocol.h>
 #include <RequestServer/HttpsProtocol.h>
@@ -52,6 +54,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     DefaultRootCACertificates::set_default_certificate_paths(certificates.span());
     [[maybe_unused]] auto& certs = DefaultRootCACertificates::the();
 
+    auto disk_cache_directory = ByteString::formatted("{}/Ladybird/RequestServer", Core::StandardPaths::cache_directory());
+    if (auto result = RequestServer::DiskCache::initialize(disk_cache_directory); result.is_error())
+        dbgln("Failed to initialize the disk cache in {}: {}", disk_cache_directory, result.error());
+
     Core::EventLoop event_loop;
 
 #if defined(AK_OS_MACOS)
@@ -18,6 +18,7 @@
 #include <LibCore/SystemServerTakeover.h>
 #include <LibIPC/ConnectionFromClient.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/ProgramCache.h>
 #include <LibMain/Main.h>
 #include <LibProtocol/RequestClient.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
@@ -140,6 +141,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Web::Platform::FontPlugin::install(*new Ladybird::FontPlugin(is_layout_test_mode));
 
     TRY(Web::Bindings::initialize_main_thread_vm(Web::HTML::EventLoop::Type::Window));
+    Web::Bindings::main_thread_vm().program_cache().set_enabled(true);
 
     if (log_all_js_exceptions) {
         JS::g_log_all_js_exceptions = true;
@@ -73,6 +73,7 @@ set(WEB_RESOURCES
     newtab.html
 )
 set(WEB_TEMPLATES
+    cache.html
     directory.html
     error.html
     version.html
@@ -77,6 +77,7 @@ set(HPET_COMPARATOR_DEBUG ON)
 set(HPET_DEBUG ON)
 set(HTML_PARSER_DEBUG ON)
 set(HTML_SCRIPT_DEBUG ON)
+set(HTTP2_DEBUG ON)
 set(HTTPJOB_DEBUG ON)
 set(HUNKS_DEBUG ON)
 set(ICMPV6_DEBUG ON)
@@ -92,6 +93,7 @@ set(INTEL_HDA_DEBUG ON)
 set(INTERRUPT_DEBUG ON)
 set(IOAPIC_DEBUG ON)
 set(IO_DEBUG ON)
+set(IPC_MESSAGE_STATISTICS_DEBUG ON)
 set(IPV4_DEBUG ON)
 set(IPV4_SOCKET_DEBUG ON)
 set(IPV6_DEBUG ON)
@@ -106,6 +108,7 @@ set(JPEGXL_DEBUG ON)
 set(JPEG_DEBUG ON)
 set(JS_BYTECODE_DEBUG ON)
 set(JS_MODULE_DEBUG ON)
+set(JS_PROPERTY_LOOKUP_CACHE_DEBUG ON)
 set(KEYBOARD_DEBUG ON)
 set(KEYBOARD_SHORTCUTS_DEBUG ON)
 set(KMALLOC_DEBUG ON)
@@ -113,6 +116,7 @@ set(LANGUAGE_SERVER_DEBUG ON)
 set(LEXER_DEBUG ON)
 set(LIBWEB_CSS_ANIMATION_DEBUG ON)
 set(LIBWEB_CSS_DEBUG ON)
+set(LIBWEB_GPU_PAINTING_DEBUG ON)
 set(LINE_EDITOR_DEBUG ON)
 set(LOCAL_SOCKET_DEBUG ON)
 set(LOCK_DEBUG ON)
@@ -146,6 +150,7 @@ set(OCCLUSIONS_DEBUG ON)
 set(OFFD_DEBUG ON)
 set(OPENTYPE_GPOS_DEBUG ON)
 set(PAGE_FAULT_DEBUG ON)
+set(PAGE_RECLAIM_DEBUG ON)
 set(PATA_DEBUG ON)
 set(PATH_DEBUG ON)
 set(PCI_DEBUG ON)
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/Debug.h>
 #include <AK/Function.h>
 #include <AK/GenericLexer.h>
@@ -21,8 +22,29 @@ struct Parameter {
     Vector<ByteString> attributes;
     ByteString type;
     ByteString name;
+
+    // Parameters marked as [Borrowed] are handed to the handler as a view into the received message.
+    bool is_borrowed() const { return attributes.contains_slow("Borrowed"); }
+};
+
+struct BorrowedType {
+    StringView view_type;
+    StringView view_accessor;
 };
 
+static Optional<BorrowedType> borrowed_type(ByteString const& type)
+{
+    if (type == "String")
+        return BorrowedType { "StringView"sv, "bytes_as_string_view()"sv };
+    if (type == "ByteString")
+        return BorrowedType { "StringView"sv, "view()"sv };
+    if (type == "ByteBuffer")
+        return BorrowedType { "ReadonlyBytes"sv, "bytes()"sv };
+    if (type == "Vector<u8>")
+        return BorrowedType { "ReadonlyBytes"sv, "span()"sv };
+    return {};
+}
+
 static ByteString pascal_case(ByteString const& identifier)
 {
     StringBuilder builder;
@@ -170,6 +192,10 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
                 warnln("Parameter {} of method: {} must be named", parameter_index, message_name);
                 VERIFY_NOT_REACHED();
             }
+            if (parameter.is_borrowed() && !borrowed_type(parameter.type).has_value()) {
+                warnln("Parameter {} of method: {} has type {}, which can't be borrowed", parameter_index, message_name, parameter.type);
+                VERIFY_NOT_REACHED();
+            }
             VERIFY(!lexer.is_eof());
             consume_whitespace();
             parameter.name = lexer.consume_until([](char ch) { return isspace(ch) || ch == ',' || ch == ')'; });
@@ -219,6 +245,12 @@ Vector<Endpoint> parse(ByteBuffer const& file_contents)
             assert_specific('(');
             parse_parameters(message.outputs, message.name);
             assert_specific(')');
+
+            // Responses are taken out of the message by the caller, so they have to own their data.
+            if (any_of(message.outputs, [](auto const& parameter) { return parameter.is_borrowed(); })) {
+                warnln("Outputs of method: {} can't be borrowed", message.name);
+                VERIFY_NOT_REACHED();
+            }
         }
 
         consume_whitespace();
@@ -373,7 +405,7 @@ public:)~~~");
     static i32 static_message_id() { return (int)MessageID::@message.pascal_name@; }
     virtual const char* message_name() const override { return "@endpoint.name@::@message.pascal_name@"; }
 
-    static ErrorOr<NonnullOwnPtr<@message.pascal_name@>> decode(Stream& stream, Queue<IPC::File>& files)
+    static ErrorOr<NonnullOwnPtr<@message.pascal_name@>> decode(FixedMemoryStream& stream, Queue<IPC::File>& files)
     {
         IPC::Decoder decoder { stream, files };)~~~");
 
@@ -388,10 +420,14 @@ public:)~~~");
         else
             parameter_generator.set("parameter.initial_value", "{}");
 
+        if (parameter.is_borrowed())
+            parameter_generator.set("parameter.type", borrowed_type(parameter.type)->view_type);
+
         parameter_generator.appendln(R"~~~(
         auto @parameter.name@ = TRY((decoder.decode<@parameter.type@>()));)~~~");
 
-        if (parameter.attributes.contains_slow("UTF8")) {
+        // Decoding a String validates it, which decoding a view of one doesn't.
+        if (parameter.attributes.contains_slow("UTF8") || (parameter.is_borrowed() && parameter.type == "String")) {
             parameter_generator.appendln(R"~~~(
         if (!Utf8View(@parameter.name@).validate())
             return Error::from_string_literal("Decoded @parameter.name@ is invalid UTF-8");)~~~");
@@ -401,15 +437,36 @@ public:)~~~");
     StringBuilder builder;
     for (size_t i = 0; i < parameters.size(); ++i) {
         auto const& parameter = parameters[i];
-        builder.appendff("move({})", parameter.name);
+        if (parameter.is_borrowed())
+            builder.appendff("{} {{}}", parameter.type);
+        else
+            builder.appendff("move({})", parameter.name);
         if (i != parameters.size() - 1)
             builder.append(", "sv);
     }
 
     message_generator.set("message.constructor_call_parameters", builder.to_byte_string());
-    message_generator.appendln(R"~~~(
+    if (any_of(parameters, [](auto const& parameter) { return parameter.is_borrowed(); })) {
+        message_generator.appendln(R"~~~(
+        auto message = make<@message.pascal_name@>(@message.constructor_call_parameters@);)~~~");
+
+        for (auto const& parameter : parameters) {
+            if (!parameter.is_borrowed())
+                continue;
+            auto parameter_generator = message_generator.fork();
+            parameter_generator.set("parameter.name", parameter.name);
+            parameter_generator.appendln(R"~~~(
+        message->m_@parameter.name@_borrowed = @parameter.name@;)~~~");
+        }
+
+        message_generator.appendln(R"~~~(
+        return message;
+    })~~~");
+    } else {
+        message_generator.appendln(R"~~~(
         return make<@message.pascal_name@>(@message.constructor_call_parameters@);
     })~~~");
+    }
 
     message_generator.appendln(R"~~~(
     virtual bool valid() const override { return m_ipc_message_valid; }
@@ -427,8 +484,13 @@ public:)~~~");
         auto parameter_generator = message_generator.fork();
 
         parameter_generator.set("parameter.name", parameter.name);
-        parameter_generator.appendln(R"~~~(
+        if (parameter.is_borrowed()) {
+            parameter_generator.appendln(R"~~~(
+        TRY(stream.encode(@parameter.name@()));)~~~");
+        } else {
+            parameter_generator.appendln(R"~~~(
         TRY(stream.encode(m_@parameter.name@));)~~~");
+        }
     }
 
     message_generator.appendln(R"~~~(
@@ -439,6 +501,14 @@ public:)~~~");
         auto parameter_generator = message_generator.fork();
         parameter_generator.set("parameter.type", parameter.type);
         parameter_generator.set("parameter.name", parameter.name);
+        if (parameter.is_borrowed()) {
+            auto borrowed = borrowed_type(parameter.type).value();
+            parameter_generator.set("parameter.view_type", borrowed.view_type);
+            parameter_generator.set("parameter.view_accessor", borrowed.view_accessor);
+            parameter_generator.appendln(R"~~~(
+    @parameter.view_type@ @parameter.name@() const { return m_@parameter.name@_borrowed.has_value() ? *m_@parameter.name@_borrowed : m_@parameter.name@.@parameter.view_accessor@; })~~~");
+            continue;
+        }
         parameter_generator.appendln(R"~~~(
     const @parameter.type@& @parameter.name@() const { return m_@parameter.name@; }
     @parameter.type@ take_@parameter.name@() { return move(m_@parameter.name@); })~~~");
@@ -454,6 +524,12 @@ private:
         parameter_generator.set("parameter.name", parameter.name);
         parameter_generator.appendln(R"~~~(
     @parameter.type@ m_@parameter.name@ {};)~~~");
+
+        if (parameter.is_borrowed()) {
+            parameter_generator.set("parameter.view_type", borrowed_type(parameter.type)->view_type);
+            parameter_generator.appendln(R"~~~(
+    Optional<@parameter.view_type@> m_@parameter.name@_borrowed;)~~~");
+        }
     }
 
     message_generator.appendln("\n};");
@@ -750,7 +826,11 @@ public:
             message_generator.appendln(R"~~~(
     virtual @message.complex_return_type@ @handler_name@()~~~");
 
-            auto make_argument_type = [](ByteString const& type) {
+            auto make_argument_type = [](Parameter const& parameter) {
+                if (parameter.is_borrowed())
+                    return ByteString { borrowed_type(parameter.type)->view_type };
+
+                auto const& type = parameter.type;
                 StringBuilder builder;
 
                 bool const_ref = !is_primitive_or_simple_type(type);
@@ -765,7 +845,7 @@ public:
             for (size_t i = 0; i < parameters.size(); ++i) {
                 auto const& parameter = parameters[i];
                 auto argument_generator = message_generator.fork();
-                argument_generator.set("argument.type", make_argument_type(parameter.type));
+                argument_generator.set("argument.type", make_argument_type(parameter));
                 argument_generator.set("argument.name", parameter.name);
                 argument_generator.append("[[maybe_unused]] @argument.type@ @argument.name@");
                 if (i != parameters.size() - 1)
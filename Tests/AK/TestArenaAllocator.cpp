@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ArenaAllocator.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/Vector.h>
+
+TEST_CASE(arena_vector)
+{
+    Arena arena;
+    ArenaScope scope(arena);
+
+    ArenaVector<int> numbers;
+    for (int i = 0; i < 10000; ++i)
+        numbers.append(i);
+
+    EXPECT_EQ(numbers.size(), 10000u);
+    for (int i = 0; i < 10000; ++i)
+        EXPECT_EQ(numbers[i], i);
+    EXPECT(arena.bytes_allocated() >= 10000 * sizeof(int));
+
+    numbers.remove(0, 5000);
+    EXPECT_EQ(numbers.first(), 5000);
+}
+
+TEST_CASE(arena_vector_with_non_trivial_elements)
+{
+    Arena arena;
+    ArenaScope scope(arena);
+
+    ArenaVector<ByteString, 4> strings;
+    for (int i = 0; i < 100; ++i)
+        strings.append(ByteString::number(i));
+    EXPECT_EQ(strings[42], "42"sv);
+
+    // Copying into a regular vector keeps the contents around after the arena is gone.
+    Vector<ByteString> copy = strings;
+    EXPECT_EQ(copy.size(), 100u);
+    EXPECT_EQ(copy[99], "99"sv);
+}
+
+TEST_CASE(arena_hash_table_and_map)
+{
+    Arena arena;
+    ArenaScope scope(arena);
+
+    ArenaHashTable<int> table;
+    for (int i = 0; i < 1000; ++i)
+        table.set(i);
+    EXPECT_EQ(table.size(), 1000u);
+    EXPECT(table.contains(500));
+    EXPECT(table.remove(500));
+    EXPECT(!table.contains(500));
+
+    ArenaHashMap<ByteString, int> map;
+    for (int i = 0; i < 1000; ++i)
+        map.set(ByteString::number(i), i);
+    EXPECT_EQ(map.size(), 1000u);
+    EXPECT_EQ(map.get("123"sv), 123);
+    EXPECT(!map.get("1000"sv).has_value());
+}
+
+TEST_CASE(nested_arena_scopes)
+{
+    Arena outer_arena;
+    ArenaScope outer_scope(outer_arena);
+    EXPECT_EQ(ArenaScope::current(), &outer_arena);
+
+    {
+        Arena inner_arena;
+        ArenaScope inner_scope(inner_arena);
+        EXPECT_EQ(ArenaScope::current(), &inner_arena);
+
+        ArenaVector<int> numbers;
+        numbers.append(1);
+        EXPECT(inner_arena.bytes_allocated() > 0);
+        EXPECT_EQ(outer_arena.bytes_allocated(), 0u);
+    }
+
+    EXPECT_EQ(ArenaScope::current(), &outer_arena);
+}
+
+TEST_CASE(large_arena_allocations)
+{
+    Arena arena;
+    auto* small = static_cast<u8*>(arena.allocate(16));
+    auto* large = static_cast<u8*>(arena.allocate(Arena::chunk_size * 2));
+    EXPECT_NE(small, nullptr);
+    EXPECT_NE(large, nullptr);
+    EXPECT_EQ(reinterpret_cast<FlatPtr>(large) % Arena::max_alignment, 0u);
+    __builtin_memset(large, 0xaa, Arena::chunk_size * 2);
+    EXPECT_EQ(large[Arena::chunk_size * 2 - 1], 0xaa);
+}
+
+BENCHMARK_CASE(many_small_vectors)
+{
+    for (int round = 0; round < 100; ++round) {
+        Vector<Vector<int>> lists;
+        for (int i = 0; i < 10000; ++i) {
+            lists.empend();
+            for (int j = 0; j < 8; ++j)
+                lists.last().append(j);
+        }
+    }
+}
+
+BENCHMARK_CASE(many_small_arena_vectors)
+{
+    for (int round = 0; round < 100; ++round) {
+        Arena arena;
+        ArenaScope scope(arena);
+        ArenaVector<ArenaVector<int>> lists;
+        for (int i = 0; i < 10000; ++i) {
+            lists.empend();
+            for (int j = 0; j < 8; ++j)
+                lists.last().append(j);
+        }
+    }
+}
@@ -64,6 +64,26 @@ TEST_CASE(escape_braces)
 {
     EXPECT_EQ(ByteString::formatted("{{{}", "foo"), "{foo");
     EXPECT_EQ(ByteString::formatted("{}}}", "bar"), "bar}");
+    EXPECT_EQ(ByteString::formatted("a{{b}}c{}d{{{{e}}}}", 1), "a{b}c1d{{e}}");
+    EXPECT_EQ(ByteString::formatted("{{}}"), "{}");
+}
+
+TEST_CASE(format_integers_of_every_length)
+{
+    u64 value = 0;
+    StringBuilder expected;
+    for (size_t digits = 1; digits <= 20; ++digits) {
+        expected.append(static_cast<char>('0' + digits % 10));
+        value = value * 10 + digits % 10;
+        EXPECT_EQ(ByteString::formatted("{}", value), expected.string_view());
+    }
+    EXPECT_EQ(ByteString::formatted("{}", 9u), "9");
+    EXPECT_EQ(ByteString::formatted("{}", 10u), "10");
+    EXPECT_EQ(ByteString::formatted("{}", 99u), "99");
+    EXPECT_EQ(ByteString::formatted("{}", 100u), "100");
+    EXPECT_EQ(ByteString::formatted("{:o}", 0777u), "777");
+    EXPECT_EQ(ByteString::formatted("{:b}", 5u), "101");
+    EXPECT_EQ(ByteString::formatted("{:X}", 0xABCDEFu), "ABCDEF");
 }
 
 TEST_CASE(everything)
@@ -430,3 +450,21 @@ TEST_CASE(format_wchar)
     EXPECT_EQ(ByteString::formatted("{:6d}", L'a'), "    97");
     EXPECT_EQ(ByteString::formatted("{:#x}", L'\U0001F41E'), "0x1f41e");
 }
+
+BENCHMARK_CASE(format_many_integers)
+{
+    StringBuilder builder;
+    for (u32 i = 0; i < 1'000'000; ++i) {
+        builder.clear();
+        builder.appendff("{} {:x} {}", i, i, static_cast<u64>(i) * 1'000'003);
+    }
+}
+
+BENCHMARK_CASE(format_many_floating_point_numbers)
+{
+    StringBuilder builder;
+    for (u32 i = 0; i < 1'000'000; ++i) {
+        builder.clear();
+        builder.appendff("{}", static_cast<double>(i) / 7);
+    }
+}
@@ -50,6 +50,31 @@ TEST_CASE(ints)
     EXPECT_EQ(test.size(), 0u);
 }
 
+TEST_CASE(remove_value_with_duplicate_keys)
+{
+    IntrusiveRBTree test;
+    IntrusiveTest first { 10 };
+    test.insert(1, first);
+    IntrusiveTest second { 20 };
+    test.insert(1, second);
+    IntrusiveTest third { 30 };
+    test.insert(1, third);
+    EXPECT_EQ(test.size(), 3u);
+
+    test.remove(second);
+    EXPECT_EQ(test.size(), 2u);
+    EXPECT(!second.m_tree_node.is_in_tree());
+
+    Vector<int> values;
+    for (auto& value : test)
+        values.append(value.m_some_value);
+    EXPECT_EQ(values, (Vector<int> { 10, 30 }));
+
+    test.remove(first);
+    test.remove(third);
+    EXPECT(test.is_empty());
+}
+
 TEST_CASE(largest_smaller_than)
 {
     IntrusiveRBTree test;
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/JsonObject.h>
+#include <AK/JsonReader.h>
+#include <AK/JsonValue.h>
+#include <AK/StringBuilder.h>
+
+using TokenType = JsonReader::TokenType;
+
+static Vector<TokenType> token_types(StringView input)
+{
+    JsonReader reader { input };
+    Vector<TokenType> types;
+    for (;;) {
+        auto token = MUST(reader.next());
+        types.append(token.type);
+        if (token.type == TokenType::EndOfInput)
+            return types;
+    }
+}
+
+TEST_CASE(tokens)
+{
+    EXPECT_EQ(token_types(R"({"a": [1, -2.5e3, "x", true, false, null], "b": {}})"sv),
+        (Vector<TokenType> {
+            TokenType::BeginObject,
+            TokenType::Key,
+            TokenType::BeginArray,
+            TokenType::Number,
+            TokenType::Number,
+            TokenType::String,
+            TokenType::True,
+            TokenType::False,
+            TokenType::Null,
+            TokenType::EndArray,
+            TokenType::Key,
+            TokenType::BeginObject,
+            TokenType::EndObject,
+            TokenType::EndObject,
+            TokenType::EndOfInput,
+        }));
+    EXPECT_EQ(token_types(" 42 "sv), (Vector<TokenType> { TokenType::Number, TokenType::EndOfInput }));
+    EXPECT_EQ(token_types("[]"sv), (Vector<TokenType> { TokenType::BeginArray, TokenType::EndArray, TokenType::EndOfInput }));
+}
+
+TEST_CASE(token_values_refer_to_the_input)
+{
+    auto input = R"({"pid": 123, "name": "init", "escaped": "a\"bé", "big": 18446744073709551615})"sv;
+    JsonReader reader { input };
+    EXPECT_EQ(MUST(reader.next()).type, TokenType::BeginObject);
+
+    auto key = MUST(reader.next());
+    EXPECT_EQ(key.type, TokenType::Key);
+    EXPECT_EQ(key.text, "pid"sv);
+    EXPECT(key.text.characters_without_null_termination() >= input.characters_without_null_termination());
+    EXPECT_EQ(MUST(reader.next()).to_number<u32>(), 123u);
+
+    EXPECT_EQ(MUST(reader.next()).text, "name"sv);
+    auto name = MUST(reader.next());
+    EXPECT_EQ(name.text, "init"sv);
+    EXPECT(!name.has_escapes);
+
+    EXPECT_EQ(MUST(reader.next()).text, "escaped"sv);
+    auto escaped = MUST(reader.next());
+    EXPECT(escaped.has_escapes);
+    EXPECT_EQ(escaped.text, R"(a\"bé)"sv);
+    EXPECT_EQ(MUST(escaped.to_byte_string()), "a\"b\xc3\xa9"sv);
+
+    EXPECT_EQ(MUST(reader.next()).text, "big"sv);
+    EXPECT_EQ(MUST(reader.next()).to_number<u64>(), NumericLimits<u64>::max());
+
+    EXPECT_EQ(MUST(reader.next()).type, TokenType::EndObject);
+    EXPECT_EQ(MUST(reader.next()).type, TokenType::EndOfInput);
+}
+
+TEST_CASE(skip_value)
+{
+    JsonReader reader { R"({"skipped": {"a": [1, {"b": []}], "c": "}"}, "wanted": true})"sv };
+    EXPECT_EQ(MUST(reader.next()).type, TokenType::BeginObject);
+    EXPECT_EQ(MUST(reader.next()).text, "skipped"sv);
+    MUST(reader.skip_value());
+    EXPECT_EQ(MUST(reader.next()).text, "wanted"sv);
+    EXPECT_EQ(MUST(reader.next()).to_bool(), true);
+    EXPECT_EQ(reader.depth(), 1u);
+    EXPECT_EQ(MUST(reader.next()).type, TokenType::EndObject);
+    EXPECT_EQ(reader.depth(), 0u);
+}
+
+TEST_CASE(invalid_documents)
+{
+    auto fails = [](StringView input) {
+        JsonReader reader { input };
+        for (;;) {
+            auto token = reader.next();
+            if (token.is_error())
+                return true;
+            if (token.value().type == TokenType::EndOfInput)
+                return false;
+        }
+    };
+
+    EXPECT(fails(""sv));
+    EXPECT(fails("{"sv));
+    EXPECT(fails("[1,]"sv));
+    EXPECT(fails("[1 2]"sv));
+    EXPECT(fails(R"({"a" 1})"sv));
+    EXPECT(fails(R"({"a": 1,})"sv));
+    EXPECT(fails(R"({1: 2})"sv));
+    EXPECT(fails("[1}"sv));
+    EXPECT(fails("01"sv));
+    EXPECT(fails("-"sv));
+    EXPECT(fails("1."sv));
+    EXPECT(fails("1e"sv));
+    EXPECT(fails("\"abc"sv));
+    EXPECT(fails("\"a\nb\""sv));
+    EXPECT(fails("tru"sv));
+    EXPECT(fails("[] []"sv));
+
+    EXPECT(!fails("-0.5E+10"sv));
+    EXPECT(!fails(R"([[], {}, [{"": ""}]])"sv));
+}
+
+TEST_CASE(agrees_with_json_parser)
+{
+    auto input = R"({"name": "x", "values": [1, 2.5, -3, true, null], "nested": {"deep": ["\n"]}})"sv;
+    auto value = MUST(JsonValue::from_string(input));
+
+    JsonReader reader { input };
+    EXPECT_EQ(MUST(reader.next()).type, TokenType::BeginObject);
+    size_t keys = 0;
+    for (;;) {
+        auto key = MUST(reader.next());
+        if (key.type == TokenType::EndObject)
+            break;
+        EXPECT(value.as_object().has(MUST(key.to_byte_string())));
+        MUST(reader.skip_value());
+        ++keys;
+    }
+    EXPECT_EQ(keys, value.as_object().size());
+}
+
+BENCHMARK_CASE(read_large_document)
+{
+    StringBuilder builder;
+    builder.append("{\"processes\": ["sv);
+    for (size_t i = 0; i < 10000; ++i) {
+        if (i > 0)
+            builder.append(',');
+        builder.appendff(R"({{"pid": {}, "name": "process {}", "threads": [{{"tid": {}, "state": "Running"}}]}})", i, i, i);
+    }
+    builder.append("]}"sv);
+    auto input = builder.string_view();
+
+    size_t pid_sum = 0;
+    for (size_t round = 0; round < 10; ++round) {
+        JsonReader reader { input };
+        for (;;) {
+            auto token = MUST(reader.next());
+            if (token.type == TokenType::EndOfInput)
+                break;
+            if (token.type == TokenType::Key && token.text == "pid"sv)
+                pid_sum += MUST(reader.next()).to_number<u32>().value();
+        }
+    }
+    EXPECT_EQ(pid_sum, 10u * (10000u * 9999u / 2));
+}
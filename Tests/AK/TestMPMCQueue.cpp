@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/Atomic.h>
+#include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/MPMCQueue.h>
+#include <AK/Vector.h>
+#include <pthread.h>
+#include <sched.h>
+
+static void run_on_threads(size_t thread_count, Function<void(size_t)> const& callback)
+{
+    struct Context {
+        Function<void(size_t)> const* callback;
+        size_t index;
+    };
+    Vector<Context> contexts;
+    for (size_t i = 0; i < thread_count; ++i)
+        contexts.append({ &callback, i });
+
+    Vector<pthread_t> threads;
+    threads.resize(thread_count);
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto rc = pthread_create(&threads[i], nullptr, [](void* argument) -> void* {
+            auto& context = *static_cast<Context*>(argument);
+            (*context.callback)(context.index);
+            return nullptr;
+        },
+            &contexts[i]);
+        VERIFY(rc == 0);
+    }
+    for (auto thread : threads)
+        pthread_join(thread, nullptr);
+}
+
+TEST_CASE(construct)
+{
+    MPMCQueue<int, 4> queue;
+    EXPECT_EQ(queue.capacity(), 4u);
+    EXPECT(!queue.try_dequeue().has_value());
+}
+
+TEST_CASE(fifo_and_bounded)
+{
+    MPMCQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i)
+        EXPECT(queue.try_enqueue(i));
+    EXPECT(!queue.try_enqueue(4));
+
+    EXPECT_EQ(queue.try_dequeue(), 0);
+    EXPECT(queue.try_enqueue(4));
+    for (int i = 1; i < 5; ++i)
+        EXPECT_EQ(queue.try_dequeue(), i);
+    EXPECT(!queue.try_dequeue().has_value());
+}
+
+TEST_CASE(complex_type)
+{
+    MPMCQueue<ByteString, 2> queue;
+    EXPECT(queue.try_enqueue("Hello"));
+    EXPECT(queue.try_enqueue("World"));
+    EXPECT_EQ(queue.try_dequeue(), "Hello");
+    EXPECT(queue.try_enqueue("!"));
+    // The destructor has to get rid of the remaining strings.
+}
+
+TEST_CASE(multiple_producers_and_consumers)
+{
+    static constexpr size_t thread_count = 4;
+    static constexpr size_t values_per_producer = 100'000;
+
+    MPMCQueue<size_t, 64> queue;
+    Atomic<size_t> consumed_count { 0 };
+    Atomic<u64> consumed_sum { 0 };
+
+    run_on_threads(thread_count * 2, [&](size_t index) {
+        if (index < thread_count) {
+            for (size_t i = 0; i < values_per_producer; ++i) {
+                while (!queue.try_enqueue(index * values_per_producer + i))
+                    sched_yield();
+            }
+            return;
+        }
+
+        while (consumed_count.load() < thread_count * values_per_producer) {
+            auto value = queue.try_dequeue();
+            if (!value.has_value()) {
+                sched_yield();
+                continue;
+            }
+            consumed_sum.fetch_add(*value);
+            consumed_count.fetch_add(1);
+        }
+    });
+
+    auto total = thread_count * values_per_producer;
+    EXPECT_EQ(consumed_count.load(), total);
+    EXPECT_EQ(consumed_sum.load(), static_cast<u64>(total) * (total - 1) / 2);
+}
+
+BENCHMARK_CASE(single_thread_throughput)
+{
+    MPMCQueue<u64, 1024> queue;
+    u64 sum = 0;
+    for (size_t round = 0; round < 10'000; ++round) {
+        for (u64 i = 0; i < 1024; ++i)
+            (void)queue.try_enqueue(i);
+        for (u64 i = 0; i < 1024; ++i)
+            sum += *queue.try_dequeue();
+    }
+    EXPECT_EQ(sum, 10'000ull * 1024 * 1023 / 2);
+}
+
+BENCHMARK_CASE(contended_throughput)
+{
+    static constexpr size_t thread_count = 4;
+    static constexpr size_t values_per_producer = 1'000'000;
+
+    MPMCQueue<u64, 1024> queue;
+    Atomic<size_t> consumed_count { 0 };
+
+    run_on_threads(thread_count * 2, [&](size_t index) {
+        if (index < thread_count) {
+            for (size_t i = 0; i < values_per_producer; ++i) {
+                while (!queue.try_enqueue(i))
+                    sched_yield();
+            }
+            return;
+        }
+
+        while (consumed_count.load(AK::MemoryOrder::memory_order_relaxed) < thread_count * values_per_producer) {
+            if (queue.try_dequeue().has_value())
+                consumed_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            else
+                sched_yield();
+        }
+    });
+
+    EXPECT_EQ(consumed_count.load(), thread_count * values_per_producer);
+}
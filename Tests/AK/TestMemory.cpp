@@ -36,6 +36,28 @@ TEST_CASE(bitap)
     EXPECT_NE(result, nullptr);
 }
 
+TEST_CASE(memmem_with_many_false_candidates)
+{
+    // Every byte of the haystack matches the first byte of the needle, which makes memmem() give up on
+    // looking for candidates and switch to bitap.
+    auto haystack = ByteString::repeated('a', 1000);
+    auto needle = "aaaab"sv;
+    EXPECT_EQ(AK::memmem_optional(haystack.characters(), haystack.length(), needle.characters_without_null_termination(), needle.length()), Optional<size_t> {});
+
+    auto haystack_with_match = ByteString::formatted("{}b", haystack);
+    EXPECT_EQ(AK::memmem_optional(haystack_with_match.characters(), haystack_with_match.length(), needle.characters_without_null_termination(), needle.length()), haystack.length() - 4);
+}
+
+BENCHMARK_CASE(memmem_short_needle)
+{
+    auto haystack = ByteString::formatted("{}needle", ByteString::repeated('x', 1 * MiB));
+    auto needle = "needle"sv;
+    for (size_t i = 0; i < 100; ++i) {
+        auto result = AK::memmem_optional(haystack.characters(), haystack.length(), needle.characters_without_null_termination(), needle.length());
+        EXPECT_EQ(result, 1 * MiB);
+    }
+}
+
 TEST_CASE(kmp_one_chunk)
 {
     Array<u8, 8> haystack { 1, 0, 1, 2, 3, 4, 5, 0 };
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteString.h>
+#include <AK/SPSCQueue.h>
+#include <pthread.h>
+#include <sched.h>
+
+template<typename Queue>
+static void* produce(void* argument)
+{
+    auto& queue = *static_cast<Queue*>(argument);
+    for (u64 i = 0; i < 1'000'000; ++i) {
+        while (!queue.try_enqueue(i))
+            sched_yield();
+    }
+    return nullptr;
+}
+
+template<typename Queue>
+static u64 consume_on_this_thread(Queue& queue)
+{
+    pthread_t producer;
+    VERIFY(pthread_create(&producer, nullptr, produce<Queue>, &queue) == 0);
+
+    u64 expected = 0;
+    u64 out_of_order_count = 0;
+    while (expected < 1'000'000) {
+        auto value = queue.try_dequeue();
+        if (!value.has_value()) {
+            sched_yield();
+            continue;
+        }
+        if (*value != expected)
+            ++out_of_order_count;
+        ++expected;
+    }
+
+    pthread_join(producer, nullptr);
+    return out_of_order_count;
+}
+
+TEST_CASE(construct)
+{
+    SPSCQueue<int, 4> queue;
+    EXPECT_EQ(queue.capacity(), 4u);
+    EXPECT(!queue.try_dequeue().has_value());
+}
+
+TEST_CASE(fifo_and_bounded)
+{
+    SPSCQueue<int, 4> queue;
+    for (int i = 0; i < 4; ++i)
+        EXPECT(queue.try_enqueue(i));
+    EXPECT(!queue.try_enqueue(4));
+
+    EXPECT_EQ(queue.try_dequeue(), 0);
+    EXPECT(queue.try_enqueue(4));
+    for (int i = 1; i < 5; ++i)
+        EXPECT_EQ(queue.try_dequeue(), i);
+    EXPECT(!queue.try_dequeue().has_value());
+}
+
+TEST_CASE(complex_type)
+{
+    SPSCQueue<ByteString, 2> queue;
+    EXPECT(queue.try_enqueue("Hello"));
+    EXPECT(queue.try_enqueue("World"));
+    EXPECT_EQ(queue.try_dequeue(), "Hello");
+    EXPECT(queue.try_enqueue("!"));
+    // The destructor has to get rid of the remaining strings.
+}
+
+TEST_CASE(producer_and_consumer_threads)
+{
+    SPSCQueue<u64, 16> queue;
+    EXPECT_EQ(consume_on_this_thread(queue), 0u);
+}
+
+BENCHMARK_CASE(cross_thread_throughput)
+{
+    SPSCQueue<u64, 1024> queue;
+    EXPECT_EQ(consume_on_this_thread(queue), 0u);
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <AK/SwissHashTable.h>
+
+TEST_CASE(construct)
+{
+    using IntTable = SwissHashTable<int>;
+    EXPECT(IntTable().is_empty());
+    EXPECT_EQ(IntTable().size(), 0u);
+}
+
+TEST_CASE(populate_and_lookup)
+{
+    SwissHashMap<int, ByteString> number_to_string;
+    EXPECT_EQ(number_to_string.set(1, "One"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(number_to_string.set(2, "Two"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(number_to_string.set(3, "Three"), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(number_to_string.set(2, "Deux"), AK::HashSetResult::ReplacedExistingEntry);
+
+    EXPECT_EQ(number_to_string.size(), 3u);
+    EXPECT_EQ(number_to_string.get(1), "One"sv);
+    EXPECT_EQ(number_to_string.get(2), "Deux"sv);
+    EXPECT_EQ(number_to_string.get(3), "Three"sv);
+    EXPECT(!number_to_string.contains(4));
+
+    size_t loop_counter = 0;
+    for (auto& it : number_to_string) {
+        EXPECT(!it.value.is_empty());
+        ++loop_counter;
+    }
+    EXPECT_EQ(loop_counter, 3u);
+}
+
+TEST_CASE(grow_and_remove)
+{
+    SwissHashTable<int> table;
+    for (int i = 0; i < 10000; ++i)
+        EXPECT_EQ(table.set(i), AK::HashSetResult::InsertedNewEntry);
+    EXPECT_EQ(table.size(), 10000u);
+
+    for (int i = 0; i < 10000; i += 2)
+        EXPECT(table.remove(i));
+    EXPECT_EQ(table.size(), 5000u);
+
+    for (int i = 0; i < 10000; ++i)
+        EXPECT_EQ(table.contains(i), i % 2 == 1);
+
+    size_t loop_counter = 0;
+    for (auto value : table) {
+        EXPECT_EQ(value % 2, 1);
+        ++loop_counter;
+    }
+    EXPECT_EQ(loop_counter, 5000u);
+}
+
+TEST_CASE(reuse_deleted_slots)
+{
+    // Inserting and removing values over and over must not make the table grow forever.
+    SwissHashTable<int> table;
+    for (int i = 0; i < 100; ++i)
+        table.set(i);
+    auto capacity = table.capacity();
+
+    for (int i = 100; i < 100000; ++i) {
+        table.set(i);
+        EXPECT(table.remove(i - 100));
+    }
+    EXPECT_EQ(table.size(), 100u);
+    EXPECT_EQ(table.capacity(), capacity);
+    for (int i = 100000 - 100; i < 100000; ++i)
+        EXPECT(table.contains(i));
+}
+
+TEST_CASE(remove_all_matching)
+{
+    SwissHashMap<int, int> map;
+    for (int i = 0; i < 100; ++i)
+        map.set(i, i * i);
+
+    EXPECT(map.remove_all_matching([](int key, int) { return key >= 50; }));
+    EXPECT_EQ(map.size(), 50u);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(map.contains(i), i < 50);
+
+    EXPECT(!map.remove_all_matching([](int key, int) { return key >= 50; }));
+}
+
+TEST_CASE(take_and_ensure)
+{
+    SwissHashMap<ByteString, NonnullOwnPtr<int>> map;
+    map.set("one", make<int>(1));
+    EXPECT_EQ(*map.ensure("two", [] { return make<int>(2); }), 2);
+
+    auto taken = map.take("one");
+    EXPECT(taken.has_value());
+    EXPECT_EQ(**taken, 1);
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT(!map.contains("one"sv));
+    EXPECT(map.contains("two"sv));
+}
+
+TEST_CASE(copy_and_clear)
+{
+    SwissHashMap<ByteString, int> map;
+    for (int i = 0; i < 1000; ++i)
+        map.set(ByteString::number(i), i);
+
+    auto copy = map;
+    map.clear_with_capacity();
+    EXPECT(map.is_empty());
+    EXPECT_EQ(copy.size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(copy.get(ByteString::number(i)), i);
+
+    map.set("x", 1);
+    EXPECT_EQ(map.size(), 1u);
+}
+
+template<typename Map>
+static void run_insert_and_lookup_benchmark()
+{
+    Map map;
+    for (u32 i = 0; i < 1'000'000; ++i)
+        map.set(i * 2654435761u, i);
+    for (size_t round = 0; round < 4; ++round) {
+        for (u32 i = 0; i < 1'000'000; ++i)
+            EXPECT(map.contains(i * 2654435761u));
+        for (u32 i = 0; i < 1'000'000; ++i)
+            EXPECT(!map.contains(i * 2654435761u + 1));
+    }
+}
+
+BENCHMARK_CASE(hash_map_insert_and_lookup)
+{
+    run_insert_and_lookup_benchmark<HashMap<u32, u32>>();
+}
+
+BENCHMARK_CASE(swiss_hash_map_insert_and_lookup)
+{
+    run_insert_and_lookup_benchmark<SwissHashMap<u32, u32>>();
+}
+
+template<typename Map>
+static void run_string_lookup_benchmark()
+{
+    Vector<ByteString> keys;
+    for (size_t i = 0; i < 100'000; ++i)
+        keys.append(ByteString::formatted("property_{}", i));
+
+    Map map;
+    for (size_t i = 0; i < keys.size(); ++i)
+        map.set(keys[i], i);
+    for (size_t round = 0; round < 10; ++round) {
+        for (auto& key : keys)
+            EXPECT(map.contains(key));
+    }
+}
+
+BENCHMARK_CASE(hash_map_string_lookup)
+{
+    run_string_lookup_benchmark<HashMap<ByteString, size_t>>();
+}
+
+BENCHMARK_CASE(swiss_hash_map_string_lookup)
+{
+    run_string_lookup_benchmark<SwissHashMap<ByteString, size_t>>();
+}
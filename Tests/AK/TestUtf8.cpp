@@ -7,6 +7,8 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/StringBuilder.h>
 #include <AK/Utf8View.h>
 
 TEST_CASE(decode_ascii)
@@ -323,3 +325,47 @@ TEST_CASE(for_each_split_view)
     EXPECT_EQ(gather(SplitBehavior::KeepEmpty | SplitBehavior::KeepTrailingSeparator),
         Vector({ "."sv, "."sv, "."sv, "Well."sv, "."sv, "hello."sv, "friends!."sv, "."sv, "."sv, ""sv }));
 }
+
+TEST_CASE(validate_long_ascii_runs)
+{
+    // Long runs of ASCII are skipped in chunks, make sure the bytes around them are still checked.
+    auto ascii = "The quick brown fox jumps over the lazy dog, "sv;
+    StringBuilder builder;
+    for (size_t i = 0; i < 4; ++i) {
+        builder.append(ascii);
+        builder.append("\xc3\xa9\xe2\x82\xac"sv);
+    }
+    auto valid = builder.to_byte_string();
+    Utf8View valid_view { valid };
+    EXPECT(valid_view.validate());
+    EXPECT_EQ(valid_view.length(), 4 * (ascii.length() + 2));
+
+    builder.append(ascii);
+    builder.append("\xe2\x82"sv);
+    auto invalid = builder.to_byte_string();
+    size_t valid_bytes = 0;
+    EXPECT(!Utf8View { invalid }.validate(valid_bytes));
+    EXPECT_EQ(valid_bytes, valid.length() + ascii.length());
+}
+
+BENCHMARK_CASE(validate_ascii)
+{
+    auto text = ByteString::repeated('a', 1 * MiB);
+    for (size_t i = 0; i < 100; ++i) {
+        Utf8View view { text };
+        EXPECT(view.validate());
+    }
+}
+
+BENCHMARK_CASE(validate_mostly_ascii)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < 16 * KiB; ++i)
+        builder.append("<p>Grüße aus Zürich</p>\n"sv);
+    auto text = builder.to_byte_string();
+    for (size_t i = 0; i < 100; ++i) {
+        Utf8View view { text };
+        EXPECT(view.validate());
+        EXPECT_EQ(view.length(), text.length() - 3 * 16 * KiB);
+    }
+}
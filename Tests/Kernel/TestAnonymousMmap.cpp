@@ -113,3 +113,42 @@ TEST_CASE(test_that_partial_munmap_does_not_break_cow)
         EXPECT(map[2 * PAGE_SIZE] == 'C');
     }
 }
+
+TEST_CASE(huge_page_hinted_anonymous_mmap)
+{
+    size_t huge_page_size = 512 * PAGE_SIZE;
+    size_t len = 2 * huge_page_size;
+    char* map = (char*)mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGE, -1, 0);
+    EXPECT(map != MAP_FAILED);
+    EXPECT_EQ((uintptr_t)map % huge_page_size, 0u);
+
+    // the first write to each block may map it with a huge page, which should still read back as zero
+    map[0] = 'A';
+    map[huge_page_size] = 'B';
+    for (size_t i = 1; i < len / PAGE_SIZE; ++i) {
+        if (i == huge_page_size / PAGE_SIZE)
+            continue;
+        EXPECT(map[i * PAGE_SIZE] == 0);
+    }
+
+    pid_t pid = fork();
+    VERIFY(pid != -1);
+    if (pid == 0) {
+        // fork and partial mprotect/munmap have to split the huge mappings without losing their contents
+        EXPECT(map[0] == 'A');
+        map[PAGE_SIZE] = '!';
+        int rc = mprotect(map + huge_page_size, PAGE_SIZE, PROT_READ);
+        VERIFY(rc != -1);
+        EXPECT(map[huge_page_size] == 'B');
+        rc = munmap(map + 2 * PAGE_SIZE, PAGE_SIZE);
+        VERIFY(rc != -1);
+        EXPECT(map[PAGE_SIZE] == '!');
+        exit(EXIT_SUCCESS);
+    } else {
+        wait(NULL);
+        EXPECT(map[0] == 'A');
+        EXPECT(map[PAGE_SIZE] == 0);
+        EXPECT(map[2 * PAGE_SIZE] == 0);
+        EXPECT(map[huge_page_size] == 'B');
+    }
+}
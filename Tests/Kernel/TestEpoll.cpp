@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+static epoll_event make_event(u32 events, int fd)
+{
+    epoll_event event {};
+    event.events = events;
+    event.data.fd = fd;
+    return event;
+}
+
+TEST_CASE(level_triggered_reports_until_drained)
+{
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    EXPECT(epoll_fd >= 0);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    auto event = make_event(EPOLLIN, pipe_fds[0]);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipe_fds[0], &event), 0);
+
+    epoll_event ready[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, ready, 4, 0), 0);
+
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, ready, 4, 0), 1);
+    EXPECT_EQ(ready[0].data.fd, pipe_fds[0]);
+    EXPECT(ready[0].events & EPOLLIN);
+
+    // Still readable, so it's reported again.
+    EXPECT_EQ(epoll_wait(epoll_fd, ready, 4, 0), 1);
+
+    char buffer;
+    EXPECT_EQ(read(pipe_fds[0], &buffer, 1), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, ready, 4, 0), 0);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(edge_triggered_reports_once)
+{
+    int epoll_fd = epoll_create1(0);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    auto event = make_event(EPOLLIN | EPOLLET, pipe_fds[0]);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipe_fds[0], &event), 0);
+
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    epoll_event ready[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, ready, 4, 0), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, ready, 4, 0), 0);
+
+    // More data is a new edge.
+    EXPECT_EQ(write(pipe_fds[1], "y", 1), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, ready, 4, 0), 1);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(one_shot_needs_rearming)
+{
+    int epoll_fd = epoll_create1(0);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    auto event = make_event(EPOLLIN | EPOLLONESHOT, pipe_fds[0]);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipe_fds[0], &event), 0);
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+
+    epoll_event ready[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, ready, 4, 0), 1);
+    EXPECT_EQ(epoll_wait(epoll_fd, ready, 4, 0), 0);
+
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_MOD, pipe_fds[0], &event), 0);
+    EXPECT_EQ(epoll_wait(epoll_fd, ready, 4, 0), 1);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(control_errors)
+{
+    int epoll_fd = epoll_create1(0);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    auto event = make_event(EPOLLIN, pipe_fds[0]);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_MOD, pipe_fds[0], &event), -1);
+    EXPECT_EQ(errno, ENOENT);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipe_fds[0], &event), 0);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipe_fds[0], &event), -1);
+    EXPECT_EQ(errno, EEXIST);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_DEL, pipe_fds[0], nullptr), 0);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_DEL, pipe_fds[0], nullptr), -1);
+    EXPECT_EQ(errno, ENOENT);
+
+    auto self_event = make_event(EPOLLIN, epoll_fd);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, epoll_fd, &self_event), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
+
+TEST_CASE(closing_the_file_removes_it)
+{
+    int epoll_fd = epoll_create1(0);
+    int pipe_fds[2];
+    EXPECT_EQ(pipe(pipe_fds), 0);
+
+    auto event = make_event(EPOLLIN, pipe_fds[0]);
+    EXPECT_EQ(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pipe_fds[0], &event), 0);
+    EXPECT_EQ(write(pipe_fds[1], "x", 1), 1);
+    close(pipe_fds[0]);
+
+    epoll_event ready[4];
+    EXPECT_EQ(epoll_wait(epoll_fd, ready, 4, 0), 0);
+
+    close(pipe_fds[1]);
+    close(epoll_fd);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibTest/TestCase.h>
+#include <limits.h>
+#include <pthread.h>
+#include <serenity.h>
+#include <unistd.h>
+
+TEST_CASE(wake_op_with_shifted_argument)
+{
+    u32 futex_word = 0;
+    u32 futex_word2 = 0;
+    // For FUTEX_WAKE_OP, the timeout argument is the number of waiters to wake on the second futex.
+    auto rc = futex(&futex_word, FUTEX_WAKE_OP | FUTEX_PRIVATE_FLAG, 1, reinterpret_cast<timespec const*>(1), &futex_word2, FUTEX_OP(FUTEX_OP_SET | FUTEX_OP_ARG_SHIFT, 3, FUTEX_OP_CMP_EQ, 0));
+    EXPECT_EQ(rc, 0);
+    EXPECT_EQ(futex_word2, 1u << 3);
+}
+
+static u32 s_source_futex_word = 0;
+static u32 s_target_futex_word = 0;
+static Atomic<u32> s_waiters_done = 0;
+
+static void* wait_on_source_futex(void*)
+{
+    while (futex_wait(&s_source_futex_word, 0, nullptr, 0, false) < 0 && errno == EINTR)
+        ;
+    s_waiters_done++;
+    return nullptr;
+}
+
+TEST_CASE(requeue_to_another_futex)
+{
+    static constexpr u32 waiter_count = 2;
+    pthread_t threads[waiter_count];
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_create(&thread, nullptr, wait_on_source_futex, nullptr), 0);
+
+    // Move the waiters over without waking any of them. They may not all be waiting yet, so keep trying.
+    u32 requeued = 0;
+    while (requeued < waiter_count) {
+        // For FUTEX_CMP_REQUEUE, the timeout argument is the maximum number of waiters to requeue.
+        auto rc = futex(&s_source_futex_word, FUTEX_CMP_REQUEUE | FUTEX_PRIVATE_FLAG, 0, reinterpret_cast<timespec const*>(INT_MAX), &s_target_futex_word, 0);
+        EXPECT(rc >= 0);
+        requeued += rc;
+        if (requeued < waiter_count)
+            usleep(1000);
+    }
+    EXPECT_EQ(requeued, waiter_count);
+    EXPECT_EQ(s_waiters_done.load(), 0u);
+
+    // Waking the source futex must not find the requeued waiters anymore.
+    EXPECT_EQ(futex_wake(&s_source_futex_word, INT_MAX, false), 0);
+    EXPECT_EQ(futex_wake(&s_target_futex_word, INT_MAX, false), static_cast<int>(waiter_count));
+
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+    EXPECT_EQ(s_waiters_done.load(), waiter_count);
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <sys/socket.h>
+
+TEST_CASE(pipe_default_size)
+{
+    auto fds = MUST(Core::System::pipe2(0));
+    EXPECT_EQ(MUST(Core::System::fcntl(fds[0], F_GETPIPE_SZ)), 64 * KiB);
+    MUST(Core::System::close(fds[0]));
+    MUST(Core::System::close(fds[1]));
+}
+
+TEST_CASE(pipe_grow_keeps_unread_data)
+{
+    auto fds = MUST(Core::System::pipe2(O_NONBLOCK));
+    auto data = MUST(ByteBuffer::create_uninitialized(64 * KiB));
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = i % 251;
+
+    EXPECT_EQ(MUST(Core::System::write(fds[1], data)), static_cast<ssize_t>(data.size()));
+    EXPECT_EQ(Core::System::write(fds[1], data).error().code(), EAGAIN);
+
+    EXPECT_EQ(MUST(Core::System::fcntl(fds[1], F_SETPIPE_SZ, 1 * MiB)), 1 * MiB);
+    EXPECT_EQ(MUST(Core::System::fcntl(fds[0], F_GETPIPE_SZ)), 1 * MiB);
+    EXPECT_EQ(MUST(Core::System::write(fds[1], data)), static_cast<ssize_t>(data.size()));
+
+    auto received = MUST(ByteBuffer::create_uninitialized(data.size()));
+    for (size_t round = 0; round < 2; ++round) {
+        size_t received_size = 0;
+        while (received_size < received.size())
+            received_size += MUST(Core::System::read(fds[0], received.bytes().slice(received_size)));
+        EXPECT_EQ(received, data);
+    }
+
+    MUST(Core::System::close(fds[0]));
+    MUST(Core::System::close(fds[1]));
+}
+
+TEST_CASE(pipe_shrink_below_unread_data)
+{
+    auto fds = MUST(Core::System::pipe2(0));
+    auto data = MUST(ByteBuffer::create_zeroed(32 * KiB));
+    MUST(Core::System::write(fds[1], data));
+
+    EXPECT_EQ(Core::System::fcntl(fds[1], F_SETPIPE_SZ, 16 * KiB).error().code(), EBUSY);
+    EXPECT_EQ(Core::System::fcntl(fds[1], F_SETPIPE_SZ, 64 * MiB).error().code(), EPERM);
+    EXPECT_EQ(MUST(Core::System::fcntl(fds[1], F_GETPIPE_SZ)), 64 * KiB);
+
+    MUST(Core::System::close(fds[0]));
+    MUST(Core::System::close(fds[1]));
+}
+
+TEST_CASE(pipe_size_of_non_pipe)
+{
+    auto fd = MUST(Core::System::open("/dev/null"sv, O_RDONLY));
+    EXPECT_EQ(Core::System::fcntl(fd, F_GETPIPE_SZ).error().code(), EBADF);
+    MUST(Core::System::close(fd));
+}
+
+TEST_CASE(local_socket_buffer_size)
+{
+    int fds[2];
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    int size = 2 * MiB;
+    MUST(Core::System::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)));
+
+    socklen_t size_length = sizeof(size);
+    MUST(Core::System::getsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &size, &size_length));
+    EXPECT_EQ(size, 2 * MiB);
+    // The send buffer of one side is the receive buffer of the other.
+    MUST(Core::System::getsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &size, &size_length));
+    EXPECT_EQ(size, 2 * MiB);
+    MUST(Core::System::getsockopt(fds[1], SOL_SOCKET, SO_SNDBUF, &size, &size_length));
+    EXPECT_EQ(size, 64 * KiB);
+
+    // Sizes that are too large are clamped.
+    size = 1 * GiB;
+    MUST(Core::System::setsockopt(fds[1], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)));
+    MUST(Core::System::getsockopt(fds[1], SOL_SOCKET, SO_SNDBUF, &size, &size_length));
+    EXPECT_EQ(size, 4 * MiB);
+
+    MUST(Core::System::close(fds[0]));
+    MUST(Core::System::close(fds[1]));
+}
@@ -25,3 +25,44 @@ TEST_CASE(test_posix_spawn_bin_true_success)
 
     EXPECT_EQ(WEXITSTATUS(status), 0);
 }
+
+TEST_CASE(test_posix_spawn_file_actions)
+{
+    char* argv[] = { const_cast<char*>("/bin/pwd"), nullptr };
+    constexpr auto output_path = "/tmp/posix_spawn_file_actions_output"sv;
+
+    posix_spawn_file_actions_t file_actions;
+    posix_spawn_file_actions_init(&file_actions);
+    posix_spawn_file_actions_addchdir(&file_actions, "/tmp");
+    // A relative path, which has to be resolved in the working directory of the child.
+    posix_spawn_file_actions_addopen(&file_actions, STDOUT_FILENO, "posix_spawn_file_actions_output", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    auto pid = TRY_OR_FAIL(Core::System::posix_spawn("/bin/pwd"sv, &file_actions, nullptr, argv, environ));
+    posix_spawn_file_actions_destroy(&file_actions);
+
+    int status;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    auto fd = TRY_OR_FAIL(Core::System::open(output_path, O_RDONLY));
+    char buffer[32] {};
+    auto nread = TRY_OR_FAIL(Core::System::read(fd, { buffer, sizeof(buffer) }));
+    EXPECT_EQ(StringView(buffer, nread), "/tmp\n"sv);
+    TRY_OR_FAIL(Core::System::close(fd));
+    TRY_OR_FAIL(Core::System::unlink(output_path));
+}
+
+TEST_CASE(test_posix_spawn_failing_file_action)
+{
+    char* argv[] = { const_cast<char*>("/bin/true"), nullptr };
+
+    posix_spawn_file_actions_t file_actions;
+    posix_spawn_file_actions_init(&file_actions);
+    posix_spawn_file_actions_addopen(&file_actions, 3, "/this/does/not/exist", O_RDONLY, 0);
+
+    auto result = Core::System::posix_spawn("/bin/true"sv, &file_actions, nullptr, argv, environ);
+    posix_spawn_file_actions_destroy(&file_actions);
+
+    EXPECT(result.is_error());
+    EXPECT_EQ(result.error().code(), ENOENT);
+}
@@ -17,6 +17,37 @@
 static u8* private_ptr = nullptr;
 size_t const buf_len = 0x1000;
 
+TEST_CASE(private_inode_vmobject_read_around)
+{
+    size_t const page_count = 40;
+    int fd = open("/tmp/private_inode_read_around_test", O_RDWR | O_CREAT | O_TRUNC, 0644);
+    VERIFY(fd >= 0);
+    u8 buf[buf_len];
+    for (size_t i = 0; i < page_count; ++i) {
+        memset(buf, (int)i, sizeof(buf));
+        auto rc = write(fd, buf, sizeof(buf));
+        VERIFY(rc == sizeof(buf));
+    }
+
+    size_t mmap_len = page_count * buf_len;
+    auto* ptr = (u8*)mmap(nullptr, mmap_len, PROT_READ, MAP_PRIVATE, fd, 0);
+    EXPECT(ptr != MAP_FAILED);
+
+    // faulting in a page also brings in its neighbours, which all have to end up in the right place
+    EXPECT_EQ(ptr[5 * buf_len], 5);
+    for (size_t i = 0; i < page_count; ++i)
+        EXPECT_EQ(ptr[i * buf_len + buf_len - 1], (u8)i);
+
+    EXPECT_EQ(madvise(ptr, mmap_len, MADV_SEQUENTIAL), 0);
+    EXPECT_EQ(madvise(ptr, mmap_len, MADV_WILLNEED), 0);
+    EXPECT_EQ(madvise(ptr, mmap_len, MADV_RANDOM), 0);
+    EXPECT_EQ(ptr[page_count * buf_len - 1], (u8)(page_count - 1));
+
+    EXPECT_EQ(munmap(ptr, mmap_len), 0);
+    close(fd);
+    unlink("/tmp/private_inode_read_around_test");
+}
+
 static void private_non_empty_inode_vmobject_sync_signal_handler(int)
 {
     auto rc = msync(private_ptr, buf_len, MS_ASYNC);
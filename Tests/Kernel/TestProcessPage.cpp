@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <sched.h>
+#include <sys/wait.h>
+#include <syscall.h>
+#include <unistd.h>
+
+TEST_CASE(credentials_match_syscalls)
+{
+    EXPECT_EQ(getuid(), static_cast<uid_t>(syscall(SC_getuid)));
+    EXPECT_EQ(geteuid(), static_cast<uid_t>(syscall(SC_geteuid)));
+    EXPECT_EQ(getgid(), static_cast<gid_t>(syscall(SC_getgid)));
+    EXPECT_EQ(getegid(), static_cast<gid_t>(syscall(SC_getegid)));
+    EXPECT_EQ(getppid(), static_cast<pid_t>(syscall(SC_getppid)));
+}
+
+TEST_CASE(child_sees_its_own_process_page_after_fork)
+{
+    // Make sure the page is mapped before forking.
+    auto parent_ppid = getppid();
+    EXPECT_EQ(parent_ppid, static_cast<pid_t>(syscall(SC_getppid)));
+
+    auto parent_pid = getpid();
+    auto child_pid = fork();
+    EXPECT(child_pid >= 0);
+    if (child_pid == 0)
+        _exit(getppid() == parent_pid && getppid() == syscall(SC_getppid) ? 0 : 1);
+
+    int status = 0;
+    EXPECT_EQ(waitpid(child_pid, &status, 0), child_pid);
+    EXPECT(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(getppid(), parent_ppid);
+}
+
+TEST_CASE(sched_getcpu_returns_a_valid_processor)
+{
+    auto processor_count = sysconf(_SC_NPROCESSORS_ONLN);
+    auto cpu = sched_getcpu();
+    EXPECT(cpu >= 0);
+    EXPECT(cpu < processor_count);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <Kernel/API/ProcessStatistics.h>
+#include <LibTest/TestCase.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+static Vector<u8> read_process_statistics()
+{
+    int fd = open("/sys/kernel/process_statistics", O_RDONLY);
+    VERIFY(fd >= 0);
+    Vector<u8> data;
+    u8 buffer[4096];
+    ssize_t nread;
+    while ((nread = read(fd, buffer, sizeof(buffer))) > 0)
+        data.append(buffer, nread);
+    VERIFY(nread == 0);
+    close(fd);
+    return data;
+}
+
+TEST_CASE(contains_current_process)
+{
+    auto data = read_process_statistics();
+    ProcessStatisticsHeader header;
+    VERIFY(data.size() >= sizeof(header));
+    memcpy(&header, data.data(), sizeof(header));
+    EXPECT_EQ(memcmp(header.magic, PROCESS_STATISTICS_MAGIC, sizeof(header.magic)), 0);
+    EXPECT_EQ(header.version, static_cast<u32>(PROCESS_STATISTICS_VERSION));
+
+    bool found_current_process = false;
+    size_t offset = sizeof(header);
+    while (offset < data.size()) {
+        ProcessStatisticsRecord record;
+        VERIFY(offset + sizeof(record) <= data.size());
+        memcpy(&record, data.data() + offset, sizeof(record));
+        EXPECT_EQ(record.size % PROCESS_STATISTICS_RECORD_ALIGNMENT, 0u);
+        EXPECT(offset + record.size <= data.size());
+
+        if (record.pid == getpid()) {
+            found_current_process = true;
+            EXPECT_EQ(record.ppid, getppid());
+            EXPECT_EQ(record.uid, getuid());
+            EXPECT(record.thread_count >= 1);
+
+            auto thread_offset = offset + record.size - record.thread_count * sizeof(ThreadStatisticsRecord);
+            bool found_current_thread = false;
+            for (size_t i = 0; i < record.thread_count; ++i) {
+                ThreadStatisticsRecord thread_record;
+                memcpy(&thread_record, data.data() + thread_offset + i * sizeof(thread_record), sizeof(thread_record));
+                if (thread_record.tid == gettid()) {
+                    found_current_thread = true;
+                    EXPECT(thread_record.syscall_count > 0);
+                }
+            }
+            EXPECT(found_current_thread);
+        }
+        offset += record.size;
+    }
+    EXPECT_EQ(offset, data.size());
+    EXPECT(found_current_process);
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+
+TEST_CASE(set_and_get_process_policy)
+{
+    sched_param param {};
+    EXPECT_EQ(sched_getparam(0, &param), 0);
+
+    EXPECT_EQ(sched_setscheduler(0, SCHED_BATCH, &param), 0);
+    EXPECT_EQ(sched_getscheduler(0), SCHED_BATCH);
+
+    // Setting only the parameters must not change the policy.
+    EXPECT_EQ(sched_setparam(0, &param), 0);
+    EXPECT_EQ(sched_getscheduler(0), SCHED_BATCH);
+
+    EXPECT_EQ(sched_setscheduler(0, SCHED_OTHER, &param), 0);
+    EXPECT_EQ(sched_getscheduler(0), SCHED_OTHER);
+}
+
+TEST_CASE(set_and_get_thread_policy)
+{
+    sched_param param {};
+    int policy = -1;
+    EXPECT_EQ(pthread_getschedparam(pthread_self(), &policy, &param), 0);
+    EXPECT_EQ(policy, SCHED_OTHER);
+
+    EXPECT_EQ(pthread_setschedparam(pthread_self(), SCHED_BATCH, &param), 0);
+    EXPECT_EQ(pthread_getschedparam(pthread_self(), &policy, &param), 0);
+    EXPECT_EQ(policy, SCHED_BATCH);
+
+    EXPECT_EQ(pthread_setschedparam(pthread_self(), SCHED_OTHER, &param), 0);
+}
+
+TEST_CASE(invalid_policy)
+{
+    sched_param param {};
+    EXPECT_EQ(sched_getparam(0, &param), 0);
+    EXPECT_EQ(sched_setscheduler(0, 1234, &param), -1);
+    EXPECT_EQ(errno, EINVAL);
+}
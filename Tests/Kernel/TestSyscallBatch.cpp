@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/API/Syscall.h>
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <serenity.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+TEST_CASE(open_fstat_read_close)
+{
+    constexpr auto path = "/etc/passwd"sv;
+    Syscall::SC_open_params params { AT_FDCWD, { path.characters_without_null_termination(), path.length() }, O_RDONLY, 0 };
+    struct stat st {};
+    char buffer[16] {};
+
+    syscall_batch_entry entries[] = {
+        { SC_open, -1, { reinterpret_cast<uintptr_t>(&params) }, 0 },
+        { SC_fstat, 0, { 0, reinterpret_cast<uintptr_t>(&st) }, 0 },
+        { SC_read, 0, { 0, reinterpret_cast<uintptr_t>(buffer), sizeof(buffer) }, 0 },
+        { SC_close, 0, {}, 0 },
+    };
+    EXPECT_EQ(syscall_batch(entries, 4), 4);
+
+    EXPECT(entries[0].result >= 0);
+    EXPECT_EQ(entries[1].result, 0);
+    EXPECT(S_ISREG(st.st_mode));
+    EXPECT_EQ(entries[2].result, static_cast<intptr_t>(min(sizeof(buffer), static_cast<size_t>(st.st_size))));
+    EXPECT_EQ(entries[3].result, 0);
+
+    // The file descriptor has to be closed already.
+    EXPECT_EQ(fcntl(entries[0].result, F_GETFD), -1);
+    EXPECT_EQ(errno, EBADF);
+}
+
+TEST_CASE(dependent_entries_are_cancelled)
+{
+    constexpr auto path = "/this/does/not/exist"sv;
+    Syscall::SC_open_params params { AT_FDCWD, { path.characters_without_null_termination(), path.length() }, O_RDONLY, 0 };
+
+    syscall_batch_entry entries[] = {
+        { SC_open, -1, { reinterpret_cast<uintptr_t>(&params) }, 0 },
+        { SC_close, 0, {}, 0 },
+        { SC_getpid, -1, {}, 0 },
+    };
+    EXPECT_EQ(syscall_batch(entries, 3), 3);
+    EXPECT_EQ(entries[0].result, -ENOENT);
+    EXPECT_EQ(entries[1].result, -ECANCELED);
+    EXPECT_EQ(entries[2].result, getpid());
+}
+
+TEST_CASE(invalid_entries)
+{
+    syscall_batch_entry entries[] = {
+        { SC_fork, -1, {}, 0 },
+        { SC_syscall_batch, -1, {}, 0 },
+        { SC_getpid, 2, {}, 0 },
+        { Syscall::Function::__Count, -1, {}, 0 },
+    };
+    EXPECT_EQ(syscall_batch(entries, 4), 4);
+    EXPECT_EQ(entries[0].result, -EINVAL);
+    EXPECT_EQ(entries[1].result, -EINVAL);
+    EXPECT_EQ(entries[2].result, -EINVAL);
+    EXPECT_EQ(entries[3].result, -ENOSYS);
+
+    EXPECT_EQ(syscall_batch(entries, 0), -1);
+    EXPECT_EQ(errno, EINVAL);
+    EXPECT_EQ(syscall_batch(entries, SYSCALL_BATCH_MAX_ENTRIES + 1), -1);
+    EXPECT_EQ(errno, EINVAL);
+}
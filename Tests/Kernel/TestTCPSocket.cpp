@@ -8,6 +8,7 @@
 #include <LibCore/File.h>
 #include <LibTest/TestCase.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <pthread.h>
 #include <semaphore.h>
 #include <sys/socket.h>
@@ -141,6 +142,93 @@ TEST_CASE(tcp_bind_connect)
     }
 }
 
+TEST_CASE(tcp_congestion_control)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT(fd >= 0);
+
+    char name[TCP_CA_NAME_MAX] {};
+    socklen_t name_size = sizeof(name);
+    int rc = getsockopt(fd, IPPROTO_TCP, TCP_CONGESTION, name, &name_size);
+    EXPECT_EQ(rc, 0);
+    EXPECT_EQ(StringView { name, strlen(name) }, "cubic"sv);
+
+    rc = setsockopt(fd, IPPROTO_TCP, TCP_CONGESTION, "newreno", strlen("newreno"));
+    EXPECT_EQ(rc, 0);
+    name_size = sizeof(name);
+    rc = getsockopt(fd, IPPROTO_TCP, TCP_CONGESTION, name, &name_size);
+    EXPECT_EQ(rc, 0);
+    EXPECT_EQ(StringView { name, strlen(name) }, "newreno"sv);
+
+    rc = setsockopt(fd, IPPROTO_TCP, TCP_CONGESTION, "vegas", strlen("vegas"));
+    EXPECT_EQ(rc, -1);
+    EXPECT_EQ(errno, ENOENT);
+
+    rc = close(fd);
+    EXPECT_EQ(rc, 0);
+}
+
+static int bind_tcp_socket(u16 bind_port, int option_name)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    EXPECT(fd >= 0);
+
+    if (option_name != 0) {
+        int value = 1;
+        int rc = setsockopt(fd, SOL_SOCKET, option_name, &value, sizeof(value));
+        EXPECT_EQ(rc, 0);
+    }
+
+    sockaddr_in sin {};
+    sin.sin_family = AF_INET;
+    sin.sin_port = htons(bind_port);
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (sockaddr*)(&sin), sizeof(sin)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+TEST_CASE(tcp_reuse_port)
+{
+    int first_fd = bind_tcp_socket(port + 2, SO_REUSEPORT);
+    EXPECT(first_fd >= 0);
+    EXPECT_EQ(listen(first_fd, 1), 0);
+
+    int second_fd = bind_tcp_socket(port + 2, SO_REUSEPORT);
+    EXPECT(second_fd >= 0);
+    EXPECT_EQ(listen(second_fd, 1), 0);
+
+    // A socket that didn't opt in can't join the group.
+    int third_fd = bind_tcp_socket(port + 2, 0);
+    EXPECT_EQ(third_fd, -1);
+    EXPECT_EQ(errno, EADDRINUSE);
+
+    int value = 0;
+    socklen_t value_size = sizeof(value);
+    int rc = getsockopt(first_fd, SOL_SOCKET, SO_REUSEPORT, &value, &value_size);
+    EXPECT_EQ(rc, 0);
+    EXPECT_EQ(value, 1);
+
+    EXPECT_EQ(close(first_fd), 0);
+    EXPECT_EQ(close(second_fd), 0);
+}
+
+TEST_CASE(tcp_reuse_address_with_listener)
+{
+    int listener_fd = bind_tcp_socket(port + 3, SO_REUSEADDR);
+    EXPECT(listener_fd >= 0);
+    EXPECT_EQ(listen(listener_fd, 1), 0);
+
+    // SO_REUSEADDR doesn't allow a second socket onto a port that's being listened on.
+    int second_fd = bind_tcp_socket(port + 3, SO_REUSEADDR);
+    EXPECT_EQ(second_fd, -1);
+    EXPECT_EQ(errno, EADDRINUSE);
+
+    EXPECT_EQ(close(listener_fd), 0);
+}
+
 TEST_CASE(socket_connect_after_bind)
 {
     unlink("/tmp/tmp-client.test");
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <LibAudio/Resampler.h>
+#include <LibTest/TestCase.h>
+
+static Vector<Audio::Sample> resample_in_chunks(Audio::SincResampler& resampler, ReadonlySpan<Audio::Sample> input, size_t chunk_size)
+{
+    Vector<Audio::Sample> output;
+    for (size_t offset = 0; offset < input.size(); offset += chunk_size)
+        MUST(resampler.try_resample_into_end(output, input.slice(offset, min(chunk_size, input.size() - offset))));
+    return output;
+}
+
+static Vector<Audio::Sample> sine(float frequency, u32 sample_rate, size_t sample_count)
+{
+    Vector<Audio::Sample> samples;
+    for (size_t i = 0; i < sample_count; ++i)
+        samples.append(Audio::Sample { AK::sin(2 * AK::Pi<float> * frequency * static_cast<float>(i) / static_cast<float>(sample_rate)) });
+    return samples;
+}
+
+static float rms(ReadonlySpan<Audio::Sample> samples)
+{
+    float sum = 0;
+    for (auto sample : samples)
+        sum += sample.left * sample.left;
+    return AK::sqrt(sum / static_cast<float>(samples.size()));
+}
+
+TEST_CASE(same_rate_passes_samples_through)
+{
+    Audio::SincResampler resampler(48000, 48000);
+    auto input = sine(1000, 48000, 300);
+    auto output = resample_in_chunks(resampler, input, 128);
+    EXPECT_EQ(output.size(), input.size());
+    for (size_t i = 0; i < input.size(); ++i)
+        EXPECT_EQ(output[i].left, input[i].left);
+}
+
+TEST_CASE(upsampling_keeps_constant_signal)
+{
+    Audio::SincResampler resampler(44100, 48000);
+    Vector<Audio::Sample> input;
+    for (size_t i = 0; i < 4410; ++i)
+        input.append(Audio::Sample { 0.5f });
+    auto output = resample_in_chunks(resampler, input, 100);
+
+    // All but the last half filter length of input is turned into output.
+    EXPECT(output.size() > 4800 - Audio::SincResampler::tap_count);
+    EXPECT(output.size() <= 4800);
+    // The first samples are still mixed with the silence before the input.
+    for (size_t i = Audio::SincResampler::tap_count; i < output.size(); ++i)
+        EXPECT_APPROXIMATE_WITH_ERROR(output[i].left, 0.5f, 0.00001);
+}
+
+TEST_CASE(chunk_size_does_not_change_output)
+{
+    auto input = sine(440, 44100, 2000);
+    Audio::SincResampler whole_resampler(44100, 48000);
+    Audio::SincResampler chunked_resampler(44100, 48000);
+
+    auto whole = resample_in_chunks(whole_resampler, input, input.size());
+    auto chunked = resample_in_chunks(chunked_resampler, input, 37);
+    EXPECT_EQ(whole.size(), chunked.size());
+    for (size_t i = 0; i < min(whole.size(), chunked.size()); ++i)
+        EXPECT_EQ(whole[i].left, chunked[i].left);
+}
+
+TEST_CASE(downsampling_removes_frequencies_above_new_nyquist)
+{
+    Audio::SincResampler passing_resampler(48000, 24000);
+    auto passed = resample_in_chunks(passing_resampler, sine(1000, 48000, 4800), 100);
+    EXPECT(rms(passed.span().slice(Audio::SincResampler::tap_count)) > 0.69f);
+
+    Audio::SincResampler filtering_resampler(48000, 24000);
+    auto filtered = resample_in_chunks(filtering_resampler, sine(20000, 48000, 4800), 100);
+    EXPECT(rms(filtered.span().slice(Audio::SincResampler::tap_count)) < 0.001f);
+}
@@ -29,3 +29,45 @@ TEST_CASE(strtok_r_delimiters_only)
     // The string to which `saved_str` initially points to shouldn't be modified.
     EXPECT_EQ(strcmp(dummy, "a;"), 0);
 }
+
+TEST_CASE(string_functions_at_all_alignments)
+{
+    // strlen(), memchr() and memcmp() look at many bytes at a time, so check every alignment and every length
+    // around the size of a chunk.
+    alignas(16) char buffer[128];
+    alignas(16) char other[128];
+    for (size_t offset = 0; offset < 16; ++offset) {
+        for (size_t length = 0; length < 64; ++length) {
+            memset(buffer, 'x', sizeof(buffer));
+            buffer[offset + length] = '\0';
+            EXPECT_EQ(strlen(buffer + offset), length);
+
+            buffer[offset + length] = 'y';
+            EXPECT_EQ(memchr(buffer + offset, 'y', length + 1), buffer + offset + length);
+            EXPECT_EQ(memchr(buffer + offset, 'y', length), nullptr);
+
+            memcpy(other, buffer + offset, length + 1);
+            EXPECT_EQ(memcmp(buffer + offset, other, length + 1), 0);
+            other[length] = 'z';
+            EXPECT(memcmp(buffer + offset, other, length + 1) < 0);
+            EXPECT(memcmp(other, buffer + offset, length + 1) > 0);
+        }
+    }
+}
+
+BENCHMARK_CASE(strlen_long_string)
+{
+    static char string[1 * MiB];
+    memset(string, 'x', sizeof(string) - 1);
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(strlen(string), sizeof(string) - 1);
+}
+
+BENCHMARK_CASE(memchr_long_buffer)
+{
+    static char buffer[1 * MiB];
+    memset(buffer, 'x', sizeof(buffer));
+    buffer[sizeof(buffer) - 1] = 'y';
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(memchr(buffer, 'y', sizeof(buffer)), &buffer[sizeof(buffer) - 1]);
+}
@@ -6,9 +6,12 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/Array.h>
 #include <errno.h>
 #include <mallocdefs.h>
+#include <pthread.h>
 #include <stdlib.h>
+#include <string.h>
 
 TEST_CASE(malloc_limits)
 {
@@ -38,3 +41,88 @@ TEST_CASE(malloc_limits)
         return Test::Crash::Failure::DidNotCrash;
     });
 }
+
+static constexpr size_t cross_thread_allocation_count = 1000;
+
+static void* allocate_and_fill(void* argument)
+{
+    auto& allocations = *static_cast<Array<u8*, cross_thread_allocation_count>*>(argument);
+    for (size_t i = 0; i < allocations.size(); ++i) {
+        auto size = size_classes[i % num_size_classes];
+        allocations[i] = static_cast<u8*>(malloc(size));
+        memset(allocations[i], static_cast<u8>(i), size);
+    }
+    return nullptr;
+}
+
+TEST_CASE(free_on_another_thread)
+{
+    Array<u8*, cross_thread_allocation_count> allocations {};
+    pthread_t thread;
+    EXPECT_EQ(pthread_create(&thread, nullptr, allocate_and_fill, &allocations), 0);
+    EXPECT_EQ(pthread_join(thread, nullptr), 0);
+
+    for (size_t i = 0; i < allocations.size(); ++i) {
+        auto size = size_classes[i % num_size_classes];
+        EXPECT(malloc_size(allocations[i]) >= size);
+        EXPECT_EQ(allocations[i][size - 1], static_cast<u8>(i));
+        free(allocations[i]);
+    }
+
+    // The chunks we just freed have to be handed out again without overlapping.
+    Array<u8*, cross_thread_allocation_count> reallocations {};
+    allocate_and_fill(&reallocations);
+    for (size_t i = 0; i < reallocations.size(); ++i) {
+        auto size = size_classes[i % num_size_classes];
+        EXPECT_EQ(reallocations[i][0], static_cast<u8>(i));
+        EXPECT_EQ(reallocations[i][size - 1], static_cast<u8>(i));
+        free(reallocations[i]);
+    }
+}
+
+TEST_CASE(realloc_big_allocation_preserves_contents)
+{
+    size_t size = 256 * KiB;
+    auto* buffer = static_cast<u8*>(malloc(size));
+    EXPECT_NE(buffer, nullptr);
+    for (size_t i = 0; i < size; ++i)
+        buffer[i] = static_cast<u8>(i);
+
+    // Grow, which might be done in place.
+    buffer = static_cast<u8*>(realloc(buffer, 4 * size));
+    EXPECT_NE(buffer, nullptr);
+    EXPECT(malloc_size(buffer) >= 4 * size);
+    for (size_t i = 0; i < size; ++i)
+        EXPECT_EQ(buffer[i], static_cast<u8>(i));
+    memset(buffer + size, 0xab, 3 * size);
+
+    // Shrink, which releases the tail.
+    buffer = static_cast<u8*>(realloc(buffer, size / 2));
+    EXPECT_NE(buffer, nullptr);
+    EXPECT(malloc_size(buffer) >= size / 2);
+    for (size_t i = 0; i < size / 2; ++i)
+        EXPECT_EQ(buffer[i], static_cast<u8>(i));
+    free(buffer);
+}
+
+TEST_CASE(malloc_statistics_and_trim)
+{
+    serenity_malloc_statistics before {};
+    serenity_get_malloc_statistics(&before);
+
+    auto* big = malloc(1 * MiB);
+    EXPECT_NE(big, nullptr);
+    serenity_malloc_statistics during {};
+    serenity_get_malloc_statistics(&during);
+    EXPECT_EQ(during.big_allocation_count, before.big_allocation_count + 1);
+    EXPECT(during.big_allocation_bytes >= before.big_allocation_bytes + 1 * MiB);
+    free(big);
+
+    malloc_trim(0);
+    serenity_malloc_statistics after {};
+    serenity_get_malloc_statistics(&after);
+    EXPECT_EQ(after.big_allocation_count, before.big_allocation_count);
+    EXPECT_EQ(after.hot_empty_block_count, 0u);
+    EXPECT_EQ(after.cold_empty_block_count, 0u);
+    EXPECT_EQ(after.recycled_big_block_count, 0u);
+}
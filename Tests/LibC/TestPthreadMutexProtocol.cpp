@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <pthread.h>
+
+static void initialize_priority_inheriting_mutex(pthread_mutex_t& mutex, int type = PTHREAD_MUTEX_NORMAL)
+{
+    pthread_mutexattr_t attributes;
+    EXPECT_EQ(pthread_mutexattr_init(&attributes), 0);
+    EXPECT_EQ(pthread_mutexattr_settype(&attributes, type), 0);
+    EXPECT_EQ(pthread_mutexattr_setprotocol(&attributes, PTHREAD_PRIO_INHERIT), 0);
+    EXPECT_EQ(pthread_mutex_init(&mutex, &attributes), 0);
+    EXPECT_EQ(pthread_mutexattr_destroy(&attributes), 0);
+}
+
+TEST_CASE(protocol_attribute)
+{
+    pthread_mutexattr_t attributes;
+    EXPECT_EQ(pthread_mutexattr_init(&attributes), 0);
+
+    int protocol = -1;
+    EXPECT_EQ(pthread_mutexattr_getprotocol(&attributes, &protocol), 0);
+    EXPECT_EQ(protocol, PTHREAD_PRIO_NONE);
+
+    EXPECT_EQ(pthread_mutexattr_setprotocol(&attributes, PTHREAD_PRIO_INHERIT), 0);
+    EXPECT_EQ(pthread_mutexattr_getprotocol(&attributes, &protocol), 0);
+    EXPECT_EQ(protocol, PTHREAD_PRIO_INHERIT);
+
+    EXPECT_EQ(pthread_mutexattr_setprotocol(&attributes, 42), ENOTSUP);
+    EXPECT_EQ(pthread_mutexattr_destroy(&attributes), 0);
+}
+
+TEST_CASE(priority_inheriting_lock_and_trylock)
+{
+    pthread_mutex_t mutex;
+    initialize_priority_inheriting_mutex(mutex);
+
+    EXPECT_EQ(pthread_mutex_lock(&mutex), 0);
+    EXPECT_EQ(pthread_mutex_trylock(&mutex), EBUSY);
+    EXPECT_EQ(pthread_mutex_unlock(&mutex), 0);
+
+    EXPECT_EQ(pthread_mutex_trylock(&mutex), 0);
+    EXPECT_EQ(pthread_mutex_unlock(&mutex), 0);
+    EXPECT_EQ(pthread_mutex_destroy(&mutex), 0);
+}
+
+TEST_CASE(priority_inheriting_recursive_lock)
+{
+    pthread_mutex_t mutex;
+    initialize_priority_inheriting_mutex(mutex, PTHREAD_MUTEX_RECURSIVE);
+
+    EXPECT_EQ(pthread_mutex_lock(&mutex), 0);
+    EXPECT_EQ(pthread_mutex_lock(&mutex), 0);
+    EXPECT_EQ(pthread_mutex_trylock(&mutex), 0);
+    EXPECT_EQ(pthread_mutex_unlock(&mutex), 0);
+    EXPECT_EQ(pthread_mutex_unlock(&mutex), 0);
+    EXPECT_EQ(pthread_mutex_unlock(&mutex), 0);
+
+    // The mutex has to be free for others now.
+    EXPECT_EQ(mutex.lock, 0u);
+    EXPECT_EQ(pthread_mutex_destroy(&mutex), 0);
+}
+
+static pthread_mutex_t s_contended_mutex;
+static u32 s_counter = 0;
+static constexpr u32 increments_per_thread = 10000;
+
+static void* increment_counter(void*)
+{
+    for (u32 i = 0; i < increments_per_thread; ++i) {
+        pthread_mutex_lock(&s_contended_mutex);
+        ++s_counter;
+        pthread_mutex_unlock(&s_contended_mutex);
+    }
+    return nullptr;
+}
+
+TEST_CASE(priority_inheriting_contention)
+{
+    initialize_priority_inheriting_mutex(s_contended_mutex);
+
+    static constexpr size_t thread_count = 4;
+    pthread_t threads[thread_count];
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_create(&thread, nullptr, increment_counter, nullptr), 0);
+    for (auto& thread : threads)
+        EXPECT_EQ(pthread_join(thread, nullptr), 0);
+
+    EXPECT_EQ(s_counter, thread_count * increments_per_thread);
+    EXPECT_EQ(s_contended_mutex.lock, 0u);
+    EXPECT_EQ(pthread_mutex_destroy(&s_contended_mutex), 0);
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitStream.h>
+#include <AK/MemoryStream.h>
+#include <AK/Random.h>
+#include <LibCompress/Deflate.h>
+#include <LibTest/TestCase.h>
+
+// Somewhat compressible data: words made of a few letters, with some random bytes in between.
+static ByteBuffer create_test_data()
+{
+    auto data = MUST(ByteBuffer::create_uninitialized(16 * MiB));
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (i % 64 < 4)
+            data[i] = get_random<u8>();
+        else
+            data[i] = "the quick brown fox jumps over the lazy dog "[(i * 13 / 7) % 44];
+    }
+    return data;
+}
+
+static ByteBuffer const& test_data()
+{
+    static auto data = create_test_data();
+    return data;
+}
+
+static ByteBuffer const& compressed_test_data()
+{
+    static auto data = MUST(Compress::DeflateCompressor::compress_all(test_data(), Compress::DeflateCompressor::CompressionLevel::FAST));
+    return data;
+}
+
+BENCHMARK_CASE(decompress_stream)
+{
+    FixedMemoryStream memory_stream { compressed_test_data().bytes() };
+    LittleEndianInputBitStream bit_stream { MaybeOwned<Stream>(memory_stream) };
+    auto deflate_stream = MUST(Compress::DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream>(bit_stream)));
+    auto decompressed = MUST(deflate_stream->read_until_eof(4096));
+    EXPECT_EQ(decompressed.size(), test_data().size());
+}
+
+BENCHMARK_CASE(decompress_all)
+{
+    auto decompressed = MUST(Compress::DeflateDecompressor::decompress_all(compressed_test_data()));
+    EXPECT_EQ(decompressed.size(), test_data().size());
+}
+
+BENCHMARK_CASE(decompress_into)
+{
+    auto output = MUST(ByteBuffer::create_uninitialized(test_data().size()));
+    auto size = MUST(Compress::DeflateDecompressor::decompress_into(compressed_test_data(), output));
+    EXPECT_EQ(size, test_data().size());
+}
@@ -180,3 +180,73 @@ TEST_CASE(ossfuzz_58046)
     auto test_data = TRY_OR_FAIL(test_file->read_until_eof());
     EXPECT(Compress::DeflateDecompressor::decompress_all(test_data).is_error());
 }
+
+TEST_CASE(deflate_decompress_into)
+{
+    auto original = ByteBuffer::create_zeroed(4096).release_value();
+    fill_with_random(original.bytes().trim(2048));
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::FAST));
+
+    auto output = ByteBuffer::create_uninitialized(original.size()).release_value();
+    auto size = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_into(compressed, output));
+    EXPECT_EQ(size, original.size());
+    EXPECT(output == original);
+
+    auto too_small_output = ByteBuffer::create_uninitialized(original.size() - 1).release_value();
+    EXPECT(Compress::DeflateDecompressor::decompress_into(compressed, too_small_output).is_error());
+}
+
+TEST_CASE(deflate_decompress_all_matches_stream)
+{
+    // Short runs of a few different bytes make for plenty of overlapping back references.
+    auto original = ByteBuffer::create_uninitialized(3 * Compress::DeflateCompressor::block_size).release_value();
+    for (size_t i = 0; i < original.size(); ++i)
+        original[i] = "abcabcdabcdeaaaa"[(i * 7 / 5) % 16] + (i % 1000 < 50 ? get_random_uniform(4) : 0);
+
+    for (auto level : { Compress::DeflateCompressor::CompressionLevel::STORE, Compress::DeflateCompressor::CompressionLevel::FAST, Compress::DeflateCompressor::CompressionLevel::GREAT }) {
+        auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, level));
+
+        auto decompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+        EXPECT(decompressed == original);
+
+        FixedMemoryStream memory_stream { compressed.bytes() };
+        LittleEndianInputBitStream bit_stream { MaybeOwned<Stream>(memory_stream) };
+        auto deflate_stream = TRY_OR_FAIL(Compress::DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream>(bit_stream)));
+        auto streamed = TRY_OR_FAIL(deflate_stream->read_until_eof(4096));
+        EXPECT(streamed == decompressed);
+
+        // Cutting off the end of the data must be noticed.
+        EXPECT(Compress::DeflateDecompressor::decompress_all(compressed.bytes().trim(compressed.size() - 1)).is_error());
+    }
+}
+
+TEST_CASE(deflate_compress_chunk_with_dictionary)
+{
+    auto original = ByteBuffer::create_uninitialized(16 * KiB).release_value();
+    fill_with_random(original);
+
+    // With the data itself as the dictionary, all of it can be encoded as back references.
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_chunk(original, true, Compress::DeflateCompressor::CompressionLevel::GOOD, original));
+    EXPECT(compressed.size() < original.size() / 16);
+
+    auto prefixed_original = TRY_OR_FAIL(ByteBuffer::copy(original));
+    TRY_OR_FAIL(prefixed_original.try_append(original));
+    auto prefixed_compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_chunk(original, false, Compress::DeflateCompressor::CompressionLevel::GOOD));
+    TRY_OR_FAIL(prefixed_compressed.try_append(compressed));
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(prefixed_compressed));
+    EXPECT(uncompressed == prefixed_original);
+}
+
+TEST_CASE(deflate_round_trip_compress_in_parallel)
+{
+    auto original = ByteBuffer::create_uninitialized(5 * Compress::DeflateCompressor::parallel_chunk_size + 1234).release_value();
+    fill_with_random(original.bytes().trim(Compress::DeflateCompressor::parallel_chunk_size + 4 * KiB));
+    for (size_t i = Compress::DeflateCompressor::parallel_chunk_size + 4 * KiB; i < original.size(); ++i)
+        original[i] = original[i - 10 * KiB];
+
+    auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all_in_parallel(original, Compress::DeflateCompressor::CompressionLevel::FAST));
+    auto serially_compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(original, Compress::DeflateCompressor::CompressionLevel::FAST));
+    EXPECT(compressed.size() < serially_compressed.size() + serially_compressed.size() / 10);
+    auto uncompressed = TRY_OR_FAIL(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
@@ -95,6 +95,74 @@ TEST_CASE(compress_long_overflow_chain)
     EXPECT_EQ(uncompressed, result.span());
 }
 
+static ByteBuffer generate_compressible_data(size_t size)
+{
+    // Words in a random order, with occasional runs of random bytes and long repetitions of a single byte.
+    constexpr Array words { "alpha "sv, "beta "sv, "gamma "sv, "delta "sv, "serenity "sv, "kernel "sv, "compress "sv, "\n"sv };
+
+    ByteBuffer data;
+    u32 state = 42;
+    auto next_random = [&] {
+        state = state * 1103515245 + 12345;
+        return state >> 16;
+    };
+
+    while (data.size() < size) {
+        auto choice = next_random() % 500;
+        if (choice < 2) {
+            for (size_t i = 0; i < 300; ++i)
+                data.append(static_cast<u8>(next_random()));
+        } else if (choice == 2) {
+            for (size_t i = 0; i < 2000; ++i)
+                data.append('x');
+        } else {
+            data.append(words[next_random() % words.size()].bytes());
+        }
+    }
+
+    data.resize(size);
+    return data;
+}
+
+static void test_roundtrip(ReadonlyBytes uncompressed, Compress::LzmaCompressorOptions const& options)
+{
+    auto stream = MUST(try_make<AllocatingMemoryStream>());
+    auto compressor = TRY_OR_FAIL(Compress::LzmaCompressor::create_container(MaybeOwned<Stream> { *stream }, options));
+    TRY_OR_FAIL(compressor->write_until_depleted(uncompressed));
+    if (!options.uncompressed_size.has_value())
+        TRY_OR_FAIL(compressor->flush());
+
+    // The data has a lot of repetitions, so finding them should make it a lot smaller.
+    EXPECT(stream->used_buffer_size() < uncompressed.size() / 3);
+
+    auto decompressor = TRY_OR_FAIL(Compress::LzmaDecompressor::create_from_container(MaybeOwned<Stream> { *stream }));
+    auto result = TRY_OR_FAIL(decompressor->read_until_eof());
+
+    EXPECT_EQ(uncompressed, result.span());
+}
+
+TEST_CASE(compress_decompress_roundtrip_with_match_finders)
+{
+    // The data is much larger than the dictionary, so the match finders have to move their windows a few times.
+    auto const uncompressed = generate_compressible_data(1 * MiB);
+
+    for (auto match_finder : { Compress::LzmaMatchFinderType::HashChain, Compress::LzmaMatchFinderType::BinaryTree }) {
+        test_roundtrip(uncompressed, { .dictionary_size = 64 * KiB, .match_finder = match_finder });
+        test_roundtrip(uncompressed, { .dictionary_size = 64 * KiB, .uncompressed_size = uncompressed.size(), .match_finder = match_finder, .nice_match_length = 273 });
+    }
+}
+
+TEST_CASE(compress_decompress_roundtrip_with_presets)
+{
+    auto const uncompressed = generate_compressible_data(256 * KiB);
+
+    for (u8 preset = 0; preset <= Compress::LzmaCompressorOptions::maximum_preset; ++preset) {
+        auto options = Compress::LzmaCompressorOptions::from_preset(preset);
+        options.uncompressed_size = uncompressed.size();
+        test_roundtrip(uncompressed, options);
+    }
+}
+
 // The following tests are based on test files from the LZMA specification, which has been placed in the public domain.
 // LZMA Specification Draft (2015): https://www.7-zip.org/a/lzma-specification.7z
 
@@ -1939,6 +1939,9 @@ TEST_CASE(xz_utils_good_2_lzma2)
     auto decompressor = MUST(Compress::XzDecompressor::create(move(stream)));
     auto buffer = TRY_OR_FAIL(decompressor->read_until_eof(PAGE_SIZE));
     EXPECT_EQ(buffer.span(), xz_utils_hello_world.bytes());
+
+    auto all_at_once = TRY_OR_FAIL(Compress::XzDecompressor::decompress_all(compressed));
+    EXPECT_EQ(all_at_once.span(), xz_utils_hello_world.bytes());
 }
 
 // The following test files are designated as "unsupported", which usually means that they test indicators
@@ -2057,3 +2060,64 @@ TEST_CASE(xz_utils_unsupported_filter_flags_3)
     auto buffer_or_error = decompressor->read_until_eof(PAGE_SIZE);
     EXPECT(buffer_or_error.is_error());
 }
+
+TEST_CASE(xz_decompress_all_multiple_blocks)
+{
+    // Created with `xz --block-size=1024 --check=crc32`, which splits the input into four Blocks.
+    Array<u8, 568> const compressed {
+        0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, 0x01, 0x69, 0x22, 0xDE, 0x36, 0x02, 0x00, 0x21, 0x01,
+        0x16, 0x00, 0x00, 0x00, 0x74, 0x2F, 0xE5, 0xA3, 0xE0, 0x03, 0xFF, 0x00, 0x69, 0x5D, 0x00, 0x26,
+        0x1A, 0x49, 0xC6, 0x67, 0x41, 0x3B, 0x27, 0x86, 0x82, 0x9F, 0xE2, 0x39, 0x92, 0xB2, 0xB8, 0xBD,
+        0x06, 0xBF, 0x21, 0x27, 0xA2, 0xA2, 0x22, 0xD7, 0xF0, 0xC2, 0x81, 0xF5, 0xB4, 0x89, 0x5C, 0xBF,
+        0x86, 0x30, 0x3F, 0x17, 0x43, 0x36, 0x3D, 0x99, 0x2F, 0x00, 0x3B, 0x79, 0x30, 0x64, 0xFB, 0xD8,
+        0x57, 0xEF, 0xC4, 0x91, 0x56, 0xC0, 0x98, 0x95, 0x48, 0xC9, 0xDB, 0x25, 0xAD, 0x0B, 0x85, 0x4D,
+        0x5E, 0xCB, 0x4D, 0x30, 0x02, 0x8F, 0x5C, 0x89, 0x13, 0xEF, 0x55, 0x4F, 0xCF, 0xD1, 0xE5, 0xE4,
+        0x95, 0x04, 0x11, 0x57, 0x65, 0x8D, 0xCB, 0x2A, 0xD2, 0x18, 0x8C, 0xD6, 0xF6, 0x5D, 0x0C, 0xD3,
+        0xA6, 0xB9, 0x8B, 0x82, 0x34, 0xC4, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8D, 0x8E, 0x55, 0x57,
+        0x02, 0x00, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x74, 0x2F, 0xE5, 0xA3, 0xE0, 0x03, 0xFF, 0x00,
+        0x67, 0x5D, 0x00, 0x3A, 0x9B, 0x0A, 0xEF, 0x32, 0x9E, 0xCE, 0x20, 0xE6, 0xA9, 0xA0, 0x5C, 0xC8,
+        0x5B, 0x7F, 0xEA, 0xF4, 0xC8, 0x04, 0xB3, 0xE7, 0x9B, 0x99, 0x60, 0xCE, 0xCA, 0xB5, 0xB8, 0x91,
+        0x24, 0xF5, 0x39, 0x4E, 0x31, 0x7B, 0x4C, 0x22, 0xE7, 0xB5, 0xB4, 0x52, 0x97, 0xC5, 0xCE, 0x67,
+        0x6C, 0x54, 0x70, 0xD6, 0x33, 0x2E, 0x60, 0x26, 0xC4, 0x75, 0x62, 0x70, 0x53, 0x82, 0x89, 0x7C,
+        0x0D, 0xBD, 0x4B, 0x19, 0x34, 0x17, 0x38, 0x64, 0x5D, 0xBC, 0x90, 0x27, 0xF9, 0x05, 0xA0, 0x07,
+        0xF9, 0x4E, 0xF9, 0x4A, 0x0D, 0xDF, 0xA7, 0xED, 0x9C, 0x0E, 0x45, 0x10, 0x46, 0x8E, 0xF4, 0x11,
+        0x58, 0xD5, 0xD9, 0xDE, 0xF9, 0xE5, 0x86, 0xD0, 0xD0, 0x00, 0x00, 0x00, 0xC8, 0xEE, 0xF4, 0x02,
+        0x02, 0x00, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x74, 0x2F, 0xE5, 0xA3, 0xE0, 0x03, 0xFF, 0x00,
+        0x68, 0x5D, 0x00, 0x16, 0x98, 0x89, 0x87, 0x21, 0x2C, 0x5A, 0x10, 0x13, 0x87, 0x49, 0x87, 0xCC,
+        0x99, 0x31, 0x5F, 0x9E, 0x5E, 0x07, 0xC2, 0x38, 0xBF, 0x3F, 0xDC, 0x02, 0xE1, 0x59, 0x08, 0xFA,
+        0x24, 0x5E, 0xC0, 0xD6, 0x3B, 0x55, 0xE0, 0xFE, 0x1B, 0xFF, 0x3E, 0xE9, 0xEF, 0x9F, 0x53, 0x99,
+        0x10, 0xC5, 0x6B, 0xDB, 0x77, 0x50, 0xD1, 0x69, 0x18, 0x2F, 0xD4, 0xEA, 0x24, 0xC0, 0xF1, 0x27,
+        0x42, 0x18, 0x6B, 0xC4, 0xFD, 0xD6, 0x2C, 0x48, 0x69, 0x6F, 0xB3, 0xEE, 0x5E, 0x99, 0xDB, 0x92,
+        0xD6, 0x80, 0xA2, 0x86, 0x0F, 0xB0, 0xB1, 0xF8, 0xA8, 0x48, 0x36, 0x4A, 0xDE, 0xE8, 0xE4, 0x11,
+        0x29, 0xFE, 0x4F, 0xBF, 0xB6, 0x71, 0x91, 0xC1, 0x32, 0x76, 0x98, 0x00, 0xAA, 0x2B, 0x5B, 0x4A,
+        0x02, 0x00, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x74, 0x2F, 0xE5, 0xA3, 0xE0, 0x03, 0xF9, 0x00,
+        0x6C, 0x5D, 0x00, 0x31, 0x9A, 0xC0, 0x04, 0x81, 0x86, 0x4C, 0xC2, 0xD2, 0x77, 0x88, 0xDF, 0x85,
+        0xD5, 0x0F, 0xFB, 0x91, 0x1B, 0x8E, 0x93, 0x10, 0xB7, 0x76, 0xA3, 0xF4, 0x7F, 0x5D, 0x22, 0xFE,
+        0x9D, 0xDE, 0x83, 0x75, 0x77, 0x6A, 0xAF, 0x80, 0x46, 0x4F, 0x1C, 0xA6, 0x31, 0xAF, 0x9D, 0x4D,
+        0x3B, 0x82, 0xD0, 0xCD, 0xE5, 0xE1, 0xA9, 0xA2, 0xCA, 0x64, 0xDC, 0x5E, 0x5F, 0x25, 0xD5, 0x0D,
+        0x71, 0xBF, 0x71, 0xFD, 0x8C, 0x02, 0xC7, 0xAE, 0x57, 0x6A, 0x35, 0x9C, 0xD4, 0xE2, 0x9C, 0x41,
+        0x30, 0x00, 0x64, 0xFA, 0x4B, 0x2E, 0x9D, 0x5F, 0x48, 0xF8, 0x98, 0x28, 0xA1, 0x9A, 0xF7, 0x1D,
+        0x88, 0xED, 0x87, 0x46, 0xEA, 0x83, 0x65, 0x0E, 0xC7, 0xBE, 0xC4, 0x60, 0x20, 0x72, 0x00, 0x00,
+        0x1B, 0xAE, 0x4F, 0xB2, 0x00, 0x04, 0x81, 0x01, 0x80, 0x08, 0x7F, 0x80, 0x08, 0x80, 0x01, 0x80,
+        0x08, 0x84, 0x01, 0xFA, 0x07, 0x00, 0x00, 0x00, 0x3F, 0x50, 0x0E, 0xAC, 0x86, 0x00, 0x08, 0x96,
+        0x05, 0x00, 0x00, 0x00, 0x00, 0x01, 0x59, 0x5A
+    };
+
+    StringBuilder expected;
+    for (size_t i = 0; i < 120; i++)
+        expected.appendff("Line {} of a multi-block XZ file.\n", i);
+
+    auto buffer = TRY_OR_FAIL(Compress::XzDecompressor::decompress_all(compressed));
+    EXPECT_EQ(StringView { buffer.bytes() }, expected.string_view());
+
+    // The streaming decoder has to produce the same.
+    auto stream = MUST(try_make<FixedMemoryStream>(compressed));
+    auto decompressor = MUST(Compress::XzDecompressor::create(move(stream)));
+    auto streamed_buffer = TRY_OR_FAIL(decompressor->read_until_eof(PAGE_SIZE));
+    EXPECT_EQ(streamed_buffer, buffer);
+
+    // Damaging the header of the third Block is noticed, even though the Blocks are decoded independently.
+    auto damaged = TRY_OR_FAIL(ByteBuffer::copy(compressed));
+    damaged[272 + 5] ^= 0x55;
+    EXPECT(Compress::XzDecompressor::decompress_all(damaged).is_error());
+}
@@ -46,6 +46,27 @@ TEST_CASE(zlib_compress_simple)
     EXPECT(freshly_pressed.value().bytes() == compressed.span());
 }
 
+TEST_CASE(zlib_compress_chunks)
+{
+    auto uncompressed = TRY_OR_FAIL(ByteBuffer::create_uninitialized(200 * KiB));
+    for (size_t i = 0; i < uncompressed.size(); ++i)
+        uncompressed[i] = (i * i) >> 7;
+
+    Vector<ByteBuffer> compressed_chunks;
+    size_t const chunk_size = 64 * KiB;
+    for (size_t offset = 0; offset < uncompressed.size(); offset += chunk_size) {
+        auto chunk = uncompressed.bytes().slice(offset, min(chunk_size, uncompressed.size() - offset));
+        bool is_last_chunk = offset + chunk.size() == uncompressed.size();
+        compressed_chunks.append(TRY_OR_FAIL(Compress::ZlibCompressor::compress_chunk(chunk, is_last_chunk)));
+    }
+    auto compressed = TRY_OR_FAIL(Compress::ZlibCompressor::create_from_compressed_chunks(compressed_chunks, uncompressed));
+
+    auto stream = make<FixedMemoryStream>(compressed.bytes());
+    auto decompressor = TRY_OR_FAIL(Compress::ZlibDecompressor::create(move(stream)));
+    auto decompressed = TRY_OR_FAIL(decompressor->read_until_eof());
+    EXPECT(decompressed.bytes() == uncompressed.bytes());
+}
+
 TEST_CASE(zlib_decompress_with_missing_end_bits)
 {
     // This test case has been extracted from compressed PNG data of `/res/icons/16x16/app-masterword.png`.
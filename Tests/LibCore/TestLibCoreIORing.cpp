@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/IORing.h>
+#include <LibCore/System.h>
+#include <LibTest/AsyncTestCase.h>
+#include <fcntl.h>
+#include <poll.h>
+
+ASYNC_TEST_CASE(read_and_write_at_offsets)
+{
+    auto& ring = Core::IORing::the();
+
+    char path[] = "/tmp/TestLibCoreIORing.XXXXXX";
+    auto fd = CO_TRY_OR_FAIL(Core::System::mkstemp(path));
+    CO_TRY_OR_FAIL(Core::System::unlink({ path, sizeof(path) - 1 }));
+
+    auto written = CO_TRY_OR_FAIL(co_await ring.write(fd, "world"sv.bytes(), 6));
+    EXPECT_EQ(written, 5u);
+    written = CO_TRY_OR_FAIL(co_await ring.write(fd, "hello "sv.bytes(), 0));
+    EXPECT_EQ(written, 6u);
+    CO_TRY_OR_FAIL(co_await ring.fsync(fd));
+
+    Array<u8, 16> buffer;
+    auto nread = CO_TRY_OR_FAIL(co_await ring.read(fd, buffer, 0));
+    EXPECT_EQ(StringView(buffer.span().trim(nread)), "hello world"sv);
+
+    CO_TRY_OR_FAIL(Core::System::close(fd));
+}
+
+ASYNC_TEST_CASE(many_operations_in_flight)
+{
+    auto& ring = Core::IORing::the();
+    auto fd = CO_TRY_OR_FAIL(Core::System::open("/dev/zero"sv, O_RDONLY));
+
+    // More operations than fit into the submission ring at once.
+    static constexpr size_t operation_count = Core::IORing::default_entries * 3;
+    Vector<Array<u8, 64>> buffers;
+    buffers.resize(operation_count);
+    Vector<Coroutine<ErrorOr<size_t>>> reads;
+    for (auto& buffer : buffers) {
+        buffer.fill(0xff);
+        reads.append(ring.read(fd, buffer));
+    }
+
+    for (auto& read : reads) {
+        auto nread = CO_TRY_OR_FAIL(co_await read);
+        EXPECT_EQ(nread, 64u);
+    }
+    for (auto& buffer : buffers)
+        EXPECT(all_of(buffer, [](u8 byte) { return byte == 0; }));
+
+    CO_TRY_OR_FAIL(Core::System::close(fd));
+}
+
+ASYNC_TEST_CASE(stream_over_a_pipe)
+{
+    auto fds = CO_TRY_OR_FAIL(Core::System::pipe2(O_CLOEXEC | O_NONBLOCK));
+    auto reader = CO_TRY_OR_FAIL(Core::IORingStream::adopt_fd(fds[0]));
+    auto writer = CO_TRY_OR_FAIL(Core::IORingStream::adopt_fd(fds[1]));
+
+    auto read = reader->read(11);
+    EXPECT(!read.await_ready());
+
+    Array<ReadonlyBytes, 2> buffers { "hello "sv.bytes(), "world"sv.bytes() };
+    CO_TRY_OR_FAIL(co_await writer->write(buffers));
+    CO_TRY_OR_FAIL(co_await writer->close());
+
+    auto data = CO_TRY_OR_FAIL(co_await read);
+    EXPECT_EQ(StringView { data }, "hello world"sv);
+
+    auto [rest, is_eof] = CO_TRY_OR_FAIL(co_await reader->peek_or_eof());
+    EXPECT(rest.is_empty());
+    EXPECT(is_eof);
+    CO_TRY_OR_FAIL(co_await reader->close());
+}
+
+ASYNC_TEST_CASE(poll_for_readiness)
+{
+    auto& ring = Core::IORing::the();
+    auto fds = CO_TRY_OR_FAIL(Core::System::pipe2(O_CLOEXEC));
+
+    auto revents = CO_TRY_OR_FAIL(co_await ring.poll(fds[1], POLLOUT));
+    EXPECT_EQ(revents, POLLOUT);
+
+    auto poll = ring.poll(fds[0], POLLIN);
+    CO_TRY_OR_FAIL(Core::System::write(fds[1], "x"sv.bytes()));
+    revents = CO_TRY_OR_FAIL(co_await poll);
+    EXPECT_EQ(revents, POLLIN);
+
+    CO_TRY_OR_FAIL(Core::System::close(fds[0]));
+    CO_TRY_OR_FAIL(Core::System::close(fds[1]));
+}
@@ -306,6 +306,42 @@ TEST_CASE(test_AES_CTR_256bit_encrypt_36bytes_with_high_counter)
     test_aes_ctr_encrypt(AS_BB(key), AS_BB(ivec), AS_BB(in), AS_BB(out));
 }
 
+TEST_CASE(test_AES_CTR_many_blocks_match_single_blocks)
+{
+    // Long enough for the key stream to be generated in batches, and ends with a partial block.
+    u8 key[32];
+    u8 ivec[16];
+    u8 in[333];
+    for (size_t i = 0; i < sizeof(key); ++i)
+        key[i] = i * 13 + 5;
+    for (size_t i = 0; i < sizeof(ivec); ++i)
+        ivec[i] = i < 14 ? i : 0xfa; // Makes the counter carry over into the next byte.
+    for (size_t i = 0; i < sizeof(in); ++i)
+        in[i] = i * 7 + 3;
+
+    for (size_t key_bits : { 128, 192, 256 }) {
+        ReadonlyBytes key_bytes { key, key_bits / 8 };
+        Crypto::Cipher::AESCipher block_cipher(key_bytes, key_bits, Crypto::Cipher::Intent::Encryption);
+        u8 expected[sizeof(in)];
+        u8 counter[16];
+        memcpy(counter, ivec, sizeof(counter));
+        Bytes counter_bytes { counter, sizeof(counter) };
+        for (size_t offset = 0; offset < sizeof(in); offset += 16) {
+            Crypto::Cipher::AESCipherBlock block(counter, sizeof(counter));
+            block_cipher.encrypt_block(block, block);
+            for (size_t i = offset; i < min(offset + 16, sizeof(in)); ++i)
+                expected[i] = in[i] ^ block.bytes()[i - offset];
+            Crypto::Cipher::IncrementInplace {}(counter_bytes);
+        }
+
+        Crypto::Cipher::AESCipher::CTRMode cipher(key_bytes, key_bits, Crypto::Cipher::Intent::Encryption);
+        auto out = ByteBuffer::create_zeroed(sizeof(in)).release_value();
+        auto out_span = out.bytes();
+        cipher.encrypt(AS_BB(in), out_span, AS_BB(ivec));
+        EXPECT(memcmp(expected, out.data(), sizeof(in)) == 0);
+    }
+}
+
 static auto test_aes_ctr_decrypt = [](auto key, auto ivec, auto in, auto out_expected) {
     // nonce is already included in ivec.
     Crypto::Cipher::AESCipher::CTRMode cipher(key, 8 * key.size(), Crypto::Cipher::Intent::Decryption);
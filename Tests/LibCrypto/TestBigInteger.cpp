@@ -335,6 +335,18 @@ TEST_CASE(test_bigint_modular_power_extra_tests)
     }
 }
 
+TEST_CASE(test_bigint_modular_power_short_exponent)
+{
+    // A public RSA operation, which uses the short exponent path.
+    auto base = "9442954144609909329123740048217147843282987798861407395693845664835248548153279305484288297561816362558828630640424796426452477048523731449311391739090413796040152650083190303571012310566690160086347053008944631776986514519566235353533278827661552516852088153633100400338142134890590837933056690278223"_bigint;
+    auto modulo = "127407160288666748789284314724484747812380996297178154499824666755907013267934294410802640118552832542192600857324576203429678531653020606947911273485365716577450071302790220550104182715196868190802097827263177526432961487173120855236666381886777771188369344309054155260978966194326080332267167765843867449921"_bigint;
+    auto expected = "41874223685551512244157500880428189132165181179686966699692061111915629138249885467195982953271042630804122350689755762918877686910758343830747269213647681040739903617444586029276519330299007291299699260834218608568053509597283764230292162944002774573584184788917930305868744775739142845578084658211145457556"_bigint;
+    EXPECT_EQ(Crypto::NumberTheory::ModularPower(base, 65537, modulo), expected);
+
+    EXPECT_EQ(Crypto::NumberTheory::ModularPower(base, 1, modulo), base);
+    EXPECT_EQ(Crypto::NumberTheory::ModularPower(base, 0, modulo), 1);
+}
+
 TEST_CASE(test_bigint_primality_test)
 {
     struct {
@@ -37,6 +37,18 @@ TEST_CASE(test_BLAKE2b_hash_empty_string)
     EXPECT(memcmp(result, digest.data, Crypto::Hash::BLAKE2b::digest_size()) == 0);
 }
 
+TEST_CASE(test_BLAKE2b_hash_multiple_blocks)
+{
+    u8 result[] {
+        0x4b, 0xdd, 0x2c, 0x9c, 0xf3, 0x1d, 0x79, 0x7a, 0x81, 0xd2, 0x45, 0xc9, 0x89, 0xff, 0xb7, 0x51, 0x51, 0x43, 0xca, 0x34, 0x5c, 0x66, 0xf7, 0x30, 0x87, 0xdd, 0x5c, 0x58, 0xbf, 0x64, 0x2b, 0xf0, 0x83, 0xba, 0x16, 0x89, 0x4e, 0xab, 0x79, 0xe3, 0xb0, 0x8d, 0x51, 0x26, 0x40, 0x4d, 0x83, 0x3e, 0x75, 0x10, 0x27, 0x1b, 0x50, 0xbe, 0x36, 0xa7, 0xb7, 0xcb, 0xbb, 0x46, 0xf5, 0xc8, 0x9f, 0xac
+    };
+    u8 input[1000];
+    for (size_t i = 0; i < sizeof(input); ++i)
+        input[i] = i * 7 + 3;
+    auto digest = Crypto::Hash::BLAKE2b::hash(input, sizeof(input));
+    EXPECT(memcmp(result, digest.data, Crypto::Hash::BLAKE2b::digest_size()) == 0);
+}
+
 TEST_CASE(test_BLAKE2b_consecutive_multiple_updates)
 {
     u8 result[] {
@@ -325,3 +337,40 @@ TEST_CASE(test_ghash_galois_field_multiply2)
     Crypto::Authentication::galois_multiply(z, x, y);
     EXPECT(memcmp(result, z, 4 * sizeof(u32)) == 0);
 }
+
+TEST_CASE(test_ghash_process_many_blocks)
+{
+    // Long enough for the blocks to be processed in batches, and both inputs end with a partial block.
+    u8 key[16];
+    u8 aad[37];
+    u8 cipher[301];
+    for (size_t i = 0; i < sizeof(key); ++i)
+        key[i] = i * 29 + 1;
+    for (size_t i = 0; i < sizeof(aad); ++i)
+        aad[i] = i * 3 + 11;
+    for (size_t i = 0; i < sizeof(cipher); ++i)
+        cipher[i] = i * 7 + 3;
+
+    auto load = [](u8 const* data) { return AK::convert_between_host_and_big_endian(ByteReader::load32(data)); };
+    u32 h[4] { load(key), load(key + 4), load(key + 8), load(key + 12) };
+    u32 expected[4] { 0, 0, 0, 0 };
+    auto absorb = [&](ReadonlyBytes data) {
+        for (size_t offset = 0; offset < data.size(); offset += 16) {
+            u8 block[16] {};
+            data.slice(offset, min<size_t>(16, data.size() - offset)).copy_to(block);
+            for (size_t i = 0; i < 4; ++i)
+                expected[i] ^= load(block + i * 4);
+            Crypto::Authentication::galois_multiply(expected, h, expected);
+        }
+    };
+    absorb({ aad, sizeof(aad) });
+    absorb({ cipher, sizeof(cipher) });
+    expected[1] ^= sizeof(aad) * 8;
+    expected[3] ^= sizeof(cipher) * 8;
+    Crypto::Authentication::galois_multiply(expected, h, expected);
+
+    Crypto::Authentication::GHash ghash({ key, sizeof(key) });
+    auto tag = ghash.process({ aad, sizeof(aad) }, { cipher, sizeof(cipher) });
+    for (size_t i = 0; i < 4; ++i)
+        EXPECT_EQ(load(tag.data + i * 4), expected[i]);
+}
@@ -6,9 +6,12 @@
 
 #include <LibTest/TestCase.h>
 
+#include <AK/Math.h>
+#include <LibGfx/AntiAliasingPainter.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Painter.h>
+#include <LibGfx/Path.h>
 #include <stdio.h>
 
 BENCHMARK_CASE(diagonal_lines)
@@ -52,3 +55,154 @@ BENCHMARK_CASE(fill_with_gradient)
         painter.fill_rect_with_gradient(bitmap->rect(), Color::Blue, Color::Red);
     }
 }
+
+BENCHMARK_CASE(fill_with_alpha)
+{
+    int const run_count = 100;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.fill_rect(bitmap->rect(), Color(Color::Blue).with_alpha(128));
+    }
+}
+
+BENCHMARK_CASE(blit_with_alpha)
+{
+    int const run_count = 100;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    auto source = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { bitmap_size, bitmap_size }));
+    source->fill(Color(Color::Red).with_alpha(128));
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.blit({}, source, source->rect());
+    }
+}
+
+BENCHMARK_CASE(blit_with_opacity)
+{
+    int const run_count = 100;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    auto source = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    source->fill(Color::Red);
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.blit({}, source, source->rect(), 0.5f);
+    }
+}
+
+BENCHMARK_CASE(draw_scaled_bitmap_bilinear)
+{
+    int const run_count = 20;
+    int const bitmap_size = 2000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    auto source = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { bitmap_size / 3, bitmap_size / 3 }));
+    source->fill(Color(Color::Red).with_alpha(128));
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.draw_scaled_bitmap(bitmap->rect(), source, source->rect(), 1.0f, Gfx::ScalingMode::BilinearBlend);
+    }
+}
+
+BENCHMARK_CASE(draw_scaled_bitmap_box_sampling)
+{
+    int const run_count = 20;
+    int const bitmap_size = 500;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    auto source = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { bitmap_size * 3, bitmap_size * 3 }));
+    source->fill(Color(Color::Red).with_alpha(128));
+    Gfx::Painter painter(bitmap);
+
+    for (int run = 0; run < run_count; run++) {
+        painter.draw_scaled_bitmap(bitmap->rect(), source, source->rect(), 1.0f, Gfx::ScalingMode::BoxSampling);
+    }
+}
+
+// The kind of shapes found in SVG icons: a self-intersecting star, a rounded rect, a circle, and a curvy blob.
+static Gfx::Path svg_like_path(float size)
+{
+    Gfx::Path path;
+    Gfx::FloatPoint center { size / 2, size / 2 };
+
+    auto star_radius = size * 0.45f;
+    for (int i = 0; i < 5; i++) {
+        auto angle = i * 4 * AK::Pi<float> / 5 - AK::Pi<float> / 2;
+        Gfx::FloatPoint point { center.x() + star_radius * AK::cos(angle), center.y() + star_radius * AK::sin(angle) };
+        if (i == 0)
+            path.move_to(point);
+        else
+            path.line_to(point);
+    }
+    path.close();
+
+    path.rounded_rect({ size * 0.05f, size * 0.05f, size * 0.3f, size * 0.2f }, { 12, 12 }, { 12, 12 }, { 12, 12 }, { 12, 12 });
+
+    auto circle_radius = size * 0.15f;
+    path.move_to({ center.x() + circle_radius, center.y() });
+    path.arc_to({ center.x() - circle_radius, center.y() }, circle_radius, false, true);
+    path.arc_to({ center.x() + circle_radius, center.y() }, circle_radius, false, true);
+    path.close();
+
+    path.move_to({ size * 0.6f, size * 0.7f });
+    path.cubic_bezier_curve_to({ size * 0.9f, size * 0.55f }, { size * 1.0f, size * 0.9f }, { size * 0.8f, size * 0.95f });
+    path.cubic_bezier_curve_to({ size * 0.65f, size * 1.0f }, { size * 0.4f, size * 0.85f }, { size * 0.6f, size * 0.7f });
+    path.close();
+
+    return path;
+}
+
+BENCHMARK_CASE(fill_path)
+{
+    int const run_count = 200;
+    int const bitmap_size = 1000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    Gfx::Painter painter(bitmap);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+    auto path = svg_like_path(bitmap_size);
+
+    for (int run = 0; run < run_count; run++) {
+        aa_painter.fill_path(path, Color::Blue, Gfx::WindingRule::Nonzero);
+    }
+}
+
+BENCHMARK_CASE(fill_path_even_odd)
+{
+    int const run_count = 200;
+    int const bitmap_size = 1000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    Gfx::Painter painter(bitmap);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+    auto path = svg_like_path(bitmap_size);
+
+    for (int run = 0; run < run_count; run++) {
+        aa_painter.fill_path(path, Color::Blue, Gfx::WindingRule::EvenOdd);
+    }
+}
+
+BENCHMARK_CASE(fill_path_with_alpha)
+{
+    int const run_count = 200;
+    int const bitmap_size = 1000;
+
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { bitmap_size, bitmap_size }));
+    Gfx::Painter painter(bitmap);
+    Gfx::AntiAliasingPainter aa_painter(painter);
+    auto path = svg_like_path(bitmap_size);
+
+    for (int run = 0; run < run_count; run++) {
+        aa_painter.fill_path(path, Color(Color::Blue).with_alpha(128), Gfx::WindingRule::Nonzero);
+    }
+}
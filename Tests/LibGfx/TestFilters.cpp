@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Filters/FastBoxBlurFilter.h>
+#include <LibGfx/Filters/SaturateFilter.h>
+#include <LibGfx/Filters/StackBlurFilter.h>
+#include <LibTest/TestCase.h>
+
+static NonnullRefPtr<Gfx::Bitmap> create_gradient_bitmap(Gfx::IntSize size)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, size));
+    for (int y = 0; y < size.height(); ++y) {
+        for (int x = 0; x < size.width(); ++x)
+            bitmap->set_pixel(x, y, Gfx::Color(x * 37, y * 59, (x + y) * 13, 255 - x));
+    }
+    return bitmap;
+}
+
+static void expect_uniform(Gfx::Bitmap const& bitmap, Gfx::Color color)
+{
+    for (int y = 0; y < bitmap.height(); ++y) {
+        for (int x = 0; x < bitmap.width(); ++x)
+            EXPECT_EQ(bitmap.get_pixel(x, y), color);
+    }
+}
+
+TEST_CASE(matrix_filter_matches_per_pixel_conversion)
+{
+    // 7 pixels wide, so that every row also has pixels that don't fill a whole vector.
+    auto bitmap = create_gradient_bitmap({ 7, 5 });
+    auto expected = MUST(bitmap->clone());
+
+    Gfx::SaturateFilter filter { 2.5f };
+    filter.apply(*bitmap, bitmap->rect(), *bitmap, bitmap->rect());
+    filter.Gfx::ColorFilter::apply(*expected, expected->rect(), *expected, expected->rect());
+
+    for (int y = 0; y < bitmap->height(); ++y) {
+        for (int x = 0; x < bitmap->width(); ++x)
+            EXPECT_EQ(bitmap->get_pixel(x, y), expected->get_pixel(x, y));
+    }
+}
+
+TEST_CASE(box_blur_keeps_uniform_bitmap)
+{
+    auto color = Gfx::Color(10, 200, 30, 128);
+
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 67, 41 }));
+    bitmap->fill(color);
+    Gfx::FastBoxBlurFilter { *bitmap }.apply_single_pass(5, 3);
+    expect_uniform(*bitmap, color);
+
+    // Radii this large blur a downscaled copy instead.
+    Gfx::FastBoxBlurFilter { *bitmap }.apply_three_passes(40);
+    expect_uniform(*bitmap, color);
+}
+
+TEST_CASE(box_blur_averages_neighbors)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, { 9, 9 }));
+    bitmap->fill(Gfx::Color::Black);
+    bitmap->set_pixel(4, 4, Gfx::Color(90, 180, 9));
+
+    Gfx::FastBoxBlurFilter { *bitmap }.apply_single_pass(1);
+    for (int y = 0; y < 9; ++y) {
+        for (int x = 0; x < 9; ++x) {
+            bool is_neighbor = abs(x - 4) <= 1 && abs(y - 4) <= 1;
+            EXPECT_EQ(bitmap->get_pixel(x, y), is_neighbor ? Gfx::Color(10, 20, 1) : Gfx::Color::Black);
+        }
+    }
+}
+
+TEST_CASE(stack_blur_keeps_uniform_bitmap)
+{
+    auto color = Gfx::Color(250, 100, 0, 255);
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 80, 33 }));
+    bitmap->fill(color);
+    Gfx::StackBlurFilter { *bitmap }.process_rgba(12);
+    expect_uniform(*bitmap, color);
+}
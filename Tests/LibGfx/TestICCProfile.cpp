@@ -7,6 +7,7 @@
 #include <AK/Endian.h>
 #include <LibCore/MappedFile.h>
 #include <LibGfx/ICC/BinaryWriter.h>
+#include <LibGfx/ICC/ColorTransform.h>
 #include <LibGfx/ICC/Profile.h>
 #include <LibGfx/ICC/Tags.h>
 #include <LibGfx/ICC/WellKnownProfiles.h>
@@ -295,3 +296,36 @@ TEST_CASE(v2_pcs_illuminant)
     auto icc_profile = MUST(Gfx::ICC::Profile::try_load_from_externally_owned_memory(file->bytes()));
     EXPECT(icc_profile->is_v2());
 }
+
+TEST_CASE(color_transform)
+{
+    auto file = MUST(Core::MappedFile::map(TEST_INPUT("icc/p3-v4.icc"sv)));
+    auto p3 = MUST(Gfx::ICC::Profile::try_load_from_externally_owned_memory(file->bytes()));
+    auto sRGB = MUST(Gfx::ICC::sRGB());
+
+    auto transform = MUST(Gfx::ICC::ColorTransform::create(p3, sRGB));
+    EXPECT_EQ(transform->number_of_input_channels(), 3u);
+
+    // The interpolated colors should be within a few steps of the directly converted ones.
+    for (int r = 0; r < 256; r += 17) {
+        for (int g = 0; g < 256; g += 13) {
+            for (int b = 0; b < 256; b += 11) {
+                u8 rgb[] = { static_cast<u8>(r), static_cast<u8>(g), static_cast<u8>(b) };
+                auto pcs = MUST(p3->to_pcs(rgb));
+                MUST(sRGB->from_pcs(p3, pcs, rgb));
+
+                Gfx::ARGB32 pixel = Color(r, g, b, 128).value();
+                transform->convert_row({ &pixel, 1 });
+                auto color = Color::from_argb(pixel);
+                EXPECT(abs(color.red() - rgb[0]) <= 3);
+                EXPECT(abs(color.green() - rgb[1]) <= 3);
+                EXPECT(abs(color.blue() - rgb[2]) <= 3);
+                EXPECT_EQ(color.alpha(), 128);
+            }
+        }
+    }
+
+    // Transforms for the same profiles come from the cache.
+    auto cached_transform = MUST(Gfx::ICC::ColorTransform::for_profiles(p3, sRGB));
+    EXPECT_EQ(cached_transform.ptr(), MUST(Gfx::ICC::ColorTransform::for_profiles(p3, sRGB)).ptr());
+}
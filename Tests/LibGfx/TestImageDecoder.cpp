@@ -15,6 +15,7 @@
 #include <LibGfx/ImageFormats/ICOLoader.h>
 #include <LibGfx/ImageFormats/ILBMLoader.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
+#include <LibGfx/ImageFormats/IncrementalImageDecoder.h>
 #include <LibGfx/ImageFormats/JBIG2Loader.h>
 #include <LibGfx/ImageFormats/JPEG2000BitplaneDecoding.h>
 #include <LibGfx/ImageFormats/JPEG2000InverseDiscreteWaveletTransform.h>
@@ -666,6 +667,42 @@ TEST_CASE(test_jpeg_non_conventional_app_id)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 80, 80 }));
 }
 
+TEST_CASE(test_jpeg_decode_at_reduced_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/several_scans.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 150, 200 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(148, 200));
+
+    // Asking for a larger size afterwards decodes the image again.
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(592, 800));
+}
+
+TEST_CASE(test_jpeg_sof2_decode_at_reduced_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/spectral_selection.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+    auto reference_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 64, 64 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(74, 100));
+
+    // Only the DC coefficients are used, so each pixel should be close to the average of its block.
+    auto reference_frame = TRY_OR_FAIL(reference_decoder->frame(0));
+    for (int block_y = 0; block_y < frame.image->height(); block_y += 17) {
+        for (int block_x = 0; block_x < frame.image->width(); block_x += 13) {
+            int red = 0;
+            for (int y = 0; y < 8; ++y) {
+                for (int x = 0; x < 8; ++x)
+                    red += reference_frame.image->get_pixel(block_x * 8 + x, block_y * 8 + y).red();
+            }
+            EXPECT(abs(red / 64 - frame.image->get_pixel(block_x, block_y).red()) <= 8);
+        }
+    }
+}
+
 TEST_CASE(test_jpeg2000_spec_annex_j_10_bitplane_decoding)
 {
     // J.10.4 Arithmetic-coded compressed data
@@ -1381,6 +1418,29 @@ TEST_CASE(test_exif)
     EXPECT_EQ(*exif_metadata.orientation(), Gfx::TIFF::Orientation::Rotate90Clockwise);
 }
 
+TEST_CASE(test_png_unfilter_scanline)
+{
+    // Whole pixels of 3 and 4 bytes are unfiltered a pixel at a time, while scanlines with a partial pixel at the end
+    // are unfiltered a byte at a time. Both must agree on the bytes they have in common.
+    Array<u8, 49> previous_scanline;
+    Array<u8, 49> scanline;
+    for (size_t i = 0; i < scanline.size(); ++i) {
+        previous_scanline[i] = (i * 73 + 41) & 0xFF;
+        scanline[i] = (i * 151 + 7) & 0xFF;
+    }
+
+    for (auto filter : { Gfx::PNG::FilterType::Sub, Gfx::PNG::FilterType::Average, Gfx::PNG::FilterType::Paeth }) {
+        for (u8 bytes_per_complete_pixel : { 3, 4 }) {
+            auto by_pixel = scanline;
+            auto by_byte = scanline;
+            size_t const whole_pixels_size = 12 * bytes_per_complete_pixel;
+            Gfx::PNGImageDecoderPlugin::unfilter_scanline(filter, by_pixel.span().trim(whole_pixels_size), previous_scanline.span(), bytes_per_complete_pixel);
+            Gfx::PNGImageDecoderPlugin::unfilter_scanline(filter, by_byte.span().trim(whole_pixels_size + 1), previous_scanline.span(), bytes_per_complete_pixel);
+            EXPECT_EQ(by_pixel.span().trim(whole_pixels_size), by_byte.span().trim(whole_pixels_size));
+        }
+    }
+}
+
 TEST_CASE(test_png_malformed_frame)
 {
     Array test_inputs = {
@@ -2307,3 +2367,58 @@ TEST_CASE(test_dicom)
         for (int x = 0; x < frame.image->width(); ++x)
             EXPECT_EQ(frame.image->get_pixel(x, y), reference_frame.image->get_pixel(x, y));
 }
+
+static void expect_partial_frame_of_truncated_data(StringView file_name, size_t truncated_size)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(file_name));
+    auto truncated_data = file->bytes().trim(truncated_size);
+
+    auto decoder = TRY_OR_FAIL(Gfx::ImageDecoder::try_create_for_raw_bytes(truncated_data));
+    VERIFY(decoder);
+    auto partial_frame = TRY_OR_FAIL(decoder->partial_frame());
+    EXPECT(partial_frame.image);
+    EXPECT(partial_frame.decoded_rows > 0);
+    EXPECT(partial_frame.decoded_rows < partial_frame.image->height());
+
+    // With all the data, the partial frame is the complete frame.
+    Gfx::IncrementalImageDecoder incremental_decoder;
+    TRY_OR_FAIL(incremental_decoder.append_data(file->bytes()));
+    auto complete_frame = TRY_OR_FAIL(incremental_decoder.decode_partial_frame());
+    EXPECT(complete_frame.has_value());
+    EXPECT_EQ(complete_frame->decoded_rows, complete_frame->image->height());
+}
+
+TEST_CASE(test_partial_frame_png)
+{
+    expect_partial_frame_of_truncated_data(TEST_INPUT("png/buggie.png"sv), 4500);
+}
+
+TEST_CASE(test_partial_frame_gif)
+{
+    // The first frame ends well before the other frames of the animation.
+    expect_partial_frame_of_truncated_data(TEST_INPUT("download-animation.gif"sv), 1400);
+}
+
+TEST_CASE(test_partial_frame_jpeg)
+{
+    expect_partial_frame_of_truncated_data(TEST_INPUT("jpg/big_image.jpg"sv), 1 * MiB);
+}
+
+TEST_CASE(test_incremental_image_decoder)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+
+    Gfx::IncrementalImageDecoder decoder;
+    EXPECT(!decoder.should_decode_partial_frame());
+
+    // Without the header, there is nothing to decode yet.
+    TRY_OR_FAIL(decoder.append_data(file->bytes().trim(16)));
+    EXPECT(!TRY_OR_FAIL(decoder.decode_partial_frame()).has_value());
+
+    TRY_OR_FAIL(decoder.append_data(file->bytes().slice(16, file->bytes().size() / 2 - 16)));
+    auto partial_frame = TRY_OR_FAIL(decoder.decode_partial_frame());
+    EXPECT(partial_frame.has_value());
+    EXPECT(partial_frame->decoded_rows > 0);
+    EXPECT(partial_frame->image->has_alpha_channel());
+    EXPECT_EQ(partial_frame->image->get_pixel(0, partial_frame->image->height() - 1).alpha(), 0);
+}
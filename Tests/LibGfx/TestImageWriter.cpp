@@ -377,6 +377,20 @@ TEST_CASE(test_png)
     TRY_OR_FAIL((test_roundtrip<Gfx::PNGWriter, Gfx::PNGImageDecoderPlugin>(*TRY_OR_FAIL(create_test_rgba_bitmap()))));
 }
 
+TEST_CASE(test_png_compress_in_parallel)
+{
+    // This is large enough to be compressed in several chunks.
+    auto bitmap = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 512, 512 }));
+    for (int y = 0; y < bitmap->height(); ++y) {
+        for (int x = 0; x < bitmap->width(); ++x)
+            bitmap->set_pixel(x, y, Color(x, y, x ^ y, 255 - (x + y) / 4));
+    }
+
+    auto encoded_data = TRY_OR_FAIL(encode_bitmap<Gfx::PNGWriter>(*bitmap, Gfx::PNGWriter::Options { .compress_in_parallel = true }));
+    auto decoded = TRY_OR_FAIL(expect_single_frame_of_size(*TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(encoded_data)), bitmap->size()));
+    expect_bitmaps_equal(*decoded, *bitmap);
+}
+
 TEST_CASE(test_png_paeth_simd)
 {
     for (int a = 0; a < 256; ++a) {
@@ -120,3 +120,53 @@ TEST_CASE(aliased_fill)
 
     EXPECT_EQ(failed_test_count, 0);
 }
+
+static Gfx::Color pattern_color(int x, int y)
+{
+    return Gfx::Color::from_argb(static_cast<u32>(x * 0x9e3779b1u) ^ static_cast<u32>(y * 0x85ebca6bu));
+}
+
+TEST_CASE(fill_rect_with_alpha_matches_color_blend)
+{
+    // The width is not a multiple of the vector width, and some of the destination pixels are translucent, so every
+    // path through the blending kernels is covered.
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 37, 5 }));
+    for (int y = 0; y < bitmap->height(); ++y) {
+        for (int x = 0; x < bitmap->width(); ++x)
+            bitmap->set_pixel(x, y, y == 0 ? pattern_color(x, y) : pattern_color(x, y).with_alpha(255));
+    }
+    auto original = MUST(bitmap->clone());
+
+    Gfx::Color const color { 10, 200, 30, 100 };
+    Gfx::Painter painter(*bitmap);
+    painter.fill_rect(bitmap->rect(), color);
+
+    for (int y = 0; y < bitmap->height(); ++y) {
+        for (int x = 0; x < bitmap->width(); ++x)
+            EXPECT_EQ(bitmap->get_pixel(x, y), original->get_pixel(x, y).blend(color));
+    }
+}
+
+TEST_CASE(blit_with_alpha_matches_color_blend)
+{
+    auto source = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { 37, 5 }));
+    for (int y = 0; y < source->height(); ++y) {
+        for (int x = 0; x < source->width(); ++x)
+            source->set_pixel(x, y, pattern_color(y, x));
+    }
+
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, source->size()));
+    for (int y = 0; y < bitmap->height(); ++y) {
+        for (int x = 0; x < bitmap->width(); ++x)
+            bitmap->set_pixel(x, y, y == 0 ? pattern_color(x, y) : pattern_color(x, y).with_alpha(255));
+    }
+    auto original = MUST(bitmap->clone());
+
+    Gfx::Painter painter(*bitmap);
+    painter.blit({}, *source, source->rect());
+
+    for (int y = 0; y < bitmap->height(); ++y) {
+        for (int x = 0; x < bitmap->width(); ++x)
+            EXPECT_EQ(bitmap->get_pixel(x, y), original->get_pixel(x, y).blend(source->get_pixel(x, y)));
+    }
+}
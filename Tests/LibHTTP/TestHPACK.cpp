@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Hex.h>
+#include <LibHTTP/HPACK.h>
+#include <LibTest/TestCase.h>
+
+static ByteBuffer from_hex(StringView hex)
+{
+    return MUST(decode_hex(hex));
+}
+
+static void expect_headers(ReadonlySpan<HTTP::Header> headers, Vector<HTTP::Header> const& expected)
+{
+    EXPECT_EQ(headers.size(), expected.size());
+    for (size_t i = 0; i < min(headers.size(), expected.size()); ++i) {
+        EXPECT_EQ(headers[i].name, expected[i].name);
+        EXPECT_EQ(headers[i].value, expected[i].value);
+    }
+}
+
+// The examples are from RFC 7541 Appendix C.
+
+TEST_CASE(integers)
+{
+    ByteBuffer buffer;
+    MUST(HTTP::HPACK::encode_integer(buffer, 5, 0, 10));
+    EXPECT_EQ(buffer, from_hex("0a"sv));
+
+    buffer.clear();
+    MUST(HTTP::HPACK::encode_integer(buffer, 5, 0, 1337));
+    EXPECT_EQ(buffer, from_hex("1f9a0a"sv));
+
+    buffer.clear();
+    MUST(HTTP::HPACK::encode_integer(buffer, 8, 0, 42));
+    EXPECT_EQ(buffer, from_hex("2a"sv));
+
+    auto encoded = from_hex("1f9a0a"sv);
+    ReadonlyBytes bytes = encoded;
+    EXPECT_EQ(MUST(HTTP::HPACK::decode_integer(bytes, 5)), 1337u);
+    EXPECT(bytes.is_empty());
+
+    auto truncated = from_hex("1f9a"sv);
+    bytes = truncated;
+    EXPECT(HTTP::HPACK::decode_integer(bytes, 5).is_error());
+}
+
+TEST_CASE(huffman)
+{
+    ByteBuffer buffer;
+    MUST(HTTP::HPACK::huffman_encode(buffer, "www.example.com"sv.bytes()));
+    EXPECT_EQ(buffer, from_hex("f1e3c2e5f23a6ba0ab90f4ff"sv));
+    EXPECT_EQ(HTTP::HPACK::huffman_encoded_length("www.example.com"sv.bytes()), 12u);
+    EXPECT_EQ(MUST(HTTP::HPACK::huffman_decode(buffer)), "www.example.com"sv);
+
+    // Every byte value has a code.
+    Array<u8, 256> all_bytes;
+    for (size_t i = 0; i < all_bytes.size(); ++i)
+        all_bytes[i] = i;
+    buffer.clear();
+    MUST(HTTP::HPACK::huffman_encode(buffer, all_bytes));
+    auto decoded = MUST(HTTP::HPACK::huffman_decode(buffer));
+    EXPECT_EQ(decoded.bytes(), ReadonlyBytes { all_bytes });
+
+    // Padding must be made of the most significant bits of EOS (all ones), and be shorter than a byte.
+    EXPECT(HTTP::HPACK::huffman_decode(from_hex("f1e3c2e5f23a6ba0ab90f4fe"sv)).is_error());
+    EXPECT(HTTP::HPACK::huffman_decode(from_hex("f1e3c2e5f23a6ba0ab90f4ffff"sv)).is_error());
+    EXPECT(HTTP::HPACK::huffman_decode(from_hex("ffffffff"sv)).is_error());
+}
+
+TEST_CASE(decode_requests_without_huffman)
+{
+    HTTP::HPACK::Decoder decoder;
+
+    auto headers = MUST(decoder.decode(from_hex("828684410f7777772e6578616d706c652e636f6d"sv)));
+    expect_headers(headers, { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" } });
+    EXPECT_EQ(decoder.table().size(), 57u);
+
+    headers = MUST(decoder.decode(from_hex("828684be58086e6f2d6361636865"sv)));
+    expect_headers(headers, { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" }, { "cache-control", "no-cache" } });
+    EXPECT_EQ(decoder.table().size(), 110u);
+
+    headers = MUST(decoder.decode(from_hex("828785bf400a637573746f6d2d6b65790c637573746f6d2d76616c7565"sv)));
+    expect_headers(headers, { { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" }, { ":authority", "www.example.com" }, { "custom-key", "custom-value" } });
+    EXPECT_EQ(decoder.table().size(), 164u);
+    EXPECT_EQ(decoder.table().at(1).name, "custom-key"sv);
+    EXPECT_EQ(decoder.table().at(3).name, ":authority"sv);
+}
+
+TEST_CASE(decode_responses_with_eviction)
+{
+    HTTP::HPACK::Decoder decoder(256);
+
+    auto headers = MUST(decoder.decode(from_hex("488264025885aec3771a4b6196d07abe941054d444a8200595040b8166e082a62d1bff6e919d29ad171863c78f0b97c8e9ae82ae43d3"sv)));
+    expect_headers(headers, { { ":status", "302" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:21 GMT" }, { "location", "https://www.example.com" } });
+    EXPECT_EQ(decoder.table().size(), 222u);
+
+    headers = MUST(decoder.decode(from_hex("4883640effc1c0bf"sv)));
+    expect_headers(headers, { { ":status", "307" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:21 GMT" }, { "location", "https://www.example.com" } });
+    EXPECT_EQ(decoder.table().size(), 222u);
+
+    headers = MUST(decoder.decode(from_hex("88c16196d07abe941054d444a8200595040b8166e084a62d1bffc05a839bd9ab77ad94e7821dd7f2e6c7b335dfdfcd5b3960d5af27087f3672c1ab270fb5291f9587316065c003ed4ee5b1063d5007"sv)));
+    expect_headers(headers, { { ":status", "200" }, { "cache-control", "private" }, { "date", "Mon, 21 Oct 2013 20:13:22 GMT" }, { "location", "https://www.example.com" }, { "content-encoding", "gzip" }, { "set-cookie", "foo=ASDJKHQKBZXOQWEOPIUAXQWEOIU; max-age=3600; version=1" } });
+    EXPECT_EQ(decoder.table().size(), 215u);
+    EXPECT_EQ(decoder.table().entry_count(), 3u);
+    EXPECT_EQ(decoder.table().at(3).name, "date"sv);
+}
+
+TEST_CASE(decode_errors)
+{
+    HTTP::HPACK::Decoder decoder;
+
+    // Index 0, and an index past the end of the (empty) dynamic table.
+    EXPECT(decoder.decode(from_hex("80"sv)).is_error());
+    EXPECT(decoder.decode(from_hex("be"sv)).is_error());
+
+    // A table size update that is larger than the limit, and one that follows a header.
+    EXPECT(decoder.decode(from_hex("3fe21f"sv)).is_error());
+    EXPECT(decoder.decode(from_hex("823f00"sv)).is_error());
+
+    // A literal whose value is cut short.
+    EXPECT(decoder.decode(from_hex("4108"sv)).is_error());
+}
+
+TEST_CASE(encode_requests)
+{
+    HTTP::HPACK::Encoder encoder;
+
+    Vector<HTTP::Header> first_request { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" } };
+    EXPECT_EQ(MUST(encoder.encode(first_request)), from_hex("828684418cf1e3c2e5f23a6ba0ab90f4ff"sv));
+
+    Vector<HTTP::Header> second_request { { ":method", "GET" }, { ":scheme", "http" }, { ":path", "/" }, { ":authority", "www.example.com" }, { "cache-control", "no-cache" } };
+    EXPECT_EQ(MUST(encoder.encode(second_request)), from_hex("828684be5886a8eb10649cbf"sv));
+
+    Vector<HTTP::Header> third_request { { ":method", "GET" }, { ":scheme", "https" }, { ":path", "/index.html" }, { ":authority", "www.example.com" }, { "custom-key", "custom-value" } };
+    EXPECT_EQ(MUST(encoder.encode(third_request)), from_hex("828785bf408825a849e95ba97d7f8925a849e95bb8e8b4bf"sv));
+    EXPECT_EQ(encoder.table().size(), 164u);
+}
+
+TEST_CASE(encode_and_decode)
+{
+    HTTP::HPACK::Encoder encoder;
+    HTTP::HPACK::Decoder decoder;
+
+    Vector<HTTP::Header> request { { ":method", "POST" }, { ":path", "/login" }, { "authorization", "Basic c2VyZW5pdHk6b3M=" }, { "x-empty", "" } };
+    for (size_t i = 0; i < 3; ++i)
+        expect_headers(MUST(decoder.decode(MUST(encoder.encode(request)))), request);
+
+    // Credentials are never added to the tables.
+    EXPECT(!decoder.table().find("authorization"sv, "Basic c2VyZW5pdHk6b3M="sv).has_value());
+
+    // Shrinking the table is announced to the decoder, which evicts entries to match.
+    encoder.set_max_table_size(0);
+    encoder.set_max_table_size(64);
+    expect_headers(MUST(decoder.decode(MUST(encoder.encode(request)))), request);
+    EXPECT_EQ(decoder.table().max_size(), 64u);
+    EXPECT_EQ(decoder.table().size(), encoder.table().size());
+}
@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <LibHTTP/HPACK.h>
+#include <LibHTTP/Http2Connection.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+enum FrameType : u8 {
+    Data = 0x0,
+    Headers = 0x1,
+    RstStream = 0x3,
+    Settings = 0x4,
+    Ping = 0x6,
+    GoAway = 0x7,
+    WindowUpdate = 0x8,
+    Continuation = 0x9,
+};
+
+enum Flags : u8 {
+    EndStream = 0x1,
+    Ack = 0x1,
+    EndHeaders = 0x4,
+    Padded = 0x8,
+};
+
+struct Frame {
+    u8 type { 0 };
+    u8 flags { 0 };
+    u32 stream_id { 0 };
+    ByteBuffer payload;
+};
+
+ByteBuffer make_frame(u8 type, u8 flags, u32 stream_id, ReadonlyBytes payload = {})
+{
+    ByteBuffer buffer;
+    buffer.append(static_cast<u8>(payload.size() >> 16));
+    buffer.append(static_cast<u8>(payload.size() >> 8));
+    buffer.append(static_cast<u8>(payload.size()));
+    buffer.append(type);
+    buffer.append(flags);
+    BigEndian<u32> big_endian_stream_id = stream_id;
+    buffer.append(&big_endian_stream_id, sizeof(big_endian_stream_id));
+    buffer.append(payload);
+    return buffer;
+}
+
+ByteBuffer make_u32_payload(u32 value)
+{
+    BigEndian<u32> big_endian_value = value;
+    return MUST(ByteBuffer::copy(&big_endian_value, sizeof(big_endian_value)));
+}
+
+u32 read_u32(ReadonlyBytes bytes)
+{
+    return (static_cast<u32>(bytes[0]) << 24) | (static_cast<u32>(bytes[1]) << 16) | (static_cast<u32>(bytes[2]) << 8) | bytes[3];
+}
+
+struct StreamResult {
+    Optional<u32> status_code;
+    HTTP::HeaderMap headers;
+    ByteBuffer body;
+    bool completed { false };
+    bool failed { false };
+};
+
+// Plays the server side of a connection.
+struct Server {
+    Server()
+    {
+        connection.on_stream_closed = [this] { ++closed_stream_count; };
+    }
+
+    void start()
+    {
+        connection.start();
+        EXPECT(output.bytes().starts_with(HTTP::Http2Connection::preface.bytes()));
+        output = MUST(output.slice(HTTP::Http2Connection::preface.length(), output.size() - HTTP::Http2Connection::preface.length()));
+        (void)take_frames();
+
+        connection.receive(make_frame(FrameType::Settings, 0, 0));
+        auto frames = take_frames();
+        EXPECT_EQ(frames.size(), 1u);
+        EXPECT_EQ(frames[0].type, FrameType::Settings);
+        EXPECT_EQ(frames[0].flags, Flags::Ack);
+    }
+
+    Vector<Frame> take_frames()
+    {
+        Vector<Frame> frames;
+        ReadonlyBytes bytes = output;
+        while (!bytes.is_empty()) {
+            VERIFY(bytes.size() >= HTTP::Http2Connection::frame_header_size);
+            size_t length = (bytes[0] << 16) | (bytes[1] << 8) | bytes[2];
+            frames.append({
+                .type = bytes[3],
+                .flags = bytes[4],
+                .stream_id = read_u32(bytes.slice(5)) & 0x7fffffff,
+                .payload = MUST(ByteBuffer::copy(bytes.slice(HTTP::Http2Connection::frame_header_size, length))),
+            });
+            bytes = bytes.slice(HTTP::Http2Connection::frame_header_size + length);
+        }
+        output.clear();
+        return frames;
+    }
+
+    u32 open_stream(StringView path, ByteBuffer body = {})
+    {
+        auto stream_id = connection.open_stream(
+            {
+                .method = body.is_empty() ? "GET" : "POST",
+                .scheme = "https",
+                .authority = "serenityos.org",
+                .path = path,
+                .headers = { { "accept", "*/*" } },
+                .body = move(body),
+            },
+            {
+                .on_headers = [this, path = ByteString(path)](u32 status_code, HTTP::HeaderMap headers) {
+                    auto& result = results.ensure(path);
+                    result.status_code = status_code;
+                    result.headers = move(headers); },
+                .on_data = [this, path = ByteString(path)](ReadonlyBytes data) { results.ensure(path).body.append(data); },
+                .on_complete = [this, path = ByteString(path)] { results.ensure(path).completed = true; },
+                .on_error = [this, path = ByteString(path)] { results.ensure(path).failed = true; },
+            });
+        return stream_id;
+    }
+
+    void send_headers(u32 stream_id, Vector<HTTP::Header> const& headers, u8 flags = Flags::EndHeaders)
+    {
+        connection.receive(make_frame(FrameType::Headers, flags, stream_id, MUST(encoder.encode(headers))));
+    }
+
+    void send_data(u32 stream_id, StringView data, u8 flags = 0)
+    {
+        connection.receive(make_frame(FrameType::Data, flags, stream_id, data.bytes()));
+    }
+
+    ByteBuffer output;
+    HTTP::Http2Connection connection { [this](ReadonlyBytes bytes) { output.append(bytes); } };
+    HTTP::HPACK::Encoder encoder;
+    HTTP::HPACK::Decoder decoder;
+    HashMap<ByteString, StreamResult> results;
+    size_t closed_stream_count { 0 };
+};
+
+}
+
+TEST_CASE(connection_preface)
+{
+    Server server;
+    server.connection.start();
+    EXPECT(server.output.bytes().starts_with(HTTP::Http2Connection::preface.bytes()));
+    server.output = MUST(server.output.slice(HTTP::Http2Connection::preface.length(), server.output.size() - HTTP::Http2Connection::preface.length()));
+
+    auto frames = server.take_frames();
+    EXPECT_EQ(frames.size(), 2u);
+
+    // Push is disabled, and the stream window is raised.
+    EXPECT_EQ(frames[0].type, FrameType::Settings);
+    EXPECT_EQ(frames[0].flags, 0);
+    EXPECT_EQ(frames[0].payload.size(), 12u);
+    EXPECT_EQ(frames[0].payload.bytes().slice(0, 2), (Array<u8, 2> { 0, 2 }).span());
+    EXPECT_EQ(read_u32(frames[0].payload.bytes().slice(2)), 0u);
+    EXPECT_EQ(frames[0].payload.bytes().slice(6, 2), (Array<u8, 2> { 0, 4 }).span());
+    EXPECT_EQ(read_u32(frames[0].payload.bytes().slice(8)), HTTP::Http2Connection::stream_receive_window_size);
+
+    // The connection window is raised too.
+    EXPECT_EQ(frames[1].type, FrameType::WindowUpdate);
+    EXPECT_EQ(frames[1].stream_id, 0u);
+    EXPECT_EQ(read_u32(frames[1].payload), HTTP::Http2Connection::connection_receive_window_size - HTTP::Http2Connection::default_window_size);
+
+    // Anything but SETTINGS as the first frame of the server is an error.
+    server.connection.receive(make_frame(FrameType::Ping, 0, 0, make_u32_payload(0)));
+    EXPECT(server.connection.is_closed());
+}
+
+TEST_CASE(multiplexed_streams)
+{
+    Server server;
+    server.start();
+
+    EXPECT_EQ(server.open_stream("/a"sv), 1u);
+    EXPECT_EQ(server.open_stream("/b"sv), 3u);
+    EXPECT_EQ(server.connection.open_stream_count(), 2u);
+
+    auto frames = server.take_frames();
+    EXPECT_EQ(frames.size(), 2u);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        EXPECT_EQ(frames[i].type, FrameType::Headers);
+        EXPECT_EQ(frames[i].flags, Flags::EndHeaders | Flags::EndStream);
+        EXPECT_EQ(frames[i].stream_id, 1 + 2 * i);
+
+        auto headers = MUST(server.decoder.decode(frames[i].payload));
+        EXPECT_EQ(headers.size(), 5u);
+        EXPECT_EQ(headers[0].name, ":method"sv);
+        EXPECT_EQ(headers[0].value, "GET"sv);
+        EXPECT_EQ(headers[2].value, "serenityos.org"sv);
+        EXPECT_EQ(headers[3].name, ":path"sv);
+        EXPECT_EQ(headers[3].value, i == 0 ? "/a"sv : "/b"sv);
+        EXPECT_EQ(headers[4].name, "accept"sv);
+    }
+
+    // The responses can arrive in any order, and interleaved.
+    server.send_headers(3, { { ":status", "404" }, { "content-type", "text/plain" } });
+    server.send_headers(1, { { ":status", "200" } });
+    server.send_data(3, "not "sv);
+    server.send_data(1, "hello"sv, Flags::EndStream);
+    EXPECT(server.results.get("/a"sv)->completed);
+    EXPECT(!server.results.get("/b"sv)->completed);
+    server.send_data(3, "found"sv, Flags::EndStream);
+
+    auto const& a = *server.results.get("/a"sv);
+    EXPECT_EQ(a.status_code, 200u);
+    EXPECT_EQ(StringView { a.body.bytes() }, "hello"sv);
+    EXPECT(a.completed);
+
+    auto const& b = *server.results.get("/b"sv);
+    EXPECT_EQ(b.status_code, 404u);
+    EXPECT_EQ(b.headers.get("Content-Type"), "text/plain"sv);
+    EXPECT_EQ(StringView { b.body.bytes() }, "not found"sv);
+    EXPECT(b.completed);
+
+    EXPECT_EQ(server.connection.open_stream_count(), 0u);
+    EXPECT_EQ(server.closed_stream_count, 2u);
+    EXPECT(!server.connection.is_closed());
+}
+
+TEST_CASE(continuation_and_padding)
+{
+    Server server;
+    server.start();
+    server.open_stream("/"sv);
+    (void)server.take_frames();
+
+    // A 100 Continue is skipped.
+    server.send_headers(1, { { ":status", "100" } });
+
+    auto header_block = MUST(server.encoder.encode(Vector<HTTP::Header> { { ":status", "200" }, { "server", "test" } }));
+    server.connection.receive(make_frame(FrameType::Headers, 0, 1, header_block.bytes().slice(0, 3)));
+    EXPECT(!server.results.contains("/"sv));
+    server.connection.receive(make_frame(FrameType::Continuation, Flags::EndHeaders, 1, header_block.bytes().slice(3)));
+    EXPECT_EQ(server.results.get("/"sv)->status_code, 200u);
+    EXPECT_EQ(server.results.get("/"sv)->headers.get("server"), "test"sv);
+
+    Array<u8, 7> padded_data { 3, 'a', 'b', 'c', 0, 0, 0 };
+    server.connection.receive(make_frame(FrameType::Data, Flags::Padded | Flags::EndStream, 1, padded_data));
+    EXPECT_EQ(StringView { server.results.get("/"sv)->body.bytes() }, "abc"sv);
+    EXPECT(server.results.get("/"sv)->completed);
+}
+
+TEST_CASE(frames_between_continuations)
+{
+    Server server;
+    server.start();
+    server.open_stream("/"sv);
+    (void)server.take_frames();
+
+    auto header_block = MUST(server.encoder.encode(Vector<HTTP::Header> { { ":status", "200" } }));
+    server.connection.receive(make_frame(FrameType::Headers, 0, 1, header_block));
+    server.connection.receive(make_frame(FrameType::Ping, 0, 0, make_u32_payload(0)));
+
+    EXPECT(server.connection.is_closed());
+    EXPECT(server.results.get("/"sv)->failed);
+
+    auto frames = server.take_frames();
+    EXPECT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].type, FrameType::GoAway);
+    EXPECT_EQ(read_u32(frames[0].payload.bytes().slice(4)), to_underlying(HTTP::Http2Connection::ErrorCode::ProtocolError));
+}
+
+TEST_CASE(request_body_flow_control)
+{
+    Server server;
+    server.start();
+
+    auto body = MUST(ByteBuffer::create_zeroed(100000));
+    server.open_stream("/upload"sv, move(body));
+
+    // The body is sent until the default window of 65535 bytes is used up.
+    auto frames = server.take_frames();
+    EXPECT_EQ(frames[0].type, FrameType::Headers);
+    EXPECT_EQ(frames[0].flags, Flags::EndHeaders);
+    size_t sent_size = 0;
+    for (size_t i = 1; i < frames.size(); ++i) {
+        EXPECT_EQ(frames[i].type, FrameType::Data);
+        EXPECT(frames[i].payload.size() <= HTTP::Http2Connection::default_max_frame_size);
+        EXPECT_EQ(frames[i].flags, 0);
+        sent_size += frames[i].payload.size();
+    }
+    EXPECT_EQ(sent_size, HTTP::Http2Connection::default_window_size);
+
+    // Both the connection and the stream window have to allow more.
+    server.connection.receive(make_frame(FrameType::WindowUpdate, 0, 0, make_u32_payload(50000)));
+    EXPECT(server.take_frames().is_empty());
+    server.connection.receive(make_frame(FrameType::WindowUpdate, 0, 1, make_u32_payload(50000)));
+
+    frames = server.take_frames();
+    sent_size = 0;
+    for (auto& frame : frames) {
+        EXPECT_EQ(frame.type, FrameType::Data);
+        sent_size += frame.payload.size();
+    }
+    EXPECT_EQ(sent_size, 100000u - HTTP::Http2Connection::default_window_size);
+    EXPECT_EQ(frames.last().flags, Flags::EndStream);
+}
+
+TEST_CASE(response_flow_control)
+{
+    Server server;
+    server.start();
+    server.open_stream("/download"sv);
+    (void)server.take_frames();
+
+    server.send_headers(1, { { ":status", "200" } });
+
+    // The window of the stream is replenished once half of it has been received.
+    auto chunk = MUST(ByteBuffer::create_zeroed(HTTP::Http2Connection::default_max_frame_size));
+    size_t chunk_count = HTTP::Http2Connection::stream_receive_window_size / 2 / chunk.size();
+    for (size_t i = 0; i < chunk_count; ++i) {
+        EXPECT(server.take_frames().is_empty());
+        server.connection.receive(make_frame(FrameType::Data, 0, 1, chunk));
+    }
+
+    auto frames = server.take_frames();
+    EXPECT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].type, FrameType::WindowUpdate);
+    EXPECT_EQ(frames[0].stream_id, 1u);
+    EXPECT_EQ(read_u32(frames[0].payload), HTTP::Http2Connection::stream_receive_window_size / 2);
+    EXPECT_EQ(server.results.get("/download"sv)->body.size(), chunk_count * chunk.size());
+
+    server.send_data(1, {}, Flags::EndStream);
+    EXPECT(server.results.get("/download"sv)->completed);
+}
+
+TEST_CASE(settings_and_ping)
+{
+    Server server;
+    server.start();
+
+    Array<u8, 8> ping_data { 1, 2, 3, 4, 5, 6, 7, 8 };
+    server.connection.receive(make_frame(FrameType::Ping, 0, 0, ping_data));
+    auto frames = server.take_frames();
+    EXPECT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].type, FrameType::Ping);
+    EXPECT_EQ(frames[0].flags, Flags::Ack);
+    EXPECT_EQ(frames[0].payload.bytes(), ping_data.span());
+
+    // SETTINGS_MAX_CONCURRENT_STREAMS = 1
+    Array<u8, 6> settings { 0, 3, 0, 0, 0, 1 };
+    server.connection.receive(make_frame(FrameType::Settings, 0, 0, settings));
+    EXPECT_EQ(server.take_frames().first().flags, Flags::Ack);
+
+    EXPECT(server.connection.can_open_stream());
+    server.open_stream("/"sv);
+    EXPECT(!server.connection.can_open_stream());
+    server.send_headers(1, { { ":status", "204" } }, Flags::EndHeaders | Flags::EndStream);
+    EXPECT(server.results.get("/"sv)->completed);
+    EXPECT(server.connection.can_open_stream());
+}
+
+TEST_CASE(reset_and_goaway)
+{
+    Server server;
+    server.start();
+    server.open_stream("/1"sv);
+    server.open_stream("/3"sv);
+    server.open_stream("/5"sv);
+    (void)server.take_frames();
+
+    server.connection.receive(make_frame(FrameType::RstStream, 0, 3, make_u32_payload(to_underlying(HTTP::Http2Connection::ErrorCode::RefusedStream))));
+    EXPECT(server.results.get("/3"sv)->failed);
+    EXPECT_EQ(server.connection.open_stream_count(), 2u);
+
+    // Streams after the last one that the server processes fail, but the others still complete.
+    ByteBuffer goaway_payload = make_u32_payload(1);
+    goaway_payload.append(make_u32_payload(to_underlying(HTTP::Http2Connection::ErrorCode::NoError)));
+    server.connection.receive(make_frame(FrameType::GoAway, 0, 0, goaway_payload));
+    EXPECT(server.results.get("/5"sv)->failed);
+    EXPECT(!server.results.contains("/1"sv));
+    EXPECT(!server.connection.can_open_stream());
+
+    server.send_headers(1, { { ":status", "200" } });
+    server.send_data(1, "done"sv, Flags::EndStream);
+    EXPECT(server.results.get("/1"sv)->completed);
+    EXPECT_EQ(server.closed_stream_count, 3u);
+
+    // Cancelling a stream resets it.
+    Server other_server;
+    other_server.start();
+    auto stream_id = other_server.open_stream("/"sv);
+    (void)other_server.take_frames();
+    other_server.connection.cancel_stream(stream_id);
+    auto frames = other_server.take_frames();
+    EXPECT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].type, FrameType::RstStream);
+    EXPECT_EQ(read_u32(frames[0].payload), to_underlying(HTTP::Http2Connection::ErrorCode::Cancel));
+
+    // Frames that were already in flight are ignored.
+    other_server.send_headers(stream_id, { { ":status", "200" } });
+    EXPECT(!other_server.results.contains("/"sv));
+    EXPECT(!other_server.connection.is_closed());
+}
+
+TEST_CASE(transport_closed)
+{
+    Server server;
+    server.start();
+    server.open_stream("/"sv);
+    server.connection.did_close_transport();
+    EXPECT(server.results.get("/"sv)->failed);
+    EXPECT(server.connection.is_closed());
+    EXPECT(!server.connection.can_open_stream());
+}
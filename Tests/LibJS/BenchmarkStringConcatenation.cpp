@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+static void run_script(StringView source)
+{
+    auto vm = MUST(JS::VM::create());
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto script = JS::Script::parse(source, *root_execution_context->realm);
+    VERIFY(!script.is_error());
+    auto result = vm->bytecode_interpreter().run(*script.value());
+    EXPECT(!result.is_error());
+}
+
+BENCHMARK_CASE(build_table_with_plus_equals)
+{
+    run_script(R"~~~(
+        let html = "<table>";
+        for (let row = 0; row < 2000; ++row) {
+            html += "<tr>";
+            for (let column = 0; column < 10; ++column)
+                html += "<td class=\"cell\">" + row + ":" + column + "</td>";
+            html += "</tr>";
+        }
+        html += "</table>";
+        if (html.length !== 566915)
+            throw new Error("unexpected length " + html.length);
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(build_table_with_template_literals)
+{
+    run_script(R"~~~(
+        let html = "";
+        for (let row = 0; row < 2000; ++row) {
+            let cells = "";
+            for (let column = 0; column < 10; ++column)
+                cells = `${cells}<td class="cell">${row}:${column}</td>`;
+            html = `${html}<tr>${cells}</tr>`;
+        }
+        if (!html.startsWith("<tr><td class=\"cell\">0:0</td>"))
+            throw new Error("unexpected result");
+    )~~~"sv);
+}
+
+BENCHMARK_CASE(check_length_while_appending)
+{
+    run_script(R"~~~(
+        let text = "";
+        let lines = 0;
+        while (text.length < 500000) {
+            text += "line " + lines + "\n";
+            ++lines;
+        }
+        if (text.split("\n").length !== lines + 1)
+            throw new Error("unexpected number of lines");
+    )~~~"sv);
+}
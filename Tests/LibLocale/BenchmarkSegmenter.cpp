@@ -5,6 +5,7 @@
  */
 
 #include <LibLocale/Segmenter.h>
+#include <LibTest/Benchmark.h>
 #include <LibTest/TestCase.h>
 
 constexpr size_t N = 10'000;
@@ -18,6 +19,8 @@ auto long_string = make_string();
 
 BENCHMARK_CASE(for_each_boundary)
 {
+    Test::set_benchmark_throughput(long_string.bytes_as_string_view().length());
+
     Vector<size_t> boundaries;
     auto segmenter = Locale::Segmenter::create(Locale::SegmenterGranularity::Word);
 
@@ -31,6 +34,8 @@ BENCHMARK_CASE(for_each_boundary)
 
 BENCHMARK_CASE(forward)
 {
+    Test::set_benchmark_throughput(long_string.bytes_as_string_view().length());
+
     Vector<size_t> boundaries;
     auto segmenter = Locale::Segmenter::create(Locale::SegmenterGranularity::Word);
     segmenter->set_segmented_text(long_string);
@@ -51,6 +56,8 @@ BENCHMARK_CASE(forward)
 
 BENCHMARK_CASE(backward)
 {
+    Test::set_benchmark_throughput(long_string.bytes_as_string_view().length());
+
     Vector<size_t> boundaries;
     auto segmenter = Locale::Segmenter::create(Locale::SegmenterGranularity::Word);
     segmenter->set_segmented_text(long_string);
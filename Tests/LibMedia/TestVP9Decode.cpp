@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/ElapsedTimer.h>
 #include <LibMedia/Video/VP9/Decoder.h>
 
 #include "TestMediaCommon.h"
@@ -49,3 +50,17 @@ BENCHMARK_CASE(vp9_clamp_reference_mvs)
 {
     decode_video("./vp9_clamp_reference_mvs.webm"sv, 92, make_decoder);
 }
+
+BENCHMARK_CASE(vp9_decode_rate)
+{
+    auto report_decode_rate = [](StringView path, size_t frame_count) {
+        auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        decode_video(path, frame_count, make_decoder);
+        auto elapsed_seconds = timer.elapsed_time().to_nanoseconds() / 1'000'000'000.0;
+        outln("{}: {} frames in {:.3}s, {:.1} fps", path, frame_count, elapsed_seconds, frame_count / elapsed_seconds);
+    };
+
+    report_decode_rate("./vp9_4k.webm"sv, 2);
+    report_decode_rate("./vp9_clamp_reference_mvs.webm"sv, 92);
+    report_decode_rate("./vp9_oob_blocks.webm"sv, 240);
+}
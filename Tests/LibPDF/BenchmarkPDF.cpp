@@ -4,10 +4,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/LexicalPath.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/MappedFile.h>
+#include <LibCore/ResourceImplementationFile.h>
+#include <LibCore/System.h>
+#include <LibGfx/Bitmap.h>
 #include <LibPDF/CommonNames.h>
 #include <LibPDF/Document.h>
 #include <LibPDF/Function.h>
+#include <LibPDF/Renderer.h>
 #include <LibTest/TestCase.h>
 
 static PDF::Value make_array(Vector<float> floats)
@@ -73,3 +79,36 @@ BENCHMARK_CASE(function)
         VERIFY(result[2] == 0);
     }
 }
+
+BENCHMARK_CASE(render_pages)
+{
+#if !defined(AK_OS_SERENITY)
+    // Get from Build/lagom/bin/BenchmarkPDF to Build/lagom/Root/res.
+    auto source_root = LexicalPath(MUST(Core::System::current_executable_path())).parent().parent().string();
+    Core::ResourceImplementation::install(make<Core::ResourceImplementationFile>(MUST(String::formatted("{}/Root/res", source_root))));
+#endif
+
+    auto report_page_render_times = [](StringView path) {
+        auto file = MUST(Core::MappedFile::map(path));
+        auto document = MUST(PDF::Document::create(file->bytes()));
+        MUST(document->initialize());
+
+        for (u32 page_index = 0; page_index < document->get_page_count(); ++page_index) {
+            auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+            auto page = MUST(document->get_page(page_index));
+            auto page_size = Gfx::IntSize { 800, round_to<int>(800 * page.media_box.height() / page.media_box.width()) };
+            auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, page_size));
+            // Rendering errors are fine here, only the time it takes matters.
+            (void)PDF::Renderer::render(document, page, bitmap, Color::White, PDF::RenderingPreferences {});
+            auto elapsed_milliseconds = timer.elapsed_time().to_nanoseconds() / 1'000'000.0;
+            outln("{} page {}: {:.2} ms", path, page_index + 1, elapsed_milliseconds);
+        }
+    };
+
+    report_page_render_times("complex.pdf"sv);
+    report_page_render_times("linearized.pdf"sv);
+    report_page_render_times("paths.pdf"sv);
+    report_page_render_times("shade-radial.pdf"sv);
+    report_page_render_times("standard-14-fonts.pdf"sv);
+    report_page_render_times("text.pdf"sv);
+}
@@ -1218,3 +1218,145 @@ TEST_CASE(mismatching_brackets)
         EXPECT_EQ(re.parser_result.error, regex::Error::MismatchingBracket);
     }
 }
+
+TEST_CASE(lazy_dfa)
+{
+    struct _test {
+        StringView pattern;
+        StringView subject;
+        bool matches;
+        ECMAScriptFlags options {};
+    };
+
+    constexpr _test tests[] {
+        { "abc"sv, "xxabcxx"sv, true },
+        { "abc"sv, "xxabxcx"sv, false },
+        { "a+b"sv, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaac"sv, false },
+        { "(a|b)*c"sv, "ababababx"sv, false },
+        { "(a|b)*c"sv, "xababc"sv, true },
+        { "^abc"sv, "xabc"sv, false },
+        { "^abc"sv, "abcx"sv, true },
+        { "abc$"sv, "abcx"sv, false },
+        { "abc$"sv, "xabc"sv, true },
+        { "^$"sv, ""sv, true },
+        { "x*"sv, ""sv, true },
+        { "[a-z]+[0-9]"sv, "...abc1"sv, true },
+        { "[^a-z]{0,}z"sv, "abcz"sv, true },
+        { "\\d\\s\\w"sv, "1 a"sv, true },
+        { "\\d\\s\\w"sv, "1a "sv, false },
+        { "hello"sv, "xHeLLo"sv, true, ECMAScriptFlags::Insensitive },
+        { "[a-c]x"sv, "BX"sv, true, ECMAScriptFlags::Insensitive },
+        { "a.c"sv, "a\U0001F600c"sv, true, ECMAScriptFlags::Unicode },
+        { "a.c"sv, "a\U0001F600c"sv, false },
+        { "\U0001F600+$"sv, "x\U0001F600\U0001F600"sv, true, ECMAScriptFlags::Unicode },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.pattern, (ECMAScriptFlags)regex::AllFlags::Global | test.options);
+        EXPECT_EQ(re.parser_result.error, regex::Error::NoError);
+
+        auto subject = MUST(AK::utf8_to_utf16(test.subject));
+        Utf16View view { subject };
+
+        // The lazy DFA has to agree with the backtracking VM, both on its own and when used as a prefilter.
+        EXPECT_EQ(re.has_match(view), test.matches);
+        EXPECT_EQ(re.match(view).success, test.matches);
+        EXPECT_EQ(re.has_match(view), test.matches);
+    }
+
+    {
+        Regex<PosixExtended> re("^[a-z]+(foo|bar)$"sv);
+        EXPECT(re.parser_result.optimization_data.can_use_lazy_dfa);
+        EXPECT_EQ(re.has_match("xyzbar"sv, PosixFlags::Global), true);
+        EXPECT_EQ(re.has_match("xyzbaz"sv, PosixFlags::Global), false);
+        EXPECT_EQ(re.has_match("bar"sv, PosixFlags::Global), false);
+        EXPECT_EQ(re.match("xyzfoo"sv, PosixFlags::Global).success, true);
+    }
+
+    {
+        // Backreferences can't be handled by the DFA, these are left to the VM.
+        Regex<ECMA262> re("(a)\\1"sv);
+        EXPECT(!re.parser_result.optimization_data.can_use_lazy_dfa);
+        EXPECT_EQ(re.has_match("xaa"sv, (ECMAScriptFlags)regex::AllFlags::Global), true);
+    }
+}
+
+TEST_CASE(match_start_prefilters)
+{
+    {
+        Regex<PosixExtended> re("foo(bar|baz)+"sv);
+        EXPECT_EQ(re.parser_result.optimization_data.required_prefix, "foo"sv);
+        auto result = re.match("xx foobar foo foobazbar"sv, PosixFlags::Global);
+        EXPECT_EQ(result.count, 2u);
+        EXPECT_EQ(result.matches[0].view, "foobar"sv);
+        EXPECT_EQ(result.matches[0].global_offset, 3u);
+        EXPECT_EQ(result.matches[1].view, "foobazbar"sv);
+        EXPECT_EQ(result.matches[1].global_offset, 14u);
+        EXPECT_EQ(re.match("fo fobar"sv, PosixFlags::Global).success, false);
+    }
+    {
+        Regex<ECMA262> re("(\\d|[a-c])x"sv, (ECMAScriptFlags)regex::AllFlags::Global);
+        EXPECT(!re.parser_result.optimization_data.required_prefix.has_value());
+        EXPECT(re.parser_result.optimization_data.starting_characters.has_value());
+        auto result = re.match("zzz 4x qqq bx dx"sv);
+        EXPECT_EQ(result.count, 2u);
+        EXPECT_EQ(result.matches[0].view, "4x"sv);
+        EXPECT_EQ(result.matches[1].view, "bx"sv);
+    }
+    {
+        // Case-insensitive patterns have to consider both cases of the first character.
+        Regex<ECMA262> re("ab+c"sv, (ECMAScriptFlags)regex::AllFlags::Global | ECMAScriptFlags::Insensitive);
+        EXPECT(!re.parser_result.optimization_data.required_prefix.has_value());
+        auto result = re.match("xx ABBC abc"sv);
+        EXPECT_EQ(result.count, 2u);
+        EXPECT_EQ(result.matches[0].view, "ABBC"sv);
+    }
+    {
+        // Patterns that can match the empty string can start anywhere.
+        Regex<ECMA262> re("a*"sv, (ECMAScriptFlags)regex::AllFlags::Global);
+        EXPECT(!re.parser_result.optimization_data.starting_characters.has_value());
+    }
+    {
+        Regex<PosixExtended> re("^foo"sv);
+        EXPECT(re.parser_result.optimization_data.only_start_of_input);
+        EXPECT_EQ(re.match("foofoo"sv, PosixFlags::Global).count, 1u);
+        EXPECT_EQ(re.match("xfoo"sv, PosixFlags::Global).success, false);
+    }
+    {
+        // With multiline matching, '^' matches at the start of every line.
+        Regex<ECMA262> re("^foo"sv, ECMAScriptFlags::Multiline | (ECMAScriptFlags)regex::AllFlags::Global);
+        EXPECT_EQ(re.match("foo\nfoo"sv).count, 2u);
+    }
+}
+
+TEST_CASE(for_each_matching_line)
+{
+    auto collect_matching_lines = [](auto const& re, StringView buffer) {
+        Vector<ByteString> lines;
+        re.for_each_matching_line(buffer, [&](StringView line, size_t line_index) {
+            lines.append(ByteString::formatted("{}:{}", line_index, line));
+            return IterationDecision::Continue;
+        });
+        return lines;
+    };
+
+    auto buffer = "first line\nsecond foo line\n\nfoofoo\nno match\nlast foo"sv;
+
+    {
+        Regex<PosixExtended> re("foo+"sv);
+        EXPECT_EQ(collect_matching_lines(re, buffer), (Vector<ByteString> { "1:second foo line", "3:foofoo", "5:last foo" }));
+    }
+    {
+        Regex<PosixExtended> re("^(no|first)"sv);
+        EXPECT_EQ(collect_matching_lines(re, buffer), (Vector<ByteString> { "0:first line", "4:no match" }));
+    }
+    {
+        // Patterns that match the empty string match every line, including empty ones (but not after the last newline).
+        Regex<PosixExtended> re("x*"sv);
+        EXPECT_EQ(collect_matching_lines(re, "a\n\nb\n"sv).size(), 3u);
+    }
+    {
+        Regex<PosixBasic> re("LINE"sv, PosixFlags::Insensitive);
+        EXPECT_EQ(collect_matching_lines(re, buffer), (Vector<ByteString> { "0:first line", "1:second foo line" }));
+    }
+}
@@ -6,6 +6,7 @@
 
 #include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibSQL/Heap.h>
 #include <LibTest/TestCase.h>
@@ -192,3 +193,123 @@ TEST_CASE(heap_free_storage)
     auto new_heap_size = MUST(heap->file_size_in_bytes());
     EXPECT(new_heap_size <= heap_size);
 }
+
+TEST_CASE(heap_block_cache)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto heap = create_heap();
+    auto storage_block_id = heap->request_new_block_index();
+
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    auto long_string = builder.string_view();
+    TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
+    MUST(heap->flush());
+
+    // The first read comes from the file, the second one from the cache
+    auto statistics = heap->block_cache_statistics();
+    auto stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+    EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+    EXPECT_EQ(heap->block_cache_statistics().misses, statistics.misses + 4);
+    EXPECT_EQ(heap->block_cache_statistics().hits, statistics.hits);
+
+    stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+    EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+    EXPECT_EQ(heap->block_cache_statistics().misses, statistics.misses + 4);
+    EXPECT_EQ(heap->block_cache_statistics().hits, statistics.hits + 4);
+
+    // Overwritten blocks must not be read from the cache
+    builder.clear();
+    MUST(builder.try_append_repeated('y', SQL::Block::DATA_SIZE * 4));
+    auto other_long_string = builder.string_view();
+    TRY_OR_FAIL(heap->write_storage(storage_block_id, other_long_string.bytes()));
+    MUST(heap->flush());
+    auto stored_other_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+    EXPECT_EQ(other_long_string.bytes(), stored_other_long_string.bytes());
+}
+
+TEST_CASE(heap_block_cache_eviction)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto heap = create_heap();
+    auto storage_block_id = heap->request_new_block_index();
+
+    // Write storage that doesn't fit into the cache
+    StringBuilder builder;
+    for (size_t i = 0; i < SQL::Heap::BLOCK_CACHE_CAPACITY + 16; ++i)
+        MUST(builder.try_append_repeated('a' + (i % 26), SQL::Block::DATA_SIZE));
+    auto long_string = builder.string_view();
+    TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
+    MUST(heap->flush());
+
+    for (size_t i = 0; i < 2; ++i) {
+        auto stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+        EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+    }
+    EXPECT(heap->block_cache_statistics().evictions > 0);
+}
+
+TEST_CASE(heap_recover_committed_blocks_from_log)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto log_path = ByteString::formatted("{}-wal", db_path);
+
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    auto long_string = builder.string_view();
+
+    SQL::Block::Index committed_index = 0;
+    SQL::Block::Index uncommitted_index = 0;
+    {
+        auto heap = create_heap();
+        committed_index = heap->request_new_block_index();
+        TRY_OR_FAIL(heap->write_storage(committed_index, long_string.bytes()));
+        MUST(heap->flush());
+
+        uncommitted_index = heap->request_new_block_index();
+        TRY_OR_FAIL(heap->write_storage(uncommitted_index, long_string.bytes()));
+
+        // Pretend to crash: the heap is never destroyed, so its log is not checkpointed into the heap file.
+        EXPECT(MUST(Core::System::stat(log_path)).st_size > 0);
+        (void)heap.leak_ref();
+    }
+
+    // Append a torn record, as if the crash happened in the middle of a write to the log.
+    {
+        auto log_file = MUST(Core::File::open(log_path, Core::File::OpenMode::Write | Core::File::OpenMode::Append));
+        MUST(log_file->write_until_depleted("SWAL, but not quite"sv.bytes()));
+    }
+
+    auto heap = create_heap();
+    EXPECT_EQ(MUST(Core::System::stat(log_path)).st_size, 0);
+
+    auto stored_long_string = TRY_OR_FAIL(heap->read_storage(committed_index));
+    EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+    EXPECT(!heap->has_block(uncommitted_index));
+}
+
+TEST_CASE(heap_checkpoint)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto log_path = ByteString::formatted("{}-wal", db_path);
+    auto heap = create_heap();
+    auto storage_block_id = heap->request_new_block_index();
+
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    auto long_string = builder.string_view();
+    TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
+    MUST(heap->flush());
+
+    // Committed blocks are appended to the log; the heap file only grows once they are checkpointed
+    EXPECT_EQ(MUST(Core::System::stat(db_path)).st_size, 0);
+    EXPECT(MUST(Core::System::stat(log_path)).st_size > 0);
+    auto heap_size = MUST(heap->file_size_in_bytes());
+
+    MUST(heap->checkpoint());
+    EXPECT_EQ(MUST(Core::System::stat(log_path)).st_size, 0);
+    EXPECT_EQ(static_cast<size_t>(MUST(Core::System::stat(db_path)).st_size), heap_size);
+
+    auto stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+    EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+}
@@ -230,6 +230,42 @@ TEST_CASE(insert_with_placeholders)
     }
 }
 
+TEST_CASE(insert_batch_with_placeholders)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+
+    auto parser = SQL::AST::Parser(SQL::AST::Lexer("INSERT INTO TestSchema.TestTable VALUES (?, ?);"sv));
+    auto statement = parser.next_statement();
+    EXPECT(!parser.has_errors());
+
+    Vector<Vector<SQL::Value>> placeholder_value_sets;
+    for (auto count = 0; count < 100; ++count)
+        placeholder_value_sets.append(placeholders(ByteString::formatted("Test_{}", count), count));
+
+    auto batch_result = statement->execute_batch(database, placeholder_value_sets);
+    EXPECT(!batch_result.is_error());
+
+    auto result = batch_result.release_value();
+    EXPECT_EQ(result.command(), SQL::SQLCommand::Insert);
+    EXPECT_EQ(result.size(), 100u);
+
+    result = execute(database, "SELECT TextColumn, IntColumn FROM TestSchema.TestTable ORDER BY IntColumn;");
+    EXPECT_EQ(result.size(), 100u);
+    for (auto count = 0; count < 100; ++count) {
+        EXPECT_EQ(result[count].row[0], ByteString::formatted("Test_{}", count));
+        EXPECT_EQ(result[count].row[1], count);
+    }
+
+    placeholder_value_sets.append(placeholders(42, 42));
+    auto error = statement->execute_batch(database, placeholder_value_sets);
+    EXPECT(error.is_error());
+    EXPECT_EQ(error.error().error(), SQL::SQLErrorCode::InvalidValueType);
+}
+
 TEST_CASE(select_from_empty_table)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -664,6 +700,47 @@ TEST_CASE(select_with_offset_out_of_bounds)
     EXPECT_EQ(result.size(), 0u);
 }
 
+TEST_CASE(select_with_where_and_limit)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+    for (auto count = 0; count < 100; count++) {
+        auto result = execute(database,
+            ByteString::formatted("INSERT INTO TestSchema.TestTable ( TextColumn, IntColumn ) VALUES ( 'Test_{}', {} );", count, count));
+        EXPECT(result.size() == 1);
+    }
+    auto result = execute(database, "SELECT TextColumn, IntColumn FROM TestSchema.TestTable WHERE IntColumn >= 50 LIMIT 5 OFFSET 3;");
+    EXPECT_EQ(result.size(), 5u);
+    for (auto const& row : result)
+        EXPECT(row.row[1].to_int<i32>().value() >= 50);
+}
+
+TEST_CASE(explain_select)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_table(database);
+
+    auto plan = [&](ByteString const& sql) {
+        auto result = execute(database, sql);
+        EXPECT_EQ(result.command(), SQL::SQLCommand::Explain);
+
+        Vector<ByteString> steps;
+        for (auto const& row : result)
+            steps.append(row.row[0].to_byte_string());
+        return steps;
+    };
+
+    EXPECT_EQ(plan("EXPLAIN SELECT * FROM TestSchema.TestTable;"sv), (Vector<ByteString> { "SCAN TABLE TESTSCHEMA.TESTTABLE" }));
+    EXPECT_EQ(plan("EXPLAIN SELECT * FROM TestSchema.TestTable WHERE IntColumn > 3 LIMIT 10 OFFSET 5;"sv),
+        (Vector<ByteString> { "SCAN TABLE TESTSCHEMA.TESTTABLE", "FILTER ROWS BY WHERE CLAUSE", "STOP SCAN AFTER 15 MATCHING ROWS" }));
+    EXPECT_EQ(plan("EXPLAIN SELECT * FROM TestSchema.TestTable ORDER BY IntColumn LIMIT 10;"sv),
+        (Vector<ByteString> { "SCAN TABLE TESTSCHEMA.TESTTABLE", "SORT RESULTS FOR ORDER BY", "APPLY LIMIT TO RESULTS" }));
+}
+
 TEST_CASE(describe_table)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -783,3 +783,20 @@ TEST_CASE(describe_table)
     validate("DESCRIBE TABLE TableName;"sv, {}, "TABLENAME"sv);
     validate("DESCRIBE TABLE SchemaName.TableName;"sv, "SCHEMANAME"sv, "TABLENAME"sv);
 }
+
+TEST_CASE(explain)
+{
+    EXPECT(parse("EXPLAIN"sv).is_error());
+    EXPECT(parse("EXPLAIN;"sv).is_error());
+    EXPECT(parse("EXPLAIN TABLE table_name;"sv).is_error());
+    EXPECT(parse("EXPLAIN SELECT * FROM table_name"sv).is_error());
+
+    auto statement = TRY_OR_FAIL(parse("EXPLAIN SELECT * FROM table_name LIMIT 15;"sv));
+    EXPECT(is<SQL::AST::Explain>(*statement));
+
+    auto const& explain_statement = static_cast<const SQL::AST::Explain&>(*statement);
+    auto const& select_statement = explain_statement.select_statement();
+    EXPECT_EQ(select_statement->table_or_subquery_list().size(), 1u);
+    EXPECT_EQ(select_statement->table_or_subquery_list()[0]->table_name(), "TABLE_NAME"sv);
+    EXPECT(!select_statement->limit_clause().is_null());
+}
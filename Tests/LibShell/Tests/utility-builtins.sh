@@ -0,0 +1,39 @@
+#!/bin/Shell
+
+source $(dirname "$0")/test-commons.inc
+
+# These are run without starting a process.
+for name in echo printf test [ basename dirname {
+    if not [ "$(type $name)" = "$name is a shell builtin" ] { fail "'$name' is not a builtin" }
+}
+
+if not [ "$(echo -n a b)" = "a b" ] { fail "'echo -n' not working" }
+if not [ "$(echo -e 'a\tb')" = "a	b" ] { fail "'echo -e' not working" }
+
+if not [ "$(printf '%s-%03d|' x 7 y 8)" = "x-007|y-008|" ] { fail "'printf' not reusing its format" }
+if not [ "$(printf '%5s|%-3x|%c' ab 255 zz)" = "   ab|ff |z" ] { fail "'printf' conversions not working" }
+
+if not test 1 -lt 2 -a abc = abc { fail "'test' with '-a' not working" }
+if test 2 -lt 1 -o ! -n "" { fail "'test' with '-o' and '!' not working" }
+if not [ -d / ] { fail "'[' not working" }
+if [ -f / ] { fail "'[' not checking the file kind" }
+if [ -z x ] 2>/dev/null { fail "'[' not checking for empty strings" }
+
+if not [ "$(basename /a/b.txt .txt)" = "b" ] { fail "'basename' not working" }
+if not [ "$(dirname /a/b/c)" = "/a/b" ] { fail "'dirname' not working" }
+
+# Functions still take precedence over them.
+basename() { printf 'function' }
+if not [ "$(basename /a/b)" = "function" ] { fail "function not overriding 'basename'" }
+
+# Sourced scripts are parsed again once they change.
+script=/tmp/shell-test-source-cache.sh
+printf 'sourced_value=1\n' > $script
+source $script
+if not [ $sourced_value = 1 ] { fail "sourcing a script not working" }
+printf 'sourced_value=22\n' > $script
+source $script
+if not [ $sourced_value = 22 ] { fail "sourcing a changed script still runs the old version" }
+rm $script
+
+echo PASS
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTLS/Certificate.h>
+#include <LibTLS/SessionCache.h>
+#include <LibTest/TestCase.h>
+
+static TLS::SessionCache::Session make_session(u8 id)
+{
+    return {
+        .session_id = MUST(ByteBuffer::copy(Array<u8, 4> { id, id, id, id })),
+        .cipher = TLS::CipherSuite::TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256,
+        .master_key = MUST(ByteBuffer::create_zeroed(48)),
+        .extended_master_secret = true,
+        // Later sessions are newer, so that the order doesn't depend on the resolution of the clock.
+        .creation_time = MonotonicTime::now_coarse() - Duration::from_seconds(60 - id),
+    };
+}
+
+TEST_CASE(store_and_find_session)
+{
+    auto cache = TLS::SessionCache::create();
+    EXPECT(!cache->find_session("serenityos.org"sv).has_value());
+
+    cache->store_session("serenityos.org"sv, make_session(1));
+    auto session = cache->find_session("serenityos.org"sv);
+    EXPECT(session.has_value());
+    EXPECT_EQ(session->session_id.bytes(), (Array<u8, 4> { 1, 1, 1, 1 }).span());
+    EXPECT_EQ(session->cipher, TLS::CipherSuite::TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256);
+    EXPECT_EQ(session->master_key.size(), 48u);
+    EXPECT(session->extended_master_secret);
+    EXPECT(!cache->find_session("example.com"sv).has_value());
+
+    cache->store_session("serenityos.org"sv, make_session(2));
+    EXPECT_EQ(cache->find_session("serenityos.org"sv)->session_id.bytes(), (Array<u8, 4> { 2, 2, 2, 2 }).span());
+
+    cache->remove_session("serenityos.org"sv);
+    EXPECT(!cache->find_session("serenityos.org"sv).has_value());
+}
+
+TEST_CASE(full_cache_drops_oldest_session)
+{
+    auto cache = TLS::SessionCache::create(2);
+    cache->store_session("a.example"sv, make_session(1));
+    cache->store_session("b.example"sv, make_session(2));
+    cache->store_session("c.example"sv, make_session(3));
+
+    EXPECT(!cache->find_session("a.example"sv).has_value());
+    EXPECT(cache->find_session("b.example"sv).has_value());
+    EXPECT(cache->find_session("c.example"sv).has_value());
+}
+
+TEST_CASE(verified_chains)
+{
+    auto cache = TLS::SessionCache::create();
+
+    auto hash = TLS::SessionCache::hash_chain("serenityos.org"sv, {}, false);
+    EXPECT_NE(hash, TLS::SessionCache::hash_chain("example.com"sv, {}, false));
+    EXPECT_NE(hash, TLS::SessionCache::hash_chain("serenityos.org"sv, {}, true));
+
+    EXPECT(!cache->is_chain_verified(hash));
+    cache->add_verified_chain(hash, {});
+    EXPECT(cache->is_chain_verified(hash));
+}
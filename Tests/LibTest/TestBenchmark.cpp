@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/Benchmark.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(statistics)
+{
+    auto statistics = Test::BenchmarkStatistics::compute({ 5, 1, 4, 2, 3 });
+    EXPECT_EQ(statistics.sample_count, 5u);
+    EXPECT_EQ(statistics.min, 1.0);
+    EXPECT_EQ(statistics.max, 5.0);
+    EXPECT_EQ(statistics.mean, 3.0);
+    EXPECT_EQ(statistics.median, 3.0);
+    EXPECT_APPROXIMATE(statistics.variance, 2.5);
+    EXPECT_APPROXIMATE(statistics.percentile_5, 1.2);
+    EXPECT_APPROXIMATE(statistics.percentile_95, 4.8);
+
+    // The median of an even number of samples lies between the two in the middle.
+    EXPECT_EQ(Test::BenchmarkStatistics::compute({ 1, 2, 3, 10 }).median, 2.5);
+
+    auto single = Test::BenchmarkStatistics::compute({ 7 });
+    EXPECT_EQ(single.median, 7.0);
+    EXPECT_EQ(single.percentile_95, 7.0);
+    EXPECT_EQ(single.variance, 0.0);
+
+    EXPECT_EQ(Test::BenchmarkStatistics::compute({}).sample_count, 0u);
+}
+
+TEST_CASE(statistics_of_long_samples)
+{
+    // Summing up the squares of these would lose the variance entirely.
+    auto statistics = Test::BenchmarkStatistics::compute({ 1e12 + 1, 1e12 + 2, 1e12 + 3 });
+    EXPECT_APPROXIMATE(statistics.variance, 1.0);
+}
+
+TEST_CASE(throughput)
+{
+    Test::BenchmarkResult result;
+    result.nanoseconds = Test::BenchmarkStatistics::compute({ 500'000'000 });
+    EXPECT(!result.throughput_per_second().has_value());
+
+    result.throughput = Test::BenchmarkThroughput { 1024, Test::ThroughputUnit::Bytes };
+    EXPECT_EQ(result.throughput_per_second(), 2048.0);
+}
+
+TEST_CASE(compare_to_baseline)
+{
+    Vector<Test::BenchmarkResult> baseline_results;
+    baseline_results.append({ "fast", Test::BenchmarkStatistics::compute({ 1000, 1000, 1000 }), {}, Test::BenchmarkThroughput { 10, Test::ThroughputUnit::Items } });
+    baseline_results.append({ "slow", Test::BenchmarkStatistics::compute({ 2000 }), Test::BenchmarkStatistics::compute({ 4000 }), {} });
+    auto baseline = Test::benchmark_results_to_json("Suite"sv, baseline_results);
+
+    Vector<Test::BenchmarkResult> results;
+    results.append({ "slow", Test::BenchmarkStatistics::compute({ 3000 }), {}, {} });
+    results.append({ "new", Test::BenchmarkStatistics::compute({ 100 }), {}, {} });
+    results.append({ "fast", Test::BenchmarkStatistics::compute({ 500 }), {}, {} });
+
+    auto comparisons = MUST(Test::compare_benchmark_results_to_baseline(results, baseline));
+    EXPECT_EQ(comparisons.size(), 2u);
+    EXPECT_EQ(comparisons[0].name, "slow"sv);
+    EXPECT_APPROXIMATE(comparisons[0].change_in_percent(), 50.0);
+    EXPECT_EQ(comparisons[1].name, "fast"sv);
+    EXPECT_APPROXIMATE(comparisons[1].change_in_percent(), -50.0);
+
+    EXPECT(Test::compare_benchmark_results_to_baseline(results, "[]"sv).is_error());
+    EXPECT(Test::compare_benchmark_results_to_baseline(results, "{\"benchmarks\": [{\"name\": \"fast\"}]}"sv).is_error());
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibTest/Benchmark.h>
+#include <LibTest/TestCase.h>
+#include <LibTextCodec/Decoder.h>
+
+// Roughly what the markup of a large page looks like: mostly ASCII tags, attributes and scripts, with some text in
+// between that isn't.
+static ByteString make_page(StringView non_ascii_text)
+{
+    StringBuilder builder;
+    builder.append("<!DOCTYPE html><html><head><title>Benchmark</title></head><body>\n"sv);
+    for (size_t i = 0; i < 10'000; ++i) {
+        builder.appendff("<div class=\"entry entry-{}\"><a href=\"/articles/{}\">", i % 7, i);
+        builder.append(non_ascii_text);
+        builder.append("</a><script>window.entries.push({ id: "sv);
+        builder.appendff("{}, seen: false }});</script></div>\n", i);
+    }
+    builder.append("</body></html>\n"sv);
+    return builder.to_byte_string();
+}
+
+static ByteString encode_as_utf16le(StringView utf8)
+{
+    StringBuilder builder;
+    for (auto code_point : Utf8View { utf8 }) {
+        VERIFY(code_point < 0x10000);
+        builder.append(static_cast<char>(code_point & 0xff));
+        builder.append(static_cast<char>(code_point >> 8));
+    }
+    return builder.to_byte_string();
+}
+
+static auto utf8_page = make_page("Grüße aus Köln, 東京 und Zürich"sv);
+static auto windows_1252_page = make_page("Gr\xfc\xdf" "e aus K\xf6ln und Z\xfcrich"sv);
+static auto utf16le_page = encode_as_utf16le(utf8_page);
+
+BENCHMARK_CASE(utf8_to_utf8)
+{
+    Test::set_benchmark_throughput(utf8_page.length());
+    auto decoder = TextCodec::decoder_for_exact_name("utf-8"sv);
+    EXPECT(!MUST(decoder->to_utf8(utf8_page)).is_empty());
+}
+
+BENCHMARK_CASE(windows_1252_to_utf8)
+{
+    Test::set_benchmark_throughput(windows_1252_page.length());
+    auto decoder = TextCodec::decoder_for_exact_name("windows-1252"sv);
+    EXPECT(!MUST(decoder->to_utf8(windows_1252_page)).is_empty());
+}
+
+BENCHMARK_CASE(latin1_to_utf8)
+{
+    Test::set_benchmark_throughput(windows_1252_page.length());
+    auto decoder = TextCodec::decoder_for_exact_name("iso-8859-1"sv);
+    EXPECT(!MUST(decoder->to_utf8(windows_1252_page)).is_empty());
+}
+
+BENCHMARK_CASE(utf16le_to_utf8)
+{
+    Test::set_benchmark_throughput(utf16le_page.length());
+    auto decoder = TextCodec::decoder_for_exact_name("utf-16le"sv);
+    EXPECT(!MUST(decoder->to_utf8(utf16le_page)).is_empty());
+}
+
+BENCHMARK_CASE(windows_1252_process)
+{
+    Test::set_benchmark_throughput(windows_1252_page.length());
+    auto decoder = TextCodec::decoder_for_exact_name("windows-1252"sv);
+    size_t code_points = 0;
+    MUST(decoder->process(windows_1252_page, [&](u32) -> ErrorOr<void> {
+        ++code_points;
+        return {};
+    }));
+    EXPECT_EQ(code_points, windows_1252_page.length());
+}
@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/String.h>
+#include <AK/StringBuilder.h>
 #include <AK/Vector.h>
 #include <LibTest/TestCase.h>
 #include <LibTextCodec/Decoder.h>
@@ -58,3 +60,68 @@ TEST_CASE(test_utf16le_decode)
     EXPECT(processed_code_points[2] == 0x6B);
     EXPECT(processed_code_points[3] == 0x1F600);
 }
+
+static String decode_one_code_point_at_a_time(TextCodec::Decoder& decoder, StringView input)
+{
+    StringBuilder builder;
+    MUST(decoder.process(input, [&](u32 code_point) {
+        return builder.try_append_code_point(code_point);
+    }));
+    return MUST(builder.to_string());
+}
+
+TEST_CASE(test_utf16_to_utf8_with_ascii_runs)
+{
+    // "A long run of ASCII text, then säk😀, a lone high surrogate and some more ASCII", followed by a trailing byte.
+    StringBuilder utf16le;
+    StringBuilder utf16be;
+    auto append_code_unit = [&](u16 code_unit) {
+        utf16le.append(static_cast<char>(code_unit & 0xff));
+        utf16le.append(static_cast<char>(code_unit >> 8));
+        utf16be.append(static_cast<char>(code_unit >> 8));
+        utf16be.append(static_cast<char>(code_unit & 0xff));
+    };
+    for (auto c : "A long run of ASCII text, then s"sv)
+        append_code_unit(c);
+    for (u16 code_unit : Array<u16, 10> { 0xe4, 'k', 0xd83d, 0xde00, ',', ' ', 0xd800, 'x', 'y', 'z' })
+        append_code_unit(code_unit);
+    utf16le.append('!');
+    utf16be.append('!');
+
+    auto expected = "A long run of ASCII text, then säk😀, \ufffdxyz"sv;
+
+    auto le_decoder = TextCodec::UTF16LEDecoder();
+    EXPECT_EQ(MUST(le_decoder.to_utf8(utf16le.string_view())), expected);
+    EXPECT_EQ(decode_one_code_point_at_a_time(le_decoder, utf16le.string_view()), expected);
+
+    auto be_decoder = TextCodec::UTF16BEDecoder();
+    EXPECT_EQ(MUST(be_decoder.to_utf8(utf16be.string_view())), expected);
+    EXPECT_EQ(decode_one_code_point_at_a_time(be_decoder, utf16be.string_view()), expected);
+}
+
+TEST_CASE(test_single_byte_to_utf8_with_ascii_runs)
+{
+    auto input = "Prices are given in \x80 (\xe9tudiants: \x80\x80 less), see the list below for details.\x85"sv;
+
+    auto windows_1252_decoder = TextCodec::decoder_for_exact_name("windows-1252"sv);
+    EXPECT(windows_1252_decoder.has_value());
+    EXPECT_EQ(MUST(windows_1252_decoder->to_utf8(input)), "Prices are given in € (étudiants: €€ less), see the list below for details.…"sv);
+    EXPECT_EQ(MUST(windows_1252_decoder->to_utf8(input)), decode_one_code_point_at_a_time(*windows_1252_decoder, input));
+
+    auto latin1_decoder = TextCodec::decoder_for_exact_name("iso-8859-1"sv);
+    EXPECT(latin1_decoder.has_value());
+    EXPECT_EQ(MUST(latin1_decoder->to_utf8(input)), decode_one_code_point_at_a_time(*latin1_decoder, input));
+
+    auto x_user_defined_decoder = TextCodec::decoder_for_exact_name("x-user-defined"sv);
+    EXPECT(x_user_defined_decoder.has_value());
+    EXPECT_EQ(MUST(x_user_defined_decoder->to_utf8(input)), decode_one_code_point_at_a_time(*x_user_defined_decoder, input));
+}
+
+TEST_CASE(test_single_byte_validate)
+{
+    // 0xA5 isn't part of ISO-8859-3.
+    auto decoder = TextCodec::decoder_for_exact_name("iso-8859-3"sv);
+    EXPECT(decoder.has_value());
+    EXPECT(decoder->validate("Some text with an \xa1 in it"sv));
+    EXPECT(!decoder->validate("Some text with an \xa5 in it"sv));
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibThreading/BoundedQueue.h>
+#include <LibThreading/Thread.h>
+
+TEST_CASE(values_are_dequeued_in_order)
+{
+    Threading::BoundedQueue<int> queue { 4 };
+    EXPECT(queue.enqueue(1));
+    EXPECT(queue.enqueue(2));
+    EXPECT(queue.enqueue(3));
+
+    EXPECT_EQ(queue.dequeue(), 1);
+    EXPECT_EQ(queue.dequeue(), 2);
+    EXPECT_EQ(queue.dequeue(), 3);
+}
+
+TEST_CASE(closed_queue_is_drained_before_it_ends)
+{
+    Threading::BoundedQueue<int> queue { 4 };
+    EXPECT(queue.enqueue(1));
+    queue.close();
+
+    EXPECT(!queue.enqueue(2));
+    EXPECT_EQ(queue.dequeue(), 1);
+    EXPECT(!queue.dequeue().has_value());
+}
+
+TEST_CASE(producer_waits_for_consumer)
+{
+    static constexpr int value_count = 10000;
+
+    Threading::BoundedQueue<int> queue { 3 };
+    auto producer = Threading::Thread::construct([&queue]() {
+        for (int i = 0; i < value_count; ++i)
+            VERIFY(queue.enqueue(i));
+        queue.close();
+        return 0;
+    });
+    producer->start();
+
+    int expected_value = 0;
+    while (true) {
+        auto value = queue.dequeue();
+        if (!value.has_value())
+            break;
+        EXPECT_EQ(*value, expected_value);
+        ++expected_value;
+    }
+    EXPECT_EQ(expected_value, value_count);
+
+    MUST(producer->join());
+}
+
+TEST_CASE(closing_wakes_up_blocked_producer)
+{
+    Threading::BoundedQueue<int> queue { 1 };
+    EXPECT(queue.enqueue(1));
+
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<bool> enqueued { true };
+    auto producer = Threading::Thread::construct([&]() {
+        enqueued = queue.enqueue(2);
+        return 0;
+    });
+    producer->start();
+
+    queue.close();
+    MUST(producer->join());
+    EXPECT(!enqueued.load());
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/Timer.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/EventLoopThread.h>
+#include <pthread.h>
+
+TEST_CASE(invocations_run_on_the_thread_in_order)
+{
+    Core::EventLoop main_loop;
+    auto thread = MUST(Threading::EventLoopThread::create("Test"sv));
+
+    Vector<int> order;
+    pthread_t invoked_on {};
+    Core::EventLoop* invoked_loop = nullptr;
+    bool done = false;
+
+    for (int i = 0; i < 10; ++i)
+        thread->deferred_invoke([&order, i] { order.append(i); });
+    thread->deferred_invoke([&] {
+        invoked_on = pthread_self();
+        invoked_loop = &Core::EventLoop::current();
+        main_loop.deferred_invoke([&done] { done = true; });
+    });
+
+    main_loop.spin_until([&] { return done; });
+
+    EXPECT_EQ(order, (Vector<int> { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    EXPECT(!pthread_equal(invoked_on, pthread_self()));
+    EXPECT_NE(invoked_loop, &main_loop);
+}
+
+TEST_CASE(timers_fire_on_the_thread)
+{
+    Core::EventLoop main_loop;
+    OwnPtr<Threading::EventLoopThread> thread = MUST(Threading::EventLoopThread::create());
+
+    Atomic<bool> fired { false };
+    RefPtr<Core::Timer> timer;
+    thread->deferred_invoke([&] {
+        timer = Core::Timer::create_single_shot(10, [&] {
+            fired = true;
+            main_loop.wake();
+        });
+        timer->start();
+    });
+
+    main_loop.spin_until([&] { return fired.load(); });
+
+    // The timer has to go away on the thread that created it.
+    thread->deferred_invoke([&] { timer = nullptr; });
+    thread = nullptr;
+    EXPECT(!timer);
+}
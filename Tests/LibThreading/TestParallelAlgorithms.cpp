@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/ParallelAlgorithms.h>
+
+static Vector<u32> pseudo_random_values(size_t count)
+{
+    Vector<u32> values;
+    values.ensure_capacity(count);
+    u32 state = 1;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 1103515245 + 12345;
+        values.unchecked_append(state >> 8);
+    }
+    return values;
+}
+
+TEST_CASE(parallel_for_visits_every_element_once)
+{
+    Vector<u32> values;
+    values.resize(50'000);
+
+    Threading::parallel_for(values.span(), [](Span<u32> slice) {
+        for (auto& value : slice)
+            ++value;
+    });
+
+    for (auto value : values)
+        EXPECT_EQ(value, 1u);
+}
+
+TEST_CASE(parallel_reduce_combines_slices_in_order)
+{
+    auto values = pseudo_random_values(50'000);
+
+    u64 expected_sum = 0;
+    for (auto value : values)
+        expected_sum += value;
+
+    auto sum = Threading::parallel_reduce(
+        values.span(), 100, [](Span<u32> slice) {
+            u64 sum = 0;
+            for (auto value : slice)
+                sum += value;
+            return sum;
+        },
+        [](u64 a, u64 b) { return a + b; });
+    EXPECT_EQ(sum, expected_sum);
+
+    Vector<u32> indices;
+    for (u32 i = 0; i < 1000; ++i)
+        indices.append(i);
+
+    auto concatenated = Threading::parallel_reduce(
+        indices.span(), 10, [](Span<u32> slice) { return Vector<u32> { slice }; },
+        [](Vector<u32> a, Vector<u32> b) {
+            a.extend(move(b));
+            return a;
+        });
+    EXPECT_EQ(concatenated, indices);
+}
+
+TEST_CASE(parallel_sort)
+{
+    for (size_t count : { 0, 1, 100, 10'000, 100'000 }) {
+        auto values = pseudo_random_values(count);
+        auto expected = values;
+        quick_sort(expected);
+
+        Threading::parallel_sort(values.span());
+        EXPECT_EQ(values, expected);
+    }
+
+    auto values = pseudo_random_values(10'000);
+    Threading::parallel_sort(values.span(), 16, [](u32 a, u32 b) { return a > b; });
+    for (size_t i = 1; i < values.size(); ++i)
+        EXPECT(values[i - 1] >= values[i]);
+}
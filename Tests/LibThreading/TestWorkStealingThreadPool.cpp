@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/WorkStealingThreadPool.h>
+
+TEST_CASE(deque_pops_newest_and_steals_oldest)
+{
+    int values[3] = { 1, 2, 3 };
+    Threading::WorkStealingDeque<int> deque(2);
+    EXPECT(deque.is_empty());
+
+    for (auto& value : values)
+        deque.push(&value);
+
+    EXPECT_EQ(deque.steal(), &values[0]);
+    EXPECT_EQ(deque.pop(), &values[2]);
+    EXPECT_EQ(deque.pop(), &values[1]);
+    EXPECT_EQ(deque.pop(), nullptr);
+    EXPECT_EQ(deque.steal(), nullptr);
+    EXPECT(deque.is_empty());
+}
+
+TEST_CASE(submitted_tasks_run)
+{
+    auto pool = MUST(Threading::WorkStealingThreadPool::create(4));
+    EXPECT_EQ(pool->worker_count(), 4u);
+
+    Atomic<size_t> count { 0 };
+    for (size_t i = 0; i < 1000; ++i)
+        pool->submit([&count] { count.fetch_add(1); });
+    pool->wait_for_all();
+
+    EXPECT_EQ(count.load(), 1000u);
+}
+
+static u64 fibonacci(Threading::WorkStealingThreadPool& pool, u64 n)
+{
+    if (n < 2)
+        return n;
+
+    u64 a = 0;
+    u64 b = 0;
+    pool.fork_join([&] { a = fibonacci(pool, n - 1); }, [&] { b = fibonacci(pool, n - 2); });
+    return a + b;
+}
+
+TEST_CASE(nested_fork_join)
+{
+    auto pool = MUST(Threading::WorkStealingThreadPool::create(4));
+
+    u64 result = 0;
+    Threading::WorkStealingThreadPool::TaskGroup group;
+    pool->spawn(group, [&] { result = fibonacci(*pool, 20); });
+    pool->wait(group);
+
+    EXPECT_EQ(result, 6765u);
+}
+
+TEST_CASE(parallel_for_visits_every_element_once)
+{
+    auto pool = MUST(Threading::WorkStealingThreadPool::create(4));
+
+    Vector<u32> values;
+    values.resize(100'000);
+
+    pool->parallel_for(values.span(), 1000, [](Span<u32> slice) {
+        EXPECT(slice.size() <= 1000);
+        for (auto& value : slice)
+            ++value;
+    });
+
+    for (auto value : values)
+        EXPECT_EQ(value, 1u);
+}
@@ -39,6 +39,7 @@ TEST_CASE(grapheme_segmentation)
     test_grapheme_segmentation("a\nb"sv, { 0u, 1u, 2u, 3u });
     test_grapheme_segmentation("a\n\rb"sv, { 0u, 1u, 2u, 3u, 4u });
     test_grapheme_segmentation("a\r\nb"sv, { 0u, 1u, 3u, 4u });
+    test_grapheme_segmentation("ae\u0301b"sv, { 0u, 1u, 4u, 5u });
 
     test_grapheme_segmentation("aᄀb"sv, { 0u, 1u, 4u, 5u });
     test_grapheme_segmentation("aᄀᄀb"sv, { 0u, 1u, 7u, 8u });
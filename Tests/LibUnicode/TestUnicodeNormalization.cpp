@@ -93,3 +93,18 @@ TEST_CASE(normalize_nfkc)
     EXPECT_EQ(normalize("\u0958"sv, NormalizationForm::NFKC), "\u0915\u093C"sv);
     EXPECT_EQ(normalize("\u2126"sv, NormalizationForm::NFKC), "\u03A9"sv);
 }
+
+TEST_CASE(normalize_text_with_unchanged_runs)
+{
+    EXPECT_EQ(normalize("The quick brown fox jumps over the lazy dog."sv, NormalizationForm::NFC), "The quick brown fox jumps over the lazy dog."sv);
+    EXPECT_EQ(normalize("Déjà vu, naïve façade"sv, NormalizationForm::NFC), "Déjà vu, naïve façade"sv);
+
+    EXPECT_EQ(normalize("Ame\u0301lie and Ame\u0301lie"sv, NormalizationForm::NFC), "Amélie and Amélie"sv);
+    EXPECT_EQ(normalize("Amélie and Amélie"sv, NormalizationForm::NFD), "Ame\u0301lie and Ame\u0301lie"sv);
+    EXPECT_EQ(normalize("e\u0301 at the start, and at the end: e\u0301"sv, NormalizationForm::NFC), "é at the start, and at the end: é"sv);
+    EXPECT_EQ(normalize("D\u0307\u0323 and D\u0323\u0307"sv, NormalizationForm::NFC), "\u1E0C\u0307 and \u1E0C\u0307"sv);
+
+    EXPECT_EQ(normalize("Oﬀice ¼ of the time"sv, NormalizationForm::NFKC), "Office 1\u20444 of the time"sv);
+    EXPECT_EQ(normalize("1\u00A02"sv, NormalizationForm::NFKD), "1 2"sv);
+    EXPECT_EQ(normalize("1\u00A02"sv, NormalizationForm::NFC), "1\u00A02"sv);
+}
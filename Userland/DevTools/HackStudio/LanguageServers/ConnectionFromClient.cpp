@@ -14,8 +14,11 @@ namespace LanguageServers {
 
 static HashMap<int, RefPtr<ConnectionFromClient>> s_connections;
 
+static constexpr int s_pending_edits_delay_ms = 300;
+
 ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> socket)
     : IPC::ConnectionFromClient<LanguageClientEndpoint, LanguageServerEndpoint>(*this, move(socket), 1)
+    , m_pending_edits_timer(Core::Timer::create_single_shot(s_pending_edits_delay_ms, [this]() { process_pending_edits(); }))
 {
     s_connections.set(1, *this);
 }
@@ -26,6 +29,20 @@ void ConnectionFromClient::die()
     exit(0);
 }
 
+void ConnectionFromClient::did_edit_file(ByteString const& filename)
+{
+    m_files_with_pending_edits.set(filename);
+    m_pending_edits_timer->restart();
+}
+
+void ConnectionFromClient::process_pending_edits()
+{
+    m_pending_edits_timer->stop();
+    auto files_with_pending_edits = move(m_files_with_pending_edits);
+    for (auto& filename : files_with_pending_edits)
+        m_autocomplete_engine->on_edit(filename);
+}
+
 void ConnectionFromClient::greet(ByteString const& project_root)
 {
     m_filedb.set_project_root(project_root);
@@ -54,7 +71,7 @@ void ConnectionFromClient::file_edit_insert_text(ByteString const& filename, Byt
     dbgln_if(LANGUAGE_SERVER_DEBUG, "Text: {}", text);
     dbgln_if(LANGUAGE_SERVER_DEBUG, "[{}:{}]", start_line, start_column);
     m_filedb.on_file_edit_insert_text(filename, text, start_line, start_column);
-    m_autocomplete_engine->on_edit(filename);
+    did_edit_file(filename);
 }
 
 void ConnectionFromClient::file_edit_remove_text(ByteString const& filename, i32 start_line, i32 start_column, i32 end_line, i32 end_column)
@@ -62,7 +79,7 @@ void ConnectionFromClient::file_edit_remove_text(ByteString const& filename, i32
     dbgln_if(LANGUAGE_SERVER_DEBUG, "RemoveText for file: {}", filename);
     dbgln_if(LANGUAGE_SERVER_DEBUG, "[{}:{} - {}:{}]", start_line, start_column, end_line, end_column);
     m_filedb.on_file_edit_remove_text(filename, start_line, start_column, end_line, end_column);
-    m_autocomplete_engine->on_edit(filename);
+    did_edit_file(filename);
 }
 
 void ConnectionFromClient::auto_complete_suggestions(CodeComprehension::ProjectLocation const& location)
@@ -75,6 +92,7 @@ void ConnectionFromClient::auto_complete_suggestions(CodeComprehension::ProjectL
         return;
     }
 
+    process_pending_edits();
     GUI::TextPosition autocomplete_position = { (size_t)location.line, (size_t)max(location.column, location.column - 1) };
     Vector<CodeComprehension::AutocompleteResultEntry> suggestions = m_autocomplete_engine->get_suggestions(location.file, autocomplete_position);
     async_auto_complete_suggestions(move(suggestions));
@@ -91,7 +109,7 @@ void ConnectionFromClient::set_file_content(ByteString const& filename, ByteStri
         document->set_text(content.view());
     }
     VERIFY(m_filedb.is_open(filename));
-    m_autocomplete_engine->on_edit(filename);
+    did_edit_file(filename);
 }
 
 void ConnectionFromClient::find_declaration(CodeComprehension::ProjectLocation const& location)
@@ -103,6 +121,7 @@ void ConnectionFromClient::find_declaration(CodeComprehension::ProjectLocation c
         return;
     }
 
+    process_pending_edits();
     GUI::TextPosition identifier_position = { (size_t)location.line, (size_t)location.column };
     auto decl_location = m_autocomplete_engine->find_declaration_of(location.file, identifier_position);
     if (!decl_location.has_value()) {
@@ -123,6 +142,7 @@ void ConnectionFromClient::get_parameters_hint(CodeComprehension::ProjectLocatio
         return;
     }
 
+    process_pending_edits();
     GUI::TextPosition identifier_position = { (size_t)location.line, (size_t)location.column };
     auto params = m_autocomplete_engine->get_function_params_hint(location.file, identifier_position);
     if (!params.has_value()) {
@@ -148,6 +168,7 @@ void ConnectionFromClient::get_tokens_info(ByteString const& filename)
         return;
     }
 
+    process_pending_edits();
     auto tokens_info = m_autocomplete_engine->get_tokens_info(filename);
     async_tokens_info_result(move(tokens_info));
 }
@@ -10,8 +10,10 @@
 #include "../AutoCompleteResponse.h"
 #include "FileDB.h"
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/LexicalPath.h>
 #include <LibCodeComprehension/CodeComprehensionEngine.h>
+#include <LibCore/Timer.h>
 #include <LibIPC/ConnectionFromClient.h>
 
 #include <Userland/DevTools/HackStudio/LanguageServers/LanguageClientEndpoint.h>
@@ -39,6 +41,15 @@ protected:
 
     FileDB m_filedb;
     OwnPtr<CodeComprehension::CodeComprehensionEngine> m_autocomplete_engine;
+
+private:
+    void did_edit_file(ByteString const& filename);
+    void process_pending_edits();
+
+    // Edits are passed on to the engine once the client has stopped typing for a while, or when a request needs an
+    // up-to-date view of the files, so that a burst of keystrokes only causes a single reparse.
+    NonnullRefPtr<Core::Timer> m_pending_edits_timer;
+    HashTable<ByteString> m_files_with_pending_edits;
 };
 
 }
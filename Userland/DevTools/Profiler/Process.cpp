@@ -116,12 +116,28 @@ Debug::DebugInfo const& LibraryMetadata::Library::load_debug_info(FlatPtr base_a
     return *debug_info.ptr();
 }
 
+ByteString MappedObject::symbolicate(FlatPtr address, u32* offset)
+{
+    if (auto it = symbol_cache.find(address); it != symbol_cache.end()) {
+        if (offset)
+            *offset = it->value.offset;
+        return it->value.name;
+    }
+
+    CachedSymbol symbol;
+    symbol.name = elf.symbolicate(address, &symbol.offset);
+    if (offset)
+        *offset = symbol.offset;
+    symbol_cache.set(address, symbol);
+    return symbol.name;
+}
+
 ByteString LibraryMetadata::Library::symbolicate(FlatPtr ptr, u32* offset) const
 {
     if (!object)
         return ByteString::formatted("?? <{:p}>", ptr);
 
-    return object->elf.symbolicate(ptr - base, offset);
+    return object->symbolicate(ptr - base, offset);
 }
 
 LibraryMetadata::Library const* LibraryMetadata::library_containing(FlatPtr ptr) const
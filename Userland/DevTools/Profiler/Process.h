@@ -19,6 +19,16 @@ namespace Profiler {
 struct MappedObject {
     NonnullOwnPtr<Core::MappedFile> file;
     ELF::Image elf;
+
+    struct CachedSymbol {
+        ByteString name;
+        u32 offset { 0 };
+    };
+    // Mapped objects are kept around for as long as we're running, so every address is only looked up once, no matter
+    // how many samples, processes or profiles it shows up in.
+    HashMap<FlatPtr, CachedSymbol> symbol_cache {};
+
+    ByteString symbolicate(FlatPtr address, u32* offset);
 };
 
 extern HashMap<ByteString, OwnPtr<MappedObject>> g_mapped_object_cache;
@@ -15,9 +15,12 @@
 #include <AK/QuickSort.h>
 #include <AK/RefPtr.h>
 #include <AK/Try.h>
+#include <Kernel/API/Perfcore.h>
+#include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibELF/Image.h>
 #include <LibSymbolication/Symbolication.h>
+#include <serenity.h>
 #include <sys/stat.h>
 
 namespace Profiler {
@@ -32,14 +35,27 @@ static void sort_profile_nodes(Vector<NonnullRefPtr<ProfileNode>>& nodes)
         child->sort_children();
 }
 
-Profile::Profile(Vector<Process> processes, Vector<Event> events)
+Profile::Profile(Vector<Process> processes, Vector<Event> events, u64 dropped_event_count)
     : m_processes(move(processes))
     , m_events(move(events))
+    , m_dropped_event_count(dropped_event_count)
     , m_file_event_nodes(FileEventNode::create(""))
 {
+    // The kernel records events of different CPUs in the order they were committed, which isn't quite the order of their
+    // timestamps. Sorting them lets us find the events of a time range with a binary search.
+    quick_sort(m_events, [](auto& a, auto& b) {
+        if (a.timestamp == b.timestamp)
+            return a.serial < b.serial;
+        return a.timestamp < b.timestamp;
+    });
+
     for (size_t i = 0; i < m_events.size(); ++i) {
-        if (m_events[i].data.has<Event::SignpostData>())
+        if (m_events[i].is_signpost())
             m_signpost_indices.append(i);
+        if (auto* hardware_sample = m_events[i].data.get_pointer<Event::HardwareSampleData>())
+            m_hardware_events |= 1u << to_underlying(hardware_sample->event);
+
+        m_event_indices_by_pid.ensure(m_events[i].pid).append(i);
     }
 
     m_first_timestamp = m_events.first().timestamp;
@@ -68,6 +84,38 @@ GUI::Model& Profile::signposts_model()
     return *m_signposts_model;
 }
 
+Vector<size_t> const& Profile::event_indices_for_pid(pid_t pid) const
+{
+    static Vector<size_t> const no_event_indices;
+    auto it = m_event_indices_by_pid.find(pid);
+    if (it == m_event_indices_by_pid.end())
+        return no_event_indices;
+    return it->value;
+}
+
+Profile::EventIndexRange Profile::event_index_range_in_filter_range() const
+{
+    if (!has_timestamp_filter_range())
+        return { 0, m_events.size() };
+
+    auto first_event_index_at_or_after = [this](u64 timestamp) {
+        size_t low = 0;
+        size_t high = m_events.size();
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            if (m_events[middle].timestamp < timestamp)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        return low;
+    };
+
+    auto start = first_event_index_at_or_after(m_timestamp_filter_range_start);
+    auto end = m_timestamp_filter_range_end == NumericLimits<u64>::max() ? m_events.size() : first_event_index_at_or_after(m_timestamp_filter_range_end + 1);
+    return { start, max(start, end) };
+}
+
 void Profile::rebuild_tree()
 {
     Vector<NonnullRefPtr<ProfileNode>> roots;
@@ -104,23 +152,24 @@ void Profile::rebuild_tree()
     m_filtered_signpost_indices.clear();
     m_file_event_nodes->children().clear();
 
-    for (size_t event_index = 0; event_index < m_events.size(); ++event_index) {
+    auto range = event_index_range_in_filter_range();
+    for (size_t event_index = range.start; event_index < range.end; ++event_index) {
         auto& event = m_events.at(event_index);
 
-        if (has_timestamp_filter_range()) {
-            auto timestamp = event.timestamp;
-            if (timestamp < m_timestamp_filter_range_start || timestamp > m_timestamp_filter_range_end)
-                continue;
-        }
-
         if (!process_filter_contains(event.pid, event.serial))
             continue;
 
-        if (event.data.has<Event::SignpostData>()) {
+        if (event.is_signpost()) {
             m_filtered_signpost_indices.append(event_index);
             continue;
         }
 
+        if (m_hardware_event_filter.has_value()) {
+            auto* hardware_sample = event.data.get_pointer<Event::HardwareSampleData>();
+            if (!hardware_sample || hardware_sample->event != m_hardware_event_filter.value())
+                continue;
+        }
+
         m_filtered_event_indices.append(event_index);
 
         if (auto* malloc_data = event.data.get_pointer<Event::MallocData>(); malloc_data && !live_allocations.contains(malloc_data->ptr))
@@ -265,101 +314,206 @@ void Profile::rebuild_tree()
 Optional<MappedObject> g_kernel_debuginfo_object;
 OwnPtr<Debug::DebugInfo> g_kernel_debug_info;
 
-ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path)
+static Optional<Profile::Event::HardwareEvent> hardware_event_from_type(u32 type)
 {
-    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    switch (type) {
+    case PERF_EVENT_CPU_CYCLES:
+        return Profile::Event::HardwareEvent::CPUCycles;
+    case PERF_EVENT_INSTRUCTIONS_RETIRED:
+        return Profile::Event::HardwareEvent::InstructionsRetired;
+    case PERF_EVENT_CACHE_MISS:
+        return Profile::Event::HardwareEvent::CacheMisses;
+    case PERF_EVENT_BRANCH_MISS:
+        return Profile::Event::HardwareEvent::BranchMisses;
+    default:
+        return {};
+    }
+}
 
-    auto json = JsonValue::from_string(TRY(file->read_until_eof()));
-    if (json.is_error() || !json.value().is_object())
-        return Error::from_string_literal("Invalid perfcore format (not a JSON object)");
+// Reads the fixed part of an event's data. Fields that are missing from the record read as zero.
+template<typename T>
+static T read_event_data(ReadonlyBytes data)
+{
+    T value {};
+    memcpy(&value, data.data(), min(sizeof(T), data.size()));
+    return value;
+}
 
-    auto const& object = json.value().as_object();
+// Strings in event data take up everything after the fixed part.
+static ByteString read_event_data_string(ReadonlyBytes data, size_t offset)
+{
+    if (offset >= data.size())
+        return {};
+    return StringView { data.slice(offset) };
+}
+
+ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path)
+{
+    // Saved profiles are mapped, but the ones we read from /proc/<pid>/perf_events can't be.
+    OwnPtr<Core::MappedFile> mapped_file;
+    ByteBuffer file_contents;
+    ReadonlyBytes bytes;
+    if (auto mapped_file_or_error = Core::MappedFile::map(path); !mapped_file_or_error.is_error()) {
+        mapped_file = mapped_file_or_error.release_value();
+        bytes = mapped_file->bytes();
+    } else {
+        auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+        file_contents = TRY(file->read_until_eof());
+        bytes = file_contents.bytes();
+    }
+
+    if (bytes.size() < sizeof(PerfcoreHeader))
+        return Error::from_string_literal("Invalid perfcore format (file is too short)");
+    auto const& header = *reinterpret_cast<PerfcoreHeader const*>(bytes.data());
+    if (StringView { header.magic, sizeof(header.magic) } != PERFCORE_MAGIC ""sv)
+        return Error::from_string_literal("Invalid perfcore format (bad magic)");
+    if (header.version != PERFCORE_VERSION)
+        return Error::from_string_literal("Unsupported perfcore version");
 
     if (!g_kernel_debuginfo_object.has_value()) {
         auto debuginfo_file_or_error = Core::MappedFile::map("/boot/Kernel.debug"sv);
         if (!debuginfo_file_or_error.is_error()) {
             auto debuginfo_file = debuginfo_file_or_error.release_value();
             auto debuginfo_image = ELF::Image(debuginfo_file->bytes());
-            g_kernel_debuginfo_object = { { move(debuginfo_file), move(debuginfo_image) } };
+            g_kernel_debuginfo_object = { { .file = move(debuginfo_file), .elf = move(debuginfo_image) } };
         }
     }
 
-    auto strings_value = object.get_array("strings"sv);
-    if (!strings_value.has_value())
-        return Error::from_string_literal("Malformed profile (strings is not an array)");
-    auto const& strings = strings_value.value();
-
     HashMap<FlatPtr, ByteString> profile_strings;
-    for (FlatPtr string_id = 0; string_id < strings.size(); ++string_id) {
-        auto const& value = strings.at(string_id);
-        profile_strings.set(string_id, value.as_string());
-    }
-
-    auto events_value = object.get_array("events"sv);
-    if (!events_value.has_value())
-        return Error::from_string_literal("Malformed profile (events is not an array)");
-    auto const& perf_events = events_value.value();
-
     Vector<NonnullOwnPtr<Process>> all_processes;
     HashMap<pid_t, Process*> current_processes;
     Vector<Event> events;
     EventSerialNumber next_serial;
+    u64 dropped_event_count = 0;
+
+    for (size_t record_offset = sizeof(PerfcoreHeader); record_offset < bytes.size();) {
+        if (bytes.size() - record_offset < sizeof(PerfcoreRecordHeader))
+            return Error::from_string_literal("Malformed profile (truncated record)");
+        auto const& record_header = *reinterpret_cast<PerfcoreRecordHeader const*>(bytes.offset(record_offset));
+        if (record_header.size < sizeof(PerfcoreRecordHeader) || record_header.size > bytes.size() - record_offset)
+            return Error::from_string_literal("Malformed profile (bad record size)");
+        auto record = bytes.slice(record_offset, record_header.size);
+        record_offset += record_header.size;
+
+        if (record_header.type == PerfcoreRecordType::String) {
+            if (record.size() < sizeof(PerfcoreStringRecord))
+                return Error::from_string_literal("Malformed profile (truncated string)");
+            auto const& string_record = *reinterpret_cast<PerfcoreStringRecord const*>(record.data());
+            if (string_record.length > record.size() - sizeof(PerfcoreStringRecord))
+                return Error::from_string_literal("Malformed profile (truncated string)");
+            profile_strings.set(string_record.index, StringView { record.slice(sizeof(PerfcoreStringRecord), string_record.length) });
+            continue;
+        }
 
-    for (auto const& perf_event_value : perf_events.values()) {
-        auto const& perf_event = perf_event_value.as_object();
+        if (record_header.type == PerfcoreRecordType::DroppedEvents) {
+            if (record.size() < sizeof(PerfcoreDroppedEventsRecord))
+                return Error::from_string_literal("Malformed profile (truncated dropped events)");
+            dropped_event_count += reinterpret_cast<PerfcoreDroppedEventsRecord const*>(record.data())->count;
+            continue;
+        }
+
+        // Skip over record types from newer kernels that we don't know about.
+        if (record_header.type != PerfcoreRecordType::Event)
+            continue;
+
+        if (record.size() < sizeof(PerfcoreEventRecord))
+            return Error::from_string_literal("Malformed profile (truncated event)");
+        auto const& perf_event = *reinterpret_cast<PerfcoreEventRecord const*>(record.data());
+        auto stack_size_in_bytes = perf_event.stack_size * sizeof(u64);
+        if (stack_size_in_bytes + perf_event.data_size > record.size() - sizeof(PerfcoreEventRecord))
+            return Error::from_string_literal("Malformed profile (truncated event)");
+        auto stack = record.slice(sizeof(PerfcoreEventRecord), stack_size_in_bytes);
+        auto data = record.slice(sizeof(PerfcoreEventRecord) + stack_size_in_bytes, perf_event.data_size);
 
         Event event;
 
         event.serial = next_serial;
         next_serial.increment();
-        event.timestamp = perf_event.get_u64("timestamp"sv).value_or(0);
-        event.lost_samples = perf_event.get_u32("lost_samples"sv).value_or(0);
-        event.pid = perf_event.get_i32("pid"sv).value_or(0);
-        event.tid = perf_event.get_i32("tid"sv).value_or(0);
+        event.timestamp = perf_event.timestamp_ns / 1'000'000;
+        event.lost_samples = perf_event.lost_samples;
+        event.pid = perf_event.pid;
+        event.tid = perf_event.tid;
 
-        auto type_string = perf_event.get_byte_string("type"sv).value_or({});
-
-        if (type_string == "sample"sv) {
+        switch (perf_event.type) {
+        case PERF_EVENT_SAMPLE:
             event.data = Event::SampleData {};
-        } else if (type_string == "kmalloc"sv) {
+            break;
+        case PERF_EVENT_KMALLOC: {
+            auto memory_data = read_event_data<PerfcoreMemoryEventData>(data);
             event.data = Event::MallocData {
-                .ptr = perf_event.get_addr("ptr"sv).value_or(0),
-                .size = perf_event.get_integer<size_t>("size"sv).value_or(0),
+                .ptr = memory_data.ptr,
+                .size = memory_data.size,
             };
-        } else if (type_string == "kfree"sv) {
+            break;
+        }
+        case PERF_EVENT_KFREE:
             event.data = Event::FreeData {
-                .ptr = perf_event.get_addr("ptr"sv).value_or(0),
+                .ptr = read_event_data<PerfcoreMemoryEventData>(data).ptr,
             };
-        } else if (type_string == "signpost"sv) {
-            auto string_id = perf_event.get_addr("arg1"sv).value_or(0);
+            break;
+        case PERF_EVENT_SIGNPOST: {
+            auto signpost_data = read_event_data<PerfcoreSignpostEventData>(data);
             event.data = Event::SignpostData {
-                .string = profile_strings.get(string_id).value_or(ByteString::formatted("Signpost #{}", string_id)),
-                .arg = perf_event.get_addr("arg2"sv).value_or(0),
+                .string = profile_strings.get(signpost_data.string_index).value_or(ByteString::formatted("Signpost #{}", signpost_data.string_index)),
+                .arg = signpost_data.arg,
             };
-        } else if (type_string == "mmap"sv) {
-            auto ptr = perf_event.get_addr("ptr"sv).value_or(0);
-            auto size = perf_event.get_integer<size_t>("size"sv).value_or(0);
-            auto name = perf_event.get_byte_string("name"sv).value_or({});
+            break;
+        }
+        case PERF_EVENT_TRACEPOINT: {
+            auto tracepoint_data = read_event_data<PerfcoreTracepointEventData>(data);
+            event.data = Event::TracepointData {
+                .name = read_event_data_string(data, sizeof(PerfcoreTracepointEventData)),
+                .arg1 = static_cast<FlatPtr>(tracepoint_data.arg1),
+                .arg2 = static_cast<FlatPtr>(tracepoint_data.arg2),
+            };
+            break;
+        }
+        case PERF_EVENT_SCHEDULING_LATENCY: {
+            auto latency_data = read_event_data<PerfcoreSchedulingLatencyEventData>(data);
+            event.data = Event::SchedulingLatencyData {
+                .latency = Duration::from_nanoseconds(latency_data.latency_ns),
+                .cpu = latency_data.cpu,
+            };
+            break;
+        }
+        case PERF_EVENT_CPU_CYCLES:
+        case PERF_EVENT_INSTRUCTIONS_RETIRED:
+        case PERF_EVENT_CACHE_MISS:
+        case PERF_EVENT_BRANCH_MISS: {
+            auto sample_data = read_event_data<PerfcoreHardwareSampleEventData>(data);
+            event.data = Event::HardwareSampleData {
+                .event = hardware_event_from_type(perf_event.type).value(),
+                .period = sample_data.period,
+                .cpu = sample_data.cpu,
+            };
+            break;
+        }
+        case PERF_EVENT_MMAP: {
+            auto memory_data = read_event_data<PerfcoreMemoryEventData>(data);
+            auto name = read_event_data_string(data, sizeof(PerfcoreMemoryEventData));
 
             event.data = Event::MmapData {
-                .ptr = ptr,
-                .size = size,
+                .ptr = memory_data.ptr,
+                .size = memory_data.size,
                 .name = name,
             };
 
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
-                it->value->library_metadata.handle_mmap(ptr, size, name);
+                it->value->library_metadata.handle_mmap(memory_data.ptr, memory_data.size, name);
             continue;
-        } else if (type_string == "munmap"sv) {
+        }
+        case PERF_EVENT_MUNMAP: {
+            auto memory_data = read_event_data<PerfcoreMemoryEventData>(data);
             event.data = Event::MunmapData {
-                .ptr = perf_event.get_addr("ptr"sv).value_or(0),
-                .size = perf_event.get_integer<size_t>("size"sv).value_or(0),
+                .ptr = memory_data.ptr,
+                .size = memory_data.size,
             };
             continue;
-        } else if (type_string == "process_create"sv) {
-            auto parent_pid = perf_event.get_integer<pid_t>("parent_pid"sv).value_or(0);
-            auto executable = perf_event.get_byte_string("executable"sv).value_or({});
+        }
+        case PERF_EVENT_PROCESS_CREATE: {
+            auto parent_pid = read_event_data<PerfcoreProcessCreateEventData>(data).parent_pid;
+            auto executable = read_event_data_string(data, sizeof(PerfcoreProcessCreateEventData));
             event.data = Event::ProcessCreateData {
                 .parent_pid = parent_pid,
                 .executable = executable,
@@ -376,8 +530,9 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
             current_processes.set(sampled_process->pid, sampled_process);
             all_processes.append(move(sampled_process));
             continue;
-        } else if (type_string == "process_exec"sv) {
-            auto executable = perf_event.get_byte_string("executable"sv).value_or({});
+        }
+        case PERF_EVENT_PROCESS_EXEC: {
+            auto executable = read_event_data_string(data, 0);
             event.data = Event::ProcessExecData {
                 .executable = executable,
             };
@@ -398,14 +553,16 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
             current_processes.set(sampled_process->pid, sampled_process);
             all_processes.append(move(sampled_process));
             continue;
-        } else if (type_string == "process_exit"sv) {
+        }
+        case PERF_EVENT_PROCESS_EXIT: {
             auto* old_process = current_processes.get(event.pid).value();
             old_process->end_valid = event.serial;
 
             current_processes.remove(event.pid);
             continue;
-        } else if (type_string == "thread_create"sv) {
-            auto parent_tid = perf_event.get_integer<pid_t>("parent_tid"sv).value_or(0);
+        }
+        case PERF_EVENT_THREAD_CREATE: {
+            auto parent_tid = read_event_data<PerfcoreThreadCreateEventData>(data).parent_tid;
             event.data = Event::ThreadCreateData {
                 .parent_tid = parent_tid,
             };
@@ -413,81 +570,79 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
             if (it != current_processes.end())
                 it->value->handle_thread_create(event.tid, event.serial);
             continue;
-        } else if (type_string == "thread_exit"sv) {
+        }
+        case PERF_EVENT_THREAD_EXIT: {
             auto it = current_processes.find(event.pid);
             if (it != current_processes.end())
                 it->value->handle_thread_exit(event.tid, event.serial);
             continue;
-        } else if (type_string == "filesystem"sv) {
+        }
+        case PERF_EVENT_FILESYSTEM: {
+            auto filesystem_data = read_event_data<PerfcoreFilesystemEventData>(data);
+            auto filename = profile_strings.get(filesystem_data.filename_index).value_or("");
             Event::FilesystemEventData fsdata {
-                .duration = Duration::from_nanoseconds(perf_event.get_integer<u64>("durationNs"sv).value_or(0)),
+                .duration = Duration::from_nanoseconds(filesystem_data.duration_ns),
                 .data = Event::OpenEventData {},
             };
-            auto const filesystem_event_type = perf_event.get("fs_event_type"sv).value_or("").as_string();
-            if (filesystem_event_type == "open"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value_or("");
+            switch (filesystem_data.type) {
+            case PerfcoreFilesystemEventType::Open:
                 fsdata.data = Event::OpenEventData {
-                    .dirfd = perf_event.get_integer<int>("dirfd"sv).value_or(0),
+                    .dirfd = filesystem_data.fd,
                     .path = filename,
-                    .options = perf_event.get_integer<int>("options"sv).value_or(0),
-                    .mode = perf_event.get_integer<u64>("mode"sv).value_or(0),
+                    .options = filesystem_data.options,
+                    .mode = filesystem_data.mode,
                 };
-            } else if (filesystem_event_type == "close"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value_or("");
+                break;
+            case PerfcoreFilesystemEventType::Close:
                 fsdata.data = Event::CloseEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem_data.fd,
                     .path = filename,
                 };
-            } else if (filesystem_event_type == "preadv"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value();
+                break;
+            case PerfcoreFilesystemEventType::Preadv:
                 fsdata.data = Event::PreadvEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem_data.fd,
                     .path = filename,
-                    .offset = perf_event.get_integer<off_t>("offset"sv).value_or(0),
+                    .offset = filesystem_data.offset,
                 };
-            } else if (filesystem_event_type == "read"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value();
+                break;
+            case PerfcoreFilesystemEventType::Read:
                 fsdata.data = Event::ReadEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem_data.fd,
                     .path = filename,
                 };
-            } else if (filesystem_event_type == "pread"sv) {
-                auto const string_index = perf_event.get_addr("filename_index"sv).value_or(0);
-                auto const filename = profile_strings.get(string_index).value();
+                break;
+            case PerfcoreFilesystemEventType::Pread:
                 fsdata.data = Event::PreadEventData {
-                    .fd = perf_event.get_integer<int>("fd"sv).value_or(0),
+                    .fd = filesystem_data.fd,
                     .path = filename,
-                    .buffer_ptr = perf_event.get_integer<FlatPtr>("buffer_ptr"sv).value_or(0),
-                    .size = perf_event.get_integer<size_t>("size"sv).value_or(0),
-                    .offset = perf_event.get_integer<off_t>("offset"sv).value_or(0),
+                    .buffer_ptr = static_cast<FlatPtr>(filesystem_data.buffer_ptr),
+                    .size = filesystem_data.size,
+                    .offset = filesystem_data.offset,
                 };
+                break;
             }
 
             event.data = fsdata;
-        } else {
-            dbgln("Unknown event type '{}'", type_string);
+            break;
+        }
+        default:
+            dbgln("Unknown event type {}", perf_event.type);
             VERIFY_NOT_REACHED();
         }
 
         auto maybe_kernel_base = Symbolication::kernel_base();
 
-        auto stack = perf_event.get_array("stack"sv);
-        VERIFY(stack.has_value());
-        auto const& stack_array = stack.value();
-        for (ssize_t i = stack_array.values().size() - 1; i >= 0; --i) {
-            auto const& frame = stack_array.at(i);
-            auto ptr = frame.as_integer<u64>();
+        auto const* frames = reinterpret_cast<u64 const*>(stack.data());
+        for (ssize_t i = perf_event.stack_size - 1; i >= 0; --i) {
+            auto ptr = frames[i];
             u32 offset = 0;
             DeprecatedFlyString object_name;
             ByteString symbol;
 
             if (maybe_kernel_base.has_value() && ptr >= maybe_kernel_base.value()) {
                 if (g_kernel_debuginfo_object.has_value()) {
-                    symbol = g_kernel_debuginfo_object->elf.symbolicate(ptr - maybe_kernel_base.value(), &offset);
+                    symbol = g_kernel_debuginfo_object->symbolicate(ptr - maybe_kernel_base.value(), &offset);
                 } else {
                     symbol = ByteString::formatted("?? <{:p}>", ptr);
                 }
@@ -531,7 +686,7 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
     for (auto& it : all_processes)
         processes.append(move(*it));
 
-    return adopt_nonnull_own_or_enomem(new (nothrow) Profile(move(processes), move(events)));
+    return adopt_nonnull_own_or_enomem(new (nothrow) Profile(move(processes), move(events), dropped_event_count));
 }
 
 void ProfileNode::sort_children()
@@ -637,6 +792,32 @@ void Profile::set_show_percentages(bool show_percentages)
     m_show_percentages = show_percentages;
 }
 
+StringView Profile::hardware_event_name(Event::HardwareEvent event)
+{
+    switch (event) {
+    case Event::HardwareEvent::CPUCycles:
+        return "CPU Cycles"sv;
+    case Event::HardwareEvent::InstructionsRetired:
+        return "Instructions Retired"sv;
+    case Event::HardwareEvent::CacheMisses:
+        return "Cache Misses"sv;
+    case Event::HardwareEvent::BranchMisses:
+        return "Branch Misses"sv;
+    case Event::HardwareEvent::__Count:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void Profile::set_hardware_event_filter(Optional<Event::HardwareEvent> event)
+{
+    if (m_hardware_event_filter == event)
+        return;
+    m_hardware_event_filter = event;
+    rebuild_tree();
+    m_samples_model->invalidate();
+}
+
 void Profile::set_disassembly_index(GUI::ModelIndex const& index)
 {
     if (m_disassembly_index == index)
@@ -200,6 +200,32 @@ public:
             FlatPtr arg {};
         };
 
+        struct TracepointData {
+            ByteString name;
+            FlatPtr arg1 {};
+            FlatPtr arg2 {};
+        };
+
+        struct SchedulingLatencyData {
+            Duration latency;
+            u32 cpu { 0 };
+        };
+
+        enum class HardwareEvent : u8 {
+            CPUCycles,
+            InstructionsRetired,
+            CacheMisses,
+            BranchMisses,
+            __Count,
+        };
+
+        // Recorded every `period` hardware events by a performance counter overflow.
+        struct HardwareSampleData {
+            HardwareEvent event { HardwareEvent::CPUCycles };
+            u64 period { 0 };
+            u32 cpu { 0 };
+        };
+
         struct MmapData {
             FlatPtr ptr {};
             size_t size {};
@@ -263,7 +289,10 @@ public:
             Variant<OpenEventData, CloseEventData, PreadvEventData, ReadEventData, PreadEventData> data;
         };
 
-        Variant<nullptr_t, SampleData, MallocData, FreeData, SignpostData, MmapData, MunmapData, ProcessCreateData, ProcessExecData, ThreadCreateData, FilesystemEventData> data { nullptr };
+        // Signposts and tracepoints are both shown as signposts.
+        bool is_signpost() const { return data.has<SignpostData>() || data.has<TracepointData>(); }
+
+        Variant<nullptr_t, SampleData, MallocData, FreeData, SignpostData, TracepointData, SchedulingLatencyData, HardwareSampleData, MmapData, MunmapData, ProcessCreateData, ProcessExecData, ThreadCreateData, FilesystemEventData> data { nullptr };
     };
 
     Vector<Event> const& events() const { return m_events; }
@@ -293,19 +322,32 @@ public:
     bool show_percentages() const { return m_show_percentages; }
     void set_show_percentages(bool);
 
+    static StringView hardware_event_name(Event::HardwareEvent);
+    bool has_hardware_event(Event::HardwareEvent event) const { return (m_hardware_events & (1u << to_underlying(event))) != 0; }
+    // Only shows the samples of a single hardware event in the tree when set.
+    void set_hardware_event_filter(Optional<Event::HardwareEvent>);
+
     Vector<Process> const& processes() const { return m_processes; }
 
+    // The number of events the kernel couldn't record because its profile buffer was full.
+    u64 dropped_event_count() const { return m_dropped_event_count; }
+
+    // The indices of all events of the processes with this pid, in the order of their timestamps.
+    Vector<size_t> const& event_indices_for_pid(pid_t) const;
+
+    struct EventIndexRange {
+        size_t start { 0 };
+        size_t end { 0 };
+    };
+    // The events are sorted by their timestamps, so the ones in the timestamp filter range are next to each other.
+    EventIndexRange event_index_range_in_filter_range() const;
+
     template<typename Callback>
     void for_each_event_in_filter_range(Callback callback)
     {
-        for (auto& event : m_events) {
-            if (has_timestamp_filter_range()) {
-                auto timestamp = event.timestamp;
-                if (timestamp < m_timestamp_filter_range_start || timestamp > m_timestamp_filter_range_end)
-                    continue;
-            }
-            callback(event);
-        }
+        auto range = event_index_range_in_filter_range();
+        for (size_t i = range.start; i < range.end; ++i)
+            callback(m_events[i]);
     }
 
     template<typename Callback>
@@ -319,7 +361,7 @@ public:
     }
 
 private:
-    Profile(Vector<Process>, Vector<Event>);
+    Profile(Vector<Process>, Vector<Event>, u64 dropped_event_count);
 
     void rebuild_tree();
 
@@ -340,7 +382,9 @@ private:
 
     Vector<Process> m_processes;
     Vector<Event> m_events;
+    u64 m_dropped_event_count { 0 };
     Vector<size_t> m_signpost_indices;
+    HashMap<pid_t, Vector<size_t>> m_event_indices_by_pid;
     Vector<size_t> m_filtered_signpost_indices;
 
     bool m_has_timestamp_filter_range { false };
@@ -354,6 +398,9 @@ private:
     bool m_inverted { false };
     bool m_show_top_functions { false };
     bool m_show_percentages { false };
+
+    u32 m_hardware_events { 0 };
+    Optional<Event::HardwareEvent> m_hardware_event_filter;
 };
 
 }
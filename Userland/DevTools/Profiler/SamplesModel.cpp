@@ -48,6 +48,10 @@ ErrorOr<String> SamplesModel::column_name(int column) const
         return "Innermost Frame"_string;
     case Column::Path:
         return "Path"_string;
+    case Column::SchedulingLatency:
+        return "Scheduling Delay"_string;
+    case Column::HardwareEvent:
+        return "Hardware Event"_string;
     default:
         VERIFY_NOT_REACHED();
     }
@@ -111,6 +115,18 @@ GUI::Variant SamplesModel::data(GUI::ModelIndex const& index, GUI::ModelRole rol
             }
         }
 
+        if (index.column() == Column::SchedulingLatency) {
+            if (event.data.has<Profile::Event::SchedulingLatencyData>())
+                return ByteString::formatted("{} us", event.data.get<Profile::Event::SchedulingLatencyData>().latency.to_microseconds());
+            return "";
+        }
+
+        if (index.column() == Column::HardwareEvent) {
+            if (auto const* hardware_sample = event.data.get_pointer<Profile::Event::HardwareSampleData>())
+                return ByteString::formatted("{} (every {})", Profile::hardware_event_name(hardware_sample->event), hardware_sample->period);
+            return "";
+        }
+
         return {};
     }
     return {};
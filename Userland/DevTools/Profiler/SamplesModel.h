@@ -29,6 +29,8 @@ public:
         LostSamples,
         InnermostStackFrame,
         Path,
+        SchedulingLatency,
+        HardwareEvent,
         __Count
     };
 
@@ -78,10 +78,14 @@ GUI::Variant SignpostsModel::data(GUI::ModelIndex const& index, GUI::ModelRole r
         }
 
         if (index.column() == Column::SignpostString) {
+            if (auto const* tracepoint = event.data.get_pointer<Profile::Event::TracepointData>())
+                return tracepoint->name;
             return event.data.get<Profile::Event::SignpostData>().string;
         }
 
         if (index.column() == Column::SignpostArgument) {
+            if (auto const* tracepoint = event.data.get_pointer<Profile::Event::TracepointData>())
+                return ByteString::formatted("{}, {}", tracepoint->arg1, tracepoint->arg2);
             return event.data.get<Profile::Event::SignpostData>().arg;
         }
         return {};
@@ -129,8 +129,12 @@ void TimelineTrack::mousemove_event(GUI::MouseEvent& event)
         constexpr int hoverable_padding = 2;
         Gfx::IntRect hoverable_rect { x - hoverable_padding, frame_thickness(), hoverable_padding * 2, height() - frame_thickness() * 2 };
         if (hoverable_rect.contains_horizontally(event.x())) {
-            auto const& data = signpost.data.template get<Profile::Event::SignpostData>();
-            GUI::Application::the()->show_tooltip_immediately(MUST(String::formatted("{}, {}", data.string, data.arg)), this);
+            String tooltip;
+            if (auto const* tracepoint = signpost.data.template get_pointer<Profile::Event::TracepointData>())
+                tooltip = MUST(String::formatted("{}, {}, {}", tracepoint->name, tracepoint->arg1, tracepoint->arg2));
+            else if (auto const* data = signpost.data.template get_pointer<Profile::Event::SignpostData>())
+                tooltip = MUST(String::formatted("{}, {}", data->string, data->arg));
+            GUI::Application::the()->show_tooltip_immediately(tooltip, this);
             hovering_a_signpost = true;
             return IterationDecision::Break;
         }
@@ -153,10 +157,8 @@ void TimelineTrack::recompute_histograms_if_needed(HistogramInputs const& inputs
     m_kernel_histogram = Histogram { inputs.start, inputs.end, inputs.columns };
     m_user_histogram = Histogram { inputs.start, inputs.end, inputs.columns };
 
-    for (auto const& event : m_profile.events()) {
-        if (event.pid != m_process.pid)
-            continue;
-
+    for (auto event_index : m_profile.event_indices_for_pid(m_process.pid)) {
+        auto const& event = m_profile.events()[event_index];
         if (!m_process.valid_at(event.serial))
             continue;
 
@@ -22,6 +22,7 @@
 #include <LibCore/Timer.h>
 #include <LibDesktop/Launcher.h>
 #include <LibGUI/Action.h>
+#include <LibGUI/ActionGroup.h>
 #include <LibGUI/Application.h>
 #include <LibGUI/BoxLayout.h>
 #include <LibGUI/Button.h>
@@ -101,8 +102,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     auto timeline_view = TRY(TimelineView::try_create(*profile));
     for (auto const& process : profile->processes()) {
         bool matching_event_found = false;
-        for (auto const& event : profile->events()) {
-            if (event.pid == process.pid && process.valid_at(event.serial)) {
+        for (auto event_index : profile->event_indices_for_pid(process.pid)) {
+            if (process.valid_at(profile->events()[event_index].serial)) {
                 matching_event_found = true;
                 break;
             }
@@ -228,7 +229,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return ByteString::formatted("{} Samples", sample_count.to_i32());
     };
 
-    auto& statusbar = main_widget->add<GUI::Statusbar>();
+    auto& statusbar = main_widget->add<GUI::Statusbar>(profile->dropped_event_count() > 0 ? 2 : 1);
+    if (profile->dropped_event_count() > 0)
+        statusbar.set_text(1, TRY(String::formatted("{} events dropped", profile->dropped_event_count())));
     auto statusbar_update = [&] {
         auto& view = *timeline_view;
         StringBuilder builder;
@@ -301,6 +304,30 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     view_menu->add_action(disassembly_action);
     view_menu->add_action(source_action);
 
+    GUI::ActionGroup hardware_event_actions;
+    hardware_event_actions.set_exclusive(true);
+    auto add_hardware_event_action = [&](auto& menu, StringView name, Optional<Profile::Event::HardwareEvent> event) {
+        auto action = GUI::Action::create_checkable(name, [&profile, event](auto&) {
+            profile->set_hardware_event_filter(event);
+        });
+        hardware_event_actions.add_action(*action);
+        menu.add_action(*action);
+        return action;
+    };
+    bool has_hardware_events = false;
+    for (size_t i = 0; i < to_underlying(Profile::Event::HardwareEvent::__Count); ++i)
+        has_hardware_events |= profile->has_hardware_event(static_cast<Profile::Event::HardwareEvent>(i));
+    if (has_hardware_events) {
+        auto hardware_event_menu = view_menu->add_submenu("&Hardware Event"_string);
+        auto all_events_action = add_hardware_event_action(*hardware_event_menu, "&All Events"sv, {});
+        all_events_action->set_checked(true);
+        for (size_t i = 0; i < to_underlying(Profile::Event::HardwareEvent::__Count); ++i) {
+            auto event = static_cast<Profile::Event::HardwareEvent>(i);
+            if (profile->has_hardware_event(event))
+                add_hardware_event_action(*hardware_event_menu, Profile::hardware_event_name(event), event);
+        }
+    }
+
     auto help_menu = window->add_menu("&Help"_string);
     help_menu->add_action(GUI::CommonActions::make_command_palette_action(window));
     help_menu->add_action(GUI::CommonActions::make_help_action([](auto&) {
@@ -192,6 +192,8 @@ void clear_color(Gfx::Color const& color)
     verify_no_error();
 }
 
+static size_t s_draw_call_count = 0;
+
 void draw_arrays(DrawPrimitive draw_primitive, size_t count)
 {
     GLenum mode = GL_TRIANGLES;
@@ -199,6 +201,17 @@ void draw_arrays(DrawPrimitive draw_primitive, size_t count)
         mode = GL_TRIANGLE_FAN;
     glDrawArrays(mode, 0, count);
     verify_no_error();
+    ++s_draw_call_count;
+}
+
+size_t draw_call_count()
+{
+    return s_draw_call_count;
+}
+
+void reset_draw_call_count()
+{
+    s_draw_call_count = 0;
 }
 
 Buffer create_buffer()
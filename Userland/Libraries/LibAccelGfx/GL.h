@@ -102,6 +102,10 @@ enum class DrawPrimitive {
 
 void draw_arrays(DrawPrimitive, size_t count);
 
+// The number of draw calls issued since the counter was last reset, for debugging purposes.
+size_t draw_call_count();
+void reset_draw_call_count();
+
 Buffer create_buffer();
 void bind_buffer(Buffer const&);
 void upload_to_buffer(Buffer const&, Span<float> values);
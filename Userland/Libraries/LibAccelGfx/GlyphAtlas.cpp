@@ -4,9 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/QuickSort.h>
+#include <AK/TypeCasts.h>
 #include <LibAccelGfx/GlyphAtlas.h>
-#include <LibGfx/Painter.h>
+#include <LibGfx/Font/ScaledFont.h>
 
 namespace AccelGfx {
 
@@ -18,69 +18,68 @@ GlyphAtlas& GlyphAtlas::the()
     return *s_the;
 }
 
+GlyphAtlas::~GlyphAtlas()
+{
+    for (auto const& it : m_page_textures)
+        GL::delete_texture(it.value.texture);
+}
+
+static Gfx::GlyphAtlas::Page const* page_for_glyph(Gfx::Font const& font, u32 code_point, Gfx::IntRect& rect)
+{
+    if (!is<Gfx::ScaledFont>(font))
+        return nullptr;
+    auto const& scaled_font = static_cast<Gfx::ScaledFont const&>(font);
+
+    auto location = scaled_font.glyph_atlas_location(scaled_font.glyph_id_for_code_point(code_point), { 0, 0 });
+    if (!location.has_value())
+        return nullptr;
+
+    rect = location->rect;
+    return &scaled_font.glyph_atlas().pages()[location->page_index];
+}
+
 void GlyphAtlas::update(HashMap<Gfx::Font const*, HashTable<u32>> const& unique_glyphs)
 {
-    auto need_to_rebuild_texture = false;
-    HashMap<GlyphsTextureKey, NonnullRefPtr<Gfx::Bitmap>> glyph_bitmaps;
+    HashTable<Gfx::Bitmap const*> used_pages;
     for (auto const& [font, code_points] : unique_glyphs) {
-        for (auto const& code_point : code_points) {
-            auto glyph = font->glyph(code_point);
-            if (!glyph.has_value())
+        for (auto code_point : code_points) {
+            Gfx::IntRect rect;
+            auto const* page = page_for_glyph(*font, code_point, rect);
+            if (!page)
                 continue;
-            auto atlas_key = GlyphsTextureKey { font, code_point };
-            if (!m_glyphs_texture_map.contains(atlas_key))
-                need_to_rebuild_texture = true;
-            glyph_bitmaps.set(atlas_key, *glyph->bitmap());
-        }
-    }
+            used_pages.set(page->bitmap.ptr());
 
-    if (!need_to_rebuild_texture || glyph_bitmaps.is_empty())
-        return;
-
-    m_glyphs_texture_map.clear();
-
-    Vector<GlyphsTextureKey> glyphs_sorted_by_height;
-    glyphs_sorted_by_height.ensure_capacity(glyph_bitmaps.size());
-    for (auto const& [atlas_key, bitmap] : glyph_bitmaps) {
-        glyphs_sorted_by_height.append(atlas_key);
-    }
-    quick_sort(glyphs_sorted_by_height, [&](auto const& a, auto const& b) {
-        auto const* bitmap_a = *glyph_bitmaps.get(a);
-        auto const* bitmap_b = *glyph_bitmaps.get(b);
-        return bitmap_a->height() > bitmap_b->height();
-    });
+            auto& page_texture = m_page_textures.ensure(page->bitmap.ptr(), [&] {
+                return PageTexture { page->bitmap, 0, GL::create_texture() };
+            });
+            if (page_texture.version == page->version)
+                continue;
 
-    int current_x = 0;
-    int current_y = 0;
-    int row_height = 0;
-    int const texture_width = 512;
-    int const padding = 1;
-    for (auto const& glyphs_texture_key : glyphs_sorted_by_height) {
-        auto const* bitmap = *glyph_bitmaps.get(glyphs_texture_key);
-        if (current_x + bitmap->width() > texture_width) {
-            current_x = 0;
-            current_y += row_height + padding;
-            row_height = 0;
+            // NOTE: Glyphs are only ever added to a page, so anything drawn with an older version is still valid.
+            GL::upload_texture_data(page_texture.texture, *page->bitmap);
+            page_texture.version = page->version;
         }
-        m_glyphs_texture_map.set(glyphs_texture_key, { current_x, current_y, bitmap->width(), bitmap->height() });
-        current_x += bitmap->width() + padding;
-        row_height = max(row_height, bitmap->height());
     }
 
-    auto glyphs_texture_bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { texture_width, current_y + row_height }));
-    auto glyphs_texture_painter = Gfx::Painter(*glyphs_texture_bitmap);
-    for (auto const& [glyphs_texture_key, glyph_bitmap] : glyph_bitmaps) {
-        auto rect = m_glyphs_texture_map.get(glyphs_texture_key).value();
-        glyphs_texture_painter.blit({ rect.x(), rect.y() }, glyph_bitmap, glyph_bitmap->rect());
-    }
-
-    GL::upload_texture_data(m_texture, *glyphs_texture_bitmap);
+    m_page_textures.remove_all_matching([&](auto const& page, auto const& page_texture) {
+        if (used_pages.contains(page))
+            return false;
+        GL::delete_texture(page_texture.texture);
+        return true;
+    });
 }
 
-Optional<Gfx::IntRect> GlyphAtlas::get_glyph_rect(Gfx::Font const* font, u32 code_point) const
+Optional<GlyphAtlas::GlyphTexture> GlyphAtlas::get_glyph(Gfx::Font const* font, u32 code_point) const
 {
-    auto atlas_key = GlyphsTextureKey { font, code_point };
-    return m_glyphs_texture_map.get(atlas_key).copy();
+    Gfx::IntRect rect;
+    auto const* page = page_for_glyph(*font, code_point, rect);
+    if (!page)
+        return {};
+
+    auto it = m_page_textures.find(page->bitmap.ptr());
+    if (it == m_page_textures.end())
+        return {};
+    return GlyphTexture { it->value.texture, rect };
 }
 
 }
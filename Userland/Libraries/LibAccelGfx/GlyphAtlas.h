@@ -13,52 +13,34 @@
 
 namespace AccelGfx {
 
+// Mirrors the pages of each font's Gfx::GlyphAtlas as textures, so the glyphs are rasterized and packed only once
+// for both the CPU and the GPU painter.
 class GlyphAtlas {
     AK_MAKE_NONCOPYABLE(GlyphAtlas);
 
 public:
-    GlyphAtlas()
-        : m_texture(GL::create_texture())
-    {
-    }
-
-    ~GlyphAtlas()
-    {
-        GL::delete_texture(m_texture);
-    }
+    GlyphAtlas() = default;
+    ~GlyphAtlas();
 
     static GlyphAtlas& the();
 
-    struct GlyphsTextureKey {
-        Gfx::Font const* font;
-        u32 code_point;
-
-        bool operator==(GlyphsTextureKey const& other) const
-        {
-            return font == other.font && code_point == other.code_point;
-        }
-    };
-
     void update(HashMap<Gfx::Font const*, HashTable<u32>> const& unique_glyphs);
-    Optional<Gfx::IntRect> get_glyph_rect(Gfx::Font const*, u32 code_point) const;
 
-    GL::Texture const& texture() const { return m_texture; }
+    struct GlyphTexture {
+        GL::Texture const& texture;
+        Gfx::IntRect rect;
+    };
+    Optional<GlyphTexture> get_glyph(Gfx::Font const*, u32 code_point) const;
 
 private:
-    GL::Texture m_texture;
-    HashMap<GlyphsTextureKey, Gfx::IntRect> m_glyphs_texture_map;
-};
-
-}
-
-namespace AK {
+    struct PageTexture {
+        NonnullRefPtr<Gfx::Bitmap const> bitmap;
+        u32 version { 0 };
+        GL::Texture texture;
+    };
 
-template<>
-struct Traits<AccelGfx::GlyphAtlas::GlyphsTextureKey> : public DefaultTraits<AccelGfx::GlyphAtlas::GlyphsTextureKey> {
-    static unsigned hash(AccelGfx::GlyphAtlas::GlyphsTextureKey const& key)
-    {
-        return pair_int_hash(ptr_hash(key.font), key.code_point);
-    }
+    // NOTE: Each texture keeps its page alive, so a page can't be replaced by another one at the same address.
+    HashMap<Gfx::Bitmap const*, PageTexture> m_page_textures;
 };
 
 }
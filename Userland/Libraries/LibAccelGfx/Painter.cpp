@@ -187,6 +187,8 @@ static void set_blending_mode(Painter::BlendingMode blending_mode)
 
 HashMap<u32, GL::Texture> s_immutable_bitmap_texture_cache;
 
+static Painter* s_painter_with_batched_rects = nullptr;
+
 NonnullOwnPtr<Painter> Painter::create(Context& context, NonnullRefPtr<Canvas> canvas)
 {
     return make<Painter>(context, canvas);
@@ -208,6 +210,8 @@ Painter::Painter(Context& context, NonnullRefPtr<Canvas> canvas)
 
 Painter::~Painter()
 {
+    if (s_painter_with_batched_rects == this)
+        flush_batched_rects();
 }
 
 void Painter::clear(Gfx::Color color)
@@ -237,33 +241,87 @@ static Array<GLfloat, 8> rect_to_vertices(Gfx::FloatRect const& rect)
 
 void Painter::fill_rect(Gfx::FloatRect rect, Gfx::Color color)
 {
-    bind_target_canvas();
+    // NOTE: The rect is mapped through the current transform right away, so only a change of the clip rect or target
+    //       canvas requires the batch to be drawn.
+    if (s_painter_with_batched_rects != this) {
+        flush_batched_rects();
+        s_painter_with_batched_rects = this;
+    }
 
-    // Draw a filled rect (with `color`) using OpenGL after mapping it through the current transform.
+    auto rect_in_clip_space = to_clip_space(transform().map(rect));
 
-    auto vertices = rect_to_vertices(to_clip_space(transform().map(rect)));
+    // p0 --- p1
+    // | \     |
+    // |   \   |
+    // |     \ |
+    // p2 --- p3
 
-    auto vbo = GL::create_buffer();
-    GL::upload_to_buffer(vbo, vertices);
+    auto p0 = rect_in_clip_space.top_left();
+    auto p1 = rect_in_clip_space.top_right();
+    auto p2 = rect_in_clip_space.bottom_left();
+    auto p3 = rect_in_clip_space.bottom_right();
+
+    auto c = gfx_color_to_opengl_color(color);
+
+    auto add_vertex = [&](auto const& p) {
+        m_batched_rect_vertices.append(p.x());
+        m_batched_rect_vertices.append(p.y());
+        m_batched_rect_colors.append(c.red * c.alpha);
+        m_batched_rect_colors.append(c.green * c.alpha);
+        m_batched_rect_colors.append(c.blue * c.alpha);
+        m_batched_rect_colors.append(c.alpha);
+    };
+
+    add_vertex(p0);
+    add_vertex(p1);
+    add_vertex(p3);
+    add_vertex(p0);
+    add_vertex(p3);
+    add_vertex(p2);
+}
+
+void Painter::flush_batched_rects()
+{
+    if (auto* painter = exchange(s_painter_with_batched_rects, nullptr))
+        painter->draw_batched_rects();
+}
+
+void Painter::draw_batched_rects()
+{
+    if (m_batched_rect_vertices.is_empty())
+        return;
+
+    bind_target_canvas();
 
     auto vao = GL::create_vertex_array();
     GL::bind_vertex_array(vao);
-    GL::bind_buffer(vbo);
 
-    auto [red, green, blue, alpha] = gfx_color_to_opengl_color(color);
+    auto vbo_vertices = GL::create_buffer();
+    GL::upload_to_buffer(vbo_vertices, m_batched_rect_vertices);
 
-    m_rectangle_program.use();
+    auto vbo_colors = GL::create_buffer();
+    GL::upload_to_buffer(vbo_colors, m_batched_rect_colors);
 
-    auto position_attribute = m_rectangle_program.get_attribute_location("aVertexPosition");
-    auto color_uniform = m_rectangle_program.get_uniform_location("uColor");
+    // NOTE: The colors are premultiplied, so the per-vertex color program of linear gradients can draw them as is.
+    m_linear_gradient_program.use();
+    auto position_attribute = m_linear_gradient_program.get_attribute_location("aVertexPosition");
+    auto color_attribute = m_linear_gradient_program.get_attribute_location("aColor");
 
-    GL::set_uniform(color_uniform, red, green, blue, alpha);
+    GL::bind_buffer(vbo_vertices);
     GL::set_vertex_attribute(position_attribute, 0, 2);
-    GL::enable_blending(GL::BlendFactor::SrcAlpha, GL::BlendFactor::OneMinusSrcAlpha, GL::BlendFactor::One, GL::BlendFactor::One);
-    GL::draw_arrays(GL::DrawPrimitive::TriangleFan, 4);
 
-    GL::delete_buffer(vbo);
+    GL::bind_buffer(vbo_colors);
+    GL::set_vertex_attribute(color_attribute, 0, 4);
+
+    GL::enable_blending(GL::BlendFactor::One, GL::BlendFactor::OneMinusSrcAlpha, GL::BlendFactor::One, GL::BlendFactor::One);
+    GL::draw_arrays(GL::DrawPrimitive::Triangles, m_batched_rect_vertices.size() / 2);
+
+    GL::delete_buffer(vbo_vertices);
+    GL::delete_buffer(vbo_colors);
     GL::delete_vertex_array(vao);
+
+    m_batched_rect_vertices.clear_with_capacity();
+    m_batched_rect_colors.clear_with_capacity();
 }
 
 void Painter::fill_rect_with_rounded_corners(Gfx::IntRect const& rect, Color const& color, CornerRadius const& top_left_radius, CornerRadius const& top_right_radius, CornerRadius const& bottom_left_radius, CornerRadius const& bottom_right_radius, BlendingMode blending_mode)
@@ -411,8 +469,12 @@ void Painter::draw_glyph_run(Span<Gfx::DrawGlyphOrEmoji const> glyph_run, Gfx::F
 {
     bind_target_canvas();
 
-    Vector<GLfloat> vertices;
-    vertices.ensure_capacity(glyph_run.size() * 24);
+    // Glyphs can be spread over several pages of the font's glyph atlas, so they're drawn in one batch per page.
+    struct Batch {
+        GL::Texture const* texture;
+        Vector<GLfloat> vertices;
+    };
+    Vector<Batch, 1> batches;
 
     auto const& glyph_atlas = GlyphAtlas::the();
 
@@ -423,15 +485,28 @@ void Painter::draw_glyph_run(Span<Gfx::DrawGlyphOrEmoji const> glyph_run, Gfx::F
             auto code_point = glyph.code_point;
             auto point = glyph.position;
 
-            auto maybe_texture_rect = glyph_atlas.get_glyph_rect(&font, code_point);
-            if (!maybe_texture_rect.has_value()) {
+            auto maybe_glyph_texture = glyph_atlas.get_glyph(&font, code_point);
+            if (!maybe_glyph_texture.has_value()) {
                 continue;
             }
 
-            auto texture_rect = to_texture_space(maybe_texture_rect.value().to_type<float>(), *glyph_atlas.texture().size);
+            auto const& atlas_texture = maybe_glyph_texture->texture;
+            auto texture_rect = to_texture_space(maybe_glyph_texture->rect.to_type<float>(), *atlas_texture.size);
+
+            Batch* batch = nullptr;
+            for (auto& existing_batch : batches) {
+                if (existing_batch.texture == &atlas_texture)
+                    batch = &existing_batch;
+            }
+            if (!batch) {
+                batches.append({ &atlas_texture, {} });
+                batch = &batches.last();
+                batch->vertices.ensure_capacity(glyph_run.size() * 24);
+            }
+            auto& vertices = batch->vertices;
 
             auto glyph_position = point + Gfx::FloatPoint(font.glyph_left_bearing(code_point), 0);
-            auto glyph_size = maybe_texture_rect->size().to_type<float>();
+            auto glyph_size = maybe_glyph_texture->rect.size().to_type<float>();
             auto glyph_rect = transform().map(Gfx::FloatRect { glyph_position, glyph_size });
             auto rect_in_clip_space = to_clip_space(glyph_rect);
 
@@ -473,30 +548,32 @@ void Painter::draw_glyph_run(Span<Gfx::DrawGlyphOrEmoji const> glyph_run, Gfx::F
         }
     }
 
-    auto vbo = GL::create_buffer();
-    GL::upload_to_buffer(vbo, vertices);
-
-    auto vao = GL::create_vertex_array();
-    GL::bind_vertex_array(vao);
-    GL::bind_buffer(vbo);
-
     auto [red, green, blue, alpha] = gfx_color_to_opengl_color(color);
 
     m_blit_program.use();
 
-    GL::bind_texture(glyph_atlas.texture());
-    GL::set_texture_scale_mode(GL::ScalingMode::Nearest);
-
     auto position_attribute = m_blit_program.get_attribute_location("aVertexPosition");
     auto color_uniform = m_blit_program.get_uniform_location("uColor");
 
-    GL::set_uniform(color_uniform, red, green, blue, alpha);
-    GL::set_vertex_attribute(position_attribute, 0, 4);
-    GL::enable_blending(GL::BlendFactor::SrcAlpha, GL::BlendFactor::OneMinusSrcAlpha, GL::BlendFactor::One, GL::BlendFactor::One);
-    GL::draw_arrays(GL::DrawPrimitive::Triangles, vertices.size() / 4);
+    for (auto const& batch : batches) {
+        auto vbo = GL::create_buffer();
+        GL::upload_to_buffer(vbo, batch.vertices);
 
-    GL::delete_buffer(vbo);
-    GL::delete_vertex_array(vao);
+        auto vao = GL::create_vertex_array();
+        GL::bind_vertex_array(vao);
+        GL::bind_buffer(vbo);
+
+        GL::bind_texture(*batch.texture);
+        GL::set_texture_scale_mode(GL::ScalingMode::Nearest);
+
+        GL::set_uniform(color_uniform, red, green, blue, alpha);
+        GL::set_vertex_attribute(position_attribute, 0, 4);
+        GL::enable_blending(GL::BlendFactor::SrcAlpha, GL::BlendFactor::OneMinusSrcAlpha, GL::BlendFactor::One, GL::BlendFactor::One);
+        GL::draw_arrays(GL::DrawPrimitive::Triangles, batch.vertices.size() / 4);
+
+        GL::delete_buffer(vbo);
+        GL::delete_vertex_array(vao);
+    }
 }
 
 void Painter::fill_rect_with_linear_gradient(Gfx::IntRect const& rect, ReadonlySpan<Gfx::ColorStop> stops, float angle, Optional<float> repeat_length)
@@ -604,24 +681,28 @@ void Painter::save()
 
 void Painter::restore()
 {
+    flush_batched_rects();
     VERIFY(!m_state_stack.is_empty());
     m_state_stack.take_last();
 }
 
 void Painter::set_clip_rect(Gfx::IntRect rect)
 {
+    flush_batched_rects();
     state().clip_rect = transform().map(rect);
     GL::enable_scissor_test(transform().map(rect));
 }
 
 void Painter::clear_clip_rect()
 {
+    flush_batched_rects();
     state().clip_rect = { { 0, 0 }, m_target_canvas->size() };
     GL::disable_scissor_test();
 }
 
 void Painter::bind_target_canvas()
 {
+    flush_batched_rects();
     m_target_canvas->bind();
     GL::set_viewport({ 0, 0, m_target_canvas->size().width(), m_target_canvas->size().height() });
     GL::enable_scissor_test(state().clip_rect);
@@ -629,6 +710,7 @@ void Painter::bind_target_canvas()
 
 void Painter::flush(Gfx::Bitmap& bitmap)
 {
+    flush_batched_rects();
     m_target_canvas->bind();
     GL::read_pixels({ 0, 0, bitmap.width(), bitmap.height() }, bitmap);
 }
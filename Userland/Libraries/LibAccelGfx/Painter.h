@@ -110,6 +110,10 @@ private:
     [[nodiscard]] State& state() { return m_state_stack.last(); }
     [[nodiscard]] State const& state() const { return m_state_stack.last(); }
 
+    // Solid color rects are collected and drawn with a single draw call right before anything else touches GL state.
+    static void flush_batched_rects();
+    void draw_batched_rects();
+
     void blit_scaled_texture(Gfx::FloatRect const& dst_rect, GL::Texture const&, Gfx::FloatRect const& src_rect, ScalingMode, float opacity = 1.0f, Optional<Gfx::AffineTransform> affine_transform = {}, BlendingMode = BlendingMode::AlphaAdd);
     void blit_blurred_texture(Gfx::FloatRect const& dst_rect, GL::Texture const&, Gfx::FloatRect const& src_rect, int radius, BlurDirection direction, ScalingMode = ScalingMode::NearestNeighbor);
     void bind_target_canvas();
@@ -125,6 +129,9 @@ private:
     Program m_blit_program;
     Program m_linear_gradient_program;
     Program m_blur_program;
+
+    Vector<GLfloat> m_batched_rect_vertices;
+    Vector<GLfloat> m_batched_rect_colors;
 };
 
 }
@@ -8,6 +8,7 @@
 #include <LibArchive/Zip.h>
 #include <LibCompress/Deflate.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 namespace Archive {
 
@@ -125,6 +126,82 @@ ErrorOr<Statistics> Zip::calculate_statistics() const
     return Statistics(file_count, directory_count, uncompressed_bytes);
 }
 
+ErrorOr<Zip> Zip::map(StringView path)
+{
+    auto mapped_file = TRY(Core::MappedFile::map(path));
+    auto zip = try_create(mapped_file->bytes());
+    if (!zip.has_value())
+        return Error::from_string_literal("Invalid zip file");
+    zip->m_mapped_file = move(mapped_file);
+    return zip.release_value();
+}
+
+ErrorOr<Vector<ZipMember>> Zip::members() const
+{
+    Vector<ZipMember> members;
+    TRY(members.try_ensure_capacity(m_member_count));
+    TRY(for_each_member([&](auto const& member) -> ErrorOr<IterationDecision> {
+        members.unchecked_append(member);
+        return IterationDecision::Continue;
+    }));
+    return members;
+}
+
+ErrorOr<ReadonlyBytes> ZipMember::decompress(ByteBuffer& buffer) const
+{
+    VERIFY(!is_directory);
+
+    ReadonlyBytes contents;
+    switch (compression_method) {
+    case ZipCompressionMethod::Store:
+        contents = compressed_data;
+        break;
+    case ZipCompressionMethod::Deflate: {
+        // The uncompressed size is known up front, so the data can be decompressed in one go, straight into the buffer.
+        TRY(buffer.try_resize(uncompressed_size));
+        auto decompressed_size = TRY(Compress::DeflateDecompressor::decompress_into(compressed_data, buffer.bytes()));
+        contents = buffer.bytes().trim(decompressed_size);
+        break;
+    }
+    default:
+        VERIFY_NOT_REACHED();
+    }
+
+    if (contents.size() != uncompressed_size)
+        return Error::from_string_literal("Zip member has an unexpected size");
+
+    if (Crypto::Checksum::CRC32 { contents }.digest() != crc32)
+        return Error::from_string_literal("Zip member has a CRC32 mismatch");
+
+    return contents;
+}
+
+ErrorOr<void> Zip::decompress_members_in_parallel(ReadonlySpan<ZipMember> members, Function<ErrorOr<void>(ZipMember const&, ErrorOr<ReadonlyBytes>)> const& callback)
+{
+    struct MemberJob {
+        ZipMember const* member;
+        ErrorOr<void> result {};
+    };
+
+    Vector<MemberJob> jobs;
+    for (auto const& member : members) {
+        if (!member.is_directory)
+            TRY(jobs.try_append({ &member }));
+    }
+
+    // The members are independent of each other, so each one is a job of its own.
+    Threading::parallel_for(jobs.span(), 1, [&](Span<MemberJob> slice) {
+        ByteBuffer buffer;
+        for (auto& job : slice)
+            job.result = callback(*job.member, job.member->decompress(buffer));
+    });
+
+    for (auto& job : jobs)
+        TRY(move(job.result));
+
+    return {};
+}
+
 ZipOutputStream::ZipOutputStream(NonnullOwnPtr<Stream> stream)
     : m_stream(move(stream))
 {
@@ -173,7 +250,7 @@ ErrorOr<ZipOutputStream::MemberInformation> ZipOutputStream::add_member_from_str
         member.modification_time = to_packed_dos_time(modification_time->hour(), modification_time->minute(), modification_time->second());
     }
 
-    auto deflate_buffer = Compress::DeflateCompressor::compress_all(buffer);
+    auto deflate_buffer = Compress::DeflateCompressor::compress_all_in_parallel(buffer);
     auto compression_ratio = 1.f;
     auto compressed_size = buffer.size();
 
@@ -17,6 +17,7 @@
 #include <AK/Vector.h>
 #include <LibArchive/Statistics.h>
 #include <LibCore/DateTime.h>
+#include <LibCore/MappedFile.h>
 #include <string.h>
 
 namespace Archive {
@@ -263,14 +264,32 @@ struct ZipMember {
     DOSPackedTime modification_time;
     DOSPackedDate modification_date;
     Optional<mode_t> mode;
+
+    // Returns the uncompressed contents of a file member, after checking their CRC32. The contents of stored members
+    // are returned as they are in the archive data, without copying them. Other members are decompressed into the buffer.
+    ErrorOr<ReadonlyBytes> decompress(ByteBuffer& buffer) const;
 };
 
 class Zip {
 public:
     static Optional<Zip> try_create(ReadonlyBytes buffer);
+
+    // Maps the archive at the given path, which stays mapped for as long as the Zip exists. The compressed data of the
+    // members refers to the mapping, so they can be decompressed without reading the archive into memory first.
+    static ErrorOr<Zip> map(StringView path);
+
     ErrorOr<bool> for_each_member(Function<ErrorOr<IterationDecision>(ZipMember const&)>) const;
     ErrorOr<Statistics> calculate_statistics() const;
 
+    // Returns all members at once, so they can be accessed in any order.
+    ErrorOr<Vector<ZipMember>> members() const;
+
+    // Decompresses the file members on multiple threads, and calls the callback with the contents of each of them (or
+    // the error that decompressing it failed with) on the thread that decompressed it. The callback therefore has to be
+    // thread-safe, and the contents are only valid until it returns. Directory members are skipped. Returns the first
+    // error that the callback returned in the order of the members, after all of them have been processed.
+    static ErrorOr<void> decompress_members_in_parallel(ReadonlySpan<ZipMember>, Function<ErrorOr<void>(ZipMember const&, ErrorOr<ReadonlyBytes> contents)> const&);
+
 private:
     static bool find_end_of_central_directory_offset(ReadonlyBytes, size_t& offset);
 
@@ -283,6 +302,7 @@ private:
     u16 m_member_count { 0 };
     size_t m_members_start_offset { 0 };
     ReadonlyBytes m_input_data;
+    OwnPtr<Core::MappedFile> m_mapped_file;
 };
 
 class ZipOutputStream {
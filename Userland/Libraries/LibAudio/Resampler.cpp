@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <LibAudio/Resampler.h>
+
+namespace Audio {
+
+static_assert(sizeof(Sample) == 2 * sizeof(float));
+static_assert(SincResampler::tap_count % 4 == 0);
+
+// The input samples that come before the first output sample's position in the filter.
+static constexpr size_t history_size = SincResampler::tap_count / 2 - 1;
+
+static float sinc(float x)
+{
+    if (x == 0)
+        return 1;
+    return AK::sin(AK::Pi<float> * x) / (AK::Pi<float> * x);
+}
+
+static float blackman_window(float x, float half_width)
+{
+    if (AK::fabs(x) >= half_width)
+        return 0;
+    auto position = AK::Pi<float> * x / half_width;
+    return 0.42f + 0.5f * AK::cos(position) + 0.08f * AK::cos(2 * position);
+}
+
+SincResampler::SincResampler(u32 source, u32 target)
+    : m_source(source)
+    , m_target(target)
+{
+    VERIFY(source > 0);
+    VERIFY(target > 0);
+
+    // When downsampling, the cutoff has to move down to the new Nyquist frequency. It stays a bit below it, as the filter is
+    // too short to be very steep.
+    auto cutoff = 0.95f * min(1.0f, static_cast<float>(target) / static_cast<float>(source));
+    auto half_width = static_cast<float>(tap_count) / 2;
+
+    m_filters.resize(phase_count);
+    for (size_t phase = 0; phase < phase_count; ++phase) {
+        auto fraction = static_cast<float>(phase) / phase_count;
+        Array<float, tap_count> coefficients;
+        float sum = 0;
+        for (size_t tap = 0; tap < tap_count; ++tap) {
+            auto x = static_cast<float>(tap) - static_cast<float>(history_size) - fraction;
+            coefficients[tap] = cutoff * sinc(cutoff * x) * blackman_window(x, half_width);
+            sum += coefficients[tap];
+        }
+        // Normalize each phase separately, so that a constant signal stays exactly constant.
+        for (size_t tap = 0; tap < tap_count; ++tap) {
+            m_filters[phase][2 * tap] = coefficients[tap] / sum;
+            m_filters[phase][2 * tap + 1] = coefficients[tap] / sum;
+        }
+    }
+
+    reset();
+}
+
+void SincResampler::reset()
+{
+    m_input.clear_with_capacity();
+    m_input.resize(history_size);
+    m_position = 0;
+}
+
+static Sample apply_filter(Sample const* samples, SincResampler::Filter const& filter)
+{
+    using AK::SIMD::f32x4;
+
+    // The samples are interleaved, so each vector holds two samples of both channels.
+    auto const* input = reinterpret_cast<float const*>(samples);
+    f32x4 first_sums {};
+    f32x4 second_sums {};
+    for (size_t i = 0; i < filter.size(); i += 8) {
+        first_sums += AK::SIMD::load_unaligned<f32x4>(input + i) * AK::SIMD::load_unaligned<f32x4>(filter.data() + i);
+        second_sums += AK::SIMD::load_unaligned<f32x4>(input + i + 4) * AK::SIMD::load_unaligned<f32x4>(filter.data() + i + 4);
+    }
+    auto sums = first_sums + second_sums;
+    return { sums[0] + sums[2], sums[1] + sums[3] };
+}
+
+ErrorOr<void> SincResampler::try_resample_into_end(Vector<Sample>& destination, ReadonlySpan<Sample> to_resample)
+{
+    if (m_source == m_target) {
+        TRY(destination.try_extend(to_resample));
+        return {};
+    }
+
+    TRY(m_input.try_extend(to_resample));
+
+    auto available_output = (static_cast<u64>(m_input.size()) * m_target) / m_source + 1;
+    TRY(destination.try_ensure_capacity(destination.size() + available_output));
+
+    for (;;) {
+        auto index = m_position / m_target;
+        if (index + tap_count > m_input.size())
+            break;
+        auto phase = (m_position % m_target) * phase_count / m_target;
+        destination.unchecked_append(apply_filter(m_input.data() + index, m_filters[phase]));
+        m_position += m_source;
+    }
+
+    // Drop the input samples that no future output sample needs anymore.
+    auto consumed = min(m_position / m_target, static_cast<u64>(m_input.size()));
+    m_input.remove(0, consumed);
+    m_position -= consumed * m_target;
+    return {};
+}
+
+}
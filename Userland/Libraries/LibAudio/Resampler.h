@@ -6,9 +6,13 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Concepts.h>
+#include <AK/Error.h>
+#include <AK/Span.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
+#include <LibAudio/Sample.h>
 
 namespace Audio {
 
@@ -97,4 +101,35 @@ private:
     SampleType m_last_sample_r {};
 };
 
+// Band-limited resampling with a windowed sinc filter, which is split into phases so that each output sample only
+// costs one dot product of a fixed length. Unlike ResampleHelper, it keeps the last input samples around, so a stream
+// can be resampled one buffer at a time without clicks at the buffer boundaries.
+// The output is delayed by half the filter length.
+class SincResampler {
+public:
+    static constexpr size_t tap_count = 32;
+    static constexpr size_t phase_count = 128;
+
+    // Each coefficient is stored twice, once for each channel of the interleaved samples it is multiplied with.
+    using Filter = Array<float, tap_count * 2>;
+
+    SincResampler(u32 source, u32 target);
+
+    ErrorOr<void> try_resample_into_end(Vector<Sample>& destination, ReadonlySpan<Sample> to_resample);
+    void reset();
+
+    u32 source() const { return m_source; }
+    u32 target() const { return m_target; }
+
+private:
+    u32 const m_source;
+    u32 const m_target;
+
+    Vector<Filter> m_filters;
+    // The input samples that are still needed for future output samples.
+    Vector<Sample> m_input;
+    // The position of the next output sample in m_input, in units of 1/m_target input samples.
+    u64 m_position { 0 };
+};
+
 }
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <Kernel/API/ProcessPage.h>
+#include <sys/cdefs.h>
+
+__BEGIN_DECLS
+
+// Reads a consistent snapshot of the kernel's process page, mapping it on first use.
+// Returns false if the page can't be mapped, in which case the caller has to make the syscall instead.
+__attribute__((visibility("hidden"))) bool __read_process_page(Kernel::ProcessPageData*);
+
+__END_DECLS
@@ -131,6 +131,13 @@ int utimensat(int dirfd, char const* path, struct timespec const times[2], int f
     return __utimens(dirfd, path, times, flag);
 }
 
+ssize_t splice(int fd_in, off_t* offset_in, int fd_out, off_t* offset_out, size_t length, unsigned flags)
+{
+    Syscall::SC_splice_params params { fd_in, offset_in, fd_out, offset_out, length, flags };
+    ssize_t rc = syscall(SC_splice, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 int __utimens(int fd, char const* path, struct timespec const times[2], int flag)
 {
     size_t path_length = 0;
@@ -39,4 +39,7 @@ int posix_fallocate(int fd, off_t offset, off_t len);
 
 int utimensat(int dirfd, char const* path, struct timespec const times[2], int flag);
 
+// Unlike on Linux, neither end has to be a pipe.
+ssize_t splice(int fd_in, off_t* offset_in, int fd_out, off_t* offset_out, size_t length, unsigned flags);
+
 __END_DECLS
@@ -45,10 +45,15 @@ private:
 static pthread_mutex_t s_malloc_mutex = PTHREAD_MUTEX_INITIALIZER;
 bool __heap_is_stable = true;
 
-constexpr size_t number_of_hot_chunked_blocks_to_keep_around = 16;
-constexpr size_t number_of_cold_chunked_blocks_to_keep_around = 16;
+constexpr size_t max_number_of_hot_chunked_blocks_to_keep_around = 64;
+constexpr size_t max_number_of_cold_chunked_blocks_to_keep_around = 64;
 constexpr size_t number_of_big_blocks_to_keep_around_per_size_class = 8;
 
+// How many empty blocks are kept around for reuse, see __malloc_init().
+// Hot blocks stay mapped, cold blocks are made volatile so that the kernel can purge them when memory runs low.
+static size_t s_number_of_hot_chunked_blocks_to_keep_around = 16;
+static size_t s_number_of_cold_chunked_blocks_to_keep_around = 16;
+
 static bool s_log_malloc = false;
 static bool s_scrub_malloc = true;
 static bool s_scrub_free = true;
@@ -76,13 +81,23 @@ struct MallocStats {
     size_t number_of_hot_keeps;
     size_t number_of_cold_keeps;
     size_t number_of_frees;
+
+    size_t number_of_thread_cache_refills;
+    size_t number_of_thread_cache_flushes;
+
+    size_t number_of_big_allocations_resized_in_place;
+    size_t number_of_trimmed_blocks;
 };
 static MallocStats g_malloc_stats = {};
 
 static size_t s_hot_empty_block_count { 0 };
-static ChunkedBlock* s_hot_empty_blocks[number_of_hot_chunked_blocks_to_keep_around] { nullptr };
+static ChunkedBlock* s_hot_empty_blocks[max_number_of_hot_chunked_blocks_to_keep_around] { nullptr };
 static size_t s_cold_empty_block_count { 0 };
-static ChunkedBlock* s_cold_empty_blocks[number_of_cold_chunked_blocks_to_keep_around] { nullptr };
+static ChunkedBlock* s_cold_empty_blocks[max_number_of_cold_chunked_blocks_to_keep_around] { nullptr };
+
+// Big allocations that are currently handed out, and the memory they take up.
+static size_t s_big_allocation_count { 0 };
+static size_t s_big_allocation_bytes { 0 };
 
 struct Allocator {
     size_t size { 0 };
@@ -114,6 +129,26 @@ static inline BigAllocator (&big_allocators())[1]
     return reinterpret_cast<BigAllocator(&)[1]>(g_big_allocators_storage);
 }
 
+#ifndef NO_TLS
+// Every thread keeps some free chunks of each size class around, so that most calls to malloc() and free() don't
+// have to take s_malloc_mutex. They are taken from and given back to the shared allocators in batches.
+// Chunks in a thread cache still count as used in their ChunkedBlock, so the block can't go away while they are cached.
+// Any thread may cache a chunk that another thread allocated, since the blocks themselves aren't owned by a thread.
+struct ThreadCacheBin {
+    FreelistEntry* head { nullptr };
+    size_t count { 0 };
+};
+
+static __thread ThreadCacheBin s_thread_cache[num_size_classes];
+// Set once the cache of an exiting thread has been given back, so that later frees of the thread don't fill it again.
+static __thread bool s_thread_cache_disabled = false;
+
+static constexpr size_t thread_cache_capacity(size_t size_class_index)
+{
+    return clamp(64 * KiB / size_classes[size_class_index], 2, 32);
+}
+#endif
+
 // --- BEGIN MATH ---
 // This stuff is only used for checking if there exists an aligned block in a
 // chunk. It has no bearing on the rest of the allocator, especially for
@@ -247,6 +282,169 @@ enum class CallerWillInitializeMemory {
 __thread bool __allocation_enabled = true;
 #endif
 
+// s_malloc_mutex has to be held.
+static ErrorOr<void*> allocate_chunk(Allocator& allocator, size_t good_size, size_t align)
+{
+    ChunkedBlock* block = nullptr;
+    void* ptr = nullptr;
+    for (auto& current : allocator.usable_blocks) {
+        if (current.free_chunks()) {
+            ptr = try_allocate_chunk_aligned(align, current);
+            if (ptr) {
+                block = &current;
+                break;
+            }
+        }
+    }
+
+    if (!block && s_hot_empty_block_count) {
+        g_malloc_stats.number_of_hot_empty_block_hits++;
+        block = s_hot_empty_blocks[--s_hot_empty_block_count];
+        if (block->m_size != good_size) {
+            new (block) ChunkedBlock(good_size);
+            char buffer[64];
+            snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
+            set_mmap_name(block, ChunkedBlock::block_size, buffer);
+        }
+        allocator.usable_blocks.append(*block);
+    }
+
+    if (!block && s_cold_empty_block_count) {
+        g_malloc_stats.number_of_cold_empty_block_hits++;
+        block = s_cold_empty_blocks[--s_cold_empty_block_count];
+        int rc = madvise(block, ChunkedBlock::block_size, MADV_SET_NONVOLATILE);
+        bool this_block_was_purged = rc == 1;
+        if (rc < 0) {
+            perror("madvise");
+            VERIFY_NOT_REACHED();
+        }
+        rc = mprotect(block, ChunkedBlock::block_size, PROT_READ | PROT_WRITE);
+        if (rc < 0) {
+            perror("mprotect");
+            VERIFY_NOT_REACHED();
+        }
+        if (this_block_was_purged || block->m_size != good_size) {
+            if (this_block_was_purged)
+                g_malloc_stats.number_of_cold_empty_block_purge_hits++;
+            new (block) ChunkedBlock(good_size);
+        }
+        allocator.usable_blocks.append(*block);
+    }
+
+    if (!block) {
+        g_malloc_stats.number_of_block_allocs++;
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
+        block = (ChunkedBlock*)TRY(os_alloc(ChunkedBlock::block_size, buffer));
+        new (block) ChunkedBlock(good_size);
+        allocator.usable_blocks.append(*block);
+        ++allocator.block_count;
+    }
+
+    if (!ptr) {
+        ptr = try_allocate_chunk_aligned(align, *block);
+    }
+
+    VERIFY(ptr);
+    if (block->is_full()) {
+        g_malloc_stats.number_of_blocks_full++;
+        dbgln_if(MALLOC_DEBUG, "Block {:p} is now full in size class {}", block, good_size);
+        allocator.usable_blocks.remove(*block);
+        allocator.full_blocks.append(*block);
+    }
+    dbgln_if(MALLOC_DEBUG, "LibC: allocated {:p} (chunk in block {:p}, size {})", ptr, block, block->bytes_per_chunk());
+
+    return ptr;
+}
+
+// s_malloc_mutex has to be held.
+static void free_chunk(ChunkedBlock* block, void* ptr)
+{
+    dbgln_if(MALLOC_DEBUG, "LibC: freeing {:p} in allocator {:p} (size={}, used={})", ptr, block, block->bytes_per_chunk(), block->used_chunks());
+
+    auto* entry = (FreelistEntry*)ptr;
+    entry->next = block->m_freelist;
+    block->m_freelist = entry;
+
+    if (block->is_full()) {
+        size_t good_size;
+        auto* allocator = allocator_for_size(block->m_size, good_size);
+        dbgln_if(MALLOC_DEBUG, "Block {:p} no longer full in size class {}", block, good_size);
+        g_malloc_stats.number_of_freed_full_blocks++;
+        allocator->full_blocks.remove(*block);
+        allocator->usable_blocks.prepend(*block);
+    }
+
+    ++block->m_free_chunks;
+
+    if (!block->used_chunks()) {
+        size_t good_size;
+        auto* allocator = allocator_for_size(block->m_size, good_size);
+        if (s_hot_empty_block_count < s_number_of_hot_chunked_blocks_to_keep_around) {
+            dbgln_if(MALLOC_DEBUG, "Keeping hot block {:p} around", block);
+            g_malloc_stats.number_of_hot_keeps++;
+            allocator->usable_blocks.remove(*block);
+            s_hot_empty_blocks[s_hot_empty_block_count++] = block;
+            return;
+        }
+        if (s_cold_empty_block_count < s_number_of_cold_chunked_blocks_to_keep_around) {
+            dbgln_if(MALLOC_DEBUG, "Keeping cold block {:p} around", block);
+            g_malloc_stats.number_of_cold_keeps++;
+            allocator->usable_blocks.remove(*block);
+            s_cold_empty_blocks[s_cold_empty_block_count++] = block;
+            mprotect(block, ChunkedBlock::block_size, PROT_NONE);
+            madvise(block, ChunkedBlock::block_size, MADV_SET_VOLATILE);
+            return;
+        }
+        dbgln_if(MALLOC_DEBUG, "Releasing block {:p} for size class {}", block, good_size);
+        g_malloc_stats.number_of_frees++;
+        allocator->usable_blocks.remove(*block);
+        --allocator->block_count;
+        os_free(block, ChunkedBlock::block_size);
+    }
+}
+
+#ifndef NO_TLS
+static size_t size_class_index(Allocator const& allocator)
+{
+    return &allocator - allocators();
+}
+
+// s_malloc_mutex must not be held.
+static ErrorOr<void> refill_thread_cache(Allocator& allocator, size_t size_class_index, ThreadCacheBin& bin)
+{
+    PthreadMutexLocker locker(s_malloc_mutex);
+    g_malloc_stats.number_of_thread_cache_refills++;
+
+    auto batch_size = thread_cache_capacity(size_class_index) / 2;
+    for (size_t i = 0; i < batch_size; ++i) {
+        auto ptr_or_error = allocate_chunk(allocator, allocator.size, 16);
+        if (ptr_or_error.is_error()) {
+            // Make do with what we got so far.
+            if (i == 0)
+                return ptr_or_error.release_error();
+            break;
+        }
+        auto* entry = (FreelistEntry*)ptr_or_error.value();
+        entry->next = bin.head;
+        bin.head = entry;
+        ++bin.count;
+    }
+    return {};
+}
+
+// s_malloc_mutex has to be held.
+static void flush_thread_cache_bin(ThreadCacheBin& bin, size_t count)
+{
+    for (; count > 0 && bin.head; --count) {
+        auto* entry = bin.head;
+        bin.head = entry->next;
+        --bin.count;
+        free_chunk((ChunkedBlock*)((FlatPtr)entry & ChunkedBlock::block_mask), entry);
+    }
+}
+#endif
+
 static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializeMemory caller_will_initialize_memory)
 {
 #ifndef NO_TLS
@@ -275,6 +473,24 @@ static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializ
     size_t good_size;
     auto* allocator = allocator_for_size(size, good_size, align);
 
+#ifndef NO_TLS
+    // Every chunk is 16-byte aligned, so only larger alignments have to look for a suitable chunk in the blocks.
+    if (allocator && align <= 16 && !s_thread_cache_disabled) {
+        auto index = size_class_index(*allocator);
+        auto& bin = s_thread_cache[index];
+        if (!bin.head)
+            TRY(refill_thread_cache(*allocator, index, bin));
+
+        auto* entry = bin.head;
+        bin.head = entry->next;
+        --bin.count;
+
+        if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
+            memset(entry, MALLOC_SCRUB_BYTE, good_size);
+        return entry;
+    }
+#endif
+
     PthreadMutexLocker locker(s_malloc_mutex);
 
     if (!allocator) {
@@ -302,6 +518,8 @@ static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializ
                     g_malloc_stats.number_of_big_allocator_purge_hits++;
                     new (block) BigAllocationBlock(real_size);
                 }
+                ++s_big_allocation_count;
+                s_big_allocation_bytes += real_size;
 
                 return reinterpret_cast<void*>(round_up_to_power_of_two(reinterpret_cast<uintptr_t>(&block->m_slot[0]), align));
             }
@@ -310,81 +528,15 @@ static ErrorOr<void*> malloc_impl(size_t size, size_t align, CallerWillInitializ
         auto* block = (BigAllocationBlock*)TRY(os_alloc(real_size, "malloc: BigAllocationBlock"));
         g_malloc_stats.number_of_big_allocs++;
         new (block) BigAllocationBlock(real_size);
+        ++s_big_allocation_count;
+        s_big_allocation_bytes += real_size;
 
         return reinterpret_cast<void*>(round_up_to_power_of_two(reinterpret_cast<uintptr_t>(&block->m_slot[0]), align));
     }
 
-    ChunkedBlock* block = nullptr;
-    void* ptr = nullptr;
-    for (auto& current : allocator->usable_blocks) {
-        if (current.free_chunks()) {
-            ptr = try_allocate_chunk_aligned(align, current);
-            if (ptr) {
-                block = &current;
-                break;
-            }
-        }
-    }
-
-    if (!block && s_hot_empty_block_count) {
-        g_malloc_stats.number_of_hot_empty_block_hits++;
-        block = s_hot_empty_blocks[--s_hot_empty_block_count];
-        if (block->m_size != good_size) {
-            new (block) ChunkedBlock(good_size);
-            char buffer[64];
-            snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
-            set_mmap_name(block, ChunkedBlock::block_size, buffer);
-        }
-        allocator->usable_blocks.append(*block);
-    }
-
-    if (!block && s_cold_empty_block_count) {
-        g_malloc_stats.number_of_cold_empty_block_hits++;
-        block = s_cold_empty_blocks[--s_cold_empty_block_count];
-        int rc = madvise(block, ChunkedBlock::block_size, MADV_SET_NONVOLATILE);
-        bool this_block_was_purged = rc == 1;
-        if (rc < 0) {
-            perror("madvise");
-            VERIFY_NOT_REACHED();
-        }
-        rc = mprotect(block, ChunkedBlock::block_size, PROT_READ | PROT_WRITE);
-        if (rc < 0) {
-            perror("mprotect");
-            VERIFY_NOT_REACHED();
-        }
-        if (this_block_was_purged || block->m_size != good_size) {
-            if (this_block_was_purged)
-                g_malloc_stats.number_of_cold_empty_block_purge_hits++;
-            new (block) ChunkedBlock(good_size);
-        }
-        allocator->usable_blocks.append(*block);
-    }
-
-    if (!block) {
-        g_malloc_stats.number_of_block_allocs++;
-        char buffer[64];
-        snprintf(buffer, sizeof(buffer), "malloc: ChunkedBlock(%zu)", good_size);
-        block = (ChunkedBlock*)TRY(os_alloc(ChunkedBlock::block_size, buffer));
-        new (block) ChunkedBlock(good_size);
-        allocator->usable_blocks.append(*block);
-        ++allocator->block_count;
-    }
-
-    if (!ptr) {
-        ptr = try_allocate_chunk_aligned(align, *block);
-    }
-
-    VERIFY(ptr);
-    if (block->is_full()) {
-        g_malloc_stats.number_of_blocks_full++;
-        dbgln_if(MALLOC_DEBUG, "Block {:p} is now full in size class {}", block, good_size);
-        allocator->usable_blocks.remove(*block);
-        allocator->full_blocks.append(*block);
-    }
-    dbgln_if(MALLOC_DEBUG, "LibC: allocated {:p} (chunk in block {:p}, size {})", ptr, block, block->bytes_per_chunk());
-
+    auto* ptr = TRY(allocate_chunk(*allocator, good_size, align));
     if (s_scrub_malloc && caller_will_initialize_memory == CallerWillInitializeMemory::No)
-        memset(ptr, MALLOC_SCRUB_BYTE, block->m_size);
+        memset(ptr, MALLOC_SCRUB_BYTE, good_size);
 
     return ptr;
 }
@@ -405,10 +557,34 @@ static void free_impl(void* ptr)
     void* block_base = (void*)((FlatPtr)ptr & ChunkedBlock::ChunkedBlock::block_mask);
     size_t magic = *(size_t*)block_base;
 
+    if (magic == MAGIC_PAGE_HEADER && s_scrub_free)
+        memset(ptr, FREE_SCRUB_BYTE, ((ChunkedBlock*)block_base)->bytes_per_chunk());
+
+#ifndef NO_TLS
+    if (magic == MAGIC_PAGE_HEADER && !s_thread_cache_disabled) {
+        size_t good_size;
+        auto index = size_class_index(*allocator_for_size(((ChunkedBlock*)block_base)->m_size, good_size));
+        auto& bin = s_thread_cache[index];
+        if (bin.count >= thread_cache_capacity(index)) {
+            PthreadMutexLocker locker(s_malloc_mutex);
+            g_malloc_stats.number_of_thread_cache_flushes++;
+            flush_thread_cache_bin(bin, bin.count / 2);
+        }
+
+        auto* entry = (FreelistEntry*)ptr;
+        entry->next = bin.head;
+        bin.head = entry;
+        ++bin.count;
+        return;
+    }
+#endif
+
     PthreadMutexLocker locker(s_malloc_mutex);
 
     if (magic == MAGIC_BIGALLOC_HEADER) {
         auto* block = (BigAllocationBlock*)block_base;
+        --s_big_allocation_count;
+        s_big_allocation_bytes -= block->m_size;
 #ifdef RECYCLE_BIG_ALLOCATIONS
         if (auto* allocator = big_allocator_for_size(block->m_size)) {
             if (allocator->blocks.size() < number_of_big_blocks_to_keep_around_per_size_class) {
@@ -433,53 +609,37 @@ static void free_impl(void* ptr)
     }
 
     VERIFY(magic == MAGIC_PAGE_HEADER);
-    auto* block = (ChunkedBlock*)block_base;
-
-    dbgln_if(MALLOC_DEBUG, "LibC: freeing {:p} in allocator {:p} (size={}, used={})", ptr, block, block->bytes_per_chunk(), block->used_chunks());
+    free_chunk((ChunkedBlock*)block_base, ptr);
+}
 
-    if (s_scrub_free)
-        memset(ptr, FREE_SCRUB_BYTE, block->bytes_per_chunk());
+// Grows or shrinks a big allocation without moving it, by mapping more memory right after it or by unmapping its tail.
+// s_malloc_mutex has to be held.
+static bool try_resize_big_allocation_in_place(BigAllocationBlock* block, void* ptr, size_t size)
+{
+    auto offset_in_block = (FlatPtr)ptr - (FlatPtr)block;
+    if (size > NumericLimits<size_t>::max() - offset_in_block - ChunkedBlock::block_size)
+        return false;
+    size_t new_real_size = round_up_to_power_of_two(offset_in_block + size, ChunkedBlock::block_size);
+    size_t old_real_size = block->m_size;
 
-    auto* entry = (FreelistEntry*)ptr;
-    entry->next = block->m_freelist;
-    block->m_freelist = entry;
+    if (new_real_size == old_real_size)
+        return true;
 
-    if (block->is_full()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-        dbgln_if(MALLOC_DEBUG, "Block {:p} no longer full in size class {}", block, good_size);
-        g_malloc_stats.number_of_freed_full_blocks++;
-        allocator->full_blocks.remove(*block);
-        allocator->usable_blocks.prepend(*block);
+    if (new_real_size < old_real_size) {
+        os_free((u8*)block + new_real_size, old_real_size - new_real_size);
+    } else {
+        auto* extension_address = (u8*)block + old_real_size;
+        int flags = MAP_ANONYMOUS | MAP_PRIVATE | MAP_PURGEABLE | MAP_FIXED_NOREPLACE;
+        auto* extension = serenity_mmap(extension_address, new_real_size - old_real_size, PROT_READ | PROT_WRITE, flags, 0, 0, ChunkedBlock::block_size, "malloc: BigAllocationBlock");
+        if (extension == MAP_FAILED)
+            return false;
+        VERIFY(extension == extension_address);
     }
 
-    ++block->m_free_chunks;
-
-    if (!block->used_chunks()) {
-        size_t good_size;
-        auto* allocator = allocator_for_size(block->m_size, good_size);
-        if (s_hot_empty_block_count < number_of_hot_chunked_blocks_to_keep_around) {
-            dbgln_if(MALLOC_DEBUG, "Keeping hot block {:p} around", block);
-            g_malloc_stats.number_of_hot_keeps++;
-            allocator->usable_blocks.remove(*block);
-            s_hot_empty_blocks[s_hot_empty_block_count++] = block;
-            return;
-        }
-        if (s_cold_empty_block_count < number_of_cold_chunked_blocks_to_keep_around) {
-            dbgln_if(MALLOC_DEBUG, "Keeping cold block {:p} around", block);
-            g_malloc_stats.number_of_cold_keeps++;
-            allocator->usable_blocks.remove(*block);
-            s_cold_empty_blocks[s_cold_empty_block_count++] = block;
-            mprotect(block, ChunkedBlock::block_size, PROT_NONE);
-            madvise(block, ChunkedBlock::block_size, MADV_SET_VOLATILE);
-            return;
-        }
-        dbgln_if(MALLOC_DEBUG, "Releasing block {:p} for size class {}", block, good_size);
-        g_malloc_stats.number_of_frees++;
-        allocator->usable_blocks.remove(*block);
-        --allocator->block_count;
-        os_free(block, ChunkedBlock::block_size);
-    }
+    g_malloc_stats.number_of_big_allocations_resized_in_place++;
+    s_big_allocation_bytes = s_big_allocation_bytes - old_real_size + new_real_size;
+    block->m_size = new_real_size;
+    return true;
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/malloc.html
@@ -581,6 +741,22 @@ void* realloc(void* ptr, size_t size)
 
     auto existing_allocation_size = malloc_size(ptr);
 
+    void* block_base = (void*)((FlatPtr)ptr & ChunkedBlock::block_mask);
+    if (((CommonHeader const*)block_base)->m_magic == MAGIC_BIGALLOC_HEADER) {
+        bool was_resized;
+        {
+            PthreadMutexLocker locker(s_malloc_mutex);
+            was_resized = try_resize_big_allocation_in_place((BigAllocationBlock*)block_base, ptr, size);
+        }
+        if (was_resized) {
+            if (s_profiling) {
+                perf_event(PERF_EVENT_FREE, reinterpret_cast<FlatPtr>(ptr), 0);
+                perf_event(PERF_EVENT_MALLOC, size, reinterpret_cast<FlatPtr>(ptr));
+            }
+            return ptr;
+        }
+    }
+
     if (size <= existing_allocation_size) {
         return ptr;
     }
@@ -602,6 +778,10 @@ void __malloc_init()
         s_log_malloc = true;
     if (secure_getenv("LIBC_PROFILE_MALLOC"))
         s_profiling = true;
+    if (auto* value = secure_getenv("LIBC_MALLOC_HOT_BLOCKS"))
+        s_number_of_hot_chunked_blocks_to_keep_around = min(strtoul(value, nullptr, 10), max_number_of_hot_chunked_blocks_to_keep_around);
+    if (auto* value = secure_getenv("LIBC_MALLOC_COLD_BLOCKS"))
+        s_number_of_cold_chunked_blocks_to_keep_around = min(strtoul(value, nullptr, 10), max_number_of_cold_chunked_blocks_to_keep_around);
 
     for (size_t i = 0; i < num_size_classes; ++i) {
         new (&allocators()[i]) Allocator();
@@ -611,6 +791,72 @@ void __malloc_init()
     new (&big_allocators()[0])(BigAllocator);
 }
 
+void __malloc_destroy_thread_cache()
+{
+#ifndef NO_TLS
+    PthreadMutexLocker locker(s_malloc_mutex);
+    for (auto& bin : s_thread_cache)
+        flush_thread_cache_bin(bin, bin.count);
+    s_thread_cache_disabled = true;
+#endif
+}
+
+int malloc_trim(size_t)
+{
+    PthreadMutexLocker locker(s_malloc_mutex);
+#ifndef NO_TLS
+    // Chunks in the cache of this thread might be all that keeps their blocks from being empty.
+    for (auto& bin : s_thread_cache)
+        flush_thread_cache_bin(bin, bin.count);
+#endif
+
+    size_t released_block_count = 0;
+    while (s_hot_empty_block_count) {
+        os_free(s_hot_empty_blocks[--s_hot_empty_block_count], ChunkedBlock::block_size);
+        ++released_block_count;
+    }
+    while (s_cold_empty_block_count) {
+        os_free(s_cold_empty_blocks[--s_cold_empty_block_count], ChunkedBlock::block_size);
+        ++released_block_count;
+    }
+#ifdef RECYCLE_BIG_ALLOCATIONS
+    for (auto& allocator : big_allocators()) {
+        for (auto* block : allocator.blocks) {
+            os_free(block, block->m_size);
+            ++released_block_count;
+        }
+        allocator.blocks.clear();
+    }
+#endif
+    g_malloc_stats.number_of_trimmed_blocks += released_block_count;
+    return released_block_count > 0;
+}
+
+void serenity_get_malloc_statistics(struct serenity_malloc_statistics* statistics)
+{
+    PthreadMutexLocker locker(s_malloc_mutex);
+    *statistics = {};
+    for (auto& allocator : allocators()) {
+        auto account = [&](ChunkedBlock& block) {
+            ++statistics->chunked_block_count;
+            statistics->chunked_bytes_in_use += block.used_chunks() * block.bytes_per_chunk();
+            statistics->chunked_bytes_free += block.free_chunks() * block.bytes_per_chunk();
+        };
+        for (auto& block : allocator.usable_blocks)
+            account(block);
+        for (auto& block : allocator.full_blocks)
+            account(block);
+    }
+    statistics->hot_empty_block_count = s_hot_empty_block_count;
+    statistics->cold_empty_block_count = s_cold_empty_block_count;
+    statistics->big_allocation_count = s_big_allocation_count;
+    statistics->big_allocation_bytes = s_big_allocation_bytes;
+#ifdef RECYCLE_BIG_ALLOCATIONS
+    for (auto& allocator : big_allocators())
+        statistics->recycled_big_block_count += allocator.blocks.size();
+#endif
+}
+
 void serenity_dump_malloc_stats()
 {
     dbgln("# malloc() calls: {}", g_malloc_stats.number_of_malloc_calls);
@@ -634,5 +880,11 @@ void serenity_dump_malloc_stats()
     dbgln("number of hot keeps: {}", g_malloc_stats.number_of_hot_keeps);
     dbgln("number of cold keeps: {}", g_malloc_stats.number_of_cold_keeps);
     dbgln("number of frees: {}", g_malloc_stats.number_of_frees);
+    dbgln();
+    dbgln("thread cache refills: {}", g_malloc_stats.number_of_thread_cache_refills);
+    dbgln("thread cache flushes: {}", g_malloc_stats.number_of_thread_cache_flushes);
+    dbgln();
+    dbgln("big allocations resized in place: {}", g_malloc_stats.number_of_big_allocations_resized_in_place);
+    dbgln("blocks released by malloc_trim(): {}", g_malloc_stats.number_of_trimmed_blocks);
 }
 }
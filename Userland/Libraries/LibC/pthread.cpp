@@ -21,6 +21,7 @@
 #include <signal.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/internals.h>
 #include <sys/mman.h>
 #include <sys/prctl.h>
 #include <syscall.h>
@@ -61,6 +62,7 @@ extern "C" {
 [[noreturn]] static void exit_thread(void* code, void* stack_location, size_t stack_size)
 {
     __pthread_key_destroy_for_current_thread();
+    __malloc_destroy_thread_cache();
     MUST(__free_tls_region(bit_cast<FlatPtr>(__builtin_thread_pointer())));
     syscall(SC_exit_thread, code, stack_location, stack_size);
     VERIFY_NOT_REACHED();
@@ -249,6 +251,7 @@ int pthread_mutex_destroy(pthread_mutex_t*)
 int pthread_mutexattr_init(pthread_mutexattr_t* attr)
 {
     attr->type = PTHREAD_MUTEX_NORMAL;
+    attr->protocol = PTHREAD_PRIO_NONE;
     return 0;
 }
 
@@ -275,6 +278,25 @@ int pthread_mutexattr_gettype(pthread_mutexattr_t* attr, int* type)
     return 0;
 }
 
+// https://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_mutexattr_setprotocol.html
+int pthread_mutexattr_setprotocol(pthread_mutexattr_t* attr, int protocol)
+{
+    if (!attr)
+        return EINVAL;
+    // FIXME: Implement PTHREAD_PRIO_PROTECT.
+    if (protocol != PTHREAD_PRIO_NONE && protocol != PTHREAD_PRIO_INHERIT)
+        return ENOTSUP;
+    attr->protocol = protocol;
+    return 0;
+}
+
+// https://pubs.opengroup.org/onlinepubs/9699919799/functions/pthread_mutexattr_getprotocol.html
+int pthread_mutexattr_getprotocol(pthread_mutexattr_t const* attr, int* protocol)
+{
+    *protocol = attr->protocol;
+    return 0;
+}
+
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_attr_init.html
 int pthread_attr_init(pthread_attr_t* attributes)
 {
@@ -509,27 +531,32 @@ int pthread_attr_setscope([[maybe_unused]] pthread_attr_t* attributes, [[maybe_u
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_getschedparam.html
-int pthread_getschedparam(pthread_t thread, [[maybe_unused]] int* policy, struct sched_param* param)
+int pthread_getschedparam(pthread_t thread, int* policy, struct sched_param* param)
 {
     Syscall::SC_scheduler_parameters_params parameters {
         .pid_or_tid = thread,
         .mode = Syscall::SchedulerParametersMode::Thread,
         .parameters = *param,
+        .policy = -1,
     };
     int rc = syscall(Syscall::SC_scheduler_get_parameters, &parameters);
-    if (rc == 0)
+    if (rc == 0) {
         *param = parameters.parameters;
+        if (policy)
+            *policy = parameters.policy;
+    }
 
     __RETURN_PTHREAD_ERROR(rc);
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_setschedparam.html
-int pthread_setschedparam(pthread_t thread, [[maybe_unused]] int policy, struct sched_param const* param)
+int pthread_setschedparam(pthread_t thread, int policy, struct sched_param const* param)
 {
     Syscall::SC_scheduler_parameters_params parameters {
         .pid_or_tid = thread,
         .mode = Syscall::SchedulerParametersMode::Thread,
         .parameters = *param,
+        .policy = policy,
     };
     int rc = syscall(Syscall::SC_scheduler_set_parameters, &parameters);
     __RETURN_PTHREAD_ERROR(rc);
@@ -97,6 +97,70 @@ static constexpr u32 MUTEX_UNLOCKED = 0;
 static constexpr u32 MUTEX_LOCKED_NO_NEED_TO_WAKE = 1;
 static constexpr u32 MUTEX_LOCKED_NEED_TO_WAKE = 2;
 
+// Priority-inheriting mutexes store the thread ID of their owner in the lock word instead, which lets
+// the kernel boost the owner while others wait. Whenever the kernel is involved in handing them over,
+// it sets FUTEX_WAITERS, so that the owner has to go through the kernel to unlock them again.
+static int priority_inheriting_mutex_trylock(pthread_mutex_t* mutex)
+{
+    u32 tid = gettid();
+    u32 expected = MUTEX_UNLOCKED;
+    if (AK::atomic_compare_exchange_strong(&mutex->lock, expected, tid, AK::memory_order_acquire)) [[likely]] {
+        mutex->level = 0;
+        return 0;
+    }
+    if ((expected & FUTEX_TID_MASK) == tid) {
+        if (mutex->type != __PTHREAD_MUTEX_RECURSIVE)
+            return EBUSY;
+        // We already own the mutex!
+        mutex->level++;
+        return 0;
+    }
+    // The mutex may be unowned but still marked as having waiters, in which case only the kernel can take it.
+    if (futex(&mutex->lock, FUTEX_TRYLOCK_PI | FUTEX_PRIVATE_FLAG, 0, nullptr, nullptr, 0) < 0)
+        return EBUSY;
+    mutex->level = 0;
+    return 0;
+}
+
+static int priority_inheriting_mutex_lock(pthread_mutex_t* mutex)
+{
+    u32 tid = gettid();
+    u32 expected = MUTEX_UNLOCKED;
+    if (AK::atomic_compare_exchange_strong(&mutex->lock, expected, tid, AK::memory_order_acquire)) [[likely]] {
+        mutex->level = 0;
+        return 0;
+    }
+    if ((expected & FUTEX_TID_MASK) == tid && mutex->type == __PTHREAD_MUTEX_RECURSIVE) {
+        // We already own the mutex!
+        mutex->level++;
+        return 0;
+    }
+
+    while (futex(&mutex->lock, FUTEX_LOCK_PI | FUTEX_PRIVATE_FLAG, 0, nullptr, nullptr, 0) < 0) {
+        if (errno != EINTR)
+            return errno;
+    }
+    mutex->level = 0;
+    return 0;
+}
+
+static int priority_inheriting_mutex_unlock(pthread_mutex_t* mutex)
+{
+    if (mutex->type == __PTHREAD_MUTEX_RECURSIVE && mutex->level > 0) {
+        mutex->level--;
+        return 0;
+    }
+
+    u32 expected = gettid();
+    if (AK::atomic_compare_exchange_strong(&mutex->lock, expected, MUTEX_UNLOCKED, AK::memory_order_release)) [[likely]]
+        return 0;
+
+    // Someone is waiting for the mutex, so let the kernel wake them up.
+    if (futex(&mutex->lock, FUTEX_UNLOCK_PI | FUTEX_PRIVATE_FLAG, 0, nullptr, nullptr, 0) < 0)
+        return errno;
+    return 0;
+}
+
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_mutex_init.html
 int pthread_mutex_init(pthread_mutex_t* mutex, pthread_mutexattr_t const* attributes)
 {
@@ -104,12 +168,16 @@ int pthread_mutex_init(pthread_mutex_t* mutex, pthread_mutexattr_t const* attrib
     mutex->owner = 0;
     mutex->level = 0;
     mutex->type = attributes ? attributes->type : __PTHREAD_MUTEX_NORMAL;
+    mutex->protocol = attributes ? attributes->protocol : __PTHREAD_PRIO_NONE;
     return 0;
 }
 
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_mutex_trylock.html
 int pthread_mutex_trylock(pthread_mutex_t* mutex)
 {
+    if (mutex->protocol == __PTHREAD_PRIO_INHERIT) [[unlikely]]
+        return priority_inheriting_mutex_trylock(mutex);
+
     u32 expected = MUTEX_UNLOCKED;
     bool exchanged = AK::atomic_compare_exchange_strong(&mutex->lock, expected, MUTEX_LOCKED_NO_NEED_TO_WAKE, AK::memory_order_acquire);
 
@@ -132,6 +200,9 @@ int pthread_mutex_trylock(pthread_mutex_t* mutex)
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_mutex_lock.html
 int pthread_mutex_lock(pthread_mutex_t* mutex)
 {
+    if (mutex->protocol == __PTHREAD_PRIO_INHERIT) [[unlikely]]
+        return priority_inheriting_mutex_lock(mutex);
+
     // Fast path: attempt to claim the mutex without waiting.
     u32 value = MUTEX_UNLOCKED;
     bool exchanged = AK::atomic_compare_exchange_strong(&mutex->lock, value, MUTEX_LOCKED_NO_NEED_TO_WAKE, AK::memory_order_acquire);
@@ -170,6 +241,9 @@ int __pthread_mutex_lock_pessimistic_np(pthread_mutex_t* mutex)
     // Same as pthread_mutex_lock(), but always set MUTEX_LOCKED_NEED_TO_WAKE,
     // and also don't bother checking for already owning the mutex recursively,
     // because we know we don't. Used in the condition variable implementation.
+    if (mutex->protocol == __PTHREAD_PRIO_INHERIT) [[unlikely]]
+        return priority_inheriting_mutex_lock(mutex);
+
     u32 value = AK::atomic_exchange(&mutex->lock, MUTEX_LOCKED_NEED_TO_WAKE, AK::memory_order_acquire);
     while (value != MUTEX_UNLOCKED) {
         futex_wait(&mutex->lock, value, nullptr, 0, false);
@@ -185,6 +259,9 @@ int __pthread_mutex_lock_pessimistic_np(pthread_mutex_t* mutex)
 // https://pubs.opengroup.org/onlinepubs/009695399/functions/pthread_mutex_unlock.html
 int pthread_mutex_unlock(pthread_mutex_t* mutex)
 {
+    if (mutex->protocol == __PTHREAD_PRIO_INHERIT) [[unlikely]]
+        return priority_inheriting_mutex_unlock(mutex);
+
     if (mutex->type == __PTHREAD_MUTEX_RECURSIVE && mutex->level > 0) {
         mutex->level--;
         return 0;
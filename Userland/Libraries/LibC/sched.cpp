@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Platform.h>
+#include <bits/process_page.h>
 #include <errno.h>
 #include <sched.h>
 #include <syscall.h>
@@ -17,6 +19,36 @@ int sched_yield()
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
 
+// https://man7.org/linux/man-pages/man3/sched_getcpu.3.html
+int sched_getcpu()
+{
+#if ARCH(X86_64)
+    Kernel::ProcessPageData process_page;
+    if (__read_process_page(&process_page)) {
+        switch (process_page.processor_id_source) {
+        case Kernel::ProcessorIDSource::RDPID: {
+            u64 processor_id;
+            asm volatile("rdpid %0"
+                         : "=r"(processor_id));
+            return static_cast<int>(processor_id);
+        }
+        case Kernel::ProcessorIDSource::RDTSCP: {
+            u32 processor_id;
+            asm volatile("rdtscp"
+                         : "=c"(processor_id)
+                         :
+                         : "eax", "edx");
+            return static_cast<int>(processor_id);
+        }
+        case Kernel::ProcessorIDSource::None:
+            break;
+        }
+    }
+#endif
+    int rc = syscall(SC_getcpu);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/sched_get_priority_min.html
 int sched_get_priority_min([[maybe_unused]] int policy)
 {
@@ -36,6 +68,7 @@ int sched_setparam(pid_t pid, const struct sched_param* param)
         .pid_or_tid = pid,
         .mode = Syscall::SchedulerParametersMode::Process,
         .parameters = *param,
+        .policy = -1,
     };
     int rc = syscall(SC_scheduler_set_parameters, &parameters);
     __RETURN_WITH_ERRNO(rc, rc, -1);
@@ -48,10 +81,37 @@ int sched_getparam(pid_t pid, struct sched_param* param)
         .pid_or_tid = pid,
         .mode = Syscall::SchedulerParametersMode::Process,
         .parameters = {},
+        .policy = -1,
     };
     int rc = syscall(SC_scheduler_get_parameters, &parameters);
     if (rc == 0)
         *param = parameters.parameters;
     __RETURN_WITH_ERRNO(rc, rc, -1);
 }
+
+// https://pubs.opengroup.org/onlinepubs/9699919799/functions/sched_setscheduler.html
+int sched_setscheduler(pid_t pid, int policy, const struct sched_param* param)
+{
+    Syscall::SC_scheduler_parameters_params parameters {
+        .pid_or_tid = pid,
+        .mode = Syscall::SchedulerParametersMode::Process,
+        .parameters = *param,
+        .policy = policy,
+    };
+    int rc = syscall(SC_scheduler_set_parameters, &parameters);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
+// https://pubs.opengroup.org/onlinepubs/9699919799/functions/sched_getscheduler.html
+int sched_getscheduler(pid_t pid)
+{
+    Syscall::SC_scheduler_parameters_params parameters {
+        .pid_or_tid = pid,
+        .mode = Syscall::SchedulerParametersMode::Process,
+        .parameters = {},
+        .policy = -1,
+    };
+    int rc = syscall(SC_scheduler_get_parameters, &parameters);
+    __RETURN_WITH_ERRNO(rc, parameters.policy, -1);
+}
 }
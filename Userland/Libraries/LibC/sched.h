@@ -18,14 +18,13 @@ __BEGIN_DECLS
 
 int sched_yield(void);
 
-#define SCHED_FIFO 0
-#define SCHED_RR 1
-#define SCHED_OTHER 2
-#define SCHED_BATCH 3
-
 int sched_get_priority_min(int policy);
 int sched_get_priority_max(int policy);
 int sched_setparam(pid_t pid, const struct sched_param* param);
 int sched_getparam(pid_t pid, struct sched_param* param);
+int sched_setscheduler(pid_t pid, int policy, const struct sched_param* param);
+int sched_getscheduler(pid_t pid);
+
+int sched_getcpu(void);
 
 __END_DECLS
@@ -61,6 +61,21 @@ int get_stack_bounds(uintptr_t* user_stack_base, size_t* user_stack_size);
 
 int anon_create(size_t size, int options);
 
+// Fills the buffer with a DirectoryEntryWithStat record for every entry of the directory.
+// Fails with EINVAL if the buffer is too small to hold all of them.
+ssize_t get_dir_entries_with_stat(int fd, void* buffer, size_t buffer_size);
+
+// Creates an I/O ring (see Kernel/API/IORing.h) and returns a file descriptor that is to be mmap()'d with MAP_SHARED.
+int io_ring_create(uint32_t entries, int options);
+// Hands up to to_submit operations from the submission ring to the kernel, and then waits until at least
+// min_complete completions are waiting to be reaped (or nothing is in flight anymore).
+// Returns the number of operations that were submitted.
+int io_ring_enter(int fd, uint32_t to_submit, uint32_t min_complete);
+
+// Makes the syscalls in entries one after the other in a single kernel entry, and stores their results in the entries.
+// Returns the number of entries that were processed. If a signal arrives, the remaining entries fail with EINTR.
+int syscall_batch(struct syscall_batch_entry* entries, size_t count);
+
 int serenity_readlink(char const* path, size_t path_length, char* buffer, size_t buffer_size);
 
 int getkeymap(char* name_buffer, size_t name_buffer_size, uint32_t* map, uint32_t* shift_map, uint32_t* alt_map, uint32_t* altgr_map, uint32_t* shift_altgr_map);
@@ -13,7 +13,7 @@
 
 #include <spawn.h>
 
-#include <AK/Function.h>
+#include <AK/ByteString.h>
 #include <AK/Vector.h>
 #include <LibFileSystem/FileSystem.h>
 #include <errno.h>
@@ -24,10 +24,48 @@
 #include <syscall.h>
 #include <unistd.h>
 
+struct posix_spawn_file_action {
+    Syscall::PosixSpawnFileActionType type;
+    int fd { -1 };
+    int new_fd { -1 };
+    int options { 0 };
+    mode_t mode { 0 };
+    ByteString path;
+};
+
 struct posix_spawn_file_actions_state {
-    Vector<Function<int()>, 4> actions;
+    Vector<posix_spawn_file_action, 4> actions;
 };
 
+static int run_file_action(posix_spawn_file_action const& action)
+{
+    switch (action.type) {
+    case Syscall::PosixSpawnFileActionType::Open: {
+        int opened_fd = open(action.path.characters(), action.options, action.mode);
+        if (opened_fd < 0 || opened_fd == action.fd)
+            return opened_fd;
+        if (int rc = dup2(opened_fd, action.fd); rc < 0)
+            return rc;
+        return close(opened_fd);
+    }
+    case Syscall::PosixSpawnFileActionType::Close:
+        return close(action.fd);
+    case Syscall::PosixSpawnFileActionType::Dup2:
+        if (action.fd == action.new_fd) {
+            int flags = fcntl(action.fd, F_GETFD);
+            if (flags < 0)
+                return flags;
+            return fcntl(action.fd, F_SETFD, flags & ~FD_CLOEXEC);
+        }
+        return dup2(action.fd, action.new_fd);
+    case Syscall::PosixSpawnFileActionType::Chdir:
+        return chdir(action.path.characters());
+    case Syscall::PosixSpawnFileActionType::Fchdir:
+        return fchdir(action.fd);
+    }
+    VERIFY_NOT_REACHED();
+}
+
 extern "C" {
 
 [[noreturn]] static void posix_spawn_child(char const* path, posix_spawn_file_actions_t const* file_actions, posix_spawnattr_t const* attr, char* const argv[], char* const envp[], int (*exec)(char const*, char* const[], char* const[]))
@@ -88,7 +126,7 @@ extern "C" {
 
     if (file_actions) {
         for (auto const& action : file_actions->state->actions) {
-            if (action() < 0) {
+            if (run_file_action(action) < 0) {
                 perror("posix_spawn file action");
                 _exit(127);
             }
@@ -100,7 +138,7 @@ extern "C" {
     _exit(127);
 }
 
-static ErrorOr<pid_t> posix_spawn_syscall(char const* path, char* const argv[], char* const envp[])
+static ErrorOr<pid_t> posix_spawn_syscall(char const* path, posix_spawn_file_actions_t const* file_actions, char* const argv[], char* const envp[])
 {
     if (!path || !argv || !argv[0])
         return EINVAL;
@@ -129,8 +167,22 @@ static ErrorOr<pid_t> posix_spawn_syscall(char const* path, char* const argv[],
     posix_spawn_params.attr_data = nullptr;
     posix_spawn_params.attr_data_size = 0;
 
-    posix_spawn_params.serialized_file_actions_data = nullptr;
-    posix_spawn_params.serialized_file_actions_data_size = 0;
+    Vector<Syscall::SC_posix_spawn_file_action, 4> serialized_file_actions;
+    if (file_actions) {
+        for (auto const& action : file_actions->state->actions) {
+            TRY(serialized_file_actions.try_append({
+                .type = action.type,
+                .fd = action.fd,
+                .new_fd = action.new_fd,
+                .options = action.options,
+                .mode = static_cast<u16>(action.mode),
+                .path = { action.path.characters(), action.path.length() },
+            }));
+        }
+    }
+
+    posix_spawn_params.serialized_file_actions_data = serialized_file_actions.is_empty() ? nullptr : serialized_file_actions.data();
+    posix_spawn_params.serialized_file_actions_data_size = serialized_file_actions.size() * sizeof(Syscall::SC_posix_spawn_file_action);
 
     pid_t rc = syscall(SC_posix_spawn, &posix_spawn_params);
 
@@ -143,9 +195,9 @@ static ErrorOr<pid_t> posix_spawn_syscall(char const* path, char* const argv[],
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/posix_spawn.html
 int posix_spawn(pid_t* out_pid, char const* path, posix_spawn_file_actions_t const* file_actions, posix_spawnattr_t const* attr, char* const argv[], char* const envp[])
 {
-    // FIXME: Support file_actions and spawnattr in the posix_spawn syscall.
-    if ((!file_actions || file_actions->state->actions.is_empty()) && !attr) {
-        auto child_pid_or_error = posix_spawn_syscall(path, argv, envp);
+    // FIXME: Support spawnattr in the posix_spawn syscall.
+    if (!attr) {
+        auto child_pid_or_error = posix_spawn_syscall(path, file_actions, argv, envp);
         if (child_pid_or_error.is_error())
             return child_pid_or_error.error().code();
 
@@ -172,7 +224,7 @@ int posix_spawnp(pid_t* out_pid, char const* file, posix_spawn_file_actions_t co
     if (strchr(file, '/') != nullptr)
         return posix_spawn(out_pid, file, file_actions, attr, argv, envp);
 
-    if ((!file_actions || file_actions->state->actions.is_empty()) && !attr) {
+    if (!attr) {
         // FIXME: This is currently not OOM-safe because ByteString does not handle OOMs!
 
         ByteString path = getenv("PATH");
@@ -184,6 +236,14 @@ int posix_spawnp(pid_t* out_pid, char const* file, posix_spawn_file_actions_t co
         path.view().for_each_split_view(":"sv, SplitBehavior::Nothing, [out_pid, file, file_actions, attr, argv, envp, &rc](auto const directory) -> IterationDecision {
             auto absolute_path = ByteString::formatted("{}/{}", directory, file);
 
+            // The file actions may have side effects, so only run them once we know the executable is there.
+            // Otherwise, an ENOENT from one of them would also make us keep searching.
+            bool has_file_actions = file_actions && !file_actions->state->actions.is_empty();
+            if (has_file_actions && access(absolute_path.characters(), F_OK) < 0) {
+                rc = errno;
+                return rc == ENOENT ? IterationDecision::Continue : IterationDecision::Break;
+            }
+
             rc = posix_spawn(out_pid, absolute_path.characters(), file_actions, attr, argv, envp);
             if (rc == ENOENT)
                 return IterationDecision::Continue;
@@ -208,41 +268,34 @@ int posix_spawnp(pid_t* out_pid, char const* file, posix_spawn_file_actions_t co
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/posix_spawn_file_actions_addchdir.html
 int posix_spawn_file_actions_addchdir(posix_spawn_file_actions_t* actions, char const* path)
 {
-    actions->state->actions.append([path]() { return chdir(path); });
+    actions->state->actions.append({ .type = Syscall::PosixSpawnFileActionType::Chdir, .path = path });
     return 0;
 }
 
 int posix_spawn_file_actions_addfchdir(posix_spawn_file_actions_t* actions, int fd)
 {
-    actions->state->actions.append([fd]() { return fchdir(fd); });
+    actions->state->actions.append({ .type = Syscall::PosixSpawnFileActionType::Fchdir, .fd = fd });
     return 0;
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/posix_spawn_file_actions_addclose.html
 int posix_spawn_file_actions_addclose(posix_spawn_file_actions_t* actions, int fd)
 {
-    actions->state->actions.append([fd]() { return close(fd); });
+    actions->state->actions.append({ .type = Syscall::PosixSpawnFileActionType::Close, .fd = fd });
     return 0;
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/posix_spawn_file_actions_adddup2.html
 int posix_spawn_file_actions_adddup2(posix_spawn_file_actions_t* actions, int old_fd, int new_fd)
 {
-    actions->state->actions.append([old_fd, new_fd]() { return dup2(old_fd, new_fd); });
+    actions->state->actions.append({ .type = Syscall::PosixSpawnFileActionType::Dup2, .fd = old_fd, .new_fd = new_fd });
     return 0;
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/posix_spawn_file_actions_addopen.html
 int posix_spawn_file_actions_addopen(posix_spawn_file_actions_t* actions, int want_fd, char const* path, int flags, mode_t mode)
 {
-    actions->state->actions.append([want_fd, path, flags, mode]() {
-        int opened_fd = open(path, flags, mode);
-        if (opened_fd < 0 || opened_fd == want_fd)
-            return opened_fd;
-        if (int rc = dup2(opened_fd, want_fd); rc < 0)
-            return rc;
-        return close(opened_fd);
-    });
+    actions->state->actions.append({ .type = Syscall::PosixSpawnFileActionType::Open, .fd = want_fd, .options = flags, .mode = mode, .path = path });
     return 0;
 }
 
@@ -22,6 +22,22 @@ __attribute__((malloc)) __attribute__((alloc_size(1, 2))) void* calloc(size_t nm
 size_t malloc_size(void const*);
 size_t malloc_good_size(size_t);
 void serenity_dump_malloc_stats(void);
+// Releases the empty blocks that malloc keeps around for reuse back to the system. Returns 1 if there were any.
+int malloc_trim(size_t pad);
+
+struct serenity_malloc_statistics {
+    // Blocks that small allocations are carved from. Chunks in per-thread caches count as in use.
+    size_t chunked_block_count;
+    size_t chunked_bytes_in_use;
+    size_t chunked_bytes_free;
+    // Empty blocks that are kept around for reuse, see malloc_trim().
+    size_t hot_empty_block_count;
+    size_t cold_empty_block_count;
+    size_t big_allocation_count;
+    size_t big_allocation_bytes;
+    size_t recycled_big_block_count;
+};
+void serenity_get_malloc_statistics(struct serenity_malloc_statistics*);
 void free(void*);
 __attribute__((alloc_size(2))) void* realloc(void* ptr, size_t);
 char* getenv(char const* name);
@@ -5,10 +5,13 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/Format.h>
 #include <AK/MemMem.h>
 #include <AK/Memory.h>
 #include <AK/Platform.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Types.h>
 #include <assert.h>
@@ -19,6 +22,21 @@
 #include <stdlib.h>
 #include <string.h>
 
+using AK::SIMD::u8x16;
+
+// Returns the index of the first byte for which the result of a comparison of two u8x16s was true,
+// or sizeof(u8x16) if there is none.
+template<typename MaskType>
+static ALWAYS_INLINE size_t index_of_first_set_byte(MaskType mask)
+{
+    auto words = bit_cast<AK::SIMD::u64x2>(mask);
+    if (words[0] != 0)
+        return count_trailing_zeroes(words[0]) / 8;
+    if (words[1] != 0)
+        return 8 + count_trailing_zeroes(words[1]) / 8;
+    return sizeof(u8x16);
+}
+
 extern "C" {
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strspn.html
@@ -52,10 +70,19 @@ size_t strcspn(char const* s, char const* reject)
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strlen.html
 size_t strlen(char const* str)
 {
-    size_t len = 0;
-    while (*(str++))
-        ++len;
-    return len;
+    char const* ptr = str;
+    for (; (FlatPtr)ptr % sizeof(u8x16) != 0; ++ptr) {
+        if (*ptr == '\0')
+            return ptr - str;
+    }
+
+    // An aligned load never crosses a page boundary, so reading past the terminator can't fault.
+    for (;; ptr += sizeof(u8x16)) {
+        u8x16 chunk;
+        __builtin_memcpy(&chunk, ptr, sizeof(chunk));
+        if (auto index = index_of_first_set_byte(chunk == 0); index != sizeof(u8x16))
+            return ptr - str + index;
+    }
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/strnlen.html
@@ -119,6 +146,12 @@ int memcmp(void const* v1, void const* v2, size_t n)
 {
     auto* s1 = (uint8_t const*)v1;
     auto* s2 = (uint8_t const*)v2;
+    for (; n >= sizeof(u8x16); n -= sizeof(u8x16), s1 += sizeof(u8x16), s2 += sizeof(u8x16)) {
+        auto chunk1 = AK::SIMD::load_unaligned<u8x16>(s1);
+        auto chunk2 = AK::SIMD::load_unaligned<u8x16>(s2);
+        if (auto index = index_of_first_set_byte(chunk1 != chunk2); index != sizeof(u8x16))
+            return s1[index] < s2[index] ? -1 : 1;
+    }
     while (n-- > 0) {
         if (*s1++ != *s2++)
             return s1[-1] < s2[-1] ? -1 : 1;
@@ -278,7 +311,14 @@ void* memchr(void const* ptr, int c, size_t size)
 {
     char ch = c;
     auto* cptr = (char const*)ptr;
-    for (size_t i = 0; i < size; ++i) {
+    size_t i = 0;
+    auto pattern = AK::SIMD::expand_to<u8x16>(static_cast<u8>(ch));
+    for (; i + sizeof(u8x16) <= size; i += sizeof(u8x16)) {
+        auto chunk = AK::SIMD::load_unaligned<u8x16>(cptr + i);
+        if (auto index = index_of_first_set_byte(chunk == pattern); index != sizeof(u8x16))
+            return const_cast<char*>(cptr + i + index);
+    }
+    for (; i < size; ++i) {
         if (cptr[i] == ch)
             return const_cast<char*>(cptr + i);
     }
@@ -16,6 +16,7 @@ typedef void (*AtExitFunction)(void*);
 // NOTE: Ideally these symbols would be hidden but some of them are needed by crt0, ubsan, and the dynamic linker.
 extern void __libc_init();
 extern void __malloc_init(void);
+extern void __malloc_destroy_thread_cache(void);
 extern void __stdio_init(void);
 extern void __begin_atexit_locking(void);
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/ByteString.h>
 #include <AK/ScopeGuard.h>
 #include <AK/ScopedValueRollback.h>
@@ -12,6 +13,7 @@
 #include <LibFileSystem/FileSystem.h>
 #include <alloca.h>
 #include <assert.h>
+#include <bits/process_page.h>
 #include <bits/pthread_cancel.h>
 #include <bits/pthread_integration.h>
 #include <dirent.h>
@@ -47,6 +49,39 @@ static __thread int s_cached_tid = 0;
 
 static int s_cached_pid = 0;
 
+static Kernel::ProcessPage* s_process_page = nullptr;
+
+static Kernel::ProcessPage* get_process_page()
+{
+    auto* process_page = AK::atomic_load(&s_process_page, AK::memory_order_acquire);
+    if (process_page)
+        return process_page;
+
+    auto rc = syscall(SC_map_process_page);
+    if ((int)rc < 0 && (int)rc > -EMAXERRNO)
+        return nullptr;
+    // The kernel moves this mapping over to the child's own page on fork(), so it never has to be remapped.
+    // If another thread was faster, its mapping is used and this one stays unused.
+    Kernel::ProcessPage* expected = nullptr;
+    if (!AK::atomic_compare_exchange_strong(&s_process_page, expected, reinterpret_cast<Kernel::ProcessPage*>(rc), AK::memory_order_acq_rel))
+        return expected;
+    return reinterpret_cast<Kernel::ProcessPage*>(rc);
+}
+
+bool __read_process_page(Kernel::ProcessPageData* data)
+{
+    auto* process_page = get_process_page();
+    if (!process_page)
+        return false;
+
+    u32 update_iteration;
+    do {
+        update_iteration = AK::atomic_load(&process_page->update1, AK::memory_order_acquire);
+        *data = process_page->data;
+    } while (update_iteration != AK::atomic_load(&process_page->update2, AK::memory_order_acquire));
+    return true;
+}
+
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/lchown.html
 int lchown(char const* pathname, uid_t uid, gid_t gid)
 {
@@ -280,24 +315,36 @@ int execlp(char const* filename, char const* arg0, ...)
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/getuid.html
 uid_t geteuid()
 {
+    Kernel::ProcessPageData process_page;
+    if (__read_process_page(&process_page))
+        return process_page.euid;
     return syscall(SC_geteuid);
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/getegid.html
 gid_t getegid()
 {
+    Kernel::ProcessPageData process_page;
+    if (__read_process_page(&process_page))
+        return process_page.egid;
     return syscall(SC_getegid);
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/getuid.html
 uid_t getuid()
 {
+    Kernel::ProcessPageData process_page;
+    if (__read_process_page(&process_page))
+        return process_page.uid;
     return syscall(SC_getuid);
 }
 
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/getgid.html
 gid_t getgid()
 {
+    Kernel::ProcessPageData process_page;
+    if (__read_process_page(&process_page))
+        return process_page.gid;
     return syscall(SC_getgid);
 }
 
@@ -315,6 +362,9 @@ pid_t getpid()
 // https://pubs.opengroup.org/onlinepubs/9699919799/functions/getppid.html
 pid_t getppid()
 {
+    Kernel::ProcessPageData process_page;
+    if (__read_process_page(&process_page))
+        return process_page.ppid;
     return syscall(SC_getppid);
 }
 
@@ -418,6 +468,13 @@ ssize_t pwrite(int fd, void const* buf, size_t count, off_t offset)
     return nwritten;
 }
 
+ssize_t copy_file_range(int fd_in, off_t* offset_in, int fd_out, off_t* offset_out, size_t length, unsigned flags)
+{
+    Syscall::SC_copy_file_range_params params { fd_in, offset_in, fd_out, offset_out, length, flags };
+    ssize_t rc = syscall(SC_copy_file_range, &params);
+    __RETURN_WITH_ERRNO(rc, rc, -1);
+}
+
 // Note: Be sure to send to directory_name parameter a directory name ended with trailing slash.
 static int ttyname_r_for_directory(char const* directory_name, dev_t device_mode, ino_t inode_number, char* buffer, size_t size)
 {
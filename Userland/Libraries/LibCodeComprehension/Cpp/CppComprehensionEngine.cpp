@@ -393,6 +393,13 @@ ByteString CppComprehensionEngine::document_path_from_include_path(StringView in
 
 void CppComprehensionEngine::on_edit(ByteString const& file)
 {
+    // Edits that end up with the text we already parsed (like an undone change, or setting a file to its current
+    // content) don't need the document and its symbols to be rebuilt.
+    if (auto const* document = get_document_data(file)) {
+        auto text = filedb().get_or_read_from_filesystem(file);
+        if (text.has_value() && text.value() == document->text())
+            return;
+    }
     set_document_data(file, create_document_data_for(file));
 }
 
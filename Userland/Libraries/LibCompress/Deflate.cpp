@@ -8,9 +8,11 @@
 #include <AK/Array.h>
 #include <AK/Assertions.h>
 #include <AK/BinarySearch.h>
+#include <AK/ByteReader.h>
 #include <AK/MemoryStream.h>
 #include <LibCompress/Deflate.h>
 #include <LibCompress/Huffman.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 namespace Compress {
 
@@ -373,12 +375,511 @@ void DeflateDecompressor::close()
 {
 }
 
-ErrorOr<ByteBuffer> DeflateDecompressor::decompress_all(ReadonlyBytes bytes)
+// Decodes a complete DEFLATE stream into contiguous memory in one go.
+//
+// Since the whole input is available, the bits are refilled eight bytes at a time into a 64-bit buffer, which always
+// holds enough bits for a complete literal/length and distance pair. Since the whole output is available too, matches
+// are copied straight from earlier output, eight bytes at a time where they don't overlap that closely, instead of
+// going through a window. Huffman codes are decoded with a single table lookup for codes of up to table_bits bits
+// (with a second lookup in a subtable for longer ones), and the literal/length table holds two literals per entry
+// where both of their codes fit into table_bits bits.
+class OneShotDeflateDecoder {
+public:
+    OneShotDeflateDecoder(ReadonlyBytes input, Bytes output)
+        : m_input(input.data())
+        , m_input_end(input.data() + input.size())
+        , m_output(output)
+    {
+    }
+
+    OneShotDeflateDecoder(ReadonlyBytes input, ByteBuffer& growable_output)
+        : m_input(input.data())
+        , m_input_end(input.data() + input.size())
+        , m_output(growable_output.bytes())
+        , m_growable_output(&growable_output)
+    {
+    }
+
+    ErrorOr<void> decode();
+
+    size_t output_size() const { return m_output_position; }
+
+private:
+    enum class EntryKind : u8 {
+        Invalid,
+        Literal,
+        TwoLiterals,
+        EndOfBlock,
+        LengthOrDistance,
+        Subtable,
+    };
+
+    struct Entry {
+        u16 symbol { 0 }; // For subtable links, the index of the subtable.
+        u16 base { 0 };
+        u8 code_length { 0 };
+        u8 extra_bits { 0 }; // For two literals, the code length of the second one.
+        EntryKind kind { EntryKind::Invalid };
+        u8 second_literal { 0 };
+    };
+    static_assert(sizeof(Entry) == 8);
+
+    enum class Alphabet {
+        LiteralLength,
+        Distance,
+        CodeLength,
+    };
+
+    static constexpr size_t max_code_length = 15;
+    static constexpr size_t literal_length_table_bits = 11;
+    static constexpr size_t distance_table_bits = 9;
+    static constexpr size_t code_length_table_bits = 7;
+
+    class DecodingTable {
+    public:
+        static ErrorOr<DecodingTable> create(ReadonlyBytes code_lengths, size_t table_bits, Alphabet);
+
+        bool is_empty() const { return m_entries.is_empty(); }
+
+        ALWAYS_INLINE Entry const& lookup(u64 bits) const
+        {
+            auto const& entry = m_entries[bits & ((1u << m_table_bits) - 1)];
+            if (entry.kind != EntryKind::Subtable)
+                return entry;
+            return m_entries[entry.symbol + ((bits >> m_table_bits) & ((1u << (max_code_length - m_table_bits)) - 1))];
+        }
+
+    private:
+        static Entry entry_for_symbol(Alphabet, size_t symbol, u8 code_length);
+
+        size_t m_table_bits { 0 };
+        Vector<Entry> m_entries;
+    };
+
+    static DecodingTable const& fixed_literal_length_table();
+    static DecodingTable const& fixed_distance_table();
+
+    // The bit buffer is refilled to at least 56 bits, which is more than a literal/length code and a distance code
+    // with their extra bits take (15 + 5 + 15 + 13 bits).
+    ErrorOr<void> refill();
+
+    ALWAYS_INLINE u32 peek_bits(size_t count) const { return m_bit_buffer & ((1ull << count) - 1); }
+    ALWAYS_INLINE void discard_bits(size_t count)
+    {
+        m_bit_buffer >>= count;
+        m_bits_in_buffer -= count;
+    }
+    ALWAYS_INLINE u32 read_bits(size_t count)
+    {
+        auto bits = peek_bits(count);
+        discard_bits(count);
+        return bits;
+    }
+
+    ErrorOr<void> ensure_output_space(size_t);
+
+    ErrorOr<void> decode_stored_block();
+    ErrorOr<void> decode_dynamic_tables(Optional<DecodingTable>& literal_length_table, Optional<DecodingTable>& distance_table);
+    ErrorOr<void> decode_huffman_block(DecodingTable const& literal_length_table, DecodingTable const* distance_table);
+    void copy_match(size_t distance, size_t length);
+
+    u8 const* m_input { nullptr };
+    u8 const* m_input_end { nullptr };
+    u64 m_bit_buffer { 0 };
+    size_t m_bits_in_buffer { 0 };
+
+    // Past the end of the input, the bit buffer is filled with zero bytes, which must not actually be read.
+    size_t m_bytes_past_end_of_input { 0 };
+
+    Bytes m_output;
+    size_t m_output_position { 0 };
+    ByteBuffer* m_growable_output { nullptr };
+};
+
+OneShotDeflateDecoder::Entry OneShotDeflateDecoder::DecodingTable::entry_for_symbol(Alphabet alphabet, size_t symbol, u8 code_length)
+{
+    Entry entry;
+    entry.symbol = symbol;
+    entry.code_length = code_length;
+
+    switch (alphabet) {
+    case Alphabet::LiteralLength:
+        if (symbol < EndOfBlock) {
+            entry.kind = EntryKind::Literal;
+        } else if (symbol == EndOfBlock) {
+            entry.kind = EntryKind::EndOfBlock;
+        } else if (symbol < 286) {
+            entry.kind = EntryKind::LengthOrDistance;
+            entry.base = packed_length_symbols[symbol - 257].base_length;
+            entry.extra_bits = packed_length_symbols[symbol - 257].extra_bits;
+        }
+        break;
+    case Alphabet::Distance:
+        if (symbol < 30) {
+            entry.kind = EntryKind::LengthOrDistance;
+            entry.base = packed_distances[symbol].base_distance;
+            entry.extra_bits = packed_distances[symbol].extra_bits;
+        }
+        break;
+    case Alphabet::CodeLength:
+        entry.kind = EntryKind::Literal;
+        break;
+    }
+
+    return entry;
+}
+
+// Accepts the same codes as CanonicalCode::from_bytes(): complete ones, and ones with a single symbol.
+ErrorOr<OneShotDeflateDecoder::DecodingTable> OneShotDeflateDecoder::DecodingTable::create(ReadonlyBytes code_lengths, size_t table_bits, Alphabet alphabet)
+{
+    DecodingTable table;
+    table.m_table_bits = table_bits;
+    TRY(table.m_entries.try_resize(1u << table_bits));
+
+    Array<u16, max_code_length + 1> code_length_counts {};
+    size_t number_of_symbols = 0;
+    size_t last_symbol = 0;
+    for (size_t symbol = 0; symbol < code_lengths.size(); ++symbol) {
+        auto code_length = code_lengths[symbol];
+        if (code_length == 0)
+            continue;
+        if (code_length > max_code_length)
+            return Error::from_string_literal("Failed to decode code lengths");
+        code_length_counts[code_length]++;
+        number_of_symbols++;
+        last_symbol = symbol;
+    }
+
+    // A single symbol gets a code of one bit, where both values decode to it.
+    if (number_of_symbols == 1) {
+        table.m_entries.span().fill(entry_for_symbol(alphabet, last_symbol, 1));
+        return table;
+    }
+
+    u32 code_space = 0;
+    for (size_t code_length = 1; code_length <= max_code_length; ++code_length)
+        code_space += code_length_counts[code_length] << (max_code_length - code_length);
+    if (code_space != (1u << max_code_length))
+        return Error::from_string_literal("Failed to decode code lengths");
+
+    Array<u16, max_code_length + 1> next_code {};
+    u16 code = 0;
+    for (size_t code_length = 1; code_length <= max_code_length; ++code_length) {
+        code = (code + code_length_counts[code_length - 1]) << 1;
+        next_code[code_length] = code;
+    }
+
+    // DEFLATE stores codes starting with their most significant bit, so the tables are indexed by reversed codes.
+    size_t const subtable_bits = max_code_length - table_bits;
+    for (size_t symbol = 0; symbol < code_lengths.size(); ++symbol) {
+        auto code_length = code_lengths[symbol];
+        if (code_length == 0)
+            continue;
+
+        auto reversed_code = fast_reverse16(next_code[code_length]++, code_length);
+        auto entry = entry_for_symbol(alphabet, symbol, code_length);
+
+        if (code_length <= table_bits) {
+            for (size_t index = reversed_code; index < (1u << table_bits); index += 1u << code_length)
+                table.m_entries[index] = entry;
+            continue;
+        }
+
+        size_t prefix = reversed_code & ((1u << table_bits) - 1);
+        if (table.m_entries[prefix].kind != EntryKind::Subtable) {
+            Entry link;
+            link.kind = EntryKind::Subtable;
+            link.symbol = table.m_entries.size();
+            link.code_length = table_bits;
+            table.m_entries[prefix] = link;
+            TRY(table.m_entries.try_resize(table.m_entries.size() + (1u << subtable_bits)));
+        }
+
+        size_t subtable_start = table.m_entries[prefix].symbol;
+        for (size_t index = reversed_code >> table_bits; index < (1u << subtable_bits); index += 1u << (code_length - table_bits))
+            table.m_entries[subtable_start + index] = entry;
+    }
+
+    if (alphabet == Alphabet::LiteralLength) {
+        // The bits after a short literal's code are the start of the next code, so if those already determine another
+        // literal, both can be written at once. An entry only ever looks at entries with smaller indices here, which
+        // still describe their first symbol the same way after they've been turned into two literals.
+        for (size_t index = 0; index < (1u << table_bits); ++index) {
+            auto& entry = table.m_entries[index];
+            if (entry.kind != EntryKind::Literal || entry.code_length >= table_bits)
+                continue;
+
+            auto const& next_entry = table.m_entries[index >> entry.code_length];
+            if (next_entry.kind != EntryKind::Literal && next_entry.kind != EntryKind::TwoLiterals)
+                continue;
+            if (entry.code_length + next_entry.code_length > table_bits)
+                continue;
+
+            entry.kind = EntryKind::TwoLiterals;
+            entry.second_literal = next_entry.symbol;
+            entry.extra_bits = next_entry.code_length;
+        }
+    }
+
+    return table;
+}
+
+OneShotDeflateDecoder::DecodingTable const& OneShotDeflateDecoder::fixed_literal_length_table()
+{
+    static auto const table = MUST(DecodingTable::create(fixed_literal_bit_lengths, literal_length_table_bits, Alphabet::LiteralLength));
+    return table;
+}
+
+OneShotDeflateDecoder::DecodingTable const& OneShotDeflateDecoder::fixed_distance_table()
+{
+    static auto const table = MUST(DecodingTable::create(fixed_distance_bit_lengths, distance_table_bits, Alphabet::Distance));
+    return table;
+}
+
+ErrorOr<void> OneShotDeflateDecoder::refill()
+{
+    if (m_input_end - m_input >= 8) {
+        // Loads whole bytes up to 56-63 bits. The bits above that are loaded again by the next refill, and since they
+        // are the same bits, OR-ing them in again doesn't change them.
+        m_bit_buffer |= ByteReader::load64(m_input) << m_bits_in_buffer;
+        m_input += (63 - m_bits_in_buffer) / 8;
+        m_bits_in_buffer |= 56;
+        return {};
+    }
+
+    while (m_bits_in_buffer <= 56) {
+        u64 byte = 0;
+        if (m_input < m_input_end)
+            byte = *m_input++;
+        else
+            m_bytes_past_end_of_input++;
+        m_bit_buffer |= byte << m_bits_in_buffer;
+        m_bits_in_buffer += 8;
+    }
+
+    // Every symbol takes at least one bit, so this stops decoding garbage once the input has run out. Whether any of
+    // the zero bytes were actually used is checked after each block.
+    if (m_bytes_past_end_of_input > 16)
+        return Error::from_string_literal("Input data ends in the middle of the DEFLATE stream");
+    return {};
+}
+
+ErrorOr<void> OneShotDeflateDecoder::ensure_output_space(size_t size)
+{
+    if (m_output.size() - m_output_position >= size)
+        return {};
+
+    if (!m_growable_output)
+        return Error::from_string_literal("Output buffer is too small for the decompressed data");
+
+    // Leaves room for a match after the requested data, so that matches usually can be copied in whole words.
+    TRY(m_growable_output->try_resize(max(m_output.size() * 2, m_output_position + size + DeflateDecompressor::max_back_reference_length + 8)));
+    m_output = m_growable_output->bytes();
+    return {};
+}
+
+ErrorOr<void> OneShotDeflateDecoder::decode_stored_block()
+{
+    discard_bits(m_bits_in_buffer % 8);
+    TRY(refill());
+
+    u16 length = read_bits(16);
+    u16 negated_length = read_bits(16);
+    if ((length ^ 0xffff) != negated_length)
+        return Error::from_string_literal("Calculated negated length does not equal stored negated length");
+
+    // The data is copied straight from the input, so the bytes that are still in the bit buffer are put back first.
+    size_t bytes_in_buffer = m_bits_in_buffer / 8;
+    if (m_bytes_past_end_of_input > bytes_in_buffer)
+        return Error::from_string_literal("Input data ends in the middle of the DEFLATE stream");
+    m_input -= bytes_in_buffer - m_bytes_past_end_of_input;
+    m_bytes_past_end_of_input = 0;
+    m_bit_buffer = 0;
+    m_bits_in_buffer = 0;
+
+    if (static_cast<size_t>(m_input_end - m_input) < length)
+        return Error::from_string_literal("Input data ends in the middle of an uncompressed DEFLATE block");
+
+    TRY(ensure_output_space(length));
+    memcpy(m_output.offset_pointer(m_output_position), m_input, length);
+    m_input += length;
+    m_output_position += length;
+    return {};
+}
+
+ErrorOr<void> OneShotDeflateDecoder::decode_dynamic_tables(Optional<DecodingTable>& literal_length_table, Optional<DecodingTable>& distance_table)
+{
+    TRY(refill());
+    auto literal_code_count = read_bits(5) + 257;
+    auto distance_code_count = read_bits(5) + 1;
+    auto code_length_count = read_bits(4) + 4;
+
+    Array<u8, 19> code_lengths_code_lengths {};
+    for (size_t i = 0; i < code_length_count; ++i) {
+        TRY(refill());
+        code_lengths_code_lengths[code_lengths_code_lengths_order[i]] = read_bits(3);
+    }
+    auto code_length_table = TRY(DecodingTable::create(code_lengths_code_lengths, code_length_table_bits, Alphabet::CodeLength));
+
+    Array<u8, 288 + 32> code_lengths;
+    size_t code_length_index = 0;
+    while (code_length_index < literal_code_count + distance_code_count) {
+        TRY(refill());
+        auto const& entry = code_length_table.lookup(m_bit_buffer);
+        discard_bits(entry.code_length);
+
+        if (entry.symbol < deflate_special_code_length_copy) {
+            code_lengths[code_length_index++] = entry.symbol;
+            continue;
+        }
+
+        u8 repeated_length = 0;
+        size_t repeat_count = 0;
+        if (entry.symbol == deflate_special_code_length_copy) {
+            if (code_length_index == 0)
+                return Error::from_string_literal("Found no codes to copy before a copy block");
+            repeated_length = code_lengths[code_length_index - 1];
+            repeat_count = 3 + read_bits(2);
+        } else if (entry.symbol == deflate_special_code_length_zeros) {
+            repeat_count = 3 + read_bits(3);
+        } else {
+            VERIFY(entry.symbol == deflate_special_code_length_long_zeros);
+            repeat_count = 11 + read_bits(7);
+        }
+
+        if (code_length_index + repeat_count > literal_code_count + distance_code_count)
+            return Error::from_string_literal("Number of code lengths does not match the sum of codes");
+        for (size_t i = 0; i < repeat_count; ++i)
+            code_lengths[code_length_index++] = repeated_length;
+    }
+
+    literal_length_table = TRY(DecodingTable::create(ReadonlyBytes { code_lengths.data(), literal_code_count }, literal_length_table_bits, Alphabet::LiteralLength));
+
+    // A single distance code of length zero means that the block has no back references.
+    auto distance_code_lengths = ReadonlyBytes { code_lengths.data() + literal_code_count, distance_code_count };
+    if (distance_code_count == 1) {
+        if (distance_code_lengths[0] == 0)
+            return {};
+        if (distance_code_lengths[0] != 1)
+            return Error::from_string_literal("Length for a single distance code is longer than 1");
+    }
+    distance_table = TRY(DecodingTable::create(distance_code_lengths, distance_table_bits, Alphabet::Distance));
+    return {};
+}
+
+ALWAYS_INLINE void OneShotDeflateDecoder::copy_match(size_t distance, size_t length)
 {
-    FixedMemoryStream memory_stream { bytes };
-    LittleEndianInputBitStream bit_stream { MaybeOwned<Stream>(memory_stream) };
-    auto deflate_stream = TRY(DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream>(bit_stream)));
-    return deflate_stream->read_until_eof(4096);
+    u8* destination = m_output.offset_pointer(m_output_position);
+    u8 const* source = destination - distance;
+    m_output_position += length;
+
+    if (m_output.size() - (m_output_position - length) >= length + 8) {
+        if (distance >= 8) {
+            // Each word only reads bytes that were written before it, and may write up to 7 bytes past the match.
+            for (size_t i = 0; i < length; i += 8)
+                __builtin_memcpy(destination + i, source + i, 8);
+            return;
+        }
+        if (distance == 1) {
+            memset(destination, *source, length);
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < length; ++i)
+        destination[i] = source[i];
+}
+
+ErrorOr<void> OneShotDeflateDecoder::decode_huffman_block(DecodingTable const& literal_length_table, DecodingTable const* distance_table)
+{
+    while (true) {
+        TRY(refill());
+
+        auto const& entry = literal_length_table.lookup(m_bit_buffer);
+        switch (entry.kind) {
+        case EntryKind::Literal:
+            discard_bits(entry.code_length);
+            TRY(ensure_output_space(1));
+            m_output[m_output_position++] = entry.symbol;
+            break;
+        case EntryKind::TwoLiterals:
+            discard_bits(entry.code_length + entry.extra_bits);
+            TRY(ensure_output_space(2));
+            m_output[m_output_position] = entry.symbol;
+            m_output[m_output_position + 1] = entry.second_literal;
+            m_output_position += 2;
+            break;
+        case EntryKind::EndOfBlock:
+            discard_bits(entry.code_length);
+            return {};
+        case EntryKind::LengthOrDistance: {
+            discard_bits(entry.code_length);
+            size_t length = entry.base + read_bits(entry.extra_bits);
+
+            if (!distance_table)
+                return Error::from_string_literal("Distance codes have not been initialized");
+            auto const& distance_entry = distance_table->lookup(m_bit_buffer);
+            if (distance_entry.kind != EntryKind::LengthOrDistance)
+                return Error::from_string_literal("Invalid deflate distance symbol");
+            discard_bits(distance_entry.code_length);
+            size_t distance = distance_entry.base + read_bits(distance_entry.extra_bits);
+
+            if (distance > m_output_position)
+                return Error::from_string_literal("Back reference distance is larger than the decompressed data");
+            TRY(ensure_output_space(length));
+            copy_match(distance, length);
+            break;
+        }
+        default:
+            return Error::from_string_literal("Invalid deflate literal/length symbol");
+        }
+    }
+}
+
+ErrorOr<void> OneShotDeflateDecoder::decode()
+{
+    bool is_final_block = false;
+    while (!is_final_block) {
+        TRY(refill());
+        is_final_block = read_bits(1);
+        auto block_type = read_bits(2);
+
+        if (block_type == 0b00) {
+            TRY(decode_stored_block());
+        } else if (block_type == 0b01) {
+            TRY(decode_huffman_block(fixed_literal_length_table(), &fixed_distance_table()));
+        } else if (block_type == 0b10) {
+            Optional<DecodingTable> literal_length_table;
+            Optional<DecodingTable> distance_table;
+            TRY(decode_dynamic_tables(literal_length_table, distance_table));
+            TRY(decode_huffman_block(*literal_length_table, distance_table.has_value() ? &distance_table.value() : nullptr));
+        } else {
+            return Error::from_string_literal("Unhandled block type for Idle state");
+        }
+
+        if (m_bytes_past_end_of_input * 8 > m_bits_in_buffer)
+            return Error::from_string_literal("Input data ends in the middle of the DEFLATE stream");
+    }
+    return {};
+}
+
+ErrorOr<size_t> DeflateDecompressor::decompress_into(ReadonlyBytes bytes, Bytes output)
+{
+    OneShotDeflateDecoder decoder { bytes, output };
+    TRY(decoder.decode());
+    return decoder.output_size();
+}
+
+ErrorOr<ByteBuffer> DeflateDecompressor::decompress_all(ReadonlyBytes bytes, size_t expected_size)
+{
+    // Compressed data usually is a few times smaller than the original, and the output grows as needed anyway. DEFLATE
+    // can't compress by more than about 1:1032 though, so a bogus expected size doesn't allocate more than that.
+    auto initial_size = min(max(expected_size, bytes.size() * 4), bytes.size() * 1032);
+    auto output = TRY(ByteBuffer::create_uninitialized(initial_size + max_back_reference_length + 8));
+    OneShotDeflateDecoder decoder { bytes, output };
+    TRY(decoder.decode());
+    output.trim(decoder.output_size(), false);
+    return output;
 }
 
 ErrorOr<u32> DeflateDecompressor::decode_length(u32 symbol)
@@ -580,7 +1081,7 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             break; // no remaining candidates
 
         VERIFY(candidate < start);
-        if (start - candidate > window_size)
+        if (start - candidate > max_match_distance)
             break; // outside the window
 
         auto match_length = compare_match_candidate(start, candidate, previous_match_length, maximum_match_length);
@@ -635,6 +1136,13 @@ void DeflateCompressor::lz77_compress_block()
         m_distance_frequencies[distance_to_base(distance)]++;
     };
 
+    // The dictionary can be referred back to, but isn't emitted itself. Its last few positions are only hashed if the
+    // block is long enough to provide the rest of their bytes.
+    auto dictionary_end = min(block_size, block_size + m_pending_block_size - min(m_pending_block_size, min_match_length - 1));
+    for (size_t position = block_size - m_dictionary_size; position < dictionary_end; position++)
+        insert_hash(position, hash_sequence(&m_rolling_window[position]));
+    m_dictionary_size = 0;
+
     size_t previous_match_length = 0;
     size_t previous_match_position = 0;
 
@@ -970,6 +1478,33 @@ ErrorOr<void> DeflateCompressor::final_flush()
     return {};
 }
 
+ErrorOr<void> DeflateCompressor::sync_flush_and_finish()
+{
+    VERIFY(!m_finished);
+    if (m_pending_block_size != 0)
+        TRY(flush());
+
+    // An empty stored block gets to a byte boundary without ending the deflate stream (this is zlib's Z_SYNC_FLUSH).
+    TRY(m_output_stream->write_bits(0b000u, 3)); // not final, no compression
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xffff));
+
+    m_finished = true;
+    TRY(m_output_stream->flush_buffer_to_stream());
+    return {};
+}
+
+void DeflateCompressor::set_dictionary(ReadonlyBytes dictionary)
+{
+    VERIFY(!m_finished);
+    VERIFY(m_pending_block_size == 0);
+
+    dictionary = dictionary.slice_from_end(min(dictionary.size(), block_size));
+    dictionary.copy_to({ m_rolling_window + block_size - dictionary.size(), dictionary.size() });
+    m_dictionary_size = dictionary.size();
+}
+
 ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, CompressionLevel compression_level)
 {
     auto output_stream = TRY(try_make<AllocatingMemoryStream>());
@@ -981,4 +1516,50 @@ ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, Compres
     return output_stream->read_until_eof();
 }
 
+ErrorOr<ByteBuffer> DeflateCompressor::compress_chunk(ReadonlyBytes bytes, bool is_last_chunk, CompressionLevel compression_level, ReadonlyBytes dictionary)
+{
+    auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+    auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(*output_stream), compression_level));
+    deflate_stream->set_dictionary(dictionary);
+
+    TRY(deflate_stream->write_until_depleted(bytes));
+    if (is_last_chunk)
+        TRY(deflate_stream->final_flush());
+    else
+        TRY(deflate_stream->sync_flush_and_finish());
+
+    return output_stream->read_until_eof();
+}
+
+ErrorOr<ByteBuffer> DeflateCompressor::compress_all_in_parallel(ReadonlyBytes bytes, CompressionLevel compression_level)
+{
+    if (bytes.size() <= parallel_chunk_size)
+        return compress_all(bytes, compression_level);
+
+    struct Chunk {
+        size_t offset { 0 };
+        ErrorOr<ByteBuffer> compressed_data { ByteBuffer {} };
+    };
+
+    Vector<Chunk> chunks;
+    TRY(chunks.try_ensure_capacity(ceil_div(bytes.size(), parallel_chunk_size)));
+    for (size_t offset = 0; offset < bytes.size(); offset += parallel_chunk_size)
+        chunks.unchecked_append({ offset });
+
+    Threading::parallel_for(chunks.span(), 1, [&](Span<Chunk> slice) {
+        for (auto& chunk : slice) {
+            auto chunk_data = bytes.slice(chunk.offset, min(parallel_chunk_size, bytes.size() - chunk.offset));
+            auto dictionary = bytes.trim(chunk.offset);
+            chunk.compressed_data = compress_chunk(chunk_data, chunk.offset + chunk_data.size() == bytes.size(), compression_level, dictionary);
+        }
+    });
+
+    ByteBuffer output;
+    for (auto& chunk : chunks) {
+        auto compressed_data = TRY(move(chunk.compressed_data));
+        TRY(output.try_append(compressed_data.bytes()));
+    }
+    return output;
+}
+
 }
@@ -108,7 +108,15 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
 
-    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
+    // Decompresses a complete DEFLATE stream in one go, which is a lot faster than reading it through the stream
+    // interface. The expected size is only used to size the output buffer up front.
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes, size_t expected_size = 0);
+
+    // Like decompress_all(), but into a buffer whose size is known up front. Returns the decompressed size, or an error
+    // if the data doesn't fit.
+    static ErrorOr<size_t> decompress_into(ReadonlyBytes, Bytes output);
+
+    static constexpr u16 max_back_reference_length = 258;
 
 private:
     DeflateDecompressor(MaybeOwned<LittleEndianInputBitStream> stream, CircularBuffer buffer);
@@ -117,8 +125,6 @@ private:
     ErrorOr<u32> decode_distance(u32);
     ErrorOr<void> decode_codes(CanonicalCode& literal_code, Optional<CanonicalCode>& distance_code);
 
-    static constexpr u16 max_back_reference_length = 258;
-
     bool m_read_final_block { false };
 
     State m_state { State::Idle };
@@ -140,6 +146,8 @@ public:
     static constexpr size_t max_huffman_distances = 32;
     static constexpr size_t min_match_length = 4;   // matches smaller than these are not worth the size of the back reference
     static constexpr size_t max_match_length = 258; // matches longer than these cannot be encoded using huffman codes
+    static constexpr size_t max_match_distance = 32 * KiB;
+    static constexpr size_t parallel_chunk_size = 128 * KiB;
     static constexpr u16 empty_slot = UINT16_MAX;
 
     struct CompressionConstants {
@@ -176,8 +184,26 @@ public:
     virtual void close() override;
     ErrorOr<void> final_flush();
 
+    // Like final_flush(), but ends the output with an empty non-final block, which leaves it at a byte boundary.
+    // Another deflate stream can then be appended to it.
+    ErrorOr<void> sync_flush_and_finish();
+
+    // Lets the first block refer back to the end of the given data (up to block_size bytes of it), which has to be the
+    // data right before this compressor's input in the decompressed stream. Must be called before writing anything.
+    void set_dictionary(ReadonlyBytes);
+
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
 
+    // Compresses one of several chunks of some data without depending on the output for the previous chunks, so that
+    // the chunks can be compressed independently of each other. The compressed chunks form a single deflate stream when
+    // they are concatenated in order. The data before the chunk can be passed as the dictionary, see set_dictionary().
+    static ErrorOr<ByteBuffer> compress_chunk(ReadonlyBytes bytes, bool is_last_chunk, CompressionLevel = CompressionLevel::GOOD, ReadonlyBytes dictionary = {});
+
+    // Like compress_all(), but compresses chunks of parallel_chunk_size bytes on multiple threads. The chunks only lose
+    // the matches that would reach back more than a block into the previous chunk, so the output is barely larger. It
+    // doesn't depend on the number of threads either.
+    static ErrorOr<ByteBuffer> compress_all_in_parallel(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
+
 private:
     DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>, CompressionLevel = CompressionLevel::GOOD);
 
@@ -213,6 +239,7 @@ private:
 
     u8 m_rolling_window[window_size];
     size_t m_pending_block_size { 0 };
+    size_t m_dictionary_size { 0 }; // the dictionary ends right before the pending block, see set_dictionary()
 
     struct [[gnu::packed]] {
         u16 distance; // back reference length
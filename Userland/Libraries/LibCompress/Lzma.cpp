@@ -101,6 +101,38 @@ ErrorOr<LzmaDecompressorOptions> LzmaHeader::as_decompressor_options() const
     };
 }
 
+LzmaCompressorOptions LzmaCompressorOptions::from_preset(u8 preset)
+{
+    VERIFY(preset <= maximum_preset);
+
+    struct Preset {
+        u32 dictionary_size;
+        LzmaMatchFinderType match_finder;
+        u16 nice_match_length;
+        u32 search_depth;
+    };
+    static constexpr Array<Preset, maximum_preset + 1> presets {
+        Preset { 256 * KiB, LzmaMatchFinderType::HashChain, 128, 4 },
+        Preset { 1 * MiB, LzmaMatchFinderType::HashChain, 128, 8 },
+        Preset { 2 * MiB, LzmaMatchFinderType::HashChain, 273, 24 },
+        Preset { 4 * MiB, LzmaMatchFinderType::HashChain, 273, 48 },
+        Preset { 4 * MiB, LzmaMatchFinderType::BinaryTree, 16, 0 },
+        Preset { 8 * MiB, LzmaMatchFinderType::BinaryTree, 32, 0 },
+        Preset { 8 * MiB, LzmaMatchFinderType::BinaryTree, 64, 0 },
+        Preset { 16 * MiB, LzmaMatchFinderType::BinaryTree, 64, 0 },
+        Preset { 32 * MiB, LzmaMatchFinderType::BinaryTree, 64, 0 },
+        Preset { 64 * MiB, LzmaMatchFinderType::BinaryTree, 64, 0 },
+    };
+
+    auto const& selected_preset = presets[preset];
+    return {
+        .dictionary_size = selected_preset.dictionary_size,
+        .match_finder = selected_preset.match_finder,
+        .nice_match_length = selected_preset.nice_match_length,
+        .search_depth = selected_preset.search_depth,
+    };
+}
+
 ErrorOr<LzmaHeader> LzmaHeader::from_compressor_options(LzmaCompressorOptions const& options)
 {
     auto encoded_model_properties = TRY(encode_model_properties({
@@ -229,13 +261,19 @@ ErrorOr<void> LzmaDecompressor::append_input_stream(MaybeOwned<Stream> stream, O
     return {};
 }
 
-ErrorOr<void> LzmaDecompressor::normalize_range_decoder()
+ALWAYS_INLINE ErrorOr<void> LzmaDecompressor::normalize_range_decoder()
 {
     // "The Normalize() function keeps the "Range" value in described range."
 
-    if (m_range_decoder_range >= minimum_range_value)
+    // This is checked after every single bit, but only reads a byte every few bits, so the read is kept out of line.
+    if (m_range_decoder_range >= minimum_range_value) [[likely]]
         return {};
 
+    return shift_range_decoder();
+}
+
+ErrorOr<void> LzmaDecompressor::shift_range_decoder()
+{
     m_range_decoder_range <<= 8;
     m_range_decoder_code <<= 8;
 
@@ -340,18 +378,20 @@ ErrorOr<u8> LzmaDecompressor::decode_bit_with_probability(Probability& probabili
 
     dbgln_if(LZMA_DEBUG, "Decoding bit {} with probability = {:#x}, bound = {:#x}, code = {:#x}, range = {:#x}", m_range_decoder_code < bound ? 0 : 1, probability, bound, m_range_decoder_code, m_range_decoder_range);
 
-    if (m_range_decoder_code < bound) {
-        probability += ((1 << probability_bit_count) - probability) >> probability_shift_width;
-        m_range_decoder_range = bound;
-        TRY(normalize_range_decoder());
-        return 0;
-    } else {
-        probability -= probability >> probability_shift_width;
-        m_range_decoder_code -= bound;
-        m_range_decoder_range -= bound;
-        TRY(normalize_range_decoder());
-        return 1;
-    }
+    // The bits are hard to predict (that's what makes them worth coding), so both outcomes are computed and selected
+    // with masks instead of branching on the decoded bit.
+    u32 bit = m_range_decoder_code >= bound;
+    u32 mask = 0 - bit;
+
+    Probability probability_if_zero = probability + (((1 << probability_bit_count) - probability) >> probability_shift_width);
+    Probability probability_if_one = probability - (probability >> probability_shift_width);
+    probability = (probability_if_zero & ~mask) | (probability_if_one & mask);
+
+    m_range_decoder_code -= bound & mask;
+    m_range_decoder_range = (bound & ~mask) | ((m_range_decoder_range - bound) & mask);
+
+    TRY(normalize_range_decoder());
+    return bit;
 }
 
 ErrorOr<void> LzmaCompressor::encode_bit_with_probability(Probability& probability, u8 value)
@@ -527,12 +567,9 @@ ErrorOr<void> LzmaCompressor::encode_literal(u8 literal)
 
     TRY(encode_match_type(MatchType::Literal));
 
-    // Note: We have already read the next byte from the input buffer, so it's now in the seekback buffer, shifting all seekback offsets by one.
     u8 previous_byte = 0;
-    if (m_dictionary->seekback_limit() - m_dictionary->used_space() > 1) {
-        auto read_bytes = MUST(m_dictionary->read_with_seekback({ &previous_byte, sizeof(previous_byte) }, 2 + m_dictionary->used_space()));
-        VERIFY(read_bytes.size() == sizeof(previous_byte));
-    }
+    if (m_match_finder->history_size() > 0)
+        previous_byte = m_match_finder->byte_before(1);
     u16 const literal_state_bits_from_position = m_total_processed_bytes & ((1 << m_options.literal_position_bits) - 1);
     u16 const literal_state_bits_from_output = previous_byte >> (8 - m_options.literal_context_bits);
     u16 const literal_state = literal_state_bits_from_position << m_options.literal_context_bits | literal_state_bits_from_output;
@@ -543,9 +580,7 @@ ErrorOr<void> LzmaCompressor::encode_literal(u8 literal)
     u16 result = 1;
 
     if (m_state >= 7) {
-        u8 matched_byte = 0;
-        auto read_bytes = TRY(m_dictionary->read_with_seekback({ &matched_byte, sizeof(matched_byte) }, current_repetition_offset() + m_dictionary->used_space() + 1));
-        VERIFY(read_bytes.size() == sizeof(matched_byte));
+        u8 matched_byte = m_match_finder->byte_before(current_repetition_offset());
 
         dbgln_if(LZMA_DEBUG, "Encoding literal using match byte {:#x}", matched_byte);
 
@@ -619,7 +654,7 @@ ErrorOr<void> LzmaCompressor::encode_existing_match(size_t real_distance, size_t
 
     TRY(encode_normalized_match_length(m_rep_length_coder, normalized_length));
     update_state_after_rep();
-    MUST(m_dictionary->discard(real_length));
+    m_match_finder->skip(real_length);
     m_total_processed_bytes += real_length;
 
     return {};
@@ -635,7 +670,7 @@ ErrorOr<void> LzmaCompressor::encode_new_match(size_t real_distance, size_t real
 
     TRY(encode_normalized_simple_match(normalized_distance, normalized_length));
 
-    MUST(m_dictionary->discard(real_length));
+    m_match_finder->skip(real_length);
     m_total_processed_bytes += real_length;
 
     return {};
@@ -991,34 +1026,39 @@ ErrorOr<void> LzmaCompressor::encode_match_type(MatchType match_type)
 
 ErrorOr<void> LzmaCompressor::encode_once()
 {
+    size_t const maximum_length = min(m_match_finder->lookahead_size(), largest_real_match_length);
+
     // Check if any of our existing match distances are currently usable.
-    Vector<size_t> const existing_distances {
-        m_rep0 + normalized_to_real_match_distance_offset,
-        m_rep1 + normalized_to_real_match_distance_offset,
-        m_rep2 + normalized_to_real_match_distance_offset,
-        m_rep3 + normalized_to_real_match_distance_offset,
-    };
-    auto existing_distance_result = m_dictionary->find_copy_in_seekback(existing_distances, m_dictionary->used_space(), normalized_to_real_match_length_offset);
+    Optional<LzmaMatchFinder::Match> existing_match;
+    for (u32 normalized_distance : { m_rep0, m_rep1, m_rep2, m_rep3 }) {
+        size_t const real_distance = normalized_distance + normalized_to_real_match_distance_offset;
+        size_t const length = m_match_finder->match_length_at_distance(real_distance, maximum_length);
+        if (length >= normalized_to_real_match_length_offset && (!existing_match.has_value() || length > existing_match->length))
+            existing_match = LzmaMatchFinder::Match { static_cast<u32>(real_distance), static_cast<u32>(length) };
+    }
+
+    // Search the rest of the dictionary for possible new offsets as well. This has to be done for every position that we
+    // don't skip over, since it also lets the match finder remember this position.
+    auto new_match = m_match_finder->find_longest_match();
 
-    if (existing_distance_result.has_value()) {
-        auto selected_match = existing_distance_result.release_value();
-        TRY(encode_existing_match(selected_match.distance, selected_match.length));
+    // A short match that is far away takes more bits to encode than the literals that it replaces.
+    if (new_match.has_value() && new_match->length == normalized_to_real_match_length_offset && new_match->distance > 128)
+        new_match.clear();
+
+    // Existing match distances are a lot cheaper to encode, so only use a new one if it's considerably longer.
+    if (existing_match.has_value() && (!new_match.has_value() || existing_match->length + 1 >= new_match->length)) {
+        TRY(encode_existing_match(existing_match->distance, existing_match->length));
         return {};
     }
 
-    // If we weren't able to find any viable existing offsets, we now have to search the rest of the dictionary for possible new offsets.
-    auto new_distance_result = m_dictionary->find_copy_in_seekback(m_dictionary->used_space(), normalized_to_real_match_length_offset);
-
-    if (new_distance_result.has_value()) {
-        auto selected_match = new_distance_result.release_value();
-        TRY(encode_new_match(selected_match.distance, selected_match.length));
+    if (new_match.has_value()) {
+        TRY(encode_new_match(new_match->distance, new_match->length));
         return {};
     }
 
     // If we weren't able to find any matches, we don't have any other choice than to encode the next byte as a literal.
-    u8 next_byte { 0 };
-    TRY(m_dictionary->read({ &next_byte, sizeof(next_byte) }));
-    TRY(encode_literal(next_byte));
+    TRY(encode_literal(m_match_finder->byte_at(0)));
+    m_match_finder->skip(1);
     return {};
 }
 
@@ -1214,7 +1254,13 @@ void LzmaDecompressor::close()
 
 ErrorOr<NonnullOwnPtr<LzmaCompressor>> LzmaCompressor::create_container(MaybeOwned<Stream> stream, LzmaCompressorOptions const& options)
 {
-    auto dictionary = TRY(try_make<SearchableCircularBuffer>(TRY(SearchableCircularBuffer::create_empty(options.dictionary_size + largest_real_match_length))));
+    static_assert(largest_real_match_length == LzmaMatchFinder::maximum_match_length);
+
+    // Matches can't reach back further than the start of the data, so small inputs don't need a large dictionary.
+    u32 dictionary_size = options.dictionary_size;
+    if (options.uncompressed_size.has_value())
+        dictionary_size = static_cast<u32>(max(min<u64>(dictionary_size, options.uncompressed_size.value()), 4 * KiB));
+    auto match_finder = TRY(LzmaMatchFinder::create(options.match_finder, dictionary_size, options.nice_match_length, options.search_depth));
 
     // "The LZMA Decoder uses (1 << (lc + lp)) tables with CProb values, where each table contains 0x300 CProb values."
     auto literal_probabilities = TRY(FixedArray<Probability>::create(literal_probability_table_size * (1 << (options.literal_context_bits + options.literal_position_bits))));
@@ -1222,16 +1268,16 @@ ErrorOr<NonnullOwnPtr<LzmaCompressor>> LzmaCompressor::create_container(MaybeOwn
     auto header = TRY(LzmaHeader::from_compressor_options(options));
     TRY(stream->write_value(header));
 
-    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) LzmaCompressor(move(stream), options, move(dictionary), move(literal_probabilities))));
+    auto compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) LzmaCompressor(move(stream), options, move(match_finder), move(literal_probabilities))));
 
     return compressor;
 }
 
-LzmaCompressor::LzmaCompressor(MaybeOwned<AK::Stream> stream, Compress::LzmaCompressorOptions options, MaybeOwned<SearchableCircularBuffer> dictionary, FixedArray<Compress::LzmaState::Probability> literal_probabilities)
+LzmaCompressor::LzmaCompressor(MaybeOwned<AK::Stream> stream, Compress::LzmaCompressorOptions options, NonnullOwnPtr<LzmaMatchFinder> match_finder, FixedArray<Compress::LzmaState::Probability> literal_probabilities)
     : LzmaState(move(literal_probabilities))
     , m_stream(move(stream))
     , m_options(move(options))
-    , m_dictionary(move(dictionary))
+    , m_match_finder(move(match_finder))
 {
 }
 
@@ -1242,25 +1288,19 @@ ErrorOr<Bytes> LzmaCompressor::read_some(Bytes)
 
 ErrorOr<size_t> LzmaCompressor::write_some(ReadonlyBytes bytes)
 {
-    // Fill the input buffer until it's full or until we can't read any more data.
-    size_t processed_bytes = min(bytes.size(), largest_real_match_length - m_dictionary->used_space());
-    bytes = bytes.trim(processed_bytes);
-
-    while (bytes.size() > 0) {
-        auto const written_bytes = m_dictionary->write(bytes);
-        bytes = bytes.slice(written_bytes);
-    }
+    // Encode the buffered data while there is enough of it left to not miss any possible repetitions.
+    // This also makes room in the match finder's window for more input data.
+    while (m_match_finder->lookahead_size() >= largest_real_match_length)
+        TRY(encode_once());
 
-    VERIFY(m_dictionary->used_space() <= largest_real_match_length);
+    size_t processed_bytes = m_match_finder->write(bytes);
 
-    if (m_options.uncompressed_size.has_value() && m_total_processed_bytes + m_dictionary->used_space() > m_options.uncompressed_size.value())
+    if (m_options.uncompressed_size.has_value() && m_total_processed_bytes + m_match_finder->lookahead_size() > m_options.uncompressed_size.value())
         return Error::from_string_literal("Tried to compress more LZMA data than announced");
 
-    TRY(encode_once());
-
     // If we read enough data to reach the final uncompressed size, flush automatically.
     // Flushing will handle encoding the remaining data for us and finalize the stream.
-    if (m_options.uncompressed_size.has_value() && m_total_processed_bytes + m_dictionary->used_space() >= m_options.uncompressed_size.value())
+    if (m_options.uncompressed_size.has_value() && m_total_processed_bytes + m_match_finder->lookahead_size() >= m_options.uncompressed_size.value())
         TRY(flush());
 
     return processed_bytes;
@@ -1271,7 +1311,7 @@ ErrorOr<void> LzmaCompressor::flush()
     if (m_has_flushed_data)
         return Error::from_string_literal("Flushed an LZMA stream twice");
 
-    while (m_dictionary->used_space() > 0)
+    while (m_match_finder->lookahead_size() > 0)
         TRY(encode_once());
 
     if (m_options.uncompressed_size.has_value() && m_total_processed_bytes < m_options.uncompressed_size.value())
@@ -11,6 +11,7 @@
 #include <AK/MaybeOwned.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Stream.h>
+#include <LibCompress/LzmaMatchFinder.h>
 
 namespace Compress {
 
@@ -34,11 +35,24 @@ struct LzmaDecompressorOptions {
 
 struct LzmaCompressorOptions {
     // Note: The default settings have been chosen based on the default settings of other LZMA compressors.
+    //       They are the same as the ones of the default preset.
     u8 literal_context_bits { 3 };
     u8 literal_position_bits { 0 };
     u8 position_bits { 2 };
     u32 dictionary_size { 8 * MiB };
     Optional<u64> uncompressed_size {};
+
+    LzmaMatchFinderType match_finder { LzmaMatchFinderType::BinaryTree };
+    u16 nice_match_length { 64 };
+    u32 search_depth { 0 }; // 0 picks a depth based on the nice match length.
+
+    static constexpr u8 maximum_preset = 9;
+    static constexpr u8 default_preset = 6;
+
+    // Presets 0 (fastest) to 9 (best compression) follow the ones of xz. Higher presets use larger dictionaries, which
+    // needs more memory for both compressing and decompressing. Compressing with the binary tree match finder of
+    // presets 4 and up needs about 10 times the dictionary size.
+    static LzmaCompressorOptions from_preset(u8 preset);
 };
 
 // Described in section "lzma file format".
@@ -192,6 +206,7 @@ private:
 
     ErrorOr<void> initialize_range_decoder();
     ErrorOr<void> normalize_range_decoder();
+    ErrorOr<void> shift_range_decoder();
     ErrorOr<u8> decode_direct_bit();
     ErrorOr<u8> decode_bit_with_probability(Probability& probability);
 
@@ -229,7 +244,7 @@ public:
     virtual ~LzmaCompressor();
 
 private:
-    LzmaCompressor(MaybeOwned<Stream>, LzmaCompressorOptions, MaybeOwned<SearchableCircularBuffer>, FixedArray<Probability> literal_probabilities);
+    LzmaCompressor(MaybeOwned<Stream>, LzmaCompressorOptions, NonnullOwnPtr<LzmaMatchFinder>, FixedArray<Probability> literal_probabilities);
 
     ErrorOr<void> shift_range_encoder();
     ErrorOr<void> normalize_range_encoder();
@@ -253,9 +268,8 @@ private:
     MaybeOwned<Stream> m_stream;
     LzmaCompressorOptions m_options;
 
-    // This doubles as an input buffer, which is appended at the very front of the buffer.
-    // Therefore, the size of this should at least be the dictionary size + the largest possible repetition length.
-    MaybeOwned<SearchableCircularBuffer> m_dictionary;
+    // This holds the dictionary, followed by the input data that hasn't been encoded yet.
+    NonnullOwnPtr<LzmaMatchFinder> m_match_finder;
 
     // Range encoder state.
     u32 m_range_encoder_range { 0xFFFFFFFF };
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/ByteReader.h>
+#include <AK/IntegralMath.h>
+#include <AK/NumericLimits.h>
+#include <LibCompress/LzmaMatchFinder.h>
+
+namespace Compress {
+
+static constexpr u32 hash2_bits = 16;
+static constexpr u32 hash3_bits = 16;
+static constexpr u32 minimum_hash4_bits = 16;
+static constexpr u32 maximum_hash4_bits = 24;
+
+// Positions can only be hashed once four bytes are available.
+static constexpr u32 minimum_length_limit = 4;
+
+static constexpr u32 golden_ratio_multiplier = 2654435761u;
+
+ErrorOr<NonnullOwnPtr<LzmaMatchFinder>> LzmaMatchFinder::create(LzmaMatchFinderType type, u32 dictionary_size, u32 nice_length, u32 search_depth)
+{
+    VERIFY(dictionary_size > 0);
+    nice_length = clamp(nice_length, minimum_length_limit, maximum_match_length);
+
+    // The window keeps a dictionary's worth of data before the current position, so the data after it has to be moved
+    // back once the window is full. Leaving at least as much room after the dictionary keeps that rare.
+    auto window = TRY(ByteBuffer::create_uninitialized(dictionary_size + max(dictionary_size, 256 * KiB)));
+
+    auto hash2_table = TRY(FixedArray<u32>::create(1 << hash2_bits));
+    auto hash3_table = TRY(FixedArray<u32>::create(1 << hash3_bits));
+    auto hash4_table = TRY(FixedArray<u32>::create(1u << clamp(AK::ceil_log2(dictionary_size) - 1, minimum_hash4_bits, maximum_hash4_bits)));
+
+    // These depths are the ones that xz uses by default.
+    switch (type) {
+    case LzmaMatchFinderType::HashChain: {
+        auto chain = TRY(FixedArray<u32>::create(dictionary_size));
+        if (search_depth == 0)
+            search_depth = 4 + nice_length / 4;
+        return TRY(adopt_nonnull_own_or_enomem(new (nothrow) LzmaHashChainMatchFinder(move(window), move(hash2_table), move(hash3_table), move(hash4_table), move(chain), nice_length, search_depth)));
+    }
+    case LzmaMatchFinderType::BinaryTree: {
+        auto tree = TRY(FixedArray<u32>::create(2 * static_cast<size_t>(dictionary_size)));
+        if (search_depth == 0)
+            search_depth = 16 + nice_length / 2;
+        return TRY(adopt_nonnull_own_or_enomem(new (nothrow) LzmaBinaryTreeMatchFinder(move(window), move(hash2_table), move(hash3_table), move(hash4_table), move(tree), nice_length, search_depth)));
+    }
+    }
+
+    VERIFY_NOT_REACHED();
+}
+
+LzmaMatchFinder::LzmaMatchFinder(ByteBuffer window, FixedArray<u32> hash2_table, FixedArray<u32> hash3_table, FixedArray<u32> hash4_table, u32 cyclic_size, u32 nice_length, u32 search_depth)
+    : m_cyclic_size(cyclic_size)
+    , m_search_depth(search_depth)
+    , m_window(move(window))
+    , m_position_offset(cyclic_size) // This puts unused entries (which are zero) more than a dictionary away from any position.
+    , m_nice_length(nice_length)
+    , m_hash2_table(move(hash2_table))
+    , m_hash3_table(move(hash3_table))
+    , m_hash4_table(move(hash4_table))
+    , m_hash4_bits(AK::count_trailing_zeroes(m_hash4_table.size()))
+{
+}
+
+size_t LzmaMatchFinder::write(ReadonlyBytes bytes)
+{
+    if (m_end == m_window.size())
+        move_window();
+
+    auto count = min(bytes.size(), m_window.size() - m_end);
+    bytes.trim(count).copy_to(m_window.span().slice(m_end));
+    m_end += count;
+    return count;
+}
+
+void LzmaMatchFinder::move_window()
+{
+    if (m_position <= m_cyclic_size)
+        return;
+
+    u32 amount = m_position - m_cyclic_size;
+
+    // Make sure that the positions of the whole window still fit into 32 bits after the move. If they don't, subtract
+    // the same amount from all stored positions, which doesn't change the distances between them.
+    if (static_cast<u64>(m_position_offset) + amount + m_window.size() > NumericLimits<u32>::max()) {
+        u32 subtracted_amount = m_position_offset - m_cyclic_size;
+        subtract_from_positions(m_hash2_table.span(), subtracted_amount);
+        subtract_from_positions(m_hash3_table.span(), subtracted_amount);
+        subtract_from_positions(m_hash4_table.span(), subtracted_amount);
+        subtract_from_linked_positions(subtracted_amount);
+        m_position_offset -= subtracted_amount;
+    }
+
+    __builtin_memmove(m_window.data(), m_window.data() + amount, m_end - amount);
+    m_position -= amount;
+    m_end -= amount;
+    m_position_offset += amount;
+}
+
+void LzmaMatchFinder::subtract_from_positions(Span<u32> positions, u32 amount)
+{
+    // Positions that would drop to zero or below are more than a dictionary away already, so they become unused.
+    for (auto& position : positions)
+        position = position > amount ? position - amount : 0;
+}
+
+u32 LzmaMatchFinder::matching_length(u8 const* match, u8 const* current, u32 start, u32 limit)
+{
+    u32 length = start;
+    while (length + sizeof(u64) <= limit) {
+        u64 difference = ByteReader::load64(match + length) ^ ByteReader::load64(current + length);
+        if (difference != 0)
+            return length + AK::count_trailing_zeroes(difference) / 8;
+        length += sizeof(u64);
+    }
+    while (length < limit && match[length] == current[length])
+        ++length;
+    return length;
+}
+
+size_t LzmaMatchFinder::match_length_at_distance(size_t distance, size_t maximum_length) const
+{
+    if (distance == 0 || distance > history_size())
+        return 0;
+
+    u8 const* current = m_window.data() + m_position;
+    return matching_length(current - distance, current, 0, min(maximum_length, lookahead_size()));
+}
+
+void LzmaMatchFinder::add_current_position(Optional<Match>* best_match)
+{
+    VERIFY(!m_current_position_is_inserted);
+    m_current_position_is_inserted = true;
+
+    u32 length_limit = min(lookahead_size(), m_nice_length);
+    u8 const* current = m_window.data() + m_position;
+    u32 position = m_position + m_position_offset;
+
+    u32 hash2 = ByteReader::load16(current);
+    u32 hash3 = ((current[0] | current[1] << 8 | static_cast<u32>(current[2]) << 16) * golden_ratio_multiplier) >> (32 - hash3_bits);
+    u32 hash4 = (ByteReader::load32(current) * golden_ratio_multiplier) >> (32 - m_hash4_bits);
+
+    u32 delta2 = position - m_hash2_table[hash2];
+    u32 delta3 = position - m_hash3_table[hash3];
+    u32 candidate = m_hash4_table[hash4];
+
+    m_hash2_table[hash2] = position;
+    m_hash3_table[hash3] = position;
+    m_hash4_table[hash4] = position;
+
+    if (!best_match) {
+        insert_current_position(current, position, candidate, length_limit, nullptr);
+        return;
+    }
+
+    // The most recent positions with the same first two or three bytes are usually close, so check them first.
+    if (delta2 < m_cyclic_size) {
+        u32 length = matching_length(current - delta2, current, 0, length_limit);
+        if (length >= 2)
+            *best_match = Match { delta2, length };
+    }
+
+    if (delta3 != delta2 && delta3 < m_cyclic_size) {
+        u32 length = matching_length(current - delta3, current, 0, length_limit);
+        if (length >= 3 && (!best_match->has_value() || length > best_match->value().length))
+            *best_match = Match { delta3, length };
+    }
+
+    if (best_match->has_value() && best_match->value().length >= length_limit) {
+        insert_current_position(current, position, candidate, length_limit, nullptr);
+        return;
+    }
+
+    insert_current_position(current, position, candidate, length_limit, best_match);
+}
+
+Optional<LzmaMatchFinder::Match> LzmaMatchFinder::find_longest_match()
+{
+    if (lookahead_size() < minimum_length_limit)
+        return {};
+
+    Optional<Match> best_match;
+    add_current_position(&best_match);
+
+    // The search stops at the nice length, but the match can be a lot longer than that.
+    if (best_match.has_value() && best_match->length >= m_nice_length) {
+        u8 const* current = m_window.data() + m_position;
+        u32 length_limit = min(lookahead_size(), maximum_match_length);
+        best_match->length = matching_length(current - best_match->distance, current, best_match->length, length_limit);
+    }
+
+    return best_match;
+}
+
+void LzmaMatchFinder::skip(size_t count)
+{
+    VERIFY(count <= lookahead_size());
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!m_current_position_is_inserted && lookahead_size() >= minimum_length_limit)
+            add_current_position(nullptr);
+
+        m_current_position_is_inserted = false;
+        ++m_position;
+        if (++m_cyclic_position == m_cyclic_size)
+            m_cyclic_position = 0;
+    }
+}
+
+LzmaHashChainMatchFinder::LzmaHashChainMatchFinder(ByteBuffer window, FixedArray<u32> hash2_table, FixedArray<u32> hash3_table, FixedArray<u32> hash4_table, FixedArray<u32> chain, u32 nice_length, u32 search_depth)
+    : LzmaMatchFinder(move(window), move(hash2_table), move(hash3_table), move(hash4_table), chain.size(), nice_length, search_depth)
+    , m_chain(move(chain))
+{
+}
+
+void LzmaHashChainMatchFinder::insert_current_position(u8 const* current, u32 position, u32 candidate, u32 length_limit, Optional<Match>* best_match)
+{
+    m_chain[m_cyclic_position] = candidate;
+
+    if (!best_match)
+        return;
+
+    u32 best_length = best_match->has_value() ? best_match->value().length : 1;
+    for (u32 depth = m_search_depth; depth > 0; --depth) {
+        u32 delta = position - candidate;
+        if (delta >= m_cyclic_size)
+            return;
+
+        u8 const* match = current - delta;
+        candidate = m_chain[cyclic_index(delta)];
+
+        // Only a match that is longer than the best one so far is interesting, so check the byte that would make it longer first.
+        if (match[best_length] != current[best_length] || match[0] != current[0])
+            continue;
+
+        u32 length = matching_length(match, current, 1, length_limit);
+        if (length > best_length) {
+            best_length = length;
+            *best_match = Match { delta, length };
+            if (length == length_limit)
+                return;
+        }
+    }
+}
+
+void LzmaHashChainMatchFinder::subtract_from_linked_positions(u32 amount)
+{
+    subtract_from_positions(m_chain.span(), amount);
+}
+
+LzmaBinaryTreeMatchFinder::LzmaBinaryTreeMatchFinder(ByteBuffer window, FixedArray<u32> hash2_table, FixedArray<u32> hash3_table, FixedArray<u32> hash4_table, FixedArray<u32> tree, u32 nice_length, u32 search_depth)
+    : LzmaMatchFinder(move(window), move(hash2_table), move(hash3_table), move(hash4_table), tree.size() / 2, nice_length, search_depth)
+    , m_tree(move(tree))
+{
+}
+
+void LzmaBinaryTreeMatchFinder::insert_current_position(u8 const* current, u32 position, u32 candidate, u32 length_limit, Optional<Match>* best_match)
+{
+    // The current position becomes the new root of the tree, so the old tree is split into the positions whose data
+    // sorts before the current data and the ones that sort after it while walking down. These are the slots where the
+    // next position of each kind is attached, and how many bytes all positions of that kind have in common with the
+    // current data.
+    u32* smaller_slot = &m_tree[2 * m_cyclic_position];
+    u32* larger_slot = &m_tree[2 * m_cyclic_position + 1];
+    u32 smaller_length = 0;
+    u32 larger_length = 0;
+
+    u32 best_length = best_match && best_match->has_value() ? best_match->value().length : 1;
+    for (u32 depth = m_search_depth;; --depth) {
+        u32 delta = position - candidate;
+        if (depth == 0 || delta >= m_cyclic_size) {
+            *smaller_slot = 0;
+            *larger_slot = 0;
+            return;
+        }
+
+        u32* children = &m_tree[2 * cyclic_index(delta)];
+        u8 const* match = current - delta;
+
+        u32 length = min(smaller_length, larger_length);
+        if (match[length] == current[length]) {
+            length = matching_length(match, current, length + 1, length_limit);
+            if (best_match && length > best_length) {
+                best_length = length;
+                *best_match = Match { delta, length };
+            }
+
+            // The data can't be told apart within the limit, so the candidate is replaced by the current position.
+            if (length == length_limit) {
+                *smaller_slot = children[0];
+                *larger_slot = children[1];
+                return;
+            }
+        }
+
+        if (match[length] < current[length]) {
+            *smaller_slot = candidate;
+            smaller_slot = &children[1];
+            candidate = *smaller_slot;
+            smaller_length = length;
+        } else {
+            *larger_slot = candidate;
+            larger_slot = &children[0];
+            candidate = *larger_slot;
+            larger_length = length;
+        }
+    }
+}
+
+void LzmaBinaryTreeMatchFinder::subtract_from_linked_positions(u32 amount)
+{
+    subtract_from_positions(m_tree.span(), amount);
+}
+
+}
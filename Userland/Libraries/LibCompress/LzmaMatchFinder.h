@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/Error.h>
+#include <AK/FixedArray.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+
+namespace Compress {
+
+enum class LzmaMatchFinderType {
+    // Follows a chain of the earlier positions that start with the same four bytes, newest first.
+    // Fast, but it only gets to check a few candidates.
+    HashChain,
+
+    // Keeps the earlier positions that start with the same four bytes in a binary search tree that is sorted by the
+    // data that follows them, so the longest match is found after checking far fewer candidates. Updating the tree
+    // takes more time, but it finds longer matches for the same search depth.
+    BinaryTree,
+};
+
+// Finds earlier occurrences of the upcoming data for the LZMA compressor. The match finder owns the window, which holds
+// the dictionary (the data that matches can refer back to) followed by the data that still has to be encoded.
+//
+// Positions are found through hash tables over their first two, three and four bytes. Positions with the same hash of
+// four bytes are then linked together by the specific match finder, which stores its links in a cyclic buffer with an
+// entry for each position of the dictionary.
+class LzmaMatchFinder {
+public:
+    struct Match {
+        u32 distance; // A distance of 1 refers to the previous byte.
+        u32 length;
+    };
+
+    static constexpr u32 maximum_match_length = 273;
+
+    // Matches are at most dictionary_size - 1 bytes away. Searches stop at the first match that is at least as long as
+    // the nice length, and after checking search_depth candidates (0 picks a depth based on the nice length).
+    static ErrorOr<NonnullOwnPtr<LzmaMatchFinder>> create(LzmaMatchFinderType, u32 dictionary_size, u32 nice_length, u32 search_depth = 0);
+
+    virtual ~LzmaMatchFinder() = default;
+
+    // Appends data to the data that still has to be encoded, and returns how much of it fits into the window.
+    // This only accepts less than all of it if more than a dictionary's worth of data is pending.
+    size_t write(ReadonlyBytes);
+
+    // The number of bytes at and after the current position.
+    size_t lookahead_size() const { return m_end - m_position; }
+
+    // The number of bytes before the current position that are still in the window.
+    size_t history_size() const { return m_position; }
+
+    u8 byte_at(size_t offset) const
+    {
+        VERIFY(offset < lookahead_size());
+        return m_window[m_position + offset];
+    }
+
+    u8 byte_before(size_t distance) const
+    {
+        VERIFY(distance > 0 && distance <= history_size());
+        return m_window[m_position - distance];
+    }
+
+    // Returns how many bytes at the current position match the ones at the given distance, up to maximum_length.
+    size_t match_length_at_distance(size_t distance, size_t maximum_length) const;
+
+    // Returns the longest match for the data at the current position that is at least two bytes long, without moving
+    // past it. This also adds the current position to the search structures, so it has to be followed by skip().
+    Optional<Match> find_longest_match();
+
+    // Moves the current position forward, and makes the skipped positions available for future matches.
+    void skip(size_t count);
+
+protected:
+    LzmaMatchFinder(ByteBuffer window, FixedArray<u32> hash2_table, FixedArray<u32> hash3_table, FixedArray<u32> hash4_table, u32 cyclic_size, u32 nice_length, u32 search_depth);
+
+    static u32 matching_length(u8 const* match, u8 const* current, u32 start, u32 limit);
+    static void subtract_from_positions(Span<u32> positions, u32 amount);
+
+    // Returns the index of an earlier position in the cyclic buffer.
+    u32 cyclic_index(u32 delta) const { return m_cyclic_position - delta + (delta > m_cyclic_position ? m_cyclic_size : 0); }
+
+    // Adds the current position to the structure that links positions with the same hash of four bytes, where candidate
+    // is the most recent of them. If best_match is given, also looks for a match that is longer than it.
+    virtual void insert_current_position(u8 const* current, u32 position, u32 candidate, u32 length_limit, Optional<Match>* best_match) = 0;
+    virtual void subtract_from_linked_positions(u32 amount) = 0;
+
+    u32 m_cyclic_size { 0 };
+    u32 m_cyclic_position { 0 };
+    u32 m_search_depth { 0 };
+
+private:
+    void add_current_position(Optional<Match>* best_match);
+    void move_window();
+
+    ByteBuffer m_window;
+    size_t m_position { 0 };
+    size_t m_end { 0 };
+    bool m_current_position_is_inserted { false };
+
+    // Positions are stored as the window index plus this offset, so they don't have to change when the window moves.
+    // Entries that are zero or more than a dictionary away from the current position are unused.
+    u32 m_position_offset { 0 };
+
+    u32 m_nice_length { 0 };
+
+    FixedArray<u32> m_hash2_table;
+    FixedArray<u32> m_hash3_table;
+    FixedArray<u32> m_hash4_table;
+    u32 m_hash4_bits { 0 };
+};
+
+class LzmaHashChainMatchFinder final : public LzmaMatchFinder {
+public:
+    LzmaHashChainMatchFinder(ByteBuffer window, FixedArray<u32> hash2_table, FixedArray<u32> hash3_table, FixedArray<u32> hash4_table, FixedArray<u32> chain, u32 nice_length, u32 search_depth);
+
+private:
+    virtual void insert_current_position(u8 const* current, u32 position, u32 candidate, u32 length_limit, Optional<Match>* best_match) override;
+    virtual void subtract_from_linked_positions(u32 amount) override;
+
+    // The previous position with the same hash for each position of the dictionary.
+    FixedArray<u32> m_chain;
+};
+
+class LzmaBinaryTreeMatchFinder final : public LzmaMatchFinder {
+public:
+    LzmaBinaryTreeMatchFinder(ByteBuffer window, FixedArray<u32> hash2_table, FixedArray<u32> hash3_table, FixedArray<u32> hash4_table, FixedArray<u32> tree, u32 nice_length, u32 search_depth);
+
+private:
+    virtual void insert_current_position(u8 const* current, u32 position, u32 candidate, u32 length_limit, Optional<Match>* best_match) override;
+    virtual void subtract_from_linked_positions(u32 amount) override;
+
+    // The roots of the trees are the most recent positions for each hash. Each position has a pair of children, the
+    // first one with the data that sorts before its own data, and the second one with the data that sorts after it.
+    FixedArray<u32> m_tree;
+};
+
+}
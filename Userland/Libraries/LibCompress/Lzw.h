@@ -99,30 +99,14 @@ public:
 
     static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes bytes, u8 initial_code_size, i32 offset_for_size_change = 0)
     {
-        auto memory_stream = make<FixedMemoryStream>(bytes);
-        auto lzw_stream = make<InputStream>(MaybeOwned<Stream>(move(memory_stream)));
-        LzwDecompressor lzw_decompressor { MaybeOwned<InputStream> { move(lzw_stream) }, initial_code_size, offset_for_size_change };
-
-        ByteBuffer decompressed;
-
-        u16 const clear_code = lzw_decompressor.add_control_code();
-        u16 const end_of_data_code = lzw_decompressor.add_control_code();
-
-        while (true) {
-            auto const code = TRY(lzw_decompressor.next_code());
-
-            if (code == clear_code) {
-                lzw_decompressor.reset();
-                continue;
-            }
-
-            if (code == end_of_data_code)
-                break;
-
-            TRY(decompressed.try_append(lzw_decompressor.get_output()));
-        }
+        return decompress(bytes, initial_code_size, offset_for_size_change, InputMayBeTruncated::No);
+    }
 
-        return decompressed;
+    // Like decompress_all(), but for data that may have been cut off. Everything up to the first code that can't be
+    // read is returned.
+    static ErrorOr<ByteBuffer> decompress_available(ReadonlyBytes bytes, u8 initial_code_size, i32 offset_for_size_change = 0)
+    {
+        return decompress(bytes, initial_code_size, offset_for_size_change, InputMayBeTruncated::Yes);
     }
 
     void reset()
@@ -167,6 +151,45 @@ public:
     }
 
 private:
+    enum class InputMayBeTruncated {
+        No,
+        Yes,
+    };
+
+    static ErrorOr<ByteBuffer> decompress(ReadonlyBytes bytes, u8 initial_code_size, i32 offset_for_size_change, InputMayBeTruncated input_may_be_truncated)
+    {
+        auto memory_stream = make<FixedMemoryStream>(bytes);
+        auto lzw_stream = make<InputStream>(MaybeOwned<Stream>(move(memory_stream)));
+        LzwDecompressor lzw_decompressor { MaybeOwned<InputStream> { move(lzw_stream) }, initial_code_size, offset_for_size_change };
+
+        ByteBuffer decompressed;
+
+        u16 const clear_code = lzw_decompressor.add_control_code();
+        u16 const end_of_data_code = lzw_decompressor.add_control_code();
+
+        while (true) {
+            auto code_or_error = lzw_decompressor.next_code();
+            if (code_or_error.is_error()) {
+                if (input_may_be_truncated == InputMayBeTruncated::Yes)
+                    break;
+                return code_or_error.release_error();
+            }
+            auto const code = code_or_error.release_value();
+
+            if (code == clear_code) {
+                lzw_decompressor.reset();
+                continue;
+            }
+
+            if (code == end_of_data_code)
+                break;
+
+            TRY(decompressed.try_append(lzw_decompressor.get_output()));
+        }
+
+        return decompressed;
+    }
+
     MaybeOwned<InputStream> m_bit_stream;
 
     u16 m_current_code { 0 };
@@ -5,10 +5,12 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/ByteReader.h>
 #include <AK/MemoryStream.h>
 #include <LibCompress/Lzma2.h>
 #include <LibCompress/Xz.h>
 #include <LibCrypto/Checksum/CRC32.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 namespace Compress {
 
@@ -793,6 +795,189 @@ ErrorOr<Bytes> XzDecompressor::read_some(Bytes bytes)
     return result;
 }
 
+// Walks the streams from the back, following the Backward Size in each Stream Footer to its Index (2.1.2.2.), whose
+// Records list the sizes of the Blocks before it (4.3.).
+ErrorOr<Vector<XzDecompressor::BlockLocation>> XzDecompressor::locate_blocks(ReadonlyBytes input)
+{
+    Vector<Vector<BlockLocation>> streams;
+
+    auto is_stream_padding = [&](size_t end) {
+        return end >= 4 && input.slice(end - 4, 4) == Array<u8, 4> {}.span();
+    };
+
+    size_t end_of_stream = input.size();
+    while (is_stream_padding(end_of_stream))
+        end_of_stream -= 4;
+
+    while (true) {
+        if (end_of_stream < sizeof(XzStreamHeader) + sizeof(XzStreamFooter))
+            return Error::from_string_literal("XZ stream is too small to contain a header and a footer");
+
+        XzStreamFooter stream_footer;
+        input.slice(end_of_stream - sizeof(XzStreamFooter), sizeof(XzStreamFooter)).copy_to({ &stream_footer, sizeof(stream_footer) });
+        TRY(stream_footer.validate());
+
+        auto end_of_index = end_of_stream - sizeof(XzStreamFooter);
+        if (stream_footer.backward_size() > end_of_index - sizeof(XzStreamHeader))
+            return Error::from_string_literal("XZ index size is larger than the stream");
+        auto start_of_index = end_of_index - stream_footer.backward_size();
+        auto index = input.slice(start_of_index, stream_footer.backward_size());
+
+        // 4.5. CRC32
+        auto index_without_crc32 = index.trim(index.size() - sizeof(u32));
+        if (Crypto::Checksum::CRC32(index_without_crc32).digest() != ByteReader::load32(index.offset_pointer(index_without_crc32.size())))
+            return Error::from_string_literal("XZ index has an invalid CRC32 checksum");
+
+        FixedMemoryStream index_stream { index_without_crc32 };
+
+        // 4.1. Index Indicator
+        if (TRY(index_stream.read_value<u8>()) != 0x00)
+            return Error::from_string_literal("XZ index does not start with an index indicator");
+
+        // 4.2. Number of Records
+        u64 const number_of_records = TRY(index_stream.read_value<XzMultibyteInteger>());
+        if (number_of_records > index.size())
+            return Error::from_string_literal("XZ index lists more records than fit into it");
+
+        Vector<BlockLocation> blocks;
+        TRY(blocks.try_ensure_capacity(number_of_records));
+        u64 size_of_blocks = 0;
+        for (u64 i = 0; i < number_of_records; i++) {
+            // 4.3. List of Records
+            u64 const unpadded_size = TRY(index_stream.read_value<XzMultibyteInteger>());
+            u64 const uncompressed_size = TRY(index_stream.read_value<XzMultibyteInteger>());
+            if (unpadded_size < 5)
+                return Error::from_string_literal("XZ index contains a record with an unpadded size of less than five");
+            if (unpadded_size > start_of_index)
+                return Error::from_string_literal("XZ index contains a record that is larger than the stream");
+
+            blocks.unchecked_append({ .offset = size_of_blocks, .unpadded_size = unpadded_size, .uncompressed_size = uncompressed_size });
+
+            // 3.3. Block Padding
+            size_of_blocks += align_up_to(unpadded_size, 4);
+            if (size_of_blocks > start_of_index)
+                return Error::from_string_literal("XZ index contains records that are larger than the stream");
+        }
+
+        // 4.4. Index Padding
+        while (!index_stream.is_eof()) {
+            if (TRY(index_stream.read_value<u8>()) != 0)
+                return Error::from_string_literal("XZ index contains a non-null padding byte");
+        }
+
+        if (size_of_blocks + sizeof(XzStreamHeader) > start_of_index)
+            return Error::from_string_literal("XZ index contains records that are larger than the stream");
+        auto start_of_stream = start_of_index - size_of_blocks - sizeof(XzStreamHeader);
+
+        XzStreamHeader stream_header;
+        input.slice(start_of_stream, sizeof(XzStreamHeader)).copy_to({ &stream_header, sizeof(stream_header) });
+        TRY(stream_header.validate());
+
+        // 2.1.2.3. Stream Flags
+        if (ReadonlyBytes { &stream_header.flags, sizeof(XzStreamFlags) } != ReadonlyBytes { &stream_footer.flags, sizeof(XzStreamFlags) })
+            return Error::from_string_literal("XZ stream header flags don't match the stream footer");
+
+        for (auto& block : blocks) {
+            block.stream_flags = stream_header.flags;
+            block.offset += start_of_stream + sizeof(XzStreamHeader);
+        }
+        TRY(streams.try_append(move(blocks)));
+
+        if (start_of_stream == 0)
+            break;
+
+        // 2.2. Stream Padding
+        end_of_stream = start_of_stream;
+        while (is_stream_padding(end_of_stream))
+            end_of_stream -= 4;
+        if (end_of_stream == 0)
+            return Error::from_string_literal("XZ data starts with stream padding");
+    }
+
+    Vector<BlockLocation> blocks;
+    u64 uncompressed_offset = 0;
+    for (auto& stream : streams.in_reverse()) {
+        for (auto& block : stream) {
+            block.uncompressed_offset = uncompressed_offset;
+            if (Checked<u64>::addition_would_overflow(uncompressed_offset, block.uncompressed_size))
+                return Error::from_string_literal("XZ data is too large");
+            uncompressed_offset += block.uncompressed_size;
+            TRY(blocks.try_append(block));
+        }
+    }
+    return blocks;
+}
+
+ErrorOr<void> XzDecompressor::decompress_block(ReadonlyBytes input, BlockLocation const& block, Bytes output)
+{
+    auto block_data = input.slice(block.offset, align_up_to(block.unpadded_size, 4));
+    auto decompressor = TRY(XzDecompressor::create(TRY(try_make<FixedMemoryStream>(block_data))));
+    decompressor->m_stream_flags = block.stream_flags;
+    decompressor->m_found_first_stream_header = true;
+
+    auto const encoded_block_header_size = TRY(decompressor->m_stream->read_value<u8>());
+    if (encoded_block_header_size == 0x00)
+        return Error::from_string_literal("XZ index lists a block where there is none");
+    TRY(decompressor->load_next_block(encoded_block_header_size));
+
+    auto& block_stream = *decompressor->m_current_block_stream;
+    size_t uncompressed_size = 0;
+    while (!block_stream->is_eof()) {
+        if (uncompressed_size == output.size()) {
+            u8 extra_byte = 0;
+            if (!TRY(block_stream->read_some({ &extra_byte, 1 })).is_empty())
+                return Error::from_string_literal("Uncompressed size of XZ Block does not match the Index");
+            continue;
+        }
+        uncompressed_size += TRY(block_stream->read_some(output.slice(uncompressed_size))).size();
+    }
+    decompressor->m_current_block_uncompressed_size = uncompressed_size;
+    TRY(decompressor->finish_current_block());
+
+    if (uncompressed_size != block.uncompressed_size)
+        return Error::from_string_literal("Uncompressed size of XZ Block does not match the Index");
+    if (decompressor->m_processed_blocks.first().unpadded_size != block.unpadded_size)
+        return Error::from_string_literal("Unpadded size of XZ Block does not match the Index");
+
+    return {};
+}
+
+ErrorOr<ByteBuffer> XzDecompressor::decompress_all(ReadonlyBytes input)
+{
+    auto blocks_or_error = locate_blocks(input);
+    if (blocks_or_error.is_error()) {
+        // Decoding the data front to back reports problems at the place where they occur.
+        auto decompressor = TRY(XzDecompressor::create(TRY(try_make<FixedMemoryStream>(input))));
+        return decompressor->read_until_eof();
+    }
+    auto blocks = blocks_or_error.release_value();
+
+    u64 total_uncompressed_size = blocks.is_empty() ? 0 : blocks.last().uncompressed_offset + blocks.last().uncompressed_size;
+    if (total_uncompressed_size > NumericLimits<size_t>::max())
+        return Error::from_string_literal("XZ data is too large");
+    auto output = TRY(ByteBuffer::create_uninitialized(total_uncompressed_size));
+
+    struct BlockJob {
+        BlockLocation location;
+        ErrorOr<void> result {};
+    };
+
+    Vector<BlockJob> jobs;
+    TRY(jobs.try_ensure_capacity(blocks.size()));
+    for (auto const& block : blocks)
+        jobs.unchecked_append({ block });
+
+    Threading::parallel_for(jobs.span(), 1, [&](Span<BlockJob> slice) {
+        for (auto& job : slice)
+            job.result = decompress_block(input, job.location, output.bytes().slice(job.location.uncompressed_offset, job.location.uncompressed_size));
+    });
+
+    for (auto& job : jobs)
+        TRY(move(job.result));
+
+    return output;
+}
+
 ErrorOr<size_t> XzDecompressor::write_some(ReadonlyBytes)
 {
     return Error::from_errno(EBADF);
@@ -156,6 +156,10 @@ class XzDecompressor : public Stream {
 public:
     static ErrorOr<NonnullOwnPtr<XzDecompressor>> create(MaybeOwned<Stream>);
 
+    // Decompresses XZ data that is completely in memory. The index at the end of each stream lists the sizes of its
+    // blocks, so the blocks can be found without decoding the ones before them, and are decoded on multiple threads.
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes);
+
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
     virtual bool is_eof() const override;
@@ -165,6 +169,16 @@ public:
 private:
     XzDecompressor(NonnullOwnPtr<CountingStream>);
 
+    struct BlockLocation {
+        XzStreamFlags stream_flags {};
+        u64 offset {};
+        u64 unpadded_size {};
+        u64 uncompressed_offset {};
+        u64 uncompressed_size {};
+    };
+    static ErrorOr<Vector<BlockLocation>> locate_blocks(ReadonlyBytes);
+    static ErrorOr<void> decompress_block(ReadonlyBytes, BlockLocation const&, Bytes output);
+
     ErrorOr<bool> load_next_stream();
     ErrorOr<void> load_next_block(u8 encoded_block_header_size);
     ErrorOr<void> finish_current_block();
@@ -15,10 +15,8 @@
 
 namespace Compress {
 
-ErrorOr<NonnullOwnPtr<ZlibDecompressor>> ZlibDecompressor::create(MaybeOwned<Stream> stream)
+ErrorOr<void> ZlibDecompressor::validate_header(ZlibHeader header)
 {
-    auto header = TRY(stream->read_value<ZlibHeader>());
-
     if (header.compression_method != ZlibCompressionMethod::Deflate || header.compression_info > 7)
         return Error::from_string_literal("Non-DEFLATE compression inside Zlib is not supported");
 
@@ -28,6 +26,14 @@ ErrorOr<NonnullOwnPtr<ZlibDecompressor>> ZlibDecompressor::create(MaybeOwned<Str
     if (header.as_u16 % 31 != 0)
         return Error::from_string_literal("Zlib error correction code does not match");
 
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<ZlibDecompressor>> ZlibDecompressor::create(MaybeOwned<Stream> stream)
+{
+    auto header = TRY(stream->read_value<ZlibHeader>());
+    TRY(validate_header(header));
+
     auto bit_stream = make<LittleEndianInputBitStream>(move(stream));
     auto deflate_stream = TRY(Compress::DeflateDecompressor::construct(move(bit_stream)));
 
@@ -40,6 +46,16 @@ ZlibDecompressor::ZlibDecompressor(ZlibHeader header, NonnullOwnPtr<Stream> stre
 {
 }
 
+ErrorOr<ByteBuffer> ZlibDecompressor::decompress_all(ReadonlyBytes bytes, size_t expected_size)
+{
+    FixedMemoryStream stream { bytes };
+    auto header = TRY(stream.read_value<ZlibHeader>());
+    TRY(validate_header(header));
+
+    // FIXME: Check the Adler-32 checksum at the end, like the stream interface should as well.
+    return DeflateDecompressor::decompress_all(bytes.slice(sizeof(ZlibHeader)), expected_size);
+}
+
 ErrorOr<Bytes> ZlibDecompressor::read_some(Bytes bytes)
 {
     return m_stream->read_some(bytes);
@@ -64,13 +80,18 @@ void ZlibDecompressor::close()
 {
 }
 
+// FIXME: Find a way to compress with Deflate's "Best" compression level.
+static DeflateCompressor::CompressionLevel deflate_compression_level(ZlibCompressionLevel compression_level)
+{
+    return static_cast<DeflateCompressor::CompressionLevel>(compression_level);
+}
+
 ErrorOr<NonnullOwnPtr<ZlibCompressor>> ZlibCompressor::construct(MaybeOwned<Stream> stream, ZlibCompressionLevel compression_level)
 {
     // Zlib only defines Deflate as a compression method.
     auto compression_method = ZlibCompressionMethod::Deflate;
 
-    // FIXME: Find a way to compress with Deflate's "Best" compression level.
-    auto compressor_stream = TRY(DeflateCompressor::construct(MaybeOwned(*stream), static_cast<DeflateCompressor::CompressionLevel>(compression_level)));
+    auto compressor_stream = TRY(DeflateCompressor::construct(MaybeOwned(*stream), deflate_compression_level(compression_level)));
 
     auto zlib_compressor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ZlibCompressor(move(stream), move(compressor_stream))));
     TRY(zlib_compressor->write_header(compression_method, compression_level));
@@ -89,7 +110,7 @@ ZlibCompressor::~ZlibCompressor()
     VERIFY(m_finished);
 }
 
-ErrorOr<void> ZlibCompressor::write_header(ZlibCompressionMethod compression_method, ZlibCompressionLevel compression_level)
+ZlibHeader ZlibCompressor::create_header(ZlibCompressionMethod compression_method, ZlibCompressionLevel compression_level)
 {
     u8 compression_info = 0;
     if (compression_method == ZlibCompressionMethod::Deflate) {
@@ -105,9 +126,13 @@ ErrorOr<void> ZlibCompressor::write_header(ZlibCompressionMethod compression_met
         .compression_level = compression_level,
     };
     header.check_bits = 0b11111 - header.as_u16 % 31;
+    return header;
+}
 
+ErrorOr<void> ZlibCompressor::write_header(ZlibCompressionMethod compression_method, ZlibCompressionLevel compression_level)
+{
     // FIXME: Support pre-defined dictionaries.
-
+    auto header = create_header(compression_method, compression_level);
     TRY(m_output_stream->write_value(header.as_u16));
 
     return {};
@@ -168,4 +193,28 @@ ErrorOr<ByteBuffer> ZlibCompressor::compress_all(ReadonlyBytes bytes, ZlibCompre
     return output_stream->read_until_eof();
 }
 
+ErrorOr<ByteBuffer> ZlibCompressor::compress_chunk(ReadonlyBytes chunk, bool is_last_chunk, ZlibCompressionLevel compression_level)
+{
+    return DeflateCompressor::compress_chunk(chunk, is_last_chunk, deflate_compression_level(compression_level));
+}
+
+ErrorOr<ByteBuffer> ZlibCompressor::create_from_compressed_chunks(ReadonlySpan<ByteBuffer> compressed_chunks, ReadonlyBytes uncompressed_bytes, ZlibCompressionLevel compression_level)
+{
+    size_t size = sizeof(ZlibHeader) + sizeof(u32);
+    for (auto const& chunk : compressed_chunks)
+        size += chunk.size();
+
+    ByteBuffer output;
+    TRY(output.try_ensure_capacity(size));
+
+    auto header = create_header(ZlibCompressionMethod::Deflate, compression_level);
+    output.append(&header.as_u16, sizeof(header.as_u16));
+    for (auto const& chunk : compressed_chunks)
+        output.append(chunk);
+
+    NetworkOrdered<u32> adler_sum = Crypto::Checksum::Adler32(uncompressed_bytes).digest();
+    output.append(&adler_sum, sizeof(adler_sum));
+    return output;
+}
+
 }
@@ -48,6 +48,9 @@ class ZlibDecompressor : public Stream {
 public:
     static ErrorOr<NonnullOwnPtr<ZlibDecompressor>> create(MaybeOwned<Stream>);
 
+    // Decompresses a complete zlib stream in one go. See DeflateDecompressor::decompress_all().
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes, size_t expected_size = 0);
+
     virtual ErrorOr<Bytes> read_some(Bytes) override;
     virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
     virtual bool is_eof() const override;
@@ -57,6 +60,8 @@ public:
 private:
     ZlibDecompressor(ZlibHeader, NonnullOwnPtr<Stream>);
 
+    static ErrorOr<void> validate_header(ZlibHeader);
+
     ZlibHeader m_header;
     NonnullOwnPtr<Stream> m_stream;
 };
@@ -75,8 +80,14 @@ public:
 
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, ZlibCompressionLevel = ZlibCompressionLevel::Default);
 
+    // Large inputs can be split into chunks that are compressed independently of each other (e.g. in parallel), at the
+    // cost of a slightly larger output. See DeflateCompressor::compress_chunk().
+    static ErrorOr<ByteBuffer> compress_chunk(ReadonlyBytes chunk, bool is_last_chunk, ZlibCompressionLevel = ZlibCompressionLevel::Default);
+    static ErrorOr<ByteBuffer> create_from_compressed_chunks(ReadonlySpan<ByteBuffer> compressed_chunks, ReadonlyBytes uncompressed_bytes, ZlibCompressionLevel = ZlibCompressionLevel::Default);
+
 private:
     ZlibCompressor(MaybeOwned<Stream> stream, NonnullOwnPtr<Stream> compressor_stream);
+    static ZlibHeader create_header(ZlibCompressionMethod, ZlibCompressionLevel);
     ErrorOr<void> write_header(ZlibCompressionMethod, ZlibCompressionLevel);
 
     bool m_finished { false };
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/AsyncSocketStream.h>
+#include <LibCore/EventLoop.h>
+
+namespace Core {
+
+struct AsyncSocketStream::ReadinessAwaiter {
+    bool await_ready() const { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { awaiter = handle; }
+    void await_resume() { }
+
+    std::coroutine_handle<>& awaiter;
+};
+
+namespace {
+
+// Resumes the coroutine on the next iteration of the event loop.
+struct YieldAwaiter {
+    bool await_ready() const { return false; }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        Core::deferred_invoke([handle] { handle.resume(); });
+    }
+    void await_resume() { }
+};
+
+}
+
+AsyncSocketStream::AsyncSocketStream(MaybeOwned<Socket> socket)
+    : m_socket(move(socket))
+{
+    m_socket->on_ready_to_read = [this] {
+        if (m_read_awaiter)
+            exchange(m_read_awaiter, {}).resume();
+    };
+}
+
+AsyncSocketStream::~AsyncSocketStream()
+{
+    VERIFY(!m_read_awaiter);
+    if (is_open())
+        shut_down();
+}
+
+void AsyncSocketStream::shut_down()
+{
+    m_is_open = false;
+    m_socket->on_ready_to_read = nullptr;
+    if (m_socket.is_owned())
+        m_socket->close();
+}
+
+void AsyncSocketStream::reset()
+{
+    VERIFY(is_open());
+    shut_down();
+    if (m_read_awaiter)
+        exchange(m_read_awaiter, {}).resume();
+}
+
+Coroutine<ErrorOr<void>> AsyncSocketStream::close()
+{
+    VERIFY(is_open());
+    VERIFY(!m_read_awaiter);
+
+    if (!m_buffer.is_empty()) {
+        reset();
+        co_return Error::from_errno(EBUSY);
+    }
+
+    shut_down();
+    co_return {};
+}
+
+ErrorOr<Optional<bool>> AsyncSocketStream::try_enqueue()
+{
+    if (!m_socket->is_eof() && !TRY(m_socket->can_read_without_blocking()))
+        return Optional<bool> {};
+
+    auto nread_or_error = m_buffer.enqueue_synchronously(16 * KiB, [&](Bytes bytes) -> ErrorOr<size_t> {
+        return TRY(m_socket->read_some(bytes)).size();
+    });
+    if (nread_or_error.is_error()) {
+        if (nread_or_error.error().is_errno() && nread_or_error.error().code() == EAGAIN)
+            return Optional<bool> {};
+        return nread_or_error.release_error();
+    }
+
+    if (nread_or_error.value() > 0)
+        return true;
+    if (m_socket->is_eof())
+        return false;
+
+    // The socket had something to read, but nothing for us, like a TLS record without application data.
+    return Optional<bool> {};
+}
+
+Coroutine<ErrorOr<bool>> AsyncSocketStream::enqueue_some(Badge<AsyncInputStream>)
+{
+    VERIFY(is_open());
+    VERIFY(!m_read_awaiter);
+
+    for (;;) {
+        auto result = try_enqueue();
+        if (result.is_error()) {
+            reset();
+            co_return result.release_error();
+        }
+        if (result.value().has_value())
+            co_return result.value().value();
+
+        co_await ReadinessAwaiter { m_read_awaiter };
+        if (!is_open())
+            co_return Error::from_errno(ECANCELED);
+    }
+}
+
+Coroutine<ErrorOr<size_t>> AsyncSocketStream::write_some(ReadonlyBytes bytes)
+{
+    VERIFY(is_open());
+
+    for (;;) {
+        auto nwritten_or_error = m_socket->write_some(bytes);
+        if (!nwritten_or_error.is_error())
+            co_return nwritten_or_error.release_value();
+
+        // Sockets don't tell us when they become writable again, so try again once the event loop has had a chance
+        // to run everything else.
+        if (nwritten_or_error.error().is_errno() && nwritten_or_error.error().code() == EAGAIN) {
+            co_await YieldAwaiter {};
+            if (!is_open())
+                co_return Error::from_errno(ECANCELED);
+            continue;
+        }
+
+        reset();
+        co_return nwritten_or_error.release_error();
+    }
+}
+
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AsyncStream.h>
+#include <AK/MaybeOwned.h>
+#include <AK/StreamBuffer.h>
+#include <LibCore/Socket.h>
+
+namespace Core {
+
+// An AsyncStream over a Core::Socket, including sockets that wrap other sockets like TLS::TLSv12 and BufferedSocket.
+//
+// Reads go straight into the stream buffer once the socket says it is readable, and only wait for on_ready_to_read
+// if the socket has nothing to read yet. A socket that isn't owned by the stream stays open when the stream is reset
+// or closed, so that connections can be reused for the next request.
+class AsyncSocketStream final : public AsyncStream {
+public:
+    explicit AsyncSocketStream(MaybeOwned<Socket>);
+    virtual ~AsyncSocketStream() override;
+
+    virtual void reset() override;
+    virtual Coroutine<ErrorOr<void>> close() override;
+    virtual bool is_open() const override { return m_is_open; }
+
+    virtual Coroutine<ErrorOr<bool>> enqueue_some(Badge<AsyncInputStream>) override;
+    virtual ReadonlyBytes buffered_data_unchecked(Badge<AsyncInputStream>) const override { return m_buffer.data(); }
+    virtual void dequeue(Badge<AsyncInputStream>, size_t bytes) override { m_buffer.dequeue(bytes); }
+
+    virtual Coroutine<ErrorOr<size_t>> write_some(ReadonlyBytes) override;
+
+private:
+    struct ReadinessAwaiter;
+
+    // Returns whether anything was read, or an empty Optional if the socket has to be waited for.
+    ErrorOr<Optional<bool>> try_enqueue();
+    void shut_down();
+
+    MaybeOwned<Socket> m_socket;
+    StreamBuffer m_buffer;
+    std::coroutine_handle<> m_read_awaiter;
+    bool m_is_open { true };
+};
+
+}
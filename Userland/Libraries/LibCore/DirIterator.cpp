@@ -11,6 +11,11 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 
+#ifdef AK_OS_SERENITY
+#    include <Kernel/API/DirectoryEntryWithStat.h>
+#    include <serenity.h>
+#endif
+
 namespace Core {
 
 DirIterator::DirIterator(ByteString path, Flags flags)
@@ -37,6 +42,11 @@ DirIterator::DirIterator(DirIterator&& other)
     , m_next(move(other.m_next))
     , m_path(move(other.m_path))
     , m_flags(other.m_flags)
+#ifdef AK_OS_SERENITY
+    , m_batched_entries(move(other.m_batched_entries))
+    , m_batched_entries_offset(other.m_batched_entries_offset)
+    , m_batched_entries_unavailable(other.m_batched_entries_unavailable)
+#endif
 {
     other.m_dir = nullptr;
 }
@@ -48,28 +58,94 @@ static constexpr bool dirent_has_d_type =
     true;
 #endif
 
+#ifdef AK_OS_SERENITY
+ErrorOr<ByteBuffer> DirIterator::fetch_batched_entries()
+{
+    // The kernel wants to fit the whole directory into the buffer, so keep growing it until it does.
+    size_t buffer_size = 16 * KiB;
+    while (true) {
+        auto buffer = TRY(ByteBuffer::create_uninitialized(buffer_size));
+        auto nread = get_dir_entries_with_stat(dirfd(m_dir), buffer.data(), buffer.size());
+        if (nread >= 0) {
+            buffer.resize(nread);
+            return buffer;
+        }
+        if (errno != EINVAL)
+            return Error::from_errno(errno);
+        buffer_size *= 2;
+    }
+}
+#endif
+
+bool DirIterator::read_next_entry()
+{
+#ifdef AK_OS_SERENITY
+    if ((m_flags & Flags::WithStat) && !m_batched_entries_unavailable) {
+        if (!m_batched_entries.has_value()) {
+            auto entries_or_error = fetch_batched_entries();
+            if (entries_or_error.is_error()) {
+                // We can still get there the slow way.
+                dbgln("DirIterator: Falling back to stat'ing every entry: {}", entries_or_error.error());
+                m_batched_entries_unavailable = true;
+                return read_next_entry();
+            }
+            m_batched_entries = entries_or_error.release_value();
+        }
+
+        if (m_batched_entries_offset >= m_batched_entries->size())
+            return false;
+        auto const& entry = *reinterpret_cast<DirectoryEntryWithStat const*>(m_batched_entries->data() + m_batched_entries_offset);
+        m_batched_entries_offset += entry.total_size();
+
+        m_next = DirectoryEntry {
+            .type = DirectoryEntry::directory_entry_type_from_posix(entry.file_type),
+            .name = ByteString { entry.name, entry.name_length },
+            .inode_number = entry.inode,
+        };
+        if (entry.stat_error == 0) {
+            m_next->stat = entry.stat;
+            m_next->type = DirectoryEntry::directory_entry_type_from_stat(entry.stat.st_mode);
+        }
+        return true;
+    }
+#endif
+
+    errno = 0;
+    auto* de = readdir(m_dir);
+    if (!de) {
+        if (errno != 0) {
+            m_error = Error::from_errno(errno);
+            dbgln("DirIteration error: {}", m_error.value());
+        }
+        return false;
+    }
+
+    if constexpr (dirent_has_d_type)
+        m_next = DirectoryEntry::from_dirent(*de);
+    else
+        m_next = DirectoryEntry::from_stat(m_dir, *de);
+
+    if (m_flags & Flags::WithStat) {
+        struct stat statbuf;
+        if (fstatat(dirfd(m_dir), de->d_name, &statbuf, AT_SYMLINK_NOFOLLOW) == 0) {
+            m_next->stat = statbuf;
+            m_next->type = DirectoryEntry::directory_entry_type_from_stat(statbuf.st_mode);
+        }
+    }
+    return true;
+}
+
 bool DirIterator::advance_next()
 {
     if (!m_dir)
         return false;
 
     while (true) {
-        errno = 0;
-        auto* de = readdir(m_dir);
-        if (!de) {
-            if (errno != 0) {
-                m_error = Error::from_errno(errno);
-                dbgln("DirIteration error: {}", m_error.value());
-            }
+        if (!read_next_entry()) {
             m_next.clear();
             return false;
         }
 
-        if constexpr (dirent_has_d_type)
-            m_next = DirectoryEntry::from_dirent(*de);
-        else
-            m_next = DirectoryEntry::from_stat(m_dir, *de);
-
         if (m_next->name.is_empty())
             return false;
 
@@ -86,7 +162,7 @@ bool DirIterator::advance_next()
             // the calling code will be given the raw unknown type.
             if ((m_flags & Flags::NoStat) == 0 && m_next->type == DirectoryEntry::Type::Unknown) {
                 struct stat statbuf;
-                if (fstatat(dirfd(m_dir), de->d_name, &statbuf, AT_SYMLINK_NOFOLLOW) < 0) {
+                if (fstatat(dirfd(m_dir), m_next->name.characters(), &statbuf, AT_SYMLINK_NOFOLLOW) < 0) {
                     m_error = Error::from_errno(errno);
                     dbgln("DirIteration error: {}", m_error.value());
                     return false;
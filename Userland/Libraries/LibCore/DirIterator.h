@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
 #include <LibCore/DirectoryEntry.h>
 #include <dirent.h>
@@ -21,6 +22,9 @@ public:
         SkipDots = 0x1,
         SkipParentAndBaseDir = 0x2,
         NoStat = 0x4,
+        // Fills in DirectoryEntry::stat as well. Where the system supports it, the metadata of
+        // the whole directory is fetched at once instead of calling lstat() for every entry.
+        WithStat = 0x8,
     };
 
     explicit DirIterator(ByteString path, Flags = Flags::NoFlags);
@@ -43,8 +47,16 @@ private:
     Optional<DirectoryEntry> m_next;
     ByteString m_path;
     int m_flags;
+#ifdef AK_OS_SERENITY
+    Optional<ByteBuffer> m_batched_entries;
+    size_t m_batched_entries_offset { 0 };
+    bool m_batched_entries_unavailable { false };
+
+    ErrorOr<ByteBuffer> fetch_batched_entries();
+#endif
 
     bool advance_next();
+    bool read_next_entry();
 };
 
 }
@@ -83,7 +83,7 @@ DirectoryEntry::Type DirectoryEntry::directory_entry_type_from_stat(mode_t st_mo
 }
 
 #if !defined(AK_OS_SOLARIS) && !defined(AK_OS_HAIKU)
-static DirectoryEntry::Type directory_entry_type_from_posix(unsigned char dt_constant)
+DirectoryEntry::Type DirectoryEntry::directory_entry_type_from_posix(unsigned char dt_constant)
 {
     switch (dt_constant) {
     case DT_UNKNOWN:
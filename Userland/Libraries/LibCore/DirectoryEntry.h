@@ -7,8 +7,10 @@
 #pragma once
 
 #include <AK/ByteString.h>
+#include <AK/Optional.h>
 #include <AK/StringView.h>
 #include <dirent.h>
+#include <sys/stat.h>
 
 namespace Core {
 
@@ -28,10 +30,15 @@ struct DirectoryEntry {
     // FIXME: Once we have a special Path string class, use that.
     ByteString name;
     ino_t inode_number;
+    // Only filled in when iterating with DirIterator::WithStat, and left empty if lstat() failed.
+    Optional<struct stat> stat;
 
     static StringView posix_name_from_directory_entry_type(Type);
     static StringView representative_name_from_directory_entry_type(Type);
     static Type directory_entry_type_from_stat(mode_t st_mode);
+#if !defined(AK_OS_SOLARIS) && !defined(AK_OS_HAIKU)
+    static Type directory_entry_type_from_posix(unsigned char dt_constant);
+#endif
     static DirectoryEntry from_dirent(dirent const&);
     static DirectoryEntry from_stat(DIR*, dirent const&);
 };
@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/BinaryHeap.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/Singleton.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Time.h>
@@ -48,6 +50,21 @@ bool has_flag(int value, int flag)
     return (value & flag) == flag;
 }
 
+// NOTE: The EPOLL* bits have the same values as the matching POLL* bits, so this works for both.
+NotificationType notification_type_from_poll_revents(int revents)
+{
+    NotificationType type = NotificationType::None;
+    if (has_flag(revents, POLLIN))
+        type |= NotificationType::Read;
+    if (has_flag(revents, POLLOUT))
+        type |= NotificationType::Write;
+    if (has_flag(revents, POLLHUP))
+        type |= NotificationType::Read | NotificationType::HangUp;
+    if (has_flag(revents, POLLERR))
+        type |= NotificationType::Error;
+    return type;
+}
+
 class EventLoopTimeout {
 public:
     static constexpr ssize_t INVALID_INDEX = NumericLimits<ssize_t>::max();
@@ -171,9 +188,12 @@ private:
 
 class EventLoopTimer final : public EventLoopTimeout {
 public:
-    EventLoopTimer() = default;
-
-    void reload(MonotonicTime const& now) { m_fire_time = now + interval; }
+    EventLoopTimer(Duration interval, MonotonicTime now)
+        : interval(interval)
+        , m_nominal_fire_time(now + interval)
+    {
+        m_fire_time = coalesced_fire_time();
+    }
 
     virtual void fire(TimeoutSet& timeout_set, MonotonicTime current_time) override
     {
@@ -183,11 +203,12 @@ public:
             return;
 
         if (should_reload) {
-            MonotonicTime next_fire_time = m_fire_time + interval;
+            MonotonicTime next_fire_time = m_nominal_fire_time + interval;
             if (next_fire_time <= current_time) {
                 next_fire_time = current_time + interval;
             }
-            m_fire_time = next_fire_time;
+            m_nominal_fire_time = next_fire_time;
+            m_fire_time = coalesced_fire_time();
             if (next_fire_time != current_time) {
                 timeout_set.schedule_absolute(this);
             } else {
@@ -215,6 +236,28 @@ public:
     WeakPtr<EventReceiver> owner;
     pthread_t owner_thread { 0 };
     Atomic<bool> is_being_deleted { false };
+
+private:
+    // Timers with long intervals don't mind firing a little late, so their fire times are rounded up to a multiple of
+    // a power-of-two number of milliseconds, up to 1/16th of their interval. Timers all over the process then expire
+    // together, and the event loop wakes up once for all of them instead of once for each.
+    MonotonicTime coalesced_fire_time() const
+    {
+        static constexpr i64 max_slack_ms = 256;
+
+        auto slack_ms = min(interval.to_truncated_milliseconds() / 16, max_slack_ms);
+        if (slack_ms < 2)
+            return m_nominal_fire_time;
+
+        i64 granularity_ns = (1ll << (8 * sizeof(u64) - 1 - count_leading_zeroes(static_cast<u64>(slack_ms)))) * 1'000'000;
+        auto remainder_ns = m_nominal_fire_time.nanoseconds() % granularity_ns;
+        if (remainder_ns == 0)
+            return m_nominal_fire_time;
+        return m_nominal_fire_time + Duration::from_nanoseconds(granularity_ns - remainder_ns);
+    }
+
+    // When the timer should fire without coalescing, so that reloading timers don't drift.
+    MonotonicTime m_nominal_fire_time;
 };
 
 struct ThreadData {
@@ -280,18 +323,68 @@ struct ThreadData {
 
         wake_pipe_fds = result.release_value();
 
+#ifdef AK_OS_SERENITY
+        // A forked child must not share the interest list of its parent, so it always gets a new one.
+        if (epoll_fd != -1)
+            close(epoll_fd);
+        auto epoll_fd_or_error = Core::System::epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd_or_error.is_error()) {
+            warnln("\033[31;1mFailed to create event loop epoll:\033[0m {}", epoll_fd_or_error.error());
+            VERIFY_NOT_REACHED();
+        }
+        epoll_fd = epoll_fd_or_error.release_value();
+
+        // The wake pipe informs us of POSIX signals as well as manual calls to wake()
+        VERIFY(notifiers_by_fd.is_empty());
+        epoll_event wake_event {};
+        wake_event.events = EPOLLIN;
+        wake_event.data.fd = wake_pipe_fds[0];
+        MUST(Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_pipe_fds[0], &wake_event));
+#else
         // The wake pipe informs us of POSIX signals as well as manual calls to wake()
         VERIFY(poll_fds.size() == 0);
         poll_fds.append({ .fd = wake_pipe_fds[0], .events = POLLIN, .revents = 0 });
         notifier_by_index.append(nullptr);
+#endif
+    }
+
+#ifdef AK_OS_SERENITY
+    void update_notifier_interest(int fd)
+    {
+        auto notifiers = notifiers_by_fd.get(fd);
+        if (!notifiers.has_value() || notifiers->is_empty()) {
+            notifiers_by_fd.remove(fd);
+            // The file descriptor may have been closed already, which takes it off the interest list by itself.
+            (void)Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            return;
+        }
+
+        epoll_event event {};
+        for (auto* notifier : *notifiers)
+            event.events |= notification_type_to_poll_events(notifier->type());
+        event.data.fd = fd;
+
+        auto result = Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+        if (result.is_error() && result.error().code() == ENOENT)
+            result = Core::System::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+        if (result.is_error())
+            dbgln("EventLoopImplementationUnix: Failed to watch fd {}: {}", fd, result.error());
     }
+#endif
 
     // Each thread has its own timers, notifiers and a wake pipe.
     TimeoutSet timeouts;
 
+#ifdef AK_OS_SERENITY
+    // The notifiers live in a persistent interest list, so waiting doesn't get slower with every notifier.
+    int epoll_fd { -1 };
+    HashMap<int, Vector<Notifier*, 1>> notifiers_by_fd;
+    Array<epoll_event, 64> ready_events;
+#else
     Vector<pollfd> poll_fds;
     HashMap<Notifier*, size_t> notifier_by_ptr;
     Vector<Notifier*> notifier_by_index;
+#endif
 
     // The wake pipe is used to notify another event loop that someone has called wake(), or a signal has been received.
     // wake() writes 0i32 into the pipe, signals write the signal number (guaranteed non-zero).
@@ -383,7 +476,11 @@ retry:
 
 try_select_again:
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
+#ifdef AK_OS_SERENITY
+    ErrorOr<int> error_or_marked_fd_count = System::epoll_wait(thread_data.epoll_fd, thread_data.ready_events, should_wait_forever ? -1 : timeout);
+#else
     ErrorOr<int> error_or_marked_fd_count = System::poll(thread_data.poll_fds, should_wait_forever ? -1 : timeout);
+#endif
     auto time_after_poll = MonotonicTime::now_coarse();
     // Because POSIX, we might spuriously return from select() with EINTR; just select again.
     if (error_or_marked_fd_count.is_error()) {
@@ -393,9 +490,18 @@ try_select_again:
         VERIFY_NOT_REACHED();
     }
 
+#ifdef AK_OS_SERENITY
+    auto ready_events = thread_data.ready_events.span().trim(error_or_marked_fd_count.value());
+    bool woke_from_wake_pipe = any_of(ready_events, [&](auto& event) {
+        return event.data.fd == thread_data.wake_pipe_fds[0] && has_flag(event.events, EPOLLIN);
+    });
+#else
+    bool woke_from_wake_pipe = has_flag(thread_data.poll_fds[0].revents, POLLIN);
+#endif
+
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
-    if (has_flag(thread_data.poll_fds[0].revents, POLLIN)) {
+    if (woke_from_wake_pipe) {
         int wake_events[8];
         ssize_t nread;
         // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
@@ -426,25 +532,26 @@ try_select_again:
 
     if (error_or_marked_fd_count.value() != 0) {
         // Handle file system notifiers by making them normal events.
+#ifdef AK_OS_SERENITY
+        for (auto& event : ready_events) {
+            auto notifiers = thread_data.notifiers_by_fd.get(event.data.fd);
+            if (!notifiers.has_value())
+                continue;
+
+            for (auto* notifier : *notifiers) {
+                auto type = notification_type_from_poll_revents(event.events) & notifier->type();
+                if (type != NotificationType::None)
+                    ThreadEventQueue::current().post_event(*notifier, make<NotifierActivationEvent>(notifier->fd(), type));
+            }
+        }
+#else
         for (size_t i = 1; i < thread_data.poll_fds.size(); ++i) {
-            auto& revents = thread_data.poll_fds[i].revents;
             auto& notifier = *thread_data.notifier_by_index[i];
-
-            NotificationType type = NotificationType::None;
-            if (has_flag(revents, POLLIN))
-                type |= NotificationType::Read;
-            if (has_flag(revents, POLLOUT))
-                type |= NotificationType::Write;
-            if (has_flag(revents, POLLHUP))
-                type |= NotificationType::Read | NotificationType::HangUp;
-            if (has_flag(revents, POLLERR))
-                type |= NotificationType::Error;
-
-            type &= notifier.type();
-
+            auto type = notification_type_from_poll_revents(thread_data.poll_fds[i].revents) & notifier.type();
             if (type != NotificationType::None)
                 ThreadEventQueue::current().post_event(notifier, make<NotifierActivationEvent>(notifier.fd(), type));
         }
+#endif
     }
 
     // Handle expired timers.
@@ -522,9 +629,13 @@ void EventLoopImplementationUnix::notify_forked_and_in_child()
 {
     auto& thread_data = ThreadData::the();
     thread_data.timeouts.clear();
+#ifdef AK_OS_SERENITY
+    thread_data.notifiers_by_fd.clear();
+#else
     thread_data.poll_fds.clear();
     thread_data.notifier_by_ptr.clear();
     thread_data.notifier_by_index.clear();
+#endif
     thread_data.initialize_wake_pipe();
     if (auto* info = signals_info<false>()) {
         info->signal_handlers.clear();
@@ -650,11 +761,9 @@ intptr_t EventLoopManagerUnix::register_timer(EventReceiver& object, int millise
 {
     VERIFY(milliseconds >= 0);
     auto& thread_data = ThreadData::the();
-    auto timer = new EventLoopTimer;
+    auto timer = new EventLoopTimer(Duration::from_milliseconds(milliseconds), MonotonicTime::now_coarse());
     timer->owner_thread = s_thread_id;
     timer->owner = object;
-    timer->interval = Duration::from_milliseconds(milliseconds);
-    timer->reload(MonotonicTime::now_coarse());
     timer->should_reload = should_reload;
     timer->fire_when_not_visible = fire_when_not_visible;
     thread_data.timeouts.schedule_absolute(timer);
@@ -680,6 +789,10 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
 {
     auto& thread_data = ThreadData::the();
 
+#ifdef AK_OS_SERENITY
+    thread_data.notifiers_by_fd.ensure(notifier.fd()).append(&notifier);
+    thread_data.update_notifier_interest(notifier.fd());
+#else
     thread_data.notifier_by_ptr.set(&notifier, thread_data.poll_fds.size());
     thread_data.notifier_by_index.append(&notifier);
     thread_data.poll_fds.append({
@@ -687,6 +800,7 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
         .events = notification_type_to_poll_events(notifier.type()),
         .revents = 0,
     });
+#endif
 
     notifier.set_owner_thread(s_thread_id);
 }
@@ -698,6 +812,13 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
         return;
 
     auto& thread_data = *thread_data_ptr;
+#ifdef AK_OS_SERENITY
+    auto notifiers = thread_data.notifiers_by_fd.get(notifier.fd());
+    VERIFY(notifiers.has_value());
+    auto did_remove = notifiers->remove_first_matching([&](auto* other) { return other == &notifier; });
+    VERIFY(did_remove);
+    thread_data.update_notifier_interest(notifier.fd());
+#else
     auto it = thread_data.notifier_by_ptr.find(&notifier);
     VERIFY(it != thread_data.notifier_by_ptr.end());
 
@@ -711,6 +832,7 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
     }
     thread_data.poll_fds.take_last();
     thread_data.notifier_by_index.take_last();
+#endif
 }
 
 void EventLoopManagerUnix::did_post_event()
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/ScopeGuard.h>
+#include <LibCore/IORing.h>
+#include <LibCore/System.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+
+namespace Core {
+
+class IORing::Operation {
+    AK_MAKE_NONCOPYABLE(Operation);
+    AK_MAKE_NONMOVABLE(Operation);
+
+public:
+    Operation(IORing& ring, IORingSubmission submission)
+        : m_ring(ring)
+        , m_submission(submission)
+    {
+        m_submission.user_data = reinterpret_cast<FlatPtr>(this);
+    }
+
+    bool await_ready() const { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        m_handle = handle;
+        m_ring.queue(*this);
+    }
+
+    ErrorOr<size_t> await_resume() const
+    {
+        if (m_result < 0)
+            return Error::from_errno(static_cast<int>(-m_result));
+        return static_cast<size_t>(m_result);
+    }
+
+    IORingSubmission const& submission() const { return m_submission; }
+
+    void complete(i64 result)
+    {
+        m_result = result;
+        exchange(m_handle, {}).resume();
+    }
+
+private:
+    IORing& m_ring;
+    IORingSubmission m_submission;
+    std::coroutine_handle<> m_handle;
+    i64 m_result { 0 };
+};
+
+IORing& IORing::the()
+{
+    // Never destroyed, since coroutines may still be waiting for their operations when the thread exits.
+    thread_local IORing* s_ring = nullptr;
+    if (!s_ring)
+        s_ring = MUST(create()).leak_ptr();
+    return *s_ring;
+}
+
+ErrorOr<NonnullOwnPtr<IORing>> IORing::create(u32 entries)
+{
+    auto fd = TRY(System::io_ring_create(entries, O_CLOEXEC));
+    auto size = io_ring_size(entries);
+    auto memory_or_error = System::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0, 0, "IORing"sv);
+    if (memory_or_error.is_error()) {
+        (void)System::close(fd);
+        return memory_or_error.release_error();
+    }
+    return adopt_nonnull_own_or_enomem(new (nothrow) IORing(fd, entries, static_cast<u8*>(memory_or_error.value()), size));
+}
+
+IORing::IORing(int fd, u32 entries, u8* memory, size_t size)
+    : m_fd(fd)
+    , m_entries(entries)
+    , m_memory(memory)
+    , m_size(size)
+    , m_notifier(Notifier::construct(fd, Notifier::Type::Read))
+{
+    // The ring becomes readable when completions are waiting to be reaped.
+    m_notifier->on_activation = [this] { reap_completions(); };
+}
+
+IORing::~IORing()
+{
+    // Whoever is waiting for an operation would never be resumed, and the kernel would write into buffers that are gone.
+    VERIFY(m_unsubmitted_count == 0 && m_overflow.is_empty());
+    m_notifier->close();
+    MUST(System::munmap(m_memory, m_size));
+    MUST(System::close(m_fd));
+}
+
+IORingSubmission& IORing::submission_at(u32 index)
+{
+    auto* submissions = reinterpret_cast<IORingSubmission*>(m_memory + header().submissions_offset);
+    return submissions[index & (m_entries - 1)];
+}
+
+IORingCompletion const& IORing::completion_at(u32 index)
+{
+    auto* completions = reinterpret_cast<IORingCompletion const*>(m_memory + header().completions_offset);
+    return completions[index & (io_ring_completion_entries(m_entries) - 1)];
+}
+
+void IORing::queue(Operation& operation)
+{
+    schedule_submission();
+
+    auto tail = header().submission_tail;
+    auto head = AK::atomic_load(&header().submission_head, AK::memory_order_acquire);
+    if (!m_overflow.is_empty() || tail - head == m_entries) {
+        m_overflow.append(&operation);
+        return;
+    }
+
+    submission_at(tail) = operation.submission();
+    AK::atomic_store(&header().submission_tail, tail + 1, AK::memory_order_release);
+    ++m_unsubmitted_count;
+}
+
+void IORing::schedule_submission()
+{
+    if (m_submission_scheduled)
+        return;
+    m_submission_scheduled = true;
+    m_notifier->deferred_invoke([this] {
+        m_submission_scheduled = false;
+        submit_queued_operations();
+    });
+}
+
+void IORing::submit_queued_operations()
+{
+    while (m_unsubmitted_count > 0) {
+        auto submitted_or_error = System::io_ring_enter(m_fd, m_unsubmitted_count, 0);
+        if (submitted_or_error.is_error()) {
+            auto code = submitted_or_error.error().code();
+            if (code == EINTR)
+                continue;
+            // Every completion slot is spoken for, so the rest has to wait until completions have been reaped.
+            if (code == EBUSY)
+                return;
+            dbgln("IORing: Failed to submit operations: {}", submitted_or_error.error());
+            VERIFY_NOT_REACHED();
+        }
+        m_unsubmitted_count -= submitted_or_error.value();
+
+        // Move operations that didn't fit into the space the kernel just made.
+        auto tail = header().submission_tail;
+        auto head = AK::atomic_load(&header().submission_head, AK::memory_order_acquire);
+        size_t moved_count = min<size_t>(m_overflow.size(), m_entries - (tail - head));
+        for (size_t i = 0; i < moved_count; ++i)
+            submission_at(tail++) = m_overflow[i]->submission();
+        AK::atomic_store(&header().submission_tail, tail, AK::memory_order_release);
+        m_overflow.remove(0, moved_count);
+        m_unsubmitted_count += moved_count;
+
+        if (submitted_or_error.value() == 0)
+            return;
+    }
+}
+
+void IORing::reap_completions()
+{
+    auto head = header().completion_head;
+    auto tail = AK::atomic_load(&header().completion_tail, AK::memory_order_acquire);
+
+    Vector<IORingCompletion, 32> completions;
+    completions.ensure_capacity(tail - head);
+    for (; head != tail; ++head)
+        completions.unchecked_append(completion_at(head));
+    AK::atomic_store(&header().completion_head, head, AK::memory_order_release);
+
+    // Reaping made room for operations that the kernel refused to take so far.
+    if (m_unsubmitted_count > 0)
+        schedule_submission();
+
+    // Resuming may start new operations, which is fine now that the completion ring is in a consistent state.
+    for (auto& completion : completions)
+        reinterpret_cast<Operation*>(static_cast<FlatPtr>(completion.user_data))->complete(completion.result);
+}
+
+static IORingSubmission make_submission(IORingOperation operation, int fd, i64 offset = 0, void const* buffer = nullptr, size_t length = 0, short poll_events = 0)
+{
+    return {
+        .operation = operation,
+        .reserved = 0,
+        .poll_events = static_cast<u16>(poll_events),
+        .fd = fd,
+        .offset = offset,
+        .buffer = reinterpret_cast<FlatPtr>(buffer),
+        .length = length,
+        .user_data = 0,
+    };
+}
+
+Coroutine<ErrorOr<size_t>> IORing::read(int fd, Bytes buffer, Optional<u64> offset)
+{
+    auto file_offset = offset.has_value() ? static_cast<i64>(*offset) : -1;
+    co_return co_await Operation(*this, make_submission(IORingOperation::Read, fd, file_offset, buffer.data(), buffer.size()));
+}
+
+Coroutine<ErrorOr<size_t>> IORing::write(int fd, ReadonlyBytes buffer, Optional<u64> offset)
+{
+    auto file_offset = offset.has_value() ? static_cast<i64>(*offset) : -1;
+    co_return co_await Operation(*this, make_submission(IORingOperation::Write, fd, file_offset, buffer.data(), buffer.size()));
+}
+
+Coroutine<ErrorOr<void>> IORing::fsync(int fd)
+{
+    CO_TRY(co_await Operation(*this, make_submission(IORingOperation::Fsync, fd)));
+    co_return {};
+}
+
+Coroutine<ErrorOr<short>> IORing::poll(int fd, short events)
+{
+    auto revents = CO_TRY(co_await Operation(*this, make_submission(IORingOperation::Poll, fd, 0, nullptr, 0, events)));
+    co_return static_cast<short>(revents);
+}
+
+Coroutine<ErrorOr<int>> IORing::accept(int fd, struct sockaddr* address, socklen_t* address_length, int flags)
+{
+    for (;;) {
+        auto new_fd_or_error = System::accept4(fd, address, address_length, flags);
+        if (!new_fd_or_error.is_error())
+            co_return new_fd_or_error.release_value();
+        if (new_fd_or_error.error().code() != EAGAIN && new_fd_or_error.error().code() != EINTR)
+            co_return new_fd_or_error.release_error();
+        CO_TRY(co_await poll(fd, POLLIN));
+    }
+}
+
+ErrorOr<NonnullOwnPtr<IORingStream>> IORingStream::adopt_fd(int fd, IORing& ring)
+{
+    if (fd < 0)
+        return Error::from_errno(EBADF);
+    return adopt_nonnull_own_or_enomem(new (nothrow) IORingStream(fd, ring));
+}
+
+IORingStream::~IORingStream()
+{
+    VERIFY(!m_is_reading && !m_is_writing);
+    if (is_open())
+        reset();
+}
+
+void IORingStream::reset()
+{
+    VERIFY(is_open());
+    // Operations that are still in flight finish with an error or get ignored, see enqueue_some() and write_some().
+    (void)System::close(exchange(m_fd, -1));
+}
+
+Coroutine<ErrorOr<void>> IORingStream::close()
+{
+    VERIFY(is_open());
+    VERIFY(!m_is_reading && !m_is_writing);
+
+    if (!m_buffer.is_empty()) {
+        reset();
+        co_return Error::from_errno(EBUSY);
+    }
+
+    auto result = System::close(exchange(m_fd, -1));
+    co_return result;
+}
+
+Coroutine<ErrorOr<bool>> IORingStream::enqueue_some(Badge<AsyncInputStream>)
+{
+    VERIFY(!m_is_reading);
+    m_is_reading = true;
+    ScopeGuard guard = [this] { m_is_reading = false; };
+
+    for (;;) {
+        // Reading goes straight into the stream buffer, the ring doesn't need a buffer of its own.
+        auto fd = m_fd;
+        auto nread_or_error = co_await m_buffer.enqueue(4096, [&](Bytes bytes) {
+            return m_ring.read(fd, bytes);
+        });
+        if (!is_open())
+            co_return Error::from_errno(ECANCELED);
+
+        if (nread_or_error.is_error() && nread_or_error.error().code() == EAGAIN) {
+            auto poll_result = co_await m_ring.poll(m_fd, POLLIN);
+            if (!is_open())
+                co_return Error::from_errno(ECANCELED);
+            if (!poll_result.is_error())
+                continue;
+            nread_or_error = poll_result.release_error();
+        }
+
+        if (nread_or_error.is_error()) {
+            reset();
+            co_return nread_or_error.release_error();
+        }
+        co_return nread_or_error.value() > 0;
+    }
+}
+
+Coroutine<ErrorOr<size_t>> IORingStream::write_some(ReadonlyBytes bytes)
+{
+    VERIFY(is_open());
+    VERIFY(!m_is_writing);
+    m_is_writing = true;
+    ScopeGuard guard = [this] { m_is_writing = false; };
+
+    for (;;) {
+        auto nwritten_or_error = co_await m_ring.write(m_fd, bytes);
+        if (!is_open())
+            co_return Error::from_errno(ECANCELED);
+
+        if (nwritten_or_error.is_error() && nwritten_or_error.error().code() == EAGAIN) {
+            auto poll_result = co_await m_ring.poll(m_fd, POLLOUT);
+            if (!is_open())
+                co_return Error::from_errno(ECANCELED);
+            if (!poll_result.is_error())
+                continue;
+            nwritten_or_error = poll_result.release_error();
+        }
+
+        if (nwritten_or_error.is_error()) {
+            reset();
+            co_return nwritten_or_error.release_error();
+        }
+        co_return nwritten_or_error.release_value();
+    }
+}
+
+}
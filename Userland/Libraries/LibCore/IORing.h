@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AsyncStream.h>
+#include <AK/Coroutine.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/StreamBuffer.h>
+#include <AK/Vector.h>
+#include <Kernel/API/IORing.h>
+#include <LibCore/Notifier.h>
+#include <sys/socket.h>
+
+namespace Core {
+
+// Asynchronous file and socket I/O for coroutines, on top of a kernel I/O ring (see Kernel/API/IORing.h).
+//
+// Operations that are started during an iteration of the event loop are handed to the kernel with a single
+// io_ring_enter() once the iteration is over, and the event loop wakes up once for all operations that finished
+// in the meantime. Buffers have to stay alive until the operation using them has finished.
+class IORing {
+    AK_MAKE_NONCOPYABLE(IORing);
+    AK_MAKE_NONMOVABLE(IORing);
+
+public:
+    static constexpr u32 default_entries = 256;
+
+    // The ring of the current thread, which is created on first use.
+    static IORing& the();
+
+    static ErrorOr<NonnullOwnPtr<IORing>> create(u32 entries = default_entries);
+    ~IORing();
+
+    // Reads at the given offset, or at (and advancing) the file offset if there is none.
+    Coroutine<ErrorOr<size_t>> read(int fd, Bytes, Optional<u64> offset = {});
+    Coroutine<ErrorOr<size_t>> write(int fd, ReadonlyBytes, Optional<u64> offset = {});
+    Coroutine<ErrorOr<void>> fsync(int fd);
+
+    // Waits until the file is ready for any of the events (POLLIN and/or POLLOUT), and returns the ones it is ready for.
+    Coroutine<ErrorOr<short>> poll(int fd, short events);
+
+    // Waits for a connection on a listening socket, which should be non-blocking, and accepts it.
+    Coroutine<ErrorOr<int>> accept(int fd, struct sockaddr* = nullptr, socklen_t* = nullptr, int flags = SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+private:
+    class Operation;
+
+    IORing(int fd, u32 entries, u8* memory, size_t size);
+
+    IORingHeader& header() { return *reinterpret_cast<IORingHeader*>(m_memory); }
+    IORingSubmission& submission_at(u32 index);
+    IORingCompletion const& completion_at(u32 index);
+
+    void queue(Operation&);
+    void schedule_submission();
+    void submit_queued_operations();
+    void reap_completions();
+
+    int m_fd { -1 };
+    u32 m_entries { 0 };
+    u8* m_memory { nullptr };
+    size_t m_size { 0 };
+
+    // Operations in the submission ring that the kernel hasn't taken yet.
+    u32 m_unsubmitted_count { 0 };
+    // Operations that didn't fit into the submission ring.
+    Vector<Operation*> m_overflow;
+    bool m_submission_scheduled { false };
+
+    NonnullRefPtr<Notifier> m_notifier;
+};
+
+// An AsyncStream over a file descriptor, which does all of its I/O through an IORing.
+class IORingStream final : public AsyncStream {
+public:
+    static ErrorOr<NonnullOwnPtr<IORingStream>> adopt_fd(int fd, IORing& = IORing::the());
+    virtual ~IORingStream() override;
+
+    virtual void reset() override;
+    virtual Coroutine<ErrorOr<void>> close() override;
+    virtual bool is_open() const override { return m_fd >= 0; }
+
+    virtual Coroutine<ErrorOr<bool>> enqueue_some(Badge<AsyncInputStream>) override;
+    virtual ReadonlyBytes buffered_data_unchecked(Badge<AsyncInputStream>) const override { return m_buffer.data(); }
+    virtual void dequeue(Badge<AsyncInputStream>, size_t bytes) override { m_buffer.dequeue(bytes); }
+
+    virtual Coroutine<ErrorOr<size_t>> write_some(ReadonlyBytes) override;
+
+private:
+    IORingStream(int fd, IORing& ring)
+        : m_fd(fd)
+        , m_ring(ring)
+    {
+    }
+
+    int m_fd { -1 };
+    IORing& m_ring;
+    StreamBuffer m_buffer;
+    bool m_is_reading { false };
+    bool m_is_writing { false };
+};
+
+}
@@ -33,6 +33,9 @@ public:
     Function<void(bool success)> on_finish;
     Function<void(Optional<u64>, u64)> on_progress;
 
+    // Called with every chunk of the response body after it has been written to the output stream.
+    Function<void(ReadonlyBytes)> on_data_written;
+
     bool is_cancelled() const { return m_error == Error::Cancelled; }
     bool has_error() const { return m_error != Error::None; }
     Error error() const { return m_error; }
@@ -62,7 +65,10 @@ protected:
     Coroutine<ErrorOr<size_t>> do_write(ReadonlyBytes bytes)
     {
         CO_TRY(co_await m_output_stream.wait_for_state(Core::Notifier::Type::Write));
-        co_return m_output_stream.write_some(bytes);
+        auto written = CO_TRY(m_output_stream.write_some(bytes));
+        if (on_data_written)
+            on_data_written(bytes.trim(written));
+        co_return written;
     }
 
 private:
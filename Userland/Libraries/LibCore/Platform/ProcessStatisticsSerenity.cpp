@@ -18,7 +18,7 @@ namespace Core::Platform {
 
 ErrorOr<void> update_process_statistics(ProcessStatistics& statistics)
 {
-    static auto proc_all_file = TRY(Core::File::open("/sys/kernel/processes"sv, Core::File::OpenMode::Read));
+    static auto proc_all_file = TRY(Core::ProcessStatisticsReader::open_statistics_file());
 
     auto const all_processes = TRY(Core::ProcessStatisticsReader::get_all(*proc_all_file, false));
 
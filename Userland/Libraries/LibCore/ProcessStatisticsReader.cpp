@@ -5,94 +5,343 @@
  */
 
 #include <AK/ByteBuffer.h>
-#include <AK/JsonArray.h>
-#include <AK/JsonObject.h>
-#include <AK/JsonValue.h>
+#include <AK/JsonReader.h>
+#include <Kernel/API/ProcessStatistics.h>
 #include <LibCore/File.h>
 #include <LibCore/ProcessStatisticsReader.h>
 #include <pwd.h>
+#include <string.h>
 
 namespace Core {
 
 HashMap<uid_t, ByteString> ProcessStatisticsReader::s_usernames;
 
-ErrorOr<AllProcessesStatistics> ProcessStatisticsReader::get_all(SeekableStream& proc_all_file, bool include_usernames)
+template<size_t N>
+static ByteString from_fixed_string(char const (&string)[N])
 {
-    TRY(proc_all_file.seek(0, SeekMode::SetPosition));
+    return ByteString(string, strnlen(string, N));
+}
+
+// Calls the callback with each key of the object whose BeginObject token was just read. The callback has to read or skip the value.
+template<typename Callback>
+static ErrorOr<void> for_each_member(JsonReader& reader, Callback callback)
+{
+    for (;;) {
+        auto key = TRY(reader.next());
+        if (key.type == JsonReader::TokenType::EndObject)
+            return {};
+        TRY(callback(key.text));
+    }
+}
+
+// Calls the callback after reading the BeginObject token of each object in the array that comes next.
+template<typename Callback>
+static ErrorOr<void> for_each_object_in_array(JsonReader& reader, Callback callback)
+{
+    if (TRY(reader.next()).type != JsonReader::TokenType::BeginArray)
+        return Error::from_string_literal("Expected a JSON array");
+    for (;;) {
+        auto token = TRY(reader.next());
+        if (token.type == JsonReader::TokenType::EndArray)
+            return {};
+        if (token.type != JsonReader::TokenType::BeginObject)
+            return Error::from_string_literal("Expected a JSON object");
+        TRY(callback());
+    }
+}
+
+static ErrorOr<JsonReader::Token> read_scalar(JsonReader& reader)
+{
+    auto token = TRY(reader.next());
+    if (token.type == JsonReader::TokenType::BeginObject || token.type == JsonReader::TokenType::BeginArray)
+        return Error::from_string_literal("Unexpected JSON object or array");
+    return token;
+}
+
+template<typename T>
+static ErrorOr<T> read_number(JsonReader& reader)
+{
+    return TRY(read_scalar(reader)).to_number<T>().value_or(0);
+}
+
+static ErrorOr<bool> read_bool(JsonReader& reader)
+{
+    return TRY(read_scalar(reader)).to_bool().value_or(false);
+}
+
+static ErrorOr<ByteString> read_string(JsonReader& reader)
+{
+    auto token = TRY(read_scalar(reader));
+    if (token.type != JsonReader::TokenType::String)
+        return ByteString::empty();
+    return token.to_byte_string();
+}
+
+static ErrorOr<Core::ThreadStatistics> read_thread(JsonReader& reader)
+{
+    Core::ThreadStatistics thread {};
+    TRY(for_each_member(reader, [&](StringView key) -> ErrorOr<void> {
+        if (key == "tid"sv)
+            thread.tid = TRY(read_number<u32>(reader));
+        else if (key == "times_scheduled"sv)
+            thread.times_scheduled = TRY(read_number<u32>(reader));
+        else if (key == "name"sv)
+            thread.name = TRY(read_string(reader));
+        else if (key == "state"sv)
+            thread.state = TRY(read_string(reader));
+        else if (key == "time_user"sv)
+            thread.time_user = TRY(read_number<u64>(reader));
+        else if (key == "time_kernel"sv)
+            thread.time_kernel = TRY(read_number<u64>(reader));
+        else if (key == "cpu"sv)
+            thread.cpu = TRY(read_number<u32>(reader));
+        else if (key == "migration_count"sv)
+            thread.migration_count = TRY(read_number<u32>(reader));
+        else if (key == "scheduling_latency_count"sv)
+            thread.scheduling_latency_count = TRY(read_number<u64>(reader));
+        else if (key == "scheduling_latency_total_ns"sv)
+            thread.scheduling_latency_total_ns = TRY(read_number<u64>(reader));
+        else if (key == "scheduling_latency_max_ns"sv)
+            thread.scheduling_latency_max_ns = TRY(read_number<u64>(reader));
+        else if (key == "priority"sv)
+            thread.priority = TRY(read_number<u32>(reader));
+        else if (key == "syscall_count"sv)
+            thread.syscall_count = TRY(read_number<u32>(reader));
+        else if (key == "inode_faults"sv)
+            thread.inode_faults = TRY(read_number<u32>(reader));
+        else if (key == "zero_faults"sv)
+            thread.zero_faults = TRY(read_number<u32>(reader));
+        else if (key == "cow_faults"sv)
+            thread.cow_faults = TRY(read_number<u32>(reader));
+        else if (key == "unix_socket_read_bytes"sv)
+            thread.unix_socket_read_bytes = TRY(read_number<u64>(reader));
+        else if (key == "unix_socket_write_bytes"sv)
+            thread.unix_socket_write_bytes = TRY(read_number<u64>(reader));
+        else if (key == "ipv4_socket_read_bytes"sv)
+            thread.ipv4_socket_read_bytes = TRY(read_number<u64>(reader));
+        else if (key == "ipv4_socket_write_bytes"sv)
+            thread.ipv4_socket_write_bytes = TRY(read_number<u64>(reader));
+        else if (key == "file_read_bytes"sv)
+            thread.file_read_bytes = TRY(read_number<u64>(reader));
+        else if (key == "file_write_bytes"sv)
+            thread.file_write_bytes = TRY(read_number<u64>(reader));
+        else
+            TRY(reader.skip_value());
+        return {};
+    }));
+    return thread;
+}
+
+static ErrorOr<Core::ProcessStatistics> read_process(JsonReader& reader)
+{
+    Core::ProcessStatistics process {};
+    TRY(for_each_member(reader, [&](StringView key) -> ErrorOr<void> {
+        if (key == "pid"sv)
+            process.pid = TRY(read_number<u32>(reader));
+        else if (key == "pgid"sv)
+            process.pgid = TRY(read_number<u32>(reader));
+        else if (key == "pgp"sv)
+            process.pgp = TRY(read_number<u32>(reader));
+        else if (key == "sid"sv)
+            process.sid = TRY(read_number<u32>(reader));
+        else if (key == "uid"sv)
+            process.uid = TRY(read_number<u32>(reader));
+        else if (key == "gid"sv)
+            process.gid = TRY(read_number<u32>(reader));
+        else if (key == "ppid"sv)
+            process.ppid = TRY(read_number<u32>(reader));
+        else if (key == "kernel"sv)
+            process.kernel = TRY(read_bool(reader));
+        else if (key == "name"sv)
+            process.name = TRY(read_string(reader));
+        else if (key == "executable"sv)
+            process.executable = TRY(read_string(reader));
+        else if (key == "tty"sv)
+            process.tty = TRY(read_string(reader));
+        else if (key == "pledge"sv)
+            process.pledge = TRY(read_string(reader));
+        else if (key == "veil"sv)
+            process.veil = TRY(read_string(reader));
+        else if (key == "creation_time"sv)
+            process.creation_time = UnixDateTime::from_nanoseconds_since_epoch(TRY(read_number<i64>(reader)));
+        else if (key == "amount_virtual"sv)
+            process.amount_virtual = TRY(read_number<u32>(reader));
+        else if (key == "amount_resident"sv)
+            process.amount_resident = TRY(read_number<u32>(reader));
+        else if (key == "amount_shared"sv)
+            process.amount_shared = TRY(read_number<u32>(reader));
+        else if (key == "amount_dirty_private"sv)
+            process.amount_dirty_private = TRY(read_number<u32>(reader));
+        else if (key == "amount_clean_inode"sv)
+            process.amount_clean_inode = TRY(read_number<u32>(reader));
+        else if (key == "amount_purgeable_volatile"sv)
+            process.amount_purgeable_volatile = TRY(read_number<u32>(reader));
+        else if (key == "amount_purgeable_nonvolatile"sv)
+            process.amount_purgeable_nonvolatile = TRY(read_number<u32>(reader));
+        else if (key == "threads"sv)
+            TRY(for_each_object_in_array(reader, [&]() -> ErrorOr<void> {
+                TRY(process.threads.try_append(TRY(read_thread(reader))));
+                return {};
+            }));
+        else
+            TRY(reader.skip_value());
+        return {};
+    }));
+    return process;
+}
+
+ErrorOr<AllProcessesStatistics> ProcessStatisticsReader::get_all_from_binary(ReadonlyBytes data, bool include_usernames)
+{
+    auto read_record = [&]<typename T>(size_t offset, T& record) -> ErrorOr<void> {
+        if (offset + sizeof(T) > data.size())
+            return Error::from_string_literal("Truncated process statistics");
+        memcpy(&record, data.offset_pointer(offset), sizeof(T));
+        return {};
+    };
+
+    ProcessStatisticsHeader header;
+    TRY(read_record(0, header));
+    if (header.version != PROCESS_STATISTICS_VERSION)
+        return Error::from_string_literal("Unsupported process statistics version");
 
     AllProcessesStatistics all_processes_statistics;
+    all_processes_statistics.total_time_scheduled = header.total_time;
+    all_processes_statistics.total_time_scheduled_kernel = header.total_time_kernel;
+
+    for (size_t offset = sizeof(header); offset < data.size();) {
+        ProcessStatisticsRecord record;
+        TRY(read_record(offset, record));
+        auto strings_size = static_cast<size_t>(record.executable_length) + record.pledge_length;
+        if (record.size < sizeof(record) + strings_size + record.thread_count * sizeof(ThreadStatisticsRecord) || offset + record.size > data.size())
+            return Error::from_string_literal("Invalid process statistics record");
 
-    auto file_contents = TRY(proc_all_file.read_until_eof());
-    auto json_obj = TRY(JsonValue::from_string(file_contents)).as_object();
-    json_obj.get_array("processes"sv)->for_each([&](auto& value) {
-        JsonObject const& process_object = value.as_object();
         Core::ProcessStatistics process;
+        process.pid = record.pid;
+        process.pgid = record.pgid;
+        process.pgp = record.pgp;
+        process.sid = record.sid;
+        process.uid = record.uid;
+        process.gid = record.gid;
+        process.ppid = record.ppid;
+        process.kernel = record.kernel;
+        process.name = from_fixed_string(record.name);
+        auto strings = data.slice(offset + sizeof(record), strings_size);
+        process.executable = ByteString(strings.trim(record.executable_length));
+        process.tty = from_fixed_string(record.tty);
+        process.pledge = ByteString(strings.slice(record.executable_length));
+        switch (record.veil) {
+        case ProcessStatisticsVeilState::None:
+            process.veil = process.kernel ? ""sv : "None"sv;
+            break;
+        case ProcessStatisticsVeilState::Dropped:
+            process.veil = "Dropped"sv;
+            break;
+        case ProcessStatisticsVeilState::Locked:
+            process.veil = "Locked"sv;
+            break;
+        }
+        process.creation_time = UnixDateTime::from_nanoseconds_since_epoch(record.creation_time_ns);
+        process.amount_virtual = record.amount_virtual;
+        process.amount_resident = record.amount_resident;
+        process.amount_shared = record.amount_shared;
+        process.amount_dirty_private = record.amount_dirty_private;
+        process.amount_clean_inode = record.amount_clean_inode;
+        process.amount_purgeable_volatile = record.amount_purgeable_volatile;
+        process.amount_purgeable_nonvolatile = record.amount_purgeable_nonvolatile;
 
-        // kernel data first
-        process.pid = process_object.get_u32("pid"sv).value_or(0);
-        process.pgid = process_object.get_u32("pgid"sv).value_or(0);
-        process.pgp = process_object.get_u32("pgp"sv).value_or(0);
-        process.sid = process_object.get_u32("sid"sv).value_or(0);
-        process.uid = process_object.get_u32("uid"sv).value_or(0);
-        process.gid = process_object.get_u32("gid"sv).value_or(0);
-        process.ppid = process_object.get_u32("ppid"sv).value_or(0);
-        process.kernel = process_object.get_bool("kernel"sv).value_or(false);
-        process.name = process_object.get_byte_string("name"sv).value_or("");
-        process.executable = process_object.get_byte_string("executable"sv).value_or("");
-        process.tty = process_object.get_byte_string("tty"sv).value_or("");
-        process.pledge = process_object.get_byte_string("pledge"sv).value_or("");
-        process.veil = process_object.get_byte_string("veil"sv).value_or("");
-        process.creation_time = UnixDateTime::from_nanoseconds_since_epoch(process_object.get_i64("creation_time"sv).value_or(0));
-        process.amount_virtual = process_object.get_u32("amount_virtual"sv).value_or(0);
-        process.amount_resident = process_object.get_u32("amount_resident"sv).value_or(0);
-        process.amount_shared = process_object.get_u32("amount_shared"sv).value_or(0);
-        process.amount_dirty_private = process_object.get_u32("amount_dirty_private"sv).value_or(0);
-        process.amount_clean_inode = process_object.get_u32("amount_clean_inode"sv).value_or(0);
-        process.amount_purgeable_volatile = process_object.get_u32("amount_purgeable_volatile"sv).value_or(0);
-        process.amount_purgeable_nonvolatile = process_object.get_u32("amount_purgeable_nonvolatile"sv).value_or(0);
-
-        auto& thread_array = process_object.get_array("threads"sv).value();
-        process.threads.ensure_capacity(thread_array.size());
-        thread_array.for_each([&](auto& value) {
-            auto& thread_object = value.as_object();
+        auto thread_offset = offset + sizeof(record) + align_up_to(strings_size, PROCESS_STATISTICS_RECORD_ALIGNMENT);
+        TRY(process.threads.try_ensure_capacity(record.thread_count));
+        for (size_t i = 0; i < record.thread_count; ++i, thread_offset += sizeof(ThreadStatisticsRecord)) {
+            ThreadStatisticsRecord thread_record;
+            TRY(read_record(thread_offset, thread_record));
             Core::ThreadStatistics thread;
-            thread.tid = thread_object.get_u32("tid"sv).value_or(0);
-            thread.times_scheduled = thread_object.get_u32("times_scheduled"sv).value_or(0);
-            thread.name = thread_object.get_byte_string("name"sv).value_or("");
-            thread.state = thread_object.get_byte_string("state"sv).value_or("");
-            thread.time_user = thread_object.get_u64("time_user"sv).value_or(0);
-            thread.time_kernel = thread_object.get_u64("time_kernel"sv).value_or(0);
-            thread.cpu = thread_object.get_u32("cpu"sv).value_or(0);
-            thread.priority = thread_object.get_u32("priority"sv).value_or(0);
-            thread.syscall_count = thread_object.get_u32("syscall_count"sv).value_or(0);
-            thread.inode_faults = thread_object.get_u32("inode_faults"sv).value_or(0);
-            thread.zero_faults = thread_object.get_u32("zero_faults"sv).value_or(0);
-            thread.cow_faults = thread_object.get_u32("cow_faults"sv).value_or(0);
-            thread.unix_socket_read_bytes = thread_object.get_u64("unix_socket_read_bytes"sv).value_or(0);
-            thread.unix_socket_write_bytes = thread_object.get_u64("unix_socket_write_bytes"sv).value_or(0);
-            thread.ipv4_socket_read_bytes = thread_object.get_u64("ipv4_socket_read_bytes"sv).value_or(0);
-            thread.ipv4_socket_write_bytes = thread_object.get_u64("ipv4_socket_write_bytes"sv).value_or(0);
-            thread.file_read_bytes = thread_object.get_u64("file_read_bytes"sv).value_or(0);
-            thread.file_write_bytes = thread_object.get_u64("file_write_bytes"sv).value_or(0);
-            process.threads.append(move(thread));
-        });
-
-        // and synthetic data last
-        if (include_usernames) {
+            thread.tid = thread_record.tid;
+            thread.times_scheduled = thread_record.times_scheduled;
+            thread.name = from_fixed_string(thread_record.name);
+            thread.state = from_fixed_string(thread_record.state);
+            thread.time_user = thread_record.time_user;
+            thread.time_kernel = thread_record.time_kernel;
+            thread.cpu = thread_record.cpu;
+            thread.migration_count = thread_record.migration_count;
+            thread.scheduling_latency_count = thread_record.scheduling_latency_count;
+            thread.scheduling_latency_total_ns = thread_record.scheduling_latency_total_ns;
+            thread.scheduling_latency_max_ns = thread_record.scheduling_latency_max_ns;
+            thread.priority = thread_record.priority;
+            thread.syscall_count = thread_record.syscall_count;
+            thread.inode_faults = thread_record.inode_faults;
+            thread.zero_faults = thread_record.zero_faults;
+            thread.cow_faults = thread_record.cow_faults;
+            thread.unix_socket_read_bytes = thread_record.unix_socket_read_bytes;
+            thread.unix_socket_write_bytes = thread_record.unix_socket_write_bytes;
+            thread.ipv4_socket_read_bytes = thread_record.ipv4_socket_read_bytes;
+            thread.ipv4_socket_write_bytes = thread_record.ipv4_socket_write_bytes;
+            thread.file_read_bytes = thread_record.file_read_bytes;
+            thread.file_write_bytes = thread_record.file_write_bytes;
+            process.threads.unchecked_append(move(thread));
+        }
+
+        if (include_usernames)
             process.username = username_from_uid(process.uid);
+        TRY(all_processes_statistics.processes.try_append(move(process)));
+        offset += record.size;
+    }
+
+    return all_processes_statistics;
+}
+
+ErrorOr<AllProcessesStatistics> ProcessStatisticsReader::get_all(SeekableStream& proc_all_file, bool include_usernames)
+{
+    TRY(proc_all_file.seek(0, SeekMode::SetPosition));
+
+    AllProcessesStatistics all_processes_statistics {};
+
+    auto file_contents = TRY(proc_all_file.read_until_eof());
+    if (file_contents.bytes().starts_with(StringView { PROCESS_STATISTICS_MAGIC, 8 }.bytes()))
+        return get_all_from_binary(file_contents.bytes(), include_usernames);
+
+    // Only a few fields of this potentially large document are needed, so read them without building a JsonValue tree.
+    JsonReader reader { file_contents };
+    if (TRY(reader.next()).type != JsonReader::TokenType::BeginObject)
+        return Error::from_string_literal("Expected a JSON object");
+
+    TRY(for_each_member(reader, [&](StringView key) -> ErrorOr<void> {
+        if (key == "total_time"sv) {
+            all_processes_statistics.total_time_scheduled = TRY(read_number<u64>(reader));
+        } else if (key == "total_time_kernel"sv) {
+            all_processes_statistics.total_time_scheduled_kernel = TRY(read_number<u64>(reader));
+        } else if (key == "processes"sv) {
+            TRY(for_each_object_in_array(reader, [&]() -> ErrorOr<void> {
+                auto process = TRY(read_process(reader));
+                // synthetic data last
+                if (include_usernames)
+                    process.username = username_from_uid(process.uid);
+                TRY(all_processes_statistics.processes.try_append(move(process)));
+                return {};
+            }));
+        } else {
+            TRY(reader.skip_value());
         }
-        all_processes_statistics.processes.append(move(process));
-    });
+        return {};
+    }));
+
+    // Make sure the rest of the document is valid as well.
+    if (TRY(reader.next()).type != JsonReader::TokenType::EndOfInput)
+        return Error::from_string_literal("Unexpected data after the JSON object");
 
-    all_processes_statistics.total_time_scheduled = json_obj.get_u64("total_time"sv).value_or(0);
-    all_processes_statistics.total_time_scheduled_kernel = json_obj.get_u64("total_time_kernel"sv).value_or(0);
     return all_processes_statistics;
 }
 
 ErrorOr<AllProcessesStatistics> ProcessStatisticsReader::get_all(bool include_usernames)
 {
-    auto proc_all_file = TRY(Core::File::open("/sys/kernel/processes"sv, Core::File::OpenMode::Read));
-    return get_all(*proc_all_file, include_usernames);
+    return get_all(*TRY(open_statistics_file()), include_usernames);
+}
+
+ErrorOr<NonnullOwnPtr<File>> ProcessStatisticsReader::open_statistics_file()
+{
+    // Prefer the binary format, but programs that have only unveiled /sys/kernel/processes can still use the JSON.
+    if (auto file = Core::File::open("/sys/kernel/process_statistics"sv, Core::File::OpenMode::Read); !file.is_error())
+        return file.release_value();
+    return Core::File::open("/sys/kernel/processes"sv, Core::File::OpenMode::Read);
 }
 
 ByteString ProcessStatisticsReader::username_from_uid(uid_t uid)
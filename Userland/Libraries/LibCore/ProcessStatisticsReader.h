@@ -9,6 +9,7 @@
 #include <AK/ByteString.h>
 #include <AK/Time.h>
 #include <AK/Vector.h>
+#include <LibCore/Forward.h>
 #include <unistd.h>
 
 namespace Core {
@@ -30,6 +31,10 @@ struct ThreadStatistics {
     u64 file_write_bytes;
     ByteString state;
     u32 cpu;
+    u32 migration_count;
+    u64 scheduling_latency_count;
+    u64 scheduling_latency_total_ns;
+    u64 scheduling_latency_max_ns;
     u32 priority;
     ByteString name;
 };
@@ -76,7 +81,12 @@ public:
     static ErrorOr<AllProcessesStatistics> get_all(SeekableStream&, bool include_usernames = true);
     static ErrorOr<AllProcessesStatistics> get_all(bool include_usernames = true);
 
+    // Opens /sys/kernel/process_statistics, or /sys/kernel/processes if that isn't available.
+    // Either one can be passed to get_all().
+    static ErrorOr<NonnullOwnPtr<File>> open_statistics_file();
+
 private:
+    static ErrorOr<AllProcessesStatistics> get_all_from_binary(ReadonlyBytes, bool include_usernames);
     static ByteString username_from_uid(uid_t);
     static HashMap<uid_t, ByteString> s_usernames;
 };
@@ -196,6 +196,8 @@ public:
     ErrorOr<void> set_blocking(bool enabled) override { return m_helper.set_blocking(enabled); }
     ErrorOr<void> set_close_on_exec(bool enabled) override { return m_helper.set_close_on_exec(enabled); }
 
+    int fd() const { return m_helper.fd(); }
+
     virtual ~TCPSocket() override { close(); }
 
 private:
@@ -223,6 +225,8 @@ public:
     static ErrorOr<NonnullOwnPtr<UDPSocket>> connect(ByteString const& host, u16 port, Optional<Duration> timeout = {});
     static ErrorOr<NonnullOwnPtr<UDPSocket>> connect(SocketAddress const& address, Optional<Duration> timeout = {});
 
+    int fd() const { return m_helper.fd(); }
+
     UDPSocket(UDPSocket&& other)
         : Socket(static_cast<Socket&&>(other))
         , m_helper(move(other.m_helper))
@@ -433,6 +437,9 @@ public:
 
     virtual size_t buffer_size() const override { return m_helper.buffer_size(); }
 
+    // Writes aren't buffered, so it's fine to bypass us and write to the underlying socket directly.
+    T& underlying_socket() { return m_helper.stream(); }
+
     virtual ~BufferedSocket() override = default;
 
 private:
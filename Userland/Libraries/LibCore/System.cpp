@@ -35,6 +35,7 @@
 #    include <serenity.h>
 #    include <sys/prctl.h>
 #    include <sys/ptrace.h>
+#    include <sys/sendfile.h>
 #    include <sys/sysmacros.h>
 #endif
 
@@ -395,6 +396,64 @@ ErrorOr<void> disown(pid_t pid)
     HANDLE_SYSCALL_RETURN_VALUE("disown", rc, {});
 }
 
+ErrorOr<int> io_ring_create(u32 entries, int options)
+{
+    int fd = ::io_ring_create(entries, options);
+    if (fd < 0)
+        return Error::from_syscall("io_ring_create"sv, -errno);
+    return fd;
+}
+
+ErrorOr<size_t> io_ring_enter(int fd, u32 to_submit, u32 min_complete)
+{
+    int rc = ::io_ring_enter(fd, to_submit, min_complete);
+    if (rc < 0)
+        return Error::from_syscall("io_ring_enter"sv, -errno);
+    return rc;
+}
+
+ErrorOr<size_t> syscall_batch(Span<syscall_batch_entry> entries)
+{
+    int rc = ::syscall_batch(entries.data(), entries.size());
+    if (rc < 0)
+        return Error::from_syscall("syscall_batch"sv, -errno);
+    return rc;
+}
+
+ErrorOr<size_t> read_file_batched(StringView path, Bytes buffer, struct stat* statbuf)
+{
+    if (!path.characters_without_null_termination())
+        return Error::from_syscall("open"sv, -EFAULT);
+
+    Syscall::SC_open_params params { AT_FDCWD, { path.characters_without_null_termination(), path.length() }, O_RDONLY | O_CLOEXEC, 0 };
+
+    // Every syscall after the open() gets the file descriptor as its first argument.
+    Array<syscall_batch_entry, 4> entries {};
+    Array<StringView, 4> names {};
+    size_t count = 0;
+    auto append = [&](StringView name, u32 function, int32_t arg1_from, uintptr_t arg2 = 0, uintptr_t arg3 = 0) {
+        names[count] = name;
+        entries[count++] = { function, arg1_from, { 0, arg2, arg3, 0 }, 0 };
+    };
+    append("open"sv, SC_open, -1);
+    entries[0].args[0] = bit_cast<uintptr_t>(&params);
+    if (statbuf)
+        append("fstat"sv, SC_fstat, 0, bit_cast<uintptr_t>(statbuf));
+    auto read_index = count;
+    append("read"sv, SC_read, 0, bit_cast<uintptr_t>(buffer.data()), buffer.size());
+    append("close"sv, SC_close, 0);
+
+    auto processed_count = TRY(syscall_batch(entries.span().trim(count)));
+    // Don't leak the file descriptor if a signal stopped the batch before the close().
+    if (processed_count < count && entries[0].result >= 0)
+        (void)::close(entries[0].result);
+    for (size_t i = 0; i < count; ++i) {
+        if (entries[i].result < 0)
+            return Error::from_syscall(names[i], entries[i].result);
+    }
+    return static_cast<size_t>(entries[read_index].result);
+}
+
 ErrorOr<void> profiling_enable(pid_t pid, u64 event_mask)
 {
     int rc = ::profiling_enable(pid, event_mask);
@@ -412,6 +471,30 @@ ErrorOr<void> profiling_free_buffer(pid_t pid)
     int rc = ::profiling_free_buffer(pid);
     HANDLE_SYSCALL_RETURN_VALUE("profiling_free_buffer", rc, {});
 }
+
+ErrorOr<size_t> sendfile(int out_fd, int in_fd, off_t* offset, size_t count)
+{
+    ssize_t rc = ::sendfile(out_fd, in_fd, offset, count);
+    if (rc < 0)
+        return Error::from_syscall("sendfile"sv, -errno);
+    return static_cast<size_t>(rc);
+}
+
+ErrorOr<size_t> copy_file_range(int fd_in, off_t* offset_in, int fd_out, off_t* offset_out, size_t length, unsigned flags)
+{
+    ssize_t rc = ::copy_file_range(fd_in, offset_in, fd_out, offset_out, length, flags);
+    if (rc < 0)
+        return Error::from_syscall("copy_file_range"sv, -errno);
+    return static_cast<size_t>(rc);
+}
+
+ErrorOr<size_t> splice(int fd_in, off_t* offset_in, int fd_out, off_t* offset_out, size_t length, unsigned flags)
+{
+    ssize_t rc = ::splice(fd_in, offset_in, fd_out, offset_out, length, flags);
+    if (rc < 0)
+        return Error::from_syscall("splice"sv, -errno);
+    return static_cast<size_t>(rc);
+}
 #endif
 
 #if !defined(AK_OS_BSD_GENERIC)
@@ -1770,6 +1853,31 @@ ErrorOr<int> poll(Span<struct pollfd> poll_fds, int timeout)
     return rc;
 }
 
+#ifdef AK_OS_SERENITY
+ErrorOr<int> epoll_create1(int flags)
+{
+    int fd = ::epoll_create1(flags);
+    if (fd < 0)
+        return Error::from_syscall("epoll_create1"sv, -errno);
+    return fd;
+}
+
+ErrorOr<void> epoll_ctl(int epfd, int op, int fd, struct epoll_event* event)
+{
+    if (::epoll_ctl(epfd, op, fd, event) < 0)
+        return Error::from_syscall("epoll_ctl"sv, -errno);
+    return {};
+}
+
+ErrorOr<int> epoll_wait(int epfd, Span<struct epoll_event> events, int timeout)
+{
+    int rc = ::epoll_wait(epfd, events.data(), events.size(), timeout);
+    if (rc < 0)
+        return Error::from_syscall("epoll_wait"sv, -errno);
+    return rc;
+}
+#endif
+
 #ifdef AK_OS_SERENITY
 ErrorOr<void> posix_fallocate(int fd, off_t offset, off_t length)
 {
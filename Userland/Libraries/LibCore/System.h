@@ -47,6 +47,8 @@
 
 #ifdef AK_OS_SERENITY
 #    include <Kernel/API/Unshare.h>
+#    include <serenity.h>
+#    include <sys/epoll.h>
 #endif
 
 namespace Core::System {
@@ -70,9 +72,18 @@ ErrorOr<void> remount(Optional<i32> vfs_context_id, StringView target, int flags
 ErrorOr<void> umount(Optional<i32> vfs_context_id, StringView mount_point);
 ErrorOr<long> ptrace(int request, pid_t tid, void* address, void* data);
 ErrorOr<void> disown(pid_t pid);
+ErrorOr<int> io_ring_create(u32 entries, int options);
+ErrorOr<size_t> io_ring_enter(int fd, u32 to_submit, u32 min_complete);
+ErrorOr<size_t> syscall_batch(Span<syscall_batch_entry>);
+// Opens, reads and closes the file (and fstat()s it if statbuf is given) with a single syscall_batch().
+// Reads at most buffer.size() bytes and returns how many were read.
+ErrorOr<size_t> read_file_batched(StringView path, Bytes buffer, struct stat* statbuf = nullptr);
 ErrorOr<void> profiling_enable(pid_t, u64 event_mask);
 ErrorOr<void> profiling_disable(pid_t);
 ErrorOr<void> profiling_free_buffer(pid_t);
+ErrorOr<size_t> sendfile(int out_fd, int in_fd, off_t* offset, size_t count);
+ErrorOr<size_t> copy_file_range(int fd_in, off_t* offset_in, int fd_out, off_t* offset_out, size_t length, unsigned flags = 0);
+ErrorOr<size_t> splice(int fd_in, off_t* offset_in, int fd_out, off_t* offset_out, size_t length, unsigned flags);
 #else
 inline ErrorOr<void> unveil(StringView, StringView)
 {
@@ -243,6 +254,12 @@ ErrorOr<void> access(StringView pathname, int mode, int flags = 0);
 ErrorOr<ByteString> readlink(StringView pathname);
 ErrorOr<int> poll(Span<struct pollfd>, int timeout);
 
+#ifdef AK_OS_SERENITY
+ErrorOr<int> epoll_create1(int flags);
+ErrorOr<void> epoll_ctl(int epfd, int op, int fd, struct epoll_event* event);
+ErrorOr<int> epoll_wait(int epfd, Span<struct epoll_event>, int timeout);
+#endif
+
 #ifdef AK_OS_SERENITY
 ErrorOr<void> create_block_device(StringView name, mode_t mode, unsigned major, unsigned minor);
 ErrorOr<void> create_char_device(StringView name, mode_t mode, unsigned major, unsigned minor);
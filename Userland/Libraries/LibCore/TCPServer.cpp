@@ -40,7 +40,7 @@ TCPServer::~TCPServer()
     MUST(Core::System::close(m_fd));
 }
 
-ErrorOr<void> TCPServer::listen(IPv4Address const& address, u16 port, AllowAddressReuse allow_address_reuse)
+ErrorOr<void> TCPServer::listen(IPv4Address const& address, u16 port, AllowAddressReuse allow_address_reuse, AllowPortReuse allow_port_reuse)
 {
     if (m_listening)
         return Error::from_errno(EADDRINUSE);
@@ -53,6 +53,11 @@ ErrorOr<void> TCPServer::listen(IPv4Address const& address, u16 port, AllowAddre
         TRY(Core::System::setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option)));
     }
 
+    if (allow_port_reuse == AllowPortReuse::Yes) {
+        int option = 1;
+        TRY(Core::System::setsockopt(m_fd, SOL_SOCKET, SO_REUSEPORT, &option, sizeof(option)));
+    }
+
     TRY(Core::System::bind(m_fd, (sockaddr const*)&in, sizeof(in)));
     TRY(Core::System::listen(m_fd, 5));
     m_listening = true;
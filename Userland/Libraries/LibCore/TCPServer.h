@@ -24,8 +24,13 @@ public:
         No,
     };
 
+    enum class AllowPortReuse {
+        Yes,
+        No,
+    };
+
     bool is_listening() const { return m_listening; }
-    ErrorOr<void> listen(IPv4Address const& address, u16 port, AllowAddressReuse = AllowAddressReuse::No);
+    ErrorOr<void> listen(IPv4Address const& address, u16 port, AllowAddressReuse = AllowAddressReuse::No, AllowPortReuse = AllowPortReuse::No);
     ErrorOr<void> set_blocking(bool blocking);
 
     ErrorOr<NonnullOwnPtr<TCPSocket>> accept();
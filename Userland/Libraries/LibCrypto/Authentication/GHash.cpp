@@ -5,7 +5,10 @@
  */
 
 #include <AK/ByteReader.h>
+#include <AK/CPUFeatures.h>
 #include <AK/Debug.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Types.h>
 #include <LibCrypto/Authentication/GHash.h>
 
@@ -31,26 +34,15 @@ GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
 {
     u32 tag[4] { 0, 0, 0, 0 };
 
-    auto transform_one = [&](auto& buf) {
-        size_t i = 0;
-        for (; i < buf.size(); i += 16) {
-            if (i + 16 <= buf.size()) {
-                for (auto j = 0; j < 4; ++j) {
-                    tag[j] ^= to_u32(buf.offset(i + j * 4));
-                }
-                galois_multiply(tag, m_key, tag);
-            }
-        }
+    auto transform_one = [&](ReadonlyBytes buf) {
+        auto whole_blocks_size = buf.size() - buf.size() % 16;
+        process_blocks(tag, buf.trim(whole_blocks_size));
 
-        if (i > buf.size()) {
+        if (whole_blocks_size < buf.size()) {
             u8 buffer[16] = {};
             Bytes buffer_bytes { buffer, 16 };
-            buf.slice(i - 16).copy_to(buffer_bytes);
-
-            for (auto j = 0; j < 4; ++j) {
-                tag[j] ^= to_u32(buffer_bytes.offset(j * 4));
-            }
-            galois_multiply(tag, m_key, tag);
+            buf.slice(whole_blocks_size).copy_to(buffer_bytes);
+            process_blocks(tag, buffer_bytes);
         }
     };
 
@@ -84,6 +76,126 @@ GHash::TagType GHash::process(ReadonlyBytes aad, ReadonlyBytes cipher)
     return digest;
 }
 
+template<>
+void GHash::process_blocks_impl<CPUFeatures::None>(u32 (&tag)[4], u32 const (&key)[4], ReadonlyBytes blocks)
+{
+    VERIFY(blocks.size() % 16 == 0);
+    for (size_t i = 0; i < blocks.size(); i += 16) {
+        for (auto j = 0; j < 4; ++j)
+            tag[j] ^= to_u32(blocks.offset(i + j * 4));
+        galois_multiply(tag, key, tag);
+    }
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_PCLMUL
+// Blocks are held with their first byte in the most significant byte of the vector, which makes the carry-less product
+// of two blocks the GHASH product (in its reflected bit order) shifted right by one bit.
+// See: Intel, "Intel Carry-Less Multiplication Instruction and its Usage for Computing the GCM Mode", Algorithm 1 and 5
+namespace {
+
+using illx2 = signed long long int __attribute__((vector_size(16)));
+using AK::SIMD::u32x4;
+
+struct UnreducedProduct {
+    u32x4 low;
+    u32x4 high;
+};
+
+template<int selector>
+[[gnu::target("pclmul")]] ALWAYS_INLINE static u32x4 carryless_multiply(u32x4 a, u32x4 b)
+{
+    return bit_cast<u32x4>(__builtin_ia32_pclmulqdq128(bit_cast<illx2>(a), bit_cast<illx2>(b), selector));
+}
+
+[[gnu::target("pclmul")]] ALWAYS_INLINE static UnreducedProduct multiply_unreduced(u32x4 a, u32x4 b)
+{
+    auto low = carryless_multiply<0x00>(a, b);
+    auto high = carryless_multiply<0x11>(a, b);
+    auto middle = carryless_multiply<0x10>(a, b) ^ carryless_multiply<0x01>(a, b);
+    low ^= u32x4 { 0, 0, middle[0], middle[1] };
+    high ^= u32x4 { middle[2], middle[3], 0, 0 };
+    return { low, high };
+}
+
+// Reduction is linear, so the products of several blocks can be added up and reduced once.
+[[gnu::target("pclmul")]] ALWAYS_INLINE static u32x4 reduce(UnreducedProduct product)
+{
+    auto low = product.low;
+    auto high = product.high;
+
+    // Undo the shift to the right that the reflected bit order causes.
+    auto low_carry = low >> 31;
+    auto high_carry = high >> 31;
+    low <<= 1;
+    high <<= 1;
+    low |= u32x4 { 0, low_carry[0], low_carry[1], low_carry[2] };
+    high |= u32x4 { low_carry[3], high_carry[0], high_carry[1], high_carry[2] };
+
+    // Reduce modulo x^128 + x^7 + x^2 + x + 1.
+    auto folded = (low << 31) ^ (low << 30) ^ (low << 25);
+    low ^= u32x4 { 0, 0, 0, folded[0] };
+    low ^= (low >> 1) ^ (low >> 2) ^ (low >> 7) ^ u32x4 { folded[1], folded[2], folded[3], 0 };
+    return high ^ low;
+}
+
+[[gnu::target("pclmul")]] ALWAYS_INLINE static u32x4 multiply(u32x4 a, u32x4 b)
+{
+    return reduce(multiply_unreduced(a, b));
+}
+
+ALWAYS_INLINE static u32x4 load_block(u8 const* data)
+{
+    return bit_cast<u32x4>(AK::SIMD::byte_reverse(AK::SIMD::load_unaligned<AK::SIMD::u8x16>(data)));
+}
+
+}
+
+template<>
+[[gnu::target("pclmul")]] void GHash::process_blocks_impl<CPUFeatures::X86_PCLMUL>(u32 (&tag)[4], u32 const (&key)[4], ReadonlyBytes blocks)
+{
+    VERIFY(blocks.size() % 16 == 0);
+
+    auto h = u32x4 { key[3], key[2], key[1], key[0] };
+    auto y = u32x4 { tag[3], tag[2], tag[1], tag[0] };
+    auto const* data = blocks.data();
+    auto const* end = data + blocks.size();
+
+    // Four blocks at a time: Y' = (Y + X1) * H^4 + X2 * H^3 + X3 * H^2 + X4 * H, with a single reduction. This keeps
+    // the multiplications independent of each other, so they don't have to wait for the previous one to finish.
+    if (end - data >= 4 * 16) {
+        auto h2 = multiply(h, h);
+        auto h3 = multiply(h2, h);
+        auto h4 = multiply(h3, h);
+        for (; end - data >= 4 * 16; data += 4 * 16) {
+            auto p1 = multiply_unreduced(y ^ load_block(data), h4);
+            auto p2 = multiply_unreduced(load_block(data + 16), h3);
+            auto p3 = multiply_unreduced(load_block(data + 32), h2);
+            auto p4 = multiply_unreduced(load_block(data + 48), h);
+            y = reduce({ p1.low ^ p2.low ^ p3.low ^ p4.low, p1.high ^ p2.high ^ p3.high ^ p4.high });
+        }
+    }
+
+    for (; data != end; data += 16)
+        y = multiply(y ^ load_block(data), h);
+
+    tag[0] = y[3];
+    tag[1] = y[2];
+    tag[2] = y[1];
+    tag[3] = y[0];
+}
+#endif
+
+decltype(GHash::process_blocks_dispatched) GHash::process_blocks_dispatched = [] {
+    CPUFeatures features = detect_cpu_features();
+
+    if constexpr (is_valid_feature(CPUFeatures::X86_PCLMUL)) {
+        if (has_flag(features, CPUFeatures::X86_PCLMUL))
+            return &GHash::process_blocks_impl<CPUFeatures::X86_PCLMUL>;
+    }
+
+    return &GHash::process_blocks_impl<CPUFeatures::None>;
+}();
+
 /// Galois Field multiplication using <x^127 + x^7 + x^2 + x + 1>.
 /// Note that x, y, and z are strictly BE.
 void galois_multiply(u32 (&_z)[4], u32 const (&_x)[4], u32 const (&_y)[4])
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/ByteReader.h>
+#include <AK/CPUFeatures.h>
 #include <AK/Endian.h>
 #include <AK/Types.h>
 #include <LibCrypto/Hash/HashFunction.h>
@@ -57,6 +58,13 @@ public:
     TagType process(ReadonlyBytes aad, ReadonlyBytes cipher);
 
 private:
+    // Folds whole 16-byte blocks into the tag.
+    template<CPUFeatures>
+    static void process_blocks_impl(u32 (&tag)[4], u32 const (&key)[4], ReadonlyBytes blocks);
+
+    static void (*const process_blocks_dispatched)(u32 (&tag)[4], u32 const (&key)[4], ReadonlyBytes blocks);
+    void process_blocks(u32 (&tag)[4], ReadonlyBytes blocks) const { return process_blocks_dispatched(tag, m_key, blocks); }
+
     u32 m_key[4];
 };
 
@@ -6,6 +6,7 @@
  */
 
 #include "UnsignedBigIntegerAlgorithms.h"
+#include <AK/BuiltinWrappers.h>
 
 namespace Crypto {
 
@@ -223,38 +224,60 @@ void UnsignedBigIntegerAlgorithms::montgomery_modular_power_with_minimal_allocat
     one.set_to(1);
     one.resize_with_leading_zeros(num_words);
 
-    // Compute the montgomery powers from 0 to 2^window_size. powers[i] = x^i
-    UnsignedBigInteger powers[1 << window_size];
-    almost_montgomery_multiplication_without_allocation(one, rr, modulo, temp_z, k, num_words, powers[0]);
-    almost_montgomery_multiplication_without_allocation(x, rr, modulo, temp_z, k, num_words, powers[1]);
-    for (size_t i = 2; i < (1 << window_size); ++i)
-        almost_montgomery_multiplication_without_allocation(powers[i - 1], powers[1], modulo, temp_z, k, num_words, powers[i]);
-
-    z.set_to(powers[0]);
-    z.resize_with_leading_zeros(num_words);
     zz.set_to(0);
     zz.resize_with_leading_zeros(num_words);
 
     ssize_t exponent_length = exponent.trimmed_length();
-    for (ssize_t word_in_exponent = exponent_length - 1; word_in_exponent >= 0; --word_in_exponent) {
-        UnsignedBigInteger::Word exponent_word = exponent.m_words[word_in_exponent];
-        size_t bit_in_word = 0;
-        while (bit_in_word < UnsignedBigInteger::BITS_IN_WORD) {
-            if (word_in_exponent != exponent_length - 1 || bit_in_word != 0) {
-                almost_montgomery_multiplication_without_allocation(z, z, modulo, temp_z, k, num_words, zz);
-                almost_montgomery_multiplication_without_allocation(zz, zz, modulo, temp_z, k, num_words, z);
-                almost_montgomery_multiplication_without_allocation(z, z, modulo, temp_z, k, num_words, zz);
-                almost_montgomery_multiplication_without_allocation(zz, zz, modulo, temp_z, k, num_words, z);
+    if (exponent_length == 1) {
+        // Short exponents (like the public exponent of RSA keys, which is usually 65537) have too few bits for the table
+        // of powers to pay off, so use plain square-and-multiply on the base. This also avoids allocating the table.
+        // Note: This branches on the bits of the exponent, so it must only be used for exponents that aren't secret.
+        UnsignedBigInteger::Word exponent_word = exponent.m_words[0];
+        auto& base_power = temp_extra;
+        almost_montgomery_multiplication_without_allocation(x, rr, modulo, temp_z, k, num_words, base_power);
+
+        z.set_to(base_power);
+        z.resize_with_leading_zeros(num_words);
+
+        ssize_t highest_bit = UnsignedBigInteger::BITS_IN_WORD - 1 - count_leading_zeroes(exponent_word);
+        for (ssize_t bit = highest_bit - 1; bit >= 0; --bit) {
+            almost_montgomery_multiplication_without_allocation(z, z, modulo, temp_z, k, num_words, zz);
+            if ((exponent_word >> bit) & 1)
+                almost_montgomery_multiplication_without_allocation(zz, base_power, modulo, temp_z, k, num_words, z);
+            else
+                swap(z, zz);
+        }
+    } else {
+        // Compute the montgomery powers from 0 to 2^window_size. powers[i] = x^i
+        UnsignedBigInteger powers[1 << window_size];
+        almost_montgomery_multiplication_without_allocation(one, rr, modulo, temp_z, k, num_words, powers[0]);
+        almost_montgomery_multiplication_without_allocation(x, rr, modulo, temp_z, k, num_words, powers[1]);
+        for (size_t i = 2; i < (1 << window_size); ++i)
+            almost_montgomery_multiplication_without_allocation(powers[i - 1], powers[1], modulo, temp_z, k, num_words, powers[i]);
+
+        z.set_to(powers[0]);
+        z.resize_with_leading_zeros(num_words);
+
+        for (ssize_t word_in_exponent = exponent_length - 1; word_in_exponent >= 0; --word_in_exponent) {
+            UnsignedBigInteger::Word exponent_word = exponent.m_words[word_in_exponent];
+            size_t bit_in_word = 0;
+            while (bit_in_word < UnsignedBigInteger::BITS_IN_WORD) {
+                if (word_in_exponent != exponent_length - 1 || bit_in_word != 0) {
+                    almost_montgomery_multiplication_without_allocation(z, z, modulo, temp_z, k, num_words, zz);
+                    almost_montgomery_multiplication_without_allocation(zz, zz, modulo, temp_z, k, num_words, z);
+                    almost_montgomery_multiplication_without_allocation(z, z, modulo, temp_z, k, num_words, zz);
+                    almost_montgomery_multiplication_without_allocation(zz, zz, modulo, temp_z, k, num_words, z);
+                }
+                auto power_index = exponent_word >> (UnsignedBigInteger::BITS_IN_WORD - window_size);
+                auto& power = powers[power_index];
+                almost_montgomery_multiplication_without_allocation(z, power, modulo, temp_z, k, num_words, zz);
+
+                swap(z, zz);
+
+                // Move to the next window
+                exponent_word <<= window_size;
+                bit_in_word += window_size;
             }
-            auto power_index = exponent_word >> (UnsignedBigInteger::BITS_IN_WORD - window_size);
-            auto& power = powers[power_index];
-            almost_montgomery_multiplication_without_allocation(z, power, modulo, temp_z, k, num_words, zz);
-
-            swap(z, zz);
-
-            // Move to the next window
-            exponent_word <<= window_size;
-            bit_in_word += window_size;
         }
     }
 
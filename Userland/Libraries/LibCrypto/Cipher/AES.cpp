@@ -724,6 +724,70 @@ template<>
 }
 #endif
 
+template<>
+void AESCipher::encrypt_blocks_impl<CPUFeatures::None>(ReadonlyBytes in, Bytes out)
+{
+    VERIFY(in.size() % block_size() == 0);
+    VERIFY(in.size() <= out.size());
+
+    AESCipherBlock block;
+    for (size_t offset = 0; offset < in.size(); offset += block_size()) {
+        block.overwrite(in.slice(offset, block_size()));
+        encrypt_block_impl<CPUFeatures::None>(block, block);
+        block.bytes().copy_to(out.slice(offset));
+    }
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_AES
+template<>
+[[gnu::target("aes")]] void AESCipher::encrypt_blocks_impl<CPUFeatures::X86_AES>(ReadonlyBytes in, Bytes out)
+{
+    using illx2 = signed long long int __attribute__((vector_size(16)));
+
+    // AESENC has a latency of several cycles, but a new one can be started every cycle. Working on this many independent
+    // blocks at once keeps the AES unit busy.
+    static constexpr size_t blocks_per_batch = 8;
+
+    VERIFY(in.size() % block_size() == 0);
+    VERIFY(in.size() <= out.size());
+
+    AESCipherKey const& key = m_key;
+    auto n_rounds = key.rounds();
+    illx2 round_keys[AESCipherKey::MAX_ROUND_COUNT + 1];
+    for (size_t i_round = 0; i_round <= n_rounds; ++i_round)
+        round_keys[i_round] = AK::SIMD::load_unaligned<illx2>(&key.round_keys()[i_round * 4]);
+
+    auto const* input_ptr = in.data();
+    auto* output_ptr = out.data();
+    auto block_count = in.size() / block_size();
+
+    for (; block_count >= blocks_per_batch; block_count -= blocks_per_batch) {
+        illx2 values[blocks_per_batch];
+        for (size_t i = 0; i < blocks_per_batch; ++i)
+            values[i] = AK::SIMD::load_unaligned<illx2>(input_ptr + i * 16) ^ round_keys[0];
+        for (size_t i_round = 1; i_round != n_rounds; ++i_round) {
+            for (size_t i = 0; i < blocks_per_batch; ++i)
+                values[i] = __builtin_ia32_aesenc128(values[i], round_keys[i_round]);
+        }
+        for (size_t i = 0; i < blocks_per_batch; ++i)
+            AK::SIMD::store_unaligned(output_ptr + i * 16, __builtin_ia32_aesenclast128(values[i], round_keys[n_rounds]));
+
+        input_ptr += blocks_per_batch * 16;
+        output_ptr += blocks_per_batch * 16;
+    }
+
+    for (; block_count > 0; --block_count) {
+        auto value = AK::SIMD::load_unaligned<illx2>(input_ptr) ^ round_keys[0];
+        for (size_t i_round = 1; i_round != n_rounds; ++i_round)
+            value = __builtin_ia32_aesenc128(value, round_keys[i_round]);
+        AK::SIMD::store_unaligned(output_ptr, __builtin_ia32_aesenclast128(value, round_keys[n_rounds]));
+
+        input_ptr += 16;
+        output_ptr += 16;
+    }
+}
+#endif
+
 decltype(AESCipher::encrypt_block_dispatched) AESCipher::encrypt_block_dispatched = [] {
     CPUFeatures features = detect_cpu_features();
 
@@ -746,6 +810,17 @@ decltype(AESCipher::decrypt_block_dispatched) AESCipher::decrypt_block_dispatche
     return &AESCipher::decrypt_block_impl<CPUFeatures::None>;
 }();
 
+decltype(AESCipher::encrypt_blocks_dispatched) AESCipher::encrypt_blocks_dispatched = [] {
+    CPUFeatures features = detect_cpu_features();
+
+    if constexpr (is_valid_feature(CPUFeatures::X86_AES)) {
+        if (has_flag(features, CPUFeatures::X86_AES))
+            return &AESCipher::encrypt_blocks_impl<CPUFeatures::X86_AES>;
+    }
+
+    return &AESCipher::encrypt_blocks_impl<CPUFeatures::None>;
+}();
+
 void AESCipherBlock::overwrite(ReadonlyBytes bytes)
 {
     auto data = bytes.data();
@@ -84,6 +84,8 @@ struct AESCipherKey : public CipherKey {
 
     virtual ~AESCipherKey() override = default;
 
+    static constexpr size_t MAX_ROUND_COUNT = 14;
+
     size_t rounds() const { return m_rounds; }
     size_t length() const { return m_bits / 8; }
 
@@ -102,7 +104,6 @@ private:
     static void (AESCipherKey::* const expand_encrypt_key_dispatched)(ReadonlyBytes user_key, size_t bits);
     static void (AESCipherKey::* const expand_decrypt_key_dispatched)(ReadonlyBytes user_key, size_t bits);
 
-    static constexpr size_t MAX_ROUND_COUNT = 14;
     u32 m_rd_keys[(MAX_ROUND_COUNT + 1) * 4] { 0 };
     size_t m_rounds;
     size_t m_bits;
@@ -128,6 +129,10 @@ public:
     virtual void encrypt_block(BlockType const& in, BlockType& out) override { return (this->*encrypt_block_dispatched)(in, out); }
     virtual void decrypt_block(BlockType const& in, BlockType& out) override { return (this->*decrypt_block_dispatched)(in, out); }
 
+    // Encrypts each block of the input on its own. Unlike encrypt_block(), this lets the hardware implementation work on
+    // several blocks at once, which is what CTR (and thus GCM) uses to generate its key stream.
+    void encrypt_blocks(ReadonlyBytes in, Bytes out) { return (this->*encrypt_blocks_dispatched)(in, out); }
+
 #ifndef KERNEL
     virtual ByteString class_name() const override
     {
@@ -143,9 +148,12 @@ private:
     void encrypt_block_impl(BlockType const& in, BlockType& out);
     template<CPUFeatures>
     void decrypt_block_impl(BlockType const& in, BlockType& out);
+    template<CPUFeatures>
+    void encrypt_blocks_impl(ReadonlyBytes in, Bytes out);
 
     static void (AESCipher::* const encrypt_block_dispatched)(BlockType const& in, BlockType& out);
     static void (AESCipher::* const decrypt_block_dispatched)(BlockType const& in, BlockType& out);
+    static void (AESCipher::* const encrypt_blocks_dispatched)(ReadonlyBytes in, Bytes out);
 };
 
 }
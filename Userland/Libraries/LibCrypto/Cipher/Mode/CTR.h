@@ -170,6 +170,35 @@ protected:
         size_t offset { 0 };
         auto block_size = cipher.block_size();
 
+        if constexpr (requires { cipher.encrypt_blocks(ReadonlyBytes {}, Bytes {}); }) {
+            // Generate the key stream for a batch of blocks at once, so the cipher can encrypt them in parallel.
+            static constexpr size_t blocks_per_batch = 8;
+            u8 key_stream_storage[blocks_per_batch * T::BlockType::block_size()];
+
+            while (length > 0) {
+                auto batch_size = min(length, sizeof(key_stream_storage));
+                auto block_count = ceil_div(batch_size, block_size);
+                Bytes key_stream { key_stream_storage, block_count * block_size };
+
+                for (size_t i = 0; i < block_count; ++i) {
+                    __builtin_memcpy(key_stream.offset(i * block_size), iv.data(), block_size);
+                    increment(iv);
+                }
+                cipher.encrypt_blocks(key_stream, key_stream);
+
+                VERIFY(offset + batch_size <= out.size());
+                if (in) {
+                    for (size_t i = 0; i < batch_size; ++i)
+                        out[offset + i] = (*in)[offset + i] ^ key_stream[i];
+                } else {
+                    __builtin_memcpy(out.offset(offset), key_stream.data(), batch_size);
+                }
+
+                length -= batch_size;
+                offset += batch_size;
+            }
+        }
+
         while (length > 0) {
             m_cipher_block.overwrite(iv.slice(0, block_size));
 
@@ -9,6 +9,7 @@
 #include <AK/ByteBuffer.h>
 #include <AK/Endian.h>
 #include <AK/MemoryStream.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/Random.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringView.h>
@@ -135,6 +136,12 @@ private:
     static constexpr StorageType R2_MOD_PRIME = calculate_r2_mod(PRIME);
     static constexpr StorageType R2_MOD_ORDER = calculate_r2_mod(ORDER);
 
+    // Multiples of the generator for fixed-base scalar multiplication: entry [w][k - 1] is k * 16^w * G, in Montgomery form.
+    static constexpr size_t GENERATOR_WINDOW_BITS = 4;
+    static constexpr size_t GENERATOR_WINDOW_COUNT = KEY_BIT_SIZE / GENERATOR_WINDOW_BITS;
+    static constexpr size_t GENERATOR_WINDOW_ENTRIES = (1u << GENERATOR_WINDOW_BITS) - 1;
+    using GeneratorTable = Array<Array<JacobianPoint, GENERATOR_WINDOW_ENTRIES>, GENERATOR_WINDOW_COUNT>;
+
 public:
     size_t key_size() override { return POINT_BYTE_SIZE; }
 
@@ -147,7 +154,11 @@ public:
 
     ErrorOr<ByteBuffer> generate_public_key(ReadonlyBytes a) override
     {
-        return compute_coordinate(a, GENERATOR_POINT);
+        AK::FixedMemoryStream scalar_stream { a };
+
+        StorageType scalar = TRY(scalar_stream.read_value<BigEndian<StorageType>>());
+        JacobianPoint result = TRY(generate_public_key_internal(scalar));
+        return write_uncompressed_point(result);
     }
 
     ErrorOr<ByteBuffer> compute_coordinate(ReadonlyBytes scalar_bytes, ReadonlyBytes point_bytes) override
@@ -158,14 +169,7 @@ public:
         StorageType scalar = TRY(scalar_stream.read_value<BigEndian<StorageType>>());
         JacobianPoint point = TRY(read_uncompressed_point(point_stream));
         JacobianPoint result = TRY(compute_coordinate_internal(scalar, point));
-
-        // Export the values into an output buffer
-        auto buf = TRY(ByteBuffer::create_uninitialized(POINT_BYTE_SIZE));
-        AK::FixedMemoryStream buf_stream { buf.bytes() };
-        TRY(buf_stream.write_value<u8>(0x04));
-        TRY(buf_stream.write_value<BigEndian<StorageType>>(result.x));
-        TRY(buf_stream.write_value<BigEndian<StorageType>>(result.y));
-        return buf;
+        return write_uncompressed_point(result);
     }
 
     ErrorOr<ByteBuffer> derive_premaster_key(ReadonlyBytes shared_point) override
@@ -258,11 +262,66 @@ public:
     }
 
 private:
-    ErrorOr<JacobianPoint> generate_public_key_internal(StorageType a)
+    ErrorOr<JacobianPoint> generate_public_key_internal(StorageType scalar)
+    {
+        // FIXME: This will slightly bias the distribution of client secrets
+        scalar = modular_reduce_order(scalar);
+        if (scalar.is_zero_constant_time())
+            return Error::from_string_literal("SECPxxxr1: scalar is zero");
+
+        auto const& table = generator_table();
+
+        // Add up one precomputed multiple of the generator for each window of the scalar. As the scalar is less than the
+        // order, the partial sum is never equal to (or the inverse of) the multiple that is added to it.
+        JacobianPoint result { 0, 0, 0 };
+        for (size_t window = 0; window < GENERATOR_WINDOW_COUNT; window++) {
+            auto digit = static_cast<u32>(scalar) & GENERATOR_WINDOW_ENTRIES;
+
+            // Look at every entry, so that the memory access pattern doesn't depend on the scalar
+            JacobianPoint multiple = table[window][0];
+            for (size_t i = 1; i < GENERATOR_WINDOW_ENTRIES; i++) {
+                auto condition = digit == i + 1;
+                multiple.x = select(multiple.x, table[window][i].x, condition);
+                multiple.y = select(multiple.y, table[window][i].y, condition);
+                multiple.z = select(multiple.z, table[window][i].z, condition);
+            }
+
+            JacobianPoint temp_result = point_add(result, multiple);
+
+            auto condition = digit != 0;
+            result.x = select(result.x, temp_result.x, condition);
+            result.y = select(result.y, temp_result.y, condition);
+            result.z = select(result.z, temp_result.z, condition);
+
+            scalar >>= GENERATOR_WINDOW_BITS;
+        }
+
+        return finish_scalar_multiplication(result);
+    }
+
+    GeneratorTable const& generator_table()
     {
-        AK::FixedMemoryStream generator_point_stream { GENERATOR_POINT };
-        JacobianPoint point = TRY(read_uncompressed_point(generator_point_stream));
-        return compute_coordinate_internal(a, point);
+        static NonnullOwnPtr<GeneratorTable> const s_table = [this] {
+            auto table = make<GeneratorTable>();
+
+            AK::FixedMemoryStream generator_point_stream { GENERATOR_POINT };
+            JacobianPoint base = MUST(read_uncompressed_point(generator_point_stream));
+            base.x = to_montgomery(base.x);
+            base.y = to_montgomery(base.y);
+            base.z = to_montgomery(base.z);
+
+            for (auto& entries : *table) {
+                entries[0] = base;
+                for (size_t i = 1; i < GENERATOR_WINDOW_ENTRIES; i++)
+                    entries[i] = point_add(entries[i - 1], base);
+
+                for (size_t i = 0; i < GENERATOR_WINDOW_BITS; i++)
+                    base = point_double(base);
+            }
+
+            return table;
+        }();
+        return *s_table;
     }
 
     ErrorOr<JacobianPoint> compute_coordinate_internal(StorageType scalar, JacobianPoint point)
@@ -297,6 +356,11 @@ private:
             scalar >>= 1u;
         }
 
+        return finish_scalar_multiplication(result);
+    }
+
+    JacobianPoint finish_scalar_multiplication(JacobianPoint result)
+    {
         // Convert from Jacobian coordinates back to Affine coordinates
         convert_jacobian_to_affine(result);
 
@@ -315,6 +379,17 @@ private:
         return result;
     }
 
+    static ErrorOr<ByteBuffer> write_uncompressed_point(JacobianPoint const& point)
+    {
+        // Export the values into an output buffer
+        auto buf = TRY(ByteBuffer::create_uninitialized(POINT_BYTE_SIZE));
+        AK::FixedMemoryStream buf_stream { buf.bytes() };
+        TRY(buf_stream.write_value<u8>(0x04));
+        TRY(buf_stream.write_value<BigEndian<StorageType>>(point.x));
+        TRY(buf_stream.write_value<BigEndian<StorageType>>(point.y));
+        return buf;
+    }
+
     static ErrorOr<JacobianPoint> read_uncompressed_point(Stream& stream)
     {
         // Make sure the point is uncompressed
@@ -5,6 +5,9 @@
  */
 
 #include <AK/ByteReader.h>
+#include <AK/CPUFeatures.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <LibCrypto/Hash/BLAKE2b.h>
 
 namespace Crypto::Hash {
@@ -84,7 +87,8 @@ void BLAKE2b::mix(u64* work_array, u64 a, u64 b, u64 c, u64 d, u64 x, u64 y)
     work_array[b] = ROTRIGHT(work_array[b] ^ work_array[c], rotation_constant_4);
 }
 
-void BLAKE2b::transform(u8 const* block)
+template<>
+void BLAKE2b::transform_impl<CPUFeatures::None>(u8 const* block)
 {
     u64 m[16];
     u64 v[16];
@@ -123,4 +127,80 @@ void BLAKE2b::transform(u8 const* block)
         m_internal_state.hash_state[i] = m_internal_state.hash_state[i] ^ v[i] ^ v[i + 8];
 }
 
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+// Rotates each 64-bit lane right by a whole number of bytes, which is a byte shuffle.
+template<size_t bytes, size_t... Idx>
+[[gnu::target("avx2")]] ALWAYS_INLINE static AK::SIMD::u64x4 rotate_lanes_right_by_bytes(AK::SIMD::u64x4 value, IndexSequence<Idx...>)
+{
+    return bit_cast<AK::SIMD::u64x4>(__builtin_shufflevector(bit_cast<AK::SIMD::u8x32>(value), bit_cast<AK::SIMD::u8x32>(value), (Idx / 8 * 8 + (Idx + bytes) % 8)...));
+}
+
+// The sixteen words of the work vector are held as four rows of four words. The mixing function is applied to the four
+// columns at once, and then to the four diagonals, by rotating the rows so that the diagonals line up as columns.
+template<>
+[[gnu::target("avx2")]] void BLAKE2b::transform_impl<CPUFeatures::X86_AVX2>(u8 const* block)
+{
+    using AK::SIMD::u64x4;
+
+    u64 m[16];
+    for (size_t i = 0; i < 16; ++i)
+        m[i] = ByteReader::load64(block + i * sizeof(m[i]));
+
+    auto a = AK::SIMD::load_unaligned<u64x4>(&m_internal_state.hash_state[0]);
+    auto b = AK::SIMD::load_unaligned<u64x4>(&m_internal_state.hash_state[4]);
+    auto c = u64x4 {
+        SHA512Constants::InitializationHashes[0],
+        SHA512Constants::InitializationHashes[1],
+        SHA512Constants::InitializationHashes[2],
+        SHA512Constants::InitializationHashes[3],
+    };
+    auto d = u64x4 {
+        SHA512Constants::InitializationHashes[4] ^ m_internal_state.message_byte_offset[0],
+        SHA512Constants::InitializationHashes[5] ^ m_internal_state.message_byte_offset[1],
+        SHA512Constants::InitializationHashes[6] ^ m_internal_state.is_at_last_block,
+        SHA512Constants::InitializationHashes[7],
+    };
+
+    auto mix_rows = [&] [[gnu::target("avx2"), gnu::always_inline]] (u64x4 x, u64x4 y) {
+        auto bytes = MakeIndexSequence<32>();
+        a = a + b + x;
+        d = rotate_lanes_right_by_bytes<4>(d ^ a, bytes);
+        c = c + d;
+        b = rotate_lanes_right_by_bytes<3>(b ^ c, bytes);
+        a = a + b + y;
+        d = rotate_lanes_right_by_bytes<2>(d ^ a, bytes);
+        c = c + d;
+        b = b ^ c;
+        b = (b >> 63) | (b << 1);
+    };
+
+    for (size_t i = 0; i < 12; ++i) {
+        auto const* sigma = BLAKE2bSigma[i];
+        mix_rows(u64x4 { m[sigma[0]], m[sigma[2]], m[sigma[4]], m[sigma[6]] }, u64x4 { m[sigma[1]], m[sigma[3]], m[sigma[5]], m[sigma[7]] });
+
+        b = __builtin_shufflevector(b, b, 1, 2, 3, 0);
+        c = __builtin_shufflevector(c, c, 2, 3, 0, 1);
+        d = __builtin_shufflevector(d, d, 3, 0, 1, 2);
+        mix_rows(u64x4 { m[sigma[8]], m[sigma[10]], m[sigma[12]], m[sigma[14]] }, u64x4 { m[sigma[9]], m[sigma[11]], m[sigma[13]], m[sigma[15]] });
+        b = __builtin_shufflevector(b, b, 3, 0, 1, 2);
+        c = __builtin_shufflevector(c, c, 2, 3, 0, 1);
+        d = __builtin_shufflevector(d, d, 1, 2, 3, 0);
+    }
+
+    AK::SIMD::store_unaligned(&m_internal_state.hash_state[0], AK::SIMD::load_unaligned<u64x4>(&m_internal_state.hash_state[0]) ^ a ^ c);
+    AK::SIMD::store_unaligned(&m_internal_state.hash_state[4], AK::SIMD::load_unaligned<u64x4>(&m_internal_state.hash_state[4]) ^ b ^ d);
+}
+#endif
+
+decltype(BLAKE2b::transform_dispatched) BLAKE2b::transform_dispatched = [] {
+    CPUFeatures features = detect_cpu_features();
+
+    if constexpr (is_valid_feature(CPUFeatures::X86_AVX2)) {
+        if (has_flag(features, CPUFeatures::X86_AVX2))
+            return &BLAKE2b::transform_impl<CPUFeatures::X86_AVX2>;
+    }
+
+    return &BLAKE2b::transform_impl<CPUFeatures::None>;
+}();
+
 }
@@ -15,6 +15,7 @@
 #include <AK/Platform.h>
 #include <AK/Random.h>
 #include <AK/ScopeGuard.h>
+#include <AK/Time.h>
 #include <AK/Vector.h>
 #include <Kernel/API/VirtualMemoryAnnotations.h>
 #include <Kernel/API/prctl_numbers.h>
@@ -69,22 +70,34 @@ static ByteString s_cwd;
 
 static bool s_allowed_to_check_environment_variables { false };
 static bool s_do_breakpoint_trap_before_entry { false };
+static bool s_bind_now { false };
+static bool s_report_startup_timing { false };
 static StringView s_ld_library_path;
 static StringView s_main_program_pledge_promises;
 static ByteString s_loader_pledge_promises;
 
 static HashMap<StringView, DynamicObject::SymbolLookupResult> s_magic_functions;
 
+// Symbols that were found in s_global_objects, keyed by the name in the string table of the object that defines them.
+// Objects are only ever appended to s_global_objects and never unloaded, so once a symbol is found, later lookups will
+// find the same definition and the key stays valid.
+static HashMap<StringView, DynamicObject::SymbolLookupResult> s_global_symbol_cache;
+
 Optional<DynamicObject::SymbolLookupResult> DynamicLinker::lookup_global_symbol(StringView name)
 {
+    if (auto cached_result = s_global_symbol_cache.get(name); cached_result.has_value())
+        return cached_result;
+
     auto symbol = DynamicObject::HashSymbol { name };
 
     for (auto& lib : s_global_objects) {
         auto res = lib.value->lookup_symbol(symbol);
         if (!res.has_value())
             continue;
-        if (res.value().bind == STB_GLOBAL || res.value().bind == STB_WEAK)
+        if (res.value().bind == STB_GLOBAL || res.value().bind == STB_WEAK) {
+            s_global_symbol_cache.set(res.value().name, res.value());
             return res;
+        }
         // We don't want to allow local symbols to be pulled in to other modules
     }
 
@@ -372,21 +385,37 @@ static void drop_loader_promise(StringView promise_to_drop)
     }
 }
 
+template<typename... Parameters>
+static void report_startup_timing(MonotonicTime start, CheckedFormatString<Parameters...>&& phase, Parameters const&... parameters)
+{
+    if (!s_report_startup_timing)
+        return;
+    auto elapsed = MonotonicTime::now() - start;
+    dbgln("Loader.so: {}: {} us", ByteString::formatted(phase.view(), parameters...), elapsed.to_microseconds());
+}
+
 static ErrorOr<void, DlErrorMessage> link_main_library(int flags, DependencyOrdering const& objects)
 {
     // Verify that all objects are already mapped
     for (auto& loader : objects.load_order)
         VERIFY(!loader->map());
 
+    auto relocation_start = MonotonicTime::now();
+
     // FIXME: Are there any observable differences between doing stages 2 and 3 in topological vs
     //        load order? POSIX says to do relocations in load order but does the order really
     //        matter here?
     for (auto& loader : objects.load_order) {
+        auto link_start = MonotonicTime::now();
         bool success = loader->link(flags);
         if (!success) {
             return DlErrorMessage { ByteString::formatted("Failed to link library {}", loader->filepath()) };
         }
+        report_startup_timing(link_start, "relocating {}", loader->filepath());
     }
+    report_startup_timing(relocation_start, "relocating all objects");
+
+    auto finalization_start = MonotonicTime::now();
 
     for (auto& loader : objects.load_order) {
         auto result = loader->load_stage_3(flags);
@@ -415,10 +444,14 @@ static ErrorOr<void, DlErrorMessage> link_main_library(int flags, DependencyOrde
         }
     }
 
+    report_startup_timing(finalization_start, "finalizing relocations");
+
     drop_loader_promise("prot_exec"sv);
 
+    auto initialization_start = MonotonicTime::now();
     for (auto& loader : objects.topological_order)
         loader->load_stage_4();
+    report_startup_timing(initialization_start, "calling initializers");
 
     return {};
 }
@@ -469,9 +502,13 @@ static Optional<DlErrorMessage> verify_tls_for_dlopen(DynamicLoader const& loade
 
 static Result<void*, DlErrorMessage> __dlopen(char const* filename, int flags)
 {
-    // FIXME: RTLD_NOW and RTLD_LOCAL are not supported
-    flags &= ~RTLD_NOW;
-    flags |= RTLD_LAZY;
+    // FIXME: RTLD_LOCAL is not supported
+    if (s_bind_now)
+        flags |= RTLD_NOW;
+    if (flags & RTLD_NOW)
+        flags &= ~RTLD_LAZY;
+    else
+        flags |= RTLD_LAZY;
     flags &= ~RTLD_LOCAL;
     flags |= RTLD_GLOBAL;
 
@@ -626,6 +663,15 @@ static void read_environment_variables()
             s_do_breakpoint_trap_before_entry = true;
         }
 
+        if (env_string == "_LOADER_TIMING=1"sv) {
+            s_report_startup_timing = true;
+        }
+
+        constexpr auto bind_now_string = "LD_BIND_NOW="sv;
+        if (env_string.starts_with(bind_now_string) && env_string.length() > bind_now_string.length()) {
+            s_bind_now = true;
+        }
+
         constexpr auto library_path_string = "LD_LIBRARY_PATH="sv;
         if (env_string.starts_with(library_path_string)) {
             s_ld_library_path = env_string.substring_view(library_path_string.length());
@@ -682,6 +728,8 @@ EntryPointFunction ELF::DynamicLinker::linker_main(ByteString&& main_program_pat
 
     s_main_program_path = main_program_path;
 
+    auto startup_start = MonotonicTime::now();
+
     // NOTE: We always map the main library first, since it may require
     //       placement at a specific address.
     auto result1 = map_library(main_program_path, main_program_fd);
@@ -724,6 +772,7 @@ Examples of static-pie ELF objects are ELF packers, and the system dynamic loade
     }
 
     auto objects = result2.release_value();
+    report_startup_timing(startup_start, "mapping {} objects", objects.load_order.size());
 
     dbgln_if(DYNAMIC_LOAD_DEBUG, "loaded all dependencies");
     for ([[maybe_unused]] auto& object : objects.load_order) {
@@ -733,7 +782,7 @@ Examples of static-pie ELF objects are ELF packers, and the system dynamic loade
 
     allocate_tls(objects.load_order);
 
-    auto result = link_main_library(RTLD_GLOBAL | RTLD_LAZY, objects);
+    auto result = link_main_library(RTLD_GLOBAL | (s_bind_now ? RTLD_NOW : RTLD_LAZY), objects);
     if (result.is_error()) {
         warnln("{}", result.error().text);
         _exit(1);
@@ -741,6 +790,8 @@ Examples of static-pie ELF objects are ELF packers, and the system dynamic loade
 
     drop_loader_promise("rpath"sv);
 
+    report_startup_timing(startup_start, "starting {}", main_program_path);
+
     auto& main_executable_loader = objects.load_order.first();
     auto entry_point = main_executable_loader->image().entry();
     if (main_executable_loader->is_dynamic())
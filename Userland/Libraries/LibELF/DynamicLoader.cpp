@@ -184,11 +184,11 @@ bool DynamicLoader::load_stage_2(unsigned flags)
             }
         }
     }
-    do_main_relocations();
+    do_main_relocations(flags);
     return true;
 }
 
-void DynamicLoader::do_main_relocations()
+void DynamicLoader::do_main_relocations(unsigned flags)
 {
     do_relr_relocations();
 
@@ -226,8 +226,7 @@ void DynamicLoader::do_main_relocations()
             return;
         }
 
-        // FIXME: Or LD_BIND_NOW is set?
-        if (m_dynamic_object->must_bind_now()) {
+        if (m_dynamic_object->must_bind_now() || (flags & RTLD_NOW)) {
             switch (do_plt_relocation(relocation, ShouldCallIfuncResolver::No)) {
             case RelocationResult::Failed:
                 dbgln("Loader.so: {} unresolved symbol '{}'", m_filepath, relocation.symbol().name());
@@ -246,12 +245,11 @@ void DynamicLoader::do_main_relocations()
     });
 }
 
-Result<NonnullRefPtr<DynamicObject>, DlErrorMessage> DynamicLoader::load_stage_3(unsigned flags)
+Result<NonnullRefPtr<DynamicObject>, DlErrorMessage> DynamicLoader::load_stage_3(unsigned)
 {
-    if (flags & RTLD_LAZY) {
-        if (m_dynamic_object->has_plt())
-            setup_plt_trampoline();
-    }
+    // Even when binding immediately, PLT entries that refer to IFUNCs are bound lazily until their resolvers have been called.
+    if (m_dynamic_object->has_plt())
+        setup_plt_trampoline();
 
     // IFUNC resolvers can only be called after the PLT has been populated,
     // as they may call arbitrary functions via the PLT.
@@ -823,7 +821,7 @@ Optional<DynamicObject::SymbolLookupResult> DynamicLoader::lookup_symbol(const E
     if (symbol.is_undefined() || symbol.bind() == STB_WEAK)
         return DynamicLinker::lookup_global_symbol(symbol.name());
 
-    return DynamicObject::SymbolLookupResult { symbol.value(), symbol.size(), symbol.address(), symbol.bind(), symbol.type(), &symbol.object() };
+    return DynamicObject::SymbolLookupResult { symbol.value(), symbol.size(), symbol.address(), symbol.bind(), symbol.type(), &symbol.object(), symbol.name() };
 }
 
 void DynamicLoader::compute_topological_order(Vector<NonnullRefPtr<DynamicLoader>>& topological_order)
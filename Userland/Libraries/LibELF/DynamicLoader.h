@@ -128,7 +128,7 @@ private:
     void load_program_headers();
 
     // Stage 2
-    void do_main_relocations();
+    void do_main_relocations(unsigned flags);
 
     // Stage 3
     void setup_plt_trampoline();
@@ -317,6 +317,7 @@ public:
         unsigned bind { STB_LOCAL };
         unsigned type { STT_FUNC };
         const ELF::DynamicObject* dynamic_object { nullptr }; // The object in which the symbol is defined
+        StringView name;                                      // Points into the string table of dynamic_object
     };
 
     Optional<SymbolLookupResult> lookup_symbol(StringView name) const;
@@ -208,11 +208,17 @@ ErrorOr<void> copy_file(StringView destination_path, StringView source_path, str
     if (source_stat.st_size > 0)
         TRY(destination->truncate(source_stat.st_size));
 
+#ifdef AK_OS_SERENITY
+    // Let the kernel (and where possible, the filesystem) copy the data, instead of bouncing every byte through our own buffer.
+    while (TRY(Core::System::copy_file_range(source.fd(), nullptr, destination->fd(), nullptr, 16 * MiB)) > 0)
+        ;
+#else
     ByteBuffer buffer = TRY(ByteBuffer::create_uninitialized(1 * MiB));
     while (!source.is_eof()) {
         auto bytes = TRY(source.read_some(buffer));
         TRY(destination->write_until_depleted(bytes));
     }
+#endif
 
     auto my_umask = umask(0);
     umask(my_umask);
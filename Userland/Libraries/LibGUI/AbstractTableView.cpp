@@ -95,6 +95,11 @@ void AbstractTableView::update_column_sizes()
     int column_count = model.column_count();
     int row_count = model.row_count();
 
+    // Only the visible rows are measured, so that updating a large model doesn't fetch the data of every row. Columns
+    // are widened further as other rows are scrolled into view.
+    int first_visible_row = max(0, vertical_scrollbar().value() / row_height() - 1);
+    int last_visible_row = min(row_count - 1, (vertical_scrollbar().value() + height()) / row_height());
+
     for (int column = 0; column < column_count; ++column) {
         if (!column_header().is_section_visible(column))
             continue;
@@ -102,7 +107,7 @@ void AbstractTableView::update_column_sizes()
         if (column == m_key_column && model.is_column_sortable(column))
             header_width += HeaderView::sorting_arrow_width + HeaderView::sorting_arrow_offset;
         int column_width = header_width;
-        for (int row = 0; row < row_count; ++row) {
+        for (int row = first_visible_row; row <= last_visible_row; ++row) {
             auto cell_data = model.index(row, column).data();
             int cell_width = 0;
             if (cell_data.is_icon()) {
@@ -127,11 +132,15 @@ void AbstractTableView::update_row_sizes()
     auto& model = *this->model();
     int row_count = model.row_count();
 
-    for (int row = 0; row < row_count; ++row) {
+    // All rows have the same height, so only the rows that were added since the last update need their size set.
+    int first_row = row_height() == m_sized_row_height ? min(m_sized_row_count, row_count) : 0;
+    for (int row = first_row; row < row_count; ++row) {
         if (!row_header().is_section_visible(row))
             continue;
         row_header().set_section_size(row, row_height());
     }
+    m_sized_row_count = row_count;
+    m_sized_row_height = row_height();
 }
 
 void AbstractTableView::update_content_size()
@@ -229,18 +238,20 @@ ModelIndex AbstractTableView::index_at_event_position(Gfx::IntPoint position, bo
     if (!model())
         return {};
 
+    // All rows have the same height, so the row can be found without looking at any of the others.
     auto adjusted_position = this->adjusted_position(position);
-    for (int row = 0, row_count = model()->row_count(); row < row_count; ++row) {
-        if (!row_rect(row).contains(adjusted_position))
+    int y_in_rows = adjusted_position.y() - row_rect(0).y();
+    if (y_in_rows < 0)
+        return {};
+    int row = y_in_rows / row_height();
+    if (row >= model()->row_count() || !row_rect(row).contains(adjusted_position))
+        return {};
+    for (int column = 0, column_count = model()->column_count(); column < column_count; ++column) {
+        if (!content_rect(row, column).contains(adjusted_position))
             continue;
-        for (int column = 0, column_count = model()->column_count(); column < column_count; ++column) {
-            if (!content_rect(row, column).contains(adjusted_position))
-                continue;
-            return model()->index(row, column);
-        }
-        return model()->index(row, 0);
+        return model()->index(row, column);
     }
-    return {};
+    return model()->index(row, 0);
 }
 
 ModelIndex AbstractTableView::index_at_event_position(Gfx::IntPoint position) const
@@ -352,8 +363,11 @@ Gfx::IntPoint AbstractTableView::adjusted_position(Gfx::IntPoint position) const
 void AbstractTableView::model_did_update(unsigned flags)
 {
     AbstractView::model_did_update(flags);
+    if (!model() || (flags & Model::UpdateFlag::InvalidateAllIndices))
+        m_sized_row_count = 0;
     update_row_sizes();
-    if (!(flags & Model::UpdateFlag::DontResizeColumns))
+    m_resizes_columns_to_contents = !(flags & Model::UpdateFlag::DontResizeColumns);
+    if (m_resizes_columns_to_contents)
         update_column_sizes();
 
     update_content_size();
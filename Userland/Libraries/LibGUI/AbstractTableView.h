@@ -102,6 +102,8 @@ protected:
     virtual void toggle_index(ModelIndex const&) { }
 
     void update_content_size();
+    // Whether the last model update asked for the columns to be resized to fit their contents.
+    bool resizes_columns_to_contents() const { return m_resizes_columns_to_contents; }
     virtual void auto_resize_column(int column);
     virtual void update_column_sizes();
     virtual void update_row_sizes();
@@ -129,6 +131,12 @@ private:
     int m_vertical_padding { 8 };
     int m_horizontal_padding { font().pixel_size_rounded_up() / 2 };
     int m_tab_moves { 0 };
+
+    // The rows whose section in the row header has been sized for a row height, see update_row_sizes().
+    int m_sized_row_count { 0 };
+    int m_sized_row_height { 0 };
+
+    bool m_resizes_columns_to_contents { true };
 };
 
 }
@@ -55,6 +55,9 @@ ConnectionToWindowServer::ConnectionToWindowServer(NonnullOwnPtr<Core::LocalSock
     Gfx::FontDatabase::set_fixed_width_font_query(message->fixed_width_font_query());
     Gfx::FontDatabase::set_window_title_font_query(message->window_title_font_query());
     m_client_id = message->client_id();
+
+    // Widgets invalidate many small rects per frame.
+    enable_message_batching();
 }
 
 void ConnectionToWindowServer::fast_greet(Vector<Gfx::IntRect> const&, u32, u32, u32, Core::AnonymousBuffer const&, ByteString const&, ByteString const&, ByteString const&, Vector<bool> const&, i32)
@@ -386,6 +389,12 @@ void ConnectionToWindowServer::display_link_notification()
     });
 }
 
+void ConnectionToWindowServer::frame_callback(i32 window_id, i64 frame_time_ms)
+{
+    if (auto* window = Window::from_window_id(window_id))
+        window->did_receive_frame_callback({}, frame_time_ms);
+}
+
 void ConnectionToWindowServer::track_mouse_move(Gfx::IntPoint mouse_position)
 {
     MouseTracker::track_mouse_move({}, mouse_position);
@@ -57,6 +57,7 @@ private:
     virtual void update_system_effects(Vector<bool> const&) override;
     virtual void window_state_changed(i32, bool, bool, bool) override;
     virtual void display_link_notification() override;
+    virtual void frame_callback(i32, i64) override;
     virtual void track_mouse_move(Gfx::IntPoint) override;
     virtual void ping() override;
 
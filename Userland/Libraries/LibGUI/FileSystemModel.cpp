@@ -507,6 +507,13 @@ void FileSystemModel::handle_file_event(Core::FileWatcherEvent const& event)
 
         auto& mutable_child = const_cast<Node&>(child.value());
         mutable_child.fetch_data(mutable_child.full_path(), &mutable_child == m_root);
+
+        // Only this one row changed, so sorting proxies can move it instead of sorting everything again.
+        if (&mutable_child != m_root) {
+            auto index = mutable_child.index(0);
+            did_update_rows(index.parent(), index.row(), index.row());
+            return;
+        }
         break;
     }
     default:
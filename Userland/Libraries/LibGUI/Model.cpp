@@ -53,6 +53,19 @@ void Model::did_update(unsigned flags)
     });
 }
 
+void Model::did_update_rows(ModelIndex const& parent, int first, int last)
+{
+    VERIFY(first >= 0 && first <= last);
+    for_each_client([&](ModelClient& client) {
+        client.model_did_update_rows(parent, first, last);
+    });
+}
+
+void ModelClient::model_did_update_rows(ModelIndex const&, int, int)
+{
+    model_did_update(Model::UpdateFlag::DontInvalidateIndices);
+}
+
 ModelIndex Model::create_index(int row, int column, void const* data) const
 {
     return ModelIndex(*this, row, column, const_cast<void*>(data));
@@ -38,6 +38,9 @@ public:
 
     virtual void model_did_update(unsigned flags) = 0;
 
+    // Called when only the data of the given rows changed. Clients that can't do better treat this like any other update.
+    virtual void model_did_update_rows(ModelIndex const& parent, int first, int last);
+
     virtual void model_did_insert_rows([[maybe_unused]] ModelIndex const& parent, [[maybe_unused]] int first, [[maybe_unused]] int last) { }
     virtual void model_did_insert_columns([[maybe_unused]] ModelIndex const& parent, [[maybe_unused]] int first, [[maybe_unused]] int last) { }
     virtual void model_did_move_rows([[maybe_unused]] ModelIndex const& source_parent, [[maybe_unused]] int first, [[maybe_unused]] int last, [[maybe_unused]] ModelIndex const& target_parent, [[maybe_unused]] int target_index) { }
@@ -117,6 +120,7 @@ protected:
     void for_each_view(Function<void(AbstractView&)>);
     void for_each_client(Function<void(ModelClient&)>);
     void did_update(unsigned flags = UpdateFlag::InvalidateAllIndices);
+    void did_update_rows(ModelIndex const& parent, int first, int last);
 
     static bool string_matches(StringView str, StringView needle, unsigned flags)
     {
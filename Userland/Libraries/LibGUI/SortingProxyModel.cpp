@@ -49,6 +49,60 @@ void SortingProxyModel::model_did_update(unsigned flags)
     update_sort(flags);
 }
 
+void SortingProxyModel::model_did_update_rows(ModelIndex const& source_parent, int first, int last)
+{
+    // Nothing has looked at these rows through us yet, so they will be sorted once something does.
+    auto it = m_mappings.find(source_parent);
+    if (it == m_mappings.end())
+        return;
+    auto& mapping = *it->value;
+
+    int row_count = source().row_count(source_parent);
+    if (static_cast<size_t>(row_count) != mapping.source_rows.size() || last >= row_count)
+        return update_sort();
+
+    if (m_last_key_column == -1)
+        return did_update_rows(map_to_proxy(source_parent), first, last);
+
+    // Moving a row to its new place costs a binary search and a memmove, so only re-sort everything when a large part
+    // of the rows changed.
+    int changed_row_count = last - first + 1;
+    if (changed_row_count > row_count / 4)
+        return update_sort();
+
+    auto old_source_rows = mapping.source_rows;
+    int first_affected_proxy_row = row_count;
+    int last_affected_proxy_row = -1;
+    for (int row = first; row <= last; ++row) {
+        first_affected_proxy_row = min(first_affected_proxy_row, mapping.proxy_rows[row]);
+        last_affected_proxy_row = max(last_affected_proxy_row, mapping.proxy_rows[row]);
+    }
+
+    mapping.source_rows.remove_all_matching([&](int row) { return row >= first && row <= last; });
+    for (int row = first; row <= last; ++row) {
+        size_t low = 0;
+        size_t high = mapping.source_rows.size();
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            if (is_sorted_before(mapping, row, mapping.source_rows[middle], m_last_key_column, m_last_sort_order))
+                high = middle;
+            else
+                low = middle + 1;
+        }
+        mapping.source_rows.insert(low, row);
+    }
+
+    for (int i = 0; i < row_count; ++i)
+        mapping.proxy_rows[mapping.source_rows[i]] = i;
+    for (int row = first; row <= last; ++row) {
+        first_affected_proxy_row = min(first_affected_proxy_row, mapping.proxy_rows[row]);
+        last_affected_proxy_row = max(last_affected_proxy_row, mapping.proxy_rows[row]);
+    }
+
+    update_views_after_remapping(mapping, old_source_rows);
+    did_update_rows(map_to_proxy(source_parent), first_affected_proxy_row, last_affected_proxy_row);
+}
+
 bool SortingProxyModel::accepts_drag(ModelIndex const& proxy_index, Core::MimeData const& mime_data) const
 {
     return source().accepts_drag(map_to_source(proxy_index), mime_data);
@@ -181,13 +235,23 @@ void SortingProxyModel::sort_mapping(Mapping& mapping, int column, SortOrder sor
         mapping.source_rows[i] = i;
 
     quick_sort(mapping.source_rows, [&](auto row1, auto row2) -> bool {
-        bool is_less_than = less_than(source().index(row1, column, mapping.source_parent), source().index(row2, column, mapping.source_parent));
-        return sort_order == SortOrder::Ascending ? is_less_than : !is_less_than;
+        return is_sorted_before(mapping, row1, row2, column, sort_order);
     });
 
     for (int i = 0; i < row_count; ++i)
         mapping.proxy_rows[mapping.source_rows[i]] = i;
 
+    update_views_after_remapping(mapping, old_source_rows);
+}
+
+bool SortingProxyModel::is_sorted_before(Mapping const& mapping, int source_row1, int source_row2, int column, SortOrder sort_order) const
+{
+    bool is_less_than = less_than(source().index(source_row1, column, mapping.source_parent), source().index(source_row2, column, mapping.source_parent));
+    return sort_order == SortOrder::Ascending ? is_less_than : !is_less_than;
+}
+
+void SortingProxyModel::update_views_after_remapping(Mapping const& mapping, Vector<int> const& old_source_rows)
+{
     // FIXME: I really feel like this should be done at the view layer somehow.
     for_each_view([&](AbstractView& view) {
         // Update the view's selection.
@@ -197,7 +261,8 @@ void SortingProxyModel::sort_mapping(Mapping& mapping, int column, SortOrder sor
             selection.for_each_index([&](ModelIndex const& index) {
                 if (index.parent() == mapping.source_parent) {
                     stale_indices_in_selection.append(index);
-                    selected_indices_in_source.append(source().index(old_source_rows[index.row()], index.column(), mapping.source_parent));
+                    if (static_cast<size_t>(index.row()) < old_source_rows.size())
+                        selected_indices_in_source.append(source().index(old_source_rows[index.row()], index.column(), mapping.source_parent));
                 }
             });
 
@@ -206,17 +271,14 @@ void SortingProxyModel::sort_mapping(Mapping& mapping, int column, SortOrder sor
             }
 
             for (auto& index : selected_indices_in_source) {
-                for (size_t i = 0; i < mapping.source_rows.size(); ++i) {
-                    if (mapping.source_rows[i] == index.row()) {
-                        auto new_source_index = this->index(i, index.column(), mapping.source_parent);
-                        selection.add(new_source_index);
-                        // Update the view's cursor.
-                        auto cursor = view.cursor_index();
-                        if (cursor.is_valid() && cursor.parent() == mapping.source_parent)
-                            view.set_cursor(new_source_index, AbstractView::SelectionUpdate::None, false);
-                        break;
-                    }
-                }
+                if (!index.is_valid() || static_cast<size_t>(index.row()) >= mapping.proxy_rows.size())
+                    continue;
+                auto new_source_index = this->index(mapping.proxy_rows[index.row()], index.column(), mapping.source_parent);
+                selection.add(new_source_index);
+                // Update the view's cursor.
+                auto cursor = view.cursor_index();
+                if (cursor.is_valid() && cursor.parent() == mapping.source_parent)
+                    view.set_cursor(new_source_index, AbstractView::SelectionUpdate::None, false);
             }
         });
     });
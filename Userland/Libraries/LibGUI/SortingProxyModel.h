@@ -62,9 +62,12 @@ private:
     using InternalMapIterator = HashMap<ModelIndex, NonnullOwnPtr<Mapping>>::IteratorType;
 
     void sort_mapping(Mapping&, int column, SortOrder);
+    bool is_sorted_before(Mapping const&, int source_row1, int source_row2, int column, SortOrder) const;
+    void update_views_after_remapping(Mapping const&, Vector<int> const& old_source_rows);
 
     // ^ModelClient
     virtual void model_did_update(unsigned) override;
+    virtual void model_did_update_rows(ModelIndex const& source_parent, int first, int last) override;
 
     Model& source() { return *m_source; }
     Model const& source() const { return *m_source; }
@@ -258,7 +258,10 @@ void TableView::mousemove_event(MouseEvent& event)
 
         set_suppress_update_on_selection_change(true);
 
-        for (int row = 0; row < row_count; ++row) {
+        // Only the rows between the origin and the current position of the rubber band can be selected.
+        int first_row = max(0, (m_rubber_band_current - column_header().height()) / row_height() - 1);
+        int last_row = min(row_count - 1, (m_rubber_band_origin - column_header().height()) / row_height() + 1);
+        for (int row = first_row; row <= last_row; ++row) {
             auto index = model()->index(row);
             VERIFY(index.is_valid());
 
@@ -325,6 +328,14 @@ void TableView::move_cursor(CursorMovement movement, SelectionUpdate selection_u
     }
 }
 
+void TableView::did_scroll()
+{
+    AbstractTableView::did_scroll();
+    // The column sizes only account for the rows that were visible, so the rows that just became visible are measured too.
+    if (model() && resizes_columns_to_contents())
+        update_column_sizes();
+}
+
 void TableView::set_grid_style(GridStyle style)
 {
     if (m_grid_style == style)
@@ -46,6 +46,7 @@ protected:
     virtual void mousemove_event(MouseEvent&) override;
     virtual void paint_event(PaintEvent&) override;
     virtual void second_paint_event(PaintEvent&) override;
+    virtual void did_scroll() override;
 
 private:
     GridStyle m_grid_style { GridStyle::None };
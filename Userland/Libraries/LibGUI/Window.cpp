@@ -57,6 +57,10 @@ public:
     Gfx::IntSize visible_size() const { return m_visible_size; }
     void set_visible_size(Gfx::IntSize visible_size) { m_visible_size = visible_size; }
 
+    // Once WindowServer has the bitmap, flipping to it only needs its serial.
+    bool is_known_to_server() const { return m_known_to_server; }
+    void set_known_to_server() { m_known_to_server = true; }
+
     [[nodiscard]] bool is_volatile() const { return m_volatile; }
 
     void set_volatile()
@@ -102,6 +106,7 @@ private:
     NonnullRefPtr<Gfx::Bitmap> m_bitmap;
     i32 const m_serial;
     Gfx::IntSize m_visible_size;
+    bool m_known_to_server { false };
     bool m_volatile { false };
 };
 
@@ -251,6 +256,7 @@ void Window::server_did_destroy()
     m_window_id = 0;
     m_visible = false;
     m_pending_paint_event_rects.clear();
+    m_frame_callbacks.clear();
     m_back_store = nullptr;
     m_front_store = nullptr;
     m_cursor = Gfx::StandardCursor::None;
@@ -341,9 +347,9 @@ void Window::set_rect(Gfx::IntRect const& a_rect)
         return;
     }
     auto window_rect = ConnectionToWindowServer::the().set_window_rect(m_window_id, a_rect);
-    if (m_back_store && m_back_store->size() != window_rect.size())
+    if (m_back_store && m_back_store->size() != backing_store_size(window_rect.size()))
         m_back_store = nullptr;
-    if (m_front_store && m_front_store->size() != window_rect.size())
+    if (m_front_store && m_front_store->size() != backing_store_size(window_rect.size()))
         m_front_store = nullptr;
     if (m_main_widget)
         m_main_widget->resize(window_rect.size());
@@ -474,11 +480,15 @@ void Window::handle_mouse_event(MouseEvent& event)
 
 Gfx::IntSize Window::backing_store_size(Gfx::IntSize window_size) const
 {
+    // Backing stores are sized in steps, so that small changes of the window size (like a window growing or shrinking a
+    // bit to fit its contents) don't need new ones, and a resize can make do with the ones it already has for a while.
+    int const backing_size_step = 64;
+    auto rounded_up = [&](int length) { return round_up_to_power_of_two(length, backing_size_step); };
     if (!m_resizing)
-        return window_size;
+        return { rounded_up(window_size.width()), rounded_up(window_size.height()) };
 
     int const backing_margin_during_resize = 64;
-    return { window_size.width() + backing_margin_during_resize, window_size.height() + backing_margin_during_resize };
+    return { rounded_up(window_size.width() + backing_margin_during_resize), rounded_up(window_size.height() + backing_margin_during_resize) };
 }
 
 void Window::handle_multi_paint_event(MultiPaintEvent& event)
@@ -496,10 +506,14 @@ void Window::handle_multi_paint_event(MultiPaintEvent& event)
     }
     VERIFY(!rects.is_empty());
 
-    // Throw away our backing store if its size is different, and we've stopped resizing or double buffering is disabled.
-    // This ensures that we shrink the backing store after a resize, and that we do not get flickering artifacts when
-    // directly painting into a shared active backing store.
-    if (m_back_store && (!m_resizing || !m_double_buffering_enabled) && m_back_store->size() != event.window_size())
+    // Throw away our backing store if its visible size is different and double buffering is disabled, so that we do
+    // not get flickering artifacts when directly painting into a shared active backing store.
+    if (m_back_store && !m_double_buffering_enabled && m_back_store->visible_size() != event.window_size())
+        m_back_store = nullptr;
+
+    // Also throw it away if it's larger than it needs to be once we've stopped resizing, which ensures that we shrink
+    // the backing store after a resize.
+    if (m_back_store && !m_resizing && m_back_store->size() != backing_store_size(event.window_size()))
         m_back_store = nullptr;
 
     // Discard our backing store if it's unable to contain the new window size. Smaller is fine though, that prevents
@@ -542,9 +556,12 @@ void Window::handle_multi_paint_event(MultiPaintEvent& event)
     }
     m_back_store->set_visible_size(event.window_size());
 
-    if (m_double_buffering_enabled)
+    if (m_double_buffering_enabled) {
         flip(rects);
-    else if (created_new_backing_store)
+        return;
+    }
+
+    if (created_new_backing_store)
         set_current_backing_store(*m_back_store, true);
 
     if (is_visible())
@@ -1026,6 +1043,7 @@ void Window::set_hovered_widget(Widget* widget)
 
 void Window::set_current_backing_store(WindowBackingStore& backing_store, bool flush_immediately) const
 {
+    backing_store.set_known_to_server();
     auto& bitmap = backing_store.bitmap();
     ConnectionToWindowServer::the().set_window_backing_store(
         m_window_id,
@@ -1043,19 +1061,36 @@ void Window::flip(Vector<Gfx::IntRect, 32> const& dirty_rects)
 {
     swap(m_front_store, m_back_store);
 
-    set_current_backing_store(*m_front_store);
+    // WindowServer keeps the last two backing stores we gave it, which are always the ones we have. So unless the front
+    // one is new, the flip and what it changed can be sent along without waiting for WindowServer.
+    if (m_front_store->is_known_to_server()) {
+        if (is_visible())
+            ConnectionToWindowServer::the().async_flip_backing_store(m_window_id, m_front_store->serial(), m_front_store->visible_size(), dirty_rects);
+    } else {
+        set_current_backing_store(*m_front_store);
+        if (is_visible())
+            ConnectionToWindowServer::the().async_did_finish_painting(m_window_id, dirty_rects);
+    }
 
     if (!m_back_store || m_back_store->size() != m_front_store->size()) {
         m_back_store = create_backing_store(m_front_store->size()).release_value_but_fixme_should_propagate_errors();
         memcpy(m_back_store->bitmap().scanline(0), m_front_store->bitmap().scanline(0), m_front_store->bitmap().size_in_bytes());
+        m_back_store->set_visible_size(m_front_store->visible_size());
         m_back_store->set_volatile();
         return;
     }
 
-    // Copy whatever was painted from the front to the back.
+    // Copy whatever was painted from the front to the back. Outside of that they only match if they were showing the
+    // same part of the window, as the backing stores are kept while the window is resized.
     Painter painter(m_back_store->bitmap());
-    for (auto& dirty_rect : dirty_rects)
-        painter.blit(dirty_rect.location(), m_front_store->bitmap(), dirty_rect, 1.0f, false);
+    if (m_back_store->visible_size() != m_front_store->visible_size()) {
+        auto visible_rect = Gfx::IntRect { {}, m_front_store->visible_size() };
+        painter.blit({}, m_front_store->bitmap(), visible_rect, 1.0f, false);
+        m_back_store->set_visible_size(m_front_store->visible_size());
+    } else {
+        for (auto& dirty_rect : dirty_rects)
+            painter.blit(dirty_rect.location(), m_front_store->bitmap(), dirty_rect, 1.0f, false);
+    }
 
     m_back_store->set_volatile();
 }
@@ -1472,6 +1507,24 @@ void Window::set_modified(bool modified)
     ConnectionToWindowServer::the().async_set_window_modified(m_window_id, modified);
 }
 
+void Window::request_frame_callback(Function<void(i64 frame_time_ms)> callback)
+{
+    if (!m_window_id)
+        return;
+    // One request covers all callbacks for the same frame.
+    if (m_frame_callbacks.is_empty())
+        ConnectionToWindowServer::the().async_request_frame_callback(m_window_id);
+    m_frame_callbacks.append(move(callback));
+}
+
+void Window::did_receive_frame_callback(Badge<ConnectionToWindowServer>, i64 frame_time_ms)
+{
+    // Callbacks usually request the next frame, which has to go into a new list.
+    auto callbacks = move(m_frame_callbacks);
+    for (auto& callback : callbacks)
+        callback(frame_time_ms);
+}
+
 void Window::flush_pending_paints_immediately()
 {
     if (!m_window_id)
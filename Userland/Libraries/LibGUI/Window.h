@@ -226,6 +226,12 @@ public:
 
     void flush_pending_paints_immediately();
 
+    // Calls the callback once WindowServer has shown the next frame of this window, with the time (in milliseconds of
+    // monotonic time) it did so. This paces animations to the frames WindowServer actually shows, and stops them while
+    // the window can't be seen. Does nothing if the window isn't shown.
+    void request_frame_callback(Function<void(i64 frame_time_ms)>);
+    void did_receive_frame_callback(Badge<ConnectionToWindowServer>, i64 frame_time_ms);
+
     Menubar& menubar() { return *m_menubar; }
     Menubar const& menubar() const { return *m_menubar; }
 
@@ -306,6 +312,7 @@ private:
     Gfx::IntRect m_floating_rect;
     ByteString m_title_when_windowless;
     Vector<Gfx::IntRect, 32> m_pending_paint_event_rects;
+    Vector<Function<void(i64)>> m_frame_callbacks;
     Gfx::IntSize m_size_increment;
     Gfx::IntSize m_base_size;
     WindowType m_window_type { WindowType::Normal };
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/CPUFeatures.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
+#include <LibGfx/CompositingKernels.h>
+
+#if defined(AK_COMPILER_GCC)
+#    pragma GCC optimize("O3")
+#endif
+
+namespace Gfx {
+
+using AK::SIMD::f32x4;
+using AK::SIMD::u16x16;
+using AK::SIMD::u32x4;
+using AK::SIMD::u32x8;
+using AK::SIMD::u8x16;
+using AK::SIMD::u8x32;
+using AK::SIMD::u8x4;
+
+using u16x32 = u16 __attribute__((vector_size(64)));
+
+// The vector types used to process 4 pixels at a time (SSE2 and NEON) and 8 pixels at a time (AVX2). Every channel
+// gets its own 16-bit lane while blending, so the products of two channels don't overflow.
+struct NarrowVectors {
+    using Pixels = u32x4;
+    using Bytes = u8x16;
+    using Channels = u16x16;
+};
+
+struct WideVectors {
+    using Pixels = u32x8;
+    using Bytes = u8x32;
+    using Channels = u16x32;
+};
+
+static constexpr u32 alpha_mask = 0xff000000;
+
+// Exact for every value in [0, 255 * 255], without needing more than 16 bits.
+template<typename T>
+ALWAYS_INLINE static T divide_by_255(T value)
+{
+    return (value + 1 + (value >> 8)) >> 8;
+}
+
+template<typename T>
+ALWAYS_INLINE static T prepare_source(T pixel, BlendRowOptions const& options)
+{
+    if (options.source_is_rgba)
+        pixel = (pixel & 0xff00ff00) | ((pixel & 0xff) << 16) | ((pixel >> 16) & 0xff);
+    if (!options.source_has_alpha)
+        pixel |= alpha_mask;
+    if (options.opacity != 255)
+        pixel = (pixel & ~alpha_mask) | (divide_by_255((pixel >> 24) * static_cast<u32>(options.opacity)) << 24);
+    return pixel;
+}
+
+ALWAYS_INLINE static ARGB32 blend_pixel(ARGB32 destination, ARGB32 source)
+{
+    return Color::from_argb(destination).blend(Color::from_argb(source)).value();
+}
+
+template<typename Pixels>
+ALWAYS_INLINE static bool are_all_opaque(Pixels pixels)
+{
+    u32 combined_alpha = alpha_mask;
+    for (size_t i = 0; i < AK::SIMD::vector_length<Pixels>; ++i)
+        combined_alpha &= pixels[i];
+    return combined_alpha == alpha_mask;
+}
+
+// Color::blend() divides by the combined alpha of both pixels, which can't be vectorized exactly. For an opaque
+// destination it reduces to (source * alpha + destination * (255 - alpha)) / 255 though, which is by far the most
+// common case, so we vectorize that and leave the other pixels to Color::blend().
+template<typename Vectors, typename LoadSource>
+ALWAYS_INLINE static void blend_row_impl(ARGB32* destination, size_t count, bool destination_has_alpha, LoadSource load_source)
+{
+    using Pixels = typename Vectors::Pixels;
+    using Bytes = typename Vectors::Bytes;
+    using Channels = typename Vectors::Channels;
+    constexpr size_t pixels_per_iteration = AK::SIMD::vector_length<Pixels>;
+
+    Pixels const destination_alpha = AK::SIMD::expand_to<Pixels>(destination_has_alpha ? 0u : alpha_mask);
+
+    size_t i = 0;
+    for (; i + pixels_per_iteration <= count; i += pixels_per_iteration) {
+        Pixels source = load_source.template vector<Pixels>(i);
+        Pixels pixels = AK::SIMD::load_unaligned<Pixels>(destination + i) | destination_alpha;
+
+        if (!are_all_opaque(pixels)) {
+            for (size_t j = 0; j < pixels_per_iteration; ++j)
+                destination[i + j] = blend_pixel(pixels[j], source[j]);
+            continue;
+        }
+
+        auto source_alpha = AK::SIMD::simd_cast<Channels>(bit_cast<Bytes>((source >> 24) * 0x01010101u));
+        auto source_channels = AK::SIMD::simd_cast<Channels>(bit_cast<Bytes>(source));
+        auto destination_channels = AK::SIMD::simd_cast<Channels>(bit_cast<Bytes>(pixels));
+
+        auto blended = divide_by_255(source_channels * source_alpha + destination_channels * (255 - source_alpha));
+        auto result = bit_cast<Pixels>(AK::SIMD::simd_cast<Bytes>(blended)) | alpha_mask;
+        AK::SIMD::store_unaligned(destination + i, result);
+    }
+
+    for (; i < count; ++i)
+        destination[i] = blend_pixel(destination[i] | destination_alpha[0], load_source.scalar(i));
+}
+
+struct LoadSourceRow {
+    ARGB32 const* source;
+    BlendRowOptions const& options;
+
+    template<typename Pixels>
+    ALWAYS_INLINE Pixels vector(size_t index) const { return prepare_source(AK::SIMD::load_unaligned<Pixels>(source + index), options); }
+    ALWAYS_INLINE ARGB32 scalar(size_t index) const { return prepare_source(source[index], options); }
+};
+
+struct LoadSourceColor {
+    ARGB32 color;
+
+    template<typename Pixels>
+    ALWAYS_INLINE Pixels vector(size_t) const { return AK::SIMD::expand_to<Pixels>(color); }
+    ALWAYS_INLINE ARGB32 scalar(size_t) const { return color; }
+};
+
+ALWAYS_INLINE static f32x4 unpack_pixel(ARGB32 pixel)
+{
+    return AK::SIMD::simd_cast<f32x4>(AK::SIMD::simd_cast<u32x4>(bit_cast<u8x4>(pixel)));
+}
+
+// Turns the sum of premultiplied colors (with the total weight of their alpha in the alpha lane) back into a pixel.
+ALWAYS_INLINE static ARGB32 pack_premultiplied(f32x4 sum, float alpha)
+{
+    if (sum[3] <= 0.f)
+        return 0;
+
+    f32x4 color = sum / sum[3];
+    color[3] = alpha;
+    color = AK::SIMD::clamp(color + 0.5f, AK::SIMD::expand4(0.f), AK::SIMD::expand4(255.f));
+    return bit_cast<ARGB32>(AK::SIMD::simd_cast<u8x4>(AK::SIMD::simd_cast<u32x4>(color)));
+}
+
+// The color channels are weighted by alpha * weight, and the alpha lane is replaced by 1 so that it sums up the weighted
+// alpha.
+ALWAYS_INLINE static f32x4 weighted_premultiplied(ARGB32 pixel, float weight, bool source_has_alpha)
+{
+    f32x4 color = unpack_pixel(pixel);
+    float const alpha = source_has_alpha ? color[3] : 255.f;
+    color[3] = 1.f;
+    return color * (alpha * weight);
+}
+
+ALWAYS_INLINE static void sample_row_bilinear_impl(ARGB32* destination, ARGB32 const* top_row, ARGB32 const* bottom_row, float bottom_weight, ReadonlySpan<BilinearColumn> columns, bool source_has_alpha, float opacity)
+{
+    float const top_weight = 1.f - bottom_weight;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        auto const& column = columns[i];
+        float const left_weight = 1.f - column.right_weight;
+
+        auto sum = weighted_premultiplied(top_row[column.left], top_weight * left_weight, source_has_alpha)
+            + weighted_premultiplied(top_row[column.right], top_weight * column.right_weight, source_has_alpha)
+            + weighted_premultiplied(bottom_row[column.left], bottom_weight * left_weight, source_has_alpha)
+            + weighted_premultiplied(bottom_row[column.right], bottom_weight * column.right_weight, source_has_alpha);
+
+        // Like Color::set_alpha(), the alpha is truncated after applying the opacity.
+        float alpha = static_cast<int>(sum[3] + 0.5f);
+        if (opacity != 1.f)
+            alpha = static_cast<int>(alpha * opacity);
+        destination[i] = pack_premultiplied(sum, alpha);
+    }
+}
+
+ALWAYS_INLINE static void sample_row_box_impl(ARGB32* destination, ARGB32 const* source, size_t source_pitch, BoxSampleSpan const& row, ReadonlySpan<BoxSampleSpan> columns, bool source_has_alpha, float alpha_scale)
+{
+    for (size_t i = 0; i < columns.size(); ++i) {
+        auto const& column = columns[i];
+
+        f32x4 sum = AK::SIMD::expand4(0.f);
+        for (int y = 0; y < row.count; ++y) {
+            ARGB32 const* scanline = source + (row.first + y) * source_pitch + column.first;
+            for (int x = 0; x < column.count; ++x)
+                sum += weighted_premultiplied(scanline[x], row.weights[y] * column.weights[x] / 255.f, source_has_alpha);
+        }
+
+        destination[i] = pack_premultiplied(sum, sum[3] * alpha_scale);
+    }
+}
+
+template<CPUFeatures>
+static void blend_row_for(ARGB32* destination, ARGB32 const* source, size_t count, BlendRowOptions const& options);
+template<CPUFeatures>
+static void blend_color_row_for(ARGB32* destination, ARGB32 color, size_t count, bool destination_has_alpha);
+template<CPUFeatures>
+static void sample_row_bilinear_for(ARGB32* destination, ARGB32 const* top_row, ARGB32 const* bottom_row, float bottom_weight, ReadonlySpan<BilinearColumn> columns, bool source_has_alpha, float opacity);
+template<CPUFeatures>
+static void sample_row_box_for(ARGB32* destination, ARGB32 const* source, size_t source_pitch, BoxSampleSpan const& row, ReadonlySpan<BoxSampleSpan> columns, bool source_has_alpha, float alpha_scale);
+
+template<>
+void blend_row_for<CPUFeatures::None>(ARGB32* destination, ARGB32 const* source, size_t count, BlendRowOptions const& options)
+{
+    blend_row_impl<NarrowVectors>(destination, count, options.destination_has_alpha, LoadSourceRow { source, options });
+}
+
+template<>
+void blend_color_row_for<CPUFeatures::None>(ARGB32* destination, ARGB32 color, size_t count, bool destination_has_alpha)
+{
+    blend_row_impl<NarrowVectors>(destination, count, destination_has_alpha, LoadSourceColor { color });
+}
+
+template<>
+void sample_row_bilinear_for<CPUFeatures::None>(ARGB32* destination, ARGB32 const* top_row, ARGB32 const* bottom_row, float bottom_weight, ReadonlySpan<BilinearColumn> columns, bool source_has_alpha, float opacity)
+{
+    sample_row_bilinear_impl(destination, top_row, bottom_row, bottom_weight, columns, source_has_alpha, opacity);
+}
+
+template<>
+void sample_row_box_for<CPUFeatures::None>(ARGB32* destination, ARGB32 const* source, size_t source_pitch, BoxSampleSpan const& row, ReadonlySpan<BoxSampleSpan> columns, bool source_has_alpha, float alpha_scale)
+{
+    sample_row_box_impl(destination, source, source_pitch, row, columns, source_has_alpha, alpha_scale);
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+template<>
+[[gnu::target("avx2")]] void blend_row_for<CPUFeatures::X86_AVX2>(ARGB32* destination, ARGB32 const* source, size_t count, BlendRowOptions const& options)
+{
+    blend_row_impl<WideVectors>(destination, count, options.destination_has_alpha, LoadSourceRow { source, options });
+}
+
+template<>
+[[gnu::target("avx2")]] void blend_color_row_for<CPUFeatures::X86_AVX2>(ARGB32* destination, ARGB32 color, size_t count, bool destination_has_alpha)
+{
+    blend_row_impl<WideVectors>(destination, count, destination_has_alpha, LoadSourceColor { color });
+}
+
+// The samplers work on one pixel per vector either way, but benefit from the VEX encoding and fewer register moves.
+template<>
+[[gnu::target("avx2")]] void sample_row_bilinear_for<CPUFeatures::X86_AVX2>(ARGB32* destination, ARGB32 const* top_row, ARGB32 const* bottom_row, float bottom_weight, ReadonlySpan<BilinearColumn> columns, bool source_has_alpha, float opacity)
+{
+    sample_row_bilinear_impl(destination, top_row, bottom_row, bottom_weight, columns, source_has_alpha, opacity);
+}
+
+template<>
+[[gnu::target("avx2")]] void sample_row_box_for<CPUFeatures::X86_AVX2>(ARGB32* destination, ARGB32 const* source, size_t source_pitch, BoxSampleSpan const& row, ReadonlySpan<BoxSampleSpan> columns, bool source_has_alpha, float alpha_scale)
+{
+    sample_row_box_impl(destination, source, source_pitch, row, columns, source_has_alpha, alpha_scale);
+}
+#endif
+
+template<template<CPUFeatures> typename Kernel>
+static auto dispatch()
+{
+    CPUFeatures features = detect_cpu_features();
+
+    if constexpr (is_valid_feature(CPUFeatures::X86_AVX2)) {
+        if (has_flag(features, CPUFeatures::X86_AVX2))
+            return Kernel<CPUFeatures::X86_AVX2>::function;
+    }
+
+    return Kernel<CPUFeatures::None>::function;
+}
+
+template<CPUFeatures features>
+struct BlendRow {
+    static constexpr auto function = &blend_row_for<features>;
+};
+
+template<CPUFeatures features>
+struct BlendColorRow {
+    static constexpr auto function = &blend_color_row_for<features>;
+};
+
+template<CPUFeatures features>
+struct SampleRowBilinear {
+    static constexpr auto function = &sample_row_bilinear_for<features>;
+};
+
+template<CPUFeatures features>
+struct SampleRowBox {
+    static constexpr auto function = &sample_row_box_for<features>;
+};
+
+static auto const s_blend_row = dispatch<BlendRow>();
+static auto const s_blend_color_row = dispatch<BlendColorRow>();
+static auto const s_sample_row_bilinear = dispatch<SampleRowBilinear>();
+static auto const s_sample_row_box = dispatch<SampleRowBox>();
+
+void blend_row(ARGB32* destination, ARGB32 const* source, size_t count, BlendRowOptions const& options)
+{
+    s_blend_row(destination, source, count, options);
+}
+
+void blend_color_row(ARGB32* destination, Color color, size_t count, bool destination_has_alpha)
+{
+    s_blend_color_row(destination, color.value(), count, destination_has_alpha);
+}
+
+void sample_row_bilinear(ARGB32* destination, ARGB32 const* top_row, ARGB32 const* bottom_row, float bottom_weight, ReadonlySpan<BilinearColumn> columns, bool source_has_alpha, float opacity)
+{
+    s_sample_row_bilinear(destination, top_row, bottom_row, bottom_weight, columns, source_has_alpha, opacity);
+}
+
+void sample_row_box(ARGB32* destination, ARGB32 const* source, size_t source_pitch, BoxSampleSpan const& row, ReadonlySpan<BoxSampleSpan> columns, bool source_has_alpha, float alpha_scale)
+{
+    s_sample_row_box(destination, source, source_pitch, row, columns, source_has_alpha, alpha_scale);
+}
+
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <AK/Types.h>
+#include <LibGfx/Color.h>
+
+// Row kernels for the hot paths of Gfx::Painter. They are vectorized with the types from AK/SIMD.h, which compile to
+// SSE2 on x86-64 and NEON on AArch64, and a wider AVX2 variant is picked at runtime on CPUs that support it.
+//
+// All pixels are BGRA8888 or BGRx8888. Pixels that are stored without an alpha channel are treated as opaque.
+
+namespace Gfx {
+
+struct BlendRowOptions {
+    // The alpha of every source pixel is multiplied by this before blending, 255 leaves it as is.
+    u8 opacity { 255 };
+    bool source_has_alpha { true };
+    // The source pixels are RGBA8888 instead of BGRA8888.
+    bool source_is_rgba { false };
+    bool destination_has_alpha { true };
+};
+
+// Composites the source pixels over the destination pixels, with exactly the same result as Color::blend().
+void blend_row(ARGB32* destination, ARGB32 const* source, size_t count, BlendRowOptions const&);
+
+// Composites a single color over the destination pixels, with exactly the same result as Color::blend().
+void blend_color_row(ARGB32* destination, Color, size_t count, bool destination_has_alpha);
+
+struct BilinearColumn {
+    int left { 0 };
+    int right { 0 };
+    float right_weight { 0 };
+};
+
+// Samples one row of a scaled image, interpolating between two source rows (with premultiplied alpha). The alpha of
+// the result is multiplied by opacity.
+void sample_row_bilinear(ARGB32* destination, ARGB32 const* top_row, ARGB32 const* bottom_row, float bottom_weight, ReadonlySpan<BilinearColumn>, bool source_has_alpha, float opacity);
+
+// The source pixels that cover one destination pixel along one axis, and how much of each of them is covered.
+struct BoxSampleSpan {
+    int first { 0 };
+    int count { 0 };
+    float const* weights { nullptr };
+};
+
+// Samples one row of a downscaled image, averaging all the source pixels that are covered by each destination pixel
+// (weighted by their coverage and alpha). The alpha of the result is their total covered alpha, in units of source
+// pixels, multiplied by alpha_scale.
+void sample_row_box(ARGB32* destination, ARGB32 const* source, size_t source_pitch, BoxSampleSpan const& row, ReadonlySpan<BoxSampleSpan> columns, bool source_has_alpha, float alpha_scale);
+
+}
@@ -7,7 +7,10 @@
 #include <AK/Array.h>
 #include <AK/Debug.h>
 #include <AK/IntegralMath.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Types.h>
+#include <LibGfx/CompositingKernels.h>
 #include <LibGfx/EdgeFlagPathRasterizer.h>
 #include <LibGfx/Painter.h>
 
@@ -20,20 +23,29 @@
 
 namespace Gfx {
 
-static auto constexpr coverage_lut = [] {
-    Array<u8, 256> coverage_lut {};
-    for (u32 sample = 0; sample <= 255; sample++)
-        coverage_lut[sample] = AK::popcount(sample);
-    return coverage_lut;
-}();
-
 template<Integral SampleType>
 static u8 compute_coverage(SampleType sample)
 {
-    u8 coverage = 0;
-    for (unsigned i = 0; i < sizeof(SampleType); i++)
-        coverage += coverage_lut[(sample >> (i * 8)) & 0xff];
-    return coverage;
+    return AK::popcount(sample);
+}
+
+// Returns the first x in [start, end] that has edge samples plotted, or end + 1 if there is none.
+// Most of a scanline is usually empty, so this skips over 16 bytes of samples at a time.
+template<Integral SampleType>
+static int find_next_edge(SampleType const* scanline, int start, int end)
+{
+    constexpr int samples_per_vector = sizeof(AK::SIMD::u32x4) / sizeof(SampleType);
+    int x = start;
+    for (; x + samples_per_vector <= end + 1; x += samples_per_vector) {
+        auto samples = AK::SIMD::load_unaligned<AK::SIMD::u32x4>(scanline + x);
+        if ((samples[0] | samples[1] | samples[2] | samples[3]) != 0)
+            break;
+    }
+    for (; x <= end; x++) {
+        if (scanline[x])
+            return x;
+    }
+    return end + 1;
 }
 
 static Vector<Detail::Edge> prepare_edges(ReadonlySpan<FloatLine> lines, unsigned samples_per_pixel, FloatPoint origin,
@@ -321,26 +333,28 @@ __attribute__((hot)) Detail::Edge* EdgeFlagPathRasterizer<SubpixelSample>::plot_
 }
 
 template<typename SubpixelSample>
-auto EdgeFlagPathRasterizer<SubpixelSample>::accumulate_even_odd_scanline(EdgeExtent edge_extent, auto init, auto sample_callback)
+auto EdgeFlagPathRasterizer<SubpixelSample>::accumulate_even_odd_scanline(EdgeExtent edge_extent, auto init, auto span_callback)
 {
     SampleType sample = init;
     VERIFY(edge_extent.min_x >= 0);
     VERIFY(edge_extent.max_x < static_cast<int>(m_scanline.size()));
-    for (int x = edge_extent.min_x; x <= edge_extent.max_x; x++) {
+    for (int x = edge_extent.min_x; x <= edge_extent.max_x;) {
         sample ^= m_scanline.data()[x];
-        sample_callback(x, sample);
-        m_scanline.data()[x] = 0;
+        auto span_end = find_next_edge(m_scanline.data(), x + 1, edge_extent.max_x) - 1;
+        span_callback(x, span_end, sample);
+        x = span_end + 1;
     }
+    edge_extent.memset_extent(m_scanline.data(), 0);
     return sample;
 }
 
 template<typename SubpixelSample>
-auto EdgeFlagPathRasterizer<SubpixelSample>::accumulate_non_zero_scanline(EdgeExtent edge_extent, auto init, auto sample_callback)
+auto EdgeFlagPathRasterizer<SubpixelSample>::accumulate_non_zero_scanline(EdgeExtent edge_extent, auto init, auto span_callback)
 {
     NonZeroAcc acc = init;
     VERIFY(edge_extent.min_x >= 0);
     VERIFY(edge_extent.max_x < static_cast<int>(m_scanline.size()));
-    for (int x = edge_extent.min_x; x <= edge_extent.max_x; x++) {
+    for (int x = edge_extent.min_x; x <= edge_extent.max_x;) {
         if (auto edges = m_scanline.data()[x]) {
             // We only need to process the windings when we hit some edges.
             for (auto y_sub = 0u; y_sub < SamplesPerPixel; y_sub++) {
@@ -355,10 +369,12 @@ auto EdgeFlagPathRasterizer<SubpixelSample>::accumulate_non_zero_scanline(EdgeEx
                 }
             }
         }
-        sample_callback(x, acc.sample);
-        m_scanline.data()[x] = 0;
-        m_windings.data()[x] = {};
+        auto span_end = find_next_edge(m_scanline.data(), x + 1, edge_extent.max_x) - 1;
+        span_callback(x, span_end, acc.sample);
+        x = span_end + 1;
     }
+    edge_extent.memset_extent(m_scanline.data(), 0);
+    edge_extent.memset_extent(m_windings.data(), 0);
     return acc;
 }
 
@@ -373,14 +389,25 @@ auto EdgeFlagPathRasterizer<SubpixelSample>::accumulate_scanline(EdgeExtent edge
 }
 
 template<typename SubpixelSample>
-void EdgeFlagPathRasterizer<SubpixelSample>::write_pixel(BitmapFormat format, ARGB32* scanline_ptr, int scanline, int offset, SampleType sample, auto& color_or_function)
+void EdgeFlagPathRasterizer<SubpixelSample>::write_span(BitmapFormat format, ARGB32* scanline_ptr, int scanline, int start, int end, SampleType sample, auto& color_or_function)
 {
     if (!sample)
         return;
-    auto dest_x = offset + m_blit_origin.x();
-    auto coverage = compute_coverage(sample);
-    auto paint_color = scanline_color(scanline, offset, SubpixelSample::coverage_to_alpha(coverage), color_or_function);
-    scanline_ptr[dest_x] = color_for_format(format, scanline_ptr[dest_x]).blend(paint_color).value();
+    auto alpha = SubpixelSample::coverage_to_alpha(compute_coverage(sample));
+    switch_on_color_or_function(
+        color_or_function,
+        [&](Color color) {
+            // Every pixel of the span is blended with the same color, so this can use the vectorized kernel.
+            auto paint_color = scanline_color(scanline, start, alpha, color);
+            blend_color_row(scanline_ptr + start + m_blit_origin.x(), paint_color, end - start + 1, format == BitmapFormat::BGRA8888);
+        },
+        [&](auto& function) {
+            for (int offset = start; offset <= end; offset++) {
+                auto dest_x = offset + m_blit_origin.x();
+                auto paint_color = scanline_color(scanline, offset, alpha, function);
+                scanline_ptr[dest_x] = color_for_format(format, scanline_ptr[dest_x]).blend(paint_color).value();
+            }
+        });
 }
 
 template<typename SubpixelSample>
@@ -407,7 +434,7 @@ FLATTEN __attribute__((hot)) void EdgeFlagPathRasterizer<SubpixelSample>::write_
     }
 
     // Accumulate non-visible section (without plotting pixels).
-    auto acc = accumulate_scanline<WindingRule>(EdgeExtent { edge_extent.min_x, left_clip - 1 }, initial_acc<WindingRule>(), [](int, SampleType) {
+    auto acc = accumulate_scanline<WindingRule>(EdgeExtent { edge_extent.min_x, left_clip - 1 }, initial_acc<WindingRule>(), [](int, int, SampleType) {
         // Do nothing!
     });
 
@@ -415,37 +442,28 @@ FLATTEN __attribute__((hot)) void EdgeFlagPathRasterizer<SubpixelSample>::write_
     auto dest_format = painter.target().format();
     auto dest_ptr = painter.target().scanline(scanline + m_blit_origin.y());
 
-    // Simple case: Handle each pixel individually.
+    // Simple case: Blend each span of equal coverage.
     // Used for PaintStyle fills and semi-transparent colors.
-    auto write_scanline_pixelwise = [&](auto& color_or_function) {
-        accumulate_scanline<WindingRule>(clipped_extent, acc, [&](int x, SampleType sample) {
-            write_pixel(dest_format, dest_ptr, scanline, x, sample, color_or_function);
+    auto write_scanline_spanwise = [&](auto& color_or_function) {
+        accumulate_scanline<WindingRule>(clipped_extent, acc, [&](int start, int end, SampleType sample) {
+            write_span(dest_format, dest_ptr, scanline, start, end, sample, color_or_function);
         });
     };
-    // Fast fill case: Track spans of solid color and set the entire span via a fast_u32_fill().
+    // Fast fill case: Set spans of full coverage via a fast_u32_fill().
     // Used for opaque colors (i.e. alpha == 255).
     auto write_scanline_with_fast_fills = [&](Color color) {
         if (color.alpha() != 255)
-            return write_scanline_pixelwise(color);
+            return write_scanline_spanwise(color);
         constexpr SampleType full_coverage = NumericLimits<SampleType>::max();
-        int full_coverage_count = 0;
-        accumulate_scanline<WindingRule>(clipped_extent, acc, [&](int x, SampleType sample) {
-            if (sample == full_coverage) {
-                full_coverage_count++;
-                return;
-            } else {
-                write_pixel(dest_format, dest_ptr, scanline, x, sample, color);
-            }
-            if (full_coverage_count > 0) {
-                fast_fill_solid_color_span(dest_ptr, x - full_coverage_count, x - 1, color);
-                full_coverage_count = 0;
-            }
+        accumulate_scanline<WindingRule>(clipped_extent, acc, [&](int start, int end, SampleType sample) {
+            if (sample == full_coverage)
+                fast_fill_solid_color_span(dest_ptr, start, end, color);
+            else
+                write_span(dest_format, dest_ptr, scanline, start, end, sample, color);
         });
-        if (full_coverage_count > 0)
-            fast_fill_solid_color_span(dest_ptr, clipped_extent.max_x - full_coverage_count + 1, clipped_extent.max_x, color);
     };
     switch_on_color_or_function(
-        color_or_function, write_scanline_with_fast_fills, write_scanline_pixelwise);
+        color_or_function, write_scanline_with_fast_fills, write_scanline_spanwise);
 }
 
 template class EdgeFlagPathRasterizer<Sample8xAA>;
@@ -172,13 +172,15 @@ private:
     template<WindingRule>
     FLATTEN void write_scanline(Painter&, int scanline, EdgeExtent, auto& color_or_function);
     Color scanline_color(int scanline, int offset, u8 alpha, auto& color_or_function);
-    void write_pixel(BitmapFormat format, ARGB32* scanline_ptr, int scanline, int offset, SampleType sample, auto& color_or_function);
+    void write_span(BitmapFormat format, ARGB32* scanline_ptr, int scanline, int start, int end, SampleType sample, auto& color_or_function);
     void fast_fill_solid_color_span(ARGB32* scanline_ptr, int start, int end, Color color);
 
+    // The accumulated sample only changes at pixels where edges were plotted, so these call the span callback with
+    // (start, end, sample) for each run of pixels that share the same sample, rather than once per pixel.
     template<WindingRule, typename Callback>
     auto accumulate_scanline(EdgeExtent, auto, Callback);
-    auto accumulate_even_odd_scanline(EdgeExtent, auto, auto sample_callback);
-    auto accumulate_non_zero_scanline(EdgeExtent, auto, auto sample_callback);
+    auto accumulate_even_odd_scanline(EdgeExtent, auto, auto span_callback);
+    auto accumulate_non_zero_scanline(EdgeExtent, auto, auto span_callback);
 
     struct WindingCounts {
         // NOTE: This only allows up to 256 winding levels. Increase this if required (i.e. to an i16).
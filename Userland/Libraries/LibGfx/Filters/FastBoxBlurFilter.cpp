@@ -8,152 +8,174 @@
 #    pragma GCC optimize("O3")
 #endif
 
-#include <AK/Function.h>
+#include <AK/SIMD.h>
 #include <AK/Vector.h>
 #include <LibGfx/Filters/FastBoxBlurFilter.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 namespace Gfx {
 
-ALWAYS_INLINE static constexpr u8 red_value(Color color)
+FastBoxBlurFilter::FastBoxBlurFilter(Bitmap& bitmap)
+    : m_bitmap(bitmap)
 {
-    return (color.alpha() == 0) ? 0xFF : color.red();
 }
-ALWAYS_INLINE static constexpr u8 green_value(Color color)
+
+void FastBoxBlurFilter::apply_single_pass(size_t radius)
 {
-    return (color.alpha() == 0) ? 0xFF : color.green();
+    apply_single_pass(radius, radius);
 }
-ALWAYS_INLINE static constexpr u8 blue_value(Color color)
+
+using AK::SIMD::u32x4;
+
+// The channels of a pixel, one per lane, in the order blue, green, red, alpha.
+ALWAYS_INLINE static u32x4 channels_of(ARGB32 pixel)
 {
-    return (color.alpha() == 0) ? 0xFF : color.blue();
+    return u32x4 { pixel & 0xff, (pixel >> 8) & 0xff, (pixel >> 16) & 0xff, pixel >> 24 };
 }
 
-FastBoxBlurFilter::FastBoxBlurFilter(Bitmap& bitmap)
-    : m_bitmap(bitmap)
+// Transparent pixels are blurred as if they were white.
+ALWAYS_INLINE static u32x4 channels_of_source(ARGB32 pixel)
 {
+    if ((pixel >> 24) == 0)
+        return u32x4 { 0xff, 0xff, 0xff, 0 };
+    return channels_of(pixel);
 }
 
-void FastBoxBlurFilter::apply_single_pass(size_t radius)
+ALWAYS_INLINE static ARGB32 pixel_of(u32x4 channels)
 {
-    apply_single_pass(radius, radius);
+    return (channels[3] << 24) | (channels[2] << 16) | (channels[1] << 8) | channels[0];
 }
 
-template<typename GetPixelFunction, typename SetPixelFunction>
-static void do_single_pass(int width, int height, size_t radius_x, size_t radius_y, GetPixelFunction get_pixel_function, SetPixelFunction set_pixel_function)
+static Vector<int> indices_up_to(int count)
 {
-    int div_x = 2 * radius_x + 1;
-    int div_y = 2 * radius_y + 1;
+    Vector<int> indices;
+    indices.ensure_capacity(count);
+    for (int i = 0; i < count; ++i)
+        indices.unchecked_append(i);
+    return indices;
+}
 
-    Vector<Color, 1024> intermediate;
-    intermediate.resize(width * height);
+// Based on the super fast blur algorithm by Quasimondo, explored here: https://stackoverflow.com/questions/21418892/understanding-super-fast-blur-algorithm
+// Each pass keeps one running sum per row or column, with all four channels in one vector. Rows and columns don't
+// depend on each other, so they are blurred in parallel.
+FLATTEN void FastBoxBlurFilter::apply_single_pass(size_t radius_x, size_t radius_y)
+{
+    auto format = m_bitmap.format();
+    VERIFY(format == BitmapFormat::BGRA8888 || format == BitmapFormat::BGRx8888);
 
-    // First pass: vertical
-    for (int y = 0; y < height; ++y) {
-        size_t sum_red = 0;
-        size_t sum_green = 0;
-        size_t sum_blue = 0;
-        size_t sum_alpha = 0;
+    // BGRx8888 pixels are opaque, whatever their top byte says.
+    ARGB32 const alpha_mask = format == BitmapFormat::BGRx8888 ? 0xff000000 : 0;
 
-        // Setup sliding window
-        for (int i = -(int)radius_x; i <= (int)radius_x; ++i) {
-            auto color_at_px = get_pixel_function(clamp(i, 0, width - 1), y);
-            sum_red += red_value(color_at_px);
-            sum_green += green_value(color_at_px);
-            sum_blue += blue_value(color_at_px);
-            sum_alpha += color_at_px.alpha();
-        }
-        // Slide horizontally
-        for (int x = 0; x < width; ++x) {
-            auto const index = y * width + x;
-            auto& current_intermediate = intermediate[index];
-            current_intermediate.set_red(sum_red / div_x);
-            current_intermediate.set_green(sum_green / div_x);
-            current_intermediate.set_blue(sum_blue / div_x);
-            current_intermediate.set_alpha(sum_alpha / div_x);
-
-            auto leftmost_x_coord = max(x - (int)radius_x, 0);
-            auto rightmost_x_coord = min(x + (int)radius_x + 1, width - 1);
-
-            auto leftmost_x_color = get_pixel_function(leftmost_x_coord, y);
-            auto rightmost_x_color = get_pixel_function(rightmost_x_coord, y);
-
-            sum_red -= red_value(leftmost_x_color);
-            sum_red += red_value(rightmost_x_color);
-            sum_green -= green_value(leftmost_x_color);
-            sum_green += green_value(rightmost_x_color);
-            sum_blue -= blue_value(leftmost_x_color);
-            sum_blue += blue_value(rightmost_x_color);
-            sum_alpha -= leftmost_x_color.alpha();
-            sum_alpha += rightmost_x_color.alpha();
-        }
-    }
+    int const width = m_bitmap.width();
+    int const height = m_bitmap.height();
+    u32 const div_x = 2 * radius_x + 1;
+    u32 const div_y = 2 * radius_y + 1;
 
-    // Second pass: horizontal
-    for (int x = 0; x < width; ++x) {
-        size_t sum_red = 0;
-        size_t sum_green = 0;
-        size_t sum_blue = 0;
-        size_t sum_alpha = 0;
+    Vector<ARGB32, 1024> intermediate;
+    intermediate.resize(width * height);
+
+    // First pass: horizontal
+    auto rows = indices_up_to(height);
+    Threading::parallel_for(rows.span(), [&](Span<int> slice) {
+        for (int y : slice) {
+            ARGB32 const* scanline = m_bitmap.scanline(y);
+            ARGB32* intermediate_row = intermediate.data() + y * width;
+            auto source_pixel = [&](int x) { return channels_of_source(scanline[x] | alpha_mask); };
+
+            // Setup sliding window
+            u32x4 sum {};
+            for (int i = -(int)radius_x; i <= (int)radius_x; ++i)
+                sum += source_pixel(clamp(i, 0, width - 1));
+
+            // Slide horizontally
+            for (int x = 0; x < width; ++x) {
+                intermediate_row[x] = pixel_of(sum / div_x);
+
+                auto leftmost_x_coord = max(x - (int)radius_x, 0);
+                auto rightmost_x_coord = min(x + (int)radius_x + 1, width - 1);
+                sum += source_pixel(rightmost_x_coord) - source_pixel(leftmost_x_coord);
+            }
+        }
+    });
+
+    // Second pass: vertical
+    // Each slice of columns is blurred by sweeping down the rows, so that the memory is still read row by row.
+    auto columns = indices_up_to(width);
+    Threading::parallel_for(columns.span(), [&](Span<int> slice) {
+        int first_x = slice.first();
+        Vector<u32x4, 64> sums;
+        sums.ensure_capacity(slice.size());
+        for (size_t x = 0; x < slice.size(); ++x)
+            sums.unchecked_append(u32x4 {});
+        auto intermediate_row = [&](int y) { return intermediate.data() + y * width + first_x; };
 
         // Setup sliding window
         for (int i = -(int)radius_y; i <= (int)radius_y; ++i) {
-            int offset = clamp(i, 0, height - 1) * width + x;
-            auto& current_intermediate = intermediate[offset];
-            sum_red += current_intermediate.red();
-            sum_green += current_intermediate.green();
-            sum_blue += current_intermediate.blue();
-            sum_alpha += current_intermediate.alpha();
+            auto const* row = intermediate_row(clamp(i, 0, height - 1));
+            for (size_t x = 0; x < slice.size(); ++x)
+                sums[x] += channels_of(row[x]);
         }
 
         for (int y = 0; y < height; ++y) {
-            auto color = Color(
-                sum_red / div_y,
-                sum_green / div_y,
-                sum_blue / div_y,
-                sum_alpha / div_y);
-
-            set_pixel_function(x, y, color);
-
-            auto const bottommost_y_coord = min(y + (int)radius_y + 1, height - 1);
-            auto const bottom_index = x + bottommost_y_coord * width;
-            auto& bottom_intermediate = intermediate[bottom_index];
-            sum_red += bottom_intermediate.red();
-            sum_green += bottom_intermediate.green();
-            sum_blue += bottom_intermediate.blue();
-            sum_alpha += bottom_intermediate.alpha();
-
-            auto const topmost_y_coord = max(y - (int)radius_y, 0);
-            auto const top_index = x + topmost_y_coord * width;
-            auto& top_intermediate = intermediate[top_index];
-            sum_red -= top_intermediate.red();
-            sum_green -= top_intermediate.green();
-            sum_blue -= top_intermediate.blue();
-            sum_alpha -= top_intermediate.alpha();
+            ARGB32* scanline = m_bitmap.scanline(y) + first_x;
+            auto const* bottom_row = intermediate_row(min(y + (int)radius_y + 1, height - 1));
+            auto const* top_row = intermediate_row(max(y - (int)radius_y, 0));
+            for (size_t x = 0; x < slice.size(); ++x) {
+                scanline[x] = pixel_of(sums[x] / div_y);
+                sums[x] += channels_of(bottom_row[x]) - channels_of(top_row[x]);
+            }
         }
-    }
+    });
 }
 
-// Based on the super fast blur algorithm by Quasimondo, explored here: https://stackoverflow.com/questions/21418892/understanding-super-fast-blur-algorithm
-FLATTEN void FastBoxBlurFilter::apply_single_pass(size_t radius_x, size_t radius_y)
+// Shrinks the bitmap by averaging blocks of factor x factor pixels.
+static ErrorOr<NonnullRefPtr<Bitmap>> downscaled_by(Bitmap const& bitmap, int factor)
 {
-    auto format = m_bitmap.format();
-    VERIFY(format == BitmapFormat::BGRA8888 || format == BitmapFormat::BGRx8888);
+    ARGB32 const alpha_mask = bitmap.format() == BitmapFormat::BGRx8888 ? 0xff000000 : 0;
+    auto downscaled = TRY(Bitmap::create(BitmapFormat::BGRA8888, { ceil_div(bitmap.width(), factor), ceil_div(bitmap.height(), factor) }));
+
+    auto rows = indices_up_to(downscaled->height());
+    Threading::parallel_for(rows.span(), [&](Span<int> slice) {
+        for (int y : slice) {
+            int first_y = y * factor;
+            int last_y = min(first_y + factor, bitmap.height());
+            for (int x = 0; x < downscaled->width(); ++x) {
+                int first_x = x * factor;
+                int last_x = min(first_x + factor, bitmap.width());
+                u32x4 sum {};
+                for (int source_y = first_y; source_y < last_y; ++source_y) {
+                    ARGB32 const* scanline = bitmap.scanline(source_y);
+                    for (int source_x = first_x; source_x < last_x; ++source_x)
+                        sum += channels_of_source(scanline[source_x] | alpha_mask);
+                }
+                downscaled->scanline(y)[x] = pixel_of(sum / static_cast<u32>((last_x - first_x) * (last_y - first_y)));
+            }
+        }
+    });
+
+    return downscaled;
+}
 
-    switch (format) {
-    case BitmapFormat::BGRx8888:
-        do_single_pass(
-            m_bitmap.width(), m_bitmap.height(), radius_x, radius_y,
-            [&](int x, int y) { return m_bitmap.get_pixel<StorageFormat::BGRx8888>(x, y); },
-            [&](int x, int y, Color color) { return m_bitmap.set_pixel<StorageFormat::BGRx8888>(x, y, color); });
-        break;
-    case BitmapFormat::BGRA8888:
-        do_single_pass(
-            m_bitmap.width(), m_bitmap.height(), radius_x, radius_y,
-            [&](int x, int y) { return m_bitmap.get_pixel<StorageFormat::BGRA8888>(x, y); },
-            [&](int x, int y, Color color) { return m_bitmap.set_pixel<StorageFormat::BGRA8888>(x, y, color); });
-        break;
-    default:
-        VERIFY_NOT_REACHED();
+// A blur this wide removes all detail that would be lost by blurring a downscaled copy and scaling it back up, and
+// blurring the copy is cheaper by the square of the factor.
+static constexpr size_t minimum_radius_for_downscaling = 32;
+static constexpr size_t radius_after_downscaling = 8;
+
+ErrorOr<void> FastBoxBlurFilter::apply_three_passes_downscaled(size_t radius)
+{
+    int factor = radius / radius_after_downscaling;
+    auto downscaled = TRY(downscaled_by(m_bitmap, factor));
+    FastBoxBlurFilter { *downscaled }.apply_three_passes(ceil_div(radius, static_cast<size_t>(factor)));
+    auto upscaled = TRY(downscaled->scaled_to_size(m_bitmap.size()));
+
+    ARGB32 const alpha_mask = m_bitmap.format() == BitmapFormat::BGRx8888 ? 0xff000000 : 0;
+    for (int y = 0; y < m_bitmap.height(); ++y) {
+        ARGB32 const* source = upscaled->scanline(y);
+        ARGB32* target = m_bitmap.scanline(y);
+        for (int x = 0; x < m_bitmap.width(); ++x)
+            target[x] = source[x] | alpha_mask;
     }
+    return {};
 }
 
 // Math from here: http://blog.ivank.net/fastest-gaussian-blur.html
@@ -162,6 +184,10 @@ void FastBoxBlurFilter::apply_three_passes(size_t radius)
     if (!radius)
         return;
 
+    // If the downscaled copy can't be allocated, the bitmap is still blurred at full size below.
+    if (radius >= minimum_radius_for_downscaling && !apply_three_passes_downscaled(radius).is_error())
+        return;
+
     constexpr size_t no_of_passes = 3;
     double w_ideal = sqrt((12 * radius * radius / (double)no_of_passes) + 1);
     int wl = floor(w_ideal);
@@ -20,6 +20,8 @@ public:
     void apply_three_passes(size_t radius);
 
 private:
+    ErrorOr<void> apply_three_passes_downscaled(size_t radius);
+
     Bitmap& m_bitmap;
 };
 
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
+#include <AK/Vector.h>
+#include <LibGfx/Filters/MatrixFilter.h>
+#include <LibThreading/ParallelAlgorithms.h>
+
+namespace Gfx {
+
+static bool is_32_bit_format(BitmapFormat format)
+{
+    return format == BitmapFormat::BGRA8888 || format == BitmapFormat::BGRx8888;
+}
+
+void MatrixFilter::apply(Bitmap& target_bitmap, IntRect const& target_rect, Bitmap const& source_bitmap, IntRect const& source_rect)
+{
+    if ((m_amount < 1.0f && !amount_handled_in_filter()) || !is_32_bit_format(source_bitmap.format()) || !is_32_bit_format(target_bitmap.format())) {
+        ColorFilter::apply(target_bitmap, target_rect, source_bitmap, source_rect);
+        return;
+    }
+
+    VERIFY(source_rect.size() == target_rect.size());
+    VERIFY(target_bitmap.rect().contains(target_rect));
+    VERIFY(source_bitmap.rect().contains(source_rect));
+
+    using namespace AK::SIMD;
+
+    // BGRx8888 pixels are opaque, whatever their top byte says.
+    u32 const source_alpha_mask = source_bitmap.format() == BitmapFormat::BGRx8888 ? 0xff000000 : 0;
+    f32x4 row_coefficients[3][3];
+    for (size_t row = 0; row < 3; ++row) {
+        for (size_t column = 0; column < 3; ++column)
+            row_coefficients[row][column] = expand4(m_operation(row, column));
+    }
+
+    // Like convert_color(), this truncates the results to whole values in [0, 255].
+    auto convert_channel = [&](size_t row, f32x4 red, f32x4 green, f32x4 blue) {
+        auto value = row_coefficients[row][0] * red + row_coefficients[row][1] * green + row_coefficients[row][2] * blue;
+        return simd_cast<u32x4>(clamp(value, expand4(0.0f), expand4(255.0f)));
+    };
+
+    auto convert_row = [&](int y) {
+        auto const* source = source_bitmap.scanline(source_rect.y() + y) + source_rect.x();
+        auto* target = target_bitmap.scanline(target_rect.y() + y) + target_rect.x();
+        int width = source_rect.width();
+
+        int x = 0;
+        for (; x + 4 <= width; x += 4) {
+            auto pixels = load_unaligned<u32x4>(source + x) | source_alpha_mask;
+            auto red = simd_cast<f32x4>((pixels >> 16) & 0xff);
+            auto green = simd_cast<f32x4>((pixels >> 8) & 0xff);
+            auto blue = simd_cast<f32x4>(pixels & 0xff);
+            auto converted = (pixels & 0xff000000) | (convert_channel(0, red, green, blue) << 16) | (convert_channel(1, red, green, blue) << 8) | convert_channel(2, red, green, blue);
+            store_unaligned(target + x, converted);
+        }
+        for (; x < width; ++x)
+            target[x] = convert_color(Color::from_argb(source[x] | source_alpha_mask)).value();
+    };
+
+    // Rows don't depend on each other, and a row only ever reads the pixels it writes, so this also works in place.
+    Vector<int> rows;
+    rows.ensure_capacity(source_rect.height());
+    for (int y = 0; y < source_rect.height(); ++y)
+        rows.unchecked_append(y);
+
+    Threading::parallel_for(rows.span(), [&](Span<int> slice) {
+        for (int y : slice)
+            convert_row(y);
+    });
+}
+
+}
@@ -19,6 +19,9 @@ public:
     {
     }
 
+    // Converts whole rows of 32-bit bitmaps at a time, four pixels per step, and falls back to ColorFilter::apply() otherwise.
+    virtual void apply(Bitmap& target_bitmap, IntRect const& target_rect, Bitmap const& source_bitmap, IntRect const& source_rect) override;
+
 protected:
     Color convert_color(Color original) override
     {
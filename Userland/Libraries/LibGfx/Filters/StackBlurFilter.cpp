@@ -14,6 +14,7 @@
 #include <AK/Math.h>
 #include <AK/Vector.h>
 #include <LibGfx/Filters/StackBlurFilter.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 namespace Gfx {
 
@@ -124,16 +125,14 @@ FLATTEN void StackBlurFilter::process_rgba(u8 radius, Color fill_color)
         return m_bitmap.set_pixel<StorageFormat::BGRA8888>(x, y, color);
     };
 
-    BlurStack blur_stack { div };
-    auto const stack_start = blur_stack.iterator_from_position(0);
-    auto const stack_end = blur_stack.iterator_from_position(radius_plus_1);
-    auto stack_iterator = stack_start;
-
     auto const sum_mult = mult_table[radius - 1];
     auto const sum_shift = shift_table[radius - 1];
 
-    for (uint y = 0; y < height; y++) {
-        stack_iterator = stack_start;
+    // Each row and then each column is blurred on its own, so they are spread across threads, each with its own stack.
+    auto blur_row = [&](uint y, BlurStack& blur_stack) {
+        auto const stack_start = blur_stack.iterator_from_position(0);
+        auto const stack_end = blur_stack.iterator_from_position(radius_plus_1);
+        auto stack_iterator = stack_start;
 
         auto color = get_pixel(0, y);
         for (uint i = 0; i < radius_plus_1; i++)
@@ -219,10 +218,12 @@ FLATTEN void StackBlurFilter::process_rgba(u8 radius, Color fill_color)
 
             ++stack_out_iterator;
         }
-    }
+    };
 
-    for (uint x = 0; x < width; x++) {
-        stack_iterator = stack_start;
+    auto blur_column = [&](uint x, BlurStack& blur_stack) {
+        auto const stack_start = blur_stack.iterator_from_position(0);
+        auto const stack_end = blur_stack.iterator_from_position(radius_plus_1);
+        auto stack_iterator = stack_start;
 
         auto color = get_pixel(x, 0);
         for (uint i = 0; i < radius_plus_1; i++)
@@ -306,7 +307,24 @@ FLATTEN void StackBlurFilter::process_rgba(u8 radius, Color fill_color)
 
             ++stack_out_iterator;
         }
-    }
+    };
+
+    Vector<uint> indices;
+    indices.ensure_capacity(max(width, height));
+    for (uint i = 0; i < max(width, height); i++)
+        indices.unchecked_append(i);
+
+    Threading::parallel_for(indices.span().trim(height), [&](Span<uint> rows) {
+        BlurStack blur_stack { div };
+        for (uint y : rows)
+            blur_row(y, blur_stack);
+    });
+
+    Threading::parallel_for(indices.span().trim(width), [&](Span<uint> columns) {
+        BlurStack blur_stack { div };
+        for (uint x : columns)
+            blur_column(x, blur_stack);
+    });
 }
 
 }
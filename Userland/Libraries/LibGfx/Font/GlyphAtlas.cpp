@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Font/GlyphAtlas.h>
+
+namespace Gfx {
+
+GlyphAtlas::GlyphAtlas(int pixel_size)
+{
+    // Make room for a few hundred glyphs per page, which covers most scripts at a typical text size in a single page.
+    static constexpr int minimum_page_dimension = 128;
+    static constexpr int maximum_page_dimension = 2048;
+
+    auto dimension = clamp(pixel_size * 16, minimum_page_dimension, maximum_page_dimension);
+    m_page_size = { dimension, dimension };
+}
+
+Optional<GlyphAtlas::Location> GlyphAtlas::add(Bitmap const& glyph_bitmap)
+{
+    auto glyph_size = glyph_bitmap.size();
+    if (glyph_size.is_empty() || glyph_size.width() > m_page_size.width() / 4 || glyph_size.height() > m_page_size.height() / 4)
+        return {};
+
+    if (!m_pages.is_empty() && m_cursor.x() + glyph_size.width() > m_page_size.width()) {
+        m_cursor = { 0, m_cursor.y() + m_row_height + padding };
+        m_row_height = 0;
+    }
+
+    if (m_pages.is_empty() || m_cursor.y() + glyph_size.height() > m_page_size.height()) {
+        auto page_bitmap = Bitmap::create(BitmapFormat::BGRA8888, m_page_size);
+        if (page_bitmap.is_error())
+            return {};
+        page_bitmap.value()->fill(Color::Transparent);
+        m_pages.append({ page_bitmap.release_value() });
+        m_cursor = {};
+        m_row_height = 0;
+    }
+
+    auto& page = m_pages.last();
+    IntRect rect { m_cursor, glyph_size };
+
+    for (int y = 0; y < glyph_size.height(); ++y)
+        __builtin_memcpy(page.bitmap->scanline(rect.y() + y) + rect.x(), glyph_bitmap.scanline(y), glyph_size.width() * sizeof(ARGB32));
+    ++page.version;
+
+    m_cursor.translate_by(glyph_size.width() + padding, 0);
+    m_row_height = max(m_row_height, glyph_size.height());
+
+    return Location { m_pages.size() - 1, rect };
+}
+
+ErrorOr<NonnullRefPtr<Bitmap>> GlyphAtlas::bitmap_for(Location const& location) const
+{
+    auto& page_bitmap = m_pages[location.page_index].bitmap;
+    auto* data = page_bitmap->scanline(location.rect.y()) + location.rect.x();
+    return Bitmap::create_wrapper(BitmapFormat::BGRA8888, location.rect.size(), 1, page_bitmap->pitch(), data, [page_bitmap] {});
+}
+
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Rect.h>
+
+namespace Gfx {
+
+// Packs the rasterized glyphs of a single font at a single size into a few large bitmaps ("pages"), instead of giving
+// every glyph its own allocation. Glyphs never move once they've been added, so a GPU painter can upload each page
+// as a single texture and the CPU painter can keep blitting from the very same pixels.
+class GlyphAtlas {
+public:
+    GlyphAtlas() = default;
+    explicit GlyphAtlas(int pixel_size);
+
+    struct Page {
+        NonnullRefPtr<Bitmap> bitmap;
+
+        // Incremented every time a glyph is added to the page, so that copies of it know when to refresh.
+        u32 version { 0 };
+    };
+
+    struct Location {
+        size_t page_index { 0 };
+        IntRect rect;
+    };
+
+    // Copies the glyph into the atlas, or returns nothing if it's too large to share a page with other glyphs.
+    Optional<Location> add(Bitmap const& glyph_bitmap);
+
+    // Returns a bitmap that shares its pixels with the atlas page (and keeps the page alive).
+    ErrorOr<NonnullRefPtr<Bitmap>> bitmap_for(Location const&) const;
+
+    Vector<Page> const& pages() const { return m_pages; }
+    IntSize page_size() const { return m_page_size; }
+
+private:
+    static constexpr int padding = 1;
+
+    IntSize m_page_size;
+    Vector<Page> m_pages;
+
+    // Glyphs are placed left to right on rows ("shelves") as tall as the tallest glyph on them.
+    IntPoint m_cursor;
+    int m_row_height { 0 };
+};
+
+}
@@ -24,6 +24,7 @@ ScaledFont::ScaledFont(NonnullRefPtr<VectorFont> font, float point_width, float
 
     m_pixel_size = m_point_height * (DEFAULT_DPI / POINTS_PER_INCH);
     m_pixel_size_rounded_up = static_cast<int>(ceilf(m_pixel_size));
+    m_glyph_atlas = GlyphAtlas(m_pixel_size_rounded_up);
 
     m_pixel_metrics = Gfx::FontPixelMetrics {
         .size = (float)pixel_size(),
@@ -79,10 +80,29 @@ RefPtr<Gfx::Bitmap> ScaledFont::rasterize_glyph(u32 glyph_id, GlyphSubpixelOffse
         return glyph_iterator->value;
 
     auto glyph_bitmap = m_font->rasterize_glyph(glyph_id, m_x_scale, m_y_scale, subpixel_offset);
+
+    // NOTE: Color bitmaps are usually emoji at a much larger size than they're drawn at, so they're kept as they are.
+    if (glyph_bitmap && !has_color_bitmaps()) {
+        if (auto location = m_glyph_atlas.add(*glyph_bitmap); location.has_value()) {
+            if (auto atlas_bitmap = m_glyph_atlas.bitmap_for(*location); !atlas_bitmap.is_error()) {
+                glyph_bitmap = atlas_bitmap.release_value();
+                m_glyph_atlas_locations.set(index, *location);
+            }
+        }
+    }
+
     m_cached_glyph_bitmaps.set(index, glyph_bitmap);
     return glyph_bitmap;
 }
 
+Optional<GlyphAtlas::Location> ScaledFont::glyph_atlas_location(u32 glyph_id, GlyphSubpixelOffset subpixel_offset) const
+{
+    GlyphIndexWithSubpixelOffset index { glyph_id, subpixel_offset };
+    if (!m_cached_glyph_bitmaps.contains(index))
+        (void)rasterize_glyph(glyph_id, subpixel_offset);
+    return m_glyph_atlas_locations.get(index).copy();
+}
+
 bool ScaledFont::append_glyph_path_to(Gfx::Path& path, u32 glyph_id) const
 {
     auto glyph_iterator = m_glyph_cache.find(glyph_id);
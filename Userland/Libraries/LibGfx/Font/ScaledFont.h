@@ -10,6 +10,7 @@
 #include <AK/HashMap.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Font/Font.h>
+#include <LibGfx/Font/GlyphAtlas.h>
 #include <LibGfx/Font/VectorFont.h>
 
 namespace Gfx {
@@ -31,6 +32,10 @@ public:
     RefPtr<Gfx::Bitmap> rasterize_glyph(u32 glyph_id, GlyphSubpixelOffset) const;
     bool append_glyph_path_to(Gfx::Path&, u32 glyph_id) const;
 
+    // Rasterizes the glyph if needed, and returns where it ended up in the glyph atlas (if it was put in there).
+    Optional<GlyphAtlas::Location> glyph_atlas_location(u32 glyph_id, GlyphSubpixelOffset) const;
+    GlyphAtlas const& glyph_atlas() const { return m_glyph_atlas; }
+
     // ^Gfx::Font
     virtual NonnullRefPtr<Font> clone() const override { return MUST(try_clone()); } // FIXME: clone() should not need to be implemented
     virtual ErrorOr<NonnullRefPtr<Font>> try_clone() const override { return const_cast<ScaledFont&>(*this); }
@@ -90,6 +95,8 @@ private:
 
     mutable HashMap<u32, Gfx::Path> m_glyph_cache;
     mutable HashMap<GlyphIndexWithSubpixelOffset, RefPtr<Gfx::Bitmap>> m_cached_glyph_bitmaps;
+    mutable HashMap<GlyphIndexWithSubpixelOffset, GlyphAtlas::Location> m_glyph_atlas_locations;
+    mutable GlyphAtlas m_glyph_atlas;
     Gfx::FontPixelMetrics m_pixel_metrics;
 
     float m_pixel_size { 0.0f };
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibGfx/ICC/ColorTransform.h>
+#include <LibGfx/ICC/Profile.h>
+#include <LibThreading/Mutex.h>
+
+namespace Gfx::ICC {
+
+// The grid points have to be at whole channel values, since the profiles only convert 8-bit colors. For three channels
+// they are 15 apart (18 points per channel), for four channels 17 apart (16 points per channel), which keeps sampling
+// the four-dimensional grid affordable.
+static size_t grid_step(size_t number_of_input_channels)
+{
+    return number_of_input_channels == 3 ? 15 : 17;
+}
+
+static size_t grid_size(size_t number_of_input_channels)
+{
+    return 255 / grid_step(number_of_input_channels) + 1;
+}
+
+size_t ColorTransform::number_of_grid_points(size_t number_of_input_channels)
+{
+    size_t size = grid_size(number_of_input_channels);
+    size_t count = 1;
+    for (size_t i = 0; i < number_of_input_channels; ++i)
+        count *= size;
+    return count;
+}
+
+ErrorOr<NonnullRefPtr<ColorTransform>> ColorTransform::create(Profile const& source_profile, Profile const& destination_profile)
+{
+    if (destination_profile.data_color_space() != ColorSpace::RGB)
+        return Error::from_string_literal("ICC::ColorTransform: Destination profile must be an RGB profile");
+
+    size_t number_of_input_channels = number_of_components_in_color_space(source_profile.data_color_space());
+    if (number_of_input_channels != 3 && number_of_input_channels != 4)
+        return Error::from_string_literal("ICC::ColorTransform: Source profile must have three or four channels");
+
+    auto grid = TRY(FixedArray<AK::SIMD::f32x4>::create(number_of_grid_points(number_of_input_channels)));
+
+    // The grid is laid out with the first input channel varying slowest, which is the same order as counting up the
+    // channels like digits. For four channels, the fourth channel is moved to the front (see m_strides).
+    size_t size = grid_size(number_of_input_channels);
+    size_t step = grid_step(number_of_input_channels);
+    Array<u8, 4> input {};
+    u8 output[3];
+    for (size_t i = 0; i < grid.size(); ++i) {
+        size_t remaining = i;
+        for (size_t channel = number_of_input_channels; channel-- > 0;) {
+            input[channel] = (remaining % size) * step;
+            remaining /= size;
+        }
+        if (number_of_input_channels == 4)
+            input = { input[1], input[2], input[3], input[0] };
+
+        auto pcs = TRY(source_profile.to_pcs(ReadonlyBytes { input.data(), number_of_input_channels }));
+        TRY(destination_profile.from_pcs(source_profile, pcs, output));
+        grid[i] = AK::SIMD::f32x4 { static_cast<float>(output[0]), static_cast<float>(output[1]), static_cast<float>(output[2]), 0.0f };
+    }
+
+    return adopt_nonnull_ref_or_enomem(new (nothrow) ColorTransform(number_of_input_channels, move(grid)));
+}
+
+ColorTransform::ColorTransform(size_t number_of_input_channels, FixedArray<AK::SIMD::f32x4> grid)
+    : m_number_of_input_channels(number_of_input_channels)
+    , m_grid(move(grid))
+{
+    size_t size = grid_size(number_of_input_channels);
+    size_t step = grid_step(number_of_input_channels);
+
+    m_strides = { size * size, size, 1, number_of_input_channels == 4 ? size * size * size : 0 };
+
+    for (size_t value = 0; value < 256; ++value) {
+        // The last grid point is the far corner of the last cell, so 255 is at the end of a cell instead of starting one.
+        size_t index = min(value / step, size - 2);
+        m_positions[value] = { index, static_cast<float>(value - index * step) / step };
+    }
+}
+
+// A small cache, since converting a few large images between the same profiles (e.g. the pages of a PDF) is common.
+static constexpr size_t transform_cache_size = 4;
+
+struct CachedTransform {
+    NonnullRefPtr<Profile const> source_profile;
+    NonnullRefPtr<Profile const> destination_profile;
+    NonnullRefPtr<ColorTransform> transform;
+};
+
+static bool is_same_profile(Profile const& a, Profile const& b)
+{
+    if (&a == &b)
+        return true;
+
+    // The profile ID is an MD5 hash of the profile contents (ICC v4, 7.2.18), so it matches for profiles that were loaded separately, too.
+    return a.id().has_value() && b.id().has_value() && a.id().value() == b.id().value();
+}
+
+ErrorOr<NonnullRefPtr<ColorTransform>> ColorTransform::for_profiles(Profile const& source_profile, Profile const& destination_profile)
+{
+    static Threading::Mutex s_cache_mutex;
+    static Vector<CachedTransform, transform_cache_size> s_cache;
+
+    {
+        Threading::MutexLocker locker(s_cache_mutex);
+        for (size_t i = 0; i < s_cache.size(); ++i) {
+            if (is_same_profile(s_cache[i].source_profile, source_profile) && is_same_profile(s_cache[i].destination_profile, destination_profile)) {
+                // Keep the most recently used transform at the front.
+                auto entry = s_cache.take(i);
+                auto transform = entry.transform;
+                s_cache.prepend(move(entry));
+                return transform;
+            }
+        }
+    }
+
+    // Another thread might create the same transform in the meantime, which only costs some time.
+    auto transform = TRY(create(source_profile, destination_profile));
+
+    Threading::MutexLocker locker(s_cache_mutex);
+    if (s_cache.size() == transform_cache_size)
+        s_cache.take_last();
+    s_cache.prepend({ source_profile, destination_profile, transform });
+    return transform;
+}
+
+// Splits the cube around a color into six tetrahedra along its diagonal, and interpolates between the four corners of
+// the tetrahedron that contains the color. This only needs four corners instead of the eight that trilinear
+// interpolation needs, and it keeps the gray axis on the diagonal exact.
+AK::SIMD::f32x4 ColorTransform::interpolate_tetrahedrally(AK::SIMD::f32x4 const* cube, float f0, float f1, float f2) const
+{
+    auto corner = [&](size_t d0, size_t d1, size_t d2) {
+        return cube[d0 * m_strides[0] + d1 * m_strides[1] + d2 * m_strides[2]];
+    };
+
+    auto c000 = corner(0, 0, 0);
+    auto c111 = corner(1, 1, 1);
+    if (f0 >= f1) {
+        if (f1 >= f2) {
+            auto c100 = corner(1, 0, 0);
+            auto c110 = corner(1, 1, 0);
+            return c000 + (c100 - c000) * f0 + (c110 - c100) * f1 + (c111 - c110) * f2;
+        }
+        if (f0 >= f2) {
+            auto c100 = corner(1, 0, 0);
+            auto c101 = corner(1, 0, 1);
+            return c000 + (c100 - c000) * f0 + (c101 - c100) * f2 + (c111 - c101) * f1;
+        }
+        auto c001 = corner(0, 0, 1);
+        auto c101 = corner(1, 0, 1);
+        return c000 + (c001 - c000) * f2 + (c101 - c001) * f0 + (c111 - c101) * f1;
+    }
+    if (f2 >= f1) {
+        auto c001 = corner(0, 0, 1);
+        auto c011 = corner(0, 1, 1);
+        return c000 + (c001 - c000) * f2 + (c011 - c001) * f1 + (c111 - c011) * f0;
+    }
+    if (f2 >= f0) {
+        auto c010 = corner(0, 1, 0);
+        auto c011 = corner(0, 1, 1);
+        return c000 + (c010 - c000) * f1 + (c011 - c010) * f2 + (c111 - c011) * f0;
+    }
+    auto c010 = corner(0, 1, 0);
+    auto c110 = corner(1, 1, 0);
+    return c000 + (c010 - c000) * f1 + (c110 - c010) * f0 + (c111 - c110) * f2;
+}
+
+ARGB32 ColorTransform::map(u8 c0, u8 c1, u8 c2, u8 c3, u8 alpha) const
+{
+    using namespace AK::SIMD;
+
+    auto const& p0 = m_positions[c0];
+    auto const& p1 = m_positions[c1];
+    auto const& p2 = m_positions[c2];
+    auto const* cube = m_grid.data() + p0.index * m_strides[0] + p1.index * m_strides[1] + p2.index * m_strides[2];
+
+    f32x4 color;
+    if (m_number_of_input_channels == 3) {
+        color = interpolate_tetrahedrally(cube, p0.fraction, p1.fraction, p2.fraction);
+    } else {
+        auto const& p3 = m_positions[c3];
+        cube += p3.index * m_strides[3];
+        auto lower = interpolate_tetrahedrally(cube, p0.fraction, p1.fraction, p2.fraction);
+        auto upper = interpolate_tetrahedrally(cube + m_strides[3], p0.fraction, p1.fraction, p2.fraction);
+        color = lower + (upper - lower) * p3.fraction;
+    }
+
+    // The interpolated values stay within the range of the grid values, so they only need to be rounded.
+    auto rounded = simd_cast<u32x4>(color + 0.5f);
+    return (static_cast<u32>(alpha) << 24) | (rounded[0] << 16) | (rounded[1] << 8) | rounded[2];
+}
+
+void ColorTransform::convert_row(Span<ARGB32> pixels) const
+{
+    VERIFY(m_number_of_input_channels == 3);
+    for (auto& pixel : pixels)
+        pixel = map(pixel >> 16, pixel >> 8, pixel, 0, pixel >> 24);
+}
+
+void ColorTransform::convert_cmyk_row(Span<ARGB32> out, ReadonlySpan<CMYK> in) const
+{
+    VERIFY(m_number_of_input_channels == 4);
+    VERIFY(out.size() == in.size());
+    for (size_t i = 0; i < in.size(); ++i)
+        out[i] = map(in[i].c, in[i].m, in[i].y, in[i].k, 255);
+}
+
+void ColorTransform::convert_bytes_row(Span<ARGB32> out, ReadonlyBytes in) const
+{
+    VERIFY(in.size() == out.size() * m_number_of_input_channels);
+    if (m_number_of_input_channels == 3) {
+        for (size_t i = 0; i < out.size(); ++i)
+            out[i] = map(in[3 * i], in[3 * i + 1], in[3 * i + 2], 0, 255);
+    } else {
+        for (size_t i = 0; i < out.size(); ++i)
+            out[i] = map(in[4 * i], in[4 * i + 1], in[4 * i + 2], in[4 * i + 3], 255);
+    }
+}
+
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Error.h>
+#include <AK/FixedArray.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/SIMD.h>
+#include <AK/Span.h>
+#include <LibGfx/CMYKBitmap.h>
+#include <LibGfx/Color.h>
+
+namespace Gfx::ICC {
+
+class Profile;
+
+// Converts colors with three or four channels (e.g. RGB or CMYK) from one profile to an RGB profile.
+//
+// Converting through the profile connection space is slow, so the conversion is sampled on a grid once, and colors are
+// then interpolated between the grid points around them: tetrahedrally in the first three channels, and linearly along
+// the fourth channel. The result is within a few steps per channel of converting every color on its own, so this is
+// used for images that have many more pixels than the grid has points.
+class ColorTransform : public RefCounted<ColorTransform> {
+public:
+    static ErrorOr<NonnullRefPtr<ColorTransform>> create(Profile const& source_profile, Profile const& destination_profile);
+
+    // Returns the transform from a small process-wide cache if one was made for the same profiles recently, and
+    // creates it otherwise.
+    static ErrorOr<NonnullRefPtr<ColorTransform>> for_profiles(Profile const& source_profile, Profile const& destination_profile);
+
+    // The number of samples that creating a transform costs, each about as much as converting a single color directly.
+    static size_t number_of_grid_points(size_t number_of_input_channels);
+
+    size_t number_of_input_channels() const { return m_number_of_input_channels; }
+
+    // Converts RGB pixels in place and keeps their alpha. Needs three input channels.
+    void convert_row(Span<ARGB32>) const;
+
+    // Needs four input channels.
+    void convert_cmyk_row(Span<ARGB32> out, ReadonlySpan<CMYK> in) const;
+
+    // Converts colors that are stored as number_of_input_channels() consecutive bytes each to opaque pixels.
+    void convert_bytes_row(Span<ARGB32> out, ReadonlyBytes in) const;
+
+private:
+    ColorTransform(size_t number_of_input_channels, FixedArray<AK::SIMD::f32x4> grid);
+
+    ALWAYS_INLINE ARGB32 map(u8 c0, u8 c1, u8 c2, u8 c3, u8 alpha) const;
+    ALWAYS_INLINE AK::SIMD::f32x4 interpolate_tetrahedrally(AK::SIMD::f32x4 const* cube, float f0, float f1, float f2) const;
+
+    size_t m_number_of_input_channels { 0 };
+
+    // The converted colors at the grid points, indexed as [fourth channel][first][second][third]. Each holds the red,
+    // green and blue output channels in [0, 255], and an unused fourth lane.
+    FixedArray<AK::SIMD::f32x4> m_grid;
+    Array<size_t, 4> m_strides {};
+
+    // The grid cell that each channel value falls into, and how far into it the value is.
+    struct GridPosition {
+        size_t index { 0 };
+        float fraction { 0 };
+    };
+    Array<GridPosition, 256> m_positions;
+};
+
+}
@@ -8,9 +8,11 @@
 #include <LibGfx/CIELAB.h>
 #include <LibGfx/CMYKBitmap.h>
 #include <LibGfx/ICC/BinaryFormat.h>
+#include <LibGfx/ICC/ColorTransform.h>
 #include <LibGfx/ICC/Profile.h>
 #include <LibGfx/ICC/Tags.h>
 #include <LibGfx/Matrix3x3.h>
+#include <LibThreading/ParallelAlgorithms.h>
 #include <math.h>
 #include <time.h>
 
@@ -1717,11 +1719,45 @@ ErrorOr<void> Profile::convert_image_matrix_matrix(Gfx::Bitmap& bitmap, MatrixMa
     return {};
 }
 
+// Sampling a ColorTransform costs about as much as converting that many pixels, so it only pays off for larger images.
+static RefPtr<ColorTransform> color_transform_for_image(Profile const& source_profile, Profile const& destination_profile, size_t pixel_count)
+{
+    auto number_of_input_channels = number_of_components_in_color_space(source_profile.data_color_space());
+    if (number_of_input_channels != 3 && number_of_input_channels != 4)
+        return nullptr;
+    if (pixel_count <= ColorTransform::number_of_grid_points(number_of_input_channels))
+        return nullptr;
+
+    // If the transform can't be made, the pixels are converted one by one instead.
+    auto transform_or_error = ColorTransform::for_profiles(source_profile, destination_profile);
+    if (transform_or_error.is_error())
+        return nullptr;
+    return transform_or_error.release_value();
+}
+
+static ErrorOr<Vector<int>> rows_of(IntSize size)
+{
+    Vector<int> rows;
+    TRY(rows.try_ensure_capacity(size.height()));
+    for (int y = 0; y < size.height(); ++y)
+        rows.unchecked_append(y);
+    return rows;
+}
+
 ErrorOr<void> Profile::convert_image(Gfx::Bitmap& bitmap, Profile const& source_profile) const
 {
     if (auto map = matrix_matrix_conversion(source_profile); map.has_value())
         return convert_image_matrix_matrix(bitmap, map.value());
 
+    if (auto transform = color_transform_for_image(source_profile, *this, bitmap.width() * bitmap.height()); transform && transform->number_of_input_channels() == 3) {
+        auto rows = TRY(rows_of(bitmap.size()));
+        Threading::parallel_for(rows.span(), [&](Span<int> slice) {
+            for (int y : slice)
+                transform->convert_row({ bitmap.scanline(y), static_cast<size_t>(bitmap.width()) });
+        });
+        return {};
+    }
+
     for (auto& pixel : bitmap) {
         u8 rgb[] = { Color::from_argb(pixel).red(), Color::from_argb(pixel).green(), Color::from_argb(pixel).blue() };
         auto pcs = TRY(source_profile.to_pcs(rgb));
@@ -1745,6 +1781,16 @@ ErrorOr<void> Profile::convert_cmyk_image(Bitmap& out, CMYKBitmap const& in, Pro
     ARGB32* out_data = out.begin();
     CMYK const* in_data = const_cast<CMYKBitmap&>(in).begin();
 
+    if (auto transform = color_transform_for_image(source_profile, *this, in.data_size() / sizeof(CMYK)); transform && transform->number_of_input_channels() == 4) {
+        auto rows = TRY(rows_of(in.size()));
+        size_t width = in.size().width();
+        Threading::parallel_for(rows.span(), [&](Span<int> slice) {
+            for (int y : slice)
+                transform->convert_cmyk_row({ out_data + y * width, width }, { in_data + y * width, width });
+        });
+        return {};
+    }
+
     for (size_t i = 0; i < in.data_size() / sizeof(CMYK); ++i) {
         u8 cmyk[] = { in_data[i].c, in_data[i].m, in_data[i].y, in_data[i].k };
         auto pcs = TRY(source_profile.to_pcs(cmyk));
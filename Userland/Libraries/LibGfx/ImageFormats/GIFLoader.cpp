@@ -89,6 +89,10 @@ struct GIFLoadingContext {
     RefPtr<Gfx::Bitmap> frame_buffer;
     size_t current_frame { 0 };
     RefPtr<Gfx::Bitmap> prev_frame_buffer;
+
+    // The data may end anywhere, so whatever part of the image data is there is decoded. See partial_frame().
+    bool may_be_truncated { false };
+    int decoded_rows { 0 };
 };
 
 enum class GIFFormat {
@@ -133,6 +137,18 @@ static void clear_rect(Bitmap& bitmap, IntRect const& rect, Color color)
     }
 }
 
+static int decoded_rows_of_frame(GIFLoadingContext const& context, GIFImageDescriptor const& image, size_t decoded_pixel_count)
+{
+    // Everything above the first row of the image that wasn't completely decoded is final. The passes of interlaced
+    // images are spread over all of it, so those are only done when they're complete.
+    int const height = context.logical_screen.height;
+    if (!image.width || decoded_pixel_count >= static_cast<size_t>(image.width) * image.height)
+        return height;
+    if (image.interlaced)
+        return 0;
+    return min(image.y + static_cast<int>(decoded_pixel_count / image.width), height);
+}
+
 static ErrorOr<void> decode_frame(GIFLoadingContext& context, size_t frame_index)
 {
     if (frame_index >= context.images.size()) {
@@ -184,7 +200,11 @@ static ErrorOr<void> decode_frame(GIFLoadingContext& context, size_t frame_index
         if (image->lzw_min_code_size > 8)
             return Error::from_string_literal("LZW minimum code size is greater than 8");
 
-        auto decoded_stream = TRY(Compress::LzwDecompressor<LittleEndianInputBitStream>::decompress_all(image->lzw_encoded_bytes, image->lzw_min_code_size));
+        using LzwDecompressor = Compress::LzwDecompressor<LittleEndianInputBitStream>;
+        auto decoded_stream = TRY(context.may_be_truncated
+                ? LzwDecompressor::decompress_available(image->lzw_encoded_bytes, image->lzw_min_code_size)
+                : LzwDecompressor::decompress_all(image->lzw_encoded_bytes, image->lzw_min_code_size));
+        context.decoded_rows = decoded_rows_of_frame(context, *image, decoded_stream.size());
 
         auto const& color_map = image->use_global_color_map ? context.logical_screen.color_map : image->color_map;
 
@@ -363,8 +383,12 @@ static ErrorOr<void> load_gif_frame_descriptors(GIFLoadingContext& context)
                 if (lzw_encoded_bytes_expected == 0)
                     break;
 
-                auto const lzw_subblock = TRY(image->lzw_encoded_bytes.get_bytes_for_writing(lzw_encoded_bytes_expected));
+                // If the data was cut off, the part of the sub-block that is there is kept. See partial_frame().
+                auto const lzw_encoded_bytes_available = min<size_t>(lzw_encoded_bytes_expected, context.stream.remaining());
+                auto const lzw_subblock = TRY(image->lzw_encoded_bytes.get_bytes_for_writing(lzw_encoded_bytes_available));
                 TRY(context.stream.read_until_filled(lzw_subblock));
+                if (lzw_encoded_bytes_available < lzw_encoded_bytes_expected)
+                    return Error::from_string_literal("Unexpected end of LZW data");
             }
 
             current_image = make<GIFImageDescriptor>();
@@ -499,4 +523,19 @@ ErrorOr<ImageFrameDescriptor> GIFImageDecoderPlugin::frame(size_t index, Optiona
     return frame;
 }
 
+ErrorOr<PartialFrameDescriptor> GIFImageDecoderPlugin::partial_frame()
+{
+    m_context->may_be_truncated = true;
+
+    if (m_context->state < GIFLoadingContext::State::FrameDescriptorsLoaded) {
+        // The data may end before the descriptors of all images are loaded, but the first one is all that's needed.
+        auto result = load_gif_frame_descriptors(*m_context);
+        if (result.is_error() && (m_context->images.is_empty() || m_context->images[0]->lzw_encoded_bytes.is_empty()))
+            return result.release_error();
+    }
+
+    TRY(decode_frame(*m_context, 0));
+    return PartialFrameDescriptor { m_context->frame_buffer, m_context->decoded_rows };
+}
+
 }
@@ -30,6 +30,7 @@ public:
     virtual size_t frame_count() override;
     virtual size_t first_animated_frame_index() override;
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) override;
+    virtual ErrorOr<PartialFrameDescriptor> partial_frame() override;
 
 private:
     GIFImageDecoderPlugin(FixedMemoryStream);
@@ -26,6 +26,13 @@ struct ImageFrameDescriptor {
     int duration { 0 };
 };
 
+// The part of the first frame that could be decoded from data that has not fully arrived yet.
+// Rows [0, decoded_rows) of the image are final, the contents of the remaining rows are unspecified.
+struct PartialFrameDescriptor {
+    RefPtr<Bitmap> image;
+    int decoded_rows { 0 };
+};
+
 struct VectorImageFrameDescriptor {
     RefPtr<VectorGraphic> image;
     int duration { 0 };
@@ -84,6 +91,10 @@ public:
 
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) = 0;
 
+    // Override this if the first frame can be decoded from a prefix of the image data.
+    // The plugin is then created from the data that has arrived so far, which may end anywhere after the header.
+    virtual ErrorOr<PartialFrameDescriptor> partial_frame() { return Error::from_string_literal("Image format does not support partial decoding"); }
+
     virtual Optional<Metadata const&> metadata() { return OptionalNone {}; }
 
     virtual ErrorOr<Optional<ReadonlyBytes>> icc_data() { return OptionalNone {}; }
@@ -110,6 +121,7 @@ public:
     size_t first_animated_frame_index() const { return m_plugin->first_animated_frame_index(); }
 
     ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) const { return m_plugin->frame(index, ideal_size); }
+    ErrorOr<PartialFrameDescriptor> partial_frame() const { return m_plugin->partial_frame(); }
 
     Optional<Metadata const&> metadata() const { return m_plugin->metadata(); }
     ErrorOr<Optional<ReadonlyBytes>> icc_data() const { return m_plugin->icc_data(); }
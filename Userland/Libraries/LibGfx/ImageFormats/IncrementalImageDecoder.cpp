@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/ImageFormats/IncrementalImageDecoder.h>
+
+namespace Gfx {
+
+// A partial frame is decoded whenever the data has grown by half since the last one, but not for every few bytes of
+// a small image. Since each decode costs about as much as the data it covers, this adds up to about three full decodes.
+static constexpr size_t minimum_data_growth_for_partial_frame = 16 * KiB;
+
+IncrementalImageDecoder::IncrementalImageDecoder(Optional<ByteString> mime_type)
+    : m_mime_type(move(mime_type))
+{
+}
+
+ErrorOr<void> IncrementalImageDecoder::append_data(ReadonlyBytes data)
+{
+    return m_data.try_append(data);
+}
+
+bool IncrementalImageDecoder::should_decode_partial_frame() const
+{
+    auto growth = m_data.size() - m_data_size_at_last_partial_frame;
+    return growth >= max(minimum_data_growth_for_partial_frame, m_data_size_at_last_partial_frame / 2);
+}
+
+static void clear_undecoded_rows(Bitmap& bitmap, int decoded_rows)
+{
+    // Undecoded rows are transparent, so the decoded ones have to be made explicitly opaque if they weren't before.
+    if (!bitmap.has_alpha_channel()) {
+        for (int y = 0; y < decoded_rows; ++y) {
+            for (auto& pixel : Span<ARGB32> { bitmap.scanline(y), static_cast<size_t>(bitmap.width()) })
+                pixel |= 0xff000000;
+        }
+        bitmap.add_alpha_channel();
+    }
+
+    for (int y = decoded_rows; y < bitmap.height(); ++y)
+        memset(bitmap.scanline(y), 0, bitmap.width() * sizeof(ARGB32));
+}
+
+ErrorOr<Optional<PartialFrameDescriptor>> IncrementalImageDecoder::decode_partial_frame()
+{
+    m_data_size_at_last_partial_frame = m_data.size();
+
+    // Until the header has arrived there might not be a plugin willing to take the data.
+    auto decoder_or_error = ImageDecoder::try_create_for_raw_bytes(m_data, m_mime_type);
+    if (decoder_or_error.is_error() || !decoder_or_error.value())
+        return OptionalNone {};
+
+    auto partial_frame_or_error = decoder_or_error.value()->partial_frame();
+    if (partial_frame_or_error.is_error())
+        return OptionalNone {};
+
+    auto partial_frame = partial_frame_or_error.release_value();
+    if (!partial_frame.image || partial_frame.decoded_rows <= 0)
+        return OptionalNone {};
+
+    partial_frame.decoded_rows = min(partial_frame.decoded_rows, partial_frame.image->height());
+    if (partial_frame.decoded_rows < partial_frame.image->height()) {
+        // The plugin may still refer to its bitmap, so the rows are cleared in a copy.
+        partial_frame.image = TRY(partial_frame.image->clone());
+        clear_undecoded_rows(*partial_frame.image, partial_frame.decoded_rows);
+    }
+
+    return partial_frame;
+}
+
+}
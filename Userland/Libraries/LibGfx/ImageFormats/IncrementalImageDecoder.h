@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/Optional.h>
+#include <LibGfx/ImageFormats/ImageDecoder.h>
+
+namespace Gfx {
+
+// Decodes the first frame of an image while its data is still arriving, e.g. over the network.
+//
+// The plugins can't pick up where they left off, so every partial frame is decoded from the start of the data again.
+// To keep that cheap, should_decode_partial_frame() only asks for a new one once the data has grown by a good part
+// since the last one, which keeps the total work within a small multiple of decoding the complete image once.
+class IncrementalImageDecoder {
+public:
+    explicit IncrementalImageDecoder(Optional<ByteString> mime_type = {});
+
+    ErrorOr<void> append_data(ReadonlyBytes);
+    ReadonlyBytes data() const { return m_data; }
+    Optional<ByteString> const& mime_type() const { return m_mime_type; }
+
+    bool should_decode_partial_frame() const;
+
+    // Decodes as much of the first frame as the data so far allows. The rows that could not be decoded yet are
+    // transparent. Returns an empty Optional if no rows could be decoded, e.g. because the header is still missing
+    // or because the image format can't be decoded partially.
+    ErrorOr<Optional<PartialFrameDescriptor>> decode_partial_frame();
+
+private:
+    Optional<ByteString> m_mime_type;
+    ByteBuffer m_data;
+    size_t m_data_size_at_last_partial_frame { 0 };
+};
+
+}
@@ -7,10 +7,15 @@
 #pragma once
 
 #include <AK/Enumerate.h>
+#include <AK/FixedArray.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Vector.h>
 #include <LibGfx/ImageFormats/JPEG2000Span2D.h>
 #include <LibGfx/Rect.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 namespace Gfx::JPEG2000 {
 
@@ -43,22 +48,79 @@ struct IDWTOutput {
     Vector<float> data;
 };
 
+// The 1D procedures below run either on single samples (for rows, and the last few columns), or on four adjacent
+// columns at once (with f32x4), since the same filter is applied to all columns of a sub-band.
+template<typename T>
 struct IDWTInternalBuffers {
-    Vector<float> scanline_buffer;
-    Vector<float> scanline_buffer2;
+    // Leave enough room for max expansion in _1D_EXTR.
+    explicit IDWTInternalBuffers(int length)
+        : scanline_buffer(MUST(FixedArray<T>::create(length + 8)))
+        , scanline_buffer2(MUST(FixedArray<T>::create(length + 8)))
+    {
+    }
+
+    FixedArray<T> scanline_buffer;
+    FixedArray<T> scanline_buffer2;
     int scanline_start { 0 };
 };
 
+template<typename T>
+ALWAYS_INLINE T load_samples(IDWTOutput const& a, int index)
+{
+    if constexpr (IsSame<T, float>)
+        return a.data[index];
+    else
+        return AK::SIMD::load_unaligned<T>(a.data.span().slice(index, sizeof(T) / sizeof(float)).data());
+}
+
+template<typename T>
+ALWAYS_INLINE void store_samples(IDWTOutput& a, int index, T samples)
+{
+    if constexpr (IsSame<T, float>)
+        a.data[index] = samples;
+    else
+        AK::SIMD::store_unaligned(a.data.span().slice(index, sizeof(T) / sizeof(float)).data(), samples);
+}
+
+template<typename T>
+ALWAYS_INLINE T floor_samples(T samples)
+{
+    if constexpr (IsSame<T, float>)
+        return floorf(samples);
+    else
+        return AK::SIMD::floor_int_range(samples);
+}
+
+// Rows and columns are reconstructed on multiple threads, but only in batches of at least this many samples, so that
+// small sub-bands aren't split into tasks that aren't worth handing to another thread.
+constexpr int minimum_samples_per_idwt_task = 16384;
+
+template<typename Callback>
+inline ErrorOr<void> for_each_line_in_parallel(int line_count, int samples_per_line, Callback const& callback)
+{
+    Vector<int> lines;
+    TRY(lines.try_ensure_capacity(line_count));
+    for (int i = 0; i < line_count; ++i)
+        lines.unchecked_append(i);
+
+    auto grain_size = static_cast<size_t>(max(ceil_div(minimum_samples_per_idwt_task, max(samples_per_line, 1)), 1));
+    Threading::parallel_for(lines.span(), grain_size, callback);
+    return {};
+}
+
 // F.3 Inverse discrete wavelet transformation
 
 // "SR" is for "subband reconstruction".
 inline ErrorOr<IDWTOutput> _2D_SR(Transformation transformation, IDWTOutput ll, IDWTDecomposition const&);
 inline ErrorOr<IDWTOutput> _2D_INTERLEAVE(IDWTOutput ll, IDWTDecomposition const&);
-inline ErrorOr<IDWTOutput> HOR_SR(Transformation transformation, IDWTOutput, IDWTInternalBuffers&);
-inline ErrorOr<IDWTOutput> VER_SR(Transformation transformation, IDWTOutput, IDWTInternalBuffers&);
-inline void _1D_SR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers&);
-inline void _1D_EXTR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers&);
-inline void _1D_FILTR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers&);
+inline ErrorOr<IDWTOutput> HOR_SR(Transformation transformation, IDWTOutput);
+inline ErrorOr<IDWTOutput> VER_SR(Transformation transformation, IDWTOutput);
+template<typename T>
+inline void _1D_SR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers<T>&);
+template<typename T>
+inline void _1D_EXTR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers<T>&);
+template<typename T>
+inline void _1D_FILTR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers<T>&);
 
 // F.3.1 The IDWT procedure
 inline ErrorOr<IDWTOutput> IDWT(IDWTInput const& input)
@@ -95,13 +157,8 @@ inline ErrorOr<IDWTOutput> _2D_SR(Transformation transformation, IDWTOutput ll,
     if (a.rect.is_empty())
         return a;
 
-    // Leave enough room for max expansion in _1D_EXTR.
-    IDWTInternalBuffers buffers;
-    buffers.scanline_buffer.resize(max(a.rect.width(), a.rect.height()) + 8);
-    buffers.scanline_buffer2.resize(max(a.rect.width(), a.rect.height()) + 8);
-
-    a = TRY(HOR_SR(transformation, move(a), buffers));
-    return VER_SR(transformation, move(a), buffers);
+    a = TRY(HOR_SR(transformation, move(a)));
+    return VER_SR(transformation, move(a));
 }
 
 // F.3.3 The 2D_INTERLEAVE procedure
@@ -184,49 +241,63 @@ inline ErrorOr<IDWTOutput> _2D_INTERLEAVE(IDWTOutput ll, IDWTDecomposition const
 }
 
 // F.3.4 The HOR_SR procedure
-inline ErrorOr<IDWTOutput> HOR_SR(Transformation transformation, IDWTOutput a, IDWTInternalBuffers& buffers)
+inline ErrorOr<IDWTOutput> HOR_SR(Transformation transformation, IDWTOutput a)
 {
     int u0 = a.rect.left();
-    int v0 = a.rect.top();
     int u1 = a.rect.right();
-    int v1 = a.rect.bottom();
 
     // Figure F.10 – The HOR_SR procedure
+    // The rows are independent of each other.
     int i0 = u0;
     int i1 = u1;
-    for (int v = v0; v < v1; ++v)
-        _1D_SR(transformation, a, (v - v0) * a.rect.width(), i0, i1, 1, buffers);
+    TRY(for_each_line_in_parallel(a.rect.height(), a.rect.width(), [&](Span<int> rows) {
+        IDWTInternalBuffers<float> buffers(a.rect.width());
+        for (auto row : rows)
+            _1D_SR(transformation, a, row * a.rect.width(), i0, i1, 1, buffers);
+    }));
 
     return a;
 }
 
 // F.3.5 The VER_SR procedure
-inline ErrorOr<IDWTOutput> VER_SR(Transformation transformation, IDWTOutput a, IDWTInternalBuffers& buffers)
+inline ErrorOr<IDWTOutput> VER_SR(Transformation transformation, IDWTOutput a)
 {
-    int u0 = a.rect.left();
     int v0 = a.rect.top();
-    int u1 = a.rect.right();
     int v1 = a.rect.bottom();
 
     // Figure F.12 – The VER_SR procedure
+    // The columns are independent of each other, and are filtered four at a time.
     int i0 = v0;
     int i1 = v1;
-    for (int u = u0; u < u1; ++u)
-        _1D_SR(transformation, a, (u - u0), i0, i1, a.rect.width(), buffers);
+    int width = a.rect.width();
+    TRY(for_each_line_in_parallel(ceil_div(width, 4), 4 * a.rect.height(), [&](Span<int> column_groups) {
+        IDWTInternalBuffers<AK::SIMD::f32x4> buffers(a.rect.height());
+        Optional<IDWTInternalBuffers<float>> scalar_buffers;
+        for (auto column_group : column_groups) {
+            int first_column = column_group * 4;
+            if (first_column + 4 <= width) {
+                _1D_SR(transformation, a, first_column, i0, i1, width, buffers);
+                continue;
+            }
+            if (!scalar_buffers.has_value())
+                scalar_buffers.emplace(a.rect.height());
+            for (int column = first_column; column < width; ++column)
+                _1D_SR(transformation, a, column, i0, i1, width, *scalar_buffers);
+        }
+    }));
 
     return a;
 }
 
 // F.3.6 The 1D_SR procedure
 // Figure F.14 – The 1D_SR procedure
-inline void _1D_SR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers& buffers)
+template<typename T>
+inline void _1D_SR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers<T>& buffers)
 {
     // "For signals of length one (i.e., i0 = il – 1), the 1D_SR procedure sets the value of X(i0) to Y(i0) if i0 is an even integer, and X(i0) to Y(i0)/2 if i0 is an odd integer."
     if (i0 == i1 - 1) {
-        if (i0 % 2 == 0)
-            a.data[start] = a.data[start];
-        else
-            a.data[start] = a.data[start] / 2;
+        if (i0 % 2 != 0)
+            store_samples(a, start, load_samples<T>(a, start) / 2.0f);
         return;
     }
 
@@ -236,7 +307,8 @@ inline void _1D_SR(Transformation transformation, IDWTOutput& a, int start, int
 }
 
 // F.3.7 The 1D_EXTR procedure
-inline void _1D_EXTR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers& buffers)
+template<typename T>
+inline void _1D_EXTR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers<T>& buffers)
 {
     // Table F.2 – Extension to the left
     int i_left;
@@ -263,19 +335,20 @@ inline void _1D_EXTR(Transformation transformation, IDWTOutput& a, int start, in
     };
 
     for (int l = i0 - i_left, i = 0; l < i1 + i_right; ++l, ++i)
-        buffers.scanline_buffer[i] = a.data[start + (PSE(l, i0, i1) - i0) * delta];
+        buffers.scanline_buffer[i] = load_samples<T>(a, start + (PSE(l, i0, i1) - i0) * delta);
 
     buffers.scanline_start = i_left;
 }
 
 // F.3.8 The 1D_FILTR procedure
-inline void _1D_FILTR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers& buffers)
+template<typename T>
+inline void _1D_FILTR(Transformation transformation, IDWTOutput& a, int start, int i0, int i1, int delta, IDWTInternalBuffers<T>& buffers)
 {
     auto y_ext = [&](int i) {
         return buffers.scanline_buffer[i + buffers.scanline_start - i0];
     };
 
-    auto x = [&](int i) -> float& {
+    auto x = [&](int i) -> T& {
         return buffers.scanline_buffer2[i + buffers.scanline_start - i0];
     };
 
@@ -283,11 +356,11 @@ inline void _1D_FILTR(Transformation transformation, IDWTOutput& a, int start, i
         // F.3.8.1 The 1D_FILTR_5-3R procedure
         // (F-5)
         for (int n = floor_div(i0, 2); n < floor_div(i1, 2) + 1; ++n)
-            x(2 * n) = y_ext(2 * n) - floorf((y_ext(2 * n - 1) + y_ext(2 * n + 1) + 2) / 4.0f);
+            x(2 * n) = y_ext(2 * n) - floor_samples<T>((y_ext(2 * n - 1) + y_ext(2 * n + 1) + 2.0f) / 4.0f);
 
         // (F-6)
         for (int n = floor_div(i0, 2); n < floor_div(i1, 2); ++n)
-            x(2 * n + 1) = y_ext(2 * n + 1) + floorf((x(2 * n) + x(2 * n + 2)) / 2.0f);
+            x(2 * n + 1) = y_ext(2 * n + 1) + floor_samples<T>((x(2 * n) + x(2 * n + 2)) / 2.0f);
     } else {
         VERIFY(transformation == Transformation::Irreversible_9_7_Filter);
 
@@ -321,7 +394,7 @@ inline void _1D_FILTR(Transformation transformation, IDWTOutput& a, int start, i
     }
 
     for (int i = i0; i < i1; ++i)
-        a.data[start + (i - i0) * delta] = x(i);
+        store_samples(a, start + (i - i0) * delta, x(i));
 }
 
 }
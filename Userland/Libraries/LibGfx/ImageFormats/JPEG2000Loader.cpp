@@ -17,6 +17,7 @@
 #include <LibGfx/ImageFormats/JPEG2000ProgressionIterators.h>
 #include <LibGfx/ImageFormats/JPEG2000TagTree.h>
 #include <LibTextCodec/Decoder.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 // Core coding system spec (.jp2 format): T-REC-T.800-201511-S!!PDF-E.pdf available here:
 // https://www.itu.int/rec/dologin_pub.asp?lang=e&id=T-REC-T.800-201511-S!!PDF-E&type=items
@@ -2054,52 +2055,61 @@ static int compute_M_b(JPEG2000LoadingContext& context, TileData& tile, int comp
     return quantization_parameters.number_of_guard_bits + exponent - 1;
 }
 
-static ErrorOr<void> decode_bitplanes_to_coefficients(JPEG2000LoadingContext& context)
+static float compute_step_size(JPEG2000LoadingContext& context, QuantizationDefault const& quantization_parameters, JPEG2000::SubBand sub_band_type, int component_index, int r, int N_L)
 {
-    auto copy_and_dequantize_if_needed = [&](JPEG2000::Span2D<float> output, ReadonlySpan<float> input, QuantizationDefault const& quantization_parameters, JPEG2000::SubBand sub_band_type, int component_index, int r, int N_L) {
-        int w = output.size.width();
-        int h = output.size.height();
-        VERIFY(w * h == static_cast<int>(input.size()));
+    // E.1.1 Irreversible transformation
+    auto R_I = context.siz.components[component_index].bit_depth();
 
-        for (int y = 0; y < h; ++y) {
-            for (int x = 0; x < w; ++x) {
-                float value = input[y * w + x];
-
-                // E.1 Inverse quantization procedure
-                // The coefficients store qbar_b.
-                if (quantization_parameters.quantization_style != QuantizationDefault::QuantizationStyle::NoQuantization) {
-                    // E.1.1 Irreversible transformation
-                    auto R_I = context.siz.components[component_index].bit_depth();
-
-                    // Table E.1 – Sub-band gains
-                    auto log_2_gain_b = sub_band_type == JPEG2000::SubBand::HorizontalLowpassVerticalLowpass ? 0 : (sub_band_type == JPEG2000::SubBand::HorizontalHighpassVerticalLowpass || sub_band_type == JPEG2000::SubBand::HorizontalLowpassVerticalHighpass ? 1 : 2);
-                    auto R_b = R_I + log_2_gain_b; // (E-4)
-
-                    u16 mantissa;
-                    if (quantization_parameters.quantization_style == QuantizationDefault::QuantizationStyle::ScalarDerived) {
-                        // (E-5)
-                        mantissa = quantization_parameters.step_sizes.get<Vector<QuantizationDefault::IrreversibleStepSize>>()[0].mantissa;
-                    } else {
-                        if (r == 0)
-                            mantissa = quantization_parameters.step_sizes.get<Vector<QuantizationDefault::IrreversibleStepSize>>()[0].mantissa;
-                        else
-                            mantissa = quantization_parameters.step_sizes.get<Vector<QuantizationDefault::IrreversibleStepSize>>()[3 * (r - 1) + (int)sub_band_type].mantissa;
-                    }
-
-                    // (E-3)
-                    auto exponent = get_exponent(quantization_parameters, sub_band_type, r, N_L);
-                    float step_size = powf(2.0f, R_b - exponent) * (1.0f + mantissa / powf(2.0f, 11.0f));
-
-                    // (E-6), with r chosen as 0 (see NOTE below (E-6)).
-                    value *= step_size;
-                }
+    // Table E.1 – Sub-band gains
+    auto log_2_gain_b = sub_band_type == JPEG2000::SubBand::HorizontalLowpassVerticalLowpass ? 0 : (sub_band_type == JPEG2000::SubBand::HorizontalHighpassVerticalLowpass || sub_band_type == JPEG2000::SubBand::HorizontalLowpassVerticalHighpass ? 1 : 2);
+    auto R_b = R_I + log_2_gain_b; // (E-4)
 
-                output.data[y * output.pitch + x] = value;
-            }
-        }
-    };
+    u16 mantissa;
+    if (quantization_parameters.quantization_style == QuantizationDefault::QuantizationStyle::ScalarDerived) {
+        // (E-5)
+        mantissa = quantization_parameters.step_sizes.get<Vector<QuantizationDefault::IrreversibleStepSize>>()[0].mantissa;
+    } else {
+        if (r == 0)
+            mantissa = quantization_parameters.step_sizes.get<Vector<QuantizationDefault::IrreversibleStepSize>>()[0].mantissa;
+        else
+            mantissa = quantization_parameters.step_sizes.get<Vector<QuantizationDefault::IrreversibleStepSize>>()[3 * (r - 1) + (int)sub_band_type].mantissa;
+    }
 
-    auto decode_bitplanes = [&](TileData& tile, JPEG2000::SubBand sub_band_type, DecodedSubBand& sub_band, int component_index, int r, int N_L) -> ErrorOr<void> {
+    // (E-3)
+    auto exponent = get_exponent(quantization_parameters, sub_band_type, r, N_L);
+    return powf(2.0f, R_b - exponent) * (1.0f + mantissa / powf(2.0f, 11.0f));
+}
+
+struct CodeBlockToDecode {
+    DecodedCodeBlock const* code_block { nullptr };
+    JPEG2000::Span2D<float> output;
+    JPEG2000::SubBand sub_band_type;
+    int M_b { 0 };
+    JPEG2000::BitplaneDecodingOptions options;
+    Optional<Error> error;
+};
+
+static ErrorOr<void> decode_code_block_to_coefficients(CodeBlockToDecode const& code_block_to_decode)
+{
+    auto const& code_block = *code_block_to_decode.code_block;
+    int total_number_of_coding_passes = code_block.number_of_coding_passes();
+    ByteBuffer storage;
+    Vector<ReadonlyBytes, 1> combined_segments = TRY(code_block.segments_for_all_layers(storage));
+    return JPEG2000::decode_code_block(code_block_to_decode.output, code_block_to_decode.sub_band_type, total_number_of_coding_passes, combined_segments, code_block_to_decode.M_b, code_block.p, code_block_to_decode.options);
+}
+
+struct SubBandToDequantize {
+    DecodedSubBand* sub_band { nullptr };
+    float step_size { 1.0f };
+};
+
+static ErrorOr<void> decode_bitplanes_to_coefficients(JPEG2000LoadingContext& context)
+{
+    // Codeblocks all use independent arithmetic coders, so they are collected first and then decoded in parallel.
+    Vector<CodeBlockToDecode> code_blocks;
+    Vector<SubBandToDequantize> sub_bands_to_dequantize;
+
+    auto collect_code_blocks = [&](TileData& tile, JPEG2000::SubBand sub_band_type, DecodedSubBand& sub_band, int component_index, int r, int N_L) -> ErrorOr<void> {
         TRY(sub_band.coefficients.try_resize(sub_band.rect.width() * sub_band.rect.height()));
 
         auto const& coding_style = context.coding_style_parameters_for_component(tile, component_index);
@@ -2112,90 +2122,127 @@ static ErrorOr<void> decode_bitplanes_to_coefficients(JPEG2000LoadingContext& co
 
         int M_b = compute_M_b(context, tile, component_index, sub_band_type, r, N_L);
 
-        // FIXME: Codeblocks all use independent arithmetic coders, so this could run in parallel.
         for (auto& precinct : sub_band.precincts) {
-
-            Vector<float> precinct_coefficients;
-            auto clipped_precinct_rect = precinct.rect.intersected(sub_band.rect);
-            precinct_coefficients.resize(clipped_precinct_rect.width() * clipped_precinct_rect.height());
-
             for (auto& code_block : precinct.code_blocks) {
-                int total_number_of_coding_passes = code_block.number_of_coding_passes();
-                ByteBuffer storage;
-                Vector<ReadonlyBytes, 1> combined_segments = TRY(code_block.segments_for_all_layers(storage));
-
+                // Codeblocks don't overlap and are confined to the sub-band, so they are decoded straight into its coefficients.
                 JPEG2000::Span2D<float> output;
                 output.size = code_block.rect.size();
-                output.pitch = clipped_precinct_rect.width();
-                output.data = precinct_coefficients.span().slice((code_block.rect.y() - clipped_precinct_rect.y()) * output.pitch + (code_block.rect.x() - clipped_precinct_rect.x()));
-                TRY(JPEG2000::decode_code_block(output, sub_band_type, total_number_of_coding_passes, combined_segments, M_b, code_block.p, bitplane_decoding_options));
+                output.pitch = sub_band.rect.width();
+                output.data = sub_band.coefficients.span().slice((code_block.rect.y() - sub_band.rect.y()) * output.pitch + (code_block.rect.x() - sub_band.rect.x()));
+                TRY(code_blocks.try_append({ &code_block, output, sub_band_type, M_b, bitplane_decoding_options, {} }));
             }
-
-            JPEG2000::Span2D<float> output;
-            output.size = clipped_precinct_rect.size();
-            output.pitch = sub_band.rect.width();
-            output.data = sub_band.coefficients.span().slice((clipped_precinct_rect.y() - sub_band.rect.y()) * output.pitch + (clipped_precinct_rect.x() - sub_band.rect.x()));
-            copy_and_dequantize_if_needed(output, precinct_coefficients, context.quantization_parameters_for_component(tile, component_index), sub_band_type, component_index, r, N_L);
         }
 
+        // E.1 Inverse quantization procedure
+        // The coefficients store qbar_b.
+        auto const& quantization_parameters = context.quantization_parameters_for_component(tile, component_index);
+        if (quantization_parameters.quantization_style != QuantizationDefault::QuantizationStyle::NoQuantization)
+            TRY(sub_bands_to_dequantize.try_append({ &sub_band, compute_step_size(context, quantization_parameters, sub_band_type, component_index, r, N_L) }));
+
         return {};
     };
 
     for (auto& tile : context.tiles) {
         for (auto [component_index, component] : enumerate(tile.components)) {
             int N_L = component.decompositions.size();
-            TRY(decode_bitplanes(tile, JPEG2000::SubBand::HorizontalLowpassVerticalLowpass, component.nLL, component_index, 0, N_L));
+            TRY(collect_code_blocks(tile, JPEG2000::SubBand::HorizontalLowpassVerticalLowpass, component.nLL, component_index, 0, N_L));
             for (auto const& [decomposition_index, decomposition] : enumerate(component.decompositions)) {
                 int r = decomposition_index + 1;
                 for (auto [sub_band_index, sub_band] : enumerate(DecodedTileComponent::SubBandOrder)) {
-                    TRY(decode_bitplanes(tile, sub_band, decomposition[sub_band_index], component_index, r, N_L));
+                    TRY(collect_code_blocks(tile, sub_band, decomposition[sub_band_index], component_index, r, N_L));
                 }
             }
         }
     }
 
+    Threading::parallel_for(code_blocks.span(), [&](Span<CodeBlockToDecode> slice) {
+        for (auto& code_block : slice) {
+            if (auto result = decode_code_block_to_coefficients(code_block); result.is_error())
+                code_block.error = result.release_error();
+        }
+    });
+
+    for (auto& code_block : code_blocks) {
+        if (code_block.error.has_value())
+            return code_block.error.release_value();
+    }
+
+    Threading::parallel_for(sub_bands_to_dequantize.span(), 1, [&](Span<SubBandToDequantize> slice) {
+        for (auto& [sub_band, step_size] : slice) {
+            // (E-6), with r chosen as 0 (see NOTE below (E-6)).
+            for (auto& value : sub_band->coefficients)
+                value *= step_size;
+        }
+    });
+
     return {};
 }
 
-static ErrorOr<void> run_inverse_discrete_wavelet_transform(JPEG2000LoadingContext& context)
+struct TileComponentToTransform {
+    TileData const* tile { nullptr };
+    DecodedTileComponent* component { nullptr };
+    int component_index { 0 };
+    Optional<Error> error;
+};
+
+static ErrorOr<void> run_inverse_discrete_wavelet_transform(JPEG2000LoadingContext const& context, TileData const& tile, DecodedTileComponent& component, int component_index)
 {
-    // FIXME: Could run these in parallel.
-    for (auto& tile : context.tiles) {
-        for (auto [component_index, component] : enumerate(tile.components)) {
-            int N_L = component.decompositions.size();
+    int N_L = component.decompositions.size();
 
-            Gfx::JPEG2000::IDWTInput input;
-            input.transformation = context.coding_style_parameters_for_component(tile, component_index).transformation;
-            input.LL.rect = component.nLL.rect;
-            input.LL.data = { component.nLL.coefficients, component.nLL.rect.size(), component.nLL.rect.width() };
+    Gfx::JPEG2000::IDWTInput input;
+    input.transformation = context.coding_style_parameters_for_component(tile, component_index).transformation;
+    input.LL.rect = component.nLL.rect;
+    input.LL.data = { component.nLL.coefficients, component.nLL.rect.size(), component.nLL.rect.width() };
 
-            for (auto const& [decomposition_index, decomposition] : enumerate(component.decompositions)) {
-                int r = decomposition_index + 1;
+    for (auto const& [decomposition_index, decomposition] : enumerate(component.decompositions)) {
+        int r = decomposition_index + 1;
 
-                JPEG2000::IDWTDecomposition idwt_decomposition;
-                idwt_decomposition.ll_rect = context.siz.reference_grid_coordinates_for_ll_band(tile.rect, component_index, r, N_L);
+        JPEG2000::IDWTDecomposition idwt_decomposition;
+        idwt_decomposition.ll_rect = context.siz.reference_grid_coordinates_for_ll_band(tile.rect, component_index, r, N_L);
 
-                VERIFY(DecodedTileComponent::SubBandOrder[0] == JPEG2000::SubBand::HorizontalHighpassVerticalLowpass);
-                auto hl_rect = decomposition[0].rect;
-                idwt_decomposition.hl = { hl_rect, { decomposition[0].coefficients, hl_rect.size(), hl_rect.width() } };
+        VERIFY(DecodedTileComponent::SubBandOrder[0] == JPEG2000::SubBand::HorizontalHighpassVerticalLowpass);
+        auto hl_rect = decomposition[0].rect;
+        idwt_decomposition.hl = { hl_rect, { decomposition[0].coefficients, hl_rect.size(), hl_rect.width() } };
 
-                VERIFY(DecodedTileComponent::SubBandOrder[1] == JPEG2000::SubBand::HorizontalLowpassVerticalHighpass);
-                auto lh_rect = decomposition[1].rect;
-                idwt_decomposition.lh = { lh_rect, { decomposition[1].coefficients, lh_rect.size(), lh_rect.width() } };
+        VERIFY(DecodedTileComponent::SubBandOrder[1] == JPEG2000::SubBand::HorizontalLowpassVerticalHighpass);
+        auto lh_rect = decomposition[1].rect;
+        idwt_decomposition.lh = { lh_rect, { decomposition[1].coefficients, lh_rect.size(), lh_rect.width() } };
 
-                VERIFY(DecodedTileComponent::SubBandOrder[2] == JPEG2000::SubBand::HorizontalHighpassVerticalHighpass);
-                auto hh_rect = decomposition[2].rect;
-                idwt_decomposition.hh = { hh_rect, { decomposition[2].coefficients, hh_rect.size(), hh_rect.width() } };
+        VERIFY(DecodedTileComponent::SubBandOrder[2] == JPEG2000::SubBand::HorizontalHighpassVerticalHighpass);
+        auto hh_rect = decomposition[2].rect;
+        idwt_decomposition.hh = { hh_rect, { decomposition[2].coefficients, hh_rect.size(), hh_rect.width() } };
 
-                input.decompositions.append(idwt_decomposition);
-            }
+        TRY(input.decompositions.try_append(idwt_decomposition));
+    }
 
-            auto output = TRY(JPEG2000::IDWT(input));
-            VERIFY(component.rect == output.rect);
-            component.samples = move(output.data);
+    auto output = TRY(JPEG2000::IDWT(input));
+    VERIFY(component.rect == output.rect);
+    component.samples = move(output.data);
+
+    // FIXME: Could release coefficient data here, to reduce peak memory use.
+    return {};
+}
 
-            // FIXME: Could release coefficient data here, to reduce peak memory use.
+static ErrorOr<void> run_inverse_discrete_wavelet_transform(JPEG2000LoadingContext& context)
+{
+    // Tile-components are transformed independently of each other, so they run in parallel.
+    // The IDWT itself also splits its rows and columns across threads, for images with a single tile.
+    Vector<TileComponentToTransform> tile_components;
+    for (auto& tile : context.tiles) {
+        for (auto [component_index, component] : enumerate(tile.components))
+            TRY(tile_components.try_append({ &tile, &component, static_cast<int>(component_index), {} }));
+    }
+
+    Threading::parallel_for(tile_components.span(), 1, [&](Span<TileComponentToTransform> slice) {
+        for (auto& tile_component : slice) {
+            if (auto result = run_inverse_discrete_wavelet_transform(context, *tile_component.tile, *tile_component.component, tile_component.component_index); result.is_error())
+                tile_component.error = result.release_error();
         }
+    });
+
+    for (auto& tile_component : tile_components) {
+        if (tile_component.error.has_value())
+            return tile_component.error.release_value();
     }
 
     return {};
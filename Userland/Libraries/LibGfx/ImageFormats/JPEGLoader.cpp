@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 #include <AK/Error.h>
@@ -13,6 +14,9 @@
 #include <AK/Math.h>
 #include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
 #include <AK/String.h>
 #include <AK/Try.h>
 #include <AK/Vector.h>
@@ -20,6 +24,7 @@
 #include <LibGfx/ImageFormats/JPEGShared.h>
 #include <LibGfx/ImageFormats/TIFFLoader.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 namespace Gfx {
 
@@ -415,6 +420,19 @@ struct Scan {
     HuffmanStream huffman_stream;
 
     u64 end_of_bands_run_count { 0 };
+    Array<i16, 4> previous_dc_values {};
+
+    // Returns a scan with the same header, that reads its entropy-coded data from another stream.
+    Scan with_stream(JPEGStream& stream) const
+    {
+        Scan scan(HuffmanStream { stream });
+        scan.components = components;
+        scan.spectral_selection_start = spectral_selection_start;
+        scan.spectral_selection_end = spectral_selection_end;
+        scan.successive_approximation_high = successive_approximation_high;
+        scan.successive_approximation_low = successive_approximation_low;
+        return scan;
+    }
 
     // See the note on Figure B.4 - Scan header syntax
     bool are_components_interleaved() const
@@ -432,16 +450,17 @@ enum class ColorTransform {
 };
 
 struct JPEGLoadingContext {
-    JPEGLoadingContext(JPEGStream jpeg_stream, JPEGDecoderOptions options)
+    JPEGLoadingContext(JPEGStream jpeg_stream, ReadonlyBytes data, JPEGDecoderOptions options)
         : stream(move(jpeg_stream))
+        , data(data)
         , options(options)
     {
     }
 
-    static ErrorOr<NonnullOwnPtr<JPEGLoadingContext>> create(NonnullOwnPtr<Stream> stream, JPEGDecoderOptions options)
+    static ErrorOr<NonnullOwnPtr<JPEGLoadingContext>> create(ReadonlyBytes data, JPEGDecoderOptions options)
     {
-        auto jpeg_stream = TRY(JPEGStream::create(move(stream)));
-        return make<JPEGLoadingContext>(move(jpeg_stream), options);
+        auto jpeg_stream = TRY(JPEGStream::create(TRY(try_make<FixedMemoryStream>(data))));
+        return make<JPEGLoadingContext>(move(jpeg_stream), data, options);
     }
 
     enum State {
@@ -472,17 +491,30 @@ struct JPEGLoadingContext {
     Array<bool, 4> registered_dc_tables {};
     Array<HuffmanTable, 4> ac_tables {};
     Array<bool, 4> registered_ac_tables {};
-    Array<i16, 4> previous_dc_values {};
     MacroblockMeta mblock_meta;
     JPEGStream stream;
+    // The whole file, which `stream` reads from. The restart intervals of a scan are found in it, see
+    // decode_restart_intervals_in_parallel().
+    ReadonlyBytes data;
     JPEGDecoderOptions options;
 
+    // The image is decoded at 1 / scale_denominator of its size, which is either 1, 2, 4 or 8.
+    // See scaled_inverse_dct().
+    u8 scale_denominator { 1 };
+
     Optional<ColorTransform> color_transform {};
 
     OwnPtr<ExifMetadata> exif_metadata {};
 
     Optional<ICCMultiChunkState> icc_multi_chunk_state;
     Optional<ByteBuffer> icc_data;
+
+    // The data may end anywhere, so decoding stops where it does instead of failing. See decoded_rows_of_partial_image().
+    bool may_be_truncated { false };
+    bool has_seen_end_of_image { false };
+    u32 complete_mcu_rows_in_current_scan { 0 };
+    // Indexed by Component::index.
+    Array<bool, 4> has_complete_dc_scan {};
 };
 
 static inline auto* get_component(Macroblock& block, unsigned component)
@@ -518,10 +550,9 @@ enum class JPEGDecodingMode {
 };
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_dc(JPEGLoadingContext const& context, Scan& scan, Macroblock& macroblock, ScanComponent const& scan_component)
 {
-    auto& dc_table = context.dc_tables[scan_component.dc_destination_id];
-    auto& scan = *context.current_scan;
+    auto const& dc_table = context.dc_tables[scan_component.dc_destination_id];
 
     auto* select_component = get_component(macroblock, scan_component.component.index);
     auto& coefficient = select_component[0];
@@ -549,7 +580,7 @@ static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock,
     if (dc_length != 0 && dc_diff < (1 << (dc_length - 1)))
         dc_diff -= (1 << dc_length) - 1;
 
-    auto& previous_dc = context.previous_dc_values[scan_component.component.index];
+    auto& previous_dc = scan.previous_dc_values[scan_component.component.index];
     previous_dc += dc_diff;
     coefficient = previous_dc << scan.successive_approximation_low;
 
@@ -593,13 +624,11 @@ static bool is_progressive(StartOfFrame::FrameType frame_type)
 }
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_ac(JPEGLoadingContext const& context, Scan& scan, Macroblock& macroblock, ScanComponent const& scan_component)
 {
-    auto& ac_table = context.ac_tables[scan_component.ac_destination_id];
+    auto const& ac_table = context.ac_tables[scan_component.ac_destination_id];
     auto* select_component = get_component(macroblock, scan_component.component.index);
 
-    auto& scan = *context.current_scan;
-
     // Compute the AC coefficients.
 
     // 0th coefficient is the dc, which is already handled
@@ -721,14 +750,14 @@ static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock,
  * we are dealing with three components) will fill up the blocks with chroma data.
  */
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
+static ErrorOr<void> build_macroblocks(JPEGLoadingContext const& context, Scan& scan, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
 {
-    for (auto const& scan_component : context.current_scan->components) {
+    for (auto const& scan_component : scan.components) {
         for (u8 vfactor_i = 0; vfactor_i < scan_component.component.sampling_factors.vertical; vfactor_i++) {
             for (u8 hfactor_i = 0; hfactor_i < scan_component.component.sampling_factors.horizontal; hfactor_i++) {
                 // A.2.3 - Interleaved order
                 u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                if (!context.current_scan->are_components_interleaved()) {
+                if (!scan.are_components_interleaved()) {
                     macroblock_index = vcursor * context.mblock_meta.hpadded_count + (hfactor_i + (hcursor * scan_component.component.sampling_factors.vertical) + (vfactor_i * scan_component.component.sampling_factors.horizontal));
 
                     // A.2.4 Completion of partial MCU
@@ -746,17 +775,17 @@ static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macro
                 Macroblock& block = macroblocks[macroblock_index];
 
                 if constexpr (DecodingMode == JPEGDecodingMode::Sequential) {
-                    TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    TRY(add_ac<DecodingMode>(context, block, scan_component));
+                    TRY(add_dc<DecodingMode>(context, scan, block, scan_component));
+                    TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
                 } else {
-                    if (context.current_scan->spectral_selection_start == 0)
-                        TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    if (context.current_scan->spectral_selection_end != 0)
-                        TRY(add_ac<DecodingMode>(context, block, scan_component));
+                    if (scan.spectral_selection_start == 0)
+                        TRY(add_dc<DecodingMode>(context, scan, block, scan_component));
+                    if (scan.spectral_selection_end != 0)
+                        TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
 
                     // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-                    if (context.current_scan->end_of_bands_run_count > 0) {
-                        --context.current_scan->end_of_bands_run_count;
+                    if (scan.end_of_bands_run_count > 0) {
+                        --scan.end_of_bands_run_count;
                         continue;
                     }
                 }
@@ -779,33 +808,148 @@ static bool is_dct_based(StartOfFrame::FrameType frame_type)
         || frame_type == StartOfFrame::FrameType::Differential_Progressive_DCT_Arithmetic;
 }
 
-static void reset_decoder(JPEGLoadingContext& context)
+static void reset_decoder(JPEGLoadingContext const& context, Scan& scan)
 {
     // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-    context.current_scan->end_of_bands_run_count = 0;
+    scan.end_of_bands_run_count = 0;
 
     // E.2.4 Control procedure for decoding a restart interval
     if (is_dct_based(context.frame.type)) {
-        context.previous_dc_values = {};
+        scan.previous_dc_values = {};
         return;
     }
 
     VERIFY_NOT_REACHED();
 }
 
+struct RestartInterval {
+    ReadonlyBytes data;
+    u32 first_mcu { 0 };
+    u32 mcu_count { 0 };
+    Optional<Error> error;
+};
+
+static ErrorOr<void> decode_restart_interval(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks, RestartInterval const& interval)
+{
+    // The huffman stream reads a few bytes ahead, so we end the interval with an EOI marker, which makes it fake zeroes
+    // instead of reading into the next interval.
+    auto buffer = TRY(ByteBuffer::create_uninitialized(interval.data.size() + 2));
+    interval.data.copy_to(buffer);
+    buffer[interval.data.size()] = 0xFF;
+    buffer[interval.data.size() + 1] = JPEG_EOI & 0xFF;
+
+    auto stream = TRY(JPEGStream::create(TRY(try_make<FixedMemoryStream>(buffer.bytes()))));
+    auto scan = context.current_scan->with_stream(stream);
+
+    u32 const mcus_per_row = context.mblock_meta.hpadded_count / context.sampling_factors.horizontal;
+    for (u32 mcu = interval.first_mcu; mcu < interval.first_mcu + interval.mcu_count; ++mcu) {
+        u32 const vcursor = (mcu / mcus_per_row) * context.sampling_factors.vertical;
+        u32 const hcursor = (mcu % mcus_per_row) * context.sampling_factors.horizontal;
+        TRY(build_macroblocks<JPEGDecodingMode::Sequential>(context, scan, macroblocks, hcursor, vcursor));
+    }
+    return {};
+}
+
+static ErrorOr<bool> decode_restart_intervals_in_parallel(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+{
+    // E.2.4 - Control procedure for decoding a restart interval
+    // The decoder is reset at the start of every restart interval, and each interval starts on a byte boundary after
+    // an RSTn marker. So once we know where the intervals are, they can all be decoded at the same time.
+    auto const& scan = *context.current_scan;
+    if (is_progressive(context.frame.type) || context.dc_restart_interval == 0 || context.data.is_empty())
+        return false;
+
+    // Only the MCUs of interleaved scans of all components are laid out like decode_huffman_stream() expects.
+    bool const is_single_block_scan = context.components.size() == 1 && context.sampling_factors == SamplingFactors { 1, 1 };
+    if (scan.components.size() != context.components.size() || (!scan.are_components_interleaved() && !is_single_block_scan))
+        return false;
+
+    u32 const mcus_per_row = context.mblock_meta.hpadded_count / context.sampling_factors.horizontal;
+    u32 const mcu_rows = ceil_div(context.mblock_meta.vcount, static_cast<u32>(context.sampling_factors.vertical));
+    u32 const mcu_count = mcus_per_row * mcu_rows;
+    u32 const interval_count = ceil_div(mcu_count, static_cast<u32>(context.dc_restart_interval));
+    if (interval_count < 2)
+        return false;
+
+    // B.1.1.5 - Entropy-coded data segments
+    // The data runs until the first marker that isn't a restart marker. 0xFF00 is a stuffed 0xFF byte, and any number
+    // of 0xFF fill bytes may precede a marker.
+    Vector<RestartInterval> intervals;
+    TRY(intervals.try_ensure_capacity(interval_count));
+    auto const data = context.data;
+    size_t offset = context.stream.byte_offset();
+    size_t interval_start = offset;
+    while (true) {
+        if (offset + 1 >= data.size())
+            return false;
+        if (data[offset] != 0xFF) {
+            ++offset;
+            continue;
+        }
+
+        Marker const marker = 0xFF00 | data[offset + 1];
+        if (marker == 0xFF00) {
+            offset += 2;
+            continue;
+        }
+        if (marker == 0xFFFF) {
+            ++offset;
+            continue;
+        }
+
+        bool const is_restart_marker = marker >= JPEG_RST0 && marker <= JPEG_RST7;
+        // Broken files may have more or less intervals than the image needs, the serial decoder deals with them.
+        if (is_restart_marker && intervals.size() + 1 == interval_count)
+            return false;
+
+        u32 const first_mcu = intervals.size() * context.dc_restart_interval;
+        intervals.unchecked_append({ data.slice(interval_start, offset - interval_start), first_mcu, min<u32>(context.dc_restart_interval, mcu_count - first_mcu), {} });
+
+        if (!is_restart_marker)
+            break;
+        offset += 2;
+        interval_start = offset;
+    }
+
+    if (intervals.size() != interval_count)
+        return false;
+
+    Threading::parallel_for(intervals.span(), 1, [&](Span<RestartInterval> slice) {
+        for (auto& interval : slice) {
+            if (auto result = decode_restart_interval(context, macroblocks, interval); result.is_error())
+                interval.error = result.release_error();
+        }
+    });
+
+    for (auto& interval : intervals) {
+        if (interval.error.has_value()) {
+            dbgln_if(JPEG_DEBUG, "Failed to decode the restart interval starting at MCU {}: {}", interval.first_mcu, *interval.error);
+            return interval.error.release_value();
+        }
+    }
+
+    // Leave the stream on the marker that ends the scan.
+    TRY(context.stream.discard(offset - context.stream.byte_offset()));
+    return true;
+}
+
 static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
 {
+    if (TRY(decode_restart_intervals_in_parallel(context, macroblocks)))
+        return {};
+
+    auto& scan = *context.current_scan;
     for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
         for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
             // FIXME: This is likely wrong for non-interleaved scans.
             VERIFY(context.mblock_meta.hpadded_count % context.sampling_factors.horizontal == 0);
             u32 number_of_mcus_decoded_so_far = ((vcursor / context.sampling_factors.vertical) * context.mblock_meta.hpadded_count + hcursor) / context.sampling_factors.horizontal;
 
-            auto& huffman_stream = context.current_scan->huffman_stream;
+            auto& huffman_stream = scan.huffman_stream;
 
             if (context.dc_restart_interval > 0) {
                 if (number_of_mcus_decoded_so_far != 0 && number_of_mcus_decoded_so_far % context.dc_restart_interval == 0) {
-                    reset_decoder(context);
+                    reset_decoder(context, scan);
 
                     // Restart markers are stored in byte boundaries. Advance the huffman stream cursor to
                     //  the 0th bit of the next byte.
@@ -818,8 +962,8 @@ static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<M
 
             auto result = [&]() {
                 if (is_progressive(context.frame.type))
-                    return build_macroblocks<JPEGDecodingMode::Progressive>(context, macroblocks, hcursor, vcursor);
-                return build_macroblocks<JPEGDecodingMode::Sequential>(context, macroblocks, hcursor, vcursor);
+                    return build_macroblocks<JPEGDecodingMode::Progressive>(context, scan, macroblocks, hcursor, vcursor);
+                return build_macroblocks<JPEGDecodingMode::Sequential>(context, scan, macroblocks, hcursor, vcursor);
             }();
 
             if (result.is_error()) {
@@ -830,6 +974,7 @@ static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<M
                 return result.release_error();
             }
         }
+        ++context.complete_mcu_rows_in_current_scan;
     }
     return {};
 }
@@ -1400,21 +1545,19 @@ static ErrorOr<void> skip_segment(JPEGStream& stream)
 }
 
 template<CallableAs<void, Component const&, i16*> F>
-static void for_each_macroblock_component(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks, F&& component_handler)
+static void for_each_macroblock_component_in_mcu_row(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks, u32 vcursor, F&& component_handler)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
-            for (u32 i = 0; i < context.components.size(); i++) {
-                auto const& component = context.components[i];
+    for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
+        for (u32 i = 0; i < context.components.size(); i++) {
+            auto const& component = context.components[i];
 
-                for (u32 vfactor_i = 0; vfactor_i < component.sampling_factors.vertical; vfactor_i++) {
-                    for (u32 hfactor_i = 0; hfactor_i < component.sampling_factors.horizontal; hfactor_i++) {
-                        u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                        Macroblock& block = macroblocks[macroblock_index];
-                        auto* block_component = get_component(block, i);
+            for (u32 vfactor_i = 0; vfactor_i < component.sampling_factors.vertical; vfactor_i++) {
+                for (u32 hfactor_i = 0; hfactor_i < component.sampling_factors.horizontal; hfactor_i++) {
+                    u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
+                    Macroblock& block = macroblocks[macroblock_index];
+                    auto* block_component = get_component(block, i);
 
-                        component_handler(component, block_component);
-                    }
+                    component_handler(component, block_component);
                 }
             }
         }
@@ -1429,9 +1572,9 @@ static void dequantize(JPEGLoadingContext const& context, Component const& compo
         block_component[k] *= quantization_table[k];
 }
 
-static void inverse_dct_8x8(i16* block_component)
+// One 1-D IDCT of 8 samples, done for the 4 lanes of the vectors at once.
+static ALWAYS_INLINE void inverse_dct_1d(AK::SIMD::f32x4* samples)
 {
-    // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
     // The 1-D DCT idea is described at https://unix4lyfe.org/dct-1d/, read aan.cc from bottom to top.
     static float const m0 = 2.0f * AK::cos(1.0f / 16.0f * 2.0f * AK::Pi<float>);
     static float const m1 = 2.0f * AK::cos(2.0f / 16.0f * 2.0f * AK::Pi<float>);
@@ -1448,145 +1591,201 @@ static void inverse_dct_8x8(i16* block_component)
     static float const s6 = AK::cos(6.0f / 16.0f * AK::Pi<float>) / 2.0f;
     static float const s7 = AK::cos(7.0f / 16.0f * AK::Pi<float>) / 2.0f;
 
-    for (u32 k = 0; k < 8; ++k) {
-        float const g0 = block_component[0 * 8 + k] * s0;
-        float const g1 = block_component[4 * 8 + k] * s4;
-        float const g2 = block_component[2 * 8 + k] * s2;
-        float const g3 = block_component[6 * 8 + k] * s6;
-        float const g4 = block_component[5 * 8 + k] * s5;
-        float const g5 = block_component[1 * 8 + k] * s1;
-        float const g6 = block_component[7 * 8 + k] * s7;
-        float const g7 = block_component[3 * 8 + k] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[0 * 8 + k] = b0 + b7;
-        block_component[1 * 8 + k] = b1 + b6;
-        block_component[2 * 8 + k] = b2 + b5;
-        block_component[3 * 8 + k] = b3 + b4;
-        block_component[4 * 8 + k] = b3 - b4;
-        block_component[5 * 8 + k] = b2 - b5;
-        block_component[6 * 8 + k] = b1 - b6;
-        block_component[7 * 8 + k] = b0 - b7;
-    }
-    for (u32 l = 0; l < 8; ++l) {
-        float const g0 = block_component[l * 8 + 0] * s0;
-        float const g1 = block_component[l * 8 + 4] * s4;
-        float const g2 = block_component[l * 8 + 2] * s2;
-        float const g3 = block_component[l * 8 + 6] * s6;
-        float const g4 = block_component[l * 8 + 5] * s5;
-        float const g5 = block_component[l * 8 + 1] * s1;
-        float const g6 = block_component[l * 8 + 7] * s7;
-        float const g7 = block_component[l * 8 + 3] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[l * 8 + 0] = b0 + b7;
-        block_component[l * 8 + 1] = b1 + b6;
-        block_component[l * 8 + 2] = b2 + b5;
-        block_component[l * 8 + 3] = b3 + b4;
-        block_component[l * 8 + 4] = b3 - b4;
-        block_component[l * 8 + 5] = b2 - b5;
-        block_component[l * 8 + 6] = b1 - b6;
-        block_component[l * 8 + 7] = b0 - b7;
+    using AK::SIMD::f32x4;
+
+    f32x4 const g0 = samples[0] * s0;
+    f32x4 const g1 = samples[4] * s4;
+    f32x4 const g2 = samples[2] * s2;
+    f32x4 const g3 = samples[6] * s6;
+    f32x4 const g4 = samples[5] * s5;
+    f32x4 const g5 = samples[1] * s1;
+    f32x4 const g6 = samples[7] * s7;
+    f32x4 const g7 = samples[3] * s3;
+
+    f32x4 const f0 = g0;
+    f32x4 const f1 = g1;
+    f32x4 const f2 = g2;
+    f32x4 const f3 = g3;
+    f32x4 const f4 = g4 - g7;
+    f32x4 const f5 = g5 + g6;
+    f32x4 const f6 = g5 - g6;
+    f32x4 const f7 = g4 + g7;
+
+    f32x4 const e0 = f0;
+    f32x4 const e1 = f1;
+    f32x4 const e2 = f2 - f3;
+    f32x4 const e3 = f2 + f3;
+    f32x4 const e4 = f4;
+    f32x4 const e5 = f5 - f7;
+    f32x4 const e6 = f6;
+    f32x4 const e7 = f5 + f7;
+    f32x4 const e8 = f4 + f6;
+
+    f32x4 const d0 = e0;
+    f32x4 const d1 = e1;
+    f32x4 const d2 = e2 * m1;
+    f32x4 const d3 = e3;
+    f32x4 const d4 = e4 * m2;
+    f32x4 const d5 = e5 * m3;
+    f32x4 const d6 = e6 * m4;
+    f32x4 const d7 = e7;
+    f32x4 const d8 = e8 * m5;
+
+    f32x4 const c0 = d0 + d1;
+    f32x4 const c1 = d0 - d1;
+    f32x4 const c2 = d2 - d3;
+    f32x4 const c3 = d3;
+    f32x4 const c4 = d4 + d8;
+    f32x4 const c5 = d5 + d7;
+    f32x4 const c6 = d6 - d8;
+    f32x4 const c7 = d7;
+    f32x4 const c8 = c5 - c6;
+
+    f32x4 const b0 = c0 + c3;
+    f32x4 const b1 = c1 + c2;
+    f32x4 const b2 = c1 - c2;
+    f32x4 const b3 = c0 - c3;
+    f32x4 const b4 = c4 - c8;
+    f32x4 const b5 = c8;
+    f32x4 const b6 = c6 - c7;
+    f32x4 const b7 = c7;
+
+    samples[0] = b0 + b7;
+    samples[1] = b1 + b6;
+    samples[2] = b2 + b5;
+    samples[3] = b3 + b4;
+    samples[4] = b3 - b4;
+    samples[5] = b2 - b5;
+    samples[6] = b1 - b6;
+    samples[7] = b0 - b7;
+}
+
+static ALWAYS_INLINE void transpose_4x4(AK::SIMD::f32x4* rows)
+{
+    auto const t0 = __builtin_shufflevector(rows[0], rows[1], 0, 4, 1, 5);
+    auto const t1 = __builtin_shufflevector(rows[0], rows[1], 2, 6, 3, 7);
+    auto const t2 = __builtin_shufflevector(rows[2], rows[3], 0, 4, 1, 5);
+    auto const t3 = __builtin_shufflevector(rows[2], rows[3], 2, 6, 3, 7);
+    rows[0] = __builtin_shufflevector(t0, t2, 0, 1, 4, 5);
+    rows[1] = __builtin_shufflevector(t0, t2, 2, 3, 6, 7);
+    rows[2] = __builtin_shufflevector(t1, t3, 0, 1, 4, 5);
+    rows[3] = __builtin_shufflevector(t1, t3, 2, 3, 6, 7);
+}
+
+// The block is kept as its left and right halves, each one being 8 rows of 4 samples.
+static ALWAYS_INLINE void transpose_8x8(AK::SIMD::f32x4* left, AK::SIMD::f32x4* right)
+{
+    transpose_4x4(left);
+    transpose_4x4(left + 4);
+    transpose_4x4(right);
+    transpose_4x4(right + 4);
+    for (u8 i = 0; i < 4; ++i)
+        swap(left[4 + i], right[i]);
+}
+
+static ALWAYS_INLINE AK::SIMD::f32x4 truncate_to_integers(AK::SIMD::f32x4 samples)
+{
+    return AK::SIMD::simd_cast<AK::SIMD::f32x4>(AK::SIMD::simd_cast<AK::SIMD::i32x4>(samples));
+}
+
+static void inverse_dct_8x8(i16* block_component)
+{
+    // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
+    // The first pass works on the columns, 4 of them at a time, and the second one on the rows of the transposed block.
+    // The samples are truncated to integers after each pass, like they would be if they were stored in the block.
+    using namespace AK::SIMD;
+
+    f32x4 left[8];
+    f32x4 right[8];
+    for (u8 i = 0; i < 8; ++i) {
+        left[i] = simd_cast<f32x4>(load_unaligned<i16x4>(block_component + i * 8));
+        right[i] = simd_cast<f32x4>(load_unaligned<i16x4>(block_component + i * 8 + 4));
+    }
+
+    inverse_dct_1d(left);
+    inverse_dct_1d(right);
+    for (u8 i = 0; i < 8; ++i) {
+        left[i] = truncate_to_integers(left[i]);
+        right[i] = truncate_to_integers(right[i]);
+    }
+
+    transpose_8x8(left, right);
+    inverse_dct_1d(left);
+    inverse_dct_1d(right);
+    transpose_8x8(left, right);
+
+    for (u8 i = 0; i < 8; ++i) {
+        store_unaligned(block_component + i * 8, simd_cast<i16x4>(simd_cast<i32x4>(left[i])));
+        store_unaligned(block_component + i * 8 + 4, simd_cast<i16x4>(simd_cast<i32x4>(right[i])));
+    }
+}
+
+static u8 samples_per_block(JPEGLoadingContext const& context)
+{
+    return 8 / context.scale_denominator;
+}
+
+static IntSize scaled_size(JPEGLoadingContext const& context)
+{
+    return { ceil_div(context.frame.width, context.scale_denominator), ceil_div(context.frame.height, context.scale_denominator) };
+}
+
+static Array<float, 16> scaled_inverse_dct_cosines(u8 size)
+{
+    // cosines[x * size + u] = C(u) * cos((2x + 1) * u * pi / (2 * size))
+    Array<float, 16> cosines {};
+    for (u8 x = 0; x < size; ++x) {
+        for (u8 u = 0; u < size; ++u) {
+            float const c = u == 0 ? 1.0f / AK::sqrt(2.0f) : 1.0f;
+            cosines[x * size + u] = c * AK::cos((2 * x + 1) * u * AK::Pi<float> / (2 * size));
+        }
+    }
+    return cosines;
+}
+
+static void scaled_inverse_dct(i16* block_component, u8 size)
+{
+    // A.3.3 - FDCT and IDCT
+    // Evaluating the IDCT on a size x size grid using only the size x size lowest frequencies yields the block
+    // downscaled by 8 / size, without ever computing the full resolution samples. The normalization factor of 1/4
+    // stays the same. The samples are written to the top left corner of the block.
+    VERIFY(size == 1 || size == 2 || size == 4);
+
+    if (size == 1) {
+        block_component[0] = round_to<i16>(block_component[0] / 8.0f);
+        return;
+    }
+
+    static auto const cosines_for_size_2 = scaled_inverse_dct_cosines(2);
+    static auto const cosines_for_size_4 = scaled_inverse_dct_cosines(4);
+    auto const& cosines = size == 2 ? cosines_for_size_2 : cosines_for_size_4;
+
+    Array<float, 16> rows {};
+    for (u8 v = 0; v < size; ++v) {
+        for (u8 x = 0; x < size; ++x) {
+            float sum = 0;
+            for (u8 u = 0; u < size; ++u)
+                sum += cosines[x * size + u] * block_component[v * 8 + u];
+            rows[v * size + x] = sum;
+        }
+    }
+
+    for (u8 y = 0; y < size; ++y) {
+        for (u8 x = 0; x < size; ++x) {
+            float sum = 0;
+            for (u8 v = 0; v < size; ++v)
+                sum += cosines[y * size + v] * rows[v * size + x];
+            block_component[y * 8 + x] = round_to<i16>(sum / 4.0f);
+        }
     }
 }
 
 static void inverse_dct(JPEGLoadingContext const& context, i16* block_component)
 {
-    inverse_dct_8x8(block_component);
+    if (context.scale_denominator == 1)
+        inverse_dct_8x8(block_component);
+    else
+        scaled_inverse_dct(block_component, samples_per_block(context));
 
     // F.2.1.5 - Inverse DCT (IDCT)
     auto const level_shift = 1 << (context.frame.precision - 1);
@@ -1613,6 +1812,7 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
     // FIXME: Allow more combinations of sampling factors.
     // See https://calendar.perfplanet.com/2015/why-arent-your-images-using-chroma-subsampling/ for
     // subsampling factors visble on the web. In PDF files, YCCK 2111 and 2112 and CMYK 2111 and 2112 are also present.
+    u8 const samples = samples_per_block(context);
     for (u32 component_i = 0; component_i < context.components.size(); component_i++) {
         auto& component = context.components[component_i];
         if (component.sampling_factors == context.sampling_factors)
@@ -1630,12 +1830,12 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[macroblock_index];
                         auto* block_component_destination = get_component(block, component_i);
-                        for (u8 i = 7; i < 8; --i) {
-                            for (u8 j = 7; j < 8; --j) {
+                        for (u8 i = samples - 1; i < samples; --i) {
+                            for (u8 j = samples - 1; j < samples; --j) {
                                 u8 const pixel = i * 8 + j;
                                 // The component is 8x8 subsampled 2x2. Upsample its 2x2 4x4 tiles.
-                                u32 const component_pxrow = (i / context.sampling_factors.vertical) + 4 * vfactor_i;
-                                u32 const component_pxcol = (j / context.sampling_factors.horizontal) + 4 * hfactor_i;
+                                u32 const component_pxrow = (i / context.sampling_factors.vertical) + (samples / context.sampling_factors.vertical) * vfactor_i;
+                                u32 const component_pxcol = (j / context.sampling_factors.horizontal) + (samples / context.sampling_factors.horizontal) * hfactor_i;
                                 u32 const component_pixel = component_pxrow * 8 + component_pxcol;
                                 block_component_destination[pixel] = block_component_source[component_pixel];
                             }
@@ -1759,15 +1959,17 @@ static ErrorOr<void> handle_color_transform(JPEGLoadingContext const& context, V
 
 static ErrorOr<void> compose_bitmap(JPEGLoadingContext& context, Vector<Macroblock> const& macroblocks)
 {
-    context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { context.frame.width, context.frame.height }));
-
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        u32 const block_row = y / 8;
-        u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
+    auto const size = scaled_size(context);
+    u8 const samples = samples_per_block(context);
+    context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, size));
+
+    for (int y = size.height() - 1; y >= 0; y--) {
+        u32 const block_row = y / samples;
+        u32 const pixel_row = y % samples;
+        for (int x = 0; x < size.width(); x++) {
+            u32 const block_column = x / samples;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
+            u32 const pixel_column = x % samples;
             u32 const pixel_index = pixel_row * 8 + pixel_column;
             Color const color { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index] };
             context.bitmap->set_pixel(x, y, color);
@@ -1777,20 +1979,130 @@ static ErrorOr<void> compose_bitmap(JPEGLoadingContext& context, Vector<Macroblo
     return {};
 }
 
+static bool can_compose_mcu_rows_directly(JPEGLoadingContext const& context)
+{
+    // Grayscale and YCbCr images, with components that are either subsampled by the MCU size or not at all, are
+    // converted to RGB while their MCU rows are decoded. See compose_mcu_row().
+    if (context.components.size() == 1)
+        return true;
+    if (context.components.size() != 3)
+        return false;
+    if (context.color_transform.has_value() && *context.color_transform != ColorTransform::YCbCr)
+        return false;
+
+    for (auto const& component : context.components) {
+        if (component.sampling_factors != context.sampling_factors && component.sampling_factors != SamplingFactors { 1, 1 })
+            return false;
+    }
+    return true;
+}
+
+static void compose_mcu_row(JPEGLoadingContext& context, Vector<Macroblock> const& macroblocks, u32 vcursor)
+{
+    // This does the job of undo_subsampling(), handle_color_transform() and compose_bitmap() for one row of MCUs at
+    // once, and with the same results. Each row of pixels is gathered from the blocks, then converted to RGB with
+    // vector instructions.
+    using namespace AK::SIMD;
+
+    auto const size = scaled_size(context);
+    u8 const samples = samples_per_block(context);
+    auto const sampling_factors = context.sampling_factors;
+    u32 const hpadded_count = context.mblock_meta.hpadded_count;
+
+    int const first_row = vcursor * samples;
+    int const end_row = min<int>((vcursor + sampling_factors.vertical) * samples, size.height());
+
+    if (context.components.size() == 1) {
+        for (int y = first_row; y < end_row; ++y) {
+            auto const* blocks = &macroblocks[(y / samples) * hpadded_count];
+            u32 const pixel_row = y % samples;
+            auto* scanline = context.bitmap->scanline(y);
+            for (int x = 0; x < size.width(); ++x) {
+                u32 const luma = static_cast<u8>(blocks[x / samples].y[pixel_row * 8 + x % samples]);
+                scanline[x] = 0xFF000000 | (luma * 0x010101);
+            }
+        }
+        return;
+    }
+
+    bool const is_cb_subsampled = context.components[1].sampling_factors != sampling_factors;
+    bool const is_cr_subsampled = context.components[2].sampling_factors != sampling_factors;
+
+    static constexpr int chunk_size = 64;
+    alignas(16) float luma[chunk_size];
+    alignas(16) float blue_difference[chunk_size];
+    alignas(16) float red_difference[chunk_size];
+
+    for (int y = first_row; y < end_row; ++y) {
+        u32 const block_row = y / samples;
+        u32 const pixel_row = y % samples;
+        u32 const vfactor_i = block_row - vcursor;
+        u32 const subsampled_pixel_row = pixel_row / sampling_factors.vertical + (samples / sampling_factors.vertical) * vfactor_i;
+        auto* scanline = context.bitmap->scanline(y);
+
+        for (int chunk_start = 0; chunk_start < size.width(); chunk_start += chunk_size) {
+            int const chunk_width = min(chunk_size, size.width() - chunk_start);
+            for (int i = 0; i < chunk_width; ++i) {
+                u32 const x = chunk_start + i;
+                u32 const block_column = x / samples;
+                u32 const pixel_column = x % samples;
+                u32 const hfactor_i = block_column % sampling_factors.horizontal;
+                u32 const hcursor = block_column - hfactor_i;
+
+                auto const& block = macroblocks[block_row * hpadded_count + block_column];
+                auto const& subsampled_block = macroblocks[vcursor * hpadded_count + hcursor];
+                u32 const pixel_index = pixel_row * 8 + pixel_column;
+                u32 const subsampled_pixel_column = pixel_column / sampling_factors.horizontal + (samples / sampling_factors.horizontal) * hfactor_i;
+                u32 const subsampled_pixel_index = subsampled_pixel_row * 8 + subsampled_pixel_column;
+
+                luma[i] = block.y[pixel_index];
+                blue_difference[i] = (is_cb_subsampled ? subsampled_block.cb[subsampled_pixel_index] : block.cb[pixel_index]) - 128;
+                red_difference[i] = (is_cr_subsampled ? subsampled_block.cr[subsampled_pixel_index] : block.cr[pixel_index]) - 128;
+            }
+            for (int i = chunk_width; i % 4 != 0; ++i) {
+                luma[i] = 0;
+                blue_difference[i] = 0;
+                red_difference[i] = 0;
+            }
+
+            // See ycbcr_to_rgb(), the samples are converted to integers the same way.
+            for (int i = 0; i < chunk_width; i += 4) {
+                auto const y_samples = load_unaligned<f32x4>(&luma[i]);
+                auto const cb_samples = load_unaligned<f32x4>(&blue_difference[i]);
+                auto const cr_samples = load_unaligned<f32x4>(&red_difference[i]);
+
+                auto const r = clamp(simd_cast<i32x4>(y_samples + 1.402f * cr_samples), 0, 255);
+                auto const g = clamp(simd_cast<i32x4>(y_samples - 0.3441f * cb_samples - 0.7141f * cr_samples), 0, 255);
+                auto const b = clamp(simd_cast<i32x4>(y_samples + 1.772f * cb_samples), 0, 255);
+                auto const pixels = expand4(0xFF000000u) | simd_cast<u32x4>((r << 16) | (g << 8) | b);
+
+                if (i + 4 <= chunk_width) {
+                    store_unaligned(&scanline[chunk_start + i], pixels);
+                } else {
+                    for (int lane = 0; i + lane < chunk_width; ++lane)
+                        scanline[chunk_start + i + lane] = pixels[lane];
+                }
+            }
+        }
+    }
+}
+
 static ErrorOr<void> compose_cmyk_bitmap(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
 {
     if (context.options.cmyk == JPEGDecoderOptions::CMYK::Normal)
         invert_colors_for_adobe_images(context, macroblocks);
 
-    context.cmyk_bitmap = TRY(Gfx::CMYKBitmap::create_with_size({ context.frame.width, context.frame.height }));
+    auto const size = scaled_size(context);
+    u8 const samples = samples_per_block(context);
+    context.cmyk_bitmap = TRY(Gfx::CMYKBitmap::create_with_size(size));
 
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
-        u32 const block_row = y / 8;
-        u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
+    for (int y = size.height() - 1; y >= 0; y--) {
+        u32 const block_row = y / samples;
+        u32 const pixel_row = y % samples;
+        for (int x = 0; x < size.width(); x++) {
+            u32 const block_column = x / samples;
             auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
+            u32 const pixel_column = x % samples;
             u32 const pixel_index = pixel_row * 8 + pixel_column;
             context.cmyk_bitmap->scanline(y)[x] = { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index], (u8)block.k[pixel_index] };
         }
@@ -1915,24 +2227,51 @@ static ErrorOr<void> decode_header(JPEGLoadingContext& context)
     return {};
 }
 
-static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& context)
+static bool can_skip_current_scan(JPEGLoadingContext const& context)
+{
+    // G.1.1.1.1 - Spectral selection control
+    // A progressive scan only carries a band of coefficients. When decoding at a reduced size, the scans that only
+    // carry frequencies we don't use don't have to be decoded at all.
+    if (!is_progressive(context.frame.type) || context.scale_denominator == 1)
+        return false;
+
+    u8 const samples = samples_per_block(context);
+    u8 highest_used_coefficient = 0;
+    for (u8 k = 0; k < 64; ++k) {
+        if (zigzag_map[k] / 8 < samples && zigzag_map[k] % 8 < samples)
+            highest_used_coefficient = k;
+    }
+    return context.current_scan->spectral_selection_start > highest_used_coefficient;
+}
+
+static ErrorOr<void> decode_scans(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
 {
     // B.6 - Summary
     // See: Figure B.16 – Flow of compressed data syntax
     // This function handles the "Multi-scan" loop.
 
-    Vector<Macroblock> macroblocks;
-    TRY(macroblocks.try_resize(context.mblock_meta.padded_total));
-
     Marker marker = TRY(read_until_marker(context.stream));
     while (true) {
         if (is_miscellaneous_or_table_marker(marker)) {
             TRY(handle_miscellaneous_or_table(context.stream, context, marker));
         } else if (marker == JPEG_SOS) {
             TRY(read_start_of_scan(context.stream, context));
+            context.complete_mcu_rows_in_current_scan = 0;
+            if (can_skip_current_scan(context)) {
+                // The entropy-coded segment runs until the first marker that isn't a restart marker.
+                do {
+                    marker = TRY(read_until_marker(context.stream));
+                } while (marker >= JPEG_RST0 && marker <= JPEG_RST7);
+                continue;
+            }
             TRY(decode_huffman_stream(context, macroblocks));
+            if (context.current_scan->spectral_selection_start == 0) {
+                for (auto const& scan_component : context.current_scan->components)
+                    context.has_complete_dc_scan[scan_component.component.index] = true;
+            }
         } else if (marker == JPEG_EOI) {
-            return macroblocks;
+            context.has_seen_end_of_image = true;
+            return {};
         } else {
             dbgln_if(JPEG_DEBUG, "Unexpected marker {:x}!", marker);
             return Error::from_string_literal("Unexpected marker");
@@ -1942,13 +2281,68 @@ static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& con
     }
 }
 
+static ErrorOr<Vector<Macroblock>> construct_macroblocks(JPEGLoadingContext& context)
+{
+    Vector<Macroblock> macroblocks;
+    TRY(macroblocks.try_resize(context.mblock_meta.padded_total));
+
+    if (auto result = decode_scans(context, macroblocks); result.is_error()) {
+        // If the data was cut off, the blocks that were decoded before it ended are still good.
+        if (!context.may_be_truncated)
+            return result.release_error();
+        dbgln_if(JPEG_DEBUG, "Stopped decoding a possibly truncated image: {}", result.error());
+    }
+    return macroblocks;
+}
+
+static int decoded_rows_of_partial_image(JPEGLoadingContext const& context)
+{
+    int const height = scaled_size(context).height();
+    if (context.has_seen_end_of_image)
+        return height;
+
+    // Progressive scans refine the whole image, so all of it can be shown as soon as every component has its DC
+    // coefficients. This also covers sequential images that were only missing their EOI marker.
+    bool const every_component_has_dc = all_of(context.components, [&](Component const& component) {
+        return context.has_complete_dc_scan[component.index];
+    });
+    if (every_component_has_dc)
+        return height;
+
+    // A scan of all components that was cut off still covers the image down to its last complete row of MCUs.
+    if (!context.current_scan.has_value() || context.current_scan->spectral_selection_start != 0 || context.current_scan->components.size() != context.components.size())
+        return 0;
+    auto const rows = static_cast<u64>(context.complete_mcu_rows_in_current_scan) * context.sampling_factors.vertical * samples_per_block(context);
+    return static_cast<int>(min<u64>(rows, height));
+}
+
 static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
 {
     auto macroblocks = TRY(construct_macroblocks(context));
-    for_each_macroblock_component(context, macroblocks, [&](Component const& component, i16* block_component) {
-        dequantize(context, component, block_component);
-        inverse_dct(context, block_component);
+
+    bool const compose_mcu_rows_directly = can_compose_mcu_rows_directly(context);
+    if (compose_mcu_rows_directly)
+        context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, scaled_size(context)));
+
+    // The MCU rows don't share any blocks, so they are transformed on multiple threads.
+    Vector<u32> mcu_rows;
+    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical)
+        TRY(mcu_rows.try_append(vcursor));
+
+    Threading::parallel_for(mcu_rows.span(), [&](Span<u32> rows) {
+        for (auto vcursor : rows) {
+            for_each_macroblock_component_in_mcu_row(context, macroblocks, vcursor, [&](Component const& component, i16* block_component) {
+                dequantize(context, component, block_component);
+                inverse_dct(context, block_component);
+            });
+            if (compose_mcu_rows_directly)
+                compose_mcu_row(context, macroblocks, vcursor);
+        }
     });
+
+    if (compose_mcu_rows_directly)
+        return {};
+
     undo_subsampling(context, macroblocks);
     TRY(handle_color_transform(context, macroblocks));
     if (context.components.size() == 4)
@@ -1958,8 +2352,9 @@ static ErrorOr<void> decode_jpeg(JPEGLoadingContext& context)
     return {};
 }
 
-JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext> context)
-    : m_context(move(context))
+JPEGImageDecoderPlugin::JPEGImageDecoderPlugin(ReadonlyBytes data, NonnullOwnPtr<JPEGLoadingContext> context)
+    : m_data(data)
+    , m_context(move(context))
 {
 }
 
@@ -1985,28 +2380,55 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create(Readon
 
 ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create_with_options(ReadonlyBytes data, JPEGDecoderOptions options)
 {
-    auto stream = TRY(try_make<FixedMemoryStream>(data));
-    auto context = TRY(JPEGLoadingContext::create(move(stream), options));
-    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(move(context))));
+    auto context = TRY(JPEGLoadingContext::create(data, options));
+    auto plugin = TRY(adopt_nonnull_own_or_enomem(new (nothrow) JPEGImageDecoderPlugin(data, move(context))));
     TRY(decode_header(*plugin->m_context));
     return plugin;
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+static u8 scale_denominator_for_ideal_size(JPEGLoadingContext const& context, Optional<IntSize> ideal_size)
 {
-    if (index > 0)
-        return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
+    if (!ideal_size.has_value() || ideal_size->is_empty() || !is_dct_based(context.frame.type))
+        return 1;
+
+    // Pick the largest reduction that still covers the ideal size, so that the caller never has to scale up.
+    for (u8 scale_denominator = 8; scale_denominator > 1; scale_denominator /= 2) {
+        if (ceil_div(context.frame.width, scale_denominator) >= ideal_size->width()
+            && ceil_div(context.frame.height, scale_denominator) >= ideal_size->height())
+            return scale_denominator;
+    }
+    return 1;
+}
+
+ErrorOr<void> JPEGImageDecoderPlugin::decode_image_if_needed(u8 scale_denominator)
+{
+    if (m_context->state == JPEGLoadingContext::State::BitmapDecoded) {
+        if (m_context->scale_denominator <= scale_denominator)
+            return {};
+
+        // The image was decoded at a smaller size than what is needed now, so we have to start over.
+        m_context = TRY(JPEGLoadingContext::create(m_data, m_context->options));
+        TRY(decode_header(*m_context));
+    }
 
     if (m_context->state == JPEGLoadingContext::State::Error)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
-    if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
-        if (auto result = decode_jpeg(*m_context); result.is_error()) {
-            m_context->state = JPEGLoadingContext::State::Error;
-            return result.release_error();
-        }
-        m_context->state = JPEGLoadingContext::State::BitmapDecoded;
+    m_context->scale_denominator = scale_denominator;
+    if (auto result = decode_jpeg(*m_context); result.is_error()) {
+        m_context->state = JPEGLoadingContext::State::Error;
+        return result.release_error();
     }
+    m_context->state = JPEGLoadingContext::State::BitmapDecoded;
+    return {};
+}
+
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
+{
+    if (index > 0)
+        return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
+
+    TRY(decode_image_if_needed(scale_denominator_for_ideal_size(*m_context, ideal_size)));
 
     if (m_context->cmyk_bitmap && !m_context->bitmap)
         return ImageFrameDescriptor { TRY(m_context->cmyk_bitmap->to_low_quality_rgb()), 0 };
@@ -2014,6 +2436,18 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Option
     return ImageFrameDescriptor { m_context->bitmap, 0 };
 }
 
+ErrorOr<PartialFrameDescriptor> JPEGImageDecoderPlugin::partial_frame()
+{
+    m_context->may_be_truncated = true;
+    TRY(decode_image_if_needed(1));
+
+    auto const decoded_rows = decoded_rows_of_partial_image(*m_context);
+    if (m_context->cmyk_bitmap && !m_context->bitmap)
+        return PartialFrameDescriptor { TRY(m_context->cmyk_bitmap->to_low_quality_rgb()), decoded_rows };
+
+    return PartialFrameDescriptor { m_context->bitmap, decoded_rows };
+}
+
 Optional<Metadata const&> JPEGImageDecoderPlugin::metadata()
 {
     if (m_context->exif_metadata)
@@ -2044,13 +2478,7 @@ ErrorOr<NonnullRefPtr<CMYKBitmap>> JPEGImageDecoderPlugin::cmyk_frame()
 {
     VERIFY(natural_frame_format() == NaturalFrameFormat::CMYK);
 
-    if (m_context->state < JPEGLoadingContext::State::BitmapDecoded) {
-        if (auto result = decode_jpeg(*m_context); result.is_error()) {
-            m_context->state = JPEGLoadingContext::State::Error;
-            return result.release_error();
-        }
-        m_context->state = JPEGLoadingContext::State::BitmapDecoded;
-    }
+    TRY(decode_image_if_needed(1));
 
     return *m_context->cmyk_bitmap;
 }
@@ -36,8 +36,12 @@ public:
     virtual ~JPEGImageDecoderPlugin() override;
     virtual IntSize size() override;
 
+    // DCT-based images are decoded at 1/2, 1/4 or 1/8 of their size if that still covers the ideal size.
     virtual ErrorOr<ImageFrameDescriptor> frame(size_t index, Optional<IntSize> ideal_size = {}) override;
 
+    // The rows of a progressive image only appear once its first scans are complete, and are refined from then on.
+    virtual ErrorOr<PartialFrameDescriptor> partial_frame() override;
+
     virtual Optional<Metadata const&> metadata() override;
 
     virtual ErrorOr<Optional<ReadonlyBytes>> icc_data() override;
@@ -46,8 +50,11 @@ public:
     virtual ErrorOr<NonnullRefPtr<CMYKBitmap>> cmyk_frame() override;
 
 private:
-    JPEGImageDecoderPlugin(NonnullOwnPtr<JPEGLoadingContext>);
+    JPEGImageDecoderPlugin(ReadonlyBytes, NonnullOwnPtr<JPEGLoadingContext>);
+
+    ErrorOr<void> decode_image_if_needed(u8 scale_denominator);
 
+    ReadonlyBytes m_data;
     NonnullOwnPtr<JPEGLoadingContext> m_context;
 };
 
@@ -87,6 +87,18 @@ ErrorOr<ANSHistogram> ANSHistogram::read_histogram(LittleEndianInputBitStream& s
     return histogram;
 }
 
+ErrorOr<ANSHistogram> ANSHistogram::clone() const
+{
+    ANSHistogram histogram;
+    histogram.m_symbols = m_symbols;
+    histogram.m_offsets = m_offsets;
+    histogram.m_cutoffs = m_cutoffs;
+    histogram.m_distribution = TRY(m_distribution.clone());
+    histogram.m_log_bucket_size = m_log_bucket_size;
+    histogram.m_bucket_size = m_bucket_size;
+    return histogram;
+}
+
 ErrorOr<u16> ANSHistogram::read_symbol(LittleEndianInputBitStream& stream, Optional<u32>& state) const
 {
     if (!state.has_value())
@@ -331,6 +343,37 @@ ErrorOr<EntropyDecoder> EntropyDecoder::create(LittleEndianInputBitStream& strea
     return entropy_decoder;
 }
 
+ErrorOr<EntropyDecoder> EntropyDecoder::clone_for_new_stream() const
+{
+    EntropyDecoder entropy_decoder;
+    entropy_decoder.m_lz77 = m_lz77;
+    entropy_decoder.m_lz_dist_ctx = m_lz_dist_ctx;
+    entropy_decoder.m_lz_len_conf = m_lz_len_conf;
+    if (m_lz77.lz77_enabled)
+        entropy_decoder.m_lz77_window = TRY(FixedArray<u32>::create(1 << 20));
+    entropy_decoder.m_dist_multiplier = m_dist_multiplier;
+
+    entropy_decoder.m_clusters = m_clusters;
+    entropy_decoder.m_configs = m_configs;
+    entropy_decoder.m_log_alphabet_size = m_log_alphabet_size;
+
+    TRY(m_distributions.visit(
+        [&](Vector<BrotliCanonicalCode> const& distributions) -> ErrorOr<void> {
+            entropy_decoder.m_distributions = distributions;
+            return {};
+        },
+        [&](Vector<ANSHistogram> const& distributions) -> ErrorOr<void> {
+            Vector<ANSHistogram> cloned_distributions;
+            TRY(cloned_distributions.try_ensure_capacity(distributions.size()));
+            for (auto const& distribution : distributions)
+                cloned_distributions.unchecked_append(TRY(distribution.clone()));
+            entropy_decoder.m_distributions = move(cloned_distributions);
+            return {};
+        }));
+
+    return entropy_decoder;
+}
+
 ErrorOr<u32> EntropyDecoder::decode_hybrid_uint(LittleEndianInputBitStream& stream, u32 context)
 {
     // C.3.3 - Hybrid integer decoding
@@ -16,6 +16,8 @@ class ANSHistogram {
 public:
     static ErrorOr<ANSHistogram> read_histogram(LittleEndianInputBitStream& stream, u8 log_alphabet_size);
 
+    ErrorOr<ANSHistogram> clone() const;
+
     ErrorOr<u16> read_symbol(LittleEndianInputBitStream& stream, Optional<u32>& state) const;
 
 private:
@@ -59,6 +61,10 @@ public:
 
     static ErrorOr<EntropyDecoder> create(LittleEndianInputBitStream& stream, u32 initial_num_distrib);
 
+    // Returns a decoder with the same distributions, but without any state from the streams decoded so far.
+    // This allows decoding independent streams, like the ones of modular groups, on multiple threads.
+    ErrorOr<EntropyDecoder> clone_for_new_stream() const;
+
     ErrorOr<u32> decode_hybrid_uint(LittleEndianInputBitStream& stream, u32 context);
 
     void set_dist_multiplier(u32 dist_multiplier)
@@ -10,6 +10,7 @@
 #include <AK/Endian.h>
 #include <AK/Enumerate.h>
 #include <AK/FixedArray.h>
+#include <AK/MemoryStream.h>
 #include <AK/String.h>
 #include <LibCompress/Brotli.h>
 #include <LibGfx/ImageFormats/ExifOrientedBitmap.h>
@@ -22,6 +23,7 @@
 #include <LibGfx/ImageFormats/JPEGXL/SelfCorrectingPredictor.h>
 #include <LibGfx/ImageFormats/JPEGXLLoader.h>
 #include <LibGfx/Matrix3x3.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 namespace Gfx::JPEGXL {
 
@@ -1941,10 +1943,16 @@ static ErrorOr<void> read_group_data(
     if constexpr (JPEGXL_DEBUG)
         debug_print(original_channels[0]);
 
+    // Every group is an entropy-coded stream of its own, so it gets its own copy of the decoder.
+    // This lets groups be decoded in parallel.
+    Optional<EntropyDecoder> decoder;
+    if (global_modular.decoder.has_value())
+        decoder = TRY(global_modular.decoder->clone_for_new_stream());
+
     auto decoded = TRY(read_modular_bitstream(stream,
         {
             .channels_info = channels_info,
-            .decoder = global_modular.decoder,
+            .decoder = decoder,
             .global_tree = global_modular.ma_tree,
             .group_dim = group_dim,
             .stream_index = stream_index,
@@ -2094,6 +2102,12 @@ struct Frame {
     Optional<Image> image {};
 };
 
+struct GroupSection {
+    u32 group_index {};
+    ByteBuffer data;
+    Optional<Error> error;
+};
+
 class AutoDepletingConstrainedStream : public ConstrainedStream {
 public:
     AutoDepletingConstrainedStream(MaybeOwned<Stream> stream, u64 limit)
@@ -2177,23 +2191,57 @@ static ErrorOr<Frame> read_frame(LittleEndianInputBitStream& stream,
         return TRY(try_make<LittleEndianInputBitStream>(move(constrained_stream)));
     };
 
+    // LF groups and pass groups only write to their own part of the GlobalModular image, so their sections are read
+    // up front and then decoded in parallel.
+    auto decode_groups = [&](u32 first_section_index, u32 group_count, auto const& decode_group) -> ErrorOr<void> {
+        if (frame.num_groups == 1 && frame.frame_header.passes.num_passes == 1) {
+            for (u32 group_index {}; group_index < group_count; ++group_index)
+                TRY(decode_group(stream, group_index));
+            return {};
+        }
+
+        Vector<GroupSection> sections;
+        TRY(sections.try_ensure_capacity(group_count));
+        for (u32 group_index {}; group_index < group_count; ++group_index) {
+            if (stream.align_to_byte_boundary() != 0)
+                return Error::from_string_literal("JPEGXLLoader: Padding bits between sections must all be zeros");
+            auto data = TRY(ByteBuffer::create_uninitialized(frame.toc.entries[first_section_index + group_index]));
+            TRY(stream.read_until_filled(data));
+            sections.unchecked_append({ group_index, move(data), {} });
+        }
+
+        Threading::parallel_for(sections.span(), 1, [&](Span<GroupSection> slice) {
+            for (auto& section : slice) {
+                FixedMemoryStream memory_stream { section.data.bytes() };
+                LittleEndianInputBitStream section_stream { MaybeOwned<Stream>(memory_stream) };
+                if (auto result = decode_group(section_stream, section.group_index); result.is_error())
+                    section.error = result.release_error();
+            }
+        });
+
+        for (auto& section : sections) {
+            if (section.error.has_value())
+                return section.error.release_value();
+        }
+        return {};
+    };
+
     {
         auto lf_stream = TRY(get_stream_for_section(stream, 0));
         frame.lf_global = TRY(read_lf_global(*lf_stream, { frame.width, frame.height }, frame.frame_header, metadata));
     }
 
-    for (u32 i {}; i < frame.num_lf_groups; ++i) {
-        auto lf_stream = TRY(get_stream_for_section(stream, 1 + i));
+    TRY(decode_groups(1, frame.num_lf_groups, [&](LittleEndianInputBitStream& lf_stream, u32 i) {
         // From H.4.1, "The stream index is defined as follows: [...] for ModularLfGroup: 1 + num_lf_groups + LF group index;"
-        TRY(read_lf_group(*lf_stream, {
-                                          .global_modular = frame.lf_global.gmodular,
-                                          .frame_header = frame.frame_header,
-                                          .group_index = i,
-                                          .stream_index = 1 + frame.num_lf_groups + i,
-                                          .bit_depth = bits_per_sample,
+        return read_lf_group(lf_stream, {
+                                            .global_modular = frame.lf_global.gmodular,
+                                            .frame_header = frame.frame_header,
+                                            .group_index = i,
+                                            .stream_index = 1 + frame.num_lf_groups + i,
+                                            .bit_depth = bits_per_sample,
 
-                                      }));
-    }
+                                        });
+    }));
 
     {
         [[maybe_unused]] auto hf_global_stream = TRY(get_stream_for_section(stream, 1 + frame.num_lf_groups));
@@ -2203,13 +2251,11 @@ static ErrorOr<Frame> read_frame(LittleEndianInputBitStream& stream,
     }
 
     for (u32 pass_index {}; pass_index < frame.frame_header.passes.num_passes; ++pass_index) {
-        for (u32 group_index {}; group_index < frame.num_groups; ++group_index) {
-            auto toc_section_number = 2 + frame.num_lf_groups + pass_index * frame.num_groups + group_index;
-            auto pass_stream = TRY(get_stream_for_section(stream, toc_section_number));
-
+        auto first_section_number = 2 + frame.num_lf_groups + pass_index * frame.num_groups;
+        TRY(decode_groups(first_section_number, frame.num_groups, [&](LittleEndianInputBitStream& pass_stream, u32 group_index) {
             // From H.4.1, ModularGroup: 1 + 3 * num_lf_groups + 17 + num_groups * pass index + group index
             u32 stream_index = 1 + 3 * frame.num_lf_groups + 17 + frame.num_groups * pass_index + group_index;
-            TRY(read_pass_group(*pass_stream,
+            return read_pass_group(pass_stream,
                 {
                     .global_modular = frame.lf_global.gmodular,
                     .frame_header = frame.frame_header,
@@ -2217,8 +2263,8 @@ static ErrorOr<Frame> read_frame(LittleEndianInputBitStream& stream,
                     .pass_index = pass_index,
                     .stream_index = stream_index,
                 },
-                { .bit_depth = bits_per_sample }));
-        }
+                { .bit_depth = bits_per_sample });
+        }));
     }
 
     // G.4.2 - Modular group data
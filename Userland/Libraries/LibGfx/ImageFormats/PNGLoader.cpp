@@ -8,6 +8,7 @@
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 #include <AK/MemoryStream.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Vector.h>
 #include <LibCompress/Zlib.h>
 #include <LibGfx/ImageFormats/PNGLoader.h>
@@ -82,11 +83,6 @@ struct EmbeddedICCProfile {
     ReadonlyBytes compressed_data;
 };
 
-struct Scanline {
-    PNG::FilterType filter;
-    ReadonlyBytes data {};
-};
-
 struct [[gnu::packed]] PaletteEntry {
     u8 r;
     u8 g;
@@ -184,9 +180,10 @@ struct PNGLoadingContext {
     bool has_seen_iend { false };
     bool has_seen_idat_chunk { false };
     bool has_seen_actl_chunk_before_idat { false };
+    // The data may end anywhere, so whatever part of the image data is there is decoded.
+    bool may_be_truncated { false };
+    int decoded_rows { 0 };
     bool has_alpha() const { return to_underlying(color_type) & 4 || palette_transparency_data.size() > 0; }
-    Vector<Scanline> scanlines;
-    ByteBuffer unfiltered_data;
     RefPtr<Gfx::Bitmap> bitmap;
     ByteBuffer compressed_data;
     Vector<PaletteEntry> palette_data;
@@ -281,22 +278,71 @@ private:
 
 static ErrorOr<void> process_chunk(Streamer&, PNGLoadingContext& context);
 
-union [[gnu::packed]] Pixel {
-    ARGB32 rgba { 0 };
-    u8 v[4];
-    struct {
-        u8 r;
-        u8 g;
-        u8 b;
-        u8 a;
-    };
-};
-static_assert(AssertSize<Pixel, 4>());
+template<u8 bytes_per_complete_pixel, typename Predictor>
+ALWAYS_INLINE static void unfilter_pixels(Bytes scanline_data, ReadonlyBytes previous_scanlines_data, Predictor predictor)
+{
+    // Each byte is only predicted from the bytes at the same position in the pixels to its left, above it and to its
+    // upper left, so a whole pixel can be unfiltered at once.
+    using AK::SIMD::u8x4;
+    static_assert(bytes_per_complete_pixel <= sizeof(u8x4));
+
+    u8x4 left {};
+    u8x4 upper_left {};
+    for (size_t i = 0; i < scanline_data.size(); i += bytes_per_complete_pixel) {
+        u8x4 pixel {};
+        u8x4 above {};
+        __builtin_memcpy(&pixel, scanline_data.data() + i, bytes_per_complete_pixel);
+        __builtin_memcpy(&above, previous_scanlines_data.data() + i, bytes_per_complete_pixel);
+        pixel += predictor(left, above, upper_left);
+        __builtin_memcpy(scanline_data.data() + i, &pixel, bytes_per_complete_pixel);
+        left = pixel;
+        upper_left = above;
+    }
+}
+
+template<u8 bytes_per_complete_pixel>
+static void unfilter_scanline_by_pixel(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data)
+{
+    using namespace AK::SIMD;
+    switch (filter) {
+    case PNG::FilterType::Sub:
+        unfilter_pixels<bytes_per_complete_pixel>(scanline_data, previous_scanlines_data, [](u8x4 left, u8x4, u8x4) {
+            return left;
+        });
+        break;
+    case PNG::FilterType::Average:
+        unfilter_pixels<bytes_per_complete_pixel>(scanline_data, previous_scanlines_data, [](u8x4 left, u8x4 above, u8x4) {
+            return simd_cast<u8x4>((simd_cast<u16x4>(left) + simd_cast<u16x4>(above)) >> 1);
+        });
+        break;
+    case PNG::FilterType::Paeth:
+        unfilter_pixels<bytes_per_complete_pixel>(scanline_data, previous_scanlines_data, [](u8x4 left, u8x4 above, u8x4 upper_left) {
+            return PNG::paeth_predictor(left, above, upper_left);
+        });
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
 
 void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
 {
     // https://www.w3.org/TR/png-3/#9Filter-types
     // "Filters are applied to bytes, not to pixels, regardless of the bit depth or colour type of the image."
+
+    // OPTIMIZATION: The filters that depend on the previous pixel are done a pixel at a time for 8-bit RGB and RGBA.
+    bool const is_predicted_from_left = filter == PNG::FilterType::Sub || filter == PNG::FilterType::Average || filter == PNG::FilterType::Paeth;
+    if (is_predicted_from_left && scanline_data.size() % bytes_per_complete_pixel == 0) {
+        if (bytes_per_complete_pixel == 3) {
+            unfilter_scanline_by_pixel<3>(filter, scanline_data, previous_scanlines_data);
+            return;
+        }
+        if (bytes_per_complete_pixel == 4) {
+            unfilter_scanline_by_pixel<4>(filter, scanline_data, previous_scanlines_data);
+            return;
+        }
+    }
+
     switch (filter) {
     case PNG::FilterType::None:
         break;
@@ -336,133 +382,87 @@ void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scan
     }
 }
 
+// The functions below convert one unfiltered scanline straight to the BGRA8888 pixels of the bitmap.
+
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_without_alpha(PNGLoadingContext const& context, ReadonlyBytes scanline, ARGB32* pixels)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* gray_values = reinterpret_cast<T const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = gray_values[i];
-            pixel.g = gray_values[i];
-            pixel.b = gray_values[i];
-            pixel.a = 0xff;
-        }
+    auto* gray_values = reinterpret_cast<T const*>(scanline.data());
+    for (int i = 0; i < context.width; ++i) {
+        auto const gray = static_cast<u8>(gray_values[i]);
+        pixels[i] = Color(gray, gray, gray).value();
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_with_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_with_alpha(PNGLoadingContext const& context, ReadonlyBytes scanline, ARGB32* pixels)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* tuples = reinterpret_cast<Tuple<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = tuples[i].gray;
-            pixel.g = tuples[i].gray;
-            pixel.b = tuples[i].gray;
-            pixel.a = tuples[i].a;
-        }
+    auto* tuples = reinterpret_cast<Tuple<T> const*>(scanline.data());
+    for (int i = 0; i < context.width; ++i) {
+        auto const gray = static_cast<u8>(tuples[i].gray);
+        pixels[i] = Color(gray, gray, gray, static_cast<u8>(tuples[i].a)).value();
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_triplets_without_alpha(PNGLoadingContext const& context, ReadonlyBytes scanline, ARGB32* pixels)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            pixel.a = 0xff;
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    int i = 0;
+    if constexpr (IsSame<T, u8>) {
+        // OPTIMIZATION: Shuffle 4 pixels at a time into place. The 16 bytes we load cover 5 1/3 pixels.
+        using namespace AK::SIMD;
+        constexpr u8x16 opaque { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+        for (; i + 6 <= context.width; i += 4) {
+            auto const bytes = load_unaligned<u8x16>(&triplets[i]);
+            store_unaligned(&pixels[i], __builtin_shufflevector(bytes, opaque, 2, 1, 0, 16, 5, 4, 3, 16, 8, 7, 6, 16, 11, 10, 9, 16));
         }
     }
+    for (; i < context.width; ++i)
+        pixels[i] = Color(static_cast<u8>(triplets[i].r), static_cast<u8>(triplets[i].g), static_cast<u8>(triplets[i].b)).value();
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_with_transparency_value(PNGLoadingContext& context, Triplet<T> transparency_value)
+ALWAYS_INLINE static void unpack_triplets_with_transparency_value(PNGLoadingContext const& context, ReadonlyBytes scanline, ARGB32* pixels, Triplet<T> transparency_value)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            if (triplets[i] == transparency_value)
-                pixel.a = 0x00;
-            else
-                pixel.a = 0xff;
-        }
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline.data());
+    for (int i = 0; i < context.width; ++i) {
+        u8 const alpha = triplets[i] == transparency_value ? 0x00 : 0xff;
+        pixels[i] = Color(static_cast<u8>(triplets[i].r), static_cast<u8>(triplets[i].g), static_cast<u8>(triplets[i].b), alpha).value();
     }
 }
 
-NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_quartets(PNGLoadingContext const& context, ReadonlyBytes scanline, ARGB32* pixels)
 {
-    // First unfilter the scanlines:
-
-    // FIXME: Instead of creating a separate buffer for the scanlines that need to be
-    //        mutated, the mutation could be done in place (if the data was non-const).
-    size_t bytes_per_scanline = context.scanlines[0].data.size();
-    size_t bytes_needed_for_all_unfiltered_scanlines = 0;
-    for (int y = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            bytes_needed_for_all_unfiltered_scanlines += bytes_per_scanline;
-        }
-    }
-    context.unfiltered_data = TRY(ByteBuffer::create_uninitialized(bytes_needed_for_all_unfiltered_scanlines));
-
-    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
-    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
-    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
-    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
-    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
-    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
-    u8 bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
-
-    u8 dummy_scanline_bytes[bytes_per_scanline];
-    memset(dummy_scanline_bytes, 0, sizeof(dummy_scanline_bytes));
-    auto previous_scanlines_data = ReadonlyBytes { dummy_scanline_bytes, sizeof(dummy_scanline_bytes) };
-
-    for (int y = 0, data_start = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            auto scanline_data_slice = context.unfiltered_data.bytes().slice(data_start, bytes_per_scanline);
-
-            // Copy the current values over and set the scanline's data to the to-be-mutated slice
-            context.scanlines[y].data.copy_to(scanline_data_slice);
-            context.scanlines[y].data = scanline_data_slice;
-
-            PNGImageDecoderPlugin::unfilter_scanline(context.scanlines[y].filter, scanline_data_slice, previous_scanlines_data, bytes_per_complete_pixel);
-
-            data_start += bytes_per_scanline;
-        }
-        previous_scanlines_data = context.scanlines[y].data;
+    using namespace AK::SIMD;
+    auto* quartets = reinterpret_cast<Quartet<u8> const*>(scanline.data());
+    int i = 0;
+    // OPTIMIZATION: Swap the red and blue channels of 4 pixels at a time.
+    for (; i + 4 <= context.width; i += 4) {
+        auto const bytes = load_unaligned<u8x16>(&quartets[i]);
+        store_unaligned(&pixels[i], __builtin_shufflevector(bytes, bytes, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15));
     }
+    for (; i < context.width; ++i)
+        pixels[i] = Color(quartets[i].r, quartets[i].g, quartets[i].b, quartets[i].a).value();
+}
 
-    // Now unpack the scanlines to RGBA:
+static ErrorOr<void> unpack_scanline(PNGLoadingContext const& context, ReadonlyBytes scanline, ARGB32* pixels)
+{
     switch (context.color_type) {
     case PNG::ColorType::Greyscale:
         if (context.bit_depth == 8) {
-            unpack_grayscale_without_alpha<u8>(context);
+            unpack_grayscale_without_alpha<u8>(context, scanline, pixels);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_without_alpha<u16>(context);
+            unpack_grayscale_without_alpha<u16>(context, scanline, pixels);
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto bit_depth_squared = context.bit_depth * context.bit_depth;
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* gray_values = context.scanlines[y].data.data();
-                for (int x = 0; x < context.width; ++x) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
-                    auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[x];
-                    pixel.r = value * (0xff / bit_depth_squared);
-                    pixel.g = value * (0xff / bit_depth_squared);
-                    pixel.b = value * (0xff / bit_depth_squared);
-                    pixel.a = 0xff;
-                }
+            for (int x = 0; x < context.width; ++x) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
+                auto value = (scanline[x / pixels_per_byte] >> bit_offset) & mask;
+                u8 const gray = value * (0xff / bit_depth_squared);
+                pixels[x] = Color(gray, gray, gray).value();
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -470,9 +470,9 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::GreyscaleWithAlpha:
         if (context.bit_depth == 8) {
-            unpack_grayscale_with_alpha<u8>(context);
+            unpack_grayscale_with_alpha<u8>(context, scanline, pixels);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_with_alpha<u16>(context);
+            unpack_grayscale_with_alpha<u16>(context, scanline, pixels);
         } else {
             VERIFY_NOT_REACHED();
         }
@@ -480,101 +480,67 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     case PNG::ColorType::Truecolor:
         if (context.palette_transparency_data.size() == 6) {
             if (context.bit_depth == 8) {
-                unpack_triplets_with_transparency_value<u8>(context, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
+                unpack_triplets_with_transparency_value<u8>(context, scanline, pixels, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
             } else if (context.bit_depth == 16) {
                 u16 tr = context.palette_transparency_data[0] | context.palette_transparency_data[1] << 8;
                 u16 tg = context.palette_transparency_data[2] | context.palette_transparency_data[3] << 8;
                 u16 tb = context.palette_transparency_data[4] | context.palette_transparency_data[5] << 8;
-                unpack_triplets_with_transparency_value<u16>(context, Triplet<u16> { tr, tg, tb });
+                unpack_triplets_with_transparency_value<u16>(context, scanline, pixels, Triplet<u16> { tr, tg, tb });
             } else {
                 VERIFY_NOT_REACHED();
             }
         } else {
             if (context.bit_depth == 8)
-                unpack_triplets_without_alpha<u8>(context);
+                unpack_triplets_without_alpha<u8>(context, scanline, pixels);
             else if (context.bit_depth == 16)
-                unpack_triplets_without_alpha<u16>(context);
+                unpack_triplets_without_alpha<u16>(context, scanline, pixels);
             else
                 VERIFY_NOT_REACHED();
         }
         break;
     case PNG::ColorType::TruecolorWithAlpha:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                memcpy(context.bitmap->scanline(y), context.scanlines[y].data.data(), context.scanlines[y].data.size());
-            }
+            unpack_quartets(context, scanline, pixels);
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* quartets = reinterpret_cast<Quartet<u16> const*>(context.scanlines[y].data.data());
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    pixel.r = quartets[i].r & 0xFF;
-                    pixel.g = quartets[i].g & 0xFF;
-                    pixel.b = quartets[i].b & 0xFF;
-                    pixel.a = quartets[i].a & 0xFF;
-                }
-            }
+            auto* quartets = reinterpret_cast<Quartet<u16> const*>(scanline.data());
+            for (int i = 0; i < context.width; ++i)
+                pixels[i] = Color(quartets[i].r & 0xFF, quartets[i].g & 0xFF, quartets[i].b & 0xFF, quartets[i].a & 0xFF).value();
         } else {
             VERIFY_NOT_REACHED();
         }
         break;
-    case PNG::ColorType::IndexedColor:
+    case PNG::ColorType::IndexedColor: {
+        auto const unpack_palette_index = [&](size_t palette_index) -> ErrorOr<ARGB32> {
+            if (palette_index >= context.palette_data.size())
+                return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+            auto& color = context.palette_data.at(palette_index);
+            auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
+                ? context.palette_transparency_data[palette_index]
+                : 0xff;
+            return Color(color.r, color.g, color.b, transparency).value();
+        };
+
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_index = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if (palette_index[i] >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at((int)palette_index[i]);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
-                        ? context.palette_transparency_data[palette_index[i]]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
-            }
+            for (int i = 0; i < context.width; ++i)
+                pixels[i] = TRY(unpack_palette_index(scanline[i]));
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_indices = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
-                    auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if ((size_t)palette_index >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at(palette_index);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
-                        ? context.palette_transparency_data[palette_index]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            for (int i = 0; i < context.width; ++i) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
+                auto palette_index = (scanline[i / pixels_per_byte] >> bit_offset) & mask;
+                pixels[i] = TRY(unpack_palette_index(palette_index));
             }
         } else {
             VERIFY_NOT_REACHED();
         }
         break;
+    }
     default:
         VERIFY_NOT_REACHED();
         break;
     }
 
-    // Swap r and b values:
-    for (int y = 0; y < context.height; ++y) {
-        auto* pixels = (Pixel*)context.bitmap->scanline(y);
-        for (int i = 0; i < context.bitmap->width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
-        }
-    }
-
     return {};
 }
 
@@ -674,6 +640,24 @@ static bool decode_png_animation_data_chunks(PNGLoadingContext& context, u32 req
     return requested_animation_frame_index <= context.last_completed_animation_frame_index.value();
 }
 
+static void append_data_of_truncated_idat_chunk(PNGLoadingContext& context)
+{
+    // If the data ends in the middle of an IDAT chunk, the part of it that is there still continues the image data.
+    size_t data_remaining = context.data_size - (context.data_current_ptr - context.data);
+    Streamer streamer(context.data_current_ptr, data_remaining);
+
+    u32 chunk_size;
+    Array<u8, 4> chunk_type_buffer;
+    if (!streamer.read(chunk_size) || !streamer.read_bytes(chunk_type_buffer.data(), chunk_type_buffer.size()))
+        return;
+    if (StringView { chunk_type_buffer.span() } != "IDAT"sv)
+        return;
+
+    ReadonlyBytes chunk_data;
+    if (streamer.wrap_bytes(chunk_data, min<size_t>(chunk_size, data_remaining - 8)))
+        context.compressed_data.append(chunk_data);
+}
+
 static bool decode_png_chunks(PNGLoadingContext& context)
 {
     VERIFY(context.state >= PNGLoadingContext::IHDRDecoded);
@@ -696,40 +680,71 @@ static bool decode_png_chunks(PNGLoadingContext& context)
         context.data_current_ptr = streamer.current_data_ptr();
     }
 
+    if (context.may_be_truncated)
+        append_data_of_truncated_idat_chunk(context);
+
     context.state = PNGLoadingContext::State::ChunksDecoded;
     return true;
 }
 
-static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
+static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, Stream& decompressed_stream)
 {
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
+    // The scanlines are read from the decompressor one at a time, and unpacked as soon as they are unfiltered, so only
+    // the current scanline and the one above it are kept around.
+    auto row_size = context.compute_row_size_for_width(context.width);
+    if (row_size.has_overflow())
+        return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
+
+    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
+    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
+    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
+    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
+    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
+    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
+    u8 bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
+
+    auto previous_scanline = TRY(ByteBuffer::create_zeroed(row_size.value()));
+    auto scanline = TRY(ByteBuffer::create_uninitialized(row_size.value()));
+
+    context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
 
     for (int y = 0; y < context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
+        // The scanlines that were decoded before the data ran out are kept.
+        auto stop_if_truncated = [&] {
+            if (!context.may_be_truncated)
+                return false;
+            context.decoded_rows = y;
+            return true;
+        };
+
+        auto filter_byte_or_error = decompressed_stream.read_value<u8>();
+        if (filter_byte_or_error.is_error()) {
+            if (stop_if_truncated())
+                return {};
             context.state = PNGLoadingContext::State::Error;
             return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
         }
 
-        if (filter_byte > 4) {
+        auto filter_or_error = PNG::filter_type(filter_byte_or_error.value());
+        if (filter_or_error.is_error()) {
             context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
+            return filter_or_error.release_error();
         }
 
-        context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = context.scanlines.last().data;
-        auto row_size = context.compute_row_size_for_width(context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
-
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
+        if (decompressed_stream.read_until_filled(scanline).is_error()) {
+            if (stop_if_truncated())
+                return {};
             context.state = PNGLoadingContext::State::Error;
             return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
         }
+
+        PNGImageDecoderPlugin::unfilter_scanline(filter_or_error.value(), scanline, previous_scanline, bytes_per_complete_pixel);
+        TRY(unpack_scanline(context, scanline, context.bitmap->scanline(y)));
+        swap(scanline, previous_scanline);
     }
 
-    context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
-    return unfilter(context);
+    context.decoded_rows = context.height;
+    return {};
 }
 
 static int adam7_height(PNGLoadingContext& context, int pass)
@@ -782,7 +797,7 @@ static int adam7_startx[8] = { 0, 0, 4, 0, 2, 0, 1, 0 };
 static int adam7_stepy[8] = { 1, 8, 8, 8, 4, 4, 2, 2 };
 static int adam7_stepx[8] = { 1, 8, 8, 4, 4, 2, 2, 1 };
 
-static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, int pass)
+static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Stream& decompressed_stream, int pass)
 {
     auto subimage_context = context.create_subimage_context(adam7_width(context, pass), adam7_height(context, pass));
 
@@ -790,33 +805,11 @@ static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& str
     if (!subimage_context.width || !subimage_context.height)
         return {};
 
-    for (int y = 0; y < subimage_context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-
-        if (filter_byte > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
-
-        subimage_context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = subimage_context.scanlines.last().data;
-
-        auto row_size = context.compute_row_size_for_width(subimage_context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
+    if (auto result = decode_png_bitmap_simple(subimage_context, decompressed_stream); result.is_error()) {
+        context.state = PNGLoadingContext::State::Error;
+        return result.release_error();
     }
 
-    subimage_context.bitmap = TRY(Bitmap::create(context.bitmap->format(), { subimage_context.width, subimage_context.height }));
-    TRY(unfilter(subimage_context));
-
     // Copy the subimage data into the main image according to the pass pattern
     for (int y = 0, dy = adam7_starty[pass]; y < subimage_context.height && dy < context.height; ++y, dy += adam7_stepy[pass]) {
         for (int x = 0, dx = adam7_startx[pass]; x < subimage_context.width && dx < context.width; ++x, dx += adam7_stepx[pass]) {
@@ -826,12 +819,13 @@ static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& str
     return {};
 }
 
-static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
+static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, Stream& decompressed_stream)
 {
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
     context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
+    // The passes are decoded on their own, so an interlaced image that was cut off fails to decode.
     for (int pass = 1; pass <= 7; ++pass)
-        TRY(decode_adam7_pass(context, streamer, pass));
+        TRY(decode_adam7_pass(context, decompressed_stream, pass));
+    context.decoded_rows = context.height;
     return {};
 }
 
@@ -848,6 +842,32 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
     if (context.color_type == PNG::ColorType::IndexedColor && context.palette_data.is_empty())
         return Error::from_string_literal("PNGImageDecoderPlugin: Didn't see a PLTE chunk for a palletized image, or it was empty.");
 
+    if (context.interlace_method != PngInterlaceMethod::Null && context.interlace_method != PngInterlaceMethod::Adam7) {
+        context.state = PNGLoadingContext::State::Error;
+        return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
+    }
+
+    auto decode_from = [&](Stream& decompressed_stream) -> ErrorOr<void> {
+        if (context.interlace_method == PngInterlaceMethod::Null)
+            return decode_png_bitmap_simple(context, decompressed_stream);
+        return decode_png_adam7(context, decompressed_stream);
+    };
+
+    // With all of the image data at hand, it is a lot faster to decompress it in one go than through the stream
+    // interface. That only works for complete zlib streams though, so anything else (like an image whose last IDAT
+    // chunks are missing) still goes through the decompressor stream, which decodes as much of it as there is.
+    if (!context.may_be_truncated) {
+        auto row_size = context.compute_row_size_for_width(context.width);
+        size_t expected_size = row_size.has_overflow() ? 0 : (static_cast<size_t>(row_size.value()) + 1) * context.height;
+        if (auto decompressed_data = Compress::ZlibDecompressor::decompress_all(context.compressed_data, expected_size); !decompressed_data.is_error()) {
+            FixedMemoryStream decompressed_stream { decompressed_data.value().bytes() };
+            TRY(decode_from(decompressed_stream));
+            context.compressed_data.clear();
+            context.state = PNGLoadingContext::State::BitmapDecoded;
+            return {};
+        }
+    }
+
     auto compressed_data_stream = make<FixedMemoryStream>(context.compressed_data.span());
     auto decompressor_or_error = Compress::ZlibDecompressor::create(move(compressed_data_stream));
     if (decompressor_or_error.is_error()) {
@@ -855,27 +875,9 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
         return decompressor_or_error.release_error();
     }
     auto decompressor = decompressor_or_error.release_value();
-    auto result_or_error = decompressor->read_until_eof();
-    if (result_or_error.is_error()) {
-        context.state = PNGLoadingContext::State::Error;
-        return result_or_error.release_error();
-    }
-    auto decompression_buffer = result_or_error.release_value();
-    context.compressed_data.clear();
-
-    context.scanlines.ensure_capacity(context.height);
-    switch (context.interlace_method) {
-    case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(context, decompression_buffer));
-        break;
-    case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(context, decompression_buffer));
-        break;
-    default:
-        context.state = PNGLoadingContext::State::Error;
-        return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
-    }
+    TRY(decode_from(*decompressor));
 
+    context.compressed_data.clear();
     context.state = PNGLoadingContext::State::BitmapDecoded;
     return {};
 }
@@ -892,16 +894,13 @@ static ErrorOr<RefPtr<Bitmap>> decode_png_animation_frame_bitmap(PNGLoadingConte
 
     auto compressed_data_stream = make<FixedMemoryStream>(animation_frame.compressed_data.span());
     auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream)));
-    auto decompression_buffer = TRY(decompressor->read_until_eof());
-    frame_context.compressed_data.clear();
 
-    frame_context.scanlines.ensure_capacity(frame_context.height);
     switch (context.interlace_method) {
     case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(frame_context, decompression_buffer));
+        TRY(decode_png_bitmap_simple(frame_context, *decompressor));
         break;
     case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(frame_context, decompression_buffer));
+        TRY(decode_png_adam7(frame_context, *decompressor));
         break;
     default:
         return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
@@ -1388,6 +1387,16 @@ static ErrorOr<RefPtr<Bitmap>> render_animation_frame(AnimationFrame const& prev
     return rendered_bitmap;
 }
 
+ErrorOr<PartialFrameDescriptor> PNGImageDecoderPlugin::partial_frame()
+{
+    if (m_context->state == PNGLoadingContext::State::Error)
+        return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+
+    m_context->may_be_truncated = true;
+    TRY(decode_png_bitmap(*m_context));
+    return PartialFrameDescriptor { m_context->bitmap, m_context->decoded_rows };
+}
+
 ErrorOr<ImageFrameDescriptor> PNGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
 {
     if (m_context->state == PNGLoadingContext::State::Error)
@@ -16,6 +16,7 @@
 #include <LibCrypto/Checksum/CRC32.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/PNGWriter.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 namespace Gfx {
 
@@ -215,158 +216,210 @@ union [[gnu::packed]] Pixel {
 static_assert(AssertSize<Pixel, 4>());
 
 template<bool include_alpha, bool include_colors>
-static ErrorOr<void> add_image_data_to_chunk_impl(Gfx::Bitmap const& bitmap, PNGChunk& png_chunk, Compress::ZlibCompressionLevel compression_level)
+static void filter_row(Gfx::Bitmap const& bitmap, int y, Pixel const* dummy_scanline, u8* filtered_row)
 {
-    ByteBuffer uncompressed_block_data;
-    TRY(uncompressed_block_data.try_ensure_capacity(bitmap.size_in_bytes() + bitmap.height()));
-
-    auto dummy_scanline = TRY(FixedArray<Pixel>::create(bitmap.width()));
-    auto const* scanline_minus_1 = dummy_scanline.data();
-
-    for (int y = 0; y < bitmap.height(); ++y) {
-        auto* scanline = reinterpret_cast<Pixel const*>(bitmap.scanline(y));
-
-        struct Filter {
-            PNG::FilterType type;
-            AK::SIMD::u32x4 sum { 0, 0, 0, 0 };
-
-            AK::SIMD::u8x4 predict(AK::SIMD::u8x4 pixel, AK::SIMD::u8x4 pixel_x_minus_1, AK::SIMD::u8x4 pixel_y_minus_1, AK::SIMD::u8x4 pixel_xy_minus_1)
-            {
-                switch (type) {
-                case PNG::FilterType::None:
-                    return pixel;
-                case PNG::FilterType::Sub:
-                    return pixel - pixel_x_minus_1;
-                case PNG::FilterType::Up:
-                    return pixel - pixel_y_minus_1;
-                case PNG::FilterType::Average: {
-                    // The sum Orig(a) + Orig(b) shall be performed without overflow (using at least nine-bit arithmetic).
-                    auto sum = AK::SIMD::simd_cast<AK::SIMD::u16x4>(pixel_x_minus_1) + AK::SIMD::simd_cast<AK::SIMD::u16x4>(pixel_y_minus_1);
-                    auto average = AK::SIMD::simd_cast<AK::SIMD::u8x4>(sum / 2);
-                    return pixel - average;
-                }
-                case PNG::FilterType::Paeth:
-                    return pixel - PNG::paeth_predictor(pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1);
-                }
-                VERIFY_NOT_REACHED();
+    auto* scanline = reinterpret_cast<Pixel const*>(bitmap.scanline(y));
+    auto const* scanline_minus_1 = y == 0 ? dummy_scanline : reinterpret_cast<Pixel const*>(bitmap.scanline(y - 1));
+
+    struct Filter {
+        PNG::FilterType type;
+        AK::SIMD::u32x4 sum { 0, 0, 0, 0 };
+
+        AK::SIMD::u8x4 predict(AK::SIMD::u8x4 pixel, AK::SIMD::u8x4 pixel_x_minus_1, AK::SIMD::u8x4 pixel_y_minus_1, AK::SIMD::u8x4 pixel_xy_minus_1)
+        {
+            switch (type) {
+            case PNG::FilterType::None:
+                return pixel;
+            case PNG::FilterType::Sub:
+                return pixel - pixel_x_minus_1;
+            case PNG::FilterType::Up:
+                return pixel - pixel_y_minus_1;
+            case PNG::FilterType::Average: {
+                // The sum Orig(a) + Orig(b) shall be performed without overflow (using at least nine-bit arithmetic).
+                auto sum = AK::SIMD::simd_cast<AK::SIMD::u16x4>(pixel_x_minus_1) + AK::SIMD::simd_cast<AK::SIMD::u16x4>(pixel_y_minus_1);
+                auto average = AK::SIMD::simd_cast<AK::SIMD::u8x4>(sum / 2);
+                return pixel - average;
             }
-
-            void append(AK::SIMD::u8x4 simd)
-            {
-                using namespace AK::SIMD;
-                sum += simd_cast<u32x4>(abs(simd_cast<i32x4>(simd_cast<i8x4>(simd))));
+            case PNG::FilterType::Paeth:
+                return pixel - PNG::paeth_predictor(pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1);
             }
+            VERIFY_NOT_REACHED();
+        }
 
-            u32 sum_of_abs_values() const
-            {
-                u32 result = sum[0];
-                if constexpr (include_colors)
-                    result += sum[1] + sum[2];
-                if constexpr (include_alpha)
-                    result += sum[3];
-                return result;
-            }
-        };
+        void append(AK::SIMD::u8x4 simd)
+        {
+            using namespace AK::SIMD;
+            sum += simd_cast<u32x4>(abs(simd_cast<i32x4>(simd_cast<i8x4>(simd))));
+        }
 
-        Filter none_filter { .type = PNG::FilterType::None };
-        Filter sub_filter { .type = PNG::FilterType::Sub };
-        Filter up_filter { .type = PNG::FilterType::Up };
-        Filter average_filter { .type = PNG::FilterType::Average };
-        Filter paeth_filter { .type = PNG::FilterType::Paeth };
+        u32 sum_of_abs_values() const
+        {
+            u32 result = sum[0];
+            if constexpr (include_colors)
+                result += sum[1] + sum[2];
+            if constexpr (include_alpha)
+                result += sum[3];
+            return result;
+        }
+    };
 
-        auto pixel_x_minus_1 = Pixel::argb32_to_simd(dummy_scanline[0]);
-        auto pixel_xy_minus_1 = Pixel::argb32_to_simd(dummy_scanline[0]);
+    Filter none_filter { .type = PNG::FilterType::None };
+    Filter sub_filter { .type = PNG::FilterType::Sub };
+    Filter up_filter { .type = PNG::FilterType::Up };
+    Filter average_filter { .type = PNG::FilterType::Average };
+    Filter paeth_filter { .type = PNG::FilterType::Paeth };
 
-        for (int x = 0; x < bitmap.width(); ++x) {
-            auto pixel = Pixel::argb32_to_simd(scanline[x]);
-            auto pixel_y_minus_1 = Pixel::argb32_to_simd(scanline_minus_1[x]);
+    auto pixel_x_minus_1 = Pixel::argb32_to_simd(dummy_scanline[0]);
+    auto pixel_xy_minus_1 = Pixel::argb32_to_simd(dummy_scanline[0]);
 
-            none_filter.append(none_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1));
-            sub_filter.append(sub_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1));
-            up_filter.append(up_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1));
-            average_filter.append(average_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1));
-            paeth_filter.append(paeth_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1));
+    for (int x = 0; x < bitmap.width(); ++x) {
+        auto pixel = Pixel::argb32_to_simd(scanline[x]);
+        auto pixel_y_minus_1 = Pixel::argb32_to_simd(scanline_minus_1[x]);
 
-            pixel_x_minus_1 = pixel;
-            pixel_xy_minus_1 = pixel_y_minus_1;
-        }
+        none_filter.append(none_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1));
+        sub_filter.append(sub_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1));
+        up_filter.append(up_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1));
+        average_filter.append(average_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1));
+        paeth_filter.append(paeth_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1));
 
-        // 12.8 Filter selection: https://www.w3.org/TR/PNG/#12Filter-selection
-        // For best compression of truecolour and greyscale images, the recommended approach
-        // is adaptive filtering in which a filter is chosen for each scanline.
-        // The following simple heuristic has performed well in early tests:
-        // compute the output scanline using all five filters, and select the filter that gives the smallest sum of absolute values of outputs.
-        // (Consider the output bytes as signed differences for this test.)
-        Filter& best_filter = none_filter;
-        if (best_filter.sum_of_abs_values() > sub_filter.sum_of_abs_values())
-            best_filter = sub_filter;
-        if (best_filter.sum_of_abs_values() > up_filter.sum_of_abs_values())
-            best_filter = up_filter;
-        if (best_filter.sum_of_abs_values() > average_filter.sum_of_abs_values())
-            best_filter = average_filter;
-        if (best_filter.sum_of_abs_values() > paeth_filter.sum_of_abs_values())
-            best_filter = paeth_filter;
-
-        TRY(uncompressed_block_data.try_append(to_underlying(best_filter.type)));
-
-        pixel_x_minus_1 = Pixel::argb32_to_simd(dummy_scanline[0]);
-        pixel_xy_minus_1 = Pixel::argb32_to_simd(dummy_scanline[0]);
-
-        for (int x = 0; x < bitmap.width(); ++x) {
-            auto pixel = Pixel::argb32_to_simd(scanline[x]);
-            auto pixel_y_minus_1 = Pixel::argb32_to_simd(scanline_minus_1[x]);
-
-            auto predicted_pixel = best_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1);
-            if constexpr (include_colors) {
-                TRY(uncompressed_block_data.try_append(predicted_pixel[2]));
-                TRY(uncompressed_block_data.try_append(predicted_pixel[1]));
-            }
-            TRY(uncompressed_block_data.try_append(predicted_pixel[0]));
-            if constexpr (include_alpha)
-                TRY(uncompressed_block_data.try_append(predicted_pixel[3]));
+        pixel_x_minus_1 = pixel;
+        pixel_xy_minus_1 = pixel_y_minus_1;
+    }
 
-            pixel_x_minus_1 = pixel;
-            pixel_xy_minus_1 = pixel_y_minus_1;
+    // 12.8 Filter selection: https://www.w3.org/TR/PNG/#12Filter-selection
+    // For best compression of truecolour and greyscale images, the recommended approach
+    // is adaptive filtering in which a filter is chosen for each scanline.
+    // The following simple heuristic has performed well in early tests:
+    // compute the output scanline using all five filters, and select the filter that gives the smallest sum of absolute values of outputs.
+    // (Consider the output bytes as signed differences for this test.)
+    Filter& best_filter = none_filter;
+    if (best_filter.sum_of_abs_values() > sub_filter.sum_of_abs_values())
+        best_filter = sub_filter;
+    if (best_filter.sum_of_abs_values() > up_filter.sum_of_abs_values())
+        best_filter = up_filter;
+    if (best_filter.sum_of_abs_values() > average_filter.sum_of_abs_values())
+        best_filter = average_filter;
+    if (best_filter.sum_of_abs_values() > paeth_filter.sum_of_abs_values())
+        best_filter = paeth_filter;
+
+    *filtered_row++ = to_underlying(best_filter.type);
+
+    pixel_x_minus_1 = Pixel::argb32_to_simd(dummy_scanline[0]);
+    pixel_xy_minus_1 = Pixel::argb32_to_simd(dummy_scanline[0]);
+
+    for (int x = 0; x < bitmap.width(); ++x) {
+        auto pixel = Pixel::argb32_to_simd(scanline[x]);
+        auto pixel_y_minus_1 = Pixel::argb32_to_simd(scanline_minus_1[x]);
+
+        auto predicted_pixel = best_filter.predict(pixel, pixel_x_minus_1, pixel_y_minus_1, pixel_xy_minus_1);
+        if constexpr (include_colors) {
+            *filtered_row++ = predicted_pixel[2];
+            *filtered_row++ = predicted_pixel[1];
         }
+        *filtered_row++ = predicted_pixel[0];
+        if constexpr (include_alpha)
+            *filtered_row++ = predicted_pixel[3];
 
-        scanline_minus_1 = scanline;
+        pixel_x_minus_1 = pixel;
+        pixel_xy_minus_1 = pixel_y_minus_1;
     }
+}
 
-    return png_chunk.compress_and_add(uncompressed_block_data, compression_level);
+template<bool include_alpha, bool include_colors>
+static ErrorOr<void> filter_image_data(Gfx::Bitmap const& bitmap, ByteBuffer& filtered_data)
+{
+    constexpr size_t bytes_per_pixel = (include_colors ? 3 : 1) + (include_alpha ? 1 : 0);
+    size_t const filtered_row_size = 1 + bitmap.width() * bytes_per_pixel;
+    TRY(filtered_data.try_resize(filtered_row_size * bitmap.height()));
+
+    auto dummy_scanline = TRY(FixedArray<Pixel>::create(bitmap.width()));
+
+    // The filters only look at the unfiltered rows, so every row can be filtered on its own.
+    Vector<int> rows;
+    TRY(rows.try_ensure_capacity(bitmap.height()));
+    for (int y = 0; y < bitmap.height(); ++y)
+        rows.unchecked_append(y);
+
+    Threading::parallel_for(rows.span(), [&](Span<int> slice) {
+        for (int y : slice)
+            filter_row<include_alpha, include_colors>(bitmap, y, dummy_scanline.data(), filtered_data.offset_pointer(y * filtered_row_size));
+    });
+
+    return {};
 }
 
-static ErrorOr<void> add_image_data_to_chunk(Gfx::Bitmap const& bitmap, PNG::ColorType color_type, PNGChunk& png_chunk, Compress::ZlibCompressionLevel compression_level)
+static ErrorOr<void> filter_image_data(Gfx::Bitmap const& bitmap, PNG::ColorType color_type, ByteBuffer& filtered_data)
 {
     switch (color_type) {
     case PNG::ColorType::Greyscale:
-        return add_image_data_to_chunk_impl<false, false>(bitmap, png_chunk, compression_level);
+        return filter_image_data<false, false>(bitmap, filtered_data);
     case PNG::ColorType::Truecolor:
-        return add_image_data_to_chunk_impl<false, true>(bitmap, png_chunk, compression_level);
+        return filter_image_data<false, true>(bitmap, filtered_data);
     case PNG::ColorType::IndexedColor:
         VERIFY_NOT_REACHED();
     case PNG::ColorType::GreyscaleWithAlpha:
-        return add_image_data_to_chunk_impl<true, false>(bitmap, png_chunk, compression_level);
+        return filter_image_data<true, false>(bitmap, filtered_data);
     case PNG::ColorType::TruecolorWithAlpha:
-        return add_image_data_to_chunk_impl<true, true>(bitmap, png_chunk, compression_level);
+        return filter_image_data<true, true>(bitmap, filtered_data);
     }
     VERIFY_NOT_REACHED();
 }
 
-ErrorOr<void> PNGWriter::add_fdAT_chunk(Gfx::Bitmap const& bitmap, PNG::ColorType color_type, u32 sequence_number, Compress::ZlibCompressionLevel compression_level)
+// Chunks of this size still compress almost as well as the whole image data, while large images are split into
+// enough of them to keep all threads busy. The size doesn't depend on the number of threads, so the output doesn't either.
+static constexpr size_t parallel_compression_chunk_size = 256 * KiB;
+
+static ErrorOr<ByteBuffer> compress_in_parallel(ReadonlyBytes data, Compress::ZlibCompressionLevel compression_level)
+{
+    struct Chunk {
+        ReadonlyBytes data;
+        bool is_last { false };
+        ErrorOr<ByteBuffer> compressed_data { ByteBuffer {} };
+    };
+
+    Vector<Chunk> chunks;
+    for (size_t offset = 0; offset < data.size(); offset += parallel_compression_chunk_size) {
+        auto chunk_data = data.slice(offset, min(parallel_compression_chunk_size, data.size() - offset));
+        TRY(chunks.try_append({ chunk_data, offset + chunk_data.size() == data.size() }));
+    }
+
+    Threading::parallel_for(chunks.span(), 1, [&](Span<Chunk> slice) {
+        for (auto& chunk : slice)
+            chunk.compressed_data = Compress::ZlibCompressor::compress_chunk(chunk.data, chunk.is_last, compression_level);
+    });
+
+    Vector<ByteBuffer> compressed_chunks;
+    TRY(compressed_chunks.try_ensure_capacity(chunks.size()));
+    for (auto& chunk : chunks)
+        compressed_chunks.unchecked_append(TRY(move(chunk.compressed_data)));
+
+    return Compress::ZlibCompressor::create_from_compressed_chunks(compressed_chunks, data, compression_level);
+}
+
+ErrorOr<void> PNGWriter::add_image_data_to_chunk(Gfx::Bitmap const& bitmap, PNG::ColorType color_type, PNGChunk& png_chunk, Options const& options)
+{
+    TRY(filter_image_data(bitmap, color_type, m_filtered_data));
+
+    if (options.compress_in_parallel && m_filtered_data.size() > parallel_compression_chunk_size)
+        return png_chunk.add(TRY(compress_in_parallel(m_filtered_data, options.compression_level)));
+    return png_chunk.compress_and_add(m_filtered_data, options.compression_level);
+}
+
+ErrorOr<void> PNGWriter::add_fdAT_chunk(Gfx::Bitmap const& bitmap, PNG::ColorType color_type, u32 sequence_number, Options const& options)
 {
     // https://www.w3.org/TR/png/#fdAT-chunk
     PNGChunk png_chunk { "fdAT"_string };
     TRY(png_chunk.reserve(bitmap.size_in_bytes() + 4));
     TRY(png_chunk.add_as_big_endian(sequence_number));
-    TRY(add_image_data_to_chunk(bitmap, color_type, png_chunk, compression_level));
+    TRY(add_image_data_to_chunk(bitmap, color_type, png_chunk, options));
     return add_chunk(png_chunk);
 }
 
-ErrorOr<void> PNGWriter::add_IDAT_chunk(Gfx::Bitmap const& bitmap, PNG::ColorType color_type, Compress::ZlibCompressionLevel compression_level)
+ErrorOr<void> PNGWriter::add_IDAT_chunk(Gfx::Bitmap const& bitmap, PNG::ColorType color_type, Options const& options)
 {
     PNGChunk png_chunk { "IDAT"_string };
     TRY(png_chunk.reserve(bitmap.size_in_bytes()));
-    TRY(add_image_data_to_chunk(bitmap, color_type, png_chunk, compression_level));
+    TRY(add_image_data_to_chunk(bitmap, color_type, png_chunk, options));
     return add_chunk(png_chunk);
 }
 
@@ -410,7 +463,7 @@ ErrorOr<void> PNGWriter::encode(Stream& stream, Bitmap const& bitmap, Options co
     TRY(writer.add_IHDR_chunk(bitmap.width(), bitmap.height(), 8, color_type, 0, 0, 0));
     if (options.icc_data.has_value())
         TRY(writer.add_iCCP_chunk(options.icc_data.value(), options.compression_level));
-    TRY(writer.add_IDAT_chunk(bitmap, color_type, options.compression_level));
+    TRY(writer.add_IDAT_chunk(bitmap, color_type, options));
     TRY(writer.add_IEND_chunk());
     return {};
 }
@@ -503,9 +556,9 @@ ErrorOr<void> PNGAnimationWriter::add_frame(Bitmap& bitmap, int duration_ms, Int
     m_sequence_number++;
 
     if (is_first_frame) {
-        TRY(m_writer.add_IDAT_chunk(bitmap, PNG::ColorType::TruecolorWithAlpha, m_options.compression_level));
+        TRY(m_writer.add_IDAT_chunk(bitmap, PNG::ColorType::TruecolorWithAlpha, m_options));
     } else {
-        TRY(m_writer.add_fdAT_chunk(bitmap, PNG::ColorType::TruecolorWithAlpha, m_sequence_number, m_options.compression_level));
+        TRY(m_writer.add_fdAT_chunk(bitmap, PNG::ColorType::TruecolorWithAlpha, m_sequence_number, m_options));
         m_sequence_number++;
     }
 
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/Optional.h>
 #include <AK/Vector.h>
 #include <LibCompress/Zlib.h>
@@ -23,6 +24,10 @@ class PNGChunk;
 struct PNGWriterOptions {
     Compress::ZlibCompressionLevel compression_level { Compress::ZlibCompressionLevel::Default };
 
+    // Compresses large images in independent chunks on multiple threads. This is a lot faster, but the output is
+    // slightly larger, since the chunks can't refer back to each other.
+    bool compress_in_parallel { false };
+
     bool force_alpha { false };
 
     // Data for the iCCP chunk.
@@ -51,11 +56,15 @@ private:
     ErrorOr<void> add_png_header();
     ErrorOr<void> add_acTL_chunk(u32 num_frames, u32 loop_count);
     ErrorOr<void> add_fcTL_chunk(fcTLData const& data);
-    ErrorOr<void> add_fdAT_chunk(Gfx::Bitmap const&, PNG::ColorType, u32 sequence_number, Compress::ZlibCompressionLevel);
+    ErrorOr<void> add_fdAT_chunk(Gfx::Bitmap const&, PNG::ColorType, u32 sequence_number, Options const&);
     ErrorOr<void> add_IHDR_chunk(u32 width, u32 height, u8 bit_depth, PNG::ColorType color_type, u8 compression_method, u8 filter_method, u8 interlace_method);
     ErrorOr<void> add_iCCP_chunk(ReadonlyBytes icc_data, Compress::ZlibCompressionLevel);
-    ErrorOr<void> add_IDAT_chunk(Gfx::Bitmap const&, PNG::ColorType, Compress::ZlibCompressionLevel);
+    ErrorOr<void> add_IDAT_chunk(Gfx::Bitmap const&, PNG::ColorType, Options const&);
     ErrorOr<void> add_IEND_chunk();
+    ErrorOr<void> add_image_data_to_chunk(Gfx::Bitmap const&, PNG::ColorType, PNGChunk&, Options const&);
+
+    // This is kept across the frames of an animation, so that it only has to be allocated once.
+    ByteBuffer m_filtered_data;
 };
 
 }
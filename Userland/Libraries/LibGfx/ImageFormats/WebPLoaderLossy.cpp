@@ -8,10 +8,15 @@
 #include <AK/Endian.h>
 #include <AK/Format.h>
 #include <AK/MemoryStream.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
+#include <AK/ScopeGuard.h>
 #include <AK/Vector.h>
 #include <LibGfx/ImageFormats/BooleanDecoder.h>
 #include <LibGfx/ImageFormats/WebPLoaderLossy.h>
 #include <LibGfx/ImageFormats/WebPLoaderLossyTables.h>
+#include <LibThreading/WorkStealingThreadPool.h>
 
 // Lossy format: https://datatracker.ietf.org/doc/html/rfc6386
 
@@ -1040,19 +1045,70 @@ void predict_y_subblock(Bytes y_prediction, IntraBlockMode mode, int x, int y, R
     }
 }
 
+// One pass of short_idct4x4llm_c(), on four columns at once.
+ALWAYS_INLINE static void inverse_dct_1d(AK::SIMD::i32x4& x0, AK::SIMD::i32x4& x1, AK::SIMD::i32x4& x2, AK::SIMD::i32x4& x3)
+{
+    using AK::SIMD::i32x4;
+
+    static constexpr int cospi8sqrt2minus1 = 20091;
+    static constexpr int sinpi8sqrt2 = 35468;
+
+    i32x4 a1 = x0 + x2;
+    i32x4 b1 = x0 - x2;
+    i32x4 c1 = ((x1 * sinpi8sqrt2) >> 16) - (x3 + ((x3 * cospi8sqrt2minus1) >> 16));
+    i32x4 d1 = (x1 + ((x1 * cospi8sqrt2minus1) >> 16)) + ((x3 * sinpi8sqrt2) >> 16);
+
+    x0 = a1 + d1;
+    x1 = b1 + c1;
+    x2 = b1 - c1;
+    x3 = a1 - d1;
+}
+
+ALWAYS_INLINE static void transpose_4x4(AK::SIMD::i32x4& x0, AK::SIMD::i32x4& x1, AK::SIMD::i32x4& x2, AK::SIMD::i32x4& x3)
+{
+    AK::SIMD::i32x4 r0 { x0[0], x1[0], x2[0], x3[0] };
+    AK::SIMD::i32x4 r1 { x0[1], x1[1], x2[1], x3[1] };
+    AK::SIMD::i32x4 r2 { x0[2], x1[2], x2[2], x3[2] };
+    AK::SIMD::i32x4 r3 { x0[3], x1[3], x2[3], x3[3] };
+    x0 = r0;
+    x1 = r1;
+    x2 = r2;
+    x3 = r3;
+}
+
+// Values are stored as i16 between the passes of short_idct4x4llm_c(), so they are wrapped the same way here.
+ALWAYS_INLINE static AK::SIMD::i32x4 wrap_to_i16(AK::SIMD::i32x4 v)
+{
+    return AK::SIMD::simd_cast<AK::SIMD::i32x4>(AK::SIMD::simd_cast<AK::SIMD::i16x4>(v));
+}
+
 template<int N>
 void add_idct_to_prediction(Bytes prediction, Coefficients coefficients, int x, int y)
 {
-    Coefficients idct_output;
-    short_idct4x4llm_c(coefficients, idct_output, 4 * sizeof(i16));
+    using namespace AK::SIMD;
+
+    // https://datatracker.ietf.org/doc/html/rfc6386#section-14.4 "Implementation of the DCT Inversion"
+    // This computes the same values as short_idct4x4llm_c(), with each row of the 4x4 block in one vector.
+    i32x4 rows[4];
+    for (int i = 0; i < 4; ++i)
+        rows[i] = simd_cast<i32x4>(load_unaligned<i16x4>(coefficients + i * 4));
+
+    inverse_dct_1d(rows[0], rows[1], rows[2], rows[3]);
+    for (auto& row : rows)
+        row = wrap_to_i16(row);
+
+    transpose_4x4(rows[0], rows[1], rows[2], rows[3]);
+    inverse_dct_1d(rows[0], rows[1], rows[2], rows[3]);
+    for (auto& row : rows)
+        row = wrap_to_i16((row + 4) >> 3);
+    transpose_4x4(rows[0], rows[1], rows[2], rows[3]);
 
     // https://datatracker.ietf.org/doc/html/rfc6386#section-14.5 "Summation of Predictor and Residue"
     // FIXME: Could omit the clamp() call if FrameHeader.clamping_type == ClampingSpecification::NoClampingNecessary.
     for (int py = 0; py < 4; ++py) {
-        for (int px = 0; px < 4; ++px) {
-            u8& p = prediction[(4 * y + py) * N + (4 * x + px)];
-            p = clamp(p + idct_output[py * 4 + px], 0, 255);
-        }
+        u8* p = &prediction[(4 * y + py) * N + 4 * x];
+        i32x4 sum = simd_cast<i32x4>(load_unaligned<u8x4>(p)) + rows[py];
+        store_unaligned(p, simd_cast<u8x4>(clamp(sum, 0, 255)));
     }
 }
 
@@ -1117,24 +1173,50 @@ void process_subblocks(Bytes y_output, MacroblockMetadata const& metadata, int m
 
 void convert_yuv_to_rgb(Bitmap& bitmap, int mb_x, int mb_y, ReadonlyBytes y_data, ReadonlyBytes u_data, ReadonlyBytes v_data)
 {
+    using namespace AK::SIMD;
+
+    // This works on four pixels at a time. It computes in doubles, so that the results are the same as with scalar code.
     for (int y = 0; y < 16; ++y) {
-        for (int x = 0; x < 16; ++x) {
-            u8 Y = y_data[y * 16 + x];
+        ARGB32* scanline = bitmap.scanline(mb_y * 16 + y) + mb_x * 16;
+        for (int x = 0; x < 16; x += 4) {
+            f64x4 Y = simd_cast<f64x4>(load_unaligned<u8x4>(&y_data[y * 16 + x]));
 
             // FIXME: Could do nicer upsampling than just nearest neighbor
-            u8 U = u_data[(y / 2) * 8 + x / 2];
-            u8 V = v_data[(y / 2) * 8 + x / 2];
+            u8 const* u = &u_data[(y / 2) * 8 + x / 2];
+            u8 const* v = &v_data[(y / 2) * 8 + x / 2];
+            f64x4 U { static_cast<double>(u[0]), static_cast<double>(u[0]), static_cast<double>(u[1]), static_cast<double>(u[1]) };
+            f64x4 V { static_cast<double>(v[0]), static_cast<double>(v[0]), static_cast<double>(v[1]), static_cast<double>(v[1]) };
 
             // XXX: These numbers are from the fixed-point values in libwebp's yuv.h. There's probably a better reference somewhere.
-            int r = 1.1655 * Y + 1.596 * V - 222.4;
-            int g = 1.1655 * Y - 0.3917 * U - 0.8129 * V + 136.0625;
-            int b = 1.1655 * Y + 2.0172 * U - 276.33;
+            i32x4 r = clamp(simd_cast<i32x4>(1.1655 * Y + 1.596 * V - 222.4), 0, 255);
+            i32x4 g = clamp(simd_cast<i32x4>(1.1655 * Y - 0.3917 * U - 0.8129 * V + 136.0625), 0, 255);
+            i32x4 b = clamp(simd_cast<i32x4>(1.1655 * Y + 2.0172 * U - 276.33), 0, 255);
 
-            bitmap.scanline(mb_y * 16 + y)[mb_x * 16 + x] = Color(clamp(r, 0, 255), clamp(g, 0, 255), clamp(b, 0, 255)).value();
+            u32x4 pixels = 0xff000000u | simd_cast<u32x4>((r << 16) | (g << 8) | b);
+            store_unaligned(scanline + x, pixels);
         }
     }
 }
 
+// Each macroblock row is reconstructed into one of these, and converted to RGB on the thread pool while the next row is
+// being decoded. Each macroblock's planes are stored next to each other, in the layout process_macroblock() works on.
+struct MacroblockRow {
+    static constexpr size_t y_size = 16 * 16;
+    static constexpr size_t uv_size = 8 * 8;
+    static constexpr size_t macroblock_size = y_size + 2 * uv_size;
+
+    static ErrorOr<MacroblockRow> create(int macroblock_width)
+    {
+        return MacroblockRow { TRY(ByteBuffer::create_zeroed(macroblock_width * macroblock_size)) };
+    }
+
+    Bytes y_data(int mb_x) { return data.bytes().slice(mb_x * macroblock_size, y_size); }
+    Bytes u_data(int mb_x) { return data.bytes().slice(mb_x * macroblock_size + y_size, uv_size); }
+    Bytes v_data(int mb_x) { return data.bytes().slice(mb_x * macroblock_size + y_size + uv_size, uv_size); }
+
+    ByteBuffer data;
+};
+
 ErrorOr<void> decode_VP8_image_data(Gfx::Bitmap& bitmap, FrameHeader const& header, Vector<ReadonlyBytes> data_partitions, int macroblock_width, int macroblock_height, Vector<MacroblockMetadata> const& macroblock_metadata)
 {
 
@@ -1162,9 +1244,17 @@ ErrorOr<void> decode_VP8_image_data(Gfx::Bitmap& bitmap, FrameHeader const& head
     for (size_t i = 0; i < predicted_v_above.size(); ++i)
         predicted_v_above[i] = 127;
 
+    // Prediction and the coefficient contexts depend on the row above, so reconstruction is sequential.
+    // Converting a reconstructed row to RGB only depends on that row though, so that happens in parallel.
+    auto& thread_pool = Threading::WorkStealingThreadPool::the();
+    Threading::WorkStealingThreadPool::TaskGroup conversions;
+    ScopeGuard wait_for_conversions = [&] { thread_pool.wait(conversions); };
+
     for (int mb_y = 0, macroblock_index = 0; mb_y < macroblock_height; ++mb_y) {
         BooleanDecoder& decoder = streams[mb_y % streams.size()];
 
+        auto row = TRY(MacroblockRow::create(macroblock_width));
+
         coefficient_reading_context.start_new_row();
 
         u8 predicted_y_left[16] { 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129, 129 };
@@ -1182,22 +1272,20 @@ ErrorOr<void> decode_VP8_image_data(Gfx::Bitmap& bitmap, FrameHeader const& head
 
             auto coefficients = read_macroblock_coefficients(decoder, header, coefficient_reading_context, metadata, mb_x);
 
-            u8 y_data[16 * 16] {};
+            auto y_data = row.y_data(mb_x);
             if (metadata.intra_y_mode == B_PRED)
                 process_subblocks(y_data, metadata, mb_x, predicted_y_left, predicted_y_above, y_truemotion_corner, coefficients.y_coeffs, macroblock_width);
             else
                 process_macroblock<4>(y_data, metadata.intra_y_mode, mb_x, mb_y, predicted_y_left, predicted_y_above, y_truemotion_corner, coefficients.y_coeffs);
 
-            u8 u_data[8 * 8] {};
+            auto u_data = row.u_data(mb_x);
             process_macroblock<2>(u_data, metadata.uv_mode, mb_x, mb_y, predicted_u_left, predicted_u_above, u_truemotion_corner, coefficients.u_coeffs);
 
-            u8 v_data[8 * 8] {};
+            auto v_data = row.v_data(mb_x);
             process_macroblock<2>(v_data, metadata.uv_mode, mb_x, mb_y, predicted_v_left, predicted_v_above, v_truemotion_corner, coefficients.v_coeffs);
 
             // FIXME: insert loop filtering here
 
-            convert_yuv_to_rgb(bitmap, mb_x, mb_y, y_data, u_data, v_data);
-
             y_truemotion_corner = predicted_y_above[mb_x * 16 + 15];
             for (int i = 0; i < 16; ++i)
                 predicted_y_left[i] = y_data[15 + i * 16];
@@ -1216,6 +1304,11 @@ ErrorOr<void> decode_VP8_image_data(Gfx::Bitmap& bitmap, FrameHeader const& head
             for (int i = 0; i < 8; ++i)
                 predicted_v_above[mb_x * 8 + i] = v_data[7 * 8 + i];
         }
+
+        thread_pool.spawn(conversions, [&bitmap, mb_y, macroblock_width, row = move(row)]() mutable {
+            for (int mb_x = 0; mb_x < macroblock_width; ++mb_x)
+                convert_yuv_to_rgb(bitmap, mb_x, mb_y, row.y_data(mb_x), row.u_data(mb_x), row.v_data(mb_x));
+        });
     }
 
     for (auto& decoder : streams)
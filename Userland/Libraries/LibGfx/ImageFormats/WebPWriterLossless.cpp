@@ -18,6 +18,7 @@
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/WebPSharedLossless.h>
 #include <LibGfx/ImageFormats/WebPWriterLossless.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 namespace Gfx {
 
@@ -103,6 +104,22 @@ NEVER_INLINE static ErrorOr<void> write_image_data(LittleEndianOutputBitStream&
     return {};
 }
 
+// The transforms look at each row on its own, so the rows of large images are transformed on multiple threads.
+template<typename Callback>
+static ErrorOr<void> for_each_row_in_parallel(int height, Callback const& callback)
+{
+    Vector<int> rows;
+    TRY(rows.try_ensure_capacity(height));
+    for (int y = 0; y < height; ++y)
+        rows.unchecked_append(y);
+
+    Threading::parallel_for(rows.span(), [&](Span<int> slice) {
+        for (int y : slice)
+            callback(y);
+    });
+    return {};
+}
+
 struct CodeLengthSymbol {
     u8 symbol { 0 };
     u8 count { 0 }; // used for special symbols 16-18
@@ -422,22 +439,43 @@ static ErrorOr<PrefixCodeGroup> compute_and_write_prefix_code_group(Vector<Symbo
         symbol_frequencies_distance
     };
 
-    static constexpr auto saturating_increment = [](u16& value) {
-        if (value < UINT16_MAX)
-            value++;
+    // The symbols are counted in parallel, with counts that can't overflow. Saturating them afterwards gives the same
+    // frequencies as saturating each increment.
+    using SymbolCounts = Array<Vector<u32>, 5>;
+    auto count_symbols = [&](ReadonlySpan<Symbol> slice) {
+        SymbolCounts counts;
+        for (int i = 0; i < 5; ++i)
+            counts[i].resize(alphabet_sizes[i]);
+
+        for (Symbol const& symbol : slice) {
+            counts[0][symbol.green_or_length_or_index]++;
+            if (symbol.green_or_length_or_index < 256) {
+                counts[1][symbol.r]++;
+                counts[2][symbol.b]++;
+                counts[3][symbol.a]++;
+            } else if (symbol.green_or_length_or_index < 256 + 24) {
+                counts[4][prefix_decompose(symbol.distance).prefix_code]++;
+            } else {
+                // Nothing to do.
+            }
+        }
+        return counts;
     };
-
-    for (Symbol const& symbol : symbols) {
-        saturating_increment(symbol_frequencies[0][symbol.green_or_length_or_index]);
-        if (symbol.green_or_length_or_index < 256) {
-            saturating_increment(symbol_frequencies[1][symbol.r]);
-            saturating_increment(symbol_frequencies[2][symbol.b]);
-            saturating_increment(symbol_frequencies[3][symbol.a]);
-        } else if (symbol.green_or_length_or_index < 256 + 24) {
-            saturating_increment(symbol_frequencies[4][prefix_decompose(symbol.distance).prefix_code]);
-        } else {
-            // Nothing to do.
+    auto add_counts = [](SymbolCounts left, SymbolCounts right) {
+        for (int i = 0; i < 5; ++i) {
+            for (size_t j = 0; j < left[i].size(); ++j)
+                left[i][j] += right[i][j];
         }
+        return left;
+    };
+
+    // Each slice has its own counts, so the slices have to be large enough to make up for them.
+    static constexpr size_t minimum_symbols_per_slice = 64 * KiB;
+    auto grain_size = max(ceil_div(symbols.size(), Threading::WorkStealingThreadPool::the().worker_count()), minimum_symbols_per_slice);
+    auto counts = Threading::parallel_reduce(symbols.span(), grain_size, count_symbols, add_counts);
+    for (int i = 0; i < 5; ++i) {
+        for (size_t j = 0; j < alphabet_sizes[i]; ++j)
+            symbol_frequencies[i][j] = min(counts[i][j], static_cast<u32>(UINT16_MAX));
     }
 
     Vector<u8, 256 + 24 + 64> code_lengths_green_or_length {};
@@ -559,7 +597,7 @@ static ErrorOr<NonnullRefPtr<Bitmap>> maybe_write_predictor_transform(LittleEndi
     TRY(write_VP8L_coded_image(ImageKind::EntropyCoded, bit_stream, *subresolution_bitmap, dont_care, {}));
 
     auto new_bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, bitmap->size()));
-    for (int y = 0; y < new_bitmap->height(); ++y) {
+    TRY(for_each_row_in_parallel(new_bitmap->height(), [&](int y) {
         auto* old_scanline = bitmap->scanline(y);
         auto* new_scanline = new_bitmap->scanline(y);
 
@@ -575,7 +613,7 @@ static ErrorOr<NonnullRefPtr<Bitmap>> maybe_write_predictor_transform(LittleEndi
             ARGB32 current = old_scanline[x];
             new_scanline[x] = sub_argb32(current, left);
         }
-    }
+    }));
 
     return new_bitmap;
 }
@@ -588,12 +626,14 @@ static ErrorOr<NonnullRefPtr<Bitmap>> write_subtract_green_transform(LittleEndia
     TRY(bit_stream.write_bits(static_cast<unsigned>(SUBTRACT_GREEN_TRANSFORM), 2u));
 
     auto new_bitmap = TRY(bitmap->clone());
-    for (ARGB32& pixel : *new_bitmap) {
-        Color color = Color::from_argb(pixel);
-        u8 red = (color.red() - color.green()) & 0xff;
-        u8 blue = (color.blue() - color.green()) & 0xff;
-        pixel = Color(red, color.green(), blue, color.alpha()).value();
-    }
+    TRY(for_each_row_in_parallel(new_bitmap->height(), [&](int y) {
+        for (ARGB32& pixel : Span<ARGB32> { new_bitmap->scanline(y), static_cast<size_t>(new_bitmap->width()) }) {
+            Color color = Color::from_argb(pixel);
+            u8 red = (color.red() - color.green()) & 0xff;
+            u8 blue = (color.blue() - color.green()) & 0xff;
+            pixel = Color(red, color.green(), blue, color.alpha()).value();
+        }
+    }));
 
     return new_bitmap;
 }
@@ -693,18 +733,19 @@ static ErrorOr<NonnullRefPtr<Bitmap>> maybe_write_color_indexing_transform(Littl
     auto new_bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { image_width, bitmap->height() }));
 
     unsigned bits_per_pixel = 8 / pixels_per_pixel;
-    for (int y = 0; y < bitmap->height(); ++y) {
+    TRY(for_each_row_in_parallel(bitmap->height(), [&](int y) {
+        auto const* scanline = bitmap->scanline(y);
+        auto* new_scanline = new_bitmap->scanline(y);
         for (int x = 0, new_x = 0; x < bitmap->width(); x += pixels_per_pixel, ++new_x) {
             u8 indexes = 0;
             for (int i = 0; i < pixels_per_pixel && x + i < bitmap->width(); ++i) {
-                auto pixel = bitmap->get_pixel(x + i, y);
-                auto result = color_index_map.get(pixel.value());
+                auto result = color_index_map.get(scanline[x + i]);
                 VERIFY(result.has_value());
                 indexes |= result.value() << (i * bits_per_pixel);
             }
-            new_bitmap->set_pixel(new_x, y, Color(0, indexes, 0, 0));
+            new_scanline[new_x] = Color(0, indexes, 0, 0).value();
         }
-    }
+    }));
 
     return new_bitmap;
 }
@@ -27,6 +27,7 @@
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
 #include <LibGfx/CharacterBitmap.h>
+#include <LibGfx/CompositingKernels.h>
 #include <LibGfx/Palette.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/Quad.h>
@@ -108,10 +109,9 @@ void Painter::fill_physical_rect(IntRect const& physical_rect, Color color)
     ARGB32* dst = target().scanline(physical_rect.top()) + physical_rect.left();
     size_t const dst_skip = target().pitch() / sizeof(ARGB32);
 
-    auto dst_format = target().format();
+    bool const dst_has_alpha = target().has_alpha_channel();
     for (int i = physical_rect.height() - 1; i >= 0; --i) {
-        for (int j = 0; j < physical_rect.width(); ++j)
-            dst[j] = color_for_format(dst_format, dst[j]).blend(color).value();
+        blend_color_row(dst, color, physical_rect.width(), dst_has_alpha);
         dst += dst_skip;
     }
 }
@@ -824,39 +824,18 @@ struct BlitState {
     BitmapFormat src_format;
 };
 
-// FIXME: This is a hack to support blit_with_opacity() with RGBA8888 source.
-//        Ideally we'd have a more generic solution that allows any source format.
-static void swap_red_and_blue_channels(Color& color)
-{
-    u32 rgba = color.value();
-    u32 bgra = (rgba & 0xff00ff00)
-        | ((rgba & 0x000000ff) << 16)
-        | ((rgba & 0x00ff0000) >> 16);
-    color = Color::from_argb(bgra);
-}
-
-// FIXME: This function is very unoptimized.
 template<BlitState::AlphaState has_alpha>
 static void do_blit_with_opacity(BlitState& state)
 {
+    BlendRowOptions const options {
+        .opacity = static_cast<u8>(clamp(state.opacity, 0.0f, 1.0f) * 255),
+        .source_has_alpha = (has_alpha & BlitState::SrcAlpha) != 0,
+        .source_is_rgba = state.src_format == BitmapFormat::RGBA8888,
+        .destination_has_alpha = (has_alpha & BlitState::DstAlpha) != 0,
+    };
+
     for (int row = 0; row < state.row_count; ++row) {
-        for (int x = 0; x < state.column_count; ++x) {
-            Color dest_color = (has_alpha & BlitState::DstAlpha) ? Color::from_argb(state.dst[x]) : Color::from_rgb(state.dst[x]);
-            if constexpr (has_alpha & BlitState::SrcAlpha) {
-                Color src_color_with_alpha = Color::from_argb(state.src[x]);
-                if (state.src_format == BitmapFormat::RGBA8888)
-                    swap_red_and_blue_channels(src_color_with_alpha);
-                float pixel_opacity = src_color_with_alpha.alpha() / 255.0;
-                src_color_with_alpha.set_alpha(255 * (state.opacity * pixel_opacity));
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
-            } else {
-                Color src_color_with_alpha = Color::from_rgb(state.src[x]);
-                if (state.src_format == BitmapFormat::RGBA8888)
-                    swap_red_and_blue_channels(src_color_with_alpha);
-                src_color_with_alpha.set_alpha(state.opacity * 255);
-                state.dst[x] = dest_color.blend(src_color_with_alpha).value();
-            }
-        }
+        blend_row(state.dst, state.src, state.column_count, options);
         state.dst += state.dst_pitch;
         state.src += state.src_pitch;
     }
@@ -1185,6 +1164,104 @@ ALWAYS_INLINE static void do_draw_box_sampled_scaled_bitmap(Gfx::Bitmap& target,
     }
 }
 
+// The vectorized samplers produce one row of the scaled image at a time, which is then composited onto the target.
+template<bool has_alpha_channel, typename SampleRow>
+static void draw_sampled_rows(Gfx::Bitmap& target, IntRect const& clipped_rect, SampleRow sample_row)
+{
+    Vector<ARGB32> row;
+    if constexpr (has_alpha_channel)
+        row.resize(clipped_rect.width());
+
+    BlendRowOptions const options { .destination_has_alpha = target.has_alpha_channel() };
+    for (int y = clipped_rect.top(); y < clipped_rect.bottom(); ++y) {
+        ARGB32* scanline = target.scanline(y) + clipped_rect.left();
+        if constexpr (has_alpha_channel) {
+            sample_row(row.data(), y);
+            blend_row(scanline, row.data(), row.size(), options);
+        } else {
+            sample_row(scanline, y);
+        }
+    }
+}
+
+template<bool has_alpha_channel>
+static void do_draw_bilinear_scaled_bitmap(Gfx::Bitmap& target, IntRect const& dst_rect, IntRect const& clipped_rect, Gfx::Bitmap const& source, FloatRect const& src_rect, IntRect const& clipped_src_rect, float opacity)
+{
+    i64 shift = 1ll << 32;
+    i64 fractional_mask = shift - 1;
+    i64 bilinear_offset_x = (1ll << 31) * (src_rect.width() / dst_rect.width() - 1);
+    i64 bilinear_offset_y = (1ll << 31) * (src_rect.height() / dst_rect.height() - 1);
+    i64 hscale = src_rect.width() * shift / dst_rect.width();
+    i64 vscale = src_rect.height() * shift / dst_rect.height();
+    i64 src_left = src_rect.left() * shift;
+    i64 src_top = src_rect.top() * shift;
+
+    // The source columns are the same for every row, so they are only computed once.
+    Vector<BilinearColumn> columns;
+    columns.ensure_capacity(clipped_rect.width());
+    for (int x = clipped_rect.left(); x < clipped_rect.right(); ++x) {
+        auto shifted_x = (x - dst_rect.x()) * hscale + src_left + bilinear_offset_x;
+        columns.unchecked_append({
+            .left = static_cast<int>(clamp(shifted_x >> 32, clipped_src_rect.left(), clipped_src_rect.right() - 1)),
+            .right = static_cast<int>(clamp((shifted_x >> 32) + 1, clipped_src_rect.left(), clipped_src_rect.right() - 1)),
+            .right_weight = (shifted_x & fractional_mask) / static_cast<float>(shift),
+        });
+    }
+
+    bool const source_has_alpha = source.has_alpha_channel();
+    draw_sampled_rows<has_alpha_channel>(target, clipped_rect, [&](ARGB32* row, int y) {
+        auto shifted_y = (y - dst_rect.y()) * vscale + src_top + bilinear_offset_y;
+        auto top = static_cast<int>(clamp(shifted_y >> 32, clipped_src_rect.top(), clipped_src_rect.bottom() - 1));
+        auto bottom = static_cast<int>(clamp((shifted_y >> 32) + 1, clipped_src_rect.top(), clipped_src_rect.bottom() - 1));
+        float bottom_weight = (shifted_y & fractional_mask) / static_cast<float>(shift);
+        sample_row_bilinear(row, source.scanline(top), source.scanline(bottom), bottom_weight, columns, source_has_alpha, opacity);
+    });
+}
+
+static void compute_box_sample_spans(Vector<BoxSampleSpan>& spans, Vector<float>& weights, float src_start, float source_pixel_size, int dst_start, int first, int count, int src_limit)
+{
+    spans.ensure_capacity(count);
+    // Every span covers at most ceil(source_pixel_size) + 1 source pixels, so the weights never move while we point at them.
+    weights.ensure_capacity(count * (static_cast<size_t>(ceilf(source_pixel_size)) + 1));
+
+    for (int i = first; i < first + count; ++i) {
+        float box_start = src_start + (i - dst_start) * source_pixel_size;
+        float box_end = box_start + source_pixel_size;
+        int first_pixel = max(static_cast<int>(floorf(box_start)), 0);
+        int end_pixel = min(static_cast<int>(ceilf(box_end)), src_limit);
+
+        BoxSampleSpan span { .first = first_pixel, .count = max(end_pixel - first_pixel, 0), .weights = weights.data() + weights.size() };
+        for (int pixel = first_pixel; pixel < end_pixel; ++pixel)
+            weights.unchecked_append(max(min(pixel + 1.f, box_end) - max(static_cast<float>(pixel), box_start), 0.f));
+        spans.unchecked_append(span);
+    }
+}
+
+template<bool has_alpha_channel>
+static void do_draw_box_sampled_scaled_bitmap(Gfx::Bitmap& target, IntRect const& dst_rect, IntRect const& clipped_rect, Gfx::Bitmap const& source, FloatRect const& src_rect, float opacity)
+{
+    float source_pixel_width = src_rect.width() / dst_rect.width();
+    float source_pixel_height = src_rect.height() / dst_rect.height();
+    float source_pixel_area = source_pixel_width * source_pixel_height;
+
+    // The area of a source pixel that is covered by a destination pixel is the product of its horizontal and vertical
+    // coverage, which we only need to compute once per column and once per row.
+    Vector<BoxSampleSpan> columns;
+    Vector<float> column_weights;
+    compute_box_sample_spans(columns, column_weights, src_rect.left(), source_pixel_width, dst_rect.x(), clipped_rect.left(), clipped_rect.width(), source.rect().right());
+
+    Vector<BoxSampleSpan> rows;
+    Vector<float> row_weights;
+    compute_box_sample_spans(rows, row_weights, src_rect.top(), source_pixel_height, dst_rect.y(), clipped_rect.top(), clipped_rect.height(), source.rect().bottom());
+
+    bool const source_has_alpha = source.has_alpha_channel();
+    size_t const source_pitch = source.pitch() / sizeof(ARGB32);
+    float const alpha_scale = 255.f / source_pixel_area * opacity;
+    draw_sampled_rows<has_alpha_channel>(target, clipped_rect, [&](ARGB32* row, int y) {
+        sample_row_box(row, source.scanline(0), source_pitch, rows[y - clipped_rect.top()], columns, source_has_alpha, alpha_scale);
+    });
+}
+
 template<bool has_alpha_channel, ScalingMode scaling_mode, typename GetPixel>
 ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect const& dst_rect, IntRect const& clipped_rect, Gfx::Bitmap const& source, FloatRect const& src_rect, GetPixel get_pixel, float opacity)
 {
@@ -1207,8 +1284,18 @@ ALWAYS_INLINE static void do_draw_scaled_bitmap(Gfx::Bitmap& target, IntRect con
         }
     }
 
-    if constexpr (scaling_mode == ScalingMode::BoxSampling)
+    bool const has_vectorized_sampler = source.format() == BitmapFormat::BGRx8888 || source.format() == BitmapFormat::BGRA8888;
+
+    if constexpr (scaling_mode == ScalingMode::BoxSampling) {
+        if (has_vectorized_sampler)
+            return do_draw_box_sampled_scaled_bitmap<has_alpha_channel>(target, dst_rect, clipped_rect, source, src_rect, opacity);
         return do_draw_box_sampled_scaled_bitmap<has_alpha_channel>(target, dst_rect, clipped_rect, source, src_rect, get_pixel, opacity);
+    }
+
+    if constexpr (scaling_mode == ScalingMode::BilinearBlend) {
+        if (has_vectorized_sampler)
+            return do_draw_bilinear_scaled_bitmap<has_alpha_channel>(target, dst_rect, clipped_rect, source, src_rect, clipped_src_rect, opacity);
+    }
 
     bool has_opacity = opacity != 1.f;
     i64 shift = 1ll << 32;
@@ -2361,6 +2448,12 @@ void Painter::clear_clip_rect()
     state().clip_rect = m_clip_origin;
 }
 
+void Painter::set_clip_origin(IntRect const& rect)
+{
+    m_clip_origin = rect.intersected(target().rect());
+    state().clip_rect = m_clip_origin;
+}
+
 PainterStateSaver::PainterStateSaver(Painter& painter)
     : m_painter(painter)
 {
@@ -2469,15 +2562,15 @@ void Painter::draw_text_run(IntPoint baseline_start, Utf8View const& string, Fon
 
 void Painter::draw_text_run(FloatPoint baseline_start, Utf8View const& string, Font const& font, Color color)
 {
-    for_each_glyph_position(baseline_start, string, font, [&](DrawGlyphOrEmoji glyph_or_emoji) {
+    for (auto const& glyph_or_emoji : GlyphRunCache::the().glyphs_for(string, font).glyphs) {
         if (glyph_or_emoji.has<DrawGlyph>()) {
-            auto& glyph = glyph_or_emoji.get<DrawGlyph>();
-            draw_glyph(glyph.position, glyph.code_point, font, color);
+            auto const& glyph = glyph_or_emoji.get<DrawGlyph>();
+            draw_glyph(glyph.position.translated(baseline_start), glyph.code_point, font, color);
         } else {
-            auto& emoji = glyph_or_emoji.get<DrawEmoji>();
-            draw_emoji(emoji.position.to_type<int>(), *emoji.emoji, font);
+            auto const& emoji = glyph_or_emoji.get<DrawEmoji>();
+            draw_emoji(emoji.position.translated(baseline_start).to_type<int>(), *emoji.emoji, font);
         }
-    });
+    }
 }
 
 void Painter::draw_scaled_bitmap_with_transform(IntRect const& dst_rect, Bitmap const& bitmap, FloatRect const& src_rect, AffineTransform const& transform, float opacity, ScalingMode scaling_mode)
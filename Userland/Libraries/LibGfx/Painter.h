@@ -175,6 +175,9 @@ public:
     void add_clip_rect(IntRect const& rect);
     void clear_clip_rect();
 
+    // Restricts all painting to the given rect, including after the clip rect has been cleared.
+    void set_clip_origin(IntRect const& rect);
+
     void translate(int dx, int dy) { translate({ dx, dy }); }
     void translate(IntPoint delta) { state().translation.translate_by(delta); }
 
@@ -250,4 +250,50 @@ DrawGlyphOrEmoji prepare_draw_glyph_or_emoji(FloatPoint point, Utf8CodePointIter
     };
 }
 
+GlyphRunCache& GlyphRunCache::the()
+{
+    static GlyphRunCache s_the;
+    return s_the;
+}
+
+static void position_glyphs(Utf8View const& text, Font const& font, GlyphRunCache::Entry& entry)
+{
+    entry.glyphs.clear_with_capacity();
+    for_each_glyph_position(
+        { 0, 0 }, text, font, [&](DrawGlyphOrEmoji const& glyph_or_emoji) {
+            entry.glyphs.append(glyph_or_emoji);
+        },
+        IncludeLeftBearing::No, entry.width);
+}
+
+GlyphRunCache::Entry const& GlyphRunCache::glyphs_for(Utf8View const& text, Font const& font)
+{
+    if (text.byte_length() > maximum_text_length) {
+        position_glyphs(text, font, m_uncached_entry);
+        return m_uncached_entry;
+    }
+
+    GlyphRunCacheKey key { ByteString { text.as_string() }, font };
+    if (auto it = m_current_generation.find(key); it != m_current_generation.end())
+        return it->value;
+
+    if (m_current_generation.size() >= maximum_entries_per_generation)
+        m_previous_generation = exchange(m_current_generation, {});
+
+    return m_current_generation.ensure(key, [&] {
+        if (auto entry = m_previous_generation.take(key); entry.has_value())
+            return entry.release_value();
+
+        Entry entry;
+        position_glyphs(text, font, entry);
+        return entry;
+    });
+}
+
+void GlyphRunCache::clear()
+{
+    m_current_generation.clear();
+    m_previous_generation.clear();
+}
+
 }
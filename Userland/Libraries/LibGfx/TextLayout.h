@@ -10,6 +10,7 @@
 #include <AK/ByteString.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Forward.h>
+#include <AK/HashMap.h>
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
 #include <AK/Variant.h>
@@ -173,4 +174,51 @@ void for_each_glyph_position(FloatPoint baseline_start, Utf8View string, Gfx::Fo
         *width = point.x() - font.glyph_spacing();
 }
 
+struct GlyphRunCacheKey {
+    ByteString text;
+    NonnullRefPtr<Font const> font;
+
+    bool operator==(GlyphRunCacheKey const& other) const { return font.ptr() == other.font.ptr() && text == other.text; }
+};
+
+}
+
+template<>
+struct AK::Traits<Gfx::GlyphRunCacheKey> : public AK::DefaultTraits<Gfx::GlyphRunCacheKey> {
+    static unsigned hash(Gfx::GlyphRunCacheKey const& key)
+    {
+        return pair_int_hash(key.text.hash(), ptr_hash(key.font.ptr()));
+    }
+};
+
+namespace Gfx {
+
+// Remembers the glyph positions of runs of text, since layout and painting tend to position the same words in the
+// same fonts over and over again. Like the fonts themselves, this is not thread-safe.
+class GlyphRunCache {
+public:
+    static GlyphRunCache& the();
+
+    struct Entry {
+        Vector<DrawGlyphOrEmoji> glyphs;
+        float width { 0 };
+    };
+
+    // Returns the same glyphs (and width) as for_each_glyph_position() would produce for a baseline starting at (0, 0).
+    // The returned entry is only valid until the next call.
+    Entry const& glyphs_for(Utf8View const&, Font const&);
+
+    void clear();
+
+private:
+    static constexpr size_t maximum_text_length = 256;
+    static constexpr size_t maximum_entries_per_generation = 4096;
+
+    // Entries that haven't been used during a whole generation are dropped, which approximates LRU eviction without
+    // having to keep track of every lookup.
+    HashMap<GlyphRunCacheKey, Entry> m_current_generation;
+    HashMap<GlyphRunCacheKey, Entry> m_previous_generation;
+    Entry m_uncached_entry;
+};
+
 }
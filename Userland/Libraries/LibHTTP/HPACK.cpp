@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/StringBuilder.h>
+#include <AK/StringView.h>
+#include <LibHTTP/HPACK.h>
+
+namespace HTTP::HPACK {
+
+struct StaticTableEntry {
+    StringView name;
+    StringView value;
+};
+
+// RFC 7541 Appendix A.
+static constexpr Array<StaticTableEntry, 61> static_table { {
+    { ":authority"sv, ""sv },
+    { ":method"sv, "GET"sv },
+    { ":method"sv, "POST"sv },
+    { ":path"sv, "/"sv },
+    { ":path"sv, "/index.html"sv },
+    { ":scheme"sv, "http"sv },
+    { ":scheme"sv, "https"sv },
+    { ":status"sv, "200"sv },
+    { ":status"sv, "204"sv },
+    { ":status"sv, "206"sv },
+    { ":status"sv, "304"sv },
+    { ":status"sv, "400"sv },
+    { ":status"sv, "404"sv },
+    { ":status"sv, "500"sv },
+    { "accept-charset"sv, ""sv },
+    { "accept-encoding"sv, "gzip, deflate"sv },
+    { "accept-language"sv, ""sv },
+    { "accept-ranges"sv, ""sv },
+    { "accept"sv, ""sv },
+    { "access-control-allow-origin"sv, ""sv },
+    { "age"sv, ""sv },
+    { "allow"sv, ""sv },
+    { "authorization"sv, ""sv },
+    { "cache-control"sv, ""sv },
+    { "content-disposition"sv, ""sv },
+    { "content-encoding"sv, ""sv },
+    { "content-language"sv, ""sv },
+    { "content-length"sv, ""sv },
+    { "content-location"sv, ""sv },
+    { "content-range"sv, ""sv },
+    { "content-type"sv, ""sv },
+    { "cookie"sv, ""sv },
+    { "date"sv, ""sv },
+    { "etag"sv, ""sv },
+    { "expect"sv, ""sv },
+    { "expires"sv, ""sv },
+    { "from"sv, ""sv },
+    { "host"sv, ""sv },
+    { "if-match"sv, ""sv },
+    { "if-modified-since"sv, ""sv },
+    { "if-none-match"sv, ""sv },
+    { "if-range"sv, ""sv },
+    { "if-unmodified-since"sv, ""sv },
+    { "last-modified"sv, ""sv },
+    { "link"sv, ""sv },
+    { "location"sv, ""sv },
+    { "max-forwards"sv, ""sv },
+    { "proxy-authenticate"sv, ""sv },
+    { "proxy-authorization"sv, ""sv },
+    { "range"sv, ""sv },
+    { "referer"sv, ""sv },
+    { "refresh"sv, ""sv },
+    { "retry-after"sv, ""sv },
+    { "server"sv, ""sv },
+    { "set-cookie"sv, ""sv },
+    { "strict-transport-security"sv, ""sv },
+    { "transfer-encoding"sv, ""sv },
+    { "user-agent"sv, ""sv },
+    { "vary"sv, ""sv },
+    { "via"sv, ""sv },
+    { "www-authenticate"sv, ""sv },
+} };
+
+struct HuffmanCode {
+    u32 bits;
+    u8 length;
+};
+
+// RFC 7541 Appendix B, indexed by symbol. Symbol 256 is EOS, which only ever shows up as padding.
+static constexpr Array<HuffmanCode, 257> huffman_codes { {
+    { 0x1ff8, 13 }, { 0x7fffd8, 23 }, { 0xfffffe2, 28 }, { 0xfffffe3, 28 },
+    { 0xfffffe4, 28 }, { 0xfffffe5, 28 }, { 0xfffffe6, 28 }, { 0xfffffe7, 28 },
+    { 0xfffffe8, 28 }, { 0xffffea, 24 }, { 0x3ffffffc, 30 }, { 0xfffffe9, 28 },
+    { 0xfffffea, 28 }, { 0x3ffffffd, 30 }, { 0xfffffeb, 28 }, { 0xfffffec, 28 },
+    { 0xfffffed, 28 }, { 0xfffffee, 28 }, { 0xfffffef, 28 }, { 0xffffff0, 28 },
+    { 0xffffff1, 28 }, { 0xffffff2, 28 }, { 0x3ffffffe, 30 }, { 0xffffff3, 28 },
+    { 0xffffff4, 28 }, { 0xffffff5, 28 }, { 0xffffff6, 28 }, { 0xffffff7, 28 },
+    { 0xffffff8, 28 }, { 0xffffff9, 28 }, { 0xffffffa, 28 }, { 0xffffffb, 28 },
+    { 0x14, 6 }, { 0x3f8, 10 }, { 0x3f9, 10 }, { 0xffa, 12 },
+    { 0x1ff9, 13 }, { 0x15, 6 }, { 0xf8, 8 }, { 0x7fa, 11 },
+    { 0x3fa, 10 }, { 0x3fb, 10 }, { 0xf9, 8 }, { 0x7fb, 11 },
+    { 0xfa, 8 }, { 0x16, 6 }, { 0x17, 6 }, { 0x18, 6 },
+    { 0x0, 5 }, { 0x1, 5 }, { 0x2, 5 }, { 0x19, 6 },
+    { 0x1a, 6 }, { 0x1b, 6 }, { 0x1c, 6 }, { 0x1d, 6 },
+    { 0x1e, 6 }, { 0x1f, 6 }, { 0x5c, 7 }, { 0xfb, 8 },
+    { 0x7ffc, 15 }, { 0x20, 6 }, { 0xffb, 12 }, { 0x3fc, 10 },
+    { 0x1ffa, 13 }, { 0x21, 6 }, { 0x5d, 7 }, { 0x5e, 7 },
+    { 0x5f, 7 }, { 0x60, 7 }, { 0x61, 7 }, { 0x62, 7 },
+    { 0x63, 7 }, { 0x64, 7 }, { 0x65, 7 }, { 0x66, 7 },
+    { 0x67, 7 }, { 0x68, 7 }, { 0x69, 7 }, { 0x6a, 7 },
+    { 0x6b, 7 }, { 0x6c, 7 }, { 0x6d, 7 }, { 0x6e, 7 },
+    { 0x6f, 7 }, { 0x70, 7 }, { 0x71, 7 }, { 0x72, 7 },
+    { 0xfc, 8 }, { 0x73, 7 }, { 0xfd, 8 }, { 0x1ffb, 13 },
+    { 0x7fff0, 19 }, { 0x1ffc, 13 }, { 0x3ffc, 14 }, { 0x22, 6 },
+    { 0x7ffd, 15 }, { 0x3, 5 }, { 0x23, 6 }, { 0x4, 5 },
+    { 0x24, 6 }, { 0x5, 5 }, { 0x25, 6 }, { 0x26, 6 },
+    { 0x27, 6 }, { 0x6, 5 }, { 0x74, 7 }, { 0x75, 7 },
+    { 0x28, 6 }, { 0x29, 6 }, { 0x2a, 6 }, { 0x7, 5 },
+    { 0x2b, 6 }, { 0x76, 7 }, { 0x2c, 6 }, { 0x8, 5 },
+    { 0x9, 5 }, { 0x2d, 6 }, { 0x77, 7 }, { 0x78, 7 },
+    { 0x79, 7 }, { 0x7a, 7 }, { 0x7b, 7 }, { 0x7ffe, 15 },
+    { 0x7fc, 11 }, { 0x3ffd, 14 }, { 0x1ffd, 13 }, { 0xffffffc, 28 },
+    { 0xfffe6, 20 }, { 0x3fffd2, 22 }, { 0xfffe7, 20 }, { 0xfffe8, 20 },
+    { 0x3fffd3, 22 }, { 0x3fffd4, 22 }, { 0x3fffd5, 22 }, { 0x7fffd9, 23 },
+    { 0x3fffd6, 22 }, { 0x7fffda, 23 }, { 0x7fffdb, 23 }, { 0x7fffdc, 23 },
+    { 0x7fffdd, 23 }, { 0x7fffde, 23 }, { 0xffffeb, 24 }, { 0x7fffdf, 23 },
+    { 0xffffec, 24 }, { 0xffffed, 24 }, { 0x3fffd7, 22 }, { 0x7fffe0, 23 },
+    { 0xffffee, 24 }, { 0x7fffe1, 23 }, { 0x7fffe2, 23 }, { 0x7fffe3, 23 },
+    { 0x7fffe4, 23 }, { 0x1fffdc, 21 }, { 0x3fffd8, 22 }, { 0x7fffe5, 23 },
+    { 0x3fffd9, 22 }, { 0x7fffe6, 23 }, { 0x7fffe7, 23 }, { 0xffffef, 24 },
+    { 0x3fffda, 22 }, { 0x1fffdd, 21 }, { 0xfffe9, 20 }, { 0x3fffdb, 22 },
+    { 0x3fffdc, 22 }, { 0x7fffe8, 23 }, { 0x7fffe9, 23 }, { 0x1fffde, 21 },
+    { 0x7fffea, 23 }, { 0x3fffdd, 22 }, { 0x3fffde, 22 }, { 0xfffff0, 24 },
+    { 0x1fffdf, 21 }, { 0x3fffdf, 22 }, { 0x7fffeb, 23 }, { 0x7fffec, 23 },
+    { 0x1fffe0, 21 }, { 0x1fffe1, 21 }, { 0x3fffe0, 22 }, { 0x1fffe2, 21 },
+    { 0x7fffed, 23 }, { 0x3fffe1, 22 }, { 0x7fffee, 23 }, { 0x7fffef, 23 },
+    { 0xfffea, 20 }, { 0x3fffe2, 22 }, { 0x3fffe3, 22 }, { 0x3fffe4, 22 },
+    { 0x7ffff0, 23 }, { 0x3fffe5, 22 }, { 0x3fffe6, 22 }, { 0x7ffff1, 23 },
+    { 0x3ffffe0, 26 }, { 0x3ffffe1, 26 }, { 0xfffeb, 20 }, { 0x7fff1, 19 },
+    { 0x3fffe7, 22 }, { 0x7ffff2, 23 }, { 0x3fffe8, 22 }, { 0x1ffffec, 25 },
+    { 0x3ffffe2, 26 }, { 0x3ffffe3, 26 }, { 0x3ffffe4, 26 }, { 0x7ffffde, 27 },
+    { 0x7ffffdf, 27 }, { 0x3ffffe5, 26 }, { 0xfffff1, 24 }, { 0x1ffffed, 25 },
+    { 0x7fff2, 19 }, { 0x1fffe3, 21 }, { 0x3ffffe6, 26 }, { 0x7ffffe0, 27 },
+    { 0x7ffffe1, 27 }, { 0x3ffffe7, 26 }, { 0x7ffffe2, 27 }, { 0xfffff2, 24 },
+    { 0x1fffe4, 21 }, { 0x1fffe5, 21 }, { 0x3ffffe8, 26 }, { 0x3ffffe9, 26 },
+    { 0xffffffd, 28 }, { 0x7ffffe3, 27 }, { 0x7ffffe4, 27 }, { 0x7ffffe5, 27 },
+    { 0xfffec, 20 }, { 0xfffff3, 24 }, { 0xfffed, 20 }, { 0x1fffe6, 21 },
+    { 0x3fffe9, 22 }, { 0x1fffe7, 21 }, { 0x1fffe8, 21 }, { 0x7ffff3, 23 },
+    { 0x3fffea, 22 }, { 0x3fffeb, 22 }, { 0x1ffffee, 25 }, { 0x1ffffef, 25 },
+    { 0xfffff4, 24 }, { 0xfffff5, 24 }, { 0x3ffffea, 26 }, { 0x7ffff4, 23 },
+    { 0x3ffffeb, 26 }, { 0x7ffffe6, 27 }, { 0x3ffffec, 26 }, { 0x3ffffed, 26 },
+    { 0x7ffffe7, 27 }, { 0x7ffffe8, 27 }, { 0x7ffffe9, 27 }, { 0x7ffffea, 27 },
+    { 0x7ffffeb, 27 }, { 0xffffffe, 28 }, { 0x7ffffec, 27 }, { 0x7ffffed, 27 },
+    { 0x7ffffee, 27 }, { 0x7ffffef, 27 }, { 0x7fffff0, 27 }, { 0x3ffffee, 26 },
+    { 0x3fffffff, 30 },
+} };
+
+static constexpr u16 huffman_eos = 256;
+
+struct HuffmanNode {
+    Array<u16, 2> children { 0, 0 };
+    u16 symbol { 0 };
+    bool is_leaf { false };
+};
+
+// Each code adds at most one node per bit, but shares the prefixes it has in common with earlier codes, so a full binary
+// tree with 257 leaves has exactly 2 * 257 - 1 nodes.
+static constexpr size_t huffman_node_count = 2 * huffman_codes.size() - 1;
+
+static constexpr Array<HuffmanNode, huffman_node_count> build_huffman_tree()
+{
+    Array<HuffmanNode, huffman_node_count> tree {};
+    size_t used_nodes = 1;
+    for (u16 symbol = 0; symbol < huffman_codes.size(); ++symbol) {
+        auto code = huffman_codes[symbol];
+        size_t node = 0;
+        for (int bit_index = code.length - 1; bit_index >= 0; --bit_index) {
+            auto bit = (code.bits >> bit_index) & 1;
+            if (tree[node].children[bit] == 0)
+                tree[node].children[bit] = used_nodes++;
+            node = tree[node].children[bit];
+        }
+        tree[node].is_leaf = true;
+        tree[node].symbol = symbol;
+    }
+    return tree;
+}
+
+static constexpr auto huffman_tree = build_huffman_tree();
+
+ErrorOr<void> encode_integer(ByteBuffer& buffer, u8 prefix_bits, u8 first_byte, u64 value)
+{
+    VERIFY(prefix_bits >= 1 && prefix_bits <= 8);
+    u64 max_prefix_value = (1u << prefix_bits) - 1;
+    if (value < max_prefix_value)
+        return buffer.try_append(static_cast<u8>(first_byte | value));
+
+    TRY(buffer.try_append(static_cast<u8>(first_byte | max_prefix_value)));
+    value -= max_prefix_value;
+    while (value >= 128) {
+        TRY(buffer.try_append(static_cast<u8>((value & 0x7f) | 0x80)));
+        value >>= 7;
+    }
+    return buffer.try_append(static_cast<u8>(value));
+}
+
+ErrorOr<u64> decode_integer(ReadonlyBytes& bytes, u8 prefix_bits)
+{
+    VERIFY(prefix_bits >= 1 && prefix_bits <= 8);
+    if (bytes.is_empty())
+        return Error::from_string_literal("HPACK: Truncated integer");
+
+    u64 max_prefix_value = (1u << prefix_bits) - 1;
+    u64 value = bytes[0] & max_prefix_value;
+    bytes = bytes.slice(1);
+    if (value < max_prefix_value)
+        return value;
+
+    // Nothing we decode is anywhere close to 2^56, so refusing longer encodings also keeps the shifts from overflowing.
+    for (u8 shift = 0; shift < 56; shift += 7) {
+        if (bytes.is_empty())
+            return Error::from_string_literal("HPACK: Truncated integer");
+        u8 byte = bytes[0];
+        bytes = bytes.slice(1);
+        value += static_cast<u64>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return value;
+    }
+    return Error::from_string_literal("HPACK: Integer is too large");
+}
+
+size_t huffman_encoded_length(ReadonlyBytes bytes)
+{
+    size_t bit_length = 0;
+    for (auto byte : bytes)
+        bit_length += huffman_codes[byte].length;
+    return (bit_length + 7) / 8;
+}
+
+ErrorOr<void> huffman_encode(ByteBuffer& buffer, ReadonlyBytes bytes)
+{
+    u64 pending_bits = 0;
+    u8 pending_bit_count = 0;
+    for (auto byte : bytes) {
+        auto code = huffman_codes[byte];
+        pending_bits = (pending_bits << code.length) | code.bits;
+        pending_bit_count += code.length;
+        while (pending_bit_count >= 8) {
+            pending_bit_count -= 8;
+            TRY(buffer.try_append(static_cast<u8>(pending_bits >> pending_bit_count)));
+        }
+    }
+
+    // Pad the last byte with the most significant bits of EOS, which are all ones.
+    if (pending_bit_count > 0) {
+        auto padding_bit_count = 8 - pending_bit_count;
+        TRY(buffer.try_append(static_cast<u8>((pending_bits << padding_bit_count) | ((1u << padding_bit_count) - 1))));
+    }
+    return {};
+}
+
+ErrorOr<ByteString> huffman_decode(ReadonlyBytes bytes)
+{
+    StringBuilder builder;
+    size_t node = 0;
+    // The bits since the last complete symbol may only be padding: fewer than 8 bits, all of them ones.
+    size_t bits_since_symbol = 0;
+    bool bits_since_symbol_are_ones = true;
+
+    for (auto byte : bytes) {
+        for (int bit_index = 7; bit_index >= 0; --bit_index) {
+            auto bit = (byte >> bit_index) & 1;
+            node = huffman_tree[node].children[bit];
+            ++bits_since_symbol;
+            bits_since_symbol_are_ones &= bit == 1;
+
+            if (!huffman_tree[node].is_leaf)
+                continue;
+            if (huffman_tree[node].symbol == huffman_eos)
+                return Error::from_string_literal("HPACK: Huffman-encoded string contains EOS");
+            TRY(builder.try_append(static_cast<char>(huffman_tree[node].symbol)));
+            node = 0;
+            bits_since_symbol = 0;
+            bits_since_symbol_are_ones = true;
+        }
+    }
+
+    if (bits_since_symbol >= 8 || !bits_since_symbol_are_ones)
+        return Error::from_string_literal("HPACK: Invalid Huffman padding");
+    return builder.to_byte_string();
+}
+
+ErrorOr<void> encode_string(ByteBuffer& buffer, StringView string, bool allow_huffman)
+{
+    if (allow_huffman) {
+        auto huffman_length = huffman_encoded_length(string.bytes());
+        if (huffman_length < string.length()) {
+            TRY(encode_integer(buffer, 7, 0x80, huffman_length));
+            return huffman_encode(buffer, string.bytes());
+        }
+    }
+
+    TRY(encode_integer(buffer, 7, 0, string.length()));
+    return buffer.try_append(string.bytes());
+}
+
+ErrorOr<ByteString> decode_string(ReadonlyBytes& bytes)
+{
+    if (bytes.is_empty())
+        return Error::from_string_literal("HPACK: Truncated string");
+
+    bool is_huffman_encoded = (bytes[0] & 0x80) != 0;
+    auto length = TRY(decode_integer(bytes, 7));
+    if (length > bytes.size())
+        return Error::from_string_literal("HPACK: Truncated string");
+
+    auto data = bytes.slice(0, length);
+    bytes = bytes.slice(length);
+    if (is_huffman_encoded)
+        return huffman_decode(data);
+    return ByteString { data };
+}
+
+void DynamicTable::add(Header header)
+{
+    auto size = entry_size(header);
+
+    // An entry that is larger than the whole table empties it, and isn't added (RFC 7541 section 4.4).
+    if (size > m_max_size) {
+        evict_until_size_is_at_most(0);
+        return;
+    }
+
+    evict_until_size_is_at_most(m_max_size - size);
+    m_entries.append(move(header));
+    m_size += size;
+}
+
+void DynamicTable::set_max_size(size_t max_size)
+{
+    m_max_size = max_size;
+    evict_until_size_is_at_most(max_size);
+}
+
+void DynamicTable::evict_until_size_is_at_most(size_t size)
+{
+    size_t evicted_entries = 0;
+    while (m_size > size) {
+        m_size -= entry_size(m_entries[evicted_entries]);
+        ++evicted_entries;
+    }
+    m_entries.remove(0, evicted_entries);
+}
+
+Optional<DynamicTable::Match> DynamicTable::find(StringView name, StringView value) const
+{
+    Optional<Match> match;
+    for (size_t index = 1; index <= m_entries.size(); ++index) {
+        auto const& header = at(index);
+        if (header.name != name)
+            continue;
+        if (header.value == value)
+            return Match { index, true };
+        if (!match.has_value())
+            match = Match { index, false };
+    }
+    return match;
+}
+
+ErrorOr<Header> Decoder::header_at(u64 index) const
+{
+    if (index == 0)
+        return Error::from_string_literal("HPACK: Invalid index 0");
+    if (index <= static_table.size()) {
+        auto const& entry = static_table[index - 1];
+        return Header { entry.name, entry.value };
+    }
+    index -= static_table.size();
+    if (index > m_table.entry_count())
+        return Error::from_string_literal("HPACK: Index is past the end of the dynamic table");
+    return m_table.at(index);
+}
+
+ErrorOr<Vector<Header>> Decoder::decode(ReadonlyBytes bytes)
+{
+    Vector<Header> headers;
+    bool may_update_table_size = true;
+
+    while (!bytes.is_empty()) {
+        u8 first_byte = bytes[0];
+
+        // Dynamic table size updates may only appear at the start of a header block (RFC 7541 section 4.2).
+        if ((first_byte & 0xe0) == 0x20) {
+            if (!may_update_table_size)
+                return Error::from_string_literal("HPACK: Dynamic table size update after the first header");
+            auto max_size = TRY(decode_integer(bytes, 5));
+            if (max_size > m_max_table_size)
+                return Error::from_string_literal("HPACK: Dynamic table size update is larger than the limit");
+            m_table.set_max_size(max_size);
+            continue;
+        }
+        may_update_table_size = false;
+
+        // Indexed header field (RFC 7541 section 6.1).
+        if (first_byte & 0x80) {
+            TRY(headers.try_append(TRY(header_at(TRY(decode_integer(bytes, 7))))));
+            continue;
+        }
+
+        // Literal header fields, with incremental indexing (section 6.2.1), without indexing (6.2.2) or never indexed (6.2.3).
+        bool add_to_table = (first_byte & 0xc0) == 0x40;
+        auto index = TRY(decode_integer(bytes, add_to_table ? 6 : 4));
+        Header header;
+        header.name = index == 0 ? TRY(decode_string(bytes)) : TRY(header_at(index)).name;
+        header.value = TRY(decode_string(bytes));
+        if (add_to_table)
+            m_table.add(header);
+        TRY(headers.try_append(move(header)));
+    }
+
+    return headers;
+}
+
+void Encoder::set_max_table_size(size_t max_size)
+{
+    m_pending_table_size_update = max_size;
+    m_smallest_table_size_update = min(max_size, m_smallest_table_size_update.value_or(max_size));
+}
+
+static bool is_sensitive_header(StringView name)
+{
+    // Indexing these would let an attacker who can make us send requests guess their values (RFC 7541 section 7.1.3).
+    return name.is_one_of("authorization"sv, "proxy-authorization"sv, "cookie"sv);
+}
+
+ErrorOr<ByteBuffer> Encoder::encode(ReadonlySpan<Header> headers)
+{
+    ByteBuffer buffer;
+
+    if (m_pending_table_size_update.has_value()) {
+        // If the size went down and back up since the last header block, the decoder must see the smallest size too.
+        if (*m_smallest_table_size_update < *m_pending_table_size_update)
+            TRY(encode_integer(buffer, 5, 0x20, *m_smallest_table_size_update));
+        TRY(encode_integer(buffer, 5, 0x20, *m_pending_table_size_update));
+        m_table.set_max_size(*m_pending_table_size_update);
+        m_pending_table_size_update.clear();
+        m_smallest_table_size_update.clear();
+    }
+
+    for (auto const& header : headers) {
+        Optional<size_t> name_index;
+        Optional<size_t> full_index;
+        for (size_t i = 0; i < static_table.size() && !full_index.has_value(); ++i) {
+            if (static_table[i].name != header.name)
+                continue;
+            if (static_table[i].value == header.value)
+                full_index = i + 1;
+            else if (!name_index.has_value())
+                name_index = i + 1;
+        }
+
+        auto sensitive = is_sensitive_header(header.name);
+        if (!full_index.has_value() && !sensitive) {
+            if (auto match = m_table.find(header.name, header.value); match.has_value()) {
+                if (match->value_matches)
+                    full_index = static_table.size() + match->index;
+                else if (!name_index.has_value())
+                    name_index = static_table.size() + match->index;
+            }
+        }
+
+        if (full_index.has_value()) {
+            TRY(encode_integer(buffer, 7, 0x80, *full_index));
+            continue;
+        }
+
+        if (sensitive)
+            TRY(encode_integer(buffer, 4, 0x10, name_index.value_or(0)));
+        else
+            TRY(encode_integer(buffer, 6, 0x40, name_index.value_or(0)));
+        if (!name_index.has_value())
+            TRY(encode_string(buffer, header.name));
+        TRY(encode_string(buffer, header.value));
+
+        if (!sensitive)
+            m_table.add(header);
+    }
+
+    return buffer;
+}
+
+}
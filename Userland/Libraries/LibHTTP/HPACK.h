@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibHTTP/Header.h>
+
+// HPACK, the header compression format of HTTP/2 (RFC 7541).
+namespace HTTP::HPACK {
+
+static constexpr size_t default_table_size = 4096;
+
+ErrorOr<void> encode_integer(ByteBuffer&, u8 prefix_bits, u8 first_byte, u64 value);
+ErrorOr<u64> decode_integer(ReadonlyBytes&, u8 prefix_bits);
+
+ErrorOr<void> encode_string(ByteBuffer&, StringView, bool allow_huffman = true);
+ErrorOr<ByteString> decode_string(ReadonlyBytes&);
+
+ErrorOr<void> huffman_encode(ByteBuffer&, ReadonlyBytes);
+ErrorOr<ByteString> huffman_decode(ReadonlyBytes);
+size_t huffman_encoded_length(ReadonlyBytes);
+
+// The table of recently used headers that each side of a connection keeps in sync with its peer (RFC 7541 section 2.3.2).
+class DynamicTable {
+public:
+    explicit DynamicTable(size_t max_size = default_table_size)
+        : m_max_size(max_size)
+    {
+    }
+
+    size_t size() const { return m_size; }
+    size_t max_size() const { return m_max_size; }
+    size_t entry_count() const { return m_entries.size(); }
+
+    // Indices start at 1 for the newest entry.
+    Header const& at(size_t index) const { return m_entries[m_entries.size() - index]; }
+
+    void add(Header);
+    void set_max_size(size_t);
+
+    // Finds the index of an entry with the given name and, if possible, the same value.
+    struct Match {
+        size_t index { 0 };
+        bool value_matches { false };
+    };
+    Optional<Match> find(StringView name, StringView value) const;
+
+private:
+    static size_t entry_size(Header const& header) { return header.name.length() + header.value.length() + 32; }
+    void evict_until_size_is_at_most(size_t);
+
+    // The oldest entry is first, so that adding an entry doesn't have to move all the others.
+    Vector<Header> m_entries;
+    size_t m_size { 0 };
+    size_t m_max_size { 0 };
+};
+
+class Decoder {
+public:
+    // The maximum size is the one we announced in our SETTINGS_HEADER_TABLE_SIZE, the encoder may only choose smaller ones.
+    explicit Decoder(size_t max_table_size = default_table_size)
+        : m_table(max_table_size)
+        , m_max_table_size(max_table_size)
+    {
+    }
+
+    ErrorOr<Vector<Header>> decode(ReadonlyBytes header_block);
+
+    DynamicTable const& table() const { return m_table; }
+
+private:
+    ErrorOr<Header> header_at(u64 index) const;
+
+    DynamicTable m_table;
+    size_t m_max_table_size { 0 };
+};
+
+class Encoder {
+public:
+    explicit Encoder(size_t max_table_size = default_table_size)
+        : m_table(max_table_size)
+    {
+    }
+
+    ErrorOr<ByteBuffer> encode(ReadonlySpan<Header>);
+
+    // Called with the SETTINGS_HEADER_TABLE_SIZE of the peer; the change is announced at the start of the next header block.
+    void set_max_table_size(size_t);
+
+    DynamicTable const& table() const { return m_table; }
+
+private:
+    DynamicTable m_table;
+    Optional<size_t> m_pending_table_size_update;
+    Optional<size_t> m_smallest_table_size_update;
+};
+
+}
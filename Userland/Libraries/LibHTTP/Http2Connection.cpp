@@ -0,0 +1,687 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Endian.h>
+#include <AK/Format.h>
+#include <LibHTTP/Http2Connection.h>
+
+namespace HTTP {
+
+namespace Flags {
+static constexpr u8 EndStream = 0x1;
+static constexpr u8 Ack = 0x1;
+static constexpr u8 EndHeaders = 0x4;
+static constexpr u8 Padded = 0x8;
+static constexpr u8 Priority = 0x20;
+}
+
+static u32 read_u32(ReadonlyBytes bytes)
+{
+    return (static_cast<u32>(bytes[0]) << 24) | (static_cast<u32>(bytes[1]) << 16) | (static_cast<u32>(bytes[2]) << 8) | bytes[3];
+}
+
+static void append_u32(ByteBuffer& buffer, u32 value)
+{
+    BigEndian<u32> big_endian_value = value;
+    buffer.append(&big_endian_value, sizeof(big_endian_value));
+}
+
+static void append_setting(ByteBuffer& buffer, u16 setting, u32 value)
+{
+    BigEndian<u16> big_endian_setting = setting;
+    buffer.append(&big_endian_setting, sizeof(big_endian_setting));
+    append_u32(buffer, value);
+}
+
+// Removes the padding from the payload of a DATA, HEADERS or PUSH_PROMISE frame (RFC 9113 section 6.1).
+static Optional<ReadonlyBytes> strip_padding(ReadonlyBytes payload, u8 flags)
+{
+    if (!(flags & Flags::Padded))
+        return payload;
+    if (payload.is_empty())
+        return {};
+    u8 padding_length = payload[0];
+    if (padding_length >= payload.size())
+        return {};
+    return payload.slice(1, payload.size() - 1 - padding_length);
+}
+
+Http2Connection::Http2Connection(Function<void(ReadonlyBytes)> on_output)
+    : m_on_output(move(on_output))
+{
+}
+
+Http2Connection::~Http2Connection() = default;
+
+void Http2Connection::start()
+{
+    m_output.append(preface.bytes());
+
+    ByteBuffer settings;
+    append_setting(settings, to_underlying(Setting::EnablePush), 0);
+    append_setting(settings, to_underlying(Setting::InitialWindowSize), stream_receive_window_size);
+    send_frame(FrameType::Settings, 0, 0, settings);
+
+    send_window_update(0, connection_receive_window_size - default_window_size);
+    flush_output();
+}
+
+bool Http2Connection::can_open_stream() const
+{
+    return can_accept_streams() && m_streams.size() < m_peer_max_concurrent_streams;
+}
+
+u32 Http2Connection::open_stream(Request request, StreamCallbacks callbacks)
+{
+    VERIFY(can_open_stream());
+
+    auto stream_id = m_next_stream_id;
+    m_next_stream_id += 2;
+
+    Vector<Header> headers;
+    headers.ensure_capacity(request.headers.size() + 4);
+    headers.unchecked_append({ ":method", move(request.method) });
+    headers.unchecked_append({ ":scheme", move(request.scheme) });
+    headers.unchecked_append({ ":authority", move(request.authority) });
+    headers.unchecked_append({ ":path", move(request.path) });
+    headers.extend(move(request.headers));
+
+    auto header_block_or_error = m_encoder.encode(headers);
+    if (header_block_or_error.is_error()) {
+        if (callbacks.on_error)
+            callbacks.on_error();
+        fail_connection({ ErrorCode::InternalError, "Failed to encode the request headers"sv });
+        flush_output();
+        return stream_id;
+    }
+    auto header_block = header_block_or_error.release_value();
+
+    auto stream = make<Stream>();
+    stream->id = stream_id;
+    stream->callbacks = move(callbacks);
+    stream->send_window = m_peer_initial_window_size;
+    stream->receive_window = stream_receive_window_size;
+    stream->body = move(request.body);
+    auto& stream_ref = *stream;
+    m_streams.set(stream_id, move(stream));
+
+    // Header blocks that don't fit in a single frame continue in CONTINUATION frames, which nothing may be sent between.
+    ReadonlyBytes remaining_block = header_block;
+    auto first_fragment = remaining_block.trim(m_peer_max_frame_size);
+    remaining_block = remaining_block.slice(first_fragment.size());
+    u8 flags = stream_ref.body.is_empty() ? Flags::EndStream : 0;
+    if (remaining_block.is_empty())
+        flags |= Flags::EndHeaders;
+    send_frame(FrameType::Headers, flags, stream_id, first_fragment);
+    while (!remaining_block.is_empty()) {
+        auto fragment = remaining_block.trim(m_peer_max_frame_size);
+        remaining_block = remaining_block.slice(fragment.size());
+        send_frame(FrameType::Continuation, remaining_block.is_empty() ? Flags::EndHeaders : 0, stream_id, fragment);
+    }
+
+    if (stream_ref.body.is_empty())
+        stream_ref.sent_end_of_stream = true;
+    else
+        send_pending_body(stream_ref);
+
+    flush_output();
+    return stream_id;
+}
+
+void Http2Connection::cancel_stream(u32 stream_id)
+{
+    auto stream = m_streams.take(stream_id);
+    if (!stream.has_value())
+        return;
+
+    send_rst_stream(stream_id, ErrorCode::Cancel);
+    flush_output();
+    if (on_stream_closed)
+        on_stream_closed();
+}
+
+void Http2Connection::receive(ReadonlyBytes bytes)
+{
+    if (m_closed)
+        return;
+
+    m_input.append(bytes);
+
+    size_t offset = 0;
+    while (!m_closed && m_input.size() - offset >= frame_header_size) {
+        auto header = m_input.bytes().slice(offset, frame_header_size);
+        u32 length = (static_cast<u32>(header[0]) << 16) | (static_cast<u32>(header[1]) << 8) | header[2];
+
+        // We never raise SETTINGS_MAX_FRAME_SIZE above its default.
+        if (length > default_max_frame_size) {
+            fail_connection({ ErrorCode::FrameSizeError, "Frame is larger than the maximum frame size"sv });
+            break;
+        }
+        if (m_input.size() - offset - frame_header_size < length)
+            break;
+
+        Frame frame {
+            .type = static_cast<FrameType>(header[3]),
+            .flags = header[4],
+            .stream_id = read_u32(header.slice(5)) & 0x7fffffff,
+            .payload = m_input.bytes().slice(offset + frame_header_size, length),
+        };
+
+        // The first frame from the server must be its SETTINGS (RFC 9113 section 3.4).
+        if (!m_received_peer_settings && (frame.type != FrameType::Settings || (frame.flags & Flags::Ack))) {
+            fail_connection({ ErrorCode::ProtocolError, "Server did not start with its settings"sv });
+            break;
+        }
+
+        if (auto result = process_frame(frame); result.is_error()) {
+            fail_connection(result.release_error());
+            break;
+        }
+        offset += frame_header_size + length;
+    }
+
+    if (m_closed)
+        m_input.clear();
+    else if (offset > 0)
+        m_input = MUST(m_input.slice(offset, m_input.size() - offset));
+
+    flush_output();
+}
+
+void Http2Connection::did_close_transport()
+{
+    if (m_closed)
+        return;
+
+    dbgln_if(HTTP2_DEBUG, "Http2Connection: Transport closed with {} open streams", m_streams.size());
+    m_closed = true;
+    fail_all_streams();
+}
+
+Http2Connection::ErrorOrConnectionError Http2Connection::process_frame(Frame const& frame)
+{
+    dbgln_if(HTTP2_DEBUG, "Http2Connection: Received frame of type {} with flags {:#x} and {} bytes on stream {}", to_underlying(frame.type), frame.flags, frame.payload.size(), frame.stream_id);
+
+    // A header block must be followed by its CONTINUATION frames, without anything in between (RFC 9113 section 6.10).
+    if (m_header_block_stream_id.has_value() && frame.type != FrameType::Continuation)
+        return ConnectionError { ErrorCode::ProtocolError, "Expected a CONTINUATION frame"sv };
+
+    switch (frame.type) {
+    case FrameType::Data:
+        return process_data_frame(frame);
+    case FrameType::Headers:
+        return process_headers_frame(frame);
+    case FrameType::Priority:
+        if (frame.stream_id == 0)
+            return ConnectionError { ErrorCode::ProtocolError, "PRIORITY frame on stream 0"sv };
+        if (frame.payload.size() != 5)
+            fail_stream(frame.stream_id, ErrorCode::FrameSizeError);
+        return {};
+    case FrameType::RstStream:
+        return process_rst_stream_frame(frame);
+    case FrameType::Settings:
+        return process_settings_frame(frame);
+    case FrameType::PushPromise:
+        // We disable server push in our settings, so the server may not send this.
+        return ConnectionError { ErrorCode::ProtocolError, "Received PUSH_PROMISE although push is disabled"sv };
+    case FrameType::Ping:
+        return process_ping_frame(frame);
+    case FrameType::GoAway:
+        return process_goaway_frame(frame);
+    case FrameType::WindowUpdate:
+        return process_window_update_frame(frame);
+    case FrameType::Continuation:
+        return process_continuation_frame(frame);
+    }
+
+    // Frames of unknown types must be ignored (RFC 9113 section 4.1).
+    return {};
+}
+
+Http2Connection::ErrorOrConnectionError Http2Connection::process_data_frame(Frame const& frame)
+{
+    if (frame.stream_id == 0)
+        return ConnectionError { ErrorCode::ProtocolError, "DATA frame on stream 0"sv };
+    if (frame.stream_id >= m_next_stream_id)
+        return ConnectionError { ErrorCode::ProtocolError, "DATA frame on an idle stream"sv };
+
+    // The whole frame counts against the windows, including the padding.
+    auto frame_size = static_cast<i64>(frame.payload.size());
+    if (frame_size > m_receive_window)
+        return ConnectionError { ErrorCode::FlowControlError, "Server exceeded the connection window"sv };
+    m_receive_window -= frame_size;
+    m_unacknowledged_received_size += frame_size;
+    if (m_unacknowledged_received_size >= connection_receive_window_size / 2) {
+        send_window_update(0, m_unacknowledged_received_size);
+        m_receive_window += m_unacknowledged_received_size;
+        m_unacknowledged_received_size = 0;
+    }
+
+    auto data = strip_padding(frame.payload, frame.flags);
+    if (!data.has_value())
+        return ConnectionError { ErrorCode::ProtocolError, "Invalid padding"sv };
+
+    // Frames for streams that we already reset can still be in flight.
+    auto* stream = find_stream(frame.stream_id);
+    if (!stream)
+        return {};
+
+    if (frame_size > stream->receive_window) {
+        fail_stream(stream->id, ErrorCode::FlowControlError);
+        return {};
+    }
+    if (!stream->received_headers) {
+        fail_stream(stream->id, ErrorCode::ProtocolError);
+        return {};
+    }
+
+    stream->receive_window -= frame_size;
+    stream->unacknowledged_received_size += frame_size;
+
+    if (!data->is_empty() && stream->callbacks.on_data) {
+        stream->callbacks.on_data(*data);
+        // The stream may have been cancelled by the callback.
+        stream = find_stream(frame.stream_id);
+        if (!stream)
+            return {};
+    }
+
+    if (frame.flags & Flags::EndStream) {
+        finish_stream(frame.stream_id);
+        return {};
+    }
+
+    // The data was handed off already, so the server can send more right away.
+    if (stream->unacknowledged_received_size >= stream_receive_window_size / 2) {
+        send_window_update(stream->id, stream->unacknowledged_received_size);
+        stream->receive_window += stream->unacknowledged_received_size;
+        stream->unacknowledged_received_size = 0;
+    }
+    return {};
+}
+
+Http2Connection::ErrorOrConnectionError Http2Connection::process_headers_frame(Frame const& frame)
+{
+    if (frame.stream_id == 0)
+        return ConnectionError { ErrorCode::ProtocolError, "HEADERS frame on stream 0"sv };
+    if (frame.stream_id >= m_next_stream_id || frame.stream_id % 2 == 0)
+        return ConnectionError { ErrorCode::ProtocolError, "HEADERS frame on a stream we didn't open"sv };
+
+    auto fragment = strip_padding(frame.payload, frame.flags);
+    if (!fragment.has_value())
+        return ConnectionError { ErrorCode::ProtocolError, "Invalid padding"sv };
+    if (frame.flags & Flags::Priority) {
+        if (fragment->size() < 5)
+            return ConnectionError { ErrorCode::FrameSizeError, "HEADERS frame is too small for its priority"sv };
+        fragment = fragment->slice(5);
+    }
+
+    m_header_block.clear();
+    m_header_block.append(*fragment);
+    m_header_block_ends_stream = frame.flags & Flags::EndStream;
+
+    if (!(frame.flags & Flags::EndHeaders)) {
+        m_header_block_stream_id = frame.stream_id;
+        return {};
+    }
+    return process_header_block(frame.stream_id, m_header_block_ends_stream);
+}
+
+Http2Connection::ErrorOrConnectionError Http2Connection::process_continuation_frame(Frame const& frame)
+{
+    if (!m_header_block_stream_id.has_value() || *m_header_block_stream_id != frame.stream_id)
+        return ConnectionError { ErrorCode::ProtocolError, "Unexpected CONTINUATION frame"sv };
+
+    m_header_block.append(frame.payload);
+    if (!(frame.flags & Flags::EndHeaders))
+        return {};
+
+    m_header_block_stream_id.clear();
+    return process_header_block(frame.stream_id, m_header_block_ends_stream);
+}
+
+Http2Connection::ErrorOrConnectionError Http2Connection::process_header_block(u32 stream_id, bool end_of_stream)
+{
+    // The block has to be decoded even if the stream is gone, to keep the compression state in sync with the server's.
+    auto headers_or_error = m_decoder.decode(m_header_block);
+    m_header_block.clear();
+    if (headers_or_error.is_error()) {
+        dbgln_if(HTTP2_DEBUG, "Http2Connection: Failed to decode header block: {}", headers_or_error.error());
+        return ConnectionError { ErrorCode::CompressionError, "Failed to decode a header block"sv };
+    }
+    auto headers = headers_or_error.release_value();
+
+    auto* stream = find_stream(stream_id);
+    if (!stream)
+        return {};
+
+    if (stream->received_headers) {
+        // A second header block can only be the trailers, which must end the stream. We don't use trailers.
+        if (!end_of_stream)
+            fail_stream(stream_id, ErrorCode::ProtocolError);
+        else
+            finish_stream(stream_id);
+        return {};
+    }
+
+    Optional<u32> status_code;
+    HeaderMap header_map;
+    for (auto& header : headers) {
+        if (header.name == ":status"sv) {
+            status_code = header.value.to_number<u32>();
+            continue;
+        }
+        if (header.name.starts_with(':')) {
+            fail_stream(stream_id, ErrorCode::ProtocolError);
+            return {};
+        }
+        header_map.set(move(header.name), move(header.value));
+    }
+
+    if (!status_code.has_value() || *status_code < 100 || *status_code > 999) {
+        fail_stream(stream_id, ErrorCode::ProtocolError);
+        return {};
+    }
+
+    // Informational responses come before the final one, and can't end the stream (RFC 9113 section 8.1).
+    if (*status_code < 200) {
+        if (end_of_stream)
+            fail_stream(stream_id, ErrorCode::ProtocolError);
+        return {};
+    }
+
+    stream->received_headers = true;
+    if (stream->callbacks.on_headers)
+        stream->callbacks.on_headers(*status_code, move(header_map));
+
+    if (end_of_stream)
+        finish_stream(stream_id);
+    return {};
+}
+
+Http2Connection::ErrorOrConnectionError Http2Connection::process_rst_stream_frame(Frame const& frame)
+{
+    if (frame.stream_id == 0)
+        return ConnectionError { ErrorCode::ProtocolError, "RST_STREAM frame on stream 0"sv };
+    if (frame.payload.size() != 4)
+        return ConnectionError { ErrorCode::FrameSizeError, "RST_STREAM frame has the wrong size"sv };
+
+    dbgln_if(HTTP2_DEBUG, "Http2Connection: Server reset stream {} with error code {}", frame.stream_id, read_u32(frame.payload));
+    fail_stream(frame.stream_id, {});
+    return {};
+}
+
+Http2Connection::ErrorOrConnectionError Http2Connection::process_settings_frame(Frame const& frame)
+{
+    if (frame.stream_id != 0)
+        return ConnectionError { ErrorCode::ProtocolError, "SETTINGS frame on a stream"sv };
+
+    if (frame.flags & Flags::Ack) {
+        if (!frame.payload.is_empty())
+            return ConnectionError { ErrorCode::FrameSizeError, "SETTINGS acknowledgement with a payload"sv };
+        return {};
+    }
+
+    if (frame.payload.size() % 6 != 0)
+        return ConnectionError { ErrorCode::FrameSizeError, "SETTINGS frame has the wrong size"sv };
+
+    for (size_t offset = 0; offset < frame.payload.size(); offset += 6) {
+        auto setting = static_cast<Setting>((frame.payload[offset] << 8) | frame.payload[offset + 1]);
+        auto value = read_u32(frame.payload.slice(offset + 2));
+
+        switch (setting) {
+        case Setting::HeaderTableSize:
+            // We never need a larger table than the default to compress requests well.
+            m_encoder.set_max_table_size(min(value, HPACK::default_table_size));
+            break;
+        case Setting::EnablePush:
+            if (value > 1)
+                return ConnectionError { ErrorCode::ProtocolError, "Invalid SETTINGS_ENABLE_PUSH"sv };
+            break;
+        case Setting::MaxConcurrentStreams:
+            m_peer_max_concurrent_streams = value;
+            break;
+        case Setting::InitialWindowSize: {
+            if (value > max_window_size)
+                return ConnectionError { ErrorCode::FlowControlError, "Invalid SETTINGS_INITIAL_WINDOW_SIZE"sv };
+            // The change applies to the windows of all open streams too (RFC 9113 section 6.9.2).
+            i64 delta = static_cast<i64>(value) - static_cast<i64>(m_peer_initial_window_size);
+            for (auto& it : m_streams) {
+                it.value->send_window += delta;
+                if (it.value->send_window > max_window_size)
+                    return ConnectionError { ErrorCode::FlowControlError, "SETTINGS_INITIAL_WINDOW_SIZE overflows a window"sv };
+            }
+            m_peer_initial_window_size = value;
+            break;
+        }
+        case Setting::MaxFrameSize:
+            if (value < default_max_frame_size || value > 0xffffff)
+                return ConnectionError { ErrorCode::ProtocolError, "Invalid SETTINGS_MAX_FRAME_SIZE"sv };
+            m_peer_max_frame_size = value;
+            break;
+        case Setting::MaxHeaderListSize:
+            break;
+        default:
+            // Unknown settings must be ignored.
+            break;
+        }
+    }
+
+    m_received_peer_settings = true;
+    send_frame(FrameType::Settings, Flags::Ack, 0, {});
+    send_pending_bodies();
+    return {};
+}
+
+Http2Connection::ErrorOrConnectionError Http2Connection::process_ping_frame(Frame const& frame)
+{
+    if (frame.stream_id != 0)
+        return ConnectionError { ErrorCode::ProtocolError, "PING frame on a stream"sv };
+    if (frame.payload.size() != 8)
+        return ConnectionError { ErrorCode::FrameSizeError, "PING frame has the wrong size"sv };
+
+    if (!(frame.flags & Flags::Ack))
+        send_frame(FrameType::Ping, Flags::Ack, 0, frame.payload);
+    return {};
+}
+
+Http2Connection::ErrorOrConnectionError Http2Connection::process_goaway_frame(Frame const& frame)
+{
+    if (frame.stream_id != 0)
+        return ConnectionError { ErrorCode::ProtocolError, "GOAWAY frame on a stream"sv };
+    if (frame.payload.size() < 8)
+        return ConnectionError { ErrorCode::FrameSizeError, "GOAWAY frame is too small"sv };
+
+    auto last_stream_id = read_u32(frame.payload) & 0x7fffffff;
+    dbgln_if(HTTP2_DEBUG, "Http2Connection: Server is going away after stream {} with error code {}", last_stream_id, read_u32(frame.payload.slice(4)));
+    m_going_away = true;
+
+    // The server won't process the streams after the last one, but the ones before it still complete.
+    Vector<u32> unprocessed_stream_ids;
+    for (auto& it : m_streams) {
+        if (it.key > last_stream_id)
+            unprocessed_stream_ids.append(it.key);
+    }
+    for (auto stream_id : unprocessed_stream_ids)
+        fail_stream(stream_id, {});
+    return {};
+}
+
+Http2Connection::ErrorOrConnectionError Http2Connection::process_window_update_frame(Frame const& frame)
+{
+    if (frame.payload.size() != 4)
+        return ConnectionError { ErrorCode::FrameSizeError, "WINDOW_UPDATE frame has the wrong size"sv };
+
+    auto increment = read_u32(frame.payload) & 0x7fffffff;
+
+    if (frame.stream_id == 0) {
+        if (increment == 0)
+            return ConnectionError { ErrorCode::ProtocolError, "WINDOW_UPDATE with an increment of 0"sv };
+        m_send_window += increment;
+        if (m_send_window > max_window_size)
+            return ConnectionError { ErrorCode::FlowControlError, "WINDOW_UPDATE overflows the connection window"sv };
+        send_pending_bodies();
+        return {};
+    }
+
+    auto* stream = find_stream(frame.stream_id);
+    if (!stream)
+        return {};
+    if (increment == 0) {
+        fail_stream(stream->id, ErrorCode::ProtocolError);
+        return {};
+    }
+    stream->send_window += increment;
+    if (stream->send_window > max_window_size) {
+        fail_stream(stream->id, ErrorCode::FlowControlError);
+        return {};
+    }
+    send_pending_body(*stream);
+    return {};
+}
+
+void Http2Connection::send_frame(FrameType type, u8 flags, u32 stream_id, ReadonlyBytes payload)
+{
+    VERIFY(payload.size() <= 0xffffff);
+    u8 header[frame_header_size] = {
+        static_cast<u8>(payload.size() >> 16),
+        static_cast<u8>(payload.size() >> 8),
+        static_cast<u8>(payload.size()),
+        to_underlying(type),
+        flags,
+        static_cast<u8>(stream_id >> 24),
+        static_cast<u8>(stream_id >> 16),
+        static_cast<u8>(stream_id >> 8),
+        static_cast<u8>(stream_id),
+    };
+    m_output.append(header, sizeof(header));
+    m_output.append(payload);
+}
+
+void Http2Connection::send_window_update(u32 stream_id, u32 increment)
+{
+    ByteBuffer payload;
+    append_u32(payload, increment);
+    send_frame(FrameType::WindowUpdate, 0, stream_id, payload);
+}
+
+void Http2Connection::send_rst_stream(u32 stream_id, ErrorCode code)
+{
+    ByteBuffer payload;
+    append_u32(payload, to_underlying(code));
+    send_frame(FrameType::RstStream, 0, stream_id, payload);
+}
+
+void Http2Connection::send_pending_bodies()
+{
+    for (auto& it : m_streams) {
+        if (m_send_window <= 0)
+            break;
+        send_pending_body(*it.value);
+    }
+}
+
+void Http2Connection::send_pending_body(Stream& stream)
+{
+    while (!stream.sent_end_of_stream) {
+        auto remaining = stream.body.size() - stream.sent_body_size;
+        auto window = min(min(m_send_window, stream.send_window), static_cast<i64>(m_peer_max_frame_size));
+        if (window <= 0)
+            return;
+
+        auto chunk_size = min(remaining, static_cast<size_t>(window));
+        auto is_last_chunk = chunk_size == remaining;
+        send_frame(FrameType::Data, is_last_chunk ? Flags::EndStream : 0, stream.id, stream.body.bytes().slice(stream.sent_body_size, chunk_size));
+        stream.sent_body_size += chunk_size;
+        m_send_window -= chunk_size;
+        stream.send_window -= chunk_size;
+
+        if (is_last_chunk) {
+            stream.sent_end_of_stream = true;
+            stream.body.clear();
+        }
+    }
+}
+
+void Http2Connection::flush_output()
+{
+    if (m_output.is_empty())
+        return;
+
+    auto output = move(m_output);
+    m_output = {};
+    m_on_output(output);
+}
+
+Http2Connection::Stream* Http2Connection::find_stream(u32 stream_id)
+{
+    auto it = m_streams.find(stream_id);
+    if (it == m_streams.end())
+        return nullptr;
+    return it->value.ptr();
+}
+
+void Http2Connection::finish_stream(u32 stream_id)
+{
+    auto stream = m_streams.take(stream_id);
+    if (!stream.has_value())
+        return;
+
+    // If the server responded before reading the whole request, it doesn't want the rest of it (RFC 9113 section 8.1).
+    if (!(*stream)->sent_end_of_stream)
+        send_rst_stream(stream_id, ErrorCode::NoError);
+
+    if ((*stream)->callbacks.on_complete)
+        (*stream)->callbacks.on_complete();
+    if (on_stream_closed)
+        on_stream_closed();
+}
+
+void Http2Connection::fail_stream(u32 stream_id, Optional<ErrorCode> code_to_send)
+{
+    auto stream = m_streams.take(stream_id);
+    if (code_to_send.has_value())
+        send_rst_stream(stream_id, *code_to_send);
+    if (!stream.has_value())
+        return;
+
+    if ((*stream)->callbacks.on_error)
+        (*stream)->callbacks.on_error();
+    if (on_stream_closed)
+        on_stream_closed();
+}
+
+void Http2Connection::fail_connection(ConnectionError error)
+{
+    if (m_closed)
+        return;
+
+    dbgln("Http2Connection: Closing the connection with error code {}: {}", to_underlying(error.code), error.reason);
+
+    ByteBuffer payload;
+    // We never accept streams from the server, so the last stream we processed is always 0.
+    append_u32(payload, 0);
+    append_u32(payload, to_underlying(error.code));
+    send_frame(FrameType::GoAway, 0, 0, payload);
+
+    m_closed = true;
+    fail_all_streams();
+}
+
+void Http2Connection::fail_all_streams()
+{
+    auto streams = move(m_streams);
+    m_streams.clear();
+    for (auto& it : streams) {
+        if (it.value->callbacks.on_error)
+            it.value->callbacks.on_error();
+    }
+    if (on_stream_closed)
+        on_stream_closed();
+}
+
+}
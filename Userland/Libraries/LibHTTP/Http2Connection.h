@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <AK/Weakable.h>
+#include <LibHTTP/HPACK.h>
+#include <LibHTTP/Header.h>
+#include <LibHTTP/HeaderMap.h>
+
+namespace HTTP {
+
+// The client side of an HTTP/2 connection (RFC 9113), which runs any number of requests at the same time as streams over
+// a single transport. It doesn't do any I/O itself: the bytes read from the transport are passed to receive(), and the
+// bytes to send to the server are passed to on_output.
+class Http2Connection : public Weakable<Http2Connection> {
+    AK_MAKE_NONCOPYABLE(Http2Connection);
+    AK_MAKE_NONMOVABLE(Http2Connection);
+
+public:
+    struct Request {
+        ByteString method;
+        ByteString scheme;
+        ByteString authority;
+        ByteString path;
+        // Names must be in lowercase, and connection-specific headers (like Connection or Transfer-Encoding) are not allowed.
+        Vector<Header> headers;
+        ByteBuffer body;
+    };
+
+    // A stream ends with either on_complete or on_error, after which none of its callbacks are called again.
+    struct StreamCallbacks {
+        Function<void(u32 status_code, HeaderMap)> on_headers;
+        Function<void(ReadonlyBytes)> on_data;
+        Function<void()> on_complete;
+        Function<void()> on_error;
+    };
+
+    enum class ErrorCode : u32 {
+        NoError = 0x0,
+        ProtocolError = 0x1,
+        InternalError = 0x2,
+        FlowControlError = 0x3,
+        SettingsTimeout = 0x4,
+        StreamClosed = 0x5,
+        FrameSizeError = 0x6,
+        RefusedStream = 0x7,
+        Cancel = 0x8,
+        CompressionError = 0x9,
+        ConnectError = 0xa,
+        EnhanceYourCalm = 0xb,
+        InadequateSecurity = 0xc,
+        Http11Required = 0xd,
+    };
+
+    static constexpr StringView preface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"sv;
+    static constexpr size_t frame_header_size = 9;
+    static constexpr u32 default_window_size = 65535;
+    static constexpr u32 max_window_size = 0x7fffffff;
+    static constexpr u32 max_stream_id = 0x7fffffff;
+    static constexpr u32 default_max_frame_size = 16384;
+
+    // The windows we give the server. They are much larger than the default, so that a single response can use the full
+    // bandwidth of a fast connection with some latency, and so that slow streams can't stall the others.
+    static constexpr u32 stream_receive_window_size = 1 * MiB;
+    static constexpr u32 connection_receive_window_size = 16 * MiB;
+
+    // Until the server tells us how many streams it allows, we assume the minimum that RFC 9113 section 6.5.2 recommends.
+    static constexpr u32 default_max_concurrent_streams = 100;
+
+    explicit Http2Connection(Function<void(ReadonlyBytes)> on_output);
+    ~Http2Connection();
+
+    // Sends the connection preface and our settings. This has to be called before anything else.
+    void start();
+
+    bool is_closed() const { return m_closed; }
+    // Whether streams can still be opened, either now or once some of the open ones are done.
+    bool can_accept_streams() const { return !m_closed && !m_going_away && m_next_stream_id <= max_stream_id; }
+    bool can_open_stream() const;
+    size_t open_stream_count() const { return m_streams.size(); }
+
+    // Returns the ID of the new stream.
+    u32 open_stream(Request, StreamCallbacks);
+    void cancel_stream(u32 stream_id);
+
+    void receive(ReadonlyBytes);
+
+    // Fails all open streams, as the transport can't be used anymore.
+    void did_close_transport();
+
+    // Called whenever a stream ends (or the connection is closed), so that the owner can open waiting streams.
+    Function<void()> on_stream_closed;
+
+private:
+    enum class FrameType : u8 {
+        Data = 0x0,
+        Headers = 0x1,
+        Priority = 0x2,
+        RstStream = 0x3,
+        Settings = 0x4,
+        PushPromise = 0x5,
+        Ping = 0x6,
+        GoAway = 0x7,
+        WindowUpdate = 0x8,
+        Continuation = 0x9,
+    };
+
+    enum class Setting : u16 {
+        HeaderTableSize = 0x1,
+        EnablePush = 0x2,
+        MaxConcurrentStreams = 0x3,
+        InitialWindowSize = 0x4,
+        MaxFrameSize = 0x5,
+        MaxHeaderListSize = 0x6,
+    };
+
+    struct Frame {
+        FrameType type;
+        u8 flags { 0 };
+        u32 stream_id { 0 };
+        ReadonlyBytes payload;
+    };
+
+    struct ConnectionError {
+        ErrorCode code;
+        StringView reason;
+    };
+    using ErrorOrConnectionError = ErrorOr<void, ConnectionError>;
+
+    struct Stream {
+        u32 id { 0 };
+        StreamCallbacks callbacks;
+        bool received_headers { false };
+
+        i64 send_window { 0 };
+        ByteBuffer body;
+        size_t sent_body_size { 0 };
+        bool sent_end_of_stream { false };
+
+        i64 receive_window { 0 };
+        u32 unacknowledged_received_size { 0 };
+    };
+
+    ErrorOrConnectionError process_frame(Frame const&);
+    ErrorOrConnectionError process_data_frame(Frame const&);
+    ErrorOrConnectionError process_headers_frame(Frame const&);
+    ErrorOrConnectionError process_continuation_frame(Frame const&);
+    ErrorOrConnectionError process_header_block(u32 stream_id, bool end_of_stream);
+    ErrorOrConnectionError process_rst_stream_frame(Frame const&);
+    ErrorOrConnectionError process_settings_frame(Frame const&);
+    ErrorOrConnectionError process_ping_frame(Frame const&);
+    ErrorOrConnectionError process_goaway_frame(Frame const&);
+    ErrorOrConnectionError process_window_update_frame(Frame const&);
+
+    void send_frame(FrameType, u8 flags, u32 stream_id, ReadonlyBytes payload);
+    void send_window_update(u32 stream_id, u32 increment);
+    void send_rst_stream(u32 stream_id, ErrorCode);
+    void send_pending_bodies();
+    void send_pending_body(Stream&);
+    void flush_output();
+
+    Stream* find_stream(u32 stream_id);
+    void finish_stream(u32 stream_id);
+    void fail_stream(u32 stream_id, Optional<ErrorCode> code_to_send);
+    void fail_connection(ConnectionError);
+    void fail_all_streams();
+
+    Function<void(ReadonlyBytes)> m_on_output;
+    ByteBuffer m_output;
+    ByteBuffer m_input;
+    bool m_closed { false };
+    bool m_going_away { false };
+    bool m_received_peer_settings { false };
+
+    HashMap<u32, NonnullOwnPtr<Stream>> m_streams;
+    u32 m_next_stream_id { 1 };
+
+    HPACK::Encoder m_encoder;
+    HPACK::Decoder m_decoder;
+
+    // A header block that is split over HEADERS and CONTINUATION frames.
+    Optional<u32> m_header_block_stream_id;
+    bool m_header_block_ends_stream { false };
+    ByteBuffer m_header_block;
+
+    // The settings of the server, which limit what we send.
+    u32 m_peer_max_concurrent_streams { default_max_concurrent_streams };
+    u32 m_peer_initial_window_size { default_window_size };
+    u32 m_peer_max_frame_size { default_max_frame_size };
+
+    i64 m_send_window { default_window_size };
+    i64 m_receive_window { connection_receive_window_size };
+    u32 m_unacknowledged_received_size { 0 };
+};
+
+}
@@ -9,14 +9,15 @@
 #include <AK/AsyncStreamTransform.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
-#include <AK/GenericAwaiter.h>
 #include <AK/MemMem.h>
 #include <AK/MemoryStream.h>
 #include <AK/StreamBuffer.h>
+#include <AK/StringBuilder.h>
 #include <AK/Try.h>
 #include <LibCompress/Brotli.h>
 #include <LibCompress/Gzip.h>
 #include <LibCompress/Zlib.h>
+#include <LibCore/AsyncSocketStream.h>
 #include <LibCore/Event.h>
 #include <LibCore/EventLoop.h>
 #include <LibHTTP/HttpResponse.h>
@@ -26,66 +27,10 @@
 
 namespace HTTP {
 
-template<typename Stream>
-struct SyncStreamAsyncWrapper final : public AsyncInputStream {
-    explicit SyncStreamAsyncWrapper(MaybeOwned<Stream>&& stream)
-        : m_stream(move(stream))
-        , m_awaiter(GenericAwaiter { [&](auto cb) { m_stream->on_ready_to_read = move(cb); } })
-    {
-    }
-
-    ~SyncStreamAsyncWrapper()
-    {
-        m_stream->on_ready_to_read = nullptr;
-    }
-
-    virtual void reset() override
-    {
-    }
-
-    virtual Coroutine<ErrorOr<void>> close() override
-    {
-        if (m_stream->is_open())
-            m_stream->close();
-        co_return {};
-    }
-
-    virtual bool is_open() const override
-    {
-        return !m_stream->is_eof() || !m_buffer.is_empty();
-    }
-
-    virtual Coroutine<ErrorOr<bool>> enqueue_some(Badge<AsyncInputStream>) override
-    {
-        CO_TRY(co_await m_awaiter);
-        auto buffer = AK::Detail::ByteBuffer<16 * KiB> {};
-        auto bytes = CO_TRY(m_stream->read_some(buffer.must_get_bytes_for_writing(16 * KiB)));
-        if (bytes.is_empty())
-            co_return !m_stream->is_eof();
-        m_buffer.append(bytes);
-        co_return true;
-    }
-
-    virtual ReadonlyBytes buffered_data_unchecked(Badge<AsyncInputStream>) const override
-    {
-        return m_buffer.data();
-    }
-
-    virtual void dequeue(Badge<AsyncInputStream>, size_t bytes) override
-    {
-        m_buffer.dequeue(bytes);
-    }
-
-    Coroutine<ErrorOr<StringView>> read_line(size_t max_size)
-    {
-        co_return StringView { CO_TRY(co_await AsyncStreamHelpers::consume_until(*this, "\r\n"sv, max_size)) }.trim("\r\n"sv, TrimMode::Right);
-    }
-
-private:
-    MaybeOwned<Stream> m_stream;
-    GenericAwaiter m_awaiter;
-    StreamBuffer m_buffer;
-};
+static Coroutine<ErrorOr<StringView>> read_line(AsyncInputStream& stream, size_t max_size)
+{
+    co_return StringView { CO_TRY(co_await AsyncStreamHelpers::consume_until(stream, "\r\n"sv, max_size)) }.trim("\r\n"sv, TrimMode::Right);
+}
 
 static ErrorOr<ByteBuffer> handle_content_encoding(ByteBuffer const& buf, ByteString const& content_encoding)
 {
@@ -173,8 +118,105 @@ void Job::start(Core::BufferedSocketBase& socket)
     });
 }
 
+static ErrorOr<Http2Connection::Request> to_http2_request(HttpRequest const& request)
+{
+    auto const& url = request.url();
+
+    StringBuilder path;
+    TRY(path.try_append(url.serialize_path()));
+    if (url.query().has_value()) {
+        TRY(path.try_append('?'));
+        TRY(path.try_append(*url.query()));
+    }
+
+    StringBuilder authority;
+    TRY(authority.try_append(TRY(url.serialized_host())));
+    if (url.port().has_value())
+        TRY(authority.try_appendff(":{}", *url.port()));
+
+    Vector<Header> headers;
+    bool has_content_length = false;
+    for (auto const& [name, value] : request.headers().headers()) {
+        auto lowercase_name = name.to_lowercase();
+        // Connection-specific headers don't exist in HTTP/2, and Host is replaced by :authority (RFC 9113 section 8.2.2).
+        if (lowercase_name.is_one_of("connection"sv, "keep-alive"sv, "proxy-connection"sv, "transfer-encoding"sv, "upgrade"sv, "host"sv))
+            continue;
+        if (lowercase_name == "te"sv && !value.equals_ignoring_ascii_case("trailers"sv))
+            continue;
+        has_content_length |= lowercase_name == "content-length"sv;
+        TRY(headers.try_append({ move(lowercase_name), value }));
+    }
+    if (!has_content_length && (!request.body().is_empty() || request.method() == HttpRequest::Method::POST))
+        TRY(headers.try_append({ "content-length", ByteString::number(request.body().size()) }));
+
+    return Http2Connection::Request {
+        .method = request.method_name(),
+        .scheme = url.scheme().to_byte_string(),
+        .authority = authority.to_byte_string(),
+        .path = path.to_byte_string(),
+        .headers = move(headers),
+        .body = TRY(ByteBuffer::copy(request.body())),
+    };
+}
+
+void Job::start(Http2Connection& connection)
+{
+    VERIFY(!m_socket && !m_http2_connection);
+    dbgln_if(HTTPJOB_DEBUG, "Starting request for {} as an HTTP/2 stream", url());
+
+    auto request = to_http2_request(m_request);
+    if (request.is_error()) {
+        dbgln("Job: Failed to create HTTP/2 request: {}", request.error());
+        deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
+        return;
+    }
+
+    // The callbacks keep the job alive until the stream is done.
+    m_http2_connection = connection;
+    m_http2_stream_id = connection.open_stream(request.release_value(),
+        {
+            .on_headers = [this, protect = NonnullRefPtr { *this }](u32 status_code, HeaderMap headers) {
+                m_code = status_code;
+                if (auto content_length = headers.get("Content-Length"sv); content_length.has_value())
+                    m_content_length = content_length->to_number<u64>();
+                // Assume that any content-encoding means that we can't decode it as a stream :(
+                if (headers.contains("Content-Encoding"sv))
+                    m_can_stream_response = false;
+                m_headers = move(headers);
+                if (on_headers_received)
+                    on_headers_received(m_headers, m_code);
+            },
+            .on_data = [this, protect = NonnullRefPtr { *this }](ReadonlyBytes data) {
+                auto buffer = ByteBuffer::copy(data);
+                if (buffer.is_error()) {
+                    shutdown(ShutdownMode::DetachFromSocket);
+                    deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
+                    return;
+                }
+                m_received_buffers.append(make<ReceivedBuffer>(buffer.release_value()));
+                m_buffered_size += data.size();
+                m_received_size += data.size();
+                Core::EventLoop::current().adopt_coroutine(flush_received_buffers());
+                deferred_invoke([this] { did_progress(m_content_length, m_received_size); });
+            },
+            .on_complete = [this, protect = NonnullRefPtr { *this }] {
+                Core::EventLoop::current().adopt_coroutine(finish_up());
+            },
+            .on_error = [this, protect = NonnullRefPtr { *this }] {
+                dbgln("Job: HTTP/2 stream for {} failed", url());
+                deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
+            },
+        });
+}
+
 void Job::shutdown(ShutdownMode mode)
 {
+    if (m_http2_connection) {
+        // The connection is shared with other requests, so only this stream is closed.
+        m_http2_connection->cancel_stream(m_http2_stream_id);
+        m_http2_connection = nullptr;
+        return;
+    }
     if (!m_socket)
         return;
     if (mode == ShutdownMode::CloseSocket) {
@@ -227,7 +269,7 @@ Coroutine<void> Job::flush_received_buffers()
 
 auto Job::parse_status(auto& stream) -> Coroutine<ErrorOr<void>>
 {
-    auto line = CO_TRY(co_await stream.read_line(PAGE_SIZE));
+    auto line = CO_TRY(co_await read_line(stream, PAGE_SIZE));
 
     dbgln_if(JOB_DEBUG, "Job {} read line of length {}", m_request.url(), line.length());
     auto parts = line.split_view(' ');
@@ -260,7 +302,7 @@ auto Job::parse_headers(auto& stream, bool in_trailers) -> Coroutine<ErrorOr<voi
 {
     while (true) {
         // There's no max limit defined on headers, but for our sanity, let's limit it to 32K.
-        auto line = StringView { CO_TRY(co_await stream.read_line(32 * KiB)) };
+        auto line = StringView { CO_TRY(co_await read_line(stream, 32 * KiB)) };
 
         if (line.is_empty()) {
             if (in_trailers) {
@@ -345,7 +387,7 @@ auto Job::parse_body(auto& stream) -> Coroutine<ErrorOr<bool>>
             auto remaining = m_current_chunk_remaining_size.value();
             if (remaining == -1) {
                 // read size
-                auto size_data = CO_TRY(co_await stream.read_line(PAGE_SIZE));
+                auto size_data = CO_TRY(co_await read_line(stream, PAGE_SIZE));
                 if (m_should_read_chunk_ending_line) {
                     // NOTE: Some servers seem to send an extra \r\n here despite there being no size.
                     //       This makes us tolerate that.
@@ -472,7 +514,7 @@ auto Job::parse_body(auto& stream) -> Coroutine<ErrorOr<bool>>
                 // we've read everything, now let's get the next chunk
                 size = -1;
 
-                auto line = CO_TRY(co_await stream.read_line(PAGE_SIZE));
+                auto line = CO_TRY(co_await read_line(stream, PAGE_SIZE));
                 VERIFY(line.is_empty());
             }
             m_current_chunk_remaining_size = size;
@@ -481,10 +523,8 @@ auto Job::parse_body(auto& stream) -> Coroutine<ErrorOr<bool>>
     co_return should_read_trailers;
 }
 
-auto Job::read_response() -> Coroutine<ErrorOr<void>>
+auto Job::read_response(AsyncInputStream& stream) -> Coroutine<ErrorOr<void>>
 {
-    auto stream = SyncStreamAsyncWrapper(MaybeOwned { *m_socket });
-
     if (is_cancelled())
         co_return {};
 
@@ -525,16 +565,25 @@ void Job::on_socket_connected()
         dbgln("{}", ByteString::copy(raw_request));
     }
 
-    if (m_socket->write_until_depleted(raw_request).is_error())
-        return deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
+    Core::EventLoop::current().adopt_coroutine(send_request_and_read_response(move(raw_request)));
+}
 
-    Core::EventLoop::current().adopt_coroutine([this] mutable -> Coroutine<void> {
-        auto result = co_await read_response();
-        if (result.is_error()) {
-            dbgln("Job: Failed to read response: {}", result.error());
-            did_fail(Core::NetworkJob::Error::TransmissionFailed);
-        }
-    }());
+Coroutine<void> Job::send_request_and_read_response(ByteBuffer raw_request)
+{
+    Core::AsyncSocketStream stream { MaybeOwned<Core::Socket> { *m_socket } };
+
+    Array<ReadonlyBytes, 1> request_buffers { raw_request.bytes() };
+    if (auto result = co_await stream.write(request_buffers); result.is_error()) {
+        dbgln("Job: Failed to send request: {}", result.error());
+        deferred_invoke([this] { did_fail(Core::NetworkJob::Error::TransmissionFailed); });
+        co_return;
+    }
+
+    auto result = co_await read_response(stream);
+    if (result.is_error()) {
+        dbgln("Job: Failed to read response: {}", result.error());
+        did_fail(Core::NetworkJob::Error::TransmissionFailed);
+    }
 }
 
 Coroutine<void> Job::finish_up()
@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include <AK/AsyncStream.h>
 #include <AK/HashMap.h>
 #include <AK/Optional.h>
+#include <AK/WeakPtr.h>
 #include <LibCore/NetworkJob.h>
 #include <LibCore/Socket.h>
+#include <LibHTTP/Http2Connection.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibHTTP/HttpResponse.h>
 
@@ -23,6 +26,8 @@ public:
     virtual ~Job() override = default;
 
     virtual void start(Core::BufferedSocketBase&) override;
+    // Runs the request as a stream of an HTTP/2 connection, which other requests may be using at the same time.
+    void start(Http2Connection&);
     virtual void shutdown(ShutdownMode) override;
 
     Core::Socket const* socket() const { return m_socket; }
@@ -35,7 +40,8 @@ private:
     auto parse_status(auto& stream) -> Coroutine<ErrorOr<void>>;
     auto parse_headers(auto& stream, bool in_trailers) -> Coroutine<ErrorOr<void>>;
     auto parse_body(auto& stream) -> Coroutine<ErrorOr<bool>>;
-    auto read_response() -> Coroutine<ErrorOr<void>>;
+    auto read_response(AsyncInputStream&) -> Coroutine<ErrorOr<void>>;
+    Coroutine<void> send_request_and_read_response(ByteBuffer raw_request);
 
 protected:
     Coroutine<void> finish_up();
@@ -44,6 +50,8 @@ protected:
 
     HttpRequest m_request;
     Core::BufferedSocketBase* m_socket { nullptr };
+    WeakPtr<Http2Connection> m_http2_connection;
+    u32 m_http2_stream_id { 0 };
     bool m_legacy_connection { false };
     int m_code { -1 };
     HTTP::HeaderMap m_headers;
@@ -5,17 +5,25 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ByteReader.h>
+#include <AK/Debug.h>
+#include <AK/QuickSort.h>
 #include <AK/Vector.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Socket.h>
+#include <LibCore/System.h>
 #include <LibCore/Timer.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/Message.h>
+#include <LibIPC/SharedMemoryRing.h>
 #include <LibIPC/Stub.h>
 #include <sys/select.h>
+#include <sys/socket.h>
 
 namespace IPC {
 
+static constexpr int message_statistics_interval_ms = 10'000;
+
 struct CoreEventLoopDeferredInvoker final : public DeferredInvoker {
     virtual ~CoreEventLoopDeferredInvoker() = default;
 
@@ -32,6 +40,10 @@ ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalS
     , m_deferred_invoker(make<CoreEventLoopDeferredInvoker>())
 {
     m_responsiveness_timer = Core::Timer::create_single_shot(3000, [this] { may_have_become_unresponsive(); });
+    if constexpr (IPC_MESSAGE_STATISTICS_DEBUG) {
+        m_message_statistics_timer = Core::Timer::create_repeating(message_statistics_interval_ms, [this] { dump_message_statistics(); });
+        m_message_statistics_timer->start();
+    }
     m_socket->on_ready_to_read = [this] {
         NonnullRefPtr protect = *this;
         // FIXME: Do something about errors.
@@ -42,6 +54,30 @@ ConnectionBase::ConnectionBase(IPC::Stub& local_stub, NonnullOwnPtr<Core::LocalS
 
 ConnectionBase::~ConnectionBase() = default;
 
+static void dump_message_statistics_for(StringView direction, HashMap<StringView, ConnectionBase::MessageStatistics>& statistics)
+{
+    Vector<StringView> message_names;
+    for (auto const& it : statistics)
+        message_names.append(it.key);
+    quick_sort(message_names, [&](auto a, auto b) { return statistics.get(a)->count > statistics.get(b)->count; });
+
+    for (auto message_name : message_names) {
+        auto const& entry = *statistics.get(message_name);
+        dbgln("    {} {}: {} messages ({}/s), {} bytes", direction, message_name, entry.count, entry.count * 1000 / message_statistics_interval_ms, entry.bytes);
+    }
+    statistics.clear();
+}
+
+void ConnectionBase::dump_message_statistics()
+{
+    if (m_sent_message_statistics.is_empty() && m_received_message_statistics.is_empty())
+        return;
+
+    dbgln("IPC::ConnectionBase ({:p}) messages in the last {} ms:", this, message_statistics_interval_ms);
+    dump_message_statistics_for("sent"sv, m_sent_message_statistics);
+    dump_message_statistics_for("received"sv, m_received_message_statistics);
+}
+
 bool ConnectionBase::is_open() const
 {
     return m_socket->is_open();
@@ -54,7 +90,10 @@ void ConnectionBase::set_deferred_invoker(NonnullOwnPtr<DeferredInvoker> deferre
 
 ErrorOr<void> ConnectionBase::post_message(Message const& message, MessageKind kind)
 {
-    return post_message(TRY(message.encode()), kind);
+    auto buffer = TRY(message.encode());
+    if constexpr (IPC_MESSAGE_STATISTICS_DEBUG)
+        m_sent_message_statistics.ensure(StringView { message.message_name(), strlen(message.message_name()) }).add(buffer.size());
+    return post_message(move(buffer), kind);
 }
 
 ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer, MessageKind kind)
@@ -64,7 +103,22 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer, MessageKind kin
     if (!m_socket->is_open())
         return Error::from_string_literal("Trying to post_message during IPC shutdown");
 
-    if (auto result = buffer.transfer_message(*m_socket, kind == MessageKind::Sync); result.is_error()) {
+    if (m_message_batching_enabled) {
+        // Messages with file descriptors are sent right away, so that a batch never has too many of them for one write.
+        static constexpr size_t max_batched_message_size = 16 * KiB;
+        if (kind == MessageKind::Async && !buffer.has_file_descriptors() && buffer.size() <= max_batched_message_size)
+            return batch_message(move(buffer));
+
+        // Keep the messages in order.
+        TRY(flush_batched_messages());
+    }
+
+    return send_message(buffer, kind);
+}
+
+ErrorOr<void> ConnectionBase::send_message(MessageBuffer& buffer, MessageKind kind)
+{
+    if (auto result = transfer_message(buffer, kind); result.is_error()) {
         shutdown_with_error(result.error());
         return result.release_error();
     }
@@ -73,8 +127,97 @@ ErrorOr<void> ConnectionBase::post_message(MessageBuffer buffer, MessageKind kin
     return {};
 }
 
+ErrorOr<void> ConnectionBase::transfer_message(MessageBuffer& buffer, MessageKind kind)
+{
+    if (m_outgoing_ring)
+        return buffer.transfer_message(*m_outgoing_ring, *m_socket, kind == MessageKind::Sync);
+    grow_send_buffer_if_needed(buffer.size());
+    return buffer.transfer_message(*m_socket, kind == MessageKind::Sync);
+}
+
+void ConnectionBase::enable_message_batching()
+{
+    m_message_batching_enabled = true;
+}
+
+ErrorOr<void> ConnectionBase::batch_message(MessageBuffer buffer)
+{
+    if (!m_batched_messages.has_value()) {
+        m_batched_messages = move(buffer);
+        m_deferred_invoker->schedule([strong_this = NonnullRefPtr(*this)] {
+            // FIXME: Do something about errors.
+            (void)strong_this->flush_batched_messages();
+        });
+        return {};
+    }
+
+    TRY(m_batched_messages->append_message(move(buffer)));
+
+    // Don't let a busy sender build up a batch that takes the peer long to catch up with.
+    static constexpr size_t max_batch_size = 64 * KiB;
+    if (m_batched_messages->size() >= max_batch_size)
+        return flush_batched_messages();
+    return {};
+}
+
+ErrorOr<void> ConnectionBase::flush_batched_messages()
+{
+    if (!m_batched_messages.has_value())
+        return {};
+
+    auto buffer = m_batched_messages.release_value();
+    if (!m_socket->is_open())
+        return Error::from_string_literal("Trying to flush batched messages during IPC shutdown");
+    return send_message(buffer, MessageKind::Async);
+}
+
+ErrorOr<void> ConnectionBase::enable_shared_memory_transport(size_t capacity)
+{
+    if (m_outgoing_ring)
+        return {};
+
+    // Messages that are waiting to be sent have to arrive before the ring is used.
+    TRY(flush_batched_messages());
+
+    auto ring = TRY(SharedMemoryRing::create(capacity));
+    auto message = TRY(MessageBuffer::create_transport_message(TransportMessage::UseSharedMemoryRing, capacity));
+    TRY(message.append_file_descriptor(TRY(Core::System::dup(ring.fd()))));
+    TRY(message.transfer_message(*m_socket));
+
+    m_outgoing_ring = TRY(adopt_nonnull_own_or_enomem(new (nothrow) SharedMemoryRing(move(ring))));
+    return {};
+}
+
+void ConnectionBase::grow_send_buffer_if_needed(size_t message_size)
+{
+    // A message that doesn't fit into the socket buffer has to be written in pieces, each of which waits for the
+    // peer to read the previous one. Large messages (like bitmaps) are common, so grow the buffer to fit them.
+    static constexpr size_t max_send_buffer_size = 4 * MiB;
+    if (message_size <= m_send_buffer_size || m_send_buffer_size >= max_send_buffer_size)
+        return;
+
+    auto fd = m_socket->fd();
+    if (!fd.has_value())
+        return;
+
+    int new_size = static_cast<int>(min(round_up_to_power_of_two(message_size, 64 * KiB), max_send_buffer_size));
+    if (Core::System::setsockopt(*fd, SOL_SOCKET, SO_SNDBUF, &new_size, sizeof(new_size)).is_error()) {
+        // Don't try again for every message.
+        m_send_buffer_size = max_send_buffer_size;
+        return;
+    }
+    m_send_buffer_size = new_size;
+}
+
 void ConnectionBase::shutdown()
 {
+    // Send what was posted before shutting down, but don't make a failure to do so shut us down again.
+    if (m_batched_messages.has_value()) {
+        auto batched_messages = m_batched_messages.release_value();
+        if (m_socket->is_open())
+            (void)transfer_message(batched_messages, MessageKind::Async);
+    }
+
     m_socket->close();
     die();
 }
@@ -87,6 +230,8 @@ void ConnectionBase::shutdown_with_error(Error const& error)
 
 void ConnectionBase::handle_messages()
 {
+    bool sent_response = false;
+
     auto messages = move(m_unprocessed_messages);
     for (auto& message : messages) {
         if (message->endpoint_magic() == m_local_endpoint_magic) {
@@ -100,9 +245,16 @@ void ConnectionBase::handle_messages()
                 if (auto post_result = post_message(*response, MessageKind::Async); post_result.is_error()) {
                     dbgln("IPC::ConnectionBase::handle_messages: {}", post_result.error());
                 }
+                sent_response = true;
             }
         }
     }
+
+    // The peer is blocked waiting for the responses, so don't hold them back until the end of the event loop iteration.
+    if (sent_response) {
+        if (auto flush_result = flush_batched_messages(); flush_result.is_error())
+            dbgln("IPC::ConnectionBase::handle_messages: {}", flush_result.error());
+    }
 }
 
 void ConnectionBase::wait_for_socket_to_become_readable()
@@ -178,16 +330,28 @@ ErrorOr<Vector<u8>> ConnectionBase::read_as_much_as_possible_from_socket_without
 
 ErrorOr<void> ConnectionBase::drain_messages_from_peer()
 {
-    auto bytes = TRY(read_as_much_as_possible_from_socket_without_blocking());
+    // The peer sends the file descriptors for a message in the ring through the socket before it writes the message,
+    // so look at the ring first. That way, everything we read from it has its file descriptors in the socket already.
+    size_t readable_ring_size = 0;
+    if (m_incoming_ring) {
+        auto readable_size_or_error = m_incoming_ring->readable_size();
+        if (readable_size_or_error.is_error()) {
+            shutdown_with_error(readable_size_or_error.error());
+            return readable_size_or_error.release_error();
+        }
+        readable_ring_size = readable_size_or_error.release_value();
+    }
+
+    auto bytes = TRY(ReceivedBytes::create(TRY(read_as_much_as_possible_from_socket_without_blocking())));
 
     size_t index = 0;
     try_parse_messages(bytes, index);
 
-    if (index < bytes.size()) {
+    if (index < bytes->bytes().size()) {
         // Sometimes we might receive a partial message. That's okay, just stash away
         // the unprocessed bytes and we'll prepend them to the next incoming message
         // in the next run of this function.
-        auto remaining_bytes = TRY(ByteBuffer::copy(bytes.span().slice(index)));
+        auto remaining_bytes = TRY(ByteBuffer::copy(bytes->bytes().slice(index)));
         if (!m_unprocessed_bytes.is_empty()) {
             shutdown();
             return Error::from_string_literal("drain_messages_from_peer: Already have unprocessed bytes");
@@ -195,6 +359,14 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
         m_unprocessed_bytes = move(remaining_bytes);
     }
 
+    if (readable_ring_size > 0)
+        TRY(read_messages_from_incoming_ring(readable_ring_size));
+
+    // Ask to be woken up for the next data in the ring. There may be some already if the peer wrote more while we
+    // were reading, or if the ring was set up by a message we just parsed.
+    if (m_incoming_ring)
+        schedule_drain_if_incoming_ring_has_data();
+
     if (!m_unprocessed_messages.is_empty()) {
         m_deferred_invoker->schedule([strong_this = NonnullRefPtr(*this)] {
             strong_this->handle_messages();
@@ -203,6 +375,46 @@ ErrorOr<void> ConnectionBase::drain_messages_from_peer()
     return {};
 }
 
+ErrorOr<void> ConnectionBase::read_messages_from_incoming_ring(size_t readable_size)
+{
+    if (auto result = m_incoming_ring->read(readable_size, m_unprocessed_ring_bytes); result.is_error()) {
+        shutdown_with_error(result.error());
+        return result.release_error();
+    }
+
+    m_responsiveness_timer->stop();
+    did_become_responsive();
+
+    // The messages may refer to the bytes, so hand them over rather than reusing the buffer.
+    auto bytes = TRY(ReceivedBytes::create(move(m_unprocessed_ring_bytes)));
+    m_unprocessed_ring_bytes = {};
+
+    size_t index = 0;
+    try_parse_messages(bytes, index);
+
+    // Unlike the socket, the ring may end in the middle of a message for as long as the peer is still writing it.
+    auto remaining_bytes = bytes->bytes().slice(index);
+    TRY(m_unprocessed_ring_bytes.try_append(remaining_bytes.data(), remaining_bytes.size()));
+    return {};
+}
+
+void ConnectionBase::schedule_drain_if_incoming_ring_has_data()
+{
+    if (m_incoming_ring_drain_scheduled || m_incoming_ring->prepare_to_wait())
+        return;
+
+    // The peer doesn't wake us up for data written before we asked it to, so read that without waiting for the socket.
+    m_incoming_ring_drain_scheduled = true;
+    m_deferred_invoker->schedule([strong_this = NonnullRefPtr(*this)] {
+        strong_this->m_incoming_ring_drain_scheduled = false;
+        if (!strong_this->is_open())
+            return;
+        // FIXME: Do something about errors.
+        (void)strong_this->drain_messages_from_peer();
+        strong_this->handle_messages();
+    });
+}
+
 OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32 endpoint_magic, int message_id)
 {
     for (;;) {
@@ -219,15 +431,18 @@ OwnPtr<IPC::Message> ConnectionBase::wait_for_specific_endpoint_message_impl(u32
         if (!m_socket->is_open())
             break;
 
-        wait_for_socket_to_become_readable();
+        // The peer only writes to the socket for messages in the ring if we asked it to before waiting.
+        if (!m_incoming_ring || m_incoming_ring->prepare_to_wait())
+            wait_for_socket_to_become_readable();
         if (drain_messages_from_peer().is_error())
             break;
     }
     return {};
 }
 
-void ConnectionBase::try_parse_messages(Vector<u8> const& bytes, size_t& index)
+void ConnectionBase::try_parse_messages(NonnullRefPtr<ReceivedBytes const> const& received_bytes, size_t& index)
 {
+    auto bytes = received_bytes->bytes();
     u32 message_size = 0;
     for (; index + sizeof(message_size) < bytes.size(); index += message_size) {
         memcpy(&message_size, bytes.data() + index, sizeof(message_size));
@@ -236,7 +451,15 @@ void ConnectionBase::try_parse_messages(Vector<u8> const& bytes, size_t& index)
         index += sizeof(message_size);
         auto remaining_bytes = ReadonlyBytes { bytes.data() + index, message_size };
 
+        if (message_size >= sizeof(u32) && ByteReader::load32(remaining_bytes.data()) == transport_message_magic) {
+            handle_transport_message(remaining_bytes);
+            continue;
+        }
+
         if (auto message = try_parse_message(remaining_bytes, m_unprocessed_fds)) {
+            if constexpr (IPC_MESSAGE_STATISTICS_DEBUG)
+                m_received_message_statistics.ensure(StringView { message->message_name(), strlen(message->message_name()) }).add(message_size);
+            message->set_received_bytes(received_bytes);
             m_unprocessed_messages.append(message.release_nonnull());
             continue;
         }
@@ -247,4 +470,40 @@ void ConnectionBase::try_parse_messages(Vector<u8> const& bytes, size_t& index)
     }
 }
 
+void ConnectionBase::handle_transport_message(ReadonlyBytes bytes)
+{
+    u32 words[3];
+    if (bytes.size() != sizeof(words)) {
+        shutdown_with_error(Error::from_string_literal("Invalid IPC transport message"));
+        return;
+    }
+    bytes.copy_to({ reinterpret_cast<u8*>(words), sizeof(words) });
+
+    switch (static_cast<TransportMessage>(words[1])) {
+    case TransportMessage::UseSharedMemoryRing: {
+        if (m_incoming_ring || m_unprocessed_fds.is_empty()) {
+            shutdown_with_error(Error::from_string_literal("Invalid IPC shared memory ring"));
+            return;
+        }
+        auto ring = SharedMemoryRing::create_from_fd(m_unprocessed_fds.dequeue().take_fd(), words[2]);
+        if (ring.is_error()) {
+            shutdown_with_error(ring.error());
+            return;
+        }
+        m_incoming_ring = adopt_own_if_nonnull(new (nothrow) SharedMemoryRing(ring.release_value()));
+        if (!m_incoming_ring)
+            shutdown_with_error(Error::from_errno(ENOMEM));
+        return;
+    }
+    case TransportMessage::Wakeup:
+        // Draining the ring after the socket is all this needs.
+        return;
+    case TransportMessage::FileDescriptors:
+        // The file descriptors are queued along with the ones for socket messages, in the order they arrived.
+        return;
+    }
+
+    shutdown_with_error(Error::from_string_literal("Unknown IPC transport message"));
+}
+
 }
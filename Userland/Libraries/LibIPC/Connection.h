@@ -8,10 +8,13 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
 #include <AK/Queue.h>
 #include <LibCore/EventReceiver.h>
 #include <LibIPC/File.h>
 #include <LibIPC/Forward.h>
+#include <LibIPC/Message.h>
 
 namespace IPC {
 
@@ -38,11 +41,34 @@ public:
     };
     ErrorOr<void> post_message(Message const&, MessageKind = MessageKind::Async);
 
+    // Makes async messages wait until the end of the current event loop iteration, so that they can be sent with a
+    // single write. Sync messages and responses are never held back, and send the waiting messages ahead of them.
+    // Only for connections that are used from the thread running their event loop.
+    void enable_message_batching();
+    ErrorOr<void> flush_batched_messages();
+
+    // Makes this side send all further messages through shared memory instead of the socket.
+    // This is worth it for connections that send many messages, each of which would otherwise cost a system call
+    // on both sides. The peer doesn't need to do anything; it starts reading the shared memory when told to.
+    ErrorOr<void> enable_shared_memory_transport(size_t capacity = 256 * KiB);
+
     void shutdown();
     virtual void die() { }
 
     Core::LocalSocket& socket() { return *m_socket; }
 
+    // Counted per message name if IPC_MESSAGE_STATISTICS_DEBUG is enabled, to find out which messages are sent the most.
+    struct MessageStatistics {
+        void add(size_t size)
+        {
+            ++count;
+            bytes += size;
+        }
+
+        u64 count { 0 };
+        u64 bytes { 0 };
+    };
+
 protected:
     explicit ConnectionBase(IPC::Stub&, NonnullOwnPtr<Core::LocalSocket>, u32 local_endpoint_magic);
 
@@ -55,9 +81,17 @@ protected:
     void wait_for_socket_to_become_readable();
     ErrorOr<Vector<u8>> read_as_much_as_possible_from_socket_without_blocking();
     ErrorOr<void> drain_messages_from_peer();
-    void try_parse_messages(Vector<u8> const& bytes, size_t& index);
+    ErrorOr<void> read_messages_from_incoming_ring(size_t readable_size);
+    void schedule_drain_if_incoming_ring_has_data();
+    void try_parse_messages(NonnullRefPtr<ReceivedBytes const> const& bytes, size_t& index);
+    void handle_transport_message(ReadonlyBytes);
 
     ErrorOr<void> post_message(MessageBuffer, MessageKind);
+    ErrorOr<void> batch_message(MessageBuffer);
+    ErrorOr<void> send_message(MessageBuffer&, MessageKind);
+    ErrorOr<void> transfer_message(MessageBuffer&, MessageKind);
+    void dump_message_statistics();
+    void grow_send_buffer_if_needed(size_t message_size);
     void handle_messages();
 
     IPC::Stub& m_local_stub;
@@ -70,8 +104,22 @@ protected:
     Queue<IPC::File> m_unprocessed_fds;
     ByteBuffer m_unprocessed_bytes;
 
+    OwnPtr<SharedMemoryRing> m_outgoing_ring;
+    OwnPtr<SharedMemoryRing> m_incoming_ring;
+    Vector<u8> m_unprocessed_ring_bytes;
+    bool m_incoming_ring_drain_scheduled { false };
+
+    bool m_message_batching_enabled { false };
+    Optional<MessageBuffer> m_batched_messages;
+
+    RefPtr<Core::Timer> m_message_statistics_timer;
+    HashMap<StringView, MessageStatistics> m_sent_message_statistics;
+    HashMap<StringView, MessageStatistics> m_received_message_statistics;
+
     u32 m_local_endpoint_magic { 0 };
 
+    size_t m_send_buffer_size { 64 * KiB };
+
     NonnullOwnPtr<DeferredInvoker> m_deferred_invoker;
 };
 
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteString.h>
+#include <LibIPC/ConnectionThreads.h>
+#include <LibThreading/EventLoopThread.h>
+
+namespace IPC {
+
+ErrorOr<NonnullOwnPtr<ConnectionThreads>> ConnectionThreads::create(size_t thread_count)
+{
+    VERIFY(thread_count > 0);
+
+    Vector<NonnullOwnPtr<Threading::EventLoopThread>> threads;
+    TRY(threads.try_ensure_capacity(thread_count));
+    for (size_t i = 0; i < thread_count; ++i) {
+        auto thread_name = ByteString::formatted("IPC [{}]", i);
+        threads.unchecked_append(TRY(Threading::EventLoopThread::create(thread_name)));
+    }
+    return adopt_nonnull_own_or_enomem(new (nothrow) ConnectionThreads(move(threads)));
+}
+
+ConnectionThreads::ConnectionThreads(Vector<NonnullOwnPtr<Threading::EventLoopThread>> threads)
+    : m_threads(move(threads))
+{
+}
+
+ConnectionThreads::~ConnectionThreads() = default;
+
+void ConnectionThreads::run_on_next_thread(Function<void()> function)
+{
+    auto& thread = *m_threads[m_next_thread_index];
+    m_next_thread_index = (m_next_thread_index + 1) % m_threads.size();
+    thread.deferred_invoke(move(function));
+}
+
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+#include <LibThreading/Forward.h>
+
+namespace IPC {
+
+// A set of event loop threads that a MultiServer hands its accepted connections to.
+class ConnectionThreads {
+    AK_MAKE_NONCOPYABLE(ConnectionThreads);
+    AK_MAKE_NONMOVABLE(ConnectionThreads);
+
+public:
+    static ErrorOr<NonnullOwnPtr<ConnectionThreads>> create(size_t thread_count);
+    ~ConnectionThreads();
+
+    size_t thread_count() const { return m_threads.size(); }
+
+    // Runs the function on the event loop of the next thread in turn.
+    void run_on_next_thread(Function<void()>);
+
+private:
+    explicit ConnectionThreads(Vector<NonnullOwnPtr<Threading::EventLoopThread>>);
+
+    Vector<NonnullOwnPtr<Threading::EventLoopThread>> m_threads;
+    size_t m_next_thread_index { 0 };
+};
+
+}
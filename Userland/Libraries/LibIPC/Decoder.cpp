@@ -23,6 +23,15 @@ ErrorOr<size_t> Decoder::decode_size()
     return static_cast<size_t>(TRY(decode<u32>()));
 }
 
+ErrorOr<ReadonlyBytes> Decoder::decode_borrowed_bytes()
+{
+    if (!m_memory_stream)
+        return Error::from_string_literal("Cannot borrow bytes from a stream that is not in memory");
+
+    auto length = TRY(decode_size());
+    return m_memory_stream->read_in_place<u8 const>(length);
+}
+
 template<>
 ErrorOr<String> decode(Decoder& decoder)
 {
@@ -57,6 +66,18 @@ ErrorOr<ByteBuffer> decode(Decoder& decoder)
     return buffer;
 }
 
+template<>
+ErrorOr<StringView> decode(Decoder& decoder)
+{
+    return StringView { TRY(decoder.decode_borrowed_bytes()) };
+}
+
+template<>
+ErrorOr<ReadonlyBytes> decode(Decoder& decoder)
+{
+    return decoder.decode_borrowed_bytes();
+}
+
 template<>
 ErrorOr<JsonValue> decode(Decoder& decoder)
 {
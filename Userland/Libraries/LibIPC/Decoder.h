@@ -10,6 +10,7 @@
 #include <AK/ByteString.h>
 #include <AK/Concepts.h>
 #include <AK/Forward.h>
+#include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
 #include <AK/Queue.h>
 #include <AK/StdLibExtras.h>
@@ -43,6 +44,13 @@ public:
     {
     }
 
+    Decoder(FixedMemoryStream& stream, Queue<IPC::File>& files)
+        : m_stream(stream)
+        , m_memory_stream(&stream)
+        , m_files(files)
+    {
+    }
+
     template<typename T>
     ErrorOr<T> decode();
 
@@ -61,11 +69,16 @@ public:
 
     ErrorOr<size_t> decode_size();
 
+    // Returns a view of the bytes of an encoded String, ByteString or ByteBuffer, without copying them. This is only
+    // possible if the decoder reads from memory, and the view is only valid for as long as that memory.
+    ErrorOr<ReadonlyBytes> decode_borrowed_bytes();
+
     Stream& stream() { return m_stream; }
     Queue<IPC::File>& files() { return m_files; }
 
 private:
     Stream& m_stream;
+    FixedMemoryStream* m_memory_stream { nullptr };
     Queue<IPC::File>& m_files;
 };
 
@@ -93,6 +106,12 @@ ErrorOr<ByteString> decode(Decoder&);
 template<>
 ErrorOr<ByteBuffer> decode(Decoder&);
 
+template<>
+ErrorOr<StringView> decode(Decoder&);
+
+template<>
+ErrorOr<ReadonlyBytes> decode(Decoder&);
+
 template<>
 ErrorOr<JsonValue> decode(Decoder&);
 
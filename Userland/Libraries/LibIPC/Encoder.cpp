@@ -73,6 +73,12 @@ ErrorOr<void> encode(Encoder& encoder, ByteString const& value)
 
 template<>
 ErrorOr<void> encode(Encoder& encoder, ByteBuffer const& value)
+{
+    return encoder.encode(value.bytes());
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, ReadonlyBytes const& value)
 {
     TRY(encoder.encode_size(value.size()));
     TRY(encoder.append(value.data(), value.size()));
@@ -92,6 +92,9 @@ ErrorOr<void> encode(Encoder&, ByteString const&);
 template<>
 ErrorOr<void> encode(Encoder&, ByteBuffer const&);
 
+template<>
+ErrorOr<void> encode(Encoder&, ReadonlyBytes const&);
+
 template<>
 ErrorOr<void> encode(Encoder&, JsonValue const&);
 
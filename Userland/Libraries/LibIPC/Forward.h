@@ -14,7 +14,9 @@ class Decoder;
 class Encoder;
 class Message;
 class MessageBuffer;
+class ReceivedBytes;
 class File;
+class SharedMemoryRing;
 class Stub;
 
 template<typename T>
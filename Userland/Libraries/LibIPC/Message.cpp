@@ -8,6 +8,7 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/Socket.h>
 #include <LibIPC/Message.h>
+#include <LibIPC/SharedMemoryRing.h>
 #include <sched.h>
 
 namespace IPC {
@@ -19,6 +20,14 @@ MessageBuffer::MessageBuffer()
     m_data.resize(sizeof(MessageSizeType));
 }
 
+ErrorOr<MessageBuffer> MessageBuffer::create_transport_message(TransportMessage message, u32 argument)
+{
+    MessageBuffer buffer;
+    u32 const words[] = { transport_message_magic, to_underlying(message), argument };
+    TRY(buffer.append_data(reinterpret_cast<u8 const*>(words), sizeof(words)));
+    return buffer;
+}
+
 ErrorOr<void> MessageBuffer::extend_data_capacity(size_t capacity)
 {
     TRY(m_data.try_ensure_capacity(m_data.size() + capacity));
@@ -38,16 +47,31 @@ ErrorOr<void> MessageBuffer::append_file_descriptor(int fd)
     return {};
 }
 
-ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket, bool block_event_loop)
+ErrorOr<void> MessageBuffer::append_message(MessageBuffer&& message)
+{
+    TRY(write_message_size());
+    m_last_message_offset = m_data.size();
+    TRY(m_data.try_extend(message.m_data));
+    TRY(m_fds.try_extend(move(message.m_fds)));
+    return {};
+}
+
+ErrorOr<void> MessageBuffer::write_message_size()
 {
-    Checked<MessageSizeType> checked_message_size { m_data.size() };
+    Checked<MessageSizeType> checked_message_size { m_data.size() - m_last_message_offset };
     checked_message_size -= sizeof(MessageSizeType);
 
     if (checked_message_size.has_overflow())
         return Error::from_string_literal("Message is too large for IPC encoding");
 
     MessageSizeType const message_size = checked_message_size.value();
-    m_data.span().overwrite(0, reinterpret_cast<u8 const*>(&message_size), sizeof(message_size));
+    m_data.span().overwrite(m_last_message_offset, reinterpret_cast<u8 const*>(&message_size), sizeof(message_size));
+    return {};
+}
+
+ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket, bool block_event_loop)
+{
+    TRY(write_message_size());
 
     auto raw_fds = Vector<int, 1> {};
     auto num_fds_to_transfer = m_fds.size();
@@ -107,4 +131,49 @@ ErrorOr<void> MessageBuffer::transfer_message(Core::LocalSocket& socket, bool bl
     return {};
 }
 
+ErrorOr<void> MessageBuffer::transfer_message(SharedMemoryRing& ring, Core::LocalSocket& socket, bool block_event_loop)
+{
+    TRY(write_message_size());
+
+    // File descriptors can only be passed through the socket. The reader drains the socket before it reads the ring,
+    // so sending them first makes sure that they have arrived by the time the reader gets to this message.
+    if (!m_fds.is_empty()) {
+        auto file_descriptors = TRY(create_transport_message(TransportMessage::FileDescriptors));
+        file_descriptors.m_fds = move(m_fds);
+        TRY(file_descriptors.transfer_message(socket, block_event_loop));
+    }
+
+    // Messages that are larger than the ring are written in pieces as the reader consumes them.
+    // Give up if the reader doesn't make any progress for a while, like we do for the socket.
+    static constexpr size_t max_yields_without_progress = 1000;
+    size_t yields_without_progress = 0;
+
+    ReadonlyBytes bytes_to_write { m_data.span() };
+    while (!bytes_to_write.is_empty()) {
+        auto nwritten = TRY(ring.write_some(bytes_to_write));
+        bytes_to_write = bytes_to_write.slice(nwritten);
+
+        if (ring.take_wakeup_request()) {
+            auto wakeup = TRY(create_transport_message(TransportMessage::Wakeup));
+            TRY(wakeup.transfer_message(socket, block_event_loop));
+        }
+
+        if (bytes_to_write.is_empty())
+            break;
+
+        if (nwritten > 0)
+            yields_without_progress = 0;
+        else if (++yields_without_progress > max_yields_without_progress)
+            return Error::from_string_literal("IPC::transfer_message: Peer buffer overflowed");
+
+        // The reader doesn't send us anything when it makes room, so there's no event to wait for. Still process the
+        // events we have, in case the reader is waiting for us to read what it sent.
+        if (!block_event_loop)
+            Core::EventLoop::current().pump(Core::EventLoop::WaitMode::PollForEvents);
+        sched_yield();
+    }
+
+    return {};
+}
+
 }
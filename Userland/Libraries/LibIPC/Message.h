@@ -12,6 +12,7 @@
 #include <AK/RefPtr.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
+#include <LibIPC/Forward.h>
 #include <unistd.h>
 
 namespace IPC {
@@ -35,20 +36,46 @@ private:
     int m_fd;
 };
 
+// Messages for the connection itself rather than for one of its endpoints. They are always sent through the socket.
+enum class TransportMessage : u32 {
+    // The sender sends all further messages through the shared memory ring whose file descriptor is attached.
+    UseSharedMemoryRing,
+    // The sender has written to the shared memory ring after we asked to be woken up.
+    Wakeup,
+    // Carries the file descriptors of the next message in the shared memory ring.
+    FileDescriptors,
+};
+
+static constexpr u32 transport_message_magic = 0x54435049; // "IPCT"
+
 class MessageBuffer {
 public:
     MessageBuffer();
 
+    static ErrorOr<MessageBuffer> create_transport_message(TransportMessage, u32 argument = 0);
+
     ErrorOr<void> extend_data_capacity(size_t capacity);
     ErrorOr<void> append_data(u8 const* values, size_t count);
 
     ErrorOr<void> append_file_descriptor(int fd);
+    bool has_file_descriptors() const { return !m_fds.is_empty(); }
+
+    // Appends another message, so that both can be sent with a single write.
+    ErrorOr<void> append_message(MessageBuffer&&);
 
     ErrorOr<void> transfer_message(Core::LocalSocket& socket, bool block_event_loop = false);
+    ErrorOr<void> transfer_message(SharedMemoryRing&, Core::LocalSocket& socket, bool block_event_loop = false);
+
+    size_t size() const { return m_data.size(); }
 
 private:
+    ErrorOr<void> write_message_size();
+
     Vector<u8, 1024> m_data;
     Vector<NonnullRefPtr<AutoCloseFileDescriptor>, 1> m_fds;
+
+    // Where the message that is still being encoded starts, if other messages were appended before it.
+    size_t m_last_message_offset { 0 };
 };
 
 enum class ErrorCode : u32 {
@@ -58,6 +85,25 @@ enum class ErrorCode : u32 {
 template<typename Value>
 using IPCErrorOr = ErrorOr<Value, ErrorCode>;
 
+// The bytes that messages were received in.
+class ReceivedBytes : public RefCounted<ReceivedBytes> {
+public:
+    static ErrorOr<NonnullRefPtr<ReceivedBytes>> create(Vector<u8> bytes)
+    {
+        return adopt_nonnull_ref_or_enomem(new (nothrow) ReceivedBytes(move(bytes)));
+    }
+
+    ReadonlyBytes bytes() const { return m_bytes; }
+
+private:
+    explicit ReceivedBytes(Vector<u8> bytes)
+        : m_bytes(move(bytes))
+    {
+    }
+
+    Vector<u8> m_bytes;
+};
+
 class Message {
 public:
     virtual ~Message() = default;
@@ -68,8 +114,15 @@ public:
     virtual bool valid() const = 0;
     virtual ErrorOr<MessageBuffer> encode() const = 0;
 
+    // Parameters marked as [Borrowed] are decoded as views into the bytes the message was received in,
+    // so the message has to keep them alive.
+    void set_received_bytes(NonnullRefPtr<ReceivedBytes const> bytes) { m_received_bytes = move(bytes); }
+
 protected:
     Message() = default;
+
+private:
+    RefPtr<ReceivedBytes const> m_received_bytes;
 };
 
 }
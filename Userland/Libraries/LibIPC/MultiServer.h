@@ -9,42 +9,92 @@
 #include <AK/Error.h>
 #include <AK/Function.h>
 #include <LibCore/LocalServer.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
 #include <LibIPC/ConnectionFromClient.h>
+#include <LibIPC/ConnectionThreads.h>
 
 namespace IPC {
 
+// Accepts connections from any number of clients.
+//
+// By default, every connection lives on the event loop of the thread that created the server. Servers created with
+// try_create_with_threads() spread their connections across that many threads with event loops of their own, so that
+// a slow request only holds up the clients on the same thread. Every connection stays on a single thread, so its
+// handlers never run concurrently, but state that is shared between connections has to be thread-safe.
+// on_new_client is called on the thread that the new connection lives on.
 template<typename ConnectionFromClientType>
 class MultiServer {
 public:
     static ErrorOr<NonnullOwnPtr<MultiServer>> try_create(Optional<ByteString> socket_path = {})
+    {
+        return try_create_with_threads(0, move(socket_path));
+    }
+
+    static ErrorOr<NonnullOwnPtr<MultiServer>> try_create(NonnullRefPtr<Core::LocalServer> server)
+    {
+        return try_create_with_threads(0, move(server));
+    }
+
+    static ErrorOr<NonnullOwnPtr<MultiServer>> try_create_with_threads(size_t thread_count, Optional<ByteString> socket_path = {})
     {
         auto server = TRY(Core::LocalServer::try_create());
         TRY(server->take_over_from_system_server(socket_path.value_or({})));
-        return adopt_nonnull_own_or_enomem(new (nothrow) MultiServer(move(server)));
+        return try_create_with_threads(thread_count, move(server));
     }
 
-    static ErrorOr<NonnullOwnPtr<MultiServer>> try_create(NonnullRefPtr<Core::LocalServer> server)
+    static ErrorOr<NonnullOwnPtr<MultiServer>> try_create_with_threads(size_t thread_count, NonnullRefPtr<Core::LocalServer> server)
     {
-        return adopt_nonnull_own_or_enomem(new (nothrow) MultiServer(move(server)));
+        OwnPtr<ConnectionThreads> threads;
+        if (thread_count > 0)
+            threads = TRY(ConnectionThreads::create(thread_count));
+        return adopt_nonnull_own_or_enomem(new (nothrow) MultiServer(move(server), move(threads)));
     }
 
     Function<void(ConnectionFromClientType&)> on_new_client;
 
 private:
-    explicit MultiServer(NonnullRefPtr<Core::LocalServer> server)
+    MultiServer(NonnullRefPtr<Core::LocalServer> server, OwnPtr<ConnectionThreads> threads)
         : m_server(move(server))
+        , m_threads(move(threads))
     {
         m_server->on_accept = [&](auto client_socket) {
             auto client_id = ++m_next_client_id;
 
-            auto client = IPC::new_client_connection<ConnectionFromClientType>(move(client_socket), client_id);
-            if (on_new_client)
-                on_new_client(*client);
+            if (!m_threads) {
+                did_accept(move(client_socket), client_id);
+                return;
+            }
+
+            // The socket's notifier belongs to this thread's event loop, so only the file descriptor moves over.
+            auto fd_or_error = client_socket->release_fd();
+            if (fd_or_error.is_error()) {
+                dbgln("MultiServer: Failed to hand over a new client: {}", fd_or_error.error());
+                return;
+            }
+            m_threads->run_on_next_thread([this, fd = fd_or_error.value(), client_id] {
+                auto socket_or_error = Core::LocalSocket::adopt_fd(fd);
+                if (socket_or_error.is_error()) {
+                    dbgln("MultiServer: Failed to adopt a new client: {}", socket_or_error.error());
+                    (void)Core::System::close(fd);
+                    return;
+                }
+                did_accept(socket_or_error.release_value(), client_id);
+            });
         };
     }
 
+    void did_accept(NonnullOwnPtr<Core::LocalSocket> client_socket, int client_id)
+    {
+        auto client = IPC::new_client_connection<ConnectionFromClientType>(move(client_socket), client_id);
+        if (on_new_client)
+            on_new_client(*client);
+    }
+
     int m_next_client_id { 0 };
     RefPtr<Core::LocalServer> m_server;
+    // Declared last, so that the threads are stopped before anything they might use is destroyed.
+    OwnPtr<ConnectionThreads> m_threads;
 };
 
 }
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <LibCore/System.h>
+#include <LibIPC/SharedMemoryRing.h>
+
+namespace IPC {
+
+static constexpr u32 ring_magic = 0x52435049; // "IPCR"
+
+struct SharedMemoryRing::Header {
+    u32 magic;
+    u32 capacity;
+
+    // Only written by the writer.
+    AK_CACHE_ALIGNED Atomic<u64> write_position;
+
+    // Only written by the reader.
+    AK_CACHE_ALIGNED Atomic<u64> read_position;
+
+    // Set by the reader before it waits for data, and reset by the writer when it wakes the reader up.
+    AK_CACHE_ALIGNED Atomic<bool> reader_is_waiting;
+};
+
+size_t const SharedMemoryRing::data_offset = round_up_to_power_of_two(sizeof(SharedMemoryRing::Header), 64);
+
+ErrorOr<SharedMemoryRing> SharedMemoryRing::create(size_t capacity)
+{
+    VERIFY(is_power_of_two(capacity));
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(data_offset + capacity));
+    auto* header = new (buffer.data<u8>()) Header();
+    header->magic = ring_magic;
+    header->capacity = capacity;
+    return SharedMemoryRing { move(buffer), capacity };
+}
+
+ErrorOr<SharedMemoryRing> SharedMemoryRing::create_from_fd(int fd, size_t capacity)
+{
+    if (!is_power_of_two(capacity) || capacity > 64 * MiB) {
+        (void)Core::System::close(fd);
+        return Error::from_string_literal("Invalid shared memory ring capacity");
+    }
+
+    auto stat_or_error = Core::System::fstat(fd);
+    if (stat_or_error.is_error() || static_cast<size_t>(stat_or_error.value().st_size) < data_offset + capacity) {
+        (void)Core::System::close(fd);
+        return Error::from_string_literal("Shared memory ring is too small");
+    }
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(fd, data_offset + capacity));
+    auto const* header = buffer.data<u8>();
+    if (reinterpret_cast<Header const*>(header)->magic != ring_magic)
+        return Error::from_string_literal("Invalid shared memory ring");
+
+    SharedMemoryRing ring { move(buffer), capacity };
+    ring.m_position = ring.header().read_position.load(AK::MemoryOrder::memory_order_acquire);
+    return ring;
+}
+
+SharedMemoryRing::SharedMemoryRing(Core::AnonymousBuffer buffer, size_t capacity)
+    : m_buffer(move(buffer))
+    , m_capacity(capacity)
+{
+}
+
+SharedMemoryRing::Header& SharedMemoryRing::header()
+{
+    return *reinterpret_cast<Header*>(m_buffer.data<u8>());
+}
+
+SharedMemoryRing::Header const& SharedMemoryRing::header() const
+{
+    return *reinterpret_cast<Header const*>(m_buffer.data<u8>());
+}
+
+u8* SharedMemoryRing::data()
+{
+    return m_buffer.data<u8>() + data_offset;
+}
+
+ErrorOr<size_t> SharedMemoryRing::write_some(ReadonlyBytes bytes)
+{
+    auto read_position = header().read_position.load(AK::MemoryOrder::memory_order_acquire);
+    if (read_position > m_position || m_position - read_position > m_capacity)
+        return Error::from_string_literal("Shared memory ring was corrupted by the reader");
+
+    auto count = min(bytes.size(), m_capacity - (m_position - read_position));
+    auto offset = m_position & (m_capacity - 1);
+    auto count_until_end = min(count, m_capacity - offset);
+    __builtin_memcpy(data() + offset, bytes.data(), count_until_end);
+    __builtin_memcpy(data(), bytes.data() + count_until_end, count - count_until_end);
+
+    m_position += count;
+    header().write_position.store(m_position, AK::MemoryOrder::memory_order_seq_cst);
+    return count;
+}
+
+bool SharedMemoryRing::take_wakeup_request()
+{
+    return header().reader_is_waiting.exchange(false, AK::MemoryOrder::memory_order_seq_cst);
+}
+
+ErrorOr<size_t> SharedMemoryRing::readable_size() const
+{
+    auto write_position = header().write_position.load(AK::MemoryOrder::memory_order_acquire);
+    if (write_position < m_position || write_position - m_position > m_capacity)
+        return Error::from_string_literal("Shared memory ring was corrupted by the writer");
+    return write_position - m_position;
+}
+
+ErrorOr<void> SharedMemoryRing::read(size_t count, Vector<u8>& buffer)
+{
+    auto offset = m_position & (m_capacity - 1);
+    auto count_until_end = min(count, m_capacity - offset);
+    TRY(buffer.try_append(data() + offset, count_until_end));
+    TRY(buffer.try_append(data(), count - count_until_end));
+
+    m_position += count;
+    header().read_position.store(m_position, AK::MemoryOrder::memory_order_release);
+    return {};
+}
+
+bool SharedMemoryRing::prepare_to_wait()
+{
+    header().reader_is_waiting.store(true, AK::MemoryOrder::memory_order_seq_cst);
+    // The writer may have written something since we last looked, without seeing our request.
+    return header().write_position.load(AK::MemoryOrder::memory_order_seq_cst) == m_position;
+}
+
+}
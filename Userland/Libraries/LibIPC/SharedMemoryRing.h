@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibCore/AnonymousBuffer.h>
+
+namespace IPC {
+
+// A byte stream from one process to another in shared memory, with a single writer and a single reader.
+// A connection can send its messages through one instead of its socket, which saves a write() and a read(),
+// and the copies into and out of the kernel, per message. The socket is still used to pass file descriptors,
+// and to wake the reader up when it is waiting for data.
+//
+// The reader can't trust the writer and vice versa, so both keep their own position and only use the one
+// in shared memory after checking it.
+class SharedMemoryRing {
+public:
+    static constexpr size_t default_capacity = 256 * KiB;
+
+    static ErrorOr<SharedMemoryRing> create(size_t capacity = default_capacity);
+
+    // Maps a ring created by the peer, after checking that the shared memory is large enough for the capacity.
+    static ErrorOr<SharedMemoryRing> create_from_fd(int fd, size_t capacity);
+
+    int fd() const { return m_buffer.fd(); }
+    size_t capacity() const { return m_capacity; }
+
+    // Writes as much of the bytes as fits, and returns how much that was.
+    ErrorOr<size_t> write_some(ReadonlyBytes);
+
+    // Returns whether the reader has asked to be woken up the next time there is new data, and resets the request.
+    bool take_wakeup_request();
+
+    // Returns the number of bytes that can be read.
+    ErrorOr<size_t> readable_size() const;
+
+    // Appends the given number of bytes to the buffer, which must not be more than readable_size() returned.
+    ErrorOr<void> read(size_t count, Vector<u8>& buffer);
+
+    // Asks the writer to wake us up on new data. Returns false if there is data to be read already.
+    bool prepare_to_wait();
+
+private:
+    struct Header;
+    static size_t const data_offset;
+
+    SharedMemoryRing(Core::AnonymousBuffer, size_t capacity);
+
+    Header& header();
+    Header const& header() const;
+    u8* data();
+
+    Core::AnonymousBuffer m_buffer;
+    size_t m_capacity { 0 };
+    u64 m_position { 0 };
+};
+
+}
@@ -16,16 +16,18 @@ Client::Client(NonnullOwnPtr<Core::LocalSocket> socket)
 
 void Client::die()
 {
-    for (auto& [_, promise] : m_pending_decoded_images) {
-        promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
+    for (auto& [_, pending_image] : m_pending_decoded_images) {
+        pending_image.promise->reject(Error::from_string_literal("ImageDecoder disconnected"));
     }
     m_pending_decoded_images.clear();
+    m_animation_frames_callbacks.clear();
+    m_partial_image_callbacks.clear();
 
     if (on_death)
         on_death();
 }
 
-NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes encoded_data, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, FrameDecoding frame_decoding)
 {
     auto promise = Core::Promise<DecodedImage>::construct();
     if (on_resolved)
@@ -55,53 +57,190 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
         return promise;
     }
 
-    m_pending_decoded_images.set(response->image_id(), promise);
+    m_pending_decoded_images.set(response->image_id(), PendingImage { promise, frame_decoding, {} });
 
     return promise;
 }
 
-void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale)
+void Client::request_animation_frames(i64 image_id, u32 start_frame_index, u32 frame_count, AnimationFramesCallback on_decoded)
+{
+    m_animation_frames_callbacks.ensure(image_id).enqueue(move(on_decoded));
+    async_request_animation_frames(image_id, start_frame_index, frame_count);
+}
+
+void Client::release_animated_image(i64 image_id)
+{
+    m_animation_frames_callbacks.remove(image_id);
+    async_release_animated_image(image_id);
+}
+
+Optional<i64> Client::begin_incremental_decode(PartialImageCallback on_partial_image, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+{
+    auto response = send_sync_but_allow_failure<Messages::ImageDecoderServer::BeginIncrementalDecode>(ideal_size, mime_type);
+    if (!response) {
+        dbgln("ImageDecoder disconnected trying to decode image");
+        return {};
+    }
+
+    if (on_partial_image)
+        m_partial_image_callbacks.set(response->image_id(), move(on_partial_image));
+    return response->image_id();
+}
+
+void Client::append_incremental_data(i64 image_id, ReadonlyBytes data)
+{
+    if (data.is_empty())
+        return;
+
+    auto buffer_or_error = Core::AnonymousBuffer::create_with_size(data.size());
+    if (buffer_or_error.is_error()) {
+        dbgln("Could not allocate encoded buffer: {}", buffer_or_error.error());
+        return;
+    }
+    auto buffer = buffer_or_error.release_value();
+    memcpy(buffer.data<void>(), data.data(), data.size());
+
+    async_append_incremental_data(image_id, move(buffer));
+}
+
+NonnullRefPtr<Core::Promise<DecodedImage>> Client::finish_incremental_decode(i64 image_id, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, FrameDecoding frame_decoding)
+{
+    auto promise = Core::Promise<DecodedImage>::construct();
+    if (on_resolved)
+        promise->on_resolution = move(on_resolved);
+    if (on_rejected)
+        promise->on_rejection = move(on_rejected);
+
+    // Partial images that are still on their way are of no use anymore.
+    m_partial_image_callbacks.remove(image_id);
+    m_pending_decoded_images.set(image_id, PendingImage { promise, frame_decoding, {} });
+    async_finish_incremental_decode(image_id);
+
+    return promise;
+}
+
+void Client::cancel_incremental_decode(i64 image_id)
+{
+    m_partial_image_callbacks.remove(image_id);
+    async_cancel_decoding(image_id);
+}
+
+static ErrorOr<void> append_frames(i64 image_id, DecodedImage& image, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations)
 {
     auto const& bitmaps = bitmap_sequence.bitmaps;
-    VERIFY(!bitmaps.is_empty());
+    TRY(image.frames.try_ensure_capacity(image.frames.size() + bitmaps.size()));
+    for (size_t i = 0; i < bitmaps.size(); ++i) {
+        if (!bitmaps[i].has_value()) {
+            dbgln("ImageDecoderClient: Invalid bitmap for request {} at index {}", image_id, image.frames.size());
+            return Error::from_string_literal("Invalid bitmap");
+        }
+
+        image.frames.unchecked_append({ *bitmaps[i], durations[i] });
+    }
+    return {};
+}
+
+void Client::did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale)
+{
+    VERIFY(!bitmap_sequence.bitmaps.is_empty());
 
-    auto maybe_promise = m_pending_decoded_images.take(image_id);
-    if (!maybe_promise.has_value()) {
+    auto maybe_pending_image = m_pending_decoded_images.get(image_id);
+    if (!maybe_pending_image.has_value()) {
         dbgln("ImageDecoderClient: No pending image with ID {}", image_id);
         return;
     }
-    auto promise = maybe_promise.release_value();
+    auto& pending_image = maybe_pending_image.value();
 
     DecodedImage image;
+    image.image_id = image_id;
     image.is_animated = is_animated;
     image.loop_count = loop_count;
+    image.frame_count = frame_count;
     image.scale = scale;
-    image.frames.ensure_capacity(bitmaps.size());
-    for (size_t i = 0; i < bitmaps.size(); ++i) {
-        if (!bitmaps[i].has_value()) {
-            dbgln("ImageDecoderClient: Invalid bitmap for request {} at index {}", image_id, i);
-            promise->reject(Error::from_string_literal("Invalid bitmap"));
+    if (auto result = append_frames(image_id, image, bitmap_sequence, durations); result.is_error()) {
+        auto promise = m_pending_decoded_images.take(image_id)->promise;
+        if (image.frames.size() < frame_count)
+            async_release_animated_image(image_id);
+        promise->reject(result.release_error());
+        return;
+    }
+
+    if (image.frames.size() < frame_count && pending_image.frame_decoding == FrameDecoding::FirstFrameOnly)
+        async_release_animated_image(image_id);
+
+    if (image.frames.size() < frame_count && pending_image.frame_decoding == FrameDecoding::AllFrames) {
+        auto const first_missing_frame = static_cast<u32>(image.frames.size());
+        pending_image.partially_decoded_image = move(image);
+        async_request_animation_frames(image_id, first_missing_frame, frame_count - first_missing_frame);
+        return;
+    }
+
+    auto promise = m_pending_decoded_images.take(image_id)->promise;
+    promise->resolve(move(image));
+}
+
+void Client::did_decode_animation_frames(i64 image_id, u32 start_frame_index, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations)
+{
+    if (auto pending_image = m_pending_decoded_images.get(image_id); pending_image.has_value()) {
+        // These are the remaining frames of an image that is decoded with FrameDecoding::AllFrames.
+        VERIFY(pending_image->partially_decoded_image.has_value());
+        auto image = pending_image->partially_decoded_image.release_value();
+        auto promise = m_pending_decoded_images.take(image_id)->promise;
+        async_release_animated_image(image_id);
+
+        if (auto result = append_frames(image_id, image, bitmap_sequence, durations); result.is_error()) {
+            promise->reject(result.release_error());
             return;
         }
+        promise->resolve(move(image));
+        return;
+    }
 
-        image.frames.empend(*bitmaps[i], durations[i]);
+    auto callbacks = m_animation_frames_callbacks.find(image_id);
+    if (callbacks == m_animation_frames_callbacks.end() || callbacks->value.is_empty()) {
+        dbgln("ImageDecoderClient: No pending animation frames for image with ID {}", image_id);
+        return;
+    }
+    auto callback = callbacks->value.dequeue();
+
+    Vector<Optional<Frame>> frames;
+    frames.ensure_capacity(bitmap_sequence.bitmaps.size());
+    for (size_t i = 0; i < bitmap_sequence.bitmaps.size(); ++i) {
+        if (bitmap_sequence.bitmaps[i].has_value())
+            frames.unchecked_append(Frame { *bitmap_sequence.bitmaps[i], durations[i] });
+        else
+            frames.unchecked_append({});
     }
 
-    promise->resolve(move(image));
+    callback(start_frame_index, frames);
 }
 
 void Client::did_fail_to_decode_image(i64 image_id, String const& error_message)
 {
-    auto maybe_promise = m_pending_decoded_images.take(image_id);
-    if (!maybe_promise.has_value()) {
+    auto maybe_pending_image = m_pending_decoded_images.take(image_id);
+    if (!maybe_pending_image.has_value()) {
         dbgln("ImageDecoderClient: No pending image with ID {}", image_id);
         return;
     }
-    auto promise = maybe_promise.release_value();
+    auto promise = maybe_pending_image->promise;
 
     dbgln("ImageDecoderClient: Failed to decode image with ID {}: {}", image_id, error_message);
     // FIXME: Include the error message in the Error object when Errors are allowed to hold Strings
     promise->reject(Error::from_string_literal("Image decoding failed or aborted"));
 }
 
+void Client::did_decode_partial_image(i64 image_id, Gfx::BitmapSequence const& bitmap_sequence, u32 decoded_rows)
+{
+    auto callback = m_partial_image_callbacks.find(image_id);
+    if (callback == m_partial_image_callbacks.end())
+        return;
+
+    if (bitmap_sequence.bitmaps.is_empty() || !bitmap_sequence.bitmaps[0].has_value()) {
+        dbgln("ImageDecoderClient: Invalid partial bitmap for request {}", image_id);
+        return;
+    }
+
+    callback->value(*bitmap_sequence.bitmaps[0], decoded_rows);
+}
+
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/Queue.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
 #include <LibCore/Promise.h>
@@ -20,12 +21,29 @@ struct Frame {
 };
 
 struct DecodedImage {
+    i64 image_id { 0 };
     bool is_animated { false };
     Gfx::FloatPoint scale { 1, 1 };
     u32 loop_count { 0 };
+    u32 frame_count { 0 };
+
+    // With FrameDecoding::OnDemand, this only holds the first frame of an animation.
     Vector<Frame> frames;
 };
 
+enum class FrameDecoding {
+    // The image is only resolved once every frame has been decoded.
+    AllFrames,
+
+    // Only the first frame is decoded.
+    FirstFrameOnly,
+
+    // Only the first frame of an animation is decoded up front. The others have to be requested with
+    // request_animation_frames(), and the image has to be released with release_animated_image() when it is no longer
+    // needed.
+    OnDemand,
+};
+
 class Client final
     : public IPC::ConnectionToServer<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint>
     , public ImageDecoderClientEndpoint {
@@ -34,17 +52,43 @@ class Client final
 public:
     Client(NonnullOwnPtr<Core::LocalSocket>);
 
-    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
+    NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {}, FrameDecoding = FrameDecoding::AllFrames);
+
+    // Frames that failed to decode are empty. Requests for the same image are answered in order.
+    using AnimationFramesCallback = Function<void(u32 start_frame_index, Vector<Optional<Frame>>&)>;
+    void request_animation_frames(i64 image_id, u32 start_frame_index, u32 frame_count, AnimationFramesCallback);
+    void release_animated_image(i64 image_id);
+
+    // Decodes an image while its data is still arriving. Partial images of the first frame are passed to the callback
+    // as the data comes in, along with the number of rows at their top that are decoded. Once all of the data has been
+    // appended, finish_incremental_decode() decodes the image just like decode_image() does.
+    using PartialImageCallback = Function<void(NonnullRefPtr<Gfx::Bitmap>, u32 decoded_rows)>;
+    Optional<i64> begin_incremental_decode(PartialImageCallback, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
+    void append_incremental_data(i64 image_id, ReadonlyBytes);
+    NonnullRefPtr<Core::Promise<DecodedImage>> finish_incremental_decode(i64 image_id, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, FrameDecoding = FrameDecoding::AllFrames);
+    void cancel_incremental_decode(i64 image_id);
 
     Function<void()> on_death;
 
 private:
     virtual void die() override;
 
-    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale) override;
+    virtual void did_decode_image(i64 image_id, bool is_animated, u32 loop_count, u32 frame_count, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations, Gfx::FloatPoint scale) override;
+    virtual void did_decode_animation_frames(i64 image_id, u32 start_frame_index, Gfx::BitmapSequence const& bitmap_sequence, Vector<u32> const& durations) override;
     virtual void did_fail_to_decode_image(i64 image_id, String const& error_message) override;
+    virtual void did_decode_partial_image(i64 image_id, Gfx::BitmapSequence const& bitmap_sequence, u32 decoded_rows) override;
+
+    struct PendingImage {
+        NonnullRefPtr<Core::Promise<DecodedImage>> promise;
+        FrameDecoding frame_decoding { FrameDecoding::AllFrames };
+
+        // With FrameDecoding::AllFrames, the first frame arrives on its own and the others are requested afterwards.
+        Optional<DecodedImage> partially_decoded_image;
+    };
 
-    HashMap<i64, NonnullRefPtr<Core::Promise<DecodedImage>>> m_pending_decoded_images;
+    HashMap<i64, PendingImage> m_pending_decoded_images;
+    HashMap<i64, Queue<AnimationFramesCallback>> m_animation_frames_callbacks;
+    HashMap<i64, PartialImageCallback> m_partial_image_callbacks;
 };
 
 }
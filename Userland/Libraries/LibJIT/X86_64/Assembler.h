@@ -306,6 +306,14 @@ struct X86_64Assembler {
     void shift_right(Operand dst, Operand count)
     {
         VERIFY(dst.type == Operand::Type::Reg);
+        if (count.type == Operand::Type::Reg) {
+            // shr dst, cl
+            VERIFY(count.reg == Reg::RCX);
+            emit_rex_for_slash(dst, REX_W::Yes);
+            emit8(0xd3);
+            emit_modrm_slash(5, dst);
+            return;
+        }
         VERIFY(count.type == Operand::Type::Imm);
         VERIFY(count.fits_in_u8());
         emit_rex_for_slash(dst, REX_W::Yes);
@@ -385,6 +393,15 @@ struct X86_64Assembler {
 
     void mov8(Operand dst, Operand src, Extension extension = Extension::ZeroExtend)
     {
+        if (dst.type == Operand::Type::Mem64BaseAndOffset && src.type == Operand::Type::Reg) {
+            // mov r/m8, r8
+            // FIXME: Without a REX prefix, registers 4 to 7 would be AH, CH, DH and BH.
+            VERIFY(to_underlying(src.reg) < 4 || to_underlying(src.reg) >= 8);
+            emit_rex_for_mr(dst, src, REX_W::No);
+            emit8(0x88);
+            emit_modrm_mr(dst, src);
+            return;
+        }
         VERIFY(dst.type == Operand::Type::Reg && src.type == Operand::Type::Mem64BaseAndOffset);
         // mov[sz]x r32, r/m8
         emit_rex_for_rm(dst, src, REX_W::No);
@@ -395,6 +412,14 @@ struct X86_64Assembler {
 
     void mov16(Operand dst, Operand src, Extension extension = Extension::ZeroExtend)
     {
+        if (dst.type == Operand::Type::Mem64BaseAndOffset && src.type == Operand::Type::Reg) {
+            // mov r/m16, r16
+            emit8(0x66);
+            emit_rex_for_mr(dst, src, REX_W::No);
+            emit8(0x89);
+            emit_modrm_mr(dst, src);
+            return;
+        }
         VERIFY(dst.type == Operand::Type::Reg && src.is_register_or_memory());
         // mov[sz]x r32, r/m16
         emit_rex_for_rm(dst, src, REX_W::No);
@@ -405,6 +430,13 @@ struct X86_64Assembler {
 
     void mov32(Operand dst, Operand src, Extension extension = Extension::ZeroExtend)
     {
+        if (dst.type == Operand::Type::Mem64BaseAndOffset && src.type == Operand::Type::Reg) {
+            // mov r/m32, r32
+            emit_rex_for_mr(dst, src, REX_W::No);
+            emit8(0x89);
+            emit_modrm_mr(dst, src);
+            return;
+        }
         VERIFY(dst.type == Operand::Type::Reg && src.is_register_or_memory());
         if (extension == Extension::ZeroExtend) {
             // mov r32, r/m32
@@ -640,6 +672,18 @@ struct X86_64Assembler {
         }
     }
 
+    void bitwise_xor(Operand dst, Operand src)
+    {
+        // xor dst,src
+        if (dst.is_register_or_memory() && src.type == Operand::Type::Reg) {
+            emit_rex_for_mr(dst, src, REX_W::Yes);
+            emit8(0x31);
+            emit_modrm_mr(dst, src);
+        } else {
+            VERIFY_NOT_REACHED();
+        }
+    }
+
     void bitwise_xor32(Operand dst, Operand src)
     {
         if (dst.is_register_or_memory() && src.type == Operand::Type::Reg) {
@@ -663,7 +707,13 @@ struct X86_64Assembler {
 
     void mul(Operand dest, Operand src)
     {
-        if (dest.type == Operand::Type::FReg && src.type == Operand::Type::FReg) {
+        if (dest.type == Operand::Type::Reg && src.type == Operand::Type::Reg) {
+            // imul dest, src (64-bit)
+            emit_rex_for_rm(dest, src, REX_W::Yes);
+            emit8(0x0f);
+            emit8(0xaf);
+            emit_modrm_rm(dest, src);
+        } else if (dest.type == Operand::Type::FReg && src.type == Operand::Type::FReg) {
             emit8(0xf2);
             emit8(0x0f);
             emit8(0x59);
@@ -1017,6 +1067,41 @@ struct X86_64Assembler {
         emit_modrm_rm(dst, src);
     }
 
+    // Moves four packed floats between a register and (unaligned) memory or another register.
+    void mov_packed_single(Operand dst, Operand src)
+    {
+        if (dst.type == Operand::Type::FReg && (src.type == Operand::Type::FReg || src.type == Operand::Type::Mem64BaseAndOffset)) {
+            // movups dst, src
+            emit_rex_for_rm(dst, src, REX_W::No);
+            emit8(0x0f);
+            emit8(0x10);
+            emit_modrm_rm(dst, src);
+        } else if (dst.type == Operand::Type::Mem64BaseAndOffset && src.type == Operand::Type::FReg) {
+            // movups dst, src
+            emit_rex_for_mr(dst, src, REX_W::No);
+            emit8(0x0f);
+            emit8(0x11);
+            emit_modrm_mr(dst, src);
+        } else {
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    void add_packed_single(Operand dst, Operand src) { emit_packed_single_operation(0x58, dst, src); }
+    void sub_packed_single(Operand dst, Operand src) { emit_packed_single_operation(0x5c, dst, src); }
+    void mul_packed_single(Operand dst, Operand src) { emit_packed_single_operation(0x59, dst, src); }
+    void div_packed_single(Operand dst, Operand src) { emit_packed_single_operation(0x5e, dst, src); }
+
+    void emit_packed_single_operation(u8 opcode, Operand dst, Operand src)
+    {
+        // Memory operands of these would have to be aligned, so we only allow registers.
+        VERIFY(dst.type == Operand::Type::FReg && src.type == Operand::Type::FReg);
+        emit_rex_for_rm(dst, src, REX_W::No);
+        emit8(0x0f);
+        emit8(opcode);
+        emit_modrm_rm(dst, src);
+    }
+
     void native_call(
         u64 callee,
         Vector<Operand> const& preserved_registers = {},
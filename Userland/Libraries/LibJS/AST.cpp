@@ -17,6 +17,7 @@
 #include <LibJS/AST.h>
 #include <LibJS/Heap/ConservativeVector.h>
 #include <LibJS/Heap/MarkedVector.h>
+#include <LibJS/Parser.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -835,11 +836,11 @@ void FunctionNode::dump(int indent, ByteString const& class_name) const
         print_indent(indent + 1);
         outln("\033[31;1m(direct eval)\033[0m");
     }
-    if (!m_parameters.is_empty()) {
+    if (!parameters().is_empty()) {
         print_indent(indent + 1);
         outln("(Parameters)");
 
-        for (auto& parameter : m_parameters) {
+        for (auto& parameter : parameters()) {
             parameter.binding.visit(
                 [&](Identifier const& identifier) {
                     if (parameter.is_rest) {
@@ -862,6 +863,25 @@ void FunctionNode::dump(int indent, ByteString const& class_name) const
     body().dump(indent + 2);
 }
 
+void FunctionNode::drop_body_until_needed(NonnullOwnPtr<LazyFunctionParseState> state)
+{
+    VERIFY(!m_lazy_parse_state);
+    m_lazy_parse_state = move(state);
+    m_body = nullptr;
+    m_parameters.clear();
+    m_local_variables_names.clear();
+}
+
+void FunctionNode::parse_dropped_body() const
+{
+    // NOTE: The parameters have to be parsed again along with the body, as the identifiers in both refer to the local variables of the function.
+    auto function = Parser::parse_function_with_dropped_body(*m_lazy_parse_state);
+    m_body = function->body();
+    m_parameters = function->parameters();
+    m_local_variables_names = function->local_variables_names();
+    m_lazy_parse_state = nullptr;
+}
+
 void FunctionDeclaration::dump(int indent) const
 {
     FunctionNode::dump(indent, class_name());
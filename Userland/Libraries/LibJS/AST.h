@@ -700,15 +700,41 @@ struct FunctionParsingInsights {
     bool might_need_arguments_object { false };
 };
 
+// Everything needed to parse a function again after its parameters and body have been dropped, see Parser::drop_bodies_of_lazily_parsed_functions().
+struct LazyFunctionParseState {
+    NonnullRefPtr<SourceCode const> source_code;
+    ByteString source;
+    Position function_start;
+    Position parse_start;
+    u16 parse_options { 0 };
+    Program::Type program_type { Program::Type::Script };
+    bool strict_mode { false };
+    // The free identifiers of the function that were found to refer to global variables, which can't be
+    // determined again without the scopes around the function.
+    HashTable<DeprecatedFlyString> global_identifier_names;
+};
+
 class FunctionNode {
 public:
     StringView name() const { return m_name ? m_name->string().view() : ""sv; }
     RefPtr<Identifier const> name_identifier() const { return m_name; }
     ByteString const& source_text() const { return m_source_text; }
-    Statement const& body() const { return *m_body; }
-    Vector<FunctionParameter> const& parameters() const { return m_parameters; }
+    Statement const& body() const
+    {
+        ensure_body_is_parsed();
+        return *m_body;
+    }
+    Vector<FunctionParameter> const& parameters() const
+    {
+        ensure_body_is_parsed();
+        return m_parameters;
+    }
     i32 function_length() const { return m_function_length; }
-    Vector<DeprecatedFlyString> const& local_variables_names() const { return m_local_variables_names; }
+    Vector<DeprecatedFlyString> const& local_variables_names() const
+    {
+        ensure_body_is_parsed();
+        return m_local_variables_names;
+    }
     bool is_strict_mode() const { return m_is_strict_mode; }
     bool might_need_arguments_object() const { return m_parsing_insights.might_need_arguments_object; }
     bool contains_direct_call_to_eval() const { return m_parsing_insights.contains_direct_call_to_eval; }
@@ -717,6 +743,9 @@ public:
     FunctionKind kind() const { return m_kind; }
     bool uses_this_from_environment() const { return m_parsing_insights.uses_this_from_environment; }
 
+    // Frees the parameters and body until they're needed again, at which point they're parsed from the source again.
+    void drop_body_until_needed(NonnullOwnPtr<LazyFunctionParseState>);
+
     virtual bool has_name() const = 0;
     virtual Value instantiate_ordinary_function_expression(VM&, DeprecatedFlyString given_name) const = 0;
 
@@ -744,16 +773,24 @@ protected:
     RefPtr<Identifier const> m_name { nullptr };
 
 private:
+    void ensure_body_is_parsed() const
+    {
+        if (m_lazy_parse_state) [[unlikely]]
+            parse_dropped_body();
+    }
+    void parse_dropped_body() const;
+
     ByteString m_source_text;
-    NonnullRefPtr<Statement const> m_body;
-    Vector<FunctionParameter> const m_parameters;
+    mutable RefPtr<Statement const> m_body;
+    mutable Vector<FunctionParameter> m_parameters;
     i32 const m_function_length;
     FunctionKind m_kind;
     bool m_is_strict_mode : 1 { false };
     bool m_is_arrow_function : 1 { false };
     FunctionParsingInsights m_parsing_insights;
 
-    Vector<DeprecatedFlyString> m_local_variables_names;
+    mutable Vector<DeprecatedFlyString> m_local_variables_names;
+    mutable OwnPtr<LazyFunctionParseState> m_lazy_parse_state;
 };
 
 class FunctionDeclaration final
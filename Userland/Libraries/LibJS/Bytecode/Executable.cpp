@@ -4,10 +4,13 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/SourceCode.h>
 
 namespace JS::Bytecode {
@@ -38,7 +41,11 @@ Executable::Executable(
     global_variable_caches.resize(number_of_global_variable_caches);
 }
 
-Executable::~Executable() = default;
+Executable::~Executable()
+{
+    if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+        dump_property_lookup_cache_statistics();
+}
 
 void Executable::dump() const
 {
@@ -83,6 +90,73 @@ void Executable::dump() const
     warnln("");
 }
 
+void Executable::dump_property_lookup_cache_statistics() const
+{
+    struct CacheSite {
+        size_t offset;
+        StringView instruction_name;
+        StringView property_name;
+        PropertyLookupCache const& cache;
+    };
+    Vector<CacheSite> sites;
+
+    InstructionStreamIterator it(bytecode, this);
+    while (!it.at_end()) {
+        auto const& instruction = *it;
+        auto add_site = [&](StringView instruction_name, StringView property_name, u32 cache_index) {
+            auto const& cache = property_lookup_caches[cache_index];
+            if (cache.hit_count != 0 || cache.miss_count != 0)
+                sites.append({ it.offset(), instruction_name, property_name, cache });
+        };
+
+        switch (instruction.type()) {
+#define __BYTECODE_OP(op)                                                                                 \
+    case Instruction::Type::op: {                                                                         \
+        auto const& typed_instruction = static_cast<Op::op const&>(instruction);                          \
+        add_site(#op##sv, get_identifier(typed_instruction.property()), typed_instruction.cache_index()); \
+        break;                                                                                            \
+    }
+            __BYTECODE_OP(GetById)
+            __BYTECODE_OP(GetByIdWithThis)
+            __BYTECODE_OP(PutById)
+            __BYTECODE_OP(PutByIdWithThis)
+#undef __BYTECODE_OP
+        case Instruction::Type::GetLength:
+            add_site("GetLength"sv, "length"sv, static_cast<Op::GetLength const&>(instruction).cache_index());
+            break;
+        case Instruction::Type::GetLengthWithThis:
+            add_site("GetLengthWithThis"sv, "length"sv, static_cast<Op::GetLengthWithThis const&>(instruction).cache_index());
+            break;
+        default:
+            break;
+        }
+
+        ++it;
+    }
+
+    if (sites.is_empty())
+        return;
+
+    warnln("\033[37;1mProperty lookup caches\033[0m of \"{}\"", name);
+    for (auto const& site : sites) {
+        auto const& cache = site.cache;
+        size_t number_of_shapes = 0;
+        for (auto const& entry : cache.entries) {
+            if (entry.shape)
+                ++number_of_shapes;
+        }
+        auto accesses = static_cast<u64>(cache.hit_count) + cache.miss_count;
+        warnln("    [{:4x}] {} {}: {} hits, {} misses ({}% hit rate), {} shapes",
+            site.offset,
+            site.instruction_name,
+            site.property_name,
+            cache.hit_count,
+            cache.miss_count,
+            cache.hit_count * 100 / accesses,
+            number_of_shapes);
+    }
+}
+
 void Executable::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
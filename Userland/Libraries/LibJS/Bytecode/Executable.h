@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -22,14 +23,36 @@
 
 namespace JS::Bytecode {
 
+// A polymorphic inline cache, which remembers where the property is for the last few shapes seen at its site.
 struct PropertyLookupCache {
-    WeakPtr<Shape> shape;
-    Optional<u32> property_offset;
-    WeakPtr<Object> prototype;
-    WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    static constexpr size_t max_number_of_shapes = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        // Set if the property was found in this prototype, which can be used as long as the chain stays valid.
+        WeakPtr<Object> prototype;
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    };
+
+    // The most recently added entry comes first.
+    AK::Array<Entry, max_number_of_shapes> entries;
+
+    // Only counted with JS_PROPERTY_LOOKUP_CACHE_DEBUG, see Executable::dump_property_lookup_cache_statistics().
+    u32 hit_count { 0 };
+    u32 miss_count { 0 };
+
+    // Makes room for a new entry, evicting the oldest one if the cache is full.
+    Entry& add_entry()
+    {
+        for (size_t i = entries.size() - 1; i > 0; --i)
+            entries[i] = move(entries[i - 1]);
+        entries[0] = {};
+        return entries[0];
+    }
 };
 
-struct GlobalVariableCache : public PropertyLookupCache {
+struct GlobalVariableCache : public PropertyLookupCache::Entry {
     u64 environment_serial_number { 0 };
     Optional<u32> environment_binding_index;
 };
@@ -88,6 +111,11 @@ public:
 
     Optional<IdentifierTableIndex> length_identifier;
 
+    // Counts how often the executable has been entered or looped, see Interpreter::should_run_native_code().
+    u32 hotness { 0 };
+    bool did_try_jitting { false };
+    OwnPtr<JIT::NativeExecutable> native_executable;
+
     ByteString const& get_string(StringTableIndex index) const { return string_table->get(index); }
     DeprecatedFlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
 
@@ -103,6 +131,7 @@ public:
     [[nodiscard]] UnrealizedSourceRange source_range_at(size_t offset) const;
 
     void dump() const;
+    void dump_property_lookup_cache_statistics() const;
 
 private:
     virtual void visit_edges(Visitor&) override;
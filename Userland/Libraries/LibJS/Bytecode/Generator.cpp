@@ -10,10 +10,12 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/VM.h>
+#include <LibJS/Runtime/ValueInlines.h>
 
 namespace JS::Bytecode {
 
@@ -199,6 +201,164 @@ CodeGenerationErrorOr<void> Generator::emit_function_declaration_instantiation(E
     return {};
 }
 
+void Generator::fold_constant_conditional_jumps()
+{
+    for (auto& block : m_root_basic_blocks) {
+        if (!block->is_terminated())
+            continue;
+
+        auto offset = block->last_instruction_start_offset();
+        auto& terminator = *reinterpret_cast<Instruction*>(block->data() + offset);
+
+        auto constant_condition = [&](Operand condition) -> Optional<Value> {
+            if (!condition.is_constant())
+                return {};
+            return m_constants[condition.index()];
+        };
+
+        Optional<Label> target;
+        switch (terminator.type()) {
+        case Instruction::Type::JumpIf: {
+            auto& jump = static_cast<Op::JumpIf const&>(terminator);
+            if (auto condition = constant_condition(jump.condition()); condition.has_value())
+                target = condition->to_boolean() ? jump.true_target() : jump.false_target();
+            break;
+        }
+        case Instruction::Type::JumpNullish: {
+            auto& jump = static_cast<Op::JumpNullish const&>(terminator);
+            if (auto condition = constant_condition(jump.condition()); condition.has_value())
+                target = condition->is_nullish() ? jump.true_target() : jump.false_target();
+            break;
+        }
+        case Instruction::Type::JumpUndefined: {
+            auto& jump = static_cast<Op::JumpUndefined const&>(terminator);
+            if (auto condition = constant_condition(jump.condition()); condition.has_value())
+                target = condition->is_undefined() ? jump.true_target() : jump.false_target();
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (!target.has_value())
+            continue;
+
+        // OPTIMIZATION: Conditions like the one in `while (1)` are known at compile time, so replace the conditional
+        //               jump with an unconditional one. This also makes the other target dead if nothing else jumps there.
+        auto source_record = block->source_map().get(offset);
+        Instruction::destroy(terminator);
+        block->rewind();
+        switch_to_basic_block(*block);
+        emit<Op::Jump>(*target);
+        if (source_record.has_value())
+            block->add_source_map_entry(offset, *source_record);
+    }
+}
+
+void Generator::thread_jumps()
+{
+    // Returns the target of the block's jump if that's the only thing the block does.
+    auto forwarded_target = [&](BasicBlock const& block) -> Optional<Label> {
+        if (block.size() == 0)
+            return {};
+        auto const& instruction = *reinterpret_cast<Instruction const*>(block.data());
+        if (instruction.type() != Instruction::Type::Jump || instruction.length() != block.size())
+            return {};
+        return static_cast<Op::Jump const&>(instruction).target();
+    };
+
+    // OPTIMIZATION: Jump straight to the end of chains of blocks that only jump elsewhere, like the ones that
+    //               break and continue leave behind. Jumps can't throw, so skipping them is fine even if the skipped
+    //               blocks have a different handler.
+    for (auto& block : m_root_basic_blocks) {
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            auto& instruction = const_cast<Instruction&>(*it);
+            instruction.visit_labels([&](Label& label) {
+                // Bound the number of hops, since empty loops like `for (;;) {}` form a cycle of jumps.
+                for (size_t hops = 0; hops < m_root_basic_blocks.size(); ++hops) {
+                    auto target = forwarded_target(*m_root_basic_blocks[label.basic_block_index()]);
+                    if (!target.has_value() || target->basic_block_index() == label.basic_block_index())
+                        break;
+                    label = *target;
+                }
+            });
+            ++it;
+        }
+    }
+}
+
+Vector<bool> Generator::find_reachable_blocks() const
+{
+    Vector<bool> is_reachable;
+    is_reachable.resize(m_root_basic_blocks.size());
+
+    Vector<BasicBlock const*> worklist;
+    auto mark_reachable = [&](BasicBlock const& block) {
+        if (is_reachable[block.index()])
+            return;
+        is_reachable[block.index()] = true;
+        worklist.append(&block);
+    };
+
+    // NOTE: Blocks never fall through into the next one, so the only ways into a block are labels and exceptions.
+    mark_reachable(*m_root_basic_blocks.first());
+    while (!worklist.is_empty()) {
+        auto const& block = *worklist.take_last();
+        if (block.handler())
+            mark_reachable(*block.handler());
+        if (block.finalizer())
+            mark_reachable(*block.finalizer());
+
+        InstructionStreamIterator it(block.instruction_stream());
+        while (!it.at_end()) {
+            const_cast<Instruction&>(*it).visit_labels([&](Label& label) {
+                mark_reachable(*m_root_basic_blocks[label.basic_block_index()]);
+            });
+            ++it;
+        }
+    }
+
+    return is_reachable;
+}
+
+u32 Generator::compact_registers(Vector<bool> const& is_reachable)
+{
+    // OPTIMIZATION: Registers that are only used by unreachable blocks (or not at all) don't need a slot in the
+    //               register file, so renumber the rest to be contiguous.
+    Vector<Optional<u32>> new_register_index;
+    new_register_index.resize(m_next_register);
+    for (u32 i = 0; i < Register::reserved_register_count; ++i)
+        new_register_index[i] = i;
+
+    auto for_each_register_operand = [&](auto callback) {
+        for (auto& block : m_root_basic_blocks) {
+            if (!is_reachable[block->index()])
+                continue;
+            InstructionStreamIterator it(block->instruction_stream());
+            while (!it.at_end()) {
+                const_cast<Instruction&>(*it).visit_operands([&](Operand& operand) {
+                    if (operand.is_register())
+                        callback(operand);
+                });
+                ++it;
+            }
+        }
+    };
+
+    u32 number_of_registers = Register::reserved_register_count;
+    for_each_register_operand([&](Operand& operand) {
+        auto& index = new_register_index[operand.index()];
+        if (!index.has_value())
+            index = number_of_registers++;
+    });
+    for_each_register_operand([&](Operand& operand) {
+        operand = Operand(Operand::Type::Register, new_register_index[operand.index()].value());
+    });
+
+    return number_of_registers;
+}
+
 CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNode const& node, FunctionKind enclosing_function_kind, GCPtr<ECMAScriptFunctionObject const> function, MustPropagateCompletion must_propagate_completion, Vector<DeprecatedFlyString> local_variable_names)
 {
     Generator generator(vm, function, must_propagate_completion);
@@ -251,9 +411,31 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
     else if (is<FunctionDeclaration>(node))
         is_strict_mode = static_cast<FunctionDeclaration const&>(node).is_strict_mode();
 
+    auto number_of_registers = generator.m_next_register;
+    Vector<bool> is_reachable;
+    if (g_optimize_bytecode) {
+        generator.fold_constant_conditional_jumps();
+        generator.thread_jumps();
+        is_reachable = generator.find_reachable_blocks();
+        number_of_registers = generator.compact_registers(is_reachable);
+    } else {
+        is_reachable.resize(generator.m_root_basic_blocks.size());
+        is_reachable.span().fill(true);
+    }
+
+    // OPTIMIZATION: Unreachable blocks are left out of the executable.
+    auto next_reachable_block_index = [&](BasicBlock const& block) -> Optional<size_t> {
+        for (size_t i = block.index() + 1; i < is_reachable.size(); ++i) {
+            if (is_reachable[i])
+                return i;
+        }
+        return {};
+    };
+
     size_t size_needed = 0;
     for (auto& block : generator.m_root_basic_blocks) {
-        size_needed += block->size();
+        if (is_reachable[block->index()])
+            size_needed += block->size();
     }
 
     Vector<u8> bytecode;
@@ -278,7 +460,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
     Optional<ScopedOperand> undefined_constant;
 
     for (auto& block : generator.m_root_basic_blocks) {
-        if (!block->is_terminated()) {
+        if (is_reachable[block->index()] && !block->is_terminated()) {
             // NOTE: We must ensure that the "undefined" constant, which will be used by the not yet
             // emitted End instruction, is taken into account while shifting local operands by the
             // number of constants.
@@ -287,7 +469,6 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
         }
     }
 
-    auto number_of_registers = generator.m_next_register;
     auto number_of_constants = generator.m_constants.size();
 
     // Pass: Rewrite the bytecode to use the correct register and constant indices.
@@ -320,6 +501,10 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
         undefined_constant.value().operand().offset_index_by(number_of_registers);
 
     for (auto& block : generator.m_root_basic_blocks) {
+        if (!is_reachable[block->index()])
+            continue;
+
+        auto next_block_index = next_reachable_block_index(*block);
         basic_block_start_offsets.append(bytecode.size());
         if (block->handler() || block->finalizer()) {
             unlinked_exception_handlers.append({
@@ -332,19 +517,29 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
 
         block_offsets.set(block.ptr(), bytecode.size());
 
-        for (auto& [offset, source_record] : block->source_map()) {
-            source_map.set(bytecode.size() + offset, source_record);
-        }
-
         Bytecode::InstructionStreamIterator it(block->instruction_stream());
         while (!it.at_end()) {
             auto& instruction = const_cast<Instruction&>(*it);
 
+            // NOTE: Instructions may be dropped or replaced with shorter ones below, so the source map entries are
+            //       added as we go.
+            if (auto source_record = block->source_map().get(it.offset()); source_record.has_value())
+                source_map.set(bytecode.size(), *source_record);
+
+            // OPTIMIZATION: Moves from an operand into itself don't do anything.
+            if (g_optimize_bytecode && instruction.type() == Instruction::Type::Mov) {
+                auto& mov = static_cast<Bytecode::Op::Mov const&>(instruction);
+                if (mov.dst() == mov.src()) {
+                    ++it;
+                    continue;
+                }
+            }
+
             if (instruction.type() == Instruction::Type::Jump) {
                 auto& jump = static_cast<Bytecode::Op::Jump&>(instruction);
 
                 // OPTIMIZATION: Don't emit jumps that just jump to the next block.
-                if (jump.target().basic_block_index() == block->index() + 1) {
+                if (jump.target().basic_block_index() == next_block_index) {
                     if (basic_block_start_offsets.last() == bytecode.size()) {
                         // This block is empty, just skip it.
                         basic_block_start_offsets.take_last();
@@ -381,7 +576,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
             //               we can emit a `JumpTrue` or `JumpFalse` (to the other block) instead.
             if (instruction.type() == Instruction::Type::JumpIf) {
                 auto& jump = static_cast<Bytecode::Op::JumpIf&>(instruction);
-                if (jump.true_target().basic_block_index() == block->index() + 1) {
+                if (jump.true_target().basic_block_index() == next_block_index) {
                     Op::JumpFalse jump_false(jump.condition(), Label { jump.false_target() });
                     auto& label = jump_false.target();
                     size_t label_offset = bytecode.size() + (bit_cast<FlatPtr>(&label) - bit_cast<FlatPtr>(&jump_false));
@@ -390,7 +585,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
                     ++it;
                     continue;
                 }
-                if (jump.false_target().basic_block_index() == block->index() + 1) {
+                if (jump.false_target().basic_block_index() == next_block_index) {
                     Op::JumpTrue jump_true(jump.condition(), Label { jump.true_target() });
                     auto& label = jump_true.target();
                     size_t label_offset = bytecode.size() + (bit_cast<FlatPtr>(&label) - bit_cast<FlatPtr>(&jump_true));
@@ -431,7 +626,7 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::compile(VM& vm, ASTNo
         node.source_code(),
         generator.m_next_property_lookup_cache,
         generator.m_next_global_variable_cache,
-        generator.m_next_register,
+        number_of_registers,
         is_strict_mode);
 
     Vector<Executable::ExceptionHandlers> linked_exception_handlers;
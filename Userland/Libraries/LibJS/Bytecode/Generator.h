@@ -360,6 +360,12 @@ private:
     // Returns true if a fused instruction was emitted.
     [[nodiscard]] bool fuse_compare_and_jump(ScopedOperand const& condition, Label true_target, Label false_target);
 
+    // Optimization passes over the finished basic blocks, see compile().
+    void fold_constant_conditional_jumps();
+    void thread_jumps();
+    [[nodiscard]] Vector<bool> find_reachable_blocks() const;
+    [[nodiscard]] u32 compact_registers(Vector<bool> const& is_reachable);
+
     struct LabelableScope {
         Label bytecode_target;
         Vector<DeprecatedFlyString> language_label_set;
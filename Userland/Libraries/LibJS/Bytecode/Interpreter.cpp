@@ -14,6 +14,8 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -39,6 +41,8 @@
 namespace JS::Bytecode {
 
 bool g_dump_bytecode = false;
+bool g_enable_jit = false;
+bool g_optimize_bytecode = true;
 
 static ByteString format_operand(StringView name, Operand operand, Bytecode::Executable const& executable)
 {
@@ -230,7 +234,16 @@ ThrowCompletionOr<Value> Interpreter::run(Script& script_record, JS::GCPtr<Envir
 
     // 13. If result.[[Type]] is normal, then
     if (result.type() == Completion::Type::Normal) {
-        auto executable_result = JS::Bytecode::Generator::generate_from_ast_node(vm, script, {});
+        // NOTE: The parse tree may be shared with earlier runs of the same script through the VM's ProgramCache,
+        //       in which case we reuse the bytecode that was generated back then.
+        auto executable_result = [&]() -> CodeGenerationErrorOr<NonnullGCPtr<Executable>> {
+            if (auto* executable = script.bytecode_executable())
+                return NonnullGCPtr { *executable };
+            auto executable = TRY(JS::Bytecode::Generator::generate_from_ast_node(vm, script, {}));
+            if (vm.program_cache().contains(script))
+                const_cast<Program&>(script).set_bytecode_executable(executable);
+            return executable;
+        }();
 
         if (executable_result.is_error()) {
             if (auto error_string = executable_result.error().to_string(); error_string.is_error())
@@ -339,11 +352,11 @@ Interpreter::HandleExceptionResponse Interpreter::handle_exception(size_t& progr
 #    define FLATTEN_ON_CLANG
 #endif
 
-FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
+FLATTEN_ON_CLANG Optional<size_t> Interpreter::run_bytecode(size_t entry_point)
 {
     if (vm().did_reach_stack_space_limit()) {
         reg(Register::exception()) = vm().throw_completion<InternalError>(ErrorType::CallStackSizeExceeded).release_value().value();
-        return;
+        return {};
     }
 
     auto& running_execution_context = this->running_execution_context();
@@ -402,12 +415,16 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
         handle_End: {
             auto& instruction = *reinterpret_cast<Op::End const*>(&bytecode[program_counter]);
             accumulator = get(instruction.value());
-            return;
+            return {};
         }
 
         handle_Jump: {
             auto& instruction = *reinterpret_cast<Op::Jump const*>(&bytecode[program_counter]);
-            program_counter = instruction.target().address();
+            auto target = instruction.target().address();
+            // Loops jump backwards, which is where hot code continues in native code.
+            if (target <= program_counter && should_run_native_code(executable)) [[unlikely]]
+                return target;
+            program_counter = target;
             goto start;
         }
 
@@ -466,7 +483,7 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
         auto result = op_snake_case(vm(), get(instruction.lhs()), get(instruction.rhs()));                              \
         if (result.is_error()) {                                                                                        \
             if (handle_exception(program_counter, result.error_value()) == HandleExceptionResponse::ExitFromExecutable) \
-                return;                                                                                                 \
+                return {};                                                                                              \
             goto start;                                                                                                 \
         }                                                                                                               \
         if (result.value().to_boolean())                                                                                \
@@ -499,7 +516,7 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             auto& instruction = *reinterpret_cast<Op::ContinuePendingUnwind const*>(&bytecode[program_counter]);
             if (auto exception = reg(Register::exception()); !exception.is_empty()) {
                 if (handle_exception(program_counter, exception) == HandleExceptionResponse::ExitFromExecutable)
-                    return;
+                    return {};
                 goto start;
             }
             if (!saved_return_value().is_empty()) {
@@ -516,7 +533,7 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
                         goto start;
                     }
                 }
-                return;
+                return {};
             }
             auto const old_scheduled_jump = running_execution_context.previously_scheduled_jumps.take_last();
             if (m_scheduled_jump.has_value()) {
@@ -548,7 +565,7 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             auto result = instruction.execute_impl(*this);                                                                  \
             if (result.is_error()) {                                                                                        \
                 if (handle_exception(program_counter, result.error_value()) == HandleExceptionResponse::ExitFromExecutable) \
-                    return;                                                                                                 \
+                    return {};                                                                                              \
                 goto start;                                                                                                 \
             }                                                                                                               \
         }                                                                                                                   \
@@ -672,13 +689,13 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
         handle_Await: {
             auto& instruction = *reinterpret_cast<Op::Await const*>(&bytecode[program_counter]);
             instruction.execute_impl(*this);
-            return;
+            return {};
         }
 
         handle_Return: {
             auto& instruction = *reinterpret_cast<Op::Return const*>(&bytecode[program_counter]);
             instruction.execute_impl(*this);
-            return;
+            return {};
         }
 
         handle_Yield: {
@@ -689,12 +706,61 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
             //       but we generate a Yield Operation in the case of returns in
             //       generators as well, so we need to check if it will actually
             //       continue or is a `return` in disguise
-            return;
+            return {};
         }
         }
     }
 }
 
+bool Interpreter::should_run_native_code(Executable& executable)
+{
+    if (executable.native_executable)
+        return true;
+    if (!g_enable_jit || executable.did_try_jitting)
+        return false;
+    if (++executable.hotness < JIT::Compiler::hotness_threshold)
+        return false;
+
+    executable.did_try_jitting = true;
+    executable.native_executable = JIT::Compiler::compile(executable);
+    dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did compile unit {:p} to native code: {}", &executable, executable.native_executable != nullptr);
+    return executable.native_executable != nullptr;
+}
+
+void Interpreter::run_bytecode_or_native_code(size_t entry_point)
+{
+    if (vm().did_reach_stack_space_limit()) {
+        reg(Register::exception()) = vm().throw_completion<InternalError>(ErrorType::CallStackSizeExceeded).release_value().value();
+        return;
+    }
+
+    auto& executable = current_executable();
+    Optional<size_t> native_entry_point;
+    if (should_run_native_code(executable))
+        native_entry_point = entry_point;
+    else
+        native_entry_point = run_bytecode(entry_point);
+
+    while (native_entry_point.has_value()) {
+        size_t program_counter = native_entry_point.release_value();
+        TemporaryChange change(m_program_counter, Optional<size_t&>(program_counter));
+
+        auto exit_reason = executable.native_executable->run(*this, program_counter, m_registers_and_constants_and_locals, m_arguments);
+        switch (exit_reason) {
+        case JIT::NativeExecutable::ExitReason::Finished:
+            return;
+        case JIT::NativeExecutable::ExitReason::Exception:
+            if (handle_exception(program_counter, reg(Register::exception())) == HandleExceptionResponse::ExitFromExecutable)
+                return;
+            native_entry_point = program_counter;
+            break;
+        case JIT::NativeExecutable::ExitReason::Bailout:
+            native_entry_point = run_bytecode(program_counter);
+            break;
+        }
+    }
+}
+
 Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& executable, Optional<size_t> entry_point, Value initial_accumulator_value)
 {
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter will run unit {:p}", &executable);
@@ -732,7 +798,7 @@ Interpreter::ResultAndReturnRegister Interpreter::run_executable(Executable& exe
         running_execution_context.registers_and_constants_and_locals[executable.number_of_registers + i] = executable.constants[i];
     }
 
-    run_bytecode(entry_point.value_or(0));
+    run_bytecode_or_native_code(entry_point.value_or(0));
 
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
 
@@ -956,6 +1022,18 @@ ALWAYS_INLINE ThrowCompletionOr<NonnullGCPtr<Object>> base_object_for_get(VM& vm
     return throw_null_or_undefined_property_get(vm, base_value, base_identifier, property, executable);
 }
 
+// Returns the (cleared) entry to record the given shape in, reusing the one that already has this shape if there is one.
+static PropertyLookupCache::Entry& cache_entry_for_shape(PropertyLookupCache& cache, Shape const& shape)
+{
+    for (auto& entry : cache.entries) {
+        if (entry.shape == &shape) {
+            entry = {};
+            return entry;
+        }
+    }
+    return cache.add_entry();
+}
+
 enum class GetByIdMode {
     Normal,
     Length,
@@ -966,7 +1044,7 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
 {
     if constexpr (mode == GetByIdMode::Length) {
         if (base_value.is_string()) {
-            return Value(base_value.as_string().utf16_string().length_in_code_units());
+            return Value(base_value.as_string().length_in_utf16_code_units());
         }
     }
 
@@ -981,44 +1059,43 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
 
     auto& shape = base_obj->shape();
 
-    if (cache.prototype) {
-        // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
-        bool can_use_cache = [&]() -> bool {
-            if (&shape != cache.shape)
-                return false;
-            if (!cache.prototype_chain_validity)
-                return false;
-            if (!cache.prototype_chain_validity->is_valid())
-                return false;
-            return true;
-        }();
-        if (can_use_cache) {
-            auto value = cache.prototype->get_direct(cache.property_offset.value());
-            if (value.is_accessor())
-                return TRY(call(vm, value.as_accessor().getter(), this_value));
-            return value;
+    for (auto& entry : cache.entries) {
+        if (&shape != entry.shape)
+            continue;
+
+        Object const* holder = base_obj;
+        if (entry.prototype) {
+            // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
+            if (!entry.prototype_chain_validity || !entry.prototype_chain_validity->is_valid())
+                break;
+            holder = entry.prototype;
         }
-    } else if (&shape == cache.shape) {
-        // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
-        auto value = base_obj->get_direct(cache.property_offset.value());
+
+        // OPTIMIZATION: If we've seen this shape before, we can use the cached property offset.
+        if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+            ++cache.hit_count;
+        auto value = holder->get_direct(entry.property_offset.value());
         if (value.is_accessor())
             return TRY(call(vm, value.as_accessor().getter(), this_value));
         return value;
     }
 
+    if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+        ++cache.miss_count;
+
     CacheablePropertyMetadata cacheable_metadata;
     auto value = TRY(base_obj->internal_get(executable.get_identifier(property), this_value, &cacheable_metadata));
 
     if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache = {};
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
+        auto& entry = cache_entry_for_shape(cache, shape);
+        entry.shape = shape;
+        entry.property_offset = cacheable_metadata.property_offset.value();
     } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-        cache = {};
-        cache.shape = &base_obj->shape();
-        cache.property_offset = cacheable_metadata.property_offset.value();
-        cache.prototype = *cacheable_metadata.prototype;
-        cache.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+        auto& entry = cache_entry_for_shape(cache, shape);
+        entry.shape = shape;
+        entry.property_offset = cacheable_metadata.property_offset.value();
+        entry.prototype = *cacheable_metadata.prototype;
+        entry.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
     }
 
     return value;
@@ -1188,17 +1265,26 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         break;
     }
     case Op::PropertyKind::KeyValue: {
-        if (cache && cache->shape == &object->shape()) {
-            object->put_direct(*cache->property_offset, value);
-            return {};
+        if (cache) {
+            for (auto& entry : cache->entries) {
+                if (entry.shape != &object->shape())
+                    continue;
+                if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+                    ++cache->hit_count;
+                object->put_direct(*entry.property_offset, value);
+                return {};
+            }
+            if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+                ++cache->miss_count;
         }
 
         CacheablePropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
         if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache->shape = object->shape();
-            cache->property_offset = cacheable_metadata.property_offset.value();
+            auto& entry = cache_entry_for_shape(*cache, object->shape());
+            entry.shape = object->shape();
+            entry.property_offset = cacheable_metadata.property_offset.value();
         }
 
         if (!succeeded && vm.in_strict_mode()) {
@@ -1296,14 +1382,8 @@ inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<Depreca
         if (storage
             && storage->is_simple_storage()
             && !object.may_interfere_with_indexed_property_access()) {
-            auto maybe_value = storage->get(index);
-            if (maybe_value.has_value()) {
-                auto existing_value = maybe_value->value;
-                if (!existing_value.is_accessor()) {
-                    storage->put(index, value);
-                    return {};
-                }
-            }
+            if (static_cast<SimpleIndexedPropertyStorage*>(storage)->inline_put_existing(index, value))
+                return {};
         }
 
         // For typed arrays:
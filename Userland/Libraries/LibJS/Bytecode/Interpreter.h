@@ -81,7 +81,11 @@ public:
     ExecutionContext& running_execution_context() { return *m_running_execution_context; }
 
 private:
-    void run_bytecode(size_t entry_point);
+    void run_bytecode_or_native_code(size_t entry_point);
+
+    // Returns where to continue in native code, if the executable has become hot enough for that.
+    [[nodiscard]] Optional<size_t> run_bytecode(size_t entry_point);
+    bool should_run_native_code(Executable&);
 
     enum class HandleExceptionResponse {
         ExitFromExecutable,
@@ -102,6 +106,8 @@ private:
 };
 
 extern bool g_dump_bytecode;
+extern bool g_enable_jit;
+extern bool g_optimize_bytecode;
 
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM&, ASTNode const&, JS::FunctionKind kind, DeprecatedFlyString const& name);
 ThrowCompletionOr<NonnullGCPtr<Bytecode::Executable>> compile(VM&, ECMAScriptFunctionObject const&);
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Badge.h>
 #include <AK/Format.h>
 #include <AK/Forward.h>
@@ -47,14 +48,27 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
-    enum class State : bool {
+    // Marks the cell, returning false if it was already marked. Safe to call from several marking threads at once.
+    bool try_set_marked()
+    {
+        if (AK::atomic_load(&m_mark, AK::MemoryOrder::memory_order_relaxed))
+            return false;
+        return !AK::atomic_exchange(&m_mark, true, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    enum class State : u8 {
         Live,
+        // The cell didn't survive garbage collection and has been finalized, but the heap hasn't swept it yet.
+        Finalized,
         Dead,
     };
 
     State state() const { return m_state; }
     void set_state(State state) { m_state = state; }
 
+    // Called by the heap when the cell is finalized, so that nothing can get to it through a WeakPtr until it's swept.
+    void revoke_weak_pointers(Badge<Heap>) { revoke_weak_ptrs(); }
+
     virtual StringView class_name() const = 0;
 
     class Visitor {
@@ -177,9 +191,10 @@ protected:
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
 private:
-    bool m_mark : 1 { false };
+    // NOTE: Not a bitfield, so that marking threads can set it atomically without touching the other bits.
+    bool m_mark { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
-    State m_state : 1 { State::Live };
+    State m_state : 2 { State::Live };
 };
 
 }
@@ -23,6 +23,10 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     if (!m_list_node.is_in_list())
         heap.register_cell_allocator({}, *this);
 
+    // Reuse the cells that died in the last garbage collection before growing the heap.
+    while (m_usable_blocks.is_empty() && !m_blocks_to_sweep.is_empty())
+        heap.sweep_block({}, *m_blocks_to_sweep.take_last());
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, *this, m_cell_size, m_class_name);
         auto block_ptr = reinterpret_cast<FlatPtr>(block.ptr());
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/Badge.h>
 #include <AK/Debug.h>
 #include <AK/HashTable.h>
@@ -20,8 +21,12 @@
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Heap/HeapBlock.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/WeakContainer.h>
 #include <LibJS/SafeFunction.h>
+#include <LibThreading/WorkStealingDeque.h>
+#include <LibThreading/WorkStealingThreadPool.h>
+#include <sched.h>
 #include <setjmp.h>
 
 #ifdef AK_OS_SERENITY
@@ -78,6 +83,9 @@ void Heap::will_allocate(size_t size)
     }
 
     m_allocated_bytes_since_last_gc += size;
+
+    if (!m_cell_allocators_with_blocks_to_sweep.is_empty())
+        sweep_some_blocks(blocks_to_sweep_per_allocation);
 }
 
 static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
@@ -253,6 +261,8 @@ private:
 
 AK::JsonObject Heap::dump_graph()
 {
+    sweep_all_blocks();
+
     HashMap<Cell*, HeapRoot> roots;
     gather_roots(roots);
     GraphConstructorVisitor visitor(*this, roots);
@@ -270,21 +280,37 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     perf_event(PERF_EVENT_SIGNPOST, gc_perf_string_id, global_gc_counter++);
 #endif
 
-    Core::ElapsedTimer collection_measurement_timer;
-    if (print_report)
-        collection_measurement_timer.start();
+    if (collection_type == CollectionType::CollectGarbage && m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    auto collection_measurement_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+
+    // NOTE: A block can only wait to be swept for one collection at a time, so finish sweeping the last one first.
+    sweep_all_blocks();
 
     if (collection_type == CollectionType::CollectGarbage) {
-        if (m_gc_deferrals) {
-            m_should_gc_when_deferral_ends = true;
-            return;
-        }
         HashMap<Cell*, HeapRoot> roots;
         gather_roots(roots);
         mark_live_cells(roots);
     }
     finalize_unmarked_cells();
-    sweep_dead_cells(print_report, collection_measurement_timer);
+    auto statistics = prepare_unmarked_cells_for_sweeping();
+
+    for (auto& weak_container : m_weak_containers)
+        weak_container.remove_dead_cells({});
+
+    // NOTE: If we're collecting everything, the heap is going away, so there's no time to sweep later.
+    if (collection_type == CollectionType::CollectEverything)
+        sweep_all_blocks();
+
+    m_gc_bytes_threshold = statistics.live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? statistics.live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+
+    auto pause_time = collection_measurement_timer.elapsed_time();
+    record_pause_time(pause_time);
+    if (print_report)
+        this->print_report(statistics, pause_time);
 }
 
 void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
@@ -388,6 +414,22 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
     });
 }
 
+// Calls the callback with every live cell that one of the pointer-sized values in the bytes might point to.
+template<typename Callback>
+static void for_each_live_cell_among_possible_values(ReadonlyBytes bytes, HashTable<HeapBlock*> const& all_live_heap_blocks, FlatPtr min_block_address, FlatPtr max_block_address, Callback callback)
+{
+    HashMap<FlatPtr, HeapRoot> possible_pointers;
+
+    auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
+    for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
+        add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, min_block_address, max_block_address);
+
+    for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        if (cell->state() == Cell::State::Live)
+            callback(*cell);
+    });
+}
+
 class MarkingVisitor final : public Cell::Visitor {
 public:
     explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
@@ -416,19 +458,11 @@ public:
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
-        HashMap<FlatPtr, HeapRoot> possible_pointers;
-
-        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
-        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
-
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
-            if (cell->is_marked())
+        for_each_live_cell_among_possible_values(bytes, m_all_live_heap_blocks, m_min_block_address, m_max_block_address, [&](Cell& cell) {
+            if (cell.is_marked())
                 return;
-            if (cell->state() != Cell::State::Live)
-                return;
-            cell->set_marked(true);
-            m_work_queue.append(*cell);
+            cell.set_marked(true);
+            m_work_queue.append(cell);
         });
     }
 
@@ -447,13 +481,98 @@ private:
     FlatPtr m_max_block_address;
 };
 
+// One of several visitors that mark at the same time, each on its own thread. Every visitor works through the cells
+// in its own deque and steals from the others once it runs out.
+class ParallelMarkingVisitor final : public Cell::Visitor {
+public:
+    struct SharedState {
+        HashTable<HeapBlock*> all_live_heap_blocks;
+        FlatPtr min_block_address { 0 };
+        FlatPtr max_block_address { 0 };
+        Vector<NonnullOwnPtr<ParallelMarkingVisitor>> visitors;
+        // Visitors that may still have (or produce) cells to visit.
+        Atomic<size_t> active_visitor_count { 0 };
+    };
+
+    ParallelMarkingVisitor(SharedState& shared_state, size_t index)
+        : m_shared_state(shared_state)
+        , m_index(index)
+    {
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        if (!cell.try_set_marked())
+            return;
+        m_work_queue.push(&cell);
+    }
+
+    virtual void visit_possible_values(ReadonlyBytes bytes) override
+    {
+        for_each_live_cell_among_possible_values(bytes, m_shared_state.all_live_heap_blocks, m_shared_state.min_block_address, m_shared_state.max_block_address, [&](Cell& cell) {
+            visit_impl(cell);
+        });
+    }
+
+    void mark_all_live_cells()
+    {
+        auto& active_visitor_count = m_shared_state.active_visitor_count;
+        active_visitor_count.fetch_add(1);
+
+        for (;;) {
+            while (auto* cell = m_work_queue.pop())
+                cell->visit_edges(*this);
+            if (auto* cell = steal()) {
+                cell->visit_edges(*this);
+                continue;
+            }
+
+            // NOTE: Only visitors with an empty deque go idle, and only active visitors push, so once no visitor is
+            //       active, every deque is empty for good.
+            active_visitor_count.fetch_sub(1);
+            for (;;) {
+                if (active_visitor_count.load() == 0)
+                    return;
+                if (any_visitor_has_work()) {
+                    active_visitor_count.fetch_add(1);
+                    break;
+                }
+                sched_yield();
+            }
+        }
+    }
+
+private:
+    Cell* steal()
+    {
+        auto& visitors = m_shared_state.visitors;
+        for (size_t i = 1; i < visitors.size(); ++i) {
+            if (auto* cell = visitors[(m_index + i) % visitors.size()]->m_work_queue.steal())
+                return cell;
+        }
+        return nullptr;
+    }
+
+    bool any_visitor_has_work() const
+    {
+        return any_of(m_shared_state.visitors, [](auto& visitor) { return !visitor->m_work_queue.is_empty(); });
+    }
+
+    SharedState& m_shared_state;
+    size_t m_index { 0 };
+    Threading::WorkStealingDeque<Cell> m_work_queue;
+};
+
 void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor(*this, roots);
-
-    visitor.mark_all_live_cells();
+    if (m_parallel_marking_enabled) {
+        mark_live_cells_in_parallel(roots);
+    } else {
+        MarkingVisitor visitor(*this, roots);
+        visitor.mark_all_live_cells();
+    }
 
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
@@ -461,6 +580,34 @@ void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
     m_uprooted_cells.clear();
 }
 
+void Heap::mark_live_cells_in_parallel(HashMap<Cell*, HeapRoot> const& roots)
+{
+    auto& thread_pool = Threading::WorkStealingThreadPool::the();
+
+    ParallelMarkingVisitor::SharedState shared_state;
+    find_min_and_max_block_addresses(shared_state.min_block_address, shared_state.max_block_address);
+    for_each_block([&](auto& block) {
+        shared_state.all_live_heap_blocks.set(&block);
+        return IterationDecision::Continue;
+    });
+    for (size_t i = 0; i < thread_pool.worker_count() + 1; ++i)
+        shared_state.visitors.append(make<ParallelMarkingVisitor>(shared_state, i));
+
+    // NOTE: The roots all start out in our own deque, the other visitors steal from it as soon as they start.
+    auto& our_visitor = *shared_state.visitors.first();
+    for (auto* root : roots.keys())
+        our_visitor.visit(root);
+
+    Threading::WorkStealingThreadPool::TaskGroup group;
+    for (size_t i = 1; i < shared_state.visitors.size(); ++i) {
+        thread_pool.spawn(group, [&visitor = *shared_state.visitors[i]] {
+            visitor.mark_all_live_cells();
+        });
+    }
+    our_visitor.mark_all_live_cells();
+    thread_pool.wait(group);
+}
+
 bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
 {
     if (!cell.overrides_must_survive_garbage_collection({}))
@@ -472,86 +619,130 @@ void Heap::finalize_unmarked_cells()
 {
     for_each_block([&](auto& block) {
         block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
-            if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell))
-                cell->finalize();
+            if (cell->is_marked())
+                return;
+            if (cell_must_survive_garbage_collection(*cell)) {
+                // NOTE: From here on, the mark bit alone says whether a cell survives.
+                cell->set_marked(true);
+                return;
+            }
+            cell->finalize();
         });
         return IterationDecision::Continue;
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+Heap::CollectionStatistics Heap::prepare_unmarked_cells_for_sweeping()
 {
-    dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
-    Vector<HeapBlock*, 32> empty_blocks;
-    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
-
-    size_t collected_cells = 0;
-    size_t live_cells = 0;
-    size_t collected_cell_bytes = 0;
-    size_t live_cell_bytes = 0;
+    dbgln_if(HEAP_DEBUG, "prepare_unmarked_cells_for_sweeping:");
+    CollectionStatistics statistics;
 
     for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
-        bool block_was_full = block.is_full();
+        bool block_has_finalized_cells = false;
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
-            if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
-                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
-                ++collected_cells;
-                collected_cell_bytes += block.cell_size();
-            } else {
+            if (cell->is_marked()) {
                 cell->set_marked(false);
-                block_has_live_cells = true;
-                ++live_cells;
-                live_cell_bytes += block.cell_size();
+                ++statistics.live_cells;
+                statistics.live_cell_bytes += block.cell_size();
+                return;
             }
+            dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+            cell->revoke_weak_pointers({});
+            cell->set_state(Cell::State::Finalized);
+            block_has_finalized_cells = true;
+            ++statistics.collected_cells;
+            statistics.collected_cell_bytes += block.cell_size();
         });
-        if (!block_has_live_cells)
-            empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
+
+        if (block_has_finalized_cells) {
+            auto& cell_allocator = block.cell_allocator();
+            auto& blocks_to_sweep = cell_allocator.blocks_to_sweep({});
+            if (blocks_to_sweep.is_empty())
+                m_cell_allocators_with_blocks_to_sweep.append(&cell_allocator);
+            blocks_to_sweep.append(&block);
+            ++statistics.blocks_to_sweep;
+        }
         return IterationDecision::Continue;
     });
 
-    for (auto& weak_container : m_weak_containers)
-        weak_container.remove_dead_cells({});
+    return statistics;
+}
 
-    for (auto* block : empty_blocks) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
-        block->cell_allocator().block_did_become_empty({}, *block);
-    }
+void Heap::sweep_block(HeapBlock& block)
+{
+    bool block_has_live_cells = false;
+    bool block_was_full = block.is_full();
+    block.for_each_cell([&](Cell* cell) {
+        if (cell->state() == Cell::State::Finalized)
+            block.deallocate(cell);
+        else if (cell->state() == Cell::State::Live)
+            block_has_live_cells = true;
+    });
 
-    for (auto* block : full_blocks_that_became_usable) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
-        block->cell_allocator().block_did_become_usable({}, *block);
+    if (!block_has_live_cells) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", &block, block.cell_size());
+        block.cell_allocator().block_did_become_empty({}, block);
+    } else if (block_was_full != block.is_full()) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", &block, block.cell_size());
+        block.cell_allocator().block_did_become_usable({}, block);
     }
+}
 
-    if constexpr (HEAP_DEBUG) {
-        for_each_block([&](auto& block) {
-            dbgln(" > Live HeapBlock @ {}: cell_size={}", &block, block.cell_size());
-            return IterationDecision::Continue;
-        });
+void Heap::sweep_some_blocks(size_t max_blocks)
+{
+    while (max_blocks > 0 && !m_cell_allocators_with_blocks_to_sweep.is_empty()) {
+        auto& blocks_to_sweep = m_cell_allocators_with_blocks_to_sweep.last()->blocks_to_sweep({});
+        if (blocks_to_sweep.is_empty()) {
+            m_cell_allocators_with_blocks_to_sweep.take_last();
+            continue;
+        }
+        sweep_block(*blocks_to_sweep.take_last());
+        --max_blocks;
     }
+}
 
-    m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+void Heap::sweep_all_blocks()
+{
+    sweep_some_blocks(NumericLimits<size_t>::max());
+}
 
-    if (print_report) {
-        Duration const time_spent = measurement_timer.elapsed_time();
-        size_t live_block_count = 0;
-        for_each_block([&](auto&) {
-            ++live_block_count;
-            return IterationDecision::Continue;
-        });
+void Heap::record_pause_time(Duration pause_time)
+{
+    auto milliseconds = pause_time.to_milliseconds();
+    size_t bucket = 0;
+    while (bucket < m_pause_time_histogram.size() - 1 && milliseconds >= (1 << bucket))
+        ++bucket;
+    ++m_pause_time_histogram[bucket];
+}
 
-        dbgln("Garbage collection report");
-        dbgln("=============================================");
-        dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
-        dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
-        dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
-        dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
-        dbgln("=============================================");
+void Heap::print_report(CollectionStatistics const& statistics, Duration pause_time)
+{
+    size_t live_block_count = 0;
+    for_each_block([&](auto&) {
+        ++live_block_count;
+        return IterationDecision::Continue;
+    });
+
+    dbgln("Garbage collection report");
+    dbgln("=============================================");
+    dbgln("     Time spent: {} ms", pause_time.to_milliseconds());
+    dbgln("     Live cells: {} ({} bytes)", statistics.live_cells, statistics.live_cell_bytes);
+    dbgln("Collected cells: {} ({} bytes)", statistics.collected_cells, statistics.collected_cell_bytes);
+    dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
+    dbgln("Blocks to sweep: {}", statistics.blocks_to_sweep);
+    auto shape_statistics = Shape::statistics();
+    dbgln("         Shapes: {} ({} dictionaries)", shape_statistics.shapes, shape_statistics.dictionaries);
+    dbgln("Property tables: {} ({} bytes)", shape_statistics.property_tables, shape_statistics.property_table_bytes);
+    dbgln("    Pause times:");
+    for (size_t i = 0; i < m_pause_time_histogram.size(); ++i) {
+        if (m_pause_time_histogram[i] == 0)
+            continue;
+        if (i == m_pause_time_histogram.size() - 1)
+            dbgln("      >= {:4} ms: {}", 1 << (i - 1), m_pause_time_histogram[i]);
+        else
+            dbgln("       < {:4} ms: {}", 1 << i, m_pause_time_histogram[i]);
     }
+    dbgln("=============================================");
 }
 
 void Heap::defer_gc()
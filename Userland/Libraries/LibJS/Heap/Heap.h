@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
@@ -69,6 +70,11 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // Marks live cells on the threads of Threading::WorkStealingThreadPool::the() as well. Only enable this if every
+    // visit_edges() in the program is safe to call from other threads, i.e. it only reads and visits.
+    bool is_parallel_marking_enabled() const { return m_parallel_marking_enabled; }
+    void set_parallel_marking_enabled(bool enabled) { m_parallel_marking_enabled = enabled; }
+
     void did_create_handle(Badge<HandleImpl>, HandleImpl&);
     void did_destroy_handle(Badge<HandleImpl>, HandleImpl&);
 
@@ -86,6 +92,8 @@ public:
 
     void register_cell_allocator(Badge<CellAllocator>, CellAllocator&);
 
+    void sweep_block(Badge<CellAllocator>, HeapBlock& block) { sweep_block(block); }
+
     void uproot_cell(Cell* cell);
 
 private:
@@ -117,8 +125,24 @@ private:
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
     void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_live_cells_in_parallel(HashMap<Cell*, HeapRoot> const& live_cells);
     void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+
+    struct CollectionStatistics {
+        size_t live_cells { 0 };
+        size_t live_cell_bytes { 0 };
+        size_t collected_cells { 0 };
+        size_t collected_cell_bytes { 0 };
+        size_t blocks_to_sweep { 0 };
+    };
+    CollectionStatistics prepare_unmarked_cells_for_sweeping();
+
+    void sweep_block(HeapBlock&);
+    void sweep_some_blocks(size_t max_blocks);
+    void sweep_all_blocks();
+
+    void record_pause_time(Duration);
+    void print_report(CollectionStatistics const&, Duration pause_time);
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -145,6 +169,7 @@ private:
     size_t m_allocated_bytes_since_last_gc { 0 };
 
     bool m_should_collect_on_every_allocation { false };
+    bool m_parallel_marking_enabled { false };
 
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
     CellAllocator::List m_all_cell_allocators;
@@ -156,6 +181,13 @@ private:
 
     Vector<GCPtr<Cell>> m_uprooted_cells;
 
+    // Garbage collection only finalizes dead cells, they are swept (destroyed) a few blocks at a time as we allocate.
+    static constexpr size_t blocks_to_sweep_per_allocation = 1;
+    Vector<CellAllocator*> m_cell_allocators_with_blocks_to_sweep;
+
+    // The number of collections whose pause took less than 1, 2, 4, ... milliseconds, the last one counts all the rest.
+    AK::Array<size_t, 12> m_pause_time_histogram {};
+
     size_t m_gc_deferrals { 0 };
     bool m_should_gc_when_deferral_ends { false };
 
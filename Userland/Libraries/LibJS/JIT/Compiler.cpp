@@ -0,0 +1,629 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/Debug.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Shape.h>
+#include <LibJS/Runtime/ValueInlines.h>
+
+namespace JS::JIT {
+
+#if JIT_ARCH_SUPPORTED
+
+using Assembler = ::JIT::Assembler;
+using Reg = Assembler::Reg;
+using Operand = Assembler::Operand;
+using Condition = Assembler::Condition;
+
+// The interpreter's state lives in callee-saved registers, so that it survives calls into the runtime.
+static constexpr Reg REGISTERS_AND_CONSTANTS_AND_LOCALS = Reg::RBX;
+static constexpr Reg INTERPRETER = Reg::R12;
+static constexpr Reg ARGUMENTS = Reg::R14;
+static constexpr Reg PROGRAM_COUNTER = Reg::R15;
+
+// What the helpers for conditional jumps return.
+enum class JumpCondition : u64 {
+    False = 0,
+    True = 1,
+    Threw = 2,
+};
+
+static Value& vm_value(Bytecode::Interpreter& interpreter, Bytecode::Operand operand)
+{
+    return interpreter.reg(Bytecode::Register(operand.index()));
+}
+
+static u64 store_exception(Bytecode::Interpreter& interpreter, Value exception)
+{
+    interpreter.reg(Bytecode::Register::exception()) = exception;
+    return to_underlying(NativeExecutable::ExitReason::Exception);
+}
+
+template<typename OpType>
+static u64 cxx_execute(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    if constexpr (IsSame<decltype(instruction.execute_impl(interpreter)), void>) {
+        instruction.execute_impl(interpreter);
+    } else {
+        auto result = instruction.execute_impl(interpreter);
+        if (result.is_error())
+            return store_exception(interpreter, result.error_value());
+    }
+    return 0;
+}
+
+static u64 cxx_to_boolean(u64 encoded_value)
+{
+    return bit_cast<Value>(encoded_value).to_boolean();
+}
+
+static u64 cxx_get_by_id(Bytecode::Interpreter& interpreter, Bytecode::Op::GetById const& instruction)
+{
+    // OPTIMIZATION: Own properties that hit one of the lookup cache's entries don't need anything from get_by_id() but the cached offset.
+    auto base_value = vm_value(interpreter, instruction.base());
+    if (base_value.is_object()) {
+        auto& object = base_value.as_object();
+        auto& cache = interpreter.current_executable().property_lookup_caches[instruction.cache_index()];
+        for (auto& entry : cache.entries) {
+            if (entry.prototype || &object.shape() != entry.shape)
+                continue;
+            auto value = object.get_direct(entry.property_offset.value());
+            if (value.is_accessor())
+                break;
+            if constexpr (JS_PROPERTY_LOOKUP_CACHE_DEBUG)
+                ++cache.hit_count;
+            vm_value(interpreter, instruction.dst()) = value;
+            return 0;
+        }
+    }
+    return cxx_execute(interpreter, instruction);
+}
+
+static u64 cxx_enter_unwind_context(Bytecode::Interpreter& interpreter, Bytecode::Op::EnterUnwindContext const&)
+{
+    interpreter.enter_unwind_context();
+    return 0;
+}
+
+static ThrowCompletionOr<Value> loosely_equals(VM& vm, Value lhs, Value rhs)
+{
+    return Value(TRY(is_loosely_equal(vm, lhs, rhs)));
+}
+
+static ThrowCompletionOr<Value> loosely_inequals(VM& vm, Value lhs, Value rhs)
+{
+    return Value(!TRY(is_loosely_equal(vm, lhs, rhs)));
+}
+
+static ThrowCompletionOr<Value> strict_equals(VM&, Value lhs, Value rhs)
+{
+    return Value(is_strictly_equal(lhs, rhs));
+}
+
+static ThrowCompletionOr<Value> strict_inequals(VM&, Value lhs, Value rhs)
+{
+    return Value(!is_strictly_equal(lhs, rhs));
+}
+
+template<typename OpType, ThrowCompletionOr<Value> (*compare)(VM&, Value, Value)>
+static u64 cxx_comparison_jump(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    auto result = compare(interpreter.vm(), vm_value(interpreter, instruction.lhs()), vm_value(interpreter, instruction.rhs()));
+    if (result.is_error()) {
+        store_exception(interpreter, result.error_value());
+        return to_underlying(JumpCondition::Threw);
+    }
+    return to_underlying(result.value().to_boolean() ? JumpCondition::True : JumpCondition::False);
+}
+
+// The condition for comparing two sign-extended int32 values.
+static constexpr Condition int32_condition(Bytecode::Instruction::Type type)
+{
+    switch (type) {
+    case Bytecode::Instruction::Type::LessThan:
+    case Bytecode::Instruction::Type::JumpLessThan:
+        return Condition::SignedLessThan;
+    case Bytecode::Instruction::Type::LessThanEquals:
+    case Bytecode::Instruction::Type::JumpLessThanEquals:
+        return Condition::SignedLessThanOrEqualTo;
+    case Bytecode::Instruction::Type::GreaterThan:
+    case Bytecode::Instruction::Type::JumpGreaterThan:
+        return Condition::SignedGreaterThan;
+    case Bytecode::Instruction::Type::GreaterThanEquals:
+    case Bytecode::Instruction::Type::JumpGreaterThanEquals:
+        return Condition::SignedGreaterThanOrEqualTo;
+    case Bytecode::Instruction::Type::JumpLooselyEquals:
+    case Bytecode::Instruction::Type::JumpStrictlyEquals:
+        return Condition::EqualTo;
+    case Bytecode::Instruction::Type::JumpLooselyInequals:
+    case Bytecode::Instruction::Type::JumpStrictlyInequals:
+        return Condition::NotEqualTo;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void Compiler::load_vm_value(Reg dst, Bytecode::Operand operand)
+{
+    m_assembler.mov(
+        Operand::Register(dst),
+        Operand::Mem64BaseAndOffset(REGISTERS_AND_CONSTANTS_AND_LOCALS, operand.index() * sizeof(Value)));
+}
+
+void Compiler::store_vm_value(Bytecode::Operand operand, Reg src)
+{
+    m_assembler.mov(
+        Operand::Mem64BaseAndOffset(REGISTERS_AND_CONSTANTS_AND_LOCALS, operand.index() * sizeof(Value)),
+        Operand::Register(src));
+}
+
+void Compiler::store_program_counter()
+{
+    m_assembler.mov(Operand::Register(Reg::RAX), Operand::Imm(m_current_offset));
+    m_assembler.mov(Operand::Mem64BaseAndOffset(PROGRAM_COUNTER, 0), Operand::Register(Reg::RAX));
+}
+
+// Clobbers RDX.
+void Compiler::branch_if_not_int32(Reg reg, Assembler::Label& label)
+{
+    VERIFY(reg != Reg::RDX);
+    m_assembler.mov(Operand::Register(Reg::RDX), Operand::Register(reg));
+    m_assembler.shift_right(Operand::Register(Reg::RDX), Operand::Imm(TAG_SHIFT));
+    m_assembler.jump_if(Operand::Register(Reg::RDX), Condition::NotEqualTo, Operand::Imm(INT32_TAG), label);
+}
+
+// Turns the (zero-extended) result of a 32-bit operation into a Value. Clobbers RDX.
+void Compiler::box_int32(Reg reg)
+{
+    VERIFY(reg != Reg::RDX);
+    m_assembler.mov(Operand::Register(Reg::RDX), Operand::Imm(SHIFTED_INT32_TAG));
+    m_assembler.bitwise_or(Operand::Register(reg), Operand::Register(Reg::RDX));
+}
+
+// Turns the condition flags into a boolean Value. Clobbers RDX.
+void Compiler::box_boolean_from_condition(Reg reg, Condition condition)
+{
+    VERIFY(reg != Reg::RDX);
+    m_assembler.set_if(condition, Operand::Register(reg));
+    m_assembler.bitwise_and(Operand::Register(reg), Operand::Imm(1));
+    m_assembler.mov(Operand::Register(Reg::RDX), Operand::Imm(SHIFTED_BOOLEAN_TAG));
+    m_assembler.bitwise_or(Operand::Register(reg), Operand::Register(Reg::RDX));
+}
+
+// Clobbers every caller-saved register.
+void Compiler::branch_on_truthiness(Reg reg, Assembler::Label& if_true, Assembler::Label& if_false)
+{
+    VERIFY(reg != Reg::RCX);
+    Assembler::Label not_boolean {};
+    Assembler::Label slow_case {};
+
+    m_assembler.mov(Operand::Register(Reg::RCX), Operand::Register(reg));
+    m_assembler.shift_right(Operand::Register(Reg::RCX), Operand::Imm(TAG_SHIFT));
+
+    m_assembler.jump_if(Operand::Register(Reg::RCX), Condition::NotEqualTo, Operand::Imm(BOOLEAN_TAG), not_boolean);
+    m_assembler.test(Operand::Register(reg), Operand::Imm(1));
+    m_assembler.jump_if(Condition::NotEqualTo, if_true);
+    m_assembler.jump(if_false);
+
+    not_boolean.link(m_assembler);
+    m_assembler.jump_if(Operand::Register(Reg::RCX), Condition::NotEqualTo, Operand::Imm(INT32_TAG), slow_case);
+    m_assembler.mov32(Operand::Register(Reg::RCX), Operand::Register(reg));
+    m_assembler.jump_if(Operand::Register(Reg::RCX), Condition::NotEqualTo, Operand::Imm(0), if_true);
+    m_assembler.jump(if_false);
+
+    slow_case.link(m_assembler);
+    m_assembler.mov(Operand::Register(Reg::RDI), Operand::Register(reg));
+    m_assembler.native_call(reinterpret_cast<FlatPtr>(&cxx_to_boolean));
+    m_assembler.jump_if(Operand::Register(Reg::RAX), Condition::NotEqualTo, Operand::Imm(0), if_true);
+    m_assembler.jump(if_false);
+}
+
+template<typename OpType>
+void Compiler::call_helper(u64 (*helper)(Bytecode::Interpreter&, OpType const&), OpType const& instruction)
+{
+    // The runtime needs to know where we are, for exceptions and for the source locations in stack traces.
+    store_program_counter();
+    m_assembler.mov(Operand::Register(Reg::RDI), Operand::Register(INTERPRETER));
+    m_assembler.mov(Operand::Register(Reg::RSI), Operand::Imm(reinterpret_cast<FlatPtr>(&instruction)));
+    m_assembler.native_call(reinterpret_cast<FlatPtr>(helper));
+}
+
+template<typename OpType>
+void Compiler::call_helper_and_check_exception(u64 (*helper)(Bytecode::Interpreter&, OpType const&), OpType const& instruction)
+{
+    call_helper(helper, instruction);
+    m_assembler.jump_if(Operand::Register(Reg::RAX), Condition::NotEqualTo, Operand::Imm(0), m_exception_exit);
+}
+
+void Compiler::exit(NativeExecutable::ExitReason reason)
+{
+    m_assembler.mov(Operand::Register(Reg::RAX), Operand::Imm(to_underlying(reason)));
+    m_assembler.jump(m_exit);
+}
+
+Assembler::Label& Compiler::label_for(Bytecode::Label label)
+{
+    auto it = m_instruction_labels.find(label.address());
+    VERIFY(it != m_instruction_labels.end());
+    return it->value;
+}
+
+template<typename OpType>
+void Compiler::compile_op(OpType const& instruction)
+{
+    call_helper_and_check_exception(&cxx_execute<OpType>, instruction);
+}
+
+void Compiler::compile_op(Bytecode::Op::Mov const& instruction)
+{
+    load_vm_value(Reg::RAX, instruction.src());
+    store_vm_value(instruction.dst(), Reg::RAX);
+}
+
+void Compiler::compile_op(Bytecode::Op::GetArgument const& instruction)
+{
+    m_assembler.mov(Operand::Register(Reg::RAX), Operand::Mem64BaseAndOffset(ARGUMENTS, instruction.index() * sizeof(Value)));
+    store_vm_value(instruction.dst(), Reg::RAX);
+}
+
+void Compiler::compile_op(Bytecode::Op::SetArgument const& instruction)
+{
+    load_vm_value(Reg::RAX, instruction.src());
+    m_assembler.mov(Operand::Mem64BaseAndOffset(ARGUMENTS, instruction.index() * sizeof(Value)), Operand::Register(Reg::RAX));
+}
+
+void Compiler::compile_op(Bytecode::Op::End const& instruction)
+{
+    load_vm_value(Reg::RAX, instruction.value());
+    store_vm_value(Bytecode::Operand(Bytecode::Register::accumulator()), Reg::RAX);
+    exit(NativeExecutable::ExitReason::Finished);
+}
+
+void Compiler::compile_op(Bytecode::Op::Jump const& instruction)
+{
+    m_assembler.jump(label_for(instruction.target()));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpIf const& instruction)
+{
+    load_vm_value(Reg::RAX, instruction.condition());
+    branch_on_truthiness(Reg::RAX, label_for(instruction.true_target()), label_for(instruction.false_target()));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpTrue const& instruction)
+{
+    Assembler::Label next {};
+    load_vm_value(Reg::RAX, instruction.condition());
+    branch_on_truthiness(Reg::RAX, label_for(instruction.target()), next);
+    next.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpFalse const& instruction)
+{
+    Assembler::Label next {};
+    load_vm_value(Reg::RAX, instruction.condition());
+    branch_on_truthiness(Reg::RAX, next, label_for(instruction.target()));
+    next.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpNullish const& instruction)
+{
+    load_vm_value(Reg::RAX, instruction.condition());
+    m_assembler.shift_right(Operand::Register(Reg::RAX), Operand::Imm(TAG_SHIFT));
+    m_assembler.bitwise_and(Operand::Register(Reg::RAX), Operand::Imm(IS_NULLISH_EXTRACT_PATTERN));
+    m_assembler.jump_if(Operand::Register(Reg::RAX), Condition::EqualTo, Operand::Imm(IS_NULLISH_PATTERN), label_for(instruction.true_target()));
+    m_assembler.jump(label_for(instruction.false_target()));
+}
+
+void Compiler::compile_op(Bytecode::Op::JumpUndefined const& instruction)
+{
+    load_vm_value(Reg::RAX, instruction.condition());
+    m_assembler.mov(Operand::Register(Reg::RCX), Operand::Imm(js_undefined().encoded()));
+    m_assembler.jump_if(Operand::Register(Reg::RAX), Condition::EqualTo, Operand::Register(Reg::RCX), label_for(instruction.true_target()));
+    m_assembler.jump(label_for(instruction.false_target()));
+}
+
+void Compiler::compile_op(Bytecode::Op::EnterUnwindContext const& instruction)
+{
+    call_helper(&cxx_enter_unwind_context, instruction);
+    m_assembler.jump(label_for(instruction.entry_point()));
+}
+
+// Unwinding through finally blocks depends on the interpreter's scheduled jumps, so the interpreter takes over.
+void Compiler::compile_op(Bytecode::Op::ContinuePendingUnwind const&)
+{
+    store_program_counter();
+    exit(NativeExecutable::ExitReason::Bailout);
+}
+
+void Compiler::compile_op(Bytecode::Op::ScheduleJump const&)
+{
+    store_program_counter();
+    exit(NativeExecutable::ExitReason::Bailout);
+}
+
+void Compiler::compile_op(Bytecode::Op::Await const& instruction)
+{
+    call_helper(&cxx_execute<Bytecode::Op::Await>, instruction);
+    exit(NativeExecutable::ExitReason::Finished);
+}
+
+void Compiler::compile_op(Bytecode::Op::Return const& instruction)
+{
+    call_helper(&cxx_execute<Bytecode::Op::Return>, instruction);
+    exit(NativeExecutable::ExitReason::Finished);
+}
+
+void Compiler::compile_op(Bytecode::Op::Yield const& instruction)
+{
+    call_helper(&cxx_execute<Bytecode::Op::Yield>, instruction);
+    exit(NativeExecutable::ExitReason::Finished);
+}
+
+void Compiler::compile_op(Bytecode::Op::GetById const& instruction)
+{
+    call_helper_and_check_exception(&cxx_get_by_id, instruction);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_operation(OpType const& instruction, Int32Operation operation)
+{
+    Assembler::Label slow_case {};
+    Assembler::Label done {};
+
+    load_vm_value(Reg::RAX, instruction.lhs());
+    load_vm_value(Reg::RCX, instruction.rhs());
+    branch_if_not_int32(Reg::RAX, slow_case);
+    branch_if_not_int32(Reg::RCX, slow_case);
+
+    auto lhs = Operand::Register(Reg::RAX);
+    auto rhs = Operand::Register(Reg::RCX);
+    switch (operation) {
+    case Int32Operation::Add:
+        m_assembler.add32(lhs, rhs, slow_case);
+        box_int32(Reg::RAX);
+        break;
+    case Int32Operation::Sub:
+        m_assembler.sub32(lhs, rhs, slow_case);
+        box_int32(Reg::RAX);
+        break;
+    case Int32Operation::Mul:
+        m_assembler.mul32(lhs, rhs, slow_case);
+        box_int32(Reg::RAX);
+        break;
+    case Int32Operation::BitwiseAnd:
+        // Both values have the same tag, which survives the 64-bit operation.
+        m_assembler.bitwise_and(lhs, rhs);
+        break;
+    case Int32Operation::BitwiseOr:
+        m_assembler.bitwise_or(lhs, rhs);
+        break;
+    case Int32Operation::BitwiseXor:
+        m_assembler.bitwise_xor32(lhs, rhs);
+        box_int32(Reg::RAX);
+        break;
+    }
+    store_vm_value(instruction.dst(), Reg::RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    call_helper_and_check_exception(&cxx_execute<OpType>, instruction);
+
+    done.link(m_assembler);
+}
+
+template<typename OpType>
+void Compiler::compile_int32_comparison(OpType const& instruction, Condition condition)
+{
+    Assembler::Label slow_case {};
+    Assembler::Label done {};
+
+    load_vm_value(Reg::RAX, instruction.lhs());
+    load_vm_value(Reg::RCX, instruction.rhs());
+    branch_if_not_int32(Reg::RAX, slow_case);
+    branch_if_not_int32(Reg::RCX, slow_case);
+
+    m_assembler.sign_extend_32_to_64_bits(Reg::RAX);
+    m_assembler.sign_extend_32_to_64_bits(Reg::RCX);
+    m_assembler.cmp(Operand::Register(Reg::RAX), Operand::Register(Reg::RCX));
+    box_boolean_from_condition(Reg::RAX, condition);
+    store_vm_value(instruction.dst(), Reg::RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    call_helper_and_check_exception(&cxx_execute<OpType>, instruction);
+
+    done.link(m_assembler);
+}
+
+template<typename OpType>
+void Compiler::compile_comparison_jump(OpType const& instruction, Condition condition, u64 (*slow_path)(Bytecode::Interpreter&, OpType const&))
+{
+    auto& true_target = label_for(instruction.true_target());
+    auto& false_target = label_for(instruction.false_target());
+    Assembler::Label slow_case {};
+
+    load_vm_value(Reg::RAX, instruction.lhs());
+    load_vm_value(Reg::RCX, instruction.rhs());
+    branch_if_not_int32(Reg::RAX, slow_case);
+    branch_if_not_int32(Reg::RCX, slow_case);
+
+    m_assembler.sign_extend_32_to_64_bits(Reg::RAX);
+    m_assembler.sign_extend_32_to_64_bits(Reg::RCX);
+    m_assembler.jump_if(Operand::Register(Reg::RAX), condition, Operand::Register(Reg::RCX), true_target);
+    m_assembler.jump(false_target);
+
+    slow_case.link(m_assembler);
+    call_helper(slow_path, instruction);
+    m_assembler.jump_if(Operand::Register(Reg::RAX), Condition::EqualTo, Operand::Imm(to_underlying(JumpCondition::Threw)), m_exception_exit);
+    m_assembler.jump_if(Operand::Register(Reg::RAX), Condition::NotEqualTo, Operand::Imm(to_underlying(JumpCondition::False)), true_target);
+    m_assembler.jump(false_target);
+}
+
+void Compiler::compile_op(Bytecode::Op::Add const& instruction)
+{
+    compile_int32_operation(instruction, Int32Operation::Add);
+}
+
+void Compiler::compile_op(Bytecode::Op::Sub const& instruction)
+{
+    compile_int32_operation(instruction, Int32Operation::Sub);
+}
+
+void Compiler::compile_op(Bytecode::Op::Mul const& instruction)
+{
+    compile_int32_operation(instruction, Int32Operation::Mul);
+}
+
+void Compiler::compile_op(Bytecode::Op::BitwiseAnd const& instruction)
+{
+    compile_int32_operation(instruction, Int32Operation::BitwiseAnd);
+}
+
+void Compiler::compile_op(Bytecode::Op::BitwiseOr const& instruction)
+{
+    compile_int32_operation(instruction, Int32Operation::BitwiseOr);
+}
+
+void Compiler::compile_op(Bytecode::Op::BitwiseXor const& instruction)
+{
+    compile_int32_operation(instruction, Int32Operation::BitwiseXor);
+}
+
+void Compiler::compile_op(Bytecode::Op::LessThan const& instruction)
+{
+    compile_int32_comparison(instruction, int32_condition(instruction.type()));
+}
+
+void Compiler::compile_op(Bytecode::Op::LessThanEquals const& instruction)
+{
+    compile_int32_comparison(instruction, int32_condition(instruction.type()));
+}
+
+void Compiler::compile_op(Bytecode::Op::GreaterThan const& instruction)
+{
+    compile_int32_comparison(instruction, int32_condition(instruction.type()));
+}
+
+void Compiler::compile_op(Bytecode::Op::GreaterThanEquals const& instruction)
+{
+    compile_int32_comparison(instruction, int32_condition(instruction.type()));
+}
+
+void Compiler::compile_op(Bytecode::Op::Increment const& instruction)
+{
+    Assembler::Label slow_case {};
+    Assembler::Label done {};
+
+    load_vm_value(Reg::RAX, instruction.dst());
+    branch_if_not_int32(Reg::RAX, slow_case);
+    m_assembler.inc32(Operand::Register(Reg::RAX), slow_case);
+    box_int32(Reg::RAX);
+    store_vm_value(instruction.dst(), Reg::RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    call_helper_and_check_exception(&cxx_execute<Bytecode::Op::Increment>, instruction);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_op(Bytecode::Op::Decrement const& instruction)
+{
+    Assembler::Label slow_case {};
+    Assembler::Label done {};
+
+    load_vm_value(Reg::RAX, instruction.dst());
+    branch_if_not_int32(Reg::RAX, slow_case);
+    m_assembler.dec32(Operand::Register(Reg::RAX), slow_case);
+    box_int32(Reg::RAX);
+    store_vm_value(instruction.dst(), Reg::RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    call_helper_and_check_exception(&cxx_execute<Bytecode::Op::Decrement>, instruction);
+
+    done.link(m_assembler);
+}
+
+#    define DEFINE_COMPILE_COMPARISON_JUMP(op_TitleCase, op_snake_case, numeric_operator)           \
+        void Compiler::compile_op(Bytecode::Op::Jump##op_TitleCase const& instruction)              \
+        {                                                                                           \
+            auto slow_path = &cxx_comparison_jump<Bytecode::Op::Jump##op_TitleCase, op_snake_case>; \
+            compile_comparison_jump(instruction, int32_condition(instruction.type()), slow_path);   \
+        }
+JS_ENUMERATE_COMPARISON_OPS(DEFINE_COMPILE_COMPARISON_JUMP)
+#    undef DEFINE_COMPILE_COMPARISON_JUMP
+
+void Compiler::compile_instruction(Bytecode::Instruction const& instruction)
+{
+    switch (instruction.type()) {
+#    define CASE_BYTECODE_OP(OpTitleCase)                                       \
+    case Bytecode::Instruction::Type::OpTitleCase:                              \
+        compile_op(static_cast<Bytecode::Op::OpTitleCase const&>(instruction)); \
+        break;
+        ENUMERATE_BYTECODE_OPS(CASE_BYTECODE_OP)
+#    undef CASE_BYTECODE_OP
+    }
+}
+
+OwnPtr<NativeExecutable> Compiler::compile_executable()
+{
+    // The prologue pins the interpreter's state to callee-saved registers and jumps to the entry point,
+    // see NativeExecutable::run() for the arguments.
+    m_assembler.enter();
+    m_assembler.mov(Operand::Register(REGISTERS_AND_CONSTANTS_AND_LOCALS), Operand::Register(Reg::RDI));
+    m_assembler.mov(Operand::Register(INTERPRETER), Operand::Register(Reg::RSI));
+    m_assembler.mov(Operand::Register(PROGRAM_COUNTER), Operand::Register(Reg::RDX));
+    m_assembler.mov(Operand::Register(ARGUMENTS), Operand::Register(Reg::RCX));
+    m_assembler.jump(Operand::Register(Reg::R8));
+
+    // Any instruction can be jumped to, by other instructions as well as by the interpreter.
+    for (Bytecode::InstructionStreamIterator it(m_executable.bytecode); !it.at_end(); ++it)
+        m_instruction_labels.set(it.offset(), Assembler::Label {});
+
+    HashMap<size_t, size_t> entry_points;
+    for (Bytecode::InstructionStreamIterator it(m_executable.bytecode); !it.at_end(); ++it) {
+        m_current_offset = it.offset();
+        entry_points.set(m_current_offset, m_output.size());
+        m_instruction_labels.find(m_current_offset)->value.link(m_assembler);
+        compile_instruction(*it);
+    }
+
+    // Every basic block ends in a terminator, so execution never falls off the end.
+    m_assembler.verify_not_reached();
+
+    m_exception_exit.link(m_assembler);
+    m_assembler.mov(Operand::Register(Reg::RAX), Operand::Imm(to_underlying(NativeExecutable::ExitReason::Exception)));
+    m_exit.link(m_assembler);
+    m_assembler.exit();
+
+    auto native_executable_or_error = NativeExecutable::create(m_output, move(entry_points));
+    if (native_executable_or_error.is_error()) {
+        dbgln("LibJS: Failed to create native code for '{}': {}", m_executable.name, native_executable_or_error.error());
+        return nullptr;
+    }
+    return native_executable_or_error.release_value();
+}
+
+#endif
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable& executable)
+{
+#if JIT_ARCH_SUPPORTED
+    Compiler compiler(executable);
+    return compiler.compile_executable();
+#else
+    (void)executable;
+    return nullptr;
+#endif
+}
+
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJIT/Assembler.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+namespace JS::JIT {
+
+// A baseline compiler, which translates every instruction of an executable on its own.
+//
+// Int32 arithmetic, comparisons, jumps and own-property hits in the PropertyLookupCache are handled in native code
+// (or a small helper), and everything else calls the instruction's execute_impl() just like the interpreter does.
+// The interpreter's registers, constants and locals stay in memory, so the interpreter can take over at any
+// instruction, which it does for the few instructions that the compiler doesn't handle.
+class Compiler {
+public:
+    // Executables are compiled once they have been entered or looped this many times.
+    static constexpr u32 hotness_threshold = 100;
+
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+#if JIT_ARCH_SUPPORTED
+private:
+    using Assembler = ::JIT::Assembler;
+
+    explicit Compiler(Bytecode::Executable& executable)
+        : m_executable(executable)
+        , m_assembler(m_output)
+    {
+    }
+
+    OwnPtr<NativeExecutable> compile_executable();
+
+    void compile_instruction(Bytecode::Instruction const&);
+
+    template<typename OpType>
+    void compile_op(OpType const&);
+
+    void compile_op(Bytecode::Op::Mov const&);
+    void compile_op(Bytecode::Op::GetArgument const&);
+    void compile_op(Bytecode::Op::SetArgument const&);
+    void compile_op(Bytecode::Op::End const&);
+    void compile_op(Bytecode::Op::Jump const&);
+    void compile_op(Bytecode::Op::JumpIf const&);
+    void compile_op(Bytecode::Op::JumpTrue const&);
+    void compile_op(Bytecode::Op::JumpFalse const&);
+    void compile_op(Bytecode::Op::JumpNullish const&);
+    void compile_op(Bytecode::Op::JumpUndefined const&);
+    void compile_op(Bytecode::Op::EnterUnwindContext const&);
+    void compile_op(Bytecode::Op::ContinuePendingUnwind const&);
+    void compile_op(Bytecode::Op::ScheduleJump const&);
+    void compile_op(Bytecode::Op::Await const&);
+    void compile_op(Bytecode::Op::Return const&);
+    void compile_op(Bytecode::Op::Yield const&);
+    void compile_op(Bytecode::Op::GetById const&);
+    void compile_op(Bytecode::Op::Add const&);
+    void compile_op(Bytecode::Op::Sub const&);
+    void compile_op(Bytecode::Op::Mul const&);
+    void compile_op(Bytecode::Op::BitwiseAnd const&);
+    void compile_op(Bytecode::Op::BitwiseOr const&);
+    void compile_op(Bytecode::Op::BitwiseXor const&);
+    void compile_op(Bytecode::Op::LessThan const&);
+    void compile_op(Bytecode::Op::LessThanEquals const&);
+    void compile_op(Bytecode::Op::GreaterThan const&);
+    void compile_op(Bytecode::Op::GreaterThanEquals const&);
+    void compile_op(Bytecode::Op::Increment const&);
+    void compile_op(Bytecode::Op::Decrement const&);
+
+#    define DECLARE_COMPILE_COMPARISON_JUMP(op_TitleCase, op_snake_case, numeric_operator) \
+        void compile_op(Bytecode::Op::Jump##op_TitleCase const&);
+    JS_ENUMERATE_COMPARISON_OPS(DECLARE_COMPILE_COMPARISON_JUMP)
+#    undef DECLARE_COMPILE_COMPARISON_JUMP
+
+    enum class Int32Operation {
+        Add,
+        Sub,
+        Mul,
+        BitwiseAnd,
+        BitwiseOr,
+        BitwiseXor,
+    };
+    template<typename OpType>
+    void compile_int32_operation(OpType const&, Int32Operation);
+    template<typename OpType>
+    void compile_int32_comparison(OpType const&, Assembler::Condition);
+    template<typename OpType>
+    void compile_comparison_jump(OpType const&, Assembler::Condition, u64 (*slow_path)(Bytecode::Interpreter&, OpType const&));
+
+    void load_vm_value(Assembler::Reg, Bytecode::Operand);
+    void store_vm_value(Bytecode::Operand, Assembler::Reg);
+    void store_program_counter();
+    void branch_if_not_int32(Assembler::Reg, Assembler::Label&);
+    void box_int32(Assembler::Reg);
+    void box_boolean_from_condition(Assembler::Reg, Assembler::Condition);
+    void branch_on_truthiness(Assembler::Reg, Assembler::Label& if_true, Assembler::Label& if_false);
+    template<typename OpType>
+    void call_helper(u64 (*helper)(Bytecode::Interpreter&, OpType const&), OpType const&);
+    template<typename OpType>
+    void call_helper_and_check_exception(u64 (*helper)(Bytecode::Interpreter&, OpType const&), OpType const&);
+    void exit(NativeExecutable::ExitReason);
+
+    Assembler::Label& label_for(Bytecode::Label);
+
+    Bytecode::Executable& m_executable;
+    Vector<u8> m_output;
+    Assembler m_assembler;
+
+    HashMap<size_t, Assembler::Label> m_instruction_labels;
+    Assembler::Label m_exit;
+    Assembler::Label m_exception_exit;
+    size_t m_current_offset { 0 };
+#endif
+};
+
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <LibJS/Runtime/Value.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+ErrorOr<NonnullOwnPtr<NativeExecutable>> NativeExecutable::create(ReadonlyBytes code, HashMap<size_t, size_t> entry_points)
+{
+    auto* memory = TRY(Core::System::mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0, 0, "JS JIT code"sv));
+    memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        auto error = AK::Error::from_syscall("mprotect"sv, -errno);
+        MUST(Core::System::munmap(memory, code.size()));
+        return error;
+    }
+    return adopt_nonnull_own_or_enomem(new (nothrow) NativeExecutable(memory, code.size(), move(entry_points)));
+}
+
+NativeExecutable::NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> entry_points)
+    : m_code(code)
+    , m_size(size)
+    , m_entry_points(move(entry_points))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    MUST(Core::System::munmap(m_code, m_size));
+}
+
+NativeExecutable::ExitReason NativeExecutable::run(Bytecode::Interpreter& interpreter, size_t& program_counter, Span<Value> registers_and_constants_and_locals, Span<Value> arguments) const
+{
+    // See Compiler::compile() for the prologue that sets up the pinned registers and jumps to the entry point.
+    using EntryFunction = u64 (*)(Value* registers_and_constants_and_locals, Bytecode::Interpreter*, size_t* program_counter, Value* arguments, void* entry_point);
+
+    auto entry_point = m_entry_points.get(program_counter);
+    VERIFY(entry_point.has_value());
+
+    auto function = reinterpret_cast<EntryFunction>(m_code);
+    auto result = function(registers_and_constants_and_locals.data(), &interpreter, &program_counter, arguments.data(), static_cast<u8*>(m_code) + *entry_point);
+    return static_cast<ExitReason>(result);
+}
+
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Span.h>
+#include <LibJS/Forward.h>
+
+namespace JS::JIT {
+
+// Machine code for a Bytecode::Executable, which can be entered at the start of any of its instructions.
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    enum class ExitReason : u64 {
+        // The executable has finished, like it does at End, Return and Yield.
+        Finished = 0,
+        // The instruction at the program counter has thrown the exception in the exception register.
+        Exception = 1,
+        // The instruction at the program counter has to be executed by the interpreter.
+        Bailout = 2,
+    };
+
+    // Copies the code into executable memory. The entry points map bytecode offsets to offsets in the code.
+    static ErrorOr<NonnullOwnPtr<NativeExecutable>> create(ReadonlyBytes code, HashMap<size_t, size_t> entry_points);
+    ~NativeExecutable();
+
+    bool has_entry_point(size_t bytecode_offset) const { return m_entry_points.contains(bytecode_offset); }
+
+    // Runs the code from the instruction at the program counter, which is updated before every call into the runtime
+    // and when the code exits.
+    ExitReason run(Bytecode::Interpreter&, size_t& program_counter, Span<Value> registers_and_constants_and_locals, Span<Value> arguments) const;
+
+private:
+    NativeExecutable(void* code, size_t size, HashMap<size_t, size_t> entry_points);
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    HashMap<size_t, size_t> m_entry_points;
+};
+
+}
@@ -223,7 +223,13 @@ static consteval Array<TokenType, 256> make_single_char_tokens_array()
 static constexpr auto s_single_char_tokens = make_single_char_tokens_array();
 
 Lexer::Lexer(StringView source, StringView filename, size_t line_number, size_t line_column)
-    : m_source(source)
+    : Lexer(ByteString { source }, filename, 0, line_number, line_column)
+{
+}
+
+Lexer::Lexer(ByteString source, StringView filename, size_t offset, size_t line_number, size_t line_column)
+    : m_source(move(source))
+    , m_position(offset)
     , m_current_token(TokenType::Eof, {}, {}, {}, 0, 0, 0)
     , m_filename(String::from_utf8(filename).release_value_but_fixme_should_propagate_errors())
     , m_line_number(line_number)
@@ -18,6 +18,8 @@ namespace JS {
 class Lexer {
 public:
     explicit Lexer(StringView source, StringView filename = "(unknown)"sv, size_t line_number = 1, size_t line_column = 0);
+    // Lexes the source from the given offset onwards, which has to be the start of a token outside of any template literal.
+    Lexer(ByteString source, StringView filename, size_t offset, size_t line_number, size_t line_column);
 
     Token next();
 
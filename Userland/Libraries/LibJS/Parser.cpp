@@ -21,6 +21,8 @@
 
 namespace JS {
 
+bool g_lazy_function_parsing = false;
+
 class ScopePusher {
 
     // NOTE: We really only need ModuleTopLevel and NotModuleTopLevel as the only
@@ -342,6 +344,9 @@ public:
 
             if (m_type == ScopeType::Program) {
                 auto can_use_global_for_identifier = !(identifier_group.used_inside_with_statement || identifier_group.might_be_variable_in_lexical_scope_in_named_function_assignment || identifier_group.used_inside_scope_with_eval || m_parser.m_state.initiated_by_eval);
+                // NOTE: When parsing a function whose body was dropped, the scopes that were around it are gone, so we can only trust what we found out when parsing it for the first time.
+                if (auto const* global_identifier_names = m_parser.m_global_identifier_names_of_function_with_dropped_body; global_identifier_names && !global_identifier_names->contains(identifier_group_name))
+                    can_use_global_for_identifier = false;
                 if (can_use_global_for_identifier) {
                     for (auto& identifier : identifier_group.identifiers)
                         identifier->set_is_global();
@@ -477,6 +482,14 @@ public:
         m_is_arrow_function = true;
     }
 
+    Vector<NonnullRefPtr<Identifier>> identifiers() const
+    {
+        Vector<NonnullRefPtr<Identifier>> identifiers;
+        for (auto const& it : m_identifier_groups)
+            identifiers.extend(it.value.identifiers);
+        return identifiers;
+    }
+
 private:
     void throw_identifier_declared(DeprecatedFlyString const& name, NonnullRefPtr<Declaration const> const& declaration)
     {
@@ -675,6 +688,13 @@ Parser::Parser(Lexer lexer, Program::Type program_type, Optional<EvalInitialStat
     }
 }
 
+Parser::Parser(Lexer lexer, Program::Type program_type, NonnullRefPtr<SourceCode const> source_code)
+    : m_source_code(move(source_code))
+    , m_state(move(lexer), program_type)
+    , m_program_type(program_type)
+{
+}
+
 Associativity Parser::operator_associativity(TokenType type) const
 {
     switch (type) {
@@ -749,14 +769,19 @@ NonnullRefPtr<Program> Parser::parse_program(bool starts_in_strict_mode)
 {
     auto rule_start = push_start();
     auto program = adopt_ref(*new Program({ m_source_code, rule_start.position(), position() }, m_program_type));
-    ScopePusher program_scope = ScopePusher::program_scope(*this, *program);
+    {
+        ScopePusher program_scope = ScopePusher::program_scope(*this, *program);
 
-    if (m_program_type == Program::Type::Script)
-        parse_script(program, starts_in_strict_mode);
-    else
-        parse_module(program);
+        if (m_program_type == Program::Type::Script)
+            parse_script(program, starts_in_strict_mode);
+        else
+            parse_module(program);
+    }
 
     program->set_end_offset({}, position().offset);
+
+    // NOTE: This has to wait until the program scope is gone, as that's when we know which identifiers refer to global variables.
+    drop_bodies_of_lazily_parsed_functions();
     return program;
 }
 
@@ -2879,6 +2904,9 @@ NonnullRefPtr<BlockStatement const> Parser::parse_block_statement()
 template<typename FunctionNodeType>
 NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, Optional<Position> const& function_start)
 {
+    auto parse_start = position();
+    auto const initial_parse_options = parse_options;
+    auto const initial_strict_mode = m_state.strict_mode;
     auto rule_start = function_start.has_value()
         ? RulePosition { *this, *function_start }
         : push_start();
@@ -2947,6 +2975,7 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
     i32 function_length = -1;
     Vector<FunctionParameter> parameters;
     FunctionParsingInsights parsing_insights;
+    Optional<Vector<NonnullRefPtr<Identifier>>> identifiers_of_lazily_parsed_function;
     auto body = [&] {
         ScopePusher function_scope = ScopePusher::function_scope(*this, name);
 
@@ -2967,6 +2996,8 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
         consume(TokenType::CurlyOpen);
 
         auto body = parse_function_body(parameters, function_kind, parsing_insights);
+        if (can_parse_function_lazily(initial_parse_options, rule_start.position(), parameters, parsing_insights))
+            identifiers_of_lazily_parsed_function = function_scope.identifiers();
         return body;
     }();
 
@@ -2982,11 +3013,104 @@ NonnullRefPtr<FunctionNodeType> Parser::parse_function_node(u16 parse_options, O
     auto function_end_offset = position().offset - m_state.current_token.trivia().length();
     auto source_text = ByteString { m_state.lexer.source().substring_view(function_start_offset, function_end_offset - function_start_offset) };
     parsing_insights.might_need_arguments_object = m_state.function_might_need_arguments_object;
-    return create_ast_node<FunctionNodeType>(
+    auto function = create_ast_node<FunctionNodeType>(
         { m_source_code, rule_start.position(), position() },
         name, move(source_text), move(body), move(parameters), function_length,
         function_kind, has_strict_directive, parsing_insights,
         move(local_variables_names));
+
+    if (identifiers_of_lazily_parsed_function.has_value()) {
+        m_lazily_parsed_functions.append({
+            .node = function,
+            .function = function.ptr(),
+            .function_start = rule_start.position(),
+            .parse_start = parse_start,
+            .parse_options = initial_parse_options,
+            .strict_mode = initial_strict_mode,
+            .identifiers = identifiers_of_lazily_parsed_function.release_value(),
+        });
+    }
+
+    return function;
+}
+
+bool Parser::can_parse_function_lazily(u16 parse_options, Position const& function_start, Vector<FunctionParameter> const& parameters, FunctionParsingInsights const& parsing_insights) const
+{
+    if (!g_lazy_function_parsing)
+        return false;
+
+    // Only plain function declarations and expressions are parsed again, as everything else depends on what's around them.
+    if (!(parse_options & FunctionNodeParseOptions::CheckForFunctionAndName))
+        return false;
+    if (parse_options & (FunctionNodeParseOptions::AllowSuperPropertyLookup | FunctionNodeParseOptions::AllowSuperConstructorCall | FunctionNodeParseOptions::IsArrowFunction))
+        return false;
+
+    // Classes may declare private names that the function refers to, and the identifiers in catch parameters aren't optimized at all.
+    if (m_state.referenced_private_names || m_state.in_catch_parameter_context || m_state.initiated_by_eval)
+        return false;
+
+    // Default values of parameters are parsed in the context around the function, which is gone by the time it's parsed again.
+    if (!is_simple_parameter_list(parameters))
+        return false;
+
+    if (parsing_insights.contains_direct_call_to_eval)
+        return false;
+
+    return position().offset - function_start.offset >= minimum_length_of_lazily_parsed_function;
+}
+
+void Parser::drop_bodies_of_lazily_parsed_functions()
+{
+    auto lazily_parsed_functions = move(m_lazily_parsed_functions);
+    if (has_errors())
+        return;
+
+    for (auto& lazily_parsed_function : lazily_parsed_functions) {
+        HashTable<DeprecatedFlyString> global_identifier_names;
+        for (auto const& identifier : lazily_parsed_function.identifiers) {
+            if (identifier->is_global())
+                global_identifier_names.set(identifier->string());
+        }
+
+        lazily_parsed_function.function->drop_body_until_needed(make<LazyFunctionParseState>(LazyFunctionParseState {
+            .source_code = m_source_code,
+            .source = m_state.lexer.source(),
+            .function_start = lazily_parsed_function.function_start,
+            .parse_start = lazily_parsed_function.parse_start,
+            .parse_options = lazily_parsed_function.parse_options,
+            .program_type = m_program_type,
+            .strict_mode = lazily_parsed_function.strict_mode,
+            .global_identifier_names = move(global_identifier_names),
+        }));
+    }
+}
+
+NonnullRefPtr<FunctionExpression const> Parser::parse_function_with_dropped_body(LazyFunctionParseState const& state)
+{
+    // NOTE: The lexer shares the source with the one that parsed the function the first time, and starts where it did, so that
+    //       all source ranges come out the same.
+    Lexer lexer { state.source, state.source_code->filename(), state.parse_start.offset, state.parse_start.line, state.parse_start.column - 1 };
+    Parser parser { move(lexer), state.program_type, state.source_code };
+    parser.m_state.strict_mode = state.strict_mode;
+    parser.m_global_identifier_names_of_function_with_dropped_body = &state.global_identifier_names;
+
+    RefPtr<FunctionExpression const> function;
+    {
+        auto program = adopt_ref(*new Program({ parser.m_source_code, state.function_start, state.function_start }, state.program_type));
+        ScopePusher program_scope = ScopePusher::program_scope(parser, *program);
+        function = parser.parse_function_node<FunctionExpression>(state.parse_options, state.function_start);
+    }
+
+    // The function was parsed without errors the first time around.
+    VERIFY(!parser.has_errors());
+
+    // Functions inside this one are dropped again, but not this one itself.
+    parser.m_lazily_parsed_functions.remove_all_matching([&](auto const& lazily_parsed_function) {
+        return lazily_parsed_function.function == static_cast<FunctionNode const*>(function.ptr());
+    });
+    parser.drop_bodies_of_lazily_parsed_functions();
+
+    return function.release_nonnull();
 }
 
 Vector<FunctionParameter> Parser::parse_formal_parameters(int& function_length, u16 parse_options)
@@ -44,6 +44,10 @@ struct FunctionNodeParseOptions {
 
 class ScopePusher;
 
+// If enabled, the parameters and bodies of large functions are dropped after parsing a script or module, and only parsed
+// again once a function object is created for them.
+extern bool g_lazy_function_parsing;
+
 class Parser {
 public:
     struct EvalInitialState {
@@ -213,9 +217,19 @@ public:
 
     static Parser parse_function_body_from_string(ByteString const& body_string, u16 parse_options, Vector<FunctionParameter> const& parameters, FunctionKind kind, FunctionParsingInsights&);
 
+    static NonnullRefPtr<FunctionExpression const> parse_function_with_dropped_body(LazyFunctionParseState const&);
+
 private:
     friend class ScopePusher;
 
+    Parser(Lexer, Program::Type, NonnullRefPtr<SourceCode const>);
+
+    // Functions smaller than this (including their parameters) are always kept around, as there's little to gain from parsing them again.
+    static constexpr size_t minimum_length_of_lazily_parsed_function = 256;
+
+    bool can_parse_function_lazily(u16 parse_options, Position const& function_start, Vector<FunctionParameter> const&, FunctionParsingInsights const&) const;
+    void drop_bodies_of_lazily_parsed_functions();
+
     void parse_script(Program& program, bool starts_in_strict_mode);
     void parse_module(Program& program);
 
@@ -343,5 +357,19 @@ private:
     Vector<ParserState> m_saved_state;
     HashMap<size_t, TokenMemoization> m_token_memoizations;
     Program::Type m_program_type;
+
+    struct LazilyParsedFunction {
+        NonnullRefPtr<ASTNode> node;
+        FunctionNode* function { nullptr };
+        Position function_start;
+        Position parse_start;
+        u16 parse_options { 0 };
+        bool strict_mode { false };
+        // All identifiers that were registered in the scope of the function when it ended, which includes its free identifiers.
+        Vector<NonnullRefPtr<Identifier>> identifiers;
+    };
+    // NOTE: This is kept outside of the ParserState, as dropping the body of a function that was parsed before backtracking is harmless.
+    Vector<LazilyParsedFunction> m_lazily_parsed_functions;
+    HashTable<DeprecatedFlyString> const* m_global_identifier_names_of_function_with_dropped_body { nullptr };
 };
 }
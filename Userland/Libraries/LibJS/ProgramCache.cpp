@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/ProgramCache.h>
+#include <LibJS/SourceCode.h>
+
+namespace JS {
+
+ProgramCache::~ProgramCache() = default;
+
+void ProgramCache::set_enabled(bool enabled)
+{
+    m_enabled = enabled;
+    if (!m_enabled)
+        clear();
+}
+
+RefPtr<Program> ProgramCache::get(StringView source_text, StringView filename, Program::Type type, size_t line_number_offset)
+{
+    if (!m_enabled || source_text.length() < minimum_source_length)
+        return {};
+
+    auto source_hash = source_text.hash();
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        auto const& entry = m_entries[i];
+        if (entry.source_hash != source_hash || entry.line_number_offset != line_number_offset || entry.program->type() != type)
+            continue;
+
+        // NOTE: The parse tree refers to its source code for error messages and stack traces, so the filename has to
+        //       match as well.
+        auto const& source_code = entry.program->source_code();
+        if (source_code.code().bytes_as_string_view() != source_text || source_code.filename().bytes_as_string_view() != filename)
+            continue;
+
+        auto program = entry.program;
+        m_entries.append(m_entries.take(i));
+        return program;
+    }
+
+    return {};
+}
+
+bool ProgramCache::contains(Program const& program) const
+{
+    return m_entries.first_matching([&](auto const& entry) { return entry.program.ptr() == &program; }).has_value();
+}
+
+void ProgramCache::set(StringView source_text, size_t line_number_offset, NonnullRefPtr<Program> program)
+{
+    if (!m_enabled || source_text.length() < minimum_source_length)
+        return;
+
+    if (m_entries.size() == max_number_of_entries)
+        m_entries.take_first();
+
+    m_entries.append({ source_text.hash(), line_number_offset, move(program) });
+}
+
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibJS/AST.h>
+
+namespace JS {
+
+// Keeps the parse trees of large scripts and modules around, so that loading the same source again (like a framework
+// bundle on every page load) skips the parser. Bytecode is cached on the AST nodes themselves, so reusing a parse tree
+// also reuses the bytecode of its top-level code and of every function in it that has already been compiled.
+class ProgramCache {
+    AK_MAKE_NONCOPYABLE(ProgramCache);
+    AK_MAKE_NONMOVABLE(ProgramCache);
+
+public:
+    // Smaller sources are parsed quickly enough that keeping them around isn't worth the memory.
+    static constexpr size_t minimum_source_length = 4 * KiB;
+    static constexpr size_t max_number_of_entries = 32;
+
+    ProgramCache() = default;
+    ~ProgramCache();
+
+    bool is_enabled() const { return m_enabled; }
+    void set_enabled(bool);
+
+    RefPtr<Program> get(StringView source_text, StringView filename, Program::Type, size_t line_number_offset);
+    void set(StringView source_text, size_t line_number_offset, NonnullRefPtr<Program>);
+    bool contains(Program const&) const;
+
+    void clear() { m_entries.clear(); }
+
+private:
+    struct Entry {
+        unsigned source_hash { 0 };
+        size_t line_number_offset { 0 };
+        NonnullRefPtr<Program> program;
+    };
+
+    // Ordered from least to most recently used.
+    Vector<Entry> m_entries;
+    bool m_enabled { false };
+};
+
+}
@@ -719,6 +719,83 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
     return js_undefined();
 }
 
+// OPTIMIZATION: Every element of an array with packed simple storage is an own data property, so reading them
+//               can't run any user code or reach the prototype chain. This returns that storage if it covers the
+//               whole length of the array, so the array can be searched without a [[HasProperty]]/[[Get]] per element.
+static SimpleIndexedPropertyStorage const* packed_array_storage(Object const& object, u64 length)
+{
+    if (!is<Array>(object) || object.may_interfere_with_indexed_property_access())
+        return nullptr;
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    auto const& simple_storage = static_cast<SimpleIndexedPropertyStorage const&>(*storage);
+    if (!simple_storage.is_packed() || simple_storage.array_like_size() < length)
+        return nullptr;
+    return &simple_storage;
+}
+
+enum class SearchDirection {
+    Forward,
+    Backward,
+};
+
+enum class SearchComparison {
+    IsStrictlyEqual,
+    SameValueZero,
+};
+
+// Returns the index of the first (or last, when searching backward) element in [start, end) that matches.
+static Optional<size_t> search_packed_elements(SimpleIndexedPropertyStorage const& storage, Value search_element, size_t start, size_t end, SearchDirection direction, SearchComparison comparison)
+{
+    using ElementKind = SimpleIndexedPropertyStorage::ElementKind;
+
+    auto const* elements = storage.elements().data();
+    auto find = [&](auto matches) -> Optional<size_t> {
+        if (direction == SearchDirection::Forward) {
+            for (size_t k = start; k < end; ++k) {
+                if (matches(elements[k]))
+                    return k;
+            }
+        } else {
+            for (size_t k = end; k > start; --k) {
+                if (matches(elements[k - 1]))
+                    return k - 1;
+            }
+        }
+        return {};
+    };
+
+    auto kind = storage.element_kind();
+    if (kind == ElementKind::PackedInt32 || kind == ElementKind::PackedDouble) {
+        // Only numbers can be equal to numbers.
+        if (!search_element.is_number())
+            return {};
+
+        // NaN isn't strictly equal to anything, but SameValueZero considers it equal to itself.
+        if (search_element.is_nan()) {
+            if (kind == ElementKind::PackedInt32 || comparison == SearchComparison::IsStrictlyEqual)
+                return {};
+            return find([](Value element) { return element.is_nan(); });
+        }
+
+        if (kind == ElementKind::PackedInt32) {
+            // NOTE: Both comparisons consider -0 and +0 equal, so this finds 0 for either of them.
+            if (!search_element.is_integral_number() || search_element.as_double() < NumericLimits<i32>::min() || search_element.as_double() > NumericLimits<i32>::max())
+                return {};
+            auto number = static_cast<i32>(search_element.as_double());
+            return find([number](Value element) { return element.as_i32() == number; });
+        }
+
+        auto number = search_element.as_double();
+        return find([number](Value element) { return element.as_double() == number; });
+    }
+
+    if (comparison == SearchComparison::SameValueZero)
+        return find([&](Value element) { return same_value_zero(search_element, element); });
+    return find([&](Value element) { return is_strictly_equal(search_element, element); });
+}
+
 // 23.1.3.16 Array.prototype.includes ( searchElement [ , fromIndex ] ), https://tc39.es/ecma262/#sec-array.prototype.includes
 JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
 {
@@ -742,6 +819,10 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    if (auto const* storage = packed_array_storage(this_object, length))
+        return Value(search_packed_elements(*storage, value_to_find, from_index, length, SearchDirection::Forward, SearchComparison::SameValueZero).has_value());
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -795,6 +876,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    if (auto const* storage = packed_array_storage(object, length)) {
+        if (k >= length)
+            return Value(-1);
+        auto index = search_packed_elements(*storage, search_element, k, length, SearchDirection::Forward, SearchComparison::IsStrictlyEqual);
+        return index.has_value() ? Value(*index) : Value(-1);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -906,6 +994,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::last_index_of)
         k = (double)length + n;
     }
 
+    if (auto const* storage = packed_array_storage(object, length)) {
+        if (k < 0)
+            return Value(-1);
+        auto index = search_packed_elements(*storage, search_element, 0, k + 1, SearchDirection::Backward, SearchComparison::IsStrictlyEqual);
+        return index.has_value() ? Value(*index) : Value(-1);
+    }
+
     // 8. Repeat, while k ≥ 0,
     for (; k >= 0; --k) {
         auto property_key = PropertyKey { k };
@@ -64,6 +64,22 @@ public:
     }
     explicit SimpleIndexedPropertyStorage(Vector<Value>&& initial_values);
 
+    // The most specific kind that describes every element, in the order that storage transitions through them.
+    // Storage only becomes more general as elements are put or removed, until it is emptied.
+    enum class ElementKind : u8 {
+        // All elements are Int32 values.
+        PackedInt32,
+        // All elements are numbers.
+        PackedDouble,
+        // All elements are present.
+        Packed,
+        // Some elements may be holes.
+        Holey,
+    };
+
+    ElementKind element_kind() const { return m_element_kind; }
+    bool is_packed() const { return m_element_kind != ElementKind::Holey; }
+
     virtual bool has_index(u32 index) const override;
     virtual Optional<ValueAndAttributes> get(u32 index) const override;
     virtual void put(u32 index, Value value, PropertyAttributes attributes = default_attributes) override;
@@ -80,7 +96,7 @@ public:
 
     [[nodiscard]] bool inline_has_index(u32 index) const
     {
-        return index < m_array_size && !m_packed_elements.data()[index].is_empty();
+        return index < m_array_size && (is_packed() || !m_packed_elements.data()[index].is_empty());
     }
 
     [[nodiscard]] Optional<ValueAndAttributes> inline_get(u32 index) const
@@ -90,12 +106,41 @@ public:
         return ValueAndAttributes { m_packed_elements.data()[index], default_attributes };
     }
 
+    // Overwrites an element that is already present, which is all that PutByValue's fast path needs.
+    // Returns false for holes and accessors, which have to take the slow path.
+    [[nodiscard]] bool inline_put_existing(u32 index, Value value)
+    {
+        if (index >= m_array_size)
+            return false;
+        auto& element = m_packed_elements.data()[index];
+        if (m_element_kind > ElementKind::PackedDouble && (element.is_empty() || element.is_accessor()))
+            return false;
+        update_element_kind(value);
+        element = value;
+        return true;
+    }
+
 private:
     friend GenericIndexedPropertyStorage;
 
     void grow_storage_if_needed();
 
+    void update_element_kind(Value value)
+    {
+        if (m_element_kind == ElementKind::Holey)
+            return;
+        auto kind = ElementKind::Packed;
+        if (value.is_empty())
+            kind = ElementKind::Holey;
+        else if (value.is_int32())
+            kind = ElementKind::PackedInt32;
+        else if (value.is_number())
+            kind = ElementKind::PackedDouble;
+        m_element_kind = max(m_element_kind, kind);
+    }
+
     size_t m_array_size { 0 };
+    ElementKind m_element_kind { ElementKind::PackedInt32 };
     Vector<Value> m_packed_elements;
 };
 
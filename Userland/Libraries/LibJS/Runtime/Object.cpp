@@ -27,6 +27,9 @@ JS_DEFINE_ALLOCATOR(Object);
 
 static HashMap<GCPtr<Object const>, HashMap<DeprecatedFlyString, Object::IntrinsicAccessor>> s_intrinsics;
 
+// Objects with more properties than this are kept as dictionaries, instead of creating a transition per property.
+static constexpr size_t max_transitions_before_converting_to_dictionary = 64;
+
 // 10.1.12 OrdinaryObjectCreate ( proto [ , additionalInternalSlotsList ] ), https://tc39.es/ecma262/#sec-ordinaryobjectcreate
 NonnullGCPtr<Object> Object::create(Realm& realm, Object* prototype)
 {
@@ -913,8 +916,12 @@ ThrowCompletionOr<Value> Object::internal_get(PropertyKey const& property_key, V
 
     auto update_inline_cache = [&] {
         // Non-standard: If the caller has requested cacheable metadata and the property is an own property, fill it in.
-        if (!cacheable_metadata || !descriptor->property_offset.has_value() || !shape().is_cacheable())
+        if (!cacheable_metadata || !descriptor->property_offset.has_value())
+            return;
+        if (!shape().is_cacheable()) {
+            const_cast<Object&>(*this).did_perform_uncached_lookup();
             return;
+        }
         if (phase == PropertyLookupPhase::OwnProperty) {
             *cacheable_metadata = CacheablePropertyMetadata {
                 .type = CacheablePropertyMetadata::Type::OwnProperty,
@@ -1027,12 +1034,16 @@ ThrowCompletionOr<bool> Object::ordinary_set_with_own_descriptor(PropertyKey con
             // iii. Let valueDesc be the PropertyDescriptor { [[Value]]: V }.
             auto value_descriptor = PropertyDescriptor { .value = value };
 
-            if (cacheable_metadata && own_descriptor.has_value() && own_descriptor->property_offset.has_value() && shape().is_cacheable()) {
-                *cacheable_metadata = CacheablePropertyMetadata {
-                    .type = CacheablePropertyMetadata::Type::OwnProperty,
-                    .property_offset = own_descriptor->property_offset.value(),
-                    .prototype = nullptr,
-                };
+            if (cacheable_metadata && own_descriptor.has_value() && own_descriptor->property_offset.has_value()) {
+                if (shape().is_cacheable()) {
+                    *cacheable_metadata = CacheablePropertyMetadata {
+                        .type = CacheablePropertyMetadata::Type::OwnProperty,
+                        .property_offset = own_descriptor->property_offset.value(),
+                        .prototype = nullptr,
+                    };
+                } else {
+                    did_perform_uncached_lookup();
+                }
             }
 
             // iv. Return ? Receiver.[[DefineOwnProperty]](P, valueDesc).
@@ -1217,8 +1228,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
     auto metadata = shape().lookup(property_key_string_or_symbol);
 
     if (!metadata.has_value()) {
-        static constexpr size_t max_transitions_before_converting_to_dictionary = 64;
-        if (!m_shape->is_dictionary() && m_shape->property_count() >= max_transitions_before_converting_to_dictionary)
+        if (!m_shape->is_dictionary() && (m_shape->property_count() >= max_transitions_before_converting_to_dictionary || !m_shape->can_cache_forward_transition(property_key_string_or_symbol, attributes)))
             set_shape(m_shape->create_cacheable_dictionary_transition());
 
         if (m_shape->is_dictionary())
@@ -1230,6 +1240,9 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
     }
 
     if (attributes != metadata->attributes) {
+        if (!m_shape->is_dictionary() && !m_shape->can_cache_forward_transition(property_key_string_or_symbol, attributes))
+            set_shape(m_shape->create_cacheable_dictionary_transition());
+
         if (m_shape->is_dictionary())
             m_shape->set_property_attributes_without_transition(property_key_string_or_symbol, attributes);
         else
@@ -1255,6 +1268,9 @@ void Object::storage_delete(PropertyKey const& property_key)
     auto metadata = shape().lookup(property_key.to_string_or_symbol());
     VERIFY(metadata.has_value());
 
+    if (!m_shape->is_dictionary() && !m_shape->can_cache_delete_transition(property_key.to_string_or_symbol()))
+        m_shape = m_shape->create_cacheable_dictionary_transition();
+
     if (m_shape->is_cacheable_dictionary()) {
         m_shape = m_shape->create_uncacheable_dictionary_transition();
     }
@@ -1267,6 +1283,19 @@ void Object::storage_delete(PropertyKey const& property_key)
     m_storage.remove(metadata->offset);
 }
 
+void Object::did_perform_uncached_lookup()
+{
+    if (!m_shape->record_uncached_lookup())
+        return;
+
+    // This object has stopped having properties deleted from it, so let inline caches work with it again.
+    // NOTE: Both kinds of shapes keep the offsets of the properties, so our property storage stays as it is.
+    if (!m_shape->is_prototype_shape() && m_shape->property_count() < max_transitions_before_converting_to_dictionary)
+        m_shape = m_shape->create_non_dictionary_transition_chain();
+    else
+        m_shape = m_shape->create_cacheable_dictionary_transition();
+}
+
 void Object::set_prototype(Object* new_prototype)
 {
     if (prototype() == new_prototype)
@@ -256,6 +256,8 @@ protected:
 private:
     void set_shape(Shape& shape) { m_shape = &shape; }
 
+    void did_perform_uncached_lookup();
+
     Object* prototype() { return shape().prototype(); }
 
     bool m_may_interfere_with_indexed_property_access { false };
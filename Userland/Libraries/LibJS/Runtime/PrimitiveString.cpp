@@ -21,8 +21,56 @@ namespace JS {
 
 JS_DEFINE_ALLOCATOR(PrimitiveString);
 
+// Appends the UTF-8 encoded `current` to a builder that ends with `previous`, combining a high surrogate at the end
+// of `previous` and a low surrogate at the start of `current` into a single code point.
+static void append_joining_surrogate_pair(StringBuilder& builder, StringView previous, StringView current)
+{
+    // Surrogates encoded as UTF-8 are 3 bytes.
+    if ((previous.length() < 3) || (current.length() < 3)) {
+        builder.append(current);
+        return;
+    }
+
+    // Might the previous string end with a UTF-8 encoded surrogate?
+    if ((static_cast<u8>(previous[previous.length() - 3]) & 0xf0) != 0xe0) {
+        builder.append(current);
+        return;
+    }
+
+    // Might the current string begin with a UTF-8 encoded surrogate?
+    if ((static_cast<u8>(current[0]) & 0xf0) != 0xe0) {
+        builder.append(current);
+        return;
+    }
+
+    auto high_surrogate = *Utf8View(previous.substring_view(previous.length() - 3)).begin();
+    auto low_surrogate = *Utf8View(current).begin();
+
+    if (!Utf16View::is_high_surrogate(high_surrogate) || !Utf16View::is_low_surrogate(low_surrogate)) {
+        builder.append(current);
+        return;
+    }
+
+    // Remove 3 bytes from the builder and replace them with the UTF-8 encoded code point.
+    builder.trim(3);
+    builder.append_code_point(Utf16View::decode_surrogate_pair(high_surrogate, low_surrogate));
+
+    // Append the remaining part of the current string.
+    builder.append(current.substring_view(3));
+}
+
+static size_t utf16_length_of_utf8_string(StringView string)
+{
+    size_t length = 0;
+    for (auto code_point : Utf8View(string))
+        length += code_point > 0xffff ? 2 : 1;
+    return length;
+}
+
 PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
     : m_is_rope(true)
+    , m_rope_depth(max(lhs.m_rope_depth, rhs.m_rope_depth) + 1)
+    , m_length_in_utf16_code_units(lhs.length_in_utf16_code_units() + rhs.length_in_utf16_code_units())
     , m_lhs(&lhs)
     , m_rhs(&rhs)
 {
@@ -78,6 +126,41 @@ bool PrimitiveString::is_empty() const
     VERIFY_NOT_REACHED();
 }
 
+size_t PrimitiveString::length_in_utf16_code_units() const
+{
+    if (!m_length_in_utf16_code_units.has_value()) {
+        // NOTE: Ropes know their length from the moment they are created.
+        VERIFY(!m_is_rope);
+
+        if (has_utf16_string())
+            m_length_in_utf16_code_units = m_utf16_string->length_in_code_units();
+        else if (has_utf8_string())
+            m_length_in_utf16_code_units = utf16_length_of_utf8_string(m_utf8_string->bytes_as_string_view());
+        else if (has_byte_string())
+            m_length_in_utf16_code_units = utf16_length_of_utf8_string(*m_byte_string);
+        else
+            VERIFY_NOT_REACHED();
+    }
+
+    return *m_length_in_utf16_code_units;
+}
+
+bool PrimitiveString::equals(PrimitiveString const& other) const
+{
+    if (this == &other)
+        return true;
+
+    // Ropes know their length, so this tells most differing strings apart without resolving them.
+    if (length_in_utf16_code_units() != other.length_in_utf16_code_units())
+        return false;
+
+    if (has_utf16_string() && other.has_utf16_string())
+        return *m_utf16_string == *other.m_utf16_string;
+    if (has_byte_string() && other.has_byte_string())
+        return *m_byte_string == *other.m_byte_string;
+    return utf8_string_view() == other.utf8_string_view();
+}
+
 String PrimitiveString::utf8_string() const
 {
     resolve_rope_if_needed(EncodingPreference::UTF8);
@@ -144,7 +227,7 @@ ThrowCompletionOr<Optional<Value>> PrimitiveString::get(VM& vm, PropertyKey cons
         return Optional<Value> {};
     if (property_key.is_string()) {
         if (property_key.as_string() == vm.names.length.as_string()) {
-            auto length = utf16_string().length_in_code_units();
+            auto length = length_in_utf16_code_units();
             return Value(static_cast<double>(length));
         }
     }
@@ -251,9 +334,55 @@ NonnullGCPtr<PrimitiveString> PrimitiveString::create(VM& vm, PrimitiveString& l
     if (rhs_empty)
         return lhs;
 
+    // Short results are smaller as a flat string than as a rope node.
+    auto rhs_length = rhs.length_in_utf16_code_units();
+    if (!lhs.m_is_rope && !rhs.m_is_rope && lhs.length_in_utf16_code_units() + rhs_length <= max_length_of_flattened_concatenation)
+        return concatenate_flat_strings(vm, lhs, rhs);
+
+    // When a short string is appended to a rope that ends in a short piece, like `html += "<td>" + cell + "</td>"`
+    // does over and over, we merge both pieces instead of growing the rope by another node. The original rope may
+    // still be referenced elsewhere, so the result is a new node that shares its left side.
+    if (lhs.m_is_rope && !rhs.m_is_rope) {
+        auto& tail = *lhs.m_rhs;
+        if (!tail.m_is_rope && tail.length_in_utf16_code_units() + rhs_length <= max_length_of_flattened_concatenation)
+            return vm.heap().allocate_without_realm<PrimitiveString>(*lhs.m_lhs, concatenate_flat_strings(vm, tail, rhs));
+    }
+
+    // Resolve the deeper side of a rope that would grow too deep, which bounds both the number of pieces it keeps
+    // alive and the amount of work left for whoever resolves it in the end.
+    if (max(lhs.m_rope_depth, rhs.m_rope_depth) >= max_rope_depth) {
+        if (lhs.m_rope_depth >= rhs.m_rope_depth)
+            lhs.resolve_rope_if_needed(EncodingPreference::UTF8);
+        else
+            rhs.resolve_rope_if_needed(EncodingPreference::UTF8);
+    }
+
     return vm.heap().allocate_without_realm<PrimitiveString>(lhs, rhs);
 }
 
+NonnullGCPtr<PrimitiveString> PrimitiveString::concatenate_flat_strings(VM& vm, PrimitiveString const& lhs, PrimitiveString const& rhs)
+{
+    VERIFY(!lhs.m_is_rope);
+    VERIFY(!rhs.m_is_rope);
+
+    // Stay in UTF-16 if both strings have it, unless both also have UTF-8.
+    if (lhs.has_utf16_string() && rhs.has_utf16_string() && (!lhs.has_utf8_string() || !rhs.has_utf8_string())) {
+        Utf16Data code_units;
+        code_units.ensure_capacity(lhs.length_in_utf16_code_units() + rhs.length_in_utf16_code_units());
+        code_units.extend(lhs.m_utf16_string->string());
+        code_units.extend(rhs.m_utf16_string->string());
+        return create(vm, Utf16String::create(move(code_units)));
+    }
+
+    auto lhs_string = lhs.utf8_string_view();
+    StringBuilder builder;
+    builder.append(lhs_string);
+    append_joining_surrogate_pair(builder, lhs_string, rhs.utf8_string_view());
+
+    // NOTE: Both strings are valid UTF-8, and so is joining them as above.
+    return create(vm, builder.to_string_without_validation());
+}
+
 void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) const
 {
     if (!m_is_rope)
@@ -283,11 +412,13 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
         // into a UTF-16 code unit buffer and create a Utf16String from it.
 
         Utf16Data code_units;
+        code_units.ensure_capacity(*m_length_in_utf16_code_units);
         for (auto const* current : pieces)
             code_units.extend(current->utf16_string().string());
 
         m_utf16_string = Utf16String::create(move(code_units));
         m_is_rope = false;
+        m_rope_depth = 0;
         m_lhs = nullptr;
         m_rhs = nullptr;
         return;
@@ -297,66 +428,17 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
     StringBuilder builder;
 
     // We keep track of the previous piece in order to handle surrogate pairs spread across two pieces.
-    PrimitiveString const* previous = nullptr;
+    StringView previous;
     for (auto const* current : pieces) {
-        if (!previous) {
-            // This is the very first piece, just append it and continue.
-            builder.append(current->utf8_string());
-            previous = current;
-            continue;
-        }
-
-        // Get the UTF-8 representations for both strings.
         auto current_string_as_utf8 = current->utf8_string_view();
-        auto previous_string_as_utf8 = previous->utf8_string_view();
-
-        // NOTE: Now we need to look at the end of the previous string and the start
-        //       of the current string, to see if they should be combined into a surrogate.
-
-        // Surrogates encoded as UTF-8 are 3 bytes.
-        if ((previous_string_as_utf8.length() < 3) || (current_string_as_utf8.length() < 3)) {
-            builder.append(current_string_as_utf8);
-            previous = current;
-            continue;
-        }
-
-        // Might the previous string end with a UTF-8 encoded surrogate?
-        if ((static_cast<u8>(previous_string_as_utf8[previous_string_as_utf8.length() - 3]) & 0xf0) != 0xe0) {
-            // If not, just append the current string and continue.
-            builder.append(current_string_as_utf8);
-            previous = current;
-            continue;
-        }
-
-        // Might the current string begin with a UTF-8 encoded surrogate?
-        if ((static_cast<u8>(current_string_as_utf8[0]) & 0xf0) != 0xe0) {
-            // If not, just append the current string and continue.
-            builder.append(current_string_as_utf8);
-            previous = current;
-            continue;
-        }
-
-        auto high_surrogate = *Utf8View(previous_string_as_utf8.substring_view(previous_string_as_utf8.length() - 3)).begin();
-        auto low_surrogate = *Utf8View(current_string_as_utf8).begin();
-
-        if (!Utf16View::is_high_surrogate(high_surrogate) || !Utf16View::is_low_surrogate(low_surrogate)) {
-            builder.append(current_string_as_utf8);
-            previous = current;
-            continue;
-        }
-
-        // Remove 3 bytes from the builder and replace them with the UTF-8 encoded code point.
-        builder.trim(3);
-        builder.append_code_point(Utf16View::decode_surrogate_pair(high_surrogate, low_surrogate));
-
-        // Append the remaining part of the current string.
-        builder.append(current_string_as_utf8.substring_view(3));
-        previous = current;
+        append_joining_surrogate_pair(builder, previous, current_string_as_utf8);
+        previous = current_string_as_utf8;
     }
 
     // NOTE: We've already produced valid UTF-8 above, so there's no need for additional validation.
     m_utf8_string = builder.to_string_without_validation();
     m_is_rope = false;
+    m_rope_depth = 0;
     m_lhs = nullptr;
     m_rhs = nullptr;
 }
@@ -40,6 +40,12 @@ public:
 
     bool is_empty() const;
 
+    // NOTE: This is known for ropes without resolving them, so prefer it over utf16_string().length_in_code_units().
+    [[nodiscard]] size_t length_in_utf16_code_units() const;
+
+    // Compares the code units of both strings, using whichever representation they already have in common.
+    [[nodiscard]] bool equals(PrimitiveString const&) const;
+
     [[nodiscard]] String utf8_string() const;
     [[nodiscard]] StringView utf8_string_view() const;
     bool has_utf8_string() const { return m_utf8_string.has_value(); }
@@ -54,6 +60,15 @@ public:
     ThrowCompletionOr<Optional<Value>> get(VM&, PropertyKey const&) const;
 
 private:
+    // Concatenations that result in a string of at most this many code units are flattened right away,
+    // since a rope node is larger than the string itself. This also merges short pieces appended to a rope.
+    static constexpr size_t max_length_of_flattened_concatenation = 64;
+
+    // Once a rope would become deeper than this, its deeper side is resolved first.
+    static constexpr u32 max_rope_depth = 512;
+
+    static NonnullGCPtr<PrimitiveString> concatenate_flat_strings(VM&, PrimitiveString const&, PrimitiveString const&);
+
     explicit PrimitiveString(PrimitiveString&, PrimitiveString&);
     explicit PrimitiveString(String);
     explicit PrimitiveString(ByteString);
@@ -68,6 +83,8 @@ private:
     void resolve_rope_if_needed(EncodingPreference) const;
 
     mutable bool m_is_rope { false };
+    mutable u32 m_rope_depth { 0 };
+    mutable Optional<size_t> m_length_in_utf16_code_units;
 
     mutable GCPtr<PrimitiveString> m_lhs;
     mutable GCPtr<PrimitiveString> m_rhs;
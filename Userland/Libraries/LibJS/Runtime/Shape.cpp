@@ -4,7 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibJS/Heap/CellAllocator.h>
 #include <LibJS/Heap/DeferGC.h>
+#include <LibJS/Heap/HeapBlock.h>
+#include <LibJS/Runtime/Intrinsics.h>
+#include <LibJS/Runtime/Realm.h>
 #include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/VM.h>
 
@@ -29,9 +33,8 @@ NonnullGCPtr<Shape> Shape::create_cacheable_dictionary_transition()
     new_shape->m_prototype = m_prototype;
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
     ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = m_property_table->copy(m_property_count);
+    new_shape->m_property_count = m_property_count;
     return new_shape;
 }
 
@@ -39,16 +42,62 @@ NonnullGCPtr<Shape> Shape::create_uncacheable_dictionary_transition()
 {
     auto new_shape = heap().allocate_without_realm<Shape>(m_realm);
     new_shape->m_dictionary = true;
-    new_shape->m_cacheable = true;
+    new_shape->m_cacheable = false;
     new_shape->m_prototype = m_prototype;
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
     ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = m_property_table->copy(m_property_count);
+    new_shape->m_property_count = m_property_count;
+    return new_shape;
+}
+
+NonnullGCPtr<Shape> Shape::create_non_dictionary_transition_chain()
+{
+    VERIFY(is_dictionary());
+    VERIFY(!m_is_prototype_shape);
+
+    // NOTE: Offsets are handed out in the order of the put transitions, which is the order of our property table,
+    //       so the object's property storage stays the same.
+    NonnullGCPtr<Shape> new_shape = m_realm->intrinsics().empty_object_shape();
+    if (new_shape->prototype() != m_prototype)
+        new_shape = new_shape->create_prototype_transition(m_prototype);
+    for (auto const& property : property_table())
+        new_shape = new_shape->create_put_transition(property.key, property.value.attributes);
+    VERIFY(new_shape->property_count() == m_property_count);
     return new_shape;
 }
 
+template<typename KeyType, typename TransitionsType>
+bool Shape::can_cache_transition(OwnPtr<TransitionsType>& transitions, KeyType const& key)
+{
+    if (!transitions || transitions->size() < max_cached_transitions || transitions->contains(key))
+        return true;
+    // Stale transitions (from garbage collection) don't count towards the limit, so prune them before giving up.
+    transitions->remove_all_matching([](auto&, auto& shape) { return !shape; });
+    return transitions->size() < max_cached_transitions;
+}
+
+bool Shape::can_cache_forward_transition(StringOrSymbol const& property_key, PropertyAttributes attributes)
+{
+    // NOTE: Prototype shapes never cache their forward transitions, so they are never full.
+    if (m_is_prototype_shape)
+        return true;
+    return can_cache_transition(m_forward_transitions, TransitionKey { property_key, attributes });
+}
+
+bool Shape::can_cache_delete_transition(StringOrSymbol const& property_key)
+{
+    return can_cache_transition(m_delete_transitions, property_key);
+}
+
+bool Shape::record_uncached_lookup()
+{
+    VERIFY(is_uncacheable_dictionary());
+    if (m_uncached_lookup_count < uncached_lookups_before_reshaping)
+        ++m_uncached_lookup_count;
+    return m_uncached_lookup_count == uncached_lookups_before_reshaping;
+}
+
 GCPtr<Shape> Shape::get_or_prune_cached_forward_transition(TransitionKey const& key)
 {
     if (m_is_prototype_shape)
@@ -107,7 +156,7 @@ NonnullGCPtr<Shape> Shape::create_put_transition(StringOrSymbol const& property_
         return *existing_shape;
     auto new_shape = heap().allocate_without_realm<Shape>(*this, property_key, attributes, TransitionType::Put);
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
-    if (!m_is_prototype_shape) {
+    if (!m_is_prototype_shape && can_cache_transition(m_forward_transitions, key)) {
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
         m_forward_transitions->set(key, new_shape.ptr());
@@ -122,7 +171,7 @@ NonnullGCPtr<Shape> Shape::create_configure_transition(StringOrSymbol const& pro
         return *existing_shape;
     auto new_shape = heap().allocate_without_realm<Shape>(*this, property_key, attributes, TransitionType::Configure);
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
-    if (!m_is_prototype_shape) {
+    if (!m_is_prototype_shape && can_cache_transition(m_forward_transitions, key)) {
         if (!m_forward_transitions)
             m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
         m_forward_transitions->set(key, new_shape.ptr());
@@ -138,7 +187,7 @@ NonnullGCPtr<Shape> Shape::create_prototype_transition(Object* new_prototype)
         return *existing_shape;
     auto new_shape = heap().allocate_without_realm<Shape>(*this, new_prototype);
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
-    if (!m_is_prototype_shape) {
+    if (!m_is_prototype_shape && can_cache_transition(m_prototype_transitions, GCPtr<Object> { new_prototype })) {
         if (!m_prototype_transitions)
             m_prototype_transitions = make<HashMap<GCPtr<Object>, WeakPtr<Shape>>>();
         m_prototype_transitions->set(new_prototype, new_shape.ptr());
@@ -214,60 +263,123 @@ Optional<PropertyMetadata> Shape::lookup(StringOrSymbol const& property_key) con
 {
     if (m_property_count == 0)
         return {};
-    auto property = property_table().get(property_key);
-    if (!property.has_value())
+    ensure_property_table();
+    auto index = m_property_table->indices.get(property_key);
+    if (!index.has_value() || *index >= m_property_count)
         return {};
-    return property.copy();
+    return m_property_table->properties[*index].value;
 }
 
-FLATTEN OrderedHashMap<StringOrSymbol, PropertyMetadata> const& Shape::property_table() const
+FLATTEN ReadonlySpan<Shape::Property> Shape::property_table() const
 {
     ensure_property_table();
-    return *m_property_table;
+    return m_property_table->properties.span().trim(m_property_count);
+}
+
+NonnullRefPtr<Shape::PropertyTable> Shape::PropertyTable::copy(u32 property_count) const
+{
+    auto table = adopt_ref(*new PropertyTable);
+    table->properties.ensure_capacity(property_count);
+    table->indices.ensure_capacity(property_count);
+    for (u32 i = 0; i < property_count; ++i) {
+        table->properties.unchecked_append(properties[i]);
+        table->indices.set(properties[i].key, i);
+    }
+    return table;
+}
+
+void Shape::PropertyTable::append(StringOrSymbol const& property_key, PropertyAttributes attributes)
+{
+    VERIFY(properties.size() < NumericLimits<u32>::max());
+    u32 offset = properties.size();
+    properties.append({ property_key, { offset, attributes } });
+    indices.set(property_key, offset);
+}
+
+void Shape::PropertyTable::remove(StringOrSymbol const& property_key)
+{
+    auto index = indices.take(property_key);
+    VERIFY(index.has_value());
+    properties.remove(*index);
+    for (u32 i = *index; i < properties.size(); ++i) {
+        --properties[i].value.offset;
+        indices.set(properties[i].key, i);
+    }
 }
 
 void Shape::ensure_property_table() const
 {
     if (m_property_table)
         return;
-    m_property_table = make<OrderedHashMap<StringOrSymbol, PropertyMetadata>>();
-
-    u32 next_offset = 0;
 
     Vector<Shape const&, 64> transition_chain;
     transition_chain.append(*this);
-    for (auto shape = m_previous; shape; shape = shape->m_previous) {
-        if (shape->m_property_table) {
-            *m_property_table = *shape->m_property_table;
-            next_offset = shape->m_property_count;
-            break;
-        }
+    for (auto shape = m_previous; shape && !shape->m_property_table; shape = shape->m_previous)
         transition_chain.append(*shape);
+
+    // NOTE: The shapes along the way get their table too, so that their other transitions can share it later.
+    for (auto const& shape : transition_chain.in_reverse())
+        shape.derive_property_table_from_previous_shape();
+}
+
+void Shape::derive_property_table_from_previous_shape() const
+{
+    if (!m_previous) {
+        VERIFY(m_property_count == 0);
+        m_property_table = adopt_ref(*new PropertyTable);
+        return;
     }
 
-    for (auto const& shape : transition_chain.in_reverse()) {
-        if (!shape.m_property_key.is_valid()) {
-            // Ignore prototype transitions as they don't affect the key map.
-            continue;
-        }
-        if (shape.m_transition_type == TransitionType::Put) {
-            m_property_table->set(shape.m_property_key, { next_offset++, shape.m_attributes });
-        } else if (shape.m_transition_type == TransitionType::Configure) {
-            auto it = m_property_table->find(shape.m_property_key);
-            VERIFY(it != m_property_table->end());
-            it->value.attributes = shape.m_attributes;
-        } else if (shape.m_transition_type == TransitionType::Delete) {
-            auto remove_it = m_property_table->find(shape.m_property_key);
-            VERIFY(remove_it != m_property_table->end());
-            auto removed_offset = remove_it->value.offset;
-            m_property_table->remove(remove_it);
-            for (auto& it : *m_property_table) {
-                if (it.value.offset > removed_offset)
-                    --it.value.offset;
-            }
-            --next_offset;
+    auto& previous_table = *m_previous->m_property_table;
+    auto previous_property_count = m_previous->m_property_count;
+
+    // NOTE: Dictionaries change their table in place, so a table can only be shared with non-dictionary shapes.
+    if (m_previous->m_dictionary) {
+        m_property_table = previous_table.copy(previous_property_count);
+        if (m_transition_type == TransitionType::Prototype)
+            return;
+    }
+
+    switch (m_transition_type) {
+    case TransitionType::Prototype:
+        m_property_table = previous_table;
+        break;
+    case TransitionType::Put:
+        if (m_property_table) {
+            m_property_table->append(m_property_key, m_attributes);
+        } else if (previous_table.properties.size() == previous_property_count) {
+            // We're the first put transition from the previous shape to get a table, so we can just add on to its table.
+            previous_table.append(m_property_key, m_attributes);
+            m_property_table = previous_table;
+        } else {
+            m_property_table = previous_table.copy(previous_property_count);
+            m_property_table->append(m_property_key, m_attributes);
         }
+        break;
+    case TransitionType::Configure: {
+        if (!m_property_table)
+            m_property_table = previous_table.copy(previous_property_count);
+        auto index = m_property_table->indices.get(m_property_key);
+        VERIFY(index.has_value());
+        m_property_table->properties[*index].value.attributes = m_attributes;
+        break;
     }
+    case TransitionType::Delete:
+        if (!m_property_table)
+            m_property_table = previous_table.copy(previous_property_count);
+        m_property_table->remove(m_property_key);
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+Shape::PropertyTable& Shape::ensure_unshared_property_table()
+{
+    ensure_property_table();
+    if (m_property_table->ref_count() > 1 || m_property_table->properties.size() != m_property_count)
+        m_property_table = m_property_table->copy(m_property_count);
+    return *m_property_table;
 }
 
 NonnullGCPtr<Shape> Shape::create_delete_transition(StringOrSymbol const& property_key)
@@ -276,20 +388,24 @@ NonnullGCPtr<Shape> Shape::create_delete_transition(StringOrSymbol const& proper
         return *existing_shape;
     auto new_shape = heap().allocate_without_realm<Shape>(*this, property_key, TransitionType::Delete);
     invalidate_prototype_if_needed_for_new_prototype(new_shape);
-    if (!m_delete_transitions)
-        m_delete_transitions = make<HashMap<StringOrSymbol, WeakPtr<Shape>>>();
-    m_delete_transitions->set(property_key, new_shape.ptr());
+    if (can_cache_transition(m_delete_transitions, property_key)) {
+        if (!m_delete_transitions)
+            m_delete_transitions = make<HashMap<StringOrSymbol, WeakPtr<Shape>>>();
+        m_delete_transitions->set(property_key, new_shape.ptr());
+    }
     return new_shape;
 }
 
 void Shape::add_property_without_transition(StringOrSymbol const& property_key, PropertyAttributes attributes)
 {
     VERIFY(property_key.is_valid());
-    ensure_property_table();
-    if (m_property_table->set(property_key, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry) {
-        VERIFY(m_property_count < NumericLimits<u32>::max());
-        ++m_property_count;
+    auto& table = ensure_unshared_property_table();
+    if (auto index = table.indices.get(property_key); index.has_value()) {
+        table.properties[*index].value.attributes = attributes;
+        return;
     }
+    table.append(property_key, attributes);
+    ++m_property_count;
 }
 
 FLATTEN void Shape::add_property_without_transition(PropertyKey const& property_key, PropertyAttributes attributes)
@@ -301,24 +417,22 @@ FLATTEN void Shape::add_property_without_transition(PropertyKey const& property_
 void Shape::set_property_attributes_without_transition(StringOrSymbol const& property_key, PropertyAttributes attributes)
 {
     VERIFY(is_dictionary());
-    VERIFY(m_property_table);
-    auto it = m_property_table->find(property_key);
-    VERIFY(it != m_property_table->end());
-    it->value.attributes = attributes;
-    m_property_table->set(property_key, it->value);
+    auto& table = ensure_unshared_property_table();
+    auto index = table.indices.get(property_key);
+    VERIFY(index.has_value());
+    table.properties[*index].value.attributes = attributes;
 }
 
 void Shape::remove_property_without_transition(StringOrSymbol const& property_key, u32 offset)
 {
     VERIFY(is_uncacheable_dictionary());
-    VERIFY(m_property_table);
-    if (m_property_table->remove(property_key))
-        --m_property_count;
-    for (auto& it : *m_property_table) {
-        VERIFY(it.value.offset != offset);
-        if (it.value.offset > offset)
-            --it.value.offset;
-    }
+    auto& table = ensure_unshared_property_table();
+    VERIFY(table.indices.get(property_key) == offset);
+    table.remove(property_key);
+    --m_property_count;
+
+    // Deleting properties is what keeps us uncacheable, so start counting lookups from scratch.
+    m_uncached_lookup_count = 0;
 }
 
 NonnullGCPtr<Shape> Shape::create_for_prototype(NonnullGCPtr<Realm> realm, GCPtr<Object> prototype)
@@ -340,9 +454,8 @@ NonnullGCPtr<Shape> Shape::clone_for_prototype()
     new_shape->m_is_prototype_shape = true;
     new_shape->m_prototype = m_prototype;
     ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    new_shape->m_property_table = m_property_table->copy(m_property_count);
+    new_shape->m_property_count = m_property_count;
     new_shape->m_prototype_chain_validity = heap().allocate_without_realm<PrototypeChainValidity>();
     return new_shape;
 }
@@ -394,4 +507,27 @@ void Shape::invalidate_all_prototype_chains_leading_to_this()
     }
 }
 
+Shape::Statistics Shape::statistics()
+{
+    Statistics statistics;
+    HashTable<PropertyTable const*> seen_property_tables;
+    cell_allocator.allocator->for_each_block([&](HeapBlock& block) {
+        block.for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            auto const& shape = static_cast<Shape const&>(*cell);
+            ++statistics.shapes;
+            if (shape.m_dictionary)
+                ++statistics.dictionaries;
+            if (!shape.m_property_table || seen_property_tables.set(shape.m_property_table.ptr()) != AK::HashSetResult::InsertedNewEntry)
+                return;
+            auto const& table = *shape.m_property_table;
+            ++statistics.property_tables;
+            statistics.property_table_bytes += sizeof(PropertyTable)
+                + table.properties.capacity() * sizeof(Property)
+                + table.indices.capacity() * (sizeof(StringOrSymbol) + sizeof(u32));
+        });
+        return IterationDecision::Continue;
+    });
+    return statistics;
+}
+
 }
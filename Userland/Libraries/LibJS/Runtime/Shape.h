@@ -8,7 +8,10 @@
 
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/StringView.h>
+#include <AK/Vector.h>
 #include <AK/WeakPtr.h>
 #include <AK/Weakable.h>
 #include <LibJS/Forward.h>
@@ -54,6 +57,15 @@ class Shape final : public Cell {
 public:
     virtual ~Shape() override;
 
+    // Shapes stop caching new transitions of a kind once they have this many, so a shape that is used with
+    // lots of different property keys (e.g. by objects used as hash maps) can't grow its transition maps
+    // without bounds. Objects that would need an uncached transition become dictionaries instead.
+    static constexpr size_t max_cached_transitions = 64;
+
+    // An uncacheable dictionary is given a cacheable shape again after this many property lookups
+    // that couldn't be cached, as long as no property was deleted from it in the meantime.
+    static constexpr u8 uncached_lookups_before_reshaping = 16;
+
     enum class TransitionType : u8 {
         Invalid,
         Put,
@@ -70,6 +82,7 @@ public:
     [[nodiscard]] NonnullGCPtr<Shape> create_delete_transition(StringOrSymbol const&);
     [[nodiscard]] NonnullGCPtr<Shape> create_cacheable_dictionary_transition();
     [[nodiscard]] NonnullGCPtr<Shape> create_uncacheable_dictionary_transition();
+    [[nodiscard]] NonnullGCPtr<Shape> create_non_dictionary_transition_chain();
     [[nodiscard]] NonnullGCPtr<Shape> clone_for_prototype();
     [[nodiscard]] static NonnullGCPtr<Shape> create_for_prototype(NonnullGCPtr<Realm>, GCPtr<Object> prototype);
 
@@ -79,6 +92,12 @@ public:
     void remove_property_without_transition(StringOrSymbol const&, u32 offset);
     void set_property_attributes_without_transition(StringOrSymbol const&, PropertyAttributes);
 
+    [[nodiscard]] bool can_cache_forward_transition(StringOrSymbol const&, PropertyAttributes);
+    [[nodiscard]] bool can_cache_delete_transition(StringOrSymbol const&);
+
+    // Returns true once an uncacheable dictionary has been looked up often enough to be worth reshaping.
+    [[nodiscard]] bool record_uncached_lookup();
+
     [[nodiscard]] bool is_cacheable() const { return m_cacheable; }
     [[nodiscard]] bool is_dictionary() const { return m_dictionary; }
     [[nodiscard]] bool is_cacheable_dictionary() const { return m_dictionary && m_cacheable; }
@@ -94,15 +113,23 @@ public:
     Object* prototype() { return m_prototype; }
     Object const* prototype() const { return m_prototype; }
 
-    Optional<PropertyMetadata> lookup(StringOrSymbol const&) const;
-    OrderedHashMap<StringOrSymbol, PropertyMetadata> const& property_table() const;
-    u32 property_count() const { return m_property_count; }
-
     struct Property {
         StringOrSymbol key;
         PropertyMetadata value;
     };
 
+    Optional<PropertyMetadata> lookup(StringOrSymbol const&) const;
+    ReadonlySpan<Property> property_table() const;
+    u32 property_count() const { return m_property_count; }
+
+    struct Statistics {
+        size_t shapes { 0 };
+        size_t dictionaries { 0 };
+        size_t property_tables { 0 };
+        size_t property_table_bytes { 0 };
+    };
+    static Statistics statistics();
+
     void set_prototype_without_transition(Object* new_prototype);
 
 private:
@@ -120,11 +147,28 @@ private:
     [[nodiscard]] GCPtr<Shape> get_or_prune_cached_prototype_transition(Object* prototype);
     [[nodiscard]] GCPtr<Shape> get_or_prune_cached_delete_transition(StringOrSymbol const&);
 
+    // The properties of a shape, in offset order. A table can be shared by a shape and the shapes that are reached
+    // from it by put and prototype transitions, as each of them only looks at the first m_property_count entries.
+    // Tables are only appended to while shared; any other change is done on a copy.
+    struct PropertyTable : public RefCounted<PropertyTable> {
+        Vector<Property> properties;
+        HashMap<StringOrSymbol, u32> indices;
+
+        NonnullRefPtr<PropertyTable> copy(u32 property_count) const;
+        void append(StringOrSymbol const&, PropertyAttributes);
+        void remove(StringOrSymbol const&);
+    };
+
     void ensure_property_table() const;
+    void derive_property_table_from_previous_shape() const;
+    PropertyTable& ensure_unshared_property_table();
+
+    template<typename KeyType, typename TransitionsType>
+    [[nodiscard]] static bool can_cache_transition(OwnPtr<TransitionsType>&, KeyType const&);
 
     NonnullGCPtr<Realm> m_realm;
 
-    mutable OwnPtr<OrderedHashMap<StringOrSymbol, PropertyMetadata>> m_property_table;
+    mutable RefPtr<PropertyTable> m_property_table;
 
     OwnPtr<HashMap<TransitionKey, WeakPtr<Shape>>> m_forward_transitions;
     OwnPtr<HashMap<GCPtr<Object>, WeakPtr<Shape>>> m_prototype_transitions;
@@ -143,6 +187,8 @@ private:
     bool m_dictionary : 1 { false };
     bool m_cacheable : 1 { true };
     bool m_is_prototype_shape : 1 { false };
+
+    u8 m_uncached_lookup_count { 0 };
 };
 
 }
@@ -15,6 +15,7 @@
 #include <LibFileSystem/FileSystem.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
@@ -65,6 +66,7 @@ VM::VM(OwnPtr<CustomData> custom_data, ErrorMessages error_messages)
     : m_heap(*this)
     , m_error_messages(move(error_messages))
     , m_custom_data(move(custom_data))
+    , m_program_cache(make<ProgramCache>())
 {
     m_bytecode_interpreter = make<Bytecode::Interpreter>(*this);
 
@@ -201,6 +203,11 @@ Bytecode::Interpreter& VM::bytecode_interpreter()
     return *m_bytecode_interpreter;
 }
 
+ProgramCache& VM::program_cache()
+{
+    return *m_program_cache;
+}
+
 struct ExecutionContextRootsCollector : public Cell::Visitor {
     virtual void visit_impl(Cell& cell) override
     {
@@ -58,6 +58,8 @@ public:
 
     Bytecode::Interpreter& bytecode_interpreter();
 
+    ProgramCache& program_cache();
+
     void dump_backtrace() const;
 
     void gather_roots(HashMap<Cell*, HeapRoot>&);
@@ -349,6 +351,9 @@ private:
 
     OwnPtr<Bytecode::Interpreter> m_bytecode_interpreter;
 
+    // NOTE: This has to be destroyed before the heap, since the cached programs hold handles to their bytecode.
+    NonnullOwnPtr<ProgramCache> m_program_cache;
+
     bool m_dynamic_imports_allowed { false };
 };
 
@@ -9,6 +9,7 @@
 #include <AK/QuickSort.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/AsyncFunctionDriverWrapper.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
@@ -128,13 +129,23 @@ void SourceTextModule::visit_edges(Cell::Visitor& visitor)
 // 16.2.1.6.1 ParseModule ( sourceText, realm, hostDefined ), https://tc39.es/ecma262/#sec-parsemodule
 Result<NonnullGCPtr<SourceTextModule>, Vector<ParserError>> SourceTextModule::parse(StringView source_text, Realm& realm, StringView filename, Script::HostDefined* host_defined)
 {
-    // 1. Let body be ParseText(sourceText, Module).
-    auto parser = Parser(Lexer(source_text, filename), Program::Type::Module);
-    auto body = parser.parse_program();
+    // OPTIMIZATION: Reuse the parse tree (and bytecode) from an earlier load of the same source, if we have one.
+    auto& program_cache = realm.vm().program_cache();
+    auto cached_body = program_cache.get(source_text, filename, Program::Type::Module, 1);
 
-    // 2. If body is a List of errors, return body.
-    if (parser.has_errors())
-        return parser.errors();
+    if (!cached_body) {
+        // 1. Let body be ParseText(sourceText, Module).
+        auto parser = Parser(Lexer(source_text, filename), Program::Type::Module);
+        auto parsed_body = parser.parse_program();
+
+        // 2. If body is a List of errors, return body.
+        if (parser.has_errors())
+            return parser.errors();
+
+        program_cache.set(source_text, 1, parsed_body);
+        cached_body = move(parsed_body);
+    }
+    auto body = cached_body.release_nonnull();
 
     // 3. Let requestedModules be the ModuleRequests of body.
     auto requested_modules = module_requests(*body);
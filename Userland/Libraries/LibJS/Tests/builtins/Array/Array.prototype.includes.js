@@ -26,3 +26,29 @@ test("is unscopable", () => {
         }).toThrowWithMessage(ReferenceError, "'includes' is not defined");
     }
 });
+
+test("numeric arrays", () => {
+    expect([1, 2, 3].includes(2)).toBeTrue();
+    expect([1, 2, 3].includes(2.0)).toBeTrue();
+    expect([1, 2, 3].includes(2.5)).toBeFalse();
+    expect([1, 2, 3].includes("2")).toBeFalse();
+    expect([0, 1].includes(-0)).toBeTrue();
+    expect([1, 2, 3].includes(NaN)).toBeFalse();
+    expect([1.5, NaN, 3].includes(NaN)).toBeTrue();
+    expect([1.5, 2.5, 3].includes(3)).toBeTrue();
+    expect([1, 2, 3].includes(2 ** 40)).toBeFalse();
+});
+
+test("elements that change kind", () => {
+    var array = [1, 2, 3];
+    array[1] = "two";
+    expect(array.includes("two")).toBeTrue();
+    expect(array.includes(2)).toBeFalse();
+
+    array = [1, 2, 3];
+    delete array[1];
+    expect(array.includes(undefined)).toBeTrue();
+    Array.prototype[1] = 2;
+    expect(array.includes(2)).toBeTrue();
+    delete Array.prototype[1];
+});
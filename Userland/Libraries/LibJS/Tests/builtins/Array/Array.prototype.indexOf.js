@@ -23,3 +23,26 @@ test("basic functionality", () => {
     expect([].indexOf()).toBe(-1);
     expect([undefined].indexOf()).toBe(0);
 });
+
+test("numeric arrays", () => {
+    expect([1, 2, 3, 2].indexOf(2)).toBe(1);
+    expect([1, 2, 3, 2].indexOf(2, 2)).toBe(3);
+    expect([1, 2, 3].indexOf(2.0)).toBe(1);
+    expect([1, 2, 3].indexOf("2")).toBe(-1);
+    expect([1.5, NaN, 3].indexOf(NaN)).toBe(-1);
+    expect([1.5, 2.5, -0].indexOf(0)).toBe(2);
+    expect([1, 2, 3].indexOf(3, 5)).toBe(-1);
+});
+
+test("array shrinking while converting fromIndex", () => {
+    var array = [1, 2, 3, 4];
+    Array.prototype[3] = 4;
+    var fromIndex = {
+        valueOf() {
+            array.length = 2;
+            return 0;
+        },
+    };
+    expect(array.indexOf(4, fromIndex)).toBe(3);
+    delete Array.prototype[3];
+});
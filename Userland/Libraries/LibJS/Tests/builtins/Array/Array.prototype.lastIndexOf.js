@@ -20,3 +20,13 @@ test("basic functionality", () => {
     expect([undefined].lastIndexOf()).toBe(0);
     expect([undefined, undefined, undefined].lastIndexOf()).toBe(2);
 });
+
+test("numeric arrays", () => {
+    expect([1, 2, 3, 2].lastIndexOf(2)).toBe(3);
+    expect([1, 2, 3, 2].lastIndexOf(2, 2)).toBe(1);
+    expect([1, 2, 3, 2].lastIndexOf(2, -2)).toBe(1);
+    expect([1, 2, 3, 2].lastIndexOf(1, -5)).toBe(-1);
+    expect([1.5, 2.5, 3].lastIndexOf(1.5)).toBe(0);
+    expect([1, 2, 3].lastIndexOf(null)).toBe(-1);
+    expect(["a", 1, "a"].lastIndexOf("a")).toBe(2);
+});
@@ -0,0 +1,72 @@
+// NOTE: The functions in this file are large enough to be parsed lazily when running with --lazy-function-parsing.
+
+var globalCounter = 0;
+
+function largeFunctionUsingGlobals(amount) {
+    // Padding to make this function large enough to have its body dropped after parsing the whole file.
+    // Padding to make this function large enough to have its body dropped after parsing the whole file.
+    globalCounter += amount;
+    return globalCounter;
+}
+
+function largeFunctionReturningClosures() {
+    let captured = 1;
+    function increment() {
+        // Padding to make this function large enough to have its body dropped after parsing the whole file.
+        // Padding to make this function large enough to have its body dropped after parsing the whole file.
+        return ++captured;
+    }
+    function get() {
+        return captured;
+    }
+    // Padding to make this function large enough to have its body dropped after parsing the whole file.
+    return { increment, get };
+}
+
+function largeFunctionThrowingError() {
+    // Padding to make this function large enough to have its body dropped after parsing the whole file.
+    // Padding to make this function large enough to have its body dropped after parsing the whole file.
+    const error = new Error();
+    return error;
+}
+
+function largeFunctionWithArguments(a, b) {
+    // Padding to make this function large enough to have its body dropped after parsing the whole file.
+    // Padding to make this function large enough to have its body dropped after parsing the whole file.
+    a = 10;
+    return [a, b, arguments.length, arguments[0]];
+}
+
+const largeFunctionInTemplateLiteral = `${(function () {
+    // Padding to make this function large enough to have its body dropped after parsing the whole file.
+    // Padding to make this function large enough to have its body dropped after parsing the whole file.
+    return `inner ${"template"}`;
+})()} done`;
+
+test("globals are resolved", () => {
+    expect(largeFunctionUsingGlobals(2)).toBe(2);
+    expect(largeFunctionUsingGlobals(3)).toBe(5);
+    expect(globalCounter).toBe(5);
+});
+
+test("closures capture variables of outer functions", () => {
+    const { increment, get } = largeFunctionReturningClosures();
+    expect(increment()).toBe(2);
+    expect(increment()).toBe(3);
+    expect(get()).toBe(3);
+});
+
+test("source positions are kept", () => {
+    const [, stackFrame] = largeFunctionThrowingError().stack.trim().split("\n");
+    expect(/function-large-bodies\.js:29:\d+\)?$/.test(stackFrame)).toBeTrue();
+    expect(largeFunctionThrowingError.toString().startsWith("function largeFunctionThrowingError() {")).toBeTrue();
+});
+
+test("parameters and arguments object", () => {
+    expect(largeFunctionWithArguments(1, 2, 3)).toEqual([10, 2, 3, 10]);
+    expect(largeFunctionWithArguments.length).toBe(2);
+});
+
+test("function inside template literal", () => {
+    expect(largeFunctionInTemplateLiteral).toBe("inner template done");
+});
@@ -16,3 +16,85 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Inline cache stays correct when an object is reshaped after deleting properties", () => {
+    // Create an object with an unique shape by adding lots of properties, then delete enough of them for it to fit a regular shape.
+    let o = {};
+    for (let x = 0; x < 80; ++x) {
+        o["prop" + x] = x;
+    }
+    for (let x = 0; x < 40; ++x) {
+        delete o["prop" + x];
+    }
+
+    function ic(o) {
+        return o.prop50;
+    }
+
+    // Look the property up often enough for the object to get a cacheable shape again.
+    for (let i = 0; i < 100; ++i) expect(ic(o)).toBe(50);
+
+    o.extra = "extra";
+    expect(ic(o)).toBe(50);
+    expect(o.prop40).toBe(40);
+    expect(o.prop79).toBe(79);
+    expect(o.extra).toBe("extra");
+    expect(Object.keys(o).length).toBe(41);
+    expect(Object.keys(o)[0]).toBe("prop40");
+
+    delete o.prop40;
+    expect(ic(o)).toBe(50);
+    expect(o.prop79).toBe(79);
+    expect(o.extra).toBe("extra");
+    expect(Object.keys(o)[0]).toBe("prop41");
+
+    delete o.prop50;
+    expect(ic(o)).toBeUndefined();
+});
+
+test("Inline cache stays correct when a prototype is reshaped after deleting properties", () => {
+    let proto = {};
+    for (let x = 0; x < 80; ++x) {
+        proto["prop" + x] = x;
+    }
+    let o = Object.create(proto);
+    delete proto.prop0;
+
+    function ic(o) {
+        return o.prop50;
+    }
+
+    for (let i = 0; i < 100; ++i) expect(ic(o)).toBe(50);
+
+    delete proto.prop1;
+    expect(ic(o)).toBe(50);
+    proto.prop50 = "changed";
+    expect(ic(o)).toBe("changed");
+    o.prop50 = "own";
+    expect(ic(o)).toBe("own");
+    delete o.prop50;
+    delete proto.prop50;
+    expect(ic(o)).toBeUndefined();
+});
+
+test("Objects with many different transitions from the same shape", () => {
+    function ic(o) {
+        return o.base;
+    }
+
+    let objects = [];
+    for (let i = 0; i < 200; ++i) {
+        let o = { base: i };
+        o["key" + i] = i * 2;
+        objects.push(o);
+    }
+
+    for (let i = 0; i < 200; ++i) {
+        expect(ic(objects[i])).toBe(i);
+        expect(objects[i]["key" + i]).toBe(i * 2);
+        expect(Object.keys(objects[i])).toEqual(["base", "key" + i]);
+        delete objects[i].base;
+        expect(ic(objects[i])).toBeUndefined();
+        expect(objects[i]["key" + i]).toBe(i * 2);
+    }
+});
@@ -23,3 +23,45 @@ test("exception in test expression", () => {
         while (foo);
     }).toThrow(ReferenceError);
 });
+
+test("constant truthy condition", () => {
+    let number = 0;
+    while (1) {
+        if (++number === 5) break;
+    }
+    expect(number).toBe(5);
+
+    number = 0;
+    while ("foo") {
+        if (++number === 5) break;
+    }
+    expect(number).toBe(5);
+});
+
+test("does not loop when initially falsy constant", () => {
+    while (0) {
+        expect().fail();
+    }
+    while ("") {
+        expect().fail();
+    }
+    while (null ?? undefined) {
+        expect().fail();
+    }
+});
+
+test("break and continue through nested loops and finally", () => {
+    let log = [];
+    outer: while (true) {
+        while (true) {
+            try {
+                log.push("try");
+                continue outer;
+            } finally {
+                log.push("finally");
+                if (log.length > 4) break outer;
+            }
+        }
+    }
+    expect(log).toEqual(["try", "finally", "try", "finally", "try", "finally"]);
+});
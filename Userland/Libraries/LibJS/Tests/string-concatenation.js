@@ -28,3 +28,40 @@ test("adding strings with dangling surrogates", () => {
     expect("\ud834a" + "\udf06").toBe("\ud834a\udf06");
     expect("\ud834" + "a\udf06").toBe("\ud834a\udf06");
 });
+
+test("building long strings piece by piece", () => {
+    let html = "";
+    let expected = [];
+    let expectedLength = 0;
+    for (let i = 0; i < 2000; ++i) {
+        html += "<td>" + i + "</td>";
+        expected.push(`<td>${i}</td>`);
+        expectedLength += expected[i].length;
+        expect(html.length).toBe(expectedLength);
+    }
+    expect(html).toBe(expected.join(""));
+
+    let prepended = "";
+    for (let i = 0; i < 2000; ++i) prepended = i + "," + prepended;
+    expect(prepended.split(",")).toHaveLength(2001);
+    expect(prepended.startsWith("1999,1998,")).toBeTrue();
+});
+
+test("appending to a string keeps the original intact", () => {
+    let base = "x".repeat(100) + "y".repeat(100) + "short";
+    let first = base + "a";
+    let second = base + "b";
+    expect(base).toBe("x".repeat(100) + "y".repeat(100) + "short");
+    expect(first).toBe(base + "a");
+    expect(second).toBe(base + "b");
+    expect(first === second).toBeFalse();
+    expect(first.length).toBe(206);
+});
+
+test("surrogate pairs spread across rope pieces", () => {
+    let string = "a".repeat(100);
+    for (let i = 0; i < 100; ++i) string = string + "\ud834" + "\udf06";
+    expect(string.length).toBe(300);
+    expect(string.codePointAt(100)).toBe(0x1d306);
+    expect(string).toBe("a".repeat(100) + "𝌆".repeat(100));
+});
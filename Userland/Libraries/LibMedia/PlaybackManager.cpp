@@ -133,8 +133,30 @@ void PlaybackManager::dispatch_decoder_error(DecoderError error)
 
 void PlaybackManager::dispatch_new_frame(RefPtr<Gfx::Bitmap> frame)
 {
+    auto previous_frame = exchange(m_last_dispatched_frame, frame);
     if (on_video_frame)
         on_video_frame(move(frame));
+
+    // If nobody is holding on to the frame that was shown before this one anymore, its bitmap can be used for another one.
+    // The frames are only passed around on this thread, so nobody can take a new reference to it while we look.
+    if (previous_frame && previous_frame->ref_count() == 1) {
+        Threading::MutexLocker locker(m_recycled_frame_bitmaps_mutex);
+        if (m_recycled_frame_bitmaps.size() < max_recycled_frame_bitmap_count)
+            m_recycled_frame_bitmaps.append(previous_frame.release_nonnull());
+    }
+}
+
+DecoderErrorOr<NonnullRefPtr<Gfx::Bitmap>> PlaybackManager::take_or_create_frame_bitmap(Gfx::IntSize size)
+{
+    {
+        Threading::MutexLocker locker(m_recycled_frame_bitmaps_mutex);
+        while (!m_recycled_frame_bitmaps.is_empty()) {
+            auto bitmap = m_recycled_frame_bitmaps.take_last();
+            if (bitmap->size() == size)
+                return bitmap;
+        }
+    }
+    return DECODER_TRY_ALLOC(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, size));
 }
 
 bool PlaybackManager::dispatch_frame_queue_item(FrameQueueItem&& item)
@@ -266,7 +288,11 @@ void PlaybackManager::decode_and_queue_one_sample()
                 break;
             }
 
-            auto bitmap_result = decoded_frame->to_bitmap();
+            auto bitmap_result = [&]() -> DecoderErrorOr<NonnullRefPtr<Gfx::Bitmap>> {
+                auto bitmap = TRY(take_or_create_frame_bitmap(decoded_frame->size().to_type<int>()));
+                TRY(decoded_frame->output_to_bitmap(bitmap));
+                return bitmap;
+            }();
 
             if (bitmap_result.is_error())
                 item_to_enqueue = FrameQueueItem::error_marker(bitmap_result.release_error(), decoded_frame->timestamp());
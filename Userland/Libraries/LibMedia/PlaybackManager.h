@@ -168,6 +168,8 @@ private:
 
     void dispatch_decoder_error(DecoderError error);
     void dispatch_new_frame(RefPtr<Gfx::Bitmap> frame);
+    // Called on the decode thread.
+    DecoderErrorOr<NonnullRefPtr<Gfx::Bitmap>> take_or_create_frame_bitmap(Gfx::IntSize);
     // Returns whether we changed playback states. If so, any PlaybackStateHandler processing must cease.
     [[nodiscard]] bool dispatch_frame_queue_item(FrameQueueItem&&);
     void dispatch_state_change();
@@ -196,6 +198,12 @@ private:
 
     u64 m_skipped_frames { 0 };
 
+    // The bitmaps of frames that have been replaced by newer ones, which the decode thread can convert new frames into.
+    static constexpr size_t max_recycled_frame_bitmap_count = 2;
+    RefPtr<Gfx::Bitmap> m_last_dispatched_frame;
+    Threading::Mutex m_recycled_frame_bitmaps_mutex;
+    Vector<NonnullRefPtr<Gfx::Bitmap>, max_recycled_frame_bitmap_count> m_recycled_frame_bitmaps;
+
     // This is a nested class to allow private access.
     class PlaybackStateHandler {
     public:
@@ -165,18 +165,22 @@ DecoderErrorOr<void> Decoder::create_video_frame(Duration timestamp, FrameContex
         timestamp,
         { output_y_size.width(), output_y_size.height() },
         frame_context.color_config.bit_depth, get_cicp_color_space(frame_context),
-        subsampling));
-    for (u32 plane = 0; plane < 3; plane++) {
+        subsampling, m_frame_plane_pool));
+    // The planes are independent of each other, so they can be converted at the same time.
+    TRY(m_parser->run_in_parallel(3, [&](u32 plane) -> DecoderErrorOr<void> {
         auto* buffer = frame->get_plane_data<T>(plane);
         auto decoded_width = plane == 0 ? decoded_y_width : decoded_uv_width;
         auto output_size = plane == 0 ? output_y_size : output_uv_size;
         auto const* decoded_buffer = get_output_buffer(plane).data();
 
         for (u32 row = 0; row < output_size.height(); row++) {
+            auto const* decoded_row = decoded_buffer + row * decoded_width;
+            auto* output_row = buffer + row * output_size.width();
             for (u32 column = 0; column < output_size.width(); column++)
-                buffer[row * output_size.width() + column] = static_cast<T>(decoded_buffer[row * decoded_width + column]);
+                output_row[column] = static_cast<T>(decoded_row[column]);
         }
-    }
+        return {};
+    }));
 
     m_video_frame_queue.enqueue(move(frame));
 
@@ -1916,72 +1920,84 @@ DecoderErrorOr<void> Decoder::update_reference_frames(FrameContext const& frame_
 
     // 1. For each value of i from 0 to NUM_REF_FRAMES - 1, the following applies if bit i of refresh_frame_flags
     // is equal to 1 (i.e. if (refresh_frame_flags>>i)&1 is equal to 1):
+    Vector<u8, NUM_REF_FRAMES> refreshed_indices;
     for (u8 i = 0; i < NUM_REF_FRAMES; i++) {
-        if (frame_context.should_update_reference_frame_at_index(i)) {
-            auto& reference_frame = m_parser->m_reference_frames[i];
-
-            // − RefFrameWidth[ i ] is set equal to FrameWidth.
-            // − RefFrameHeight[ i ] is set equal to FrameHeight.
-            reference_frame.size = frame_context.size();
-            // − RefSubsamplingX[ i ] is set equal to subsampling_x.
-            reference_frame.subsampling_x = frame_context.color_config.subsampling_x;
-            // − RefSubsamplingY[ i ] is set equal to subsampling_y.
-            reference_frame.subsampling_y = frame_context.color_config.subsampling_y;
-            // − RefBitDepth[ i ] is set equal to BitDepth.
-            reference_frame.bit_depth = frame_context.color_config.bit_depth;
-
-            // − FrameStore[ i ][ 0 ][ y ][ x ] is set equal to CurrFrame[ 0 ][ y ][ x ] for x = 0..FrameWidth-1, for y =
-            // 0..FrameHeight-1.
-            // − FrameStore[ i ][ plane ][ y ][ x ] is set equal to CurrFrame[ plane ][ y ][ x ] for plane = 1..2, for x =
-            // 0..((FrameWidth+subsampling_x) >> subsampling_x)-1, for y = 0..((FrameHeight+subsampling_y) >>
-            // subsampling_y)-1.
-
-            // FIXME: Frame width is not equal to the buffer's stride. If we store the stride of the buffer with the reference
-            //        frame, we can just copy the framebuffer data instead. Alternatively, we should crop the output framebuffer.
-            for (auto plane = 0u; plane < 3; plane++) {
-                auto width = frame_context.size().width();
-                auto height = frame_context.size().height();
-                auto stride = frame_context.decoded_size(plane > 0).width();
-                if (plane > 0) {
-                    width = Subsampling::subsampled_size(frame_context.color_config.subsampling_x, width);
-                    height = Subsampling::subsampled_size(frame_context.color_config.subsampling_y, height);
-                }
+        if (!frame_context.should_update_reference_frame_at_index(i))
+            continue;
+        refreshed_indices.append(i);
+        auto& reference_frame = m_parser->m_reference_frames[i];
+
+        // − RefFrameWidth[ i ] is set equal to FrameWidth.
+        // − RefFrameHeight[ i ] is set equal to FrameHeight.
+        reference_frame.size = frame_context.size();
+        // − RefSubsamplingX[ i ] is set equal to subsampling_x.
+        reference_frame.subsampling_x = frame_context.color_config.subsampling_x;
+        // − RefSubsamplingY[ i ] is set equal to subsampling_y.
+        reference_frame.subsampling_y = frame_context.color_config.subsampling_y;
+        // − RefBitDepth[ i ] is set equal to BitDepth.
+        reference_frame.bit_depth = frame_context.color_config.bit_depth;
+    }
 
-                auto const& original_buffer = get_output_buffer(plane);
-                auto& frame_store_buffer = reference_frame.frame_planes[plane];
-                auto frame_store_width = width + MV_BORDER * 2;
-                auto frame_store_height = height + MV_BORDER * 2;
-                frame_store_buffer.resize_and_keep_capacity(frame_store_width * frame_store_height);
-
-                VERIFY(original_buffer.size() >= width * height);
-                for (auto destination_y = 0u; destination_y < frame_store_height; destination_y++) {
-                    // Offset the source row by the motion vector border and then clamp it to the range of 0...height.
-                    // This will create an extended border on the top and bottom of the reference frame to avoid having to bounds check
-                    // inter-prediction.
-                    auto source_y = min(destination_y >= MV_BORDER ? destination_y - MV_BORDER : 0, height - 1);
-                    auto const* source = &original_buffer[source_y * stride];
-                    auto* destination = &frame_store_buffer[destination_y * frame_store_width + MV_BORDER];
-                    AK::TypedTransfer<RemoveReference<decltype(*destination)>>::copy(destination, source, width);
-                }
+    // − FrameStore[ i ][ 0 ][ y ][ x ] is set equal to CurrFrame[ 0 ][ y ][ x ] for x = 0..FrameWidth-1, for y =
+    // 0..FrameHeight-1.
+    // − FrameStore[ i ][ plane ][ y ][ x ] is set equal to CurrFrame[ plane ][ y ][ x ] for plane = 1..2, for x =
+    // 0..((FrameWidth+subsampling_x) >> subsampling_x)-1, for y = 0..((FrameHeight+subsampling_y) >>
+    // subsampling_y)-1.
+    // Every refreshed frame store gets the same samples, so we only build the bordered planes for the first one, and
+    // copy those to the others. Key frames refresh all of them.
+    auto update_frame_store_plane = [&](u32 plane) -> DecoderErrorOr<void> {
+        // FIXME: Frame width is not equal to the buffer's stride. If we store the stride of the buffer with the reference
+        //        frame, we can just copy the framebuffer data instead. Alternatively, we should crop the output framebuffer.
+        auto width = frame_context.size().width();
+        auto height = frame_context.size().height();
+        auto stride = frame_context.decoded_size(plane > 0).width();
+        if (plane > 0) {
+            width = Subsampling::subsampled_size(frame_context.color_config.subsampling_x, width);
+            height = Subsampling::subsampled_size(frame_context.color_config.subsampling_y, height);
+        }
 
-                for (auto destination_y = 0u; destination_y < frame_store_height; destination_y++) {
-                    // Stretch the leftmost samples out into the border.
-                    auto sample = frame_store_buffer[destination_y * frame_store_width + MV_BORDER];
+        auto const& original_buffer = get_output_buffer(plane);
+        auto& frame_store_buffer = m_parser->m_reference_frames[refreshed_indices.first()].frame_planes[plane];
+        auto frame_store_width = width + MV_BORDER * 2;
+        auto frame_store_height = height + MV_BORDER * 2;
+        DECODER_TRY_ALLOC(frame_store_buffer.try_resize_and_keep_capacity(frame_store_width * frame_store_height));
+
+        VERIFY(original_buffer.size() >= width * height);
+        for (auto destination_y = 0u; destination_y < frame_store_height; destination_y++) {
+            // Offset the source row by the motion vector border and then clamp it to the range of 0...height.
+            // This will create an extended border on the top and bottom of the reference frame to avoid having to bounds check
+            // inter-prediction.
+            auto source_y = min(destination_y >= MV_BORDER ? destination_y - MV_BORDER : 0, height - 1);
+            auto const* source = &original_buffer[source_y * stride];
+            auto* destination = &frame_store_buffer[destination_y * frame_store_width + MV_BORDER];
+            AK::TypedTransfer<RemoveReference<decltype(*destination)>>::copy(destination, source, width);
+        }
 
-                    for (auto destination_x = 0u; destination_x < MV_BORDER; destination_x++) {
-                        frame_store_buffer[destination_y * frame_store_width + destination_x] = sample;
-                    }
+        for (auto destination_y = 0u; destination_y < frame_store_height; destination_y++) {
+            // Stretch the leftmost samples out into the border.
+            auto sample = frame_store_buffer[destination_y * frame_store_width + MV_BORDER];
 
-                    // Stretch the rightmost samples out into the border.
-                    sample = frame_store_buffer[destination_y * frame_store_width + MV_BORDER + width - 1];
+            for (auto destination_x = 0u; destination_x < MV_BORDER; destination_x++) {
+                frame_store_buffer[destination_y * frame_store_width + destination_x] = sample;
+            }
 
-                    for (auto destination_x = MV_BORDER + width; destination_x < frame_store_width; destination_x++) {
-                        frame_store_buffer[destination_y * frame_store_width + destination_x] = sample;
-                    }
-                }
+            // Stretch the rightmost samples out into the border.
+            sample = frame_store_buffer[destination_y * frame_store_width + MV_BORDER + width - 1];
+
+            for (auto destination_x = MV_BORDER + width; destination_x < frame_store_width; destination_x++) {
+                frame_store_buffer[destination_y * frame_store_width + destination_x] = sample;
             }
         }
-    }
+
+        for (auto index : refreshed_indices.span().slice(1)) {
+            auto& other_frame_store_buffer = m_parser->m_reference_frames[index].frame_planes[plane];
+            DECODER_TRY_ALLOC(other_frame_store_buffer.try_resize_and_keep_capacity(frame_store_buffer.size()));
+            AK::TypedTransfer<u16>::copy(other_frame_store_buffer.data(), frame_store_buffer.data(), frame_store_buffer.size());
+        }
+        return {};
+    };
+    if (!refreshed_indices.is_empty())
+        TRY(m_parser->run_in_parallel(3, move(update_frame_store_plane)));
 
     // 2. If show_existing_frame is equal to 0, the following applies:
     if (!frame_context.shows_existing_frame()) {
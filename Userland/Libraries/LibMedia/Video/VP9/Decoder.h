@@ -148,6 +148,7 @@ private:
     Vector<u16> m_output_buffers[3];
 
     Queue<NonnullOwnPtr<VideoFrame>, 1> m_video_frame_queue;
+    NonnullRefPtr<VideoFramePlanePool> m_frame_plane_pool { VideoFramePlanePool::create() };
 };
 
 }
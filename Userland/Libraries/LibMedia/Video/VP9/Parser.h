@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Array.h>
+#include <AK/Function.h>
 #include <AK/OwnPtr.h>
 #include <AK/Span.h>
 #include <LibGfx/Size.h>
@@ -91,6 +92,9 @@ private:
     u8 update_mv_prob(BooleanDecoder&, u8 prob);
 
     /* (6.4) Decode Tiles Syntax */
+    // Runs the task once for each index, spread over the worker threads and this thread. Returns the first error.
+    DecoderErrorOr<void> run_in_parallel(u32 task_count, Function<DecoderErrorOr<void>(u32 task_index)> const& task);
+
     DecoderErrorOr<void> decode_tiles(FrameContext&);
     DecoderErrorOr<void> decode_tile(TileContext&);
     void clear_left_context(TileContext&);
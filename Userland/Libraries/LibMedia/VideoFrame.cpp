@@ -12,31 +12,78 @@
 
 namespace Media {
 
+static ErrorOr<u8*> allocate_plane_buffer(size_t alignment, size_t size)
+{
+    void* buffer = nullptr;
+    auto result = posix_memalign(&buffer, alignment, size);
+    if (result != 0)
+        return Error::from_errno(result);
+    return reinterpret_cast<u8*>(buffer);
+}
+
+VideoFramePlanePool::~VideoFramePlanePool()
+{
+    for (auto& buffer : m_buffers)
+        free(buffer.data);
+}
+
+ErrorOr<u8*> VideoFramePlanePool::take_or_allocate(size_t size)
+{
+    {
+        Threading::MutexLocker locker(m_mutex);
+        for (size_t i = 0; i < m_buffers.size(); i++) {
+            if (m_buffers[i].size == size)
+                return m_buffers.take(i).data;
+        }
+    }
+    return allocate_plane_buffer(buffer_alignment, size);
+}
+
+void VideoFramePlanePool::give_back(u8* buffer, size_t size)
+{
+    {
+        Threading::MutexLocker locker(m_mutex);
+        if (m_buffers.size() < max_buffer_count) {
+            m_buffers.append({ buffer, size });
+            return;
+        }
+    }
+    free(buffer);
+}
+
+size_t SubsampledYUVFrame::y_data_size(Gfx::Size<u32> size, u8 bit_depth)
+{
+    size_t component_size = bit_depth > 8 ? sizeof(u16) : sizeof(u8);
+    return size.to_type<size_t>().area() * component_size;
+}
+
+size_t SubsampledYUVFrame::uv_data_size(Gfx::Size<u32> size, u8 bit_depth, Subsampling subsampling)
+{
+    size_t component_size = bit_depth > 8 ? sizeof(u16) : sizeof(u8);
+    return subsampling.subsampled_size(size).to_type<size_t>().area() * component_size;
+}
+
 ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create(
     Duration timestamp,
     Gfx::Size<u32> size,
     u8 bit_depth, CodingIndependentCodePoints cicp,
-    Subsampling subsampling)
+    Subsampling subsampling,
+    RefPtr<VideoFramePlanePool> plane_pool)
 {
     VERIFY(bit_depth < 16);
-    size_t component_size = bit_depth > 8 ? sizeof(u16) : sizeof(u8);
     size_t alignment_size = max(bit_depth > 8 ? sizeof(u16) : sizeof(u8), sizeof(void*));
 
     auto alloc_buffer = [&](size_t size) -> ErrorOr<u8*> {
-        void* buffer = nullptr;
-        auto result = posix_memalign(&buffer, alignment_size, size);
-        if (result != 0)
-            return Error::from_errno(result);
-        return reinterpret_cast<u8*>(buffer);
+        if (plane_pool)
+            return plane_pool->take_or_allocate(size);
+        return allocate_plane_buffer(alignment_size, size);
     };
 
-    auto y_data_size = size.to_type<size_t>().area() * component_size;
-    auto uv_data_size = subsampling.subsampled_size(size).to_type<size_t>().area() * component_size;
-    auto* y_buffer = TRY(alloc_buffer(y_data_size));
-    auto* u_buffer = TRY(alloc_buffer(uv_data_size));
-    auto* v_buffer = TRY(alloc_buffer(uv_data_size));
+    auto* y_buffer = TRY(alloc_buffer(y_data_size(size, bit_depth)));
+    auto* u_buffer = TRY(alloc_buffer(uv_data_size(size, bit_depth, subsampling)));
+    auto* v_buffer = TRY(alloc_buffer(uv_data_size(size, bit_depth, subsampling)));
 
-    return adopt_nonnull_own_or_enomem(new (nothrow) SubsampledYUVFrame(timestamp, size, bit_depth, cicp, subsampling, y_buffer, u_buffer, v_buffer));
+    return adopt_nonnull_own_or_enomem(new (nothrow) SubsampledYUVFrame(timestamp, size, bit_depth, cicp, subsampling, y_buffer, u_buffer, v_buffer, move(plane_pool)));
 }
 
 ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create_from_data(
@@ -48,25 +95,31 @@ ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> SubsampledYUVFrame::try_create_from_d
 {
     auto frame = TRY(try_create(timestamp, size, bit_depth, cicp, subsampling));
 
-    size_t component_size = bit_depth > 8 ? sizeof(u16) : sizeof(u8);
-    auto y_data_size = size.to_type<size_t>().area() * component_size;
-    auto uv_data_size = subsampling.subsampled_size(size).to_type<size_t>().area() * component_size;
+    auto y_size = y_data_size(size, bit_depth);
+    auto uv_size = uv_data_size(size, bit_depth, subsampling);
 
-    VERIFY(y_data.size() >= y_data_size);
-    VERIFY(u_data.size() >= uv_data_size);
-    VERIFY(v_data.size() >= uv_data_size);
+    VERIFY(y_data.size() >= y_size);
+    VERIFY(u_data.size() >= uv_size);
+    VERIFY(v_data.size() >= uv_size);
 
-    memcpy(frame->m_y_buffer, y_data.data(), y_data_size);
-    memcpy(frame->m_u_buffer, u_data.data(), uv_data_size);
-    memcpy(frame->m_v_buffer, v_data.data(), uv_data_size);
+    memcpy(frame->m_y_buffer, y_data.data(), y_size);
+    memcpy(frame->m_u_buffer, u_data.data(), uv_size);
+    memcpy(frame->m_v_buffer, v_data.data(), uv_size);
     return frame;
 }
 
 SubsampledYUVFrame::~SubsampledYUVFrame()
 {
-    free(m_y_buffer);
-    free(m_u_buffer);
-    free(m_v_buffer);
+    if (!m_plane_pool) {
+        free(m_y_buffer);
+        free(m_u_buffer);
+        free(m_v_buffer);
+        return;
+    }
+
+    m_plane_pool->give_back(m_y_buffer, y_data_size(size(), bit_depth()));
+    m_plane_pool->give_back(m_u_buffer, uv_data_size(size(), bit_depth(), m_subsampling));
+    m_plane_pool->give_back(m_v_buffer, uv_data_size(size(), bit_depth(), m_subsampling));
 }
 
 template<u32 subsampling_horizontal, typename T>
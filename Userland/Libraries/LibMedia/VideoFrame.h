@@ -6,12 +6,14 @@
 
 #pragma once
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/ByteBuffer.h>
 #include <AK/FixedArray.h>
 #include <AK/Time.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Size.h>
 #include <LibMedia/Color/CodingIndependentCodePoints.h>
+#include <LibThreading/Mutex.h>
 
 #include "DecoderError.h"
 #include "Subsampling.h"
@@ -57,6 +59,32 @@ protected:
     CodingIndependentCodePoints m_cicp;
 };
 
+// Keeps the plane buffers of frames that were destroyed, so that the next frames of the same size don't have to allocate
+// new ones. The frames keep the pool alive, and may be destroyed on any thread.
+class VideoFramePlanePool : public AtomicRefCounted<VideoFramePlanePool> {
+public:
+    static NonnullRefPtr<VideoFramePlanePool> create() { return adopt_ref(*new VideoFramePlanePool); }
+    ~VideoFramePlanePool();
+
+    ErrorOr<u8*> take_or_allocate(size_t size);
+    void give_back(u8* buffer, size_t size);
+
+private:
+    VideoFramePlanePool() = default;
+
+    // Enough for the planes of the frames in the decoder and the playback queue.
+    static constexpr size_t max_buffer_count = 18;
+    static constexpr size_t buffer_alignment = 64;
+
+    struct Buffer {
+        u8* data { nullptr };
+        size_t size { 0 };
+    };
+
+    Threading::Mutex m_mutex;
+    Vector<Buffer, max_buffer_count> m_buffers;
+};
+
 class SubsampledYUVFrame : public VideoFrame {
 
 public:
@@ -64,7 +92,8 @@ public:
         Duration timestamp,
         Gfx::Size<u32> size,
         u8 bit_depth, CodingIndependentCodePoints cicp,
-        Subsampling subsampling);
+        Subsampling subsampling,
+        RefPtr<VideoFramePlanePool> plane_pool = nullptr);
 
     static ErrorOr<NonnullOwnPtr<SubsampledYUVFrame>> try_create_from_data(
         Duration timestamp,
@@ -78,12 +107,14 @@ public:
         Gfx::Size<u32> size,
         u8 bit_depth, CodingIndependentCodePoints cicp,
         Subsampling subsampling,
-        u8* plane_y_data, u8* plane_u_data, u8* plane_v_data)
+        u8* plane_y_data, u8* plane_u_data, u8* plane_v_data,
+        RefPtr<VideoFramePlanePool> plane_pool = nullptr)
         : VideoFrame(timestamp, size, bit_depth, cicp)
         , m_subsampling(subsampling)
         , m_y_buffer(plane_y_data)
         , m_u_buffer(plane_u_data)
         , m_v_buffer(plane_v_data)
+        , m_plane_pool(move(plane_pool))
     {
         VERIFY(m_y_buffer != nullptr);
         VERIFY(m_u_buffer != nullptr);
@@ -115,10 +146,15 @@ public:
     }
 
 protected:
+    static size_t y_data_size(Gfx::Size<u32> size, u8 bit_depth);
+    static size_t uv_data_size(Gfx::Size<u32> size, u8 bit_depth, Subsampling);
+
     Subsampling m_subsampling;
     u8* m_y_buffer = nullptr;
     u8* m_u_buffer = nullptr;
     u8* m_v_buffer = nullptr;
+    // If set, the planes came from this pool and are given back to it.
+    RefPtr<VideoFramePlanePool> m_plane_pool;
 };
 
 }
@@ -176,6 +176,14 @@ Vector<float> DeviceCMYKColorSpace::default_decode() const
     return { 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 1.0f };
 }
 
+RefPtr<Gfx::ICC::ColorTransform> DeviceCMYKColorSpace::image_color_transform() const
+{
+    auto transform_or_error = Gfx::ICC::ColorTransform::for_profiles(*s_default_cmyk_profile, ICCBasedColorSpace::sRGB());
+    if (transform_or_error.is_error())
+        return nullptr;
+    return transform_or_error.release_value();
+}
+
 PDFErrorOr<NonnullRefPtr<DeviceNColorSpace>> DeviceNColorSpace::create(Document* document, Vector<Value>&& parameters, Renderer& renderer)
 {
     // "[ /DeviceN names alternateSpace tintTransform ]
@@ -574,6 +582,18 @@ Vector<float> ICCBasedColorSpace::default_decode() const
     }
 }
 
+RefPtr<Gfx::ICC::ColorTransform> ICCBasedColorSpace::image_color_transform() const
+{
+    // CIELAB values need rescaling in style(), and matrix-based profiles are cheap enough to convert exactly.
+    if (m_profile->data_color_space() == Gfx::ICC::ColorSpace::CIELAB || m_map.has_value())
+        return nullptr;
+
+    auto transform_or_error = Gfx::ICC::ColorTransform::for_profiles(m_profile, sRGB());
+    if (transform_or_error.is_error())
+        return nullptr;
+    return transform_or_error.release_value();
+}
+
 NonnullRefPtr<Gfx::ICC::Profile> ICCBasedColorSpace::sRGB()
 {
     if (!s_srgb_profile)
@@ -9,6 +9,7 @@
 #include <AK/DeprecatedFlyString.h>
 #include <AK/Forward.h>
 #include <LibGfx/Color.h>
+#include <LibGfx/ICC/ColorTransform.h>
 #include <LibGfx/ICC/Profile.h>
 #include <LibGfx/PaintStyle.h>
 #include <LibPDF/Function.h>
@@ -71,6 +72,10 @@ public:
     virtual int number_of_components() const = 0;
     virtual Vector<float> default_decode() const = 0; // "TABLE 4.40 Default Decode arrays"
     virtual ColorSpaceFamily const& family() const = 0;
+
+    // For images with 8-bit components and the default decode array, this converts whole rows at once.
+    // Returns null if the color space needs its colors converted one by one.
+    virtual RefPtr<Gfx::ICC::ColorTransform> image_color_transform() const { return nullptr; }
 };
 
 class ColorSpaceWithFloatArgs : public ColorSpace {
@@ -126,6 +131,7 @@ public:
     int number_of_components() const override { return 4; }
     Vector<float> default_decode() const override;
     ColorSpaceFamily const& family() const override { return ColorSpaceFamily::DeviceCMYK; }
+    RefPtr<Gfx::ICC::ColorTransform> image_color_transform() const override;
 
 private:
     DeviceCMYKColorSpace() = default;
@@ -200,6 +206,7 @@ public:
     int number_of_components() const override;
     Vector<float> default_decode() const override;
     ColorSpaceFamily const& family() const override { return ColorSpaceFamily::ICCBased; }
+    RefPtr<Gfx::ICC::ColorTransform> image_color_transform() const override;
 
     static NonnullRefPtr<Gfx::ICC::Profile> sRGB();
 
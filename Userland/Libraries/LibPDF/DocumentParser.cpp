@@ -591,9 +591,13 @@ PDFErrorOr<NonnullRefPtr<DictObject>> DocumentParser::parse_file_trailer()
     return parse_dict();
 }
 
-PDFErrorOr<Value> DocumentParser::parse_compressed_object_with_index(u32 index)
+PDFErrorOr<DocumentParser::ObjectStream*> DocumentParser::get_or_load_object_stream(u32 object_stream_index)
 {
-    auto object_stream_index = m_xref_table->object_stream_for_object(index);
+    if (auto it = m_object_stream_cache.find(object_stream_index); it != m_object_stream_cache.end()) {
+        it->value.last_use = ++m_object_stream_use_counter;
+        return &it->value;
+    }
+
     auto stream_offset = m_xref_table->byte_offset_for_object(object_stream_index);
 
     m_reader.move_to(stream_offset);
@@ -618,16 +622,48 @@ PDFErrorOr<Value> DocumentParser::parse_compressed_object_with_index(u32 index)
     // The data was already decrypted when reading the outer compressed ObjStm.
     stream_parser.set_encryption_enabled(false);
 
+    HashMap<u32, u32> object_offsets;
+    TRY(object_offsets.try_ensure_capacity(object_count));
     for (u32 i = 0; i < object_count; ++i) {
         auto object_number = TRY(stream_parser.parse_number());
         auto object_offset = TRY(stream_parser.parse_number());
+        object_offsets.set(object_number.get_u32(), first_object_offset + object_offset.get_u32());
+    }
 
-        if (object_number.get_u32() == index) {
-            stream_parser.move_to(first_object_offset + object_offset.get_u32());
-            break;
+    // Make room for the new stream by dropping the ones that haven't been used for the longest time.
+    while (!m_object_stream_cache.is_empty() && m_object_stream_cache_size + stream->bytes().size() > max_object_stream_cache_size) {
+        auto least_recently_used = m_object_stream_cache.begin();
+        for (auto it = m_object_stream_cache.begin(); it != m_object_stream_cache.end(); ++it) {
+            if (it->value.last_use < least_recently_used->value.last_use)
+                least_recently_used = it;
         }
+        m_object_stream_cache_size -= least_recently_used->value.stream->bytes().size();
+        m_object_stream_cache.remove(least_recently_used);
     }
 
+    m_object_stream_cache_size += stream->bytes().size();
+    m_object_stream_cache.set(object_stream_index, { move(stream), move(object_offsets), ++m_object_stream_use_counter });
+    return &m_object_stream_cache.find(object_stream_index)->value;
+}
+
+PDFErrorOr<Value> DocumentParser::parse_compressed_object_with_index(u32 index)
+{
+    auto object_stream_index = m_xref_table->object_stream_for_object(index);
+    auto* object_stream = TRY(get_or_load_object_stream(object_stream_index));
+
+    auto object_offset = object_stream->object_offsets.get(index);
+    if (!object_offset.has_value())
+        return error("Object is missing from its object stream");
+
+    // Parsing the object can load other object streams, which might evict this one from the cache.
+    auto stream = object_stream->stream;
+
+    Parser stream_parser(m_document, stream->bytes());
+
+    // The data was already decrypted when reading the outer compressed ObjStm.
+    stream_parser.set_encryption_enabled(false);
+    stream_parser.move_to(object_offset.value());
+
     stream_parser.push_reference({ index, 0 });
     stream_parser.consume_whitespace();
     auto value = TRY(stream_parser.parse_value());
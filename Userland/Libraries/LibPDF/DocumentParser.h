@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <LibPDF/Parser.h>
 
 namespace PDF {
@@ -97,11 +98,27 @@ private:
     PDFErrorOr<NonnullRefPtr<DictObject>> parse_file_trailer();
     PDFErrorOr<Value> parse_compressed_object_with_index(u32 index);
 
+    // An object stream (PDF 1.7 spec, 3.4.6 "Object Streams") holds many small objects in a single compressed stream.
+    // Decompressing it and reading its table of contents is much more expensive than parsing one of its objects, so the
+    // most recently used ones are kept around until their decompressed size adds up to max_object_stream_cache_size.
+    struct ObjectStream {
+        NonnullRefPtr<StreamObject> stream;
+        // Maps object numbers to their offset in the decompressed stream.
+        HashMap<u32, u32> object_offsets;
+        u64 last_use { 0 };
+    };
+    static constexpr size_t max_object_stream_cache_size = 16 * MiB;
+    PDFErrorOr<ObjectStream*> get_or_load_object_stream(u32 object_stream_index);
+
     bool navigate_to_before_eof_marker();
     bool navigate_to_after_startxref();
 
     RefPtr<XRefTable> m_xref_table;
     Optional<LinearizationDictionary> m_linearization_dictionary;
+
+    HashMap<u32, ObjectStream> m_object_stream_cache;
+    size_t m_object_stream_cache_size { 0 };
+    u64 m_object_stream_use_counter { 0 };
 };
 
 }
@@ -1652,6 +1652,18 @@ PDFErrorOr<Renderer::LoadedImage> Renderer::load_image(NonnullRefPtr<StreamObjec
         bits_per_component = 8;
     }
 
+    // Fast path for images whose samples map straight to a color transform, e.g. photos in CMYK.
+    // Creating the transform costs about as much as converting its grid points one by one, so it's only used for larger images.
+    if (decode_array == color_space->default_decode() && static_cast<size_t>(width) * height > Gfx::ICC::ColorTransform::number_of_grid_points(n_components)) {
+        auto const bytes_per_row = static_cast<size_t>(width) * n_components;
+        if (auto transform = color_space->image_color_transform(); transform && transform->number_of_input_channels() == static_cast<size_t>(n_components) && content.size() >= bytes_per_row * height) {
+            auto bitmap = TRY(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, { width, height }));
+            for (int y = 0; y < height; ++y)
+                transform->convert_bytes_row({ bitmap->scanline(y), static_cast<size_t>(width) }, content.slice(y * bytes_per_row, bytes_per_row));
+            return LoadedImage { bitmap, is_image_mask };
+        }
+    }
+
     Vector<LinearInterpolation1D> component_value_decoders;
     component_value_decoders.ensure_capacity(decode_array.size());
     for (size_t i = 0; i < decode_array.size(); i += 2) {
@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/HashTable.h>
+#include <AK/QuickSort.h>
+#include <AK/Utf16View.h>
+#include <LibRegex/RegexLazyDFA.h>
+
+namespace regex {
+
+static constexpr u64 make_position(size_t instruction_position, size_t string_index)
+{
+    return (static_cast<u64>(instruction_position) << 32) | string_index;
+}
+
+static constexpr size_t instruction_position_of(u64 position)
+{
+    return position >> 32;
+}
+
+static constexpr size_t string_index_of(u64 position)
+{
+    return position & 0xffffffff;
+}
+
+// Compares with a single string argument consume one character of the string at a time,
+// all other compares consume a single character.
+static Optional<ByteCodeValueType> string_length_of_compare(ByteCode const& bytecode, size_t instruction_position)
+{
+    if (bytecode.at(instruction_position + 1) != 1)
+        return {};
+    if (static_cast<CharacterCompareType>(bytecode.at(instruction_position + 3)) != CharacterCompareType::String)
+        return {};
+    return bytecode.at(instruction_position + 4);
+}
+
+static bool can_handle_compare(OpCode_Compare const& compare)
+{
+    auto& bytecode = compare.bytecode();
+    size_t offset = compare.state().instruction_position + 3;
+    for (size_t i = 0; i < compare.arguments_count(); ++i) {
+        switch (static_cast<CharacterCompareType>(bytecode.at(offset++))) {
+        case CharacterCompareType::Inverse:
+        case CharacterCompareType::TemporaryInverse:
+        case CharacterCompareType::AnyChar:
+        case CharacterCompareType::And:
+        case CharacterCompareType::Or:
+        case CharacterCompareType::EndAndOr:
+            break;
+        case CharacterCompareType::Char:
+        case CharacterCompareType::CharClass:
+        case CharacterCompareType::CharRange:
+        case CharacterCompareType::Property:
+        case CharacterCompareType::GeneralCategory:
+        case CharacterCompareType::Script:
+        case CharacterCompareType::ScriptExtension:
+            ++offset;
+            break;
+        case CharacterCompareType::LookupTable:
+            offset += 1 + bytecode.at(offset);
+            break;
+        case CharacterCompareType::String:
+            // Strings can only be matched one character at a time if nothing else is compared.
+            if (compare.arguments_count() != 1)
+                return false;
+            offset += 1 + bytecode.at(offset);
+            break;
+        case CharacterCompareType::Reference:
+        case CharacterCompareType::Undefined:
+        case CharacterCompareType::RangeExpressionDummy:
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LazyDFA::can_handle(ByteCode const& bytecode)
+{
+    MatchState state;
+    auto bytecode_size = bytecode.size();
+    while (state.instruction_position < bytecode_size) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            if (!can_handle_compare(static_cast<OpCode_Compare const&>(opcode)))
+                return false;
+            break;
+        case OpCodeId::Jump:
+        case OpCodeId::JumpNonEmpty:
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkReplaceStay:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::Exit:
+            break;
+        default:
+            return false;
+        }
+        state.instruction_position += opcode.size();
+    }
+    return true;
+}
+
+bool LazyDFA::can_handle(AllOptions options)
+{
+    return !options.has_flag_set(AllFlags::Multiline)
+        && !options.has_flag_set(AllFlags::Internal_Stateful)
+        && !options.has_flag_set(AllFlags::MatchNotBeginOfLine)
+        && !options.has_flag_set(AllFlags::MatchNotEndOfLine);
+}
+
+unsigned LazyDFA::PositionsTraits::hash(Vector<Position> const& positions)
+{
+    unsigned hash = 0;
+    for (auto position : positions)
+        hash = pair_int_hash(hash, u64_hash(position));
+    return hash;
+}
+
+void LazyDFA::reset(ByteCode const& bytecode, InputKind input_kind, AllOptions options)
+{
+    m_input_kind = input_kind;
+    m_options = options;
+    m_states.clear();
+    m_states_by_positions.clear();
+    m_start_state = nullptr;
+
+    m_restart_positions.clear();
+    add_closure(bytecode, m_restart_positions, make_position(0, 0), false, false);
+    quick_sort(m_restart_positions);
+}
+
+LazyDFA::State* LazyDFA::state_for(Vector<Position> positions)
+{
+    quick_sort(positions);
+    for (size_t i = 1; i < positions.size();) {
+        if (positions[i] == positions[i - 1])
+            positions.remove(i);
+        else
+            ++i;
+    }
+
+    if (auto state = m_states_by_positions.get(positions); state.has_value())
+        return *state;
+
+    if (m_states.size() >= max_state_count) {
+        m_states.clear();
+        m_states_by_positions.clear();
+        m_start_state = nullptr;
+        if (++m_flush_count > max_flush_count_per_search)
+            return nullptr;
+    }
+
+    auto state = make<State>();
+    state->is_accepting = positions.contains_slow(accepting_position);
+    state->positions = move(positions);
+
+    auto* state_ptr = state.ptr();
+    m_states_by_positions.set(state->positions, state_ptr);
+    m_states.append(move(state));
+    return state_ptr;
+}
+
+void LazyDFA::add_closure(ByteCode const& bytecode, Vector<Position>& positions, Position initial_position, bool is_at_start, bool is_at_end) const
+{
+    Vector<Position, 16> worklist;
+    HashTable<Position> visited;
+    MatchState state;
+    worklist.append(initial_position);
+
+    while (!worklist.is_empty()) {
+        auto position = worklist.take_last();
+        if (visited.set(position) != HashSetResult::InsertedNewEntry)
+            continue;
+
+        auto instruction_position = instruction_position_of(position);
+        if (instruction_position >= bytecode.size()) {
+            // Running past the end of the bytecode means that the pattern has matched.
+            positions.append(accepting_position);
+            continue;
+        }
+
+        state.instruction_position = instruction_position;
+        auto& opcode = bytecode.get_opcode(state);
+        auto next_position = make_position(instruction_position + opcode.size(), 0);
+        auto jump_target = [&]<typename T>() {
+            return make_position(instruction_position + opcode.size() + static_cast<T const&>(opcode).offset(), 0);
+        };
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            if (auto length = string_length_of_compare(bytecode, instruction_position); length.has_value() && string_index_of(position) >= *length)
+                worklist.append(next_position);
+            else
+                positions.append(position);
+            break;
+        case OpCodeId::Jump:
+            worklist.append(jump_target.template operator()<OpCode_Jump>());
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            worklist.append(next_position);
+            worklist.append(jump_target.template operator()<OpCode_ForkJump>());
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            worklist.append(next_position);
+            worklist.append(jump_target.template operator()<OpCode_ForkStay>());
+            break;
+        case OpCodeId::JumpNonEmpty:
+            // This only prevents loops from repeating empty iterations, which doesn't change what the loop can match.
+            worklist.append(next_position);
+            worklist.append(jump_target.template operator()<OpCode_JumpNonEmpty>());
+            break;
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::Checkpoint:
+            worklist.append(next_position);
+            break;
+        case OpCodeId::CheckBegin:
+            if (is_at_start)
+                worklist.append(next_position);
+            break;
+        case OpCodeId::CheckEnd:
+            // Whether we are at the end is only known once the next character is read, so keep the check around.
+            if (is_at_end)
+                worklist.append(next_position);
+            else
+                positions.append(position);
+            break;
+        case OpCodeId::Exit:
+            // An Exit before the end of the bytecode fails the match.
+            break;
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+}
+
+bool LazyDFA::compare_matches(ByteCode const& bytecode, Position position, u32 character) const
+{
+    auto instruction_position = instruction_position_of(position);
+
+    if (auto length = string_length_of_compare(bytecode, instruction_position); length.has_value() && *length > 1) {
+        // Like compare_string() in RegexByteCode.cpp, which compares code units (ignoring ASCII case).
+        auto expected = static_cast<u32>(bytecode.at(instruction_position + 5 + string_index_of(position)));
+        if (m_input_kind == InputKind::Bytes)
+            expected = static_cast<u8>(expected);
+        if (m_options.has_flag_set(AllFlags::Insensitive))
+            return to_ascii_lowercase(character) == to_ascii_lowercase(expected);
+        return character == expected;
+    }
+
+    // Run the compare on a view that only contains this character.
+    MatchInput input;
+    input.regex_options = m_options;
+
+    char byte;
+    Array<u16, 2> code_units;
+    if (m_input_kind == InputKind::Bytes) {
+        byte = static_cast<char>(character);
+        input.view = StringView { &byte, 1 };
+    } else {
+        size_t code_unit_count = 1;
+        if (character > 0xffff) {
+            code_units[0] = static_cast<u16>(0xd800 + ((character - 0x10000) >> 10));
+            code_units[1] = static_cast<u16>(0xdc00 + ((character - 0x10000) & 0x3ff));
+            code_unit_count = 2;
+        } else {
+            code_units[0] = static_cast<u16>(character);
+        }
+        input.view = Utf16View { code_units.span().trim(code_unit_count) };
+    }
+    input.view.set_unicode(m_input_kind == InputKind::CodePoints);
+
+    MatchState state;
+    state.instruction_position = instruction_position;
+    auto& opcode = bytecode.get_opcode(state);
+    auto result = opcode.execute(input, state);
+    return result == ExecutionResult::Continue && state.string_position == 1;
+}
+
+LazyDFA::State* LazyDFA::transition(ByteCode const& bytecode, State& state, u32 character)
+{
+    if (character < state.ascii_transitions.size()) {
+        if (auto* next_state = state.ascii_transitions[character])
+            return next_state;
+    } else if (auto next_state = state.transitions.get(character); next_state.has_value()) {
+        return *next_state;
+    }
+
+    // A match may start at every position, so the next state always includes the start of the pattern.
+    auto positions = m_restart_positions;
+    MatchState match_state;
+    for (auto position : state.positions) {
+        if (position == accepting_position)
+            continue;
+
+        match_state.instruction_position = instruction_position_of(position);
+        auto& opcode = bytecode.get_opcode(match_state);
+        if (opcode.opcode_id() != OpCodeId::Compare)
+            continue;
+        if (!compare_matches(bytecode, position, character))
+            continue;
+
+        if (string_length_of_compare(bytecode, match_state.instruction_position).has_value())
+            add_closure(bytecode, positions, position + 1, false, false);
+        else
+            add_closure(bytecode, positions, make_position(match_state.instruction_position + opcode.size(), 0), false, false);
+    }
+
+    auto flush_count = m_flush_count;
+    auto* next_state = state_for(move(positions));
+
+    // If the cache has been flushed, the state we came from doesn't exist anymore.
+    if (next_state && flush_count == m_flush_count) {
+        if (character < state.ascii_transitions.size())
+            state.ascii_transitions[character] = next_state;
+        else
+            state.transitions.set(character, next_state);
+    }
+    return next_state;
+}
+
+bool LazyDFA::is_accepting_at_end(ByteCode const& bytecode, State& state)
+{
+    if (state.is_accepting_at_end.has_value())
+        return *state.is_accepting_at_end;
+
+    Vector<Position> positions;
+    for (auto position : state.positions)
+        add_closure(bytecode, positions, position, false, true);
+
+    state.is_accepting_at_end = positions.contains_slow(accepting_position);
+    return *state.is_accepting_at_end;
+}
+
+Optional<bool> LazyDFA::has_match(ByteCode const& bytecode, RegexStringView view, AllOptions options)
+{
+    InputKind input_kind;
+    if (view.is_string_view() && !view.unicode())
+        input_kind = InputKind::Bytes;
+    else if (view.is_u16_view())
+        input_kind = view.unicode() ? InputKind::CodePoints : InputKind::CodeUnits;
+    else
+        return {};
+
+    // These only change which match is found, not whether there is one.
+    options.reset_flag(AllFlags::Global);
+    options.reset_flag(AllFlags::Ungreedy);
+    options.reset_flag(AllFlags::Sticky);
+    options.reset_flag(AllFlags::SingleMatch);
+    options.reset_flag(AllFlags::SkipSubExprResults);
+    options.reset_flag(AllFlags::SkipTrimEmptyMatches);
+    options.reset_flag(AllFlags::StringCopyMatches);
+
+    if (input_kind != m_input_kind || options.value() != m_options.value())
+        reset(bytecode, input_kind, options);
+
+    m_flush_count = 0;
+
+    if (view.length_in_code_units() == 0) {
+        Vector<Position> positions;
+        add_closure(bytecode, positions, make_position(0, 0), true, true);
+        return positions.contains_slow(accepting_position);
+    }
+
+    if (!m_start_state) {
+        Vector<Position> positions;
+        add_closure(bytecode, positions, make_position(0, 0), true, false);
+        m_start_state = state_for(move(positions));
+        if (!m_start_state)
+            return {};
+    }
+
+    auto* state = m_start_state;
+    auto step = [&](u32 character) {
+        state = transition(bytecode, *state, character);
+    };
+
+    if (state->is_accepting)
+        return true;
+
+    if (input_kind == InputKind::Bytes) {
+        for (auto byte : view.string_view().bytes()) {
+            step(byte);
+            if (!state)
+                return {};
+            if (state->is_accepting)
+                return true;
+        }
+    } else {
+        auto const& code_units = view.u16_view();
+        for (size_t i = 0; i < code_units.length_in_code_units();) {
+            u32 character = code_units.code_unit_at(i++);
+            if (is_unicode_surrogate(character)) {
+                // Without the unicode flag, surrogate pairs are sometimes compared as a whole and sometimes not,
+                // and lone surrogates are left to the backtracking VM as well.
+                if (input_kind == InputKind::CodeUnits || !Utf16View::is_high_surrogate(character) || i == code_units.length_in_code_units())
+                    return {};
+                auto low_surrogate = code_units.code_unit_at(i++);
+                if (!Utf16View::is_low_surrogate(low_surrogate))
+                    return {};
+                character = Utf16View::decode_surrogate_pair(character, low_surrogate);
+            }
+
+            step(character);
+            if (!state)
+                return {};
+            if (state->is_accepting)
+                return true;
+        }
+    }
+
+    return is_accepting_at_end(bytecode, *state);
+}
+
+}
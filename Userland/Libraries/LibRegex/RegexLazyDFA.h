@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+#include "RegexOptions.h"
+
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// Answers whether a pattern matches anywhere in a string, without backtracking.
+//
+// The bytecode is treated as a nondeterministic automaton whose states are instruction positions, and sets of those
+// are turned into deterministic states as the input is read. These are cached along with their transitions, so most
+// input characters only cost a table lookup. Captures are ignored, since only the existence of a match is computed.
+//
+// Only bytecode without backreferences, lookarounds, word boundaries, counted repetitions and atomic groups can be
+// handled (see can_handle()), and only single-line matching of StringView and Utf16View inputs is supported.
+class LazyDFA {
+    AK_MAKE_NONCOPYABLE(LazyDFA);
+    AK_MAKE_NONMOVABLE(LazyDFA);
+
+public:
+    LazyDFA() = default;
+
+    static bool can_handle(ByteCode const&);
+    static bool can_handle(AllOptions);
+
+    // Returns whether there is a match starting at any position of the view, or nothing if the view can't be handled.
+    Optional<bool> has_match(ByteCode const&, RegexStringView, AllOptions);
+
+private:
+    // An instruction position, combined with the index of the next character for string compares.
+    using Position = u64;
+    static constexpr Position accepting_position = NumericLimits<Position>::max();
+
+    enum class InputKind {
+        None,
+        Bytes,
+        CodeUnits,
+        CodePoints,
+    };
+
+    struct State {
+        Vector<Position> positions;
+        bool is_accepting { false };
+        Optional<bool> is_accepting_at_end;
+        Array<State*, 128> ascii_transitions {};
+        HashMap<u32, State*> transitions;
+    };
+
+    struct PositionsTraits : public DefaultTraits<Vector<Position>> {
+        static unsigned hash(Vector<Position> const&);
+        static bool equals(Vector<Position> const& a, Vector<Position> const& b) { return a == b; }
+    };
+
+    void reset(ByteCode const&, InputKind, AllOptions);
+    State* state_for(Vector<Position>);
+    State* transition(ByteCode const&, State&, u32 character);
+    bool is_accepting_at_end(ByteCode const&, State&);
+
+    // Adds the positions that can be reached from the given one without consuming any input.
+    void add_closure(ByteCode const&, Vector<Position>&, Position, bool is_at_start, bool is_at_end) const;
+    bool compare_matches(ByteCode const&, Position, u32 character) const;
+
+    // Once this many states have been created, the cache is flushed.
+    static constexpr size_t max_state_count = 1024;
+    // If a single search flushes the cache more often than this, we give up and let the backtracking VM handle it.
+    static constexpr size_t max_flush_count_per_search = 8;
+
+    InputKind m_input_kind { InputKind::None };
+    AllOptions m_options;
+
+    Vector<NonnullOwnPtr<State>> m_states;
+    HashMap<Vector<Position>, State*, PositionsTraits> m_states_by_positions;
+    State* m_start_state { nullptr };
+    size_t m_flush_count { 0 };
+    // The positions reachable when starting a match anywhere but at the beginning of the input.
+    Vector<Position> m_restart_positions;
+};
+
+}
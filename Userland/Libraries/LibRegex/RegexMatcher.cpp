@@ -135,6 +135,12 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     for (auto const& view : views)
         const_cast<RegexStringView&>(view).set_unicode(unicode);
 
+    // If the pattern doesn't match anywhere in the input, there's no need to try every position with the VM.
+    if (views.size() == 1) {
+        if (auto has_match = lazy_dfa_has_match(views.first(), input.regex_options); has_match.has_value() && !has_match.value())
+            return { false, 0, {}, {}, operations, m_pattern->parser_result.capture_groups_count, m_pattern->parser_result.named_capture_groups_count };
+    }
+
     if (input.regex_options.has_flag_set(AllFlags::Internal_Stateful)) {
         if (views.size() > 1 && input.start_offset > views.first().length()) {
             dbgln_if(REGEX_DEBUG, "Started with start={}, goff={}, skip={}", input.start_offset, input.global_offset, lines_to_skip);
@@ -185,6 +191,15 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
 
+    auto& optimization_data = m_pattern->parser_result.optimization_data;
+    // The prefilters are computed for the options that the pattern was compiled with, and only for byte strings.
+    auto can_use_match_start_prefilters = continue_search
+        && (!input.regex_options.has_flag_set(AllFlags::Insensitive) || m_pattern->parser_result.options.has_flag_set(AllFlags::Insensitive));
+    // Without multiline matching, a pattern starting with '^' can't match anywhere but at the start of the input.
+    auto only_start_of_input = optimization_data.only_start_of_input
+        && !(input.regex_options.has_flag_set(AllFlags::Multiline) && input.regex_options.has_flag_set(AllFlags::Internal_ConsiderNewline))
+        && !input.regex_options.has_flag_set(AllFlags::MatchNotBeginOfLine);
+
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -235,6 +250,16 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             if (view_index == view_length && input.regex_options.has_flag_set(AllFlags::Multiline))
                 break;
 
+            if (only_start_of_input && view_index > 0)
+                break;
+
+            if (can_use_match_start_prefilters && view.is_string_view() && !view.unicode()) {
+                auto candidate = find_match_start_candidate(view.string_view(), view_index);
+                if (!candidate.has_value())
+                    break;
+                view_index = candidate.value();
+            }
+
             auto& match_length_minimum = m_pattern->parser_result.match_length_minimum;
             // FIXME: More performant would be to know the remaining minimum string
             //        length needed to match from the current position onwards within
@@ -335,6 +360,91 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     return result;
 }
 
+template<typename Parser>
+bool Matcher<Parser>::has_match(RegexStringView view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
+{
+    AllOptions options = m_regex_options | regex_options.value_or({}).value();
+
+    // A global search succeeds if there is a match starting anywhere in the view, which is exactly what the DFA finds out.
+    if (options.has_flag_set(AllFlags::Global) && !options.has_flag_set(AllFlags::Sticky)) {
+        view.set_unicode(options.has_flag_set(AllFlags::Unicode));
+        if (auto has_match = lazy_dfa_has_match(view, options); has_match.has_value()) {
+            m_pattern->start_offset = 0;
+            return has_match.value();
+        }
+    }
+
+    return match(view, AllOptions { regex_options.value_or({}) } | AllFlags::SkipSubExprResults).success;
+}
+
+template<typename Parser>
+void Matcher<Parser>::for_each_matching_line(StringView buffer, Function<IterationDecision(StringView, size_t)> const& callback, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
+{
+    AllOptions options = m_regex_options | regex_options.value_or({}).value();
+    options |= AllFlags::Global;
+
+    auto& parser_result = m_pattern->parser_result;
+    auto can_use_match_start_prefilters = !options.has_flag_set(AllFlags::Sticky)
+        && !options.has_flag_set(AllFlags::Internal_Stateful)
+        && !options.has_flag_set(AllFlags::Unicode)
+        && (!options.has_flag_set(AllFlags::Insensitive) || parser_result.options.has_flag_set(AllFlags::Insensitive));
+
+    size_t line_start = 0;
+    size_t line_index = 0;
+    while (line_start < buffer.length()) {
+        if (can_use_match_start_prefilters) {
+            // Skip ahead to the line containing the next position where a match could start.
+            auto candidate = find_match_start_candidate(buffer, line_start);
+            if (!candidate.has_value())
+                return;
+            for (auto newline = buffer.find('\n', line_start); newline.has_value() && newline.value() < candidate.value(); newline = buffer.find('\n', line_start)) {
+                line_start = newline.value() + 1;
+                ++line_index;
+            }
+        }
+
+        auto line_end = buffer.find('\n', line_start).value_or(buffer.length());
+        auto line = buffer.substring_view(line_start, line_end - line_start);
+        if (has_match(line, options) && callback(line, line_index) == IterationDecision::Break)
+            return;
+
+        line_start = line_end + 1;
+        ++line_index;
+    }
+}
+
+template<typename Parser>
+Optional<bool> Matcher<Parser>::lazy_dfa_has_match(RegexStringView view, AllOptions options) const
+{
+    if (!m_pattern->parser_result.optimization_data.can_use_lazy_dfa || !LazyDFA::can_handle(options))
+        return {};
+
+    if (!m_lazy_dfa)
+        m_lazy_dfa = make<LazyDFA>();
+    return m_lazy_dfa->has_match(m_pattern->parser_result.bytecode, view, options);
+}
+
+template<typename Parser>
+Optional<size_t> Matcher<Parser>::find_match_start_candidate(StringView view, size_t start) const
+{
+    auto& optimization_data = m_pattern->parser_result.optimization_data;
+
+    if (optimization_data.required_prefix.has_value())
+        return view.find(optimization_data.required_prefix.value(), start);
+
+    if (optimization_data.starting_characters.has_value()) {
+        auto& starting_characters = optimization_data.starting_characters.value();
+        for (size_t i = start; i < view.length(); ++i) {
+            auto ch = static_cast<u8>(view[i]);
+            if (ch < starting_characters.size() && starting_characters[ch])
+                return i;
+        }
+        return {};
+    }
+
+    return start;
+}
+
 template<typename T>
 class BumpAllocatedLinkedList {
 public:
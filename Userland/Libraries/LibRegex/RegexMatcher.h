@@ -7,13 +7,17 @@
 #pragma once
 
 #include "RegexByteCode.h"
+#include "RegexLazyDFA.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
 
 #include <AK/Forward.h>
+#include <AK/Function.h>
 #include <AK/GenericLexer.h>
 #include <AK/HashMap.h>
+#include <AK/IterationDecision.h>
+#include <AK/OwnPtr.h>
 #include <AK/Types.h>
 #include <AK/Utf32View.h>
 #include <AK/Vector.h>
@@ -62,6 +66,8 @@ public:
 
     RegexResult match(RegexStringView, Optional<typename ParserTraits<Parser>::OptionsType> = {}) const;
     RegexResult match(Vector<RegexStringView> const&, Optional<typename ParserTraits<Parser>::OptionsType> = {}) const;
+    bool has_match(RegexStringView, Optional<typename ParserTraits<Parser>::OptionsType> = {}) const;
+    void for_each_matching_line(StringView buffer, Function<IterationDecision(StringView line, size_t line_index)> const&, Optional<typename ParserTraits<Parser>::OptionsType> = {}) const;
 
     typename ParserTraits<Parser>::OptionsType options() const
     {
@@ -76,8 +82,15 @@ public:
 private:
     bool execute(MatchInput const& input, MatchState& state, size_t& operations) const;
 
+    // Returns whether the pattern matches anywhere in the view, or nothing if the lazy DFA can't tell.
+    Optional<bool> lazy_dfa_has_match(RegexStringView, AllOptions) const;
+
+    // Returns the first position at or after the given one where a match could start, or nothing if there is none.
+    Optional<size_t> find_match_start_candidate(StringView, size_t start) const;
+
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+    mutable OwnPtr<LazyDFA> m_lazy_dfa;
 };
 
 template<class Parser>
@@ -214,8 +227,7 @@ public:
     {
         if (!matcher || parser_result.error != Error::NoError)
             return false;
-        RegexResult result = matcher->match(view, AllOptions { regex_options.value_or({}) } | AllFlags::SkipSubExprResults);
-        return result.success;
+        return matcher->has_match(view, regex_options);
     }
 
     bool has_match(Vector<RegexStringView> const& views, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {}) const
@@ -226,6 +238,15 @@ public:
         return result.success;
     }
 
+    // Calls the callback with every line of the buffer that contains a match, and the (zero-based) index of that line.
+    // Lines that can't contain a match are skipped without running the matcher on them.
+    void for_each_matching_line(StringView buffer, Function<IterationDecision(StringView line, size_t line_index)> const& callback, Optional<typename ParserTraits<Parser>::OptionsType> regex_options = {}) const
+    {
+        if (!matcher || parser_result.error != Error::NoError)
+            return;
+        matcher->for_each_matching_line(buffer, callback, regex_options);
+    }
+
     using BasicBlockList = Vector<Detail::Block>;
     static BasicBlockList split_basic_blocks(ByteCode const&);
 
@@ -233,6 +254,7 @@ private:
     void run_optimization_passes();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
+    void compute_match_start_prefilters();
 };
 
 // free standing functions for match, search and has_match
@@ -4,8 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
+#include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/Function.h>
+#include <AK/HashTable.h>
 #include <AK/Queue.h>
 #include <AK/QuickSort.h>
 #include <AK/RedBlackTree.h>
@@ -13,6 +16,7 @@
 #include <AK/Trie.h>
 #include <LibRegex/Regex.h>
 #include <LibRegex/RegexBytecodeStreamOptimizer.h>
+#include <LibRegex/RegexLazyDFA.h>
 #include <LibUnicode/CharacterTypes.h>
 #if REGEX_DEBUG
 #    include <AK/ScopeGuard.h>
@@ -28,6 +32,9 @@ void Regex<Parser>::run_optimization_passes()
 {
     parser_result.bytecode.flatten();
 
+    // Find out where matches can start, so the matcher doesn't have to try every position of the input.
+    compute_match_start_prefilters();
+
     auto blocks = split_basic_blocks(parser_result.bytecode);
     if (attempt_rewrite_entire_match_as_substring_search(blocks))
         return;
@@ -37,6 +44,9 @@ void Regex<Parser>::run_optimization_passes()
     attempt_rewrite_loops_as_atomic_groups(blocks);
 
     parser_result.bytecode.flatten();
+
+    // Patterns without backreferences, lookarounds, etc. can be searched for without backtracking.
+    parser_result.optimization_data.can_use_lazy_dfa = LazyDFA::can_handle(parser_result.bytecode);
 }
 
 template<typename Parser>
@@ -651,6 +661,146 @@ bool Regex<Parser>::attempt_rewrite_entire_match_as_substring_search(BasicBlockL
     return true;
 }
 
+template<typename Parser>
+void Regex<Parser>::compute_match_start_prefilters()
+{
+    auto& bytecode = parser_result.bytecode;
+    auto& optimization_data = parser_result.optimization_data;
+    auto is_insensitive = parser_result.options.has_flag_set(AllFlags::Insensitive);
+    auto is_unicode = parser_result.options.has_flag_set(AllFlags::Unicode);
+
+    auto is_non_consuming = [](OpCodeId id) {
+        switch (id) {
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::Checkpoint:
+            return true;
+        default:
+            return false;
+        }
+    };
+
+    // Collect the literal characters at the start of the pattern, up to the first branch.
+    // e.g. /^foo(bar|baz)/ has to start with "foo", and only at the start of the input.
+    StringBuilder prefix;
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        if (opcode.opcode_id() == OpCodeId::CheckBegin && prefix.is_empty()) {
+            optimization_data.only_start_of_input = true;
+        } else if (opcode.opcode_id() == OpCodeId::Compare) {
+            auto& compare = static_cast<OpCode_Compare const&>(opcode);
+            auto flat_compares = compare.flat_compares();
+            // A single Char or String argument, anything else is not a sequence of literal characters.
+            if (compare.arguments_count() != 1 || any_of(flat_compares, [](auto& flat_compare) { return flat_compare.type != CharacterCompareType::Char || flat_compare.value > 0x7f; }))
+                break;
+            for (auto& flat_compare : flat_compares)
+                prefix.append(static_cast<char>(flat_compare.value));
+        } else if (!is_non_consuming(opcode.opcode_id())) {
+            break;
+        }
+        state.instruction_position += opcode.size();
+    }
+
+    if (!prefix.is_empty() && !is_insensitive) {
+        optimization_data.required_prefix = prefix.to_byte_string();
+        return;
+    }
+
+    // Case-insensitive unicode matching lets ASCII characters match non-ASCII ones (e.g. 'k' and KELVIN SIGN).
+    if (is_insensitive && is_unicode)
+        return;
+
+    // Otherwise, collect the set of characters that the first consuming instruction on any path can match.
+    Array<bool, 128> starting_characters {};
+    auto add_character = [&](u32 code_point) {
+        starting_characters[code_point] = true;
+        if (is_insensitive) {
+            starting_characters[to_ascii_lowercase(code_point)] = true;
+            starting_characters[to_ascii_uppercase(code_point)] = true;
+        }
+    };
+
+    Vector<size_t> positions_to_visit { 0 };
+    HashTable<size_t> visited_positions;
+    while (!positions_to_visit.is_empty()) {
+        auto position = positions_to_visit.take_last();
+        if (visited_positions.set(position) != HashSetResult::InsertedNewEntry)
+            continue;
+
+        // Reaching the end means that the pattern can match without consuming anything.
+        if (position >= bytecode.size())
+            return;
+
+        state.instruction_position = position;
+        auto& opcode = bytecode.get_opcode(state);
+        auto next_position = position + opcode.size();
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            for (auto& flat_compare : static_cast<OpCode_Compare const&>(opcode).flat_compares()) {
+                switch (flat_compare.type) {
+                case CharacterCompareType::Char:
+                    if (flat_compare.value > 0x7f)
+                        return;
+                    add_character(flat_compare.value);
+                    break;
+                case CharacterCompareType::CharRange: {
+                    CharRange range { flat_compare.value };
+                    if (range.to > 0x7f)
+                        return;
+                    for (auto code_point = range.from; code_point <= range.to; ++code_point)
+                        add_character(code_point);
+                    break;
+                }
+                case CharacterCompareType::CharClass:
+                    if (static_cast<CharClass>(flat_compare.value) != CharClass::Digit)
+                        return;
+                    for (u32 code_point = '0'; code_point <= '9'; ++code_point)
+                        add_character(code_point);
+                    break;
+                default:
+                    return;
+                }
+            }
+            break;
+        case OpCodeId::Jump:
+            positions_to_visit.append(next_position + static_cast<OpCode_Jump const&>(opcode).offset());
+            break;
+        case OpCodeId::JumpNonEmpty:
+            positions_to_visit.append(next_position + static_cast<OpCode_JumpNonEmpty const&>(opcode).offset());
+            positions_to_visit.append(next_position);
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            positions_to_visit.append(next_position + static_cast<OpCode_ForkJump const&>(opcode).offset());
+            positions_to_visit.append(next_position);
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            positions_to_visit.append(next_position + static_cast<OpCode_ForkStay const&>(opcode).offset());
+            positions_to_visit.append(next_position);
+            break;
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+            positions_to_visit.append(next_position);
+            break;
+        case OpCodeId::Exit:
+            // An explicit exit never matches.
+            break;
+        default:
+            if (!is_non_consuming(opcode.opcode_id()))
+                return;
+            positions_to_visit.append(next_position);
+            break;
+        }
+    }
+
+    optimization_data.starting_characters = starting_characters;
+}
+
 template<typename Parser>
 void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const& basic_blocks)
 {
@@ -11,6 +11,7 @@
 #include "RegexLexer.h"
 #include "RegexOptions.h"
 
+#include <AK/Array.h>
 #include <AK/Forward.h>
 #include <AK/StringBuilder.h>
 #include <AK/Types.h>
@@ -58,6 +59,12 @@ public:
 
         struct {
             Optional<ByteString> pure_substring_search;
+            // A literal that every match starts with.
+            Optional<ByteString> required_prefix;
+            // The (ASCII) characters that a match can start with, if it can't start with anything else.
+            Optional<Array<bool, 128>> starting_characters;
+            bool only_start_of_input { false };
+            bool can_use_lazy_dfa { false };
         } optimization_data {};
     };
 
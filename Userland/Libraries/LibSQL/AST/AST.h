@@ -761,6 +761,10 @@ class Statement : public ASTNode {
 public:
     ResultOr<ResultSet> execute(AK::NonnullRefPtr<Database> database, ReadonlySpan<Value> placeholder_values = {}) const;
 
+    // Executes the statement once for every set of placeholder values, and commits all executions at once. The result
+    // holds the rows of all executions.
+    ResultOr<ResultSet> execute_batch(AK::NonnullRefPtr<Database> database, ReadonlySpan<Vector<Value>> placeholder_value_sets) const;
+
     virtual ResultOr<ResultSet> execute(ExecutionContext&) const
     {
         return Result { SQLCommand::Unknown, SQLErrorCode::NotYetImplemented };
@@ -1082,7 +1086,13 @@ public:
     RefPtr<LimitClause> const& limit_clause() const { return m_limit_clause; }
     ResultOr<ResultSet> execute(ExecutionContext&) const override;
 
+    // The steps taken to execute this statement, as reported by EXPLAIN.
+    Vector<ByteString> query_plan() const;
+
 private:
+    // The number of matching rows after which a table scan may stop, if LIMIT allows stopping early.
+    Optional<size_t> scan_row_limit() const;
+
     RefPtr<CommonTableExpressionList> m_common_table_expression_list;
     bool m_select_all;
     Vector<NonnullRefPtr<ResultColumn>> m_result_column_list;
@@ -1107,4 +1117,18 @@ private:
     NonnullRefPtr<QualifiedTableName> m_qualified_table_name;
 };
 
+class Explain : public Statement {
+public:
+    Explain(NonnullRefPtr<Select> select_statement)
+        : m_select_statement(move(select_statement))
+    {
+    }
+
+    NonnullRefPtr<Select> const& select_statement() const { return m_select_statement; }
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+
+private:
+    NonnullRefPtr<Select> m_select_statement;
+};
+
 }
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Checked.h>
 #include <AK/NumericLimits.h>
 #include <LibSQL/AST/AST.h>
 #include <LibSQL/Database.h>
@@ -37,6 +38,72 @@ static ByteString result_column_name(ResultColumn const& column, size_t column_i
     return fallback_column_name();
 }
 
+static Optional<size_t> literal_row_count(RefPtr<Expression> const& expression)
+{
+    if (!expression || !is<NumericLiteral>(*expression))
+        return {};
+
+    auto value = static_cast<NumericLiteral const&>(*expression).value();
+    if (value < 0 || value != static_cast<double>(static_cast<size_t>(value)))
+        return {};
+    return static_cast<size_t>(value);
+}
+
+Optional<size_t> Select::scan_row_limit() const
+{
+    // Without ORDER BY, any rows that match will do, so a scan over a single table can stop once it found enough of them.
+    if (m_table_or_subquery_list.size() != 1 || !m_ordering_term_list.is_empty() || !m_limit_clause)
+        return {};
+
+    auto limit = literal_row_count(m_limit_clause->limit_expression());
+    if (!limit.has_value())
+        return {};
+
+    size_t offset = 0;
+    if (m_limit_clause->offset_expression()) {
+        auto maybe_offset = literal_row_count(m_limit_clause->offset_expression());
+        if (!maybe_offset.has_value())
+            return {};
+        offset = *maybe_offset;
+    }
+
+    return Checked<size_t>::saturating_add(offset, *limit);
+}
+
+Vector<ByteString> Select::query_plan() const
+{
+    Vector<ByteString> plan;
+
+    for (auto const& table_descriptor : m_table_or_subquery_list) {
+        if (!table_descriptor->is_table()) {
+            plan.append("SCAN SUBQUERY");
+            continue;
+        }
+
+        auto table_name = table_descriptor->schema_name().is_empty()
+            ? table_descriptor->table_name()
+            : ByteString::formatted("{}.{}", table_descriptor->schema_name(), table_descriptor->table_name());
+
+        if (plan.is_empty())
+            plan.append(ByteString::formatted("SCAN TABLE {}", table_name));
+        else
+            plan.append(ByteString::formatted("SCAN TABLE {} FOR EACH ROW OF THE PREVIOUS TABLES", table_name));
+    }
+
+    if (m_where_clause)
+        plan.append("FILTER ROWS BY WHERE CLAUSE");
+
+    if (!m_ordering_term_list.is_empty())
+        plan.append("SORT RESULTS FOR ORDER BY");
+
+    if (auto row_limit = scan_row_limit(); row_limit.has_value())
+        plan.append(ByteString::formatted("STOP SCAN AFTER {} MATCHING ROWS", *row_limit));
+    else if (m_limit_clause)
+        plan.append("APPLY LIMIT TO RESULTS");
+
+    return plan;
+}
+
 ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 {
     Vector<NonnullRefPtr<ResultColumn const>> columns;
@@ -87,33 +154,8 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 
     auto descriptor = adopt_ref(*new TupleDescriptor);
     Tuple tuple(descriptor);
-    Vector<Tuple> rows;
     descriptor->empend("__unity__"sv);
     tuple.append(Value { true });
-    rows.append(tuple);
-
-    for (auto& table_descriptor : table_or_subquery_list()) {
-        if (!table_descriptor->is_table())
-            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
-
-        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
-        if (table_def->num_columns() == 0)
-            continue;
-
-        auto old_descriptor_size = descriptor->size();
-        descriptor->extend(table_def->to_tuple_descriptor());
-
-        while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
-            auto cartesian_row = rows.take_first();
-            auto table_rows = TRY(context.database->select_all(*table_def));
-
-            for (auto& table_row : table_rows) {
-                auto new_row = cartesian_row;
-                new_row.extend(table_row);
-                rows.append(new_row);
-            }
-        }
-    }
 
     bool has_ordering { false };
     auto sort_descriptor = adopt_ref(*new TupleDescriptor);
@@ -123,13 +165,13 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
     }
     Tuple sort_key(sort_descriptor);
 
-    for (auto& row : rows) {
+    auto process_row = [&](Tuple& row) -> ResultOr<void> {
         context.current_row = &row;
 
         if (where_clause()) {
             auto where_result = TRY(where_clause()->evaluate(context)).to_bool();
             if (!where_result.has_value() || !where_result.value())
-                continue;
+                return {};
         }
 
         tuple.clear();
@@ -148,6 +190,63 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
         }
 
         result.insert_row(tuple, sort_key);
+        return {};
+    };
+
+    if (table_or_subquery_list().size() == 1) {
+        // Stream the rows of a single table through the filter, instead of loading all of them first.
+        auto const& table_descriptor = table_or_subquery_list().first();
+        if (!table_descriptor->is_table())
+            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
+
+        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
+        auto row_limit = scan_row_limit();
+
+        if (table_def->num_columns() == 0) {
+            TRY(process_row(tuple));
+        } else {
+            auto unity_row = tuple;
+            descriptor->extend(table_def->to_tuple_descriptor());
+
+            TRY(context.database->for_each_row(*table_def, [&](Row& table_row) -> ResultOr<IterationDecision> {
+                auto row = unity_row;
+                row.extend(table_row);
+                TRY(process_row(row));
+
+                if (row_limit.has_value() && result.size() >= *row_limit)
+                    return IterationDecision::Break;
+                return IterationDecision::Continue;
+            }));
+        }
+    } else {
+        Vector<Tuple> rows;
+        rows.append(tuple);
+
+        for (auto& table_descriptor : table_or_subquery_list()) {
+            if (!table_descriptor->is_table())
+                return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
+
+            auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
+            if (table_def->num_columns() == 0)
+                continue;
+
+            auto old_descriptor_size = descriptor->size();
+            descriptor->extend(table_def->to_tuple_descriptor());
+
+            while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
+                auto cartesian_row = rows.take_first();
+                auto table_rows = TRY(context.database->select_all(*table_def));
+
+                for (auto& table_row : table_rows) {
+                    auto new_row = cartesian_row;
+                    new_row.extend(table_row);
+                    rows.append(new_row);
+                }
+            }
+        }
+
+        for (auto& row : rows)
+            TRY(process_row(row));
     }
 
     if (m_limit_clause != nullptr) {
@@ -180,4 +279,20 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
     return result;
 }
 
+ResultOr<ResultSet> Explain::execute(ExecutionContext&) const
+{
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    descriptor->append({ .name = "plan", .type = SQLType::Text });
+
+    ResultSet result { SQLCommand::Explain, { "plan" } };
+
+    for (auto& step : m_select_statement->query_plan()) {
+        Tuple tuple(descriptor);
+        tuple[0] = move(step);
+        result.insert_row(tuple, Tuple {});
+    }
+
+    return result;
+}
+
 }
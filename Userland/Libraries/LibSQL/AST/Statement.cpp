@@ -22,4 +22,25 @@ ResultOr<ResultSet> Statement::execute(AK::NonnullRefPtr<Database> database, Rea
     return result;
 }
 
+ResultOr<ResultSet> Statement::execute_batch(AK::NonnullRefPtr<Database> database, ReadonlySpan<Vector<Value>> placeholder_value_sets) const
+{
+    Optional<ResultSet> result;
+
+    for (auto const& placeholder_values : placeholder_value_sets) {
+        ExecutionContext context { database, this, placeholder_values, nullptr };
+        auto execution_result = TRY(execute(context));
+
+        if (!result.has_value())
+            result = move(execution_result);
+        else
+            TRY(result->try_extend(move(execution_result)));
+    }
+
+    TRY(database->commit());
+
+    if (!result.has_value())
+        return ResultSet { SQLCommand::Unknown };
+    return result.release_value();
+}
+
 }
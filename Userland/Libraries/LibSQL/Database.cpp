@@ -184,6 +184,18 @@ ErrorOr<Vector<Row>> Database::select_all(TableDef& table)
     return ret;
 }
 
+ResultOr<void> Database::for_each_row(TableDef& table, Function<ResultOr<IterationDecision>(Row&)> callback)
+{
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+    for (auto block_index = table.block_index(); block_index;) {
+        auto row = m_serializer.deserialize_block<Row>(block_index, table, block_index);
+        block_index = row.next_block_index();
+        if (TRY(callback(row)) == IterationDecision::Break)
+            break;
+    }
+    return {};
+}
+
 ErrorOr<Vector<Row>> Database::match(TableDef& table, Key const& key)
 {
     VERIFY(m_table_cache.get(table.key().hash()).has_value());
@@ -218,6 +230,33 @@ ErrorOr<void> Database::insert(Row& row)
     return {};
 }
 
+ErrorOr<void> Database::insert(Span<Row> rows)
+{
+    if (rows.is_empty())
+        return {};
+
+    auto& table = rows.first().table();
+    VERIFY(m_table_cache.get(table.key().hash()).has_value());
+
+    // Chain the rows to each other, so that the table only has to be updated once for all of them.
+    auto next_block_index = table.block_index();
+    for (auto& row : rows) {
+        VERIFY(&row.table() == &table);
+
+        row.set_block_index(m_heap->request_new_block_index());
+        row.set_next_block_index(next_block_index);
+        TRY(update(row));
+
+        next_block_index = row.block_index();
+    }
+
+    auto table_key = table.key();
+    table_key.set_block_index(next_block_index);
+    VERIFY(m_tables->update_key_pointer(table_key));
+    table.set_block_index(next_block_index);
+    return {};
+}
+
 ErrorOr<void> Database::remove(Row& row)
 {
     auto& table = row.table();
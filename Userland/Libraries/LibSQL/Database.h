@@ -8,6 +8,8 @@
 #pragma once
 
 #include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/IterationDecision.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefPtr.h>
 #include <LibSQL/Forward.h>
@@ -32,6 +34,7 @@ public:
     bool is_open() const { return m_open; }
     ErrorOr<void> commit();
     ErrorOr<size_t> file_size_in_bytes() const { return m_heap->file_size_in_bytes(); }
+    Heap::BlockCacheStatistics const& block_cache_statistics() const { return m_heap->block_cache_statistics(); }
 
     ResultOr<void> add_schema(SchemaDef const&);
     static Key get_schema_key(ByteString const&);
@@ -42,8 +45,10 @@ public:
     ResultOr<NonnullRefPtr<TableDef>> get_table(ByteString const&, ByteString const&);
 
     ErrorOr<Vector<Row>> select_all(TableDef&);
+    ResultOr<void> for_each_row(TableDef&, Function<ResultOr<IterationDecision>(Row&)>);
     ErrorOr<Vector<Row>> match(TableDef&, Key const&);
     ErrorOr<void> insert(Row&);
+    ErrorOr<void> insert(Span<Row>);
     ErrorOr<void> remove(Row&);
     ErrorOr<void> update(Row&);
 
@@ -9,11 +9,43 @@
 #include <AK/Format.h>
 #include <AK/QuickSort.h>
 #include <LibCore/System.h>
+#include <LibCrypto/Checksum/CRC32.h>
 #include <LibSQL/Heap.h>
 #include <sys/stat.h>
 
 namespace SQL {
 
+// Every record in the log starts with this header. Block records are followed by the contents of the block, and store
+// its index in `value`. Commit records store the number of block records since the previous commit record.
+struct [[gnu::packed]] LogRecordHeader {
+    u32 magic;
+    u32 type;
+    u32 value;
+    u32 checksum;
+};
+
+static constexpr u32 LOG_RECORD_MAGIC = 0x4C415753; // "SWAL"
+
+enum class LogRecordType : u32 {
+    Block = 1,
+    Commit = 2,
+};
+
+static u32 log_record_checksum(LogRecordHeader const& header, ReadonlyBytes payload)
+{
+    Crypto::Checksum::CRC32 crc;
+    crc.update({ &header, offsetof(LogRecordHeader, checksum) });
+    crc.update(payload);
+    return crc.digest();
+}
+
+static LogRecordHeader make_log_record_header(LogRecordType type, u32 value, ReadonlyBytes payload)
+{
+    LogRecordHeader header { LOG_RECORD_MAGIC, to_underlying(type), value, 0 };
+    header.checksum = log_record_checksum(header, payload);
+    return header;
+}
+
 ErrorOr<NonnullRefPtr<Heap>> Heap::create(ByteString file_name)
 {
     return adopt_nonnull_ref_or_enomem(new (nothrow) Heap(move(file_name)));
@@ -26,17 +58,24 @@ Heap::Heap(ByteString file_name)
 
 Heap::~Heap()
 {
-    if (m_file && !m_write_ahead_log.is_empty()) {
-        if (auto maybe_error = flush(); maybe_error.is_error())
-            warnln("~Heap({}): {}", name(), maybe_error.error());
+    if (!m_file)
+        return;
+
+    if (auto maybe_error = checkpoint(); maybe_error.is_error()) {
+        warnln("~Heap({}): {}", name(), maybe_error.error());
+        return;
     }
+
+    // Everything is in the heap file now, so the log is no longer needed.
+    m_log_file = nullptr;
+    if (auto maybe_error = Core::System::unlink(log_name()); maybe_error.is_error())
+        warnln("~Heap({}): {}", name(), maybe_error.error());
 }
 
 ErrorOr<void> Heap::open()
 {
     VERIFY(!m_file);
 
-    size_t file_size = 0;
     struct stat stat_buffer;
     if (stat(name().characters(), &stat_buffer) != 0) {
         if (errno != ENOENT) {
@@ -46,21 +85,36 @@ ErrorOr<void> Heap::open()
     } else if (!S_ISREG(stat_buffer.st_mode)) {
         warnln("Heap::open({}): can only use regular files"sv, name());
         return Error::from_string_literal("Heap::open(): can only use regular files");
-    } else {
-        file_size = stat_buffer.st_size;
     }
 
+    auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
+    m_file_fd = file->fd();
+    m_file = TRY(Core::InputBufferedFile::create(move(file)));
+
+    m_block_cache_data = TRY(ByteBuffer::create_uninitialized(BLOCK_CACHE_CAPACITY * Block::SIZE));
+    m_cached_blocks.clear();
+    m_block_cache_slots.clear();
+    m_clock_hand = 0;
+
+    // Bring the heap file up to date with the commits in a log that was left behind, before looking at its contents.
+    m_log_file = TRY(Core::File::open(log_name(), Core::File::OpenMode::ReadWrite));
+    if (auto error_maybe = recover_from_log(); error_maybe.is_error()) {
+        m_file = nullptr;
+        m_log_file = nullptr;
+        return error_maybe.release_error();
+    }
+
+    TRY(m_file->seek(0, SeekMode::FromEndPosition));
+    auto file_size = TRY(m_file->tell());
     if (file_size > 0) {
         m_next_block = file_size / Block::SIZE;
         m_highest_block_written = m_next_block - 1;
     }
 
-    auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
-    m_file = TRY(Core::InputBufferedFile::create(move(file)));
-
     if (file_size > 0) {
         if (auto error_maybe = read_zero_block(); error_maybe.is_error()) {
             m_file = nullptr;
+            m_log_file = nullptr;
             return error_maybe.release_error();
         }
     } else {
@@ -71,8 +125,13 @@ ErrorOr<void> Heap::open()
     if (m_version != VERSION) {
         dbgln_if(SQL_DEBUG, "Heap file {} opened has incompatible version {}. Deleting for version {}.", name(), m_version, VERSION);
         m_file = nullptr;
+        m_log_file = nullptr;
+        m_uncommitted_blocks.clear();
+        m_next_block = 1;
+        m_highest_block_written = 0;
 
         TRY(Core::System::unlink(name()));
+        TRY(Core::System::unlink(log_name()));
         return open();
     }
 
@@ -91,13 +150,15 @@ ErrorOr<void> Heap::open()
 
 ErrorOr<size_t> Heap::file_size_in_bytes() const
 {
+    // Blocks that are only in the log will end up in the heap file at the next checkpoint.
     TRY(m_file->seek(0, SeekMode::FromEndPosition));
-    return TRY(m_file->tell());
+    auto file_size = TRY(m_file->tell());
+    return max(file_size, (m_highest_block_written + 1) * Block::SIZE);
 }
 
 bool Heap::has_block(Block::Index index) const
 {
-    return (index <= m_highest_block_written || m_write_ahead_log.contains(index))
+    return (index <= m_highest_block_written || m_uncommitted_blocks.contains(index))
         && !m_free_block_indices.contains_slow(index);
 }
 
@@ -115,10 +176,15 @@ ErrorOr<ByteBuffer> Heap::read_storage(Block::Index index)
     // Reconstruct the data storage from a potential chain of blocks
     ByteBuffer data;
     while (index > 0) {
-        auto block = TRY(read_block(index));
-        dbgln_if(SQL_DEBUG, "  -> {} bytes", block.size_in_bytes());
-        TRY(data.try_append(block.data().bytes().slice(0, block.size_in_bytes())));
-        index = block.next_block();
+        auto contents = TRY(raw_block_contents(index));
+        auto size_in_bytes = *reinterpret_cast<u32 const*>(contents.offset_pointer(0));
+        auto next_block = *reinterpret_cast<Block::Index const*>(contents.offset_pointer(sizeof(u32)));
+        if (size_in_bytes > Block::DATA_SIZE)
+            return Error::from_string_view("Block has an invalid size"sv);
+
+        dbgln_if(SQL_DEBUG, "  -> {} bytes", size_in_bytes);
+        TRY(data.try_append(contents.slice(Block::HEADER_SIZE, size_in_bytes)));
+        index = next_block;
     }
     return data;
 }
@@ -141,14 +207,12 @@ ErrorOr<void> Heap::write_storage(Block::Index index, ReadonlyBytes data)
         auto block_data_size = AK::min(remaining_size, Block::DATA_SIZE);
         remaining_size -= block_data_size;
 
-        ByteBuffer block_data;
+        // The existing data is overwritten entirely, so we only need to know where its chain continues
+        auto block_data = TRY(ByteBuffer::create_uninitialized(block_data_size));
         if (has_block(index)) {
-            auto existing_block = TRY(read_block(index));
-            block_data = existing_block.data();
-            TRY(block_data.try_resize(block_data_size));
-            existing_next_block_index = existing_block.next_block();
+            auto contents = TRY(raw_block_contents(index));
+            existing_next_block_index = *reinterpret_cast<Block::Index const*>(contents.offset_pointer(sizeof(u32)));
         } else {
-            block_data = TRY(ByteBuffer::create_uninitialized(block_data_size));
             existing_next_block_index = 0;
         }
 
@@ -177,25 +241,82 @@ ErrorOr<ByteBuffer> Heap::read_raw_block(Block::Index index)
     VERIFY(m_file);
     VERIFY(index < m_next_block);
 
-    if (auto wal_entry = m_write_ahead_log.get(index); wal_entry.has_value())
+    if (auto wal_entry = m_uncommitted_blocks.get(index); wal_entry.has_value())
         return wal_entry.value();
 
-    TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
     auto buffer = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
+    if (m_logged_blocks.contains(index)) {
+        TRY(read_block_from_log(index, buffer));
+        return buffer;
+    }
+
+    TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
     TRY(m_file->read_until_filled(buffer));
     return buffer;
 }
 
-ErrorOr<Block> Heap::read_block(Block::Index index)
+ErrorOr<ReadonlyBytes> Heap::raw_block_contents(Block::Index index)
 {
     dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
+    VERIFY(m_file);
+    VERIFY(index > 0 && index < m_next_block);
+
+    if (auto wal_entry = m_uncommitted_blocks.get(index); wal_entry.has_value())
+        return wal_entry->bytes();
+
+    if (auto slot = m_block_cache_slots.get(index); slot.has_value()) {
+        ++m_block_cache_statistics.hits;
+        m_cached_blocks[*slot].was_referenced = true;
+        return m_block_cache_data.bytes().slice(*slot * Block::SIZE, Block::SIZE);
+    }
+
+    ++m_block_cache_statistics.misses;
+    auto slot = claim_block_cache_slot();
+    auto contents = m_block_cache_data.bytes().slice(slot * Block::SIZE, Block::SIZE);
+
+    if (m_logged_blocks.contains(index)) {
+        TRY(read_block_from_log(index, contents));
+    } else {
+        TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
+        TRY(m_file->read_until_filled(contents));
+    }
+
+    m_cached_blocks[slot] = { index, true };
+    TRY(m_block_cache_slots.try_set(index, slot));
+    return contents;
+}
 
-    auto buffer = TRY(read_raw_block(index));
-    auto size_in_bytes = *reinterpret_cast<u32*>(buffer.offset_pointer(0));
-    auto next_block = *reinterpret_cast<Block::Index*>(buffer.offset_pointer(sizeof(u32)));
-    auto data = TRY(buffer.slice(Block::HEADER_SIZE, Block::DATA_SIZE));
+size_t Heap::claim_block_cache_slot()
+{
+    if (m_cached_blocks.size() < BLOCK_CACHE_CAPACITY) {
+        m_cached_blocks.append({});
+        return m_cached_blocks.size() - 1;
+    }
+
+    while (true) {
+        auto slot = m_clock_hand;
+        m_clock_hand = (m_clock_hand + 1) % m_cached_blocks.size();
+
+        auto& cached_block = m_cached_blocks[slot];
+        if (cached_block.index == 0)
+            return slot;
+
+        if (cached_block.was_referenced) {
+            cached_block.was_referenced = false;
+            continue;
+        }
 
-    return Block { index, size_in_bytes, next_block, move(data) };
+        ++m_block_cache_statistics.evictions;
+        m_block_cache_slots.remove(cached_block.index);
+        cached_block = {};
+        return slot;
+    }
+}
+
+void Heap::drop_cached_block(Block::Index index)
+{
+    if (auto slot = m_block_cache_slots.take(index); slot.has_value())
+        m_cached_blocks[*slot] = {};
 }
 
 ErrorOr<void> Heap::write_raw_block(Block::Index index, ReadonlyBytes data)
@@ -220,7 +341,12 @@ ErrorOr<void> Heap::write_raw_block_to_wal(Block::Index index, ByteBuffer&& data
     VERIFY(index < m_next_block);
     VERIFY(data.size() == Block::SIZE);
 
-    TRY(m_write_ahead_log.try_set(index, move(data)));
+    // The uncommitted blocks now have the most recent contents of this block
+    drop_cached_block(index);
+    TRY(m_uncommitted_blocks.try_set(index, move(data)));
+
+    if (m_uncommitted_blocks.size() >= MAX_UNFLUSHED_BLOCKS)
+        TRY(append_to_log(false));
 
     return {};
 }
@@ -251,16 +377,16 @@ ErrorOr<void> Heap::free_storage(Block::Index index)
     VERIFY(index > 0);
 
     while (index > 0) {
-        auto block = TRY(read_block(index));
-        TRY(free_block(block));
-        index = block.next_block();
+        auto contents = TRY(raw_block_contents(index));
+        auto next_block = *reinterpret_cast<Block::Index const*>(contents.offset_pointer(sizeof(u32)));
+        TRY(free_block(index));
+        index = next_block;
     }
     return {};
 }
 
-ErrorOr<void> Heap::free_block(Block const& block)
+ErrorOr<void> Heap::free_block(Block::Index index)
 {
-    auto index = block.index();
     dbgln_if(SQL_DEBUG, "{}({})", __FUNCTION__, index);
 
     VERIFY(index > 0);
@@ -276,18 +402,173 @@ ErrorOr<void> Heap::free_block(Block const& block)
 ErrorOr<void> Heap::flush()
 {
     VERIFY(m_file);
-    auto indices = m_write_ahead_log.keys();
+    if (m_uncommitted_blocks.is_empty() && m_uncommitted_log_records == 0)
+        return {};
+
+    TRY(append_to_log(true));
+
+    if (m_log_size >= CHECKPOINT_LOG_SIZE)
+        return checkpoint_log();
+    if (m_unsynced_commits >= COMMITS_PER_LOG_SYNC)
+        return sync_log();
+    return {};
+}
+
+ErrorOr<void> Heap::checkpoint()
+{
+    VERIFY(m_file);
+    if (!m_uncommitted_blocks.is_empty() || m_uncommitted_log_records > 0)
+        TRY(append_to_log(true));
+    return checkpoint_log();
+}
+
+ErrorOr<void> Heap::append_to_log(bool commit)
+{
+    auto indices = m_uncommitted_blocks.keys();
+    quick_sort(indices);
+
+    // Write all records with a single write, so that a commit costs one sequential write.
+    constexpr auto block_record_size = sizeof(LogRecordHeader) + Block::SIZE;
+    ByteBuffer records;
+    TRY(records.try_ensure_capacity(indices.size() * block_record_size + sizeof(LogRecordHeader)));
+
+    for (auto index : indices) {
+        auto const& data = m_uncommitted_blocks.get(index).value();
+        auto header = make_log_record_header(LogRecordType::Block, index, data);
+        records.append(&header, sizeof(header));
+        records.append(data);
+    }
+    if (commit) {
+        auto header = make_log_record_header(LogRecordType::Commit, m_uncommitted_log_records + indices.size(), {});
+        records.append(&header, sizeof(header));
+    }
+
+    TRY(m_log_file->seek(m_log_size, SeekMode::SetPosition));
+    TRY(m_log_file->write_until_depleted(records));
+
+    for (size_t i = 0; i < indices.size(); ++i) {
+        auto index = indices[i];
+        TRY(m_logged_blocks.try_set(index, m_log_size + i * block_record_size + sizeof(LogRecordHeader)));
+        if (index > m_highest_block_written)
+            m_highest_block_written = index;
+    }
+    m_log_size += records.size();
+    m_uncommitted_blocks.clear();
+
+    if (commit) {
+        m_uncommitted_log_records = 0;
+        ++m_unsynced_commits;
+    } else {
+        m_uncommitted_log_records += indices.size();
+    }
+
+    dbgln_if(SQL_DEBUG, "{} blocks appended to the log; log size = {}", indices.size(), m_log_size);
+    return {};
+}
+
+ErrorOr<void> Heap::read_block_from_log(Block::Index index, Bytes buffer)
+{
+    VERIFY(buffer.size() == Block::SIZE);
+    TRY(m_log_file->seek(m_logged_blocks.get(index).value(), SeekMode::SetPosition));
+    TRY(m_log_file->read_until_filled(buffer));
+    return {};
+}
+
+ErrorOr<void> Heap::sync_log()
+{
+    TRY(Core::System::fsync(m_log_file->fd()));
+    m_unsynced_commits = 0;
+    return {};
+}
+
+ErrorOr<void> Heap::checkpoint_log()
+{
+    VERIFY(m_uncommitted_blocks.is_empty() && m_uncommitted_log_records == 0);
+    if (m_log_size == 0)
+        return {};
+
+    // The log has to be on disk before the heap file is changed, so a crash during the checkpoint can be recovered from.
+    TRY(sync_log());
+
+    auto indices = m_logged_blocks.keys();
     quick_sort(indices);
+    auto buffer = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
     for (auto index : indices) {
-        dbgln_if(SQL_DEBUG, "Flushing block {}", index);
-        auto& data = m_write_ahead_log.get(index).value();
-        TRY(write_raw_block(index, data));
+        dbgln_if(SQL_DEBUG, "Checkpointing block {}", index);
+        TRY(read_block_from_log(index, buffer));
+        TRY(write_raw_block(index, buffer));
     }
-    m_write_ahead_log.clear();
-    dbgln_if(SQL_DEBUG, "WAL flushed; new number of blocks = {}", m_highest_block_written);
+    TRY(Core::System::fsync(m_file_fd));
+
+    TRY(m_log_file->truncate(0));
+    TRY(sync_log());
+    m_log_size = 0;
+    m_logged_blocks.clear();
+
+    dbgln_if(SQL_DEBUG, "Log checkpointed; new number of blocks = {}", m_highest_block_written);
     return {};
 }
 
+ErrorOr<void> Heap::recover_from_log()
+{
+    m_log_size = 0;
+    m_logged_blocks.clear();
+    m_uncommitted_log_records = 0;
+    m_unsynced_commits = 0;
+
+    TRY(m_log_file->seek(0, SeekMode::FromEndPosition));
+    auto log_file_size = TRY(m_log_file->tell());
+    TRY(m_log_file->seek(0, SeekMode::SetPosition));
+
+    // Read records until the end of the log, or until a record that is incomplete or corrupt, which is where a crash
+    // interrupted the last append. Blocks only count once the commit record that follows them has been read.
+    auto block = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
+    Vector<Block::Index> uncommitted_indices;
+    Vector<size_t> uncommitted_offsets;
+    size_t offset = 0;
+    while (offset + sizeof(LogRecordHeader) <= log_file_size) {
+        LogRecordHeader header;
+        TRY(m_log_file->read_until_filled(Bytes { &header, sizeof(header) }));
+        if (header.magic != LOG_RECORD_MAGIC)
+            break;
+
+        if (header.type == to_underlying(LogRecordType::Block)) {
+            if (offset + sizeof(header) + Block::SIZE > log_file_size)
+                break;
+            TRY(m_log_file->read_until_filled(block));
+            if (header.checksum != log_record_checksum(header, block))
+                break;
+
+            TRY(uncommitted_indices.try_append(header.value));
+            TRY(uncommitted_offsets.try_append(offset + sizeof(header)));
+            offset += sizeof(header) + Block::SIZE;
+        } else if (header.type == to_underlying(LogRecordType::Commit)) {
+            if (header.checksum != log_record_checksum(header, {}) || header.value != uncommitted_indices.size())
+                break;
+
+            for (size_t i = 0; i < uncommitted_indices.size(); ++i)
+                TRY(m_logged_blocks.try_set(uncommitted_indices[i], uncommitted_offsets[i]));
+            uncommitted_indices.clear_with_capacity();
+            uncommitted_offsets.clear_with_capacity();
+            offset += sizeof(header);
+            m_log_size = offset;
+        } else {
+            break;
+        }
+    }
+
+    dbgln_if(SQL_DEBUG, "Recovered {} blocks from {} bytes of log {}", m_logged_blocks.size(), log_file_size, log_name());
+
+    // Anything after the last commit is dropped along with the rest of the log.
+    if (m_logged_blocks.is_empty()) {
+        m_log_size = 0;
+        if (log_file_size > 0)
+            TRY(m_log_file->truncate(0));
+        return {};
+    }
+    return checkpoint_log();
+}
+
 constexpr static auto FILE_ID = "SerenitySQL "sv;
 constexpr static auto VERSION_OFFSET = FILE_ID.length();
 constexpr static auto SCHEMAS_ROOT_OFFSET = VERSION_OFFSET + sizeof(u32);
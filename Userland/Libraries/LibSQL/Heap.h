@@ -63,15 +63,47 @@ private:
  *
  * A Heap can be thought of the backing storage of a single database. It's
  * assumed that a single SQL database is backed by a single Heap.
+ *
+ * Written blocks are not written to the heap file directly. flush() commits
+ * them by appending them to a write-ahead log next to the heap file (named
+ * after it, with a "-wal" suffix), so that a commit costs a single sequential
+ * write. Every record in the log is checksummed, and the blocks of a commit
+ * only count once the commit record that follows them has been written.
+ *
+ * The log is synced to disk once for a group of commits, rather than for each
+ * of them: a crash may lose the most recent commits, but never leaves a commit
+ * half applied. Once the log has grown large enough, it is checkpointed: the
+ * latest version of every block in it is written to the heap file, and the
+ * log is emptied. A log that was left behind by a crash is replayed when the
+ * heap is opened.
  */
 class Heap : public RefCounted<Heap> {
 public:
     static constexpr u32 VERSION = 5;
 
+    // The number of blocks read from the file that are kept in memory.
+    static constexpr size_t BLOCK_CACHE_CAPACITY = 1024;
+
+    // The number of written blocks that are kept in memory before they are appended to the log, even without a commit.
+    static constexpr size_t MAX_UNFLUSHED_BLOCKS = 4096;
+
+    // The number of commits that are appended to the log before it is synced to disk.
+    static constexpr size_t COMMITS_PER_LOG_SYNC = 16;
+
+    // The size the log may grow to before it is checkpointed into the heap file.
+    static constexpr size_t CHECKPOINT_LOG_SIZE = 4 * MiB;
+
+    struct BlockCacheStatistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+    };
+
     static ErrorOr<NonnullRefPtr<Heap>> create(ByteString);
     virtual ~Heap();
 
     ByteString const& name() const { return m_name; }
+    ByteString log_name() const { return ByteString::formatted("{}-wal", m_name); }
 
     ErrorOr<void> open();
     ErrorOr<size_t> file_size_in_bytes() const;
@@ -119,8 +151,14 @@ public:
     ErrorOr<void> write_storage(Block::Index, ReadonlyBytes);
     ErrorOr<void> free_storage(Block::Index);
 
+    // Commits all blocks written since the last commit.
     ErrorOr<void> flush();
 
+    // Commits, and writes all committed blocks from the log to the heap file.
+    ErrorOr<void> checkpoint();
+
+    BlockCacheStatistics const& block_cache_statistics() const { return m_block_cache_statistics; }
+
 private:
     explicit Heap(ByteString);
 
@@ -128,9 +166,19 @@ private:
     ErrorOr<void> write_raw_block(Block::Index, ReadonlyBytes);
     ErrorOr<void> write_raw_block_to_wal(Block::Index, ByteBuffer&&);
 
-    ErrorOr<Block> read_block(Block::Index);
+    ErrorOr<void> append_to_log(bool commit);
+    ErrorOr<void> read_block_from_log(Block::Index, Bytes);
+    ErrorOr<void> sync_log();
+    ErrorOr<void> checkpoint_log();
+    ErrorOr<void> recover_from_log();
+
+    // Returns the contents of a block without copying them. They are only valid until the next block is read or written.
+    ErrorOr<ReadonlyBytes> raw_block_contents(Block::Index);
+    size_t claim_block_cache_slot();
+    void drop_cached_block(Block::Index);
+
     ErrorOr<void> write_block(Block const&);
-    ErrorOr<void> free_block(Block const&);
+    ErrorOr<void> free_block(Block::Index);
 
     ErrorOr<void> read_zero_block();
     ErrorOr<void> initialize_zero_block();
@@ -139,6 +187,7 @@ private:
     ByteString m_name;
 
     OwnPtr<Core::InputBufferedFile> m_file;
+    int m_file_fd { -1 };
     Block::Index m_highest_block_written { 0 };
     Block::Index m_next_block { 1 };
     Block::Index m_schemas_root { 0 };
@@ -146,8 +195,27 @@ private:
     Block::Index m_table_columns_root { 0 };
     u32 m_version { VERSION };
     Array<u32, 16> m_user_values { 0 };
-    HashMap<Block::Index, ByteBuffer> m_write_ahead_log;
+    HashMap<Block::Index, ByteBuffer> m_uncommitted_blocks;
     Vector<Block::Index> m_free_block_indices;
+
+    // The log, and where the latest version of every block in it can be found.
+    OwnPtr<Core::File> m_log_file;
+    size_t m_log_size { 0 };
+    HashMap<Block::Index, size_t> m_logged_blocks;
+    u32 m_uncommitted_log_records { 0 };
+    size_t m_unsynced_commits { 0 };
+
+    // Blocks that were read from the file, which are evicted with the clock algorithm: every slot has a bit that is set
+    // when its block is used, and the clock hand skips over (and clears) those bits while looking for a slot to reuse.
+    struct CachedBlock {
+        Block::Index index { 0 }; // Zero if the slot is unused.
+        bool was_referenced { false };
+    };
+    ByteBuffer m_block_cache_data;
+    Vector<CachedBlock> m_cached_blocks;
+    HashMap<Block::Index, size_t> m_block_cache_slots;
+    size_t m_clock_hand { 0 };
+    BlockCacheStatistics m_block_cache_statistics;
 };
 
 }
@@ -9,6 +9,8 @@
 #include "PosixParser.h"
 #include "Shell.h"
 #include <AK/ByteString.h>
+#include <AK/CharacterTypes.h>
+#include <AK/GenericLexer.h>
 #include <AK/LexicalPath.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Statistics.h>
@@ -1547,6 +1549,11 @@ ErrorOr<int> Shell::builtin_kill(Main::Arguments arguments)
     return exit_code;
 }
 
+static bool is_utility_builtin(StringView name)
+{
+    return name.is_one_of("echo"sv, "printf"sv, "test"sv, "["sv, "basename"sv, "dirname"sv);
+}
+
 ErrorOr<bool> Shell::run_builtin(const AST::Command& command, Vector<NonnullRefPtr<AST::Rewiring>> const& rewirings, int& retval)
 {
     if (command.argv.is_empty())
@@ -1555,6 +1562,10 @@ ErrorOr<bool> Shell::run_builtin(const AST::Command& command, Vector<NonnullRefP
     if (!has_builtin(command.argv.first()))
         return false;
 
+    // The builtins that stand in for utilities can be replaced by functions of the same name.
+    if (is_utility_builtin(command.argv.first()) && has_function(command.argv.first()))
+        return false;
+
     Vector<StringView> arguments;
     TRY(arguments.try_ensure_capacity(command.argv.size()));
     for (auto& arg : command.argv)
@@ -1583,6 +1594,8 @@ ErrorOr<bool> Shell::run_builtin(const AST::Command& command, Vector<NonnullRefP
 
     if (name == ":"sv)
         name = "noop"sv;
+    else if (name == "["sv)
+        name = "test"sv;
     else if (m_in_posix_mode && name == "."sv)
         name = "source"sv;
 
@@ -2250,9 +2263,601 @@ ErrorOr<int> Shell::builtin_in_parallel(Main::Arguments arguments)
     return 0;
 }
 
+static u8 parse_octal_escape(GenericLexer& lexer)
+{
+    u32 value = 0;
+    for (size_t count = 0; count < 3; ++count) {
+        auto c = lexer.peek();
+        if (!(c >= '0' && c <= '7'))
+            break;
+        value = value * 8 + (c - '0');
+        lexer.consume();
+    }
+    return min(value, 255u);
+}
+
+static Optional<u8> parse_hex_escape(GenericLexer& lexer)
+{
+    u8 value = 0;
+    for (size_t count = 0; count < 2; ++count) {
+        auto c = lexer.peek();
+        if (!is_ascii_hex_digit(c))
+            return {};
+        value = value * 16 + parse_ascii_hex_digit(c);
+        lexer.consume();
+    }
+    return value;
+}
+
+// Matches the escapes that echo(1) interprets with -e.
+static ByteString interpret_echo_escapes(StringView string, bool& no_trailing_newline)
+{
+    static constexpr auto escape_map = "a\ab\be\ef\fn\nr\rt\tv\v"sv;
+    static constexpr auto unescaped_chars = "\a\b\e\f\n\r\t\v\\"sv;
+
+    StringBuilder builder;
+    GenericLexer lexer { string };
+
+    while (!lexer.is_eof()) {
+        auto this_index = lexer.tell();
+        auto this_char = lexer.consume();
+        if (this_char != '\\') {
+            builder.append(this_char);
+            continue;
+        }
+        if (lexer.is_eof()) {
+            builder.append('\\');
+            break;
+        }
+        auto next_char = lexer.peek();
+        if (next_char == 'c') {
+            no_trailing_newline = true;
+            break;
+        }
+        if (next_char == '0') {
+            lexer.consume();
+            builder.append(parse_octal_escape(lexer));
+        } else if (next_char == 'x') {
+            lexer.consume();
+            if (auto hex_number = parse_hex_escape(lexer); hex_number.has_value())
+                builder.append(*hex_number);
+            else
+                builder.append(string.substring_view(this_index, lexer.tell() - this_index));
+        } else if (next_char == 'u') {
+            lexer.retreat();
+            if (auto code_point = lexer.consume_escaped_code_point(); !code_point.is_error())
+                builder.append_code_point(code_point.value());
+            else
+                builder.append(string.substring_view(this_index, lexer.tell() - this_index));
+        } else {
+            lexer.retreat();
+            auto consumed_char = lexer.consume_escaped_character('\\', escape_map);
+            if (!unescaped_chars.contains(consumed_char))
+                builder.append('\\');
+            builder.append(consumed_char);
+        }
+    }
+
+    return builder.to_byte_string();
+}
+
+ErrorOr<int> Shell::builtin_echo(Main::Arguments arguments)
+{
+    Vector<StringView> text;
+    bool no_trailing_newline = false;
+    bool should_interpret_backslash_escapes = false;
+
+    Core::ArgsParser parser;
+    parser.add_option(no_trailing_newline, "Do not output a trailing newline", nullptr, 'n');
+    parser.add_option(should_interpret_backslash_escapes, "Interpret backslash escapes", nullptr, 'e');
+    parser.add_positional_argument(text, "Text to print out", "text", Core::ArgsParser::Required::No);
+    parser.set_stop_on_first_non_option(true);
+
+    if (!parser.parse(arguments, Core::ArgsParser::FailureBehavior::PrintUsage))
+        return 1;
+
+    auto output = ByteString::join(' ', text);
+    if (should_interpret_backslash_escapes)
+        output = interpret_echo_escapes(output, no_trailing_newline);
+    out("{}", output);
+    if (!no_trailing_newline)
+        outln();
+    return 0;
+}
+
+// Matches the escapes that printf(1) interprets in its format string, returns an error for the ones it doesn't support.
+static ErrorOr<ByteString, StringView> interpret_printf_escapes(StringView string)
+{
+    StringBuilder builder;
+    for (size_t i = 0; i < string.length(); ++i) {
+        auto c = string[i];
+        if (c != '\\' || i + 1 == string.length()) {
+            builder.append(c);
+            continue;
+        }
+        switch (c = string[++i]) {
+        case 'a':
+            builder.append('\a');
+            break;
+        case 'b':
+            builder.append('\b');
+            break;
+        case 'c':
+            return builder.to_byte_string();
+        case 'e':
+            builder.append('\e');
+            break;
+        case 'f':
+            builder.append('\f');
+            break;
+        case 'n':
+            builder.append('\n');
+            break;
+        case 'r':
+            builder.append('\r');
+            break;
+        case 't':
+            builder.append('\t');
+            break;
+        case 'v':
+            builder.append('\v');
+            break;
+        case 'x':
+            return "Unsupported escape '\\x'"sv;
+        case 'u':
+            return "Unsupported escape '\\u'"sv;
+        case 'U':
+            return "Unsupported escape '\\U'"sv;
+        default:
+            builder.append(c);
+        }
+    }
+    return builder.to_byte_string();
+}
+
+static void append_printf_conversion(StringBuilder& builder, char const* specification, ...)
+{
+    va_list ap;
+    va_start(ap, specification);
+    builder.appendvf(specification, ap);
+    va_end(ap);
+}
+
+ErrorOr<int> Shell::builtin_printf(Main::Arguments arguments)
+{
+    if (arguments.strings.size() < 2) {
+        warnln("printf: Missing format");
+        return 1;
+    }
+
+    auto format_or_error = interpret_printf_escapes(arguments.strings[1]);
+    if (format_or_error.is_error()) {
+        warnln("printf: {}", format_or_error.error());
+        return 1;
+    }
+    auto format = format_or_error.release_value();
+    auto values = arguments.strings.slice(2);
+
+    size_t next_value = 0;
+    auto take_value = [&]() -> ByteString {
+        if (next_value == values.size())
+            return {};
+        return values[next_value++];
+    };
+
+    StringBuilder builder;
+    // Like printf(1), the format is reused for as long as it consumes values.
+    while (true) {
+        auto previous_next_value = next_value;
+        for (size_t i = 0; i < format.length(); ++i) {
+            if (format[i] != '%' || i + 1 == format.length()) {
+                builder.append(format[i]);
+                continue;
+            }
+
+            // Everything except for the conversion and its length modifiers is passed on to the formatter as-is.
+            StringBuilder specification;
+            specification.append('%');
+            for (++i; i < format.length() && "-+#0123456789."sv.contains(format[i]); ++i)
+                specification.append(format[i]);
+            while (i < format.length() && "hlLjzt"sv.contains(format[i]))
+                ++i;
+            if (i == format.length()) {
+                builder.append(specification.string_view());
+                break;
+            }
+
+            auto conversion = format[i];
+            switch (conversion) {
+            case '%':
+                builder.append('%');
+                break;
+            case 'd':
+            case 'i':
+                specification.appendff("ll{}", conversion);
+                append_printf_conversion(builder, specification.to_byte_string().characters(), strtoll(take_value().characters(), nullptr, 10));
+                break;
+            case 'o':
+            case 'u':
+            case 'x':
+            case 'X':
+                specification.appendff("ll{}", conversion);
+                append_printf_conversion(builder, specification.to_byte_string().characters(), strtoull(take_value().characters(), nullptr, 10));
+                break;
+            case 'f':
+            case 'g':
+                specification.append(conversion);
+                append_printf_conversion(builder, specification.to_byte_string().characters(), strtod(take_value().characters(), nullptr));
+                break;
+            case 'c': {
+                auto value = take_value();
+                specification.append('c');
+                append_printf_conversion(builder, specification.to_byte_string().characters(), value.is_empty() ? 0 : value[0]);
+                break;
+            }
+            case 's':
+                specification.append('s');
+                append_printf_conversion(builder, specification.to_byte_string().characters(), take_value().characters());
+                break;
+            default:
+                builder.append(specification.string_view());
+                builder.append(conversion);
+                break;
+            }
+        }
+        if (next_value == values.size() || next_value == previous_next_value)
+            break;
+    }
+
+    out("{}", builder.string_view());
+    return 0;
+}
+
+namespace {
+
+// Evaluates the expressions of test(1) in the same way that it does, but without having to start a process.
+class TestExpressionEvaluator {
+public:
+    explicit TestExpressionEvaluator(ReadonlySpan<StringView> arguments)
+        : m_arguments(arguments)
+    {
+    }
+
+    ErrorOr<bool, ByteString> evaluate()
+    {
+        auto result = TRY(parse_complex_expression(true));
+        if (m_index != m_arguments.size() - 1)
+            return ByteString("Too many arguments"sv);
+        return result.value_or(false);
+    }
+
+    bool there_was_an_error() const { return m_there_was_an_error; }
+
+private:
+    // An empty value means that there was no expression to parse. The checks that access the file system are only run
+    // if `should_evaluate` is set, so that `-a` and `-o` short-circuit like they do in test(1).
+    using Result = ErrorOr<Optional<bool>, ByteString>;
+
+    bool has_argument(size_t index) const { return index < m_arguments.size(); }
+    StringView argument(size_t index) const { return has_argument(index) ? m_arguments[index] : StringView {}; }
+
+    bool should_treat_expression_as_single_string(size_t index_of_argument_after) const
+    {
+        auto argument_after = argument(index_of_argument_after);
+        return !has_argument(index_of_argument_after) || argument_after == "-a"sv || argument_after == "-o"sv;
+    }
+
+    Optional<struct stat> status_of(StringView path, bool follow_symlinks)
+    {
+        auto status = follow_symlinks ? Core::System::stat(path) : Core::System::lstat(path);
+        if (status.is_error()) {
+            if (status.error().code() != ENOENT) {
+                warnln("test: {}: {}", path, status.error());
+                m_there_was_an_error = true;
+            }
+            return {};
+        }
+        return status.release_value();
+    }
+
+    bool check_unary_file_operator(char op, StringView path)
+    {
+        switch (op) {
+        case 'r':
+            return !Core::System::access(path, R_OK).is_error();
+        case 'w':
+            return !Core::System::access(path, W_OK).is_error();
+        case 'x':
+            return !Core::System::access(path, X_OK).is_error();
+        case 'e':
+            return !Core::System::access(path, F_OK).is_error();
+        default:
+            break;
+        }
+
+        auto status = status_of(path, op != 'h' && op != 'L');
+        if (!status.has_value())
+            return false;
+
+        switch (op) {
+        case 'b':
+            return S_ISBLK(status->st_mode);
+        case 'c':
+            return S_ISCHR(status->st_mode);
+        case 'd':
+            return S_ISDIR(status->st_mode);
+        case 'f':
+            return S_ISREG(status->st_mode);
+        case 'h':
+        case 'L':
+            return S_ISLNK(status->st_mode);
+        case 'p':
+            return S_ISFIFO(status->st_mode);
+        case 'S':
+            return S_ISSOCK(status->st_mode);
+        case 'g':
+            return status->st_mode & S_ISGID;
+        case 'k':
+            return status->st_mode & S_ISVTX;
+        case 'u':
+            return status->st_mode & S_ISUID;
+        case 'G':
+            return status->st_gid == getgid();
+        case 'O':
+            return status->st_uid == getuid();
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    bool compare_files(StringView lhs, StringView op, StringView rhs)
+    {
+        auto lhs_status = Core::System::stat(lhs);
+        if (lhs_status.is_error()) {
+            warnln("test: {}: {}", lhs, lhs_status.error());
+            m_there_was_an_error = true;
+            return false;
+        }
+        auto rhs_status = Core::System::stat(rhs);
+        if (rhs_status.is_error()) {
+            warnln("test: {}: {}", rhs, rhs_status.error());
+            m_there_was_an_error = true;
+            return false;
+        }
+
+        if (op == "-ef"sv)
+            return lhs_status.value().st_dev == rhs_status.value().st_dev && lhs_status.value().st_ino == rhs_status.value().st_ino;
+        if (op == "-nt"sv)
+            return lhs_status.value().st_mtime > rhs_status.value().st_mtime;
+        return lhs_status.value().st_mtime < rhs_status.value().st_mtime;
+    }
+
+    static ErrorOr<bool, ByteString> compare_numbers(StringView lhs, StringView op, StringView rhs)
+    {
+        auto lhs_number = lhs.to_number<int>();
+        if (!lhs_number.has_value())
+            return ByteString::formatted("expected integer expression: '{}'", lhs);
+        auto rhs_number = rhs.to_number<int>();
+        if (!rhs_number.has_value())
+            return ByteString::formatted("expected integer expression: '{}'", rhs);
+
+        if (op == "-eq"sv)
+            return *lhs_number == *rhs_number;
+        if (op == "-ge"sv)
+            return *lhs_number >= *rhs_number;
+        if (op == "-gt"sv)
+            return *lhs_number > *rhs_number;
+        if (op == "-le"sv)
+            return *lhs_number <= *rhs_number;
+        if (op == "-lt"sv)
+            return *lhs_number < *rhs_number;
+        return *lhs_number != *rhs_number;
+    }
+
+    Result parse_simple_expression(bool should_evaluate)
+    {
+        if (!has_argument(m_index))
+            return Optional<bool> {};
+
+        auto arg = argument(m_index);
+        if (arg == "("sv) {
+            ++m_index;
+            auto result = TRY(parse_complex_expression(should_evaluate));
+            if (result.has_value() && has_argument(m_index) && argument(++m_index) == ")"sv)
+                return result;
+            return ByteString("Unmatched ("sv);
+        }
+
+        // Try to read a unary operator.
+        if (arg.starts_with('-') && arg.length() == 2) {
+            if (!has_argument(++m_index))
+                return ByteString("expected an argument"sv);
+            if (should_treat_expression_as_single_string(m_index)) {
+                --m_index;
+                return true;
+            }
+
+            auto value = argument(m_index);
+            switch (arg[1]) {
+            case 'b':
+            case 'c':
+            case 'd':
+            case 'f':
+            case 'h':
+            case 'L':
+            case 'p':
+            case 'S':
+            case 'r':
+            case 'w':
+            case 'x':
+            case 'e':
+            case 'g':
+            case 'k':
+            case 'u':
+            case 'G':
+            case 'O':
+                return should_evaluate && check_unary_file_operator(arg[1], value);
+            case 'o':
+            case 'a':
+                // These are boolean operators, which are part of a complex expression.
+                --m_index;
+                return Optional<bool> {};
+            case 'n':
+                return !value.is_empty();
+            case 'z':
+                return value.is_empty();
+            case 'N':
+            case 's':
+                return ByteString::formatted("Unsupported operator {}", arg);
+            default:
+                --m_index;
+                break;
+            }
+        }
+
+        // Try to read a binary operator.
+        auto lhs = arg;
+        auto op = argument(++m_index);
+        auto has_op = has_argument(m_index);
+
+        if (has_op && (op == "="sv || op == "!="sv)) {
+            auto rhs = argument(++m_index);
+            return (lhs == rhs) == (op == "="sv);
+        }
+        if (has_op && op.is_one_of("-eq"sv, "-ge"sv, "-gt"sv, "-le"sv, "-lt"sv, "-ne"sv)) {
+            auto rhs = argument(++m_index);
+            return TRY(compare_numbers(lhs, op, rhs));
+        }
+        if (has_op && op.is_one_of("-ef"sv, "-nt"sv, "-ot"sv)) {
+            auto rhs = argument(++m_index);
+            return should_evaluate && compare_files(lhs, op, rhs);
+        }
+        if (has_op && (op == "-o"sv || op == "-a"sv)) {
+            --m_index;
+            return !lhs.is_empty();
+        }
+
+        // Now that we know it's not a well-formed expression, see if it's actually a negation.
+        if (lhs == "!"sv) {
+            if (should_treat_expression_as_single_string(m_index))
+                return true;
+
+            auto result = TRY(parse_complex_expression(should_evaluate));
+            if (!result.has_value())
+                return ByteString("Expected an expression after !"sv);
+            return !*result;
+        }
+
+        --m_index;
+        return !lhs.is_empty();
+    }
+
+    Result parse_complex_expression(bool should_evaluate)
+    {
+        auto result = TRY(parse_simple_expression(should_evaluate));
+
+        while (has_argument(m_index) && has_argument(m_index + 1)) {
+            if (!result.has_value())
+                return ByteString("expected an expression"sv);
+
+            auto op = argument(++m_index);
+            if (op != "-a"sv && op != "-o"sv) {
+                // Looked too far.
+                --m_index;
+                return result;
+            }
+            if (!has_argument(++m_index))
+                return ByteString("expected an expression"sv);
+
+            auto is_and = op == "-a"sv;
+            auto rhs = TRY(parse_complex_expression(should_evaluate && *result == is_and));
+            if (!rhs.has_value())
+                return ByteString("Missing right-hand side"sv);
+
+            result = is_and ? (*result && *rhs) : (*result || *rhs);
+        }
+
+        return result;
+    }
+
+    ReadonlySpan<StringView> m_arguments;
+    size_t m_index { 0 };
+    bool m_there_was_an_error { false };
+};
+
+}
+
+ErrorOr<int> Shell::builtin_test(Main::Arguments arguments)
+{
+    auto expression = arguments.strings.slice(1);
+    if (arguments.strings[0] == "["sv) {
+        if (expression.is_empty() || expression.last() != "]"sv) {
+            warnln("test: test invoked as '[' requires a closing bracket ']'");
+            return 126;
+        }
+        expression = expression.slice(0, expression.size() - 1);
+    }
+
+    // Exit false when no arguments are given.
+    if (expression.is_empty())
+        return 1;
+
+    TestExpressionEvaluator evaluator { expression };
+    auto result = evaluator.evaluate();
+    if (result.is_error()) {
+        warnln("test: {}", result.error());
+        return 126;
+    }
+
+    if (evaluator.there_was_an_error())
+        return 126;
+    return result.value() ? 0 : 1;
+}
+
+ErrorOr<int> Shell::builtin_basename(Main::Arguments arguments)
+{
+    StringView path;
+    StringView suffix;
+
+    Core::ArgsParser parser;
+    parser.set_general_help("Return the filename portion of the given path.");
+    parser.add_positional_argument(path, "Path to get basename from", "path");
+    parser.add_positional_argument(suffix, "Suffix to strip from name", "suffix", Core::ArgsParser::Required::No);
+
+    if (!parser.parse(arguments, Core::ArgsParser::FailureBehavior::PrintUsage))
+        return 1;
+
+    auto result = LexicalPath::basename(path);
+    if (!suffix.is_null() && result.length() != suffix.length() && result.ends_with(suffix))
+        result = result.substring_view(0, result.length() - suffix.length());
+
+    outln("{}", result);
+    return 0;
+}
+
+ErrorOr<int> Shell::builtin_dirname(Main::Arguments arguments)
+{
+    bool null_terminated = false;
+    Vector<StringView> paths;
+
+    Core::ArgsParser parser;
+    parser.set_general_help("Return the directory portion of the given path(s).");
+    parser.add_option(null_terminated, "End each output line with \\0, rather than \\n", "zero", 'z');
+    parser.add_positional_argument(paths, "Path to get dirname from", "path");
+
+    if (!parser.parse(arguments, Core::ArgsParser::FailureBehavior::PrintUsage))
+        return 1;
+
+    auto const delimiter = null_terminated ? '\0' : '\n';
+    for (auto const& path : paths)
+        out("{}{}", LexicalPath::dirname(path), delimiter);
+
+    return 0;
+}
+
 bool Shell::has_builtin(StringView name) const
 {
-    if (name == ":"sv || (m_in_posix_mode && name == "."sv))
+    if (name == ":"sv || name == "["sv || (m_in_posix_mode && name == "."sv))
         return true;
 
 #define __ENUMERATE_SHELL_BUILTIN(builtin, mode)                            \
@@ -643,7 +643,17 @@ int Shell::run_command(StringView cmd, Optional<SourcePosition> source_position_
     if (cmd.is_empty())
         return 0;
 
-    auto command = parse(cmd, m_is_interactive);
+    return run_parsed_command(parse(cmd, m_is_interactive));
+}
+
+int Shell::run_parsed_command(RefPtr<AST::Node> const& command)
+{
+    VERIFY(!m_default_constructed);
+
+    take_error();
+
+    if (!last_return_code.has_value())
+        last_return_code = 0;
 
     if (!command)
         return 0;
@@ -764,7 +774,14 @@ ErrorOr<RefPtr<Job>> Shell::run_command(const AST::Command& command)
     for (auto& redirection : command.redirections)
         TRY(resolve_redirection(redirection));
 
+    auto report_time_taken = [&](Core::ElapsedTimer const& timer) {
+        if (options.profile_commands)
+            warnln("Time: {} ms: {}", timer.elapsed(), command);
+    };
+
+    auto timer = Core::ElapsedTimer::start_new();
     if (int local_return_code = 0; command.should_wait && TRY(run_builtin(command, rewirings, local_return_code))) {
+        report_time_taken(timer);
         last_return_code = local_return_code;
         for (auto& next_in_chain : command.next_chain)
             run_tail(command, next_in_chain, *last_return_code);
@@ -779,6 +796,7 @@ ErrorOr<RefPtr<Job>> Shell::run_command(const AST::Command& command)
             TRY(Core::System::dup2(rewiring->old_fd, rewiring->new_fd));
 
         if (int local_return_code = 0; invoke_function(command, local_return_code)) {
+            report_time_taken(timer);
             last_return_code = local_return_code;
             for (auto& next_in_chain : command.next_chain)
                 run_tail(command, next_in_chain, *last_return_code);
@@ -919,6 +937,9 @@ ErrorOr<RefPtr<Job>> Shell::run_command(const AST::Command& command)
         if (!job->exited())
             return;
 
+        if (options.profile_commands)
+            warnln("Time: {} ms: {}", job->timer().elapsed(), job->cmd());
+
         if (job->is_running_in_background() && job->should_announce_exit())
             warnln("Shell: Job {} ({}) exited\n", job->job_id(), job->cmd());
         else if (job->signaled() && job->should_announce_signal())
@@ -1133,6 +1154,18 @@ Vector<NonnullRefPtr<Job>> Shell::run_commands(Vector<AST::Command>& commands)
     return spawned_jobs;
 }
 
+static bool is_same_script(auto const& parsed_script, struct stat const& status, bool in_posix_mode)
+{
+    // The change time is compared as well, since the file could have been rewritten within the granularity of the
+    // modification time without changing its size.
+    return parsed_script.parsed_in_posix_mode == in_posix_mode
+        && parsed_script.status.st_dev == status.st_dev
+        && parsed_script.status.st_ino == status.st_ino
+        && parsed_script.status.st_size == status.st_size
+        && parsed_script.status.st_mtime == status.st_mtime
+        && parsed_script.status.st_ctime == status.st_ctime;
+}
+
 bool Shell::run_file(ByteString const& filename, bool explicitly_invoked)
 {
     TemporaryChange script_change { current_script, filename };
@@ -1149,6 +1182,16 @@ bool Shell::run_file(ByteString const& filename, bool explicitly_invoked)
         return false;
     }
     auto file = file_or_error.release_value();
+
+    auto status_or_error = Core::System::fstat(file->fd());
+    if (!status_or_error.is_error()) {
+        if (auto cached = m_parsed_scripts.get(filename); cached.has_value() && is_same_script(*cached, status_or_error.value(), m_in_posix_mode)) {
+            // Keep the node alive, as the script could source itself and replace the cache entry.
+            RefPtr<AST::Node> node = cached->node;
+            return run_parsed_command(node) == 0;
+        }
+    }
+
     auto data_or_error = file->read_until_eof();
     if (data_or_error.is_error()) {
         auto error = ByteString::formatted("'{}': {}", escape_token_for_single_quotes(filename), data_or_error.error());
@@ -1158,7 +1201,13 @@ bool Shell::run_file(ByteString const& filename, bool explicitly_invoked)
             dbgln("reading after open() failed for {}", error);
         return false;
     }
-    return run_command(data_or_error.value()) == 0;
+
+    if (status_or_error.is_error())
+        return run_command(data_or_error.value()) == 0;
+
+    auto node = data_or_error.value().is_empty() ? nullptr : parse(data_or_error.value(), false);
+    m_parsed_scripts.set(filename, { status_or_error.value(), m_in_posix_mode, node });
+    return run_parsed_command(node) == 0;
 }
 
 bool Shell::is_allowed_to_modify_termios(const AST::Command& command) const
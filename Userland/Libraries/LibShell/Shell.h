@@ -22,56 +22,63 @@
 #include <LibCore/Notifier.h>
 #include <LibLine/Editor.h>
 #include <LibMain/Main.h>
+#include <sys/stat.h>
 #include <termios.h>
 
-#define ENUMERATE_SHELL_BUILTINS()                           \
-    __ENUMERATE_SHELL_BUILTIN(alias, InAllModes)             \
-    __ENUMERATE_SHELL_BUILTIN(where, InAllModes)             \
-    __ENUMERATE_SHELL_BUILTIN(cd, InAllModes)                \
-    __ENUMERATE_SHELL_BUILTIN(cdh, InAllModes)               \
-    __ENUMERATE_SHELL_BUILTIN(command, InAllModes)           \
-    __ENUMERATE_SHELL_BUILTIN(pwd, InAllModes)               \
-    __ENUMERATE_SHELL_BUILTIN(type, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(exec, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(eval, OnlyInPOSIXMode)         \
-    __ENUMERATE_SHELL_BUILTIN(exit, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(export, InAllModes)            \
-    __ENUMERATE_SHELL_BUILTIN(glob, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(unalias, InAllModes)           \
-    __ENUMERATE_SHELL_BUILTIN(unset, InAllModes)             \
-    __ENUMERATE_SHELL_BUILTIN(set, InAllModes)               \
-    __ENUMERATE_SHELL_BUILTIN(history, InAllModes)           \
-    __ENUMERATE_SHELL_BUILTIN(umask, InAllModes)             \
-    __ENUMERATE_SHELL_BUILTIN(not, InAllModes)               \
-    __ENUMERATE_SHELL_BUILTIN(dirs, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(pushd, InAllModes)             \
-    __ENUMERATE_SHELL_BUILTIN(popd, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(setopt, InAllModes)            \
-    __ENUMERATE_SHELL_BUILTIN(shift, InAllModes)             \
-    __ENUMERATE_SHELL_BUILTIN(source, InAllModes)            \
-    __ENUMERATE_SHELL_BUILTIN(time, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(jobs, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(disown, InAllModes)            \
-    __ENUMERATE_SHELL_BUILTIN(fg, InAllModes)                \
-    __ENUMERATE_SHELL_BUILTIN(bg, InAllModes)                \
-    __ENUMERATE_SHELL_BUILTIN(wait, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(dump, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(kill, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(reset, InAllModes)             \
-    __ENUMERATE_SHELL_BUILTIN(noop, InAllModes)              \
-    __ENUMERATE_SHELL_BUILTIN(break, OnlyInPOSIXMode)        \
-    __ENUMERATE_SHELL_BUILTIN(continue, OnlyInPOSIXMode)     \
-    __ENUMERATE_SHELL_BUILTIN(return, InAllModes)            \
-    __ENUMERATE_SHELL_BUILTIN(read, OnlyInPOSIXMode)         \
-    __ENUMERATE_SHELL_BUILTIN(run_with_env, OnlyInPOSIXMode) \
-    __ENUMERATE_SHELL_BUILTIN(argsparser_parse, InAllModes)  \
-    __ENUMERATE_SHELL_BUILTIN(in_parallel, InAllModes)       \
-    __ENUMERATE_SHELL_BUILTIN(shell_set_active_prompt, InAllModes)
+#define ENUMERATE_SHELL_BUILTINS()                                 \
+    __ENUMERATE_SHELL_BUILTIN(alias, InAllModes)                   \
+    __ENUMERATE_SHELL_BUILTIN(where, InAllModes)                   \
+    __ENUMERATE_SHELL_BUILTIN(cd, InAllModes)                      \
+    __ENUMERATE_SHELL_BUILTIN(cdh, InAllModes)                     \
+    __ENUMERATE_SHELL_BUILTIN(command, InAllModes)                 \
+    __ENUMERATE_SHELL_BUILTIN(pwd, InAllModes)                     \
+    __ENUMERATE_SHELL_BUILTIN(type, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(exec, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(eval, OnlyInPOSIXMode)               \
+    __ENUMERATE_SHELL_BUILTIN(exit, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(export, InAllModes)                  \
+    __ENUMERATE_SHELL_BUILTIN(glob, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(unalias, InAllModes)                 \
+    __ENUMERATE_SHELL_BUILTIN(unset, InAllModes)                   \
+    __ENUMERATE_SHELL_BUILTIN(set, InAllModes)                     \
+    __ENUMERATE_SHELL_BUILTIN(history, InAllModes)                 \
+    __ENUMERATE_SHELL_BUILTIN(umask, InAllModes)                   \
+    __ENUMERATE_SHELL_BUILTIN(not, InAllModes)                     \
+    __ENUMERATE_SHELL_BUILTIN(dirs, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(pushd, InAllModes)                   \
+    __ENUMERATE_SHELL_BUILTIN(popd, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(setopt, InAllModes)                  \
+    __ENUMERATE_SHELL_BUILTIN(shift, InAllModes)                   \
+    __ENUMERATE_SHELL_BUILTIN(source, InAllModes)                  \
+    __ENUMERATE_SHELL_BUILTIN(time, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(jobs, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(disown, InAllModes)                  \
+    __ENUMERATE_SHELL_BUILTIN(fg, InAllModes)                      \
+    __ENUMERATE_SHELL_BUILTIN(bg, InAllModes)                      \
+    __ENUMERATE_SHELL_BUILTIN(wait, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(dump, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(kill, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(reset, InAllModes)                   \
+    __ENUMERATE_SHELL_BUILTIN(noop, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(break, OnlyInPOSIXMode)              \
+    __ENUMERATE_SHELL_BUILTIN(continue, OnlyInPOSIXMode)           \
+    __ENUMERATE_SHELL_BUILTIN(return, InAllModes)                  \
+    __ENUMERATE_SHELL_BUILTIN(read, OnlyInPOSIXMode)               \
+    __ENUMERATE_SHELL_BUILTIN(run_with_env, OnlyInPOSIXMode)       \
+    __ENUMERATE_SHELL_BUILTIN(argsparser_parse, InAllModes)        \
+    __ENUMERATE_SHELL_BUILTIN(in_parallel, InAllModes)             \
+    __ENUMERATE_SHELL_BUILTIN(shell_set_active_prompt, InAllModes) \
+    __ENUMERATE_SHELL_BUILTIN(echo, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(printf, InAllModes)                  \
+    __ENUMERATE_SHELL_BUILTIN(test, InAllModes)                    \
+    __ENUMERATE_SHELL_BUILTIN(basename, InAllModes)                \
+    __ENUMERATE_SHELL_BUILTIN(dirname, InAllModes)
 
 #define ENUMERATE_SHELL_OPTIONS()                                                                                    \
     __ENUMERATE_SHELL_OPTION(inline_exec_keep_empty_segments, false, "Keep empty segments in inline execute $(...)") \
     __ENUMERATE_SHELL_OPTION(verbose, false, "Announce every command that is about to be executed")                  \
-    __ENUMERATE_SHELL_OPTION(invoke_program_for_autocomplete, false, "Attempt to use the program being completed itself for autocompletion via --complete")
+    __ENUMERATE_SHELL_OPTION(invoke_program_for_autocomplete, false, "Attempt to use the program being completed itself for autocompletion via --complete") \
+    __ENUMERATE_SHELL_OPTION(profile_commands, false, "Report the time every command took once it has finished")
 
 #define ENUMERATE_SHELL_IMMEDIATE_FUNCTIONS()                          \
     __ENUMERATE_SHELL_IMMEDIATE_FUNCTION(concat_lists)                 \
@@ -169,6 +176,7 @@ public:
     };
 
     int run_command(StringView, Optional<SourcePosition> = {});
+    int run_parsed_command(RefPtr<AST::Node> const&);
     Optional<RunnablePath> runnable_path_for(StringView);
     Optional<ByteString> help_path_for(Vector<RunnablePath> visited, RunnablePath const& runnable_path);
     ErrorOr<RefPtr<Job>> run_command(const AST::Command&);
@@ -481,6 +489,7 @@ private:
         // clang-format off
         // Clang-format does not properly indent this, it gives it 4 spaces too few.
             ":"sv, // POSIX-y name for "noop".
+            "["sv, // Alias for "test" that requires a closing bracket.
         // clang-format on
     };
 
@@ -496,6 +505,15 @@ private:
     pid_t m_pid { 0 };
 
     HashMap<ByteString, ShellFunction> m_functions;
+
+    // Scripts that are sourced repeatedly (e.g. from a loop, or by many other scripts) are only parsed again once they
+    // have changed on disk.
+    struct ParsedScript {
+        struct stat status {};
+        bool parsed_in_posix_mode { false };
+        RefPtr<AST::Node> node;
+    };
+    HashMap<ByteString, ParsedScript> m_parsed_scripts;
     Vector<NonnullOwnPtr<LocalFrame>> m_local_frames;
     Promise::List m_active_promises;
     Vector<NonnullRefPtr<AST::Redirection>> m_global_redirections;
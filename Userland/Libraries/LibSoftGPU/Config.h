@@ -23,6 +23,9 @@ static constexpr int MAX_CLIP_PLANES = 6;
 static constexpr int MAX_TEXTURE_SIZE = 2048;
 static constexpr float MAX_TEXTURE_LOD_BIAS = 2.f;
 static constexpr int SUBPIXEL_BITS = 4;
+// The size of the screen tiles that triangles are sorted into, so that separate tiles can be drawn at the same time.
+// This has to be even, as pixels are drawn in 2x2 quads.
+static constexpr int RASTERIZER_TILE_SIZE = 64;
 
 static constexpr int NUM_SHADER_INPUTS = 64;
 
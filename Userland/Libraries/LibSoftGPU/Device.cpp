@@ -25,6 +25,7 @@
 #include <LibSoftGPU/SIMD.h>
 #include <LibSoftGPU/Shader.h>
 #include <LibSoftGPU/ShaderCompiler.h>
+#include <LibThreading/ParallelAlgorithms.h>
 #include <math.h>
 
 namespace SoftGPU {
@@ -222,7 +223,7 @@ ALWAYS_INLINE static Vector4<f32x4> blend_colors(
 }
 
 template<typename CB1, typename CB2, typename CB3>
-ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_coverage_mask, CB2 set_quad_depth, CB3 set_quad_attributes)
+ALWAYS_INLINE void Device::rasterize(ShaderProcessor& shader_processor, Gfx::IntRect& render_bounds, CB1 set_coverage_mask, CB2 set_quad_depth, CB3 set_quad_attributes)
 {
     // Return if alpha testing is a no-op
     if (m_options.enable_alpha_test && m_options.alpha_test_func == GPU::AlphaTestFunction::Never)
@@ -300,7 +301,6 @@ ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_covera
     }
 
     // Rasterize all quads
-    // FIXME: this could be embarrassingly parallel
     for (int qy = qy0; qy <= qy1; qy += 2) {
         for (int qx = qx0; qx <= qx1; qx += 2) {
             PixelQuad quad;
@@ -453,7 +453,7 @@ ALWAYS_INLINE void Device::rasterize(Gfx::IntRect& render_bounds, CB1 set_covera
             INCREASE_STATISTICS_COUNTER(g_num_pixels_shaded, maskcount(quad.mask));
 
             set_quad_attributes(quad);
-            shade_fragments(quad);
+            shade_fragments(quad, shader_processor);
 
             // Alpha testing
             if (m_options.enable_alpha_test) {
@@ -544,6 +544,7 @@ void Device::rasterize_line_antialiased(GPU::Vertex& from, GPU::Vertex& to)
     // FIXME: performance-wise, this might be the absolute worst way to draw an anti-aliased line
     f32x4 distance_along_line;
     rasterize(
+        m_shader_processor,
         render_bounds,
         [&from_coords4, &distance_along_line, &line_vector4, &line_dot4, &line_radius](auto& quad) {
             auto const screen_coordinates4 = to_vec2_f32x4(quad.screen_coordinates);
@@ -600,6 +601,7 @@ void Device::rasterize_point_aliased(GPU::Vertex& point)
 
     // Rasterize the point as a rect
     rasterize(
+        m_shader_processor,
         point_rect,
         [](auto& quad) {
             // We already passed in point_rect, so this doesn't matter
@@ -632,6 +634,7 @@ void Device::rasterize_point_antialiased(GPU::Vertex& point)
 
     // Rasterize using a 2D signed distance field for a circle
     rasterize(
+        m_shader_processor,
         render_bounds,
         [&center4, &radius](auto& quad) {
             auto screen_coords = to_vec2_f32x4(quad.screen_coordinates);
@@ -661,7 +664,7 @@ void Device::rasterize_point(GPU::Vertex& point)
         rasterize_point_aliased(point);
 }
 
-void Device::rasterize_triangle(Triangle& triangle)
+bool Device::set_up_triangle(Triangle& triangle) const
 {
     INCREASE_STATISTICS_COUNTER(g_num_rasterized_triangles, 1);
 
@@ -671,25 +674,49 @@ void Device::rasterize_triangle(Triangle& triangle)
 
     auto triangle_area = edge_function(v0, v1, v2);
     if (triangle_area == 0)
-        return;
+        return false;
 
     // Perform face culling
     if (m_options.enable_culling) {
         bool is_front = (m_options.front_face == GPU::WindingOrder::CounterClockwise ? triangle_area > 0 : triangle_area < 0);
 
         if (!is_front && m_options.cull_back)
-            return;
+            return false;
 
         if (is_front && m_options.cull_front)
-            return;
+            return false;
     }
 
     // Force counter-clockwise ordering of vertices
-    if (triangle_area < 0) {
+    if (triangle_area < 0)
         swap(triangle.vertices[0], triangle.vertices[1]);
-        swap(v0, v1);
-        triangle_area *= -1;
-    }
+
+    return true;
+}
+
+Gfx::IntRect Device::triangle_render_bounds(Triangle const& triangle)
+{
+    auto v0 = (triangle.vertices[0].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+    auto v1 = (triangle.vertices[1].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+    auto v2 = (triangle.vertices[2].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+
+    Gfx::IntRect render_bounds;
+    render_bounds.set_left(min(min(v0.x(), v1.x()), v2.x()) / subpixel_factor);
+    render_bounds.set_right(max(max(v0.x(), v1.x()), v2.x()) / subpixel_factor + 1);
+    render_bounds.set_top(min(min(v0.y(), v1.y()), v2.y()) / subpixel_factor);
+    render_bounds.set_bottom(max(max(v0.y(), v1.y()), v2.y()) / subpixel_factor + 1);
+    return render_bounds;
+}
+
+void Device::rasterize_triangle(Triangle const& triangle, Gfx::IntRect const& clip_rect, ShaderProcessor& shader_processor)
+{
+    auto v0 = (triangle.vertices[0].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+    auto v1 = (triangle.vertices[1].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+    auto v2 = (triangle.vertices[2].window_coordinates.xy() * subpixel_factor).to_rounded<int>();
+
+    // set_up_triangle() has already made sure that the vertices are in counter-clockwise order.
+    auto triangle_area = edge_function(v0, v1, v2);
+    VERIFY(triangle_area > 0);
 
     auto const& vertex0 = triangle.vertices[0];
     auto const& vertex1 = triangle.vertices[1];
@@ -724,11 +751,7 @@ void Device::rasterize_triangle(Triangle& triangle)
     };
 
     // Calculate render bounds based on the triangle's vertices
-    Gfx::IntRect render_bounds;
-    render_bounds.set_left(min(min(v0.x(), v1.x()), v2.x()) / subpixel_factor);
-    render_bounds.set_right(max(max(v0.x(), v1.x()), v2.x()) / subpixel_factor + 1);
-    render_bounds.set_top(min(min(v0.y(), v1.y()), v2.y()) / subpixel_factor);
-    render_bounds.set_bottom(max(max(v0.y(), v1.y()), v2.y()) / subpixel_factor + 1);
+    auto render_bounds = triangle_render_bounds(triangle);
 
     // Calculate depth of fragment for fog;
     // OpenGL 1.5 chapter 3.10: "An implementation may choose to approximate the
@@ -771,7 +794,12 @@ void Device::rasterize_triangle(Triangle& triangle)
         expand4(vertex2.window_coordinates.z() + depth_offset),
     };
 
+    // Only the part of the triangle inside the clip rect is drawn, but everything above depends on the whole triangle so
+    // that the pixels of a triangle that is split over several tiles don't depend on where the tiles are.
+    render_bounds.intersect(clip_rect);
+
     rasterize(
+        shader_processor,
         render_bounds,
         [&](auto& quad) {
             auto edge_values = calculate_edge_values4(quad.screen_coordinates * subpixel_factor + half_pixel_offset);
@@ -1186,14 +1214,82 @@ void Device::draw_primitives(GPU::PrimitiveType primitive_type, Vector<GPU::Vert
         }
     }
 
-    for (auto& triangle : m_processed_triangles)
-        rasterize_triangle(triangle);
+    // Cull the triangles and bring their vertices into counter-clockwise order before they're shared between tiles.
+    m_processed_triangles.remove_all_matching([&](auto& triangle) { return !set_up_triangle(triangle); });
+    rasterize_triangles();
+}
+
+void Device::rasterize_triangles()
+{
+    auto const frame_buffer_rect = m_frame_buffer->rect();
+
+    // The statistics counters aren't atomic, so everything stays on this thread while they're being collected.
+    if constexpr (ENABLE_STATISTICS_OVERLAY) {
+        for (auto const& triangle : m_processed_triangles)
+            rasterize_triangle(triangle, frame_buffer_rect, m_shader_processor);
+        return;
+    }
+
+    // Sort the triangles into bins for the screen tiles they touch. As every pixel belongs to exactly one tile, the tiles
+    // can be drawn at the same time, and drawing each tile's triangles in order keeps the results of blending and depth
+    // testing the same as drawing all triangles one after another.
+    auto const tile_columns = ceil_div(frame_buffer_rect.width(), RASTERIZER_TILE_SIZE);
+    auto const tile_rows = ceil_div(frame_buffer_rect.height(), RASTERIZER_TILE_SIZE);
+    m_tile_triangles.resize(tile_columns * tile_rows);
+    for (auto& triangles : m_tile_triangles)
+        triangles.clear_with_capacity();
+
+    for (u32 triangle_index = 0; triangle_index < m_processed_triangles.size(); ++triangle_index) {
+        auto bounds = triangle_render_bounds(m_processed_triangles[triangle_index]).intersected(frame_buffer_rect);
+        if (m_options.scissor_enabled)
+            bounds.intersect(m_options.scissor_box);
+        if (bounds.is_empty())
+            continue;
+
+        auto const first_column = (bounds.left() - frame_buffer_rect.left()) / RASTERIZER_TILE_SIZE;
+        auto const last_column = (bounds.right() - 1 - frame_buffer_rect.left()) / RASTERIZER_TILE_SIZE;
+        auto const first_row = (bounds.top() - frame_buffer_rect.top()) / RASTERIZER_TILE_SIZE;
+        auto const last_row = (bounds.bottom() - 1 - frame_buffer_rect.top()) / RASTERIZER_TILE_SIZE;
+        for (auto row = first_row; row <= last_row; ++row) {
+            for (auto column = first_column; column <= last_column; ++column)
+                m_tile_triangles[row * tile_columns + column].append(triangle_index);
+        }
+    }
+
+    m_active_tiles.clear_with_capacity();
+    for (u32 tile_index = 0; tile_index < m_tile_triangles.size(); ++tile_index) {
+        if (!m_tile_triangles[tile_index].is_empty())
+            m_active_tiles.append(tile_index);
+    }
+
+    auto rasterize_tile = [&](u32 tile_index, ShaderProcessor& shader_processor) {
+        auto const tile_rect = Gfx::IntRect {
+            frame_buffer_rect.left() + static_cast<int>(tile_index % tile_columns) * RASTERIZER_TILE_SIZE,
+            frame_buffer_rect.top() + static_cast<int>(tile_index / tile_columns) * RASTERIZER_TILE_SIZE,
+            RASTERIZER_TILE_SIZE,
+            RASTERIZER_TILE_SIZE,
+        };
+        for (auto triangle_index : m_tile_triangles[tile_index])
+            rasterize_triangle(m_processed_triangles[triangle_index], tile_rect, shader_processor);
+    };
+
+    if (m_active_tiles.size() == 1) {
+        rasterize_tile(m_active_tiles.first(), m_shader_processor);
+        return;
+    }
+
+    Threading::parallel_for(m_active_tiles.span(), 1, [&](Span<u32> tiles) {
+        // The shader processor keeps its registers in itself, so every thread needs its own.
+        auto shader_processor = make<ShaderProcessor>(m_samplers);
+        for (auto tile_index : tiles)
+            rasterize_tile(tile_index, *shader_processor);
+    });
 }
 
-ALWAYS_INLINE void Device::shade_fragments(PixelQuad& quad)
+ALWAYS_INLINE void Device::shade_fragments(PixelQuad& quad, ShaderProcessor& shader_processor)
 {
     if (m_current_fragment_shader) {
-        m_shader_processor.execute(quad, *m_current_fragment_shader);
+        shader_processor.execute(quad, *m_current_fragment_shader);
         return;
     }
 
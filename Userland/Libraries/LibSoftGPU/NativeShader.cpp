@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibCore/System.h>
+#include <LibJIT/Assembler.h>
+#include <LibSoftGPU/NativeShader.h>
+#include <LibSoftGPU/PixelQuad.h>
+#include <LibSoftGPU/ShaderProcessor.h>
+#include <sys/mman.h>
+
+namespace SoftGPU {
+
+using AK::SIMD::f32x4;
+
+#if JIT_ARCH_SUPPORTED
+
+using Assembler = ::JIT::Assembler;
+using Reg = Assembler::Reg;
+using Operand = Assembler::Operand;
+
+// The arguments of run() are pinned to callee-saved registers, so that they survive calls into the shader processor.
+// NOTE: R12 and R13 can't be used as the base of a memory operand by the assembler.
+static constexpr Reg REGISTERS = Reg::RBX;
+static constexpr Reg QUAD = Reg::R14;
+static constexpr Reg PROCESSOR = Reg::R15;
+
+static Operand shader_register(u16 index)
+{
+    return Operand::Mem64BaseAndOffset(REGISTERS, index * sizeof(f32x4));
+}
+
+static Operand quad_input(u8 index)
+{
+    return Operand::Mem64BaseAndOffset(QUAD, offsetof(PixelQuad, inputs) + index * sizeof(f32x4));
+}
+
+static Operand quad_output(u8 index)
+{
+    return Operand::Mem64BaseAndOffset(QUAD, offsetof(PixelQuad, outputs) + index * sizeof(f32x4));
+}
+
+static Operand vector_register(u8 index)
+{
+    return Operand::FloatRegister(static_cast<Reg>(to_underlying(Reg::XMM0) + index));
+}
+
+static void compile_copy(Assembler& assembler, Operand target, Operand source)
+{
+    assembler.mov_packed_single(vector_register(0), source);
+    assembler.mov_packed_single(target, vector_register(0));
+}
+
+static void compile_instruction(Assembler& assembler, Instruction const& instruction)
+{
+    auto const& arguments = instruction.arguments;
+    switch (instruction.operation) {
+    case Opcode::Input:
+        for (u8 i = 0; i < 4; ++i)
+            compile_copy(assembler, shader_register(arguments.input.target_register + i), quad_input(arguments.input.input_index + i));
+        break;
+    case Opcode::Output:
+        for (u8 i = 0; i < 4; ++i)
+            compile_copy(assembler, quad_output(arguments.output.output_index + i), shader_register(arguments.output.source_register + i));
+        break;
+    case Opcode::Sample2D:
+        assembler.mov(Operand::Register(Reg::RDI), Operand::Register(PROCESSOR));
+        assembler.mov(Operand::Register(Reg::RSI), Operand::Imm(reinterpret_cast<FlatPtr>(&instruction)));
+        assembler.native_call(reinterpret_cast<FlatPtr>(&NativeShader::cxx_sample_2d));
+        break;
+    case Opcode::Swizzle:
+        // All sources are loaded first, as the target may overlap with them.
+        for (u8 i = 0; i < 4; ++i)
+            assembler.mov_packed_single(vector_register(i), shader_register(arguments.swizzle.source_register + i));
+        for (u8 i = 0; i < 4; ++i)
+            assembler.mov_packed_single(shader_register(arguments.swizzle.target_register + i), vector_register(swizzle_index(arguments.swizzle.pattern, i)));
+        break;
+    case Opcode::Add:
+    case Opcode::Sub:
+    case Opcode::Mul:
+    case Opcode::Div:
+        for (u8 i = 0; i < 4; ++i) {
+            auto lhs = vector_register(0);
+            auto rhs = vector_register(1);
+            assembler.mov_packed_single(lhs, shader_register(arguments.binop.source_register1 + i));
+            assembler.mov_packed_single(rhs, shader_register(arguments.binop.source_register2 + i));
+            if (instruction.operation == Opcode::Add)
+                assembler.add_packed_single(lhs, rhs);
+            else if (instruction.operation == Opcode::Sub)
+                assembler.sub_packed_single(lhs, rhs);
+            else if (instruction.operation == Opcode::Mul)
+                assembler.mul_packed_single(lhs, rhs);
+            else
+                assembler.div_packed_single(lhs, rhs);
+            assembler.mov_packed_single(shader_register(arguments.binop.target_register + i), lhs);
+        }
+        break;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+#endif
+
+OwnPtr<NativeShader> NativeShader::compile(ReadonlySpan<Instruction> instructions)
+{
+#if JIT_ARCH_SUPPORTED
+    Vector<u8> output;
+    Assembler assembler(output);
+
+    // The prologue pins the arguments, see run().
+    assembler.enter();
+    assembler.mov(Operand::Register(REGISTERS), Operand::Register(Reg::RDI));
+    assembler.mov(Operand::Register(QUAD), Operand::Register(Reg::RSI));
+    assembler.mov(Operand::Register(PROCESSOR), Operand::Register(Reg::RDX));
+
+    for (auto const& instruction : instructions)
+        compile_instruction(assembler, instruction);
+
+    assembler.exit();
+
+    auto memory_or_error = Core::System::mmap(nullptr, output.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0, 0, "SoftGPU shader code"sv);
+    if (memory_or_error.is_error()) {
+        dbgln("SoftGPU: Failed to allocate native shader code: {}", memory_or_error.error());
+        return nullptr;
+    }
+    auto* memory = memory_or_error.release_value();
+    memcpy(memory, output.data(), output.size());
+    if (mprotect(memory, output.size(), PROT_READ | PROT_EXEC) < 0) {
+        dbgln("SoftGPU: Failed to make native shader code executable: {}", Error::from_syscall("mprotect"sv, -errno));
+        MUST(Core::System::munmap(memory, output.size()));
+        return nullptr;
+    }
+
+    auto native_shader = adopt_own_if_nonnull(new (nothrow) NativeShader(memory, output.size()));
+    if (!native_shader)
+        MUST(Core::System::munmap(memory, output.size()));
+    return native_shader;
+#else
+    (void)instructions;
+    return nullptr;
+#endif
+}
+
+NativeShader::NativeShader(void* code, size_t size)
+    : m_code(code)
+    , m_size(size)
+{
+}
+
+NativeShader::~NativeShader()
+{
+    MUST(Core::System::munmap(m_code, m_size));
+}
+
+void NativeShader::run(f32x4* registers, PixelQuad& quad, ShaderProcessor& processor) const
+{
+    using EntryFunction = void (*)(f32x4* registers, PixelQuad*, ShaderProcessor*);
+    auto function = reinterpret_cast<EntryFunction>(m_code);
+    function(registers, &quad, &processor);
+}
+
+void NativeShader::cxx_sample_2d(ShaderProcessor& processor, Instruction const& instruction)
+{
+    processor.op_sample2d(instruction.arguments);
+}
+
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/SIMD.h>
+#include <AK/Span.h>
+#include <LibSoftGPU/ISA.h>
+
+namespace SoftGPU {
+
+class ShaderProcessor;
+struct PixelQuad;
+
+// Machine code for a shader program, which runs all of its instructions on a quad without going through the
+// interpreter's dispatch. Registers, inputs and outputs stay in memory where the interpreter keeps them, and texture
+// sampling calls back into the shader processor.
+class NativeShader {
+    AK_MAKE_NONCOPYABLE(NativeShader);
+    AK_MAKE_NONMOVABLE(NativeShader);
+
+public:
+    // Returns null if the architecture isn't supported, or the code couldn't be made executable. The instructions have
+    // to outlive the native shader, as the code refers to them.
+    static OwnPtr<NativeShader> compile(ReadonlySpan<Instruction>);
+    ~NativeShader();
+
+    void run(AK::SIMD::f32x4* registers, PixelQuad&, ShaderProcessor&) const;
+
+    // Called from the code for instructions that aren't worth compiling inline.
+    static void cxx_sample_2d(ShaderProcessor&, Instruction const&);
+
+private:
+    NativeShader(void* code, size_t size);
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+};
+
+}
@@ -11,6 +11,7 @@ namespace SoftGPU {
 Shader::Shader(void const* ownership_token, Vector<Instruction> const& instructions)
     : GPU::Shader(ownership_token)
     , m_instructions(instructions)
+    , m_native_shader(NativeShader::compile(m_instructions))
 {
 }
 
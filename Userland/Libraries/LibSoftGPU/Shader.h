@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include <AK/OwnPtr.h>
 #include <AK/Vector.h>
 #include <LibGPU/Shader.h>
 #include <LibSoftGPU/ISA.h>
+#include <LibSoftGPU/NativeShader.h>
 
 namespace SoftGPU {
 
@@ -18,8 +20,12 @@ public:
 
     Vector<Instruction> const& instructions() const { return m_instructions; }
 
+    // The instructions compiled to machine code when the shader is created, or null if they can only be interpreted.
+    NativeShader const* native_shader() const { return m_native_shader.ptr(); }
+
 private:
     Vector<Instruction> m_instructions;
+    OwnPtr<NativeShader> m_native_shader;
 };
 
 }
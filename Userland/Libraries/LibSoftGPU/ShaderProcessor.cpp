@@ -15,6 +15,11 @@ using AK::SIMD::f32x4;
 
 void ShaderProcessor::execute(PixelQuad& quad, Shader const& shader)
 {
+    if (auto const* native_shader = shader.native_shader()) {
+        native_shader->run(m_registers, quad, *this);
+        return;
+    }
+
     auto& instructions = shader.instructions();
     for (size_t program_counter = 0; program_counter < instructions.size(); ++program_counter) {
         auto instruction = instructions[program_counter];
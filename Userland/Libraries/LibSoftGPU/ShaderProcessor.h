@@ -30,6 +30,8 @@ public:
     ALWAYS_INLINE void set_register(u16 index, AK::SIMD::f32x4 value) { m_registers[index] = value; }
 
 private:
+    friend class NativeShader;
+
     void op_input(PixelQuad const&, Instruction::Arguments);
     void op_output(PixelQuad&, Instruction::Arguments);
     void op_sample2d(Instruction::Arguments);
@@ -34,6 +34,17 @@ ByteBuffer TLSv12::build_hello()
     builder.append(version);
     builder.append(m_context.local_random, sizeof(m_context.local_random));
 
+    // Offer to resume the last session with this server, which saves a round trip and the key exchange if it accepts.
+    m_context.offered_session.clear();
+    if (!m_context.is_server && m_context.options.session_cache && !m_context.extensions.SNI.is_empty()) {
+        m_context.offered_session = m_context.options.session_cache->find_session(m_context.extensions.SNI);
+        if (m_context.offered_session.has_value()) {
+            auto const& session_id = m_context.offered_session->session_id;
+            memcpy(m_context.session_id, session_id.data(), session_id.size());
+            m_context.session_id_size = session_id.size();
+        }
+    }
+
     builder.append(m_context.session_id_size);
     if (m_context.session_id_size)
         builder.append(m_context.session_id, m_context.session_id_size);
@@ -140,8 +151,20 @@ ByteBuffer TLSv12::build_hello()
     }
 
     if (alpn_length) {
-        // TODO
-        VERIFY_NOT_REACHED();
+        // application_layer_protocol_negotiation extension
+        builder.append((u16)ExtensionType::APPLICATION_LAYER_PROTOCOL_NEGOTIATION);
+        builder.append((u16)(alpn_length + 2));
+        builder.append((u16)alpn_length);
+        auto append_protocol = [&](ByteString const& protocol) {
+            builder.append((u8)protocol.length());
+            builder.append((u8 const*)protocol.characters(), protocol.length());
+        };
+        if (!m_context.negotiated_alpn.is_empty()) {
+            append_protocol(m_context.negotiated_alpn);
+        } else {
+            for (auto& protocol : m_context.alpn)
+                append_protocol(protocol);
+        }
     }
 
     // set the "length" field of the packet
@@ -227,6 +250,20 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
 
     // TODO: Compare Hashes
     dbgln_if(TLS_DEBUG, "FIXME: handle_handshake_finished :: Check message validity");
+
+    if (m_context.is_resuming_session) {
+        // RFC 5246 section 7.3: In an abbreviated handshake, the server sends its Finished message first,
+        //                       and the connection is established once we have sent ours.
+        write_packets = WritePacketStage::Finished;
+        return index + size;
+    }
+
+    handle_connection_established();
+    return index + size;
+}
+
+void TLSv12::handle_connection_established()
+{
     m_context.connection_status = ConnectionStatus::Established;
 
     if (m_handshake_timeout_timer) {
@@ -236,10 +273,24 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
         m_handshake_timeout_timer = nullptr;
     }
 
+    // Remember the session if the server is willing to resume it later.
+    auto& session_cache = m_context.options.session_cache;
+    if (session_cache && !m_context.is_server && !m_context.is_resuming_session && m_context.session_id_size && !m_context.extensions.SNI.is_empty()) {
+        auto session_id = ByteBuffer::copy(m_context.session_id, m_context.session_id_size);
+        auto master_key = ByteBuffer::copy(m_context.master_key);
+        if (!session_id.is_error() && !master_key.is_error()) {
+            session_cache->store_session(m_context.extensions.SNI,
+                {
+                    .session_id = session_id.release_value(),
+                    .cipher = m_context.cipher,
+                    .master_key = master_key.release_value(),
+                    .extended_master_secret = m_context.extensions.extended_master_secret,
+                });
+        }
+    }
+
     if (on_connected)
         on_connected();
-
-    return index + size;
 }
 
 ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
@@ -547,7 +598,7 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
                 auto packet = build_handshake_finished();
                 write_packet(packet);
             }
-            m_context.connection_status = ConnectionStatus::Established;
+            handle_connection_established();
             break;
         }
         payload_size++;
@@ -157,15 +157,15 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
                     size_t alpn_position = 0;
                     while (alpn_position < alpn_length) {
                         u8 alpn_size = alpn[alpn_position++];
-                        if (alpn_size + alpn_position >= extension_length)
+                        if (alpn_size + alpn_position > alpn_length)
                             break;
-                        ByteString alpn_str { (char const*)alpn + alpn_position, alpn_length };
+                        ByteString alpn_str { (char const*)alpn + alpn_position, alpn_size };
                         if (alpn_size && m_context.alpn.contains_slow(alpn_str)) {
                             m_context.negotiated_alpn = alpn_str;
-                            dbgln("negotiated alpn: {}", alpn_str);
+                            dbgln_if(TLS_DEBUG, "negotiated alpn: {}", alpn_str);
                             break;
                         }
-                        alpn_position += alpn_length;
+                        alpn_position += alpn_size;
                         if (!m_context.is_server) // server hello must contain one ALPN
                             break;
                     }
@@ -196,6 +196,31 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
         }
     }
 
+    if (m_context.offered_session.has_value()) {
+        auto session = m_context.offered_session.release_value();
+        auto accepted = session.session_id.bytes() == ReadonlyBytes { m_context.session_id, m_context.session_id_size } && session.cipher == m_context.cipher;
+        if (!accepted) {
+            // The server has started a new session, which replaces the one we offered once the handshake is done.
+            dbgln_if(TLS_DEBUG, "Server did not resume the offered session");
+            m_context.options.session_cache->remove_session(m_context.extensions.SNI);
+        } else {
+            // RFC 7627 section 5.3: A resumed session must use the extended master secret if and only if the original one did.
+            if (session.extended_master_secret != m_context.extensions.extended_master_secret) {
+                dbgln("Server resumed a session with a different extended master secret setting");
+                m_context.options.session_cache->remove_session(m_context.extensions.SNI);
+                return (i8)Error::NotSafe;
+            }
+
+            dbgln_if(TLS_DEBUG, "Resuming session");
+            m_context.master_key = move(session.master_key);
+            m_context.is_resuming_session = true;
+            expand_key();
+
+            // The server follows up with its ChangeCipherSpec and Finished messages right away.
+            m_context.connection_status = ConnectionStatus::KeyExchange;
+        }
+    }
+
     return res;
 }
 
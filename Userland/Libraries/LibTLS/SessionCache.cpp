@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibTLS/Certificate.h>
+#include <LibTLS/SessionCache.h>
+
+namespace TLS {
+
+Optional<SessionCache::Session> SessionCache::find_session(StringView host)
+{
+    Threading::MutexLocker locker(m_mutex);
+
+    auto it = m_sessions.find(host);
+    if (it == m_sessions.end())
+        return {};
+
+    if (MonotonicTime::now_coarse() - it->value.creation_time > session_lifetime) {
+        m_sessions.remove(it);
+        return {};
+    }
+
+    auto session_id = ByteBuffer::copy(it->value.session_id);
+    auto master_key = ByteBuffer::copy(it->value.master_key);
+    if (session_id.is_error() || master_key.is_error())
+        return {};
+
+    return Session {
+        .session_id = session_id.release_value(),
+        .cipher = it->value.cipher,
+        .master_key = master_key.release_value(),
+        .extended_master_secret = it->value.extended_master_secret,
+        .creation_time = it->value.creation_time,
+    };
+}
+
+void SessionCache::store_session(StringView host, Session session)
+{
+    VERIFY(!session.session_id.is_empty() && session.session_id.size() <= 32);
+
+    Threading::MutexLocker locker(m_mutex);
+
+    if (m_sessions.size() >= m_capacity && !m_sessions.contains(host)) {
+        // Make room by dropping the oldest session.
+        auto oldest = m_sessions.begin();
+        for (auto it = m_sessions.begin(); it != m_sessions.end(); ++it) {
+            if (it->value.creation_time < oldest->value.creation_time)
+                oldest = it;
+        }
+        m_sessions.remove(oldest);
+    }
+
+    m_sessions.set(host, move(session));
+}
+
+void SessionCache::remove_session(StringView host)
+{
+    Threading::MutexLocker locker(m_mutex);
+    m_sessions.remove(host);
+}
+
+ByteString SessionCache::hash_chain(StringView host, ReadonlySpan<Certificate> chain, bool allow_self_signed_certificates)
+{
+    Crypto::Hash::SHA256 hash;
+
+    auto update_with_length = [&](ReadonlyBytes bytes) {
+        BigEndian<u32> length = bytes.size();
+        hash.update(ReadonlyBytes { &length, sizeof(length) });
+        hash.update(bytes);
+    };
+
+    update_with_length(host.bytes());
+    for (auto const& certificate : chain)
+        update_with_length(certificate.der.bytes());
+
+    u8 flags = allow_self_signed_certificates ? 1 : 0;
+    hash.update(&flags, sizeof(flags));
+
+    auto digest = hash.digest();
+    return ByteString { digest.bytes() };
+}
+
+bool SessionCache::is_chain_verified(ByteString const& chain_hash)
+{
+    Threading::MutexLocker locker(m_mutex);
+
+    auto it = m_verified_chains.find(chain_hash);
+    if (it == m_verified_chains.end())
+        return false;
+
+    if (it->value <= UnixDateTime::now()) {
+        m_verified_chains.remove(it);
+        return false;
+    }
+
+    return true;
+}
+
+void SessionCache::add_verified_chain(ByteString const& chain_hash, ReadonlySpan<Certificate> chain)
+{
+    auto expiration_time = UnixDateTime::now() + verified_chain_lifetime;
+    for (auto const& certificate : chain)
+        expiration_time = min(expiration_time, certificate.validity.not_after);
+
+    Threading::MutexLocker locker(m_mutex);
+
+    if (m_verified_chains.size() >= m_capacity && !m_verified_chains.contains(chain_hash)) {
+        // Make room by dropping the chain that expires first.
+        auto first_to_expire = m_verified_chains.begin();
+        for (auto it = m_verified_chains.begin(); it != m_verified_chains.end(); ++it) {
+            if (it->value < first_to_expire->value)
+                first_to_expire = it;
+        }
+        m_verified_chains.remove(first_to_expire);
+    }
+
+    m_verified_chains.set(chain_hash, expiration_time);
+}
+
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <LibTLS/CipherSuite.h>
+#include <LibThreading/Mutex.h>
+
+namespace TLS {
+
+class Certificate;
+
+// Remembers the sessions of earlier connections, so that later connections to the same servers can resume them with an
+// abbreviated handshake (RFC 5246 section 7.3), and the certificate chains that were already verified, so that they
+// don't have to be verified again. A cache can be shared between the connections (and threads) of a process, as long as
+// all of them trust the same root certificates.
+class SessionCache : public AtomicRefCounted<SessionCache> {
+public:
+    struct Session {
+        ByteBuffer session_id;
+        CipherSuite cipher { CipherSuite::TLS_NULL_WITH_NULL_NULL };
+        ByteBuffer master_key;
+        bool extended_master_secret { false };
+        MonotonicTime creation_time { MonotonicTime::now_coarse() };
+    };
+
+    static constexpr size_t default_capacity = 256;
+
+    // How long sessions and verified chains are kept. A verified chain is also dropped once any of its certificates expires.
+    static constexpr Duration session_lifetime = Duration::from_seconds(60 * 60);
+    static constexpr Duration verified_chain_lifetime = Duration::from_seconds(60 * 60);
+
+    static NonnullRefPtr<SessionCache> create(size_t capacity = default_capacity)
+    {
+        return adopt_ref(*new SessionCache(capacity));
+    }
+
+    Optional<Session> find_session(StringView host);
+    void store_session(StringView host, Session);
+    void remove_session(StringView host);
+
+    // Chains are identified by a hash of the host name and the DER encoding of their certificates.
+    static ByteString hash_chain(StringView host, ReadonlySpan<Certificate> chain, bool allow_self_signed_certificates);
+    bool is_chain_verified(ByteString const& chain_hash);
+    void add_verified_chain(ByteString const& chain_hash, ReadonlySpan<Certificate> chain);
+
+private:
+    explicit SessionCache(size_t capacity)
+        : m_capacity(capacity)
+    {
+    }
+
+    size_t m_capacity { 0 };
+
+    Threading::Mutex m_mutex;
+    HashMap<ByteString, Session> m_sessions;
+    HashMap<ByteString, UnixDateTime> m_verified_chains;
+};
+
+}
@@ -250,6 +250,23 @@ bool Context::verify_chain(StringView host) const
     if (!options.validate_certificates)
         return true;
 
+    if (!options.session_cache || is_server)
+        return verify_chain_without_cache(host);
+
+    // Verifying the signatures of a chain is expensive, so don't do it again for chains that were verified before.
+    auto chain_hash = SessionCache::hash_chain(host, certificates, options.allow_self_signed_certificates);
+    if (options.session_cache->is_chain_verified(chain_hash))
+        return true;
+
+    if (!verify_chain_without_cache(host))
+        return false;
+
+    options.session_cache->add_verified_chain(chain_hash, certificates);
+    return true;
+}
+
+bool Context::verify_chain_without_cache(StringView host) const
+{
     Vector<Certificate> const* local_chain = nullptr;
     if (is_server) {
         dbgln("Unsupported: Server mode");
@@ -513,6 +530,7 @@ TLSv12::TLSv12(StreamVariantType stream, Options options)
     m_context.options = move(options);
     m_context.is_server = false;
     m_context.tls_buffer = {};
+    m_context.alpn = m_context.options.alpn_protocols;
 
     set_root_certificates(m_context.options.root_certificates.has_value()
             ? *m_context.options.root_certificates
@@ -20,6 +20,7 @@
 #include <LibCrypto/Hash/HashManager.h>
 #include <LibCrypto/PK/RSA.h>
 #include <LibTLS/CipherSuite.h>
+#include <LibTLS/SessionCache.h>
 #include <LibTLS/TLSPacketBuilder.h>
 
 namespace TLS {
@@ -194,6 +195,9 @@ struct Options {
     OPTION_WITH_DEFAULTS(Function<void()>, finish_callback, [] { })
     OPTION_WITH_DEFAULTS(Function<Vector<Certificate>()>, certificate_provider, [] { return Vector<Certificate> {}; })
     OPTION_WITH_DEFAULTS(bool, enable_extended_master_secret, true)
+    OPTION_WITH_DEFAULTS(RefPtr<SessionCache>, session_cache, )
+    // The application protocols offered with ALPN (RFC 7301), in order of preference.
+    OPTION_WITH_DEFAULTS(Vector<ByteString>, alpn_protocols, )
 
 #undef OPTION_WITH_DEFAULTS
 };
@@ -238,6 +242,7 @@ private:
 
 struct Context {
     bool verify_chain(StringView host) const;
+    bool verify_chain_without_cache(StringView host) const;
     bool verify_certificate_pair(Certificate const& subject, Certificate const& issuer) const;
 
     Options options;
@@ -246,6 +251,8 @@ struct Context {
     u8 local_random[32];
     u8 session_id[32];
     u8 session_id_size { 0 };
+    Optional<SessionCache::Session> offered_session;
+    bool is_resuming_session { false };
     CipherSuite cipher;
     bool is_server { false };
     Vector<Certificate> certificates;
@@ -303,7 +310,7 @@ struct Context {
     HashMap<ByteString, Certificate> root_certificates;
 
     Vector<ByteString> alpn;
-    StringView negotiated_alpn;
+    ByteString negotiated_alpn;
 
     size_t send_retries { 0 };
 
@@ -442,6 +449,7 @@ private:
 
     ssize_t handle_server_hello(ReadonlyBytes, WritePacketStage&);
     ssize_t handle_handshake_finished(ReadonlyBytes, WritePacketStage&);
+    void handle_connection_established();
     ssize_t handle_certificate(ReadonlyBytes);
     ssize_t handle_server_key_exchange(ReadonlyBytes);
     ssize_t handle_dhe_rsa_server_key_exchange(ReadonlyBytes);
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/QuickSort.h>
+#include <LibTest/Benchmark.h>
+#include <math.h>
+
+namespace Test {
+
+double BenchmarkStatistics::standard_deviation() const
+{
+    return sqrt(variance);
+}
+
+double percentile_of_sorted_samples(ReadonlySpan<double> sorted_samples, double percentile)
+{
+    VERIFY(!sorted_samples.is_empty());
+    VERIFY(percentile >= 0 && percentile <= 100);
+
+    auto rank = percentile / 100 * (sorted_samples.size() - 1);
+    auto lower_index = static_cast<size_t>(floor(rank));
+    auto upper_index = min(lower_index + 1, sorted_samples.size() - 1);
+    auto fraction = rank - lower_index;
+    return sorted_samples[lower_index] + (sorted_samples[upper_index] - sorted_samples[lower_index]) * fraction;
+}
+
+BenchmarkStatistics BenchmarkStatistics::compute(Vector<double> samples)
+{
+    BenchmarkStatistics statistics;
+    if (samples.is_empty())
+        return statistics;
+
+    quick_sort(samples);
+
+    statistics.sample_count = samples.size();
+    statistics.min = samples.first();
+    statistics.max = samples.last();
+
+    double sum = 0;
+    for (auto sample : samples)
+        sum += sample;
+    statistics.mean = sum / samples.size();
+
+    // The deviations from the mean are summed up instead of the squares of the samples, which loses a lot of precision
+    // for long-running benchmarks with little variance.
+    if (samples.size() > 1) {
+        double sum_of_squared_deviations = 0;
+        for (auto sample : samples)
+            sum_of_squared_deviations += (sample - statistics.mean) * (sample - statistics.mean);
+        statistics.variance = sum_of_squared_deviations / (samples.size() - 1);
+    }
+
+    statistics.median = percentile_of_sorted_samples(samples, 50);
+    statistics.percentile_5 = percentile_of_sorted_samples(samples, 5);
+    statistics.percentile_95 = percentile_of_sorted_samples(samples, 95);
+    return statistics;
+}
+
+Optional<double> BenchmarkResult::throughput_per_second() const
+{
+    if (!throughput.has_value() || nanoseconds.median <= 0)
+        return {};
+    return throughput->amount / (nanoseconds.median / 1'000'000'000);
+}
+
+static JsonObject statistics_to_json(BenchmarkStatistics const& statistics)
+{
+    JsonObject object;
+    object.set("samples", statistics.sample_count);
+    object.set("min", statistics.min);
+    object.set("max", statistics.max);
+    object.set("mean", statistics.mean);
+    object.set("variance", statistics.variance);
+    object.set("standard_deviation", statistics.standard_deviation());
+    object.set("median", statistics.median);
+    object.set("p5", statistics.percentile_5);
+    object.set("p95", statistics.percentile_95);
+    return object;
+}
+
+ByteString benchmark_results_to_json(StringView suite_name, ReadonlySpan<BenchmarkResult> results)
+{
+    JsonArray benchmarks;
+    for (auto const& result : results) {
+        JsonObject benchmark;
+        benchmark.set("name", result.name);
+        benchmark.set("nanoseconds", statistics_to_json(result.nanoseconds));
+        if (result.cycles.has_value())
+            benchmark.set("cycles", statistics_to_json(*result.cycles));
+        if (result.throughput.has_value()) {
+            benchmark.set("throughput_unit", result.throughput->unit == ThroughputUnit::Bytes ? "bytes"sv : "items"sv);
+            benchmark.set("throughput_amount", result.throughput->amount);
+            benchmark.set("throughput_per_second", *result.throughput_per_second());
+        }
+        benchmarks.must_append(move(benchmark));
+    }
+
+    JsonObject object;
+    object.set("suite", suite_name);
+    object.set("benchmarks", move(benchmarks));
+    return object.to_byte_string();
+}
+
+ErrorOr<Vector<BenchmarkComparison>> compare_benchmark_results_to_baseline(ReadonlySpan<BenchmarkResult> results, StringView baseline_json)
+{
+    auto baseline = TRY(JsonValue::from_string(baseline_json));
+    if (!baseline.is_object())
+        return Error::from_string_literal("Benchmark baseline is not a JSON object");
+    auto baseline_benchmarks = baseline.as_object().get_array("benchmarks"sv);
+    if (!baseline_benchmarks.has_value())
+        return Error::from_string_literal("Benchmark baseline has no benchmarks");
+
+    Vector<BenchmarkComparison> comparisons;
+    for (auto const& result : results) {
+        for (auto const& value : baseline_benchmarks->values()) {
+            if (!value.is_object())
+                return Error::from_string_literal("Benchmark baseline contains a benchmark that is not a JSON object");
+            auto const& benchmark = value.as_object();
+            if (benchmark.get_byte_string("name"sv) != result.name)
+                continue;
+
+            auto nanoseconds = benchmark.get_object("nanoseconds"sv);
+            if (!nanoseconds.has_value())
+                return Error::from_string_literal("Benchmark baseline contains a benchmark without times");
+            auto median = nanoseconds->get_double_with_precision_loss("median"sv);
+            if (!median.has_value() || *median <= 0)
+                return Error::from_string_literal("Benchmark baseline contains a benchmark without a valid median");
+
+            TRY(comparisons.try_append({ result.name, *median, result.nanoseconds.median }));
+            break;
+        }
+    }
+    return comparisons;
+}
+
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/Optional.h>
+#include <AK/Platform.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+
+namespace Test {
+
+// The distribution of the samples taken of a benchmark, without any of the warmup runs.
+struct BenchmarkStatistics {
+    size_t sample_count { 0 };
+    double min { 0 };
+    double max { 0 };
+    double mean { 0 };
+    // The unbiased sample variance, which is zero for a single sample.
+    double variance { 0 };
+    double median { 0 };
+    double percentile_5 { 0 };
+    double percentile_95 { 0 };
+
+    double standard_deviation() const;
+
+    static BenchmarkStatistics compute(Vector<double> samples);
+};
+
+// Linearly interpolates between the closest ranks of the sorted samples, with `percentile` between 0 and 100.
+double percentile_of_sorted_samples(ReadonlySpan<double> sorted_samples, double percentile);
+
+enum class ThroughputUnit {
+    Bytes,
+    Items,
+};
+
+struct BenchmarkThroughput {
+    // How much a single run of the benchmark processes.
+    u64 amount { 0 };
+    ThroughputUnit unit { ThroughputUnit::Bytes };
+};
+
+struct BenchmarkResult {
+    ByteString name;
+    BenchmarkStatistics nanoseconds;
+    Optional<BenchmarkStatistics> cycles;
+    Optional<BenchmarkThroughput> throughput;
+
+    // The amount processed per second, based on the median time.
+    Optional<double> throughput_per_second() const;
+};
+
+// Serializes the results as a JSON object, which can be read back as a baseline.
+ByteString benchmark_results_to_json(StringView suite_name, ReadonlySpan<BenchmarkResult>);
+
+struct BenchmarkComparison {
+    ByteString name;
+    double baseline_median_nanoseconds { 0 };
+    double median_nanoseconds { 0 };
+
+    // How much slower (positive) or faster (negative) than the baseline the benchmark was, in percent.
+    double change_in_percent() const { return (median_nanoseconds / baseline_median_nanoseconds - 1) * 100; }
+};
+
+// Matches the results with the benchmarks of the same name in a baseline that benchmark_results_to_json() produced.
+// Benchmarks that aren't part of the baseline are left out.
+ErrorOr<Vector<BenchmarkComparison>> compare_benchmark_results_to_baseline(ReadonlySpan<BenchmarkResult>, StringView baseline_json);
+
+// Reads a counter that ticks at (roughly) the CPU's clock rate, if the architecture has one that can be read from
+// userspace. On AArch64 this is the generic timer, which ticks at a fixed but lower frequency.
+ALWAYS_INLINE Optional<u64> read_cycle_counter()
+{
+#if ARCH(X86_64)
+    return __builtin_ia32_rdtsc();
+#elif ARCH(AARCH64)
+    u64 value;
+    asm volatile("isb\nmrs %0, cntvct_el0"
+                 : "=r"(value));
+    return value;
+#else
+    return {};
+#endif
+}
+
+// Called from a benchmark to report how much each run processes, so that its throughput is printed alongside its time.
+void set_benchmark_throughput(u64 amount, ThroughputUnit = ThroughputUnit::Bytes);
+
+}
@@ -6,11 +6,13 @@
  */
 
 #include <AK/Function.h>
+#include <AK/NumberFormat.h>
+#include <AK/Time.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
 #include <LibTest/Macros.h>
 #include <LibTest/TestResult.h>
 #include <LibTest/TestSuite.h>
-#include <math.h>
 #include <stdlib.h>
 #include <sys/time.h>
 
@@ -81,6 +83,12 @@ void set_suite_setup_function(Function<void()> setup)
     TestSuite::the().set_suite_setup(move(setup));
 }
 
+// Declared in Benchmark.h
+void set_benchmark_throughput(u64 amount, ThroughputUnit unit)
+{
+    TestSuite::the().set_current_benchmark_throughput({ amount, unit });
+}
+
 // Declared in Macros.h
 bool is_reporting_enabled()
 {
@@ -117,6 +125,34 @@ static ByteString test_result_to_string(TestResult result)
     }
 }
 
+static ByteString format_throughput(BenchmarkResult const& result)
+{
+    auto per_second = result.throughput_per_second();
+    if (!per_second.has_value())
+        return {};
+    if (result.throughput->unit == ThroughputUnit::Bytes)
+        return ByteString::formatted(", {}/s", human_readable_size(static_cast<u64>(*per_second)));
+    return ByteString::formatted(", {:.1f} items/s", *per_second);
+}
+
+static void print_benchmark_result(TestResult test_result, BenchmarkResult const& result)
+{
+    auto const& times = result.nanoseconds;
+    auto throughput = format_throughput(result);
+
+    if (times.sample_count == 1) {
+        dbgln("{} benchmark '{}' in {:.3f}ms{}", test_result_to_string(test_result), result.name, times.median / 1'000'000, throughput);
+        return;
+    }
+
+    auto cycles = result.cycles.has_value() ? ByteString::formatted(", median of {:.0f} cycles", result.cycles->median) : ByteString {};
+    dbgln("{} benchmark '{}' in a median of {:.3f}ms (p5={:.3f}ms, p95={:.3f}ms, mean={:.3f}±{:.3f}ms, min={:.3f}ms, max={:.3f}ms, {} samples{}){}",
+        test_result_to_string(test_result), result.name,
+        times.median / 1'000'000, times.percentile_5 / 1'000'000, times.percentile_95 / 1'000'000,
+        times.mean / 1'000'000, times.standard_deviation() / 1'000'000, times.min / 1'000'000, times.max / 1'000'000,
+        times.sample_count, cycles, throughput);
+}
+
 int TestSuite::main(ByteString const& suite_name, Span<StringView> arguments)
 {
     m_suite_name = suite_name;
@@ -131,11 +167,17 @@ int TestSuite::main(ByteString const& suite_name, Span<StringView> arguments)
     args_parser.add_option(do_tests_only, "Only run tests.", "tests");
     args_parser.add_option(do_benchmarks_only, "Only run benchmarks.", "bench");
     args_parser.add_option(m_benchmark_repetitions, "Number of times to repeat each benchmark (default 1)", "benchmark_repetitions", 0, "N");
+    args_parser.add_option(m_benchmark_warmup_runs, "Number of unmeasured runs before each benchmark (default 0)", "benchmark_warmup", 0, "N");
+    args_parser.add_option(m_benchmark_json_path, "Write the benchmark results as JSON to a file", "benchmark_json", 0, "path");
+    args_parser.add_option(m_benchmark_baseline_path, "Compare the benchmark results to a JSON file written by --benchmark_json", "benchmark_baseline", 0, "path");
+    args_parser.add_option(m_benchmark_regression_threshold, "How much slower than the baseline a benchmark may get, in percent (default 5)", "benchmark_threshold", 0, "percent");
     args_parser.add_option(m_randomized_runs, "Number of times to run each RANDOMIZED_TEST_CASE (default 100)", "randomized_runs", 0, "RUNS");
     args_parser.add_option(do_list_cases, "List available test cases.", "list");
     args_parser.add_positional_argument(search_string, "Only run matching cases.", "pattern", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    m_benchmark_repetitions = max<u64>(m_benchmark_repetitions, 1);
+
     if (m_setup)
         m_setup();
 
@@ -186,41 +228,58 @@ int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
 
     for (auto const& t : tests) {
         auto const test_type = t->is_benchmark() ? "benchmark" : "test";
-        auto const repetitions = t->is_benchmark() ? m_benchmark_repetitions : 1;
 
         warnln("Running {} '{}'.", test_type, t->name());
         m_current_test_result = TestResult::NotRun;
         enable_reporting();
 
         u64 total_time = 0;
-        u64 sum_of_squared_times = 0;
-        u64 min_time = NumericLimits<u64>::max();
-        u64 max_time = 0;
 
-        for (u64 i = 0; i < repetitions; ++i) {
+        if (!t->is_benchmark()) {
             TestElapsedTimer timer;
             t->func()();
-            auto const iteration_time = timer.elapsed_milliseconds();
-            total_time += iteration_time;
-            sum_of_squared_times += iteration_time * iteration_time;
-            min_time = min(min_time, iteration_time);
-            max_time = max(max_time, iteration_time);
+            total_time = timer.elapsed_milliseconds();
 
             // Non-randomized tests don't touch the test result when passing.
             if (m_current_test_result == TestResult::NotRun)
                 m_current_test_result = TestResult::Passed;
-        }
-
-        if (repetitions != 1) {
-            double average = total_time / double(repetitions);
-            double average_squared = average * average;
-            double standard_deviation = sqrt((sum_of_squared_times + repetitions * average_squared - 2 * total_time * average) / (repetitions - 1));
 
-            dbgln("{} {} '{}' on average in {:.1f}±{:.1f}ms (min={}ms, max={}ms, total={}ms)",
-                test_result_to_string(m_current_test_result), test_type, t->name(),
-                average, standard_deviation, min_time, max_time, total_time);
-        } else {
             dbgln("{} {} '{}' in {}ms", test_result_to_string(m_current_test_result), test_type, t->name(), total_time);
+        } else {
+            m_current_benchmark_throughput = {};
+
+            // Warmup runs fill caches and settle the CPU's frequency. They aren't measured, but can still fail.
+            for (u64 i = 0; i < m_benchmark_warmup_runs; ++i)
+                t->func()();
+
+            Vector<double> nanoseconds;
+            Vector<double> cycles;
+            bool has_cycle_counter = read_cycle_counter().has_value();
+            for (u64 i = 0; i < m_benchmark_repetitions; ++i) {
+                auto start_cycles = read_cycle_counter();
+                auto start_time = MonotonicTime::now();
+                t->func()();
+                auto iteration_time = MonotonicTime::now() - start_time;
+                auto end_cycles = read_cycle_counter();
+
+                nanoseconds.append(iteration_time.to_nanoseconds());
+                if (has_cycle_counter)
+                    cycles.append(*end_cycles - *start_cycles);
+            }
+            if (m_current_test_result == TestResult::NotRun)
+                m_current_test_result = TestResult::Passed;
+
+            BenchmarkResult result {
+                .name = t->name(),
+                .nanoseconds = BenchmarkStatistics::compute(move(nanoseconds)),
+                .cycles = {},
+                .throughput = m_current_benchmark_throughput,
+            };
+            if (has_cycle_counter)
+                result.cycles = BenchmarkStatistics::compute(move(cycles));
+            total_time = static_cast<u64>(result.nanoseconds.mean * result.nanoseconds.sample_count / 1'000'000);
+            print_benchmark_result(m_current_test_result, result);
+            m_benchmark_results.append(move(result));
         }
 
         if (t->is_benchmark()) {
@@ -254,6 +313,19 @@ int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
         }
     }
 
+    if (!m_benchmark_results.is_empty()) {
+        auto regression_count_or_error = report_benchmark_results();
+        if (regression_count_or_error.is_error()) {
+            warnln("Failed to report benchmark results: {}", regression_count_or_error.error());
+            benchmark_passed_count = 0;
+        } else {
+            // Regressions count as failures, so that they can be caught the same way.
+            auto regression_count = min(regression_count_or_error.value(), benchmark_passed_count);
+            benchmark_passed_count -= regression_count;
+            benchmark_failed_count += regression_count;
+        }
+    }
+
     dbgln("Finished {} tests and {} benchmarks in {}ms ({}ms tests, {}ms benchmarks, {}ms other).",
         test_count,
         benchmark_count,
@@ -287,4 +359,33 @@ int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
     return (int)(test_count - test_passed_count + benchmark_count - benchmark_passed_count);
 }
 
+ErrorOr<size_t> TestSuite::report_benchmark_results()
+{
+    if (!m_benchmark_json_path.is_empty()) {
+        auto file = TRY(Core::File::open(m_benchmark_json_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(benchmark_results_to_json(m_suite_name, m_benchmark_results)));
+    }
+
+    if (m_benchmark_baseline_path.is_empty())
+        return 0;
+
+    auto file = TRY(Core::File::open(m_benchmark_baseline_path, Core::File::OpenMode::Read));
+    auto baseline = TRY(file->read_until_eof());
+    auto comparisons = TRY(compare_benchmark_results_to_baseline(m_benchmark_results, baseline));
+
+    size_t regression_count = 0;
+    for (auto const& comparison : comparisons) {
+        auto change = comparison.change_in_percent();
+        auto regressed = change > m_benchmark_regression_threshold;
+        if (regressed)
+            ++regression_count;
+        dbgln("{} benchmark '{}': {:.3f}ms -> {:.3f}ms ({:+.1f}%)",
+            regressed ? "Regressed" : "Compared",
+            comparison.name, comparison.baseline_median_nanoseconds / 1'000'000, comparison.median_nanoseconds / 1'000'000, change);
+    }
+    if (comparisons.size() != m_benchmark_results.size())
+        dbgln("{} benchmarks are not part of the baseline.", m_benchmark_results.size() - comparisons.size());
+    return regression_count;
+}
+
 } // namespace Test
@@ -9,7 +9,9 @@
 
 #include <AK/ByteString.h>
 #include <AK/Function.h>
+#include <AK/Optional.h>
 #include <AK/Vector.h>
+#include <LibTest/Benchmark.h>
 #include <LibTest/Macros.h>
 #include <LibTest/Randomized/RandomnessSource.h>
 #include <LibTest/TestCase.h>
@@ -62,13 +64,24 @@ public:
 
     u64 randomized_runs() { return m_randomized_runs; }
 
+    void set_current_benchmark_throughput(BenchmarkThroughput throughput) { m_current_benchmark_throughput = throughput; }
+
 private:
+    // Compares the benchmark results to the baseline, and returns how many of them have regressed.
+    ErrorOr<size_t> report_benchmark_results();
+
     static TestSuite* s_global;
     Vector<NonnullRefPtr<TestCase>> m_cases;
     u64 m_testtime = 0;
     u64 m_benchtime = 0;
     ByteString m_suite_name;
     u64 m_benchmark_repetitions = 1;
+    u64 m_benchmark_warmup_runs = 0;
+    StringView m_benchmark_json_path;
+    StringView m_benchmark_baseline_path;
+    double m_benchmark_regression_threshold = 5;
+    Vector<BenchmarkResult> m_benchmark_results;
+    Optional<BenchmarkThroughput> m_current_benchmark_throughput;
     u64 m_randomized_runs = 100;
     Function<void()> m_setup;
     TestResult m_current_test_result = TestResult::NotRun;
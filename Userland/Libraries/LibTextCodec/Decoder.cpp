@@ -349,6 +349,106 @@ ErrorOr<String> Decoder::to_utf8(StringView input)
     return builder.to_string_without_validation();
 }
 
+// Decodes an encoding in which every byte is a code point and ASCII bytes map to themselves. Runs of ASCII bytes,
+// which make up most of the text on the web, are copied as a whole instead of being looked at one byte at a time.
+template<typename CodePointForNonASCIIByte>
+static ErrorOr<String> single_byte_encoding_to_utf8(StringView input, CodePointForNonASCIIByte code_point_for_non_ascii_byte)
+{
+    StringBuilder builder(input.length());
+    Utf8View view { input };
+    size_t next_ascii_run_check = 0;
+
+    for (size_t i = 0; i < input.length();) {
+        u8 byte = input[i];
+        if (byte >= 0x80) {
+            TRY(builder.try_append_code_point(code_point_for_non_ascii_byte(byte)));
+            ++i;
+            continue;
+        }
+
+        if (i >= next_ascii_run_check) {
+            if (auto ascii_length = view.length_of_ascii_run(i); ascii_length > 0) {
+                TRY(builder.try_append(input.substring_view(i, ascii_length)));
+                i += ascii_length;
+                continue;
+            }
+            next_ascii_run_check = i + Utf8View::ascii_chunk_size;
+        }
+        TRY(builder.try_append(static_cast<char>(byte)));
+        ++i;
+    }
+
+    return builder.to_string_without_validation();
+}
+
+enum class UTF16Endianness {
+    Big,
+    Little,
+};
+
+template<UTF16Endianness endianness>
+static u16 utf16_code_unit_at(ReadonlyBytes bytes, size_t offset)
+{
+    if constexpr (endianness == UTF16Endianness::Big)
+        return (bytes[offset] << 8) | bytes[offset + 1];
+    return bytes[offset] | (bytes[offset + 1] << 8);
+}
+
+// Produces the same code points as UTF16{BE,LE}Decoder::process(), but appends them directly, and copies ASCII code
+// units four at a time.
+template<UTF16Endianness endianness>
+static ErrorOr<String> utf16_to_utf8(StringView input)
+{
+    static constexpr size_t high_byte = endianness == UTF16Endianness::Big ? 0 : 1;
+    static constexpr size_t low_byte = 1 - high_byte;
+
+    auto bytes = input.bytes();
+    size_t utf16_length = bytes.size() - (bytes.size() % 2);
+    StringBuilder builder(utf16_length / 2);
+
+    for (size_t i = 0; i < utf16_length;) {
+        if (i + 8 <= utf16_length) {
+            auto const* chunk = bytes.data() + i;
+            u8 high_bytes = chunk[high_byte] | chunk[high_byte + 2] | chunk[high_byte + 4] | chunk[high_byte + 6];
+            u8 low_bytes = chunk[low_byte] | chunk[low_byte + 2] | chunk[low_byte + 4] | chunk[low_byte + 6];
+            if (high_bytes == 0 && low_bytes < 0x80) {
+                char const ascii[] = {
+                    static_cast<char>(chunk[low_byte]),
+                    static_cast<char>(chunk[low_byte + 2]),
+                    static_cast<char>(chunk[low_byte + 4]),
+                    static_cast<char>(chunk[low_byte + 6]),
+                };
+                TRY(builder.try_append(ascii, sizeof(ascii)));
+                i += 8;
+                continue;
+            }
+        }
+
+        u16 w1 = utf16_code_unit_at<endianness>(bytes, i);
+        i += 2;
+        if (!is_unicode_surrogate(w1)) {
+            TRY(builder.try_append_code_point(w1));
+            continue;
+        }
+
+        if (!Utf16View::is_high_surrogate(w1) || i == utf16_length) {
+            TRY(builder.try_append_code_point(replacement_code_point));
+            continue;
+        }
+
+        u16 w2 = utf16_code_unit_at<endianness>(bytes, i);
+        if (!Utf16View::is_low_surrogate(w2)) {
+            TRY(builder.try_append_code_point(replacement_code_point));
+            continue;
+        }
+
+        TRY(builder.try_append_code_point(Utf16View::decode_surrogate_pair(w1, w2)));
+        i += 2;
+    }
+
+    return builder.to_string_without_validation();
+}
+
 ErrorOr<void> UTF8Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
     for (auto c : Utf8View(input)) {
@@ -435,9 +535,7 @@ ErrorOr<String> UTF16BEDecoder::to_utf8(StringView input)
     if (auto bytes = input.bytes(); bytes.size() >= 2 && bytes[0] == 0xFE && bytes[1] == 0xFF)
         bomless_input = input.substring_view(2);
 
-    StringBuilder builder(bomless_input.length() / 2);
-    TRY(process(bomless_input, [&builder](u32 c) { return builder.try_append_code_point(c); }));
-    return builder.to_string();
+    return utf16_to_utf8<UTF16Endianness::Big>(bomless_input);
 }
 
 ErrorOr<void> UTF16LEDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
@@ -508,9 +606,7 @@ ErrorOr<String> UTF16LEDecoder::to_utf8(StringView input)
     if (auto bytes = input.bytes(); bytes.size() >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE)
         bomless_input = input.substring_view(2);
 
-    StringBuilder builder(bomless_input.length() / 2);
-    TRY(process(bomless_input, [&builder](u32 c) { return builder.try_append_code_point(c); }));
-    return builder.to_string();
+    return utf16_to_utf8<UTF16Endianness::Little>(bomless_input);
 }
 
 ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
@@ -523,6 +619,11 @@ ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u3
     return {};
 }
 
+ErrorOr<String> Latin1Decoder::to_utf8(StringView input)
+{
+    return single_byte_encoding_to_utf8(input, [](u8 byte) -> u32 { return byte; });
+}
+
 ErrorOr<void> PDFDocEncodingDecoder::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
     // PDF 1.7 spec, Appendix D.2 "PDFDocEncoding Character Set"
@@ -594,6 +695,11 @@ ErrorOr<void> XUserDefinedDecoder::process(StringView input, Function<ErrorOr<vo
     return {};
 }
 
+ErrorOr<String> XUserDefinedDecoder::to_utf8(StringView input)
+{
+    return single_byte_encoding_to_utf8(input, [](u8 byte) -> u32 { return 0xF780 + byte - 0x80; });
+}
+
 // https://encoding.spec.whatwg.org/#single-byte-decoder
 template<Integral ArrayType>
 ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
@@ -617,6 +723,22 @@ ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<E
     return {};
 }
 
+template<Integral ArrayType>
+bool SingleByteDecoder<ArrayType>::validate(StringView input)
+{
+    for (u8 const byte : input) {
+        if (byte >= 0x80 && m_translation_table[byte - 0x80] == replacement_code_point)
+            return false;
+    }
+    return true;
+}
+
+template<Integral ArrayType>
+ErrorOr<String> SingleByteDecoder<ArrayType>::to_utf8(StringView input)
+{
+    return single_byte_encoding_to_utf8(input, [this](u8 byte) -> u32 { return m_translation_table[byte - 0x80]; });
+}
+
 // https://encoding.spec.whatwg.org/#index-gb18030-ranges-code-point
 static Optional<u32> index_gb18030_ranges_code_point(u32 pointer)
 {
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Queue.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+
+namespace Threading {
+
+// A queue that connects the stages of a pipeline running on different threads. Producers block while it is full, so a
+// fast stage can't run too far ahead of a slow one, and consumers block while it is empty.
+template<typename T>
+class BoundedQueue {
+    AK_MAKE_NONCOPYABLE(BoundedQueue);
+    AK_MAKE_NONMOVABLE(BoundedQueue);
+
+public:
+    explicit BoundedQueue(size_t capacity)
+        : m_capacity(capacity)
+    {
+        VERIFY(capacity > 0);
+    }
+
+    // Waits for room in the queue. Returns false without adding the value if the queue has been closed.
+    bool enqueue(T value)
+    {
+        MutexLocker locker(m_mutex);
+        while (m_queue.size() >= m_capacity && !m_closed)
+            m_not_full.wait();
+        if (m_closed)
+            return false;
+        m_queue.enqueue(move(value));
+        m_not_empty.signal();
+        return true;
+    }
+
+    // Waits for a value. Returns nothing once the queue has been closed and all values in it have been taken out.
+    Optional<T> dequeue()
+    {
+        MutexLocker locker(m_mutex);
+        while (m_queue.is_empty() && !m_closed)
+            m_not_empty.wait();
+        if (m_queue.is_empty())
+            return {};
+        auto value = m_queue.dequeue();
+        m_not_full.signal();
+        return value;
+    }
+
+    // Ends the stream of values. Consumers still get the values that are in the queue, but producers can't add more.
+    void close()
+    {
+        MutexLocker locker(m_mutex);
+        m_closed = true;
+        m_not_empty.broadcast();
+        m_not_full.broadcast();
+    }
+
+private:
+    size_t m_capacity { 0 };
+    bool m_closed { false };
+    Queue<T> m_queue;
+    Mutex m_mutex;
+    ConditionVariable m_not_empty { m_mutex };
+    ConditionVariable m_not_full { m_mutex };
+};
+
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibThreading/EventLoopThread.h>
+
+namespace Threading {
+
+ErrorOr<NonnullOwnPtr<EventLoopThread>> EventLoopThread::create(StringView thread_name)
+{
+    auto event_loop_thread = TRY(adopt_nonnull_own_or_enomem(new (nothrow) EventLoopThread));
+    auto& self = *event_loop_thread;
+
+    self.m_thread = TRY(Thread::try_create([&self]() -> intptr_t {
+        Core::EventLoop event_loop;
+        {
+            MutexLocker locker(self.m_mutex);
+            self.m_event_loop = &event_loop;
+            self.m_event_loop_changed.broadcast();
+        }
+
+        auto exit_code = event_loop.exec();
+
+        MutexLocker locker(self.m_mutex);
+        self.m_event_loop = nullptr;
+        return exit_code;
+    },
+        thread_name));
+    self.m_thread->start();
+
+    // Work may only be handed to the thread once its event loop exists.
+    MutexLocker locker(self.m_mutex);
+    self.m_event_loop_changed.wait_while([&] { return self.m_event_loop == nullptr; });
+    return event_loop_thread;
+}
+
+EventLoopThread::~EventLoopThread()
+{
+    {
+        MutexLocker locker(m_mutex);
+        if (m_event_loop) {
+            auto& event_loop = *m_event_loop;
+            event_loop.deferred_invoke([&event_loop] { event_loop.quit(0); });
+        }
+    }
+    (void)m_thread->join();
+}
+
+void EventLoopThread::deferred_invoke(Function<void()> function)
+{
+    MutexLocker locker(m_mutex);
+    VERIFY(m_event_loop);
+    // Posting an event to another thread's queue also wakes up that thread's event loop.
+    m_event_loop->deferred_invoke(move(function));
+}
+
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibCore/Forward.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace Threading {
+
+// A thread that runs a Core::EventLoop of its own, with its own ThreadEventQueue, notifiers and timers.
+//
+// Work is handed to the thread with deferred_invoke(), and everything created by that work (sockets, notifiers,
+// timers) belongs to the thread's event loop. The event loop is stopped and the thread joined on destruction.
+class EventLoopThread {
+    AK_MAKE_NONCOPYABLE(EventLoopThread);
+    AK_MAKE_NONMOVABLE(EventLoopThread);
+
+public:
+    static ErrorOr<NonnullOwnPtr<EventLoopThread>> create(StringView thread_name = {});
+    ~EventLoopThread();
+
+    // Runs the function on the thread during the next iteration of its event loop. Can be called from any thread.
+    void deferred_invoke(Function<void()>);
+
+    Thread const& thread() const { return *m_thread; }
+
+private:
+    EventLoopThread() = default;
+
+    RefPtr<Thread> m_thread;
+
+    Mutex m_mutex;
+    ConditionVariable m_event_loop_changed { m_mutex };
+    Core::EventLoop* m_event_loop { nullptr };
+};
+
+}
@@ -9,6 +9,8 @@
 
 namespace Threading {
 
+class EventLoopThread;
+
 template<typename ErrorType>
 class WorkerThread;
 
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/QuickSort.h>
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+#include <LibThreading/WorkStealingThreadPool.h>
+
+// Parallel versions of common algorithms, which run on the process-wide WorkStealingThreadPool.
+// Inputs that fit into a single slice are processed on the calling thread.
+
+namespace Threading {
+
+namespace Detail {
+
+// Splits the work into a few pieces per worker, so that idle workers have something to steal.
+inline size_t default_grain_size(size_t size)
+{
+    return max<size_t>(ceil_div(size, WorkStealingThreadPool::the().worker_count() * 8), 1);
+}
+
+template<typename T, typename Map, typename Reduce>
+auto parallel_reduce_impl(WorkStealingThreadPool& pool, Span<T> span, size_t grain_size, Map const& map, Reduce const& reduce) -> decltype(map(span))
+{
+    if (span.size() <= grain_size)
+        return map(span);
+
+    auto middle = span.size() / 2;
+    decltype(map(span)) left {};
+    decltype(map(span)) right {};
+    pool.fork_join(
+        [&] { left = parallel_reduce_impl(pool, span.trim(middle), grain_size, map, reduce); },
+        [&] { right = parallel_reduce_impl(pool, span.slice(middle), grain_size, map, reduce); });
+    return reduce(move(left), move(right));
+}
+
+template<typename T, typename LessThan>
+void parallel_sort_impl(WorkStealingThreadPool& pool, Span<T> span, size_t grain_size, LessThan const& less_than)
+{
+    if (span.size() <= grain_size) {
+        quick_sort(span, less_than);
+        return;
+    }
+
+    // A merge sort, since its halves are always the same size, no matter what the input looks like.
+    auto middle = span.size() / 2;
+    auto left = span.trim(middle);
+    auto right = span.slice(middle);
+    pool.fork_join(
+        [&] { parallel_sort_impl(pool, left, grain_size, less_than); },
+        [&] { parallel_sort_impl(pool, right, grain_size, less_than); });
+
+    if (!less_than(right.first(), left.last()))
+        return;
+
+    Vector<T> merged;
+    merged.ensure_capacity(span.size());
+    size_t left_index = 0;
+    size_t right_index = 0;
+    while (left_index < left.size() && right_index < right.size()) {
+        if (less_than(right[right_index], left[left_index]))
+            merged.unchecked_append(move(right[right_index++]));
+        else
+            merged.unchecked_append(move(left[left_index++]));
+    }
+    while (left_index < left.size())
+        merged.unchecked_append(move(left[left_index++]));
+    while (right_index < right.size())
+        merged.unchecked_append(move(right[right_index++]));
+
+    for (size_t i = 0; i < span.size(); ++i)
+        span[i] = move(merged[i]);
+}
+
+}
+
+// Calls the callback with consecutive slices of the span, possibly at the same time, and returns once all of them
+// have been processed.
+template<typename T, typename Callback>
+void parallel_for(Span<T> span, size_t grain_size, Callback const& callback)
+{
+    if (span.size() <= grain_size) {
+        if (!span.is_empty())
+            callback(span);
+        return;
+    }
+    WorkStealingThreadPool::the().parallel_for(span, grain_size, callback);
+}
+
+template<typename T, typename Callback>
+void parallel_for(Span<T> span, Callback const& callback)
+{
+    parallel_for(span, Detail::default_grain_size(span.size()), callback);
+}
+
+// Maps slices of the span to values with `map`, and combines those with `reduce`, which must be associative.
+// The slices are combined in order, so `reduce` does not have to be commutative.
+template<typename T, typename Map, typename Reduce>
+auto parallel_reduce(Span<T> span, size_t grain_size, Map const& map, Reduce const& reduce) -> decltype(map(span))
+{
+    VERIFY(grain_size > 0);
+    if (span.size() <= grain_size)
+        return map(span);
+    return Detail::parallel_reduce_impl(WorkStealingThreadPool::the(), span, grain_size, map, reduce);
+}
+
+template<typename T, typename Map, typename Reduce>
+auto parallel_reduce(Span<T> span, Map const& map, Reduce const& reduce) -> decltype(map(span))
+{
+    return parallel_reduce(span, Detail::default_grain_size(span.size()), map, reduce);
+}
+
+// Sorts the span like quick_sort(), which is also used for slices of up to grain_size elements.
+// Like quick_sort(), this is not a stable sort.
+template<typename T, typename LessThan>
+void parallel_sort(Span<T> span, size_t grain_size, LessThan const& less_than)
+{
+    VERIFY(grain_size > 0);
+    if (span.size() <= grain_size) {
+        quick_sort(span, less_than);
+        return;
+    }
+    Detail::parallel_sort_impl(WorkStealingThreadPool::the(), span, grain_size, less_than);
+}
+
+template<typename T, typename LessThan>
+void parallel_sort(Span<T> span, LessThan const& less_than)
+{
+    // Sorting small slices on a single thread is faster than handing them to other threads.
+    static constexpr size_t minimum_grain_size = 4096;
+    if (span.size() <= minimum_grain_size) {
+        quick_sort(span, less_than);
+        return;
+    }
+    parallel_sort(span, max(Detail::default_grain_size(span.size()), minimum_grain_size), less_than);
+}
+
+template<typename T>
+void parallel_sort(Span<T> span)
+{
+    parallel_sort(span, [](auto& a, auto& b) { return a < b; });
+}
+
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+
+namespace Threading {
+
+// A Chase-Lev work-stealing deque of pointers, with the memory orders from "Correct and Efficient Work-Stealing for
+// Weak Memory Models" (Lê et al., 2013).
+//
+// One thread owns the deque and pushes and pops at the bottom, like a stack. Any other thread can steal from the top,
+// so the oldest (and usually largest) pieces of work are the ones that move to other threads. Neither end takes a lock.
+template<typename T>
+class WorkStealingDeque {
+    AK_MAKE_NONCOPYABLE(WorkStealingDeque);
+    AK_MAKE_NONMOVABLE(WorkStealingDeque);
+
+public:
+    explicit WorkStealingDeque(size_t initial_capacity = 256)
+    {
+        VERIFY(is_power_of_two(initial_capacity));
+        auto buffer = make<Buffer>(initial_capacity);
+        m_buffer.store(buffer.ptr(), AK::MemoryOrder::memory_order_relaxed);
+        m_buffers.append(move(buffer));
+    }
+
+    // Only called by the owner.
+    void push(T* value)
+    {
+        auto bottom = m_bottom.load(AK::MemoryOrder::memory_order_relaxed);
+        auto top = m_top.load(AK::MemoryOrder::memory_order_acquire);
+        auto* buffer = m_buffer.load(AK::MemoryOrder::memory_order_relaxed);
+
+        if (bottom - top > static_cast<i64>(buffer->capacity()) - 1)
+            buffer = grow(buffer, top, bottom);
+
+        buffer->store(bottom, value);
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_release);
+        m_bottom.store(bottom + 1, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    // Only called by the owner. Returns the most recently pushed value, or nullptr if the deque is empty.
+    T* pop()
+    {
+        auto bottom = m_bottom.load(AK::MemoryOrder::memory_order_relaxed) - 1;
+        auto* buffer = m_buffer.load(AK::MemoryOrder::memory_order_relaxed);
+        m_bottom.store(bottom, AK::MemoryOrder::memory_order_relaxed);
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_seq_cst);
+        auto top = m_top.load(AK::MemoryOrder::memory_order_relaxed);
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, AK::MemoryOrder::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto* value = buffer->load(bottom);
+        if (top == bottom) {
+            // This is the last value, so a thief may be trying to take it at the same time.
+            if (!m_top.compare_exchange_strong(top, top + 1, AK::MemoryOrder::memory_order_seq_cst))
+                value = nullptr;
+            m_bottom.store(bottom + 1, AK::MemoryOrder::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    // Called by any thread. Returns the oldest value, or nullptr if the deque is empty or another thread got there first.
+    T* steal()
+    {
+        auto top = m_top.load(AK::MemoryOrder::memory_order_acquire);
+        AK::atomic_thread_fence(AK::MemoryOrder::memory_order_seq_cst);
+        auto bottom = m_bottom.load(AK::MemoryOrder::memory_order_acquire);
+
+        if (top >= bottom)
+            return nullptr;
+
+        auto* value = m_buffer.load(AK::MemoryOrder::memory_order_acquire)->load(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, AK::MemoryOrder::memory_order_seq_cst))
+            return nullptr;
+        return value;
+    }
+
+    // Only a snapshot, since other threads may be stealing at the same time.
+    bool is_empty() const
+    {
+        return m_bottom.load(AK::MemoryOrder::memory_order_relaxed) <= m_top.load(AK::MemoryOrder::memory_order_relaxed);
+    }
+
+private:
+    class Buffer {
+        AK_MAKE_NONCOPYABLE(Buffer);
+        AK_MAKE_NONMOVABLE(Buffer);
+
+    public:
+        explicit Buffer(size_t capacity)
+            : m_capacity(capacity)
+            , m_slots(new Atomic<T*>[capacity])
+        {
+        }
+
+        ~Buffer() { delete[] m_slots; }
+
+        size_t capacity() const { return m_capacity; }
+
+        T* load(i64 index) const { return m_slots[index & (m_capacity - 1)].load(AK::MemoryOrder::memory_order_relaxed); }
+        void store(i64 index, T* value) { m_slots[index & (m_capacity - 1)].store(value, AK::MemoryOrder::memory_order_relaxed); }
+
+    private:
+        size_t m_capacity { 0 };
+        Atomic<T*>* m_slots { nullptr };
+    };
+
+    Buffer* grow(Buffer* buffer, i64 top, i64 bottom)
+    {
+        auto new_buffer = make<Buffer>(buffer->capacity() * 2);
+        for (auto i = top; i < bottom; ++i)
+            new_buffer->store(i, buffer->load(i));
+
+        // Thieves may still be reading from the old buffer, so it is only freed along with the deque.
+        m_buffer.store(new_buffer.ptr(), AK::MemoryOrder::memory_order_release);
+        m_buffers.append(move(new_buffer));
+        return m_buffers.last().ptr();
+    }
+
+    AK_CACHE_ALIGNED Atomic<i64> m_top { 0 };
+    AK_CACHE_ALIGNED Atomic<i64> m_bottom { 0 };
+    Atomic<Buffer*> m_buffer { nullptr };
+    Vector<NonnullOwnPtr<Buffer>> m_buffers;
+};
+
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibThreading/WorkStealingThreadPool.h>
+#include <sched.h>
+
+namespace Threading {
+
+struct WorkStealingThreadPool::Worker {
+    WorkStealingThreadPool& pool;
+    size_t index { 0 };
+    WorkStealingDeque<QueuedTask> deque;
+    RefPtr<Thread> thread;
+    u32 random_state { 0 };
+
+    size_t next_victim()
+    {
+        // xorshift32, which is plenty for picking where to steal from.
+        random_state ^= random_state << 13;
+        random_state ^= random_state >> 17;
+        random_state ^= random_state << 5;
+        return random_state % pool.m_workers.size();
+    }
+};
+
+thread_local WorkStealingThreadPool::Worker* WorkStealingThreadPool::s_current_worker = nullptr;
+
+WorkStealingThreadPool& WorkStealingThreadPool::the()
+{
+    // Never destroyed, so that tasks don't have to be finished before the process can exit.
+    static WorkStealingThreadPool* s_the = MUST(create()).leak_ptr();
+    return *s_the;
+}
+
+ErrorOr<NonnullOwnPtr<WorkStealingThreadPool>> WorkStealingThreadPool::create(Optional<size_t> concurrency)
+{
+    auto worker_count = max<size_t>(concurrency.value_or(Core::System::hardware_concurrency()), 1);
+    auto pool = TRY(adopt_nonnull_own_or_enomem(new (nothrow) WorkStealingThreadPool));
+
+    TRY(pool->m_workers.try_ensure_capacity(worker_count));
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto worker = TRY(adopt_nonnull_own_or_enomem(new (nothrow) Worker { .pool = *pool, .index = i, .random_state = static_cast<u32>(i + 1) }));
+        worker->thread = TRY(Thread::try_create([&pool = *pool, &worker = *worker]() -> intptr_t {
+            pool.worker_loop(worker);
+            return 0;
+        },
+            "ThreadPool worker"sv));
+        pool->m_workers.unchecked_append(move(worker));
+    }
+
+    for (auto& worker : pool->m_workers)
+        worker->thread->start();
+
+    return pool;
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    m_should_exit.store(true, AK::MemoryOrder::memory_order_release);
+    {
+        MutexLocker locker(m_sleep_mutex);
+        m_work_available.broadcast();
+    }
+
+    for (auto& worker : m_workers) {
+        if (worker->thread->needs_to_be_joined())
+            (void)worker->thread->join();
+    }
+}
+
+void WorkStealingThreadPool::submit(Task task)
+{
+    m_unfinished_task_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    enqueue(make<QueuedTask>(move(task), nullptr));
+}
+
+void WorkStealingThreadPool::spawn(TaskGroup& group, Task task)
+{
+    group.m_pending_tasks.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    m_unfinished_task_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    enqueue(make<QueuedTask>(move(task), &group));
+}
+
+void WorkStealingThreadPool::wait(TaskGroup& group)
+{
+    auto* worker = s_current_worker && &s_current_worker->pool == this ? s_current_worker : nullptr;
+    while (!group.is_done()) {
+        if (!run_one_task(worker))
+            sched_yield();
+    }
+}
+
+void WorkStealingThreadPool::wait_for_all()
+{
+    auto* worker = s_current_worker && &s_current_worker->pool == this ? s_current_worker : nullptr;
+    while (m_unfinished_task_count.load(AK::MemoryOrder::memory_order_acquire) > 0) {
+        if (!run_one_task(worker))
+            sched_yield();
+    }
+}
+
+void WorkStealingThreadPool::enqueue(NonnullOwnPtr<QueuedTask> task)
+{
+    // Count the task before it can be found, so that the count never drops below zero.
+    m_queued_task_count.fetch_add(1, AK::MemoryOrder::memory_order_seq_cst);
+
+    if (s_current_worker && &s_current_worker->pool == this) {
+        s_current_worker->deque.push(task.leak_ptr());
+    } else {
+        m_injection_queue.with_locked([&](auto& queue) {
+            queue.enqueue(task.leak_ptr());
+        });
+    }
+
+    // Only wake a worker if one is asleep. Sleeping workers check the queued task count after announcing that they
+    // are going to sleep, so either they see this task or we see them.
+    if (m_sleeping_worker_count.load(AK::MemoryOrder::memory_order_seq_cst) > 0) {
+        MutexLocker locker(m_sleep_mutex);
+        m_work_available.signal();
+    }
+}
+
+WorkStealingThreadPool::QueuedTask* WorkStealingThreadPool::find_task(Worker* worker)
+{
+    auto take = [this](QueuedTask* task) {
+        if (task)
+            m_queued_task_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+        return task;
+    };
+
+    if (worker) {
+        if (auto* task = worker->deque.pop())
+            return take(task);
+    }
+
+    if (m_queued_task_count.load(AK::MemoryOrder::memory_order_relaxed) == 0)
+        return nullptr;
+
+    auto* injected_task = m_injection_queue.with_locked([](auto& queue) -> QueuedTask* {
+        if (queue.is_empty())
+            return nullptr;
+        return queue.dequeue();
+    });
+    if (injected_task)
+        return take(injected_task);
+
+    auto first_victim = worker ? worker->next_victim() : 0;
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        auto& victim = m_workers[(first_victim + i) % m_workers.size()];
+        if (victim.ptr() == worker)
+            continue;
+        if (auto* task = victim->deque.steal())
+            return take(task);
+    }
+
+    return nullptr;
+}
+
+void WorkStealingThreadPool::run(QueuedTask* raw_task)
+{
+    auto task = adopt_own(*raw_task);
+    task->task();
+
+    if (task->group)
+        task->group->m_pending_tasks.fetch_sub(1, AK::MemoryOrder::memory_order_release);
+    m_unfinished_task_count.fetch_sub(1, AK::MemoryOrder::memory_order_release);
+}
+
+bool WorkStealingThreadPool::run_one_task(Worker* worker)
+{
+    auto* task = find_task(worker);
+    if (!task)
+        return false;
+    run(task);
+    return true;
+}
+
+void WorkStealingThreadPool::worker_loop(Worker& worker)
+{
+    s_current_worker = &worker;
+
+    for (;;) {
+        if (run_one_task(&worker))
+            continue;
+
+        if (m_should_exit.load(AK::MemoryOrder::memory_order_acquire))
+            break;
+
+        // A steal can fail because another thread took the task first, so look again while there is work around.
+        if (m_queued_task_count.load(AK::MemoryOrder::memory_order_relaxed) > 0) {
+            sched_yield();
+            continue;
+        }
+
+        MutexLocker locker(m_sleep_mutex);
+        m_sleeping_worker_count.fetch_add(1, AK::MemoryOrder::memory_order_seq_cst);
+        if (m_queued_task_count.load(AK::MemoryOrder::memory_order_seq_cst) == 0 && !m_should_exit.load(AK::MemoryOrder::memory_order_acquire))
+            m_work_available.wait();
+        m_sleeping_worker_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    s_current_worker = nullptr;
+}
+
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Queue.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/MutexProtected.h>
+#include <LibThreading/Thread.h>
+#include <LibThreading/WorkStealingDeque.h>
+
+namespace Threading {
+
+// A thread pool for splitting up CPU-bound work, like decoding an image or compressing a file.
+//
+// Each worker keeps the tasks it spawns in its own deque and runs them most recent first, while idle workers steal
+// the oldest tasks from the others. Tasks submitted from outside the pool go into a shared injection queue. Threads
+// that wait for tasks run other tasks in the meantime, so tasks may wait for tasks they spawned without deadlocking.
+class WorkStealingThreadPool {
+    AK_MAKE_NONCOPYABLE(WorkStealingThreadPool);
+    AK_MAKE_NONMOVABLE(WorkStealingThreadPool);
+
+public:
+    using Task = Function<void()>;
+
+    // Tasks spawned into a group can be waited for together.
+    class TaskGroup {
+        AK_MAKE_NONCOPYABLE(TaskGroup);
+        AK_MAKE_NONMOVABLE(TaskGroup);
+
+    public:
+        TaskGroup() = default;
+        ~TaskGroup() { VERIFY(is_done()); }
+
+        bool is_done() const { return m_pending_tasks.load(AK::MemoryOrder::memory_order_acquire) == 0; }
+
+    private:
+        friend class WorkStealingThreadPool;
+
+        Atomic<size_t> m_pending_tasks { 0 };
+    };
+
+    // A pool with one worker per processor, for everyone in the process to share.
+    static WorkStealingThreadPool& the();
+
+    static ErrorOr<NonnullOwnPtr<WorkStealingThreadPool>> create(Optional<size_t> concurrency = {});
+    ~WorkStealingThreadPool();
+
+    size_t worker_count() const { return m_workers.size(); }
+
+    // Runs the task on one of the workers, without a way to wait for it other than wait_for_all().
+    void submit(Task);
+
+    void spawn(TaskGroup&, Task);
+
+    // Runs tasks until all tasks in the group have finished.
+    void wait(TaskGroup&);
+
+    // Runs tasks until all tasks that were submitted or spawned have finished.
+    void wait_for_all();
+
+    // Runs both callbacks, possibly at the same time, and returns once both have returned.
+    template<typename A, typename B>
+    void fork_join(A&& a, B&& b)
+    {
+        TaskGroup group;
+        spawn(group, [&b] { b(); });
+        a();
+        wait(group);
+    }
+
+    // Calls the callback with slices of the span, which are at most grain_size long, and returns once all of them
+    // have been processed. The slices are processed in no particular order, possibly at the same time.
+    template<typename T, typename Callback>
+    void parallel_for(Span<T> span, size_t grain_size, Callback const& callback)
+    {
+        VERIFY(grain_size > 0);
+        TaskGroup group;
+        parallel_for_impl(group, span, grain_size, callback);
+        wait(group);
+    }
+
+private:
+    struct Worker;
+
+    struct QueuedTask {
+        Task task;
+        TaskGroup* group { nullptr };
+    };
+
+    WorkStealingThreadPool() = default;
+
+    template<typename T, typename Callback>
+    void parallel_for_impl(TaskGroup& group, Span<T> span, size_t grain_size, Callback const& callback)
+    {
+        // Hand off halves, so that a thief takes a large piece of work and splits it up further on its own worker.
+        while (span.size() > grain_size) {
+            auto second_half = span.slice(span.size() / 2);
+            spawn(group, [this, &group, second_half, grain_size, &callback] {
+                parallel_for_impl(group, second_half, grain_size, callback);
+            });
+            span = span.trim(span.size() / 2);
+        }
+        callback(span);
+    }
+
+    void enqueue(NonnullOwnPtr<QueuedTask>);
+    QueuedTask* find_task(Worker*);
+    void run(QueuedTask*);
+    bool run_one_task(Worker*);
+    void worker_loop(Worker&);
+
+    static thread_local Worker* s_current_worker;
+
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+    MutexProtected<Queue<QueuedTask*>> m_injection_queue;
+
+    // Tasks that are in a queue, so idle workers know whether to go to sleep.
+    AK_CACHE_ALIGNED Atomic<size_t> m_queued_task_count { 0 };
+    // Tasks that haven't finished yet, for wait_for_all().
+    AK_CACHE_ALIGNED Atomic<size_t> m_unfinished_task_count { 0 };
+
+    Mutex m_sleep_mutex;
+    ConditionVariable m_work_available { m_sleep_mutex };
+    Atomic<size_t> m_sleeping_worker_count { 0 };
+    Atomic<bool> m_should_exit { false };
+};
+
+}
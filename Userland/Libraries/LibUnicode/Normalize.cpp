@@ -297,13 +297,90 @@ static Vector<u32> normalize_implementation(Utf8View string, NormalizationForm f
     VERIFY_NOT_REACHED();
 }
 
+// Every code point below this limit is a starter that is left alone by the normalization form (its quick check property
+// is Yes), and that no preceding code point combines with.
+static constexpr u32 quick_check_limit(NormalizationForm form)
+{
+    switch (form) {
+    case NormalizationForm::NFD:
+        // U+00C0 is the first code point with a canonical decomposition.
+        return 0xC0;
+    case NormalizationForm::NFC:
+        // U+0300 is the first combining mark.
+        return 0x300;
+    case NormalizationForm::NFKD:
+    case NormalizationForm::NFKC:
+        // U+00A0 is the first code point with a compatibility decomposition.
+        return 0xA0;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// Returns the byte offset of the first code point at or after the given offset that isn't below the limit.
+static size_t find_code_point_at_or_above(Utf8View const& view, size_t byte_offset, u32 limit)
+{
+    size_t next_ascii_run_check = byte_offset;
+
+    for (auto it = view.iterator_at_byte_offset_without_validation(byte_offset); it != view.end();) {
+        auto offset = view.byte_offset_of(it);
+        if (offset >= next_ascii_run_check) {
+            if (auto ascii_length = view.length_of_ascii_run(offset); ascii_length > 0) {
+                it = view.iterator_at_byte_offset_without_validation(offset + ascii_length);
+                continue;
+            }
+            next_ascii_run_check = offset + Utf8View::ascii_chunk_size;
+        }
+
+        // Overlong encodings are left to the normalization, which replaces them.
+        auto code_point = *it;
+        if (code_point >= limit || it.underlying_code_point_length_in_bytes() != (code_point < 0x80 ? 1u : 2u))
+            return offset;
+        ++it;
+    }
+    return view.byte_length();
+}
+
+// Returns the byte offset of the first code point after the one at the given offset that is below the limit.
+static size_t find_code_point_below(Utf8View const& view, size_t byte_offset, u32 limit)
+{
+    auto it = view.iterator_at_byte_offset_without_validation(byte_offset);
+    for (++it; it != view.end(); ++it) {
+        if (*it < limit)
+            return view.byte_offset_of(it);
+    }
+    return view.byte_length();
+}
+
 String normalize(StringView string, NormalizationForm form)
 {
-    auto const code_points = normalize_implementation(Utf8View { string }, form);
+    Utf8View view { string };
+    auto limit = quick_check_limit(form);
+
+    // Most text is made up of code points that don't change, which we can copy over as they are. Only the runs of other
+    // code points (together with the starter in front of them, which they might combine with) have to be normalized.
+    auto offset = find_code_point_at_or_above(view, 0, limit);
+    if (offset == string.length())
+        return String::from_utf8_without_validation(string.bytes());
 
     StringBuilder builder;
-    for (auto code_point : code_points)
-        builder.append_code_point(code_point);
+    size_t copied_up_to = 0;
+    while (offset < string.length()) {
+        auto segment_start = offset;
+        if (segment_start > copied_up_to) {
+            --segment_start;
+            while (segment_start > copied_up_to && (static_cast<u8>(string[segment_start]) & 0xC0) == 0x80)
+                --segment_start;
+        }
+        auto segment_end = find_code_point_below(view, offset, limit);
+
+        builder.append(string.substring_view(copied_up_to, segment_start - copied_up_to));
+        for (auto code_point : normalize_implementation(view.substring_view(segment_start, segment_end - segment_start), form))
+            builder.append_code_point(code_point);
+
+        copied_up_to = segment_end;
+        offset = find_code_point_at_or_above(view, segment_end, limit);
+    }
+    builder.append(string.substring_view(copied_up_to));
 
     return MUST(builder.to_string());
 }
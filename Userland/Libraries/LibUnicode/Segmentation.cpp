@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
+#include <AK/CharacterTypes.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf32View.h>
 #include <AK/Utf8View.h>
@@ -86,6 +88,17 @@ static void for_each_grapheme_segmentation_boundary_impl([[maybe_unused]] ViewTy
         for (++it; it != view.end(); ++it, code_point = next_code_point) {
             next_code_point = *it;
 
+            // No ASCII code point has a property that joins it with a following ASCII code point, except for CR LF. So
+            // ASCII text can be segmented without looking up any of the properties.
+            if (is_ascii(code_point) && is_ascii(next_code_point)) {
+                current_ri_chain = 0;
+                if (code_point == '\r' && next_code_point == '\n')
+                    continue;
+                if (callback(code_unit_offset_of(view, it)) == IterationDecision::Break)
+                    return;
+                continue;
+            }
+
             // GB9c
             if (code_point_has_property(code_point, Property::InCB_Consonant)) {
                 auto it_copy = it;
@@ -190,6 +203,76 @@ void for_each_grapheme_segmentation_boundary(Utf32View const& view, Segmentation
     for_each_grapheme_segmentation_boundary_impl(view, move(callback));
 }
 
+#if ENABLE_UNICODE_DATA
+// The word break properties of a code point, looked up once so the rules can check them as often as they need to.
+struct WordBreakProperties {
+    static constexpr Array properties {
+        WordBreakProperty::ALetter,
+        WordBreakProperty::CR,
+        WordBreakProperty::Double_Quote,
+        WordBreakProperty::Extend,
+        WordBreakProperty::ExtendNumLet,
+        WordBreakProperty::Format,
+        WordBreakProperty::Hebrew_Letter,
+        WordBreakProperty::Katakana,
+        WordBreakProperty::LF,
+        WordBreakProperty::MidLetter,
+        WordBreakProperty::MidNum,
+        WordBreakProperty::MidNumLet,
+        WordBreakProperty::Newline,
+        WordBreakProperty::Numeric,
+        WordBreakProperty::Regional_Indicator,
+        WordBreakProperty::Single_Quote,
+        WordBreakProperty::WSegSpace,
+        WordBreakProperty::ZWJ,
+    };
+
+    static constexpr u32 bit_of(WordBreakProperty property)
+    {
+        for (size_t i = 0; i < properties.size(); ++i) {
+            if (properties[i] == property)
+                return 1u << i;
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+    template<typename... Properties>
+    bool has_any(Properties... properties) const
+    {
+        return (mask & (bit_of(properties) | ...)) != 0;
+    }
+
+    u32 mask { 0 };
+    bool is_extended_pictographic { false };
+};
+
+static WordBreakProperties look_up_word_break_properties(u32 code_point)
+{
+    WordBreakProperties result;
+    for (auto property : WordBreakProperties::properties) {
+        if (code_point_has_word_break_property(code_point, property))
+            result.mask |= WordBreakProperties::bit_of(property);
+    }
+    result.is_extended_pictographic = code_point_has_property(code_point, Property::Extended_Pictographic);
+    return result;
+}
+
+static WordBreakProperties word_break_properties_of(u32 code_point)
+{
+    // Most text is ASCII, so its properties are looked up once and kept in a table.
+    static auto const ascii_properties = [] {
+        Array<WordBreakProperties, 128> properties;
+        for (u32 code_point = 0; code_point < properties.size(); ++code_point)
+            properties[code_point] = look_up_word_break_properties(code_point);
+        return properties;
+    }();
+
+    if (is_ascii(code_point))
+        return ascii_properties[code_point];
+    return look_up_word_break_properties(code_point);
+}
+#endif
+
 template<typename ViewType>
 static void for_each_word_segmentation_boundary_impl([[maybe_unused]] ViewType const& view, [[maybe_unused]] SegmentationCallback callback)
 {
@@ -200,8 +283,8 @@ static void for_each_word_segmentation_boundary_impl([[maybe_unused]] ViewType c
     if (view.is_empty())
         return;
 
-    auto has_any_wbp = [](u32 code_point, auto&&... properties) {
-        return (code_point_has_word_break_property(code_point, properties) || ...);
+    auto has_any_wbp = [](WordBreakProperties const& code_point_properties, auto&&... properties) {
+        return code_point_properties.has_any(properties...);
     };
 
     // WB1
@@ -210,13 +293,15 @@ static void for_each_word_segmentation_boundary_impl([[maybe_unused]] ViewType c
 
     if (code_unit_length(view) > 1) {
         auto it = view.begin();
-        auto code_point = *it;
-        u32 next_code_point;
-        Optional<u32> previous_code_point;
+        auto code_point = word_break_properties_of(*it);
+        WordBreakProperties next_code_point;
+        Optional<WordBreakProperties> previous_code_point;
+        // The rules look one code point ahead, whose properties are kept for the next iteration.
+        Optional<WordBreakProperties> lookahead_code_point;
         auto current_ri_chain = 0;
 
         for (++it; it != view.end(); ++it, previous_code_point = code_point, code_point = next_code_point) {
-            next_code_point = *it;
+            next_code_point = lookahead_code_point.has_value() ? lookahead_code_point.release_value() : word_break_properties_of(*it);
 
             auto code_point_is_cr = has_any_wbp(code_point, WBP::CR);
             auto next_code_point_is_lf = has_any_wbp(next_code_point, WBP::LF);
@@ -231,7 +316,7 @@ static void for_each_word_segmentation_boundary_impl([[maybe_unused]] ViewType c
                 continue;
             }
             // WB3c
-            if (has_any_wbp(code_point, WBP::ZWJ) && code_point_has_property(next_code_point, Property::Extended_Pictographic))
+            if (has_any_wbp(code_point, WBP::ZWJ) && next_code_point.is_extended_pictographic)
                 continue;
             // WB3d
             if (has_any_wbp(code_point, WBP::WSegSpace) && has_any_wbp(next_code_point, WBP::WSegSpace))
@@ -250,12 +335,14 @@ static void for_each_word_segmentation_boundary_impl([[maybe_unused]] ViewType c
             if (code_point_is_ah_letter && next_code_point_is_ah_letter)
                 continue;
 
-            Optional<u32> next_next_code_point;
+            Optional<WordBreakProperties> next_next_code_point;
             if (it != view.end()) {
                 auto it_copy = it;
                 ++it_copy;
-                if (it_copy != view.end())
-                    next_next_code_point = *it_copy;
+                if (it_copy != view.end()) {
+                    lookahead_code_point = word_break_properties_of(*it_copy);
+                    next_next_code_point = lookahead_code_point;
+                }
             }
             bool next_next_code_point_is_hebrew_letter = next_next_code_point.has_value() && has_any_wbp(*next_next_code_point, WBP::Hebrew_Letter);
             bool next_next_code_point_is_ah_letter = next_next_code_point_is_hebrew_letter || (next_next_code_point.has_value() && has_any_wbp(*next_next_code_point, WBP::ALetter));
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Painter.h>
+#include <LibVT/GlyphAtlas.h>
+
+namespace VT {
+
+void GlyphAtlas::set_parameters(Gfx::Font const& font, Gfx::Font const& bold_font, Gfx::IntSize cell_size, int glyph_offset, int scale)
+{
+    if (m_font == &font && m_bold_font == &bold_font && m_cell_size == cell_size && m_glyph_offset == glyph_offset && m_scale == scale)
+        return;
+
+    m_font = font;
+    m_bold_font = bold_font;
+    m_cell_size = cell_size;
+    m_glyph_offset = glyph_offset;
+    m_scale = scale;
+    m_bitmap = nullptr;
+    m_slots.clear();
+}
+
+bool GlyphAtlas::can_draw(u32 code_point, bool bold) const
+{
+    auto const& font = bold ? *m_bold_font : *m_font;
+    return font.contains_glyph(code_point) && font.glyph_width(code_point) <= m_cell_size.width();
+}
+
+Gfx::IntRect GlyphAtlas::rect_of_slot(size_t slot) const
+{
+    return {
+        static_cast<int>(slot % cells_per_row) * m_cell_size.width(),
+        static_cast<int>(slot / cells_per_row) * m_cell_size.height(),
+        m_cell_size.width(),
+        m_cell_size.height(),
+    };
+}
+
+ErrorOr<Gfx::IntRect> GlyphAtlas::cell_rect(u32 code_point, bool bold, Gfx::Color foreground, Gfx::Color background)
+{
+    Key key { code_point, bold, foreground, background };
+    if (auto slot = m_slots.get(key); slot.has_value())
+        return rect_of_slot(*slot);
+
+    if (!m_bitmap) {
+        Gfx::IntSize size { m_cell_size.width() * cells_per_row, m_cell_size.height() * rows_of_cells };
+        m_bitmap = TRY(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, size, m_scale));
+    }
+
+    // Once the atlas is full, the cells start over from scratch. The cells of a screenful of output are usually drawn
+    // many times over before that happens.
+    if (m_slots.size() == cells_per_row * rows_of_cells)
+        m_slots.clear();
+
+    auto slot = m_slots.size();
+    TRY(m_slots.try_set(key, slot));
+
+    auto rect = rect_of_slot(slot);
+    Gfx::Painter painter(*m_bitmap);
+    painter.add_clip_rect(rect);
+    painter.clear_rect(rect, background);
+    painter.draw_glyph(rect.location().translated(0, m_glyph_offset), code_point, bold ? *m_bold_font : *m_font, foreground);
+    return rect;
+}
+
+}
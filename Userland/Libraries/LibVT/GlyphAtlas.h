@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/RefPtr.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/Color.h>
+#include <LibGfx/Font/Font.h>
+#include <LibGfx/Rect.h>
+
+namespace VT {
+
+// Keeps cells that have been drawn before (their background and glyph) in a single bitmap, so that drawing them again
+// is a plain copy of their pixels instead of rasterizing and blending the glyph.
+class GlyphAtlas {
+public:
+    // Forgets all cells if any of the parameters changed since the last call.
+    void set_parameters(Gfx::Font const& font, Gfx::Font const& bold_font, Gfx::IntSize cell_size, int glyph_offset, int scale);
+
+    // Returns whether the glyph can be drawn entirely within a cell, which is the case for most monospace glyphs.
+    bool can_draw(u32 code_point, bool bold) const;
+
+    // Returns the rect of the cell in bitmap(), drawing it first if necessary.
+    ErrorOr<Gfx::IntRect> cell_rect(u32 code_point, bool bold, Gfx::Color foreground, Gfx::Color background);
+
+    Gfx::Bitmap const& bitmap() const { return *m_bitmap; }
+
+private:
+    static constexpr int cells_per_row = 32;
+    static constexpr int rows_of_cells = 16;
+
+    struct Key {
+        u32 code_point { 0 };
+        bool bold { false };
+        Gfx::Color foreground;
+        Gfx::Color background;
+
+        bool operator==(Key const&) const = default;
+    };
+
+    struct KeyTraits : public DefaultTraits<Key> {
+        static unsigned hash(Key const& key)
+        {
+            return pair_int_hash(pair_int_hash(key.code_point << 1 | key.bold, key.foreground.value()), key.background.value());
+        }
+    };
+
+    Gfx::IntRect rect_of_slot(size_t slot) const;
+
+    RefPtr<Gfx::Font const> m_font;
+    RefPtr<Gfx::Font const> m_bold_font;
+    Gfx::IntSize m_cell_size;
+    int m_glyph_offset { 0 };
+    int m_scale { 1 };
+
+    RefPtr<Gfx::Bitmap> m_bitmap;
+    HashMap<Key, size_t, KeyTraits> m_slots;
+};
+
+}
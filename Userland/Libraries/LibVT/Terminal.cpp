@@ -850,10 +850,12 @@ void Terminal::scroll_up(u16 region_top, u16 region_bottom, size_t count)
         for (u16 row = region_bottom + 1 - count; row <= region_bottom; ++row)
             active_buffer()[row]->clear();
     }
-    // Set dirty flag on swapped lines.
+    // Set dirty flag on swapped lines, unless the client could move them on screen.
     // The other lines have implicitly been set dirty by being cleared.
-    for (u16 row = region_top; row + count <= region_bottom; ++row)
-        active_buffer()[row]->set_dirty(true);
+    if (!m_client.terminal_did_scroll(region_top, region_bottom, count)) {
+        for (u16 row = region_top; row + count <= region_bottom; ++row)
+            active_buffer()[row]->set_dirty(true);
+    }
     m_client.terminal_history_changed(history_delta);
 }
 
@@ -875,10 +877,12 @@ void Terminal::scroll_down(u16 region_top, u16 region_bottom, size_t count)
     // Clear the 'new' lines at the top.
     for (u16 row = region_top; row < region_top + count; ++row)
         active_buffer()[row]->clear();
-    // Set dirty flag on swapped lines.
+    // Set dirty flag on swapped lines, unless the client could move them on screen.
     // The other lines have implicitly been set dirty by being cleared.
-    for (u16 row = region_top + count; row <= region_bottom; ++row)
-        active_buffer()[row]->set_dirty(true);
+    if (!m_client.terminal_did_scroll(region_top, region_bottom, -static_cast<int>(count))) {
+        for (u16 row = region_top + count; row <= region_bottom; ++row)
+            active_buffer()[row]->set_dirty(true);
+    }
 }
 
 // Insert `count` blank cells at the end of the line. Text moves left.
@@ -51,6 +51,9 @@ public:
     virtual void terminal_did_resize(u16 columns, u16 rows) = 0;
     virtual void terminal_history_changed(int delta) = 0;
     virtual void terminal_did_perform_possibly_partial_clear() = 0;
+    // Called once the lines in the region have moved up (positive `count`) or down (negative `count`). Returns whether
+    // the client moved what it displays for them along, in which case they aren't marked dirty.
+    virtual bool terminal_did_scroll([[maybe_unused]] u16 region_top, [[maybe_unused]] u16 region_bottom, [[maybe_unused]] int count) { return false; }
     virtual void emit(u8 const*, size_t) = 0;
     virtual void set_cursor_shape(CursorShape) = 0;
     virtual void set_cursor_blinking(bool) = 0;
@@ -81,7 +81,7 @@ void TerminalWidget::set_pty_master_fd(int fd)
             handle_pty_owner_change(pgrp);
         }
 
-        flush_dirty_lines();
+        schedule_flush_of_dirty_lines();
     };
 }
 
@@ -104,6 +104,12 @@ TerminalWidget::TerminalWidget(int ptm_fd, bool automatic_size_policy)
     m_cursor_blink_timer = add<Core::Timer>();
     m_visual_beep_timer = add<Core::Timer>();
     m_auto_scroll_timer = add<Core::Timer>();
+    m_flush_timer = add<Core::Timer>();
+
+    m_flush_timer->set_single_shot(true);
+    m_flush_timer->on_timeout = [this] {
+        flush_dirty_lines();
+    };
 
     m_scrollbar = add<GUI::Scrollbar>(Orientation::Vertical);
     m_scrollbar->set_scroll_animation(GUI::Scrollbar::Animation::CoarseScroll);
@@ -291,10 +297,6 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
 
     painter.add_clip_rect(event.rect());
 
-    if (visual_beep_active)
-        painter.clear_rect(frame_inner_rect(), terminal_color_to_rgb(VT::Color::named(VT::Color::ANSIColor::Red)));
-    else
-        painter.clear_rect(frame_inner_rect(), terminal_color_to_rgb(VT::Color::named(VT::Color::ANSIColor::DefaultBackground)).with_alpha(m_opacity));
     invalidate_cursor();
 
     int rows_from_history = 0;
@@ -306,6 +308,108 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
         row_with_cursor = m_terminal.cursor_row() + rows_from_history;
     }
 
+    if (auto result = render_rows(event.rect(), painter.scale(), visual_beep_active, first_row_from_history, row_with_cursor); result.is_error()) {
+        dbgln("TerminalWidget: Failed to render rows: {}", result.error());
+        return;
+    }
+
+    auto rect_to_copy = event.rect().intersected(frame_inner_rect());
+    painter.blit(rect_to_copy.location(), *m_rendered_rows, rect_to_copy.translated(-frame_inner_rect().location()), 1.0f, false);
+
+    // Draw cursor.
+    if (m_cursor_blink_state && row_with_cursor < m_terminal.rows()) {
+        auto& cursor_line = m_terminal.line(first_row_from_history + row_with_cursor);
+        if (m_terminal.cursor_row() >= (m_terminal.rows() - rows_from_history))
+            return;
+
+        if (m_has_logical_focus && m_cursor_shape == VT::CursorShape::Block)
+            return; // This has already been handled by inverting the cell colors
+
+        auto cursor_color = terminal_color_to_rgb(cursor_line.attribute_at(m_terminal.cursor_column()).effective_foreground_color());
+        auto cell_rect = glyph_rect(row_with_cursor, m_terminal.cursor_column()).inflated(0, m_line_spacing);
+        if (m_cursor_shape == VT::CursorShape::Underline) {
+            auto x1 = cell_rect.left();
+            auto x2 = cell_rect.right();
+            auto y = cell_rect.bottom() - 1;
+            for (auto x = x1; x < x2; ++x)
+                painter.set_pixel({ x, y }, cursor_color);
+        } else if (m_cursor_shape == VT::CursorShape::Bar) {
+            auto x = cell_rect.left();
+            auto y1 = cell_rect.top();
+            auto y2 = cell_rect.bottom();
+            for (auto y = y1; y < y2; ++y)
+                painter.set_pixel({ x, y }, cursor_color);
+        } else {
+            // We fall back to a block if we don't support the selected cursor type.
+            painter.draw_rect(cell_rect, cursor_color);
+        }
+    }
+}
+
+void TerminalWidget::invalidate_rendered_rows()
+{
+    m_rendered_state.clear();
+}
+
+ErrorOr<void> TerminalWidget::render_rows(Gfx::IntRect const& rect, int scale, bool visual_beep_active, int first_row_from_history, int row_with_cursor)
+{
+    auto inner_rect = frame_inner_rect();
+    RenderState state {
+        .selection = m_selection,
+        .rectangle_selection = m_rectangle_selection,
+        .hovered_href_id = m_hovered_href_id,
+        .active_href_id = m_active_href_id,
+        .has_logical_focus = m_has_logical_focus,
+        .cursor_shape = m_cursor_shape,
+        .visual_beep_active = visual_beep_active,
+        .first_row_from_history = first_row_from_history - static_cast<int>(m_terminal.history_size()),
+        .rows = m_terminal.rows(),
+        .columns = m_terminal.columns(),
+        .size = inner_rect.size(),
+        .scale = scale,
+    };
+
+    if (m_rendered_state != state) {
+        if (!m_rendered_rows || m_rendered_rows->size() != state.size || m_rendered_rows->scale() != scale)
+            m_rendered_rows = TRY(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, state.size, scale));
+
+        Gfx::Painter painter(*m_rendered_rows);
+        if (visual_beep_active)
+            painter.clear_rect({ {}, state.size }, terminal_color_to_rgb(VT::Color::named(VT::Color::ANSIColor::Red)));
+        else
+            painter.clear_rect({ {}, state.size }, terminal_color_to_rgb(VT::Color::named(VT::Color::ANSIColor::DefaultBackground)).with_alpha(m_opacity));
+
+        TRY(m_rendered_row_is_valid.try_resize(m_terminal.rows()));
+        m_rendered_row_is_valid.span().fill(false);
+        m_rendered_state = state;
+    }
+
+    // The hovered link is highlighted across the rows around it, so the rows can't be rendered separately.
+    if (m_hovered_href_id.has_value())
+        m_rendered_row_is_valid.span().fill(false);
+
+    // The cursor blinks and moves without its line becoming dirty, so the rows it was and is on are always rendered.
+    if (m_rendered_row_with_cursor.has_value() && *m_rendered_row_with_cursor < m_rendered_row_is_valid.size())
+        m_rendered_row_is_valid[*m_rendered_row_with_cursor] = false;
+    if (row_with_cursor >= 0 && static_cast<size_t>(row_with_cursor) < m_rendered_row_is_valid.size())
+        m_rendered_row_is_valid[row_with_cursor] = false;
+
+    Vector<u16> rows_to_render;
+    for (u16 visual_row = 0; visual_row < m_terminal.rows(); ++visual_row) {
+        if (!m_rendered_row_is_valid[visual_row] && rect.intersects(row_rect(visual_row)))
+            TRY(rows_to_render.try_append(visual_row));
+    }
+    if (rows_to_render.is_empty())
+        return {};
+
+    Gfx::Painter painter(*m_rendered_rows);
+    painter.translate(-inner_rect.x(), -inner_rect.y());
+
+    auto& font = this->font();
+    auto& bold_font = font.bold_variant();
+    m_glyph_atlas.set_parameters(font, bold_font, { m_column_width, m_line_height }, m_line_spacing / 2, scale);
+    auto can_use_glyph_atlas = !visual_beep_active && !m_hovered_href_id.has_value();
+
     // Pass: Compute the rect(s) of the currently hovered link, if any.
     Vector<Gfx::IntRect> hovered_href_rects;
     if (m_hovered_href_id.has_value()) {
@@ -329,11 +433,12 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
         }
     }
 
+    // Cells whose glyph was copied from the glyph atlas together with their background.
+    Vector<bool> cell_is_drawn;
+
     // Pass: Paint background & text decorations.
-    for (u16 visual_row = 0; visual_row < m_terminal.rows(); ++visual_row) {
+    for (auto visual_row : rows_to_render) {
         auto row_rect = this->row_rect(visual_row);
-        if (!event.rect().contains(row_rect))
-            continue;
         auto& line = m_terminal.line(first_row_from_history + visual_row);
         bool has_only_one_background_color = line.has_only_one_background_color();
         if (visual_beep_active)
@@ -353,8 +458,25 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
             auto cell_rect = character_rect.inflated(0, m_line_spacing);
             auto text_color_before_bold_change = should_reverse_fill_for_cursor_or_selection ? attribute.effective_background_color() : attribute.effective_foreground_color();
             auto text_color = terminal_color_to_rgb(m_show_bold_text_as_bright ? text_color_before_bold_change.to_bright() : text_color_before_bold_change);
-            if ((!visual_beep_active && !has_only_one_background_color) || should_reverse_fill_for_cursor_or_selection)
-                painter.clear_rect(cell_rect, terminal_color_to_rgb(should_reverse_fill_for_cursor_or_selection ? attribute.effective_foreground_color() : attribute.effective_background_color()));
+            auto should_fill_cell = (!visual_beep_active && !has_only_one_background_color) || should_reverse_fill_for_cursor_or_selection;
+            auto cell_color = should_fill_cell
+                ? terminal_color_to_rgb(should_reverse_fill_for_cursor_or_selection ? attribute.effective_foreground_color() : attribute.effective_background_color())
+                : terminal_color_to_rgb(line.attribute_at(0).effective_background_color()).with_alpha(m_opacity);
+
+            u32 code_point = line.code_point(column);
+            bool is_bold = has_flag(attribute.flags, VT::Attribute::Flags::Bold);
+            if (can_use_glyph_atlas
+                && code_point != ' '
+                && !has_flag(attribute.flags, VT::Attribute::Flags::Concealed)
+                && m_glyph_atlas.can_draw(code_point, is_bold)) {
+                auto atlas_rect = TRY(m_glyph_atlas.cell_rect(code_point, is_bold, text_color, cell_color));
+                painter.blit(cell_rect.location(), m_glyph_atlas.bitmap(), atlas_rect, 1.0f, false);
+                TRY(cell_is_drawn.try_append(true));
+            } else {
+                if (should_fill_cell)
+                    painter.clear_rect(cell_rect, cell_color);
+                TRY(cell_is_drawn.try_append(false));
+            }
 
             if constexpr (TERMINAL_DEBUG) {
                 if (line.termination_column() == column)
@@ -405,16 +527,14 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
         painter.draw_rect(rect.inflated(2, 2).intersected(frame_inner_rect()), palette().base_text());
     }
 
-    auto& font = this->font();
-    auto& bold_font = font.bold_variant();
-
     // Pass: Paint foreground (text).
-    for (u16 visual_row = 0; visual_row < m_terminal.rows(); ++visual_row) {
-        auto row_rect = this->row_rect(visual_row);
-        if (!event.rect().contains(row_rect))
-            continue;
+    size_t cell_index = 0;
+    for (auto visual_row : rows_to_render) {
         auto& line = m_terminal.line(first_row_from_history + visual_row);
         for (size_t column = 0; column < line.length(); ++column) {
+            if (cell_is_drawn[cell_index++])
+                continue;
+
             auto attribute = line.attribute_at(column);
             bool should_reverse_fill_for_cursor_or_selection = m_cursor_blink_state
                 && m_cursor_shape == VT::CursorShape::Block
@@ -447,34 +567,12 @@ void TerminalWidget::paint_event(GUI::PaintEvent& event)
         }
     }
 
-    // Draw cursor.
-    if (m_cursor_blink_state && row_with_cursor < m_terminal.rows()) {
-        auto& cursor_line = m_terminal.line(first_row_from_history + row_with_cursor);
-        if (m_terminal.cursor_row() >= (m_terminal.rows() - rows_from_history))
-            return;
-
-        if (m_has_logical_focus && m_cursor_shape == VT::CursorShape::Block)
-            return; // This has already been handled by inverting the cell colors
-
-        auto cursor_color = terminal_color_to_rgb(cursor_line.attribute_at(m_terminal.cursor_column()).effective_foreground_color());
-        auto cell_rect = glyph_rect(row_with_cursor, m_terminal.cursor_column()).inflated(0, m_line_spacing);
-        if (m_cursor_shape == VT::CursorShape::Underline) {
-            auto x1 = cell_rect.left();
-            auto x2 = cell_rect.right();
-            auto y = cell_rect.bottom() - 1;
-            for (auto x = x1; x < x2; ++x)
-                painter.set_pixel({ x, y }, cursor_color);
-        } else if (m_cursor_shape == VT::CursorShape::Bar) {
-            auto x = cell_rect.left();
-            auto y1 = cell_rect.top();
-            auto y2 = cell_rect.bottom();
-            for (auto y = y1; y < y2; ++y)
-                painter.set_pixel({ x, y }, cursor_color);
-        } else {
-            // We fall back to a block if we don't support the selected cursor type.
-            painter.draw_rect(cell_rect, cursor_color);
-        }
+    for (auto visual_row : rows_to_render) {
+        m_rendered_row_is_valid[visual_row] = true;
+        if (visual_row == row_with_cursor)
+            m_rendered_row_with_cursor = visual_row;
     }
+    return {};
 }
 
 void TerminalWidget::set_window_progress(int value, int max)
@@ -501,10 +599,28 @@ void TerminalWidget::invalidate_cursor()
     m_terminal.invalidate_cursor();
 }
 
+void TerminalWidget::schedule_flush_of_dirty_lines()
+{
+    if (m_flush_timer->is_active())
+        return;
+
+    // A program that writes a lot of output shouldn't have to wait for us to paint every bit of it, so it's only shown
+    // as often as the screen is refreshed.
+    if (!m_time_since_last_flush.is_valid() || m_time_since_last_flush.elapsed_milliseconds() >= minimum_flush_interval_ms) {
+        flush_dirty_lines();
+        return;
+    }
+    m_flush_timer->start(minimum_flush_interval_ms - m_time_since_last_flush.elapsed_milliseconds());
+}
+
 void TerminalWidget::flush_dirty_lines()
 {
+    m_flush_timer->stop();
+    m_time_since_last_flush.start();
+
     // FIXME: Update smarter when scrolled
     if (m_terminal.m_need_full_flush || m_scrollbar->value() != m_scrollbar->max()) {
+        m_rendered_row_is_valid.span().fill(false);
         update();
         m_terminal.m_need_full_flush = false;
         return;
@@ -514,11 +630,64 @@ void TerminalWidget::flush_dirty_lines()
         if (m_terminal.visible_line(i).is_dirty()) {
             rect = rect.united(row_rect(i));
             m_terminal.visible_line(i).set_dirty(false);
+            if (static_cast<size_t>(i) < m_rendered_row_is_valid.size())
+                m_rendered_row_is_valid[i] = false;
         }
     }
     update(rect);
 }
 
+bool TerminalWidget::terminal_did_scroll(u16 region_top, u16 region_bottom, int count)
+{
+    // Only the rows of the screen can be moved along, and only while they are shown like they were rendered. With a
+    // selection, the lines that leave the screen might not be kept, which would make the selection move on screen.
+    if (!m_rendered_state.has_value()
+        || m_rendered_state->first_row_from_history != 0
+        || m_rendered_state->rows != m_terminal.rows()
+        || m_scrollbar->value() != m_scrollbar->max()
+        || m_hovered_href_id.has_value()
+        || m_selection.is_valid())
+        return false;
+
+    int rows_in_region = region_bottom - region_top + 1;
+    int distance = count > 0 ? count : -count;
+    if (distance >= rows_in_region)
+        return false;
+
+    auto& bitmap = *m_rendered_rows;
+    auto physical_line_height = m_line_height * bitmap.scale();
+    auto physical_top = (row_rect(region_top).top() - frame_inner_rect().top()) * bitmap.scale();
+    auto physical_height_to_move = (rows_in_region - distance) * physical_line_height;
+    auto physical_distance = distance * physical_line_height;
+    if (physical_top < 0 || physical_top + rows_in_region * physical_line_height > bitmap.physical_height())
+        return false;
+
+    auto bytes_per_scanline = bitmap.physical_width() * sizeof(Gfx::ARGB32);
+    if (count > 0) {
+        for (int y = physical_top; y < physical_top + physical_height_to_move; ++y)
+            memcpy(bitmap.scanline(y), bitmap.scanline(y + physical_distance), bytes_per_scanline);
+        for (int row = region_top; row <= region_bottom; ++row)
+            m_rendered_row_is_valid[row] = row + distance <= region_bottom && m_rendered_row_is_valid[row + distance];
+    } else {
+        for (int y = physical_top + physical_height_to_move - 1; y >= physical_top; --y)
+            memcpy(bitmap.scanline(y + physical_distance), bitmap.scanline(y), bytes_per_scanline);
+        for (int row = region_bottom; row >= region_top; --row)
+            m_rendered_row_is_valid[row] = row - distance >= region_top && m_rendered_row_is_valid[row - distance];
+    }
+
+    // The cursor was moved along with its row, and has to be taken off it again.
+    if (m_rendered_row_with_cursor.has_value() && *m_rendered_row_with_cursor >= region_top && *m_rendered_row_with_cursor <= region_bottom) {
+        int moved_row = static_cast<int>(*m_rendered_row_with_cursor) - count;
+        if (moved_row >= region_top && moved_row <= region_bottom) {
+            m_rendered_row_is_valid[moved_row] = false;
+            m_rendered_row_with_cursor = moved_row;
+        }
+    }
+
+    update(row_rect(region_top).united(row_rect(region_bottom)));
+    return true;
+}
+
 void TerminalWidget::resize_event(GUI::ResizeEvent& event)
 {
     relayout(event.size());
@@ -572,6 +741,7 @@ void TerminalWidget::set_opacity(u8 new_opacity)
 
     window()->set_has_alpha_channel(new_opacity < 255);
     m_opacity = new_opacity;
+    invalidate_rendered_rows();
     update();
 }
 
@@ -1234,6 +1404,7 @@ void TerminalWidget::did_change_font()
 {
     GUI::Frame::did_change_font();
     update_cached_font_metrics();
+    invalidate_rendered_rows();
     if (!size().is_empty())
         relayout(size());
 }
@@ -1312,6 +1483,7 @@ void TerminalWidget::update_color_scheme()
     m_colors[14] = palette.bright_cyan();
     m_colors[15] = palette.bright_white();
 
+    invalidate_rendered_rows();
     update();
 }
 
@@ -16,6 +16,7 @@
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Rect.h>
 #include <LibVT/Color.h>
+#include <LibVT/GlyphAtlas.h>
 #include <LibVT/Range.h>
 #include <LibVT/Terminal.h>
 
@@ -150,6 +151,7 @@ private:
     virtual void terminal_did_resize(u16 columns, u16 rows) override;
     virtual void terminal_history_changed(int delta) override;
     virtual void terminal_did_perform_possibly_partial_clear() override;
+    virtual bool terminal_did_scroll(u16 region_top, u16 region_bottom, int count) override;
     virtual void emit(u8 const*, size_t) override;
 
     // ^GUI::Clipboard::ClipboardClient
@@ -165,6 +167,11 @@ private:
     void update_cursor();
     void invalidate_cursor();
 
+    void schedule_flush_of_dirty_lines();
+
+    void invalidate_rendered_rows();
+    ErrorOr<void> render_rows(Gfx::IntRect const&, int scale, bool visual_beep_active, int first_row_from_history, int row_with_cursor);
+
     void relayout(Gfx::IntSize);
 
     void update_copy_action();
@@ -244,6 +251,38 @@ private:
     RefPtr<Core::Timer> m_cursor_blink_timer;
     RefPtr<Core::Timer> m_visual_beep_timer;
     RefPtr<Core::Timer> m_auto_scroll_timer;
+    RefPtr<Core::Timer> m_flush_timer;
+
+    static constexpr i64 minimum_flush_interval_ms = 16;
+    Core::ElapsedTimer m_time_since_last_flush;
+
+    // Everything that affects how the rows are rendered, other than the lines themselves and the cursor (whose lines
+    // are marked dirty when it changes).
+    struct RenderState {
+        VT::Range selection;
+        bool rectangle_selection { false };
+        Optional<ByteString> hovered_href_id;
+        Optional<ByteString> active_href_id;
+        bool has_logical_focus { false };
+        VT::CursorShape cursor_shape { VT::CursorShape::Block };
+        bool visual_beep_active { false };
+        // Relative to the first row of the screen, i.e. negative while scrolled back.
+        int first_row_from_history { 0 };
+        u16 rows { 0 };
+        u16 columns { 0 };
+        Gfx::IntSize size;
+        int scale { 1 };
+
+        bool operator==(RenderState const&) const = default;
+    };
+
+    // The rows as they were last rendered, covering the frame's inner rect. Only rows that have changed since are
+    // rendered again, and rows that scroll are moved within it.
+    RefPtr<Gfx::Bitmap> m_rendered_rows;
+    Vector<bool> m_rendered_row_is_valid;
+    Optional<RenderState> m_rendered_state;
+    Optional<size_t> m_rendered_row_with_cursor;
+    GlyphAtlas m_glyph_atlas;
 
     RefPtr<GUI::Scrollbar> m_scrollbar;
 
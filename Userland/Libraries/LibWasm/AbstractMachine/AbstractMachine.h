@@ -13,6 +13,7 @@
 #include <AK/Result.h>
 #include <AK/StackInfo.h>
 #include <AK/UFixedBigInt.h>
+#include <LibWasm/JIT/NativeFunction.h>
 #include <LibWasm/Types.h>
 
 // NOTE: Special case for Wasm::Result.
@@ -337,6 +338,11 @@ public:
     auto& code() const { return m_code; }
     RefPtr<Module const> module_ref() const { return m_module.strong_ref(); }
 
+    // Counts how often the function has been called, see BytecodeInterpreter::native_function_for_current_frame().
+    u32 hotness { 0 };
+    bool did_try_jitting { false };
+    OwnPtr<JIT::NativeFunction> native_function;
+
 private:
     FunctionType m_type;
     WeakPtr<Module const> m_module;
@@ -407,6 +413,7 @@ public:
     static ErrorOr<MemoryInstance> create(MemoryType const& type)
     {
         MemoryInstance instance { type };
+        instance.reserve_address_space();
 
         if (!instance.grow(type.limits().min() * Constants::page_size, GrowType::No))
             return Error::from_string_literal("Failed to grow to requested size");
@@ -472,6 +479,20 @@ private:
     {
     }
 
+    // Reserves room for the declared maximum size, so that `memory.grow` never has to move the contents around.
+    // Large allocations are only backed by physical pages once they are touched on 64-bit hosts, so this merely costs
+    // address space there. If the reservation fails, the memory is grown on demand instead.
+    void reserve_address_space()
+    {
+#if defined(AK_ARCH_64_BIT) && !defined(AK_OS_SERENITY)
+        auto max = m_type.limits().max();
+        if (!max.has_value())
+            return;
+        u64 max_size = min(static_cast<u64>(max.value()), 65536ull) * Constants::page_size;
+        (void)m_data.try_ensure_capacity(max_size);
+#endif
+    }
+
     MemoryType m_type;
     size_t m_size { 0 };
     ByteBuffer m_data;
@@ -562,32 +583,14 @@ private:
     Vector<DataInstance> m_datas;
 };
 
-class Label {
-public:
-    explicit Label(size_t arity, InstructionPointer continuation, size_t stack_height)
-        : m_arity(arity)
-        , m_stack_height(stack_height)
-        , m_continuation(continuation)
-    {
-    }
-
-    auto continuation() const { return m_continuation; }
-    auto arity() const { return m_arity; }
-    auto stack_height() const { return m_stack_height; }
-
-private:
-    size_t m_arity { 0 };
-    size_t m_stack_height { 0 };
-    InstructionPointer m_continuation { 0 };
-};
-
 class Frame {
 public:
-    explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity)
+    explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity, Optional<FunctionAddress> function = {})
         : m_module(module)
         , m_locals(move(locals))
         , m_expression(expression)
         , m_arity(arity)
+        , m_function(function)
     {
     }
 
@@ -596,15 +599,19 @@ public:
     auto& locals() { return m_locals; }
     auto& expression() const { return m_expression; }
     auto arity() const { return m_arity; }
-    auto label_index() const { return m_label_index; }
-    auto& label_index() { return m_label_index; }
+    // The function whose body is being executed, if any.
+    auto function() const { return m_function; }
+    // The height of the value stack when this frame was entered.
+    auto stack_base() const { return m_stack_base; }
+    auto& stack_base() { return m_stack_base; }
 
 private:
     ModuleInstance const& m_module;
     Vector<Value> m_locals;
     Expression const& m_expression;
     size_t m_arity { 0 };
-    size_t m_label_index { 0 };
+    size_t m_stack_base { 0 };
+    Optional<FunctionAddress> m_function;
 };
 
 using InstantiationResult = AK::ErrorOr<NonnullOwnPtr<ModuleInstance>, InstantiationError>;
@@ -15,6 +15,7 @@
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Operators.h>
+#include <LibWasm/JIT/Compiler.h>
 #include <LibWasm/Opcode.h>
 #include <LibWasm/Printer/Printer.h>
 
@@ -22,6 +23,8 @@ using namespace AK::SIMD;
 
 namespace Wasm {
 
+bool g_enable_jit = false;
+
 #define TRAP_IF_NOT(x)                                                                         \
     do {                                                                                       \
         if (trap_if_not(x, #x##sv)) {                                                          \
@@ -33,6 +36,11 @@ namespace Wasm {
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap = Empty {};
+    if (auto* native_function = native_function_for_current_frame(configuration)) {
+        run_native_code(configuration, *native_function);
+        return;
+    }
+
     auto& instructions = configuration.frame().expression().instructions();
     auto max_ip_value = InstructionPointer { instructions.size() };
     auto& current_ip_value = configuration.ip();
@@ -56,16 +64,56 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
     }
 }
 
-void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
+JIT::NativeFunction const* BytecodeInterpreter::native_function_for_current_frame(Configuration& configuration)
 {
-    dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
-    for (size_t i = 0; i < index.value(); ++i)
-        configuration.label_stack().take_last();
-    auto label = configuration.label_stack().last();
-    dbgln_if(WASM_TRACE_DEBUG, "...which is actually IP {}, and has {} result(s)", label.continuation().value(), label.arity());
-
-    configuration.value_stack().remove(label.stack_height(), configuration.value_stack().size() - label.stack_height() - label.arity());
-    configuration.ip() = label.continuation();
+    if (!g_enable_jit || configuration.should_limit_instruction_count() || configuration.ip() != 0)
+        return nullptr;
+    auto address = configuration.frame().function();
+    if (!address.has_value())
+        return nullptr;
+    auto& function = configuration.store().get(*address)->get<WasmFunction>();
+    if (function.native_function)
+        return function.native_function.ptr();
+    if (function.did_try_jitting || ++function.hotness < JIT::Compiler::hotness_threshold)
+        return nullptr;
+
+    function.did_try_jitting = true;
+    function.native_function = JIT::Compiler::compile(configuration, function);
+    dbgln_if(WASM_TRACE_DEBUG, "Compiled function {} to native code: {}", address->value(), function.native_function != nullptr);
+    return function.native_function.ptr();
+}
+
+void BytecodeInterpreter::run_native_code(Configuration& configuration, JIT::NativeFunction const& native_function)
+{
+    auto& locals = configuration.frame().locals();
+    Vector<u64, 64> slots;
+    slots.resize(native_function.slot_count());
+    for (size_t i = 0; i < locals.size(); ++i)
+        slots[i] = locals[i].to<u64>();
+
+    JIT::NativeFunction::Context context { .interpreter = this, .configuration = &configuration };
+    if (native_function.run(context, slots) == JIT::NativeFunction::ExitReason::Trap) {
+        if (context.trap_reason)
+            m_trap = Trap { context.trap_reason };
+        VERIFY(did_trap());
+        return;
+    }
+
+    auto& result_types = native_function.result_types();
+    for (size_t i = 0; i < result_types.size(); ++i)
+        configuration.value_stack().append(JIT::NativeFunction::value_from_slot(slots[native_function.local_count() + i], result_types[i]));
+}
+
+void BytecodeInterpreter::branch_to(Configuration& configuration, Instruction::BranchTarget const& target)
+{
+    dbgln_if(WASM_TRACE_DEBUG, "Branch to IP {}, with {} result(s)", target.continuation.value(), target.arity);
+
+    auto& value_stack = configuration.value_stack();
+    auto stack_height = configuration.frame().stack_base() + target.stack_height;
+    auto values_to_drop = value_stack.size() - stack_height - target.arity;
+    if (values_to_drop != 0)
+        value_stack.remove(stack_height, values_to_drop);
+    configuration.ip() = target.continuation;
 }
 
 template<typename ReadType, typename PushType>
@@ -231,7 +279,11 @@ void BytecodeInterpreter::call_address(Configuration& configuration, FunctionAdd
     FunctionType const* type { nullptr };
     instance->visit([&](auto const& function) { type = &function.type(); });
     Vector<Value> args;
-    args.ensure_capacity(type->parameters().size());
+    // NOTE: The arguments become the first locals of a wasm function, so make room for the rest of them too.
+    if (auto* wasm_function = instance->get_pointer<WasmFunction>())
+        args.ensure_capacity(type->parameters().size() + wasm_function->code().func().total_local_count());
+    else
+        args.ensure_capacity(type->parameters().size());
     auto span = configuration.value_stack().span().slice_from_end(type->parameters().size());
     for (auto& value : span)
         args.unchecked_append(value);
@@ -433,98 +485,44 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
     case Instructions::f64_const.value():
         configuration.value_stack().append(Value(instruction.arguments().get<double>()));
         return;
-    case Instructions::block.value(): {
-        size_t arity = 0;
-        size_t param_arity = 0;
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            param_arity = type.parameters().size();
-        }
-        }
-
-        configuration.label_stack().append(Label(arity, args.end_ip, configuration.value_stack().size() - param_arity));
-        return;
-    }
-    case Instructions::loop.value(): {
-        auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        size_t arity = 0;
-        if (args.block_type.kind() == BlockType::Index) {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.parameters().size();
-        }
-        configuration.label_stack().append(Label(arity, ip.value() + 1, configuration.value_stack().size() - arity));
+    case Instructions::block.value():
+    case Instructions::loop.value():
+    case Instructions::structured_end.value():
+        // NOTE: Branches have been resolved by the validator, so there are no labels to keep track of.
         return;
-    }
     case Instructions::if_.value(): {
-        size_t arity = 0;
-        size_t param_arity = 0;
         auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
-        switch (args.block_type.kind()) {
-        case BlockType::Empty:
-            break;
-        case BlockType::Type:
-            arity = 1;
-            break;
-        case BlockType::Index: {
-            auto& type = configuration.frame().module().types()[args.block_type.type_index().value()];
-            arity = type.results().size();
-            param_arity = type.parameters().size();
-        }
-        }
-
         auto value = configuration.value_stack().take_last().to<i32>();
-        auto end_label = Label(arity, args.end_ip.value(), configuration.value_stack().size() - param_arity);
-        if (value == 0) {
-            if (args.else_ip.has_value()) {
-                configuration.ip() = args.else_ip.value();
-                configuration.label_stack().append(end_label);
-            } else {
-                configuration.ip() = args.end_ip.value() + 1;
-            }
-        } else {
-            configuration.label_stack().append(end_label);
-        }
+        if (value == 0)
+            configuration.ip() = args.else_ip.value_or(args.end_ip);
         return;
     }
-    case Instructions::structured_end.value():
-        configuration.label_stack().take_last();
-        return;
-    case Instructions::structured_else.value(): {
-        auto label = configuration.label_stack().take_last();
-        // Jump to the end label
-        configuration.ip() = label.continuation();
+    case Instructions::structured_else.value():
+        // We've reached the end of the then block, skip over the else block.
+        configuration.ip() = instruction.arguments().get<Instruction::BranchTarget>().continuation;
         return;
-    }
     case Instructions::return_.value(): {
-        while (configuration.label_stack().size() - 1 != configuration.frame().label_index())
-            configuration.label_stack().take_last();
-        configuration.ip() = configuration.frame().expression().instructions().size();
-        return;
+        // Returning is just like branching to the outermost label.
+        auto& frame = configuration.frame();
+        Instruction::BranchTarget target { frame.expression().instructions().size(), static_cast<u32>(frame.arity()), 0 };
+        return branch_to(configuration, target);
     }
     case Instructions::br.value():
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
+        return branch_to(configuration, instruction.arguments().get<Instruction::BranchArgs>().target);
     case Instructions::br_if.value(): {
         auto cond = configuration.value_stack().take_last().to<i32>();
         if (cond == 0)
             return;
-        return branch_to_label(configuration, instruction.arguments().get<LabelIndex>());
+        return branch_to(configuration, instruction.arguments().get<Instruction::BranchArgs>().target);
     }
     case Instructions::br_table.value(): {
         auto& arguments = instruction.arguments().get<Instruction::TableBranchArgs>();
         auto i = configuration.value_stack().take_last().to<u32>();
 
         if (i >= arguments.labels.size()) {
-            return branch_to_label(configuration, arguments.default_);
+            return branch_to(configuration, arguments.default_.target);
         }
-        return branch_to_label(configuration, arguments.labels[i]);
+        return branch_to(configuration, arguments.labels[i].target);
     }
     case Instructions::call.value(): {
         auto index = instruction.arguments().get<FunctionIndex>();
@@ -10,8 +10,16 @@
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
 
+namespace Wasm::JIT {
+
+class Compiler;
+
+}
+
 namespace Wasm {
 
+extern bool g_enable_jit;
+
 struct BytecodeInterpreter : public Interpreter {
     explicit BytecodeInterpreter(StackInfo const& stack_info)
         : m_stack_info(stack_info)
@@ -45,8 +53,13 @@ struct BytecodeInterpreter : public Interpreter {
     };
 
 protected:
+    friend class JIT::Compiler;
+
+    JIT::NativeFunction const* native_function_for_current_frame(Configuration&);
+    void run_native_code(Configuration&, JIT::NativeFunction const&);
+
     void interpret_instruction(Configuration&, InstructionPointer&, Instruction const&);
-    void branch_to_label(Configuration&, LabelIndex);
+    void branch_to(Configuration&, Instruction::BranchTarget const&);
     template<typename ReadT, typename PushT>
     void load_and_push(Configuration&, Instruction const&);
     template<typename PopT, typename StoreT>
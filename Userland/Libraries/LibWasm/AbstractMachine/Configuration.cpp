@@ -25,7 +25,7 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
         return Trap {};
     if (auto* wasm_function = function->get_pointer<WasmFunction>()) {
         Vector<Value> locals = move(arguments);
-        locals.ensure_capacity(locals.size() + wasm_function->code().func().locals().size());
+        locals.ensure_capacity(locals.size() + wasm_function->code().func().total_local_count());
         for (auto& local : wasm_function->code().func().locals()) {
             for (size_t i = 0; i < local.n(); ++i)
                 locals.append(Value());
@@ -36,6 +36,7 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
             move(locals),
             wasm_function->code().func().body(),
             wasm_function->type().results().size(),
+            address,
         });
         m_ip = 0;
         return execute(interpreter);
@@ -57,7 +58,6 @@ Result Configuration::execute(Interpreter& interpreter)
     for (size_t i = 0; i < frame().arity(); ++i)
         results.unchecked_append(value_stack().take_last());
 
-    label_stack().take_last();
     return Result { move(results) };
 }
 
@@ -9,6 +9,7 @@
 #include <AK/SourceLocation.h>
 #include <AK/TemporaryChange.h>
 #include <AK/Try.h>
+#include <LibThreading/ParallelAlgorithms.h>
 #include <LibWasm/AbstractMachine/Validator.h>
 #include <LibWasm/Printer/Printer.h>
 
@@ -242,26 +243,61 @@ ErrorOr<void, ValidationError> Validator::validate(TableSection const& section)
 
 ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
 {
+    // Every function is validated by its own fork of the validator, which lets us validate them in parallel.
+    // The forks share the module's context through reference counted vectors, so they must only be created and
+    // destroyed on this thread.
+    struct FunctionValidation {
+        NonnullOwnPtr<Validator> validator;
+        FunctionType const* type { nullptr };
+        Expression const* body { nullptr };
+        Optional<ValidationError> error;
+    };
+
+    Vector<FunctionValidation> validations;
+    validations.ensure_capacity(section.functions().size());
+
     size_t index = m_context.imported_function_count;
+    size_t total_instruction_count = 0;
     for (auto& entry : section.functions()) {
         auto function_index = index++;
         TRY(validate(FunctionIndex { function_index }));
         auto& function_type = m_context.functions[function_index];
         auto& function = entry.func();
 
-        auto function_validator = fork();
-        function_validator.m_context.locals = {};
-        function_validator.m_context.locals.extend(function_type.parameters());
+        auto function_validator = adopt_own(*new Validator { m_context });
+        function_validator->m_context.locals = {};
+        function_validator->m_context.locals.extend(function_type.parameters());
         for (auto& local : function.locals()) {
             for (size_t i = 0; i < local.n(); ++i)
-                function_validator.m_context.locals.append(local.type());
+                function_validator->m_context.locals.append(local.type());
+        }
+
+        function_validator->m_frames.empend(function_type, FrameKind::Function, (size_t)0, InstructionPointer { function.body().instructions().size() });
+
+        total_instruction_count += function.body().instructions().size();
+        validations.unchecked_append({ move(function_validator), &function_type, &function.body(), {} });
+    }
+
+    auto validate_functions = [](Span<FunctionValidation> validations) {
+        for (auto& validation : validations) {
+            auto results = validation.validator->validate(*validation.body, validation.type->results());
+            if (results.is_error())
+                validation.error = results.release_error();
+            else if (results.value().result_types.size() != validation.type->results().size())
+                validation.error = Errors::invalid("function result"sv, validation.type->results(), results.value().result_types);
         }
+    };
 
-        function_validator.m_frames.empend(function_type, FrameKind::Function, (size_t)0);
+    // Handing small modules to other threads takes longer than just validating them.
+    static constexpr size_t minimum_instruction_count_to_validate_in_parallel = 16 * KiB;
+    if (total_instruction_count < minimum_instruction_count_to_validate_in_parallel)
+        validate_functions(validations.span());
+    else
+        Threading::parallel_for(validations.span(), validate_functions);
 
-        auto results = TRY(function_validator.validate(function.body(), function_type.results()));
-        if (results.result_types.size() != function_type.results().size())
-            return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+    for (auto& validation : validations) {
+        if (validation.error.has_value())
+            return validation.error.release_value();
     }
 
     return {};
@@ -1940,6 +1976,10 @@ VALIDATE_INSTRUCTION(structured_else)
     if (stack.size() != frame.initial_size)
         return Errors::stack_height_mismatch(stack, frame.initial_size);
 
+    // NOTE: This is also called for the implicit else of an if without one, which has nothing to resolve.
+    if (auto* target = instruction.arguments().get_pointer<Instruction::BranchTarget>())
+        const_cast<Instruction::BranchTarget&>(*target) = branch_target(LabelIndex { 0 });
+
     frame.kind = FrameKind::Else;
     frame.unreachable = false;
     for (auto& parameter : block_type.parameters())
@@ -1957,7 +1997,7 @@ VALIDATE_INSTRUCTION(block)
     for (size_t i = 1; i <= parameters.size(); ++i)
         TRY(stack.take(parameters[parameters.size() - i]));
 
-    m_frames.empend(block_type, FrameKind::Block, stack.size());
+    m_frames.empend(block_type, FrameKind::Block, stack.size(), args.end_ip);
     for (auto& parameter : parameters)
         stack.append(parameter);
 
@@ -1973,7 +2013,7 @@ VALIDATE_INSTRUCTION(loop)
     for (size_t i = 1; i <= parameters.size(); ++i)
         TRY(stack.take(parameters[parameters.size() - i]));
 
-    m_frames.empend(block_type, FrameKind::Loop, stack.size());
+    m_frames.empend(block_type, FrameKind::Loop, stack.size(), m_instruction_pointer);
     for (auto& parameter : parameters)
         stack.append(parameter);
 
@@ -1993,7 +2033,7 @@ VALIDATE_INSTRUCTION(if_)
     for (size_t i = 1; i <= parameters.size(); ++i)
         TRY(stack.take(parameters[parameters.size() - i]));
 
-    m_frames.empend(block_type, FrameKind::If, stack.size());
+    m_frames.empend(block_type, FrameKind::If, stack.size(), args.end_ip);
     for (auto& parameter : parameters)
         stack.append(parameter);
 
@@ -2002,8 +2042,10 @@ VALIDATE_INSTRUCTION(if_)
 
 VALIDATE_INSTRUCTION(br)
 {
-    auto label = instruction.arguments().get<LabelIndex>();
+    auto& args = instruction.arguments().get<Instruction::BranchArgs>();
+    auto label = args.label;
     TRY(validate(label));
+    resolve_branch(args);
 
     auto& type = m_frames[(m_frames.size() - 1) - label.value()].labels();
     for (size_t i = 1; i <= type.size(); ++i)
@@ -2016,8 +2058,10 @@ VALIDATE_INSTRUCTION(br)
 
 VALIDATE_INSTRUCTION(br_if)
 {
-    auto label = instruction.arguments().get<LabelIndex>();
+    auto& args = instruction.arguments().get<Instruction::BranchArgs>();
+    auto label = args.label;
     TRY(validate(label));
+    resolve_branch(args);
 
     TRY(stack.take<ValueType::I32>());
 
@@ -2041,18 +2085,21 @@ VALIDATE_INSTRUCTION(br_if)
 VALIDATE_INSTRUCTION(br_table)
 {
     auto& args = instruction.arguments().get<Instruction::TableBranchArgs>();
-    TRY(validate(args.default_));
+    TRY(validate(args.default_.label));
+    resolve_branch(args.default_);
 
-    for (auto& label : args.labels)
-        TRY(validate(label));
+    for (auto& label : args.labels) {
+        TRY(validate(label.label));
+        resolve_branch(label);
+    }
 
     TRY(stack.take<ValueType::I32>());
 
-    auto& default_types = m_frames[(m_frames.size() - 1) - args.default_.value()].labels();
+    auto& default_types = m_frames[(m_frames.size() - 1) - args.default_.label.value()].labels();
     auto arity = default_types.size();
 
     for (auto& label : args.labels) {
-        auto& label_types = m_frames[(m_frames.size() - 1) - label.value()].labels();
+        auto& label_types = m_frames[(m_frames.size() - 1) - label.label.value()].labels();
         if (label_types.size() != arity)
             return Errors::invalid("br_table label arity mismatch"sv);
         Vector<StackEntry> popped {};
@@ -3703,17 +3750,22 @@ ErrorOr<void, ValidationError> Validator::validate(Instruction const& instructio
 ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Expression const& expression, Vector<ValueType> const& result_types)
 {
     if (m_frames.is_empty())
-        m_frames.empend(FunctionType { {}, result_types }, FrameKind::Function, (size_t)0);
+        m_frames.empend(FunctionType { {}, result_types }, FrameKind::Function, (size_t)0, InstructionPointer { expression.instructions().size() });
     auto stack = Stack(m_frames);
     bool is_constant_expression = true;
+    size_t max_stack_height = 0;
 
-    for (auto& instruction : expression.instructions()) {
+    for (size_t i = 0; i < expression.instructions().size(); ++i) {
+        m_instruction_pointer = i;
         bool is_constant = false;
-        TRY(validate(instruction, stack, is_constant));
+        TRY(validate(expression.instructions()[i], stack, is_constant));
 
         is_constant_expression &= is_constant;
+        max_stack_height = max(max_stack_height, stack.size());
     }
 
+    const_cast<Expression&>(expression).set_stack_usage_hint(max_stack_height);
+
     auto expected_result_types = result_types;
     while (!expected_result_types.is_empty())
         TRY(stack.take(expected_result_types.take_last()));
@@ -3726,6 +3778,21 @@ ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Ex
     return ExpressionTypeResult { stack.release_vector(), is_constant_expression };
 }
 
+Instruction::BranchTarget Validator::branch_target(LabelIndex label) const
+{
+    auto& frame = m_frames[(m_frames.size() - 1) - label.value()];
+    return {
+        .continuation = frame.continuation,
+        .arity = static_cast<u32>(frame.labels().size()),
+        .stack_height = static_cast<u32>(frame.initial_size),
+    };
+}
+
+void Validator::resolve_branch(Instruction::BranchArgs const& args) const
+{
+    const_cast<Instruction::BranchArgs&>(args).target = branch_target(args.label);
+}
+
 ByteString Validator::Errors::find_instruction_name(SourceLocation const& location)
 {
     auto index = location.function_name().find('<');
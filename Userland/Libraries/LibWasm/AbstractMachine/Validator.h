@@ -148,6 +148,8 @@ public:
         FunctionType type;
         FrameKind kind;
         size_t initial_size;
+        // Where a branch to this frame continues.
+        InstructionPointer continuation;
         // Stack polymorphism is handled with this field
         bool unreachable { false };
 
@@ -283,6 +285,10 @@ private:
     {
     }
 
+    // Branches are resolved as part of validation, so the interpreter doesn't have to keep track of labels.
+    Instruction::BranchTarget branch_target(LabelIndex) const;
+    void resolve_branch(Instruction::BranchArgs const&) const;
+
     struct Errors {
         static ValidationError invalid(StringView name) { return ByteString::formatted("Invalid {}", name); }
 
@@ -346,6 +352,7 @@ private:
 
     Context m_context;
     Vector<Frame> m_frames;
+    InstructionPointer m_instruction_pointer { 0 };
     COWVector<GlobalType> m_globals_without_internal_globals;
 };
 
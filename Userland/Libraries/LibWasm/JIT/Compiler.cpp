@@ -0,0 +1,829 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
+#include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/JIT/Compiler.h>
+#include <LibWasm/Opcode.h>
+#include <LibWasm/Printer/Printer.h>
+
+namespace Wasm::JIT {
+
+#if JIT_ARCH_SUPPORTED
+
+using Reg = Compiler::Assembler::Reg;
+using Operand = Compiler::Assembler::Operand;
+using Condition = Compiler::Assembler::Condition;
+
+// The frame and the context live in callee-saved registers, so that they survive calls into the runtime.
+// NOTE: R12 and R13 can't be used as the base of a memory operand by the assembler.
+static constexpr Reg SLOTS = Reg::RBX;
+static constexpr Reg CONTEXT = Reg::R15;
+static constexpr Reg MEMORY_BASE = Reg::R13;
+static constexpr Reg MEMORY_SIZE = Reg::R14;
+
+static bool is_supported_type(ValueType const& type)
+{
+    return type.is_numeric();
+}
+
+static bool are_supported_types(Vector<ValueType> const& types)
+{
+    return all_of(types, is_supported_type);
+}
+
+static constexpr Condition condition_for(Compiler::Comparison comparison)
+{
+    switch (comparison) {
+    case Compiler::Comparison::Equal:
+        return Condition::EqualTo;
+    case Compiler::Comparison::NotEqual:
+        return Condition::NotEqualTo;
+    case Compiler::Comparison::SignedLessThan:
+        return Condition::SignedLessThan;
+    case Compiler::Comparison::UnsignedLessThan:
+        return Condition::UnsignedLessThan;
+    case Compiler::Comparison::SignedGreaterThan:
+        return Condition::SignedGreaterThan;
+    case Compiler::Comparison::UnsignedGreaterThan:
+        return Condition::UnsignedGreaterThan;
+    case Compiler::Comparison::SignedLessThanOrEqual:
+        return Condition::SignedLessThanOrEqualTo;
+    case Compiler::Comparison::UnsignedLessThanOrEqual:
+        return Condition::UnsignedLessThanOrEqualTo;
+    case Compiler::Comparison::SignedGreaterThanOrEqual:
+        return Condition::SignedGreaterThanOrEqualTo;
+    case Compiler::Comparison::UnsignedGreaterThanOrEqual:
+        return Condition::UnsignedGreaterThanOrEqualTo;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static constexpr bool is_signed(Compiler::Comparison comparison)
+{
+    switch (comparison) {
+    case Compiler::Comparison::SignedLessThan:
+    case Compiler::Comparison::SignedGreaterThan:
+    case Compiler::Comparison::SignedLessThanOrEqual:
+    case Compiler::Comparison::SignedGreaterThanOrEqual:
+        return true;
+    default:
+        return false;
+    }
+}
+
+u64 Compiler::cxx_call(NativeFunction::Context& context, u64 function_index, u64* arguments_and_results)
+{
+    auto& configuration = *context.configuration;
+    auto address = configuration.frame().module().functions()[function_index];
+
+    size_t result_count = 0;
+    configuration.store().get(address)->visit([&](auto const& function) {
+        auto& parameters = function.type().parameters();
+        for (size_t i = 0; i < parameters.size(); ++i)
+            configuration.value_stack().append(NativeFunction::value_from_slot(arguments_and_results[i], parameters[i]));
+        result_count = function.type().results().size();
+    });
+
+    context.interpreter->call_address(configuration, address);
+    if (context.interpreter->did_trap())
+        return to_underlying(NativeFunction::ExitReason::Trap);
+
+    for (size_t i = result_count; i > 0; --i)
+        arguments_and_results[i - 1] = configuration.value_stack().take_last().to<u64>();
+
+    // The callee might have grown the memory.
+    context.reload_memory();
+    return to_underlying(NativeFunction::ExitReason::Finished);
+}
+
+u64 Compiler::cxx_global_get(NativeFunction::Context& context, u64 global_index)
+{
+    auto& configuration = *context.configuration;
+    auto address = configuration.frame().module().globals()[global_index];
+    return configuration.store().get(address)->value().to<u64>();
+}
+
+u64 Compiler::cxx_global_set(NativeFunction::Context& context, u64 global_index, u64 value)
+{
+    auto& configuration = *context.configuration;
+    auto address = configuration.frame().module().globals()[global_index];
+    auto* global = configuration.store().get(address);
+    global->set_value(NativeFunction::value_from_slot(value, global->type().type()));
+    return 0;
+}
+
+u64 Compiler::cxx_memory_grow(NativeFunction::Context& context, u64 page_count)
+{
+    auto& configuration = *context.configuration;
+    auto address = configuration.frame().module().memories().first();
+    auto* memory = configuration.store().get(address);
+    i32 old_pages = memory->size() / Constants::page_size;
+    auto new_pages = static_cast<i32>(page_count);
+    auto result = memory->grow(new_pages * Constants::page_size) ? old_pages : -1;
+    context.reload_memory();
+    return static_cast<u32>(result);
+}
+
+Operand Compiler::slot(u32 index) const
+{
+    return Operand::Mem64BaseAndOffset(SLOTS, index * sizeof(u64));
+}
+
+void Compiler::push(Reg reg)
+{
+    m_assembler.mov(stack_slot(m_stack_height), Operand::Register(reg));
+    ++m_stack_height;
+    m_max_stack_height = max(m_max_stack_height, m_stack_height);
+}
+
+void Compiler::pop(Reg reg)
+{
+    VERIFY(m_stack_height > 0);
+    --m_stack_height;
+    m_assembler.mov(Operand::Register(reg), stack_slot(m_stack_height));
+}
+
+void Compiler::reload_memory()
+{
+    m_assembler.mov(Operand::Register(MEMORY_BASE), Operand::Mem64BaseAndOffset(CONTEXT, offsetof(NativeFunction::Context, memory_base)));
+    m_assembler.mov(Operand::Register(MEMORY_SIZE), Operand::Mem64BaseAndOffset(CONTEXT, offsetof(NativeFunction::Context, memory_size)));
+}
+
+void Compiler::trap(char const* reason)
+{
+    m_assembler.mov(Operand::Register(Reg::RAX), Operand::Imm(reinterpret_cast<FlatPtr>(reason)));
+    m_assembler.mov(Operand::Mem64BaseAndOffset(CONTEXT, offsetof(NativeFunction::Context, trap_reason)), Operand::Register(Reg::RAX));
+    m_assembler.mov(Operand::Register(Reg::RAX), Operand::Imm(to_underlying(NativeFunction::ExitReason::Trap)));
+    m_assembler.jump(m_exit);
+}
+
+void Compiler::call_helper(FlatPtr helper)
+{
+    m_assembler.mov(Operand::Register(Reg::RDI), Operand::Register(CONTEXT));
+    m_assembler.native_call(helper);
+}
+
+Optional<FunctionType const&> Compiler::function_type(FunctionIndex index) const
+{
+    auto& functions = m_function.module().functions();
+    if (index.value() >= functions.size())
+        return {};
+    auto* function = m_configuration.store().get(functions[index.value()]);
+    if (!function)
+        return {};
+    FunctionType const* type { nullptr };
+    function->visit([&](auto const& function) { type = &function.type(); });
+    return *type;
+}
+
+Optional<FunctionType> Compiler::block_type(BlockType const& type) const
+{
+    switch (type.kind()) {
+    case BlockType::Empty:
+        return FunctionType { {}, {} };
+    case BlockType::Type:
+        return FunctionType { {}, { type.value_type() } };
+    case BlockType::Index: {
+        auto& types = m_function.module().types();
+        if (type.type_index().value() >= types.size())
+            return {};
+        return types[type.type_index().value()];
+    }
+    }
+    VERIFY_NOT_REACHED();
+}
+
+bool Compiler::enter_block(Instruction const& instruction)
+{
+    auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+    auto type = block_type(args.block_type);
+    if (!type.has_value() || !are_supported_types(type->parameters()) || !are_supported_types(type->results()))
+        return false;
+
+    auto is_if = instruction.opcode() == Instructions::if_;
+    if (is_if && m_is_reachable) {
+        VERIFY(m_stack_height > 0);
+        --m_stack_height;
+        m_assembler.mov32(Operand::Register(Reg::RAX), stack_slot(m_stack_height));
+        m_assembler.jump_if(Operand::Register(Reg::RAX), Condition::EqualTo, Operand::Imm(0), m_instruction_labels[args.else_ip.value_or(args.end_ip).value()]);
+    }
+
+    m_control_stack.append({
+        .entry_height = m_stack_height - static_cast<u32>(type->parameters().size()),
+        .parameter_count = static_cast<u32>(type->parameters().size()),
+        .result_count = static_cast<u32>(type->results().size()),
+        .is_if = is_if,
+        .was_reachable = m_is_reachable,
+    });
+    return true;
+}
+
+void Compiler::compile_branch(Instruction::BranchTarget const& target)
+{
+    // Move the values that are carried over to where the target expects them.
+    auto source_height = m_stack_height - target.arity;
+    if (source_height != target.stack_height) {
+        for (u32 i = 0; i < target.arity; ++i) {
+            m_assembler.mov(Operand::Register(Reg::RCX), stack_slot(source_height + i));
+            m_assembler.mov(stack_slot(target.stack_height + i), Operand::Register(Reg::RCX));
+        }
+    }
+    m_assembler.jump(m_instruction_labels[target.continuation.value()]);
+}
+
+void Compiler::compile_comparison(Width width, Comparison comparison)
+{
+    pop(Reg::RCX);
+    pop(Reg::RAX);
+    if (width == Width::Bits32) {
+        // The upper halves of 32-bit values are undefined, so extend them first.
+        auto extension = is_signed(comparison) ? Assembler::Extension::SignExtend : Assembler::Extension::ZeroExtend;
+        m_assembler.mov32(Operand::Register(Reg::RAX), Operand::Register(Reg::RAX), extension);
+        m_assembler.mov32(Operand::Register(Reg::RCX), Operand::Register(Reg::RCX), extension);
+    }
+    m_assembler.cmp(Operand::Register(Reg::RAX), Operand::Register(Reg::RCX));
+    m_assembler.set_if(condition_for(comparison), Operand::Register(Reg::RAX));
+    m_assembler.bitwise_and(Operand::Register(Reg::RAX), Operand::Imm(1));
+    push(Reg::RAX);
+}
+
+void Compiler::compile_binary_operation(Width width, Operation operation)
+{
+    VERIFY(width == Width::Bits32 || width == Width::Bits64);
+    auto is_32_bit = width == Width::Bits32;
+    auto lhs = Operand::Register(Reg::RAX);
+    auto rhs = Operand::Register(Reg::RCX);
+
+    // NOTE: Shift counts have to be in CL, which conveniently also masks them the way Wasm wants.
+    pop(Reg::RCX);
+    pop(Reg::RAX);
+    switch (operation) {
+    case Operation::Add:
+        if (is_32_bit)
+            m_assembler.add32(lhs, rhs, {});
+        else
+            m_assembler.add(lhs, rhs);
+        break;
+    case Operation::Sub:
+        if (is_32_bit)
+            m_assembler.sub32(lhs, rhs, {});
+        else
+            m_assembler.sub(lhs, rhs);
+        break;
+    case Operation::Mul:
+        if (is_32_bit)
+            m_assembler.mul32(lhs, rhs, {});
+        else
+            m_assembler.mul(lhs, rhs);
+        break;
+    case Operation::And:
+        m_assembler.bitwise_and(lhs, rhs);
+        break;
+    case Operation::Or:
+        m_assembler.bitwise_or(lhs, rhs);
+        break;
+    case Operation::Xor:
+        if (is_32_bit)
+            m_assembler.bitwise_xor32(lhs, rhs);
+        else
+            m_assembler.bitwise_xor(lhs, rhs);
+        break;
+    case Operation::ShiftLeft:
+        if (is_32_bit)
+            m_assembler.shift_left32(lhs, {});
+        else
+            m_assembler.shift_left(lhs, {});
+        break;
+    case Operation::ShiftRightSigned:
+        if (is_32_bit)
+            m_assembler.arithmetic_right_shift32(lhs, {});
+        else
+            m_assembler.arithmetic_right_shift(lhs, {});
+        break;
+    case Operation::ShiftRightUnsigned:
+        if (is_32_bit)
+            m_assembler.shift_right32(lhs, {});
+        else
+            m_assembler.shift_right(lhs, rhs);
+        break;
+    }
+    push(Reg::RAX);
+}
+
+// Turns the 32-bit address in the register into a pointer to the memory, or traps if the access would be out of bounds.
+// Clobbers RCX.
+void Compiler::compute_memory_address(Reg reg, u32 offset, size_t access_size)
+{
+    VERIFY(reg != Reg::RCX);
+    if (offset != 0) {
+        if (Operand::Imm(offset).fits_in_i32()) {
+            m_assembler.add(Operand::Register(reg), Operand::Imm(offset));
+        } else {
+            m_assembler.mov(Operand::Register(Reg::RCX), Operand::Imm(offset));
+            m_assembler.add(Operand::Register(reg), Operand::Register(Reg::RCX));
+        }
+    }
+    m_assembler.mov(Operand::Register(Reg::RCX), Operand::Register(reg));
+    m_assembler.add(Operand::Register(Reg::RCX), Operand::Imm(access_size));
+    m_assembler.jump_if(Operand::Register(Reg::RCX), Condition::UnsignedGreaterThan, Operand::Register(MEMORY_SIZE), m_out_of_bounds);
+    m_assembler.add(Operand::Register(reg), Operand::Register(MEMORY_BASE));
+}
+
+static size_t size_of(Compiler::Width width)
+{
+    switch (width) {
+    case Compiler::Width::Bits8:
+        return 1;
+    case Compiler::Width::Bits16:
+        return 2;
+    case Compiler::Width::Bits32:
+        return 4;
+    case Compiler::Width::Bits64:
+        return 8;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+bool Compiler::compile_load(Instruction const& instruction, Width width, bool sign_extend_to_64_bits, bool is_signed)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if (arg.memory_index.value() != 0)
+        return false;
+
+    VERIFY(m_stack_height > 0);
+    auto address_slot = stack_slot(m_stack_height - 1);
+    auto dst = Operand::Register(Reg::RAX);
+    auto src = Operand::Mem64BaseAndOffset(Reg::RAX, 0);
+    auto extension = is_signed ? Assembler::Extension::SignExtend : Assembler::Extension::ZeroExtend;
+
+    m_assembler.mov32(Operand::Register(Reg::RAX), address_slot);
+    compute_memory_address(Reg::RAX, arg.offset, size_of(width));
+    switch (width) {
+    case Width::Bits8:
+        m_assembler.mov8(dst, src, extension);
+        break;
+    case Width::Bits16:
+        m_assembler.mov16(dst, src, extension);
+        break;
+    case Width::Bits32:
+        m_assembler.mov32(dst, src, sign_extend_to_64_bits ? extension : Assembler::Extension::ZeroExtend);
+        break;
+    case Width::Bits64:
+        m_assembler.mov(dst, src);
+        break;
+    }
+    if (is_signed && sign_extend_to_64_bits && width != Width::Bits32)
+        m_assembler.sign_extend_32_to_64_bits(Reg::RAX);
+    m_assembler.mov(address_slot, dst);
+    return true;
+}
+
+bool Compiler::compile_store(Instruction const& instruction, Width width)
+{
+    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    if (arg.memory_index.value() != 0)
+        return false;
+
+    auto value = Operand::Register(Reg::RDX);
+    auto dst = Operand::Mem64BaseAndOffset(Reg::RAX, 0);
+
+    pop(Reg::RDX);
+    VERIFY(m_stack_height > 0);
+    --m_stack_height;
+    m_assembler.mov32(Operand::Register(Reg::RAX), stack_slot(m_stack_height));
+    compute_memory_address(Reg::RAX, arg.offset, size_of(width));
+    switch (width) {
+    case Width::Bits8:
+        m_assembler.mov8(dst, value);
+        break;
+    case Width::Bits16:
+        m_assembler.mov16(dst, value);
+        break;
+    case Width::Bits32:
+        m_assembler.mov32(dst, value);
+        break;
+    case Width::Bits64:
+        m_assembler.mov(dst, value);
+        break;
+    }
+    return true;
+}
+
+bool Compiler::compile_instruction(Instruction const& instruction)
+{
+    auto opcode = instruction.opcode();
+
+    // Structured instructions keep track of the stack height, even in unreachable code.
+    if (opcode == Instructions::block || opcode == Instructions::loop || opcode == Instructions::if_)
+        return enter_block(instruction);
+
+    if (opcode == Instructions::structured_else) {
+        auto& frame = m_control_stack.last();
+        if (frame.was_reachable) {
+            if (m_is_reachable)
+                m_assembler.jump(m_instruction_labels[instruction.arguments().get<Instruction::BranchTarget>().continuation.value()]);
+            m_is_reachable = true;
+        }
+        m_stack_height = frame.entry_height + frame.parameter_count;
+        return true;
+    }
+
+    if (opcode == Instructions::structured_end) {
+        auto frame = m_control_stack.take_last();
+        // Any code following a block that was entered is reachable through a branch to its end.
+        m_is_reachable = frame.was_reachable;
+        m_stack_height = frame.entry_height + frame.result_count;
+        m_max_stack_height = max(m_max_stack_height, m_stack_height);
+        return true;
+    }
+
+    if (!m_is_reachable)
+        return true;
+
+    auto const rax = Operand::Register(Reg::RAX);
+
+    switch (opcode.value()) {
+    case Instructions::unreachable.value():
+        trap("Unreachable");
+        m_is_reachable = false;
+        return true;
+    case Instructions::nop.value():
+        return true;
+    case Instructions::br.value():
+        compile_branch(instruction.arguments().get<Instruction::BranchArgs>().target);
+        m_is_reachable = false;
+        return true;
+    case Instructions::br_if.value(): {
+        Assembler::Label not_taken {};
+        --m_stack_height;
+        m_assembler.mov32(rax, stack_slot(m_stack_height));
+        m_assembler.jump_if(rax, Condition::EqualTo, Operand::Imm(0), not_taken);
+        compile_branch(instruction.arguments().get<Instruction::BranchArgs>().target);
+        not_taken.link(m_assembler);
+        return true;
+    }
+    case Instructions::br_table.value(): {
+        auto& args = instruction.arguments().get<Instruction::TableBranchArgs>();
+        --m_stack_height;
+        m_assembler.mov32(rax, stack_slot(m_stack_height));
+        for (size_t i = 0; i < args.labels.size(); ++i) {
+            Assembler::Label next {};
+            m_assembler.jump_if(rax, Condition::NotEqualTo, Operand::Imm(i), next);
+            compile_branch(args.labels[i].target);
+            next.link(m_assembler);
+        }
+        compile_branch(args.default_.target);
+        m_is_reachable = false;
+        return true;
+    }
+    case Instructions::return_.value(): {
+        auto arity = static_cast<u32>(m_function.type().results().size());
+        compile_branch({ InstructionPointer { m_function.code().func().body().instructions().size() }, arity, 0 });
+        m_is_reachable = false;
+        return true;
+    }
+    case Instructions::call.value(): {
+        auto index = instruction.arguments().get<FunctionIndex>();
+        auto type = function_type(index);
+        if (!type.has_value() || !are_supported_types(type->parameters()) || !are_supported_types(type->results()))
+            return false;
+        auto parameter_count = static_cast<u32>(type->parameters().size());
+        auto result_count = static_cast<u32>(type->results().size());
+        VERIFY(m_stack_height >= parameter_count);
+        m_stack_height -= parameter_count;
+
+        // The results are written to where the arguments were, so make sure the frame is large enough for them.
+        m_max_stack_height = max(m_max_stack_height, m_stack_height + result_count);
+        m_assembler.mov(Operand::Register(Reg::RDX), Operand::Register(SLOTS));
+        m_assembler.add(Operand::Register(Reg::RDX), Operand::Imm((m_local_count + m_stack_height) * sizeof(u64)));
+        m_assembler.mov(Operand::Register(Reg::RSI), Operand::Imm(index.value()));
+        call_helper(reinterpret_cast<FlatPtr>(&cxx_call));
+        m_assembler.jump_if(rax, Condition::NotEqualTo, Operand::Imm(0), m_trap_exit);
+        reload_memory();
+        m_stack_height += result_count;
+        return true;
+    }
+    case Instructions::drop.value():
+        --m_stack_height;
+        return true;
+    case Instructions::select.value():
+    case Instructions::select_typed.value(): {
+        if (opcode == Instructions::select_typed && !are_supported_types(instruction.arguments().get<Vector<ValueType>>()))
+            return false;
+        pop(Reg::RAX);
+        pop(Reg::RDX);
+        pop(Reg::RCX);
+        m_assembler.mov32(rax, rax);
+        m_assembler.cmp(rax, Operand::Imm(0));
+        m_assembler.mov_if(Condition::EqualTo, Operand::Register(Reg::RCX), Operand::Register(Reg::RDX));
+        push(Reg::RCX);
+        return true;
+    }
+    case Instructions::local_get.value():
+        m_assembler.mov(rax, slot(instruction.arguments().get<LocalIndex>().value()));
+        push(Reg::RAX);
+        return true;
+    case Instructions::local_set.value():
+        pop(Reg::RAX);
+        m_assembler.mov(slot(instruction.arguments().get<LocalIndex>().value()), rax);
+        return true;
+    case Instructions::local_tee.value():
+        m_assembler.mov(rax, stack_slot(m_stack_height - 1));
+        m_assembler.mov(slot(instruction.arguments().get<LocalIndex>().value()), rax);
+        return true;
+    case Instructions::global_get.value():
+        m_assembler.mov(Operand::Register(Reg::RSI), Operand::Imm(instruction.arguments().get<GlobalIndex>().value()));
+        call_helper(reinterpret_cast<FlatPtr>(&cxx_global_get));
+        push(Reg::RAX);
+        return true;
+    case Instructions::global_set.value():
+        pop(Reg::RDX);
+        m_assembler.mov(Operand::Register(Reg::RSI), Operand::Imm(instruction.arguments().get<GlobalIndex>().value()));
+        call_helper(reinterpret_cast<FlatPtr>(&cxx_global_set));
+        return true;
+    case Instructions::i32_load.value():
+        return compile_load(instruction, Width::Bits32, false, false);
+    case Instructions::i64_load.value():
+        return compile_load(instruction, Width::Bits64, false, false);
+    case Instructions::f32_load.value():
+        return compile_load(instruction, Width::Bits32, false, false);
+    case Instructions::f64_load.value():
+        return compile_load(instruction, Width::Bits64, false, false);
+    case Instructions::i32_load8_s.value():
+        return compile_load(instruction, Width::Bits8, false, true);
+    case Instructions::i32_load8_u.value():
+        return compile_load(instruction, Width::Bits8, false, false);
+    case Instructions::i32_load16_s.value():
+        return compile_load(instruction, Width::Bits16, false, true);
+    case Instructions::i32_load16_u.value():
+        return compile_load(instruction, Width::Bits16, false, false);
+    case Instructions::i64_load8_s.value():
+        return compile_load(instruction, Width::Bits8, true, true);
+    case Instructions::i64_load8_u.value():
+        return compile_load(instruction, Width::Bits8, true, false);
+    case Instructions::i64_load16_s.value():
+        return compile_load(instruction, Width::Bits16, true, true);
+    case Instructions::i64_load16_u.value():
+        return compile_load(instruction, Width::Bits16, true, false);
+    case Instructions::i64_load32_s.value():
+        return compile_load(instruction, Width::Bits32, true, true);
+    case Instructions::i64_load32_u.value():
+        return compile_load(instruction, Width::Bits32, true, false);
+    case Instructions::i32_store.value():
+    case Instructions::f32_store.value():
+    case Instructions::i64_store32.value():
+        return compile_store(instruction, Width::Bits32);
+    case Instructions::i64_store.value():
+    case Instructions::f64_store.value():
+        return compile_store(instruction, Width::Bits64);
+    case Instructions::i32_store8.value():
+    case Instructions::i64_store8.value():
+        return compile_store(instruction, Width::Bits8);
+    case Instructions::i32_store16.value():
+    case Instructions::i64_store16.value():
+        return compile_store(instruction, Width::Bits16);
+    case Instructions::memory_size.value():
+        if (instruction.arguments().get<Instruction::MemoryIndexArgument>().memory_index.value() != 0)
+            return false;
+        m_assembler.mov(rax, Operand::Register(MEMORY_SIZE));
+        m_assembler.shift_right(rax, Operand::Imm(AK::log2(Constants::page_size)));
+        push(Reg::RAX);
+        return true;
+    case Instructions::memory_grow.value():
+        if (instruction.arguments().get<Instruction::MemoryIndexArgument>().memory_index.value() != 0)
+            return false;
+        pop(Reg::RSI);
+        call_helper(reinterpret_cast<FlatPtr>(&cxx_memory_grow));
+        reload_memory();
+        push(Reg::RAX);
+        return true;
+    case Instructions::i32_const.value():
+        m_assembler.mov(rax, Operand::Imm(bit_cast<u32>(instruction.arguments().get<i32>())));
+        push(Reg::RAX);
+        return true;
+    case Instructions::i64_const.value():
+        m_assembler.mov(rax, Operand::Imm(bit_cast<u64>(instruction.arguments().get<i64>())));
+        push(Reg::RAX);
+        return true;
+    case Instructions::f32_const.value():
+        m_assembler.mov(rax, Operand::Imm(bit_cast<u32>(instruction.arguments().get<float>())));
+        push(Reg::RAX);
+        return true;
+    case Instructions::f64_const.value():
+        m_assembler.mov(rax, Operand::Imm(bit_cast<u64>(instruction.arguments().get<double>())));
+        push(Reg::RAX);
+        return true;
+    case Instructions::i32_eqz.value():
+    case Instructions::i64_eqz.value():
+        pop(Reg::RAX);
+        if (opcode == Instructions::i32_eqz)
+            m_assembler.mov32(rax, rax);
+        m_assembler.cmp(rax, Operand::Imm(0));
+        m_assembler.set_if(Condition::EqualTo, rax);
+        m_assembler.bitwise_and(rax, Operand::Imm(1));
+        push(Reg::RAX);
+        return true;
+    case Instructions::i32_eq.value():
+        compile_comparison(Width::Bits32, Comparison::Equal);
+        return true;
+    case Instructions::i32_ne.value():
+        compile_comparison(Width::Bits32, Comparison::NotEqual);
+        return true;
+    case Instructions::i32_lts.value():
+        compile_comparison(Width::Bits32, Comparison::SignedLessThan);
+        return true;
+    case Instructions::i32_ltu.value():
+        compile_comparison(Width::Bits32, Comparison::UnsignedLessThan);
+        return true;
+    case Instructions::i32_gts.value():
+        compile_comparison(Width::Bits32, Comparison::SignedGreaterThan);
+        return true;
+    case Instructions::i32_gtu.value():
+        compile_comparison(Width::Bits32, Comparison::UnsignedGreaterThan);
+        return true;
+    case Instructions::i32_les.value():
+        compile_comparison(Width::Bits32, Comparison::SignedLessThanOrEqual);
+        return true;
+    case Instructions::i32_leu.value():
+        compile_comparison(Width::Bits32, Comparison::UnsignedLessThanOrEqual);
+        return true;
+    case Instructions::i32_ges.value():
+        compile_comparison(Width::Bits32, Comparison::SignedGreaterThanOrEqual);
+        return true;
+    case Instructions::i32_geu.value():
+        compile_comparison(Width::Bits32, Comparison::UnsignedGreaterThanOrEqual);
+        return true;
+    case Instructions::i64_eq.value():
+        compile_comparison(Width::Bits64, Comparison::Equal);
+        return true;
+    case Instructions::i64_ne.value():
+        compile_comparison(Width::Bits64, Comparison::NotEqual);
+        return true;
+    case Instructions::i64_lts.value():
+        compile_comparison(Width::Bits64, Comparison::SignedLessThan);
+        return true;
+    case Instructions::i64_ltu.value():
+        compile_comparison(Width::Bits64, Comparison::UnsignedLessThan);
+        return true;
+    case Instructions::i64_gts.value():
+        compile_comparison(Width::Bits64, Comparison::SignedGreaterThan);
+        return true;
+    case Instructions::i64_gtu.value():
+        compile_comparison(Width::Bits64, Comparison::UnsignedGreaterThan);
+        return true;
+    case Instructions::i64_les.value():
+        compile_comparison(Width::Bits64, Comparison::SignedLessThanOrEqual);
+        return true;
+    case Instructions::i64_leu.value():
+        compile_comparison(Width::Bits64, Comparison::UnsignedLessThanOrEqual);
+        return true;
+    case Instructions::i64_ges.value():
+        compile_comparison(Width::Bits64, Comparison::SignedGreaterThanOrEqual);
+        return true;
+    case Instructions::i64_geu.value():
+        compile_comparison(Width::Bits64, Comparison::UnsignedGreaterThanOrEqual);
+        return true;
+    case Instructions::i32_add.value():
+        compile_binary_operation(Width::Bits32, Operation::Add);
+        return true;
+    case Instructions::i32_sub.value():
+        compile_binary_operation(Width::Bits32, Operation::Sub);
+        return true;
+    case Instructions::i32_mul.value():
+        compile_binary_operation(Width::Bits32, Operation::Mul);
+        return true;
+    case Instructions::i32_and.value():
+        compile_binary_operation(Width::Bits32, Operation::And);
+        return true;
+    case Instructions::i32_or.value():
+        compile_binary_operation(Width::Bits32, Operation::Or);
+        return true;
+    case Instructions::i32_xor.value():
+        compile_binary_operation(Width::Bits32, Operation::Xor);
+        return true;
+    case Instructions::i32_shl.value():
+        compile_binary_operation(Width::Bits32, Operation::ShiftLeft);
+        return true;
+    case Instructions::i32_shrs.value():
+        compile_binary_operation(Width::Bits32, Operation::ShiftRightSigned);
+        return true;
+    case Instructions::i32_shru.value():
+        compile_binary_operation(Width::Bits32, Operation::ShiftRightUnsigned);
+        return true;
+    case Instructions::i64_add.value():
+        compile_binary_operation(Width::Bits64, Operation::Add);
+        return true;
+    case Instructions::i64_sub.value():
+        compile_binary_operation(Width::Bits64, Operation::Sub);
+        return true;
+    case Instructions::i64_mul.value():
+        compile_binary_operation(Width::Bits64, Operation::Mul);
+        return true;
+    case Instructions::i64_and.value():
+        compile_binary_operation(Width::Bits64, Operation::And);
+        return true;
+    case Instructions::i64_or.value():
+        compile_binary_operation(Width::Bits64, Operation::Or);
+        return true;
+    case Instructions::i64_xor.value():
+        compile_binary_operation(Width::Bits64, Operation::Xor);
+        return true;
+    case Instructions::i64_shl.value():
+        compile_binary_operation(Width::Bits64, Operation::ShiftLeft);
+        return true;
+    case Instructions::i64_shrs.value():
+        compile_binary_operation(Width::Bits64, Operation::ShiftRightSigned);
+        return true;
+    case Instructions::i64_shru.value():
+        compile_binary_operation(Width::Bits64, Operation::ShiftRightUnsigned);
+        return true;
+    case Instructions::i32_wrap_i64.value():
+    case Instructions::i32_reinterpret_f32.value():
+    case Instructions::i64_reinterpret_f64.value():
+    case Instructions::f32_reinterpret_i32.value():
+    case Instructions::f64_reinterpret_i64.value():
+        // Only the bits that make up the value matter, so these are no-ops.
+        return true;
+    case Instructions::i64_extend_si32.value():
+    case Instructions::i64_extend_ui32.value(): {
+        auto extension = opcode == Instructions::i64_extend_si32 ? Assembler::Extension::SignExtend : Assembler::Extension::ZeroExtend;
+        m_assembler.mov32(rax, stack_slot(m_stack_height - 1), extension);
+        m_assembler.mov(stack_slot(m_stack_height - 1), rax);
+        return true;
+    }
+    default:
+        dbgln_if(WASM_TRACE_DEBUG, "Wasm JIT: Can't compile {}", instruction_name(opcode));
+        return false;
+    }
+}
+
+OwnPtr<NativeFunction> Compiler::compile_function()
+{
+    auto& type = m_function.type();
+    auto& func = m_function.code().func();
+    if (!are_supported_types(type.parameters()) || !are_supported_types(type.results()))
+        return nullptr;
+    for (auto& locals : func.locals()) {
+        if (!is_supported_type(locals.type()))
+            return nullptr;
+    }
+
+    auto& instructions = func.body().instructions();
+    m_local_count = type.parameters().size() + func.total_local_count();
+    m_instruction_labels.resize(instructions.size() + 1);
+    m_control_stack.append({ .entry_height = 0, .parameter_count = 0, .result_count = static_cast<u32>(type.results().size()) });
+
+    // The prologue pins the frame and the context to callee-saved registers, see NativeFunction::run() for the arguments.
+    m_assembler.enter();
+    m_assembler.mov(Operand::Register(SLOTS), Operand::Register(Reg::RDI));
+    m_assembler.mov(Operand::Register(CONTEXT), Operand::Register(Reg::RSI));
+    reload_memory();
+
+    for (size_t i = 0; i < instructions.size(); ++i) {
+        m_instruction_labels[i].link(m_assembler);
+        if (!compile_instruction(instructions[i]))
+            return nullptr;
+    }
+
+    // Returning and falling off the end both leave the results at the bottom of the stack.
+    m_instruction_labels[instructions.size()].link(m_assembler);
+    m_assembler.mov(Operand::Register(Reg::RAX), Operand::Imm(to_underlying(NativeFunction::ExitReason::Finished)));
+    m_exit.link(m_assembler);
+    m_assembler.exit();
+
+    m_out_of_bounds.link(m_assembler);
+    trap("Memory access out of bounds");
+
+    // The interpreter's trap has already been set by a helper.
+    m_trap_exit.link(m_assembler);
+    m_assembler.mov(Operand::Register(Reg::RAX), Operand::Imm(to_underlying(NativeFunction::ExitReason::Trap)));
+    m_assembler.jump(m_exit);
+
+    auto native_function_or_error = NativeFunction::create(m_output, m_local_count, m_local_count + m_max_stack_height, type.results());
+    if (native_function_or_error.is_error()) {
+        dbgln("LibWasm: Failed to create native code: {}", native_function_or_error.error());
+        return nullptr;
+    }
+    return native_function_or_error.release_value();
+}
+
+#endif
+
+OwnPtr<NativeFunction> Compiler::compile(Configuration& configuration, WasmFunction const& function)
+{
+#if JIT_ARCH_SUPPORTED
+    Compiler compiler(configuration, function);
+    return compiler.compile_function();
+#else
+    (void)configuration;
+    (void)function;
+    return nullptr;
+#endif
+}
+
+}
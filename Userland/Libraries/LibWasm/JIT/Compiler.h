@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJIT/Assembler.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/JIT/NativeFunction.h>
+
+namespace Wasm::JIT {
+
+// A single-pass compiler from validated function bodies to machine code.
+//
+// Locals and stack values live in a frame of 64-bit slots, whose offsets are fixed at compile time. Integer arithmetic,
+// comparisons, branches and memory accesses (with an explicit bounds check) are done in native code, while calls and
+// globals go through small helpers. Functions using anything else (floating point arithmetic, vectors, references,
+// tables, bulk memory operations, ...) are left to the interpreter.
+class Compiler {
+public:
+    // Functions are compiled once they have been called this many times.
+    static constexpr u32 hotness_threshold = 100;
+
+    static OwnPtr<NativeFunction> compile(Configuration&, WasmFunction const&);
+
+#if JIT_ARCH_SUPPORTED
+    using Assembler = ::JIT::Assembler;
+
+    enum class Width {
+        Bits8,
+        Bits16,
+        Bits32,
+        Bits64,
+    };
+    enum class Comparison {
+        Equal,
+        NotEqual,
+        SignedLessThan,
+        UnsignedLessThan,
+        SignedGreaterThan,
+        UnsignedGreaterThan,
+        SignedLessThanOrEqual,
+        UnsignedLessThanOrEqual,
+        SignedGreaterThanOrEqual,
+        UnsignedGreaterThanOrEqual,
+    };
+    enum class Operation {
+        Add,
+        Sub,
+        Mul,
+        And,
+        Or,
+        Xor,
+        ShiftLeft,
+        ShiftRightSigned,
+        ShiftRightUnsigned,
+    };
+
+private:
+    Compiler(Configuration& configuration, WasmFunction const& function)
+        : m_configuration(configuration)
+        , m_function(function)
+        , m_assembler(m_output)
+    {
+    }
+
+    OwnPtr<NativeFunction> compile_function();
+
+    // Returns false if the instruction isn't supported.
+    [[nodiscard]] bool compile_instruction(Instruction const&);
+
+    struct ControlFrame {
+        u32 entry_height { 0 };
+        u32 parameter_count { 0 };
+        u32 result_count { 0 };
+        bool is_if { false };
+        bool was_reachable { true };
+    };
+    [[nodiscard]] bool enter_block(Instruction const&);
+
+    [[nodiscard]] bool compile_load(Instruction const&, Width, bool sign_extend_to_64_bits, bool is_signed);
+    [[nodiscard]] bool compile_store(Instruction const&, Width);
+    void compile_comparison(Width, Comparison);
+    void compile_binary_operation(Width, Operation);
+    void compile_branch(Instruction::BranchTarget const&);
+    void compute_memory_address(Assembler::Reg, u32 offset, size_t access_size);
+
+    Assembler::Operand slot(u32 index) const;
+    Assembler::Operand stack_slot(u32 height) const { return slot(m_local_count + height); }
+    void push(Assembler::Reg);
+    void pop(Assembler::Reg);
+    void reload_memory();
+    void trap(char const* reason);
+
+    // Passes the context as the first argument, the other arguments have to be in place already.
+    void call_helper(FlatPtr helper);
+
+    // The helpers that native code calls into.
+    static u64 cxx_call(NativeFunction::Context&, u64 function_index, u64* arguments_and_results);
+    static u64 cxx_global_get(NativeFunction::Context&, u64 global_index);
+    static u64 cxx_global_set(NativeFunction::Context&, u64 global_index, u64 value);
+    static u64 cxx_memory_grow(NativeFunction::Context&, u64 page_count);
+
+    Optional<FunctionType const&> function_type(FunctionIndex) const;
+    Optional<FunctionType> block_type(BlockType const&) const;
+
+    Configuration& m_configuration;
+    WasmFunction const& m_function;
+    Vector<u8> m_output;
+    Assembler m_assembler;
+
+    Vector<Assembler::Label> m_instruction_labels;
+    Vector<ControlFrame> m_control_stack;
+    Assembler::Label m_exit;
+    Assembler::Label m_trap_exit;
+    Assembler::Label m_out_of_bounds;
+    u32 m_local_count { 0 };
+    u32 m_stack_height { 0 };
+    u32 m_max_stack_height { 0 };
+    bool m_is_reachable { true };
+#endif
+};
+
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibWasm/AbstractMachine/Configuration.h>
+#include <LibWasm/JIT/NativeFunction.h>
+#include <sys/mman.h>
+
+namespace Wasm::JIT {
+
+ErrorOr<NonnullOwnPtr<NativeFunction>> NativeFunction::create(ReadonlyBytes code, size_t local_count, size_t slot_count, Vector<ValueType> result_types)
+{
+    auto* memory = TRY(Core::System::mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0, 0, "Wasm JIT code"sv));
+    memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        auto error = Error::from_syscall("mprotect"sv, -errno);
+        MUST(Core::System::munmap(memory, code.size()));
+        return error;
+    }
+    return adopt_nonnull_own_or_enomem(new (nothrow) NativeFunction(memory, code.size(), local_count, slot_count, move(result_types)));
+}
+
+NativeFunction::NativeFunction(void* code, size_t size, size_t local_count, size_t slot_count, Vector<ValueType> result_types)
+    : m_code(code)
+    , m_size(size)
+    , m_local_count(local_count)
+    , m_slot_count(slot_count)
+    , m_result_types(move(result_types))
+{
+}
+
+NativeFunction::~NativeFunction()
+{
+    MUST(Core::System::munmap(m_code, m_size));
+}
+
+void NativeFunction::Context::reload_memory()
+{
+    auto& memories = configuration->frame().module().memories();
+    if (memories.is_empty())
+        return;
+    auto* memory = configuration->store().get(memories.first());
+    memory_base = memory->data().data();
+    memory_size = memory->size();
+}
+
+Value NativeFunction::value_from_slot(u64 slot, ValueType type)
+{
+    switch (type.kind()) {
+    case ValueType::I32:
+        return Value(static_cast<i32>(slot));
+    case ValueType::I64:
+        return Value(static_cast<i64>(slot));
+    case ValueType::F32:
+        return Value(bit_cast<f32>(static_cast<u32>(slot)));
+    case ValueType::F64:
+        return Value(bit_cast<f64>(slot));
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+NativeFunction::ExitReason NativeFunction::run(Context& context, Span<u64> slots) const
+{
+    context.reload_memory();
+
+    // See Compiler::compile_function() for the prologue that sets up the pinned registers.
+    using EntryFunction = u64 (*)(u64* slots, Context*);
+
+    VERIFY(slots.size() >= m_slot_count);
+    auto function = reinterpret_cast<EntryFunction>(m_code);
+    return static_cast<ExitReason>(function(slots.data(), &context));
+}
+
+}
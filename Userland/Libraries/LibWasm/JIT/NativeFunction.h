@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+class Configuration;
+class Value;
+struct BytecodeInterpreter;
+
+}
+
+namespace Wasm::JIT {
+
+// Machine code for the body of a WasmFunction.
+//
+// Instead of the configuration's value stack, the code works on a frame of 64-bit slots: the function's locals come
+// first, followed by the values on its stack (whose height is known at every instruction). The results of the function
+// are left in the first stack slots.
+class NativeFunction {
+    AK_MAKE_NONCOPYABLE(NativeFunction);
+    AK_MAKE_NONMOVABLE(NativeFunction);
+
+public:
+    enum class ExitReason : u64 {
+        Finished = 0,
+        // The code has trapped, with either the context's trap reason or the interpreter's trap set.
+        Trap = 1,
+    };
+
+    // What the code and the helpers it calls into need to know, see Compiler.cpp.
+    struct Context {
+        BytecodeInterpreter* interpreter { nullptr };
+        Configuration* configuration { nullptr };
+        // The contents of the module's first memory, which have to be reloaded whenever the memory could have grown.
+        u8* memory_base { nullptr };
+        u64 memory_size { 0 };
+        char const* trap_reason { nullptr };
+
+        void reload_memory();
+    };
+
+    static Value value_from_slot(u64, ValueType);
+
+    // Copies the code into executable memory.
+    static ErrorOr<NonnullOwnPtr<NativeFunction>> create(ReadonlyBytes code, size_t local_count, size_t slot_count, Vector<ValueType> result_types);
+    ~NativeFunction();
+
+    size_t local_count() const { return m_local_count; }
+    size_t slot_count() const { return m_slot_count; }
+    auto& result_types() const { return m_result_types; }
+
+    ExitReason run(Context&, Span<u64> slots) const;
+
+private:
+    NativeFunction(void* code, size_t size, size_t local_count, size_t slot_count, Vector<ValueType> result_types);
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    size_t m_local_count { 0 };
+    size_t m_slot_count { 0 };
+    Vector<ValueType> m_result_types;
+};
+
+}
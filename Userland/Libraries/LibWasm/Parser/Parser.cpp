@@ -12,6 +12,7 @@
 #include <AK/ScopeGuard.h>
 #include <AK/ScopeLogger.h>
 #include <AK/UFixedBigInt.h>
+#include <LibThreading/ParallelAlgorithms.h>
 #include <LibWasm/Types.h>
 
 namespace Wasm {
@@ -249,13 +250,17 @@ ParseResult<Instruction> Instruction::parse(Stream& stream)
     case Instructions::br_if.value(): {
         // branches with a single label immediate
         auto index = TRY(GenericIndexParser<LabelIndex>::parse(stream));
-        return Instruction { opcode, index };
+        return Instruction { opcode, BranchArgs { index } };
     }
     case Instructions::br_table.value(): {
         // br_table label* label
         auto labels = TRY(parse_vector<GenericIndexParser<LabelIndex>>(stream));
         auto default_label = TRY(GenericIndexParser<LabelIndex>::parse(stream));
-        return Instruction { opcode, TableBranchArgs { labels, default_label } };
+        Vector<BranchArgs> branches;
+        branches.ensure_capacity(labels.size());
+        for (auto label : labels)
+            branches.unchecked_append(BranchArgs { label });
+        return Instruction { opcode, TableBranchArgs { move(branches), BranchArgs { default_label } } };
     }
     case Instructions::call.value(): {
         // call function
@@ -368,8 +373,10 @@ ParseResult<Instruction> Instruction::parse(Stream& stream)
         auto index = TRY(GenericIndexParser<FunctionIndex>::parse(stream));
         return Instruction { opcode, index };
     }
-    case Instructions::structured_end.value():
     case Instructions::structured_else.value():
+        // The end of the if block is filled in by the validator.
+        return Instruction { opcode, BranchTarget {} };
+    case Instructions::structured_end.value():
     case Instructions::ref_is_null.value():
     case Instructions::unreachable.value():
     case Instructions::nop.value():
@@ -1160,7 +1167,60 @@ ParseResult<CodeSection::Code> CodeSection::Code::parse(Stream& stream)
 ParseResult<CodeSection> CodeSection::parse(Stream& stream)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("CodeSection"sv);
-    auto result = TRY(parse_vector<Code>(stream));
+
+    // Function bodies make up most of a module, and since they are prefixed with their size, they can be parsed
+    // independently of each other. So we only collect their bytes here, and parse them in parallel afterwards.
+    struct Body {
+        ByteBuffer bytes;
+        Optional<Func> func;
+        Optional<ParseError> error;
+    };
+
+    size_t count = TRY_READ(stream, LEB128<u32>, ParseError::ExpectedSize);
+    Vector<Body> bodies;
+    if (bodies.try_ensure_capacity(count).is_error())
+        return ParseError::OutOfMemory;
+
+    size_t total_size = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t size = TRY_READ(stream, LEB128<u32>, ParseError::InvalidSize);
+        auto bytes = ByteBuffer::create_uninitialized(size);
+        if (bytes.is_error())
+            return ParseError::HugeAllocationRequested;
+        if (stream.read_until_filled(bytes.value()).is_error())
+            return with_eof_check(stream, ParseError::InvalidInput);
+        total_size += size;
+        bodies.unchecked_append({ bytes.release_value(), {}, {} });
+    }
+
+    auto parse_bodies = [](Span<Body> bodies) {
+        for (auto& body : bodies) {
+            FixedMemoryStream body_stream { body.bytes.bytes() };
+            // See Code::parse() for the size hint.
+            auto func = Func::parse(body_stream, body.bytes.size() / 2);
+            if (func.is_error())
+                body.error = func.error();
+            else if (!body_stream.is_eof())
+                body.error = ParseError::InvalidSize;
+            else
+                body.func = func.release_value();
+        }
+    };
+
+    // Handing small sections to other threads takes longer than just parsing them.
+    static constexpr size_t minimum_size_to_parse_in_parallel = 64 * KiB;
+    if (total_size < minimum_size_to_parse_in_parallel)
+        parse_bodies(bodies.span());
+    else
+        Threading::parallel_for(bodies.span(), parse_bodies);
+
+    Vector<Code> result;
+    result.ensure_capacity(count);
+    for (auto& body : bodies) {
+        if (body.error.has_value())
+            return body.error.release_value();
+        result.unchecked_append(Code { static_cast<u32>(body.bytes.size()), body.func.release_value() });
+    }
     return CodeSection { move(result) };
 }
 
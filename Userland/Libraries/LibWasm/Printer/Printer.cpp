@@ -440,6 +440,8 @@ void Printer::print(Wasm::Instruction const& instruction)
         print(" ");
         instruction.arguments().visit(
             [&](BlockType const& type) { print(type); },
+            [&](Instruction::BranchArgs const& args) { print("(label index {})", args.label.value()); },
+            [&](Instruction::BranchTarget const& target) { print("(continue at {})", target.continuation.value()); },
             [&](DataIndex const& index) { print("(data index {})", index.value()); },
             [&](ElementIndex const& index) { print("(element index {})", index.value()); },
             [&](FunctionIndex const& index) { print("(function index {})", index.value()); },
@@ -471,8 +473,8 @@ void Printer::print(Wasm::Instruction const& instruction)
             [&](Instruction::TableBranchArgs const& args) {
                 print("(table_branch");
                 for (auto& label : args.labels)
-                    print(" (label {})", label.value());
-                print(" (label {}))", args.default_.value());
+                    print(" (label {})", label.label.value());
+                print(" (label {}))", args.default_.label.value());
             },
             [&](Instruction::TableElementArgs const& args) { print("(table_element (table index {}) (element index {}))", args.table_index.value(), args.element_index.value()); },
             [&](Instruction::TableTableArgs const& args) { print("(table_table (table index {}) (table index {}))", args.lhs.value(), args.rhs.value()); },
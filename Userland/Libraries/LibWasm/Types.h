@@ -402,9 +402,22 @@ public:
         Optional<InstructionPointer> else_ip;
     };
 
+    // Where execution continues once a branch is taken, as resolved by the validator: the instruction to continue at,
+    // the number of values that are carried over, and the height of the value stack below them (relative to the frame).
+    struct BranchTarget {
+        InstructionPointer continuation { 0 };
+        u32 arity { 0 };
+        u32 stack_height { 0 };
+    };
+
+    struct BranchArgs {
+        LabelIndex label;
+        BranchTarget target {};
+    };
+
     struct TableBranchArgs {
-        Vector<LabelIndex> labels;
-        LabelIndex default_;
+        Vector<BranchArgs> labels;
+        BranchArgs default_;
     };
 
     struct IndirectCallArgs {
@@ -471,6 +484,8 @@ private:
     OpCode m_opcode { 0 };
     Variant<
         BlockType,
+        BranchArgs,
+        BranchTarget,
         DataIndex,
         ElementIndex,
         FunctionIndex,
@@ -706,10 +721,15 @@ public:
 
     auto& instructions() const { return m_instructions; }
 
+    // The most values this expression keeps on the value stack at once, as found by the validator.
+    size_t stack_usage_hint() const { return m_stack_usage_hint; }
+    void set_stack_usage_hint(size_t value) { m_stack_usage_hint = value; }
+
     static ParseResult<Expression> parse(Stream& stream, Optional<size_t> size_hint = {});
 
 private:
     Vector<Instruction> m_instructions;
+    size_t m_stack_usage_hint { 0 };
 };
 
 class GlobalSection {
@@ -880,9 +900,12 @@ public:
             : m_locals(move(locals))
             , m_body(move(body))
         {
+            for (auto& local : m_locals)
+                m_total_local_count += local.n();
         }
 
         auto& locals() const { return m_locals; }
+        auto total_local_count() const { return m_total_local_count; }
         auto& body() const { return m_body; }
 
         static ParseResult<Func> parse(Stream& stream, size_t size_hint);
@@ -890,6 +913,7 @@ public:
     private:
         Vector<Locals> m_locals;
         Expression m_body;
+        size_t m_total_local_count { 0 };
     };
     class Code {
     public:
@@ -11,6 +11,7 @@
 #include <LibWeb/Bindings/KeyframeEffectPrototype.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/StyleComputer.h>
+#include <LibWeb/HTML/Navigable.h>
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Painting/Paintable.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
@@ -1001,8 +1002,21 @@ void KeyframeEffect::update_style_properties()
         document.set_needs_layout();
     if (invalidation.rebuild_layout_tree)
         document.invalidate_layout_tree();
-    if (invalidation.repaint)
+    if (invalidation.repaint) {
         document.set_needs_to_resolve_paint_only_properties();
+
+        // NOTE: Descendants may paint outside of the target, and inherit the animated values as well.
+        if (pseudo_element_type().has_value()) {
+            if (auto navigable = document.navigable())
+                navigable->set_needs_display();
+        } else {
+            target->for_each_in_inclusive_subtree_of_type<DOM::Element>([&](auto& element) {
+                if (auto* paintable = element.paintable())
+                    paintable->set_needs_display();
+                return TraversalDecision::Continue;
+            });
+        }
+    }
     if (invalidation.rebuild_stacking_context_tree)
         document.invalidate_stacking_context_tree();
 }
@@ -72,6 +72,9 @@
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
+#include <LibWeb/HTML/HTMLInputElement.h>
+#include <LibWeb/HTML/HTMLSelectElement.h>
+#include <LibWeb/HTML/HTMLTextAreaElement.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/HighResolutionTime/TimeOrigin.h>
@@ -426,7 +429,7 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
     if (element.is_document_element())
         add_rules_to_run(rule_cache.root_rules);
 
-    element.for_each_attribute([&](auto& name, auto&) {
+    element.for_each_attribute([&](FlyString const& name, String const&) {
         if (auto it = rule_cache.rules_by_attribute_name.find(name); it != rule_cache.rules_by_attribute_name.end()) {
             add_rules_to_run(it->value);
         }
@@ -434,6 +437,8 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
 
     add_rules_to_run(rule_cache.other_rules);
 
+    m_rule_matching_statistics.candidate_rules += rules_to_run.size();
+
     size_t maximum_match_count = 0;
 
     for (auto& rule_to_run : rules_to_run) {
@@ -458,6 +463,7 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
 
         auto const& selector = rule_to_run.absolutized_selectors()[rule_to_run.selector_index];
         if (should_reject_with_ancestor_filter(*selector)) {
+            ++m_rule_matching_statistics.rejected_by_ancestor_filter;
             rule_to_run.skip = true;
             continue;
         }
@@ -485,13 +491,15 @@ Vector<MatchingRule> StyleComputer::collect_matching_rules(DOM::Element const& e
 
         auto const& selector = rule_to_run.absolutized_selectors()[rule_to_run.selector_index];
 
-        if (rule_to_run.can_use_fast_matches) {
-            if (!SelectorEngine::fast_matches(selector, *rule_to_run.sheet, element, shadow_host_to_use))
-                continue;
-        } else {
-            if (!SelectorEngine::matches(selector, *rule_to_run.sheet, element, shadow_host_to_use, pseudo_element))
-                continue;
+        bool matches = rule_to_run.can_use_fast_matches
+            ? SelectorEngine::fast_matches(selector, *rule_to_run.sheet, element, shadow_host_to_use)
+            : SelectorEngine::matches(selector, *rule_to_run.sheet, element, shadow_host_to_use, pseudo_element);
+        if (!matches) {
+            ++m_rule_matching_statistics.rejected_by_selector_matching;
+            continue;
         }
+
+        ++m_rule_matching_statistics.matched_rules;
         matching_rules.append(rule_to_run);
     }
     return matching_rules;
@@ -1951,13 +1959,7 @@ RefPtr<Gfx::FontCascadeList const> StyleComputer::compute_font_for_style_values(
 
     float const font_size_in_pt = font_size_in_px * 0.75f;
 
-    auto find_font = [&](FlyString const& family) -> RefPtr<Gfx::FontCascadeList const> {
-        FontFaceKey key {
-            .family_name = family,
-            .weight = weight,
-            .slope = slope,
-        };
-
+    auto find_font_uncached = [&](FontFaceKey const& key) -> RefPtr<Gfx::FontCascadeList const> {
         auto result = Gfx::FontCascadeList::create();
         if (auto it = m_loaded_fonts.find(key); it != m_loaded_fonts.end()) {
             auto const& loaders = it->value;
@@ -1972,7 +1974,7 @@ RefPtr<Gfx::FontCascadeList const> StyleComputer::compute_font_for_style_values(
             return found_font;
         }
 
-        if (auto found_font = Gfx::FontDatabase::the().get(family, font_size_in_pt, weight, width, slope, Gfx::Font::AllowInexactSizeMatch::Yes)) {
+        if (auto found_font = Gfx::FontDatabase::the().get(key.family_name, font_size_in_pt, weight, width, slope, Gfx::Font::AllowInexactSizeMatch::Yes)) {
             result->add(*found_font);
             return result;
         }
@@ -1980,6 +1982,24 @@ RefPtr<Gfx::FontCascadeList const> StyleComputer::compute_font_for_style_values(
         return {};
     };
 
+    auto find_font = [&](FlyString const& family) -> RefPtr<Gfx::FontCascadeList const> {
+        FontMatchingCacheKey cache_key {
+            .face = {
+                .family_name = family,
+                .weight = weight,
+                .slope = slope,
+            },
+            .width = width,
+            .font_size_in_pt = font_size_in_pt,
+        };
+        if (auto it = m_font_matching_cache.find(cache_key); it != m_font_matching_cache.end())
+            return it->value;
+
+        auto found_font = find_font_uncached(cache_key.face);
+        m_font_matching_cache.set(move(cache_key), found_font);
+        return found_font;
+    };
+
     auto find_generic_font = [&](Keyword font_id) -> RefPtr<Gfx::FontCascadeList const> {
         Platform::GenericFont generic_font {};
         switch (font_id) {
@@ -2309,6 +2329,15 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
 
     ScopeGuard guard { [&element]() { element.set_needs_style_update(false); } };
 
+    if (mode == ComputeStyleMode::Normal && !pseudo_element.has_value()) {
+        if (auto* sibling = find_element_to_share_style_with(element)) {
+            ++m_rule_matching_statistics.shared_styles;
+            element.set_custom_properties({}, sibling->custom_properties({}));
+            // NOTE: The properties are copy-on-write, so animations and the like can still change one of the styles.
+            return sibling->computed_css_values()->clone();
+        }
+    }
+
     auto style = StyleProperties::create();
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
@@ -2374,6 +2403,127 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
     return style;
 }
 
+static bool can_share_style(DOM::Element& element)
+{
+    // Form controls adjust their computed style depending on their state.
+    if (!element.is_html_element() || is<HTML::HTMLInputElement>(element) || is<HTML::HTMLSelectElement>(element) || is<HTML::HTMLTextAreaElement>(element))
+        return false;
+    if (element.use_pseudo_element().has_value() || element.is_shadow_host() || element.inline_style())
+        return false;
+    if (!is<DOM::Document>(element.root()))
+        return false;
+    auto* parent = element.parent_element();
+    if (!parent || parent->is_shadow_host())
+        return false;
+    if (element.cached_animation_name_source({}) || !element.get_animations_internal({ .subtree = false }).is_empty())
+        return false;
+    return true;
+}
+
+static bool have_same_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    if (a.attribute_list_size() != b.attribute_list_size())
+        return false;
+    bool same_attributes = true;
+    a.for_each_attribute([&](DOM::Attr const& attribute) {
+        if (same_attributes && b.get_attribute_ns(attribute.namespace_uri(), attribute.local_name()) != attribute.value())
+            same_attributes = false;
+    });
+    return same_attributes;
+}
+
+DOM::Element* StyleComputer::find_element_to_share_style_with(DOM::Element& element) const
+{
+    // Elements that had a style before might have to start transitions from it.
+    if (element.computed_css_values() || !can_share_style(element))
+        return nullptr;
+
+    size_t remaining_candidates = max_style_sharing_candidates;
+    for (auto* sibling = element.previous_element_sibling(); sibling && remaining_candidates > 0; sibling = sibling->previous_element_sibling(), --remaining_candidates) {
+        auto const* style = sibling->computed_css_values();
+        if (!style || sibling->needs_style_update())
+            continue;
+        if (sibling->local_name() != element.local_name() || sibling->namespace_uri() != element.namespace_uri())
+            continue;
+        if (!have_same_attributes(*sibling, element) || !can_share_style(*sibling))
+            continue;
+
+        // Styles with animations are changed by them, and creating the style for an animation has to create the animation.
+        if (!style->animated_property_values().is_empty())
+            continue;
+        if (auto animation_name = style->maybe_null_property(PropertyID::AnimationName); animation_name && animation_name->to_keyword() != Keyword::None)
+            continue;
+
+        if (!state_dependent_rules_match_equally(element, *sibling))
+            continue;
+
+        return sibling;
+    }
+    return nullptr;
+}
+
+bool StyleComputer::state_dependent_rules_match_equally(DOM::Element const& element, DOM::Element const& sibling) const
+{
+    // Both elements have the same tag name and attributes, so they look up the same rules from the rule caches. And
+    // since they have the same ancestors, those rules can only match differently if their subject depends on the state
+    // of the element or its position among its siblings. So we only have to match those rules against both elements.
+    bool match_equally = true;
+    auto check_rules = [&](Vector<MatchingRule> const& rules) {
+        for (auto const& rule : rules) {
+            if (!match_equally)
+                return;
+            if (!rule.could_depend_on_element_state_or_siblings || rule.contains_pseudo_element || rule.shadow_root)
+                continue;
+            auto const& selector = rule.absolutized_selectors()[rule.selector_index];
+            if (SelectorEngine::matches(selector, *rule.sheet, element, nullptr) != SelectorEngine::matches(selector, *rule.sheet, sibling, nullptr))
+                match_equally = false;
+        }
+    };
+
+    for (auto cascade_origin : { CascadeOrigin::UserAgent, CascadeOrigin::User, CascadeOrigin::Author }) {
+        auto const& rule_cache = rule_cache_for_cascade_origin(cascade_origin);
+        for (auto const& class_name : element.class_names()) {
+            if (auto it = rule_cache.rules_by_class.find(class_name); it != rule_cache.rules_by_class.end())
+                check_rules(it->value);
+        }
+        if (auto id = element.id(); id.has_value()) {
+            if (auto it = rule_cache.rules_by_id.find(id.value()); it != rule_cache.rules_by_id.end())
+                check_rules(it->value);
+        }
+        if (auto it = rule_cache.rules_by_tag_name.find(element.local_name()); it != rule_cache.rules_by_tag_name.end())
+            check_rules(it->value);
+        element.for_each_attribute([&](FlyString const& name, String const&) {
+            if (auto it = rule_cache.rules_by_attribute_name.find(name); it != rule_cache.rules_by_attribute_name.end())
+                check_rules(it->value);
+        });
+        check_rules(rule_cache.other_rules);
+    }
+    return match_equally;
+}
+
+// Whether the selector can match one of two siblings with the same tag name and attributes, but not the other.
+static bool could_depend_on_element_state_or_siblings(CSS::Selector const& selector)
+{
+    auto const& subject = selector.compound_selectors().last();
+    if (subject.combinator == CSS::Selector::Combinator::NextSibling || subject.combinator == CSS::Selector::Combinator::SubsequentSibling)
+        return true;
+
+    for (auto const& simple_selector : subject.simple_selectors) {
+        if (simple_selector.type != CSS::Selector::SimpleSelector::Type::PseudoClass)
+            continue;
+        switch (simple_selector.pseudo_class().type) {
+        case CSS::PseudoClass::AnyLink:
+        case CSS::PseudoClass::Lang:
+        case CSS::PseudoClass::Link:
+        case CSS::PseudoClass::Visited:
+            break;
+        default:
+            return true;
+        }
+    }
+    return false;
+}
+
 void StyleComputer::build_rule_cache_if_needed() const
 {
     if (m_author_rule_cache && m_user_rule_cache && m_user_agent_rule_cache)
@@ -2457,6 +2607,8 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                     false,
                 };
 
+                matching_rule.could_depend_on_element_state_or_siblings = could_depend_on_element_state_or_siblings(selector);
+
                 bool contains_root_pseudo_class = false;
                 Optional<CSS::Selector::PseudoElement::Type> pseudo_element;
 
@@ -2732,6 +2884,7 @@ void StyleComputer::invalidate_rule_cache()
 
 void StyleComputer::did_load_font(FlyString const&)
 {
+    m_font_matching_cache.clear();
     document().invalidate_style(DOM::StyleInvalidationReason::CSSFontLoaded);
 }
 
@@ -2765,6 +2918,7 @@ Optional<FontLoader&> StyleComputer::load_font_face(ParsedFontFace const& font_f
 
     auto loader = make<FontLoader>(const_cast<StyleComputer&>(*this), font_face.font_family(), font_face.unicode_ranges(), move(urls), move(on_load), move(on_fail));
     auto& loader_ref = *loader;
+    m_font_matching_cache.clear();
     auto maybe_font_loaders_list = const_cast<StyleComputer&>(*this).m_loaded_fonts.get(key);
     if (maybe_font_loaders_list.has_value()) {
         maybe_font_loaders_list->append(move(loader));
@@ -2791,6 +2945,7 @@ void StyleComputer::load_fonts_from_sheet(CSSStyleSheet& sheet)
 
 void StyleComputer::unload_fonts_from_sheet(CSSStyleSheet& sheet)
 {
+    m_font_matching_cache.clear();
     for (auto& [_, font_loader_list] : m_loaded_fonts) {
         font_loader_list.remove_all_matching([&](auto& font_loader) {
             return sheet.has_associated_font_loader(*font_loader);
@@ -93,6 +93,7 @@ struct MatchingRule {
     bool contains_pseudo_element { false };
     bool can_use_fast_matches { false };
     bool must_be_hovered { false };
+    bool could_depend_on_element_state_or_siblings { false };
     bool skip { false };
 
     // Helpers to deal with the fact that `rule` might be a CSSStyleRule or a CSSNestedDeclarations
@@ -164,6 +165,17 @@ public:
 
     [[nodiscard]] bool has_has_selectors() const { return m_has_has_selectors; }
 
+    // How well the rule cache buckets and the ancestor filter narrow down the rules that have to be matched.
+    struct RuleMatchingStatistics {
+        size_t candidate_rules { 0 };
+        size_t rejected_by_ancestor_filter { 0 };
+        size_t rejected_by_selector_matching { 0 };
+        size_t matched_rules { 0 };
+        size_t shared_styles { 0 };
+    };
+    RuleMatchingStatistics const& rule_matching_statistics() const { return m_rule_matching_statistics; }
+    void reset_rule_matching_statistics() { m_rule_matching_statistics = {}; }
+
 private:
     enum class ComputeStyleMode {
         Normal,
@@ -175,6 +187,12 @@ private:
     [[nodiscard]] bool should_reject_with_ancestor_filter(Selector const&) const;
 
     RefPtr<StyleProperties> compute_style_impl(DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, ComputeStyleMode) const;
+
+    // Siblings with the same tag name and attributes usually end up with the same style, in which case the style of
+    // a previous sibling can be reused instead of computing it again.
+    static constexpr size_t max_style_sharing_candidates = 8;
+    DOM::Element* find_element_to_share_style_with(DOM::Element&) const;
+    [[nodiscard]] bool state_dependent_rules_match_equally(DOM::Element const&, DOM::Element const&) const;
     void compute_cascaded_values(StyleProperties&, DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, bool& did_match_any_pseudo_element_rules, ComputeStyleMode) const;
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_ascending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_descending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
@@ -246,12 +264,25 @@ private:
     using FontLoaderList = Vector<NonnullOwnPtr<FontLoader>>;
     HashMap<FontFaceKey, FontLoaderList> m_loaded_fonts;
 
+    // The same fonts are looked up for most elements, so the results are kept until the set of loaded fonts changes.
+    struct FontMatchingCacheKey {
+        FontFaceKey face;
+        int width { 0 };
+        float font_size_in_pt { 0 };
+
+        [[nodiscard]] u32 hash() const { return pair_int_hash(face.hash(), pair_int_hash(width, bit_cast<u32>(font_size_in_pt))); }
+        [[nodiscard]] bool operator==(FontMatchingCacheKey const&) const = default;
+    };
+    mutable HashMap<FontMatchingCacheKey, RefPtr<Gfx::FontCascadeList const>> m_font_matching_cache;
+
     Length::FontMetrics m_default_font_metrics;
     Length::FontMetrics m_root_element_font_metrics;
 
     CSSPixelRect m_viewport_rect;
 
     CountingBloomFilter<u8, 14> m_ancestor_filter;
+
+    mutable RuleMatchingStatistics m_rule_matching_statistics;
 };
 
 class FontLoader : public ResourceClient {
@@ -471,6 +471,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_associated_inert_template_document);
     visitor.visit(m_appropriate_template_contents_owner_document);
     visitor.visit(m_pending_parsing_blocking_script);
+    visitor.visit(m_map_of_preloaded_resources);
     visitor.visit(m_history);
 
     visitor.visit(m_browsing_context);
@@ -1075,6 +1076,16 @@ URL::URL Document::parse_url(StringView url) const
 }
 
 void Document::set_needs_layout()
+{
+    // NOTE: Without knowing which part of the layout tree changed, nothing from the previous layout can be reused.
+    m_needs_full_layout = true;
+    if (m_needs_layout)
+        return;
+    m_needs_layout = true;
+    schedule_layout_update();
+}
+
+void Document::set_needs_layout(Badge<Layout::Node>)
 {
     if (m_needs_layout)
         return;
@@ -1164,6 +1175,13 @@ void Document::update_layout()
 
     Layout::LayoutState layout_state;
 
+    if (m_needs_full_layout) {
+        m_layout_root->for_each_in_inclusive_subtree_of_type<Layout::Box>([](auto& box) {
+            box.reset_cached_intrinsic_sizes();
+            return TraversalDecision::Continue;
+        });
+    }
+
     {
         Layout::BlockFormattingContext root_formatting_context(layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
 
@@ -1185,6 +1203,9 @@ void Document::update_layout()
 
     layout_state.commit(*m_layout_root);
 
+    m_layout_root->clear_needs_layout_in_subtree();
+    m_needs_full_layout = false;
+
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
     inform_all_viewport_clients_about_the_current_viewport_rect();
 
@@ -1284,13 +1305,19 @@ void Document::update_style()
     evaluate_media_rules();
 
     style_computer().reset_ancestor_filter();
+    style_computer().reset_rule_matching_statistics();
 
     auto invalidation = update_style_recursively(*this, style_computer());
+
+    if constexpr (LIBWEB_CSS_DEBUG) {
+        auto const& statistics = style_computer().rule_matching_statistics();
+        dbgln("Style update: {} candidate rules, {} rejected by the ancestor filter, {} rejected by selector matching, {} matched, {} styles shared",
+            statistics.candidate_rules, statistics.rejected_by_ancestor_filter, statistics.rejected_by_selector_matching, statistics.matched_rules, statistics.shared_styles);
+    }
     if (invalidation.rebuild_layout_tree) {
         invalidate_layout_tree();
     } else {
-        if (invalidation.relayout)
-            set_needs_layout();
+        // NOTE: Elements that need relayout have already marked their layout nodes as such.
         if (invalidation.rebuild_stacking_context_tree)
             invalidate_stacking_context_tree();
     }
@@ -1355,14 +1382,12 @@ void Document::set_inspected_node(Node* node, Optional<CSS::Selector::PseudoElem
     if (m_inspected_node.ptr() == node && m_inspected_pseudo_element == pseudo_element)
         return;
 
-    if (auto layout_node = inspected_layout_node(); layout_node && layout_node->paintable())
-        layout_node->paintable()->set_needs_display();
-
     m_inspected_node = node;
     m_inspected_pseudo_element = pseudo_element;
 
-    if (auto layout_node = inspected_layout_node(); layout_node && layout_node->paintable())
-        layout_node->paintable()->set_needs_display();
+    // NOTE: The inspector overlay paints outside of the inspected element, so everything is repainted.
+    if (auto navigable = this->navigable())
+        navigable->set_needs_display();
 }
 
 Layout::Node* Document::inspected_layout_node()
@@ -2961,6 +2986,10 @@ void Document::invalidate_stacking_context_tree()
 {
     if (auto* paintable_box = this->paintable_box())
         paintable_box->invalidate_stacking_context();
+
+    // NOTE: Changing the stacking context tree can change how anything is painted, not just the affected elements.
+    if (auto navigable = this->navigable())
+        navigable->set_needs_display();
 }
 
 void Document::check_favicon_after_loading_link_resource()
@@ -497,6 +497,7 @@ class PageTransitionEvent;
 class Path2D;
 class Plugin;
 class PluginArray;
+class PreloadEntry;
 class PromiseRejectionEvent;
 class RadioNodeList;
 class SelectedFile;
@@ -543,6 +544,7 @@ struct OpenerPolicy;
 struct OpenerPolicyEnforcementResult;
 struct PolicyContainer;
 struct POSTResource;
+struct PreloadKey;
 struct ScrollOptions;
 struct ScrollToOptions;
 struct SerializedFormData;
@@ -669,6 +671,7 @@ class AutoplayAllowlist;
 
 namespace Web::Platform {
 class AudioCodecPlugin;
+struct DecodedImage;
 class Timer;
 }
 
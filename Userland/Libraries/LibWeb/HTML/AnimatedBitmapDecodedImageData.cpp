@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <LibGfx/Bitmap.h>
+#include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/Heap.h>
 #include <LibJS/Runtime/Realm.h>
 #include <LibWeb/HTML/AnimatedBitmapDecodedImageData.h>
@@ -13,32 +15,132 @@ namespace Web::HTML {
 
 JS_DEFINE_ALLOCATOR(AnimatedBitmapDecodedImageData);
 
+// How many frames are requested from the image decoder at once.
+static constexpr size_t frames_to_decode_ahead = 8;
+
+// Animations whose decoded frames take up more memory than this only keep the frames around them.
+static constexpr size_t decoded_frames_memory_budget = 32 * MiB;
+
 ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create(JS::Realm& realm, Vector<Frame>&& frames, size_t loop_count, bool animated)
 {
     return realm.heap().allocate<AnimatedBitmapDecodedImageData>(realm, move(frames), loop_count, animated);
 }
 
-AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated)
+ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> AnimatedBitmapDecodedImageData::create_with_frames_decoded_on_demand(JS::Realm& realm, i64 image_id, Vector<Frame>&& decoded_frames, size_t frame_count, size_t loop_count)
+{
+    VERIFY(!decoded_frames.is_empty());
+    VERIFY(decoded_frames.size() <= frame_count);
+    TRY(decoded_frames.try_resize(frame_count));
+    return realm.heap().allocate<AnimatedBitmapDecodedImageData>(realm, move(decoded_frames), loop_count, true, image_id);
+}
+
+AnimatedBitmapDecodedImageData::AnimatedBitmapDecodedImageData(Vector<Frame>&& frames, size_t loop_count, bool animated, Optional<i64> image_id)
     : m_frames(move(frames))
     , m_loop_count(loop_count)
     , m_animated(animated)
+    , m_image_id(image_id)
 {
 }
 
 AnimatedBitmapDecodedImageData::~AnimatedBitmapDecodedImageData() = default;
 
+void AnimatedBitmapDecodedImageData::finalize()
+{
+    Base::finalize();
+    if (m_image_id.has_value())
+        Platform::ImageCodecPlugin::the().release_animated_image(*m_image_id);
+}
+
+// Until a frame has been decoded, the closest one before it stands in for it.
+static AnimatedBitmapDecodedImageData::Frame const& closest_decoded_frame(Vector<AnimatedBitmapDecodedImageData::Frame> const& frames, size_t frame_index)
+{
+    for (size_t i = frame_index + 1; i-- > 0;) {
+        if (frames[i].bitmap)
+            return frames[i];
+    }
+    return frames.first();
+}
+
 RefPtr<Gfx::ImmutableBitmap> AnimatedBitmapDecodedImageData::bitmap(size_t frame_index, Gfx::IntSize) const
 {
     if (frame_index >= m_frames.size())
         return nullptr;
-    return m_frames[frame_index].bitmap;
+    decode_frames_if_needed(frame_index);
+    return closest_decoded_frame(m_frames, frame_index).bitmap;
 }
 
 int AnimatedBitmapDecodedImageData::frame_duration(size_t frame_index) const
 {
     if (frame_index >= m_frames.size())
         return 0;
-    return m_frames[frame_index].duration;
+    return closest_decoded_frame(m_frames, frame_index).duration;
+}
+
+void AnimatedBitmapDecodedImageData::decode_frames_if_needed(size_t frame_index) const
+{
+    if (!m_image_id.has_value() || m_is_decoding_frames)
+        return;
+
+    // Look for the first missing frame among the ones that will be shown next, wrapping around for looping animations.
+    Optional<size_t> start_frame_index;
+    for (size_t i = 0; i < min(frames_to_decode_ahead, m_frames.size()); ++i) {
+        auto index = (frame_index + i) % m_frames.size();
+        if (!m_frames[index].bitmap) {
+            start_frame_index = index;
+            break;
+        }
+    }
+    if (!start_frame_index.has_value())
+        return;
+
+    size_t frame_count = 0;
+    while (*start_frame_index + frame_count < m_frames.size() && frame_count < frames_to_decode_ahead && !m_frames[*start_frame_index + frame_count].bitmap)
+        ++frame_count;
+
+    m_is_decoding_frames = true;
+    Platform::ImageCodecPlugin::the().request_animation_frames(*m_image_id, *start_frame_index, frame_count, [strong_this = JS::Handle { const_cast<AnimatedBitmapDecodedImageData&>(*this) }](u32 start_frame_index, Vector<Platform::Frame>& frames) {
+        strong_this->did_decode_frames(start_frame_index, frames);
+    });
+}
+
+void AnimatedBitmapDecodedImageData::did_decode_frames(u32 start_frame_index, Vector<Platform::Frame>& frames)
+{
+    m_is_decoding_frames = false;
+    if (!m_image_id.has_value())
+        return;
+
+    for (size_t i = 0; i < frames.size() && start_frame_index + i < m_frames.size(); ++i) {
+        auto& frame = frames[i];
+        auto index = start_frame_index + i;
+        if (frame.bitmap)
+            m_frames[index] = { Gfx::ImmutableBitmap::create(*frame.bitmap), static_cast<int>(frame.duration) };
+        else
+            m_frames[index] = closest_decoded_frame(m_frames, index);
+    }
+
+    // The frames we are not about to show are decoded again the next time around.
+    if (decoded_frames_size_in_bytes() > decoded_frames_memory_budget) {
+        for (size_t i = 1; i < m_frames.size(); ++i) {
+            if (i < start_frame_index || i >= start_frame_index + frames.size())
+                m_frames[i].bitmap = nullptr;
+        }
+    }
+
+    // Once every frame has been decoded, the image decoder doesn't have to hold on to the animation anymore.
+    if (all_of(m_frames, [](auto const& frame) { return frame.bitmap; })) {
+        Platform::ImageCodecPlugin::the().release_animated_image(*m_image_id);
+        m_image_id.clear();
+    }
+}
+
+size_t AnimatedBitmapDecodedImageData::decoded_frames_size_in_bytes() const
+{
+    size_t size = 0;
+    for (auto const& frame : m_frames) {
+        if (frame.bitmap)
+            size += frame.bitmap->bitmap().size_in_bytes();
+    }
+    return size;
 }
 
 Optional<CSSPixels> AnimatedBitmapDecodedImageData::intrinsic_width() const
@@ -8,6 +8,7 @@
 
 #include <LibGfx/ImmutableBitmap.h>
 #include <LibWeb/HTML/DecodedImageData.h>
+#include <LibWeb/Platform/ImageCodecPlugin.h>
 
 namespace Web::HTML {
 
@@ -22,6 +23,10 @@ public:
     };
 
     static ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> create(JS::Realm&, Vector<Frame>&&, size_t loop_count, bool animated);
+
+    // Only the first frames of the animation have been decoded, the others are requested from the image decoder
+    // shortly before they are needed.
+    static ErrorOr<JS::NonnullGCPtr<AnimatedBitmapDecodedImageData>> create_with_frames_decoded_on_demand(JS::Realm&, i64 image_id, Vector<Frame>&& decoded_frames, size_t frame_count, size_t loop_count);
     virtual ~AnimatedBitmapDecodedImageData() override;
 
     virtual RefPtr<Gfx::ImmutableBitmap> bitmap(size_t frame_index, Gfx::IntSize = {}) const override;
@@ -36,11 +41,22 @@ public:
     virtual Optional<CSSPixelFraction> intrinsic_aspect_ratio() const override;
 
 private:
-    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated);
+    AnimatedBitmapDecodedImageData(Vector<Frame>&&, size_t loop_count, bool animated, Optional<i64> image_id = {});
+
+    virtual void finalize() override;
 
+    void decode_frames_if_needed(size_t frame_index) const;
+    void did_decode_frames(u32 start_frame_index, Vector<Platform::Frame>&);
+    size_t decoded_frames_size_in_bytes() const;
+
+    // Frames that are decoded on demand have a null bitmap until they arrive.
     Vector<Frame> m_frames;
     size_t m_loop_count { 0 };
     bool m_animated { false };
+
+    // Set for as long as the image decoder holds on to the animation for us.
+    Optional<i64> m_image_id;
+    mutable bool m_is_decoding_frames { false };
 };
 
 }
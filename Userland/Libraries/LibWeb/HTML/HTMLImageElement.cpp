@@ -738,6 +738,27 @@ void HTMLImageElement::add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequ
                 dispatch_event(DOM::Event::create(realm(), HTML::EventNames::error));
 
             m_load_event_delayer.clear();
+        },
+        [this, image_request]() {
+            // If the resource type and data corresponds to a supported image format, set image request's state to
+            // partially available.
+            // AD-HOC: The partial image is only shown in place of the current request, which has nothing else to show.
+            //         A pending request only replaces the current one once it is completely available.
+            if (image_request != m_current_request || image_request->state() == ImageRequest::State::CompletelyAvailable)
+                return;
+
+            VERIFY(image_request->shared_resource_request());
+            bool const had_image_data = image_request->image_data();
+            image_request->set_image_data(image_request->shared_resource_request()->image_data());
+            image_request->set_state(ImageRequest::State::PartiallyAvailable);
+
+            // Only the first partial image can change the size of the element, the following ones just need a repaint.
+            if (!had_image_data) {
+                set_needs_style_update(true);
+                document().set_needs_layout();
+            } else if (paintable()) {
+                paintable()->set_needs_display();
+            }
         });
 }
 
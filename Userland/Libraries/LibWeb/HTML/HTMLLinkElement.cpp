@@ -543,7 +543,7 @@ static NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_favicon(
         return {};
     };
 
-    auto promise = Platform::ImageCodecPlugin::the().decode_image(favicon_data, move(on_successful_decode), move(on_failed_decode));
+    auto promise = Platform::ImageCodecPlugin::the().decode_image(favicon_data, Platform::FrameDecoding::FirstFrameOnly, move(on_successful_decode), move(on_failed_decode));
 
     return promise;
 }
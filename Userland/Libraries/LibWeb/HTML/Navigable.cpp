@@ -2068,9 +2068,19 @@ void Navigable::set_viewport_size(CSSPixelSize size)
 void Navigable::perform_scroll_of_viewport(CSSPixelPoint new_position)
 {
     if (m_viewport_scroll_offset != new_position) {
+        // NOTE: The scrollbars are painted at a fixed position in the viewport, so both their old and new location
+        //       have to be repainted when the rest of the previous frame is reused.
+        bool can_reuse_pixels = can_reuse_pixels_when_scrolling();
+        if (can_reuse_pixels)
+            set_needs_display_for_viewport_scrollbars();
+
         m_viewport_scroll_offset = new_position;
         scroll_offset_did_change();
-        set_needs_display();
+
+        if (can_reuse_pixels)
+            set_needs_display_for_viewport_scrollbars();
+        else
+            set_needs_display();
 
         if (auto document = active_document())
             document->inform_all_viewport_clients_about_the_current_viewport_rect();
@@ -2080,17 +2090,56 @@ void Navigable::perform_scroll_of_viewport(CSSPixelPoint new_position)
     HTML::main_thread_event_loop().schedule();
 }
 
+bool Navigable::can_reuse_pixels_when_scrolling()
+{
+    // NOTE: Only the top-level traversable paints into a backing store of its own.
+    if (!is_traversable())
+        return false;
+
+    auto document = active_document();
+    if (!document || !document->paintable())
+        return false;
+
+    // Anything that is positioned relative to the viewport does not move along with the content when scrolling.
+    bool can_reuse_pixels = true;
+    document->paintable()->for_each_in_inclusive_subtree([&](Painting::Paintable const& paintable) {
+        if (paintable.is_fixed_position() || paintable.computed_values().position() == CSS::Positioning::Sticky) {
+            can_reuse_pixels = false;
+            return TraversalDecision::Break;
+        }
+        for (auto const& layer : paintable.computed_values().background_layers()) {
+            if (layer.attachment == CSS::BackgroundAttachment::Fixed) {
+                can_reuse_pixels = false;
+                return TraversalDecision::Break;
+            }
+        }
+        return TraversalDecision::Continue;
+    });
+    return can_reuse_pixels;
+}
+
+void Navigable::set_needs_display_for_viewport_scrollbars()
+{
+    auto const& viewport_paintable = *active_document()->paintable();
+    for (auto direction : { Painting::PaintableBox::ScrollDirection::Horizontal, Painting::PaintableBox::ScrollDirection::Vertical }) {
+        if (auto thumb_rect = viewport_paintable.scroll_thumb_rect(direction); thumb_rect.has_value())
+            set_needs_display(thumb_rect->inflated(1, 1));
+    }
+}
+
 void Navigable::set_needs_display()
 {
+    m_needs_full_repaint = true;
     set_needs_display(viewport_rect());
 }
 
-void Navigable::set_needs_display(CSSPixelRect const&)
+void Navigable::set_needs_display(CSSPixelRect const& rect)
 {
     // FIXME: Ignore updates outside the visible viewport rect.
     //        This requires accounting for fixed-position elements in the input rect, which we don't do yet.
 
     m_needs_repaint = true;
+    m_damaged_rect = m_damaged_rect.united(rect);
 
     if (is<TraversableNavigable>(*this)) {
         // Schedule the main thread event loop, which will, in turn, schedule a repaint.
@@ -2102,6 +2151,13 @@ void Navigable::set_needs_display(CSSPixelRect const&)
         container()->paintable()->set_needs_display();
 }
 
+Optional<CSSPixelRect> Navigable::damaged_rect() const
+{
+    if (m_needs_full_repaint)
+        return {};
+    return m_damaged_rect;
+}
+
 // https://html.spec.whatwg.org/#rendering-opportunity
 bool Navigable::has_a_rendering_opportunity() const
 {
@@ -2197,6 +2253,8 @@ void Navigable::record_display_list(Painting::DisplayListRecorder& display_list_
     }
 
     m_needs_repaint = false;
+    m_needs_full_repaint = false;
+    m_damaged_rect = {};
 }
 
 // https://html.spec.whatwg.org/multipage/browsing-the-web.html#event-uni
@@ -184,6 +184,11 @@ public:
 
     [[nodiscard]] bool needs_repaint() const { return m_needs_repaint; }
 
+    // The part of the document that has changed since the last repaint, or an empty optional if the whole viewport
+    // needs to be repainted. Scrolling the viewport does not damage the content that moves along with it, so the
+    // pixels of the previous frame can be reused at their new position.
+    [[nodiscard]] Optional<CSSPixelRect> damaged_rect() const;
+
     struct PaintConfig {
         bool paint_overlay { false };
         bool should_show_line_box_borders { false };
@@ -216,6 +221,8 @@ private:
     void reset_cursor_blink_cycle();
 
     void scroll_offset_did_change();
+    [[nodiscard]] bool can_reuse_pixels_when_scrolling();
+    void set_needs_display_for_viewport_scrollbars();
 
     void inform_the_navigation_api_about_aborting_navigation();
 
@@ -250,6 +257,8 @@ private:
     CSSPixelPoint m_viewport_scroll_offset;
 
     bool m_needs_repaint { false };
+    bool m_needs_full_repaint { true };
+    CSSPixelRect m_damaged_rect;
 
     Web::EventHandler m_event_handler;
 };
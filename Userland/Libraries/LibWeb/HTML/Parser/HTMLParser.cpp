@@ -262,7 +262,11 @@ void HTMLParser::the_end(JS::NonnullGCPtr<DOM::Document> document, JS::GCPtr<HTM
     if (parser && parser->m_parsing_fragment)
         return;
 
-    // FIXME: 1. If the active speculative HTML parser is not null, then stop the speculative HTML parser and return.
+    // 1. If the active speculative HTML parser is not null, then stop the speculative HTML parser and return.
+    if (parser && parser->m_active_speculative_html_parser) {
+        parser->stop_the_speculative_html_parser();
+        return;
+    }
 
     // 2. Set the insertion point to undefined.
     if (parser)
@@ -2934,7 +2938,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    start_the_speculative_html_parser();
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -2953,7 +2958,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    stop_the_speculative_html_parser();
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -4918,13 +4924,60 @@ JS::Realm& HTMLParser::realm()
     return m_document->realm();
 }
 
+// https://html.spec.whatwg.org/multipage/parsing.html#start-the-speculative-html-parser
+void HTMLParser::start_the_speculative_html_parser()
+{
+    // 1. Optionally, return.
+    // NOTE: The speculative parser scans everything up to the end of the input in one go, so there is nothing new to
+    //       find the next time the parser gets blocked. Only running it once keeps documents with many blocking
+    //       scripts from being rescanned over and over.
+    if (m_has_started_speculative_html_parser)
+        return;
+    m_has_started_speculative_html_parser = true;
+
+    // 2. If parser's active speculative HTML parser is not null, then stop the speculative HTML parser for parser.
+    stop_the_speculative_html_parser();
+
+    // 3. Let speculativeParser be a new speculative HTML parser, with the same state as parser.
+    // NOTE: We only need the unparsed part of the input stream, the scanner does not build a tree.
+    auto speculative_parser = SpeculativeHTMLParser::create(*m_document, m_tokenizer.unparsed_input(), m_scripting_enabled);
+
+    // FIXME: 4. Let speculativeDoc be a new isomorphic representation of parser's Document, where all elements are instead
+    //           speculative mock elements. Let speculativeParser parse into speculativeDoc.
+
+    // 5. Set parser's active speculative HTML parser to speculativeParser.
+    m_active_speculative_html_parser = move(speculative_parser);
+
+    // 6. In parallel, run speculativeParser until it is stopped or until it reaches the end of its input stream.
+    // NOTE: We run it right away instead. Tokenizing is cheap compared to waiting on the network for the blocking script,
+    //       and the tokenizer relies on FlyString and other state that is not safe to touch off the main thread.
+    m_active_speculative_html_parser->run();
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#stop-the-speculative-html-parser
+void HTMLParser::stop_the_speculative_html_parser()
+{
+    // 1. Let speculativeParser be parser's active speculative HTML parser.
+    // 2. If speculativeParser is null, then return.
+    if (!m_active_speculative_html_parser)
+        return;
+
+    // 3. Throw away any pending content in speculativeParser's input stream, and discard any future content that would
+    //    have been added to it.
+    m_active_speculative_html_parser->stop();
+
+    // 4. Set parser's active speculative HTML parser to null.
+    m_active_speculative_html_parser = nullptr;
+}
+
 // https://html.spec.whatwg.org/multipage/parsing.html#abort-a-parser
 void HTMLParser::abort()
 {
     // 1. Throw away any pending content in the input stream, and discard any future content that would have been added to it.
     m_tokenizer.abort();
 
-    // FIXME: 2. Stop the speculative HTML parser for this HTML parser.
+    // 2. Stop the speculative HTML parser for this HTML parser.
+    stop_the_speculative_html_parser();
 
     // 3. Update the current document readiness to "interactive".
     m_document->update_readiness(DocumentReadyState::Interactive);
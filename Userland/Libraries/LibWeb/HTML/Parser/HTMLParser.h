@@ -11,6 +11,7 @@
 #include <LibWeb/DOM/Node.h>
 #include <LibWeb/HTML/Parser/HTMLTokenizer.h>
 #include <LibWeb/HTML/Parser/ListOfActiveFormattingElements.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
 #include <LibWeb/HTML/Parser/StackOfOpenElements.h>
 #include <LibWeb/MimeSniff/MimeType.h>
 
@@ -99,6 +100,9 @@ private:
 
     char const* insertion_mode_name() const;
 
+    void start_the_speculative_html_parser();
+    void stop_the_speculative_html_parser();
+
     DOM::QuirksMode which_quirks_mode(HTMLToken const&) const;
 
     void handle_initial(HTMLToken&);
@@ -187,6 +191,10 @@ private:
 
     HTMLTokenizer m_tokenizer;
 
+    // https://html.spec.whatwg.org/multipage/parsing.html#active-speculative-html-parser
+    OwnPtr<SpeculativeHTMLParser> m_active_speculative_html_parser;
+    bool m_has_started_speculative_html_parser { false };
+
     bool m_foster_parenting { false };
     bool m_frameset_ok { true };
     bool m_parsing_fragment { false };
@@ -130,6 +130,9 @@ public:
 
     ByteString source() const { return m_decoded_input; }
 
+    // The part of the input stream that the tokenizer has not consumed yet.
+    StringView unparsed_input() const { return m_decoded_input.substring_view(m_utf8_view.byte_offset_of(m_utf8_iterator)); }
+
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
     bool is_eof_inserted();
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/HTMLBaseElement.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
+#include <LibWeb/HTML/PotentialCORSRequest.h>
+#include <LibWeb/HTML/Preload.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/MathML/TagNames.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+#include <LibWeb/SVG/TagNames.h>
+
+namespace Web::HTML {
+
+NonnullOwnPtr<SpeculativeHTMLParser> SpeculativeHTMLParser::create(DOM::Document& document, StringView input, bool scripting_enabled)
+{
+    return adopt_own(*new SpeculativeHTMLParser(document, input, scripting_enabled));
+}
+
+SpeculativeHTMLParser::SpeculativeHTMLParser(DOM::Document& document, StringView input, bool scripting_enabled)
+    : m_document(document)
+    , m_tokenizer(input, "utf-8"sv)
+    , m_base_url(document.base_url())
+    , m_base_url_is_frozen(document.first_base_element_with_href_in_tree_order() != nullptr)
+    , m_scripting_enabled(scripting_enabled)
+{
+}
+
+static Optional<String> attribute_value(HTMLToken const& token, FlyString const& name)
+{
+    Optional<String> value;
+    token.for_each_attribute([&](auto const& attribute) {
+        if (attribute.local_name != name)
+            return IterationDecision::Continue;
+        value = attribute.value;
+        return IterationDecision::Break;
+    });
+    return value;
+}
+
+void SpeculativeHTMLParser::run()
+{
+    while (!m_stopped) {
+        auto token = m_tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+
+        if (token->is_start_tag())
+            process_start_tag(*token);
+        else if (token->is_end_tag())
+            process_end_tag(*token);
+    }
+}
+
+void SpeculativeHTMLParser::process_start_tag(HTMLToken const& token)
+{
+    auto const& tag_name = token.tag_name();
+
+    // NOTE: The tree builder is what normally switches the tokenizer into the text states, so we have to do it
+    //       ourselves to avoid scanning the contents of e.g. scripts and comments-in-style as markup.
+    if (tag_name == HTML::TagNames::script) {
+        m_tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+    } else if (tag_name.is_one_of(HTML::TagNames::style, HTML::TagNames::xmp, HTML::TagNames::iframe, HTML::TagNames::noembed, HTML::TagNames::noframes)
+        || (tag_name == HTML::TagNames::noscript && m_scripting_enabled)) {
+        m_tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+    } else if (tag_name.is_one_of(HTML::TagNames::textarea, HTML::TagNames::title)) {
+        m_tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+    } else if (tag_name == HTML::TagNames::plaintext) {
+        m_tokenizer.switch_to(HTMLTokenizer::State::PLAINTEXT);
+    }
+
+    if (tag_name == HTML::TagNames::template_) {
+        ++m_template_depth;
+        return;
+    }
+    if (tag_name.is_one_of(SVG::TagNames::svg, MathML::TagNames::math)) {
+        if (!token.is_self_closing())
+            ++m_foreign_content_depth;
+        return;
+    }
+    if (tag_name == HTML::TagNames::picture) {
+        ++m_picture_depth;
+        return;
+    }
+
+    // Nothing inside a template is fetched until it is instantiated, and scripts and images in foreign content are
+    // SVG/MathML elements that don't go through the HTML fetching algorithms.
+    if (m_template_depth > 0 || m_foreign_content_depth > 0)
+        return;
+
+    if (tag_name == HTML::TagNames::base) {
+        // https://html.spec.whatwg.org/multipage/semantics.html#set-the-frozen-base-url
+        // Only the first base element with an href attribute affects the document base URL.
+        if (m_base_url_is_frozen)
+            return;
+        auto href = attribute_value(token, HTML::AttributeNames::href);
+        if (!href.has_value())
+            return;
+        m_base_url_is_frozen = true;
+        auto url = m_document->fallback_base_url().complete_url(*href);
+        if (url.is_valid() && url.scheme() != "data"sv && url.scheme() != "javascript"sv)
+            m_base_url = move(url);
+        return;
+    }
+
+    auto integrity = attribute_value(token, HTML::AttributeNames::integrity).value_or({});
+    auto cors_setting = cors_setting_attribute_from_keyword(attribute_value(token, HTML::AttributeNames::crossorigin));
+
+    if (tag_name == HTML::TagNames::script) {
+        auto src = attribute_value(token, HTML::AttributeNames::src);
+        if (!src.has_value() || src->is_empty() || !m_scripting_enabled)
+            return;
+
+        // https://html.spec.whatwg.org/multipage/scripting.html#prepare-the-script-element
+        // Same script type determination as the script element itself does, but without the legacy language attribute.
+        auto type = attribute_value(token, HTML::AttributeNames::type);
+        auto script_block_type = type.has_value() ? MUST(type->trim(Infra::ASCII_WHITESPACE)) : "text/javascript"_string;
+        if (script_block_type.is_empty() || MimeSniff::is_javascript_mime_type_essence_match(script_block_type)) {
+            speculative_fetch(*src, Fetch::Infrastructure::Request::Destination::Script, cors_setting, integrity);
+            return;
+        }
+
+        if (script_block_type.equals_ignoring_ascii_case("module"sv)) {
+            // NOTE: Module scripts are always fetched in "cors" mode, and a missing crossorigin attribute means a
+            //       credentials mode of "same-origin", which is exactly what the Anonymous state maps to.
+            if (cors_setting == CORSSettingAttribute::NoCORS)
+                cors_setting = CORSSettingAttribute::Anonymous;
+            speculative_fetch(*src, Fetch::Infrastructure::Request::Destination::Script, cors_setting, integrity);
+        }
+        return;
+    }
+
+    if (tag_name == HTML::TagNames::link) {
+        auto rel = attribute_value(token, HTML::AttributeNames::rel);
+        auto href = attribute_value(token, HTML::AttributeNames::href);
+        if (!rel.has_value() || !href.has_value() || href->is_empty())
+            return;
+        if (attribute_value(token, HTML::AttributeNames::disabled).has_value())
+            return;
+
+        bool is_stylesheet = false;
+        bool is_alternate = false;
+        auto lowercased_rel = rel->to_ascii_lowercase();
+        for (auto part : lowercased_rel.bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace)) {
+            if (part == "stylesheet"sv)
+                is_stylesheet = true;
+            else if (part == "alternate"sv)
+                is_alternate = true;
+        }
+        if (is_stylesheet && !is_alternate)
+            speculative_fetch(*href, Fetch::Infrastructure::Request::Destination::Style, cors_setting, integrity);
+        return;
+    }
+
+    if (tag_name == HTML::TagNames::img) {
+        // NOTE: Picking a source out of srcset or a <picture> depends on layout and media queries, and lazy images are
+        //       deliberately not fetched until they are near the viewport.
+        if (m_picture_depth > 0 || attribute_value(token, HTML::AttributeNames::srcset).has_value())
+            return;
+        auto loading = attribute_value(token, HTML::AttributeNames::loading);
+        if (loading.has_value() && loading->equals_ignoring_ascii_case("lazy"sv) && m_scripting_enabled)
+            return;
+        auto src = attribute_value(token, HTML::AttributeNames::src);
+        if (!src.has_value() || src->is_empty())
+            return;
+        speculative_fetch(*src, Fetch::Infrastructure::Request::Destination::Image, cors_setting, {});
+    }
+}
+
+void SpeculativeHTMLParser::process_end_tag(HTMLToken const& token)
+{
+    auto const& tag_name = token.tag_name();
+    if (tag_name == HTML::TagNames::template_ && m_template_depth > 0)
+        --m_template_depth;
+    else if (tag_name.is_one_of(SVG::TagNames::svg, MathML::TagNames::math) && m_foreign_content_depth > 0)
+        --m_foreign_content_depth;
+    else if (tag_name == HTML::TagNames::picture && m_picture_depth > 0)
+        --m_picture_depth;
+}
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-fetch
+void SpeculativeHTMLParser::speculative_fetch(StringView href, Fetch::Infrastructure::Request::Destination destination, CORSSettingAttribute cors_setting, StringView integrity)
+{
+    auto url = m_base_url.complete_url(href);
+    if (!url.is_valid() || (url.scheme() != "http"sv && url.scheme() != "https"sv))
+        return;
+
+    auto& document = *m_document;
+
+    // NOTE: The body of an opaque response can't be handed over to the real request, so there is no point in
+    //       speculatively fetching cross-origin resources in "no-cors" mode.
+    if (cors_setting == CORSSettingAttribute::NoCORS && !url.origin().is_same_origin(document.origin()))
+        return;
+
+    dbgln_if(HTML_PARSER_DEBUG, "SpeculativeHTMLParser: Preloading {}", url);
+
+    auto request = create_potential_CORS_request(document.vm(), url, destination, cors_setting);
+    request->set_client(&document.relevant_settings_object());
+    request->set_integrity_metadata(MUST(String::from_utf8(integrity)));
+    request->set_initiator_type(Fetch::Infrastructure::Request::InitiatorType::Other);
+
+    preload(document, request);
+}
+
+}
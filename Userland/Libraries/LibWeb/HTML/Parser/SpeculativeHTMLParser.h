@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <LibJS/Heap/Handle.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/HTML/CORSSettingAttribute.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+// A lightweight preload scanner: it tokenizes the input that the HTML parser has not reached yet while the parser is
+// blocked on a script, and starts fetching the scripts, style sheets and images it finds so that they are ready (or
+// at least in flight) by the time the tree builder gets to them. No tree is built and no scripts are run.
+class SpeculativeHTMLParser {
+    AK_MAKE_NONCOPYABLE(SpeculativeHTMLParser);
+    AK_MAKE_NONMOVABLE(SpeculativeHTMLParser);
+
+public:
+    static NonnullOwnPtr<SpeculativeHTMLParser> create(DOM::Document&, StringView input, bool scripting_enabled);
+
+    // Tokenizes the input until the end, or until stop() is called.
+    void run();
+    void stop() { m_stopped = true; }
+
+private:
+    SpeculativeHTMLParser(DOM::Document&, StringView input, bool scripting_enabled);
+
+    void process_start_tag(HTMLToken const&);
+    void process_end_tag(HTMLToken const&);
+
+    void speculative_fetch(StringView url, Fetch::Infrastructure::Request::Destination, CORSSettingAttribute, StringView integrity);
+
+    JS::Handle<DOM::Document> m_document;
+    HTMLTokenizer m_tokenizer;
+    URL::URL m_base_url;
+    bool m_base_url_is_frozen { false };
+    bool m_scripting_enabled { true };
+    bool m_stopped { false };
+
+    // Resources inside these can not be fetched without knowing more about the tree.
+    size_t m_template_depth { 0 };
+    size_t m_foreign_content_depth { 0 };
+    size_t m_picture_depth { 0 };
+};
+
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/Fetch/Fetching/Fetching.h>
+#include <LibWeb/Fetch/Infrastructure/FetchAlgorithms.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
+#include <LibWeb/HTML/Preload.h>
+#include <LibWeb/HTML/Window.h>
+#include <LibWeb/SRI/SRI.h>
+
+namespace Web::HTML {
+
+JS_DEFINE_ALLOCATOR(PreloadEntry);
+
+JS::NonnullGCPtr<PreloadEntry> PreloadEntry::create(JS::VM& vm, String integrity_metadata)
+{
+    return vm.heap().allocate_without_realm<PreloadEntry>(move(integrity_metadata));
+}
+
+PreloadEntry::PreloadEntry(String integrity_metadata)
+    : m_integrity_metadata(move(integrity_metadata))
+{
+}
+
+void PreloadEntry::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_response);
+    visitor.visit(m_on_response_available);
+}
+
+// https://html.spec.whatwg.org/multipage/links.html#consume-a-preloaded-resource
+bool consume_a_preloaded_resource(Window& window, URL::URL const& url, Optional<Fetch::Infrastructure::Request::Destination> const& destination, Fetch::Infrastructure::Request::Mode mode, Fetch::Infrastructure::Request::CredentialsMode credentials_mode, StringView integrity_metadata, JS::NonnullGCPtr<PreloadEntry::OnResponseAvailable> on_response_available)
+{
+    // 1. Let key be a preload key whose URL is url, destination is destination, mode is mode, and credentials mode is credentialsMode.
+    PreloadKey key { url, destination, mode, credentials_mode };
+
+    // 2. Let preloads be window's associated Document's map of preloaded resources.
+    auto& preloads = window.associated_document().map_of_preloaded_resources();
+
+    // 3. If key does not exist in preloads, then return false.
+    auto it = preloads.find(key);
+    if (it == preloads.end())
+        return false;
+
+    // 4. Let entry be preloads[key].
+    auto entry = it->value;
+
+    // 5. Let consumerIntegrityMetadata be the result of parsing integrityMetadata.
+    auto consumer_integrity_metadata = SRI::parse_metadata(integrity_metadata);
+
+    // 6. Let preloadIntegrityMetadata be the result of parsing entry's integrity metadata.
+    auto preload_integrity_metadata = SRI::parse_metadata(entry->integrity_metadata());
+
+    // 7. If none of the following conditions apply:
+    //    - consumerIntegrityMetadata is no metadata;
+    //    - consumerIntegrityMetadata is equal to preloadIntegrityMetadata;
+    //    then return false.
+    if (consumer_integrity_metadata.is_error() || preload_integrity_metadata.is_error())
+        return false;
+    if (!consumer_integrity_metadata.value().is_empty() && consumer_integrity_metadata.value() != preload_integrity_metadata.value())
+        return false;
+
+    // 8. Remove preloads[key].
+    preloads.remove(it);
+
+    // 9. If entry's response is null, then set entry's on response available to onResponseAvailable.
+    if (!entry->response())
+        entry->set_on_response_available(on_response_available);
+    // 10. Otherwise, call onResponseAvailable with entry's response.
+    else
+        on_response_available->function()(*entry->response());
+
+    // 11. Return true.
+    return true;
+}
+
+// https://html.spec.whatwg.org/multipage/links.html#link-type-preload:fetch-and-process-the-linked-resource
+// NOTE: This is the part of the preload processing model that is shared by <link rel=preload> and the speculative HTML
+//       parser; the caller is responsible for creating the request.
+void preload(DOM::Document& document, JS::NonnullGCPtr<Fetch::Infrastructure::Request> request)
+{
+    auto& realm = document.realm();
+    auto& vm = realm.vm();
+
+    // Let key be a preload key whose URL is request's URL, destination is request's destination, mode is request's
+    // mode, and credentials mode is request's credentials mode.
+    PreloadKey key { request->url(), request->destination(), request->mode(), request->credentials_mode() };
+
+    // NOTE: A matching preload is already in flight, there is nothing more to do.
+    auto& preloads = document.map_of_preloaded_resources();
+    if (preloads.contains(key))
+        return;
+
+    // Let entry be a new preload entry whose integrity metadata is request's integrity metadata.
+    auto entry = PreloadEntry::create(vm, request->integrity_metadata());
+
+    // Fetch request, with processResponseConsumeBody set to the following steps given a response response and null,
+    // failure, or a byte sequence bodyBytes:
+    Fetch::Infrastructure::FetchAlgorithms::Input fetch_algorithms_input {};
+    fetch_algorithms_input.process_response_consume_body = [&realm, entry](JS::NonnullGCPtr<Fetch::Infrastructure::Response> response, Fetch::Infrastructure::FetchAlgorithms::BodyBytes body_bytes) {
+        // 1. If bodyBytes is a byte sequence, then set response's body to bodyBytes as a body.
+        if (auto* bytes = body_bytes.get_pointer<ByteBuffer>()) {
+            response->set_body(MUST(Fetch::Infrastructure::byte_sequence_as_body(realm, *bytes)));
+        }
+        // 2. Otherwise, set response to a network error.
+        else {
+            response = Fetch::Infrastructure::Response::network_error(realm.vm(), "Failed to read preloaded resource body"sv);
+        }
+
+        // 3. If entry's on response available is null, then set entry's response to response; otherwise call entry's
+        //    on response available given response.
+        if (!entry->on_response_available())
+            entry->set_response(response);
+        else
+            entry->on_response_available()->function()(response);
+    };
+
+    auto result = Fetch::Fetching::fetch(realm, request, Fetch::Infrastructure::FetchAlgorithms::create(vm, move(fetch_algorithms_input)));
+    if (result.is_error())
+        return;
+
+    // Set preloads[key] to entry.
+    preloads.set(move(key), entry);
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashFunctions.h>
+#include <AK/Traits.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibJS/Heap/GCPtr.h>
+#include <LibJS/Heap/HeapFunction.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+// https://html.spec.whatwg.org/multipage/links.html#preload-key
+struct PreloadKey {
+    // URL
+    //     A URL
+    URL::URL url;
+
+    // destination
+    //     A string
+    Optional<Fetch::Infrastructure::Request::Destination> destination;
+
+    // mode
+    //     A request mode, either "same-origin", "cors", or "no-cors"
+    Fetch::Infrastructure::Request::Mode mode;
+
+    // credentials mode
+    //     A credentials mode
+    Fetch::Infrastructure::Request::CredentialsMode credentials_mode;
+
+    bool operator==(PreloadKey const&) const = default;
+};
+
+// https://html.spec.whatwg.org/multipage/links.html#preload-entry
+class PreloadEntry final : public JS::Cell {
+    JS_CELL(PreloadEntry, JS::Cell);
+    JS_DECLARE_ALLOCATOR(PreloadEntry);
+
+public:
+    using OnResponseAvailable = JS::HeapFunction<void(JS::NonnullGCPtr<Fetch::Infrastructure::Response>)>;
+
+    [[nodiscard]] static JS::NonnullGCPtr<PreloadEntry> create(JS::VM&, String integrity_metadata);
+
+    [[nodiscard]] String const& integrity_metadata() const { return m_integrity_metadata; }
+
+    [[nodiscard]] JS::GCPtr<Fetch::Infrastructure::Response> response() const { return m_response; }
+    void set_response(JS::GCPtr<Fetch::Infrastructure::Response> response) { m_response = response; }
+
+    [[nodiscard]] JS::GCPtr<OnResponseAvailable> on_response_available() const { return m_on_response_available; }
+    void set_on_response_available(JS::GCPtr<OnResponseAvailable> on_response_available) { m_on_response_available = on_response_available; }
+
+private:
+    explicit PreloadEntry(String integrity_metadata);
+
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    // integrity metadata
+    //     A string
+    String m_integrity_metadata;
+
+    // response
+    //     Null or a response
+    JS::GCPtr<Fetch::Infrastructure::Response> m_response;
+
+    // on response available
+    //     Null, or an algorithm accepting a response or null
+    JS::GCPtr<OnResponseAvailable> m_on_response_available;
+};
+
+bool consume_a_preloaded_resource(Window&, URL::URL const&, Optional<Fetch::Infrastructure::Request::Destination> const&, Fetch::Infrastructure::Request::Mode, Fetch::Infrastructure::Request::CredentialsMode, StringView integrity_metadata, JS::NonnullGCPtr<PreloadEntry::OnResponseAvailable>);
+void preload(DOM::Document&, JS::NonnullGCPtr<Fetch::Infrastructure::Request>);
+
+}
+
+template<>
+struct AK::Traits<Web::HTML::PreloadKey> : public AK::DefaultTraits<Web::HTML::PreloadKey> {
+    static unsigned hash(Web::HTML::PreloadKey const& key)
+    {
+        auto hash = Traits<URL::URL>::hash(key.url);
+        hash = pair_int_hash(hash, key.destination.has_value() ? to_underlying(*key.destination) + 1 : 0);
+        hash = pair_int_hash(hash, to_underlying(key.mode));
+        return pair_int_hash(hash, to_underlying(key.credentials_mode));
+    }
+};
@@ -59,6 +59,7 @@ void SharedResourceRequest::visit_edges(JS::Cell::Visitor& visitor)
     for (auto& callback : m_callbacks) {
         visitor.visit(callback.on_finish);
         visitor.visit(callback.on_fail);
+        visitor.visit(callback.on_partial);
     }
     visitor.visit(m_image_data);
 }
@@ -86,24 +87,35 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, JS::NonnullGCPtr<Fe
         //        https://github.com/whatwg/html/issues/9355
         response = response->unsafe_response();
 
-        auto process_body = JS::create_heap_function(heap(), [this, request, response](ByteBuffer data) {
-            auto extracted_mime_type = response->header_list()->extract_mime_type();
-            auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence().bytes_as_string_view() : StringView {};
-            handle_successful_fetch(request->url(), mime_type, move(data));
-        });
-        auto process_body_error = JS::create_heap_function(heap(), [this](JS::Value) {
-            handle_failed_fetch();
-        });
-
         // Check for failed fetch response
         if (!Fetch::Infrastructure::is_ok_status(response->status()) || !response->body()) {
             handle_failed_fetch();
             return;
         }
 
-        response->body()->fully_read(realm, process_body, process_body_error, JS::NonnullGCPtr { realm.global_object() });
+        auto extracted_mime_type = response->header_list()->extract_mime_type();
+        auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence() : String {};
+        handle_response_body_start(request->url(), mime_type.bytes_as_string_view());
+
+        auto process_body_chunk = JS::create_heap_function(heap(), [this](ByteBuffer chunk) {
+            handle_response_body_chunk(move(chunk));
+        });
+        auto process_end_of_body = JS::create_heap_function(heap(), [this, request, mime_type] {
+            handle_response_end_of_body(request->url(), mime_type.bytes_as_string_view());
+        });
+        auto process_body_error = JS::create_heap_function(heap(), [this](JS::Value) {
+            if (m_incremental_decode_id.has_value())
+                Platform::ImageCodecPlugin::the().cancel_incremental_decode(m_incremental_decode_id.release_value());
+            handle_failed_fetch();
+        });
+
+        response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, JS::NonnullGCPtr { realm.global_object() });
     };
 
+    // AD-HOC: Images are decoded while their data is still arriving, so that they can be shown before all of it is
+    //         there. That only works if the response isn't buffered.
+    request->set_buffer_policy(Fetch::Infrastructure::Request::BufferPolicy::DoNotBufferResponse);
+
     m_state = State::Fetching;
 
     auto fetch_controller = Fetch::Fetching::fetch(
@@ -115,7 +127,7 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, JS::NonnullGCPtr<Fe
     set_fetch_controller(fetch_controller);
 }
 
-void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial)
 {
     if (m_state == State::Finished) {
         if (on_finish)
@@ -134,8 +146,78 @@ void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<v
         callbacks.on_finish = JS::create_heap_function(vm().heap(), move(on_finish));
     if (on_fail)
         callbacks.on_fail = JS::create_heap_function(vm().heap(), move(on_fail));
+    if (on_partial)
+        callbacks.on_partial = JS::create_heap_function(vm().heap(), move(on_partial));
 
     m_callbacks.append(move(callbacks));
+
+    // Late arrivals get to see the part of the image that has been decoded so far.
+    if (m_image_data && m_callbacks.last().on_partial)
+        m_callbacks.last().on_partial->function()();
+}
+
+void SharedResourceRequest::handle_response_body_start(URL::URL const& url, StringView mime_type)
+{
+    // AD-HOC: SVG images can only be parsed once they are complete, and neither can anything if the image decoder is
+    //         unavailable. Their data is collected in m_encoded_data instead.
+    bool const is_svg_image = mime_type == "image/svg+xml"sv || url.basename().ends_with(".svg"sv);
+    if (is_svg_image)
+        return;
+
+    m_incremental_decode_id = Platform::ImageCodecPlugin::the().begin_incremental_decode([strong_this = JS::Handle(*this)](NonnullRefPtr<Gfx::Bitmap> bitmap, u32) {
+        strong_this->handle_partial_image(move(bitmap));
+    });
+}
+
+void SharedResourceRequest::handle_response_body_chunk(ByteBuffer chunk)
+{
+    if (m_incremental_decode_id.has_value()) {
+        Platform::ImageCodecPlugin::the().append_incremental_data(*m_incremental_decode_id, chunk);
+        return;
+    }
+
+    if (m_encoded_data.try_append(chunk).is_error())
+        handle_failed_fetch();
+}
+
+void SharedResourceRequest::handle_response_end_of_body(URL::URL const& url, StringView mime_type)
+{
+    if (m_state != State::Fetching)
+        return;
+
+    if (!m_incremental_decode_id.has_value()) {
+        handle_successful_fetch(url, mime_type, move(m_encoded_data));
+        return;
+    }
+
+    auto handle_successful_bitmap_decode = [strong_this = JS::Handle(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
+        strong_this->handle_successful_bitmap_decode(result);
+        return {};
+    };
+
+    auto handle_failed_decode = [strong_this = JS::Handle(*this)](Error&) -> void {
+        strong_this->handle_failed_fetch();
+    };
+
+    (void)Platform::ImageCodecPlugin::the().finish_incremental_decode(m_incremental_decode_id.release_value(), Platform::FrameDecoding::OnDemand, move(handle_successful_bitmap_decode), move(handle_failed_decode));
+}
+
+void SharedResourceRequest::handle_partial_image(NonnullRefPtr<Gfx::Bitmap> bitmap)
+{
+    if (m_state != State::Fetching)
+        return;
+
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    frames.append({ .bitmap = Gfx::ImmutableBitmap::create(*bitmap), .duration = 0 });
+    auto image_data_or_error = AnimatedBitmapDecodedImageData::create(m_document->realm(), move(frames), 0, false);
+    if (image_data_or_error.is_error())
+        return;
+    m_image_data = image_data_or_error.release_value();
+
+    for (auto& callback : m_callbacks) {
+        if (callback.on_partial)
+            callback.on_partial->function()();
+    }
 }
 
 void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string, StringView mime_type, ByteBuffer data)
@@ -157,15 +239,7 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
     }
 
     auto handle_successful_bitmap_decode = [strong_this = JS::Handle(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
-        Vector<AnimatedBitmapDecodedImageData::Frame> frames;
-        for (auto& frame : result.frames) {
-            frames.append(AnimatedBitmapDecodedImageData::Frame {
-                .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap),
-                .duration = static_cast<int>(frame.duration),
-            });
-        }
-        strong_this->m_image_data = AnimatedBitmapDecodedImageData::create(strong_this->m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
-        strong_this->handle_successful_resource_load();
+        strong_this->handle_successful_bitmap_decode(result);
         return {};
     };
 
@@ -173,12 +247,30 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
         strong_this->handle_failed_fetch();
     };
 
-    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode));
+    (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), Web::Platform::FrameDecoding::OnDemand, move(handle_successful_bitmap_decode), move(handle_failed_decode));
+}
+
+void SharedResourceRequest::handle_successful_bitmap_decode(Platform::DecodedImage& result)
+{
+    Vector<AnimatedBitmapDecodedImageData::Frame> frames;
+    for (auto& frame : result.frames) {
+        frames.append(AnimatedBitmapDecodedImageData::Frame {
+            .bitmap = Gfx::ImmutableBitmap::create(*frame.bitmap),
+            .duration = static_cast<int>(frame.duration),
+        });
+    }
+    auto& realm = m_document->realm();
+    if (frames.size() < result.frame_count)
+        m_image_data = AnimatedBitmapDecodedImageData::create_with_frames_decoded_on_demand(realm, result.image_id, move(frames), result.frame_count, result.loop_count).release_value_but_fixme_should_propagate_errors();
+    else
+        m_image_data = AnimatedBitmapDecodedImageData::create(realm, move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
+    handle_successful_resource_load();
 }
 
 void SharedResourceRequest::handle_failed_fetch()
 {
     m_state = State::Failed;
+    m_image_data = nullptr;
     for (auto& callback : m_callbacks) {
         if (callback.on_fail)
             callback.on_fail->function()();
@@ -8,6 +8,7 @@
 
 #include <AK/Error.h>
 #include <AK/OwnPtr.h>
+#include <LibGfx/Forward.h>
 #include <LibGfx/Size.h>
 #include <LibJS/Heap/Handle.h>
 #include <LibJS/Heap/HeapFunction.h>
@@ -35,7 +36,9 @@ public:
 
     void fetch_resource(JS::Realm&, JS::NonnullGCPtr<Fetch::Infrastructure::Request>);
 
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    // on_partial is called whenever more of a bitmap image has been decoded while its data is still arriving. The
+    // partial image is then available from image_data().
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial = {});
 
     bool is_fetching() const;
     bool needs_fetching() const;
@@ -46,7 +49,12 @@ private:
     virtual void finalize() override;
     virtual void visit_edges(JS::Cell::Visitor&) override;
 
+    void handle_response_body_start(URL::URL const&, StringView mime_type);
+    void handle_response_body_chunk(ByteBuffer);
+    void handle_response_end_of_body(URL::URL const&, StringView mime_type);
     void handle_successful_fetch(URL::URL const&, StringView mime_type, ByteBuffer data);
+    void handle_partial_image(NonnullRefPtr<Gfx::Bitmap>);
+    void handle_successful_bitmap_decode(Platform::DecodedImage&);
     void handle_failed_fetch();
     void handle_successful_resource_load();
 
@@ -64,9 +72,14 @@ private:
     struct Callbacks {
         JS::GCPtr<JS::HeapFunction<void()>> on_finish;
         JS::GCPtr<JS::HeapFunction<void()>> on_fail;
+        JS::GCPtr<JS::HeapFunction<void()>> on_partial;
     };
     Vector<Callbacks> m_callbacks;
 
+    // Bitmap images are decoded while their data arrives, everything else is collected here until it is complete.
+    Optional<i64> m_incremental_decode_id;
+    ByteBuffer m_encoded_data;
+
     URL::URL m_url;
     JS::GCPtr<DecodedImageData> m_image_data;
     JS::GCPtr<Fetch::Infrastructure::FetchController> m_fetch_controller;
@@ -1380,8 +1380,18 @@ void TraversableNavigable::paint(DevicePixelRect const& content_rect, Gfx::Bitma
         }
 #endif
     } else {
-        Painting::DisplayListPlayerCPU player(target, display_list_player_type == DisplayListPlayerType::CPUWithExperimentalTransformSupport);
-        player.execute(display_list);
+        auto enable_affine_command_executor = display_list_player_type == DisplayListPlayerType::CPUWithExperimentalTransformSupport;
+        // NOTE: Backdrop filters read back what has been painted so far, which is only up to date inside the damage rects.
+        if (paint_options.damage_rects.is_empty() || display_list->has_backdrop_filters()) {
+            Painting::DisplayListPlayerCPU player(target, enable_affine_command_executor);
+            player.execute(display_list);
+            return;
+        }
+        // NOTE: Commands outside of the clip are skipped, so replaying the display list once per damage rect is cheap.
+        for (auto const& damage_rect : paint_options.damage_rects) {
+            Painting::DisplayListPlayerCPU player(target, enable_affine_command_executor, damage_rect.to_type<int>());
+            player.execute(display_list);
+        }
     }
 }
 
@@ -242,7 +242,7 @@ JS::NonnullGCPtr<JS::Promise> WindowOrWorkerGlobalScopeMixin::create_image_bitma
                     return {};
                 };
 
-                (void)Web::Platform::ImageCodecPlugin::the().decode_image(image_data, move(on_successful_decode), move(on_failed_decode));
+                (void)Web::Platform::ImageCodecPlugin::the().decode_image(image_data, Web::Platform::FrameDecoding::FirstFrameOnly, move(on_successful_decode), move(on_failed_decode));
             });
         },
         [&](auto&) {
@@ -60,6 +60,13 @@ bool Box::is_user_scrollable() const
     return computed_values().overflow_y() == CSS::Overflow::Scroll || computed_values().overflow_y() == CSS::Overflow::Auto;
 }
 
+IntrinsicSizes& Box::cached_intrinsic_sizes() const
+{
+    if (!m_cached_intrinsic_sizes)
+        m_cached_intrinsic_sizes = make<IntrinsicSizes>();
+    return *m_cached_intrinsic_sizes;
+}
+
 bool Box::is_body() const
 {
     return dom_node() && dom_node() == document().body();
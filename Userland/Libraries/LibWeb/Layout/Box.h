@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Rect.h>
 #include <LibJS/Heap/Cell.h>
@@ -18,6 +19,17 @@ struct LineBoxFragmentCoordinate {
     size_t fragment_index { 0 };
 };
 
+// Intrinsic sizes only depend on the contents of a box, so they are kept across layouts until the box or one of its
+// descendants needs layout. This avoids computing them several times while performing flex and grid layout.
+struct IntrinsicSizes {
+    Optional<CSSPixels> min_content_width;
+    Optional<CSSPixels> max_content_width;
+
+    // Keyed by the available width.
+    HashMap<CSSPixels, Optional<CSSPixels>> min_content_height;
+    HashMap<CSSPixels, Optional<CSSPixels>> max_content_height;
+};
+
 class Box : public NodeWithStyleAndBoxModelMetrics {
     JS_CELL(Box, NodeWithStyleAndBoxModelMetrics);
 
@@ -54,6 +66,9 @@ public:
 
     bool is_user_scrollable() const;
 
+    IntrinsicSizes& cached_intrinsic_sizes() const;
+    void reset_cached_intrinsic_sizes() const { m_cached_intrinsic_sizes = nullptr; }
+
 protected:
     Box(DOM::Document&, DOM::Node*, NonnullRefPtr<CSS::StyleProperties>);
     Box(DOM::Document&, DOM::Node*, NonnullOwnPtr<CSS::ComputedValues>);
@@ -64,6 +79,8 @@ private:
     Optional<CSSPixels> m_natural_width;
     Optional<CSSPixels> m_natural_height;
     Optional<CSSPixelFraction> m_natural_aspect_ratio;
+
+    mutable OwnPtr<IntrinsicSizes> m_cached_intrinsic_sizes;
 };
 
 template<>
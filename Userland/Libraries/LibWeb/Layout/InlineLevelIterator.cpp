@@ -239,14 +239,10 @@ Optional<InlineLevelIterator::Item> InlineLevelIterator::next_without_lookahead(
             };
         }
 
-        Vector<Gfx::DrawGlyphOrEmoji> glyph_run;
-        float glyph_run_width = 0;
-        Gfx::for_each_glyph_position(
-            { 0, 0 }, chunk.view, chunk.font, [&](Gfx::DrawGlyphOrEmoji const& glyph_or_emoji) {
-                glyph_run.append(glyph_or_emoji);
-                return IterationDecision::Continue;
-            },
-            Gfx::IncludeLeftBearing::No, glyph_run_width);
+        // NOTE: The glyphs are copied, since line boxes reposition the glyphs of the runs they're given.
+        auto const& cached_glyph_run = Gfx::GlyphRunCache::the().glyphs_for(chunk.view, chunk.font);
+        Vector<Gfx::DrawGlyphOrEmoji> glyph_run = cached_glyph_run.glyphs;
+        float glyph_run_width = cached_glyph_run.width;
 
         if (!m_text_node_context->is_last_chunk)
             glyph_run_width += text_node.first_available_font().glyph_spacing();
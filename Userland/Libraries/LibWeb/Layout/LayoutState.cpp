@@ -29,46 +29,68 @@ LayoutState::~LayoutState()
 {
 }
 
+LayoutState::UsedValues* LayoutState::find_used_values(NodeWithStyle const& node) const
+{
+    auto index = node.layout_index();
+    if (index < m_first_layout_index || index - m_first_layout_index >= m_used_values_by_layout_index.size())
+        return nullptr;
+    return m_used_values_by_layout_index[index - m_first_layout_index];
+}
+
+LayoutState::UsedValues& LayoutState::add_used_values(UsedValues&& new_used_values)
+{
+    auto index = new_used_values.node().layout_index();
+    if (m_used_values_by_layout_index.is_empty()) {
+        m_first_layout_index = index;
+    } else if (index < m_first_layout_index) {
+        // Grow the table downwards.
+        Vector<UsedValues*> table;
+        table.resize(m_first_layout_index - index);
+        table.extend(move(m_used_values_by_layout_index));
+        m_used_values_by_layout_index = move(table);
+        m_first_layout_index = index;
+    }
+    if (index - m_first_layout_index >= m_used_values_by_layout_index.size())
+        m_used_values_by_layout_index.resize(index - m_first_layout_index + 1);
+
+    m_used_values.append(move(new_used_values));
+    auto& stored_used_values = m_used_values[m_used_values.size() - 1];
+    m_used_values_by_layout_index[index - m_first_layout_index] = &stored_used_values;
+    return stored_used_values;
+}
+
 LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
 {
-    if (auto* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
+    if (auto* used_values = find_used_values(node))
         return *used_values;
 
     for (auto const* ancestor = m_parent; ancestor; ancestor = ancestor->m_parent) {
-        if (auto* ancestor_used_values = ancestor->used_values_per_layout_node.get(node).value_or(nullptr)) {
-            auto cow_used_values = adopt_own(*new UsedValues(*ancestor_used_values));
-            auto* cow_used_values_ptr = cow_used_values.ptr();
-            used_values_per_layout_node.set(node, move(cow_used_values));
-            return *cow_used_values_ptr;
-        }
+        if (auto* ancestor_used_values = ancestor->find_used_values(node))
+            return add_used_values(UsedValues(*ancestor_used_values));
     }
 
     auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
 
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    UsedValues new_used_values;
+    new_used_values.set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
+    return add_used_values(move(new_used_values));
 }
 
 LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
 {
-    if (auto const* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
+    if (auto const* used_values = find_used_values(node))
         return *used_values;
 
     for (auto const* ancestor = m_parent; ancestor; ancestor = ancestor->m_parent) {
-        if (auto const* ancestor_used_values = ancestor->used_values_per_layout_node.get(node).value_or(nullptr))
+        if (auto const* ancestor_used_values = ancestor->find_used_values(node))
             return *ancestor_used_values;
     }
 
     auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
 
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    const_cast<LayoutState*>(this)->used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    UsedValues new_used_values;
+    new_used_values.set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
+    return const_cast<LayoutState*>(this)->add_used_values(move(new_used_values));
 }
 
 // https://www.w3.org/TR/css-overflow-3/#scrollable-overflow
@@ -161,8 +183,7 @@ void LayoutState::resolve_relative_positions()
 {
     // This function resolves relative position offsets of fragments that belong to inline paintables.
     // It runs *after* the paint tree has been constructed, so it modifies paintable node & fragment offsets directly.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         auto* paintable = node.paintable();
@@ -233,8 +254,7 @@ void LayoutState::commit(Box& root)
 
     Vector<Painting::PaintableWithLines&> paintables_with_lines;
 
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         if (is<NodeWithStyleAndBoxModelMetrics>(node)) {
@@ -286,8 +306,7 @@ void LayoutState::commit(Box& root)
     // Resolve relative positions for regular boxes (not line box fragments):
     // NOTE: This needs to occur before fragments are transferred into the corresponding inline paintables, because
     //       after this transfer, the containing_line_box_fragment will no longer be valid.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         if (!node.is_box())
@@ -365,8 +384,7 @@ void LayoutState::commit(Box& root)
     resolve_relative_positions();
 
     // Measure overflow in scroll containers.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for (auto& used_values : m_used_values) {
         if (!used_values.node().is_box())
             continue;
         auto const& box = static_cast<Layout::Box const&>(used_values.node());
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/SegmentedVector.h>
 #include <LibGfx/Point.h>
 #include <LibWeb/Layout/Box.h>
 #include <LibWeb/Layout/LineBox.h>
@@ -176,25 +177,22 @@ struct LayoutState {
     // NOTE: get() will not CoW the UsedValues.
     UsedValues const& get(NodeWithStyle const&) const;
 
-    HashMap<JS::NonnullGCPtr<Layout::Node const>, NonnullOwnPtr<UsedValues>> used_values_per_layout_node;
-
-    // We cache intrinsic sizes once determined, as they will not change over the course of a full layout.
-    // This avoids computing them several times while performing flex layout.
-    struct IntrinsicSizes {
-        Optional<CSSPixels> min_content_width;
-        Optional<CSSPixels> max_content_width;
-
-        HashMap<CSSPixels, Optional<CSSPixels>> min_content_height;
-        HashMap<CSSPixels, Optional<CSSPixels>> max_content_height;
-    };
-
-    HashMap<JS::GCPtr<NodeWithStyle const>, NonnullOwnPtr<IntrinsicSizes>> mutable intrinsic_sizes;
-
     LayoutState const* m_parent { nullptr };
     LayoutState const& m_root;
 
 private:
     void resolve_relative_positions();
+
+    UsedValues* find_used_values(NodeWithStyle const&) const;
+    UsedValues& add_used_values(UsedValues&&);
+
+    // Used values live in segments that are never reallocated, so references to them stay valid as more are added.
+    SegmentedVector<UsedValues, 16> m_used_values;
+
+    // Maps layout indices to used values in this state. Nested states only cover the range of indices they have
+    // touched, which is usually a single subtree.
+    Vector<UsedValues*> m_used_values_by_layout_index;
+    size_t m_first_layout_index { 0 };
 };
 
 }
@@ -41,6 +41,7 @@ Node::Node(DOM::Document& document, DOM::Node* node)
     : m_dom_node(node ? *node : document)
     , m_browsing_context(*document.browsing_context())
     , m_anonymous(node == nullptr)
+    , m_layout_index(document.allocate_layout_node_index({}))
 {
     if (node)
         node->set_layout_node({}, *this);
@@ -48,6 +49,45 @@ Node::Node(DOM::Document& document, DOM::Node* node)
 
 Node::~Node() = default;
 
+void Node::set_needs_layout()
+{
+    if (m_needs_layout)
+        return;
+    m_needs_layout = true;
+
+    if (is<Box>(*this))
+        static_cast<Box const&>(*this).reset_cached_intrinsic_sizes();
+
+    // NOTE: Children can depend on the definite sizes they are given by this node, so forget their sizes as well.
+    for_each_child_of_type<Box>([](Box const& child) {
+        child.reset_cached_intrinsic_sizes();
+        return IterationDecision::Continue;
+    });
+
+    for (auto* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
+        if (is<Box>(*ancestor))
+            static_cast<Box const&>(*ancestor).reset_cached_intrinsic_sizes();
+        // NOTE: If this ancestor was already marked, the ones above it have been invalidated as well.
+        if (ancestor->m_child_needs_layout)
+            break;
+        ancestor->m_child_needs_layout = true;
+    }
+
+    document().set_needs_layout({});
+}
+
+void Node::clear_needs_layout_in_subtree()
+{
+    if (!m_needs_layout && !m_child_needs_layout)
+        return;
+    m_needs_layout = false;
+    m_child_needs_layout = false;
+    for_each_child([](Node& child) {
+        child.clear_needs_layout_in_subtree();
+        return IterationDecision::Continue;
+    });
+}
+
 void Node::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
@@ -83,6 +83,16 @@ public:
 
     bool is_root_element() const;
 
+    // Layout nodes of a document are numbered in creation order, so per-node layout data can be kept in dense tables.
+    size_t layout_index() const { return m_layout_index; }
+
+    // Layout invalidation: a node whose layout is dirty also dirties the intrinsic sizes of all of its ancestors,
+    // since those depend on their contents. Intrinsic sizes of clean subtrees are kept across layouts.
+    bool needs_layout() const { return m_needs_layout; }
+    bool child_needs_layout() const { return m_child_needs_layout; }
+    void set_needs_layout();
+    void clear_needs_layout_in_subtree();
+
     String debug_description() const;
 
     bool has_style() const { return m_has_style; }
@@ -194,9 +204,14 @@ private:
     bool m_is_flex_item { false };
     bool m_is_grid_item { false };
 
+    bool m_needs_layout { false };
+    bool m_child_needs_layout { false };
+
     GeneratedFor m_generated_for { GeneratedFor::NotGenerated };
 
     u32 m_initial_quote_nesting_level { 0 };
+
+    size_t m_layout_index { 0 };
 };
 
 class NodeWithStyle : public Node {
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
 #include <AK/NumberFormat.h>
 #include <AK/QuickSort.h>
 #include <AK/SourceGenerator.h>
@@ -98,4 +100,38 @@ ErrorOr<String> load_about_version_page()
     return TRY(String::from_utf8(generator.as_string_view()));
 }
 
+ErrorOr<String> load_about_cache_page(StringView disk_cache_statistics)
+{
+    auto statistics = JsonValue::from_string(disk_cache_statistics);
+    auto is_enabled = !statistics.is_error() && statistics.value().is_object();
+    auto get = [&](StringView key) -> u64 {
+        if (!is_enabled)
+            return 0;
+        return statistics.value().as_object().get_u64(key).value_or(0);
+    };
+
+    auto hits = get("hits"sv);
+    auto misses = get("misses"sv);
+    auto revalidations = get("revalidations"sv);
+    auto lookups = hits + misses + revalidations;
+
+    // Generate HTML about cache page from template file
+    // FIXME: Use an actual templating engine (our own one when it's built, preferably with a way to check these usages at compile time)
+    auto template_file = TRY(Core::Resource::load_from_uri("resource://ladybird/templates/cache.html"sv));
+    StringBuilder builder;
+    SourceGenerator generator { builder, '%', '%' };
+    generator.set("status", is_enabled ? "Enabled"_string : "Disabled"_string);
+    generator.set("hits", ByteString::number(hits));
+    generator.set("misses", ByteString::number(misses));
+    generator.set("revalidations", ByteString::number(revalidations));
+    generator.set("hit_rate", lookups == 0 ? ByteString { "-"sv } : ByteString::formatted("{:.1}%", 100.0 * (hits + revalidations) / lookups));
+    generator.set("stores", ByteString::number(get("stores"sv)));
+    generator.set("evictions", ByteString::number(get("evictions"sv)));
+    generator.set("entry_count", ByteString::number(get("entry_count"sv)));
+    generator.set("total_size", human_readable_size(get("total_size"sv)));
+    generator.set("maximum_size", human_readable_size(get("maximum_size"sv)));
+    generator.append(template_file->data());
+    return TRY(String::from_utf8(generator.as_string_view()));
+}
+
 }
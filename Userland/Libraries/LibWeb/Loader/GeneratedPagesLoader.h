@@ -23,4 +23,6 @@ ErrorOr<String> load_file_directory_page(URL::URL const&);
 
 ErrorOr<String> load_about_version_page();
 
+ErrorOr<String> load_about_cache_page(StringView disk_cache_statistics);
+
 }
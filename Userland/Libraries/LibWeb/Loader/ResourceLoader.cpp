@@ -274,6 +274,12 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
             return;
         }
 
+        // About cache page
+        if (url.path_segment_at_index(0) == "cache") {
+            success_callback(MUST(load_about_cache_page(m_connector->disk_cache_statistics())).bytes(), response_headers, {});
+            return;
+        }
+
         // Other about static HTML pages
         auto resource = Core::Resource::load_from_uri(MUST(String::formatted("resource://ladybird/{}.html", url.path_segment_at_index(0))));
         if (!resource.is_error()) {
@@ -286,6 +286,9 @@ struct PaintOptions {
     bool should_show_line_box_borders { false };
     bool has_focus { false };
 
+    // If not empty, the target already contains the previous frame, and only these parts of it need to be repainted.
+    Vector<DevicePixelRect, 2> damage_rects;
+
 #ifdef HAS_ACCELERATED_GRAPHICS
     AccelGfx::Context* accelerated_graphics_context { nullptr };
 #endif
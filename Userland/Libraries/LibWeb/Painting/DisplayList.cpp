@@ -10,6 +10,8 @@ namespace Web::Painting {
 
 void DisplayList::append(Command&& command, Optional<i32> scroll_frame_id)
 {
+    if (command.has<ApplyBackdropFilter>())
+        m_has_backdrop_filters = true;
     m_commands.append({ scroll_frame_id, move(command) });
 }
 
@@ -101,6 +101,8 @@ public:
     void apply_scroll_offsets(Vector<Gfx::IntPoint> const& offsets_by_frame_id);
     void mark_unnecessary_commands();
 
+    bool has_backdrop_filters() const { return m_has_backdrop_filters; }
+
     size_t corner_clip_max_depth() const { return m_corner_clip_max_depth; }
     void set_corner_clip_max_depth(size_t depth) { m_corner_clip_max_depth = depth; }
 
@@ -116,6 +118,7 @@ private:
     DisplayList() = default;
 
     size_t m_corner_clip_max_depth { 0 };
+    bool m_has_backdrop_filters { false };
     AK::SegmentedVector<CommandListItem, 512> m_commands;
 };
 
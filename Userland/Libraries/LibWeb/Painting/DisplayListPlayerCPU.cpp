@@ -15,7 +15,7 @@
 
 namespace Web::Painting {
 
-DisplayListPlayerCPU::DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affine_command_executor)
+DisplayListPlayerCPU::DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affine_command_executor, Optional<Gfx::IntRect> damage_rect)
     : m_target_bitmap(bitmap)
     , m_enable_affine_command_executor(enable_affine_command_executor)
 {
@@ -23,6 +23,10 @@ DisplayListPlayerCPU::DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affi
         .opacity = 1.0f,
         .destination = {},
         .scaling_mode = {} });
+
+    // NOTE: Commands entirely outside of the damage rect are skipped, since they would be fully clipped.
+    if (damage_rect.has_value())
+        painter().set_clip_origin(*damage_rect);
 }
 
 DisplayListPlayerCPU::~DisplayListPlayerCPU() = default;
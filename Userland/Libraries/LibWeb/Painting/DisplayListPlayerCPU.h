@@ -15,7 +15,8 @@ namespace Web::Painting {
 
 class DisplayListPlayerCPU : public DisplayListPlayer {
 public:
-    DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affine_command_executor = false);
+    // If a damage rect is given, only that part of the bitmap is repainted, and the rest keeps its current contents.
+    DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affine_command_executor = false, Optional<Gfx::IntRect> damage_rect = {});
 
     ~DisplayListPlayerCPU();
 
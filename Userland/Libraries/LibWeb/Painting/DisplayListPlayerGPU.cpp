@@ -4,8 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibAccelGfx/GlyphAtlas.h>
+#include <LibGfx/Font/FontDatabase.h>
+#include <LibGfx/Painter.h>
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
+#include <LibWeb/Painting/DisplayListPlayerCPU.h>
 #include <LibWeb/Painting/DisplayListPlayerGPU.h>
 
 namespace Web::Painting {
@@ -22,15 +26,73 @@ DisplayListPlayerGPU::DisplayListPlayerGPU(AccelGfx::Context& context, Gfx::Bitm
         .opacity = 1.0f,
         .destination = {},
         .transform = {} });
+    AccelGfx::GL::reset_draw_call_count();
 }
 
 DisplayListPlayerGPU::~DisplayListPlayerGPU()
 {
     m_context.activate();
     VERIFY(m_stacking_contexts.size() == 1);
+    if constexpr (LIBWEB_GPU_PAINTING_DEBUG)
+        paint_stats_overlay();
     painter().flush(m_target_bitmap);
 }
 
+template<typename CommandType>
+CommandResult DisplayListPlayerGPU::execute_on_cpu(CommandType const& command, Gfx::IntRect bounding_rect)
+{
+    auto translation = painter().transform().translation().to_type<int>();
+    auto rect = bounding_rect.intersected(painter().clip_rect().translated(-translation));
+    if (rect.is_empty())
+        return CommandResult::Continue;
+
+    auto bitmap_or_error = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, rect.size());
+    if (bitmap_or_error.is_error()) {
+        dbgln("Failed to allocate a bitmap of size {} to paint a command on the CPU", rect.size());
+        m_skipped_command_count++;
+        return CommandResult::Continue;
+    }
+    auto bitmap = bitmap_or_error.release_value();
+
+    // NOTE: The command is wrapped in a stacking context that moves it into the bitmap, since nested display lists
+    //       (like text clips) are positioned in the same coordinate space as the command itself.
+    auto display_list = DisplayList::create();
+    display_list->append(PushStackingContext {
+                             .opacity = 1.0f,
+                             .is_fixed_position = false,
+                             .source_paintable_rect = rect,
+                             .post_transform_translation = -rect.location(),
+                             .image_rendering = CSS::ImageRendering::Auto,
+                             .transform = { .origin = {}, .matrix = Gfx::FloatMatrix4x4::identity() },
+                         },
+        {});
+    display_list->append(CommandType { command }, {});
+    display_list->append(PopStackingContext {}, {});
+
+    DisplayListPlayerCPU cpu_player(*bitmap);
+    cpu_player.execute(*display_list);
+
+    painter().draw_scaled_bitmap(rect, *bitmap, bitmap->rect());
+    m_cpu_fallback_count++;
+    return CommandResult::Continue;
+}
+
+void DisplayListPlayerGPU::paint_stats_overlay()
+{
+    auto text = ByteString::formatted("{} draw calls, {} painted on CPU, {} skipped", AccelGfx::GL::draw_call_count(), m_cpu_fallback_count, m_skipped_command_count);
+    auto const& font = Gfx::FontDatabase::default_font();
+    Gfx::IntRect rect { 0, 0, font.width_rounded_up(text) + 8, font.pixel_size_rounded_up() + 8 };
+
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, rect.size()));
+    Gfx::Painter cpu_painter(*bitmap);
+    cpu_painter.fill_rect(rect, Color(0, 0, 0, 180));
+    cpu_painter.draw_text(rect, text, font, Gfx::TextAlignment::Center, Color::White);
+
+    painter().clear_clip_rect();
+    painter().set_transform({});
+    painter().draw_scaled_bitmap(rect, *bitmap, rect);
+}
+
 CommandResult DisplayListPlayerGPU::draw_glyph_run(DrawGlyphRun const& command)
 {
     Vector<Gfx::DrawGlyphOrEmoji> transformed_glyph_run;
@@ -51,7 +113,8 @@ CommandResult DisplayListPlayerGPU::draw_glyph_run(DrawGlyphRun const& command)
 
 CommandResult DisplayListPlayerGPU::fill_rect(FillRect const& command)
 {
-    // FIXME: Support clip paths
+    if (command.text_clip)
+        return execute_on_cpu(command, command.rect);
     painter().fill_rect(command.rect, command.color);
     return CommandResult::Continue;
 }
@@ -60,10 +123,11 @@ static AccelGfx::Painter::ScalingMode to_accelgfx_scaling_mode(Gfx::ScalingMode
 {
     switch (scaling_mode) {
     case Gfx::ScalingMode::NearestNeighbor:
-    case Gfx::ScalingMode::BoxSampling:
-    case Gfx::ScalingMode::SmoothPixels:
     case Gfx::ScalingMode::None:
         return AccelGfx::Painter::ScalingMode::NearestNeighbor;
+    // NOTE: Bilinear filtering is the closest the GPU painter gets to these.
+    case Gfx::ScalingMode::BoxSampling:
+    case Gfx::ScalingMode::SmoothPixels:
     case Gfx::ScalingMode::BilinearBlend:
         return AccelGfx::Painter::ScalingMode::Bilinear;
     default:
@@ -160,22 +224,22 @@ CommandResult DisplayListPlayerGPU::pop_stacking_context(PopStackingContext cons
 
 CommandResult DisplayListPlayerGPU::paint_linear_gradient(PaintLinearGradient const& command)
 {
-    // FIXME: Support clip paths
+    // NOTE: AccelGfx::Painter can only paint unclipped, non-repeating gradients that go from left to right.
     auto const& linear_gradient_data = command.linear_gradient_data;
+    if (command.text_clip || linear_gradient_data.gradient_angle != 90.0f || linear_gradient_data.color_stops.repeat_length.has_value())
+        return execute_on_cpu(command, command.gradient_rect);
     painter().fill_rect_with_linear_gradient(command.gradient_rect, linear_gradient_data.color_stops.list, linear_gradient_data.gradient_angle, linear_gradient_data.color_stops.repeat_length);
     return CommandResult::Continue;
 }
 
-CommandResult DisplayListPlayerGPU::paint_outer_box_shadow(PaintOuterBoxShadow const&)
+CommandResult DisplayListPlayerGPU::paint_outer_box_shadow(PaintOuterBoxShadow const& command)
 {
-    // FIXME
-    return CommandResult::Continue;
+    return execute_on_cpu(command, command.bounding_rect());
 }
 
-CommandResult DisplayListPlayerGPU::paint_inner_box_shadow(PaintInnerBoxShadow const&)
+CommandResult DisplayListPlayerGPU::paint_inner_box_shadow(PaintInnerBoxShadow const& command)
 {
-    // FIXME
-    return CommandResult::Continue;
+    return execute_on_cpu(command, command.bounding_rect());
 }
 
 CommandResult DisplayListPlayerGPU::paint_text_shadow(PaintTextShadow const& command)
@@ -203,7 +267,8 @@ CommandResult DisplayListPlayerGPU::paint_text_shadow(PaintTextShadow const& com
 
 CommandResult DisplayListPlayerGPU::fill_rect_with_rounded_corners(FillRectWithRoundedCorners const& command)
 {
-    // FIXME: Support clip paths
+    if (command.text_clip)
+        return execute_on_cpu(command, command.rect);
     painter().fill_rect_with_rounded_corners(
         command.rect, command.color,
         { static_cast<float>(command.corner_radii.top_left.horizontal_radius), static_cast<float>(command.corner_radii.top_left.vertical_radius) },
@@ -213,34 +278,29 @@ CommandResult DisplayListPlayerGPU::fill_rect_with_rounded_corners(FillRectWithR
     return CommandResult::Continue;
 }
 
-CommandResult DisplayListPlayerGPU::fill_path_using_color(FillPathUsingColor const&)
+CommandResult DisplayListPlayerGPU::fill_path_using_color(FillPathUsingColor const& command)
 {
-    // FIXME
-    return CommandResult::Continue;
+    return execute_on_cpu(command, command.bounding_rect());
 }
 
-CommandResult DisplayListPlayerGPU::fill_path_using_paint_style(FillPathUsingPaintStyle const&)
+CommandResult DisplayListPlayerGPU::fill_path_using_paint_style(FillPathUsingPaintStyle const& command)
 {
-    // FIXME
-    return CommandResult::Continue;
+    return execute_on_cpu(command, command.bounding_rect());
 }
 
-CommandResult DisplayListPlayerGPU::stroke_path_using_color(StrokePathUsingColor const&)
+CommandResult DisplayListPlayerGPU::stroke_path_using_color(StrokePathUsingColor const& command)
 {
-    // FIXME
-    return CommandResult::Continue;
+    return execute_on_cpu(command, command.bounding_rect());
 }
 
-CommandResult DisplayListPlayerGPU::stroke_path_using_paint_style(StrokePathUsingPaintStyle const&)
+CommandResult DisplayListPlayerGPU::stroke_path_using_paint_style(StrokePathUsingPaintStyle const& command)
 {
-    // FIXME
-    return CommandResult::Continue;
+    return execute_on_cpu(command, command.bounding_rect());
 }
 
-CommandResult DisplayListPlayerGPU::draw_ellipse(DrawEllipse const&)
+CommandResult DisplayListPlayerGPU::draw_ellipse(DrawEllipse const& command)
 {
-    // FIXME
-    return CommandResult::Continue;
+    return execute_on_cpu(command, command.bounding_rect());
 }
 
 CommandResult DisplayListPlayerGPU::fill_ellipse(FillEllipse const& command)
@@ -258,39 +318,41 @@ CommandResult DisplayListPlayerGPU::fill_ellipse(FillEllipse const& command)
 
 CommandResult DisplayListPlayerGPU::draw_line(DrawLine const& command)
 {
-    // FIXME: Pass line style and alternate color once AccelGfx::Painter supports it
+    if (command.style != Gfx::LineStyle::Solid) {
+        auto rect = Gfx::IntRect::from_two_points(command.from, command.to).inflated(command.thickness * 2, command.thickness * 2);
+        return execute_on_cpu(command, rect);
+    }
     painter().draw_line(command.from, command.to, command.thickness, command.color);
     return CommandResult::Continue;
 }
 
 CommandResult DisplayListPlayerGPU::apply_backdrop_filter(ApplyBackdropFilter const&)
 {
-    // FIXME
+    // FIXME: This needs to read back what has been painted so far.
+    m_skipped_command_count++;
     return CommandResult::Continue;
 }
 
-CommandResult DisplayListPlayerGPU::draw_rect(DrawRect const&)
+CommandResult DisplayListPlayerGPU::draw_rect(DrawRect const& command)
 {
-    // FIXME
-    return CommandResult::Continue;
+    return execute_on_cpu(command, command.bounding_rect());
 }
 
-CommandResult DisplayListPlayerGPU::paint_radial_gradient(PaintRadialGradient const&)
+CommandResult DisplayListPlayerGPU::paint_radial_gradient(PaintRadialGradient const& command)
 {
-    // FIXME
-    return CommandResult::Continue;
+    return execute_on_cpu(command, command.bounding_rect());
 }
 
-CommandResult DisplayListPlayerGPU::paint_conic_gradient(PaintConicGradient const&)
+CommandResult DisplayListPlayerGPU::paint_conic_gradient(PaintConicGradient const& command)
 {
-    // FIXME
-    return CommandResult::Continue;
+    return execute_on_cpu(command, command.bounding_rect());
 }
 
-CommandResult DisplayListPlayerGPU::draw_triangle_wave(DrawTriangleWave const&)
+CommandResult DisplayListPlayerGPU::draw_triangle_wave(DrawTriangleWave const& command)
 {
-    // FIXME
-    return CommandResult::Continue;
+    auto inflation = (command.amplitude + command.thickness) * 2;
+    auto rect = Gfx::IntRect::from_two_points(command.p1, command.p2).inflated(inflation, inflation);
+    return execute_on_cpu(command, rect);
 }
 
 CommandResult DisplayListPlayerGPU::sample_under_corners(SampleUnderCorners const& command)
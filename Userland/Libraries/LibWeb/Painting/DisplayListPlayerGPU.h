@@ -56,6 +56,12 @@ private:
     bool needs_update_immutable_bitmap_texture_cache() const override { return true; }
     void update_immutable_bitmap_texture_cache(HashMap<u32, Gfx::ImmutableBitmap const*>&) override;
 
+    // Rasterizes a command that has no GPU implementation on the CPU, and uploads the result as a texture.
+    template<typename CommandType>
+    CommandResult execute_on_cpu(CommandType const&, Gfx::IntRect bounding_rect);
+
+    void paint_stats_overlay();
+
     Gfx::Bitmap& m_target_bitmap;
     AccelGfx::Context& m_context;
 
@@ -87,6 +93,9 @@ private:
 
     Vector<StackingContext> m_stacking_contexts;
     Vector<OwnPtr<BorderRadiusCornerClipper>> m_corner_clippers;
+
+    size_t m_cpu_fallback_count { 0 };
+    size_t m_skipped_command_count { 0 };
 };
 
 }
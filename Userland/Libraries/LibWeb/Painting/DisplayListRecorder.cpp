@@ -233,14 +233,9 @@ void DisplayListRecorder::draw_text(Gfx::IntRect const& rect, String raw_text, G
     if (rect.is_empty())
         return;
 
-    auto glyph_run = adopt_ref(*new Gfx::GlyphRun({}, font, Gfx::GlyphRun::TextType::Ltr));
-    float glyph_run_width = 0;
-    Gfx::for_each_glyph_position(
-        { 0, 0 }, raw_text.code_points(), font, [&](Gfx::DrawGlyphOrEmoji const& glyph_or_emoji) {
-            glyph_run->append(glyph_or_emoji);
-            return IterationDecision::Continue;
-        },
-        Gfx::IncludeLeftBearing::No, glyph_run_width);
+    auto const& cached_glyph_run = Gfx::GlyphRunCache::the().glyphs_for(raw_text.code_points(), font);
+    auto glyph_run = adopt_ref(*new Gfx::GlyphRun(Vector { cached_glyph_run.glyphs }, font, Gfx::GlyphRun::TextType::Ltr));
+    float glyph_run_width = cached_glyph_run.width;
 
     float baseline_x = 0;
     if (alignment == Gfx::TextAlignment::CenterLeft) {
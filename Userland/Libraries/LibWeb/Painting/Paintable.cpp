@@ -127,6 +127,28 @@ void Paintable::invalidate_stacking_context()
     m_stacking_context = nullptr;
 }
 
+bool Paintable::can_track_damage_in_document_coordinates() const
+{
+    for (auto const* paintable = this; paintable; paintable = paintable->parent()) {
+        if (paintable->is_fixed_position())
+            return false;
+        if (!paintable->is_paintable_box())
+            continue;
+        auto const& box = static_cast<PaintableBox const&>(*paintable);
+        if (box.is_viewport())
+            break;
+        auto const& computed_values = box.computed_values();
+        if (computed_values.position() == CSS::Positioning::Sticky || !computed_values.transformations().is_empty())
+            return false;
+        // The root element and body paint the canvas background, which covers the whole viewport.
+        if (box.layout_box().is_root_element() || box.layout_box().is_body())
+            return false;
+        if (paintable != this && box.layout_box().is_scroll_container() && !box.scroll_offset().is_zero())
+            return false;
+    }
+    return true;
+}
+
 void Paintable::set_needs_display() const
 {
     auto* containing_block = this->containing_block();
@@ -136,16 +158,28 @@ void Paintable::set_needs_display() const
     if (!navigable)
         return;
 
+    if (!can_track_damage_in_document_coordinates() || !computed_values().text_shadow().is_empty()) {
+        navigable->set_needs_display();
+        return;
+    }
+
+    // NOTE: Glyphs can paint outside of their fragment, so we leave some room around it.
+    auto damage_rect_for_fragment = [](PaintableFragment const& fragment) {
+        auto rect = fragment.absolute_rect();
+        auto inflation = rect.height();
+        return rect.inflated(inflation, inflation, inflation, inflation);
+    };
+
     if (is<Painting::InlinePaintable>(*this)) {
         auto const& fragments = static_cast<Painting::InlinePaintable const*>(this)->fragments();
         for (auto const& fragment : fragments)
-            navigable->set_needs_display(fragment.absolute_rect());
+            navigable->set_needs_display(damage_rect_for_fragment(fragment));
     }
 
     if (!is<Painting::PaintableWithLines>(*containing_block))
         return;
     static_cast<Painting::PaintableWithLines const&>(*containing_block).for_each_fragment([&](auto& fragment) {
-        navigable->set_needs_display(fragment.absolute_rect());
+        navigable->set_needs_display(damage_rect_for_fragment(fragment));
         return IterationDecision::Continue;
     });
 }
@@ -179,6 +179,10 @@ public:
 
     virtual void set_needs_display() const;
 
+    // Damage is tracked in document coordinates, which only describe where something ends up on screen if nothing
+    // between this paintable and the viewport scrolls, transforms or sticks it elsewhere.
+    [[nodiscard]] bool can_track_damage_in_document_coordinates() const;
+
     PaintableBox* containing_block() const
     {
         if (!m_containing_block.has_value()) {
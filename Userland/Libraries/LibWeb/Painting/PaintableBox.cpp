@@ -1040,8 +1040,22 @@ TraversalDecision PaintableWithLines::hit_test(CSSPixelPoint position, HitTestTy
 
 void PaintableBox::set_needs_display() const
 {
-    if (auto navigable = this->navigable())
-        navigable->set_needs_display(absolute_rect());
+    auto navigable = this->navigable();
+    if (!navigable)
+        return;
+
+    if (!can_track_damage_in_document_coordinates()) {
+        navigable->set_needs_display();
+        return;
+    }
+
+    // NOTE: The cached paint rect may be from before a style change, and it doesn't include outlines.
+    auto rect = compute_absolute_paint_rect();
+    if (computed_values().outline_style() != CSS::OutlineStyle::None) {
+        auto outline_extent = computed_values().outline_width().to_px(layout_node()) + max(computed_values().outline_offset().to_px(layout_node()), CSSPixels(0));
+        rect.inflate(outline_extent, outline_extent, outline_extent, outline_extent);
+    }
+    navigable->set_needs_display(rect);
 }
 
 Optional<CSSPixelRect> PaintableBox::get_masking_area() const
@@ -209,6 +209,13 @@ public:
 
     virtual void resolve_paint_properties() override;
 
+    enum class ScrollDirection {
+        Horizontal,
+        Vertical,
+    };
+    [[nodiscard]] Optional<CSSPixelRect> scroll_thumb_rect(ScrollDirection) const;
+    [[nodiscard]] bool is_scrollable(ScrollDirection) const;
+
 protected:
     explicit PaintableBox(Layout::Box const&);
 
@@ -220,13 +227,6 @@ protected:
     virtual CSSPixelRect compute_absolute_rect() const;
     virtual CSSPixelRect compute_absolute_paint_rect() const;
 
-    enum class ScrollDirection {
-        Horizontal,
-        Vertical,
-    };
-    [[nodiscard]] Optional<CSSPixelRect> scroll_thumb_rect(ScrollDirection) const;
-    [[nodiscard]] bool is_scrollable(ScrollDirection) const;
-
     TraversalDecision hit_test_scrollbars(CSSPixelPoint position, Function<TraversalDecision(HitTestResult)> const& callback) const;
 
 private:
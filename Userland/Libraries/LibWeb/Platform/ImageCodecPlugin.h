@@ -20,11 +20,26 @@ struct Frame {
 };
 
 struct DecodedImage {
+    i64 image_id { 0 };
     bool is_animated { false };
     u32 loop_count { 0 };
+    u32 frame_count { 0 };
     Vector<Frame> frames;
 };
 
+enum class FrameDecoding {
+    // Every frame is decoded before the image is resolved.
+    AllFrames,
+
+    // Only the first frame is decoded.
+    FirstFrameOnly,
+
+    // Only the first frame of an animation is decoded up front. The others are decoded with
+    // ImageCodecPlugin::request_animation_frames(), and the image has to be released with
+    // ImageCodecPlugin::release_animated_image() once it is no longer needed.
+    OnDemand,
+};
+
 class ImageCodecPlugin {
 public:
     static ImageCodecPlugin& the();
@@ -32,7 +47,22 @@ public:
 
     virtual ~ImageCodecPlugin();
 
-    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+    virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, FrameDecoding, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+
+    // Frames that failed to decode have a null bitmap.
+    using AnimationFramesCallback = Function<void(u32 start_frame_index, Vector<Frame>&)>;
+    virtual void request_animation_frames(i64 image_id, u32 start_frame_index, u32 frame_count, ESCAPING AnimationFramesCallback) = 0;
+    virtual void release_animated_image(i64 image_id) = 0;
+
+    // Decodes an image while its data is still arriving. Partial images of the first frame are passed to the callback
+    // as the data comes in, along with the number of rows at their top that are decoded. Once all of the data has been
+    // appended, finish_incremental_decode() decodes the image just like decode_image() does.
+    // Returns an empty Optional if the image can't be decoded incrementally, in which case decode_image() should be used.
+    using PartialImageCallback = Function<void(NonnullRefPtr<Gfx::Bitmap>, u32 decoded_rows)>;
+    virtual Optional<i64> begin_incremental_decode(ESCAPING PartialImageCallback) = 0;
+    virtual void append_incremental_data(i64 incremental_decode_id, ReadonlyBytes) = 0;
+    virtual NonnullRefPtr<Core::Promise<DecodedImage>> finish_incremental_decode(i64 incremental_decode_id, FrameDecoding, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+    virtual void cancel_incremental_decode(i64 incremental_decode_id) = 0;
 };
 
 }
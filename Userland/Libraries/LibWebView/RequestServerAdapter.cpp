@@ -101,4 +101,9 @@ void RequestServerAdapter::preconnect(URL::URL const& url)
     m_protocol_client->ensure_connection(url, RequestServer::CacheLevel::CreateConnection);
 }
 
+ByteString RequestServerAdapter::disk_cache_statistics()
+{
+    return m_protocol_client->disk_cache_statistics();
+}
+
 }
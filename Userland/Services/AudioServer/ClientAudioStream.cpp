@@ -25,16 +25,17 @@ bool ClientAudioStream::is_connected() const
     return m_client && m_client->is_open();
 }
 
-ErrorOr<Audio::Sample, ClientAudioStream::ErrorState> ClientAudioStream::get_next_sample(u32 audiodevice_sample_rate)
+ErrorOr<void, ClientAudioStream::ErrorState> ClientAudioStream::dequeue_next_chunk(u32 audiodevice_sample_rate)
 {
-    // Note: Even though we only check client state here, we will probably close the client much earlier.
-    if (!is_connected())
-        return ErrorState::ClientDisconnected;
-
-    if (m_paused)
-        return ErrorState::ClientUnderrun;
-
-    if (m_in_chunk_location >= m_current_audio_chunk.size()) {
+    auto source_sample_rate = m_sample_rate == 0 ? audiodevice_sample_rate : m_sample_rate;
+    // The resampler keeps state between chunks, so it's only replaced once the sample rate of either side changes.
+    if (!m_resampler || m_resampler->source() != source_sample_rate || m_resampler->target() != audiodevice_sample_rate)
+        m_resampler = make<Audio::SincResampler>(source_sample_rate, audiodevice_sample_rate);
+
+    m_current_audio_chunk.clear_with_capacity();
+    m_in_chunk_location = 0;
+    // When upsampling, the resampler may need a few chunks before it has enough input for its first output samples.
+    while (m_current_audio_chunk.is_empty()) {
         auto result = m_buffer->dequeue();
         if (result.is_error()) {
             if (result.error() == Audio::AudioQueue::QueueStatus::Empty) {
@@ -43,21 +44,35 @@ ErrorOr<Audio::Sample, ClientAudioStream::ErrorState> ClientAudioStream::get_nex
 
             return ErrorState::ClientUnderrun;
         }
-        // FIXME: Our resampler and the way we resample here are bad.
-        //        Ideally, we should both do perfect band-corrected resampling,
-        //        as well as carry resampling state over between buffers.
-        auto maybe_resampled = Audio::ResampleHelper<Audio::Sample> { m_sample_rate == 0 ? audiodevice_sample_rate : m_sample_rate, audiodevice_sample_rate }
-                                   .try_resample(result.release_value());
-        if (maybe_resampled.is_error())
-            return ErrorState::ResamplingError;
 
-        // If the sample rate changes underneath us, we will still play the existing buffer unchanged until we're done.
-        // This is not a significant problem since the buffers are very small (~100 samples or less).
-        m_current_audio_chunk = maybe_resampled.release_value();
-        m_in_chunk_location = 0;
+        if (m_resampler->try_resample_into_end(m_current_audio_chunk, result.value().span()).is_error())
+            return ErrorState::ResamplingError;
     }
+    return {};
+}
 
-    return m_current_audio_chunk[m_in_chunk_location++];
+ErrorOr<size_t, ClientAudioStream::ErrorState> ClientAudioStream::read_samples(Span<Audio::Sample> samples, u32 audiodevice_sample_rate)
+{
+    // Note: Even though we only check client state here, we will probably close the client much earlier.
+    if (!is_connected())
+        return ErrorState::ClientDisconnected;
+
+    if (m_paused)
+        return ErrorState::ClientUnderrun;
+
+    size_t samples_read = 0;
+    while (samples_read < samples.size()) {
+        if (m_in_chunk_location >= m_current_audio_chunk.size()) {
+            if (dequeue_next_chunk(audiodevice_sample_rate).is_error())
+                break;
+        }
+
+        auto chunk = m_current_audio_chunk.span().slice(m_in_chunk_location);
+        auto copied = chunk.copy_trimmed_to(samples.slice(samples_read));
+        m_in_chunk_location += copied;
+        samples_read += copied;
+    }
+    return samples_read;
 }
 
 void ClientAudioStream::set_buffer(NonnullOwnPtr<Audio::AudioQueue> buffer)
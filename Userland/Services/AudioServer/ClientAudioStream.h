@@ -14,6 +14,7 @@
 #include <AK/RefCounted.h>
 #include <AK/WeakPtr.h>
 #include <LibAudio/Queue.h>
+#include <LibAudio/Resampler.h>
 
 namespace AudioServer {
 
@@ -29,7 +30,8 @@ public:
     explicit ClientAudioStream(ConnectionFromClient&);
     ~ClientAudioStream() = default;
 
-    ErrorOr<Audio::Sample, ErrorState> get_next_sample(u32 audiodevice_sample_rate);
+    // Fills the samples from the start, and returns how many there were before the client ran out.
+    ErrorOr<size_t, ErrorState> read_samples(Span<Audio::Sample>, u32 audiodevice_sample_rate);
     void clear();
 
     bool is_connected() const;
@@ -48,9 +50,12 @@ public:
     void set_sample_rate(u32 sample_rate);
 
 private:
+    ErrorOr<void, ErrorState> dequeue_next_chunk(u32 audiodevice_sample_rate);
+
     OwnPtr<Audio::AudioQueue> m_buffer;
+    OwnPtr<Audio::SincResampler> m_resampler;
     Vector<Audio::Sample> m_current_audio_chunk;
-    size_t m_in_chunk_location;
+    size_t m_in_chunk_location { 0 };
 
     bool m_paused { true };
     bool m_muted { false };
@@ -8,7 +8,6 @@
 #include "Mixer.h"
 #include <AK/Array.h>
 #include <AK/Format.h>
-#include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
 #include <AudioServer/ConnectionFromClient.h>
 #include <AudioServer/ConnectionFromManagerClient.h>
@@ -16,6 +15,7 @@
 #include <LibCore/ConfigFile.h>
 #include <LibCore/Timer.h>
 #include <pthread.h>
+#include <sched.h>
 #include <sys/ioctl.h>
 
 namespace AudioServer {
@@ -40,29 +40,52 @@ NonnullRefPtr<ClientAudioStream> Mixer::create_queue(ConnectionFromClient& clien
 {
     auto queue = adopt_ref(*new ClientAudioStream(client));
     queue->set_sample_rate(audiodevice_get_sample_rate());
-    {
-        Threading::MutexLocker const locker(m_pending_mutex);
-        m_pending_mixing.append(*queue);
+    // The mixer thread empties the ring before every buffer, so it can only be full for a very short time.
+    while (!m_pending_mixing.try_enqueue(queue)) {
+        wake_mixer();
+        sched_yield();
     }
     // Signal the mixer thread to start back up, in case nobody was connected before.
-    m_mixing_necessary.signal();
+    wake_mixer();
 
     return queue;
 }
 
+void Mixer::wake_mixer()
+{
+    Threading::MutexLocker const locker(m_idle_mutex);
+    m_mixing_necessary.signal();
+}
+
+// Adds the scaled samples to the mix. This is kept free of any per-sample branches or volume calculations, so that the
+// compiler can turn it into vector multiply-adds.
+static void mix_samples(Span<Audio::Sample> mix, ReadonlySpan<Audio::Sample> samples, float gain)
+{
+    VERIFY(samples.size() <= mix.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        mix[i].left += samples[i].left * gain;
+        mix[i].right += samples[i].right * gain;
+    }
+}
+
 void Mixer::mix()
 {
-    decltype(m_pending_mixing) active_mix_queues;
+    Vector<NonnullRefPtr<ClientAudioStream>> active_mix_queues;
+
+    auto take_pending_queues = [&] {
+        for (auto queue = m_pending_mixing.try_dequeue(); queue.has_value(); queue = m_pending_mixing.try_dequeue())
+            active_mix_queues.append(queue.release_value());
+    };
 
     for (;;) {
-        {
-            Threading::MutexLocker const locker(m_pending_mutex);
+        take_pending_queues();
+        if (active_mix_queues.is_empty()) {
+            Threading::MutexLocker const locker(m_idle_mutex);
             // While we have nothing to mix, wait on the condition.
-            m_mixing_necessary.wait_while([this, &active_mix_queues]() { return m_pending_mixing.is_empty() && active_mix_queues.is_empty(); });
-            if (!m_pending_mixing.is_empty()) {
-                active_mix_queues.extend(move(m_pending_mixing));
-                m_pending_mixing.clear();
-            }
+            m_mixing_necessary.wait_while([&] {
+                take_pending_queues();
+                return active_mix_queues.is_empty();
+            });
         }
 
         active_mix_queues.remove_all_matching([&](auto& entry) { return !entry->is_connected(); });
@@ -79,18 +102,12 @@ void Mixer::mix()
             }
             queue->volume().advance_time();
 
-            // FIXME: Perform sample extraction and mixing in two separate loops so they can be more easily vectorized.
-            for (auto& mixed_sample : mixed_buffer) {
-                auto sample_or_error = queue->get_next_sample(audiodevice_get_sample_rate());
-                if (sample_or_error.is_error())
-                    break;
-                if (queue->is_muted())
-                    continue;
-                auto sample = sample_or_error.release_value();
-                sample.log_multiply(SAMPLE_HEADROOM);
-                sample.log_multiply(static_cast<float>(queue->volume()));
-                mixed_sample += sample;
-            }
+            // The volume only changes between buffers, so the whole buffer is scaled by the same factor.
+            auto sample_count_or_error = queue->read_samples(m_client_samples.span(), audiodevice_get_sample_rate());
+            if (sample_count_or_error.is_error() || queue->is_muted())
+                continue;
+            auto gain = Audio::Sample::linear_to_log(SAMPLE_HEADROOM) * Audio::Sample::linear_to_log(static_cast<float>(queue->volume()));
+            mix_samples(mixed_buffer.span(), m_client_samples.span().trim(sample_count_or_error.value()), gain);
         }
 
         // Even though it's not realistic, the user expects no sound at 0%.
@@ -98,24 +115,17 @@ void Mixer::mix()
             if (m_device)
                 m_device->write_until_depleted(m_zero_filled_buffer).release_value_but_fixme_should_propagate_errors();
         } else {
-            FixedMemoryStream stream { m_stream_buffer.span() };
-
-            for (auto& mixed_sample : mixed_buffer) {
-                mixed_sample.log_multiply(static_cast<float>(m_main_volume));
+            auto main_gain = Audio::Sample::linear_to_log(static_cast<float>(m_main_volume));
+            for (size_t i = 0; i < mixed_buffer.size(); ++i) {
+                auto mixed_sample = mixed_buffer[i] * main_gain;
                 mixed_sample.clip();
-
-                LittleEndian<i16> out_sample;
-                out_sample = static_cast<i16>(mixed_sample.left * NumericLimits<i16>::max());
-                MUST(stream.write_value(out_sample));
-
-                out_sample = static_cast<i16>(mixed_sample.right * NumericLimits<i16>::max());
-                MUST(stream.write_value(out_sample));
+                m_stream_buffer[2 * i] = static_cast<i16>(mixed_sample.left * NumericLimits<i16>::max());
+                m_stream_buffer[2 * i + 1] = static_cast<i16>(mixed_sample.right * NumericLimits<i16>::max());
             }
 
-            auto buffered_bytes = MUST(stream.tell());
-            VERIFY(buffered_bytes == m_stream_buffer.size());
+            static_assert(sizeof(m_stream_buffer) == HARDWARE_BUFFER_SIZE_BYTES);
             if (m_device)
-                m_device->write_until_depleted({ m_stream_buffer.data(), buffered_bytes })
+                m_device->write_until_depleted({ m_stream_buffer.data(), sizeof(m_stream_buffer) })
                     .release_value_but_fixme_should_propagate_errors();
         }
     }
@@ -14,8 +14,10 @@
 #include <AK/Badge.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Debug.h>
+#include <AK/Endian.h>
 #include <AK/Queue.h>
 #include <AK/RefCounted.h>
+#include <AK/SPSCQueue.h>
 #include <AK/WeakPtr.h>
 #include <LibAudio/Queue.h>
 #include <LibAudio/Resampler.h>
@@ -35,6 +37,8 @@ constexpr double SAMPLE_HEADROOM = 0.95;
 constexpr size_t HARDWARE_BUFFER_SIZE = 512;
 // The hardware buffer size in bytes; there's two channels of 16-bit samples.
 constexpr size_t HARDWARE_BUFFER_SIZE_BYTES = HARDWARE_BUFFER_SIZE * 2 * sizeof(i16);
+// How many new streams can wait for the mixer thread to pick them up, which it does before mixing each buffer.
+constexpr size_t MAX_PENDING_STREAMS = 32;
 
 class Mixer : public Core::EventReceiver {
     C_OBJECT_ABSTRACT(Mixer)
@@ -69,10 +73,13 @@ private:
     Mixer(NonnullRefPtr<Core::ConfigFile> config, OwnPtr<Core::File> device);
 
     void request_setting_sync();
+    void wake_mixer();
 
-    Vector<NonnullRefPtr<ClientAudioStream>> m_pending_mixing;
-    Threading::Mutex m_pending_mutex;
-    Threading::ConditionVariable m_mixing_necessary { m_pending_mutex };
+    // New streams are handed to the mixer thread through a lock-free ring, so that mixing never has to take a lock.
+    // The mutex and condition variable are only used to wake the mixer thread up when it has nothing to mix.
+    SPSCQueue<NonnullRefPtr<ClientAudioStream>, MAX_PENDING_STREAMS> m_pending_mixing;
+    Threading::Mutex m_idle_mutex;
+    Threading::ConditionVariable m_mixing_necessary { m_idle_mutex };
 
     OwnPtr<Core::File> m_device;
     mutable Optional<u32> m_cached_sample_rate {};
@@ -85,7 +92,8 @@ private:
     NonnullRefPtr<Core::ConfigFile> m_config;
     RefPtr<Core::Timer> m_config_write_timer;
 
-    Array<u8, HARDWARE_BUFFER_SIZE_BYTES> m_stream_buffer;
+    Array<Audio::Sample, HARDWARE_BUFFER_SIZE> m_client_samples;
+    Array<LittleEndian<i16>, HARDWARE_BUFFER_SIZE * 2> m_stream_buffer;
     Array<u8, HARDWARE_BUFFER_SIZE_BYTES> const m_zero_filled_buffer {};
 
     void mix();
@@ -7,9 +7,11 @@
 #include <AK/Debug.h>
 #include <ImageDecoder/ConnectionFromClient.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
+#include <LibCore/EventLoop.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
+#include <LibThreading/WorkStealingThreadPool.h>
 
 namespace ImageDecoder {
 
@@ -20,20 +22,23 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> sock
 
 void ConnectionFromClient::die()
 {
-    for (auto& [_, job] : m_pending_jobs) {
-        job->cancel();
-    }
-    m_pending_jobs.clear();
+    for (auto& [_, pending_decode] : m_pending_decodes)
+        pending_decode->is_canceled = true;
+
+    // The workers refer to our state, so let them finish before it goes away.
+    Threading::WorkStealingThreadPool::the().wait_for_all();
+    m_pending_decodes.clear();
+    m_incremental_decodes.clear();
+    m_animated_images.clear();
 
-    Threading::quit_background_thread();
     Core::EventLoop::current().quit(0);
 }
 
 namespace {
 
-void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const& decoder, Optional<Gfx::IntSize> ideal_size, Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>>& bitmaps, Vector<u32>& durations)
+void decode_frames_with_decoder(Gfx::ImageDecoder const& decoder, size_t start_frame_index, size_t frame_count, Optional<Gfx::IntSize> ideal_size, Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>>& bitmaps, Vector<u32>& durations)
 {
-    for (size_t i = 0; i < decoder.frame_count(); ++i) {
+    for (size_t i = start_frame_index; i < start_frame_index + frame_count; ++i) {
         auto frame_or_error = decoder.frame(i, ideal_size);
         if (frame_or_error.is_error()) {
             bitmaps.append({});
@@ -46,9 +51,9 @@ void decode_image_to_bitmaps_and_durations_with_decoder(Gfx::ImageDecoder const&
     }
 }
 
-ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
+ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(ReadonlyBytes encoded_data, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& known_mime_type)
 {
-    auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(ReadonlyBytes { encoded_buffer.data<u8>(), encoded_buffer.size() }, known_mime_type));
+    auto decoder = TRY(Gfx::ImageDecoder::try_create_for_raw_bytes(encoded_data, known_mime_type));
 
     if (!decoder)
         return Error::from_string_literal("Could not find suitable image decoder plugin for data");
@@ -59,6 +64,7 @@ ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::Anonym
     ConnectionFromClient::DecodeResult result;
     result.is_animated = decoder->is_animated();
     result.loop_count = decoder->loop_count();
+    result.frame_count = decoder->frame_count();
 
     Vector<Optional<NonnullRefPtr<Gfx::Bitmap>>> bitmaps;
 
@@ -74,9 +80,11 @@ ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::Anonym
         }
     }
 
-    decode_image_to_bitmaps_and_durations_with_decoder(*decoder, move(ideal_size), bitmaps, result.durations);
+    // Animations can have hundreds of frames, most of which may never be shown, so we only decode the first one now.
+    bool const decode_frames_on_demand = result.is_animated && result.frame_count > 1;
+    decode_frames_with_decoder(*decoder, 0, decode_frames_on_demand ? 1 : result.frame_count, ideal_size, bitmaps, result.durations);
 
-    auto no_frame_available = !any_of(bitmaps, [](Optional<NonnullRefPtr<Gfx::Bitmap>> bitmap) {
+    auto no_frame_available = !any_of(bitmaps, [](Optional<NonnullRefPtr<Gfx::Bitmap>> const& bitmap) {
         return bitmap.has_value();
     });
 
@@ -84,30 +92,14 @@ ErrorOr<ConnectionFromClient::DecodeResult> decode_image_to_details(Core::Anonym
         return Error::from_string_literal("Could not decode image");
 
     result.bitmaps = { move(bitmaps) };
+    if (decode_frames_on_demand)
+        result.decoder = move(decoder);
 
     return result;
 }
 
 }
 
-NonnullRefPtr<ConnectionFromClient::Job> ConnectionFromClient::make_decode_image_job(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
-{
-    return Job::construct(
-        [encoded_buffer = move(encoded_buffer), ideal_size = move(ideal_size), mime_type = move(mime_type)](auto&) -> ErrorOr<DecodeResult> {
-            return TRY(decode_image_to_details(encoded_buffer, ideal_size, mime_type));
-        },
-        [strong_this = NonnullRefPtr(*this), image_id](DecodeResult result) -> ErrorOr<void> {
-            strong_this->async_did_decode_image(image_id, result.is_animated, result.loop_count, move(result.bitmaps), move(result.durations), result.scale);
-            strong_this->m_pending_jobs.remove(image_id);
-            return {};
-        },
-        [strong_this = NonnullRefPtr(*this), image_id](Error error) -> void {
-            if (strong_this->is_open())
-                strong_this->async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", error)));
-            strong_this->m_pending_jobs.remove(image_id);
-        });
-}
-
 Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_image(Core::AnonymousBuffer const& encoded_buffer, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type)
 {
     auto image_id = m_next_image_id++;
@@ -118,16 +110,272 @@ Messages::ImageDecoderServer::DecodeImageResponse ConnectionFromClient::decode_i
         return image_id;
     }
 
-    m_pending_jobs.set(image_id, make_decode_image_job(image_id, encoded_buffer, ideal_size, mime_type));
-
+    start_decoding_image(image_id, encoded_buffer, ideal_size, mime_type);
     return image_id;
 }
 
+void ConnectionFromClient::start_decoding_image(i64 image_id, Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& mime_type)
+{
+    // The worker copies the MIME type, so it must not share its reference count with the IPC message.
+    auto unshared_mime_type = mime_type.map([](auto const& type) { return ByteString { type.view() }; });
+    auto pending_decode = make<PendingDecode>(move(encoded_buffer), ideal_size, move(unshared_mime_type));
+    auto& pending_decode_ref = *pending_decode;
+    m_pending_decodes.set(image_id, move(pending_decode));
+
+    Threading::WorkStealingThreadPool::the().submit([this, image_id, &pending_decode = pending_decode_ref, event_loop = &Core::EventLoop::current()] {
+        ErrorOr<DecodeResult> result = Error::from_errno(ECANCELED);
+        if (!pending_decode.is_canceled) {
+            ReadonlyBytes encoded_data { pending_decode.encoded_buffer.data<u8>(), pending_decode.encoded_buffer.size() };
+            result = decode_image_to_details(encoded_data, pending_decode.ideal_size, pending_decode.mime_type);
+        }
+
+        event_loop->deferred_invoke([this, image_id, result = move(result)]() mutable {
+            did_finish_decoding_image(image_id, move(result));
+        });
+        event_loop->wake();
+    });
+}
+
+void ConnectionFromClient::did_finish_decoding_image(i64 image_id, ErrorOr<DecodeResult> result)
+{
+    // The pending decodes are all dropped when the client goes away.
+    auto maybe_pending_decode = m_pending_decodes.take(image_id);
+    if (!maybe_pending_decode.has_value())
+        return;
+
+    auto pending_decode = maybe_pending_decode.release_value();
+    if (pending_decode->is_canceled || !is_open())
+        return;
+
+    if (result.is_error()) {
+        async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", result.error())));
+        return;
+    }
+
+    auto decode_result = result.release_value();
+    if (decode_result.decoder) {
+        m_animated_images.set(image_id, make<AnimatedImage>(move(pending_decode->encoded_buffer), decode_result.decoder.release_nonnull(), pending_decode->ideal_size));
+    }
+
+    async_did_decode_image(image_id, decode_result.is_animated, decode_result.loop_count, decode_result.frame_count, move(decode_result.bitmaps), move(decode_result.durations), decode_result.scale);
+}
+
 void ConnectionFromClient::cancel_decoding(i64 image_id)
 {
-    if (auto job = m_pending_jobs.take(image_id); job.has_value()) {
-        job.value()->cancel();
+    // The decode may already be running, so we only drop it once the worker is done with it.
+    if (auto pending_decode = m_pending_decodes.get(image_id); pending_decode.has_value())
+        pending_decode.value()->is_canceled = true;
+
+    if (auto incremental_decode = m_incremental_decodes.get(image_id); incremental_decode.has_value()) {
+        if (incremental_decode.value()->is_decoding)
+            incremental_decode.value()->is_canceled = true;
+        else
+            m_incremental_decodes.remove(image_id);
+    }
+}
+
+Messages::ImageDecoderServer::BeginIncrementalDecodeResponse ConnectionFromClient::begin_incremental_decode(Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type)
+{
+    auto image_id = m_next_image_id++;
+
+    // The worker copies the MIME type, so it must not share its reference count with the IPC message.
+    auto unshared_mime_type = mime_type.map([](auto const& type) { return ByteString { type.view() }; });
+    auto incremental_decode = make<IncrementalDecode>(Gfx::IncrementalImageDecoder { move(unshared_mime_type) });
+    incremental_decode->ideal_size = ideal_size;
+    m_incremental_decodes.set(image_id, move(incremental_decode));
+    return image_id;
+}
+
+void ConnectionFromClient::append_incremental_data(i64 image_id, Core::AnonymousBuffer const& data)
+{
+    auto maybe_incremental_decode = m_incremental_decodes.get(image_id);
+    if (!maybe_incremental_decode.has_value() || !data.is_valid()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Data appended to unknown incremental decode {}", image_id);
+        return;
+    }
+
+    auto& incremental_decode = *maybe_incremental_decode.value();
+    if (incremental_decode.is_finished || incremental_decode.is_canceled)
+        return;
+
+    ReadonlyBytes bytes { data.data<u8>(), data.size() };
+    auto result = incremental_decode.is_decoding ? incremental_decode.pending_data.try_append(bytes) : incremental_decode.decoder.append_data(bytes);
+    if (result.is_error()) {
+        incremental_decode.is_canceled = true;
+        async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", result.error())));
+        if (!incremental_decode.is_decoding)
+            m_incremental_decodes.remove(image_id);
+        return;
+    }
+
+    decode_next_partial_image(image_id, incremental_decode);
+}
+
+void ConnectionFromClient::decode_next_partial_image(i64 image_id, IncrementalDecode& incremental_decode)
+{
+    // Decoders can't resume, so each partial image is decoded from the start. The decoder only asks for a new one
+    // once enough new data has arrived, and only one of them is decoded at a time.
+    if (incremental_decode.is_decoding || !incremental_decode.decoder.should_decode_partial_frame())
+        return;
+
+    incremental_decode.is_decoding = true;
+    Threading::WorkStealingThreadPool::the().submit([this, image_id, &decoder = incremental_decode.decoder, event_loop = &Core::EventLoop::current()] {
+        auto result = decoder.decode_partial_frame();
+
+        event_loop->deferred_invoke([this, image_id, result = move(result)]() mutable {
+            did_finish_decoding_partial_image(image_id, move(result));
+        });
+        event_loop->wake();
+    });
+}
+
+void ConnectionFromClient::did_finish_decoding_partial_image(i64 image_id, ErrorOr<Optional<Gfx::PartialFrameDescriptor>> result)
+{
+    auto maybe_incremental_decode = m_incremental_decodes.get(image_id);
+    if (!maybe_incremental_decode.has_value())
+        return;
+
+    auto& incremental_decode = *maybe_incremental_decode.value();
+    incremental_decode.is_decoding = false;
+
+    if (incremental_decode.is_canceled || !is_open()) {
+        m_incremental_decodes.remove(image_id);
+        return;
+    }
+
+    if (auto append_result = incremental_decode.decoder.append_data(incremental_decode.pending_data); append_result.is_error()) {
+        async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", append_result.error())));
+        m_incremental_decodes.remove(image_id);
+        return;
+    }
+    incremental_decode.pending_data.clear();
+
+    // A partial image that fails to decode is simply not shown, the complete image is what counts.
+    if (!result.is_error() && result.value().has_value()) {
+        auto& partial_frame = result.value().value();
+        if (partial_frame.decoded_rows > incremental_decode.sent_decoded_rows) {
+            incremental_decode.sent_decoded_rows = partial_frame.decoded_rows;
+            Gfx::BitmapSequence bitmaps;
+            bitmaps.bitmaps.append(partial_frame.image.release_nonnull());
+            async_did_decode_partial_image(image_id, move(bitmaps), partial_frame.decoded_rows);
+        }
+    }
+
+    if (incremental_decode.is_finished) {
+        decode_incremental_image(image_id, m_incremental_decodes.take(image_id).release_value());
+        return;
+    }
+
+    decode_next_partial_image(image_id, incremental_decode);
+}
+
+void ConnectionFromClient::finish_incremental_decode(i64 image_id)
+{
+    auto maybe_incremental_decode = m_incremental_decodes.get(image_id);
+    if (!maybe_incremental_decode.has_value()) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Unknown incremental decode {} finished", image_id);
+        async_did_fail_to_decode_image(image_id, "Unknown image"_string);
+        return;
+    }
+
+    // The image is decoded once the partial image that is being decoded right now is done.
+    auto& incremental_decode = *maybe_incremental_decode.value();
+    incremental_decode.is_finished = true;
+    if (!incremental_decode.is_decoding)
+        decode_incremental_image(image_id, m_incremental_decodes.take(image_id).release_value());
+}
+
+void ConnectionFromClient::decode_incremental_image(i64 image_id, NonnullOwnPtr<IncrementalDecode> incremental_decode)
+{
+    auto data = incremental_decode->decoder.data();
+    if (data.is_empty()) {
+        async_did_fail_to_decode_image(image_id, "No encoded data"_string);
+        return;
+    }
+
+    auto encoded_buffer_or_error = Core::AnonymousBuffer::create_with_size(data.size());
+    if (encoded_buffer_or_error.is_error()) {
+        async_did_fail_to_decode_image(image_id, MUST(String::formatted("Decoding failed: {}", encoded_buffer_or_error.error())));
+        return;
+    }
+    auto encoded_buffer = encoded_buffer_or_error.release_value();
+    memcpy(encoded_buffer.data<void>(), data.data(), data.size());
+
+    start_decoding_image(image_id, move(encoded_buffer), incremental_decode->ideal_size, incremental_decode->decoder.mime_type());
+}
+
+void ConnectionFromClient::request_animation_frames(i64 image_id, u32 start_frame_index, u32 frame_count)
+{
+    auto animated_image = m_animated_images.get(image_id);
+    if (!animated_image.has_value() || animated_image.value()->is_released) {
+        dbgln_if(IMAGE_DECODER_DEBUG, "Frames requested for unknown animated image {}", image_id);
+        return;
     }
+
+    auto& image = *animated_image.value();
+    auto const total_frame_count = image.decoder->frame_count();
+    if (start_frame_index >= total_frame_count || frame_count == 0)
+        return;
+
+    image.pending_requests.enqueue({ start_frame_index, min(frame_count, static_cast<u32>(total_frame_count - start_frame_index)) });
+    decode_next_animation_frames(image_id, image);
+}
+
+void ConnectionFromClient::decode_next_animation_frames(i64 image_id, AnimatedImage& image)
+{
+    if (image.is_decoding || image.pending_requests.is_empty())
+        return;
+
+    auto range = image.pending_requests.dequeue();
+    image.is_decoding = true;
+
+    Threading::WorkStealingThreadPool::the().submit([this, image_id, range, &decoder = *image.decoder, ideal_size = image.ideal_size, event_loop = &Core::EventLoop::current()] {
+        DecodeFramesResult result;
+        result.start_frame_index = range.start_frame_index;
+        decode_frames_with_decoder(decoder, range.start_frame_index, range.frame_count, ideal_size, result.bitmaps.bitmaps, result.durations);
+
+        event_loop->deferred_invoke([this, image_id, result = move(result)]() mutable {
+            did_finish_decoding_animation_frames(image_id, move(result));
+        });
+        event_loop->wake();
+    });
+}
+
+void ConnectionFromClient::did_finish_decoding_animation_frames(i64 image_id, DecodeFramesResult result)
+{
+    auto animated_image = m_animated_images.get(image_id);
+    if (!animated_image.has_value())
+        return;
+
+    auto& image = *animated_image.value();
+    image.is_decoding = false;
+
+    if (image.is_released) {
+        m_animated_images.remove(image_id);
+        return;
+    }
+
+    if (!is_open())
+        return;
+
+    async_did_decode_animation_frames(image_id, result.start_frame_index, move(result.bitmaps), move(result.durations));
+    decode_next_animation_frames(image_id, image);
+}
+
+void ConnectionFromClient::release_animated_image(i64 image_id)
+{
+    auto animated_image = m_animated_images.get(image_id);
+    if (!animated_image.has_value())
+        return;
+
+    // A worker may still be using the decoder, in which case the image goes away once it is done.
+    if (animated_image.value()->is_decoding) {
+        animated_image.value()->is_released = true;
+        animated_image.value()->pending_requests.clear();
+        return;
+    }
+
+    m_animated_images.remove(image_id);
 }
 
 }
@@ -6,16 +6,28 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/HashMap.h>
+#include <AK/Queue.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
 #include <LibGfx/BitmapSequence.h>
+#include <LibGfx/ImageFormats/ImageDecoder.h>
+#include <LibGfx/ImageFormats/IncrementalImageDecoder.h>
 #include <LibIPC/ConnectionFromClient.h>
-#include <LibThreading/BackgroundAction.h>
 
 namespace ImageDecoder {
 
+// Images are decoded on the threads of the shared work-stealing thread pool, so a page full of images is decoded in
+// parallel. Only the first frame of an animated image is decoded up front; the decoder is kept around so that the
+// client can ask for the other frames when it needs them.
+//
+// Images can also be decoded while their data is still arriving. Partial images of the first frame are sent back as the
+// data comes in, and once all of it is there the image is decoded like any other.
+//
+// None of the state below is touched by the worker threads, except for the parts of a PendingDecode or AnimatedImage
+// that are handed to a worker while it is running. Those are only removed from the main thread once the worker is done.
 class ConnectionFromClient final
     : public IPC::ConnectionFromClient<ImageDecoderClientEndpoint, ImageDecoderServerEndpoint> {
     C_OBJECT(ConnectionFromClient);
@@ -28,23 +40,79 @@ public:
     struct DecodeResult {
         bool is_animated = false;
         u32 loop_count = 0;
+        u32 frame_count = 0;
         Gfx::FloatPoint scale { 1, 1 };
         Gfx::BitmapSequence bitmaps;
         Vector<u32> durations;
+
+        // Set for animated images, whose remaining frames are decoded on demand.
+        RefPtr<Gfx::ImageDecoder> decoder;
+    };
+
+    struct DecodeFramesResult {
+        u32 start_frame_index { 0 };
+        Gfx::BitmapSequence bitmaps;
+        Vector<u32> durations;
     };
 
 private:
-    using Job = Threading::BackgroundAction<DecodeResult>;
+    struct PendingDecode {
+        Core::AnonymousBuffer encoded_buffer;
+        Optional<Gfx::IntSize> ideal_size;
+        Optional<ByteString> mime_type;
+        Atomic<bool> is_canceled { false };
+    };
+
+    struct IncrementalDecode {
+        // The worker reads the data of the decoder, so any data that arrives while it is running waits in pending_data.
+        Gfx::IncrementalImageDecoder decoder;
+        ByteBuffer pending_data;
+        Optional<Gfx::IntSize> ideal_size;
+        int sent_decoded_rows { 0 };
+        bool is_decoding { false };
+        bool is_finished { false };
+        bool is_canceled { false };
+    };
+
+    struct FrameRange {
+        u32 start_frame_index { 0 };
+        u32 frame_count { 0 };
+    };
+
+    struct AnimatedImage {
+        // The decoder reads straight out of the encoded data, so it has to stay alive with it.
+        Core::AnonymousBuffer encoded_buffer;
+        NonnullRefPtr<Gfx::ImageDecoder> decoder;
+        Optional<Gfx::IntSize> ideal_size;
+
+        // Decoders can't be used from more than one thread at a time, so the requests are decoded one after another.
+        Queue<FrameRange> pending_requests;
+        bool is_decoding { false };
+        bool is_released { false };
+    };
 
     explicit ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket>);
 
     virtual Messages::ImageDecoderServer::DecodeImageResponse decode_image(Core::AnonymousBuffer const&, Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type) override;
     virtual void cancel_decoding(i64 image_id) override;
+    virtual Messages::ImageDecoderServer::BeginIncrementalDecodeResponse begin_incremental_decode(Optional<Gfx::IntSize> const& ideal_size, Optional<ByteString> const& mime_type) override;
+    virtual void append_incremental_data(i64 image_id, Core::AnonymousBuffer const&) override;
+    virtual void finish_incremental_decode(i64 image_id) override;
+    virtual void request_animation_frames(i64 image_id, u32 start_frame_index, u32 frame_count) override;
+    virtual void release_animated_image(i64 image_id) override;
 
-    NonnullRefPtr<Job> make_decode_image_job(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
+    void start_decoding_image(i64 image_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> const& mime_type);
+    void did_finish_decoding_image(i64 image_id, ErrorOr<DecodeResult>);
+    void decode_next_partial_image(i64 image_id, IncrementalDecode&);
+    void did_finish_decoding_partial_image(i64 image_id, ErrorOr<Optional<Gfx::PartialFrameDescriptor>>);
+    void decode_incremental_image(i64 image_id, NonnullOwnPtr<IncrementalDecode>);
+    void decode_next_animation_frames(i64 image_id, AnimatedImage&);
+    void did_finish_decoding_animation_frames(i64 image_id, DecodeFramesResult);
 
     i64 m_next_image_id { 0 };
-    HashMap<i64, NonnullRefPtr<Job>> m_pending_jobs;
+    HashMap<i64, NonnullOwnPtr<PendingDecode>> m_pending_decodes;
+    HashMap<i64, NonnullOwnPtr<IncrementalDecode>> m_incremental_decodes;
+    HashMap<i64, NonnullOwnPtr<AnimatedImage>> m_animated_images;
 };
 
 }
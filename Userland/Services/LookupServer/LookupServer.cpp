@@ -13,11 +13,15 @@
 #include <AK/Random.h>
 #include <AK/StdLibExtras.h>
 #include <AK/StringBuilder.h>
+#include <AK/Time.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/File.h>
 #include <LibCore/LocalServer.h>
+#include <LibCore/Socket.h>
+#include <LibCore/System.h>
 #include <LibDNS/Packet.h>
 #include <limits.h>
+#include <poll.h>
 #include <stdio.h>
 #include <time.h>
 #include <unistd.h>
@@ -27,6 +31,17 @@ namespace LookupServer {
 static LookupServer* s_the;
 // NOTE: This is the TTL we return for the hostname or answers from /etc/hosts.
 static constexpr u32 s_static_ttl = 86400;
+// LibDNS doesn't parse the authority section of responses, so we don't have the SOA minimum TTL that RFC 2308 uses for
+// negative answers. Instead, we believe them for a short while.
+static constexpr u32 s_negative_ttl = 60;
+static constexpr size_t s_max_cache_entries = 512;
+// Names that are looked up often are refreshed shortly before their answers expire, and are answered from the cache for a
+// little while after they did, so that their lookups don't have to wait for the nameservers.
+static constexpr u32 s_popular_hit_count = 2;
+static constexpr u32 s_prefetch_ttl_percentage = 10;
+static constexpr u32 s_max_stale_seconds = 30;
+static constexpr int s_upstream_attempts = 3;
+static constexpr i64 s_upstream_timeout_milliseconds = 1000;
 
 LookupServer& LookupServer::the()
 {
@@ -188,109 +203,56 @@ ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, RecordType record
     }
 
     // Third, try our cache.
-    if (auto cached_answers = m_lookup_cache.find(name); cached_answers != m_lookup_cache.end()) {
-        for (auto& answer : cached_answers->value) {
-            // TODO: Actually remove expired answers from the cache.
-            if (answer.type() == record_type && !answer.has_expired()) {
-                dbgln_if(LOOKUPSERVER_DEBUG, "Cache hit: {} -> {}", name.as_string(), answer.record_data());
-                add_answer(answer);
-            }
-        }
-        if (!answers.is_empty())
-            return answers;
+    if (auto cached_answers = lookup_in_cache(name, record_type); cached_answers.has_value()) {
+        for (auto& answer : *cached_answers)
+            add_answer(answer);
+        return answers;
     }
 
     // Fourth, look up .local names using mDNS instead of DNS nameservers.
     if (name.as_string().ends_with(".local"sv)) {
         answers = TRY(m_mdns->lookup(name, record_type));
         for (auto& answer : answers)
-            put_in_cache(answer);
+            put_in_cache(name, answer);
         return answers;
     }
 
     // Fifth, ask the upstream nameservers.
-    for (auto& nameserver : m_nameservers) {
-        dbgln_if(LOOKUPSERVER_DEBUG, "Doing lookup using nameserver '{}'", nameserver);
-        bool did_get_response = false;
-        int retries = 3;
-        Vector<Answer> upstream_answers;
-        do {
-            auto upstream_answers_or_error = lookup(name, nameserver, did_get_response, record_type);
-            if (upstream_answers_or_error.is_error())
-                continue;
-            upstream_answers = upstream_answers_or_error.release_value();
-            if (did_get_response)
-                break;
-        } while (--retries);
-        if (!upstream_answers.is_empty()) {
-            for (auto& answer : upstream_answers) {
-                add_answer(answer);
-                put_in_cache(answer);
-            }
-            break;
-        } else {
-            if (!did_get_response)
-                dbgln("Never got a response from '{}', trying next nameserver", nameserver);
-            else
-                dbgln("Received response from '{}' but no result(s), trying next nameserver", nameserver);
-        }
-    }
+    auto response = TRY(lookup_upstream(name, record_type));
 
     // Sixth, fail.
-    if (answers.is_empty()) {
+    if (!response.has_value()) {
         dbgln("Tried all nameservers but never got a response :(");
         return Vector<Answer> {};
     }
 
+    put_upstream_response_in_cache(name, record_type, *response);
+    for (auto& answer : response->answers)
+        add_answer(answer);
     return answers;
 }
 
-ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, ByteString const& nameserver, bool& did_get_response, RecordType record_type, ShouldRandomizeCase should_randomize_case)
+static ErrorOr<Packet> receive_response(Core::UDPSocket& socket, Packet const& request)
 {
-    Packet request;
-    request.set_is_query();
-    request.set_id(get_random_uniform(UINT16_MAX));
-    Name name_in_question = name;
-    if (should_randomize_case == ShouldRandomizeCase::Yes)
-        name_in_question.randomize_case();
-    request.add_question({ name_in_question, record_type, RecordClass::IN, false });
-
-    auto buffer = TRY(request.to_byte_buffer());
-
-    auto udp_socket = TRY(Core::UDPSocket::connect(nameserver, 53, Duration::from_seconds(1)));
-    TRY(udp_socket->set_blocking(true));
-
-    TRY(udp_socket->write_until_depleted(buffer));
-
     u8 response_buffer[4096];
-    auto nrecv = TRY(udp_socket->read_some({ response_buffer, sizeof(response_buffer) })).size();
-    if (udp_socket->is_eof())
-        return Vector<Answer> {};
-
-    did_get_response = true;
+    auto nrecv = TRY(socket.read_some({ response_buffer, sizeof(response_buffer) })).size();
+    if (socket.is_eof())
+        return Error::from_string_literal("Connection closed");
 
-    auto response_or_error = Packet::from_raw_packet({ response_buffer, nrecv });
-    if (response_or_error.is_error())
-        return Vector<Answer> {};
-
-    auto response = response_or_error.release_value();
+    auto response = TRY(Packet::from_raw_packet({ response_buffer, nrecv }));
 
     if (response.id() != request.id()) {
         dbgln("LookupServer: ID mismatch ({} vs {}) :(", response.id(), request.id());
-        return Vector<Answer> {};
+        return Error::from_string_literal("ID mismatch");
     }
 
-    if (response.code() == Packet::Code::REFUSED) {
-        if (should_randomize_case == ShouldRandomizeCase::Yes) {
-            // Retry with 0x20 case randomization turned off.
-            return lookup(name, nameserver, did_get_response, record_type, ShouldRandomizeCase::No);
-        }
-        return Vector<Answer> {};
-    }
+    // A refusal may not repeat the question.
+    if (response.code() == Packet::Code::REFUSED)
+        return response;
 
     if (response.question_count() != request.question_count()) {
         dbgln("LookupServer: Question count ({} vs {}) :(", response.question_count(), request.question_count());
-        return Vector<Answer> {};
+        return Error::from_string_literal("Question count mismatch");
     }
 
     // Verify the questions in our request and in their response match, ignoring case.
@@ -304,56 +266,263 @@ ErrorOr<Vector<Answer>> LookupServer::lookup(Name const& name, ByteString const&
             dbgln("Request and response questions do not match");
             dbgln("   Request: name=_{}_, type={}, class={}", request_question.name().as_string(), response_question.record_type(), response_question.class_code());
             dbgln("  Response: name=_{}_, type={}, class={}", response_question.name().as_string(), response_question.record_type(), response_question.class_code());
-            return Vector<Answer> {};
+            return Error::from_string_literal("Question mismatch");
         }
     }
 
-    if (response.answer_count() < 1) {
-        dbgln("LookupServer: No answers :(");
-        return Vector<Answer> {};
+    return response;
+}
+
+ErrorOr<Optional<LookupServer::UpstreamResponse>> LookupServer::lookup_upstream(Name const& name, RecordType record_type, ShouldRandomizeCase should_randomize_case)
+{
+    Packet request;
+    request.set_is_query();
+    request.set_id(get_random_uniform(UINT16_MAX));
+    Name name_in_question = name;
+    if (should_randomize_case == ShouldRandomizeCase::Yes)
+        name_in_question.randomize_case();
+    request.add_question({ name_in_question, record_type, RecordClass::IN, false });
+
+    auto buffer = TRY(request.to_byte_buffer());
+
+    struct Query {
+        ByteString nameserver;
+        NonnullOwnPtr<Core::UDPSocket> socket;
+    };
+
+    bool was_refused = false;
+    for (int attempt = 0; attempt < s_upstream_attempts; ++attempt) {
+        // Ask all nameservers at the same time, and go with the first one that answers.
+        Vector<Query> queries;
+        for (auto& nameserver : m_nameservers) {
+            dbgln_if(LOOKUPSERVER_DEBUG, "Doing lookup using nameserver '{}'", nameserver);
+            auto socket = Core::UDPSocket::connect(nameserver, 53, Duration::from_seconds(1));
+            if (socket.is_error()) {
+                dbgln("LookupServer: Failed to connect to nameserver '{}': {}", nameserver, socket.error());
+                continue;
+            }
+            if (auto result = socket.value()->write_until_depleted(buffer); result.is_error()) {
+                dbgln("LookupServer: Failed to send query to nameserver '{}': {}", nameserver, result.error());
+                continue;
+            }
+            TRY(queries.try_append({ nameserver, socket.release_value() }));
+        }
+        if (queries.is_empty())
+            break;
+
+        auto deadline = MonotonicTime::now() + Duration::from_milliseconds(s_upstream_timeout_milliseconds);
+        while (!queries.is_empty()) {
+            auto timeout = (deadline - MonotonicTime::now()).to_milliseconds();
+            if (timeout <= 0)
+                break;
+
+            Vector<pollfd> fds;
+            for (auto& query : queries)
+                TRY(fds.try_append({ query.socket->fd(), POLLIN, 0 }));
+            if (TRY(Core::System::poll(fds, static_cast<int>(timeout))) == 0)
+                break;
+
+            for (size_t i = queries.size(); i-- > 0;) {
+                if (fds[i].revents == 0)
+                    continue;
+                auto query = queries.take(i);
+                auto response_or_error = receive_response(*query.socket, request);
+                if (response_or_error.is_error()) {
+                    dbgln("LookupServer: Bad response from '{}': {}", query.nameserver, response_or_error.error());
+                    continue;
+                }
+                auto response = response_or_error.release_value();
+
+                switch (response.code()) {
+                case Packet::Code::NOERROR: {
+                    UpstreamResponse upstream_response;
+                    for (auto& answer : response.answers()) {
+                        put_in_cache(answer.name(), answer);
+                        if (answer.type() == record_type)
+                            TRY(upstream_response.answers.try_append(answer));
+                    }
+                    if (upstream_response.answers.is_empty())
+                        dbgln_if(LOOKUPSERVER_DEBUG, "'{}' has no {} records for {}", query.nameserver, record_type, name.as_string());
+                    return upstream_response;
+                }
+                case Packet::Code::NXDOMAIN:
+                    dbgln_if(LOOKUPSERVER_DEBUG, "'{}' says {} doesn't exist", query.nameserver, name.as_string());
+                    return UpstreamResponse {};
+                case Packet::Code::REFUSED:
+                    was_refused = true;
+                    break;
+                default:
+                    dbgln("Received response from '{}' but no result(s), trying other nameservers", query.nameserver);
+                    break;
+                }
+            }
+        }
+
+        // If everyone already gave up on the question, asking again won't help.
+        if (queries.is_empty())
+            break;
+        for (auto& query : queries)
+            dbgln("Never got a response from '{}'", query.nameserver);
+    }
+
+    if (was_refused && should_randomize_case == ShouldRandomizeCase::Yes) {
+        // Retry with 0x20 case randomization turned off.
+        return lookup_upstream(name, record_type, ShouldRandomizeCase::No);
+    }
+    return OptionalNone {};
+}
+
+Optional<Vector<Answer>> LookupServer::lookup_in_cache(Name const& name, RecordType record_type)
+{
+    auto it = m_lookup_cache.find(name);
+    if (it == m_lookup_cache.end())
+        return {};
+
+    auto& entry = it->value;
+    auto now = time(nullptr);
+    entry.last_used = now;
+    ++entry.hit_count;
+
+    if (auto negative_until = entry.negative_answers.get(record_type); negative_until.has_value()) {
+        if (now < *negative_until) {
+            dbgln_if(LOOKUPSERVER_DEBUG, "Negative cache hit: {} has no {} records", name.as_string(), record_type);
+            return Vector<Answer> {};
+        }
+        entry.negative_answers.remove(record_type);
     }
 
-    Vector<Answer, 8> answers;
-    for (auto& answer : response.answers()) {
-        put_in_cache(answer);
+    // mDNS names are only answered on demand, so there's nothing to refresh them from.
+    auto is_popular = entry.hit_count >= s_popular_hit_count && !name.as_string().ends_with(".local"sv);
+    auto should_prefetch = false;
+
+    Vector<Answer> answers;
+    for (auto& answer : entry.answers) {
         if (answer.type() != record_type)
             continue;
+        auto expiry_time = answer.received_time() + static_cast<time_t>(answer.ttl());
+        if (now >= expiry_time) {
+            if (!is_popular || now >= expiry_time + s_max_stale_seconds)
+                continue;
+            should_prefetch = true;
+        } else if (is_popular && (expiry_time - now) * 100 <= static_cast<time_t>(answer.ttl() * s_prefetch_ttl_percentage)) {
+            should_prefetch = true;
+        }
+        dbgln_if(LOOKUPSERVER_DEBUG, "Cache hit: {} -> {}", name.as_string(), answer.record_data());
         answers.append(answer);
     }
 
+    if (answers.is_empty())
+        return {};
+    if (should_prefetch)
+        prefetch(name, record_type);
     return answers;
 }
 
-void LookupServer::put_in_cache(Answer const& answer)
+void LookupServer::prefetch(Name const& name, RecordType record_type)
 {
-    if (answer.has_expired())
+    auto& entry = ensure_cache_entry(name);
+    if (entry.pending_prefetches.set(record_type) != HashSetResult::InsertedNewEntry)
         return;
 
-    // Prevent the cache from growing too big.
-    // TODO: Evict least used entries.
-    if (m_lookup_cache.size() >= 256)
-        m_lookup_cache.remove(m_lookup_cache.begin());
+    dbgln_if(LOOKUPSERVER_DEBUG, "Prefetching {} records for {}", record_type, name.as_string());
 
-    auto it = m_lookup_cache.find(answer.name());
-    if (it == m_lookup_cache.end())
-        m_lookup_cache.set(answer.name(), { answer });
-    else {
-        if (answer.mdns_cache_flush()) {
-            auto now = time(nullptr);
+    // The lookup that needed this has been answered from the cache by the time we get back to the event loop.
+    deferred_invoke([this, name, record_type] {
+        auto response = lookup_upstream(name, record_type);
+        if (auto it = m_lookup_cache.find(name); it != m_lookup_cache.end())
+            it->value.pending_prefetches.remove(record_type);
 
-            it->value.remove_all_matching([&](Answer const& other_answer) {
-                if (other_answer.type() != answer.type() || other_answer.class_code() != answer.class_code())
-                    return false;
+        if (response.is_error()) {
+            dbgln("LookupServer: Failed to prefetch {}: {}", name.as_string(), response.error());
+            return;
+        }
+        if (response.value().has_value())
+            put_upstream_response_in_cache(name, record_type, *response.value());
+    });
+}
+
+auto LookupServer::ensure_cache_entry(Name const& name) -> CacheEntry&
+{
+    if (auto it = m_lookup_cache.find(name); it != m_lookup_cache.end())
+        return it->value;
 
-                if (other_answer.received_time() >= now - 1)
-                    return false;
+    evict_from_cache_if_needed();
+    auto& entry = m_lookup_cache.ensure(name, [] { return CacheEntry {}; });
+    entry.last_used = time(nullptr);
+    return entry;
+}
+
+void LookupServer::evict_from_cache_if_needed()
+{
+    if (m_lookup_cache.size() < s_max_cache_entries)
+        return;
 
-                dbgln_if(LOOKUPSERVER_DEBUG, "Removing cache entry: {}", other_answer.name());
-                return true;
-            });
+    // First, get rid of everything that can't be used anymore.
+    auto now = time(nullptr);
+    m_lookup_cache.remove_all_matching([&](auto const&, CacheEntry& entry) {
+        entry.answers.remove_all_matching([&](Answer const& answer) {
+            return now >= static_cast<time_t>(answer.received_time() + answer.ttl() + s_max_stale_seconds);
+        });
+        entry.negative_answers.remove_all_matching([&](auto, time_t until) { return now >= until; });
+        return entry.answers.is_empty() && entry.negative_answers.is_empty() && entry.pending_prefetches.is_empty();
+    });
+
+    // If that wasn't enough, make room by dropping the names that haven't been looked up for the longest time.
+    while (m_lookup_cache.size() >= s_max_cache_entries) {
+        auto least_recently_used = m_lookup_cache.begin();
+        for (auto it = m_lookup_cache.begin(); it != m_lookup_cache.end(); ++it) {
+            if (it->value.last_used < least_recently_used->value.last_used)
+                least_recently_used = it;
         }
-        it->value.append(answer);
+        dbgln_if(LOOKUPSERVER_DEBUG, "Evicting cache entry: {}", least_recently_used->key.as_string());
+        m_lookup_cache.remove(least_recently_used);
+    }
+}
+
+void LookupServer::put_upstream_response_in_cache(Name const& name, RecordType record_type, UpstreamResponse const& response)
+{
+    // The response replaces whatever we knew about these records before.
+    auto& entry = ensure_cache_entry(name);
+    entry.answers.remove_all_matching([&](Answer const& answer) { return answer.type() == record_type; });
+
+    if (response.answers.is_empty()) {
+        entry.negative_answers.set(record_type, time(nullptr) + s_negative_ttl);
+        return;
     }
+
+    // Answers are also cached under the name that was asked for, so that aliases (CNAMEs) are found in the cache too.
+    for (auto& answer : response.answers)
+        put_in_cache(name, answer);
+}
+
+void LookupServer::put_in_cache(Name const& name, Answer const& answer)
+{
+    if (answer.has_expired())
+        return;
+
+    auto& entry = ensure_cache_entry(name);
+    entry.negative_answers.remove(answer.type());
+
+    if (answer.mdns_cache_flush()) {
+        auto now = time(nullptr);
+
+        entry.answers.remove_all_matching([&](Answer const& other_answer) {
+            if (other_answer.type() != answer.type() || other_answer.class_code() != answer.class_code())
+                return false;
+
+            if (other_answer.received_time() >= now - 1)
+                return false;
+
+            dbgln_if(LOOKUPSERVER_DEBUG, "Removing cache entry: {}", other_answer.name());
+            return true;
+        });
+    }
+
+    // A fresh copy of a record replaces the old one.
+    entry.answers.remove_all_matching([&](Answer const& other_answer) {
+        return other_answer.type() == answer.type() && other_answer.class_code() == answer.class_code() && other_answer.record_data() == answer.record_data();
+    });
+    entry.answers.append(answer);
 }
 
 }
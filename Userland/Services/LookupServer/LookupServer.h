@@ -9,6 +9,7 @@
 #include "ConnectionFromClient.h"
 #include "DNSServer.h"
 #include "MulticastDNS.h"
+#include <AK/HashTable.h>
 #include <LibCore/EventReceiver.h>
 #include <LibCore/FileWatcher.h>
 #include <LibDNS/Name.h>
@@ -29,11 +30,33 @@ public:
 private:
     LookupServer();
 
+    struct CacheEntry {
+        Vector<Answer> answers;
+        // Record types that the nameservers told us this name doesn't have (or that the name doesn't exist at all),
+        // mapped to the time until which we believe them.
+        HashMap<RecordType, time_t> negative_answers;
+        // Record types that are being looked up again because their answers are about to expire.
+        HashTable<RecordType> pending_prefetches;
+        time_t last_used { 0 };
+        u32 hit_count { 0 };
+    };
+
+    // The answer of the first nameserver that gave one; an empty list of answers means that the name has no such records.
+    struct UpstreamResponse {
+        Vector<Answer> answers;
+    };
+
     ErrorOr<HashMap<Name, Vector<Answer>, Name::Traits>> try_load_etc_hosts();
     void load_etc_hosts();
-    void put_in_cache(Answer const&);
 
-    ErrorOr<Vector<Answer>> lookup(Name const& hostname, ByteString const& nameserver, bool& did_get_response, RecordType record_type, ShouldRandomizeCase = ShouldRandomizeCase::Yes);
+    Optional<Vector<Answer>> lookup_in_cache(Name const&, RecordType);
+    CacheEntry& ensure_cache_entry(Name const&);
+    void put_in_cache(Name const&, Answer const&);
+    void put_upstream_response_in_cache(Name const&, RecordType, UpstreamResponse const&);
+    void evict_from_cache_if_needed();
+    void prefetch(Name const&, RecordType);
+
+    ErrorOr<Optional<UpstreamResponse>> lookup_upstream(Name const&, RecordType, ShouldRandomizeCase = ShouldRandomizeCase::Yes);
 
     OwnPtr<IPC::MultiServer<ConnectionFromClient>> m_server;
     RefPtr<DNSServer> m_dns_server;
@@ -41,7 +64,7 @@ private:
     Vector<ByteString> m_nameservers;
     RefPtr<Core::FileWatcher> m_file_watcher;
     HashMap<Name, Vector<Answer>, Name::Traits> m_etc_hosts;
-    HashMap<Name, Vector<Answer>, Name::Traits> m_lookup_cache;
+    HashMap<Name, CacheEntry, Name::Traits> m_lookup_cache;
 };
 
 }
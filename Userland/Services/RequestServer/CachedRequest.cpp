@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <RequestServer/CachedRequest.h>
+
+namespace RequestServer {
+
+ErrorOr<NonnullOwnPtr<CachedRequest>> CachedRequest::create(ConnectionFromClient& client, DiskCache::CachedResponse cached_response, i32 request_id)
+{
+    auto fds = TRY(Core::System::pipe2(O_NONBLOCK));
+    auto output_stream = TRY(Core::File::adopt_fd(fds[1], Core::File::OpenMode::Write));
+
+    auto request = adopt_own(*new CachedRequest(client, move(output_stream), move(cached_response), request_id));
+    request->set_request_fd(fds[0]);
+    return request;
+}
+
+CachedRequest::CachedRequest(ConnectionFromClient& client, NonnullOwnPtr<Core::File>&& output_stream, DiskCache::CachedResponse cached_response, i32 request_id)
+    : Request(client, move(output_stream), request_id)
+    , m_url(cached_response.url)
+{
+    auto status_code = cached_response.status_code;
+    auto response_headers = cached_response.response_headers;
+    set_cached_response(move(cached_response));
+
+    // NOTE: The client has to be told about the request before it can receive anything for it.
+    Core::deferred_invoke([this, status_code, response_headers = move(response_headers)]() mutable {
+        set_status_code(status_code);
+        set_response_headers(move(response_headers));
+        write_cached_response_body();
+    });
+}
+
+}
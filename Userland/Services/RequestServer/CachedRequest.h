@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <RequestServer/DiskCache.h>
+#include <RequestServer/Request.h>
+
+namespace RequestServer {
+
+// A request that is served entirely from a fresh response in the disk cache, without touching the network.
+class CachedRequest final : public Request {
+public:
+    static ErrorOr<NonnullOwnPtr<CachedRequest>> create(ConnectionFromClient&, DiskCache::CachedResponse, i32 request_id);
+    virtual ~CachedRequest() override = default;
+
+    virtual URL::URL url() const override { return m_url; }
+
+private:
+    CachedRequest(ConnectionFromClient&, NonnullOwnPtr<Core::File>&&, DiskCache::CachedResponse, i32 request_id);
+
+    URL::URL m_url;
+};
+
+}
@@ -7,6 +7,7 @@
 #include "ConnectionCache.h"
 #include <AK/Debug.h>
 #include <AK/Find.h>
+#include <AK/ScopeGuard.h>
 #include <LibCore/EventLoop.h>
 
 namespace RequestServer::ConnectionCache {
@@ -14,6 +15,7 @@ namespace RequestServer::ConnectionCache {
 Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<Core::TCPSocket, Core::Socket>>>>>> g_tcp_connection_cache {};
 Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<TLS::TLSv12>>>>>> g_tls_connection_cache {};
 Threading::RWLockProtected<HashMap<ByteString, InferredServerProperties>> g_inferred_server_properties;
+NonnullRefPtr<TLS::SessionCache> g_tls_session_cache = TLS::SessionCache::create();
 
 void request_did_finish(URL::URL const& url, Core::Socket const* socket)
 {
@@ -101,6 +103,14 @@ void request_did_finish(URL::URL const& url, Core::Socket const* socket)
                 connection->job_data->timing_info.starting_connection += Duration::from_milliseconds(timer.elapsed_milliseconds());
             }
 
+            // The new socket may have picked HTTP/2, in which case the rest of the queue runs as its streams.
+            if constexpr (IsSame<RemoveCVReference<decltype(*connection)>, Connection<TLS::TLSv12>>) {
+                if (connection->http2_connection) {
+                    co_await run_queued_http2_requests(*connection, url);
+                    co_return;
+                }
+            }
+
             connection->has_started = true;
             Core::deferred_invoke([&connection = *connection, &cache, url] {
                 cache.with_read_locked([&](auto&) {
@@ -127,6 +137,131 @@ void request_did_finish(URL::URL const& url, Core::Socket const* socket)
         dbgln("Unknown socket {} finished for URL {}", socket, url);
 }
 
+void set_alpn_protocols(TLS::Options& options, URL::URL const& url)
+{
+    // Other protocols that run over TLS (like Gemini) have nothing to negotiate.
+    if (url.scheme() == "https"sv)
+        options.set_alpn_protocols({ "h2", "http/1.1" });
+}
+
+void start_http2_connection(Connection<TLS::TLSv12>& connection)
+{
+    dbgln_if(REQUESTSERVER_DEBUG, "Connection {} uses HTTP/2", &connection);
+
+    connection.http2_connection = make<HTTP::Http2Connection>([&connection](ReadonlyBytes bytes) {
+        if (!connection.socket)
+            return;
+        if (auto result = connection.socket->write_until_depleted(bytes); result.is_error()) {
+            dbgln("ConnectionCache: Failed to write to HTTP/2 connection {}: {}", &connection, result.error());
+            connection.socket->close();
+        }
+    });
+    connection.http2_connection->on_stream_closed = [&connection] {
+        Core::deferred_invoke([&connection] {
+            Core::EventLoop::current().adopt_coroutine(run_queued_http2_requests(connection, connection.current_url));
+        });
+    };
+
+    connection.socket->on_ready_to_read = [&connection] {
+        auto& http2_connection = *connection.http2_connection;
+        Array<u8, 16 * KiB> buffer;
+        while (true) {
+            auto can_read = connection.socket->can_read_without_blocking();
+            if (can_read.is_error() || !can_read.value())
+                break;
+            auto bytes = connection.socket->read_some(buffer);
+            if (bytes.is_error() || bytes.value().is_empty())
+                break;
+            http2_connection.receive(bytes.value());
+            if (http2_connection.is_closed())
+                return;
+        }
+
+        if (connection.socket->is_eof() || !connection.socket->is_open()) {
+            connection.socket->on_ready_to_read = nullptr;
+            http2_connection.did_close_transport();
+        }
+    };
+    connection.socket->set_notifications_enabled(true);
+    connection.http2_connection->start();
+}
+
+Coroutine<void> run_queued_http2_requests(Connection<TLS::TLSv12>& connection, URL::URL url)
+{
+    connection.current_url = url;
+    if (connection.is_being_started)
+        co_return;
+    connection.is_being_started = true;
+    ScopeGuard started = [&] { connection.is_being_started = false; };
+
+    auto has_queued_requests = [&] {
+        return !connection.request_queue.with_read_locked([](auto& queue) { return queue.is_empty(); });
+    };
+
+    // A connection that the server is shutting down is replaced by a new one once all of its streams are done.
+    if (connection.http2_connection && !connection.http2_connection->can_accept_streams() && connection.http2_connection->open_stream_count() == 0) {
+        connection.http2_connection = nullptr;
+        connection.socket = nullptr;
+    }
+
+    if (!connection.http2_connection && has_queued_requests()) {
+        if (auto result = co_await recreate_socket_if_needed(connection, url); result.is_error()) {
+            dbgln("ConnectionCache: Failed to reconnect for HTTP/2 requests to {}: {}", url, result.error());
+            auto jobs = connection.request_queue.with_write_locked([](auto& queue) { return move(queue); });
+            for (auto& job : jobs)
+                job.fail(Core::NetworkJob::Error::ConnectionFailed);
+            connection.has_started = false;
+            co_return;
+        }
+
+        // The server doesn't speak HTTP/2 anymore, so go back to running one request at a time.
+        if (!connection.http2_connection) {
+            connection.has_started = true;
+            connection.timer.start();
+            connection.job_data = connection.request_queue.with_write_locked([](auto& queue) { return queue.take_first(); });
+            connection.socket->set_notifications_enabled(true);
+            connection.job_data->start(*connection.socket);
+            co_return;
+        }
+    }
+
+    if (connection.http2_connection) {
+        while (connection.http2_connection->can_open_stream() && has_queued_requests()) {
+            auto job_data = connection.request_queue.with_write_locked([](auto& queue) { return queue.take_first(); });
+            dbgln_if(REQUESTSERVER_DEBUG, "Open HTTP/2 stream on connection {}", &connection);
+            job_data.start_http2(*connection.http2_connection);
+        }
+    }
+
+    connection.has_started = has_queued_requests() || (connection.http2_connection && connection.http2_connection->open_stream_count() > 0);
+    if (connection.has_started) {
+        connection.removal_timer->stop();
+        co_return;
+    }
+
+    connection.removal_timer->on_timeout = [ptr = &connection] {
+        Core::deferred_invoke([ptr] {
+            if (ptr->has_started)
+                return;
+
+            dbgln_if(REQUESTSERVER_DEBUG, "Removing no-longer-used HTTP/2 connection {} (socket {})", ptr, ptr->socket);
+            g_tls_connection_cache.with_write_locked([&](auto& cache) {
+                Optional<ConnectionKey> empty_key;
+                for (auto& [key, entry] : cache) {
+                    if (entry->remove_first_matching([&](auto& connection) { return connection == ptr; })) {
+                        if (entry->is_empty())
+                            empty_key = key;
+                        break;
+                    }
+                }
+                if (empty_key.has_value())
+                    cache.remove(*empty_key);
+            });
+        });
+    };
+    connection.removal_timer->start();
+}
+
 void dump_jobs()
 {
     dbgln("=========== TLS Connection Cache ==========");
@@ -16,6 +16,7 @@
 #include <LibCore/NetworkJob.h>
 #include <LibCore/SOCKSProxyClient.h>
 #include <LibCore/Timer.h>
+#include <LibHTTP/Http2Connection.h>
 #include <LibTLS/TLSv12.h>
 #include <LibThreading/RWLockProtected.h>
 #include <LibURL/URL.h>
@@ -63,6 +64,7 @@ struct JobData {
     Function<void(Core::BufferedSocketBase&)> start {};
     Function<void(Core::NetworkJob::Error)> fail {};
     Function<Vector<TLS::Certificate>()> provide_client_certificates {};
+    Function<void(HTTP::Http2Connection&)> start_http2 {};
 #if REQUESTSERVER_DEBUG
     struct {
         bool valid { true };
@@ -87,6 +89,7 @@ struct JobData {
         : start(move(other.start))
         , fail(move(other.fail))
         , provide_client_certificates(move(other.provide_client_certificates))
+        , start_http2(move(other.start_http2))
         , timing_info(move(other.timing_info))
     {
         other.timing_info.valid = false;
@@ -96,10 +99,12 @@ struct JobData {
         Function<void(Core::BufferedSocketBase&)> start,
         Function<void(Core::NetworkJob::Error)> fail,
         Function<Vector<TLS::Certificate>()> provide_client_certificates,
+        Function<void(HTTP::Http2Connection&)> start_http2,
         decltype(timing_info) timing_info)
         : start(move(start))
         , fail(move(fail))
         , provide_client_certificates(move(provide_client_certificates))
+        , start_http2(move(start_http2))
         , timing_info(move(timing_info))
     {
     }
@@ -120,6 +125,15 @@ struct JobData {
                     (void)job;
                 }
                 return Vector<TLS::Certificate> {}; },
+            /* .start_http2 = */ [job](HTTP::Http2Connection& connection) {
+                // Only HTTPS connections ever use HTTP/2.
+                if constexpr (requires { job->start(connection); }) {
+                    job->start(connection);
+                } else {
+                    (void)job;
+                    (void)connection;
+                    VERIFY_NOT_REACHED();
+                } },
 #if REQUESTSERVER_DEBUG
             /* .timing_info = */ {
                 .timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise),
@@ -146,6 +160,9 @@ struct Connection {
     Optional<JobData> job_data {};
     Proxy proxy {};
     size_t max_queue_length { 0 };
+    // Set if the server chose HTTP/2 for this connection, in which case its queued requests all run at the same time, as
+    // streams of the connection.
+    OwnPtr<HTTP::Http2Connection> http2_connection {};
 };
 
 struct ConnectionKey {
@@ -174,10 +191,15 @@ struct InferredServerProperties {
 extern Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<Core::TCPSocket, Core::Socket>>>>>> g_tcp_connection_cache;
 extern Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<TLS::TLSv12>>>>>> g_tls_connection_cache;
 extern Threading::RWLockProtected<HashMap<ByteString, InferredServerProperties>> g_inferred_server_properties;
+extern NonnullRefPtr<TLS::SessionCache> g_tls_session_cache;
 
 void request_did_finish(URL::URL const&, Core::Socket const*);
 void dump_jobs();
 
+void set_alpn_protocols(TLS::Options&, URL::URL const&);
+void start_http2_connection(Connection<TLS::TLSv12>&);
+Coroutine<void> run_queued_http2_requests(Connection<TLS::TLSv12>&, URL::URL);
+
 constexpr static size_t MaxConcurrentConnectionsPerURL = 4;
 constexpr static size_t ConnectionKeepAliveTimeMilliseconds = 10'000;
 constexpr static size_t ConnectionCacheQueueHighWatermark = 4;
@@ -189,6 +211,7 @@ Coroutine<ErrorOr<void>> recreate_socket_if_needed(T& connection, URL::URL const
     using SocketStorageType = typename T::StorageType;
 
     if (!connection.socket || !connection.socket->is_open() || connection.socket->is_eof()) {
+        connection.http2_connection = nullptr;
         connection.socket = nullptr;
         // Create another socket for the connection.
         auto set_socket = [&](NonnullOwnPtr<SocketStorageType>&& socket) -> ErrorOr<void> {
@@ -207,15 +230,21 @@ Coroutine<ErrorOr<void>> recreate_socket_if_needed(T& connection, URL::URL const
                 else
                     reason = Core::NetworkJob::Error::TransmissionFailed;
 
-                if (connection.job_data->fail)
+                if (connection.job_data.has_value() && connection.job_data->fail)
                     connection.job_data->fail(reason);
             });
             options.set_certificate_provider([&connection]() -> Vector<TLS::Certificate> {
-                if (connection.job_data->provide_client_certificates)
+                if (connection.job_data.has_value() && connection.job_data->provide_client_certificates)
                     return connection.job_data->provide_client_certificates();
                 return {};
             });
-            CO_TRY(set_socket(CO_TRY(co_await (connection.proxy.template tunnel<SocketType, SocketStorageType>(url, move(options))))));
+            options.set_session_cache(g_tls_session_cache);
+            set_alpn_protocols(options, url);
+            auto socket = CO_TRY(co_await (connection.proxy.template tunnel<SocketType, SocketStorageType>(url, move(options))));
+            auto use_http2 = socket->alpn() == "h2"sv;
+            CO_TRY(set_socket(move(socket)));
+            if (use_http2)
+                start_http2_connection(connection);
         } else {
             CO_TRY(set_socket(CO_TRY(co_await (connection.proxy.template tunnel<SocketType, SocketStorageType>(url)))));
         }
@@ -235,6 +264,23 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
         return map.ensure({ move(hostname), url.port_or_default(), proxy_data }, [] { return make<CacheEntryType>(); }).ptr();
     });
 
+    using ConnectionType = RemoveCVReference<decltype(*declval<CacheEntryType>().at(0))>;
+    if constexpr (IsSame<typename ConnectionType::SocketType, TLS::TLSv12>) {
+        // A server that speaks HTTP/2 gets all requests on the same connection, instead of having them wait for each other.
+        auto http2_it = cache.with_read_locked([&](auto&) {
+            return sockets_for_url.find_if([](auto& connection) {
+                return connection->http2_connection && connection->http2_connection->can_accept_streams();
+            });
+        });
+        if (!http2_it.is_end()) {
+            auto& connection = **http2_it;
+            dbgln_if(REQUESTSERVER_DEBUG, "Run request for URL {} as a stream of HTTP/2 connection {}", url, &connection);
+            connection.request_queue.with_write_locked([&](auto& queue) { queue.append(JobData::create(job)); });
+            co_await run_queued_http2_requests(connection, move(url));
+            co_return;
+        }
+    }
+
     // Find the connection with an empty queue; if none exist, we'll find the least backed-up connection later.
     // Note that servers that are known to serve a single request per connection (e.g. HTTP/1.0) usually have
     // issues with concurrent connections, so we'll only allow one connection per URL in that case to avoid issues.
@@ -253,7 +299,6 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
 
     auto start_timer = Core::ElapsedTimer::start_new();
     if (failed_to_find_a_socket && sockets_for_url.size() < ConnectionCache::MaxConcurrentConnectionsPerURL) {
-        using ConnectionType = RemoveCVReference<decltype(*declval<CacheEntryType>().at(0))>;
         cache.with_write_locked([&](auto&) {
             sockets_for_url.append(make<ConnectionType>(
                 nullptr,
@@ -267,7 +312,16 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
             socket_for_url->is_being_started = false;
         };
 
-        auto connection_result = co_await proxy.tunnel<typename ConnectionType::SocketType, typename ConnectionType::StorageType>(url);
+        auto connection_result = co_await [&] {
+            if constexpr (IsSame<typename ConnectionType::SocketType, TLS::TLSv12>) {
+                TLS::Options options;
+                options.set_session_cache(g_tls_session_cache);
+                set_alpn_protocols(options, url);
+                return proxy.tunnel<typename ConnectionType::SocketType, typename ConnectionType::StorageType>(url, move(options));
+            } else {
+                return proxy.tunnel<typename ConnectionType::SocketType, typename ConnectionType::StorageType>(url);
+            }
+        }();
         if (connection_result.is_error()) {
             dbgln("ConnectionCache: Connection to {} failed: {}", url, connection_result.error());
             Core::deferred_invoke([job] {
@@ -275,6 +329,9 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
             });
             co_return;
         }
+        auto use_http2 = false;
+        if constexpr (IsSame<typename ConnectionType::SocketType, TLS::TLSv12>)
+            use_http2 = connection_result.value()->alpn() == "h2"sv;
         auto socket_result = Core::BufferedSocket<typename ConnectionType::StorageType>::create(connection_result.release_value());
         if (socket_result.is_error()) {
             dbgln("ConnectionCache: Failed to make a buffered socket for {}: {}", url, socket_result.error());
@@ -286,6 +343,10 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
 
         socket_for_url->socket = socket_result.release_value();
         socket_for_url->proxy = move(proxy);
+        if constexpr (IsSame<typename ConnectionType::SocketType, TLS::TLSv12>) {
+            if (use_http2)
+                start_http2_connection(*socket_for_url);
+        }
         did_add_new_connection = true;
     }
     if (failed_to_find_a_socket) {
@@ -340,6 +401,14 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
                         job->fail(Core::NetworkJob::Error::ConnectionFailed);
                     });
                 } else {
+                    if constexpr (IsSame<typename ConnectionType::SocketType, TLS::TLSv12>) {
+                        if (connection.http2_connection) {
+                            dbgln_if(REQUESTSERVER_DEBUG, "Start request for url {} as a stream of HTTP/2 connection {}", url, &connection);
+                            connection.request_queue.with_write_locked([&](auto& queue) { queue.prepend(JobData::create(job)); });
+                            co_await run_queued_http2_requests(connection, url);
+                            co_return;
+                        }
+                    }
                     dbgln_if(REQUESTSERVER_DEBUG, "Immediately start request for url {} in {} - {}", url, &connection, connection.socket);
                     connection.removal_timer->stop();
                     connection.timer.start();
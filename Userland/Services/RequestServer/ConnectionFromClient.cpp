@@ -13,7 +13,9 @@
 #include <LibCore/Socket.h>
 #include <LibWebSocket/ConnectionInfo.h>
 #include <LibWebSocket/Message.h>
+#include <RequestServer/CachedRequest.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/Protocol.h>
 #include <RequestServer/Request.h>
 #include <RequestServer/RequestClientEndpoint.h>
@@ -162,7 +164,29 @@ void ConnectionFromClient::worker_do_work(Work work)
                 (void)post_message(Messages::RequestClient::RequestFinished(start_request.request_id, false, 0));
                 return;
             }
-            auto request = protocol->start_request(start_request.request_id, *this, start_request.method, start_request.url, start_request.request_headers, start_request.request_body, start_request.proxy_data);
+
+            OwnPtr<Request> request;
+            auto* disk_cache = start_request.url.scheme().is_one_of("http"sv, "https"sv) ? DiskCache::the() : nullptr;
+            auto cached_response = disk_cache ? disk_cache->open_response(start_request.method, start_request.url, start_request.request_headers) : Optional<DiskCache::CachedResponse> {};
+
+            if (cached_response.has_value() && cached_response->is_fresh) {
+                if (auto cached_request = CachedRequest::create(*this, cached_response.release_value(), start_request.request_id); !cached_request.is_error())
+                    request = cached_request.release_value();
+            } else {
+                // https://httpwg.org/specs/rfc9111.html#validation.sent
+                auto request_headers = start_request.request_headers;
+                if (cached_response.has_value()) {
+                    if (cached_response->entity_tag.has_value())
+                        request_headers.set("If-None-Match", *cached_response->entity_tag);
+                    if (cached_response->last_modified.has_value())
+                        request_headers.set("If-Modified-Since", *cached_response->last_modified);
+                }
+
+                request = protocol->start_request(start_request.request_id, *this, start_request.method, start_request.url, request_headers, start_request.request_body, start_request.proxy_data);
+                if (request && disk_cache)
+                    request->set_disk_cache_request(start_request.method, start_request.request_headers, move(cached_response));
+            }
+
             if (!request) {
                 dbgln("StartRequest: Protocol handler failed to start request: '{}'", start_request.url);
                 auto lock = Threading::MutexLocker(m_ipc_mutex);
@@ -212,6 +236,11 @@ void ConnectionFromClient::die()
     s_connections.remove(client_id);
     s_client_ids.deallocate(client_id);
 
+    if (auto* disk_cache = DiskCache::the()) {
+        if (auto result = disk_cache->flush_index(); result.is_error())
+            dbgln("DiskCache: Failed to write the index: {}", result.error());
+    }
+
     if (s_connections.is_empty())
         Core::EventLoop::current().quit(0);
 }
@@ -431,6 +460,13 @@ void ConnectionFromClient::dump_connection_info()
     ConnectionCache::dump_jobs();
 }
 
+Messages::RequestServer::DiskCacheStatisticsResponse ConnectionFromClient::disk_cache_statistics()
+{
+    if (auto* disk_cache = DiskCache::the())
+        return disk_cache->statistics_as_json();
+    return ByteString {};
+}
+
 void ConnectionFromClient::destroy_thread_pool()
 {
     s_thread_pool.clear();
@@ -83,6 +83,7 @@ private:
     virtual Messages::RequestServer::WebsocketSetCertificateResponse websocket_set_certificate(i32, ByteString const&, ByteString const&) override;
 
     virtual void dump_connection_info() override;
+    virtual Messages::RequestServer::DiskCacheStatisticsResponse disk_cache_statistics() override;
 
     Threading::MutexProtected<HashMap<i32, OwnPtr<Request>>> m_requests;
     HashMap<i32, RefPtr<WebSocket::WebSocket>> m_websockets;
@@ -0,0 +1,607 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteReader.h>
+#include <AK/Debug.h>
+#include <AK/Endian.h>
+#include <AK/JsonObject.h>
+#include <AK/MemoryStream.h>
+#include <AK/QuickSort.h>
+#include <AK/Time.h>
+#include <LibCore/DateTime.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <RequestServer/DiskCache.h>
+
+namespace RequestServer {
+
+static OwnPtr<DiskCache> s_the;
+
+static constexpr u32 entry_magic = 0x45435352; // "RSCE"
+
+ErrorOr<void> DiskCache::initialize(ByteString directory, u64 maximum_size)
+{
+    VERIFY(!s_the);
+
+    TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
+
+    auto cache = adopt_own(*new DiskCache(move(directory), maximum_size));
+    if (auto result = cache->load_index(); result.is_error())
+        dbgln("DiskCache: Starting with an empty cache, could not load the index: {}", result.error());
+
+    s_the = move(cache);
+    return {};
+}
+
+DiskCache* DiskCache::the()
+{
+    return s_the.ptr();
+}
+
+DiskCache::DiskCache(ByteString directory, u64 maximum_size)
+    : m_directory(move(directory))
+    , m_maximum_size(maximum_size)
+{
+}
+
+DiskCache::~DiskCache()
+{
+    if (auto result = flush_index(); result.is_error())
+        dbgln("DiskCache: Failed to write the index: {}", result.error());
+}
+
+static i64 now_in_seconds()
+{
+    return UnixDateTime::now().seconds_since_epoch();
+}
+
+// https://httpwg.org/specs/rfc9110.html#http.date
+static Optional<i64> parse_http_date(StringView date)
+{
+    // NOTE: Only the preferred IMF-fixdate format is supported, the obsolete formats are rarely seen in practice.
+    auto date_time = Core::DateTime::parse("%a, %d %b %Y %H:%M:%S %Z"sv, date.trim_whitespace());
+    if (!date_time.has_value())
+        return {};
+    return static_cast<i64>(date_time->timestamp());
+}
+
+// https://httpwg.org/specs/rfc9111.html#field.cache-control
+struct CacheControl {
+    bool no_store { false };
+    bool no_cache { false };
+    Optional<i64> max_age;
+
+    static CacheControl parse(HTTP::HeaderMap const& headers)
+    {
+        CacheControl cache_control;
+
+        auto value = headers.get("Cache-Control"sv);
+        if (!value.has_value()) {
+            // https://httpwg.org/specs/rfc9111.html#field.pragma
+            // When the Cache-Control header field is not present in a request, caches MUST consider the no-cache
+            // request pragma directive as having the same effect as if "Cache-Control: no-cache" were present.
+            if (auto pragma = headers.get("Pragma"sv); pragma.has_value() && pragma->contains("no-cache"sv, CaseSensitivity::CaseInsensitive))
+                cache_control.no_cache = true;
+            return cache_control;
+        }
+
+        value->view().for_each_split_view(',', SplitBehavior::Nothing, [&](StringView directive) {
+            directive = directive.trim_whitespace();
+
+            auto name = directive;
+            Optional<StringView> argument;
+            if (auto equals = directive.find('='); equals.has_value()) {
+                name = directive.substring_view(0, *equals).trim_whitespace();
+                argument = directive.substring_view(*equals + 1).trim_whitespace().trim("\""sv);
+            }
+
+            if (name.equals_ignoring_ascii_case("no-store"sv))
+                cache_control.no_store = true;
+            else if (name.equals_ignoring_ascii_case("no-cache"sv))
+                cache_control.no_cache = true;
+            else if (name.equals_ignoring_ascii_case("max-age"sv) && argument.has_value())
+                cache_control.max_age = argument->to_number<i64>();
+        });
+
+        return cache_control;
+    }
+};
+
+// https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+static bool is_heuristically_cacheable(u32 status_code)
+{
+    // https://httpwg.org/specs/rfc9110.html#overview.of.status.codes
+    switch (status_code) {
+    case 200:
+    case 203:
+    case 204:
+    case 300:
+    case 301:
+    case 308:
+    case 404:
+    case 405:
+    case 410:
+    case 414:
+    case 501:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// https://httpwg.org/specs/rfc9111.html#expiration.model
+static i64 compute_expiration_time(u32 status_code, HTTP::HeaderMap const& response_headers, i64 response_time)
+{
+    auto cache_control = CacheControl::parse(response_headers);
+
+    auto date_value = response_headers.get("Date"sv).map([](auto const& date) { return parse_http_date(date); }).value_or({}).value_or(response_time);
+
+    // https://httpwg.org/specs/rfc9111.html#age.calculations
+    auto age_value = response_headers.get("Age"sv).map([](auto const& age) { return age.view().template to_number<i64>(); }).value_or({}).value_or(0);
+    auto apparent_age = max<i64>(0, response_time - date_value);
+    auto corrected_initial_age = max(apparent_age, age_value);
+
+    // https://httpwg.org/specs/rfc9111.html#calculating.freshness.lifetime
+    i64 freshness_lifetime = 0;
+    if (cache_control.no_cache) {
+        // The no-cache response directive means the response must not be reused without successful validation.
+        freshness_lifetime = 0;
+    } else if (cache_control.max_age.has_value()) {
+        freshness_lifetime = *cache_control.max_age;
+    } else if (auto expires = response_headers.get("Expires"sv); expires.has_value()) {
+        // A cache recipient MUST interpret invalid date formats, especially the value "0", as representing a time in
+        // the past (i.e., "already expired").
+        auto expires_value = parse_http_date(*expires);
+        freshness_lifetime = expires_value.has_value() ? *expires_value - date_value : 0;
+    } else if (auto last_modified = response_headers.get("Last-Modified"sv); last_modified.has_value() && is_heuristically_cacheable(status_code)) {
+        // If the response has a Last-Modified header field, caches are encouraged to use a heuristic expiration value
+        // that is no more than some fraction of the interval since that time. A typical setting of this fraction might
+        // be 10%.
+        static constexpr i64 maximum_heuristic_freshness_lifetime = 24 * 60 * 60;
+        if (auto last_modified_value = parse_http_date(*last_modified); last_modified_value.has_value())
+            freshness_lifetime = min(max<i64>(0, date_value - *last_modified_value) / 10, maximum_heuristic_freshness_lifetime);
+    }
+
+    return response_time + freshness_lifetime - corrected_initial_age;
+}
+
+u64 DiskCache::key_for_url(URL::URL const& url)
+{
+    auto serialized_url = url.serialize(URL::ExcludeFragment::Yes);
+    auto digest = Crypto::Hash::SHA256::hash(serialized_url.bytes());
+
+    u64 key = 0;
+    ByteReader::load(digest.immutable_data(), key);
+    return key;
+}
+
+ByteString DiskCache::path_for_key(u64 key) const
+{
+    return ByteString::formatted("{}/{:016x}", m_directory, key);
+}
+
+ErrorOr<void> DiskCache::load_index()
+{
+    auto index_file = TRY(Core::MappedFile::map(ByteString::formatted("{}/index", m_directory)));
+    auto bytes = index_file->bytes();
+
+    if (bytes.size() < sizeof(IndexHeader))
+        return Error::from_string_literal("Index is too small");
+
+    IndexHeader header;
+    ByteReader::load(bytes.data(), header);
+    if (header.magic != index_magic || header.version != index_version)
+        return Error::from_string_literal("Index has an unknown format");
+    if (bytes.size() != sizeof(IndexHeader) + header.entry_count * sizeof(IndexEntry))
+        return Error::from_string_literal("Index has an unexpected size");
+
+    auto const* entries = bytes.offset(sizeof(IndexHeader));
+    for (u64 i = 0; i < header.entry_count; ++i) {
+        IndexEntry entry;
+        ByteReader::load(entries + i * sizeof(IndexEntry), entry);
+        m_index.set(entry.key, entry);
+        m_total_size += entry.size;
+    }
+
+    dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Loaded {} entries ({} bytes) from {}", m_index.size(), m_total_size, m_directory);
+
+    // The size limit may have been lowered since the index was written.
+    evict_entries_if_needed();
+    return {};
+}
+
+ErrorOr<void> DiskCache::flush_index()
+{
+    Threading::MutexLocker locker(m_mutex);
+    if (!m_index_is_dirty)
+        return {};
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(sizeof(IndexHeader) + m_index.size() * sizeof(IndexEntry)));
+
+    IndexHeader header { index_magic, index_version, m_index.size() };
+    __builtin_memcpy(buffer.data(), &header, sizeof(header));
+
+    size_t offset = sizeof(IndexHeader);
+    for (auto const& it : m_index) {
+        __builtin_memcpy(buffer.offset_pointer(offset), &it.value, sizeof(IndexEntry));
+        offset += sizeof(IndexEntry);
+    }
+
+    // Write to a temporary file first, so that a crash can never leave a half-written index behind.
+    auto index_path = ByteString::formatted("{}/index", m_directory);
+    auto temporary_path = ByteString::formatted("{}.tmp", index_path);
+    {
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(buffer));
+    }
+    TRY(Core::System::rename(temporary_path, index_path));
+
+    m_index_is_dirty = false;
+    return {};
+}
+
+// Entry file layout (little endian):
+//     u32 magic, u32 status code, u32 URL length, URL, u32 header count,
+//     { u32 name length, name, u32 value length, value } * header count,
+//     u64 body size, body
+ErrorOr<void> DiskCache::write_entry_file(ByteString const& path, URL::URL const& url, u32 status_code, HTTP::HeaderMap const& response_headers, ReadonlyBytes body)
+{
+    auto write_string = [](Core::File& file, StringView string) -> ErrorOr<void> {
+        TRY(file.write_value<LittleEndian<u32>>(string.length()));
+        TRY(file.write_until_depleted(string.bytes()));
+        return {};
+    };
+
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    TRY(file->write_value<LittleEndian<u32>>(entry_magic));
+    TRY(file->write_value<LittleEndian<u32>>(status_code));
+    TRY(write_string(*file, url.serialize(URL::ExcludeFragment::Yes)));
+
+    TRY(file->write_value<LittleEndian<u32>>(response_headers.headers().size()));
+    for (auto const& header : response_headers.headers()) {
+        TRY(write_string(*file, header.name));
+        TRY(write_string(*file, header.value));
+    }
+
+    TRY(file->write_value<LittleEndian<u64>>(body.size()));
+    TRY(file->write_until_depleted(body));
+    return {};
+}
+
+ErrorOr<DiskCache::CachedResponse> DiskCache::read_entry_file(ByteString const& path)
+{
+    auto file = TRY(Core::MappedFile::map(path));
+    FixedMemoryStream stream { file->bytes() };
+
+    auto read_string = [&]() -> ErrorOr<ByteString> {
+        auto length = TRY(stream.read_value<LittleEndian<u32>>());
+        auto bytes = TRY(stream.read_in_place<u8 const>(length));
+        return ByteString { bytes };
+    };
+
+    if (TRY(stream.read_value<LittleEndian<u32>>()) != entry_magic)
+        return Error::from_string_literal("Cache entry has an unknown format");
+
+    u32 status_code = TRY(stream.read_value<LittleEndian<u32>>());
+    auto url = URL::URL { TRY(read_string()) };
+
+    HTTP::HeaderMap response_headers;
+    auto header_count = TRY(stream.read_value<LittleEndian<u32>>());
+    for (u32 i = 0; i < header_count; ++i) {
+        auto name = TRY(read_string());
+        auto value = TRY(read_string());
+        response_headers.set(move(name), move(value));
+    }
+
+    u64 body_size = TRY(stream.read_value<LittleEndian<u64>>());
+    auto body = TRY(stream.read_in_place<u8 const>(body_size));
+
+    return CachedResponse {
+        .url = move(url),
+        .status_code = status_code,
+        .response_headers = move(response_headers),
+        .file = move(file),
+        .body = body,
+    };
+}
+
+// https://httpwg.org/specs/rfc9111.html#constructing.responses.from.caches
+Optional<DiskCache::CachedResponse> DiskCache::open_response(ByteString const& method, URL::URL const& url, HTTP::HeaderMap const& request_headers)
+{
+    // AD-HOC: Conditional and range requests are passed straight through to the origin server, the client is doing
+    //         its own caching for them.
+    if (!method.equals_ignoring_ascii_case("GET"sv)
+        || request_headers.contains("If-None-Match"sv)
+        || request_headers.contains("If-Modified-Since"sv)
+        || request_headers.contains("If-Range"sv)
+        || request_headers.contains("Range"sv))
+        return {};
+
+    auto request_cache_control = CacheControl::parse(request_headers);
+    if (request_cache_control.no_store)
+        return {};
+
+    Threading::MutexLocker locker(m_mutex);
+
+    auto key = key_for_url(url);
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    auto cached_response_or_error = read_entry_file(path_for_key(key));
+    if (cached_response_or_error.is_error()) {
+        dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Dropping unreadable entry for {}: {}", url, cached_response_or_error.error());
+        remove_entry(key);
+        ++m_statistics.misses;
+        return {};
+    }
+    auto cached_response = cached_response_or_error.release_value();
+
+    // - the presented target URI (Section 7.1 of [HTTP]) and that of the stored response match, and
+    if (cached_response.url.serialize(URL::ExcludeFragment::Yes) != url.serialize(URL::ExcludeFragment::Yes)) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    // - the stored response is one of the following:
+    //   + fresh (see Section 4.2), or
+    //   + successfully validated (see Section 4.3).
+    auto now = now_in_seconds();
+    cached_response.is_fresh = now < it->value.expiration_time
+        && !request_cache_control.no_cache
+        && (!request_cache_control.max_age.has_value() || now - it->value.response_time < *request_cache_control.max_age);
+    cached_response.entity_tag = cached_response.response_headers.get("ETag"sv);
+    cached_response.last_modified = cached_response.response_headers.get("Last-Modified"sv);
+
+    if (!cached_response.is_fresh && !cached_response.entity_tag.has_value() && !cached_response.last_modified.has_value()) {
+        ++m_statistics.misses;
+        return {};
+    }
+
+    it->value.last_access_time = now;
+    m_index_is_dirty = true;
+
+    if (cached_response.is_fresh)
+        ++m_statistics.hits;
+
+    dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Found {} entry for {}", cached_response.is_fresh ? "fresh"sv : "stale"sv, url);
+    return cached_response;
+}
+
+// https://httpwg.org/specs/rfc9111.html#response.cacheability
+bool DiskCache::can_store_response(ByteString const& method, HTTP::HeaderMap const& request_headers, u32 status_code, HTTP::HeaderMap const& response_headers) const
+{
+    // A cache MUST NOT store a response to a request unless:
+
+    // - the request method is understood by the cache;
+    if (!method.equals_ignoring_ascii_case("GET"sv))
+        return false;
+
+    // AD-HOC: Responses to range requests would need to be combined with other partial responses to be useful.
+    if (request_headers.contains("Range"sv))
+        return false;
+
+    // - the response status code is final (see Section 15 of [HTTP]);
+    // - if the response status code is 206 or 304, or the must-understand cache directive (see Section 5.2.2.3) is
+    //   present: the cache understands the response status code;
+    // AD-HOC: We only store responses with status codes that are cacheable by default.
+    if (!is_heuristically_cacheable(status_code))
+        return false;
+
+    // - the no-store cache directive is not present in the response (see Section 5.2.2.5);
+    if (CacheControl::parse(response_headers).no_store || CacheControl::parse(request_headers).no_store)
+        return false;
+
+    // AD-HOC: We don't keep multiple variants of a resource around. Every request from us has the same
+    //         Accept-Encoding, so that is the only field a stored response is allowed to vary on.
+    if (auto vary = response_headers.get("Vary"sv); vary.has_value()) {
+        bool varies_on_other_fields = false;
+        vary->view().for_each_split_view(',', SplitBehavior::Nothing, [&](StringView field) {
+            if (!field.trim_whitespace().equals_ignoring_ascii_case("Accept-Encoding"sv))
+                varies_on_other_fields = true;
+        });
+        if (varies_on_other_fields)
+            return false;
+    }
+
+    // AD-HOC: A response that would be stale right away and can't be validated is of no use to anyone.
+    if (!response_headers.contains("ETag"sv) && !response_headers.contains("Last-Modified"sv)
+        && compute_expiration_time(status_code, response_headers, now_in_seconds()) <= now_in_seconds())
+        return false;
+
+    return true;
+}
+
+// https://httpwg.org/specs/rfc9111.html#storing.fields
+static bool is_exempted_for_storage(StringView header_name)
+{
+    // The Connection header field and fields whose names are listed in it are required by Section 7.6.1 of [HTTP] to be
+    // removed before forwarding the message. This MAY be implemented by doing so before storage.
+    // AD-HOC: Cookies are processed by the client when the response first arrives, replaying them from the cache
+    //         would resurrect cookies that have since been changed or deleted.
+    return header_name.is_one_of_ignoring_ascii_case(
+        "Connection"sv,
+        "Proxy-Connection"sv,
+        "Keep-Alive"sv,
+        "TE"sv,
+        "Transfer-Encoding"sv,
+        "Upgrade"sv,
+        "Set-Cookie"sv,
+        "Set-Cookie2"sv);
+}
+
+void DiskCache::store_response(URL::URL const& url, u32 status_code, HTTP::HeaderMap const& response_headers, ReadonlyBytes body)
+{
+    if (body.size() > maximum_entry_size())
+        return;
+
+    HTTP::HeaderMap stored_headers;
+    for (auto const& header : response_headers.headers()) {
+        if (!is_exempted_for_storage(header.name))
+            stored_headers.set(header.name, header.value);
+    }
+
+    auto key = key_for_url(url);
+    auto path = path_for_key(key);
+
+    Threading::MutexLocker locker(m_mutex);
+
+    // Write to a temporary file first, so that other threads never see a half-written entry.
+    auto temporary_path = ByteString::formatted("{}.tmp", path);
+    if (auto result = write_entry_file(temporary_path, url, status_code, stored_headers, body); result.is_error()) {
+        dbgln("DiskCache: Failed to store {}: {}", url, result.error());
+        (void)Core::System::unlink(temporary_path);
+        return;
+    }
+    if (auto result = Core::System::rename(temporary_path, path); result.is_error()) {
+        dbgln("DiskCache: Failed to store {}: {}", url, result.error());
+        return;
+    }
+
+    auto stat = Core::System::stat(path);
+    auto size = stat.is_error() ? body.size() : static_cast<u64>(stat.value().st_size);
+
+    if (auto it = m_index.find(key); it != m_index.end())
+        m_total_size -= it->value.size;
+
+    auto now = now_in_seconds();
+    m_index.set(key,
+        IndexEntry {
+            .key = key,
+            .size = size,
+            .response_time = now,
+            .expiration_time = compute_expiration_time(status_code, stored_headers, now),
+            .last_access_time = now,
+        });
+    m_total_size += size;
+    m_index_is_dirty = true;
+    ++m_statistics.stores;
+
+    dbgln_if(REQUESTSERVER_DEBUG, "DiskCache: Stored {} ({} bytes)", url, size);
+
+    evict_entries_if_needed();
+}
+
+// https://httpwg.org/specs/rfc9111.html#freshening.responses
+HTTP::HeaderMap DiskCache::freshen_response(CachedResponse const& cached_response, HTTP::HeaderMap const& not_modified_response_headers)
+{
+    // For each stored response identified, the cache MUST update its header fields with the header fields provided in
+    // the 304 (Not Modified) response, as per Section 3.2.
+    // https://httpwg.org/specs/rfc9111.html#update
+    auto is_exempted_for_updating = [](StringView header_name) {
+        return is_exempted_for_storage(header_name)
+            || header_name.equals_ignoring_ascii_case("Content-Length"sv)
+            // AD-HOC: The stored body was decoded according to the stored Content-Encoding.
+            || header_name.equals_ignoring_ascii_case("Content-Encoding"sv);
+    };
+
+    HTTP::HeaderMap headers;
+    for (auto const& header : cached_response.response_headers.headers()) {
+        if (is_exempted_for_updating(header.name) || !not_modified_response_headers.contains(header.name))
+            headers.set(header.name, header.value);
+    }
+    for (auto const& header : not_modified_response_headers.headers()) {
+        if (!is_exempted_for_updating(header.name))
+            headers.set(header.name, header.value);
+    }
+
+    Threading::MutexLocker locker(m_mutex);
+    ++m_statistics.revalidations;
+
+    auto key = key_for_url(cached_response.url);
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+        return headers;
+
+    // Rewrite the entry with the updated header fields, which also gives it a new freshness lifetime.
+    auto path = path_for_key(key);
+    auto temporary_path = ByteString::formatted("{}.tmp", path);
+    if (write_entry_file(temporary_path, cached_response.url, cached_response.status_code, headers, cached_response.body).is_error()
+        || Core::System::rename(temporary_path, path).is_error()) {
+        (void)Core::System::unlink(temporary_path);
+        remove_entry(key);
+        return headers;
+    }
+
+    auto now = now_in_seconds();
+    it->value.response_time = now;
+    it->value.expiration_time = compute_expiration_time(cached_response.status_code, headers, now);
+    it->value.last_access_time = now;
+    m_index_is_dirty = true;
+
+    return headers;
+}
+
+void DiskCache::did_miss()
+{
+    Threading::MutexLocker locker(m_mutex);
+    ++m_statistics.misses;
+}
+
+void DiskCache::remove_entry(u64 key)
+{
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+        return;
+
+    (void)Core::System::unlink(path_for_key(key));
+    m_total_size -= it->value.size;
+    m_index.remove(it);
+    m_index_is_dirty = true;
+}
+
+void DiskCache::evict_entries_if_needed()
+{
+    if (m_total_size <= m_maximum_size)
+        return;
+
+    // Evict the least recently used entries until we're back under the limit.
+    Vector<IndexEntry> entries;
+    entries.ensure_capacity(m_index.size());
+    for (auto const& it : m_index)
+        entries.unchecked_append(it.value);
+    quick_sort(entries, [](auto const& a, auto const& b) { return a.last_access_time < b.last_access_time; });
+
+    for (auto const& entry : entries) {
+        if (m_total_size <= m_maximum_size)
+            break;
+        remove_entry(entry.key);
+        ++m_statistics.evictions;
+    }
+}
+
+DiskCache::Statistics DiskCache::statistics() const
+{
+    Threading::MutexLocker locker(m_mutex);
+
+    auto statistics = m_statistics;
+    statistics.entry_count = m_index.size();
+    statistics.total_size = m_total_size;
+    statistics.maximum_size = m_maximum_size;
+    return statistics;
+}
+
+ByteString DiskCache::statistics_as_json() const
+{
+    auto statistics = this->statistics();
+
+    JsonObject object;
+    object.set("hits", statistics.hits);
+    object.set("misses", statistics.misses);
+    object.set("revalidations", statistics.revalidations);
+    object.set("stores", statistics.stores);
+    object.set("evictions", statistics.evictions);
+    object.set("entry_count", statistics.entry_count);
+    object.set("total_size", statistics.total_size);
+    object.set("maximum_size", statistics.maximum_size);
+    return object.to_byte_string();
+}
+
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Types.h>
+#include <LibCore/MappedFile.h>
+#include <LibHTTP/HeaderMap.h>
+#include <LibThreading/Mutex.h>
+#include <LibURL/URL.h>
+
+namespace RequestServer {
+
+// A persistent HTTP cache (https://httpwg.org/specs/rfc9111.html) that is shared by every client of RequestServer.
+// It is a private cache: it is only ever used by a single user agent.
+//
+// Each stored response lives in its own file in the cache directory. The cache directory also contains an index with
+// a fixed-size record for each of those files, which is small and flat enough to be mapped straight into memory on
+// startup instead of having to look at every entry.
+class DiskCache {
+public:
+    static constexpr u64 default_maximum_size = 256 * MiB;
+
+    static ErrorOr<void> initialize(ByteString directory, u64 maximum_size = default_maximum_size);
+    static DiskCache* the();
+
+    ~DiskCache();
+
+    struct CachedResponse {
+        URL::URL url;
+        u32 status_code { 0 };
+        HTTP::HeaderMap response_headers;
+        NonnullOwnPtr<Core::MappedFile> file;
+        ReadonlyBytes body;
+
+        // A stale response can only be used after it has been successfully validated with the origin server.
+        bool is_fresh { false };
+        Optional<ByteString> entity_tag;
+        Optional<ByteString> last_modified;
+    };
+
+    // Returns a response that can be used to satisfy the request, either directly (if it is fresh), or after being
+    // validated (if it is stale, but has a validator).
+    Optional<CachedResponse> open_response(ByteString const& method, URL::URL const&, HTTP::HeaderMap const& request_headers);
+
+    [[nodiscard]] bool can_store_response(ByteString const& method, HTTP::HeaderMap const& request_headers, u32 status_code, HTTP::HeaderMap const& response_headers) const;
+    void store_response(URL::URL const&, u32 status_code, HTTP::HeaderMap const& response_headers, ReadonlyBytes body);
+
+    // Updates a stored response with the header fields of a 304 (Not Modified) response, and returns the header fields
+    // that should be presented to the client.
+    HTTP::HeaderMap freshen_response(CachedResponse const&, HTTP::HeaderMap const& not_modified_response_headers);
+
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 revalidations { 0 };
+        u64 stores { 0 };
+        u64 evictions { 0 };
+        u64 entry_count { 0 };
+        u64 total_size { 0 };
+        u64 maximum_size { 0 };
+    };
+    Statistics statistics() const;
+    ByteString statistics_as_json() const;
+
+    void did_miss();
+
+    u64 maximum_entry_size() const { return m_maximum_size / 8; }
+
+    ErrorOr<void> flush_index();
+
+private:
+    DiskCache(ByteString directory, u64 maximum_size);
+
+    // The on-disk layout of the index. All fields are stored in host byte order; the index is thrown away if it was
+    // written by a different version of the cache.
+    struct [[gnu::packed]] IndexHeader {
+        u32 magic;
+        u32 version;
+        u64 entry_count;
+    };
+
+    struct [[gnu::packed]] IndexEntry {
+        u64 key;
+        u64 size;
+        i64 response_time;
+        i64 expiration_time;
+        i64 last_access_time;
+    };
+
+    static constexpr u32 index_magic = 0x43445352; // "RSDC"
+    static constexpr u32 index_version = 1;
+
+    ErrorOr<void> load_index();
+    ErrorOr<void> write_entry_file(ByteString const& path, URL::URL const&, u32 status_code, HTTP::HeaderMap const& response_headers, ReadonlyBytes body);
+    ErrorOr<CachedResponse> read_entry_file(ByteString const& path);
+
+    static u64 key_for_url(URL::URL const&);
+    ByteString path_for_key(u64 key) const;
+
+    void remove_entry(u64 key);
+    void evict_entries_if_needed();
+
+    ByteString m_directory;
+    u64 m_maximum_size { 0 };
+
+    mutable Threading::Mutex m_mutex;
+    HashMap<u64, IndexEntry> m_index;
+    u64 m_total_size { 0 };
+    bool m_index_is_dirty { false };
+
+    Statistics m_statistics;
+};
+
+}
@@ -24,15 +24,31 @@ template<typename TSelf, typename TJob>
 void init(TSelf* self, TJob job)
 {
     job->on_headers_received = [self](auto& headers, auto response_code) {
+        if (response_code.has_value() && self->did_receive_response_for_disk_cache(response_code.value(), headers))
+            return;
         if (response_code.has_value())
             self->set_status_code(response_code.value());
         self->set_response_headers(headers);
     };
 
+    job->on_data_written = [self](ReadonlyBytes bytes) {
+        self->did_write_response_body(bytes);
+    };
+
     job->on_finish = [self](bool success) {
-        Core::deferred_invoke([url = self->job().url(), socket = self->job().socket()] {
-            ConnectionCache::request_did_finish(url, socket);
-        });
+        // Requests that ran as HTTP/2 streams have no socket of their own, their connection starts the next one by itself.
+        if (auto* socket = self->job().socket()) {
+            Core::deferred_invoke([url = self->job().url(), socket] {
+                ConnectionCache::request_did_finish(url, socket);
+            });
+        }
+
+        // The origin server confirmed that the cached response is still good, so send that instead of the empty 304.
+        if (success && self->did_revalidate_cached_response()) {
+            self->write_cached_response_body();
+            return;
+        }
+
         if (auto* response = self->job().response()) {
             self->set_status_code(response->code());
             self->set_response_headers(response->headers());
@@ -44,6 +60,7 @@ void init(TSelf* self, TJob job)
         if (!self->total_size().has_value())
             self->did_progress(self->downloaded_size(), self->downloaded_size());
 
+        self->did_finish_response_for_disk_cache(success);
         self->did_finish(success);
     };
     job->on_progress = [self](Optional<u64> total, u64 current) {
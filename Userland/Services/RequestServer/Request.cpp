@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/File.h>
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/Request.h>
+#include <errno.h>
 
 namespace RequestServer {
 
@@ -16,6 +18,14 @@ Request::Request(ConnectionFromClient& client, NonnullOwnPtr<Core::File>&& outpu
 {
 }
 
+Request::~Request()
+{
+    if (m_cached_response_body_notifier) {
+        m_cached_response_body_notifier->set_enabled(false);
+        m_cached_response_body_notifier->on_activation = nullptr;
+    }
+}
+
 void Request::stop()
 {
     m_client.did_finish_request({}, *this, false);
@@ -48,4 +58,97 @@ void Request::did_request_certificates()
     m_client.did_request_certificates({}, *this);
 }
 
+void Request::set_disk_cache_request(ByteString method, HTTP::HeaderMap request_headers, Optional<DiskCache::CachedResponse> cached_response)
+{
+    m_method = move(method);
+    m_request_headers = move(request_headers);
+    m_cached_response = move(cached_response);
+}
+
+bool Request::did_receive_response_for_disk_cache(u32 status_code, HTTP::HeaderMap const& response_headers)
+{
+    auto* disk_cache = DiskCache::the();
+    if (!disk_cache || m_method.is_empty())
+        return false;
+
+    if (m_cached_response.has_value()) {
+        if (status_code == 304) {
+            m_did_revalidate_cached_response = true;
+            set_status_code(m_cached_response->status_code);
+            set_response_headers(disk_cache->freshen_response(*m_cached_response, response_headers));
+            return true;
+        }
+
+        // The stored response was replaced by a new one, which is as good as not having had one at all.
+        m_cached_response.clear();
+        disk_cache->did_miss();
+    }
+
+    if (!disk_cache->can_store_response(m_method, m_request_headers, status_code, response_headers))
+        return false;
+
+    if (auto content_length = response_headers.get("Content-Length"sv).map([](auto const& value) { return value.view().template to_number<u64>(); }).value_or({}); content_length.has_value()) {
+        if (*content_length > disk_cache->maximum_entry_size())
+            return false;
+    }
+
+    m_is_storing_response_body = true;
+    return false;
+}
+
+void Request::did_write_response_body(ReadonlyBytes bytes)
+{
+    if (!m_is_storing_response_body)
+        return;
+
+    auto* disk_cache = DiskCache::the();
+    if (m_response_body.size() + bytes.size() > disk_cache->maximum_entry_size() || m_response_body.try_append(bytes).is_error()) {
+        m_is_storing_response_body = false;
+        m_response_body.clear();
+    }
+}
+
+void Request::did_finish_response_for_disk_cache(bool success)
+{
+    if (!m_is_storing_response_body)
+        return;
+    m_is_storing_response_body = false;
+
+    if (success && m_status_code.has_value())
+        DiskCache::the()->store_response(url(), *m_status_code, m_response_headers, m_response_body);
+    m_response_body.clear();
+}
+
+void Request::write_cached_response_body()
+{
+    VERIFY(m_cached_response.has_value());
+
+    m_cached_response_body_notifier = Core::Notifier::construct(m_output_stream->fd(), Core::Notifier::Type::Write);
+    m_cached_response_body_notifier->on_activation = [this] {
+        auto body = m_cached_response->body;
+
+        if (m_cached_response_body_offset < body.size()) {
+            auto result = m_output_stream->write_some(body.slice(m_cached_response_body_offset));
+            if (result.is_error()) {
+                if (result.error().is_errno() && result.error().code() == EAGAIN)
+                    return;
+                dbgln("Request: Failed to write cached response body for {}: {}", url(), result.error());
+            } else {
+                m_cached_response_body_offset += result.value();
+                if (m_cached_response_body_offset < body.size())
+                    return;
+            }
+        }
+
+        // NOTE: Finishing the request destroys it, so keep the notifier alive until we've returned from its callback.
+        auto protector = m_cached_response_body_notifier;
+        protector->set_enabled(false);
+
+        bool success = m_cached_response_body_offset == body.size();
+        if (success)
+            did_progress(body.size(), body.size());
+        did_finish(success);
+    };
+}
+
 }
@@ -10,14 +10,16 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <AK/RefCounted.h>
+#include <LibCore/Notifier.h>
 #include <LibURL/URL.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/Forward.h>
 
 namespace RequestServer {
 
 class Request {
 public:
-    virtual ~Request() = default;
+    virtual ~Request();
 
     i32 id() const { return m_id; }
     virtual URL::URL url() const = 0;
@@ -42,9 +44,24 @@ public:
     void set_downloaded_size(size_t size) { m_downloaded_size = size; }
     Core::File const& output_stream() const { return *m_output_stream; }
 
+    // Makes the response eligible for the disk cache. If the cache had a stale response for this request, it is
+    // attached here while it is being revalidated with the origin server.
+    void set_disk_cache_request(ByteString method, HTTP::HeaderMap request_headers, Optional<DiskCache::CachedResponse>);
+    bool did_revalidate_cached_response() const { return m_did_revalidate_cached_response; }
+
+    // Returns true if the response was a 304 (Not Modified) for the cached response, which is then used instead.
+    bool did_receive_response_for_disk_cache(u32 status_code, HTTP::HeaderMap const& response_headers);
+    void did_write_response_body(ReadonlyBytes);
+    void did_finish_response_for_disk_cache(bool success);
+
+    // Writes the body of the cached response to the output stream as it drains, then finishes the request.
+    void write_cached_response_body();
+
 protected:
     explicit Request(ConnectionFromClient&, NonnullOwnPtr<Core::File>&&, i32 request_id);
 
+    void set_cached_response(DiskCache::CachedResponse cached_response) { m_cached_response = move(cached_response); }
+
 private:
     ConnectionFromClient& m_client;
     i32 m_id { 0 };
@@ -54,6 +71,16 @@ private:
     size_t m_downloaded_size { 0 };
     NonnullOwnPtr<Core::File> m_output_stream;
     HTTP::HeaderMap m_response_headers;
+
+    ByteString m_method;
+    HTTP::HeaderMap m_request_headers;
+    Optional<DiskCache::CachedResponse> m_cached_response;
+    bool m_did_revalidate_cached_response { false };
+    bool m_is_storing_response_body { false };
+    ByteBuffer m_response_body;
+
+    RefPtr<Core::Notifier> m_cached_response_body_notifier;
+    size_t m_cached_response_body_offset { 0 };
 };
 
 }
@@ -7,11 +7,13 @@
 #include <AK/OwnPtr.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 #include <LibTLS/Certificate.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/GeminiProtocol.h>
 #include <RequestServer/HttpProtocol.h>
 #include <RequestServer/HttpsProtocol.h>
@@ -28,20 +30,23 @@ ErrorOr<int> serenity_main(Main::Arguments)
     signal(SIGINFO, [](int) { RequestServer::ConnectionCache::dump_jobs(); });
 #endif
 
-    if constexpr (TLS_SSL_KEYLOG_DEBUG)
-        TRY(Core::System::pledge("stdio inet accept thread unix cpath wpath rpath sendfd recvfd"));
-    else
-        TRY(Core::System::pledge("stdio inet accept thread unix rpath sendfd recvfd"));
+    TRY(Core::System::pledge("stdio inet accept thread unix cpath wpath rpath sendfd recvfd"));
 
     // Ensure the certificates are read out here.
     // FIXME: Allow specifying extra certificates on the command line, or in other configuration.
     [[maybe_unused]] auto& certs = DefaultRootCACertificates::the();
 
+    auto disk_cache_directory = ByteString::formatted("{}/RequestServer", Core::StandardPaths::cache_directory());
+    if (auto result = RequestServer::DiskCache::initialize(disk_cache_directory); result.is_error())
+        dbgln("Failed to initialize the disk cache in {}: {}", disk_cache_directory, result.error());
+
     Core::EventLoop event_loop;
     // FIXME: Establish a connection to LookupServer and then drop "unix"?
     TRY(Core::System::unveil("/tmp/portal/lookup", "rw"));
     TRY(Core::System::unveil("/etc/cacert.pem", "rw"));
     TRY(Core::System::unveil("/etc/timezone", "r"));
+    if (RequestServer::DiskCache::the())
+        TRY(Core::System::unveil(disk_cache_directory, "rwc"));
     if constexpr (TLS_SSL_KEYLOG_DEBUG)
         TRY(Core::System::unveil("/home/anon", "rwc"));
     TRY(Core::System::unveil(nullptr, nullptr));
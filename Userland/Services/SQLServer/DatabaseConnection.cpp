@@ -61,6 +61,13 @@ DatabaseConnection::DatabaseConnection(NonnullRefPtr<SQL::Database> database, By
 void DatabaseConnection::disconnect()
 {
     dbgln_if(SQLSERVER_DEBUG, "DatabaseConnection::disconnect(connection_id {}, database '{}'", connection_id(), m_database_name);
+
+    if constexpr (SQLSERVER_DEBUG) {
+        auto const& statistics = m_database->block_cache_statistics();
+        auto lookups = statistics.hits + statistics.misses;
+        dbgln("Block cache of database '{}': {} hits, {} misses ({}% hit rate), {} evictions", m_database_name,
+            statistics.hits, statistics.misses, lookups ? statistics.hits * 100 / lookups : 0, statistics.evictions);
+    }
     s_connections.remove(connection_id());
 }
 
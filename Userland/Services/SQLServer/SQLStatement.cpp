@@ -62,6 +62,22 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
 {
     dbgln_if(SQLSERVER_DEBUG, "SQLStatement::execute(statement_id {}", statement_id());
 
+    return schedule_execution([this, placeholder_values = move(placeholder_values)] {
+        return m_statement->execute(connection().database(), placeholder_values);
+    });
+}
+
+Optional<SQL::ExecutionID> SQLStatement::execute_batch(Vector<Vector<SQL::Value>> placeholder_value_sets)
+{
+    dbgln_if(SQLSERVER_DEBUG, "SQLStatement::execute_batch(statement_id {}, {} executions)", statement_id(), placeholder_value_sets.size());
+
+    return schedule_execution([this, placeholder_value_sets = move(placeholder_value_sets)] {
+        return m_statement->execute_batch(connection().database(), placeholder_value_sets);
+    });
+}
+
+Optional<SQL::ExecutionID> SQLStatement::schedule_execution(Function<SQL::ResultOr<SQL::ResultSet>()> execute)
+{
     auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
     if (!client_connection) {
         warnln("Cannot yield next result. Client disconnected");
@@ -70,8 +86,8 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
 
     auto execution_id = m_next_execution_id++;
 
-    Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), placeholder_values = move(placeholder_values), execution_id] {
-        auto execution_result = m_statement->execute(connection().database(), placeholder_values);
+    Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), execute = move(execute), execution_id] {
+        auto execution_result = execute();
 
         if (execution_result.is_error()) {
             report_error(execution_result.release_error(), execution_id);
@@ -137,6 +153,7 @@ bool SQLStatement::should_send_result_rows(SQL::ResultSet const& result) const
 
     switch (result.command()) {
     case SQL::SQLCommand::Describe:
+    case SQL::SQLCommand::Explain:
     case SQL::SQLCommand::Select:
         return true;
     default:
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Function.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/Vector.h>
@@ -26,11 +27,13 @@ public:
     SQL::StatementID statement_id() const { return m_statement_id; }
     DatabaseConnection& connection() { return m_connection; }
     Optional<SQL::ExecutionID> execute(Vector<SQL::Value> placeholder_values);
+    Optional<SQL::ExecutionID> execute_batch(Vector<Vector<SQL::Value>> placeholder_value_sets);
     void ready_for_next_result(SQL::ExecutionID);
 
 private:
     SQLStatement(DatabaseConnection&, NonnullRefPtr<SQL::AST::Statement> statement);
 
+    Optional<SQL::ExecutionID> schedule_execution(Function<SQL::ResultOr<SQL::ResultSet>()> execute);
     bool should_send_result_rows(SQL::ResultSet const& result) const;
     void report_error(SQL::Result, SQL::ExecutionID execution_id);
 
@@ -115,13 +115,55 @@ ErrorOr<void> Service::activate()
 {
     VERIFY(m_pid < 0);
 
-    if (m_lazy)
+    if (!m_activation_time.has_value())
+        m_activation_time = MonotonicTime::now();
+
+    if (m_lazy) {
         setup_notifier();
-    else
-        TRY(spawn());
+        did_become_ready();
+        return {};
+    }
+
+    if (auto result = spawn(); result.is_error()) {
+        did_become_ready(true);
+        return result.release_error();
+    }
     return {};
 }
 
+void Service::did_become_ready(bool failed)
+{
+    if (m_ready_time.has_value())
+        return;
+
+    m_ready_time = MonotonicTime::now();
+    m_failed_to_start = failed;
+    dbgln_if(SYSTEMSERVER_DEBUG, "{} is ready after {} ms", name(), (*m_ready_time - *m_activation_time).to_milliseconds());
+
+    if (on_ready)
+        on_ready();
+}
+
+JsonObject Service::boot_report() const
+{
+    JsonObject report;
+    report.set("name", name());
+
+    JsonArray after_services;
+    for (auto const& service : m_after_services)
+        after_services.must_append(service);
+    report.set("after_services", move(after_services));
+
+    if (m_activation_time.has_value())
+        report.set("activated", m_activation_time->milliseconds());
+    if (m_ready_time.has_value()) {
+        report.set("ready", m_ready_time->milliseconds());
+        report.set("startup_time", (*m_ready_time - *m_activation_time).to_milliseconds());
+        report.set("failed", m_failed_to_start);
+    }
+    return report;
+}
+
 ErrorOr<void> Service::change_privileges()
 {
     // NOTE: Dropping privileges makes sense when SystemServer is running
@@ -156,87 +198,98 @@ ErrorOr<void> Service::spawn(int socket_fd)
     pid_t pid = TRY(Core::System::fork());
 
     if (pid == 0) {
-        // We are the child.
-        if (m_working_directory.has_value())
-            TRY(Core::System::chdir(*m_working_directory));
-
-        struct sched_param p;
-        p.sched_priority = m_priority;
-        int rc = sched_setparam(0, &p);
-        if (rc < 0) {
-            perror("sched_setparam");
-            VERIFY_NOT_REACHED();
-        }
-
-        if (m_stdio_file_path.has_value()) {
-            close(STDIN_FILENO);
-            auto const fd = TRY(Core::System::open(*m_stdio_file_path, O_RDWR, 0));
-            VERIFY(fd == 0);
-
-            dup2(STDIN_FILENO, STDOUT_FILENO);
-            dup2(STDIN_FILENO, STDERR_FILENO);
-
-            if (isatty(STDIN_FILENO)) {
-                ioctl(STDIN_FILENO, TIOCSCTTY);
-            }
-        } else {
-            if (isatty(STDIN_FILENO)) {
-                ioctl(STDIN_FILENO, TIOCNOTTY);
+        // We are the child. If anything goes wrong before the exec, we must not return into SystemServer's own code.
+        auto result = [&]() -> ErrorOr<void> {
+            if (m_working_directory.has_value())
+                TRY(Core::System::chdir(*m_working_directory));
+
+            struct sched_param p;
+            p.sched_priority = m_priority;
+            int rc = sched_setparam(0, &p);
+            if (rc < 0) {
+                perror("sched_setparam");
+                VERIFY_NOT_REACHED();
             }
-            close(STDIN_FILENO);
-            close(STDOUT_FILENO);
-            close(STDERR_FILENO);
-
-            auto const fd = TRY(Core::System::open("/dev/null"sv, O_RDWR));
-            VERIFY(fd == STDIN_FILENO);
-            dup2(STDIN_FILENO, STDOUT_FILENO);
-            dup2(STDIN_FILENO, STDERR_FILENO);
-        }
-
-        StringBuilder socket_takeover_builder;
 
-        if (socket_fd >= 0) {
-            // We were spawned by socket activation. We currently only support
-            // single sockets for socket activation, so make sure that's the case.
-            VERIFY(m_sockets.size() == 1);
+            if (m_stdio_file_path.has_value()) {
+                close(STDIN_FILENO);
+                auto const fd = TRY(Core::System::open(*m_stdio_file_path, O_RDWR, 0));
+                VERIFY(fd == 0);
+
+                dup2(STDIN_FILENO, STDOUT_FILENO);
+                dup2(STDIN_FILENO, STDERR_FILENO);
+
+                if (isatty(STDIN_FILENO)) {
+                    ioctl(STDIN_FILENO, TIOCSCTTY);
+                }
+            } else {
+                if (isatty(STDIN_FILENO)) {
+                    ioctl(STDIN_FILENO, TIOCNOTTY);
+                }
+                close(STDIN_FILENO);
+                close(STDOUT_FILENO);
+                close(STDERR_FILENO);
+
+                auto const fd = TRY(Core::System::open("/dev/null"sv, O_RDWR));
+                VERIFY(fd == STDIN_FILENO);
+                dup2(STDIN_FILENO, STDOUT_FILENO);
+                dup2(STDIN_FILENO, STDERR_FILENO);
+            }
 
-            int fd = dup(socket_fd);
-            TRY(socket_takeover_builder.try_appendff("{}:{}", m_sockets[0].path, fd));
-        } else {
-            // We were spawned as a regular process, so dup every socket for this
-            // service and let the service know via SOCKET_TAKEOVER.
-            for (unsigned i = 0; i < m_sockets.size(); i++) {
-                SocketDescriptor& socket = m_sockets.at(i);
-
-                int new_fd = dup(socket.fd);
-                if (i != 0)
-                    TRY(socket_takeover_builder.try_append(';'));
-                TRY(socket_takeover_builder.try_appendff("{}:{}", socket.path, new_fd));
+            StringBuilder socket_takeover_builder;
+
+            if (socket_fd >= 0) {
+                // We were spawned by socket activation. We currently only support
+                // single sockets for socket activation, so make sure that's the case.
+                VERIFY(m_sockets.size() == 1);
+
+                int fd = dup(socket_fd);
+                TRY(socket_takeover_builder.try_appendff("{}:{}", m_sockets[0].path, fd));
+            } else {
+                // We were spawned as a regular process, so dup every socket for this
+                // service and let the service know via SOCKET_TAKEOVER.
+                for (unsigned i = 0; i < m_sockets.size(); i++) {
+                    SocketDescriptor& socket = m_sockets.at(i);
+
+                    int new_fd = dup(socket.fd);
+                    if (i != 0)
+                        TRY(socket_takeover_builder.try_append(';'));
+                    TRY(socket_takeover_builder.try_appendff("{}:{}", socket.path, new_fd));
+                }
             }
-        }
 
-        if (!m_sockets.is_empty()) {
-            // The new descriptor is !CLOEXEC here.
-            TRY(Core::Environment::set("SOCKET_TAKEOVER"sv, socket_takeover_builder.string_view(), Core::Environment::Overwrite::Yes));
-        }
+            if (!m_sockets.is_empty()) {
+                // The new descriptor is !CLOEXEC here.
+                TRY(Core::Environment::set("SOCKET_TAKEOVER"sv, socket_takeover_builder.string_view(), Core::Environment::Overwrite::Yes));
+            }
 
-        TRY(change_privileges());
+            TRY(change_privileges());
 
-        TRY(m_environment.view().for_each_split_view(' ', SplitBehavior::Nothing, [&](auto env) {
-            return Core::Environment::put(env);
-        }));
+            TRY(m_environment.view().for_each_split_view(' ', SplitBehavior::Nothing, [&](auto env) {
+                return Core::Environment::put(env);
+            }));
 
-        Vector<StringView, 10> arguments;
-        TRY(arguments.try_append(m_executable_path));
-        TRY(m_extra_arguments.view().for_each_split_view(' ', SplitBehavior::Nothing, [&](auto arg) {
-            return arguments.try_append(arg);
-        }));
+            Vector<StringView, 10> arguments;
+            TRY(arguments.try_append(m_executable_path));
+            TRY(m_extra_arguments.view().for_each_split_view(' ', SplitBehavior::Nothing, [&](auto arg) {
+                return arguments.try_append(arg);
+            }));
 
-        TRY(Core::System::exec(m_executable_path, arguments, Core::System::SearchInPath::No));
-    } else if (!m_multi_instance) {
+            return Core::System::exec(m_executable_path, arguments, Core::System::SearchInPath::No);
+        }();
+        dbgln("{}: Failed to spawn: {}", name(), result.error());
+        _exit(1);
+    } else {
         // We are the parent.
-        m_pid = pid;
-        s_service_map.set(pid, this);
+        if (!m_multi_instance) {
+            m_pid = pid;
+            s_service_map.set(pid, this);
+        }
+
+        // Connections to the sockets queue up until the service accepts them, and services that keep running don't have
+        // anything else to wait for. Services that are run once are only ready when they're done.
+        if (!m_sockets.is_empty() || m_keep_alive || m_multi_instance)
+            did_become_ready();
     }
 
     return {};
@@ -257,11 +310,13 @@ ErrorOr<void> Service::did_exit(int status)
     s_service_map.remove(m_pid);
     m_pid = -1;
 
+    bool exited_successfully = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    did_become_ready(!exited_successfully);
+
     if (!m_keep_alive)
         return {};
 
     auto run_time = m_run_timer.elapsed_time();
-    bool exited_successfully = WIFEXITED(status) && WEXITSTATUS(status) == 0;
 
     if (!exited_successfully && run_time < 1_sec) {
         switch (m_restart_attempts) {
@@ -322,6 +377,9 @@ Service::Service(Core::ConfigFile const& config, StringView name)
     m_multi_instance = config.read_bool_entry(name, "MultiInstance");
     m_accept_socket_connections = config.read_bool_entry(name, "AcceptSocketConnections");
 
+    for (auto const& service : config.read_entry(name, "AfterServices").split(','))
+        m_after_services.append(service.trim_whitespace());
+
     ByteString socket_entry = config.read_entry(name, "Socket");
     ByteString socket_permissions_entry = config.read_entry(name, "SocketPermissions", "0600");
 
@@ -7,7 +7,10 @@
 #pragma once
 
 #include <AK/ByteString.h>
+#include <AK/Function.h>
+#include <AK/JsonObject.h>
 #include <AK/RefPtr.h>
+#include <AK/Time.h>
 #include <LibCore/Account.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/EventReceiver.h>
@@ -29,6 +32,19 @@ public:
 
     static Service* find_by_pid(pid_t);
 
+    // The names of the services that have to be ready before this one is activated.
+    Vector<ByteString> const& after_services() const { return m_after_services; }
+    void ignore_after_services() { m_after_services.clear(); }
+
+    // A service is ready once services that come after it can rely on it: lazy services as soon as their socket is set up,
+    // services that others connect to or that keep running once they have been spawned, and any other service once it
+    // has exited. A service that couldn't be spawned is ready as well, so that it doesn't hold up the rest of the boot.
+    bool is_ready() const { return m_ready_time.has_value(); }
+    Function<void()> on_ready;
+
+    // When the service was activated and became ready, in milliseconds since boot.
+    JsonObject boot_report() const;
+
 private:
     Service(Core::ConfigFile const&, StringView name);
 
@@ -38,6 +54,8 @@ private:
 
     ErrorOr<void> change_privileges();
 
+    void did_become_ready(bool failed = false);
+
     /// SocketDescriptor describes the details of a single socket that was
     /// requested by a service.
     struct SocketDescriptor {
@@ -76,6 +94,8 @@ private:
     ByteString m_environment;
     // Socket descriptors for this service.
     Vector<SocketDescriptor> m_sockets;
+    // Services that have to be ready before this one is activated.
+    Vector<ByteString> m_after_services;
 
     // The resolved user account to run this service as.
     Optional<Core::Account> m_account;
@@ -91,6 +111,11 @@ private:
     // times where it has exited unsuccessfully and too quickly.
     int m_restart_attempts { 0 };
 
+    // When the service was first activated and when it became ready, for the boot report.
+    Optional<MonotonicTime> m_activation_time;
+    Optional<MonotonicTime> m_ready_time;
+    bool m_failed_to_start { false };
+
     ErrorOr<void> setup_socket(SocketDescriptor&);
     void setup_notifier();
     ErrorOr<void> handle_socket_connection();
@@ -10,14 +10,20 @@
 #include <AK/Assertions.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Debug.h>
+#include <AK/HashTable.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/LexicalPath.h>
 #include <AK/String.h>
 #include <Kernel/API/DeviceEvent.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/ConfigFile.h>
 #include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
 #include <LibCore/Event.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/File.h>
+#include <LibCore/SessionManagement.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
 #include <errno.h>
@@ -36,6 +42,8 @@ static constexpr StringView selftest_system_mode = "self-test"sv;
 static constexpr StringView graphical_system_mode = "graphical"sv;
 ByteString g_system_mode = graphical_system_mode;
 Vector<NonnullRefPtr<Service>> g_services;
+static ByteString s_boot_report_path = "/tmp/system/boot-report.json";
+static Vector<NonnullRefPtr<Service>> s_services_waiting_for_activation;
 
 // NOTE: This handler ensures that the destructor of g_services is called.
 static void sigterm_handler(int)
@@ -99,6 +107,70 @@ static ErrorOr<void> determine_system_mode()
     return {};
 }
 
+static Service* find_service_by_name(StringView name)
+{
+    for (auto& service : g_services) {
+        if (service->name() == name)
+            return service;
+    }
+    return nullptr;
+}
+
+static bool has_dependency_cycle(Service const& service, HashTable<Service const*>& services_on_path)
+{
+    if (services_on_path.contains(&service))
+        return true;
+
+    services_on_path.set(&service);
+    for (auto const& name : service.after_services()) {
+        if (auto const* dependency = find_service_by_name(name); dependency && has_dependency_cycle(*dependency, services_on_path))
+            return true;
+    }
+    services_on_path.remove(&service);
+    return false;
+}
+
+// The boot report lists when each service was activated and when it became ready, and is updated as they do.
+static ErrorOr<void> write_boot_report()
+{
+    JsonArray services;
+    for (auto const& service : g_services)
+        TRY(services.append(service->boot_report()));
+
+    JsonObject report;
+    report.set("system_mode", g_system_mode);
+    report.set("services", move(services));
+
+    TRY(Core::Directory::create(LexicalPath(s_boot_report_path).parent(), Core::Directory::CreateDirectories::Yes));
+    auto file = TRY(Core::File::open(s_boot_report_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    auto contents = report.to_byte_string();
+    TRY(file->write_until_depleted(contents.bytes()));
+    return {};
+}
+
+// Services are activated as soon as all the services they come after are ready, so independent services start together
+// instead of one after the other.
+static void activate_services_that_can_be_activated()
+{
+    Vector<NonnullRefPtr<Service>> services_to_activate;
+    s_services_waiting_for_activation.remove_all_matching([&](auto& service) {
+        auto can_be_activated = all_of(service->after_services(), [](auto const& name) {
+            auto const* dependency = find_service_by_name(name);
+            return !dependency || dependency->is_ready();
+        });
+        if (can_be_activated)
+            services_to_activate.append(service);
+        return can_be_activated;
+    });
+
+    // Activating a service can make others ready to be activated, which activates them right away.
+    for (auto& service : services_to_activate) {
+        dbgln_if(SYSTEMSERVER_DEBUG, "Activating {}", service->name());
+        if (auto result = service->activate(); result.is_error())
+            dbgln("{}: {}", service->name(), result.release_error());
+    }
+}
+
 static ErrorOr<void> activate_services(Core::ConfigFile const& config)
 {
     Vector<NonnullRefPtr<Service>> services_to_activate;
@@ -111,13 +183,32 @@ static ErrorOr<void> activate_services(Core::ConfigFile const& config)
         }
     }
 
-    // After we've set them all up, activate only those just added!
-    dbgln("Activating {} services...", services_to_activate.size());
     for (auto& service : services_to_activate) {
-        dbgln_if(SYSTEMSERVER_DEBUG, "Activating {}", service->name());
-        if (auto result = service->activate(); result.is_error())
-            dbgln("{}: {}", service->name(), result.release_error());
+        for (auto const& name : service->after_services()) {
+            if (!find_service_by_name(name))
+                dbgln("{}: Ignoring unknown service {} in AfterServices", service->name(), name);
+        }
+
+        HashTable<Service const*> services_on_path;
+        if (has_dependency_cycle(*service, services_on_path)) {
+            dbgln("{}: Ignoring AfterServices, as the services it comes after depend on it", service->name());
+            service->ignore_after_services();
+        }
+
+        service->on_ready = [] {
+            activate_services_that_can_be_activated();
+            if (auto result = write_boot_report(); result.is_error())
+                dbgln("Failed to write the boot report: {}", result.release_error());
+        };
     }
+
+    // After we've set them all up, activate only those just added!
+    dbgln("Activating {} services...", services_to_activate.size());
+    s_services_waiting_for_activation.extend(move(services_to_activate));
+    activate_services_that_can_be_activated();
+
+    if (auto result = write_boot_report(); result.is_error())
+        dbgln("Failed to write the boot report: {}", result.release_error());
     return {};
 }
 
@@ -184,6 +275,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (!user) {
         TRY(SystemServer::activate_base_services_based_on_system_mode());
     } else {
+        s_boot_report_path = TRY(Core::SessionManagement::parse_path_with_sid("/tmp/session/%sid/boot-report.json"sv));
         TRY(SystemServer::activate_user_services_based_on_system_mode());
     }
 
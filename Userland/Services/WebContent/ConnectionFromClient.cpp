@@ -61,6 +61,9 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> sock
     : IPC::ConnectionFromClient<WebContentClientEndpoint, WebContentServerEndpoint>(*this, move(socket), 1)
     , m_page_host(PageHost::create(*this))
 {
+    // Layout, cursor and tooltip updates are sent many times per frame.
+    enable_message_batching();
+
     m_input_event_queue_timer = Web::Platform::Timer::create_single_shot(0, [this] { process_next_input_event(); });
 }
 
@@ -154,7 +157,7 @@ void ConnectionFromClient::load_url(u64 page_id, const URL::URL& url)
     page->page().load(url);
 }
 
-void ConnectionFromClient::load_html(u64 page_id, ByteString const& html)
+void ConnectionFromClient::load_html(u64 page_id, StringView html)
 {
     if (auto page = this->page(page_id); page.has_value())
         page->page().load_html(html);
@@ -60,7 +60,7 @@ private:
     virtual void update_system_fonts(u64 page_id, ByteString const&, ByteString const&, ByteString const&) override;
     virtual void update_screen_rects(u64 page_id, Vector<Web::DevicePixelRect> const&, u32) override;
     virtual void load_url(u64 page_id, URL::URL const&) override;
-    virtual void load_html(u64 page_id, ByteString const&) override;
+    virtual void load_html(u64 page_id, StringView) override;
     virtual void reload(u64 page_id) override;
     virtual void traverse_the_history_by_delta(u64 page_id, i32 delta) override;
     virtual void set_viewport_size(u64 page_id, Web::DevicePixelSize const) override;
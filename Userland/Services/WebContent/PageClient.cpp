@@ -106,6 +106,9 @@ void PageClient::add_backing_store(i32 front_bitmap_id, Gfx::ShareableBitmap con
     m_backing_stores.back_bitmap_id = back_bitmap_id;
     m_backing_stores.front_bitmap = *const_cast<Gfx::ShareableBitmap&>(front_bitmap).bitmap();
     m_backing_stores.back_bitmap = *const_cast<Gfx::ShareableBitmap&>(back_bitmap).bitmap();
+    m_backing_stores.front_bitmap_damage = {};
+    m_backing_stores.front_bitmap_viewport_rect = {};
+    m_backing_stores.front_bitmap_is_pixel_aligned = false;
 }
 
 void PageClient::visit_edges(JS::Cell::Visitor& visitor)
@@ -200,8 +203,49 @@ Web::Layout::Viewport* PageClient::layout_root()
     return document->layout_node();
 }
 
+// Copies the pixels of a previous frame into the bitmap for a frame where the page is scrolled to a different position,
+// and returns the part of the viewport that was not covered by the previous frame.
+static Optional<Web::DevicePixelRect> copy_scrolled_pixels(Gfx::Bitmap const& source, Web::DevicePixelRect const& source_viewport_rect, Gfx::Bitmap& target, Web::DevicePixelRect const& target_viewport_rect)
+{
+    if (source_viewport_rect.size() != target_viewport_rect.size())
+        return {};
+
+    Gfx::IntRect viewport { {}, target_viewport_rect.size().to_type<int>() };
+    if (!source.rect().contains(viewport) || !target.rect().contains(viewport))
+        return {};
+
+    auto delta = (target_viewport_rect.location() - source_viewport_rect.location()).to_type<int>();
+    auto reused_rect = viewport.translated(-delta).intersected(viewport);
+    if (reused_rect.is_empty())
+        return {};
+
+    for (int y = reused_rect.top(); y < reused_rect.bottom(); ++y)
+        memcpy(target.scanline(y) + reused_rect.left(), source.scanline(y + delta.y()) + reused_rect.left() + delta.x(), reused_rect.width() * sizeof(Gfx::ARGB32));
+
+    Gfx::IntRect exposed_rect;
+    for (auto const& piece : viewport.shatter(reused_rect))
+        exposed_rect = exposed_rect.united(piece);
+    return exposed_rect.to_type<Web::DevicePixels>();
+}
+
 void PageClient::paint_next_frame()
 {
+    // NOTE: Painting resets the damage, so this has to happen before taking any screenshots.
+    auto& traversable = *page().top_level_traversable();
+    auto viewport_rect = page().css_to_device_rect(traversable.viewport_rect());
+    Optional<Web::DevicePixelRect> damage_rect;
+    if (auto damaged_rect = traversable.damaged_rect(); damaged_rect.has_value()) {
+        // NOTE: Leave some room for antialiasing around the damaged rect.
+        auto rect = page().enclosing_device_rect(damaged_rect->translated(-traversable.viewport_rect().location())).inflated(4, 4);
+        damage_rect = rect.intersected({ {}, viewport_rect.size() });
+    }
+
+    auto is_pixel_aligned = [&] {
+        auto scale = device_pixels_per_css_pixel();
+        auto location = traversable.viewport_rect().location().to_type<double>() * scale;
+        return location.x() == floor(location.x()) && location.y() == floor(location.y());
+    }();
+
     while (!m_screenshot_tasks.is_empty()) {
         auto task = m_screenshot_tasks.dequeue();
         if (task.node_id.has_value()) {
@@ -226,13 +270,30 @@ void PageClient::paint_next_frame()
         return;
     }
 
-    auto& back_bitmap = *m_backing_stores.back_bitmap;
-    auto viewport_rect = page().css_to_device_rect(page().top_level_traversable()->viewport_rect());
-    paint(viewport_rect, back_bitmap);
-
     auto& backing_stores = m_backing_stores;
+    auto& back_bitmap = *backing_stores.back_bitmap;
+
+    Web::PaintOptions paint_options;
+    bool front_bitmap_shows_same_viewport = backing_stores.front_bitmap_viewport_rect == viewport_rect;
+    if (damage_rect.has_value() && front_bitmap_shows_same_viewport && backing_stores.front_bitmap_damage.has_value()) {
+        // The back bitmap still contains the frame before the front one, so it has to catch up on the damage of both.
+        paint_options.damage_rects.append(*damage_rect);
+        paint_options.damage_rects.append(*backing_stores.front_bitmap_damage);
+    } else if (damage_rect.has_value() && is_pixel_aligned && backing_stores.front_bitmap_is_pixel_aligned) {
+        // Otherwise, start from the front bitmap moved to the current scroll position, and only paint what it doesn't show.
+        if (auto exposed_rect = copy_scrolled_pixels(*backing_stores.front_bitmap, backing_stores.front_bitmap_viewport_rect, back_bitmap, viewport_rect); exposed_rect.has_value()) {
+            paint_options.damage_rects.append(*damage_rect);
+            paint_options.damage_rects.append(*exposed_rect);
+        }
+    }
+    paint(viewport_rect, back_bitmap, paint_options);
+
     swap(backing_stores.front_bitmap, backing_stores.back_bitmap);
     swap(backing_stores.front_bitmap_id, backing_stores.back_bitmap_id);
+    // NOTE: The damage only tells the back bitmap how to catch up if it shows the page at the same scroll position.
+    backing_stores.front_bitmap_damage = front_bitmap_shows_same_viewport ? damage_rect : Optional<Web::DevicePixelRect> {};
+    backing_stores.front_bitmap_viewport_rect = viewport_rect;
+    backing_stores.front_bitmap_is_pixel_aligned = is_pixel_aligned;
 
     m_paint_state = PaintState::WaitingForClient;
     client().async_did_paint(m_id, viewport_rect.to_type<int>(), backing_stores.front_bitmap_id);
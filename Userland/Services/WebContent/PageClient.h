@@ -215,6 +215,15 @@ private:
         i32 back_bitmap_id { -1 };
         RefPtr<Gfx::Bitmap> front_bitmap;
         RefPtr<Gfx::Bitmap> back_bitmap;
+
+        // If the back bitmap contains the frame painted before the one in the front bitmap, this is the part of the
+        // viewport that changed between them.
+        Optional<Web::DevicePixelRect> front_bitmap_damage;
+        Web::DevicePixelRect front_bitmap_viewport_rect;
+
+        // Whether the front bitmap was painted at a whole device pixel scroll position, which allows moving its pixels
+        // into the back bitmap when the page is scrolled.
+        bool front_bitmap_is_pixel_aligned { false };
     };
     BackingStores m_backing_stores;
 
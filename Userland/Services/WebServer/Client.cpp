@@ -6,10 +6,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/Base64.h>
 #include <AK/Debug.h>
 #include <AK/LexicalPath.h>
-#include <AK/MemoryStream.h>
 #include <AK/NumberFormat.h>
 #include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
@@ -18,7 +18,9 @@
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibCore/MimeData.h>
+#include <LibCore/Notifier.h>
 #include <LibCore/System.h>
+#include <LibCore/Timer.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibHTTP/HttpRequest.h>
 #include <LibHTTP/HttpResponse.h>
@@ -38,22 +40,51 @@ Client::Client(NonnullOwnPtr<Core::BufferedTCPSocket> socket, Core::EventReceive
 
 void Client::die()
 {
+    if (m_is_dead)
+        return;
+    m_is_dead = true;
+
+    m_idle_timer->stop();
+    m_write_notifier->set_enabled(false);
     m_socket->close();
     deferred_invoke([this] { remove_from_parent(); });
 }
 
+static void report_error(Variant<AK::Error, HTTP::HttpRequest::ParseError> const& error)
+{
+    error.visit(
+        [](AK::Error const& error) {
+            warnln("Internal error: {}", error);
+        },
+        [](HTTP::HttpRequest::ParseError const& error) {
+            warnln("HTTP request parsing error: {}", HTTP::HttpRequest::parse_error_to_string(error));
+        });
+}
+
 void Client::start()
 {
+    m_idle_timer = Core::Timer::create_single_shot(keep_alive_timeout_ms, [this] { die(); }, this);
+    m_idle_timer->start();
+
+    m_write_notifier = Core::Notifier::construct(m_socket->underlying_socket().fd(), Core::Notifier::Type::Write, this);
+    m_write_notifier->set_enabled(false);
+    m_write_notifier->on_activation = [this] {
+        auto result = [&]() -> ErrorOr<void, WrappedError> {
+            TRY(flush_output());
+            // Pipelined requests wait until the responses to the previous ones are on their way.
+            if (!m_is_dead && m_output.is_empty())
+                TRY(handle_buffered_requests());
+            return {};
+        }();
+        if (result.is_error()) {
+            report_error(result.error());
+            die();
+        }
+    };
+
     m_socket->on_ready_to_read = [this] {
         if (auto result = on_ready_to_read(); result.is_error()) {
-            result.error().visit(
-                [](AK::Error const& error) {
-                    warnln("Internal error: {}", error);
-                },
-                [](HTTP::HttpRequest::ParseError const& error) {
-                    warnln("HTTP request parsing error: {}", HTTP::HttpRequest::parse_error_to_string(error));
-                });
-
+            report_error(result.error());
             die();
         }
     };
@@ -64,36 +95,103 @@ ErrorOr<void, Client::WrappedError> Client::on_ready_to_read()
     // FIXME: Mostly copied from LibWeb/WebDriver/Client.cpp. As noted there, this should be move the LibHTTP and made spec compliant.
     auto buffer = TRY(ByteBuffer::create_uninitialized(m_socket->buffer_size()));
 
+    bool client_closed_connection = false;
     for (;;) {
         if (!TRY(m_socket->can_read_without_blocking()))
             break;
 
         auto data = TRY(m_socket->read_some(buffer));
-        TRY(m_remaining_request.try_append(StringView { data }));
+        TRY(m_remaining_request.try_append(data));
 
-        if (m_socket->is_eof())
+        if (m_socket->is_eof()) {
+            client_closed_connection = true;
             break;
+        }
     }
 
-    if (m_remaining_request.is_empty())
+    if (m_remaining_request.size() > max_buffered_request_size)
+        return HTTP::HttpRequest::ParseError::RequestTooLarge;
+
+    m_idle_timer->restart();
+
+    // The requests that we already got are still answered, but nothing after them.
+    if (client_closed_connection)
+        m_close_after_output = true;
+
+    TRY(handle_buffered_requests());
+
+    if (client_closed_connection && m_output.is_empty())
+        die();
+    return {};
+}
+
+// Returns the size of the first request in the buffer, if all of it has arrived.
+static Optional<size_t> size_of_complete_request(ReadonlyBytes buffer)
+{
+    auto end_of_headers = StringView { buffer }.find("\r\n\r\n"sv);
+    if (!end_of_headers.has_value())
         return {};
 
-    auto request = TRY(m_remaining_request.to_byte_buffer());
-    dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", ByteString::copy(request));
+    size_t content_length = 0;
+    auto headers = StringView { buffer.trim(*end_of_headers) };
+    for (auto line : headers.split_view("\r\n"sv)) {
+        auto colon = line.find(':');
+        if (!colon.has_value() || !line.substring_view(0, *colon).equals_ignoring_ascii_case("Content-Length"sv))
+            continue;
+        content_length = line.substring_view(*colon + 1).trim_whitespace().to_number<size_t>().value_or(0);
+    }
 
-    auto maybe_parsed_request = HTTP::HttpRequest::from_raw_request(TRY(m_remaining_request.to_byte_buffer()));
-    if (maybe_parsed_request.is_error()) {
-        if (maybe_parsed_request.error() == HTTP::HttpRequest::ParseError::RequestIncomplete) {
-            // If request is not complete we need to wait for more data to arrive
-            return {};
+    auto size = *end_of_headers + 4 + content_length;
+    if (size > buffer.size())
+        return {};
+    return size;
+}
+
+static bool wants_keep_alive(StringView request_line, HTTP::HttpRequest const& request)
+{
+    if (auto connection = request.headers().get("Connection"sv); connection.has_value()) {
+        for (auto token : connection->split_view(',')) {
+            if (token.trim_whitespace().equals_ignoring_ascii_case("close"sv))
+                return false;
+            if (token.trim_whitespace().equals_ignoring_ascii_case("keep-alive"sv))
+                return true;
         }
-        return maybe_parsed_request.error();
     }
 
-    m_remaining_request.clear();
+    // Connections are persistent by default since HTTP/1.1.
+    return request_line.ends_with("HTTP/1.1"sv);
+}
+
+ErrorOr<void, Client::WrappedError> Client::handle_buffered_requests()
+{
+    while (!m_is_dead && !m_remaining_request.is_empty()) {
+        // A large file has to be sent before we know what comes after it.
+        if (m_buffered_output_size >= max_buffered_output_size || any_of(m_output, [](auto& chunk) { return chunk.template has<FileTransfer>(); }))
+            break;
+
+        auto request_size = size_of_complete_request(m_remaining_request);
+        // If request is not complete we need to wait for more data to arrive
+        if (!request_size.has_value())
+            break;
+
+        auto raw_request = m_remaining_request.bytes().trim(*request_size);
+        dbgln_if(WEBSERVER_DEBUG, "Got raw request: '{}'", StringView { raw_request });
+
+        auto request = TRY(HTTP::HttpRequest::from_raw_request(raw_request));
+        auto request_line = StringView { raw_request }.find_first_split_view('\r');
+        m_keep_alive = !m_close_after_output && wants_keep_alive(request_line, request);
 
-    TRY(handle_request(maybe_parsed_request.value()));
+        m_remaining_request = TRY(ByteBuffer::copy(m_remaining_request.bytes().slice(*request_size)));
+
+        TRY(handle_request(request));
+
+        if (!m_keep_alive) {
+            m_close_after_output = true;
+            m_remaining_request.clear();
+        }
+    }
 
+    TRY(flush_output());
     return {};
 }
 
@@ -130,6 +228,12 @@ ErrorOr<bool> Client::handle_request(HTTP::HttpRequest const& request)
 
     auto real_path = TRY(String::formatted("{}{}", Configuration::the().document_root_path(), requested_path));
 
+    // Only regular files are cached, so this can't skip any of the directory handling below.
+    if (auto const* entry = FileCache::the().find_fresh(real_path.to_byte_string())) {
+        TRY(send_cached_file(*entry, request));
+        return true;
+    }
+
     if (FileSystem::is_directory(real_path.bytes_as_string_view())) {
         if (!resource_decoded.ends_with('/')) {
             TRY(send_redirect(TRY(String::formatted("{}/", requested_path)), request));
@@ -150,36 +254,133 @@ ErrorOr<bool> Client::handle_request(HTTP::HttpRequest const& request)
         real_path = index_html_path;
     }
 
-    if (!FileSystem::exists(real_path.bytes_as_string_view())) {
-        TRY(send_error_response(404, request));
+    return handle_file_request(real_path, request);
+}
+
+static bool accepts_gzip_encoding(HTTP::HttpRequest const& request)
+{
+    auto accept_encoding = request.headers().get("Accept-Encoding"sv);
+    if (!accept_encoding.has_value())
         return false;
+    for (auto coding : accept_encoding->split_view(',')) {
+        auto parts = coding.split_view(';');
+        if (parts.is_empty() || !parts[0].trim_whitespace().equals_ignoring_ascii_case("gzip"sv))
+            continue;
+        // "gzip;q=0" explicitly refuses it.
+        return parts.size() < 2 || parts[1].trim_whitespace() != "q=0"sv;
     }
+    return false;
+}
 
-    auto is_readable_or_error = Core::System::access(real_path.bytes_as_string_view(), R_OK);
-    if (is_readable_or_error.is_error()) {
-        TRY(send_error_response(403, request));
+static bool matches_etag(HTTP::HttpRequest const& request, StringView etag)
+{
+    auto if_none_match = request.headers().get("If-None-Match"sv);
+    if (!if_none_match.has_value())
         return false;
+    for (auto candidate : if_none_match->split_view(',')) {
+        candidate = candidate.trim_whitespace();
+        // We only send strong validators, but clients may compare them weakly.
+        if (candidate.starts_with("W/"sv))
+            candidate = candidate.substring_view(2);
+        if (candidate == "*"sv || candidate == etag)
+            return true;
+    }
+    return false;
+}
+
+ErrorOr<bool> Client::handle_file_request(String const& real_path, HTTP::HttpRequest const& request)
+{
+    auto& cache = FileCache::the();
+    auto identity_key = real_path.to_byte_string();
+    auto gzip_key = ByteString::formatted("gzip:{}", real_path);
+    bool accepts_gzip = accepts_gzip_encoding(request);
+
+    if (accepts_gzip) {
+        if (auto const* entry = cache.find_fresh(gzip_key)) {
+            TRY(send_cached_file(*entry, request));
+            return true;
+        }
+    }
+    if (auto const* entry = cache.find_fresh(identity_key)) {
+        TRY(send_cached_file(*entry, request));
+        return true;
     }
 
-    if (FileSystem::is_device(real_path.bytes_as_string_view())) {
+    auto status_or_error = Core::System::stat(real_path.bytes_as_string_view());
+    if (status_or_error.is_error()) {
+        TRY(send_error_response(404, request));
+        return false;
+    }
+    auto status = status_or_error.release_value();
+    if (!S_ISREG(status.st_mode)) {
         TRY(send_error_response(403, request));
         return false;
     }
 
-    auto stream = TRY(Core::File::open(real_path.bytes_as_string_view(), Core::File::OpenMode::Read));
+    // A pre-compressed variant next to the file is sent instead, as long as it isn't older than the file itself.
+    auto path = identity_key;
+    auto key = identity_key;
+    bool is_gzip_encoded = false;
+    if (accepts_gzip) {
+        auto gzip_path = ByteString::formatted("{}.gz", real_path);
+        auto gzip_status_or_error = Core::System::stat(gzip_path);
+        if (!gzip_status_or_error.is_error() && S_ISREG(gzip_status_or_error.value().st_mode) && gzip_status_or_error.value().st_mtime >= status.st_mtime) {
+            path = move(gzip_path);
+            key = move(gzip_key);
+            status = gzip_status_or_error.release_value();
+            is_gzip_encoded = true;
+        }
+    }
+
+    if (auto const* entry = cache.find_valid(key, status)) {
+        TRY(send_cached_file(*entry, request));
+        return true;
+    }
+
+    auto etag = ByteString::formatted("\"{:x}-{:x}{}\"", status.st_mtime, status.st_size, is_gzip_encoded ? "-gzip"sv : ""sv);
+    if (matches_etag(request, etag)) {
+        TRY(send_not_modified(etag, request));
+        return true;
+    }
+
+    auto file_or_error = Core::File::open(path, Core::File::OpenMode::Read);
+    if (file_or_error.is_error()) {
+        TRY(send_error_response(403, request));
+        return false;
+    }
+    auto file = file_or_error.release_value();
 
-    auto const info = ContentInfo {
+    auto info = ContentInfo {
         .type = TRY(String::from_utf8(Core::guess_mime_type_based_on_filename(real_path.bytes_as_string_view()))),
-        .length = static_cast<u64>(TRY(FileSystem::size_from_stat(real_path.bytes_as_string_view())))
+        .length = static_cast<u64>(status.st_size),
+        .etag = etag,
+        .is_gzip_encoded = is_gzip_encoded,
     };
-    TRY(send_response(*stream, request, move(info)));
+
+    if (info.length > FileCache::max_file_size) {
+        TRY(send_response_headers(request, info));
+        TRY(m_output.try_append(FileTransfer { move(file), 0, info.length }));
+        return true;
+    }
+
+    auto body = TRY(file->read_until_eof());
+    if (body.size() != info.length) {
+        // The file has changed since we looked at it, so we send what we got without caching it.
+        info.length = body.size();
+        TRY(send_response(body, request, move(info)));
+        return true;
+    }
+
+    auto const* entry = TRY(cache.add(key, status, TRY(build_response_headers(info)), move(body), move(etag)));
+    VERIFY(entry);
+    TRY(send_cached_file(*entry, request));
     return true;
 }
 
-ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& request, ContentInfo content_info)
+ErrorOr<ByteBuffer> Client::build_response_headers(ContentInfo const& content_info)
 {
     StringBuilder builder;
-    TRY(builder.try_append("HTTP/1.0 200 OK\r\n"sv));
+    TRY(builder.try_append("HTTP/1.1 200 OK\r\n"sv));
     TRY(builder.try_append("Server: WebServer (SerenityOS)\r\n"sv));
     TRY(builder.try_append("X-Frame-Options: SAMEORIGIN\r\n"sv));
     TRY(builder.try_append("X-Content-Type-Options: nosniff\r\n"sv));
@@ -189,57 +390,151 @@ ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& r
     else
         TRY(builder.try_appendff("Content-Type: {}\r\n", content_info.type));
     TRY(builder.try_appendff("Content-Length: {}\r\n", content_info.length));
-    TRY(builder.try_append("\r\n"sv));
+    // Files get an ETag, and may also be sent pre-compressed.
+    if (!content_info.etag.is_empty()) {
+        TRY(builder.try_append("Cache-Control: no-cache\r\n"sv));
+        TRY(builder.try_appendff("ETag: {}\r\n", content_info.etag));
+        TRY(builder.try_append("Vary: Accept-Encoding\r\n"sv));
+    }
+    if (content_info.is_gzip_encoded)
+        TRY(builder.try_append("Content-Encoding: gzip\r\n"sv));
+    return builder.to_byte_buffer();
+}
 
-    auto builder_contents = TRY(builder.to_byte_buffer());
-    TRY(m_socket->write_until_depleted(builder_contents));
+ErrorOr<void> Client::send_response_headers(HTTP::HttpRequest const& request, ContentInfo const& content_info)
+{
+    TRY(queue_output(TRY(build_response_headers(content_info))));
+    TRY(queue_connection_header());
     log_response(200, request);
+    return {};
+}
 
-    char buffer[PAGE_SIZE];
-    do {
-        auto size = TRY(response.read_some({ buffer, sizeof(buffer) })).size();
-        if (response.is_eof() && size == 0)
-            break;
-
-        ReadonlyBytes write_buffer { buffer, size };
-        while (!write_buffer.is_empty()) {
-            auto nwritten = TRY(m_socket->write_some(write_buffer));
+ErrorOr<void> Client::send_response(ReadonlyBytes body, HTTP::HttpRequest const& request, ContentInfo content_info)
+{
+    TRY(send_response_headers(request, content_info));
+    TRY(queue_output(body));
+    return {};
+}
 
-            if (nwritten == 0) {
-                dbgln("EEEEEE got 0 bytes written!");
-            }
+ErrorOr<void> Client::send_cached_file(FileCache::Entry const& entry, HTTP::HttpRequest const& request)
+{
+    if (matches_etag(request, entry.etag))
+        return send_not_modified(entry.etag, request);
 
-            write_buffer = write_buffer.slice(nwritten);
-        }
-    } while (true);
+    TRY(queue_output(entry.headers));
+    TRY(queue_connection_header());
+    TRY(queue_output(entry.body));
+    log_response(200, request);
+    return {};
+}
 
-    auto keep_alive = false;
-    if (auto it = request.headers().headers().find_if([](auto& header) { return header.name.equals_ignoring_ascii_case("Connection"sv); }); !it.is_end()) {
-        if (it->value.trim_whitespace().equals_ignoring_ascii_case("keep-alive"sv))
-            keep_alive = true;
-    }
-    if (!keep_alive)
-        m_socket->close();
+ErrorOr<void> Client::send_not_modified(ByteString const& etag, HTTP::HttpRequest const& request)
+{
+    StringBuilder builder;
+    TRY(builder.try_append("HTTP/1.1 304 Not Modified\r\n"sv));
+    TRY(builder.try_append("Server: WebServer (SerenityOS)\r\n"sv));
+    TRY(builder.try_appendff("ETag: {}\r\n", etag));
+    TRY(builder.try_append("Vary: Accept-Encoding\r\n"sv));
+    TRY(queue_output(TRY(builder.to_byte_buffer())));
+    TRY(queue_connection_header());
 
+    log_response(304, request);
     return {};
 }
 
 ErrorOr<void> Client::send_redirect(StringView redirect_path, HTTP::HttpRequest const& request)
 {
     StringBuilder builder;
-    TRY(builder.try_append("HTTP/1.0 301 Moved Permanently\r\n"sv));
+    TRY(builder.try_append("HTTP/1.1 301 Moved Permanently\r\n"sv));
     TRY(builder.try_append("Location: "sv));
     TRY(builder.try_append(redirect_path));
     TRY(builder.try_append("\r\n"sv));
-    TRY(builder.try_append("\r\n"sv));
-
-    auto builder_contents = TRY(builder.to_byte_buffer());
-    TRY(m_socket->write_until_depleted(builder_contents));
+    TRY(builder.try_append("Content-Length: 0\r\n"sv));
+    TRY(queue_output(TRY(builder.to_byte_buffer())));
+    TRY(queue_connection_header());
 
     log_response(301, request);
     return {};
 }
 
+ErrorOr<void> Client::queue_connection_header()
+{
+    if (m_keep_alive) {
+        auto header = ByteString::formatted("Connection: keep-alive\r\nKeep-Alive: timeout={}\r\n\r\n", keep_alive_timeout_ms / 1000);
+        return queue_output(header.bytes());
+    }
+    return queue_output("Connection: close\r\n\r\n"sv.bytes());
+}
+
+ErrorOr<void> Client::queue_output(ReadonlyBytes bytes)
+{
+    if (bytes.is_empty())
+        return {};
+
+    // Small pieces are joined, so that a response usually goes out in a single write.
+    if (!m_output.is_empty() && m_output.last().has<BufferTransfer>())
+        TRY(m_output.last().get<BufferTransfer>().data.try_append(bytes));
+    else
+        TRY(m_output.try_append(BufferTransfer { TRY(ByteBuffer::copy(bytes)), 0 }));
+    m_buffered_output_size += bytes.size();
+    return {};
+}
+
+static bool is_would_block(Error const& error)
+{
+    return error.is_errno() && (error.code() == EAGAIN || error.code() == EWOULDBLOCK);
+}
+
+ErrorOr<void> Client::flush_output()
+{
+    auto& socket = m_socket->underlying_socket();
+    while (!m_output.is_empty() && !m_is_dead) {
+        auto finished = TRY(m_output.first().visit(
+            [&](BufferTransfer& transfer) -> ErrorOr<bool> {
+                while (transfer.offset < transfer.data.size()) {
+                    auto nwritten_or_error = m_socket->write_some(transfer.data.bytes().slice(transfer.offset));
+                    if (nwritten_or_error.is_error()) {
+                        if (is_would_block(nwritten_or_error.error()))
+                            return false;
+                        return nwritten_or_error.release_error();
+                    }
+                    transfer.offset += nwritten_or_error.value();
+                    m_buffered_output_size -= nwritten_or_error.value();
+                    m_idle_timer->restart();
+                }
+                return true;
+            },
+            [&](FileTransfer& transfer) -> ErrorOr<bool> {
+                // The kernel moves the file contents into the socket for us, without a round trip through our address space.
+                while (transfer.remaining > 0) {
+                    auto nsent_or_error = Core::System::sendfile(socket.fd(), transfer.file->fd(), &transfer.offset, min<u64>(transfer.remaining, 1 * MiB));
+                    if (nsent_or_error.is_error()) {
+                        if (is_would_block(nsent_or_error.error()))
+                            return false;
+                        return nsent_or_error.release_error();
+                    }
+                    // We promised the client more than there is, so the connection can't be used anymore.
+                    if (nsent_or_error.value() == 0)
+                        return Error::from_string_literal("File was truncated while it was being sent");
+                    transfer.remaining -= nsent_or_error.value();
+                    m_idle_timer->restart();
+                }
+                return true;
+            }));
+
+        if (!finished) {
+            m_write_notifier->set_enabled(true);
+            return {};
+        }
+        m_output.take_first();
+    }
+
+    m_write_notifier->set_enabled(false);
+    if (m_close_after_output)
+        die();
+    return {};
+}
+
 static ByteString folder_image_data()
 {
     static ByteString cache;
@@ -338,8 +633,7 @@ ErrorOr<void> Client::handle_directory_listing(String const& requested_path, Str
     TRY(builder.try_append("</html>\n"sv));
 
     auto response = builder.to_byte_string();
-    FixedMemoryStream stream { response.bytes() };
-    return send_response(stream, request, { .type = "text/html"_string, .length = response.length() });
+    return send_response(response.bytes(), request, { .type = "text/html"_string, .length = response.length() });
 }
 
 ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const& request, Vector<String> const& headers)
@@ -353,7 +647,7 @@ ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const
     TRY(content_builder.try_append("</h1></body></html>"sv));
 
     StringBuilder header_builder;
-    TRY(header_builder.try_appendff("HTTP/1.0 {} ", code));
+    TRY(header_builder.try_appendff("HTTP/1.1 {} ", code));
     TRY(header_builder.try_append(reason_phrase));
     TRY(header_builder.try_append("\r\n"sv));
 
@@ -363,9 +657,9 @@ ErrorOr<void> Client::send_error_response(unsigned code, HTTP::HttpRequest const
     }
     TRY(header_builder.try_append("Content-Type: text/html; charset=UTF-8\r\n"sv));
     TRY(header_builder.try_appendff("Content-Length: {}\r\n", content_builder.length()));
-    TRY(header_builder.try_append("\r\n"sv));
-    TRY(m_socket->write_until_depleted(TRY(header_builder.to_byte_buffer())));
-    TRY(m_socket->write_until_depleted(TRY(content_builder.to_byte_buffer())));
+    TRY(queue_output(TRY(header_builder.to_byte_buffer())));
+    TRY(queue_connection_header());
+    TRY(queue_output(TRY(content_builder.to_byte_buffer())));
 
     log_response(code, request);
     return {};
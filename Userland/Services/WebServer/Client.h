@@ -7,11 +7,15 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/String.h>
+#include <AK/Variant.h>
 #include <LibCore/EventReceiver.h>
+#include <LibCore/Forward.h>
 #include <LibCore/Socket.h>
 #include <LibHTTP/Forward.h>
 #include <LibHTTP/HttpRequest.h>
+#include <WebServer/FileCache.h>
 
 namespace WebServer {
 
@@ -19,6 +23,15 @@ class Client final : public Core::EventReceiver {
     C_OBJECT(Client);
 
 public:
+    // How long a kept-alive connection may stay idle before we close it.
+    static constexpr int keep_alive_timeout_ms = 15'000;
+
+    // Pipelined requests are only handled while the responses to the previous ones are small enough to be buffered.
+    static constexpr size_t max_buffered_output_size = 1 * MiB;
+
+    // How much of the requests that haven't been handled yet we buffer before giving up on the client.
+    static constexpr size_t max_buffered_request_size = 1 * MiB;
+
     void start();
 
 private:
@@ -29,20 +42,51 @@ private:
     struct ContentInfo {
         String type;
         u64 length {};
+        ByteString etag {};
+        bool is_gzip_encoded { false };
+    };
+
+    // Responses are queued, and sent as the socket becomes writable.
+    struct BufferTransfer {
+        ByteBuffer data;
+        size_t offset { 0 };
+    };
+    // Large files are sent straight from the file system.
+    struct FileTransfer {
+        NonnullOwnPtr<Core::File> file;
+        off_t offset { 0 };
+        u64 remaining { 0 };
     };
+    using OutputChunk = Variant<BufferTransfer, FileTransfer>;
 
     ErrorOr<void, WrappedError> on_ready_to_read();
+    ErrorOr<void, WrappedError> handle_buffered_requests();
     ErrorOr<bool> handle_request(HTTP::HttpRequest const&);
-    ErrorOr<void> send_response(Stream&, HTTP::HttpRequest const&, ContentInfo);
+    ErrorOr<bool> handle_file_request(String const& real_path, HTTP::HttpRequest const&);
+    ErrorOr<ByteBuffer> build_response_headers(ContentInfo const&);
+    ErrorOr<void> send_response_headers(HTTP::HttpRequest const&, ContentInfo const&);
+    ErrorOr<void> send_response(ReadonlyBytes, HTTP::HttpRequest const&, ContentInfo);
+    ErrorOr<void> send_cached_file(FileCache::Entry const&, HTTP::HttpRequest const&);
+    ErrorOr<void> send_not_modified(ByteString const& etag, HTTP::HttpRequest const&);
     ErrorOr<void> send_redirect(StringView redirect, HTTP::HttpRequest const&);
     ErrorOr<void> send_error_response(unsigned code, HTTP::HttpRequest const&, Vector<String> const& headers = {});
+    ErrorOr<void> queue_output(ReadonlyBytes);
+    ErrorOr<void> queue_connection_header();
+    ErrorOr<void> flush_output();
     void die();
     void log_response(unsigned code, HTTP::HttpRequest const&);
     ErrorOr<void> handle_directory_listing(String const& requested_path, String const& real_path, HTTP::HttpRequest const&);
     bool verify_credentials(Vector<HTTP::Header> const&);
 
     NonnullOwnPtr<Core::BufferedTCPSocket> m_socket;
-    StringBuilder m_remaining_request;
+    ByteBuffer m_remaining_request;
+    Vector<OutputChunk> m_output;
+    size_t m_buffered_output_size { 0 };
+    bool m_keep_alive { false };
+    bool m_close_after_output { false };
+    bool m_is_dead { false };
+    RefPtr<Core::Notifier> m_write_notifier;
+    RefPtr<Core::Timer> m_idle_timer;
 };
 
 }
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <WebServer/FileCache.h>
+
+namespace WebServer {
+
+FileCache& FileCache::the()
+{
+    static FileCache s_the;
+    return s_the;
+}
+
+static bool has_same_status(struct stat const& a, struct stat const& b)
+{
+    // The change time also covers changes to the permissions, which could make the file unreadable for us.
+    return a.st_dev == b.st_dev
+        && a.st_ino == b.st_ino
+        && a.st_size == b.st_size
+        && a.st_mtime == b.st_mtime
+        && a.st_ctime == b.st_ctime;
+}
+
+FileCache::Entry const* FileCache::find_fresh(ByteString const& key)
+{
+    auto entry = m_entries.get(key);
+    if (!entry.has_value())
+        return nullptr;
+    if (MonotonicTime::now_coarse() - (*entry)->last_validated > revalidation_interval)
+        return nullptr;
+    (*entry)->last_use = ++m_use_counter;
+    return *entry;
+}
+
+FileCache::Entry const* FileCache::find_valid(ByteString const& key, struct stat const& status)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return nullptr;
+    if (!has_same_status(it->value->status, status)) {
+        m_total_size -= it->value->body.size();
+        m_entries.remove(it);
+        return nullptr;
+    }
+    it->value->last_validated = MonotonicTime::now_coarse();
+    it->value->last_use = ++m_use_counter;
+    return it->value;
+}
+
+ErrorOr<FileCache::Entry const*> FileCache::add(ByteString const& key, struct stat const& status, ByteBuffer headers, ByteBuffer body, ByteString etag)
+{
+    if (body.size() > max_file_size)
+        return nullptr;
+
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        m_total_size -= it->value->body.size();
+        m_entries.remove(it);
+    }
+    evict_until_size_is_at_most(max_total_size - body.size());
+
+    auto entry = TRY(try_make<Entry>());
+    entry->headers = move(headers);
+    entry->body = move(body);
+    entry->etag = move(etag);
+    entry->status = status;
+    entry->last_use = ++m_use_counter;
+
+    auto const* result = entry.ptr();
+    auto size = entry->body.size();
+    TRY(m_entries.try_set(key, move(entry)));
+    m_total_size += size;
+    return result;
+}
+
+void FileCache::evict_until_size_is_at_most(size_t size)
+{
+    while (m_total_size > size) {
+        auto least_recently_used = m_entries.begin();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+            if (it->value->last_use < least_recently_used->value->last_use)
+                least_recently_used = it;
+        }
+        m_total_size -= least_recently_used->value->body.size();
+        m_entries.remove(least_recently_used);
+    }
+}
+
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
+#include <sys/stat.h>
+
+namespace WebServer {
+
+// Small files that are served often are kept in memory, together with the headers of their responses, so that they
+// can be sent without opening or reading them again.
+class FileCache {
+public:
+    static constexpr size_t max_file_size = 256 * KiB;
+    static constexpr size_t max_total_size = 16 * MiB;
+
+    // A cached file is trusted for this long before its status is checked again, so that a burst of requests for the
+    // same file doesn't cost a stat() each.
+    static constexpr Duration revalidation_interval = Duration::from_seconds(1);
+
+    struct Entry {
+        // Everything up to (but not including) the Connection header.
+        ByteBuffer headers;
+        ByteBuffer body;
+        ByteString etag;
+
+        struct stat status {};
+        MonotonicTime last_validated { MonotonicTime::now_coarse() };
+        u64 last_use { 0 };
+    };
+
+    static FileCache& the();
+
+    // Returns the entry for the key if it has been validated recently, without touching the file system.
+    Entry const* find_fresh(ByteString const& key);
+
+    // Returns the entry for the key if the file still has the given status.
+    Entry const* find_valid(ByteString const& key, struct stat const&);
+
+    // Adds the contents of a file, and returns null if the file is too large to be cached.
+    ErrorOr<Entry const*> add(ByteString const& key, struct stat const&, ByteBuffer headers, ByteBuffer body, ByteString etag);
+
+private:
+    void evict_until_size_is_at_most(size_t);
+
+    HashMap<ByteString, NonnullOwnPtr<Entry>> m_entries;
+    size_t m_total_size { 0 };
+    u64 m_use_counter { 0 };
+};
+
+}
@@ -88,8 +88,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             return;
         }
 
+        // Clients are served from the event loop, so a slow one can't hold up the others.
         // FIXME: Propagate errors
-        MUST(maybe_buffered_socket.value()->set_blocking(true));
+        MUST(maybe_buffered_socket.value()->set_blocking(false));
         auto client = WebServer::Client::construct(maybe_buffered_socket.release_value(), server);
         client->start();
     };
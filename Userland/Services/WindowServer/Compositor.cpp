@@ -14,6 +14,7 @@
 #include "Window.h"
 #include "WindowManager.h"
 #include "WindowSwitcher.h"
+#include <AK/AnyOf.h>
 #include <AK/Debug.h>
 #include <AK/Memory.h>
 #include <AK/ScopeGuard.h>
@@ -99,6 +100,13 @@ void CompositorScreenData::init_bitmaps(Compositor& compositor, Screen& screen)
         m_screen_number_overlay = nullptr;
     }
 
+    if (compositor.showing_statistics()) {
+        m_statistics_overlay = compositor.create_overlay<CompositorStatisticsOverlay>(screen);
+        m_statistics_overlay->set_enabled(true);
+    } else {
+        m_statistics_overlay = nullptr;
+    }
+
     m_has_flipped = false;
     m_have_flush_rects = false;
     m_buffers_are_flipped = false;
@@ -107,6 +115,7 @@ void CompositorScreenData::init_bitmaps(Compositor& compositor, Screen& screen)
     m_flush_rects.clear_with_capacity();
     m_flush_transparent_rects.clear_with_capacity();
     m_flush_special_rects.clear_with_capacity();
+    m_back_buffer_damage.clear_with_capacity();
 
     auto size = screen.size();
     m_front_bitmap = nullptr;
@@ -179,9 +188,13 @@ void Compositor::compose()
 
     if (!m_invalidated_any) {
         // nothing dirtied since the last compose pass.
+        send_frame_callbacks(MonotonicTime::now());
         return;
     }
 
+    auto compose_start_time = MonotonicTime::now();
+    m_last_compose_time = compose_start_time;
+
     if (m_occlusions_dirty) {
         m_occlusions_dirty = false;
         recompute_occlusions();
@@ -215,27 +228,35 @@ void Compositor::compose()
     });
 
     // Any dirty rects in transparency areas may require windows above or below
-    // to also be marked dirty in these areas
-    wm.for_each_visible_window_from_back_to_front([&](Window& window) {
-        auto& dirty_rects = window.dirty_rects(); // dirty rects have already been adjusted for transition offset!
-        if (dirty_rects.is_empty())
-            return IterationDecision::Continue;
-        auto& affected_transparency_rects = window.affected_transparency_rects();
-        if (affected_transparency_rects.is_empty())
-            return IterationDecision::Continue;
-        // If we have transparency rects that affect others, we better have transparency rects ourselves...
-        auto& transparency_rects = window.transparency_rects();
-        VERIFY(!transparency_rects.is_empty());
-        for (auto& it : affected_transparency_rects) {
-            auto& affected_window_dirty_rects = it.key->dirty_rects();
-            auto& affected_rects = it.value;
-            affected_rects.for_each_intersected(dirty_rects, [&](auto& dirty_rect) {
-                affected_window_dirty_rects.add(dirty_rect);
+    // to also be marked dirty in these areas. As that can affect yet more windows
+    // where several transparent windows overlap, keep going until nothing changes.
+    bool marked_more_rects_dirty = false;
+    do {
+        marked_more_rects_dirty = false;
+        wm.for_each_visible_window_from_back_to_front([&](Window& window) {
+            auto& dirty_rects = window.dirty_rects(); // dirty rects have already been adjusted for transition offset!
+            if (dirty_rects.is_empty())
                 return IterationDecision::Continue;
-            });
-        }
-        return IterationDecision::Continue;
-    });
+            auto& affected_transparency_rects = window.affected_transparency_rects();
+            if (affected_transparency_rects.is_empty())
+                return IterationDecision::Continue;
+            // If we have transparency rects that affect others, we better have transparency rects ourselves...
+            auto& transparency_rects = window.transparency_rects();
+            VERIFY(!transparency_rects.is_empty());
+            for (auto& it : affected_transparency_rects) {
+                auto& affected_window_dirty_rects = it.key->dirty_rects();
+                auto& affected_rects = it.value;
+                affected_rects.for_each_intersected(dirty_rects, [&](auto& dirty_rect) {
+                    if (!affected_window_dirty_rects.contains(dirty_rect)) {
+                        affected_window_dirty_rects.add(dirty_rect);
+                        marked_more_rects_dirty = true;
+                    }
+                    return IterationDecision::Continue;
+                });
+            }
+            return IterationDecision::Continue;
+        });
+    } while (marked_more_rects_dirty);
 
     Color background_color = wm.palette().desktop_background();
     if (m_custom_background_color.has_value())
@@ -255,6 +276,10 @@ void Compositor::compose()
         screen_data.m_flush_rects.clear_with_capacity();
         screen_data.m_flush_transparent_rects.clear_with_capacity();
         screen_data.m_flush_special_rects.clear_with_capacity();
+        screen_data.m_frame_statistics = {};
+        screen_data.m_frame_changed_more_than_statistics = false;
+        // This has to happen before anything is drawn, as the cursor and animations are drawn on top of what's there.
+        screen_data.repair_back_buffer(screen, dirty_screen_rects);
         return IterationDecision::Continue;
     });
 
@@ -602,6 +627,103 @@ void Compositor::compose()
         flush(screen);
         return IterationDecision::Continue;
     });
+
+    auto compose_end_time = MonotonicTime::now();
+    m_compose_time_histogram.add(compose_end_time - compose_start_time);
+    send_frame_callbacks(compose_end_time);
+
+    if (m_show_statistics)
+        update_statistics_overlays();
+}
+
+static void copy_pixels(Screen& screen, Gfx::IntRect rect, Gfx::Bitmap const& from, Gfx::Bitmap& to)
+{
+    // Almost everything in Compositor is in logical coordinates, with the painters having
+    // a scale applied. But this routine accesses the buffer pixels directly, so it
+    // must work in physical coordinates.
+    auto scaled_rect = rect * screen.scale_factor();
+    Gfx::ARGB32 const* from_ptr = from.scanline(scaled_rect.y()) + scaled_rect.x();
+    Gfx::ARGB32* to_ptr = to.scanline(scaled_rect.y()) + scaled_rect.x();
+    size_t pitch = to.pitch();
+
+    for (int y = 0; y < scaled_rect.height(); ++y) {
+        fast_u32_copy(to_ptr, from_ptr, scaled_rect.width());
+        from_ptr = (Gfx::ARGB32 const*)((u8 const*)from_ptr + pitch);
+        to_ptr = (Gfx::ARGB32*)((u8*)to_ptr + pitch);
+    }
+}
+
+void CompositorScreenData::repair_back_buffer(Screen& screen, Gfx::DisjointIntRectSet const& rects_to_repaint)
+{
+    if (m_back_buffer_damage.is_empty())
+        return;
+
+    // Whatever is going to be repainted for this frame anyway doesn't have to be copied first, which saves most of the
+    // copying while something (like a window being moved) changes the same area in every frame.
+    auto rects_to_copy = m_back_buffer_damage.shatter(rects_to_repaint);
+    m_back_buffer_damage.clear_with_capacity();
+
+    auto screen_rect = screen.rect();
+    for (auto& rect : rects_to_copy.rects()) {
+        auto rect_in_screen = rect.intersected(screen_rect).translated(-screen_rect.location());
+        if (rect_in_screen.is_empty())
+            continue;
+        copy_pixels(screen, rect_in_screen, *m_front_bitmap, *m_back_bitmap);
+        m_frame_statistics.copied_pixels += rect_in_screen.size().area();
+        // The device has to know about this before we flip to this buffer.
+        if (screen.can_device_flush_buffers())
+            screen.queue_flush_display_rect(rect_in_screen);
+    }
+}
+
+void CompositorScreenData::update_frame_statistics()
+{
+    auto statistics_rect = m_statistics_overlay ? m_statistics_overlay->rect() : Gfx::IntRect {};
+    auto add_rects = [&](Gfx::DisjointIntRectSet const& rects) {
+        for (auto& rect : rects.rects()) {
+            auto area = static_cast<u64>(rect.size().area());
+            m_frame_statistics.composed_pixels += area;
+            m_frame_statistics.flushed_rect_count++;
+            if (area > static_cast<u64>(rect.intersected(statistics_rect).size().area()))
+                m_frame_changed_more_than_statistics = true;
+        }
+    };
+    add_rects(m_flush_rects);
+    add_rects(m_flush_transparent_rects);
+    add_rects(m_flush_special_rects);
+}
+
+void Compositor::update_statistics_overlays()
+{
+    Screen::for_each([&](auto& screen) {
+        auto& screen_data = screen.compositor_screen_data();
+        // Showing new statistics is a frame of its own, which shouldn't replace the statistics of the frame before it.
+        if (screen_data.m_statistics_overlay && screen_data.m_frame_changed_more_than_statistics) {
+            screen_data.m_frame_statistics.median_compose_time_ms = m_compose_time_histogram.limit_for_percentile_ms(50);
+            screen_data.m_frame_statistics.p99_compose_time_ms = m_compose_time_histogram.limit_for_percentile_ms(99);
+            screen_data.m_statistics_overlay->set_statistics(screen_data.m_frame_statistics);
+        }
+        return IterationDecision::Continue;
+    });
+}
+
+void Compositor::set_show_statistics(bool show)
+{
+    if (m_show_statistics == show)
+        return;
+    m_show_statistics = show;
+    m_compose_time_histogram.clear();
+
+    Screen::for_each([&](auto& screen) {
+        auto& screen_data = screen.compositor_screen_data();
+        if (show) {
+            screen_data.m_statistics_overlay = create_overlay<CompositorStatisticsOverlay>(screen);
+            screen_data.m_statistics_overlay->set_enabled(true);
+        } else {
+            screen_data.m_statistics_overlay = nullptr;
+        }
+        return IterationDecision::Continue;
+    });
 }
 
 void Compositor::flush(Screen& screen)
@@ -614,6 +736,7 @@ void Compositor::flush(Screen& screen)
         return;
     }
     screen_data.m_have_flush_rects = false;
+    screen_data.update_frame_statistics();
 
     auto screen_rect = screen.rect();
     if (m_flash_flush) {
@@ -662,51 +785,24 @@ void Compositor::flush(Screen& screen)
     if (screen_data.m_screen_can_set_buffer) {
         screen_data.flip_buffers(screen);
         screen_data.m_has_flipped = true;
+
+        // Rather than copying everything we drew to the new back buffer right away, remember it so that we only copy
+        // what won't be drawn again for the next frame.
+        screen_data.m_back_buffer_damage.add(screen_data.m_flush_rects);
+        screen_data.m_back_buffer_damage.add(screen_data.m_flush_transparent_rects);
+        screen_data.m_back_buffer_damage.add(screen_data.m_flush_special_rects);
+        return;
     }
 
+    // Without buffer flipping, flushing means that we copy the changed rects from the
+    // backing bitmap to the display framebuffer.
     auto do_flush = [&](Gfx::IntRect rect) {
         VERIFY(screen_rect.contains(rect));
         rect.translate_by(-screen_rect.location());
-
-        // Almost everything in Compositor is in logical coordinates, with the painters having
-        // a scale applied. But this routine accesses the backbuffer pixels directly, so it
-        // must work in physical coordinates.
-        auto scaled_rect = rect * screen.scale_factor();
-        Gfx::ARGB32* front_ptr = screen_data.m_front_bitmap->scanline(scaled_rect.y()) + scaled_rect.x();
-        Gfx::ARGB32* back_ptr = screen_data.m_back_bitmap->scanline(scaled_rect.y()) + scaled_rect.x();
-        size_t pitch = screen_data.m_back_bitmap->pitch();
-
-        // NOTE: The meaning of a flush depends on whether we can flip buffers or not.
-        //
-        //       If flipping is supported, flushing means that we've flipped, and now we
-        //       copy the changed bits from the front buffer to the back buffer, to keep
-        //       them in sync.
-        //
-        //       If flipping is not supported, flushing means that we copy the changed
-        //       rects from the backing bitmap to the display framebuffer.
-
-        Gfx::ARGB32* to_ptr;
-        Gfx::ARGB32 const* from_ptr;
-
-        if (screen_data.m_screen_can_set_buffer) {
-            to_ptr = back_ptr;
-            from_ptr = front_ptr;
-        } else {
-            to_ptr = front_ptr;
-            from_ptr = back_ptr;
-        }
-
-        for (int y = 0; y < scaled_rect.height(); ++y) {
-            fast_u32_copy(to_ptr, from_ptr, scaled_rect.width());
-            from_ptr = (Gfx::ARGB32 const*)((u8 const*)from_ptr + pitch);
-            to_ptr = (Gfx::ARGB32*)((u8*)to_ptr + pitch);
-        }
-        if (device_can_flush_buffers) {
-            // Whether or not we need to flush buffers, we need to at least track what we modified
-            // so that we can flush these areas next time before we flip buffers. Or, if we don't
-            // support buffer flipping then we will flush them shortly.
+        copy_pixels(screen, rect, *screen_data.m_back_bitmap, *screen_data.m_front_bitmap);
+        screen_data.m_frame_statistics.copied_pixels += rect.size().area();
+        if (device_can_flush_buffers)
             screen.queue_flush_display_rect(rect);
-        }
     };
     for (auto& rect : screen_data.m_flush_rects.rects())
         do_flush(rect);
@@ -714,13 +810,8 @@ void Compositor::flush(Screen& screen)
         do_flush(rect);
     for (auto& rect : screen_data.m_flush_special_rects.rects())
         do_flush(rect);
-    if (device_can_flush_buffers && !screen_data.m_screen_can_set_buffer) {
-        // If we also support flipping buffers we don't really need to flush these areas right now.
-        // Instead, we skip this step and just keep track of them until shortly before the next flip.
-        // If we however don't support flipping buffers then we need to flush the changed areas right
-        // now so that they can be sent to the device.
-        screen.flush_display(screen_data.m_buffers_are_flipped ? 1 : 0);
-    }
+    if (device_can_flush_buffers)
+        screen.flush_display(0);
 }
 
 void Compositor::invalidate_screen()
@@ -764,13 +855,16 @@ void Compositor::invalidate_window()
 
 void Compositor::start_compose_async_timer()
 {
-    // We delay composition by a timer interval, but to not affect latency too
-    // much, if a pending compose is not already scheduled, we also schedule an
-    // immediate compose the next spin of the event loop.
-    if (!m_compose_timer->is_active()) {
-        m_compose_timer->start();
+    // Frames are paced to the refresh rate. If the last one was composed long enough
+    // ago, we compose the next one on the next spin of the event loop to not affect
+    // latency, otherwise we wait until it's time for the next frame.
+    if (m_compose_timer->is_active() || m_immediate_compose_timer->is_active())
+        return;
+    auto time_since_last_compose = MonotonicTime::now() - m_last_compose_time;
+    if (time_since_last_compose >= frame_interval)
         m_immediate_compose_timer->start();
-    }
+    else
+        m_compose_timer->start((frame_interval - time_since_last_compose).to_milliseconds());
 }
 
 bool Compositor::set_background_color(ByteString const& background_color)
@@ -1070,6 +1164,64 @@ void Compositor::notify_display_links()
     });
 }
 
+void Compositor::request_frame_callback(Badge<ConnectionFromClient>, Window& window)
+{
+    auto is_waiting = any_of(m_windows_waiting_for_frame, [&](auto& waiting_window) { return waiting_window.ptr() == &window; });
+    if (!is_waiting)
+        m_windows_waiting_for_frame.append(window.make_weak_ptr<Window>());
+    start_compose_async_timer();
+}
+
+void Compositor::send_frame_callbacks(MonotonicTime frame_time)
+{
+    // Windows that can't be seen don't need new frames, so they are kept waiting until they can be seen again.
+    m_windows_waiting_for_frame.remove_all_matching([&](auto& window) {
+        if (!window || !window->client())
+            return true;
+        if (!window->is_visible() || window->is_minimized() || window->is_occluded())
+            return false;
+        window->client()->async_frame_callback(window->window_id(), frame_time.milliseconds());
+        return true;
+    });
+}
+
+void FrameTimeHistogram::add(Duration duration)
+{
+    // Older frames count for less and less, so that the histogram follows what's happening now.
+    static constexpr size_t max_frame_count = 600;
+    if (m_frame_count == max_frame_count) {
+        m_frame_count = 0;
+        for (auto& bucket : m_buckets) {
+            bucket /= 2;
+            m_frame_count += bucket;
+        }
+    }
+
+    size_t bucket_index = 0;
+    while (bucket_index < bucket_count && duration >= Duration::from_milliseconds(1 << bucket_index))
+        ++bucket_index;
+    ++m_buckets[bucket_index];
+    ++m_frame_count;
+}
+
+void FrameTimeHistogram::clear()
+{
+    m_buckets.fill(0);
+    m_frame_count = 0;
+}
+
+Optional<u32> FrameTimeHistogram::limit_for_percentile_ms(u32 percentile) const
+{
+    size_t frames_to_cover = (m_frame_count * percentile + 99) / 100;
+    size_t covered_frames = 0;
+    for (size_t i = 0; i < bucket_count; ++i) {
+        covered_frames += m_buckets[i];
+        if (covered_frames >= frames_to_cover)
+            return 1u << i;
+    }
+    return {};
+}
+
 void Compositor::increment_display_link_count(Badge<ConnectionFromClient>)
 {
     ++m_display_link_count;
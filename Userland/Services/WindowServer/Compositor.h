@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
+#include <AK/Time.h>
+#include <AK/WeakPtr.h>
 #include <LibCore/EventReceiver.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/DisjointRectSet.h>
@@ -32,6 +35,27 @@ enum class WallpaperMode {
     Fill,
 };
 
+// Counts how long frames took to compose, in buckets that are twice as large as the ones before them.
+class FrameTimeHistogram {
+public:
+    static constexpr size_t bucket_count = 9;
+    static constexpr u32 largest_limit_ms = 1u << (bucket_count - 1);
+
+    void add(Duration);
+    void clear();
+
+    size_t frame_count() const { return m_frame_count; }
+
+    // The upper limit of the bucket that the given percentage of frames fits into, if that isn't the last one.
+    Optional<u32> limit_for_percentile_ms(u32 percentile) const;
+
+private:
+    // Bucket n counts the frames that took less than 2^n ms, but not less than the limit of the bucket before it.
+    // The last one counts all frames that took longer than that.
+    Array<u32, bucket_count + 1> m_buckets {};
+    size_t m_frame_count { 0 };
+};
+
 struct CompositorScreenData {
     RefPtr<Gfx::Bitmap> m_front_bitmap;
     RefPtr<Gfx::Bitmap> m_back_bitmap;
@@ -45,6 +69,7 @@ struct CompositorScreenData {
     Gfx::IntRect m_last_cursor_rect;
     OwnPtr<ScreenNumberOverlay> m_screen_number_overlay;
     OwnPtr<WindowStackSwitchOverlay> m_window_stack_switch_overlay;
+    OwnPtr<CompositorStatisticsOverlay> m_statistics_overlay;
     bool m_buffers_are_flipped { false };
     bool m_screen_can_set_buffer { false };
     bool m_has_flipped { false };
@@ -55,9 +80,18 @@ struct CompositorScreenData {
     Gfx::DisjointIntRectSet m_flush_transparent_rects;
     Gfx::DisjointIntRectSet m_flush_special_rects;
 
+    // The areas in which the back buffer is older than the front buffer. After flipping, this is everything that was
+    // drawn for the frame that is now shown, and it is copied over before the next frame is drawn into the back buffer.
+    Gfx::DisjointIntRectSet m_back_buffer_damage;
+
+    CompositorStatisticsOverlay::Statistics m_frame_statistics;
+    bool m_frame_changed_more_than_statistics { false };
+
     Gfx::Painter& overlay_painter() { return *m_temp_painter; }
 
     void init_bitmaps(Compositor&, Screen&);
+    void repair_back_buffer(Screen&, Gfx::DisjointIntRectSet const& rects_to_repaint);
+    void update_frame_statistics();
     void flip_buffers(Screen&);
     void draw_cursor(Screen&, Gfx::IntRect const&);
     bool restore_cursor_back(Screen&, Gfx::IntRect&);
@@ -118,10 +152,19 @@ public:
     void increment_display_link_count(Badge<ConnectionFromClient>);
     void decrement_display_link_count(Badge<ConnectionFromClient>);
 
+    // Notifies the client once the next frame that shows the window has been flushed.
+    void request_frame_callback(Badge<ConnectionFromClient>, Window&);
+
+    // We don't get any notifications about when a display refreshes, so we assume that it happens at this rate.
+    static constexpr Duration frame_interval = Duration::from_microseconds(1'000'000 / 60);
+
     void increment_show_screen_number(Badge<ConnectionFromClient>);
     void decrement_show_screen_number(Badge<ConnectionFromClient>);
     bool showing_screen_numbers() const { return m_show_screen_number_count > 0; }
 
+    void set_show_statistics(bool);
+    bool showing_statistics() const { return m_show_statistics; }
+
     void invalidate_after_theme_or_font_change()
     {
         update_fonts();
@@ -193,6 +236,8 @@ private:
     Compositor();
     void init_bitmaps();
     void invalidate_current_screen_number_rects();
+    void update_statistics_overlays();
+    void send_frame_callbacks(MonotonicTime frame_time);
     void overlays_theme_changed();
 
     void render_overlays();
@@ -217,6 +262,10 @@ private:
     RefPtr<Core::Timer> m_compose_timer;
     RefPtr<Core::Timer> m_immediate_compose_timer;
     bool m_flash_flush { false };
+    bool m_show_statistics { false };
+    MonotonicTime m_last_compose_time { MonotonicTime::now_coarse() };
+    FrameTimeHistogram m_compose_time_histogram;
+    Vector<WeakPtr<Window>> m_windows_waiting_for_frame;
     bool m_occlusions_dirty { true };
     bool m_invalidated_any { true };
     bool m_invalidated_window { false };
@@ -54,6 +54,10 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<Core::LocalSocket> clie
         s_connections = new HashMap<int, NonnullRefPtr<ConnectionFromClient>>;
     s_connections->set(client_id, *this);
 
+    // Input events and window updates are sent at a high rate, so don't make a system call for each of them.
+    if (auto result = enable_shared_memory_transport(); result.is_error())
+        dbgln("Failed to enable shared memory transport for client {}: {}", client_id, result.error());
+
     auto& wm = WindowManager::the();
     async_fast_greet(Screen::rects(), Screen::main().index(), wm.window_stack_rows(), wm.window_stack_columns(), Gfx::current_system_theme_buffer(), Gfx::FontDatabase::default_font_query(), Gfx::FontDatabase::fixed_width_font_query(), Gfx::FontDatabase::window_title_font_query(), wm.system_effects().effects(), client_id);
 }
@@ -811,6 +815,27 @@ void ConnectionFromClient::set_window_backing_store(i32 window_id, [[maybe_unuse
         window.invalidate(false);
 }
 
+void ConnectionFromClient::flip_backing_store(i32 window_id, i32 serial, Gfx::IntSize visible_size, Vector<Gfx::IntRect> const& damage)
+{
+    auto it = m_windows.find(window_id);
+    if (it == m_windows.end()) {
+        did_misbehave("FlipBackingStore: Bad window ID");
+        return;
+    }
+    auto& window = *(*it).value;
+    if (window.backing_store_serial() != serial) {
+        if (!window.last_backing_store() || window.last_backing_store_serial() != serial) {
+            did_misbehave("FlipBackingStore: Unknown backing store serial");
+            return;
+        }
+        window.swap_backing_stores();
+    }
+    window.set_backing_store_visible_size(visible_size);
+
+    // Only what the client painted has changed, so that's all we have to compose again.
+    did_finish_painting(window_id, damage);
+}
+
 void ConnectionFromClient::set_global_mouse_tracking(bool enabled)
 {
     m_does_global_mouse_tracking = enabled;
@@ -1056,6 +1081,16 @@ void ConnectionFromClient::disable_display_link()
     Compositor::the().decrement_display_link_count({});
 }
 
+void ConnectionFromClient::request_frame_callback(i32 window_id)
+{
+    auto it = m_windows.find(window_id);
+    if (it == m_windows.end()) {
+        did_misbehave("RequestFrameCallback: Bad window ID");
+        return;
+    }
+    Compositor::the().request_frame_callback({}, *it->value);
+}
+
 void ConnectionFromClient::notify_display_link(Badge<Compositor>)
 {
     if (!m_has_display_link)
@@ -1359,6 +1394,11 @@ void ConnectionFromClient::set_flash_flush(bool enabled)
     Compositor::the().set_flash_flush(enabled);
 }
 
+void ConnectionFromClient::set_show_compositor_statistics(bool enabled)
+{
+    Compositor::the().set_show_statistics(enabled);
+}
+
 void ConnectionFromClient::set_window_parent_from_client(i32 client_id, i32 parent_id, i32 child_id)
 {
     auto* child_window = window_from_id(child_id);
@@ -228,6 +228,57 @@ Gfx::IntRect ScreenNumberOverlay::calculate_content_rect_for_screen(Screen& scre
     return calculate_frame_rect(content_rect);
 }
 
+CompositorStatisticsOverlay::CompositorStatisticsOverlay(Screen& screen)
+    : m_screen(screen)
+{
+    // Make room for the largest numbers we can show, so that the overlay doesn't jump around.
+    auto& font = WindowManager::the().font();
+    auto line_height = font.pixel_size_rounded_up() + line_spacing;
+    auto widest_line = max(font.width("Composed: 000000000 px (100.0%)"sv), font.width("Compose: >= 000 ms (99%: >= 000 ms)"sv));
+    m_content_size = { static_cast<int>(ceilf(widest_line)) + 16, 4 * line_height + 10 };
+
+    Gfx::IntRect content_rect { { screen.width() - default_offset - m_content_size.width(), default_offset }, m_content_size };
+    content_rect.translate_by(screen.rect().location());
+    set_content_rect(content_rect);
+}
+
+void CompositorStatisticsOverlay::set_statistics(Statistics const& statistics)
+{
+    if (m_statistics == statistics)
+        return;
+    m_statistics = statistics;
+    invalidate_content();
+}
+
+Vector<ByteString, 4> CompositorStatisticsOverlay::lines() const
+{
+    auto screen_pixels = static_cast<u64>(m_screen.width()) * m_screen.height();
+    auto percentage = screen_pixels ? 100.0 * m_statistics.composed_pixels / screen_pixels : 0.0;
+    auto format_compose_time = [](Optional<u32> limit_ms) {
+        if (!limit_ms.has_value())
+            return ByteString::formatted(">= {} ms", FrameTimeHistogram::largest_limit_ms);
+        return ByteString::formatted("< {} ms", *limit_ms);
+    };
+    return {
+        ByteString::formatted("Composed: {} px ({:.1}%)", m_statistics.composed_pixels, percentage),
+        ByteString::formatted("Copied: {} px", m_statistics.copied_pixels),
+        ByteString::formatted("Flushed: {} rects", m_statistics.flushed_rect_count),
+        ByteString::formatted("Compose: {} (99%: {})", format_compose_time(m_statistics.median_compose_time_ms), format_compose_time(m_statistics.p99_compose_time_ms)),
+    };
+}
+
+void CompositorStatisticsOverlay::render_overlay_bitmap(Gfx::Painter& painter)
+{
+    auto& font = WindowManager::the().font();
+    auto line_height = font.pixel_size_rounded_up() + line_spacing;
+    auto content_rect = Gfx::IntRect { {}, m_content_size }.centered_within({ {}, rect().size() });
+    Gfx::IntRect line_rect { content_rect.x() + 8, content_rect.y() + 5, content_rect.width() - 16, line_height };
+    for (auto& line : lines()) {
+        painter.draw_text(line_rect, line, font, Gfx::TextAlignment::CenterLeft, Color::White);
+        line_rect.translate_by(0, line_height);
+    }
+}
+
 WindowGeometryOverlay::WindowGeometryOverlay(Window& window)
     : m_window(window)
 {
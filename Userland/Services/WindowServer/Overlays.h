@@ -35,6 +35,7 @@ public:
         Dnd,
         WindowStackSwitch,
         ScreenNumber,
+        CompositorStatistics,
     };
     [[nodiscard]] virtual ZOrder zorder() const = 0;
     virtual void render(Gfx::Painter&, Screen const&) = 0;
@@ -138,6 +139,38 @@ private:
     static Gfx::Font const* s_font;
 };
 
+// Shows how much work the compositor did for the last frame on a screen that changed anything besides this overlay.
+class CompositorStatisticsOverlay : public RectangularOverlay {
+public:
+    static constexpr int default_offset = 20;
+    static constexpr int line_spacing = 4;
+
+    struct Statistics {
+        u64 composed_pixels { 0 };
+        u64 copied_pixels { 0 };
+        size_t flushed_rect_count { 0 };
+        // The upper limits of the compose time buckets that half and 99% of the frames fell into, if they have one.
+        Optional<u32> median_compose_time_ms;
+        Optional<u32> p99_compose_time_ms;
+
+        bool operator==(Statistics const&) const = default;
+    };
+
+    CompositorStatisticsOverlay(Screen&);
+
+    void set_statistics(Statistics const&);
+
+    virtual ZOrder zorder() const override { return ZOrder::CompositorStatistics; }
+    virtual void render_overlay_bitmap(Gfx::Painter&) override;
+
+private:
+    Vector<ByteString, 4> lines() const;
+
+    Screen& m_screen;
+    Statistics m_statistics;
+    Gfx::IntSize m_content_size;
+};
+
 class WindowGeometryOverlay : public RectangularOverlay {
 public:
     WindowGeometryOverlay(Window&);
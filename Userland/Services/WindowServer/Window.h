@@ -252,6 +252,7 @@ public:
         swap(m_backing_store_serial, m_last_backing_store_serial);
     }
 
+    i32 backing_store_serial() const { return m_backing_store_serial; }
     Gfx::Bitmap* last_backing_store() { return m_last_backing_store.ptr(); }
     i32 last_backing_store_serial() const { return m_last_backing_store_serial; }
 
@@ -10,11 +10,12 @@
 #include <LibCore/System.h>
 #include <LibCrypto/Hash/HashManager.h>
 #include <LibMain/Main.h>
+#include <LibThreading/ParallelAlgorithms.h>
 #include <unistd.h>
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::pledge("stdio rpath thread"));
 
     auto program_name = LexicalPath::basename(arguments.strings[0]);
     auto hash_kind = Crypto::Hash::HashKind::None;
@@ -49,10 +50,42 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (paths.is_empty())
         paths.append("-"sv);
 
+    bool has_error = false;
+
+    if (!verify_from_paths) {
+        auto hash_file = [hash_kind](StringView path) -> ErrorOr<ByteString> {
+            auto file = TRY(Core::File::open_file_or_standard_stream(path, Core::File::OpenMode::Read));
+            Crypto::Hash::Manager hash;
+            hash.initialize(hash_kind);
+            Array<u8, PAGE_SIZE> buffer;
+            while (!file->is_eof())
+                hash.update(TRY(file->read_some(buffer)));
+            return ByteString::formatted("{:hex-dump}", hash.digest().bytes());
+        };
+
+        // Hash the files in parallel, but print the results in the order they were given in.
+        Vector<Optional<ErrorOr<ByteString>>> checksums;
+        checksums.resize(paths.size());
+        Threading::parallel_for(paths.span(), 1, [&](Span<StringView> paths_to_hash) {
+            for (auto& path : paths_to_hash)
+                checksums[&path - paths.data()] = hash_file(path);
+        });
+
+        for (size_t i = 0; i < paths.size(); ++i) {
+            auto& checksum = checksums[i].value();
+            if (checksum.is_error()) {
+                has_error = true;
+                warnln("{}: {}", paths[i], checksum.error());
+                continue;
+            }
+            outln("{}  {}", checksum.value(), paths[i]);
+        }
+        return has_error ? 1 : 0;
+    }
+
     Crypto::Hash::Manager hash;
     hash.initialize(hash_kind);
 
-    bool has_error = false;
     int read_fail_count = 0;
     int failed_verification_count = 0;
 
@@ -66,65 +99,57 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         }
         auto file = file_or_error.release_value();
         Array<u8, PAGE_SIZE> buffer;
-        if (!verify_from_paths) {
-            while (!file->is_eof())
-                hash.update(TRY(file->read_some(buffer)));
-            outln("{:hex-dump}  {}", hash.digest().bytes(), path);
-        } else {
-            StringBuilder checksum_list_contents;
-            Array<u8, 1> checksum_list_buffer;
-            while (!file->is_eof())
-                checksum_list_contents.append(TRY(file->read_some(checksum_list_buffer)).data()[0]);
-            Vector<StringView> const lines = checksum_list_contents.string_view().split_view("\n"sv);
-
-            for (size_t i = 0; i < lines.size(); ++i) {
-                Vector<StringView> const line = lines[i].split_view("  "sv);
-                if (line.size() != 2) {
-                    ++read_fail_count;
-                    // The real line number is greater than the iterator.
-                    warnln("{}: {}: Failed to parse line {}", program_name, path, i + 1);
-                    continue;
-                }
-
-                // line[0] = checksum
-                // line[1] = filename
-                StringView const filename = line[1];
-                auto file_from_filename_or_error = Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read);
-                if (file_from_filename_or_error.is_error()) {
-                    ++read_fail_count;
-                    warnln("{}: {}", filename, file_from_filename_or_error.release_error());
-                    continue;
-                }
-                auto file_from_filename = file_from_filename_or_error.release_value();
-                hash.reset();
-                while (!file_from_filename->is_eof())
-                    hash.update(TRY(file_from_filename->read_some(buffer)));
-                if (ByteString::formatted("{:hex-dump}", hash.digest().bytes()) == line[0])
-                    outln("{}: OK", filename);
-                else {
-                    ++failed_verification_count;
-                    warnln("{}: FAILED", filename);
-                }
+        StringBuilder checksum_list_contents;
+        Array<u8, 1> checksum_list_buffer;
+        while (!file->is_eof())
+            checksum_list_contents.append(TRY(file->read_some(checksum_list_buffer)).data()[0]);
+        Vector<StringView> const lines = checksum_list_contents.string_view().split_view("\n"sv);
+
+        for (size_t i = 0; i < lines.size(); ++i) {
+            Vector<StringView> const line = lines[i].split_view("  "sv);
+            if (line.size() != 2) {
+                ++read_fail_count;
+                // The real line number is greater than the iterator.
+                warnln("{}: {}: Failed to parse line {}", program_name, path, i + 1);
+                continue;
+            }
+
+            // line[0] = checksum
+            // line[1] = filename
+            StringView const filename = line[1];
+            auto file_from_filename_or_error = Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read);
+            if (file_from_filename_or_error.is_error()) {
+                ++read_fail_count;
+                warnln("{}: {}", filename, file_from_filename_or_error.release_error());
+                continue;
+            }
+            auto file_from_filename = file_from_filename_or_error.release_value();
+            hash.reset();
+            while (!file_from_filename->is_eof())
+                hash.update(TRY(file_from_filename->read_some(buffer)));
+            if (ByteString::formatted("{:hex-dump}", hash.digest().bytes()) == line[0])
+                outln("{}: OK", filename);
+            else {
+                ++failed_verification_count;
+                warnln("{}: FAILED", filename);
             }
         }
     }
     // Print the warnings here in order to only print them once.
-    if (verify_from_paths) {
-        if (read_fail_count) {
-            if (read_fail_count == 1)
-                warnln("WARNING: 1 file could not be read");
-            else
-                warnln("WARNING: {} files could not be read", read_fail_count);
-            has_error = true;
-        }
+    if (read_fail_count) {
+        if (read_fail_count == 1)
+            warnln("WARNING: 1 file could not be read");
+        else
+            warnln("WARNING: {} files could not be read", read_fail_count);
+        has_error = true;
+    }
 
-        if (failed_verification_count) {
-            if (failed_verification_count == 1)
-                warnln("WARNING: 1 checksum did NOT match");
-            else
-                warnln("WARNING: {} checksums did NOT match", failed_verification_count);
-            has_error = true;
-        }
+    if (failed_verification_count) {
+        if (failed_verification_count == 1)
+            warnln("WARNING: 1 checksum did NOT match");
+        else
+            warnln("WARNING: {} checksums did NOT match", failed_verification_count);
+        has_error = true;
     }
     return has_error ? 1 : 0;
 }
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/CPUFeatures.h>
 #include <AK/HashMap.h>
 #include <AK/NumberFormat.h>
 #include <AK/Random.h>
@@ -184,6 +185,29 @@ static ErrorOr<void> benchmark(StringView algorithm)
     return Error::from_string_literal("Unknown algorithm");
 }
 
+// Several algorithms pick their implementation based on the CPU features that are available, so the results are only
+// comparable between runs with the same features.
+static void print_cpu_features()
+{
+    auto features = detect_cpu_features();
+    Vector<StringView> names;
+    auto add_if_detected = [&](CPUFeatures feature, StringView name) {
+        if (is_valid_feature(feature) && has_flag(features, feature))
+            names.append(name);
+    };
+
+    add_if_detected(CPUFeatures::X86_SSE42, "sse4.2"sv);
+    add_if_detected(CPUFeatures::X86_SHA, "sha (SHA-1, SHA-256)"sv);
+    add_if_detected(CPUFeatures::X86_AES, "aes (AES)"sv);
+    add_if_detected(CPUFeatures::X86_PCLMUL, "pclmul (GHASH)"sv);
+    add_if_detected(CPUFeatures::X86_AVX2, "avx2 (BLAKE2b)"sv);
+
+    if (names.is_empty())
+        outln("CPU features: none, using the portable implementations");
+    else
+        outln("CPU features: {}", ByteString::join(", "sv, names));
+}
+
 static void print_benchmark_results()
 {
     // algo, size, min, max, avg, throughput
@@ -254,6 +278,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             TRY(benchmark(algorithm));
     }
 
+    print_cpu_features();
     print_benchmark_results();
 
     return 0;
@@ -60,7 +60,7 @@ struct AK::Traits<VisitedFile> : public DefaultTraits<VisitedFile> {
 static HashTable<VisitedFile> s_visited_files;
 
 static ErrorOr<void> parse_args(Main::Arguments arguments, Vector<ByteString>& files, DuOption& du_option);
-static u64 print_space_usage(ByteString const& path, DuOption const& du_option, size_t current_depth, Optional<dev_t> root_device = {});
+static u64 print_space_usage(ByteString const& path, DuOption const& du_option, size_t current_depth, Optional<dev_t> root_device = {}, Optional<struct stat> known_stat = {});
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
@@ -182,16 +182,19 @@ ErrorOr<void> parse_args(Main::Arguments arguments, Vector<ByteString>& files, D
     return {};
 }
 
-u64 print_space_usage(ByteString const& path, DuOption const& du_option, size_t current_depth, Optional<dev_t> root_device)
+u64 print_space_usage(ByteString const& path, DuOption const& du_option, size_t current_depth, Optional<dev_t> root_device, Optional<struct stat> known_stat)
 {
     u64 size = 0;
-    auto path_stat_or_error = Core::System::lstat(path);
-    if (path_stat_or_error.is_error()) {
-        warnln("du: cannot stat '{}': {}", path, path_stat_or_error.release_error());
-        return 0;
+    if (!known_stat.has_value()) {
+        auto path_stat_or_error = Core::System::lstat(path);
+        if (path_stat_or_error.is_error()) {
+            warnln("du: cannot stat '{}': {}", path, path_stat_or_error.release_error());
+            return 0;
+        }
+        known_stat = path_stat_or_error.release_value();
     }
 
-    auto path_stat = path_stat_or_error.release_value();
+    auto path_stat = known_stat.release_value();
 
     if (!root_device.has_value()) {
         root_device = path_stat.st_dev;
@@ -209,7 +212,7 @@ u64 print_space_usage(ByteString const& path, DuOption const& du_option, size_t
 
     bool const is_directory = S_ISDIR(path_stat.st_mode);
     if (is_directory) {
-        auto di = Core::DirIterator(path, Core::DirIterator::SkipParentAndBaseDir);
+        auto di = Core::DirIterator(path, static_cast<Core::DirIterator::Flags>(Core::DirIterator::SkipParentAndBaseDir | Core::DirIterator::WithStat));
         if (di.has_error()) {
             auto error = di.error();
             warnln("du: cannot read directory '{}': {}", path, error);
@@ -217,8 +220,9 @@ u64 print_space_usage(ByteString const& path, DuOption const& du_option, size_t
         }
 
         while (di.has_next()) {
-            auto const child_path = di.next_full_path();
-            size += print_space_usage(child_path, du_option, current_depth + 1, root_device);
+            auto const child = di.next().release_value();
+            auto const child_path = ByteString::formatted("{}{}{}", path, path.ends_with('/') ? ""sv : "/"sv, child.name);
+            size += print_space_usage(child_path, du_option, current_depth + 1, root_device, child.stat);
         }
     }
 
@@ -35,6 +35,8 @@ bool g_have_seen_action_command = false;
 bool g_print_hyperlinks = false;
 Optional<u32> g_max_depth = {};
 Optional<u32> g_min_depth = {};
+// Set if any of the commands look at the stat data of the files, so it's worth fetching it along with the directory entries.
+bool g_need_stat = false;
 
 template<typename... Parameters>
 [[noreturn]] static void fatal_error(CheckedFormatString<Parameters...>&& fmtstr, Parameters const&... parameters)
@@ -174,6 +176,11 @@ public:
 
 class StatCommand : public Command {
 public:
+    StatCommand()
+    {
+        g_need_stat = true;
+    }
+
     virtual bool evaluate(const struct stat&) const = 0;
 
 private:
@@ -391,6 +398,7 @@ class EmptyCommand final : public Command {
 public:
     EmptyCommand()
     {
+        g_need_stat = true;
     }
 
 private:
@@ -920,6 +928,30 @@ static NonnullOwnPtr<Command> parse_all_commands(Vector<char*>& args)
     return make<AndCommand>(command.release_nonnull(), make<PrintCommand>());
 }
 
+static unsigned char d_type_from_directory_entry_type(Core::DirectoryEntry::Type type)
+{
+    switch (type) {
+    case Core::DirectoryEntry::Type::BlockDevice:
+        return DT_BLK;
+    case Core::DirectoryEntry::Type::CharacterDevice:
+        return DT_CHR;
+    case Core::DirectoryEntry::Type::Directory:
+        return DT_DIR;
+    case Core::DirectoryEntry::Type::File:
+        return DT_REG;
+    case Core::DirectoryEntry::Type::NamedPipe:
+        return DT_FIFO;
+    case Core::DirectoryEntry::Type::Socket:
+        return DT_SOCK;
+    case Core::DirectoryEntry::Type::SymbolicLink:
+        return DT_LNK;
+    case Core::DirectoryEntry::Type::Unknown:
+    case Core::DirectoryEntry::Type::Whiteout:
+        return DT_UNKNOWN;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 static void walk_tree(FileData& root_data, Command& command, u32 depth = 0)
 {
     if (!g_min_depth.has_value() || g_min_depth.value() <= depth)
@@ -942,39 +974,40 @@ static void walk_tree(FileData& root_data, Command& command, u32 depth = 0)
         return;
     }
 
-    int dirfd = openat(root_data.dirfd, root_data.basename, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
-    if (dirfd < 0) {
-        if (errno == ENOTDIR) {
+    auto flags = Core::DirIterator::SkipParentAndBaseDir;
+    if (g_need_stat)
+        flags = static_cast<Core::DirIterator::Flags>(flags | Core::DirIterator::WithStat);
+    Core::DirIterator di(root_data.full_path(), flags);
+    if (di.has_error()) {
+        if (di.error().code() == ENOTDIR) {
             // Above we decided to try to open this file because it could
             // be a directory, but turns out it's not. This is fine though.
             return;
         }
-        perror(root_data.full_path().characters());
+        warnln("{}: {}", root_data.full_path(), di.error());
         g_there_was_an_error = true;
         return;
     }
 
-    DIR* dir = fdopendir(dirfd);
-
-    while (true) {
-        errno = 0;
-        auto* dirent = readdir(dir);
-        if (!dirent)
-            break;
-
-        if (strcmp(dirent->d_name, ".") == 0 || strcmp(dirent->d_name, "..") == 0)
-            continue;
+    while (di.has_next()) {
+        auto entry = di.next().release_value();
 
         FileData file_data {
             root_data.root_path,
-            root_data.relative_path.append({ dirent->d_name, strlen(dirent->d_name) }),
-            dirfd,
-            dirent->d_name,
+            root_data.relative_path.append(entry.name),
+            di.fd(),
+            entry.name.characters(),
             (struct stat) {},
             false,
-            dirent->d_type,
+            d_type_from_directory_entry_type(entry.type),
         };
 
+        // The directory iterator hands us lstat() results, which are only what we want if we aren't following the symlink.
+        if (entry.stat.has_value() && (!g_follow_symlinks || entry.type != Core::DirectoryEntry::Type::SymbolicLink)) {
+            file_data.stat = entry.stat.value();
+            file_data.stat_is_valid = true;
+        }
+
         bool should_increase_depth = false;
         if (g_max_depth.has_value() || g_min_depth.has_value()) {
             if (g_max_depth.has_value() && depth >= g_max_depth.value())
@@ -990,12 +1023,10 @@ static void walk_tree(FileData& root_data, Command& command, u32 depth = 0)
         walk_tree(file_data, command, should_increase_depth ? depth + 1 : depth);
     }
 
-    if (errno != 0) {
-        perror(root_data.full_path().characters());
+    if (di.has_error()) {
+        warnln("{}: {}", root_data.full_path(), di.error());
         g_there_was_an_error = true;
     }
-
-    closedir(dir);
 }
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
@@ -14,12 +14,15 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibMain/Main.h>
 #include <LibRegex/Regex.h>
+#include <LibThreading/ParallelAlgorithms.h>
 #include <LibURL/URL.h>
 #include <stdio.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 enum class BinaryFileMode {
@@ -115,7 +118,7 @@ static void append_formatted_path(StringBuilder& builder, StringView path, Optio
 
 ErrorOr<int> serenity_main(Main::Arguments args)
 {
-    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::pledge("stdio rpath thread"));
 
     ByteString program_name = AK::LexicalPath::basename(args.strings[0]);
 
@@ -137,8 +140,6 @@ ErrorOr<int> serenity_main(Main::Arguments args)
     bool disable_hyperlinks = !is_a_tty;
     bool count_lines = false;
 
-    size_t matched_line_count = 0;
-
     Core::ArgsParser args_parser;
     args_parser.add_option(recursive, "Recursively scan files", "recursive", 'r');
     args_parser.add_option(use_ere, "Extended regular expressions", "extended-regexp", 'E');
@@ -233,7 +234,10 @@ ErrorOr<int> serenity_main(Main::Arguments args)
     if (case_insensitive)
         options |= PosixFlags::Insensitive;
 
-    auto grep_logic = [&](auto&& regular_expressions) {
+    // Files are searched in place if they can be mapped, so that only lines containing a match have to be looked at.
+    // Recursive searches look at many files, which are then searched in parallel, with the output printed in order.
+    auto grep_logic = [&](auto compile_regular_expressions) {
+        auto regular_expressions = compile_regular_expressions();
         for (auto& re : regular_expressions) {
             if (re.parser_result.error != regex::Error::NoError) {
                 warnln("regex parse error: {}", regex::get_error_string(re.parser_result.error));
@@ -241,150 +245,220 @@ ErrorOr<int> serenity_main(Main::Arguments args)
             }
         }
 
-        auto matches = [&](StringView str, StringView filename, size_t line_number, bool print_filename, bool is_binary) {
-            size_t last_printed_char_pos { 0 };
-            if (is_binary && binary_mode == BinaryFileMode::Skip)
-                return false;
-
-            for (auto& re : regular_expressions) {
-                auto result = re.match(str, PosixFlags::Global);
-                if (!(result.success ^ invert_match))
-                    continue;
+        auto search_file = [&](auto& regular_expressions, StringView filename, bool print_filename, auto const& write) -> ErrorOr<bool> {
+            bool matched_any_line = false;
+            size_t matched_line_count = 0;
+
+            auto matches = [&](StringView str, size_t line_number, bool is_binary) {
+                size_t last_printed_char_pos { 0 };
+                if (is_binary && binary_mode == BinaryFileMode::Skip)
+                    return false;
+
+                for (auto& re : regular_expressions) {
+                    // If nothing gets printed, we only need to know whether there is a match, not where it is.
+                    if (quiet_mode || count_lines) {
+                        if (!(re.has_match(str, PosixFlags::Global) ^ invert_match))
+                            continue;
+                        if (!quiet_mode)
+                            matched_line_count++;
+                        return true;
+                    }
 
-                if (quiet_mode)
-                    return true;
+                    auto result = re.match(str, PosixFlags::Global);
+                    if (!(result.success ^ invert_match))
+                        continue;
 
-                if (count_lines) {
-                    matched_line_count++;
-                    return true;
-                }
-
-                if (is_binary && binary_mode == BinaryFileMode::Binary) {
-                    StringBuilder filename_builder;
-                    append_formatted_path(filename_builder, filename, {}, PrintType::Path, !disable_hyperlinks, colored_output);
-                    outln("binary file {} matches"sv, filename_builder.string_view());
-                } else {
-                    PrintType print_type { 0 };
-                    if (print_filename)
-                        print_type |= PrintType::Path;
-                    if (line_numbers)
-                        print_type |= PrintType::LineNumbers;
-
-                    if ((result.matches.size() || invert_match) && has_any_flag(print_type, PrintType::Path | PrintType::LineNumbers)) {
+                    StringBuilder builder;
+                    if (is_binary && binary_mode == BinaryFileMode::Binary) {
                         StringBuilder filename_builder;
-                        append_formatted_path(filename_builder, filename, line_number, print_type, !disable_hyperlinks, colored_output);
-                        out("{}:"sv, filename_builder.string_view());
+                        append_formatted_path(filename_builder, filename, {}, PrintType::Path, !disable_hyperlinks, colored_output);
+                        builder.appendff("binary file {} matches\n"sv, filename_builder.string_view());
+                    } else {
+                        PrintType print_type { 0 };
+                        if (print_filename)
+                            print_type |= PrintType::Path;
+                        if (line_numbers)
+                            print_type |= PrintType::LineNumbers;
+
+                        if ((result.matches.size() || invert_match) && has_any_flag(print_type, PrintType::Path | PrintType::LineNumbers)) {
+                            append_formatted_path(builder, filename, line_number, print_type, !disable_hyperlinks, colored_output);
+                            builder.append(':');
+                        }
+
+                        for (auto& match : result.matches) {
+                            auto pre_match_length = match.global_offset - last_printed_char_pos;
+                            builder.appendff(colored_output ? "{}\x1B[32m{}\x1B[0m"sv : "{}{}"sv,
+                                pre_match_length > 0 ? StringView(&str[last_printed_char_pos], pre_match_length) : ""sv,
+                                match.view.to_byte_string());
+                            last_printed_char_pos = match.global_offset + match.view.length();
+                        }
+                        auto remaining_length = str.length() - last_printed_char_pos;
+                        builder.appendff("{}\n", remaining_length > 0 ? StringView(&str[last_printed_char_pos], remaining_length) : ""sv);
                     }
+                    write(builder.string_view());
 
-                    for (auto& match : result.matches) {
-                        auto pre_match_length = match.global_offset - last_printed_char_pos;
-                        out(colored_output ? "{}\x1B[32m{}\x1B[0m"sv : "{}{}"sv,
-                            pre_match_length > 0 ? StringView(&str[last_printed_char_pos], pre_match_length) : ""sv,
-                            match.view.to_byte_string());
-                        last_printed_char_pos = match.global_offset + match.view.length();
-                    }
-                    auto remaining_length = str.length() - last_printed_char_pos;
-                    outln("{}", remaining_length > 0 ? StringView(&str[last_printed_char_pos], remaining_length) : ""sv);
+                    return true;
                 }
 
-                return true;
-            }
+                return false;
+            };
 
-            return false;
-        };
+            auto handle_line = [&](StringView line, size_t line_number) {
+                auto is_binary = line.contains('\0');
+                if (!matches(line, line_number, is_binary))
+                    return IterationDecision::Continue;
+
+                matched_any_line = true;
+                if (is_binary && binary_mode == BinaryFileMode::Binary)
+                    return IterationDecision::Break;
+                return IterationDecision::Continue;
+            };
+
+            auto search_buffer = [&](StringView buffer) {
+                // With a single pattern, the regex engine can skip over all the lines that don't contain a match.
+                if (regular_expressions.size() == 1 && !invert_match) {
+                    regular_expressions.first().for_each_matching_line(
+                        buffer, [&](StringView line, size_t line_index) { return handle_line(line, line_index + 1); }, PosixFlags::Global);
+                    return;
+                }
 
-        auto exit_status = ExitStatus::NoLinesMatched;
+                size_t line_number = 1;
+                for (size_t line_start = 0; line_start < buffer.length(); ++line_number) {
+                    auto line_end = buffer.find('\n', line_start).value_or(buffer.length());
+                    if (handle_line(buffer.substring_view(line_start, line_end - line_start), line_number) == IterationDecision::Break)
+                        break;
+                    line_start = line_end + 1;
+                }
+            };
 
-        auto handle_file = [&matches, binary_mode, count_lines, quiet_mode, disable_hyperlinks, colored_output,
-                               &matched_line_count, &exit_status](StringView filename, bool print_filename) -> ErrorOr<void> {
             auto file = TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read));
-            auto buffered_file = TRY(Core::InputBufferedFile::create(move(file)));
-
-            auto buffer = TRY(ByteBuffer::create_uninitialized(PAGE_SIZE));
-            for (size_t line_number = 1; !buffered_file->is_eof(); ++line_number) {
-                auto line = TRY(buffered_file->read_line_with_resize(buffer));
-                if (line.is_empty() && buffered_file->is_eof())
-                    break;
-
-                auto is_binary = line.contains('\0');
+            auto stat = TRY(Core::System::fstat(file->fd()));
+            if (S_ISREG(stat.st_mode)) {
+                // Empty files can't be mapped, but they don't have any lines either.
+                if (stat.st_size > 0) {
+                    auto mapped_file = TRY(Core::MappedFile::map_from_file(move(file), filename));
+                    search_buffer(StringView { mapped_file->bytes() });
+                }
+            } else {
+                auto buffered_file = TRY(Core::InputBufferedFile::create(move(file)));
+                auto buffer = TRY(ByteBuffer::create_uninitialized(PAGE_SIZE));
+                for (size_t line_number = 1; !buffered_file->is_eof(); ++line_number) {
+                    auto line = TRY(buffered_file->read_line_with_resize(buffer));
+                    if (line.is_empty() && buffered_file->is_eof())
+                        break;
 
-                auto matched = matches(line, filename, line_number, print_filename, is_binary);
-                if (matched) {
-                    if (exit_status == ExitStatus::NoLinesMatched)
-                        exit_status = ExitStatus::SomethingMatched;
-                    if (is_binary && binary_mode == BinaryFileMode::Binary)
+                    if (handle_line(line, line_number) == IterationDecision::Break)
                         break;
                 }
             }
 
             if (count_lines && !quiet_mode) {
+                StringBuilder builder;
                 if (print_filename) {
-                    StringBuilder filename_builder;
-                    append_formatted_path(filename_builder, filename, {}, PrintType::Path, !disable_hyperlinks, colored_output);
-                    out("{}:", filename_builder.string_view());
+                    append_formatted_path(builder, filename, {}, PrintType::Path, !disable_hyperlinks, colored_output);
+                    builder.append(':');
                 }
-                outln("{}", matched_line_count);
-                matched_line_count = 0;
+                builder.appendff("{}\n", matched_line_count);
+                write(builder.string_view());
             }
 
-            return {};
+            return matched_any_line;
         };
 
-        auto add_directory = [&handle_file, &exit_status, user_has_specified_files, suppress_errors](ByteString base, Optional<ByteString> recursive, auto handle_directory) -> void {
-            Core::DirIterator it(recursive.value_or(base), Core::DirIterator::Flags::SkipDots);
-            while (it.has_next()) {
-                auto path = it.next_full_path();
-                if (!FileSystem::is_directory(path)) {
-                    // Remove leading './' when `grep -r` was run without any specified paths.
-                    auto key = user_has_specified_files ? path.view() : path.substring_view(base.length() + 1);
-                    if (auto result = handle_file(key, true); result.is_error() && !suppress_errors) {
-                        warnln("Failed with file {}: {}", key, result.release_error());
-                        exit_status = ExitStatus::ErrorOccurred;
-                    }
+        auto exit_status = ExitStatus::NoLinesMatched;
 
-                } else {
-                    handle_directory(base, path, handle_directory);
+        auto handle_result = [&](StringView filename, ErrorOr<bool> result) {
+            if (result.is_error()) {
+                if (!suppress_errors) {
+                    warnln("Failed with file {}: {}", filename, result.release_error());
+                    exit_status = ExitStatus::ErrorOccurred;
                 }
+                return;
             }
+            if (result.value() && exit_status == ExitStatus::NoLinesMatched)
+                exit_status = ExitStatus::SomethingMatched;
         };
 
+        auto write_to_stdout = [](StringView output) { out("{}", output); };
+
         if (recursive) {
             if (!user_has_specified_files)
                 files.append("."sv);
 
-            for (auto& filename : files) {
+            Vector<ByteString> paths;
+            auto add_directory = [&paths, user_has_specified_files](ByteString base, Optional<ByteString> recursive, auto add_directory) -> void {
+                Core::DirIterator it(recursive.value_or(base), Core::DirIterator::Flags::SkipDots);
+                while (it.has_next()) {
+                    auto path = it.next_full_path();
+                    if (!FileSystem::is_directory(path)) {
+                        // Remove leading './' when `grep -r` was run without any specified paths.
+                        paths.append(user_has_specified_files ? path : path.substring(base.length() + 1));
+                    } else {
+                        add_directory(base, path, add_directory);
+                    }
+                }
+            };
+            for (auto& filename : files)
                 add_directory(filename, {}, add_directory);
+
+            // The hostname is cached on first use, which has to happen before any other threads want it.
+            if (!disable_hyperlinks)
+                (void)hostname();
+
+            struct FileSearch {
+                ByteString path;
+                StringBuilder output {};
+                ErrorOr<bool> result { false };
+            };
+
+            // Searching in batches keeps the amount of buffered output in check.
+            static constexpr size_t files_per_batch = 256;
+            for (size_t batch_start = 0; batch_start < paths.size(); batch_start += files_per_batch) {
+                Vector<FileSearch> searches;
+                for (size_t i = batch_start; i < min(paths.size(), batch_start + files_per_batch); ++i)
+                    searches.append({ paths[i] });
+
+                Threading::parallel_for(searches.span(), [&](Span<FileSearch> slice) {
+                    // Regexes keep some state around between searches, so every thread needs its own.
+                    auto regular_expressions = compile_regular_expressions();
+                    for (auto& search : slice)
+                        search.result = search_file(regular_expressions, search.path, true, [&](StringView output) { search.output.append(output); });
+                });
+
+                for (auto& search : searches) {
+                    out("{}", search.output.string_view());
+                    handle_result(search.path, move(search.result));
+                }
             }
         } else {
             if (!user_has_specified_files)
                 files.append("-"sv);
 
             bool print_filename { files.size() > 1 };
-            for (auto& filename : files) {
-                auto result = handle_file(filename, print_filename);
-                if (result.is_error() && !suppress_errors) {
-                    warnln("Failed with file {}: {}", filename, result.release_error());
-                    exit_status = ExitStatus::ErrorOccurred;
-                }
-            }
+            for (auto& filename : files)
+                handle_result(filename, search_file(regular_expressions, filename, print_filename, write_to_stdout));
         }
 
         return exit_status;
     };
 
     if (use_ere) {
-        Vector<Regex<PosixExtended>> regular_expressions;
-        for (auto pattern : patterns) {
-            auto escaped_pattern = (fixed_strings) ? escape_characters(pattern, ere_special_characters) : pattern;
-            regular_expressions.append(Regex<PosixExtended>(escaped_pattern, options));
-        }
-        return to_underlying(grep_logic(regular_expressions));
+        return to_underlying(grep_logic([&] {
+            Vector<Regex<PosixExtended>> regular_expressions;
+            for (auto pattern : patterns) {
+                auto escaped_pattern = (fixed_strings) ? escape_characters(pattern, ere_special_characters) : pattern;
+                regular_expressions.append(Regex<PosixExtended>(escaped_pattern, options));
+            }
+            return regular_expressions;
+        }));
     }
 
-    Vector<Regex<PosixBasic>> regular_expressions;
-    for (auto pattern : patterns) {
-        auto escaped_pattern = (fixed_strings) ? escape_characters(pattern, basic_special_characters) : pattern;
-        regular_expressions.append(Regex<PosixBasic>(escaped_pattern, options));
-    }
-    return to_underlying(grep_logic(regular_expressions));
+    return to_underlying(grep_logic([&] {
+        Vector<Regex<PosixBasic>> regular_expressions;
+        for (auto pattern : patterns) {
+            auto escaped_pattern = (fixed_strings) ? escape_characters(pattern, basic_special_characters) : pattern;
+            regular_expressions.append(Regex<PosixBasic>(escaped_pattern, options));
+        }
+        return regular_expressions;
+    }));
 }
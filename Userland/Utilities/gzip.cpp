@@ -77,11 +77,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull()));
         }
 
-        auto buffer = TRY(ByteBuffer::create_uninitialized(1 * MiB));
+        // Every write to the compressor becomes a gzip member of its own, so the input is compressed in large pieces,
+        // which are then compressed on multiple threads.
+        auto buffer = TRY(ByteBuffer::create_uninitialized(decompress ? 1 * MiB : 16 * MiB));
 
         while (!input_stream->is_eof()) {
-            auto span = TRY(input_stream->read_some(buffer));
-            TRY(output_stream->write_until_depleted(span));
+            size_t buffered_size = 0;
+            while (buffered_size < buffer.size() && !input_stream->is_eof())
+                buffered_size += TRY(input_stream->read_some(buffer.bytes().slice(buffered_size))).size();
+            TRY(output_stream->write_until_depleted(buffer.bytes().trim(buffered_size)));
         }
 
         if (!keep_input_files)
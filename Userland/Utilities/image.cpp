@@ -191,7 +191,7 @@ static ErrorOr<void> convert_image_profile(LoadedImage& image, StringView conver
     return {};
 }
 
-static ErrorOr<void> save_image(LoadedImage& image, StringView out_path, bool force_alpha, bool ppm_ascii, u8 jpeg_quality, Optional<unsigned> webp_allowed_transforms, unsigned webp_color_cache_bits, Compress::ZlibCompressionLevel png_compression_level)
+static ErrorOr<void> save_image(LoadedImage& image, StringView out_path, bool force_alpha, bool ppm_ascii, u8 jpeg_quality, Optional<unsigned> webp_allowed_transforms, unsigned webp_color_cache_bits, Compress::ZlibCompressionLevel png_compression_level, bool png_compress_in_parallel)
 {
     auto stream = [out_path]() -> ErrorOr<NonnullOwnPtr<Core::OutputBufferedFile>> {
         auto output_stream = TRY(Core::File::open(out_path, Core::File::OpenMode::Write));
@@ -230,7 +230,7 @@ static ErrorOr<void> save_image(LoadedImage& image, StringView out_path, bool fo
         return {};
     }
     if (out_path.ends_with(".png"sv, CaseSensitivity::CaseInsensitive)) {
-        TRY(Gfx::PNGWriter::encode(*TRY(stream()), *frame, { .compression_level = png_compression_level, .force_alpha = force_alpha, .icc_data = image.icc_data }));
+        TRY(Gfx::PNGWriter::encode(*TRY(stream()), *frame, { .compression_level = png_compression_level, .compress_in_parallel = png_compress_in_parallel, .force_alpha = force_alpha, .icc_data = image.icc_data }));
         return {};
     }
     if (out_path.ends_with(".ppm"sv, CaseSensitivity::CaseInsensitive)) {
@@ -284,6 +284,7 @@ struct Options {
     StringView convert_color_profile_path;
     bool strip_color_profile = false;
     Compress::ZlibCompressionLevel png_compression_level { Compress::ZlibCompressionLevel::Default };
+    bool png_compress_in_parallel = false;
     bool ppm_ascii = false;
     u8 quality = 75;
     Optional<Gfx::DitheringAlgorithm> to_bilevel;
@@ -378,6 +379,7 @@ static ErrorOr<Options> parse_options(Main::Arguments arguments)
 
     auto png_compression_level = static_cast<unsigned>(Compress::ZlibCompressionLevel::Default);
     args_parser.add_option(png_compression_level, "PNG compression level, in [0, 3]. Higher values take longer and produce smaller outputs. Default: 2", "png-compression-level", {}, {});
+    args_parser.add_option(options.png_compress_in_parallel, "Compress PNG output on multiple threads. This is a lot faster for large images, but produces slightly larger outputs", "png-compress-in-parallel", {});
     args_parser.add_option(options.ppm_ascii, "Convert to a PPM in ASCII", "ppm-ascii", {});
     args_parser.add_option(options.quality, "Quality used for the JPEG encoder, the default value is 75 on a scale from 0 to 100", "quality", {}, {});
     args_parser.add_option(options.webp_color_cache_bits, "Size of the webp color cache (in [0, 11], higher values tend to be slower and produce smaller output, default: 6)", "webp-color-cache-bits", {}, {});
@@ -445,7 +447,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (options.no_output)
         return 0;
 
-    TRY(save_image(image, options.out_path, options.force_alpha, options.ppm_ascii, options.quality, options.webp_allowed_transforms, options.webp_color_cache_bits, options.png_compression_level));
+    TRY(save_image(image, options.out_path, options.force_alpha, options.ppm_ascii, options.quality, options.webp_allowed_transforms, options.webp_color_cache_bits, options.png_compression_level, options.png_compress_in_parallel));
 
     return 0;
 }
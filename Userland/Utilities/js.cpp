@@ -20,6 +20,7 @@
 #include <LibJS/Contrib/Test262/GlobalObject.h>
 #include <LibJS/Parser.h>
 #include <LibJS/Print.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/DeclarativeEnvironment.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
@@ -535,12 +536,14 @@ private:
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction map_fixed"));
+    TRY(Core::System::pledge("stdio rpath wpath cpath tty sigaction map_fixed prot_exec thread"));
 
     bool gc_on_every_allocation = false;
+    bool parallel_gc_marking = false;
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
+    bool disable_bytecode_optimizations = false;
     StringView evaluate_script;
     Vector<StringView> script_paths;
 
@@ -548,11 +551,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(disable_bytecode_optimizations, "Disable bytecode optimization passes", "disable-bytecode-optimizations", {});
+    args_parser.add_option(JS::Bytecode::g_enable_jit, "Compile hot code to native code", "jit", {});
+    args_parser.add_option(JS::g_lazy_function_parsing, "Parse the bodies of large functions again when they're needed instead of keeping them around", "lazy-function-parsing", {});
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(parallel_gc_marking, "Mark live cells on several threads during GC", "parallel-gc-marking", {});
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
@@ -560,7 +567,17 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_positional_argument(script_paths, "Path to script files", "scripts", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
+    // Drop the promises that only optional features need.
+    StringBuilder promises;
+    promises.append("stdio rpath wpath cpath tty sigaction map_fixed"sv);
+    if (JS::Bytecode::g_enable_jit)
+        promises.append(" prot_exec"sv);
+    if (parallel_gc_marking)
+        promises.append(" thread"sv);
+    TRY(Core::System::pledge(promises.string_view()));
+
     bool syntax_highlight = !disable_syntax_highlight;
+    JS::Bytecode::g_optimize_bytecode = !disable_bytecode_optimizations;
 
     AK::set_debug_enabled(!disable_debug_printing);
     s_history_path = TRY(String::formatted("{}/.js-history", Core::StandardPaths::home_directory()));
@@ -569,6 +586,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     g_vm = g_vm_storage->ptr();
     g_vm->set_dynamic_imports_allowed(true);
 
+    // Scripts loaded from the REPL with load() are often loaded again after editing them, or several times unchanged.
+    g_vm->program_cache().set_enabled(true);
+
     if (!disable_debug_printing) {
         // NOTE: These will print out both warnings when using something like Promise.reject().catch(...) -
         // which is, as far as I can tell, correct - a promise is created, rejected without handler, and a
@@ -600,6 +620,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         ReplConsoleClient console_client(console_object.console());
         console_object.console().set_client(console_client);
         g_vm->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        g_vm->heap().set_parallel_marking_enabled(parallel_gc_marking);
 
         auto& global_environment = realm.global_environment();
 
@@ -829,6 +850,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         ReplConsoleClient console_client(console_object.console());
         console_object.console().set_client(console_client);
         g_vm->heap().set_should_collect_on_every_allocation(gc_on_every_allocation);
+        g_vm->heap().set_parallel_marking_enabled(parallel_gc_marking);
 
         StringBuilder builder;
         StringView source_name;
@@ -445,7 +445,7 @@ static int do_file_system_object_long(ByteString const& path)
     if (flag_show_almost_all_dotfiles)
         flags = Core::DirIterator::SkipParentAndBaseDir;
 
-    Core::DirIterator di(path, flags);
+    Core::DirIterator di(path, static_cast<Core::DirIterator::Flags>(flags | Core::DirIterator::WithStat));
 
     if (di.has_error()) {
         auto error = di.error();
@@ -480,9 +480,13 @@ static int do_file_system_object_long(ByteString const& path)
         builder.append('/');
         builder.append(metadata.name);
         metadata.path = builder.to_byte_string();
-        int rc = lstat(metadata.path.characters(), &metadata.stat);
-        if (rc < 0)
-            perror("lstat");
+        if (dirent.stat.has_value()) {
+            metadata.stat = dirent.stat.value();
+        } else {
+            int rc = lstat(metadata.path.characters(), &metadata.stat);
+            if (rc < 0)
+                perror("lstat");
+        }
 
         files.append(move(metadata));
     }
@@ -571,7 +575,7 @@ int do_file_system_object_short(ByteString const& path)
     if (flag_show_almost_all_dotfiles)
         flags = Core::DirIterator::SkipParentAndBaseDir;
 
-    Core::DirIterator di(path, flags);
+    Core::DirIterator di(path, static_cast<Core::DirIterator::Flags>(flags | Core::DirIterator::WithStat));
     if (di.has_error()) {
         auto error = di.error();
         if (error.code() == ENOTDIR) {
@@ -604,9 +608,13 @@ int do_file_system_object_short(ByteString const& path)
         builder.append('/');
         builder.append(metadata.name);
         metadata.path = builder.to_byte_string();
-        int rc = lstat(metadata.path.characters(), &metadata.stat);
-        if (rc < 0)
-            perror("lstat");
+        if (dirent.stat.has_value()) {
+            metadata.stat = dirent.stat.value();
+        } else {
+            int rc = lstat(metadata.path.characters(), &metadata.stat);
+            if (rc < 0)
+                perror("lstat");
+        }
 
         files.append(metadata);
         if (metadata.name.length() > longest_name)
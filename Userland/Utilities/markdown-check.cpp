@@ -42,7 +42,6 @@ static bool is_missing_file_acceptable(ByteString const& filename)
         "/usr/share/man/man2/mprotect.md"sv,
         "/usr/share/man/man2/open.md"sv,
         "/usr/share/man/man2/ptrace.md"sv,
-        "/usr/share/man/man5/perfcore.md"sv,
         // These ones are okay:
         "/home/anon/Tests/js-tests/test-common.js"sv,
         "/man1/index.html"sv,
@@ -43,8 +43,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     u64 physical_available = json.get_u64("physical_available"sv).value_or(0);
     u64 physical_committed = json.get_u64("physical_committed"sv).value_or(0);
     u64 physical_uncommitted = json.get_u64("physical_uncommitted"sv).value_or(0);
+    u64 physical_reclaimed = json.get_u64("physical_reclaimed"sv).value_or(0);
+    auto memory_pressure = json.get_byte_string("memory_pressure"sv).value_or("normal");
     u32 kmalloc_call_count = json.get_u32("kmalloc_call_count"sv).value_or(0);
     u32 kfree_call_count = json.get_u32("kfree_call_count"sv).value_or(0);
+    u64 kmalloc_magazine_cached = json.get_u64("kmalloc_magazine_cached"sv).value_or(0);
+    u64 kmalloc_magazine_allocation_count = json.get_u64("kmalloc_magazine_allocation_count"sv).value_or(0);
+    u64 kmalloc_magazine_free_count = json.get_u64("kmalloc_magazine_free_count"sv).value_or(0);
+    u64 kmalloc_magazine_refill_count = json.get_u64("kmalloc_magazine_refill_count"sv).value_or(0);
+    u64 kmalloc_magazine_drain_count = json.get_u64("kmalloc_magazine_drain_count"sv).value_or(0);
 
     u64 kmalloc_bytes_total = kmalloc_allocated + kmalloc_available;
     u64 physical_pages_total = physical_allocated + physical_available;
@@ -52,19 +59,25 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if (flag_human_readable) {
         outln("Kmalloc allocated: {}", TRY(String::formatted("{} / {}", human_readable_size_long(kmalloc_allocated, UseThousandsSeparator::Yes), human_readable_size_long(kmalloc_bytes_total, UseThousandsSeparator::Yes))));
+        outln("Kmalloc cached in per-CPU magazines: {}", human_readable_size_long(kmalloc_magazine_cached, UseThousandsSeparator::Yes));
         outln("Physical pages (in use) count: {}", TRY(String::formatted("{} / {}", human_readable_size_long(page_count_to_bytes(physical_pages_in_use), UseThousandsSeparator::Yes), human_readable_size_long(page_count_to_bytes(physical_pages_total), UseThousandsSeparator::Yes))));
         outln("Physical pages (committed) count: {}", TRY(String::formatted("{}", human_readable_size_long(page_count_to_bytes(physical_committed), UseThousandsSeparator::Yes))));
         outln("Physical pages (uncommitted) count: {}", TRY(String::formatted("{}", human_readable_size_long(page_count_to_bytes(physical_uncommitted), UseThousandsSeparator::Yes))));
         outln("Physical pages (total) count: {:'}", physical_pages_total);
     } else {
         outln("Kmalloc allocated: {}", TRY(String::formatted("{}/{}", kmalloc_allocated, kmalloc_bytes_total)));
+        outln("Kmalloc cached in per-CPU magazines: {}", kmalloc_magazine_cached);
         outln("Physical pages (in use) count: {}", TRY(String::formatted("{}/{}", page_count_to_bytes(physical_pages_in_use), page_count_to_bytes(physical_pages_total))));
         outln("Physical pages (committed) count: {}", TRY(String::formatted("{}", page_count_to_bytes(physical_committed))));
         outln("Physical pages (uncommitted) count: {}", TRY(String::formatted("{}", page_count_to_bytes(physical_uncommitted))));
         outln("Physical pages (total) count: {}", physical_pages_total);
     }
+    outln("Physical pages (reclaimed) count: {}", physical_reclaimed);
+    outln("Memory pressure: {}", memory_pressure);
     outln("Kmalloc call count: {}", kmalloc_call_count);
     outln("Kfree call count: {}", kfree_call_count);
     outln("Kmalloc/Kfree delta: {}", TRY(String::formatted("{:+}", kmalloc_call_count - kfree_call_count)));
+    outln("Kmalloc magazine allocations/frees: {}/{}", kmalloc_magazine_allocation_count, kmalloc_magazine_free_count);
+    outln("Kmalloc magazine refills/drains: {}/{}", kmalloc_magazine_refill_count, kmalloc_magazine_drain_count);
     return 0;
 }
@@ -5,6 +5,7 @@
  */
 
 #include <AK/JsonObject.h>
+#include <AK/QuickSort.h>
 #include <AK/LexicalPath.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
@@ -15,6 +16,9 @@
 #include <LibPDF/CommonNames.h>
 #include <LibPDF/Document.h>
 #include <LibPDF/Renderer.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
 
 static PDF::PDFErrorOr<void> print_document_info(PDF::Document& document, bool json)
 {
@@ -129,24 +133,102 @@ static ErrorOr<String> summary_string(Vector<int> const& pages)
     return builder.to_string();
 }
 
-static PDF::PDFErrorOr<void> print_debugging_stats(PDF::Document& document, bool json)
+static PDF::PDFErrorOr<void> collect_page_diagnostics(PDF::Document& document, u32 page_number, Function<void(ByteString const&)> const& on_diagnostic)
 {
-    HashMap<ByteString, Vector<int>> diags_to_pages;
-    for (u32 page_number = 1; page_number <= document.get_page_count(); ++page_number) {
+    auto page = TRY(document.get_page(page_number - 1));
+    auto page_size = Gfx::IntSize { 200, round_to<int>(200 * page.media_box.height() / page.media_box.width()) };
+    auto bitmap = TRY(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, page_size));
+    auto errors = PDF::Renderer::render(document, page, bitmap, Color::White, PDF::RenderingPreferences {});
+    if (errors.is_error()) {
+        for (auto const& error : errors.error().errors())
+            on_diagnostic(error.message());
+    }
+    return {};
+}
+
+// A Document can only be used from one thread, so the pages are rendered in worker processes that each have their own
+// copy of it. Every line a worker writes to the shared pipe is either "page" when it's done with that page, or
+// "page<tab>message" for a diagnostic. Lines are written with a single write() of at most PIPE_BUF bytes, so the
+// lines of different workers never end up mixed.
+static PDF::PDFErrorOr<void> collect_diagnostics_in_workers(PDF::Document& document, u32 job_count, bool json, HashMap<ByteString, Vector<int>>& diags_to_pages)
+{
+    auto pipe_fds = TRY(Core::System::pipe2(O_CLOEXEC));
+    fflush(stdout);
+
+    Vector<pid_t> workers;
+    for (u32 worker_index = 0; worker_index < job_count; ++worker_index) {
+        auto pid = TRY(Core::System::fork());
+        if (pid != 0) {
+            workers.append(pid);
+            continue;
+        }
+
+        auto write_line = [&](ByteString const& line) {
+            auto bytes = line.bytes().trim(PIPE_BUF - 1);
+            StringBuilder builder;
+            builder.append(StringView { bytes }.replace("\n"sv, " "sv, ReplaceMode::All));
+            builder.append('\n');
+            (void)Core::System::write(pipe_fds[1], builder.string_view().bytes());
+        };
+        for (u32 page_number = 1 + worker_index; page_number <= document.get_page_count(); page_number += job_count) {
+            auto result = collect_page_diagnostics(document, page_number, [&](ByteString const& message) {
+                write_line(ByteString::formatted("{}\t{}", page_number, message));
+            });
+            if (result.is_error())
+                write_line(ByteString::formatted("{}\t{}", page_number, result.error().message()));
+            write_line(ByteString::number(page_number));
+        }
+        _exit(0);
+    }
+    TRY(Core::System::close(pipe_fds[1]));
+
+    auto pipe = TRY(Core::InputBufferedFile::create(TRY(Core::File::adopt_fd(pipe_fds[0], Core::File::OpenMode::Read))));
+    auto buffer = TRY(ByteBuffer::create_uninitialized(PIPE_BUF));
+    u32 finished_pages = 0;
+    while (!pipe->is_eof()) {
+        auto line = TRY(pipe->read_line(buffer));
+        if (line.is_empty())
+            continue;
+        auto tab = line.find('\t');
+        auto page_number = line.substring_view(0, tab.value_or(line.length())).to_number<int>();
+        if (!page_number.has_value())
+            continue;
+        if (tab.has_value()) {
+            diags_to_pages.ensure(line.substring_view(tab.value() + 1)).append(page_number.value());
+            continue;
+        }
         if (!json) {
-            out("page number {} / {}", page_number, document.get_page_count());
+            out("\rpage number {} / {}", ++finished_pages, document.get_page_count());
             fflush(stdout);
         }
-        auto page = TRY(document.get_page(page_number - 1));
-        auto page_size = Gfx::IntSize { 200, round_to<int>(200 * page.media_box.height() / page.media_box.width()) };
-        auto bitmap = TRY(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, page_size));
-        auto errors = PDF::Renderer::render(document, page, bitmap, Color::White, PDF::RenderingPreferences {});
-        if (errors.is_error()) {
-            for (auto const& error : errors.error().errors())
-                diags_to_pages.ensure(error.message()).append(page_number);
+    }
+
+    for (auto pid : workers)
+        (void)TRY(Core::System::waitpid(pid));
+
+    // The pages arrive in any order, but the summaries below expect them to be sorted.
+    for (auto& entry : diags_to_pages)
+        quick_sort(entry.value);
+    return {};
+}
+
+static PDF::PDFErrorOr<void> print_debugging_stats(PDF::Document& document, bool json, u32 job_count)
+{
+    HashMap<ByteString, Vector<int>> diags_to_pages;
+    if (job_count > 1) {
+        TRY(collect_diagnostics_in_workers(document, min(job_count, document.get_page_count()), json, diags_to_pages));
+    } else {
+        for (u32 page_number = 1; page_number <= document.get_page_count(); ++page_number) {
+            if (!json) {
+                out("page number {} / {}", page_number, document.get_page_count());
+                fflush(stdout);
+            }
+            TRY(collect_page_diagnostics(document, page_number, [&](ByteString const& message) {
+                diags_to_pages.ensure(message).append(page_number);
+            }));
+            if (!json)
+                out("\r");
         }
-        if (!json)
-            out("\r");
     }
     if (!json)
         outln();
@@ -195,6 +277,9 @@ static PDF::PDFErrorOr<int> pdf_main(Main::Arguments arguments)
     bool debugging_stats = false;
     args_parser.add_option(debugging_stats, "Print stats for debugging", "debugging-stats", {});
 
+    u32 job_count = 1;
+    args_parser.add_option(job_count, "Number of pages to render at the same time for --debugging-stats", "jobs", 'j', "N");
+
     bool dump_contents = false;
     args_parser.add_option(dump_contents, "Dump page contents", "dump-contents", {});
 
@@ -245,7 +330,7 @@ static PDF::PDFErrorOr<int> pdf_main(Main::Arguments arguments)
 #endif
 
     if (debugging_stats) {
-        TRY(print_debugging_stats(*document, json));
+        TRY(print_debugging_stats(*document, json, job_count));
         return 0;
     }
 
@@ -44,6 +44,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 event_mask |= PERF_EVENT_SAMPLE;
             else if (event_type == "context_switch")
                 event_mask |= PERF_EVENT_CONTEXT_SWITCH;
+            else if (event_type == "scheduling_latency")
+                event_mask |= PERF_EVENT_SCHEDULING_LATENCY;
+            else if (event_type == "cpu_cycles")
+                event_mask |= PERF_EVENT_CPU_CYCLES;
+            else if (event_type == "instructions_retired")
+                event_mask |= PERF_EVENT_INSTRUCTIONS_RETIRED;
+            else if (event_type == "cache_miss")
+                event_mask |= PERF_EVENT_CACHE_MISS;
+            else if (event_type == "branch_miss")
+                event_mask |= PERF_EVENT_BRANCH_MISS;
             else if (event_type == "kmalloc")
                 event_mask |= PERF_EVENT_KMALLOC;
             else if (event_type == "kfree")
@@ -54,6 +64,8 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 event_mask |= PERF_EVENT_SYSCALL;
             else if (event_type == "filesystem")
                 event_mask |= PERF_EVENT_FILESYSTEM;
+            else if (event_type == "tracepoint")
+                event_mask |= PERF_EVENT_TRACEPOINT;
             else {
                 warnln("Unknown event type '{}' specified.", event_type);
                 exit(1);
@@ -65,7 +77,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     auto print_types = [] {
         outln();
-        outln("Event type can be one of: sample, context_switch, page_fault, syscall, filesystem, kmalloc and kfree.");
+        outln("Event type can be one of: sample, context_switch, scheduling_latency, cpu_cycles, instructions_retired, cache_miss, branch_miss, page_fault, syscall, filesystem, tracepoint, kmalloc and kfree.");
     };
 
     if (!args_parser.parse(arguments, Core::ArgsParser::FailureBehavior::PrintUsage)) {
@@ -159,7 +159,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 0;
     }
 
-    auto encoded_bitmap_or_error = Gfx::PNGWriter::encode(*bitmap);
+    auto encoded_bitmap_or_error = Gfx::PNGWriter::encode(*bitmap, { .compress_in_parallel = true });
     if (encoded_bitmap_or_error.is_error()) {
         warnln("Failed to encode PNG");
         return 1;
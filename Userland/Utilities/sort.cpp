@@ -8,12 +8,12 @@
 #include <AK/ByteString.h>
 #include <AK/CharacterTypes.h>
 #include <AK/HashMap.h>
-#include <AK/QuickSort.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
+#include <LibThreading/ParallelAlgorithms.h>
 
 struct Line {
     StringView key;
@@ -99,7 +99,7 @@ static ErrorOr<void> load_file(Options const& options, StringView filename, Stri
 
 ErrorOr<int> serenity_main([[maybe_unused]] Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath"));
+    TRY(Core::System::pledge("stdio rpath thread"));
 
     Options options;
 
@@ -125,7 +125,7 @@ ErrorOr<int> serenity_main([[maybe_unused]] Main::Arguments arguments)
         }
     }
 
-    quick_sort(lines);
+    Threading::parallel_sort(lines.span());
 
     auto print_lines = [line_delimiter](auto const& lines) {
         for (auto& line : lines)
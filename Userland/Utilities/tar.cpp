@@ -17,9 +17,12 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DirIterator.h>
 #include <LibCore/Directory.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibMain/Main.h>
+#include <LibThreading/BoundedQueue.h>
+#include <LibThreading/Thread.h>
 #include <fcntl.h>
 #include <stdio.h>
 #include <sys/stat.h>
@@ -27,6 +30,188 @@
 
 constexpr size_t buffer_size = 4096;
 
+// Extracting an archive is split into three stages, which run on their own threads so that reading the archive,
+// decompressing it and writing the extracted files can overlap. The reader stage reads the archive in chunks, the main
+// thread decompresses and parses it, and the writer stage writes the contents of the extracted files.
+// The queues between the stages hold at most this many chunks.
+constexpr size_t pipeline_chunk_size = 256 * KiB;
+constexpr size_t pipeline_queue_capacity = 16;
+
+// Reads a file on a thread of its own, and provides its contents as a stream.
+class ReaderStage final : public Stream {
+public:
+    static ErrorOr<NonnullOwnPtr<ReaderStage>> start(NonnullOwnPtr<Core::File> file)
+    {
+        auto stage = TRY(adopt_nonnull_own_or_enomem(new (nothrow) ReaderStage(move(file))));
+        stage->m_thread = TRY(Threading::Thread::try_create([&stage = *stage] { return stage.read_chunks(); }, "tar reader"sv));
+        stage->m_thread->start();
+        return stage;
+    }
+
+    virtual ~ReaderStage() override
+    {
+        // This stops the reader thread if it's still waiting to hand over a chunk.
+        m_chunks.close();
+        (void)m_thread->join();
+    }
+
+    virtual ErrorOr<Bytes> read_some(Bytes bytes) override
+    {
+        if (!load_next_chunk_if_needed()) {
+            if (m_error.has_value())
+                return Error::copy(*m_error);
+            return bytes.trim(0);
+        }
+
+        auto remaining = m_current_chunk.bytes().slice(m_offset_in_current_chunk);
+        auto read_bytes = remaining.copy_trimmed_to(bytes);
+        m_offset_in_current_chunk += read_bytes;
+        return bytes.trim(read_bytes);
+    }
+
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override { return Error::from_errno(EBADF); }
+    virtual bool is_eof() const override { return !load_next_chunk_if_needed() && !m_error.has_value(); }
+    virtual bool is_open() const override { return true; }
+    virtual void close() override { }
+
+private:
+    explicit ReaderStage(NonnullOwnPtr<Core::File> file)
+        : m_file(move(file))
+    {
+    }
+
+    intptr_t read_chunks()
+    {
+        while (true) {
+            auto chunk_or_error = [&]() -> ErrorOr<ByteBuffer> {
+                auto chunk = TRY(ByteBuffer::create_uninitialized(pipeline_chunk_size));
+                auto read_bytes = TRY(m_file->read_some(chunk));
+                chunk.resize(read_bytes.size());
+                return chunk;
+            }();
+
+            if (chunk_or_error.is_error()) {
+                // The error is only read after the queue has been closed, which orders the accesses.
+                m_error = chunk_or_error.release_error();
+                break;
+            }
+
+            auto chunk = chunk_or_error.release_value();
+            if (chunk.is_empty() || !m_chunks.enqueue(move(chunk)))
+                break;
+        }
+
+        m_chunks.close();
+        return 0;
+    }
+
+    // Returns false once all chunks have been read.
+    bool load_next_chunk_if_needed() const
+    {
+        while (m_offset_in_current_chunk == m_current_chunk.size()) {
+            auto chunk = m_chunks.dequeue();
+            if (!chunk.has_value())
+                return false;
+            m_current_chunk = chunk.release_value();
+            m_offset_in_current_chunk = 0;
+        }
+        return true;
+    }
+
+    NonnullOwnPtr<Core::File> m_file;
+    RefPtr<Threading::Thread> m_thread;
+    Optional<Error> m_error;
+
+    mutable Threading::BoundedQueue<ByteBuffer> m_chunks { pipeline_queue_capacity };
+    mutable ByteBuffer m_current_chunk;
+    mutable size_t m_offset_in_current_chunk { 0 };
+};
+
+// Writes the contents of extracted files on a thread of its own. The files are opened by the main thread, which keeps
+// the order of creating files and directories the same as in the archive.
+class WriterStage {
+public:
+    static ErrorOr<NonnullOwnPtr<WriterStage>> start()
+    {
+        auto stage = TRY(adopt_nonnull_own_or_enomem(new (nothrow) WriterStage));
+        stage->m_thread = TRY(Threading::Thread::try_create([&stage = *stage] { return stage.write_chunks(); }, "tar writer"sv));
+        stage->m_thread->start();
+        return stage;
+    }
+
+    ~WriterStage()
+    {
+        (void)finish();
+    }
+
+    // Takes over the file descriptor, which is closed after all of its chunks have been written.
+    ErrorOr<void> write(int fd, ByteBuffer chunk) { return enqueue({ fd, move(chunk), false }); }
+    ErrorOr<void> close(int fd) { return enqueue({ fd, {}, true }); }
+
+    // Waits until everything has been written, and returns the first error that occurred.
+    ErrorOr<void> finish()
+    {
+        if (!m_finished) {
+            m_finished = true;
+            m_jobs.close();
+            (void)m_thread->join();
+        }
+        if (m_error.has_value())
+            return Error::copy(*m_error);
+        return {};
+    }
+
+private:
+    struct Job {
+        int fd { -1 };
+        ByteBuffer chunk;
+        bool close_afterwards { false };
+    };
+
+    WriterStage() = default;
+
+    ErrorOr<void> enqueue(Job job)
+    {
+        // Stop extracting at the first error instead of when the archive ends.
+        if (m_failed.load(AK::MemoryOrder::memory_order_relaxed))
+            return finish();
+
+        VERIFY(m_jobs.enqueue(move(job)));
+        return {};
+    }
+
+    intptr_t write_chunks()
+    {
+        while (true) {
+            auto job = m_jobs.dequeue();
+            if (!job.has_value())
+                break;
+
+            auto result = [&]() -> ErrorOr<void> {
+                if (job->close_afterwards)
+                    return Core::System::close(job->fd);
+                if (m_failed.load(AK::MemoryOrder::memory_order_relaxed))
+                    return {};
+                for (auto bytes = job->chunk.bytes(); !bytes.is_empty();)
+                    bytes = bytes.slice(TRY(Core::System::write(job->fd, bytes)));
+                return {};
+            }();
+
+            if (result.is_error() && !m_failed.load(AK::MemoryOrder::memory_order_relaxed)) {
+                m_error = result.release_error();
+                m_failed.store(true, AK::MemoryOrder::memory_order_relaxed);
+            }
+        }
+        return 0;
+    }
+
+    RefPtr<Threading::Thread> m_thread;
+    Threading::BoundedQueue<Job> m_jobs { pipeline_queue_capacity };
+    Atomic<bool> m_failed { false };
+    Optional<Error> m_error; // Only accessed by the main thread after joining the writer thread.
+    bool m_finished { false };
+};
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     bool create = false;
@@ -72,7 +257,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     }
 
     if (list || extract) {
-        NonnullOwnPtr<Stream> input_stream = TRY(Core::InputBufferedFile::create(TRY(Core::File::open_file_or_standard_stream(archive_file, Core::File::OpenMode::Read))));
+        NonnullOwnPtr<Stream> input_stream = TRY(ReaderStage::start(TRY(Core::File::open_file_or_standard_stream(archive_file, Core::File::OpenMode::Read))));
+
+        // An archive file can be decompressed in one go, which decodes its blocks on multiple threads.
+        ByteBuffer decompressed_archive;
+        Optional<NonnullOwnPtr<Core::MappedFile>> mapped_archive;
+        if (xz && !archive_file.is_empty() && archive_file != "-"sv) {
+            if (auto mapped_file = Core::MappedFile::map(archive_file); !mapped_file.is_error())
+                mapped_archive = mapped_file.release_value();
+        }
 
         if (!directory.is_empty())
             TRY(Core::System::chdir(directory));
@@ -83,11 +276,19 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         if (lzma)
             input_stream = TRY(Compress::LzmaDecompressor::create_from_container(move(input_stream)));
 
-        if (xz)
+        if (xz && mapped_archive.has_value()) {
+            decompressed_archive = TRY(Compress::XzDecompressor::decompress_all((*mapped_archive)->bytes()));
+            input_stream = TRY(try_make<FixedMemoryStream>(decompressed_archive.bytes()));
+        } else if (xz) {
             input_stream = TRY(Compress::XzDecompressor::create(move(input_stream)));
+        }
 
         auto tar_stream = TRY(Archive::TarInputStream::construct(move(input_stream)));
 
+        OwnPtr<WriterStage> writer_stage;
+        if (extract)
+            writer_stage = TRY(WriterStage::start());
+
         HashMap<ByteString, ByteString> global_overrides;
         HashMap<ByteString, ByteString> local_overrides;
 
@@ -178,13 +379,21 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
                     int fd = TRY(Core::System::open(absolute_path, O_CREAT | O_WRONLY, header_mode));
 
-                    Array<u8, buffer_size> buffer;
+                    // Reserving the space up front keeps large files from fragmenting. Not every file system supports
+                    // this, and the writes report running out of space anyway, so failing here isn't an error.
+                    if (auto size = TRY(header.size()); size > 0)
+                        (void)Core::System::posix_fallocate(fd, 0, size);
+
                     while (!file_stream.is_eof()) {
-                        auto slice = TRY(file_stream.read_some(buffer));
-                        TRY(Core::System::write(fd, slice));
+                        auto chunk = TRY(ByteBuffer::create_uninitialized(pipeline_chunk_size));
+                        size_t chunk_size = 0;
+                        while (chunk_size < chunk.size() && !file_stream.is_eof())
+                            chunk_size += TRY(file_stream.read_some(chunk.bytes().slice(chunk_size))).size();
+                        chunk.resize(chunk_size);
+                        TRY(writer_stage->write(fd, move(chunk)));
                     }
 
-                    TRY(Core::System::close(fd));
+                    TRY(writer_stage->close(fd));
                     break;
                 }
                 case Archive::TarFileType::SymLink: {
@@ -214,6 +423,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             TRY(tar_stream->advance());
         }
 
+        if (writer_stage)
+            TRY(writer_stage->finish());
+
         return 0;
     }
 
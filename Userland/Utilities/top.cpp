@@ -11,6 +11,7 @@
 #include <AK/QuickSort.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
 #include <LibCore/ProcessStatisticsReader.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
@@ -91,7 +92,8 @@ struct Snapshot {
 
 static ErrorOr<Snapshot> get_snapshot(HashTable<pid_t> const& pids)
 {
-    auto all_processes = TRY(Core::ProcessStatisticsReader::get_all());
+    static auto statistics_file = TRY(Core::ProcessStatisticsReader::open_statistics_file());
+    auto all_processes = TRY(Core::ProcessStatisticsReader::get_all(*statistics_file));
 
     Snapshot snapshot;
     for (auto& process : all_processes.processes) {
@@ -233,6 +235,7 @@ static void restore_tty()
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     TRY(Core::System::pledge("stdio rpath tty sigaction"));
+    TRY(Core::System::unveil("/sys/kernel/process_statistics", "r"));
     TRY(Core::System::unveil("/sys/kernel/processes", "r"));
     TRY(Core::System::unveil("/etc/passwd", "r"));
     unveil(nullptr, nullptr);
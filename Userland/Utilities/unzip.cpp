@@ -10,16 +10,11 @@
 #include <AK/NumberFormat.h>
 #include <AK/StringUtils.h>
 #include <LibArchive/Zip.h>
-#include <LibCompress/Deflate.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/DateTime.h>
 #include <LibCore/Directory.h>
 #include <LibCore/File.h>
-#include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
-#include <LibCrypto/Checksum/CRC32.h>
-#include <LibFileSystem/FileSystem.h>
-#include <sys/stat.h>
 
 static ErrorOr<void> adjust_modification_time(Archive::ZipMember const& zip_member)
 {
@@ -33,74 +28,52 @@ static ErrorOr<void> adjust_modification_time(Archive::ZipMember const& zip_memb
     return Core::System::utime(zip_member.name, buf);
 }
 
-static bool unpack_zip_member(Archive::ZipMember zip_member, bool quiet)
+// Creates the directory for a directory member, or the parent directories of a file member.
+static bool prepare_zip_member(Archive::ZipMember const& zip_member)
 {
     if (zip_member.is_directory) {
         if (auto maybe_error = Core::System::mkdir(zip_member.name, 0755); maybe_error.is_error()) {
             warnln("Failed to create directory '{}': {}", zip_member.name, maybe_error.error());
             return false;
         }
-        if (!quiet)
-            outln(" extracting: {}", zip_member.name);
         return true;
     }
-    MUST(Core::Directory::create(LexicalPath(zip_member.name.to_byte_string()).parent(), Core::Directory::CreateDirectories::Yes));
-    mode_t file_permissions = zip_member.mode.value_or(0644) & 0777;
-    auto new_file_or_error = Core::File::open(zip_member.name.to_byte_string(), Core::File::OpenMode::Write, file_permissions);
-    if (new_file_or_error.is_error()) {
-        warnln("Can't write file {}: {}", zip_member.name, new_file_or_error.release_error());
+    if (auto maybe_error = Core::Directory::create(LexicalPath(zip_member.name.to_byte_string()).parent(), Core::Directory::CreateDirectories::Yes); maybe_error.is_error()) {
+        warnln("Failed to create directory for '{}': {}", zip_member.name, maybe_error.error());
         return false;
     }
-    auto new_file = new_file_or_error.release_value();
-
-    if (!quiet)
-        outln(" extracting: {}", zip_member.name);
+    return true;
+}
 
-    Crypto::Checksum::CRC32 checksum;
-    switch (zip_member.compression_method) {
-    case Archive::ZipCompressionMethod::Store: {
-        if (auto maybe_error = new_file->write_until_depleted(zip_member.compressed_data); maybe_error.is_error()) {
-            warnln("Can't write file contents in {}: {}", zip_member.name, maybe_error.release_error());
-            return false;
-        }
-        checksum.update({ zip_member.compressed_data.data(), zip_member.compressed_data.size() });
-        break;
-    }
-    case Archive::ZipCompressionMethod::Deflate: {
-        auto decompressed_data = Compress::DeflateDecompressor::decompress_all(zip_member.compressed_data);
-        if (decompressed_data.is_error()) {
-            warnln("Failed decompressing file {}: {}", zip_member.name, decompressed_data.error());
-            return false;
-        }
-        if (decompressed_data.value().size() != zip_member.uncompressed_size) {
-            warnln("Failed decompressing file {}", zip_member.name);
-            return false;
-        }
-        if (auto maybe_error = new_file->write_until_depleted(decompressed_data.value()); maybe_error.is_error()) {
-            warnln("Can't write file contents in {}: {}", zip_member.name, maybe_error.release_error());
-            return false;
-        }
-        checksum.update(decompressed_data.value());
-        break;
-    }
-    default:
-        VERIFY_NOT_REACHED();
+// This runs on multiple threads at once, see Archive::Zip::decompress_members_in_parallel().
+static ErrorOr<void> write_zip_member(Archive::ZipMember const& zip_member, ErrorOr<ReadonlyBytes> contents)
+{
+    if (contents.is_error()) {
+        warnln("Failed decompressing file {}: {}", zip_member.name, contents.error());
+        return contents.release_error();
     }
 
-    if (adjust_modification_time(zip_member).is_error()) {
-        warnln("Failed setting modification_time for file {}", zip_member.name);
-        return false;
+    mode_t file_permissions = zip_member.mode.value_or(0644) & 0777;
+    auto new_file_or_error = Core::File::open(zip_member.name.to_byte_string(), Core::File::OpenMode::Write, file_permissions);
+    if (new_file_or_error.is_error()) {
+        warnln("Can't write file {}: {}", zip_member.name, new_file_or_error.error());
+        return new_file_or_error.release_error();
     }
+    auto new_file = new_file_or_error.release_value();
 
+    // The contents of stored members are written straight from the mapped archive.
+    if (auto maybe_error = new_file->write_until_depleted(contents.value()); maybe_error.is_error()) {
+        warnln("Can't write file contents in {}: {}", zip_member.name, maybe_error.error());
+        return maybe_error.release_error();
+    }
     new_file->close();
 
-    if (checksum.digest() != zip_member.crc32) {
-        warnln("Failed decompressing file {}: CRC32 mismatch", zip_member.name);
-        MUST(FileSystem::remove(zip_member.name, FileSystem::RecursionMode::Disallowed));
-        return false;
+    if (auto maybe_error = adjust_modification_time(zip_member); maybe_error.is_error()) {
+        warnln("Failed setting modification_time for file {}", zip_member.name);
+        return maybe_error.release_error();
     }
 
-    return true;
+    return {};
 }
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
@@ -119,26 +92,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_positional_argument(file_filters, "Files or filters in the archive to extract", "files", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
-    struct stat st = TRY(Core::System::stat(zip_file_path));
-
-    // FIXME: Map file chunk-by-chunk once we have mmap() with offset.
-    //        This will require mapping some parts then unmapping them repeatedly,
-    //        but it would be significantly faster and less syscall heavy than seek()/read() at every read.
-    OwnPtr<Core::MappedFile> mapped_file;
-    ReadonlyBytes input_bytes;
-    if (st.st_size > 0) {
-        mapped_file = TRY(Core::MappedFile::map(zip_file_path));
-        input_bytes = mapped_file->bytes();
-    }
-
     if (!quiet)
         warnln("Archive: {}", zip_file_path);
 
-    auto zip_file = Archive::Zip::try_create(input_bytes);
-    if (!zip_file.has_value()) {
-        warnln("Invalid zip file {}", zip_file_path);
+    auto zip_file_or_error = Archive::Zip::map(zip_file_path);
+    if (zip_file_or_error.is_error()) {
+        warnln("Invalid zip file {}: {}", zip_file_path, zip_file_or_error.error());
         return 1;
     }
+    auto zip_file = zip_file_or_error.release_value();
 
     if (!output_directory_path.is_null()) {
         TRY(Core::Directory::create(output_directory_path, Core::Directory::CreateDirectories::Yes));
@@ -148,7 +110,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     if (list_files) {
         outln("  Length     Date      Time     Name");
         outln("--------- ---------- --------   ----");
-        TRY(zip_file->for_each_member([&](auto zip_member) -> ErrorOr<IterationDecision> {
+        TRY(zip_file.for_each_member([&](auto zip_member) -> ErrorOr<IterationDecision> {
             auto time = time_from_packed_dos(zip_member.modification_date, zip_member.modification_time);
             auto time_str = TRY(Core::DateTime::from_timestamp(time.seconds_since_epoch()).to_string());
 
@@ -156,15 +118,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
             return IterationDecision::Continue;
         }));
-        auto statistics = TRY(zip_file->calculate_statistics());
+        auto statistics = TRY(zip_file.calculate_statistics());
         outln("---------                       ----");
         outln("{:>9}                       {} files", statistics.total_uncompressed_bytes(), statistics.member_count());
         return 0;
     }
 
+    Vector<Archive::ZipMember> zip_members;
     Vector<Archive::ZipMember> zip_directories;
 
-    auto success = TRY(zip_file->for_each_member([&](auto zip_member) {
+    for (auto& zip_member : TRY(zip_file.members())) {
         bool keep_file = false;
 
         if (!file_filters.is_empty()) {
@@ -180,19 +143,21 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             keep_file = true;
         }
 
-        if (keep_file) {
-            if (!unpack_zip_member(zip_member, quiet))
-                return IterationDecision::Break;
-            if (zip_member.is_directory)
-                zip_directories.append(zip_member);
-        }
+        if (!keep_file)
+            continue;
 
-        return IterationDecision::Continue;
-    }));
+        // Creating all directories up front lets the files be extracted in any order.
+        if (!prepare_zip_member(zip_member))
+            return 1;
+        if (!quiet)
+            outln(" extracting: {}", zip_member.name);
+        if (zip_member.is_directory)
+            TRY(zip_directories.try_append(zip_member));
+        TRY(zip_members.try_append(move(zip_member)));
+    }
 
-    if (!success) {
+    if (Archive::Zip::decompress_members_in_parallel(zip_members, write_zip_member).is_error())
         return 1;
-    }
 
     for (auto& directory : zip_directories) {
         if (adjust_modification_time(directory).is_error()) {
@@ -208,5 +173,5 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         }
     }
 
-    return success ? 0 : 1;
+    return 0;
 }
@@ -523,6 +523,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool export_all_imports = false;
     bool shell_mode = false;
     bool wasi = false;
+    bool enable_jit = false;
     ByteString exported_function_to_execute;
     Vector<ParsedValue> values_to_push;
     Vector<ByteString> modules_to_link_in;
@@ -538,6 +539,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     parser.add_option(export_all_imports, "Export noop functions corresponding to imports", "export-noop");
     parser.add_option(shell_mode, "Launch a REPL in the module's context (implies -i)", "shell", 's');
     parser.add_option(wasi, "Enable WASI", "wasi", 'w');
+    parser.add_option(enable_jit, "Compile frequently called functions to native code", "jit");
     parser.add_option(Core::ArgsParser::Option {
         .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
         .help_string = "Directory mappings to expose via WASI",
@@ -595,6 +597,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         return 1;
     }
 
+    // The debugger has to see every instruction, so everything is interpreted while debugging.
+    Wasm::g_enable_jit = enable_jit && !debug;
+
     if (debug || shell_mode) {
         old_signal = signal(SIGINT, sigint_handler);
     }
@@ -7,12 +7,13 @@
 #include <LibCompress/Xz.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("rpath stdio"));
+    TRY(Core::System::pledge("rpath stdio thread"));
 
     StringView filename;
 
@@ -21,6 +22,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_positional_argument(filename, "File to decompress", "file");
     args_parser.parse(arguments);
 
+    // A file can be decompressed in one go, which decodes its blocks on multiple threads.
+    if (filename != "-"sv) {
+        if (auto mapped_file = Core::MappedFile::map(filename); !mapped_file.is_error()) {
+            auto decompressed_data = TRY(Compress::XzDecompressor::decompress_all(mapped_file.value()->bytes()));
+            out("{:s}", decompressed_data.bytes());
+            return 0;
+        }
+    }
+
     auto file = TRY(Core::File::open_file_or_standard_stream(filename, Core::File::OpenMode::Read));
     auto buffered_file = TRY(Core::InputBufferedFile::create(move(file)));
     auto stream = TRY(Compress::XzDecompressor::create(move(buffered_file)));